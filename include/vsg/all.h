@@ -14,12 +14,15 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 // Core header files
 #include <vsg/core/Allocator.h>
+#include <vsg/core/AllocatorArena.h>
 #include <vsg/core/Array.h>
 #include <vsg/core/Array2D.h>
 #include <vsg/core/Array3D.h>
 #include <vsg/core/Auxiliary.h>
+#include <vsg/core/CompressedData.h>
 #include <vsg/core/ConstVisitor.h>
 #include <vsg/core/Data.h>
+#include <vsg/core/Dispatcher.h>
 #include <vsg/core/Exception.h>
 #include <vsg/core/Export.h>
 #include <vsg/core/External.h>
@@ -31,11 +34,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Object.h>
 #include <vsg/core/Objects.h>
 #include <vsg/core/ScratchMemory.h>
+#include <vsg/core/TrackingAllocator.h>
 #include <vsg/core/Value.h>
 #include <vsg/core/Version.h>
 #include <vsg/core/Visitor.h>
 #include <vsg/core/compare.h>
 #include <vsg/core/contains.h>
+#include <vsg/core/hash.h>
 #include <vsg/core/observer_ptr.h>
 #include <vsg/core/ref_ptr.h>
 #include <vsg/core/type_name.h>
@@ -51,8 +56,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/maths/mat4.h>
 #include <vsg/maths/numbers.h>
 #include <vsg/maths/plane.h>
+#include <vsg/maths/quantize.h>
 #include <vsg/maths/quat.h>
 #include <vsg/maths/sample.h>
+#include <vsg/maths/simd.h>
 #include <vsg/maths/sphere.h>
 #include <vsg/maths/transform.h>
 #include <vsg/maths/vec2.h>
@@ -61,6 +68,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 // Node header files
 #include <vsg/nodes/AbsoluteTransform.h>
+#include <vsg/nodes/BatchedCullGroup.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/nodes/Compilable.h>
 #include <vsg/nodes/CoordinateFrame.h>
@@ -69,18 +77,28 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/DepthSorted.h>
 #include <vsg/nodes/Geometry.h>
 #include <vsg/nodes/Group.h>
+#include <vsg/nodes/InstanceCulling.h>
 #include <vsg/nodes/InstanceDraw.h>
 #include <vsg/nodes/InstanceDrawIndexed.h>
+#include <vsg/nodes/InstanceDrawIndexedIndirect.h>
 #include <vsg/nodes/InstanceNode.h>
 #include <vsg/nodes/InstrumentationNode.h>
 #include <vsg/nodes/LOD.h>
 #include <vsg/nodes/Layer.h>
+#include <vsg/nodes/LazyCompileGroup.h>
 #include <vsg/nodes/MatrixTransform.h>
 #include <vsg/nodes/Node.h>
+#include <vsg/nodes/Occluder.h>
+#include <vsg/nodes/PackedDraws.h>
+#include <vsg/nodes/PackedSubgraph.h>
 #include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/ParallelGroup.h>
+#include <vsg/nodes/PointCloud.h>
 #include <vsg/nodes/QuadGroup.h>
 #include <vsg/nodes/RegionOfInterest.h>
+#include <vsg/nodes/SpatialGrid.h>
 #include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/StreamingStateGroup.h>
 #include <vsg/nodes/Switch.h>
 #include <vsg/nodes/TileDatabase.h>
 #include <vsg/nodes/Transform.h>
@@ -95,18 +113,24 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/animation/CameraSampler.h>
 #include <vsg/animation/FindAnimations.h>
 #include <vsg/animation/Joint.h>
+#include <vsg/animation/JointPalette.h>
 #include <vsg/animation/JointSampler.h>
 #include <vsg/animation/MorphSampler.h>
+#include <vsg/animation/MorphTargets.h>
 #include <vsg/animation/TransformSampler.h>
 #include <vsg/animation/time_value.h>
 
 // Lighting header files
 #include <vsg/lighting/AmbientLight.h>
+#include <vsg/lighting/DepthReduction.h>
 #include <vsg/lighting/DirectionalLight.h>
 #include <vsg/lighting/HardShadows.h>
 #include <vsg/lighting/Light.h>
+#include <vsg/lighting/LightClustering.h>
 #include <vsg/lighting/PercentageCloserSoftShadows.h>
 #include <vsg/lighting/PointLight.h>
+#include <vsg/lighting/RayTracedShadows.h>
+#include <vsg/lighting/ShadowMapBudget.h>
 #include <vsg/lighting/ShadowSettings.h>
 #include <vsg/lighting/SoftShadows.h>
 #include <vsg/lighting/SpotLight.h>
@@ -141,6 +165,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/commands/ResetQueryPool.h>
 #include <vsg/commands/ResolveImage.h>
 #include <vsg/commands/SetDepthBias.h>
+#include <vsg/commands/SetFragmentShadingRate.h>
 #include <vsg/commands/SetLineWidth.h>
 #include <vsg/commands/SetPrimitiveTopology.h>
 #include <vsg/commands/SetScissor.h>
@@ -150,6 +175,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 // State header files
 #include <vsg/state/ArrayState.h>
 #include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/BindlessDescriptors.h>
 #include <vsg/state/Buffer.h>
 #include <vsg/state/BufferInfo.h>
 #include <vsg/state/BufferView.h>
@@ -162,7 +188,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/DescriptorSet.h>
 #include <vsg/state/DescriptorSetLayout.h>
 #include <vsg/state/DescriptorTexelBufferView.h>
+#include <vsg/state/DynamicDescriptorBuffer.h>
 #include <vsg/state/DynamicState.h>
+#include <vsg/state/ExtendedDynamicState.h>
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/state/Image.h>
 #include <vsg/state/ImageInfo.h>
@@ -171,9 +199,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/MultisampleState.h>
 #include <vsg/state/PipelineLayout.h>
 #include <vsg/state/PushConstants.h>
+#include <vsg/state/PushDescriptorSet.h>
 #include <vsg/state/QueryPool.h>
 #include <vsg/state/RasterizationState.h>
+#include <vsg/state/RenderingState.h>
 #include <vsg/state/ResourceHints.h>
+#include <vsg/state/RingDescriptorBuffer.h>
 #include <vsg/state/Sampler.h>
 #include <vsg/state/ShaderModule.h>
 #include <vsg/state/ShaderStage.h>
@@ -191,9 +222,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/threading/Barrier.h>
 #include <vsg/threading/DeleteQueue.h>
 #include <vsg/threading/FrameBlock.h>
+#include <vsg/threading/HybridWait.h>
 #include <vsg/threading/Latch.h>
 #include <vsg/threading/OperationQueue.h>
 #include <vsg/threading/OperationThreads.h>
+#include <vsg/threading/ThreadConfinedScope.h>
 #include <vsg/threading/atomics.h>
 
 // User Interface abstraction header files
@@ -218,13 +251,31 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/CommandGraph.h>
 #include <vsg/app/CompileManager.h>
 #include <vsg/app/CompileTraversal.h>
+#include <vsg/app/CullCache.h>
+#include <vsg/app/DynamicResolution.h>
 #include <vsg/app/EllipsoidModel.h>
+#include <vsg/app/FrameCapture.h>
+#include <vsg/app/FrameGraph.h>
+#include <vsg/app/FramePacing.h>
+#include <vsg/app/FrameReadback.h>
+#include <vsg/app/GpuDecompressor.h>
+#include <vsg/app/Headless.h>
+#include <vsg/app/LazyCompiler.h>
+#include <vsg/app/MipmapGenerator.h>
+#include <vsg/app/OcclusionBuffer.h>
+#include <vsg/app/PagedLODOcclusionQueries.h>
+#include <vsg/app/PrefetchTraversal.h>
 #include <vsg/app/Presentation.h>
 #include <vsg/app/ProjectionMatrix.h>
 #include <vsg/app/RecordAndSubmitTask.h>
+#include <vsg/app/RecordCosts.h>
 #include <vsg/app/RecordTraversal.h>
 #include <vsg/app/RenderGraph.h>
+#include <vsg/app/RenderPassChain.h>
 #include <vsg/app/SecondaryCommandGraph.h>
+#include <vsg/app/StaticTileCache.h>
+#include <vsg/app/TerrainHeightCache.h>
+#include <vsg/app/TextureStreamer.h>
 #include <vsg/app/Trackball.h>
 #include <vsg/app/TransferTask.h>
 #include <vsg/app/UpdateOperations.h>
@@ -240,6 +291,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/AllocationCallbacks.h>
 #include <vsg/vk/CommandBuffer.h>
 #include <vsg/vk/CommandPool.h>
+#include <vsg/vk/CommandPoolRing.h>
 #include <vsg/vk/Context.h>
 #include <vsg/vk/DescriptorPool.h>
 #include <vsg/vk/DescriptorPools.h>
@@ -247,18 +299,21 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/DeviceExtensions.h>
 #include <vsg/vk/DeviceFeatures.h>
 #include <vsg/vk/DeviceMemory.h>
+#include <vsg/vk/DeviceResourceCache.h>
 #include <vsg/vk/Fence.h>
 #include <vsg/vk/Framebuffer.h>
 #include <vsg/vk/Instance.h>
 #include <vsg/vk/InstanceExtensions.h>
 #include <vsg/vk/MemoryBufferPools.h>
 #include <vsg/vk/PhysicalDevice.h>
+#include <vsg/vk/PipelineCache.h>
 #include <vsg/vk/Queue.h>
 #include <vsg/vk/RenderPass.h>
 #include <vsg/vk/ResourceRequirements.h>
 #include <vsg/vk/Semaphore.h>
 #include <vsg/vk/Slots.h>
 #include <vsg/vk/State.h>
+#include <vsg/vk/SubmitBatch.h>
 #include <vsg/vk/SubmitCommands.h>
 #include <vsg/vk/Surface.h>
 #include <vsg/vk/Swapchain.h>
@@ -266,20 +321,27 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/vulkan.h>
 
 // Input/Output header files
+#include <vsg/io/Archive.h>
 #include <vsg/io/AsciiInput.h>
 #include <vsg/io/AsciiOutput.h>
+#include <vsg/io/AsyncFileReader.h>
 #include <vsg/io/BinaryInput.h>
 #include <vsg/io/BinaryOutput.h>
+#include <vsg/io/Compression.h>
 #include <vsg/io/DatabasePager.h>
+#include <vsg/io/DirectoryCache.h>
 #include <vsg/io/FileSystem.h>
+#include <vsg/io/HashOutput.h>
 #include <vsg/io/Input.h>
 #include <vsg/io/JSONParser.h>
 #include <vsg/io/Logger.h>
+#include <vsg/io/MappedFile.h>
 #include <vsg/io/ObjectFactory.h>
 #include <vsg/io/Options.h>
 #include <vsg/io/Output.h>
 #include <vsg/io/Path.h>
 #include <vsg/io/ReaderWriter.h>
+#include <vsg/io/StreamingWriter.h>
 #include <vsg/io/VSG.h>
 #include <vsg/io/convert_utf.h>
 #include <vsg/io/glsl.h>
@@ -295,28 +357,53 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 // Utility header files
 #include <vsg/utils/Builder.h>
+#include <vsg/utils/CachedBounds.h>
+#include <vsg/utils/ChangeTracker.h>
+#include <vsg/utils/CollectMemoryUsage.h>
 #include <vsg/utils/CommandLine.h>
+#include <vsg/utils/CompactInstanceArrays.h>
+#include <vsg/utils/CompressTextures.h>
 #include <vsg/utils/ComputeBounds.h>
 #include <vsg/utils/CoordinateSpace.h>
 #include <vsg/utils/FindDynamicObjects.h>
+#include <vsg/utils/FrameStatistics.h>
+#include <vsg/utils/GenerateImpostor.h>
+#include <vsg/utils/GenerateLODs.h>
 #include <vsg/utils/GpuAnnotation.h>
 #include <vsg/utils/GraphicsPipelineConfigurator.h>
+#include <vsg/utils/InstanceBVH.h>
 #include <vsg/utils/Instrumentation.h>
+#include <vsg/utils/InterleaveVertexArrays.h>
 #include <vsg/utils/Intersector.h>
 #include <vsg/utils/LineSegmentIntersector.h>
 #include <vsg/utils/LoadPagedLOD.h>
+#include <vsg/utils/MergeGeometries.h>
+#include <vsg/utils/MultiLineSegmentIntersector.h>
+#include <vsg/utils/OptimizeMeshes.h>
+#include <vsg/utils/OptimizeStateGroups.h>
+#include <vsg/utils/PackSubgraph.h>
+#include <vsg/utils/PackTextures.h>
+#include <vsg/utils/PartitionGroups.h>
+#include <vsg/utils/PointCloudShaderSet.h>
 #include <vsg/utils/PolytopeIntersector.h>
 #include <vsg/utils/PrimitiveFunctor.h>
+#include <vsg/utils/ProcessImages.h>
 #include <vsg/utils/Profiler.h>
 #include <vsg/utils/PropagateDynamicObjects.h>
+#include <vsg/utils/QuantizeVertexAttributes.h>
 #include <vsg/utils/ShaderCompiler.h>
+#include <vsg/utils/ShaderReflection.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/utils/SharedObjects.h>
+#include <vsg/utils/TriangleBVH.h>
+#include <vsg/utils/WeightedBlendedTransparency.h>
 
 // Text header files
 #include <vsg/text/CpuLayoutTechnique.h>
 #include <vsg/text/Font.h>
+#include <vsg/text/GlyphGenerator.h>
 #include <vsg/text/GlyphMetrics.h>
+#include <vsg/text/GpuLabelTechnique.h>
 #include <vsg/text/GpuLayoutTechnique.h>
 #include <vsg/text/StandardLayout.h>
 #include <vsg/text/Text.h>
@@ -330,6 +417,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/raytracing/BottomLevelAccelerationStructure.h>
 #include <vsg/raytracing/BuildAccelerationStructureTraversal.h>
 #include <vsg/raytracing/DescriptorAccelerationStructure.h>
+#include <vsg/raytracing/RayQueryIntersector.h>
 #include <vsg/raytracing/RayTracingPipeline.h>
 #include <vsg/raytracing/RayTracingShaderGroup.h>
 #include <vsg/raytracing/TopLevelAccelerationStructure.h>
@@ -339,3 +427,4 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/meshshaders/DrawMeshTasks.h>
 #include <vsg/meshshaders/DrawMeshTasksIndirect.h>
 #include <vsg/meshshaders/DrawMeshTasksIndirectCount.h>
+#include <vsg/meshshaders/Meshlets.h>
@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/animation/AnimationGroup.h>
+#include <vsg/threading/OperationThreads.h>
 #include <vsg/ui/FrameStamp.h>
 #include <vsg/utils/Instrumentation.h>
 
@@ -30,6 +31,14 @@ namespace vsg
 
         ref_ptr<Instrumentation> instrumentation;
 
+        /// when assigned, and there are more than minimumAnimationsPerOperation animations, run() distributes the animation updates across the operationThreads,
+        /// waiting for them all to complete before returning so they are finished before the RecordTraversal.
+        /// Each animation's samplers are updated on a single thread so animations being played concurrently must not share sampler targets, and update(Animation&) must be thread safe.
+        ref_ptr<OperationThreads> operationThreads;
+
+        /// number of animations updated by each operation when running in parallel.
+        uint32_t minimumAnimationsPerOperation = 16;
+
         /// assign instrumentation if required
         virtual void assignInstrumentation(ref_ptr<Instrumentation> in_instrumentation);
 
@@ -50,6 +59,9 @@ namespace vsg
 
     protected:
         double _simulationTime = 0.0;
+
+        std::vector<Animation*> _updateAnimations;
+        std::vector<uint8_t> _updateResults;
     };
     VSG_type_name(vsg::AnimationManager);
 
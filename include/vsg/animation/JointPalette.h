@@ -0,0 +1,91 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Command.h>
+#include <vsg/core/Array.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/BufferInfo.h>
+#include <vsg/state/ComputePipeline.h>
+
+namespace vsg
+{
+
+    /** JointPalette is a compute stage that flattens joint hierarchies and computes the skinning matrix palettes of one or more skeleton instances on the GPU,
+      * replacing the CPU accumulation of JointSampler::jointMatrices. JointSampler writes each joint's local matrix, relative to its parent joint, to localMatrices
+      * and the compute shader accumulates each joint's parent chain and applies the offsetMatrices, writing the results to the jointMatrices buffer.
+      * jointMatrices can be bound as the "jointMatrices" storage buffer of the skinning shaders, or when vertices, jointIndices and jointWeights are assigned
+      * the vertices (and normals) are pre-skinned into the skinnedVertices (and skinnedNormals) buffers which can be bound as vertex arrays by the main and shadow passes,
+      * so each vertex is only skinned once per frame.
+      * As compute dispatches can't be recorded within a render pass JointPalette must be placed in the CommandGraph ahead of the RenderGraph, and as it allocates
+      * the output buffers it must be compiled before the subgraphs that use them.*/
+    class VSG_DECLSPEC JointPalette : public Inherit<Command, JointPalette>
+    {
+    public:
+        JointPalette();
+
+        /// number of joints in the hierarchy and the number of skeleton instances that share it.
+        uint32_t jointCount = 0;
+        uint32_t instanceCount = 1;
+
+        /// per instance joint local matrices, instanceCount * jointCount entries, typically updated each frame by JointSampler.
+        ref_ptr<mat4Array> localMatrices;
+
+        /// parent joint index of each joint, -1 for root joints.
+        ref_ptr<intArray> parentIndices;
+
+        /// inverse bind matrices of each joint.
+        ref_ptr<mat4Array> offsetMatrices;
+
+        /// optional pre-skinning inputs, vertices, jointIndices and jointWeights must all be assigned to enable pre-skinning, normals are optional.
+        ref_ptr<vec3Array> vertices;
+        ref_ptr<vec3Array> normals;
+        ref_ptr<ivec4Array> jointIndices;
+        ref_ptr<vec4Array> jointWeights;
+
+        /// matrix palettes written by the compute shader, each instance's palette starts jointStride() matrices after the previous one.
+        ref_ptr<BufferInfo> jointMatrices;
+        BufferInfoList instanceJointMatrices;
+
+        /// pre-skinned vec3 vertices and normals written by the compute shader, instanceCount * vertices->size() entries.
+        ref_ptr<BufferInfo> skinnedVertices;
+        ref_ptr<BufferInfo> skinnedNormals;
+        BufferInfoList instanceSkinnedVertices;
+        BufferInfoList instanceSkinnedNormals;
+
+        /// number of matrices between the start of each instance's palette, padded so each palette can be bound as a storage buffer.
+        uint32_t jointStride() const { return (jointCount + 3) & ~3u; }
+
+        /// set up the inputs, output buffers and compute pipelines, call once the counts and arrays have been assigned.
+        void init();
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~JointPalette();
+
+        ref_ptr<BufferInfo> _localMatrices;
+        ref_ptr<BufferInfo> _parentIndices;
+        ref_ptr<BufferInfo> _offsetMatrices;
+        BufferInfoList _skinningInputs;
+
+        ref_ptr<PipelineLayout> _pipelineLayout;
+        ref_ptr<BindComputePipeline> _bindPaletteComputePipeline;
+        ref_ptr<BindComputePipeline> _bindSkinningComputePipeline;
+        ref_ptr<BindDescriptorSet> _bindDescriptorSet;
+    };
+    VSG_type_name(vsg::JointPalette);
+
+} // namespace vsg
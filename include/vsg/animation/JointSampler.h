@@ -29,6 +29,13 @@ namespace vsg
         std::vector<dmat4> offsetMatrices;
         ref_ptr<Node> subgraph;
 
+        /// when localMatrices is assigned update() writes each joint's matrix relative to its parent joint to localMatrices, starting at localMatricesOffset,
+        /// and its parent joint index to parentIndices, leaving the hierarchy flattening and palette computation to a JointPalette compute stage.
+        /// These are run time settings that aren't serialized.
+        ref_ptr<mat4Array> localMatrices;
+        ref_ptr<intArray> parentIndices;
+        uint32_t localMatricesOffset = 0;
+
         void update(double time) override;
         double maxTime() const override;
 
@@ -45,6 +52,8 @@ namespace vsg
         void apply(Joint& joint) override;
 
         std::vector<dmat4> _matrixStack;
+        int _parentIndex = -1;
+        bool _parentIndicesModified = false;
     };
     VSG_type_name(vsg::JointSampler);
 
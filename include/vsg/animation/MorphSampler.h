@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/animation/Animation.h>
+#include <vsg/animation/time_value.h>
 
 namespace vsg
 {
@@ -43,7 +44,7 @@ namespace vsg
     };
     VSG_type_name(vsg::MorphKeyframes);
 
-    /// Animation sampler for morphing geometry, implementation not yet completed.
+    /// Animation sampler for morphing geometry, the blended weights are passed on to the MorphTargets or floatArray assigned as the object.
     class VSG_DECLSPEC MorphSampler : public Inherit<AnimationSampler, MorphSampler>
     {
     public:
@@ -53,6 +54,13 @@ namespace vsg
         ref_ptr<MorphKeyframes> keyframes;
         ref_ptr<Object> object;
 
+        // updated using keyframes, weights indexed by morph target
+        std::vector<double> weights;
+
+        /// index of the first weight written to the object's weights, for a MorphTargets with multiple instances set to instance * targetCount().
+        /// This is a run time setting that isn't serialized.
+        uint32_t weightsOffset = 0;
+
         void update(double time) override;
         double maxTime() const override;
 
@@ -62,6 +70,10 @@ namespace vsg
 
         void read(Input& input) override;
         void write(Output& output) const override;
+
+    protected:
+        // index of the key frame used by the last update, used to accelerate the search for the next update
+        size_t _keyframeIndex = 0;
     };
     VSG_type_name(vsg::MorphSampler);
 
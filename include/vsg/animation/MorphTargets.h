@@ -0,0 +1,101 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/Command.h>
+#include <vsg/core/Array.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/BufferInfo.h>
+#include <vsg/state/ComputePipeline.h>
+#include <vsg/vk/vk_buffer.h>
+
+namespace vsg
+{
+
+    /** MorphTargets is a compute stage that blends sparse morph target deltas into the vertices (and normals) of one or more instances of a mesh on the GPU.
+      * The targets only store the deltas of the vertices they move, init() merges them into a per affected vertex list so that each frame the compute shader
+      * only touches the affected vertices, the rest of the morphedVertices (and morphedNormals) buffers are initialized from the base vertices on the first record.
+      * The blend is skipped when the weights haven't been modified since the last record, and the outputs can be bound as vertex arrays by the main and shadow passes,
+      * so each vertex is only morphed once per frame. The weights are typically updated by MorphSampler with its object set to the MorphTargets.
+      * As compute dispatches can't be recorded within a render pass MorphTargets must be placed in the CommandGraph ahead of the RenderGraph, and as it allocates
+      * the output buffers it must be compiled before the subgraphs that use them.*/
+    class VSG_DECLSPEC MorphTargets : public Inherit<Command, MorphTargets>
+    {
+    public:
+        MorphTargets();
+
+        /// number of mesh instances that share the targets, each with its own weights and outputs.
+        uint32_t instanceCount = 1;
+
+        /// base vertices and optional normals.
+        ref_ptr<vec3Array> vertices;
+        ref_ptr<vec3Array> normals;
+
+        /// sparse morph target, the vertex indices and their deltas, normalDeltas are optional.
+        struct Target
+        {
+            ref_ptr<uintArray> indices;
+            ref_ptr<vec3Array> vertexDeltas;
+            ref_ptr<vec3Array> normalDeltas;
+        };
+
+        std::vector<Target> targets;
+
+        /// add a sparse target.
+        void addTarget(ref_ptr<uintArray> indices, ref_ptr<vec3Array> vertexDeltas, ref_ptr<vec3Array> normalDeltas = {});
+
+        /// add a target from per vertex deltas, such as glTF morph targets, keeping only the vertices with a vertex or normal delta larger than threshold.
+        void addTarget(const vec3Array& vertexDeltas, const vec3Array* normalDeltas = nullptr, float threshold = 0.0f);
+
+        uint32_t targetCount() const { return static_cast<uint32_t>(targets.size()); }
+
+        /// per instance target weights, instanceCount * targetCount() entries, allocated by init() if not already assigned.
+        ref_ptr<floatArray> weights;
+
+        /// morphed vec3 vertices and normals written by the compute shader, instanceCount * vertices->size() entries.
+        ref_ptr<BufferInfo> morphedVertices;
+        ref_ptr<BufferInfo> morphedNormals;
+        BufferInfoList instanceMorphedVertices;
+        BufferInfoList instanceMorphedNormals;
+
+        /// number of vertices moved by at least one target, set by init().
+        uint32_t affectedVertexCount = 0;
+
+        /// set up the inputs, output buffers and compute pipeline, call once the vertices and targets have been assigned.
+        void init();
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~MorphTargets();
+
+        ref_ptr<BufferInfo> _vertices;
+        ref_ptr<BufferInfo> _normals;
+        ref_ptr<BufferInfo> _weights;
+        BufferInfoList _inputs;
+
+        ref_ptr<PipelineLayout> _pipelineLayout;
+        ref_ptr<BindComputePipeline> _bindComputePipeline;
+        ref_ptr<BindDescriptorSet> _bindDescriptorSet;
+
+        struct RecordState
+        {
+            bool initialized = false;
+            ModifiedCount weightsModifiedCount;
+        };
+        mutable vk_buffer<RecordState> _recordState;
+    };
+    VSG_type_name(vsg::MorphTargets);
+
+} // namespace vsg
@@ -40,11 +40,27 @@ namespace vsg
         /// scale key frames
         std::vector<VectorKey> scales;
 
+        /// compact structure-of-arrays key frames with single precision values, assigned by compact(..).
+        /// When not empty TransformSampler samples these in preference to the positions, rotations and scales vectors.
+        time_values<vec3> compactPositions;
+        time_values<quat> compactRotations;
+        time_values<quantized_quat> quantizedRotations;
+        time_values<vec3> compactScales;
+
+        /// move the positions, rotations and scales key frames into the compact representation to reduce memory footprint and cache misses when sampling long animations.
+        /// Values are stored in single precision, so compacting is not appropriate for positions far from the origin.
+        /// If quantizeRotations is true rotations are stored with 16 bits per component.
+        void compact(bool quantizeRotations = false);
+
         void clear()
         {
             positions.clear();
             rotations.clear();
             scales.clear();
+            compactPositions.clear();
+            compactRotations.clear();
+            quantizedRotations.clear();
+            compactScales.clear();
         }
 
         void add(double time, const dvec3& position, const dquat& rotation)
@@ -98,6 +114,12 @@ namespace vsg
         void apply(Joint& joint) override;
         void apply(LookAt& lookAt) override;
         void apply(Camera& camera) override;
+
+    protected:
+        // indices of the key frames used by the last update, used to accelerate the search for the next update
+        size_t _positionIndex = 0;
+        size_t _rotationIndex = 0;
+        size_t _scaleIndex = 0;
     };
     VSG_type_name(vsg::TransformSampler);
 
@@ -12,6 +12,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <algorithm>
+#include <cmath>
+
 #include <vsg/animation/Animation.h>
 #include <vsg/app/ViewMatrix.h>
 #include <vsg/maths/transform.h>
@@ -35,6 +38,88 @@ namespace vsg
     using time_dvec4 = time_value<dvec4>;
     using time_dquat = time_value<dquat>;
 
+    /// compact structure-of-arrays key frame container, holding the times separately from the values so the key frame search touches only the times.
+    template<typename T>
+    struct time_values
+    {
+        using value_type = T;
+        std::vector<double> times;
+        std::vector<value_type> values;
+
+        size_t size() const { return times.size(); }
+        bool empty() const { return times.empty(); }
+
+        void clear()
+        {
+            times.clear();
+            values.clear();
+        }
+
+        void reserve(size_t size)
+        {
+            times.reserve(size);
+            values.reserve(size);
+        }
+
+        void push_back(double time, const value_type& value)
+        {
+            times.push_back(time);
+            values.push_back(value);
+        }
+    };
+
+    /// quaternion quantized to 16 bit signed normalized components, used to reduce the memory footprint of rotation key frames.
+    struct quantized_quat
+    {
+        svec4 value;
+
+        quantized_quat() = default;
+
+        template<typename T>
+        explicit quantized_quat(const t_quat<T>& q) :
+            value(quantize(q.x), quantize(q.y), quantize(q.z), quantize(q.w))
+        {
+        }
+
+        template<typename T>
+        explicit operator t_quat<T>() const
+        {
+            constexpr T scale = T(1.0 / 32767.0);
+            return normalize(t_quat<T>(T(value.x) * scale, T(value.y) * scale, T(value.z) * scale, T(value.w) * scale));
+        }
+
+        template<typename T>
+        static int16_t quantize(T v)
+        {
+            return static_cast<int16_t>(std::round(std::clamp(v, T(-1.0), T(1.0)) * T(32767.0)));
+        }
+    };
+
+    /// return the index i of the key frames that bracket time, such that key_time(keys[i]) <= time < key_time(keys[i+1]).
+    /// The search starts from the hint index, stepping forwards/backwards a few keys to take advantage of the coherent times used during animation playback,
+    /// falling back to a binary search when the time has jumped further.
+    /// Requires keys to contain at least two entries and time to lie between the first and last key times.
+    template<typename C, typename F>
+    size_t bracket(double time, const C& keys, size_t hint, F key_time)
+    {
+        size_t i = std::min(hint, keys.size() - 2);
+        for (int step = 0; step < 4; ++step)
+        {
+            if (time < key_time(keys[i]))
+                --i;
+            else if (time >= key_time(keys[i + 1]))
+                ++i;
+            else
+                return i;
+        }
+
+        if (key_time(keys[i]) <= time && time < key_time(keys[i + 1])) return i;
+
+        using key_type = typename C::value_type;
+        auto itr = std::upper_bound(keys.begin(), keys.end(), time, [&key_time](double t, const key_type& key) -> bool { return t < key_time(key); });
+        return static_cast<size_t>(itr - keys.begin()) - 1;
+    }
+
     template<typename T, typename V>
     bool sample(double time, const T& values, V& value)
     {
@@ -79,4 +164,67 @@ namespace vsg
         }
     }
 
+    /// sample values at the specified time, using index as the cached position of the last sample to accelerate the search of coherent times.
+    template<typename T, typename V>
+    bool sample(double time, const std::vector<time_value<T>>& values, V& value, size_t& index)
+    {
+        if (values.empty()) return false;
+
+        if (values.size() == 1 || time <= values.front().time)
+        {
+            index = 0;
+            value = values.front().value;
+            return true;
+        }
+
+        if (time >= values.back().time)
+        {
+            index = values.size() - 1;
+            value = values.back().value;
+            return true;
+        }
+
+        index = bracket(time, values, index, [](const time_value<T>& key) { return key.time; });
+
+        const auto& before = values[index];
+        const auto& after = values[index + 1];
+        double delta_time = (after.time - before.time);
+        double r = delta_time != 0.0 ? (time - before.time) / delta_time : 0.5;
+
+        value = mix(before.value, after.value, r);
+
+        return true;
+    }
+
+    /// sample compact key frames at the specified time, converting the stored values to the type of value, using index as the cached position of the last sample.
+    template<typename T, typename V>
+    bool sample(double time, const time_values<T>& keys, V& value, size_t& index)
+    {
+        const auto& times = keys.times;
+        if (times.empty()) return false;
+
+        if (times.size() == 1 || time <= times.front())
+        {
+            index = 0;
+            value = V(keys.values.front());
+            return true;
+        }
+
+        if (time >= times.back())
+        {
+            index = times.size() - 1;
+            value = V(keys.values.back());
+            return true;
+        }
+
+        index = bracket(time, times, index, [](double t) { return t; });
+
+        double delta_time = (times[index + 1] - times[index]);
+        double r = delta_time != 0.0 ? (time - times[index]) / delta_time : 0.5;
+
+        value = mix(V(keys.values[index]), V(keys.values[index + 1]), r);
+
+        return true;
+    }
+
 } // namespace vsg
@@ -14,11 +14,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/app/Camera.h>
 #include <vsg/app/Window.h>
+#include <vsg/core/observer_ptr.h>
 #include <vsg/core/Export.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/nodes/Group.h>
 #include <vsg/utils/Instrumentation.h>
 #include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/CommandPoolRing.h>
 
 namespace vsg
 {
@@ -53,10 +55,47 @@ namespace vsg
         /// hook for assigning Instrumentation to enable profiling of record traversal.
         ref_ptr<Instrumentation> instrumentation;
 
+        /// when true the command buffers recorded for each framebuffer/swapchain image are retained and resubmitted, skipping the RecordTraversal,
+        /// while the subgraph is unchanged according to ChangeTracker::hasChanged(this) and the projection and view matrices of its Views are unchanged.
+        /// Intended for static subgraphs such as overlays, the CommandGraph must be tracked by a ChangeTracker through which all changes to the subgraph are made,
+        /// with ChangeTracker::clear() called after recordAndSubmit(), untracked CommandGraphs are always re-recorded.
+        bool reuseCommandBuffers = false;
+
+        /// discard the retained command buffers so the next record() re-records the subgraph.
+        void releaseRecordedCommandBuffers();
+
     protected:
         virtual ~CommandGraph();
 
-        CommandBuffers _commandBuffers; // assign one per index? Or just use round robin, each has a CommandPool
+        CommandBuffers _commandBuffers; // command buffers used when reuseCommandBuffers is enabled, each has its own CommandPool so can be retained independently
+
+        /// CommandPools that the command buffers are recorded to when reuseCommandBuffers is disabled, reset once per record() rather than per CommandBuffer.
+        ref_ptr<CommandPoolRing> _commandPoolRing;
+
+        struct RecordedCommandBuffer
+        {
+            const Object* target = nullptr; // framebuffer or swapchain image view that the command buffer was recorded for
+            ref_ptr<CommandBuffer> commandBuffer;
+        };
+
+        struct RecordedView
+        {
+            observer_ptr<View> view;
+            dmat4 projectionMatrix;
+            dmat4 viewMatrix;
+        };
+
+        std::vector<RecordedCommandBuffer> _recordedCommandBuffers;
+        std::vector<RecordedView> _recordedViews;
+
+        /// return the retained CommandBuffer recorded for target if reuseCommandBuffers is enabled and nothing has changed since it was recorded, otherwise return nullptr.
+        ref_ptr<CommandBuffer> _reuseCommandBuffer(const Object* target);
+
+        /// return an available CommandBuffer to record to, excluding the CommandBuffers retained for reuse.
+        ref_ptr<CommandBuffer> _availableCommandBuffer();
+
+        /// retain the CommandBuffer just recorded for target when reuseCommandBuffers is enabled.
+        void _retainCommandBuffer(const Object* target, ref_ptr<CommandBuffer> commandBuffer);
     };
     VSG_type_name(vsg::CommandGraph);
 
@@ -65,4 +104,11 @@ namespace vsg
     /// convenience function that sets up RenderGraph inside primary CommandGraph to render the specified scene graph from the specified Camera view
     extern VSG_DECLSPEC ref_ptr<CommandGraph> createCommandGraphForView(ref_ptr<Window> window, ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE, bool assignHeadlight = true);
 
+    /// convenience function that splits the rendering of the specified scene graph from the specified Camera view into columns x rows tiles of the window,
+    /// each rendered by a View, RenderGraph and CommandGraph of its own so the tiles are culled and recorded independently, and in parallel when Viewer::setupThreading() is used.
+    /// Each tile's Camera uses a TileProjection of the camera's projectionMatrix and shares its viewMatrix, so updates to the camera apply to all the tiles.
+    /// The tiles after the first use a RenderPass that preserves the parts of the swapchain image rendered by the previous tiles, so the CommandGraphs must be
+    /// submitted in the order returned. Windows using dynamicRendering are not supported.
+    extern VSG_DECLSPEC CommandGraphs createTiledCommandGraphs(ref_ptr<Window> window, ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, uint32_t columns, uint32_t rows, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE, bool assignHeadlight = true);
+
 } // namespace vsg
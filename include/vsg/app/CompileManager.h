@@ -63,6 +63,10 @@ namespace vsg
         /// assign Instrumentation to all CompileTraversal and their associated Context
         void assignInstrumentation(ref_ptr<Instrumentation> in_instrumentation);
 
+        /// assign OperationThreads to all CompileTraversal and their associated Context so that pipelines are created in parallel with the compile traversal.
+        /// if asynchronousPipelines is true compiles don't wait for GraphicsPipeline creation to complete, so streamed in subgraphs can be merged before their pipelines are ready.
+        void assignOperationThreads(ref_ptr<OperationThreads> in_operationThreads, bool in_asynchronousPipelines = false);
+
         using ContextSelectionFunction = std::function<bool(vsg::Context&)>;
 
         /// compile object
@@ -49,6 +49,12 @@ namespace vsg
         /// Hook for assigning Instrumentation to enable profiling
         ref_ptr<Instrumentation> instrumentation;
 
+        /// OperationThreads, when assigned, that the Context use to create pipelines in parallel with the rest of the traversal.
+        ref_ptr<OperationThreads> operationThreads;
+
+        /// when true, and operationThreads are assigned, the compile doesn't wait for GraphicsPipeline to be created, see Context::asynchronousPipelines.
+        bool asynchronousPipelines = false;
+
         /// add a compile Context for device
         void add(ref_ptr<Device> device, ref_ptr<TransferTask> transferTask, const ResourceRequirements& resourceRequirements = {});
 
@@ -81,6 +87,9 @@ namespace vsg
 
         Instrumentation* getInstrumentation() override { return instrumentation.get(); }
 
+        /// assign OperationThreads and asynchronous pipeline setting to all Context
+        void assignOperationThreads(ref_ptr<OperationThreads> in_operationThreads, bool in_asynchronousPipelines = false);
+
         virtual bool record();
         virtual void waitForCompletion();
 
@@ -97,6 +106,7 @@ namespace vsg
         void apply(Compilable& node) override;
         void apply(Commands& commands) override;
         void apply(Geometry& geometry) override;
+        void apply(LazyCompileGroup& lcg) override;
         void apply(CommandGraph& commandGraph) override;
         void apply(SecondaryCommandGraph& secondaryCommandGraph) override;
         void apply(RenderGraph& renderGraph) override;
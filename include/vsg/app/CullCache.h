@@ -0,0 +1,90 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Inherit.h>
+#include <vsg/maths/mat4.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace vsg
+{
+    class Node;
+
+    /// CullCache records the view frustum, occlusion and LOD culling results of a View's RecordTraversal so that they can be reused when the View is traversed again
+    /// with the same culling projection and view matrices and LODScale, such as for a static camera, avoiding repeated culling of large scene graphs.
+    /// Results are recorded in traversal order along with the Node they were computed for, and the matrices of Transforms with culled subgraphs,
+    /// so changes to the scene graph structure, Switch settings or transform matrices are detected and the affected results recomputed.
+    /// PagedLOD, DepthSorted and PackedSubgraph nodes and the subgraphs of ParallelGroup batches are always culled afresh.
+    /// Changes to the bounds of CullGroup, CullNode or LOD nodes, or to the Occluders that cull them, are not detected so call dirty() when they change.
+    /// Assign to View::cullCache, sharing a CullCache between sibling Views that also share a View::cullingCamera, such as the Views of a stereo pair,
+    /// lets the culling be done once by the first View and reused by the others. Views sharing a CullCache are traversed one at a time.
+    class VSG_DECLSPEC CullCache : public Inherit<Object, CullCache>
+    {
+    public:
+        CullCache();
+
+        /// number of cull results reused and computed during the last traversal
+        uint32_t numResultsReused = 0;
+        uint32_t numResultsComputed = 0;
+
+        /// discard the cached results so they are all recomputed on the next traversal.
+        void dirty();
+
+        /// begin a traversal, prior results are reused if the projection and view matrices and LODScale match those used when they were computed.
+        /// Locks the CullCache until end() is called.
+        void begin(const dmat4& projection, const dmat4& view, double LODScale);
+
+        /// end the traversal, discarding any results not visited and unlocking the CullCache.
+        void end();
+
+        /// return true and assign value if a result was cached for node at the current position in the traversal,
+        /// otherwise discard the remaining cached results so that subsequent results are computed and added with store(..).
+        bool lookup(const Node* node, int32_t& value);
+
+        /// add a newly computed result for node.
+        void store(const Node* node, int32_t value);
+
+        /// check that the matrix of a Transform node matches the matrix recorded for it, discarding the remaining cached results if it doesn't.
+        void validate(const Node* node, const dmat4& matrix);
+
+    protected:
+        virtual ~CullCache();
+
+        void _discardRemaining();
+
+        struct Entry
+        {
+            const Node* node = nullptr;
+            int32_t value = 0;
+        };
+
+        std::mutex _mutex;
+        std::atomic_bool _dirty{false};
+        bool _valid = false;
+        bool _reusing = false;
+        dmat4 _projection;
+        dmat4 _view;
+        double _LODScale = 1.0;
+
+        std::vector<Entry> _entries;
+        std::vector<dmat4> _matrices;
+        size_t _position = 0;
+        size_t _matrixPosition = 0;
+    };
+    VSG_type_name(vsg::CullCache);
+
+} // namespace vsg
@@ -0,0 +1,91 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/CommandGraph.h>
+#include <vsg/app/RenderGraph.h>
+#include <vsg/utils/FrameStatistics.h>
+#include <vsg/vk/Framebuffer.h>
+
+namespace vsg
+{
+
+    /// DynamicResolution renders a View to an offscreen color and depth Framebuffer at a fraction of the Window's resolution and upscales the result
+    /// to the Window's swapchain image with a linear filtered blit, trading resolution for GPU time on fill rate bound scenes.
+    /// The scale is adjusted each frame by update(..) to keep the GPU time measured by a Profiler's FrameStatistics close to targetGPUTime.
+    /// The Window's swapchain must be created with VK_IMAGE_USAGE_TRANSFER_DST_BIT in WindowTraits::swapchainPreferences.imageUsage,
+    /// and the scene graph compiled with the default dynamic ViewportState so scale changes don't require the pipelines to be recompiled.
+    class VSG_DECLSPEC DynamicResolution : public Inherit<Object, DynamicResolution>
+    {
+    public:
+        explicit DynamicResolution(ref_ptr<Window> in_window);
+
+        ref_ptr<Window> window;
+
+        /// format of the offscreen color attachment, defaults to the Window's surface format
+        VkFormat colorFormat = VK_FORMAT_UNDEFINED;
+
+        /// fraction of the Window's width and height rendered
+        double scale = 1.0;
+        double minScale = 0.5;
+        double maxScale = 1.0;
+
+        /// GPU time in milliseconds that update(..) adjusts scale to achieve, 0.0 disables the adjustment
+        double targetGPUTime = 0.0;
+
+        /// fraction of targetGPUTime within which the measured GPU time is accepted without adjusting scale
+        double tolerance = 0.05;
+
+        /// fraction of each computed scale change applied per update, lower values respond more slowly but avoid oscillating between resolutions
+        double damping = 0.25;
+
+        /// name of the FrameStatistics metric used by update(const FrameStatistics&), sampled by the Profiler for the RenderGraph's GPU instrumentation
+        std::string statisticName = "RenderGraph gpu ms";
+
+        ref_ptr<RenderPass> renderPass;
+        ref_ptr<Image> colorImage;
+        ref_ptr<ImageView> colorImageView;
+        ref_ptr<Image> depthImage;
+        ref_ptr<ImageView> depthImageView;
+        ref_ptr<Framebuffer> framebuffer;
+
+        ref_ptr<Camera> camera;
+        ref_ptr<RenderGraph> renderGraph;
+
+        /// extent of the region of the framebuffer rendered to at the current scale
+        VkExtent2D scaledExtent() const;
+
+        /// create a RenderGraph rendering a View of the scenegraph to the offscreen framebuffer
+        ref_ptr<RenderGraph> createRenderGraphForView(ref_ptr<Camera> in_camera, ref_ptr<Node> scenegraph, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE, bool assignHeadlight = true);
+
+        /// create a CommandGraph for the Window containing the RenderGraph from createRenderGraphForView(..) followed by the upscaling blit to the Window's swapchain image
+        ref_ptr<CommandGraph> createCommandGraphForView(ref_ptr<Camera> in_camera, ref_ptr<Node> scenegraph, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE, bool assignHeadlight = true);
+
+        /// adjust scale towards the targetGPUTime given the measured GPU time of the last frame in milliseconds, then call apply().
+        virtual void update(double gpuTime);
+
+        /// adjust scale using the last value of the statisticName metric, call after Viewer::update() and before Viewer::recordAndSubmit().
+        void update(const FrameStatistics& statistics);
+
+        /// reallocate the framebuffer if the Window has been resized, and set the camera's viewport and the renderGraph's renderArea to the scaledExtent().
+        virtual void apply();
+
+    protected:
+        virtual ~DynamicResolution();
+
+        void _initRenderPass();
+        void _initFramebuffer(const VkExtent2D& extent);
+    };
+    VSG_type_name(vsg::DynamicResolution);
+
+} // namespace vsg
@@ -0,0 +1,63 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/Commands.h>
+#include <vsg/core/Objects.h>
+#include <vsg/io/Options.h>
+
+#include <mutex>
+
+namespace vsg
+{
+
+    /// FrameCapture captures the sequence of commands that the RecordTraversal records for each View during a requested frame
+    /// so that they can be written to file and replayed independently of the scene graph traversal, for instance to profile the GPU side of a frame spike.
+    /// Assign to RecordTraversal::frameCapture to enable, then call request() to capture the next frame.
+    /// Each View is captured as a vsg::Commands containing the state commands, draws and other commands in the order recorded,
+    /// with the projection and modelview matrices captured as PushConstants.
+    /// To replay, read the Objects back from file and add the Commands to a View with a compatible RenderGraph, the Commands are recorded as is each frame.
+    /// Commands recorded into secondary CommandBuffers by ParallelGroup batches and InstanceDraw/InstanceDrawIndexed are not captured.
+    class VSG_DECLSPEC FrameCapture : public Inherit<Object, FrameCapture>
+    {
+    public:
+        FrameCapture();
+
+        /// request that the next frame recorded is captured
+        void request();
+
+        /// return true if the frame with frameCount is being captured, called by RecordTraversal at the start of each View
+        bool capturing(uint64_t frameCount);
+
+        /// add the commands captured for a View, called by RecordTraversal at the end of each View
+        void add(ref_ptr<Commands> commands);
+
+        /// frameCount of the most recently captured frame
+        uint64_t frameCount() const;
+
+        /// return the Commands, one for each View, of the most recently captured frame
+        ref_ptr<Objects> captured() const;
+
+        /// write the most recently captured frame to file, call after the frame has been recorded so the dynamic data written matches that captured.
+        bool write(const Path& filename, ref_ptr<const Options> options = {}) const;
+
+    protected:
+        mutable std::mutex _mutex;
+        bool _requested = false;
+        bool _active = false;
+        uint64_t _frameCount = 0;
+        ref_ptr<Objects> _captured;
+    };
+    VSG_type_name(vsg::FrameCapture);
+
+} // namespace vsg
@@ -0,0 +1,95 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Event.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/vk/DeviceMemory.h>
+
+namespace vsg
+{
+
+    /// FrameGraph records a sequence of passes, such as compute dispatches or RenderGraphs, inserting the pipeline barriers between them that are implied by
+    /// how each pass declares it reads and writes its buffers and images, rather than application code inserting PipelineBarrier commands manually.
+    /// Barriers needed before a pass are batched into a single PipelineBarrier, when the pass that last accessed a resource isn't the immediately preceding one
+    /// a split barrier is used, with a SetEvent after the source pass and a WaitEvents before the destination pass, so that the passes in between can overlap.
+    /// Transient resources, whose contents don't need to persist between frames, are allocated by build() from a shared DeviceMemory, with resources whose lifetimes
+    /// don't overlap aliasing the same memory. Transient images and buffers must not be compiled before build() is called.
+    /// Add the FrameGraph to a CommandGraph once build() has been called, its children are the generated barrier commands and the pass nodes.
+    class VSG_DECLSPEC FrameGraph : public Inherit<Group, FrameGraph>
+    {
+    public:
+        FrameGraph();
+
+        struct Resource
+        {
+            /// either image or buffer is assigned
+            ref_ptr<Image> image;
+            ref_ptr<Buffer> buffer;
+
+            /// when true the contents of the resource are only used within a frame, so its memory may be aliased by build()
+            bool transient = false;
+
+            /// layout the image is in at the start of each frame, VK_IMAGE_LAYOUT_UNDEFINED discards its contents on first use.
+            VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            /// when set the image is transitioned to finalLayout at the end of the frame
+            VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        };
+
+        /// declaration of how a pass accesses a resource
+        struct Access
+        {
+            uint32_t resource = 0;
+            VkPipelineStageFlags stageMask = 0;
+            VkAccessFlags accessMask = 0;
+
+            /// layout the pass requires an image to be in
+            VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        };
+
+        struct Pass
+        {
+            ref_ptr<Node> node;
+            std::vector<Access> accesses;
+        };
+
+        std::vector<Resource> resources;
+        std::vector<Pass> passes;
+
+        /// use SetEvent/WaitEvents pairs for barriers between non adjacent passes, otherwise all barriers are PipelineBarrier recorded just before the pass.
+        bool splitBarriers = true;
+
+        /// add a resource, returning its index for use in Access::resource
+        uint32_t addImage(ref_ptr<Image> image, bool transient, VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED, VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED);
+        uint32_t addBuffer(ref_ptr<Buffer> buffer, bool transient);
+
+        /// add a pass, returning its index
+        uint32_t addPass(ref_ptr<Node> node, const std::vector<Access>& accesses);
+
+        /// allocate the aliased memory of the transient resources, compute the barriers and set up the children in execution order.
+        void build(Device* device);
+
+        /// DeviceMemory shared by the transient resources, one per set of compatible memory types.
+        std::vector<ref_ptr<DeviceMemory>> transientMemory;
+
+        /// total size of the transient resources if they weren't aliased, compare with the size of the transientMemory to see the saving.
+        VkDeviceSize unaliasedTransientSize = 0;
+
+    protected:
+        virtual ~FrameGraph();
+    };
+    VSG_type_name(vsg::FrameGraph);
+
+} // namespace vsg
@@ -0,0 +1,86 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/Presentation.h>
+#include <vsg/ui/UIEvent.h>
+#include <vsg/utils/Instrumentation.h>
+
+#include <deque>
+
+namespace vsg
+{
+
+    /// FramePacing controls the start of each frame to minimize the latency between the polling of input events and the display of the resulting frame.
+    /// Assign to Viewer::framePacing. Waiting on the display of frames requires the Window's Device to be created with the VK_KHR_present_id and
+    /// VK_KHR_present_wait extensions and their presentId and presentWait features, via WindowTraits::deviceExtensionNames and WindowTraits::deviceFeatures,
+    /// when these aren't available FramePacing does nothing. Best used with the VK_PRESENT_MODE_MAILBOX_KHR or VK_PRESENT_MODE_FIFO_KHR present modes.
+    class VSG_DECLSPEC FramePacing : public Inherit<Object, FramePacing>
+    {
+    public:
+        FramePacing();
+
+        /// maximum number of frames presented but not yet displayed when a new frame is started, the fewer the lower the latency,
+        /// but the less slack there is for absorbing variations in frame time.
+        uint32_t maxFramesInFlight = 1;
+
+        /// when true delay the start of each frame so that it's presented just in time for the display refresh it will be displayed on.
+        bool justInTime = true;
+
+        /// time in seconds reserved for the GPU rendering and variations in CPU frame time when computing the just in time frame start.
+        double safetyMargin = 0.004;
+
+        /// weighting of each new measurement in the exponentially smoothed frameDuration and refreshInterval.
+        double smoothing = 0.1;
+
+        /// timeout in nanoseconds for each wait on the display of a frame.
+        uint64_t presentWaitTimeout = 100000000;
+
+        /// measured duration in seconds from the start of the frame to its present.
+        double frameDuration = 0.0;
+
+        /// measured interval in seconds between the display of consecutive frames.
+        double refreshInterval = 0.0;
+
+        /// measured latency in seconds from the start of the last displayed frame to it being displayed.
+        double latency = 0.0;
+
+        /// wait till the number of frames waiting to be displayed is no more than maxFramesInFlight and, if justInTime is set, till the just in time start of the next frame.
+        /// Called by Viewer::advanceToNextFrame() before polling events.
+        virtual void waitForFrameStart(const std::vector<ref_ptr<Presentation>>& presentations, const Instrumentation* instrumentation = nullptr);
+
+        /// record the present ids of the frame just presented, called by Viewer::present() after the Presentation::present() calls.
+        virtual void presented(const std::vector<ref_ptr<Presentation>>& presentations, const Instrumentation* instrumentation = nullptr);
+
+        /// discard the frames waiting to be displayed, call when swapchains are recreated.
+        void reset();
+
+    protected:
+        virtual ~FramePacing();
+
+        struct PresentedFrame
+        {
+            clock::time_point frameStart;
+            std::vector<Presentation::PresentId> presentIds;
+        };
+
+        std::deque<PresentedFrame> _presentedFrames;
+        clock::time_point _frameStart;
+        clock::time_point _lastDisplayed;
+        bool _frameStarted = false;
+        bool _displayed = false;
+    };
+    VSG_type_name(vsg::FramePacing);
+
+} // namespace vsg
@@ -0,0 +1,151 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/Window.h>
+#include <vsg/commands/Command.h>
+#include <vsg/commands/Event.h>
+#include <vsg/state/Buffer.h>
+#include <vsg/state/ComputePipeline.h>
+#include <vsg/threading/ActivityStatus.h>
+#include <vsg/vk/DescriptorPool.h>
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <thread>
+
+namespace vsg
+{
+
+    /// FrameReadback command copies the current swapchain image of a Window into a ring of persistently mapped host visible buffers,
+    /// handing each completed frame to a background thread that invokes the callback, so screenshots and video capture don't stall the Viewer.
+    /// Completion of each readback is tracked with a vsg::Event that is polled without blocking at the start of each record, if all the buffers
+    /// are still in flight or being processed by the callback the frame is dropped rather than waiting. When pixelFormat is YUV420 the image
+    /// is converted to planar BT.709 limited range YUV 4:2:0 by a compute shader ahead of the copy to the host, halving the bytes read back.
+    /// The swapchain must be created with VK_IMAGE_USAGE_TRANSFER_SRC_BIT, which prepare(WindowTraits&) assigns.
+    /// Usage:
+    ///     FrameReadback::prepare(*windowTraits);
+    ///     auto frameReadback = vsg::FrameReadback::create(window);
+    ///     frameReadback->callback = [&](const vsg::FrameReadback::Frame& frame) { encoder.write(frame); };
+    ///     commandGraph->addChild(frameReadback); // after the RenderGraph
+    ///     frameReadback->start();
+    class VSG_DECLSPEC FrameReadback : public Inherit<Command, FrameReadback>
+    {
+    public:
+        explicit FrameReadback(ref_ptr<Window> in_window, uint32_t in_numBuffers = 3);
+
+        enum PixelFormat
+        {
+            IMAGE_FORMAT, /// pixels in the format of the swapchain image, see Frame::imageFormat
+            YUV420        /// planar 8 bit Y, U and V planes with the U and V planes subsampled by 2 in each dimension
+        };
+
+        /// details of a frame passed to the callback, the data is only valid for the duration of the callback.
+        struct Frame
+        {
+            const uint8_t* data = nullptr;
+            VkDeviceSize size = 0;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            PixelFormat pixelFormat = IMAGE_FORMAT;
+            VkFormat imageFormat = VK_FORMAT_UNDEFINED;
+            uint64_t frameNumber = 0;
+
+            /// byte offset and row stride of each plane, IMAGE_FORMAT frames only have the first plane.
+            VkDeviceSize planeOffsets[3] = {0, 0, 0};
+            uint32_t planeStrides[3] = {0, 0, 0};
+        };
+
+        using Callback = std::function<void(const Frame& frame)>;
+
+        ref_ptr<Window> window;
+        const uint32_t numBuffers;
+
+        PixelFormat pixelFormat = IMAGE_FORMAT;
+
+        /// callback invoked on the background thread for each frame read back.
+        Callback callback;
+
+        /// when false no frames are read back.
+        bool active = true;
+
+        /// read back every captureInterval frames, a value of 2 reads back every other frame.
+        uint32_t captureInterval = 1;
+
+        /// number of frames not read back as no buffer was available.
+        std::atomic_uint64_t numDroppedFrames{0};
+
+        /// number of frames passed to the callback.
+        std::atomic_uint64_t numCapturedFrames{0};
+
+        /// assign the swapchain image usage required to read back the swapchain images.
+        static void prepare(WindowTraits& traits);
+
+        /// start the background thread that invokes the callback.
+        void start();
+
+        /// stop the background thread, frames that have been read back but not yet passed to the callback are discarded.
+        void stop();
+
+        /// check, without blocking, for readbacks that have completed and pass them to the background thread, called automatically by record(..).
+        void poll() const;
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~FrameReadback();
+
+        enum SlotStatus
+        {
+            AVAILABLE,
+            IN_FLIGHT,
+            COMPLETED
+        };
+
+        struct Slot
+        {
+            ref_ptr<Buffer> buffer;
+            uint8_t* mappedData = nullptr;
+            ref_ptr<Event> event;
+            ref_ptr<DescriptorSet::Implementation> descriptorSet;
+            SlotStatus status = AVAILABLE;
+            Frame frame;
+        };
+
+        bool _allocate(Slot& slot, const VkExtent2D& extent, VkFormat imageFormat, PixelFormat format) const;
+        void _retire(ref_ptr<Object> object) const;
+        Slot* _takeCompleted();
+
+        ref_ptr<ActivityStatus> _status;
+        std::thread _thread;
+
+        mutable std::mutex _mutex;
+        mutable std::condition_variable _completedCV;
+        mutable std::vector<Slot> _slots;
+        mutable std::list<Slot*> _completed;
+        mutable uint64_t _frameNumber = 0;
+
+        // buffers and descriptor sets replaced on resize, released once the frames that may still reference them have completed
+        mutable std::list<std::pair<uint64_t, ref_ptr<Object>>> _retired;
+
+        // compute conversion to YUV420
+        ref_ptr<ComputePipeline> _pipeline;
+        ref_ptr<DescriptorSetLayout> _descriptorSetLayout;
+        ref_ptr<DescriptorPool> _descriptorPool;
+        mutable ref_ptr<Buffer> _sourceBuffer;
+    };
+    VSG_type_name(vsg::FrameReadback);
+
+} // namespace vsg
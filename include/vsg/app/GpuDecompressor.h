@@ -0,0 +1,86 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/CompressedData.h>
+#include <vsg/core/Objects.h>
+#include <vsg/state/ComputePipeline.h>
+#include <vsg/state/ImageView.h>
+
+namespace vsg
+{
+
+    // forward declare
+    class MipmapGenerator;
+
+    /** GpuDecompressor decompresses the LZ4 compressed payloads of CompressedData on the GPU, so TransferTask can upload the compressed bytes as is,
+      * saving CPU time on the loading threads and transfer bandwidth. The chunks of the payloads uploaded by a transfer are decoded by a single dispatch, split only when the payloads exceed maxStorageBufferRange,
+      * each workgroup decoding one chunk with the sequences parsed by its first invocation and the literals and matches copied by all of them.
+      * The payloads are decompressed into a device local scratch buffer and then copied to the destination Buffer or Image, as images with optimal tiling
+      * can't be written as buffers and decoding in place would require storage usage on every destination buffer.*/
+    class VSG_DECLSPEC GpuDecompressor : public Inherit<Object, GpuDecompressor>
+    {
+    public:
+        explicit GpuDecompressor(Device* in_device);
+
+        ref_ptr<Device> device;
+
+        /// return true if the payload of data can be decompressed by the compute shader, creating the compute pipeline on first use.
+        bool supported(const CompressedData& data);
+
+        /// add the decompression of data, whose payload has been copied to stagingBuffer at stagingOffset, to buffer at offset.
+        void add(ref_ptr<CompressedData> data, ref_ptr<Buffer> stagingBuffer, VkDeviceSize stagingOffset, ref_ptr<Buffer> buffer, VkDeviceSize offset);
+
+        /// add the decompression of data, whose payload has been copied to stagingBuffer at stagingOffset, to the image of imageView which is then transitioned to targetImageLayout.
+        void add(ref_ptr<CompressedData> data, ref_ptr<Buffer> stagingBuffer, VkDeviceSize stagingOffset, ref_ptr<ImageView> imageView, VkImageLayout targetImageLayout, uint32_t mipLevels);
+
+        /// return true if no payloads are waiting to be decompressed.
+        bool empty() const { return _entries.empty(); }
+
+        /// record the dispatch that decompresses all the payloads added since the previous record and the copies to their destinations,
+        /// the mipmaps of images are generated with mipmapGenerator when it's provided and supports them.
+        /// Returns the scratch buffer, parameter buffer and descriptor set used by the commands, these must be kept until the commandBuffer has completed.
+        ref_ptr<Objects> record(VkCommandBuffer commandBuffer, MipmapGenerator* mipmapGenerator = nullptr);
+
+        /// number of compressed bytes uploaded and decompressed bytes written since the GpuDecompressor was created.
+        uint64_t numCompressedBytes = 0;
+        uint64_t numDecompressedBytes = 0;
+
+    protected:
+        virtual ~GpuDecompressor();
+
+        struct Entry
+        {
+            ref_ptr<CompressedData> data;
+            ref_ptr<Buffer> stagingBuffer;
+            VkDeviceSize stagingOffset = 0;
+            ref_ptr<Buffer> buffer;
+            VkDeviceSize offset = 0;
+            ref_ptr<ImageView> imageView;
+            VkImageLayout targetImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            uint32_t mipLevels = 1;
+        };
+
+        std::vector<Entry> _entries;
+
+        ref_ptr<Context> _context;
+        ref_ptr<DescriptorSetLayout> _descriptorSetLayout;
+        ref_ptr<PipelineLayout> _pipelineLayout;
+        ref_ptr<ComputePipeline> _pipeline;
+        bool _pipelineFailed = false;
+
+        ComputePipeline* _getPipeline();
+    };
+    VSG_type_name(vsg::GpuDecompressor);
+
+} // namespace vsg
@@ -0,0 +1,65 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/CommandGraph.h>
+#include <vsg/app/RenderGraph.h>
+#include <vsg/app/WindowTraits.h>
+#include <vsg/vk/Framebuffer.h>
+
+namespace vsg
+{
+
+    /// Headless sets up the Vulkan Instance, Device and an offscreen color and depth Framebuffer for rendering without a Window, Surface or Swapchain,
+    /// used for automated testing and benchmarking on machines without a display.  The CommandGraph returned by createCommandGraphForView(..) is assigned
+    /// to the Viewer via Viewer::assignRecordAndSubmitTaskAndPresentation(..), and the usual advanceToNextFrame()/handleEvents()/update()/recordAndSubmit()
+    /// frame loop run for a fixed number of frames, with a CameraAnimationHandler playing back the camera path and a Profiler with FrameStatistics
+    /// collecting the per frame CPU and GPU timings.  Viewer::present() is a no op as there are no Presentation.
+    class VSG_DECLSPEC Headless : public Inherit<Object, Headless>
+    {
+    public:
+        /// create the Vulkan objects using the width, height, depthFormat, queueFlags, layers, extensions, features and device type preferences of traits.
+        explicit Headless(ref_ptr<WindowTraits> in_traits);
+
+        ref_ptr<WindowTraits> traits;
+
+        /// format of the offscreen color attachment
+        VkFormat colorFormat = VK_FORMAT_R8G8B8A8_UNORM;
+
+        ref_ptr<Instance> instance;
+        ref_ptr<PhysicalDevice> physicalDevice;
+        ref_ptr<Device> device;
+        int queueFamily = -1;
+
+        ref_ptr<RenderPass> renderPass;
+        ref_ptr<Image> colorImage;
+        ref_ptr<ImageView> colorImageView;
+        ref_ptr<Image> depthImage;
+        ref_ptr<ImageView> depthImageView;
+        ref_ptr<Framebuffer> framebuffer;
+
+        VkExtent2D extent2D() const { return {traits->width, traits->height}; }
+
+        /// create a RenderGraph rendering a View of the scenegraph to the framebuffer
+        ref_ptr<RenderGraph> createRenderGraphForView(ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE, bool assignHeadlight = true);
+
+        /// create a CommandGraph for the device's queueFamily containing the RenderGraph from createRenderGraphForView(..)
+        ref_ptr<CommandGraph> createCommandGraphForView(ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE, bool assignHeadlight = true);
+
+    protected:
+        void _initDevice();
+        void _initFramebuffer();
+    };
+    VSG_type_name(vsg::Headless);
+
+} // namespace vsg
@@ -0,0 +1,94 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/CompileManager.h>
+#include <vsg/core/observer_ptr.h>
+#include <vsg/nodes/LazyCompileGroup.h>
+#include <vsg/threading/ActivityStatus.h>
+#include <vsg/threading/OperationQueue.h>
+
+#include <condition_variable>
+#include <list>
+#include <thread>
+
+namespace vsg
+{
+
+    // forward declare
+    class Viewer;
+
+    /// LazyCompiler compiles the children of LazyCompileGroup on background threads when they first become visible, so large scenes can be rendered
+    /// without first compiling the whole scene graph, and only the parts of the scene that have been seen end up resident on the GPU.
+    /// The RecordTraversal queues visible uncompiled LazyCompileGroup with the LazyCompiler, prioritized by their screen space size,
+    /// the compiled LazyCompileGroup are then merged when the LazyCompiler is run as an update operation.
+    /// Usage:
+    ///     auto lazyCompiler = vsg::LazyCompiler::create(viewer);
+    ///     lazyCompiler->wrapChildren(*scene); // or lazyCompiler->assign(*scene) for scenes that already contain LazyCompileGroup
+    ///     viewer->compile();
+    ///     viewer->addUpdateOperation(lazyCompiler, vsg::UpdateOperations::ALL_FRAMES);
+    ///     lazyCompiler->start();
+    class VSG_DECLSPEC LazyCompiler : public Inherit<Operation, LazyCompiler>
+    {
+    public:
+        explicit LazyCompiler(Viewer* viewer);
+
+        /// CompileManager used to compile the LazyCompileGroup children, assigned from the Viewer by start() if not already set.
+        ref_ptr<CompileManager> compileManager;
+
+        /// number of background threads compiling LazyCompileGroup
+        uint32_t numThreads = 1;
+
+        /// assign this LazyCompiler to all the LazyCompileGroup in a scene graph.
+        void assign(Object& object);
+
+        /// replace each of the children of group with a LazyCompileGroup containing the child, with its bound computed from the child's subgraph, and assign this LazyCompiler to them.
+        void wrapChildren(Group& group);
+
+        /// start the background threads that compile the requested LazyCompileGroup.
+        void start();
+
+        /// stop the background threads.
+        void stop();
+
+        /// called by the RecordTraversal for visible LazyCompileGroup that haven't been compiled yet.
+        void request(const LazyCompileGroup& lcg, double priority);
+
+        /// merge the compiled LazyCompileGroup into the scene graph, invoked as an update operation.
+        void run() override;
+
+        std::atomic_uint64_t numActiveRequests{0};
+        std::atomic_uint64_t numCompiled{0};
+
+    protected:
+        virtual ~LazyCompiler();
+
+        ref_ptr<LazyCompileGroup> _takeRequest();
+        void _compile(ref_ptr<LazyCompileGroup> lcg);
+
+        observer_ptr<Viewer> _viewer;
+
+        ref_ptr<ActivityStatus> _status;
+        std::list<std::thread> _threads;
+
+        std::mutex _requestMutex;
+        std::condition_variable _requestCV;
+        std::list<ref_ptr<LazyCompileGroup>> _requests;
+
+        std::mutex _mergeMutex;
+        std::list<ref_ptr<LazyCompileGroup>> _toMerge;
+        CompileResult _mergeResult;
+    };
+    VSG_type_name(vsg::LazyCompiler);
+
+} // namespace vsg
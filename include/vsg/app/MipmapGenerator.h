@@ -0,0 +1,84 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Objects.h>
+#include <vsg/state/ComputePipeline.h>
+#include <vsg/state/ImageView.h>
+
+namespace vsg
+{
+
+    /** MipmapGenerator generates the mipmap chains of 2D images with a compute shader, batching the images uploaded by a transfer so that each dispatch
+      * downsamples many images and the layout transitions of all the images are recorded in a single barrier before and after the dispatches.
+      * Each dispatch generates up to 12 levels in a single pass: every workgroup reduces a 64x64 tile of the base level to levels 1 to 6,
+      * then the last workgroup to complete for an image reduces level 6 to levels 7 to 12, so images up to 4096x4096 are supported.
+      * Images must be created with VK_IMAGE_USAGE_STORAGE_BIT, and sRGB images with mutable format, which prepare(..) assigns ahead of the Image being compiled.
+      * Indexing the storage image array requires the shaderStorageImageArrayDynamicIndexing device feature to be enabled.*/
+    class VSG_DECLSPEC MipmapGenerator : public Inherit<Object, MipmapGenerator>
+    {
+    public:
+        explicit MipmapGenerator(Device* in_device);
+
+        ref_ptr<Device> device;
+
+        /// maximum number of mipmap levels, including the base level, that can be generated.
+        static constexpr uint32_t maxMipLevels = 13;
+
+        /// maximum number of images downsampled by a single dispatch, clamped by the device's storage image descriptor limits on first use.
+        uint32_t maxImagesPerDispatch = 16;
+
+        /// assign the usage and create flags required for compute mipmap generation to an Image that hasn't yet been compiled.
+        /// returns true if the Image is suitable for compute mipmap generation.
+        bool prepare(Image& image) const;
+
+        /// return true if the mipmaps of imageView can be generated by the compute shader, creating the compute pipeline for its format on first use.
+        bool supported(const ImageView& imageView, uint32_t mipLevels);
+
+        /// add an image, that supported(..) has returned true for, whose base level has been copied to and is in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL layout, it's transitioned to targetImageLayout once its mipmaps have been generated.
+        void add(ref_ptr<ImageView> imageView, VkImageLayout targetImageLayout, uint32_t mipLevels);
+
+        /// return true if no images are waiting to have their mipmaps generated.
+        bool empty() const { return _images.empty(); }
+
+        /// record the barriers and dispatches that generate the mipmaps of all the images added since the previous record.
+        /// Returns the level views, descriptor sets and parameter buffer used by the commands, these must be kept until the commandBuffer has completed.
+        ref_ptr<Objects> record(VkCommandBuffer commandBuffer, VkPipelineStageFlags dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+    protected:
+        virtual ~MipmapGenerator();
+
+        struct ImageToGenerate
+        {
+            ref_ptr<ImageView> imageView;
+            VkImageLayout targetImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            uint32_t mipLevels = 0;
+            uint32_t formatClass = 0;
+            bool srgb = false;
+        };
+
+        std::vector<ImageToGenerate> _images;
+
+        ref_ptr<Context> _context;
+        uint32_t _imagesPerDispatch = 0;
+        ref_ptr<DescriptorSetLayout> _descriptorSetLayout;
+        ref_ptr<PipelineLayout> _pipelineLayout;
+        std::vector<ref_ptr<ComputePipeline>> _pipelines; // indexed by format class
+        std::vector<bool> _pipelineFailed;
+
+        ComputePipeline* _getPipeline(uint32_t formatClass);
+    };
+    VSG_type_name(vsg::MipmapGenerator);
+
+} // namespace vsg
@@ -0,0 +1,86 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/maths/mat4.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Occluder.h>
+
+#include <mutex>
+
+namespace vsg
+{
+
+    /// OcclusionBuffer is a low resolution software depth buffer and hierarchical max depth pyramid used by the RecordTraversal to cull CullGroup, CullNode and LOD
+    /// subgraphs that are hidden behind Occluder nodes. Assign one to View::occlusionBuffer to enable occlusion culling for that View.
+    /// The Occluders visited during a frame are collected with their model matrices, then at the start of the next frame's View traversal they are rasterized
+    /// with the new projection and view matrices so the pyramid is exact for static occluders, while moving occluders lag by a frame.
+    class VSG_DECLSPEC OcclusionBuffer : public Inherit<Object, OcclusionBuffer>
+    {
+    public:
+        explicit OcclusionBuffer(uint32_t in_width = 256, uint32_t in_height = 128);
+
+        /// resolution of the finest level of the depth pyramid
+        const uint32_t width;
+        const uint32_t height;
+
+        /// number of occluder triangles rasterized at the start of the current frame
+        uint32_t numTrianglesRasterized = 0;
+
+        /// rasterize the Occluders collected during the previous frame using the new projection and view matrices and build the depth pyramid,
+        /// called by RecordTraversal::apply(const View&).
+        void begin(const dmat4& projection, const dmat4& view);
+
+        /// add an Occluder visited during the RecordTraversal, modelview is the Occluder's local to eye coordinate transform. Thread safe.
+        void add(const Occluder& occluder, const dmat4& modelview);
+
+        /// return true if the bounding sphere in the local coordinate frame of modelview is entirely behind the rasterized occluders.
+        bool occluded(const dsphere& bound, const dmat4& modelview) const;
+
+        /// clear the depth buffer.
+        void clear();
+
+        /// rasterize a triangle list, mvp is the local to clip coordinate transform. Triangles crossing the near plane are skipped.
+        void rasterize(const dmat4& mvp, const vec3Array& vertices, const Data& indices);
+
+        /// build the max depth pyramid from the depth buffer.
+        void buildPyramid();
+
+    protected:
+        virtual ~OcclusionBuffer();
+
+        struct Level
+        {
+            uint32_t width = 0;
+            uint32_t height = 0;
+            std::vector<float> depths;
+        };
+
+        void _rasterizeTriangle(const dvec3& v0, const dvec3& v1, const dvec3& v2);
+
+        // depths are stored so that larger values are further away, _depthSign is -1 for reverse depth projections
+        double _depthSign = 1.0;
+        dmat4 _projection;
+        dmat4 _inverseViewMatrix;
+        std::vector<Level> _levels;
+
+        using Occluders = std::vector<std::pair<ref_ptr<const Occluder>, dmat4>>;
+
+        std::mutex _mutex;
+        Occluders _occluders;
+        Occluders _previousOccluders;
+    };
+    VSG_type_name(vsg::OcclusionBuffer);
+
+} // namespace vsg
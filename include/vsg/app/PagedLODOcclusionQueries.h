@@ -0,0 +1,101 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/maths/mat4.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/state/GraphicsPipeline.h>
+#include <vsg/state/QueryPool.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace vsg
+{
+
+    /// PagedLODOcclusionQueries suppresses the DatabasePager requests of PagedLOD whose high res child is required by the LOD test but whose bounds are hidden behind the
+    /// rendered scene, so that tiles occluded by nearer terrain or buildings aren't loaded. For each PagedLOD waiting on its high res child the RecordTraversal queues an
+    /// occlusion query, drawing the box enclosing its bounding sphere without color or depth writes after the View's bins have been recorded. The results are read back
+    /// without blocking a few frames later, and while the latest result reports no samples passed the request is withheld. PagedLOD are still rendered with their low res child.
+    /// Assign to View::pagedLODOcclusionQueries before the viewer is compiled, use one per View. The query pools are reset from the host so the device must have the
+    /// Vulkan 1.2 hostQueryReset feature enabled, or VK_EXT_host_query_reset, otherwise the queries are disabled. The View must be recorded inline into a single view,
+    /// single color attachment subpass, views recorded into secondary command buffers or multiview render passes aren't queried.
+    class VSG_DECLSPEC PagedLODOcclusionQueries : public Inherit<Object, PagedLODOcclusionQueries>
+    {
+    public:
+        explicit PagedLODOcclusionQueries(uint32_t in_maxQueriesPerFrame = 256, uint32_t in_numFrames = 4);
+
+        /// maximum number of PagedLOD queried each frame, PagedLOD beyond this aren't queried and request their high res child as normal.
+        const uint32_t maxQueriesPerFrame;
+
+        /// number of frames of query pools cycled through while waiting for results.
+        const uint32_t numFrames;
+
+        /// when true PagedLOD that haven't been queried yet wait for their first result before requesting their high res child, otherwise they request it immediately.
+        bool waitForFirstResult = true;
+
+        /// number of frames a result remains valid, older results are discarded.
+        uint64_t resultLifetime = 60;
+
+        /// statistics of the last frame
+        uint32_t numQueriesRecorded = 0;
+        uint32_t numRequestsSuppressed = 0;
+
+        /// create the pipeline and query pools, called by the CompileTraversal for the View.
+        void compile(Context& context);
+
+        /// read back the completed queries and select the query pool for the new frame, called by RecordTraversal::apply(const View&).
+        void begin(uint64_t frameCount);
+
+        /// return true if the PagedLOD's request for its high res child should be withheld, and queue a query for it. modelview is the PagedLOD's local to eye coordinate transform. Thread safe.
+        bool suppressRequest(const PagedLOD& plod, const dmat4& projection, const dmat4& modelview);
+
+        /// record the queued queries, called by RecordTraversal::apply(const View&) after the View's bins have been recorded.
+        void record(CommandBuffer& commandBuffer);
+
+    protected:
+        virtual ~PagedLODOcclusionQueries();
+
+        struct Query
+        {
+            ref_ptr<const PagedLOD> plod;
+            mat4 mvp;
+        };
+
+        struct Slot
+        {
+            ref_ptr<QueryPool> queryPool;
+            std::vector<Query> queries;
+            bool submitted = false;
+            uint64_t frameCount = 0;
+        };
+
+        struct Result
+        {
+            bool occluded = false;
+            uint64_t frameCount = 0;
+        };
+
+        std::mutex _mutex;
+        std::vector<Slot> _slots;
+        Slot* _currentSlot = nullptr;
+        uint64_t _frameCount = 0;
+        std::unordered_map<const PagedLOD*, Result> _results;
+        std::vector<uint32_t> _samples;
+
+        ref_ptr<GraphicsPipeline> _pipeline;
+        ref_ptr<BindGraphicsPipeline> _bindPipeline;
+    };
+    VSG_type_name(vsg::PagedLODOcclusionQueries);
+
+} // namespace vsg
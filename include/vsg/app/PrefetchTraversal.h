@@ -0,0 +1,146 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/ConstVisitor.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/ui/FrameStamp.h>
+#include <vsg/vk/State.h>
+
+#include <stack>
+#include <vector>
+
+namespace vsg
+{
+    // forward declare
+    class View;
+    class RecordTraversal;
+    class DatabasePager;
+    class CulledPagedLODs;
+
+    /// PrefetchTraversal requests the PagedLOD high res subgraphs that will be required by a View's future viewpoints so that they are loaded before the camera gets there.
+    /// Future viewpoints are either extrapolated from the camera's recent ViewMatrix history, or taken from viewMatrixHints when an application knows the path ahead, such as a flight plan.
+    /// Requests are made at a lower priority than those of the current frame, scaled by priorityScale, and are kept alive by being renewed each frame, so when the predicted
+    /// path changes the requests no longer required expire in the same way as PagedLOD that are no longer visible.
+    /// Assign to View::prefetchTraversal, the RecordTraversal then invokes prefetch(..) after traversing the View. Each View requires its own PrefetchTraversal.
+    class VSG_DECLSPEC PrefetchTraversal : public Inherit<ConstVisitor, PrefetchTraversal>
+    {
+    public:
+        PrefetchTraversal();
+
+        /// how far ahead in seconds to extrapolate the camera motion.
+        double predictionTime = 0.5;
+
+        /// number of intermediate viewpoints to test along the extrapolated path, the last being predictionTime ahead.
+        uint32_t numPredictionSteps = 2;
+
+        /// scale applied to the priority of prefetch requests, keep below 1.0 so requests for the current frame are loaded ahead of prefetch requests.
+        double priorityScale = 0.01;
+
+        /// minimum change in camera position, in world units per frame, or rotation, in radians per frame, to be considered moving.
+        double minimumMotion = 1e-6;
+
+        /// optional view matrices of future viewpoints, when assigned these are used in place of the extrapolated viewpoints.
+        /// Applications should update or clear the hints as the camera progresses along its path.
+        std::vector<dmat4> viewMatrixHints;
+
+        /// view matrices used for the last prefetch
+        std::vector<dmat4> predictedViewMatrices;
+
+        /// number of prefetch requests made during last prefetch
+        uint32_t numRequests = 0;
+
+        /// number of focus requests made during last focus
+        uint32_t numFocusRequests = 0;
+
+        /// compute the future viewpoints of the View and request any PagedLOD high res subgraphs required by them.
+        void prefetch(const View& view, RecordTraversal& recordTraversal);
+
+        /// request the PagedLOD high res subgraphs within the focus area of each RegionOfInterest found during the RecordTraversal of the View, see RegionOfInterest::focusRadius.
+        /// Invoked by the RecordTraversal after traversing a View that contains RegionOfInterest with a focusRadius, whether or not the View has a prefetchTraversal assigned.
+        void focus(const View& view, RecordTraversal& recordTraversal);
+
+        /// discard the ViewMatrix history so the next prefetch(..) restarts the extrapolation, call when the camera jumps to a new position.
+        void reset();
+
+        void apply(const Node& node) override;
+        void apply(const CullGroup& cullGroup) override;
+        void apply(const CullNode& cullNode) override;
+        void apply(const LOD& lod) override;
+        void apply(const PagedLOD& plod) override;
+        void apply(const Transform& transform) override;
+
+    protected:
+        virtual ~PrefetchTraversal();
+
+        void _predictViewMatrices(const dmat4& viewMatrix, const FrameStamp& frameStamp);
+
+        /// set up the settings shared by prefetch(..) and focus(..), returns false if there is nothing to request.
+        bool _begin(const View& view, RecordTraversal& recordTraversal);
+
+        bool _previousValid = false;
+        dmat4 _previousViewMatrix;
+        time_point _previousTime = {};
+
+        dmat4 _projectionMatrix;
+        Frustum _frustumProjected;
+        std::stack<dmat4> _modelviewMatrixStack;
+        std::stack<Frustum> _frustumStack;
+
+        double _LODScale = 1.0;
+        double _screenSpaceErrorScale = 0.0; // matches RecordTraversal's screen space error LOD selection
+        double _requestPriorityScale = 0.01;
+
+        // when _focusRadius is non zero subgraphs are selected by their distance from the origin of the focus view matrix rather than the view frustum
+        double _focusRadius = 0.0;
+        double _focusLodScale = 1.0;
+        uint64_t _focusMemory = 0;
+        uint64_t _focusMemoryBudget = 0;
+        uint64_t _frameCount = 0;
+        DatabasePager* _databasePager = nullptr;
+        CulledPagedLODs* _culledPagedLODs = nullptr;
+
+        /// return true if the sphere is within the frustum, or within the focus area when focusing.
+        bool _intersect(const dsphere& sphere) const
+        {
+            if (_focusRadius == 0.0) return _frustumStack.top().intersect(sphere);
+
+            const auto& mv = _modelviewMatrixStack.top();
+            double scale = length(dvec3(mv[0][0], mv[0][1], mv[0][2]));
+            return length(mv * sphere.center) <= _focusRadius + sphere.radius * scale;
+        }
+
+        /// return -1.0 if sphere is outside the frustum, otherwise return the lod distance.
+        double _lodDistance(const dsphere& sphere) const
+        {
+            if (_focusRadius > 0.0)
+            {
+                // distance from the focus in all directions, scaled to match the frustum's screen height based lod distance
+                if (!_intersect(sphere)) return -1.0;
+
+                const auto& mv = _modelviewMatrixStack.top();
+                double scale = length(dvec3(mv[0][0], mv[0][1], mv[0][2]));
+                return length(mv * sphere.center) * _focusLodScale / scale;
+            }
+
+            const auto& frustum = _frustumStack.top();
+            if (!frustum.intersect(sphere)) return -1.0;
+
+            const auto& lodScale = frustum.lodScale;
+            return std::abs(lodScale[0] * sphere.x + lodScale[1] * sphere.y + lodScale[2] * sphere.z + lodScale[3]);
+        }
+    };
+    VSG_type_name(vsg::PrefetchTraversal);
+
+} // namespace vsg
@@ -23,10 +23,20 @@ namespace vsg
     public:
         VkResult present();
 
+        /// present the swapchains of all the presentations, combining the presentations that share a Queue into a single vkQueuePresentKHR call.
+        static VkResult present(const std::vector<ref_ptr<Presentation>>& presentations);
+
         Windows windows;
         Semaphores waitSemaphores; // taken from RecordAndSubmitTasks.signalSemaphores
 
         ref_ptr<Queue> queue; // assign in application for GraphicsQueue from device
+
+        /// swapchain and present id of each image presented by the last call to present(), only filled in when all the swapchains support VK_KHR_present_id
+        using PresentId = std::pair<ref_ptr<Swapchain>, uint64_t>;
+        std::vector<PresentId> presentIds;
+
+    protected:
+        static VkResult _present(Queue& presentQueue, const std::vector<Presentation*>& presentations);
     };
     VSG_type_name(vsg::Presentation);
 
@@ -184,6 +184,46 @@ namespace vsg
     };
     VSG_type_name(vsg::RelativeProjection);
 
+    /// TileProjection is a ProjectionMatrix that decorates another ProjectionMatrix to project just a rectangular tile of its view volume,
+    /// used to split the rendering of a view across multiple Views so each tile's Camera only culls and records what falls within its tile.
+    /// The tile is specified as {x, y, width, height} in normalized window coordinates, with 0,0 at the top left and 1,1 at the bottom right of the window.
+    class TileProjection : public Inherit<ProjectionMatrix, TileProjection>
+    {
+    public:
+        TileProjection(ref_ptr<ProjectionMatrix> pm, const dvec4& in_tile, bool in_forwardChangeExtent = true) :
+            projectionMatrix(pm),
+            tile(in_tile),
+            forwardChangeExtent(in_forwardChangeExtent)
+        {
+        }
+
+        /// matrix that maps the tile's region of clip space to the full clip space
+        dmat4 tileMatrix() const
+        {
+            double centerX = 2.0 * tile.x + tile.z - 1.0;
+            double centerY = 2.0 * tile.y + tile.w - 1.0;
+            return scale(1.0 / tile.z, 1.0 / tile.w, 1.0) * translate(-centerX, -centerY, 0.0);
+        }
+
+        /// returns tileMatrix() * projectionMatrix->transform()
+        dmat4 transform() const override
+        {
+            return tileMatrix() * projectionMatrix->transform();
+        }
+
+        void changeExtent(const VkExtent2D& prevExtent, const VkExtent2D& newExtent) override
+        {
+            if (forwardChangeExtent) projectionMatrix->changeExtent(prevExtent, newExtent);
+        }
+
+        ref_ptr<ProjectionMatrix> projectionMatrix;
+        dvec4 tile;
+
+        /// when true changeExtent(..) is passed on to the projectionMatrix, set to false on all but one of the TileProjection that share a projectionMatrix so window resizes only update it once.
+        bool forwardChangeExtent = true;
+    };
+    VSG_type_name(vsg::TileProjection);
+
     /// EllipsoidPerspective is a ProjectionMatrix that implements the gluPerspective model for setting the projection matrix,
     /// with automatic clamping of the near/far values to an ellipsoidModel, typically used for rendering whole earth models.
     class VSG_DECLSPEC EllipsoidPerspective : public Inherit<ProjectionMatrix, EllipsoidPerspective>
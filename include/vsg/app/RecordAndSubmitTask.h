@@ -15,10 +15,15 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/CommandGraph.h>
 #include <vsg/app/TransferTask.h>
 #include <vsg/app/Window.h>
+#include <vsg/core/observer_ptr.h>
 #include <vsg/io/DatabasePager.h>
 #include <vsg/nodes/Group.h>
 #include <vsg/utils/Instrumentation.h>
 #include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/SubmitBatch.h>
+
+#include <condition_variable>
+#include <mutex>
 
 namespace vsg
 {
@@ -35,6 +40,10 @@ namespace vsg
         virtual VkResult record(ref_ptr<RecordedCommandBuffers> recordedCommandBuffers, ref_ptr<FrameStamp> frameStamp);
         virtual VkResult finish(ref_ptr<RecordedCommandBuffers> recordedCommandBuffers);
 
+        /// transfer the dynamic data required before the record traversal, snapshotting it into the TransferTask staging buffers so later modifications don't affect this frame.
+        /// Called by submit() and the Viewer's transfer threads if not already called for the current frame, Viewer::pipelinedFrames calls it before starting the record threads.
+        VkResult transferBeforeRecordTraversal();
+
         ref_ptr<Device> device;
         Windows windows;
         Semaphores waitSemaphores;   // assign in application setup
@@ -44,11 +53,35 @@ namespace vsg
         ref_ptr<TransferTask> transferTask; // data is transferred for this frame
 
         ref_ptr<Semaphore> earlyDataTransferredSemaphore;
+        uint64_t earlyDataTransferredValue = 0;
         ref_ptr<Semaphore> earlyTransferConsumerCompletedSemaphore;
 
         ref_ptr<Semaphore> lateDataTransferredSemaphore;
+        uint64_t lateDataTransferredValue = 0;
         ref_ptr<Semaphore> lateTransferConsumerCompletedSemaphore;
 
+        /// optional timeline semaphore, when assigned each frame's submission signals a new value on it which is used for frame pacing and TransferTask synchronization in place of the per frame Fences.
+        /// Use enableTimelineSemaphore() to create and assign it along with the TransferTask's timeline semaphore.
+        ref_ptr<Semaphore> timelineSemaphore;
+
+        /// create timeline semaphores for this task and its TransferTask, sharing one semaphore when both submit to the same queue. Requires Device::supportsTimelineSemaphores().
+        void enableTimelineSemaphore();
+
+        /// Dependency on the submissions of another RecordAndSubmitTask, typically one submitting to an async compute queue, requires both tasks to have a timelineSemaphore.
+        /// With a frameLag of 0 this task's submission waits on the task's submission for the current frame, which must submit earlier in the frame,
+        /// a frameLag of 1 waits on the previous frame's submission etc., used to prevent the task overwriting data still being read by this task's previous frames.
+        struct Dependency
+        {
+            observer_ptr<RecordAndSubmitTask> task;
+            VkPipelineStageFlags waitStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            uint32_t frameLag = 0;
+        };
+
+        std::vector<Dependency> dependencies;
+
+        /// wait till finish() has completed for the current frame, used by dependent tasks with a frameLag of 0. timeout is in nanoseconds, returns false if the wait timed out.
+        bool waitForSubmission(uint64_t timeout);
+
         /// advance the currentFrameIndex
         void advance();
 
@@ -56,10 +89,24 @@ namespace vsg
         size_t index(size_t relativeFrameIndex = 0) const;
 
         /// fence() and fence(0) return the Fence for the frame currently being rendered, fence(1) returns the previous frame's Fence etc.
+        /// return nullptr when a timelineSemaphore is used, as the Fences are then not submitted.
         ref_ptr<Fence> fence(size_t relativeFrameIndex = 0);
 
+        /// return the timelineSemaphore value signaled by the submission of the frame relativeFrameIndex, 0 if no value has been assigned.
+        uint64_t timelineValue(size_t relativeFrameIndex = 0) const;
+
+        /// wait for the submission of the frame relativeFrameIndex to complete, using the timelineSemaphore when assigned, otherwise the associated Fence. timeout is in nanoseconds.
+        VkResult wait(size_t relativeFrameIndex, uint64_t timeout);
+
+        /// wait for the submissions of all the frames in flight to complete, used to wait on just this task when the resources of the Windows it renders to are recreated. timeout is in nanoseconds.
+        VkResult waitForFramesInFlight(uint64_t timeout);
+
         ref_ptr<Queue> queue;
 
+        /// when assigned finish() adds the frame's submission to the SubmitBatch rather than submitting it to the queue, the SubmitBatch must then be submitted before the next frame.
+        /// Assigned by the Viewer to combine the submissions of the tasks that share a Queue into a single vkQueueSubmit.
+        ref_ptr<SubmitBatch> submitBatch;
+
         ref_ptr<DatabasePager> databasePager;
 
         /// hook for assigning Instrumentation to enable profiling of record traversal.
@@ -68,10 +115,24 @@ namespace vsg
         /// Convenience method for assigning Instrumentation to the viewer and any associated objects.
         void assignInstrumentation(ref_ptr<Instrumentation> in_instrumentation);
 
+        /// frame scoped memory for the temporary containers used by finish(), released by start().
+        ref_ptr<ScratchMemory> scratchMemory;
+
     protected:
+        /// release the frame scoped ScratchMemory used by the previous frame, consolidating any that overflowed its buffer so the next frame doesn't need to allocate from the heap.
+        void releaseScratchMemory(ScratchMemory& frameScratchMemory, const char* description) const;
+
+        ref_ptr<RecordedCommandBuffers> _recordedCommandBuffers;
+        bool _transferredBeforeRecordTraversal = false;
         size_t _currentFrameIndex;
         std::vector<size_t> _indices;
         std::vector<ref_ptr<Fence>> _fences;
+        std::vector<uint64_t> _timelineValues;
+
+        std::mutex _submissionMutex;
+        std::condition_variable _submissionCondition;
+        uint64_t _advanceCount = 0;
+        uint64_t _submissionCount = 0;
     };
     VSG_type_name(vsg::RecordAndSubmitTask);
 
@@ -0,0 +1,127 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Inherit.h>
+#include <vsg/ui/UIEvent.h>
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace vsg
+{
+    // forward declare
+    class Node;
+    class PagedLOD;
+
+    /// RecordCosts accumulates the draws, vertices, state binds and CPU time that the RecordTraversal spends in PagedLOD and named node subgraphs,
+    /// providing a report of the most expensive subgraphs of a scene without the need for adding InstrumentationNode to the scene graph.
+    /// Assign to RecordTraversal::recordCosts to enable, costs are attributed to the innermost tracked subgraph so nested subgraphs aren't double counted,
+    /// with costs outside of any tracked subgraph attributed to the nullptr entry.
+    /// Nodes recorded via Bin are attributed to the subgraph that contains the View, not the subgraph they were binned from.
+    class VSG_DECLSPEC RecordCosts : public Inherit<Object, RecordCosts>
+    {
+    public:
+        RecordCosts();
+
+        struct Cost
+        {
+            std::string name;
+            uint64_t visits = 0;
+            uint64_t draws = 0;
+            uint64_t vertices = 0; // vertex or index count multiplied by instance count of VertexDraw, VertexIndexDraw, InstanceDraw and InstanceDrawIndexed
+            uint64_t stateBinds = 0; // number of state commands pushed by StateGroup
+            double cpuTime = 0.0; // milliseconds, excluding time spent in nested tracked subgraphs
+
+            void add(const Cost& rhs)
+            {
+                visits += rhs.visits;
+                draws += rhs.draws;
+                vertices += rhs.vertices;
+                stateBinds += rhs.stateBinds;
+                cpuTime += rhs.cpuTime;
+            }
+        };
+
+        using Costs = std::map<const Node*, Cost>;
+
+        /// track PagedLOD subgraphs, named using the PagedLOD::filename.
+        bool trackPagedLOD = true;
+
+        /// track subgraphs of nodes that have a "name" string value assigned via Object::setValue("name", ...).
+        bool trackNamedNodes = true;
+
+        /// return true if the node should be tracked, assigning its name to name.
+        bool track(const Node& node, std::string& name) const;
+        bool track(const PagedLOD& plod, std::string& name) const;
+
+        /// merge costs collected by a RecordTraversal, thread safe.
+        void add(const Costs& costs);
+
+        enum SortBy
+        {
+            CPU_TIME,
+            DRAWS,
+            VERTICES,
+            STATE_BINDS
+        };
+
+        using NodeCost = std::pair<const Node*, Cost>;
+
+        /// return the n most expensive subgraphs. Nodes are only used as keys and may have been deleted since they were recorded.
+        std::vector<NodeCost> top(size_t n, SortBy sortBy = CPU_TIME) const;
+
+        /// write the n most expensive subgraphs to out.
+        void report(std::ostream& out, size_t n = 20, SortBy sortBy = CPU_TIME) const;
+
+        /// remove all accumulated costs.
+        void clear();
+
+    protected:
+        mutable std::mutex _mutex;
+        Costs _costs;
+    };
+    VSG_type_name(vsg::RecordCosts);
+
+    /// RecordCostCollector collects the costs of a single RecordTraversal, tracking the stack of subgraphs being traversed.
+    class VSG_DECLSPEC RecordCostCollector
+    {
+    public:
+        RecordCosts::Costs costs;
+
+        /// return the cost of the current scope, costs outside of any tracked subgraph are attributed to the nullptr entry
+        RecordCosts::Cost& current();
+
+        void enter(const Node* node, const std::string& name);
+        void leave();
+
+        /// start collecting from the current scope of parent, used for the ParallelGroup batches
+        void inherit(const RecordCostCollector& parent);
+
+        /// add the costs of a batch collector, clearing it
+        void merge(RecordCostCollector& batch);
+
+        /// add the collected costs to recordCosts and reset them
+        void flush(RecordCosts& recordCosts);
+
+    protected:
+        void _accumulateTime(time_point now);
+
+        std::vector<std::pair<const Node*, RecordCosts::Cost*>> _stack;
+        time_point _start;
+    };
+
+} // namespace vsg
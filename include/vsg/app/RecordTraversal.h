@@ -16,8 +16,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Object.h>
 #include <vsg/core/type_name.h>
 #include <vsg/maths/mat4.h>
+#include <vsg/maths/sphere.h>
 #include <vsg/vk/Slots.h>
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -28,10 +30,18 @@ namespace vsg
     class Node;
     class Group;
     class QuadGroup;
+    class ParallelGroup;
     class LOD;
     class PagedLOD;
+    class PointCloud;
     class StateGroup;
+    class StreamingStateGroup;
     class CullGroup;
+    class BatchedCullGroup;
+    class LazyCompileGroup;
+    class SpatialGrid;
+    class PackedSubgraph;
+    class PackedDraws;
     class CullNode;
     class DepthSorted;
     class Layer;
@@ -42,6 +52,7 @@ namespace vsg
     class TileDatabase;
     class VertexDraw;
     class VertexIndexDraw;
+    class DrawIndexed;
     class Geometry;
     class Command;
     class Commands;
@@ -51,6 +62,8 @@ namespace vsg
     class FrameStamp;
     class CulledPagedLODs;
     class View;
+    class ViewMatrix;
+    class PrefetchTraversal;
     class Bin;
     class Switch;
     class RegionOfInterest;
@@ -66,6 +79,19 @@ namespace vsg
     class InstanceNode;
     class InstanceDraw;
     class InstanceDrawIndexed;
+    class CommandPoolRing;
+    class OperationThreads;
+    class OcclusionBuffer;
+    class PagedLODOcclusionQueries;
+    class StaticTileCache;
+    class CullCache;
+    class Occluder;
+    struct Operation;
+    class Latch;
+    struct ScratchMemory;
+    class RecordCosts;
+    class RecordCostCollector;
+    class FrameCapture;
 
     VSG_type_name(vsg::RecordTraversal);
 
@@ -95,6 +121,15 @@ namespace vsg
 
         ref_ptr<Instrumentation> instrumentation;
 
+        /// Optional RecordCosts that the draws, vertices, state binds and CPU time of the traversal are attributed to.
+        ref_ptr<RecordCosts> recordCosts;
+
+        /// Optional FrameCapture that the commands recorded for each View are captured to when it has a capture requested.
+        ref_ptr<FrameCapture> frameCapture;
+
+        /// Optional threads used to record the batches of ParallelGroup children in parallel, if not assigned batches are recorded on the calling thread.
+        ref_ptr<OperationThreads> recordThreads;
+
         /// Container for CommandBuffers that have been recorded in current frame
         ref_ptr<RecordedCommandBuffers> recordedCommandBuffers;
 
@@ -118,19 +153,28 @@ namespace vsg
         // scene graph nodes
         void apply(const Group& group);
         void apply(const QuadGroup& quadGroup);
+        void apply(const ParallelGroup& parallelGroup);
         void apply(const LOD& lod);
         void apply(const PagedLOD& pagedLOD);
         void apply(const TileDatabase& tileDatabase);
+        void apply(const PointCloud& pointCloud);
         void apply(const CullGroup& cullGroup);
+        void apply(const BatchedCullGroup& cullGroup);
+        void apply(const LazyCompileGroup& lcg);
+        void apply(const SpatialGrid& spatialGrid);
+        void apply(const PackedSubgraph& packedSubgraph);
+        void apply(const PackedDraws& packedDraws);
         void apply(const CullNode& cullNode);
         void apply(const DepthSorted& depthSorted);
         void apply(const Layer& layer);
         void apply(const Switch& sw);
         void apply(const RegionOfInterest& roi);
+        void apply(const Occluder& occluder);
 
         // leaf node
         void apply(const VertexDraw& vid);
         void apply(const VertexIndexDraw& vid);
+        void apply(const DrawIndexed& drawIndexed);
         void apply(const Geometry& vid);
 
         // positional state
@@ -155,6 +199,7 @@ namespace vsg
 
         // Vulkan nodes
         void apply(const StateGroup& object);
+        void apply(const StreamingStateGroup& object);
 
         // Commands
         void apply(const Commands& commands);
@@ -184,8 +229,92 @@ namespace vsg
         std::vector<ref_ptr<Bin>> bins;
         ref_ptr<ViewDependentState> viewDependentState;
 
+        // assigned from View::occlusionBuffer during the View traversal.
+        ref_ptr<OcclusionBuffer> occlusionBuffer;
+
+        // assigned from View::pagedLODOcclusionQueries during the View traversal.
+        ref_ptr<PagedLODOcclusionQueries> pagedLODOcclusionQueries;
+
+        // assigned from View::staticTileCache during the View traversal.
+        ref_ptr<StaticTileCache> staticTileCache;
+
+        // assigned from View::cullCache during the View traversal.
+        ref_ptr<CullCache> cullCache;
+
+        /// frame scoped memory for temporary containers used during the record traversal, such as the Bin sort maps.
+        /// Released at the start of CommandGraph::record() and consolidated by RecordAndSubmitTask::start() so that steady state frames don't allocate from the heap.
+        ref_ptr<ScratchMemory> scratchMemory;
+
     protected:
         virtual ~RecordTraversal();
+
+        /// per batch RecordTraversal and secondary CommandBuffers used to record ParallelGroup children
+        struct ParallelBatch
+        {
+            ref_ptr<RecordTraversal> recordTraversal;
+            ref_ptr<CommandPoolRing> commandPoolRing;
+            ref_ptr<CommandBuffer> commandBuffer;
+            ref_ptr<Operation> operation;
+        };
+
+        std::vector<ParallelBatch> _parallelBatches;
+        ref_ptr<Latch> _parallelBatchLatch;
+        bool _parallelBatch = false;
+
+        /// visibility results of nested BatchedCullGroup/PackedSubgraph/PackedDraws, used as a stack so entries are accessed by index
+        std::vector<uint8_t> _batchedCullVisibility;
+
+        /// view matrices relative to the origins of the CoordinateFrame encountered during the current View, so each distinct origin's view matrix is computed once per frame
+        /// rather than for every CoordinateFrame, which is costly for ViewMatrix such as TrackingViewMatrix.
+        std::vector<std::pair<dvec3, dmat4>> _originViewMatrices;
+
+        /// return the view matrix of the current View relative to origin
+        dmat4 _originViewMatrix(const ViewMatrix& viewMatrix, const dvec3& origin);
+
+        /// viewport height in pixels divided by View::maximumScreenSpaceError, so geometricError * _screenSpaceErrorScale > lodDistance when the error exceeds the budget.
+        /// 0.0 when the View has no viewport, in which case LOD and PagedLOD select children by minimumScreenHeightRatio.
+        double _screenSpaceErrorScale = 0.0;
+        double _LODHysteresis = 0.0;
+
+        /// used to request the focus areas of RegionOfInterest in Views without a prefetchTraversal
+        ref_ptr<PrefetchTraversal> _focusTraversal;
+
+        /// costs collected during the traversal, merged into recordCosts at the end of each View
+        std::unique_ptr<RecordCostCollector> _costCollector;
+
+        /// RAII helper that makes the node's subgraph the current cost scope when recordCosts tracks it
+        struct CostScope
+        {
+            CostScope(RecordTraversal& rt, const Node& node);
+            CostScope(RecordTraversal& rt, const PagedLOD& plod);
+            ~CostScope();
+
+            RecordCostCollector* collector = nullptr;
+        };
+
+        /// return the collector for the current traversal, creating it on first use
+        RecordCostCollector& _costs();
+
+        /// request the loading of the PagedLOD's high res child from the DatabasePager, resetting its priority on the first request of the frame
+        void _requestPagedLOD(const PagedLOD& plod, double priority, bool firstRequestOfFrame);
+
+        /// record the PagedLOD child, replaying it from the staticTileCache when its subgraph is static
+        void _recordTile(const Node& tile);
+
+        /// return true if the bound, in the current modelview coordinate frame, is hidden behind the occluders of the current View's OcclusionBuffer
+        bool _occluded(const dsphere& bound) const;
+
+        /// return true if the node's bound is within the view frustum and not occluded, using the results from the current View's CullCache when available
+        bool _intersect(const Node& node, const dsphere& bound);
+
+        /// return true if commands can't be recorded inline as the current subpass only permits executing secondary CommandBuffers
+        bool _secondaryCommandBuffersRequired() const;
+
+        /// set up the batch's RecordTraversal to inherit the current State and begin recording to a secondary CommandBuffer
+        ParallelBatch& _beginParallelBatch(size_t index);
+
+        /// complete the recording of the batches, merge their Bin, RegionOfInterest and PagedLOD results, and execute their secondary CommandBuffers
+        void _endParallelBatches(size_t numBatches);
     };
 
 } // namespace vsg
@@ -17,6 +17,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/Camera.h>
 #include <vsg/app/Window.h>
 #include <vsg/app/WindowResizeHandler.h>
+#include <vsg/state/RenderingState.h>
 #include <vsg/state/ResourceHints.h>
 
 namespace vsg
@@ -25,6 +26,7 @@ namespace vsg
     /// RenderGraph encapsulates the vkCmdBeginRenderPass/vkCmdEndRenderPass functionality.
     /// Member variables of the RenderGraph map to the settings of the VkRenderPassBeginInfo.
     /// During the RecordTraversal children of RenderGraph are visited within the vkCmdBeginRenderPass/vkCmdEndRenderPass pair.
+    /// When dynamicRendering is enabled vkCmdBeginRendering/vkCmdEndRendering are used instead, with no RenderPass or Framebuffer required.
     class VSG_DECLSPEC RenderGraph : public Inherit<Group, RenderGraph>
     {
     public:
@@ -68,6 +70,49 @@ namespace vsg
         /// Subpass contents setting passed to vkCmdBeginRenderPass
         VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE;
 
+        /// when true use vkCmdBeginRendering/vkCmdEndRendering (VK_KHR_dynamic_rendering or Vulkan 1.3) rather than vkCmdBeginRenderPass/vkCmdEndRenderPass,
+        /// so that no RenderPass or Framebuffer is needed and GraphicsPipeline are compiled against a RenderingState rather than a RenderPass.
+        /// If colorAttachments is empty the window's swapchain, multisample and depth image views are used. Defaults to the window's WindowTraits::dynamicRendering.
+        bool dynamicRendering = false;
+
+        /// attachment settings used to set up the VkRenderingAttachmentInfo when dynamicRendering is enabled
+        struct RenderingAttachment
+        {
+            ref_ptr<ImageView> imageView;
+            VkImageLayout imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+            /// layout of the image before rendering, a pipeline barrier transitions it to imageLayout. VK_IMAGE_LAYOUT_UNDEFINED discards the previous contents.
+            VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            /// layout to transition the image to after rendering, VK_IMAGE_LAYOUT_UNDEFINED leaves it in imageLayout.
+            VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            VkAttachmentStoreOp storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+
+            /// optional multisample resolve target, transitioned from VK_IMAGE_LAYOUT_UNDEFINED to imageLayout before rendering and to resolveFinalLayout afterwards.
+            ref_ptr<ImageView> resolveImageView;
+            VkResolveModeFlagBits resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
+            VkImageLayout resolveFinalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        };
+        using RenderingAttachments = std::vector<RenderingAttachment>;
+
+        /// color attachments, the clearValues entries map to the colorAttachments followed by the depthAttachment.
+        RenderingAttachments colorAttachments;
+
+        /// depth attachment, also used as the stencil attachment when its format has a stencil component.
+        RenderingAttachment depthAttachment = {{}, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+
+        /// VkRenderingInfo settings
+        uint32_t layerCount = 1;
+        uint32_t viewMask = 0;
+
+        /// create the RenderingState that GraphicsPipeline used under this RenderGraph require when dynamicRendering is enabled.
+        ref_ptr<RenderingState> createRenderingState();
+
+        /// return the number of samples of the color/depth attachments.
+        VkSampleCountFlagBits getSamples();
+
         uint32_t viewportStateHint = DYNAMIC_VIEWPORTSTATE;
 
         /// Callback used to automatically update viewports, scissors, renderArea and clears when the window is resized.
@@ -80,6 +125,9 @@ namespace vsg
         /// window extent at previous frame, used to track window resizes
         constexpr static uint32_t invalid_dimension = std::numeric_limits<uint32_t>::max();
         mutable VkExtent2D previous_extent = VkExtent2D{invalid_dimension, invalid_dimension};
+
+    protected:
+        void _traverse(RecordTraversal& recordTraversal) const;
     };
     VSG_type_name(vsg::RenderGraph);
 
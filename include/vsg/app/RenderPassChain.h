@@ -0,0 +1,91 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/RenderGraph.h>
+
+namespace vsg
+{
+
+    /// RenderPassChain describes a sequence of passes, such as depth prepass, opaque, lighting and post processing passes, that render to a shared set of attachments
+    /// and merges them into the subpasses of a single RenderPass so that intermediate results can stay in tile memory on tile based GPUs.
+    /// Attachments without an assigned imageView are intermediates that only exist within the RenderPass, they are backed by transient, lazily allocated images and never stored.
+    /// Load and store ops, layouts, preserved attachments and subpass dependencies are all derived from how the passes use the attachments.
+    /// Passes must share the same extent and may only read the results of earlier passes at the same pixel via input attachments,
+    /// passes that sample other pixels, such as shadow maps or blurs, must remain separate RenderGraphs.
+    /// The GraphicsPipeline used within each pass must be set up with the pass index as their subpass.
+    class VSG_DECLSPEC RenderPassChain : public Inherit<Object, RenderPassChain>
+    {
+    public:
+        RenderPassChain();
+        explicit RenderPassChain(const VkExtent2D& in_extent);
+
+        struct Attachment
+        {
+            VkFormat format = VK_FORMAT_UNDEFINED;
+            VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+
+            /// when true the attachment is cleared to clearValue when first used, otherwise the contents of imageView are loaded if initialLayout is set, or left undefined.
+            bool clear = true;
+            VkClearValue clearValue = {};
+
+            /// image view of an attachment whose contents are used after the RenderPass, such as the final color output, when not assigned the attachment is a transient intermediate.
+            ref_ptr<ImageView> imageView;
+
+            /// layout of the imageView's existing contents, only used when clear is false
+            VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            /// layout to transition imageView to at the end of the RenderPass
+            VkImageLayout finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        };
+
+        struct Pass
+        {
+            ref_ptr<Node> subgraph;
+
+            /// indices of the attachments written to as color attachments
+            std::vector<uint32_t> colorAttachments;
+
+            /// index of the depth/stencil attachment, -1 for none
+            int32_t depthStencilAttachment = -1;
+
+            /// indices of the attachments written by earlier passes that are read as input attachments (subpassLoad)
+            std::vector<uint32_t> inputAttachments;
+
+            VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE;
+        };
+
+        VkExtent2D extent = {0, 0};
+        std::vector<Attachment> attachments;
+        std::vector<Pass> passes;
+
+        /// add attachment, returning its index
+        uint32_t addAttachment(const Attachment& attachment);
+
+        /// add pass, returning its index which is also its subpass index
+        uint32_t addPass(const Pass& pass);
+
+        /// create a RenderPass with one subpass per pass
+        ref_ptr<RenderPass> createRenderPass(Device* device) const;
+
+        /// create the RenderPass, the transient images of the intermediate attachments, the Framebuffer,
+        /// and a RenderGraph that records each pass's subgraph in turn, separated by NextSubPass commands.
+        ref_ptr<RenderGraph> createRenderGraph(Device* device);
+
+    protected:
+        virtual ~RenderPassChain();
+    };
+    VSG_type_name(vsg::RenderPassChain);
+
+} // namespace vsg
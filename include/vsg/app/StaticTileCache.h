@@ -0,0 +1,102 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/nodes/Node.h>
+#include <vsg/state/GraphicsPipeline.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace vsg
+{
+
+    // forward declare
+    class RecordTraversal;
+
+    /// StaticTileCache reduces the cost of recording large static tilesets by flattening the subgraph of each PagedLOD child, the first time it's recorded, into a list of
+    /// state, transform and draw operations that is replayed on subsequent frames in place of traversing the subgraph. Replaying skips the visitor dispatch of the
+    /// intermediate groups and the per node culling within the tile, the tile as a whole is still culled by its PagedLOD. Only subgraphs composed of Group, CullGroup,
+    /// CullNode, StateGroup, MatrixTransform and leaf Commands/Command nodes are flattened, subgraphs containing LOD, PagedLOD, Switch, lights or other nodes whose
+    /// traversal depends on the view are traversed as normal. The subgraphs must not be modified once they have been recorded while they remain in the cache.
+    /// Tiles not recorded for expiryFrames frames, or no longer referenced by the scene graph, are removed from the cache. Assign to View::staticTileCache.
+    class VSG_DECLSPEC StaticTileCache : public Inherit<Object, StaticTileCache>
+    {
+    public:
+        StaticTileCache();
+
+        struct Operation
+        {
+            enum Type : uint8_t
+            {
+                PUSH_STATE,
+                POP_STATE,
+                PUSH_TRANSFORM,
+                POP_TRANSFORM,
+                RECORD
+            };
+
+            Type type;
+            const Node* node; // StateGroup for PUSH/POP_STATE, MatrixTransform for PUSH/POP_TRANSFORM, the node to record for RECORD
+        };
+
+        /// flattened subgraph of a tile
+        class VSG_DECLSPEC Tile : public Inherit<Object, Tile>
+        {
+        public:
+            std::vector<Operation> operations;
+            std::vector<const BindGraphicsPipeline*> bindPipelines;
+
+            /// return true if the GraphicsPipelines of the tile have been compiled for the view
+            bool ready(uint32_t viewID) const;
+
+            /// replay the operations, matching the results of the RecordTraversal traversing the subgraph apart from the culling within the tile.
+            void record(RecordTraversal& recordTraversal) const;
+        };
+
+        /// number of frames a tile remains in the cache after it was last recorded
+        uint64_t expiryFrames = 60;
+
+        /// statistics of the last frame
+        uint32_t numTilesFlattened = 0;
+        uint32_t numTilesExpired = 0;
+
+        /// remove the expired tiles, called by RecordTraversal::apply(const View&).
+        void begin(uint64_t frameCount);
+
+        /// return the flattened tile of the node, flattening it on first use, or null if the subgraph isn't static. Thread safe.
+        ref_ptr<const Tile> getTile(const Node& node, uint64_t frameCount);
+
+        /// flatten the subgraph, return null if it isn't static
+        static ref_ptr<Tile> flatten(const Node& node);
+
+        void clear();
+
+    protected:
+        virtual ~StaticTileCache();
+
+        struct Entry
+        {
+            ref_ptr<const Node> node;
+            ref_ptr<const Tile> tile;
+            uint64_t frameLastUsed = 0;
+        };
+
+        std::mutex _mutex;
+        std::unordered_map<const Node*, Entry> _entries;
+        uint64_t _frameCount = 0;
+    };
+    VSG_type_name(vsg::StaticTileCache);
+    VSG_type_name(vsg::StaticTileCache::Tile);
+
+} // namespace vsg
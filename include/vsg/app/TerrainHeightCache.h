@@ -0,0 +1,118 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/EllipsoidModel.h>
+#include <vsg/core/Array2D.h>
+#include <vsg/maths/box.h>
+#include <vsg/nodes/Node.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace vsg
+{
+
+    /// TerrainHeightCache answers terrain height queries from heightfields cached per tile, so camera manipulators and terrain following code can find the
+    /// ground height without intersecting the whole scene graph each frame. Heightfields are added by the vsg::tile ReaderWriter as tiles with elevation data
+    /// are loaded, when assigned to TileDatabaseSettings::terrainHeightCache, or can be extracted by intersecting the geometry of a subgraph. Queries use the
+    /// finest level heightfield covering the location, falling back to intersecting the scene, when assigned, for locations no heightfield covers.
+    /// Heightfields are retained after their tiles expire, up to maxHeightFields with the least recently used discarded first. Thread safe.
+    class VSG_DECLSPEC TerrainHeightCache : public Inherit<Object, TerrainHeightCache>
+    {
+    public:
+        explicit TerrainHeightCache(ref_ptr<EllipsoidModel> in_ellipsoidModel = {}, ref_ptr<Node> in_scene = {});
+
+        /// ellipsoid used to convert between latitude, longitude, altitude and the ECEF coordinates of the scene.
+        ref_ptr<EllipsoidModel> ellipsoidModel;
+
+        /// optional scene graph intersected for locations that no cached heightfield covers.
+        ref_ptr<Node> scene;
+
+        /// projection of the heightfield extents, matching TileDatabaseSettings::projection, "EPSG:3857" or "spherical-mercator" for spherical mercator
+        /// tiles, otherwise the extents are in longitude and latitude.
+        std::string projection;
+
+        /// maximum number of heightfields retained.
+        uint32_t maxHeightFields = 4096;
+
+        /// altitude above and below the ellipsoid of the line segments used when intersecting the scene.
+        double intersectionAltitudeRange = 100000.0;
+
+        /// heightfield of a tile, heights in metres above the ellipsoid with row 0 at extents.min.y and column 0 at extents.min.x.
+        struct HeightField
+        {
+            dbox extents; // x = longitude, y = latitude or spherical mercator y, in the same units as TileDatabaseSettings::extents
+            uint32_t level = 0;
+            ref_ptr<floatArray2D> heights;
+        };
+
+        /// add a heightfield, replacing any previously added heightfield with the same level and extents.
+        void insert(const HeightField& heightField);
+
+        /// convert elevation data, as used by the vsg::tile ReaderWriter, to a heightfield and add it, return false if the elevation data format isn't supported.
+        /// Normalized formats are scaled by elevationScale, the elevation data's properties.origin denotes whether its row 0 is at the top or bottom of the tile.
+        bool insert(const dbox& extents, uint32_t level, const Data& elevationData, double elevationScale);
+
+        /// extract a heightfield with the specified dimensions by intersecting the subgraph with vertical line segments and add it, return false if nothing was hit.
+        bool extract(const Node& subgraph, const dbox& extents, uint32_t level, uint32_t numColumns = 33, uint32_t numRows = 33);
+
+        /// get the terrain height at the latitude and longitude, in degrees, from the cached heightfields, return false if none cover the location.
+        bool getHeight(double latitude, double longitude, double& height);
+
+        /// set the z component of each latitude, longitude, height entry to the terrain height, intersecting the scene for the locations that no cached heightfield
+        /// covers, entries no height is found for are left unchanged. Return the number of entries assigned.
+        size_t getHeights(std::vector<dvec3>& latitudeLongitudeHeights);
+
+        /// remove all heightfields
+        void clear();
+
+        /// number of heightfields cached.
+        size_t size() const;
+
+        /// statistics of getHeight(..)/getHeights(..) queries, the number answered from the cache and the number that required intersecting the scene.
+        uint64_t numQueries = 0;
+        uint64_t numCacheHits = 0;
+        uint64_t numIntersections = 0;
+
+    protected:
+        virtual ~TerrainHeightCache();
+
+        struct Entry
+        {
+            uint32_t level;
+            std::pair<int64_t, int64_t> key;
+            HeightField heightField;
+        };
+
+        using Entries = std::list<Entry>;
+
+        /// tiles of a level are assumed to share the same size and be aligned to a common grid
+        struct Level
+        {
+            dvec2 origin;
+            dvec2 tileSize;
+            std::map<std::pair<int64_t, int64_t>, Entries::iterator> tiles;
+        };
+
+        dvec2 _project(double latitude, double longitude) const;
+        bool _getHeight(const dvec2& coord, double& height);
+
+        mutable std::mutex _mutex;
+        Entries _entries;
+        std::map<uint32_t, Level> _levels;
+    };
+    VSG_type_name(vsg::TerrainHeightCache);
+
+} // namespace vsg
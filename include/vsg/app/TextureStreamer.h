@@ -0,0 +1,111 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/CompileManager.h>
+#include <vsg/core/observer_ptr.h>
+#include <vsg/nodes/StreamingStateGroup.h>
+#include <vsg/threading/DeleteQueue.h>
+#include <vsg/threading/OperationQueue.h>
+
+#include <condition_variable>
+#include <list>
+#include <thread>
+
+namespace vsg
+{
+
+    // forward declare
+    class Viewer;
+
+    /// TextureStreamer streams the mipmap levels of the textures of StreamingStateGroup in and out based on their screen space size.
+    /// Images are re-created with the required subset of the mipmap chain on a background thread and compiled via the CompileManager,
+    /// the replacement descriptor sets are then merged into the scene graph when the TextureStreamer is run as an update operation,
+    /// with the previous descriptor sets and images released via a DeleteQueue once they are no longer in use by in flight frames.
+    /// Usage:
+    ///     auto textureStreamer = vsg::TextureStreamer::create(viewer);
+    ///     textureStreamer->assign(*scene);
+    ///     viewer->compile();
+    ///     viewer->addUpdateOperation(textureStreamer, vsg::UpdateOperations::ALL_FRAMES);
+    ///     textureStreamer->start();
+    class VSG_DECLSPEC TextureStreamer : public Inherit<Operation, TextureStreamer>
+    {
+    public:
+        explicit TextureStreamer(Viewer* viewer);
+
+        /// CompileManager used to compile the replacement images and descriptor sets, assigned from the Viewer by start() if not already set.
+        ref_ptr<CompileManager> compileManager;
+
+        /// viewport height in pixels used to map the screen height ratio of a StreamingStateGroup's bound to the texel density required.
+        double screenHeight = 1080.0;
+
+        /// bias added to the computed mipmap level, positive values reduce the resolution streamed in.
+        double levelBias = 0.0;
+
+        /// number of levels the required level must fall below the resident level before lower resolution replacements are streamed in, avoids thrashing between levels.
+        uint32_t evictionHysteresis = 1;
+
+        /// assign this TextureStreamer to all the StreamingStateGroup in a scene graph.
+        void assign(Object& object);
+
+        /// start the background thread that reads and compiles the replacement images.
+        void start();
+
+        /// stop the background thread.
+        void stop();
+
+        /// called by the RecordTraversal for visible StreamingStateGroup, requesting an update if any of the textures require different mipmap levels.
+        void request(const StreamingStateGroup& ssg, double screenHeightRatio);
+
+        /// merge the compiled replacements into the scene graph, invoked as an update operation.
+        void run() override;
+
+        /// return a Data object containing the mipmap levels of a 2D image from firstLevel onwards, sharing the data when firstLevel is 0.
+        /// returns null if firstLevel is beyond the mipmap levels of the data or the data isn't a single 2D image.
+        static ref_ptr<Data> mipmapSubset(ref_ptr<Data> data, uint32_t firstLevel);
+
+        std::atomic_uint64_t numActiveRequests{0};
+
+    protected:
+        virtual ~TextureStreamer();
+
+        struct Replacement
+        {
+            ref_ptr<StreamingStateGroup> stateGroup;
+            StateCommands stateCommands;
+            StateCommands replacedStateCommands;
+            std::vector<std::pair<ref_ptr<StreamedTexture>, uint32_t>> textures;
+            std::vector<ref_ptr<ImageInfo>> imageInfos;
+        };
+
+        ref_ptr<StreamingStateGroup> _takeRequest();
+        void _stream(ref_ptr<StreamingStateGroup> ssg);
+
+        observer_ptr<Viewer> _viewer;
+
+        ref_ptr<ActivityStatus> _status;
+        std::list<std::thread> _threads;
+
+        std::mutex _requestMutex;
+        std::condition_variable _requestCV;
+        std::list<ref_ptr<StreamingStateGroup>> _requests;
+
+        std::mutex _mergeMutex;
+        std::list<Replacement> _toMerge;
+
+        ref_ptr<DeleteQueue> _deleteQueue;
+    };
+    VSG_type_name(vsg::TextureStreamer);
+
+} // namespace vsg
@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/app/Camera.h>
 #include <vsg/app/EllipsoidModel.h>
+#include <vsg/app/TerrainHeightCache.h>
 #include <vsg/maths/transform.h>
 #include <vsg/ui/Keyboard.h>
 #include <vsg/ui/PointerEvent.h>
@@ -56,8 +57,12 @@ namespace vsg
         bool withinRenderArea(const PointerEvent& pointerEvent) const;
         bool eventRelevant(const WindowEvent& event) const;
 
+        /// clamp the LookAt center to the surface of the globe, and the eye to above it, using the terrainHeightCache when assigned.
         void clampToGlobe();
 
+        /// optional terrain height cache used by clampToGlobe() to keep the view on, and the eye above, the terrain rather than the ellipsoid.
+        ref_ptr<TerrainHeightCache> terrainHeightCache;
+
         /// list of windows that this Trackball should respond to events from, and the points xy offsets to apply
         std::map<observer_ptr<Window>, ivec2> windowOffsets;
 
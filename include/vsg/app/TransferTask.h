@@ -12,6 +12,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/app/GpuDecompressor.h>
+#include <vsg/app/MipmapGenerator.h>
 #include <vsg/io/Logger.h>
 #include <vsg/state/ImageInfo.h>
 #include <vsg/vk/CommandBuffer.h>
@@ -34,6 +36,7 @@ namespace vsg
         {
             VkResult result = VK_SUCCESS;
             ref_ptr<Semaphore> dataTransferredSemaphore;
+            uint64_t dataTransferredValue = 0; // value to wait on when dataTransferredSemaphore is a timeline semaphore
         };
 
         enum TransferMask
@@ -49,6 +52,9 @@ namespace vsg
 
         virtual bool containsDataToTransfer(TransferMask transferMask) const;
 
+        /// return true if any of the dynamic data has been modified since it was last transferred.
+        virtual bool requiresTransfer(TransferMask transferMask) const;
+
         ref_ptr<Device> device;
 
         void assign(const DynamicData& dynamicData);
@@ -57,18 +63,41 @@ namespace vsg
 
         ref_ptr<Queue> transferQueue;
 
-        /// minimum size to use when allocating staging buffers.
+        /// optional timeline semaphore, when assigned it replaces the per frame Fence and binary semaphores used to synchronize transfers.
+        /// Submissions to the timeline semaphore must be made in increasing value order, so only share it with submissions made from the same thread to the same queue.
+        ref_ptr<Semaphore> timelineSemaphore;
+
+        /// minimum size to use when allocating the staging ring buffers, each frame's transfer is sub-allocated from the ring so the size should cover several frames of updates.
         VkDeviceSize minimumStagingBufferSize = 16 * 1024 * 1024;
 
+        /// when true, BufferInfo whose memory is host visible and coherent, such as device local memory on integrated GPUs or exposed via resizable BAR, are written directly rather than copied via the staging buffer.
+        /// Direct writes are not synchronized with command buffers from earlier frames that may still be reading the buffer, so only enable when those have completed before the next transfer, or the data is multi-buffered.
+        bool directHostWrites = false;
+
+        /// when true, and directHostWrites is enabled, the values of dynamic Arrays written directly are relocated into the mapped buffer memory so subsequent CPU updates are made in place and need no copy.
+        /// The values are moved back into memory owned by the Data when its BufferInfo is released or the TransferTask is destroyed.
+        bool mapDataToDeviceMemory = false;
+
+        /// when assigned, the mipmaps of uploaded images are generated by its compute shader, batching all the images of a transfer, rather than with per image blits.
+        /// Must be assigned before the images are compiled so that they are created with the required storage usage, and transferQueue must support compute.
+        ref_ptr<MipmapGenerator> mipmapGenerator;
+
+        /// when assigned, the LZ4 payloads of CompressedData are uploaded as is and decompressed by its compute shader, otherwise they are decompressed on the CPU as they are copied to the staging buffer.
+        /// Must be assigned before the first transfer so that the staging buffer is created with the required storage usage, and transferQueue must support compute.
+        ref_ptr<GpuDecompressor> gpuDecompressor;
+
         /// hook for assigning Instrumentation to enable profiling of record traversal.
         ref_ptr<Instrumentation> instrumentation;
 
         /// control for the level of debug information emitted by the TransferTask
         Logger::Level level = Logger::LOGGER_DEBUG;
 
-        void assignTransferConsumedCompletedSemaphore(TransferMask transferMask, ref_ptr<Semaphore> semaphore);
+        /// assign the semaphore that the next transfer should wait on before overwriting the data consumed by the previous submission, value is used when semaphore is a timeline semaphore.
+        void assignTransferConsumedCompletedSemaphore(TransferMask transferMask, ref_ptr<Semaphore> semaphore, uint64_t value = 0);
 
     protected:
+        virtual ~TransferTask();
+
         using OffsetBufferInfoMap = std::map<VkDeviceSize, ref_ptr<BufferInfo>>;
         using BufferMap = std::map<ref_ptr<Buffer>, OffsetBufferInfoMap>;
 
@@ -82,6 +111,11 @@ namespace vsg
             void* buffer_data = nullptr;
             std::vector<VkBufferCopy> copyRegions;
             bool waitOnFence = false;
+            uint64_t timelineValue = 0;
+            VkDeviceSize stagingOffset = 0; // range of the staging ring buffer used by the submitted copies
+            VkDeviceSize stagingSize = 0;
+            ref_ptr<Objects> mipmapResources; // level views and descriptor sets used by the compute mipmap generation
+            ref_ptr<Objects> decompressionResources; // scratch buffer and descriptor sets used by the compute decompression
         };
 
         struct DataToCopy
@@ -95,10 +129,17 @@ namespace vsg
 
             VkDeviceSize dataTotalRegions = 0;
             VkDeviceSize dataTotalSize = 0;
+            VkDeviceSize directWriteSize = 0;
             VkDeviceSize imageTotalSize = 0;
 
+            // staging ring buffer shared by all the frames
+            ref_ptr<Buffer> staging;
+            void* staging_data = nullptr;
+            VkDeviceSize stagingHead = 0;
+
             ref_ptr<Semaphore> transferCompleteSemaphore;
             ref_ptr<Semaphore> transferConsumerCompletedSemaphore;
+            uint64_t transferConsumerCompletedValue = 0;
 
             bool requiresCopy(uint32_t deviceID) const;
             bool containsDataToTransfer() const { return !dataMap.empty() || !imageInfoSet.empty(); }
@@ -111,6 +152,18 @@ namespace vsg
 
         TransferResult _transferData(DataToCopy& dataToCopy);
 
+        VkResult _waitForTransferBlock(TransferBlock& frame);
+        VkResult _reserveStagingMemory(DataToCopy& dataToCopy, TransferBlock& frame, VkDeviceSize size, VkDeviceSize& offset);
+
+        /// return pointer to the mapped memory of buffer if it can be written to directly, otherwise return nullptr.
+        char* _directWritePointer(Buffer* buffer);
+
+        /// return true if the payload of data can be copied to the staging buffer of frame and decompressed by the gpuDecompressor.
+        bool _decompressOnGpu(TransferBlock& frame, const CompressedData& data) const;
+
+        std::map<ref_ptr<DeviceMemory>, void*> _mappedDeviceMemory;
+        std::set<ref_ptr<Data>> _relocatedData;
+
         void _transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer vk_commandBuffer, TransferBlock& frame, VkDeviceSize& offset);
 
         void _transferImageInfos(DataToCopy& dataToCopy, VkCommandBuffer vk_commandBuffer, TransferBlock& frame, VkDeviceSize& offset);
@@ -119,6 +172,7 @@ namespace vsg
     VSG_type_name(vsg::TransferTask);
 
     /// convenience function that uploads staging buffer data to device including mipmaps.
-    extern VSG_DECLSPEC void transferImageData(ref_ptr<ImageView> imageView, VkImageLayout targetImageLayout, Data::Properties properties, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, ref_ptr<Buffer> stagingBuffer, VkDeviceSize stagingBufferOffset, VkCommandBuffer vk_commandBuffer, vsg::Device* device);
+    /// when a mipmapGenerator is provided and supports the image, only the base level is copied and the image is added to the mipmapGenerator, leaving it to record the mipmap generation and final layout transition.
+    extern VSG_DECLSPEC void transferImageData(ref_ptr<ImageView> imageView, VkImageLayout targetImageLayout, Data::Properties properties, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, ref_ptr<Buffer> stagingBuffer, VkDeviceSize stagingBufferOffset, VkCommandBuffer vk_commandBuffer, vsg::Device* device, MipmapGenerator* mipmapGenerator = nullptr);
 
 } // namespace vsg
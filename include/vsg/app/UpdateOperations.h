@@ -51,6 +51,9 @@ namespace vsg
         /// get a copy of all current all frames updated operations
         container_type getUpdateOperationsAllFrames() const;
 
+        /// return true if one time operations are waiting to be run
+        bool requiresRun() const;
+
         /// run is invoked by Viewer::update()
         virtual void run();
 
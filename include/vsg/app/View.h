@@ -21,6 +21,11 @@ namespace vsg
 
     // forward declare
     class ViewDependentState;
+    class OcclusionBuffer;
+    class PagedLODOcclusionQueries;
+    class StaticTileCache;
+    class CullCache;
+    class PrefetchTraversal;
 
     /// ViewFeatures mask provide a means for controlling what features should be implemented by the View's ViewDependentState.
     enum ViewFeatures
@@ -28,7 +33,8 @@ namespace vsg
         INHERIT_VIEWPOINT = (1 << 0),
         RECORD_LIGHTS = (1 << 1),
         RECORD_SHADOW_MAPS = (1 << 2),
-        RECORD_ALL = (RECORD_LIGHTS | RECORD_SHADOW_MAPS)
+        RECORD_ALL = (RECORD_LIGHTS | RECORD_SHADOW_MAPS),
+        CLUSTERED_LIGHTING = (1 << 3) // bin point and unshadowed spot lights into view space clusters on the GPU, use in combination with RECORD_ALL
     };
 
     /// View is a Group class that pairs a Camera that defines the view with a subgraph that defines the scene that is being viewed/rendered
@@ -80,12 +86,38 @@ namespace vsg
         /// LODScale scales
         double LODScale = 1.0;
 
+        /// screen space error budget, in pixels, used to select the children of LOD and PagedLOD that have a geometricError assigned.
+        /// Increase to trade quality for fewer, lower resolution, tiles.
+        double maximumScreenSpaceError = 16.0;
+
+        /// fraction by which the PagedLOD high res child's screen height ratio or screen space error test is relaxed once the high res child is in use,
+        /// so that viewpoints hovering at the transition don't alternately expire and reload the high res child. 0.0 disables the hysteresis.
+        double LODHysteresis = 0.0;
+
         /// bins
         std::vector<ref_ptr<Bin>> bins;
 
         /// view dependent state used for positional state like lighting, texgen and clipping
         ref_ptr<ViewDependentState> viewDependentState;
 
+        /// optional software occlusion buffer, when assigned CullGroup, CullNode and LOD subgraphs hidden behind Occluder nodes are culled
+        ref_ptr<OcclusionBuffer> occlusionBuffer;
+
+        /// optional GPU occlusion queries of PagedLOD bounds, when assigned PagedLOD hidden behind the rendered scene don't request their high res children
+        ref_ptr<PagedLODOcclusionQueries> pagedLODOcclusionQueries;
+
+        /// optional cache of the flattened subgraphs of static PagedLOD children, when assigned the tiles are replayed from the cache rather than traversed
+        ref_ptr<StaticTileCache> staticTileCache;
+
+        /// optional camera used for view frustum culling in place of camera, such as one whose frustum encloses both Views of a stereo pair or a set of shadow cascades
+        ref_ptr<Camera> cullingCamera;
+
+        /// optional cache of culling results, reused while the culling camera is unchanged, share between Views with the same cullingCamera to cull once for all of them
+        ref_ptr<CullCache> cullCache;
+
+        /// optional prefetching of the PagedLOD required by predicted future viewpoints of the camera, invoked by the RecordTraversal after the View's subgraph has been traversed
+        ref_ptr<PrefetchTraversal> prefetchTraversal;
+
         /// override states for customization of graphics pipelines for this view
         GraphicsPipelineStates overridePipelineStates;
 
@@ -14,19 +14,26 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/animation/AnimationManager.h>
 #include <vsg/app/CompileManager.h>
+#include <vsg/app/FramePacing.h>
 #include <vsg/app/Presentation.h>
 #include <vsg/app/RecordAndSubmitTask.h>
 #include <vsg/app/UpdateOperations.h>
 #include <vsg/app/Window.h>
+#include <vsg/threading/Affinity.h>
 #include <vsg/threading/Barrier.h>
 #include <vsg/threading/FrameBlock.h>
 #include <vsg/utils/Instrumentation.h>
 
+#include <atomic>
+#include <functional>
 #include <map>
 
 namespace vsg
 {
 
+    // forward declare
+    class View;
+
     /// Viewer provides high level viewer functionality for managing windows, handling events and recording and submitting
     /// command graphs for compute and rendering.
     class VSG_DECLSPEC Viewer : public Inherit<Object, Viewer>
@@ -93,6 +100,10 @@ namespace vsg
         /// compile manager provides thread safe support for compiling subgraphs
         ref_ptr<CompileManager> compileManager;
 
+        /// optional OperationThreads shared by the CompileManager, and through it the DatabasePager, and the AnimationManager,
+        /// assigned to them by compile(..) so their parallel work runs on a single pool of threads rather than each oversubscribing the cores.
+        ref_ptr<OperationThreads> operationThreads;
+
         /// hint for setting the FrameStamp::simulationTime to time since start_point()
         static constexpr double UseTimeSinceStartPoint = std::numeric_limits<double>::max();
 
@@ -108,7 +119,7 @@ namespace vsg
 
         virtual bool acquireNextFrame();
 
-        /// call vkWaitForFence on the fences associated with previous frames RecordAndSubmitTask, a relativeFrameIndex of 1 is the previous frame, 2 is two frames ago.
+        /// wait on the fences, or timeline semaphore values, associated with previous frames RecordAndSubmitTask, a relativeFrameIndex of 1 is the previous frame, 2 is two frames ago.
         /// timeout is in nanoseconds.
         virtual VkResult waitForFences(size_t relativeFrameIndex, uint64_t timeout);
 
@@ -119,6 +130,29 @@ namespace vsg
         using Presentations = std::vector<ref_ptr<Presentation>>;
         Presentations presentations;
 
+        /// optional FramePacing that advanceToNextFrame() uses to delay the start of frames to minimize the latency between input and display
+        ref_ptr<FramePacing> framePacing;
+
+        /// when true advanceToNextFrame() only advances to a new frame once requiresRedraw() returns true, polling the windows for events every onDemandPollInterval
+        /// seconds while it waits, so idle displays don't consume GPU time. ALL_FRAMES update operations are only run when a frame is rendered, so those that
+        /// modify the scene need to call requestRedraw() to keep frames coming.
+        bool onDemandRendering = false;
+
+        /// time in seconds between polls for events while advanceToNextFrame() waits for a frame to be required.
+        double onDemandPollInterval = 0.01;
+
+        /// request that numFrames frames are rendered when onDemandRendering is enabled, may be called from any thread.
+        void requestRedraw(uint32_t numFrames = 1);
+
+        /// optional callback called by requiresRedraw(), return true to request a frame.
+        using RedrawCallback = std::function<bool(Viewer&)>;
+        RedrawCallback redrawCallback;
+
+        /// return true if a new frame is required, due to calls to requestRedraw(), the redrawCallback, pending one time update operations, playing animations,
+        /// loaded subgraphs waiting to be merged by the DatabasePager, modified dynamic data or changes to the Cameras of the Views since the previous frame.
+        /// Window events are checked separately by advanceToNextFrame().
+        virtual bool requiresRedraw();
+
         /// Create RecordAndSubmitTask and Presentation objects configured to manage specified commandGraphs and assign them to the viewer.
         /// Replace any preexisting setup.
         virtual void assignRecordAndSubmitTaskAndPresentation(CommandGraphs commandGraphs);
@@ -129,9 +163,28 @@ namespace vsg
         ref_ptr<ActivityStatus> status;
         std::list<std::thread> threads;
 
+        /// Affinity of the threads created by setupThreading(), when empty the threads are placed on the performance cores of hybrid CPUs.
+        Affinity recordThreadAffinity;
+
+        /// when non zero the FrameBlock and Barriers created by setupThreading() have waiting threads spin for up to threadingSpinCount iterations before blocking,
+        /// reducing the wake up latency of the threads on the frame's critical path at the cost of CPU time, see vsg::HybridWait.
+        uint32_t threadingSpinCount = 0;
+
         void setupThreading();
         void stopThreading();
 
+        /// when true, and threading has been set up with setupThreading(), recordAndSubmit() returns once the record threads have been started,
+        /// so the next frame's event handling and update run concurrently with the record traversal of the current frame, the current frame's
+        /// present() being deferred till the record has completed. Dynamic vsg::Data is snapshotted into the TransferTask staging buffers before
+        /// the record threads start so it can be safely modified by the next update, and DatabasePager merges are deferred till the record completes.
+        /// Other scene graph objects read by the record traversal, such as transforms and cameras, aren't double buffered, so event handlers,
+        /// update operations and animations must only modify dynamic vsg::Data, or otherwise tolerate the concurrent record traversal.
+        bool pipelinedFrames = false;
+
+        /// when true the submissions of the RecordAndSubmitTasks that share a Queue are combined into a single vkQueueSubmit call each frame,
+        /// and the presents of the Presentations that share a Queue into a single vkQueuePresentKHR call.
+        bool batchSubmissions = true;
+
         virtual void update();
 
         virtual void recordAndSubmit();
@@ -165,6 +218,35 @@ namespace vsg
         bool _threading = false;
         ref_ptr<FrameBlock> _frameBlock;
         ref_ptr<Barrier> _submissionCompleted;
+
+        bool _frameInFlight = false;
+        bool _acquireDeferred = false;
+        bool _presentDeferred = false;
+
+        std::vector<ref_ptr<SubmitBatch>> _submitBatches;
+
+        std::atomic_uint _redrawsRequested{0};
+
+        struct OnDemandView
+        {
+            observer_ptr<View> view;
+            dmat4 projectionMatrix;
+            dmat4 viewMatrix;
+        };
+
+        bool _onDemandViewsAssigned = false;
+        std::vector<OnDemandView> _onDemandViews;
+
+        /// wait till a new frame is required, return false if the viewer is no longer active.
+        bool _waitForRedraw();
+
+        /// return true if the Cameras of the Views have changed since the last call, updating the recorded matrices.
+        bool _camerasChanged();
+
+        void _completeFrameInFlight();
+        void _mergeDatabasePagerUpdates();
+        void _assignSubmitBatches();
+        void _flushSubmitBatches();
     };
     VSG_type_name(vsg::Viewer);
 
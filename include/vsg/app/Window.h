@@ -18,11 +18,16 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/CommandBuffer.h>
 #include <vsg/vk/CommandPool.h>
 #include <vsg/vk/DeviceMemory.h>
+#include <vsg/vk/Fence.h>
 #include <vsg/vk/Framebuffer.h>
 #include <vsg/vk/Semaphore.h>
 
+#include <list>
+
 namespace vsg
 {
+    // forward declare
+    class MoveEvent;
 
     /// Window base class provides a cross platform window
     /// The Android_Window, iOS_Window, MacOS_Window, Xcb_Window and Win32_Window classes derived from Window provide
@@ -56,6 +61,14 @@ namespace vsg
         /// get the list of events since the last pollEvents() call by splicing bufferEvents with polled windowing events.
         virtual bool pollEvents(UIEvents& events);
 
+        /// merge consecutive MoveEvents with the same button mask buffered between pollEvents() calls, initialized from WindowTraits::coalesceMoveEvents.
+        bool coalesceMoveEvents = false;
+
+        /// add a MoveEvent to bufferedEvents, used by the platform specific Window implementations.
+        /// MoveEvents are recycled from a small pool once no longer referenced by the event handlers, or merged with the last buffered event when coalesceMoveEvents is true,
+        /// so high rate pointer devices don't allocate a new MoveEvent for each move.
+        void bufferMoveEvent(time_point time, int32_t x, int32_t y, uint16_t buttonMask);
+
         virtual void resize() {}
 
         ref_ptr<WindowTraits> traits() { return _traits; }
@@ -101,6 +114,10 @@ namespace vsg
         ref_ptr<ImageView> getDepthImageView() { return _depthImageView; }
         ref_ptr<ImageView> getOrCreateDepthImageView();
 
+        /// multisample color and depth image views, only assigned when multisampling is used, the multisample depth image view only when the depth image also needs resolving.
+        ref_ptr<ImageView> getMultisampleImageView() { return _multisampleImageView; }
+        ref_ptr<ImageView> getMultisampleDepthImageView() { return _multisampleDepthImageView; }
+
         size_t numFrames() const { return _frames.size(); }
 
         ref_ptr<ImageView> imageView(size_t i) { return _frames[i].imageView; }
@@ -131,6 +148,9 @@ namespace vsg
         Frame& frame(size_t i) { return _frames[i]; }
         Frames& frames() { return _frames; }
 
+        /// release the resources of the Swapchains retired by asynchronous swapchain recreation whose frames have completed, called by acquireNextImage().
+        void releaseRetiredSwapchains();
+
     protected:
         Window(ref_ptr<WindowTraits> traits);
 
@@ -180,6 +200,23 @@ namespace vsg
 
         Semaphores _availableSemaphores;
         size_t _availableSemaphoreIndex = 0;
+
+        // resources of a Swapchain replaced when WindowTraits::asynchronousSwapchainRecreation is set, kept until the fence submitted after the frames that used them signals.
+        // The swapchain is declared first so it's destroyed after the framebuffers and image views created from its images.
+        struct RetiredSwapchain
+        {
+            ref_ptr<Swapchain> swapchain;
+            Frames frames;
+            Semaphores availableSemaphores;
+            std::vector<ref_ptr<Object>> attachments;
+            ref_ptr<CommandBuffer> commandBuffer;
+            ref_ptr<Fence> fence;
+        };
+
+        std::list<RetiredSwapchain> _retiredSwapchains;
+
+        std::vector<ref_ptr<MoveEvent>> _moveEventPool;
+        size_t _moveEventPoolIndex = 0;
     };
     VSG_type_name(vsg::Window);
 
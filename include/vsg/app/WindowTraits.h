@@ -71,8 +71,26 @@ namespace vsg
 
         VkQueueFlags queueFlags = VK_QUEUE_GRAPHICS_BIT;
         std::vector<float> queuePriorities{1.0, 0.0};
+
+        /// when true, and the physical device has a compute only queue family, a queue on it is created along with the graphics queue for CommandGraph recording async compute work,
+        /// use PhysicalDevice::getQueueFamily(VK_QUEUE_COMPUTE_BIT) to get the queue family to assign to the CommandGraph.
+        bool asyncComputeQueue = false;
         VkPipelineStageFlagBits imageAvailableSemaphoreWaitFlag = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
+        /// when true, the Window doesn't create Framebuffers for the swapchain images and RenderGraph assigned to the Window use vkCmdBeginRendering,
+        /// so GraphicsPipeline don't depend upon a RenderPass and window resizes don't need new Framebuffers.
+        /// Enables VK_KHR_dynamic_rendering when the vulkanVersion is less than 1.3, and the dynamicRendering device feature.
+        bool dynamicRendering = false;
+
+        /// when true, consecutive MoveEvents with the same button mask received between Window::pollEvents() calls are merged into a single MoveEvent with the latest position and time,
+        /// reducing the number of events that high rate pointer devices generate for the event handlers to process.
+        bool coalesceMoveEvents = false;
+
+        /// when true, resizing the Window recreates the Swapchain without vkDeviceWaitIdle, the new Swapchain is created with the previous one as its oldSwapchain
+        /// and the previous images, framebuffers and semaphores are retired till the frames that used them have completed. The Viewer only waits on the frames in
+        /// flight of the RecordAndSubmitTasks rendering to the resized Window, so the other Windows continue rendering without a stall.
+        bool asynchronousSwapchainRecreation = false;
+
         // hints to which extension to enable during Instance/Device setup
         bool debugLayer = false;           // VK_LAYER_KHRONOS_validation
         bool synchronizationLayer = false; // VK_LAYER_KHRONOS_synchronization2
@@ -89,6 +107,10 @@ namespace vsg
         vsg::PhysicalDeviceTypes deviceTypePreferences;
         ref_ptr<DeviceFeatures> deviceFeatures;
 
+        /// index into Instance::getPhysicalDevices() of the GPU to create the Window's Device on, used to place the Windows of a multi GPU system on different GPUs.
+        /// When -1 the PhysicalDevice is selected using the deviceTypePreferences.
+        int physicalDeviceIndex = -1;
+
         // Multisampling
         // A bitmask of sample counts. The window's framebuffer will
         // be configured with the maximum requested value that is
@@ -156,4 +156,23 @@ namespace vsg
     };
     VSG_type_name(vsg::PipelineBarrier);
 
+    /// release and acquire PipelineBarrier pair that transfers ownership of a VK_SHARING_MODE_EXCLUSIVE resource between queue families.
+    /// The release barrier must be recorded to a CommandGraph on the source queue family and the acquire barrier to one on the destination queue family,
+    /// with the acquiring submission waiting on the releasing one, see RecordAndSubmitTask::dependencies.
+    struct QueueFamilyOwnershipTransfer
+    {
+        ref_ptr<PipelineBarrier> release;
+        ref_ptr<PipelineBarrier> acquire;
+    };
+
+    /// create a QueueFamilyOwnershipTransfer for size bytes of buffer from offset, srcStageMask/srcAccessMask are the source queue's last use and dstStageMask/dstAccessMask the destination queue's first use.
+    extern VSG_DECLSPEC QueueFamilyOwnershipTransfer createQueueFamilyOwnershipTransfer(ref_ptr<Buffer> buffer, VkDeviceSize offset, VkDeviceSize size,
+                                                                                       uint32_t srcQueueFamily, VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask,
+                                                                                       uint32_t dstQueueFamily, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask);
+
+    /// create a QueueFamilyOwnershipTransfer for the subresourceRange of image, transitioning it from oldLayout to newLayout.
+    extern VSG_DECLSPEC QueueFamilyOwnershipTransfer createQueueFamilyOwnershipTransfer(ref_ptr<Image> image, const VkImageSubresourceRange& subresourceRange, VkImageLayout oldLayout, VkImageLayout newLayout,
+                                                                                       uint32_t srcQueueFamily, VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask,
+                                                                                       uint32_t dstQueueFamily, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask);
+
 } // namespace vsg
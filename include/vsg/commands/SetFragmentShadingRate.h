@@ -0,0 +1,42 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/Command.h>
+
+namespace vsg
+{
+
+    /// SetFragmentShadingRate command encapsulates vkCmdSetFragmentShadingRateKHR functionality, setting the pipeline fragment shading rate of subsequent draws.
+    /// Placing it at the top of a View's subgraph sets a per View shading rate, e.g. coarser shading for peripheral or low priority views.
+    /// Requires the Device to be created with the VK_KHR_fragment_shading_rate extension and its pipelineFragmentShadingRate feature,
+    /// and the GraphicsPipelines to list VK_DYNAMIC_STATE_FRAGMENT_SHADING_RATE_KHR in their DynamicState. Does nothing when the extension isn't enabled.
+    class VSG_DECLSPEC SetFragmentShadingRate : public Inherit<Command, SetFragmentShadingRate>
+    {
+    public:
+        explicit SetFragmentShadingRate(const VkExtent2D& in_fragmentSize = {1, 1});
+
+        /// size in pixels of the fragments shaded once, each dimension 1, 2 or 4.
+        VkExtent2D fragmentSize = {1, 1};
+
+        /// how the pipeline rate is combined with the primitive rate, and that result combined with the attachment rate.
+        VkFragmentShadingRateCombinerOpKHR combinerOps[2] = {VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR, VK_FRAGMENT_SHADING_RATE_COMBINER_OP_KEEP_KHR};
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        void record(CommandBuffer& commandBuffer) const override;
+    };
+    VSG_type_name(vsg::SetFragmentShadingRate);
+
+} // namespace vsg
@@ -14,6 +14,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/core/Export.h>
 
+#include <atomic>
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -25,7 +27,8 @@ namespace vsg
         ALLOCATOR_TYPE_NO_DELETE = 0,
         ALLOCATOR_TYPE_NEW_DELETE,
         ALLOCATOR_TYPE_MALLOC_FREE,
-        ALLOCATOR_TYPE_VSG_ALLOCATOR
+        ALLOCATOR_TYPE_VSG_ALLOCATOR,
+        ALLOCATOR_TYPE_ALIGNED_NEW_DELETE /// aligned operator new/delete using the alignment from Data::Properties::alignment
     };
 
     enum AllocatorAffinity : uint32_t
@@ -89,6 +92,46 @@ namespace vsg
     /// deallocate memory using vsg::Allocator::instance() if available, otherwise use std::free(ptr)
     extern VSG_DECLSPEC void deallocate(void* ptr, std::size_t size = 0);
 
+    /// return the alignment used by allocateAligned(..), at least alignof(std::max_align_t) and rounded up to a power of two
+    inline std::size_t alignedAllocationAlignment(std::size_t alignment)
+    {
+        std::size_t result = alignof(std::max_align_t);
+        while (result < alignment) result <<= 1;
+        return result;
+    }
+
+    /// allocate memory aligned to alignment, such as 16 for SIMD loads, 64 for cache lines or 4096 for pages, release with deallocateAligned(..) passing the same alignment
+    inline void* allocateAligned(std::size_t size, std::size_t alignment)
+    {
+        return ::operator new(size, std::align_val_t{alignedAllocationAlignment(alignment)});
+    }
+
+    /// deallocate memory allocated by allocateAligned(..)
+    inline void deallocateAligned(void* ptr, std::size_t alignment)
+    {
+        ::operator delete(ptr, std::align_val_t{alignedAllocationAlignment(alignment)});
+    }
+
+    /// AllocationTag assigns the name that allocations made by the current thread are attributed to while it's in scope,
+    /// used by Inherit<>::create() to attribute allocations to the class being created when an allocator such as TrackingAllocator enables tagging.
+    struct VSG_DECLSPEC AllocationTag
+    {
+        explicit AllocationTag(const char* name);
+        ~AllocationTag();
+
+        AllocationTag(const AllocationTag&) = delete;
+        AllocationTag& operator=(const AllocationTag&) = delete;
+
+        /// return the name of the innermost AllocationTag in scope on the current thread, nullptr if none.
+        static const char* current();
+
+        /// when true Inherit<>::create() assigns an AllocationTag for the class being created.
+        static std::atomic_bool enabled;
+
+    protected:
+        const char* _previous;
+    };
+
     /// std container adapter for allocating with specific affinity
     template<typename T, vsg::AllocatorAffinity A>
     struct allocator_affinity_adapter
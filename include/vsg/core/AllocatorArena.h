@@ -0,0 +1,95 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Inherit.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace vsg
+{
+
+    /// AllocatorArena is a region of memory that vsg::allocate(..) bump allocates from while the AllocatorArena is assigned to the current thread with an AllocatorArenaScope,
+    /// so the objects and data created while loading a subgraph are packed together and their memory freed in a single operation, rather than each allocation being returned
+    /// to the Allocator's MemoryBlocks. Each allocation holds a reference to the arena so its memory remains valid while any allocation made from it is still in use, such as
+    /// objects shared with other subgraphs. The memory of deallocated allocations isn't reused, the arena's blocks are freed once the last allocation has been deallocated and
+    /// all other references to the arena have been released.
+    class VSG_DECLSPEC AllocatorArena : public Inherit<Object, AllocatorArena>
+    {
+    public:
+        explicit AllocatorArena(size_t in_blockSize = 1024 * 1024, size_t in_alignment = 16);
+
+        AllocatorArena(const AllocatorArena&) = delete;
+        AllocatorArena& operator=(const AllocatorArena&) = delete;
+
+        /// size of the blocks of memory allocated from, larger allocations are given a block of their own.
+        const size_t blockSize;
+
+        /// alignment of all allocations.
+        const size_t alignment;
+
+        /// allocate from the current block, or a new block. Thread safe.
+        void* allocate(std::size_t size);
+
+        /// deallocate memory allocated from this arena, releasing the allocation's reference to the arena. Thread safe.
+        void deallocate(void* ptr);
+
+        /// number of allocations from this arena that haven't yet been deallocated.
+        size_t numAllocations() const { return _numAllocations.load(); }
+
+        /// total size of the blocks of memory allocated by this arena.
+        size_t totalMemorySize() const { return _totalMemorySize.load(); }
+
+        /// return the arena that ptr was allocated from, or nullptr if it wasn't allocated from an arena. Thread safe.
+        static AllocatorArena* find(const void* ptr);
+
+    protected:
+        virtual ~AllocatorArena();
+
+        struct Block
+        {
+            uint8_t* memory = nullptr;
+            size_t size = 0;
+        };
+
+        uint8_t* _allocateBlock(size_t size);
+
+        std::mutex _mutex;
+        std::vector<Block> _blocks;
+        uint8_t* _ptr = nullptr;
+        uint8_t* _end = nullptr;
+        std::atomic_size_t _numAllocations{0};
+        std::atomic_size_t _totalMemorySize{0};
+    };
+    VSG_type_name(vsg::AllocatorArena);
+
+    /// AllocatorArenaScope assigns the AllocatorArena that vsg::allocate(..) allocates from on the current thread while it's in scope, a null arena restores allocation from the Allocator.
+    struct VSG_DECLSPEC AllocatorArenaScope
+    {
+        explicit AllocatorArenaScope(ref_ptr<AllocatorArena> arena);
+        ~AllocatorArenaScope();
+
+        AllocatorArenaScope(const AllocatorArenaScope&) = delete;
+        AllocatorArenaScope& operator=(const AllocatorArenaScope&) = delete;
+
+        /// return the AllocatorArena assigned to the current thread, nullptr if none.
+        static AllocatorArena* current();
+
+    protected:
+        ref_ptr<AllocatorArena> _arena;
+        AllocatorArena* _previous;
+    };
+
+} // namespace vsg
@@ -48,7 +48,14 @@ namespace vsg
             _data(nullptr),
             _size(rhs._size)
         {
-            if (_size != 0)
+            if (_size != 0 && copyop.copyOnWriteData)
+            {
+                // share rhs's values until they are first accessed through a non const typed accessor
+                _storage = rhs._storage ? rhs._storage : ref_ptr<Data>(const_cast<Array*>(&rhs));
+                _data = rhs._data;
+                _copyOnWrite = true;
+            }
+            else if (_size != 0)
             {
                 _data = _allocate(_size);
                 auto dest_v = _data;
@@ -170,9 +177,23 @@ namespace vsg
             {
                 properties.stride = sizeof(value_type);
                 _size = width_size;
-                _storage = nullptr;
                 size_t new_total_size = computeValueCountIncludingMipmaps();
 
+                if (auto payload = input.readPayload<value_type>(new_total_size))
+                {
+                    // reference the payload directly, typically from a memory mapped file
+                    _delete();
+                    _storage = payload;
+                    _data = static_cast<value_type*>(_storage->dataPointer());
+                    dirty();
+                    return;
+                }
+
+                // existing data may be a view into another Data object's storage so can't be reused
+                if (_storage) _data = nullptr;
+                _storage = nullptr;
+                _copyOnWrite = false;
+
                 if (_data) // if data exists already may be able to reuse it
                 {
                     if (original_total_size != new_total_size) // if existing data is a different size delete old, and create new
@@ -207,6 +228,7 @@ namespace vsg
             }
 
             output.writePropertyName("data");
+            output.alignPayload<value_type>();
             output.write(size(), _data);
             output.writeEndOfLine();
         }
@@ -302,12 +324,38 @@ namespace vsg
             }
         }
 
+        bool relocate(ref_ptr<Data> storage, size_t offset) override
+        {
+            size_t size = dataSize();
+            uint8_t* dest = nullptr;
+            if (storage)
+            {
+                if (!storage->dataPointer() || (offset + size) > storage->dataSize()) return false;
+                dest = static_cast<uint8_t*>(storage->dataPointer()) + offset;
+            }
+            else
+            {
+                if (!_storage) return true;
+                if (properties.allocatorType == ALLOCATOR_TYPE_NO_DELETE) properties.allocatorType = ALLOCATOR_TYPE_VSG_ALLOCATOR;
+                dest = reinterpret_cast<uint8_t*>(_allocate((size + sizeof(value_type) - 1) / sizeof(value_type)));
+            }
+
+            if (dest != reinterpret_cast<uint8_t*>(_data) && _data) std::memmove(dest, _data, size);
+
+            _deallocate();
+            _storage = storage;
+            _data = reinterpret_cast<value_type*>(dest);
+            _copyOnWrite = false;
+            return true;
+        }
+
         size_t valueSize() const override { return sizeof(value_type); }
         size_t valueCount() const override { return size(); }
 
         bool dataAvailable() const override { return available(); }
         size_t dataSize() const override { return size() * properties.stride; }
 
+        /// untyped access used when transferring or hashing the values so doesn't detach shared copy-on-write values, call detachSharedData() before writing through it.
         void* dataPointer() override { return _data; }
         const void* dataPointer() const override { return _data; }
 
@@ -320,10 +368,18 @@ namespace vsg
         uint32_t height() const override { return 1; }
         uint32_t depth() const override { return 1; }
 
-        value_type* data() { return _data; }
+        value_type* data()
+        {
+            if (_copyOnWrite) detachSharedData();
+            return _data;
+        }
         const value_type* data() const { return _data; }
 
-        inline value_type* data(size_t i) { return reinterpret_cast<value_type*>(reinterpret_cast<uint8_t*>(_data) + i * static_cast<size_t>(properties.stride)); }
+        inline value_type* data(size_t i)
+        {
+            if (_copyOnWrite) detachSharedData();
+            return reinterpret_cast<value_type*>(reinterpret_cast<uint8_t*>(_data) + i * static_cast<size_t>(properties.stride));
+        }
         inline const value_type* data(size_t i) const { return reinterpret_cast<const value_type*>(reinterpret_cast<const uint8_t*>(_data) + i * static_cast<size_t>(properties.stride)); }
 
         value_type& operator[](size_t i) { return *data(i); }
@@ -337,12 +393,36 @@ namespace vsg
         Data* storage() { return _storage; }
         const Data* storage() const { return _storage; }
 
-        iterator begin() { return iterator{_data, properties.stride}; }
+        iterator begin() { return iterator{data(), properties.stride}; }
         const_iterator begin() const { return const_iterator{_data, properties.stride}; }
 
         iterator end() { return iterator{data(_size), properties.stride}; }
         const_iterator end() const { return const_iterator{data(_size), properties.stride}; }
 
+        /// return true if the values are shared with the Array this Array was copied from with CopyOp::copyOnWriteData set
+        bool copyOnWrite() const { return _copyOnWrite; }
+
+        /// copy the values shared with the Array this Array was copy-on-write cloned from, so that they can be modified without affecting other Arrays.
+        /// Called automatically by the non const typed accessors.
+        void detachSharedData()
+        {
+            if (!_copyOnWrite) return;
+            _copyOnWrite = false;
+
+            // the shared values may be referenced without ownership, e.g. from a memory mapped file, so the copy needs an allocator that deletes
+            if (properties.allocatorType == ALLOCATOR_TYPE_NO_DELETE) properties.allocatorType = ALLOCATOR_TYPE_VSG_ALLOCATOR;
+
+            auto shared = _storage;
+            const Array& self = *this;
+            auto dest = _allocate(_size);
+            auto dest_v = dest;
+            for (const auto& v : self) *(dest_v++) = v;
+
+            _storage = nullptr;
+            _data = dest;
+            properties.stride = sizeof(value_type);
+        }
+
     protected:
         virtual ~Array()
         {
@@ -357,28 +437,39 @@ namespace vsg
                 return new value_type[size];
             else if (properties.allocatorType == ALLOCATOR_TYPE_MALLOC_FREE)
                 return new (std::malloc(sizeof(value_type) * size)) value_type[size];
+            else if (properties.allocatorType == ALLOCATOR_TYPE_ALIGNED_NEW_DELETE)
+                return new (vsg::allocateAligned(sizeof(value_type) * size, properties.alignment)) value_type[size];
             else
                 return new (vsg::allocate(sizeof(value_type) * size, ALLOCATOR_AFFINITY_DATA)) value_type[size];
         }
 
         void _delete()
         {
+            _deallocate();
+            _clear();
+        }
+
+        void _deallocate()
+        {
+            _copyOnWrite = false;
+
             if (!_storage && _data)
             {
                 if (properties.allocatorType == ALLOCATOR_TYPE_NEW_DELETE)
                     delete[] _data;
                 else if (properties.allocatorType == ALLOCATOR_TYPE_MALLOC_FREE)
                     std::free(_data);
+                else if (properties.allocatorType == ALLOCATOR_TYPE_ALIGNED_NEW_DELETE)
+                    vsg::deallocateAligned(_data, properties.alignment);
                 else if (properties.allocatorType != 0)
                     vsg::deallocate(_data);
             }
-
-            _clear();
         }
 
     private:
         value_type* _data;
         uint32_t _size;
+        bool _copyOnWrite = false;
         ref_ptr<Data> _storage;
     };
 
@@ -158,10 +158,23 @@ namespace vsg
                 _width = w;
                 _height = h;
                 _depth = d;
-                _storage = nullptr;
 
                 size_t new_size = computeValueCountIncludingMipmaps();
 
+                if (auto payload = input.readPayload<value_type>(new_size))
+                {
+                    // reference the payload directly, typically from a memory mapped file
+                    _delete();
+                    _storage = payload;
+                    _data = static_cast<value_type*>(_storage->dataPointer());
+                    dirty();
+                    return;
+                }
+
+                // existing data may be a view into another Data object's storage so can't be reused
+                if (_storage) _data = nullptr;
+                _storage = nullptr;
+
                 if (_data) // if data exists already may be able to reuse it
                 {
                     if (original_size != new_size) // if existing data is a different size delete old, and create new
@@ -198,6 +211,7 @@ namespace vsg
             }
 
             output.writePropertyName("data");
+            output.alignPayload<value_type>();
             output.write(valueCount(), _data);
             output.writeEndOfLine();
         }
@@ -369,6 +383,8 @@ namespace vsg
                 return new value_type[size];
             else if (properties.allocatorType == ALLOCATOR_TYPE_MALLOC_FREE)
                 return new (std::malloc(sizeof(value_type) * size)) value_type[size];
+            else if (properties.allocatorType == ALLOCATOR_TYPE_ALIGNED_NEW_DELETE)
+                return new (vsg::allocateAligned(sizeof(value_type) * size, properties.alignment)) value_type[size];
             else
                 return new (vsg::allocate(sizeof(value_type) * size, ALLOCATOR_AFFINITY_DATA)) value_type[size];
         }
@@ -381,6 +397,8 @@ namespace vsg
                     delete[] _data;
                 else if (properties.allocatorType == ALLOCATOR_TYPE_MALLOC_FREE)
                     std::free(_data);
+                else if (properties.allocatorType == ALLOCATOR_TYPE_ALIGNED_NEW_DELETE)
+                    vsg::deallocateAligned(_data, properties.alignment);
                 else if (properties.allocatorType != 0)
                     vsg::deallocate(_data);
             }
@@ -0,0 +1,103 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/io/Compression.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace vsg
+{
+
+    /// CompressedData holds the values of another Data compressed into independently decompressible chunks, so that streamed vertex, index and image
+    /// payloads can be uploaded as is and decompressed on the GPU by TransferTask::gpuDecompressor, or directly into mapped memory on the CPU when that isn't available.
+    /// It reports the dimensions, properties and dataSize() of the uncompressed values but dataPointer() returns nullptr, so CPU side algorithms that read the values,
+    /// such as ComputeBounds and the intersectors, skip it. Only assign it to data that is just consumed by the GPU, typically the textures of paged tiles.
+    class VSG_DECLSPEC CompressedData : public Inherit<Data, CompressedData>
+    {
+    public:
+        CompressedData();
+
+        /// compress the values of data in chunks of chunkSize bytes, chunks that don't compress are stored as is. level of 0 selects the method's default.
+        explicit CompressedData(const Data& data, CompressionMethod in_method = COMPRESSION_LZ4, uint32_t in_chunkSize = 65536, int level = 0);
+
+        struct Chunk
+        {
+            uint32_t offset = 0; /// offset of the chunk's compressed bytes in the payload
+            uint32_t size = 0;   /// compressed size of the chunk, equal to its uncompressed size when stored as is
+        };
+
+        CompressionMethod method = COMPRESSION_NONE;
+
+        /// uncompressed size of each chunk, apart from the last which holds the remainder.
+        uint32_t chunkSize = 0;
+
+        std::vector<Chunk> chunks;
+
+        /// compressed bytes of all the chunks.
+        ref_ptr<ubyteArray> payload;
+
+        /// uncompressed size of the chunk at index.
+        uint32_t chunkDataSize(size_t index) const { return static_cast<uint32_t>(std::min(static_cast<uint64_t>(chunkSize), _dataSize - static_cast<uint64_t>(index) * chunkSize)); }
+
+        /// true if the values were compressed successfully and can be decompressed.
+        bool valid() const { return payload && !chunks.empty() && compressionSupported(method); }
+
+        /// decompress the values into dest, which must have room for dataSize() bytes.
+        bool decompress(void* dest) const;
+
+        int compare(const Object& rhs_object) const override;
+        uint64_t hash() const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        size_t valueSize() const override { return _valueSize; }
+        size_t valueCount() const override { return _valueCount; }
+
+        bool dataAvailable() const override { return false; }
+        size_t dataSize() const override { return static_cast<size_t>(_dataSize); }
+
+        void* dataPointer() override { return nullptr; }
+        const void* dataPointer() const override { return nullptr; }
+
+        void* dataPointer(size_t) override { return nullptr; }
+        const void* dataPointer(size_t) const override { return nullptr; }
+
+        void* dataRelease() override { return nullptr; }
+
+        uint32_t dimensions() const override { return _dimensions; }
+
+        uint32_t width() const override { return _width; }
+        uint32_t height() const override { return _height; }
+        uint32_t depth() const override { return _depth; }
+
+    protected:
+        virtual ~CompressedData();
+
+        uint32_t _dimensions = 0;
+        uint32_t _width = 0;
+        uint32_t _height = 0;
+        uint32_t _depth = 0;
+        uint32_t _valueSize = 0;
+        uint64_t _valueCount = 0;
+        uint64_t _dataSize = 0;
+    };
+    VSG_type_name(vsg::CompressedData);
+
+    /// copy the values of data to dest, decompressing them if data is a CompressedData. dest must have room for data.dataSize() bytes.
+    extern VSG_DECLSPEC bool copyData(const Data& data, void* dest);
+
+} // namespace vsg
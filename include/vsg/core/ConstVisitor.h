@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Array.h>
 #include <vsg/core/Array2D.h>
 #include <vsg/core/Array3D.h>
+#include <vsg/core/Dispatcher.h>
 #include <vsg/core/Mask.h>
 #include <vsg/core/Value.h>
 
@@ -30,10 +31,19 @@ namespace vsg
     class Commands;
     class Group;
     class QuadGroup;
+    class ParallelGroup;
     class LOD;
     class PagedLOD;
+    class PointCloudTile;
+    class PointCloud;
     class StateGroup;
+    class StreamingStateGroup;
     class CullGroup;
+    class BatchedCullGroup;
+    class LazyCompileGroup;
+    class SpatialGrid;
+    class PackedSubgraph;
+    class PackedDraws;
     class CullNode;
     class Transform;
     class MatrixTransform;
@@ -52,6 +62,7 @@ namespace vsg
     class SpotLight;
     class InstrumentationNode;
     class RegionOfInterest;
+    class Occluder;
     class InstanceNode;
     class InstanceDraw;
     class InstanceDrawIndexed;
@@ -175,6 +186,9 @@ namespace vsg
     class FrameStamp;
     class Instrumentation;
 
+    class ConstVisitor;
+    using ConstVisitorDispatcher = Dispatcher<ConstVisitor, const Object>;
+
     class VSG_DECLSPEC ConstVisitor : public Object
     {
     public:
@@ -190,6 +204,16 @@ namespace vsg
 
         virtual Instrumentation* getInstrumentation() { return nullptr; }
 
+        /// optional Dispatcher used by accept(..) to call the apply(..) overridden for an object's type directly, bypassing the chain of default apply(..) calls.
+        ConstVisitorDispatcher* dispatcher = nullptr;
+
+        /// dispatch object via the dispatcher, returning false if no dispatcher is assigned or it has no handler for the object's type.
+        template<class T>
+        bool dispatch(const T& object)
+        {
+            return dispatcher && dispatcher->dispatch(*this, typeID<T>(), object);
+        }
+
         virtual void apply(const Object&);
         virtual void apply(const Objects&);
         virtual void apply(const External&);
@@ -337,10 +361,19 @@ namespace vsg
         virtual void apply(const Commands&);
         virtual void apply(const Group&);
         virtual void apply(const QuadGroup&);
+        virtual void apply(const ParallelGroup&);
         virtual void apply(const LOD&);
         virtual void apply(const PagedLOD&);
+        virtual void apply(const PointCloudTile&);
+        virtual void apply(const PointCloud&);
         virtual void apply(const StateGroup&);
+        virtual void apply(const StreamingStateGroup&);
         virtual void apply(const CullGroup&);
+        virtual void apply(const BatchedCullGroup&);
+        virtual void apply(const LazyCompileGroup&);
+        virtual void apply(const SpatialGrid&);
+        virtual void apply(const PackedSubgraph&);
+        virtual void apply(const PackedDraws&);
         virtual void apply(const CullNode&);
         virtual void apply(const Transform&);
         virtual void apply(const MatrixTransform&);
@@ -359,6 +392,7 @@ namespace vsg
         virtual void apply(const SpotLight&);
         virtual void apply(const InstrumentationNode&);
         virtual void apply(const RegionOfInterest&);
+        virtual void apply(const Occluder&);
         virtual void apply(const InstanceNode&);
         virtual void apply(const InstanceDraw&);
         virtual void apply(const InstanceDrawIndexed&);
@@ -485,18 +519,30 @@ namespace vsg
 
     // provide Value<>::accept() implementation
     template<typename T>
-    void Value<T>::accept(ConstVisitor& visitor) const { visitor.apply(*this); }
+    void Value<T>::accept(ConstVisitor& visitor) const
+    {
+        if (!visitor.dispatch(*this)) visitor.apply(*this);
+    }
 
     // provide Array<>::accept() implementation
     template<typename T>
-    void Array<T>::accept(ConstVisitor& visitor) const { visitor.apply(*this); }
+    void Array<T>::accept(ConstVisitor& visitor) const
+    {
+        if (!visitor.dispatch(*this)) visitor.apply(*this);
+    }
 
     // provide Array2D<>::accept() implementation
     template<typename T>
-    void Array2D<T>::accept(ConstVisitor& visitor) const { visitor.apply(*this); }
+    void Array2D<T>::accept(ConstVisitor& visitor) const
+    {
+        if (!visitor.dispatch(*this)) visitor.apply(*this);
+    }
 
     // provide Array3D<>::accept() implementation
     template<typename T>
-    void Array3D<T>::accept(ConstVisitor& visitor) const { visitor.apply(*this); }
+    void Array3D<T>::accept(ConstVisitor& visitor) const
+    {
+        if (!visitor.dispatch(*this)) visitor.apply(*this);
+    }
 
 } // namespace vsg
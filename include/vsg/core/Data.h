@@ -18,6 +18,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/type_name.h>
 #include <vsg/vk/vulkan.h>
 
+#include <atomic>
 #include <cstring>
 #include <vector>
 
@@ -134,6 +135,7 @@ namespace vsg
             int8_t imageViewType = -1;               /// -1 signifies undefined VkImageViewType, if value >=0 then value should be treated as valid VkImageViewType.
             DataVariance dataVariance = STATIC_DATA; /// hint as to how the data values may change during the lifetime of the vsg::Data.
             AllocatorType allocatorType = ALLOCATOR_TYPE_VSG_ALLOCATOR;
+            uint32_t alignment = 0; /// alignment of the values allocated when allocatorType is ALLOCATOR_TYPE_ALIGNED_NEW_DELETE, e.g. 16 for SIMD loads or 4096 to match page boundaries.
 
             int compare(const Properties& rhs) const;
             Properties& operator=(const Properties& rhs);
@@ -162,6 +164,9 @@ namespace vsg
 
         int compare(const Object& rhs_object) const override;
 
+        /// return a hash of the className(), properties and data contents. The hash is cached against the ModifiedCount so call dirty() after modifying the data.
+        uint64_t hash() const override;
+
         void read(Input& input) override;
         void write(Output& output) const override;
 
@@ -184,6 +189,10 @@ namespace vsg
 
         virtual void* dataRelease() = 0;
 
+        /// move the values, keeping their current layout, to offset within storage, or back into memory owned by this Data when storage is null.
+        /// Used to place the values of dynamic data directly in mapped GPU memory. Returns false if not supported by the Data type.
+        virtual bool relocate(ref_ptr<Data> /*storage*/, size_t /*offset*/) { return false; }
+
         virtual uint32_t dimensions() const = 0;
 
         virtual uint32_t width() const = 0;
@@ -234,6 +243,9 @@ namespace vsg
 
         ModifiedCount _modifiedCount;
 
+        // upper 32 bits of the cached hash packed with the ModifiedCount it was computed for, so both can be updated atomically, 0 when not computed.
+        mutable std::atomic_uint64_t _cachedHash{0};
+
 #if 1
     public:
         /// deprecated: provided for backwards compatibility, use Properties instead.
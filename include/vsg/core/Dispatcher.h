@@ -0,0 +1,119 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace vsg
+{
+
+    /// allocate the next type ID, used by typeID<T>()
+    extern VSG_DECLSPEC uint32_t allocateTypeID();
+
+    /// return the type ID of class T, IDs are small consecutive integers allocated on first use so can be used to index dispatch tables.
+    /// IDs are not stable between runs so must not be serialized.
+    template<class T>
+    uint32_t typeID()
+    {
+        static const uint32_t s_typeID = allocateTypeID();
+        return s_typeID;
+    }
+
+    /// Dispatcher maps the type ID of visited objects directly to the apply(..) that a visitor overrides for that type (or its closest base class),
+    /// so that Inherit<>::accept(..) and Value/Array<>::accept(..) can make a single apply(..) call rather than walking the chain of default
+    /// apply(..) methods that forward from concrete type to base class. The handler for each type ID is resolved on first use with Object::is_compatible(..).
+    ///
+    /// Visitors opt in by assigning their Visitor::dispatcher/ConstVisitor::dispatcher member. Registrations are searched in order with the first compatible
+    /// registration used, so derived classes must be registered before their base classes, and every type the visitor overrides apply(..) for must be registered.
+    /// Dispatch is disabled when the visitor is of a different type than the one the registrations were written for, as subclasses may override other apply(..).
+    template<class V, class O>
+    class Dispatcher
+    {
+    public:
+        using Handler = void (*)(V& visitor, O& object);
+
+        struct Registration
+        {
+            const std::type_info* type;
+            Handler handler;
+        };
+
+        using Registrations = std::vector<Registration>;
+
+        /// create a Registration that calls visitor.apply(T&)
+        template<class T>
+        static Registration registration()
+        {
+            using T_ref = std::conditional_t<std::is_const_v<O>, const T&, T&>;
+            return Registration{&typeid(T), [](V& visitor, O& object) { visitor.apply(static_cast<T_ref>(object)); }};
+        }
+
+        /// registrations are referenced not copied, so should typically be a static that is shared between all instances of the visitor
+        Dispatcher(const Registrations& in_registrations, const std::type_info& in_visitorType) :
+            registrations(in_registrations),
+            visitorType(in_visitorType) {}
+
+        Dispatcher(const Dispatcher&) = delete;
+        Dispatcher& operator=(const Dispatcher&) = delete;
+
+        const Registrations& registrations;
+        const std::type_info& visitorType;
+
+        /// call the handler registered for object's type and return true, or return false if no handler applies so the caller should fall back to visitor.apply(..)
+        bool dispatch(V& visitor, uint32_t id, O& object)
+        {
+            if (_state == UNCHECKED) _state = (typeid(visitor) == visitorType) ? ENABLED : DISABLED;
+            if (_state == DISABLED) return false;
+
+            if (id >= _handlers.size()) _handlers.resize(id + 1, UNRESOLVED);
+
+            int32_t& index = _handlers[id];
+            if (index == UNRESOLVED) index = resolve(object);
+            if (index < 0) return false;
+
+            registrations[index].handler(visitor, object);
+            return true;
+        }
+
+    protected:
+        static constexpr int32_t UNRESOLVED = -2;
+        static constexpr int32_t NO_HANDLER = -1;
+
+        int32_t resolve(O& object) const
+        {
+            for (size_t i = 0; i < registrations.size(); ++i)
+            {
+                if (object.is_compatible(*registrations[i].type)) return static_cast<int32_t>(i);
+            }
+            return NO_HANDLER;
+        }
+
+        enum State
+        {
+            UNCHECKED,
+            ENABLED,
+            DISABLED
+        };
+
+        State _state = UNCHECKED;
+        std::vector<int32_t> _handlers;
+    };
+
+} // namespace vsg
@@ -17,6 +17,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/io/FileSystem.h>
 
+#include <mutex>
+#include <set>
+
 namespace vsg
 {
 
@@ -27,6 +30,7 @@ namespace vsg
     /// needed by the rest of the subgraph i.e.
     ///     auto external = vsg::External::create("mytexture.png", texture);
     ///     scene->setObject("external", external); // scene uses the texture object somewhere within it.
+    /// When read with Options::lazyExternalHint set the entries are read on demand, either through getObject(..), prefetch(..) or when a Visitor traverses the External.
     class VSG_DECLSPEC External : public Inherit<Object, External>
     {
     public:
@@ -43,7 +47,7 @@ namespace vsg
             }
         }
 
-        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(Visitor& visitor) override;
         void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
         void traverse(RecordTraversal&) const override {}
 
@@ -58,8 +62,36 @@ namespace vsg
 
         void add(const Path& filename, ref_ptr<Object> object = {}) { entries[filename] = object; }
 
+        /// when true entries are only read on first access rather than when the External is read, set from Options::lazyExternalHint when reading.
+        /// Objects in lazily read files can't be referenced by the rest of the file that the External is read from, such references are read as null,
+        /// so only use lazy reading for entries that are accessed through the External.
+        bool lazy = false;
+
+        /// get the object associated with filename, reading it first if it's a lazy entry that hasn't been read yet.
+        ref_ptr<Object> getObject(const Path& filename);
+
+        /// get the object associated with filename cast to type T, reading it first if it's a lazy entry that hasn't been read yet.
+        template<class T>
+        ref_ptr<T> getObject(const Path& filename) { return getObject(filename).cast<T>(); }
+
+        /// return true if the entry has been read, or there has been an attempt to read it.
+        bool resolved(const Path& filename) const;
+
+        /// hint that the specified entries will soon be required, lazy entries are read in the background by the Options::operationThreads if assigned, otherwise the hint is ignored.
+        void prefetch(const Paths& filenames);
+
+        /// read all the lazy entries that haven't been read yet, in parallel if Options::operationThreads is assigned.
+        void resolveAll();
+
     protected:
         virtual ~External();
+
+        ref_ptr<const Options> _readOptions() const;
+
+        mutable std::mutex _mutex;
+        std::set<Path> _attempted;
+        std::set<Path> _prefetching;
+        ref_ptr<const Options> _inputOptions;
     };
     VSG_type_name(vsg::External);
 
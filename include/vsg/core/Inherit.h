@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/app/RecordTraversal.h>
+#include <vsg/core/Allocator.h>
 #include <vsg/core/ConstVisitor.h>
 #include <vsg/core/Visitor.h>
 #include <vsg/core/ref_ptr.h>
@@ -34,6 +35,11 @@ namespace vsg
         template<typename... Args>
         static ref_ptr<Subclass> create(Args&&... args)
         {
+            if (AllocationTag::enabled.load(std::memory_order_relaxed))
+            {
+                AllocationTag tag(type_name<Subclass>());
+                return ref_ptr<Subclass>(new Subclass(std::forward<Args>(args)...));
+            }
             return ref_ptr<Subclass>(new Subclass(std::forward<Args>(args)...));
         }
 
@@ -67,8 +73,14 @@ namespace vsg
             return std::memcmp(lhs_ptr + startOfSubclass, rhs_ptr + startOfSubclass, size);
         }
 
-        void accept(Visitor& visitor) override { visitor.apply(static_cast<Subclass&>(*this)); }
-        void accept(ConstVisitor& visitor) const override { visitor.apply(static_cast<const Subclass&>(*this)); }
+        void accept(Visitor& visitor) override
+        {
+            if (!visitor.dispatch(static_cast<Subclass&>(*this))) visitor.apply(static_cast<Subclass&>(*this));
+        }
+        void accept(ConstVisitor& visitor) const override
+        {
+            if (!visitor.dispatch(static_cast<const Subclass&>(*this))) visitor.apply(static_cast<const Subclass&>(*this));
+        }
         void accept(RecordTraversal& visitor) const override { visitor.apply(static_cast<const Subclass&>(*this)); }
     };
 
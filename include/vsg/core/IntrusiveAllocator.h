@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/core/Allocator.h>
 
+#include <atomic>
 #include <list>
 #include <string>
 #include <vector>
@@ -42,6 +43,12 @@ namespace vsg
     // The maximum size of allocations within the block allocation is (2^15-2) * 4, allocations larger than this
     // are allocated using aligned versions of std::new and std::delete.
     //
+    // To avoid contention on the Allocator mutex when multiple threads allocate and deallocate concurrently,
+    // each thread keeps a cache of deallocated slots, grouped by AllocatorAffinity and size, that subsequent
+    // allocations of the same affinity and size are served from without taking the mutex. Caches that grow
+    // beyond threadCacheSize slots return half their slots to the MemoryBlocks in a single batch, and empty
+    // caches are refilled with a batch of slots allocated under a single lock.
+    //
     class VSG_DECLSPEC IntrusiveAllocator : public Allocator
     {
     public:
@@ -64,6 +71,15 @@ namespace vsg
         size_t totalMemorySize() const override;
         void setBlockSize(AllocatorAffinity allocatorAffinity, size_t blockSize) override;
 
+        /// maximum number of slots of each size and affinity held in each thread's cache, 0 disables thread caching.
+        size_t threadCacheSize = 32;
+
+        /// maximum size of allocations served from the thread caches, larger allocations always take the mutex.
+        size_t threadCacheMaximumAllocationSize = 512;
+
+        /// when true the pages of new MemoryBlocks are placed on the NUMA node of the thread that fills them, even when the process has been run with an interleaved memory policy.
+        bool numaLocalBlocks = true;
+
     protected:
         struct VSG_DECLSPEC MemoryBlock
         {
@@ -71,12 +87,16 @@ namespace vsg
             virtual ~MemoryBlock();
 
             std::string name;
+            uint32_t affinity = 0;
 
             void* allocate(std::size_t size);
             bool deallocate(void* ptr, std::size_t size);
 
             void report(std::ostream& out) const;
 
+            /// under Linux set the memory policy of the block's pages to MPOL_LOCAL, so they are placed on the NUMA node of the thread that first writes to them.
+            void bindToLocalNumaNode();
+
             // bitfield packing of doubly-linked with status field into a 4 byte word
             struct Element
             {
@@ -177,6 +197,7 @@ namespace vsg
 
             IntrusiveAllocator* parent = nullptr;
             std::string name;
+            uint32_t affinity = 0;
             size_t alignment = 8;
             size_t blockSize = 0;
             size_t maximumAllocationSize = 0;
@@ -196,6 +217,32 @@ namespace vsg
         std::vector<std::unique_ptr<MemoryBlocks>> allocatorMemoryBlocks;
         std::map<void*, std::shared_ptr<MemoryBlock>> memoryBlocks;
         std::map<void*, std::pair<size_t, size_t>> largeAllocations;
+
+        struct ThreadCache;
+        struct ThreadCaches;
+
+        // return the calling thread's cache for this allocator, or nullptr if the thread's caches have already been released at thread exit.
+        ThreadCache* threadCache();
+
+        // implementations of allocate/deallocate that require the mutex to be locked by the caller.
+        void* _allocate(std::size_t size, AllocatorAffinity allocatorAffinity);
+        bool _deallocate(void* ptr, std::size_t size);
+        MemoryBlock* _findMemoryBlock(const void* ptr) const;
+
+        // methods that manage thread caches, require the mutex to be locked by the caller.
+        void* _refillThreadCache(ThreadCache& cache, size_t sizeClass, AllocatorAffinity allocatorAffinity);
+        void _flushThreadCache(ThreadCache& cache, void*& head, size_t& count, size_t numSlots);
+        void _releaseThreadCache(ThreadCache& cache);
+        void _accumulateThreadCacheStats(ThreadCache& cache);
+
+        const uint64_t _allocatorID;
+        std::atomic_uint64_t _blockGeneration{0};
+
+        // thread cache stats, accumulated from each thread's own counters whenever it takes the mutex.
+        size_t _threadCacheHits = 0;
+        size_t _threadCacheMisses = 0;
+        size_t _threadCacheFlushes = 0;
+        int64_t _threadCacheSlots = 0;
     };
 
 } // namespace vsg
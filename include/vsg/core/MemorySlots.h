@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/core/Export.h>
 
+#include <cstdint>
 #include <list>
 #include <map>
 #include <ostream>
@@ -31,7 +32,9 @@ namespace vsg
         MEMORY_TRACKING_DEFAULT = MEMORY_TRACKING_NO_CHECKS
     };
 
-    /** class used internally by vsg::Allocator, vsg::DeviceMemory and vsg::Buffer to manage suballocation within a block of CPU or GPU memory.*/
+    /** class used internally by vsg::Allocator, vsg::DeviceMemory and vsg::Buffer to manage suballocation within a block of CPU or GPU memory.
+      * Available slots are binned using a two-level segregated fit (TLSF) scheme, first level by power of two and second level by linear subdivision,
+      * so finding a suitable slot is a constant time bitmap lookup rather than a search of all the available slots.*/
     class VSG_DECLSPEC MemorySlots
     {
     public:
@@ -43,14 +46,23 @@ namespace vsg
 
         bool release(size_t offset, size_t size);
 
-        bool full() const { return _availableMemory.empty(); }
+        bool full() const { return _offsetSizes.empty(); }
         bool empty() const { return totalAvailableSize() == totalMemorySize(); }
 
-        size_t maximumAvailableSpace() const { return _availableMemory.empty() ? 0 : _availableMemory.rbegin()->first; }
-        size_t totalAvailableSize() const;
-        size_t totalReservedSize() const;
+        size_t maximumAvailableSpace() const;
+        size_t totalAvailableSize() const { return _totalAvailableSize; }
+        size_t totalReservedSize() const { return _totalReservedSize; }
         size_t totalMemorySize() const { return _totalMemorySize; }
 
+        /// number of separate available slots
+        size_t numAvailableSlots() const { return _offsetSizes.size(); }
+
+        /// number of reserved slots
+        size_t numReservedSlots() const { return _reservedMemory.size(); }
+
+        /// ratio of the available memory that is not part of the largest available slot, 0.0 when all the available memory is contiguous.
+        double fragmentation() const;
+
         // debug facilities
         void report(std::ostream& out) const;
         bool check() const;
@@ -58,14 +70,35 @@ namespace vsg
         mutable int memoryTracking = MEMORY_TRACKING_DEFAULT;
 
     protected:
-        std::multimap<size_t, size_t> _availableMemory;
-        std::map<size_t, size_t> _offsetSizes;
+        static constexpr uint32_t SL_BITS = 4;
+        static constexpr uint32_t SL_COUNT = 1 << SL_BITS;
+        static constexpr uint32_t FL_COUNT = 64;
+        static constexpr size_t NO_SLOT = ~size_t(0);
+
+        /// available slot, doubly linked with the other available slots in the same bin.
+        struct AvailableSlot
+        {
+            size_t size = 0;
+            size_t previous = NO_SLOT;
+            size_t next = NO_SLOT;
+        };
+
+        std::map<size_t, AvailableSlot> _offsetSizes;
         std::map<size_t, size_t> _reservedMemory;
 
+        uint64_t _firstLevelBitmap = 0;
+        uint32_t _secondLevelBitmaps[FL_COUNT];
+        size_t _bins[FL_COUNT][SL_COUNT]; // offset of first available slot in each bin
+
+        /// map a slot size to the first and second level indices of the bin it's stored in.
+        static void mapping(size_t size, uint32_t& fl, uint32_t& sl);
+
         void insertAvailableSlot(size_t offset, size_t size);
         void removeAvailableSlot(size_t offset, size_t size);
 
         size_t _totalMemorySize;
+        size_t _totalAvailableSize = 0;
+        size_t _totalReservedSize = 0;
     };
 
 } // namespace vsg
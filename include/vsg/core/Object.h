@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <atomic>
 #include <map>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <vector>
 
@@ -38,11 +39,36 @@ namespace vsg
     template<typename T>
     constexpr bool has_read_write() { return false; }
 
+    template<typename T, typename = void>
+    struct has_value_type : std::false_type
+    {
+    };
+
+    template<typename T>
+    struct has_value_type<T, std::void_t<typename T::value_type>> : std::true_type
+    {
+    };
+
+    /// return true if type T is serialized to binary files as raw bytes, so arrays of T can be referenced directly from memory mapped files.
+    template<typename T>
+    constexpr bool is_raw_serializable()
+    {
+        if constexpr (has_read_write<T>() || !std::is_trivially_destructible_v<T> || std::is_same_v<T, long double>)
+            return false;
+        else if constexpr (has_value_type<T>::value)
+            return is_raw_serializable<typename T::value_type>();
+        else
+            return true;
+    }
+
     class CopyOp
     {
     public:
         mutable ref_ptr<Duplicate> duplicate;
 
+        /// when true copied Arrays share the values of the Array they are copied from until first accessed through a non const typed accessor.
+        bool copyOnWriteData = false;
+
         /// copy/clone pointer
         template<class T>
         inline ref_ptr<T> operator()(ref_ptr<T> ptr) const;
@@ -106,6 +132,10 @@ namespace vsg
         /// compare two objects, return -1 if this object is less than rhs, return 0 if it's equal, return 1 if rhs is greater,
         virtual int compare(const Object& rhs) const;
 
+        /// return a hash of the object's contents, objects that compare equal should return the same hash. Used by SharedObjects when useObjectHashes is enabled.
+        /// The default implementation hashes the className() and the values written by write(Output&).
+        virtual uint64_t hash() const;
+
         virtual void accept(Visitor& visitor);
         virtual void traverse(Visitor&) {}
 
@@ -119,14 +149,38 @@ namespace vsg
         virtual void write(Output& output) const;
 
         // ref counting methods
-        inline void ref() const noexcept { _referenceCount.fetch_add(1, std::memory_order_relaxed); }
+        inline void ref() const noexcept
+        {
+            if (_threadConfined)
+                _referenceCount.store(_referenceCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            else
+                _referenceCount.fetch_add(1, std::memory_order_relaxed);
+        }
         inline void unref() const noexcept
         {
-            if (_referenceCount.fetch_sub(1, std::memory_order_seq_cst) <= 1) _attemptDelete();
+            if (_threadConfined)
+            {
+                unsigned int count = _referenceCount.load(std::memory_order_relaxed);
+                _referenceCount.store(count - 1, std::memory_order_relaxed);
+                if (count <= 1) _attemptDelete();
+            }
+            else if (_referenceCount.fetch_sub(1, std::memory_order_seq_cst) <= 1)
+                _attemptDelete();
+        }
+        inline void unref_nodelete() const noexcept
+        {
+            if (_threadConfined)
+                _referenceCount.store(_referenceCount.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            else
+                _referenceCount.fetch_sub(1, std::memory_order_seq_cst);
         }
-        inline void unref_nodelete() const noexcept { _referenceCount.fetch_sub(1, std::memory_order_seq_cst); }
         inline unsigned int referenceCount() const noexcept { return _referenceCount.load(); }
 
+        /// when set ref()/unref() update the reference count with plain loads and stores rather than atomic read-modify-writes,
+        /// only safe while the object is accessed by a single thread. Usually set via vsg::ThreadConfinedScope.
+        inline void setThreadConfined(bool confined) const noexcept { _threadConfined = confined; }
+        inline bool getThreadConfined() const noexcept { return _threadConfined; }
+
         /// meta data access methods
         /// wraps the value with a vsg::Value<T> object and then assigns via setObject(key, vsg::Value<T>)
         template<typename T>
@@ -188,6 +242,7 @@ namespace vsg
         friend class Auxiliary;
 
         mutable std::atomic_uint _referenceCount;
+        mutable bool _threadConfined;
 
         Auxiliary* _auxiliary;
     };
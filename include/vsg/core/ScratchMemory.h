@@ -15,6 +15,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Inherit.h>
 
 #include <algorithm>
+#include <new>
+#include <vector>
 
 namespace vsg
 {
@@ -25,6 +27,9 @@ namespace vsg
         uint8_t* ptr = nullptr;
         size_t size = 0;
 
+        /// number of allocate() calls since the last release(), used to report the usage of frame scoped ScratchMemory.
+        size_t numAllocations = 0;
+
         ref_ptr<ScratchMemory> next;
 
         explicit ScratchMemory(size_t bufferSize)
@@ -54,6 +59,8 @@ namespace vsg
         {
             if (num == 0) return nullptr;
 
+            ++numAllocations;
+
             size_t allocate_size = sizeof(T) * num;
 
             if ((ptr + allocate_size) <= (buffer + size))
@@ -74,8 +81,74 @@ namespace vsg
         void release()
         {
             ptr = buffer;
+            numAllocations = 0;
             if (next) next->release();
         }
+
+        /// total size of this and any chained ScratchMemory
+        size_t totalSize() const { return next ? size + next->totalSize() : size; }
+
+        /// release all allocations, replacing any chained ScratchMemory with a single buffer large enough to hold them,
+        /// so that repeating the same allocations doesn't require any further heap allocations. Returns true if the buffer was resized.
+        bool consolidate()
+        {
+            if (!next)
+            {
+                release();
+                return false;
+            }
+
+            size_t newSize = totalSize();
+            next = {};
+
+            delete[] buffer;
+            size = newSize;
+            buffer = new uint8_t[size];
+            ptr = buffer;
+            numAllocations = 0;
+            return true;
+        }
+    };
+
+    /// std::allocator compatible allocator that allocates from ScratchMemory, deallocate() is a no-op with the memory reclaimed by ScratchMemory::release().
+    /// Containers using a ScratchAllocator must not be used after the ScratchMemory is released. When no ScratchMemory is assigned the heap is used.
+    template<typename T>
+    struct ScratchAllocator
+    {
+        using value_type = T;
+
+        ScratchMemory* scratchMemory = nullptr;
+
+        ScratchAllocator(ScratchMemory* in_scratchMemory = nullptr) noexcept :
+            scratchMemory(in_scratchMemory) {}
+
+        template<typename U>
+        ScratchAllocator(const ScratchAllocator<U>& rhs) noexcept :
+            scratchMemory(rhs.scratchMemory) {}
+
+        T* allocate(size_t num)
+        {
+            // ScratchMemory only aligns allocations to pointer size
+            static_assert(alignof(T) <= sizeof(void*), "ScratchAllocator does not support over aligned types.");
+
+            if (scratchMemory) return scratchMemory->allocate<T>(num);
+            return static_cast<T*>(::operator new(num * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t) noexcept
+        {
+            if (!scratchMemory) ::operator delete(p);
+        }
+
+        template<typename U>
+        bool operator==(const ScratchAllocator<U>& rhs) const noexcept { return scratchMemory == rhs.scratchMemory; }
+
+        template<typename U>
+        bool operator!=(const ScratchAllocator<U>& rhs) const noexcept { return scratchMemory != rhs.scratchMemory; }
     };
 
+    /// std::vector that allocates from ScratchMemory, used for temporary containers.
+    template<typename T>
+    using scratch_vector = std::vector<T, ScratchAllocator<T>>;
+
 } // namespace vsg
@@ -0,0 +1,96 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Allocator.h>
+
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace vsg
+{
+
+    /// TrackingAllocator wraps a nested Allocator, recording allocation counts and bytes by AllocatorAffinity and by the AllocationTag in scope,
+    /// which Inherit<>::create() assigns to the className() of the Object being created, so that allocation hot spots and per frame leaks can be found.
+    /// Enable by wrapping the current allocator:
+    ///     vsg::Allocator::instance().reset(new vsg::TrackingAllocator(std::move(vsg::Allocator::instance())));
+    class VSG_DECLSPEC TrackingAllocator : public Allocator
+    {
+    public:
+        explicit TrackingAllocator(std::unique_ptr<Allocator> in_nestedAllocator);
+        ~TrackingAllocator();
+
+        struct Stats
+        {
+            uint64_t allocations = 0;
+            uint64_t deallocations = 0;
+            uint64_t allocatedBytes = 0;
+            uint64_t deallocatedBytes = 0;
+
+            int64_t liveAllocations() const { return static_cast<int64_t>(allocations) - static_cast<int64_t>(deallocations); }
+            int64_t liveBytes() const { return static_cast<int64_t>(allocatedBytes) - static_cast<int64_t>(deallocatedBytes); }
+
+            Stats& operator-=(const Stats& rhs)
+            {
+                allocations -= rhs.allocations;
+                deallocations -= rhs.deallocations;
+                allocatedBytes -= rhs.allocatedBytes;
+                deallocatedBytes -= rhs.deallocatedBytes;
+                return *this;
+            }
+        };
+
+        struct Snapshot
+        {
+            std::array<Stats, ALLOCATOR_AFFINITY_LAST> affinities;
+            std::map<std::string, Stats> tags; // allocations made without an AllocationTag in scope are recorded against "untagged"
+        };
+
+        /// return the stats accumulated since tracking started
+        Snapshot snapshot() const;
+
+        /// return the change in stats since the previous call to delta(), call once per frame to track per frame allocations and leaks
+        Snapshot delta();
+
+        /// write snapshot to out, skipping tags with no allocations or deallocations.
+        static void report(std::ostream& out, const Snapshot& snapshot);
+
+        void report(std::ostream& out) const override;
+
+        void* allocate(std::size_t size, AllocatorAffinity allocatorAffinity = ALLOCATOR_AFFINITY_OBJECTS) override;
+        bool deallocate(void* ptr, std::size_t size) override;
+
+        size_t deleteEmptyMemoryBlocks() override;
+        size_t totalAvailableSize() const override;
+        size_t totalReservedSize() const override;
+        size_t totalMemorySize() const override;
+        void setBlockSize(AllocatorAffinity allocatorAffinity, size_t blockSize) override;
+
+    protected:
+        struct Allocation
+        {
+            size_t size;
+            AllocatorAffinity affinity;
+            Stats* tagStats;
+        };
+
+        mutable std::mutex _trackingMutex;
+        std::unordered_map<void*, Allocation> _allocations;
+        Snapshot _current;
+        Snapshot _previous;
+    };
+
+} // namespace vsg
@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Array.h>
 #include <vsg/core/Array2D.h>
 #include <vsg/core/Array3D.h>
+#include <vsg/core/Dispatcher.h>
 #include <vsg/core/Mask.h>
 #include <vsg/core/Value.h>
 
@@ -30,10 +31,19 @@ namespace vsg
     class Commands;
     class Group;
     class QuadGroup;
+    class ParallelGroup;
     class LOD;
     class PagedLOD;
+    class PointCloudTile;
+    class PointCloud;
     class StateGroup;
+    class StreamingStateGroup;
     class CullGroup;
+    class BatchedCullGroup;
+    class LazyCompileGroup;
+    class SpatialGrid;
+    class PackedSubgraph;
+    class PackedDraws;
     class CullNode;
     class Transform;
     class MatrixTransform;
@@ -52,6 +62,7 @@ namespace vsg
     class SpotLight;
     class InstrumentationNode;
     class RegionOfInterest;
+    class Occluder;
     class InstanceNode;
     class InstanceDraw;
     class InstanceDrawIndexed;
@@ -175,6 +186,9 @@ namespace vsg
     class FrameStamp;
     class Instrumentation;
 
+    class Visitor;
+    using VisitorDispatcher = Dispatcher<Visitor, Object>;
+
     class VSG_DECLSPEC Visitor : public Object
     {
     public:
@@ -190,6 +204,16 @@ namespace vsg
 
         virtual Instrumentation* getInstrumentation() { return nullptr; }
 
+        /// optional Dispatcher used by accept(..) to call the apply(..) overridden for an object's type directly, bypassing the chain of default apply(..) calls.
+        VisitorDispatcher* dispatcher = nullptr;
+
+        /// dispatch object via the dispatcher, returning false if no dispatcher is assigned or it has no handler for the object's type.
+        template<class T>
+        bool dispatch(T& object)
+        {
+            return dispatcher && dispatcher->dispatch(*this, typeID<T>(), object);
+        }
+
         virtual void apply(Object&);
         virtual void apply(Objects&);
         virtual void apply(External&);
@@ -337,10 +361,19 @@ namespace vsg
         virtual void apply(Commands&);
         virtual void apply(Group&);
         virtual void apply(QuadGroup&);
+        virtual void apply(ParallelGroup&);
         virtual void apply(LOD&);
         virtual void apply(PagedLOD&);
+        virtual void apply(PointCloudTile&);
+        virtual void apply(PointCloud&);
         virtual void apply(StateGroup&);
+        virtual void apply(StreamingStateGroup&);
         virtual void apply(CullGroup&);
+        virtual void apply(BatchedCullGroup&);
+        virtual void apply(LazyCompileGroup&);
+        virtual void apply(SpatialGrid&);
+        virtual void apply(PackedSubgraph&);
+        virtual void apply(PackedDraws&);
         virtual void apply(CullNode&);
         virtual void apply(Transform&);
         virtual void apply(MatrixTransform&);
@@ -359,6 +392,7 @@ namespace vsg
         virtual void apply(SpotLight&);
         virtual void apply(InstrumentationNode&);
         virtual void apply(RegionOfInterest&);
+        virtual void apply(Occluder&);
         virtual void apply(InstanceNode&);
         virtual void apply(InstanceDraw&);
         virtual void apply(InstanceDrawIndexed&);
@@ -485,18 +519,30 @@ namespace vsg
 
     // provide Value<>::accept() implementation
     template<typename T>
-    void Value<T>::accept(Visitor& visitor) { visitor.apply(*this); }
+    void Value<T>::accept(Visitor& visitor)
+    {
+        if (!visitor.dispatch(*this)) visitor.apply(*this);
+    }
 
     // provide Array<>::accept() implementation
     template<typename T>
-    void Array<T>::accept(Visitor& visitor) { visitor.apply(*this); }
+    void Array<T>::accept(Visitor& visitor)
+    {
+        if (!visitor.dispatch(*this)) visitor.apply(*this);
+    }
 
     // provide Array2D<>::accept() implementation
     template<typename T>
-    void Array2D<T>::accept(Visitor& visitor) { visitor.apply(*this); }
+    void Array2D<T>::accept(Visitor& visitor)
+    {
+        if (!visitor.dispatch(*this)) visitor.apply(*this);
+    }
 
     // provide Array3D<>::accept() implementation
     template<typename T>
-    void Array3D<T>::accept(Visitor& visitor) { visitor.apply(*this); }
+    void Array3D<T>::accept(Visitor& visitor)
+    {
+        if (!visitor.dispatch(*this)) visitor.apply(*this);
+    }
 
 } // namespace vsg
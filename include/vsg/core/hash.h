@@ -0,0 +1,72 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <cstdint>
+#include <cstring>
+
+namespace vsg
+{
+
+    /// combine value into the seed hash value.
+    inline uint64_t hash_combine(uint64_t seed, uint64_t value)
+    {
+        // 64 bit variant of boost::hash_combine
+        return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 12) + (seed >> 4));
+    }
+
+    /// final avalanche mix of a 64 bit value, from MurmurHash3's fmix64.
+    inline uint64_t hash_mix(uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    /// hash size bytes of data, processing 8 bytes at a time so that hashing large arrays is fast. Not suitable for persistent hashes as values depend on endianness.
+    inline uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0)
+    {
+        const uint64_t m = 0xc6a4a7935bd1e995ull;
+        uint64_t h = seed ^ (size * m);
+
+        auto ptr = static_cast<const uint8_t*>(data);
+        auto end = ptr + (size & ~static_cast<size_t>(7));
+        for (; ptr != end; ptr += 8)
+        {
+            uint64_t k;
+            std::memcpy(&k, ptr, 8);
+
+            k *= m;
+            k ^= k >> 47;
+            k *= m;
+
+            h ^= k;
+            h *= m;
+        }
+
+        if (size_t remainder = size & 7; remainder != 0)
+        {
+            uint64_t k = 0;
+            std::memcpy(&k, ptr, remainder);
+            h ^= k;
+            h *= m;
+        }
+
+        return hash_mix(h);
+    }
+
+} // namespace vsg
@@ -0,0 +1,75 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/MappedFile.h>
+#include <vsg/io/ReaderWriter.h>
+
+#include <map>
+
+namespace vsg
+{
+
+    /// Archive is a ReaderWriter that reads files packed into a single indexed .vsgarc archive file. The archive is memory mapped and the entries are passed as memory blocks
+    /// to the ReaderWriter::read(ptr, size, options) of the ReaderWriters assigned to the Options, or the built-in formats if none are assigned, so they're read without copying
+    /// the file contents. When an entry is a .vsgb file the array payloads of BinaryInput::mappedPayloadThreshold bytes or more reference the mapped archive directly rather than being copied.
+    /// To use, add the Archive to the Options::readerWriters ahead of the other ReaderWriters, then read entries by the name they were packed with, or with the
+    /// archive filename prepended, i.e.
+    ///     options->readerWriters.insert(options->readerWriters.begin(), vsg::Archive::create("assets.vsgarc"));
+    ///     auto model = vsg::read_cast<vsg::Node>("models/tank.vsgb", options);
+    class VSG_DECLSPEC Archive : public Inherit<ReaderWriter, Archive>
+    {
+    public:
+        Archive();
+        explicit Archive(const Path& in_filename);
+
+        struct Entry
+        {
+            uint64_t offset = 0;
+            uint64_t size = 0;
+        };
+
+        /// open the archive file and read its index, return true on success.
+        bool open(const Path& in_filename);
+
+        /// return true if the archive has been opened successfully.
+        bool valid() const { return _mappedFile && _mappedFile->valid(); }
+
+        const Path& filename() const { return _filename; }
+
+        /// index of the entries in the archive, mapping the entry name to its location in the archive.
+        const std::map<std::string, Entry>& entries() const { return _entries; }
+
+        /// return true if the archive contains the specified entry
+        bool contains(const Path& entryName) const { return _entries.count(_entryName(entryName)) != 0; }
+
+        /// get the memory block of an entry, returns nullptr if the entry isn't in the archive.
+        const uint8_t* data(const Path& entryName, size_t& size) const;
+
+        ref_ptr<Object> read(const Path& entryName, ref_ptr<const Options> options = {}) const override;
+
+        bool getFeatures(Features& features) const override;
+
+        /// pack the files into an archive, mapping the entry names to the files to read them from, return true on success.
+        static bool pack(const Path& archiveFilename, const std::map<std::string, Path>& files);
+
+    protected:
+        std::string _entryName(const Path& path) const;
+
+        Path _filename;
+        ref_ptr<MappedFile> _mappedFile;
+        std::map<std::string, Entry> _entries;
+    };
+    VSG_type_name(vsg::Archive);
+
+} // namespace vsg
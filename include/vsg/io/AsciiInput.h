@@ -18,7 +18,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/ObjectFactory.h>
 #include <vsg/io/Options.h>
 
+#include <charconv>
+#include <cstdlib>
 #include <fstream>
+#include <sstream>
+#include <type_traits>
 
 namespace vsg
 {
@@ -38,40 +42,61 @@ namespace vsg
 
         OptionalObjectID objectID();
 
+        /// read the next whitespace delimited token from the input stream into token, sets the stream's failbit if no token could be read.
+        void _readToken(std::string& token);
+
+        /// convert token to a number using std::from_chars, falling back to std::istream parsing for number formats that std::from_chars doesn't accept.
         template<typename T>
-        void _read(size_t num, T* value)
+        void _parse(const std::string& token, T& value)
         {
-            if (num == 1)
+            const char* first = token.data();
+            const char* last = first + token.size();
+            if (first != last && *first == '+') ++first;
+
+            if constexpr (std::is_floating_point_v<T>)
             {
-                _input >> *value;
+#if defined(__cpp_lib_to_chars)
+                if (std::from_chars(first, last, value).ec == std::errc() || token.empty()) return;
+#else
+                if (token.empty()) return;
+                char* end = nullptr;
+                long double v = std::strtold(first, &end);
+                if (end == last)
+                {
+                    value = static_cast<T>(v);
+                    return;
+                }
+#endif
             }
             else
             {
-                for (; num > 0; --num, ++value)
-                {
-                    _input >> *value;
-                }
+                if (std::from_chars(first, last, value).ec == std::errc() || token.empty()) return;
+            }
+
+            std::istringstream str(token);
+            if (!(str >> value)) _input.setstate(std::ios_base::failbit);
+        }
+
+        template<typename T>
+        void _read(size_t num, T* value)
+        {
+            for (; num > 0; --num, ++value)
+            {
+                _readToken(_token);
+                _parse(_token, *value);
             }
         }
 
         template<typename R, typename T>
         void _read_withcast(size_t num, T* value)
         {
-            if (num == 1)
+            R v{};
+            for (; num > 0; --num, ++value)
             {
-                R v;
-                _input >> v;
+                _readToken(_token);
+                _parse(_token, v);
                 *value = static_cast<T>(v);
             }
-            else
-            {
-                R v;
-                for (; num > 0; --num, ++value)
-                {
-                    _input >> v;
-                    *value = static_cast<T>(v);
-                }
-            }
         }
 
         // read value(s)
@@ -109,6 +134,7 @@ namespace vsg
         std::istream& _input;
 
         std::string _readPropertyName;
+        std::string _token;
     };
 
 } // namespace vsg
@@ -17,7 +17,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Output.h>
 
 #include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
+#include <type_traits>
 
 namespace vsg
 {
@@ -41,79 +45,78 @@ namespace vsg
         /// write end of line as an \n
         void writeEndOfLine() override { _output << '\n'; }
 
+        /// convert value to characters in the range [first, last), returning the end of the characters written.
+        /// Real numbers are written using printf's %g formatting to match std::ostream's default formatting with the specified precision.
         template<typename T>
-        void _write(size_t num, const T* value)
+        static char* _to_chars(char* first, char* last, T value, int precision)
         {
-            if (num == 1)
+            if constexpr (std::is_floating_point_v<T>)
             {
-                _output << ' ' << *value;
+                if (!std::isfinite(value)) value = T(0); // fallback to using 0.0 when the value is NaN or Infinite to prevent problems when reading
+#if defined(__cpp_lib_to_chars)
+                return std::to_chars(first, last, value, std::chars_format::general, precision).ptr;
+#else
+                int length = 0;
+                if constexpr (std::is_same_v<T, long double>)
+                    length = std::snprintf(first, last - first, "%.*Lg", precision, value);
+                else
+                    length = std::snprintf(first, last - first, "%.*g", precision, static_cast<double>(value));
+                return first + std::min(static_cast<std::ptrdiff_t>(length), last - first);
+#endif
             }
             else
             {
-                for (size_t numInRow = 1; num > 0; --num, ++value, ++numInRow)
-                {
-                    _output << ' ' << *value;
-
-                    if (numInRow == _maximumNumbersPerLine && num > 1)
-                    {
-                        numInRow = 0;
-                        writeEndOfLine();
-                        indent();
-                    }
-                }
+                return std::to_chars(first, last, value).ptr;
             }
         }
 
-        template<typename T>
-        void _write_real(size_t num, const T* value)
+        /// write numbers as space separated characters, batching the characters into a local buffer so that large arrays are written to the std::ostream in a few bulk writes.
+        template<typename R, typename T>
+        void _write_numbers(size_t num, const T* value, int precision = 0)
         {
-            if (num == 1)
-            {
-                if (std::isfinite(*value))
-                    _output << ' ' << *value;
-                else
-                    _output << ' ' << 0.0; // fallback to using 0.0 when the value is NaN or Infinite to prevent problems when reading
-            }
-            else
+            constexpr std::ptrdiff_t maxNumberLength = 64;
+            char buffer[1024];
+            char* ptr = buffer;
+            char* end = buffer + sizeof(buffer);
+            for (size_t numInRow = 1; num > 0; --num, ++value, ++numInRow)
             {
-                for (size_t numInRow = 1; num > 0; --num, ++value, ++numInRow)
+                if ((end - ptr) < maxNumberLength)
+                {
+                    _output.write(buffer, ptr - buffer);
+                    ptr = buffer;
+                }
+
+                *(ptr++) = ' ';
+                ptr = _to_chars(ptr, end, static_cast<R>(*value), precision);
+
+                if (numInRow == _maximumNumbersPerLine && num > 1)
                 {
-                    if (std::isfinite(*value))
-                        _output << ' ' << *value;
-                    else
-                        _output << ' ' << 0.0; // fallback to using 0.0 when the value is NaN or Infinite to prevent problems when reading
-
-                    if (numInRow == _maximumNumbersPerLine && num > 1)
-                    {
-                        numInRow = 0;
-                        writeEndOfLine();
-                        indent();
-                    }
+                    numInRow = 0;
+                    _output.write(buffer, ptr - buffer);
+                    ptr = buffer;
+                    writeEndOfLine();
+                    indent();
                 }
             }
+            _output.write(buffer, ptr - buffer);
+        }
+
+        template<typename T>
+        void _write(size_t num, const T* value)
+        {
+            _write_numbers<T>(num, value);
+        }
+
+        template<typename T>
+        void _write_real(size_t num, const T* value)
+        {
+            _write_numbers<T>(num, value, static_cast<int>(_output.precision()));
         }
 
         template<typename R, typename T>
         void _write_withcast(size_t num, const T* value)
         {
-            if (num == 1)
-            {
-                _output << ' ' << static_cast<R>(*value);
-            }
-            else
-            {
-                for (size_t numInRow = 1; num > 0; --num, ++value, ++numInRow)
-                {
-                    _output << ' ' << static_cast<R>(*value);
-
-                    if (numInRow == _maximumNumbersPerLine && num > 1)
-                    {
-                        numInRow = 0;
-                        writeEndOfLine();
-                        indent();
-                    }
-                }
-            }
+            _write_numbers<R>(num, value);
         }
 
         // write contiguous array of value(s)
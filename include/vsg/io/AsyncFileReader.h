@@ -0,0 +1,108 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array.h>
+#include <vsg/io/Path.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace vsg
+{
+
+    /// AsyncRead is a request to read the whole contents of a file, used with AsyncFileReader.
+    class VSG_DECLSPEC AsyncRead : public Inherit<Object, AsyncRead>
+    {
+    public:
+        explicit AsyncRead(const Path& in_filename, ref_ptr<Object> in_object = {}) :
+            filename(in_filename),
+            object(in_object) {}
+
+        /// file to read
+        Path filename;
+
+        /// user object associated with the request, such as the PagedLOD that the file is being read for
+        ref_ptr<Object> object;
+
+        /// contents of file, assigned on successful completion of the read
+        ref_ptr<ubyteArray> data;
+
+        /// return true if the file was successfully read
+        bool succeeded() const { return data.valid(); }
+    };
+    VSG_type_name(vsg::AsyncRead);
+
+    /// AsyncFileReader reads the contents of files asynchronously into memory so a few threads can keep many reads in flight, decoupling file I/O from decoding of the file contents.
+    /// Uses io_uring on Linux and overlapped I/O with an I/O completion port on Windows, falling back to blocking reads on a dedicated I/O thread when these aren't available.
+    /// Requests are submitted with read(..) and the completed requests taken with take_when_available(..), typically from a pool of decode threads
+    /// that pass the file contents to vsg::read(ptr, size, options), see DatabasePager::asyncFileReader.
+    class VSG_DECLSPEC AsyncFileReader : public Inherit<Object, AsyncFileReader>
+    {
+    public:
+        /// queueDepth is the maximum number of reads in flight at one time, maxPendingReads the number of submitted but not yet taken requests at which wait_for_capacity(..) blocks.
+        explicit AsyncFileReader(uint32_t in_queueDepth = 64, uint32_t in_maxPendingReads = 128);
+
+        AsyncFileReader(const AsyncFileReader&) = delete;
+        AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+        const uint32_t queueDepth;
+        uint32_t maxPendingReads;
+
+        /// name of the I/O mechanism used, "io_uring", "overlapped" or "blocking".
+        const char* backend() const;
+
+        /// submit a read request, returns immediately. Requests for files that can't be opened are completed immediately with a null data.
+        void read(ref_ptr<AsyncRead> request);
+
+        /// take a completed request, waiting up to timeout for one to complete, returns null if none completed in time.
+        ref_ptr<AsyncRead> take_when_available(std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
+
+        /// wait up to timeout for the number of pending requests to fall below maxPendingReads, returns true if submitting more requests is appropriate.
+        bool wait_for_capacity(std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
+
+        /// number of requests submitted that haven't yet been taken.
+        size_t numPending() const;
+
+        class Backend;
+        struct PendingRead;
+
+    protected:
+        virtual ~AsyncFileReader();
+
+        void _run();
+        void _submit(PendingRead* pending);
+        void _complete(PendingRead* pending, bool success);
+
+        std::unique_ptr<Backend> _backend;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _completedCV;
+        std::condition_variable _capacityCV;
+        std::deque<ref_ptr<AsyncRead>> _completed;
+        std::deque<PendingRead*> _waiting;
+        uint32_t _numInFlight = 0;
+        size_t _numPending = 0;
+
+        std::atomic_bool _active{true};
+        std::thread _thread;
+    };
+    VSG_type_name(vsg::AsyncFileReader);
+
+} // namespace vsg
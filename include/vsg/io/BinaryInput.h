@@ -14,10 +14,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/core/Object.h>
 
+#include <vsg/io/Compression.h>
 #include <vsg/io/Input.h>
+#include <vsg/io/MappedFile.h>
 #include <vsg/io/Options.h>
 
 #include <fstream>
+#include <vector>
 
 namespace vsg
 {
@@ -41,7 +44,10 @@ namespace vsg
         template<typename T>
         void _read(size_t num, T* value)
         {
-            _input.read(reinterpret_cast<char*>(value), num * sizeof(T));
+            if (_payloadCompression != COMPRESSION_NONE)
+                _readCompressedPayload(reinterpret_cast<uint8_t*>(value), num * sizeof(T));
+            else
+                _input.read(reinterpret_cast<char*>(value), num * sizeof(T));
         }
 
         // read value(s)
@@ -75,8 +81,41 @@ namespace vsg
         /// read object
         vsg::ref_ptr<vsg::Object> read() override;
 
+        /// when set and the input stream is reading from the mappedFile, array payloads of mappedPayloadThreshold bytes or more reference the mapped memory directly rather than being copied.
+        ref_ptr<MappedFile> mappedFile;
+        size_t mappedPayloadThreshold = 4096;
+
+        /// offset of the start of the input stream within the mappedFile, used when reading a block of a mapped file such as an Archive entry.
+        size_t mappedFileOffset = 0;
+
+        void readPayloadAlignment() override;
+        ref_ptr<Data> mapPayload(size_t size, size_t alignment) override;
+
+        /// continue from the objects and types already read by rhs, so that objects in chunks can reference the shared objects that precede them.
+        void continueFrom(const BinaryInput& rhs);
+
     protected:
+        /// read a group written by BinaryOutput::writeChunks(..), decoding the chunks in parallel when Options::operationThreads are assigned.
+        ref_ptr<Object> _readChunks();
+
+        /// decompress the pending compressed payload directly into the destination memory.
+        void _readCompressedPayload(uint8_t* data, size_t size);
+
         std::istream& _input;
+
+        struct TypeEntry
+        {
+            std::string className;
+            ObjectFactory::CreateFunction create;
+        };
+
+        /// type table built up as class names are first encountered in files written with version 1.1.17 onwards, indexed by type ID with entry 0 reserved for nullptr.
+        std::vector<TypeEntry> _typeTable;
+
+        // compression method and compressed size of the payload to be read by the next call to _read(..), set by readPayloadAlignment() for files written with version 1.1.19 onwards.
+        CompressionMethod _payloadCompression = COMPRESSION_NONE;
+        uint64_t _compressedPayloadSize = 0;
+        std::vector<uint8_t> _compressionBuffer;
     };
 
 } // namespace vsg
@@ -12,14 +12,21 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/io/Compression.h>
 #include <vsg/io/Options.h>
 #include <vsg/io/Output.h>
 
 #include <fstream>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 namespace vsg
 {
 
+    // forward declare
+    class Group;
+
     /// vsg::Output subclass that implements writing objects as binary data to an output stream.
     /// Used by VSG ReaderWriter when writing objects to native .vsgb binary files.
     class VSG_DECLSPEC BinaryOutput : public vsg::Output
@@ -36,7 +43,10 @@ namespace vsg
         template<typename T>
         void _write(size_t num, const T* value)
         {
-            _output.write(reinterpret_cast<const char*>(value), num * sizeof(T));
+            if (_payloadPending)
+                _writePayload(reinterpret_cast<const uint8_t*>(value), num * sizeof(T));
+            else
+                _output.write(reinterpret_cast<const char*>(value), num * sizeof(T));
         }
 
         // write contiguous array of value(s)
@@ -62,8 +72,47 @@ namespace vsg
         /// write object
         void write(const vsg::Object* object) override;
 
+        /// alignment, in bytes from the start of the stream, of array payloads. Aligned payloads can be referenced directly when a file is memory mapped by BinaryInput.
+        size_t payloadAlignment = 16;
+
+        void writePayloadAlignment(size_t alignment) override;
+
+        /// compression method used for array payloads of compressionThreshold bytes or more, requires version 1.1.19 or later.
+        /// Payloads are only written compressed when the method is supported by this build and compression reduces their size.
+        CompressionMethod compression = COMPRESSION_NONE;
+        int compressionLevel = 0;
+        size_t compressionThreshold = 4096;
+
+        /// position of the start of the output stream within the file, used when computing payload alignment for chunks that are written to separate buffers before being copied into the file.
+        std::streamoff streamOffset = 0;
+
+        /// continue the object and type ID numbering of rhs so that objects already written by rhs are referenced by their IDs.
+        void continueFrom(const BinaryOutput& rhs);
+
+        /// write group with each of its children encoded as an independently decodable chunk so that BinaryInput can decode them in parallel, requires version 1.1.18 or later.
+        /// Objects referenced from more than one child are written once, ahead of the chunks, so sharing is preserved.
+        void writeChunks(const Group* group);
+
     protected:
+        /// write the type ID of className, from version 1.1.17 onwards class names are written once per file, the first time their type ID is used.
+        void _writeTypeID(const char* className);
+
+        /// write the payload header followed by the payload, compressing it when enabled, from version 1.1.19 onwards.
+        void _writePayload(const uint8_t* data, size_t size);
+
+        void _writePadding(size_t alignment);
+
         std::ostream& _output;
+
+        // type IDs are sequential with 0 reserved for nullptr, looked up by className() pointer with a fallback to the name as pointers may differ across shared libraries.
+        uint32_t _nextTypeID = 1;
+        std::unordered_map<const char*, uint32_t> _typeIDs;
+        std::map<std::string, uint32_t> _typeIDsByName;
+
+        // alignment of the payload whose header is written by the next call to _write(..)
+        bool _payloadPending = false;
+        size_t _pendingAlignment = 0;
+        std::vector<uint8_t> _compressionBuffer;
     };
 
 } // namespace vsg
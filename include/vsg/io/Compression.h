@@ -0,0 +1,48 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vsg
+{
+
+    /// compression method used for array payloads in .vsgb files.
+    enum CompressionMethod : uint8_t
+    {
+        COMPRESSION_NONE = 0,
+        COMPRESSION_LZ4 = 1,
+        COMPRESSION_ZSTD = 2
+    };
+
+    /// return true if the compression method is available in this build, LZ4 and zstd are optional dependencies controlled by VSG_SUPPORTS_LZ4 and VSG_SUPPORTS_zstd.
+    extern VSG_DECLSPEC bool compressionSupported(CompressionMethod method);
+
+    /// convert "none", "lz4" or "zstd" to the matching CompressionMethod, returning COMPRESSION_NONE if not recognized.
+    extern VSG_DECLSPEC CompressionMethod compressionMethod(const std::string& name);
+
+    /// return the maximum compressed size of srcSize bytes.
+    extern VSG_DECLSPEC size_t compressBound(CompressionMethod method, size_t srcSize);
+
+    /// compress srcSize bytes from src into dst, returning the compressed size or 0 on failure. level of 0 selects the method's default.
+    extern VSG_DECLSPEC size_t compress(CompressionMethod method, int level, const void* src, size_t srcSize, void* dst, size_t dstCapacity);
+
+    /// decompress srcSize bytes from src into dst, returning true if exactly dstSize bytes were decompressed.
+    extern VSG_DECLSPEC bool decompress(CompressionMethod method, const void* src, size_t srcSize, void* dst, size_t dstSize);
+
+} // namespace vsg
@@ -13,17 +13,24 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/app/CompileManager.h>
+#include <vsg/core/AllocatorArena.h>
 #include <vsg/core/Inherit.h>
 #include <vsg/core/observer_ptr.h>
+#include <vsg/io/AsyncFileReader.h>
 #include <vsg/io/FileSystem.h>
 #include <vsg/io/Options.h>
 #include <vsg/nodes/PagedLOD.h>
+#include <vsg/threading/Affinity.h>
 #include <vsg/threading/DeleteQueue.h>
+#include <vsg/vk/Device.h>
 #include <vsg/utils/Instrumentation.h>
 
 #include <condition_variable>
+#include <deque>
 #include <list>
+#include <map>
 #include <thread>
+#include <vector>
 
 namespace vsg
 {
@@ -68,7 +75,8 @@ namespace vsg
             List* list = nullptr;
         };
 
-        using Elements = std::vector<Element>;
+        // deque so that growing the container doesn't reallocate and copy the existing elements
+        using Elements = std::deque<Element>;
 
         Elements elements;
         List availableList;
@@ -89,7 +97,8 @@ namespace vsg
         void print(std::ostream& out);
     };
 
-    /// Thread safe queue for tracking PagedLOD that needs to be loaded, compiled or merged by the DatabasePager
+    /// Thread safe priority queue for tracking PagedLOD that needs to be loaded, compiled or merged by the DatabasePager
+    /// Requests are ordered by the PagedLOD::priority assigned during the RecordTraversal, with prioritize() called each frame to refresh the ordering and remove requests no longer required.
     class VSG_DECLSPEC DatabaseQueue : public Inherit<Object, DatabaseQueue>
     {
     public:
@@ -102,23 +111,127 @@ namespace vsg
 
         void add(ref_ptr<PagedLOD> plod);
 
+        /// add a compiled PagedLOD along with its CompileResult, the bytes of dynamic data in the CompileResult are recorded for use with take(..) budgets.
         void add(ref_ptr<PagedLOD> plod, const CompileResult& cr);
 
+        /// take the highest priority request, waiting until one is available or the associated ActivityStatus is no longer active.
         ref_ptr<PagedLOD> take_when_available();
 
         Nodes take_all(CompileResult& result);
 
+        /// take the highest priority requests, up to maxCount requests and maxBytes of dynamic data, merging their CompileResult into result.
+        /// A maxCount or maxBytes of 0 disables that limit, and at least one request is taken if any are available.
+        Nodes take(CompileResult& result, uint32_t maxCount, size_t maxBytes);
+
+        /// update the priorities of all queued requests, removing and returning the PagedLOD whose high res child has not been used since the previous frame.
+        Nodes prioritize(uint64_t frameCount);
+
+        size_t size() const;
+
     protected:
         virtual ~DatabaseQueue();
 
-        std::mutex _mutex;
+        struct Request
+        {
+            double priority = 0.0;
+            ref_ptr<PagedLOD> plod;
+            CompileResult compileResult;
+            size_t dynamicDataSize = 0;
+
+            bool operator<(const Request& rhs) const { return priority < rhs.priority; }
+        };
+
+        mutable std::mutex _mutex;
         std::condition_variable _cv;
-        Nodes _queue;
-        CompileResult _compileResult;
+        std::vector<Request> _queue; // heap ordered with highest priority first
         ref_ptr<ActivityStatus> _status;
     };
     VSG_type_name(vsg::DatabaseQueue);
 
+    /// Thread safe bounded queue of the subgraphs read by the DatabasePager's read or decode threads waiting to be compiled by its compile threads.
+    /// add() blocks while the queue is full so that the read threads don't run ahead of the compile threads, take_when_available() returns the highest priority entry.
+    class VSG_DECLSPEC DatabaseCompileQueue : public Inherit<Object, DatabaseCompileQueue>
+    {
+    public:
+        DatabaseCompileQueue(ref_ptr<ActivityStatus> status, uint32_t in_maxSize);
+
+        /// maximum number of read subgraphs held by the queue.
+        const uint32_t maxSize;
+
+        struct Entry
+        {
+            ref_ptr<PagedLOD> plod;
+            ref_ptr<Object> object;
+        };
+
+        /// add the object read for plod, waiting while the queue is full. Returns false without adding if the associated ActivityStatus is no longer active.
+        bool add(ref_ptr<PagedLOD> plod, ref_ptr<Object> object);
+
+        /// take the entry with the highest PagedLOD::priority, waiting until one is available or the associated ActivityStatus is no longer active.
+        Entry take_when_available();
+
+        size_t size() const;
+
+    protected:
+        virtual ~DatabaseCompileQueue();
+
+        mutable std::mutex _mutex;
+        std::condition_variable _notEmptyCV;
+        std::condition_variable _notFullCV;
+        std::list<Entry> _queue;
+        ref_ptr<ActivityStatus> _status;
+    };
+    VSG_type_name(vsg::DatabaseCompileQueue);
+
+    /// Bounded cache of the compiled subgraphs of expired PagedLOD, keyed by filename, so that revisiting an area reuses the subgraphs along with their
+    /// Buffers, Images and DescriptorSets rather than reading and compiling them again. The least recently expired subgraphs are evicted to stay within the limits.
+    /// Subgraphs are only valid for the Devices and Views they were compiled for, so clear() the cache when the CompileManager's contexts change.
+    class VSG_DECLSPEC RecycledSubgraphs : public Inherit<Object, RecycledSubgraphs>
+    {
+    public:
+        explicit RecycledSubgraphs(uint32_t in_maxNumSubgraphs = 256, uint64_t in_maxGPUMemory = 0);
+
+        /// maximum number of subgraphs held by the cache.
+        uint32_t maxNumSubgraphs = 256;
+
+        /// maximum bytes of GPU memory required by the subgraphs held by the cache, 0 for no limit.
+        uint64_t maxGPUMemory = 0;
+
+        using Subgraphs = std::list<ref_ptr<Object>>;
+
+        /// add the subgraph of an expired PagedLOD, returning the subgraphs evicted to stay within limits, these should be deleted via the DeleteQueue.
+        Subgraphs add(const Path& filename, ref_ptr<Node> subgraph, uint64_t gpuMemory);
+
+        /// take the subgraph added for filename, returning null if there isn't one.
+        ref_ptr<Node> take(const Path& filename);
+
+        /// remove all the subgraphs, returning them so they can be deleted via the DeleteQueue.
+        Subgraphs clear();
+
+        size_t size() const;
+        uint64_t gpuMemory() const;
+
+        /// total number of subgraphs reused and evicted.
+        std::atomic_uint64_t numRecycled{0};
+        std::atomic_uint64_t numEvicted{0};
+
+    protected:
+        struct Entry
+        {
+            Path filename;
+            ref_ptr<Node> subgraph;
+            uint64_t gpuMemory = 0;
+        };
+
+        using Entries = std::list<Entry>;
+
+        mutable std::mutex _mutex;
+        Entries _entries; // least recently added at front
+        std::map<Path, Entries::iterator> _lookup;
+        uint64_t _gpuMemory = 0;
+    };
+    VSG_type_name(vsg::RecycledSubgraphs);
+
     /// Multi-threaded database pager for reading, compiling loaded PagedLOD subgraphs and updating the scene graph
     /// with newly loaded subgraphs and pruning expired PagedLOD subgraphs
     class VSG_DECLSPEC DatabasePager : public Inherit<Object, DatabasePager>
@@ -135,16 +248,56 @@ namespace vsg
 
         virtual void updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResult& cr);
 
+        /// return true if loaded subgraphs are waiting to be merged by updateSceneGraph(..).
+        bool requiresUpdate() const;
+
         ref_ptr<CompileManager> compileManager;
 
         std::atomic_uint numActiveRequests{0};
         std::atomic_uint64_t frameCount;
 
+        /// total number of requests discarded because the PagedLOD was no longer visible by the time the request reached the front of the read queue.
+        std::atomic_uint64_t numExpiredRequests{0};
+
+        /// total number of requests discarded because the read or compile of the subgraph failed.
+        std::atomic_uint64_t numFailedRequests{0};
+
         ref_ptr<CulledPagedLODs> culledPagedLODs;
 
         /// for systems with smaller GPU memory limits you may need to reduce the targetMaxNumPagedLODWithHighResSubgraphs to keep memory usage within available limits.
         uint32_t targetMaxNumPagedLODWithHighResSubgraphs = 1500;
 
+        /// maximum number of loaded subgraphs merged into the scene graph each frame, 0 for no limit.
+        /// Subgraphs over budget stay on the merge queue, highest priority first, so that a batch of tiles completing together is spread over several frames.
+        uint32_t maxNumMergesPerFrame = 0;
+
+        /// maximum bytes of dynamic data, to be uploaded by the TransferTask, in the subgraphs merged each frame, 0 for no limit. At least one subgraph is merged each frame.
+        size_t maxMergeBytesPerFrame = 0;
+
+        /// maximum bytes of CPU memory held by the high res subgraphs of PagedLOD, 0 for no limit. Least recently visible inactive subgraphs are expired to stay within the budget.
+        uint64_t targetMaxHighResSubgraphsCPUMemory = 0;
+
+        /// maximum bytes of GPU memory required by the high res subgraphs of PagedLOD, 0 for no limit. Least recently visible inactive subgraphs are expired to stay within the budget.
+        uint64_t targetMaxHighResSubgraphsGPUMemory = 0;
+
+        /// when the device supports VK_EXT_memory_budget inactive high res subgraphs are also expired while the device's available memory is below minimumAvailableDeviceMemory, 0 disables the check.
+        VkDeviceSize minimumAvailableDeviceMemory = 0;
+
+        /// memory priority used for the device memory of paged subgraphs that don't have their own ResourceHints, the default of 0.25 is lower than the 0.5 used for the rest of the scene
+        /// so that when VK_EXT_memory_priority is enabled the driver demotes paged tiles to system memory before the main scene's resources.
+        float memoryPriority = 0.25f;
+
+        /// optional cache of the compiled subgraphs of expired PagedLOD, when assigned expired subgraphs are kept in the cache
+        /// and reused by later requests for the same file rather than being read and compiled again.
+        ref_ptr<RecycledSubgraphs> recycledSubgraphs;
+
+        /// device used to check the minimumAvailableDeviceMemory, assigned by Viewer::compile() if not already set.
+        ref_ptr<Device> device;
+
+        /// estimated bytes of CPU and GPU memory held by the currently merged high res subgraphs of PagedLOD.
+        std::atomic_uint64_t highResSubgraphsCPUMemory{0};
+        std::atomic_uint64_t highResSubgraphsGPUMemory{0};
+
         std::mutex pendingPagedLODMutex;
 
         ref_ptr<PagedLODContainer> pagedLODContainer;
@@ -155,17 +308,56 @@ namespace vsg
         /// assign Instrumentation to all CompileTraversal and their associated Context
         void assignInstrumentation(ref_ptr<Instrumentation> in_instrumentation);
 
-        /// read and delete threads created by start()
+        /// optional asynchronous file reader, when assigned prior to start() the files of requests are read by a single fetch thread via the asyncFileReader,
+        /// with the numReadThreads threads decoding the file contents via vsg::read(ptr, size, options) and compiling them, so fewer threads are needed to keep the storage busy.
+        /// Files that can't be loaded into memory by the asyncFileReader, or formats that can't be read from memory, fall back to vsg::read(filename, options).
+        ref_ptr<AsyncFileReader> asyncFileReader;
+
+        /// when non zero each subgraph is read into an AllocatorArena of its own with blocks of allocatorArenaBlockSize bytes, so that the nodes and data of the subgraph
+        /// are packed together and the arena's memory is freed in one operation once the subgraph has been expired and deleted, rather than returning each allocation to
+        /// the Allocator's MemoryBlocks. Objects created by the compile are allocated as normal. Objects the loaders cache beyond the lifetime of the subgraph, such as
+        /// those shared via Options::sharedObjects, keep their arena's memory allocated until they are deleted.
+        size_t allocatorArenaBlockSize = 0;
+
+        /// number of threads compiling the read subgraphs, assign prior to start(). When 0 the subgraphs are compiled by the read or decode thread that read them,
+        /// otherwise the read or decode threads pass them to the compile threads via a bounded queue, so slow reads don't hold up compiles and vice versa.
+        uint32_t numCompileThreads = 0;
+
+        /// maximum number of read subgraphs waiting to be compiled when numCompileThreads is non zero, the read or decode threads wait while the queue is full.
+        uint32_t maxCompileQueueSize = 8;
+
+        /// read, or fetch and decode, compile and delete threads created by start()
         std::list<std::thread> threads;
 
+        /// Affinity of the threads created by start(), when empty the threads are placed on the efficiency cores of hybrid CPUs, leaving the performance cores for the Viewer's record threads.
+        Affinity threadAffinity;
+
     protected:
         virtual ~DatabasePager();
 
         void requestDiscarded(PagedLOD* plod);
+        void requestExpired(PagedLOD* plod);
+        void requestFailed(PagedLOD* plod);
+
+        /// return true if the request is still required, marking it as being read, otherwise discard it.
+        bool _startReading(PagedLOD* plod);
+
+        /// return a new AllocatorArena for reading a subgraph if allocatorArenaBlockSize is non zero, otherwise null.
+        ref_ptr<AllocatorArena> _createAllocatorArena() const;
+
+        /// compile the subgraph read for a request and add it to the merge queue, discarding the request on failure.
+        void _compile(PagedLOD* plod, ref_ptr<Object> read_object);
+
+        /// pass the subgraph read for a request to the compile queue when there are compile threads, otherwise compile it on the calling thread.
+        void _compileOrQueue(PagedLOD* plod, ref_ptr<Object> read_object);
+
+        /// return true if a compiled subgraph for the request was found in recycledSubgraphs and has been added to the merge queue.
+        bool _recycle(PagedLOD* plod);
 
         ref_ptr<ActivityStatus> _status;
 
         ref_ptr<DatabaseQueue> _requestQueue;
+        ref_ptr<DatabaseCompileQueue> _compileQueue;
         ref_ptr<DatabaseQueue> _toMergeQueue;
         ref_ptr<DeleteQueue> _deleteQueue;
     };
@@ -0,0 +1,59 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Inherit.h>
+#include <vsg/io/Path.h>
+#include <vsg/ui/UIEvent.h>
+
+#include <map>
+#include <mutex>
+#include <set>
+
+namespace vsg
+{
+
+    /// DirectoryCache caches the contents of directories so that repeated file existence checks, such as vsg::findFile(..) searching the Options::paths, don't need to query the file system.
+    /// Directory listings are read on first use and re-read once they are older than expiryTime, call flush() after files have been added or removed to pick up the changes immediately.
+    /// Assign to Options::directoryCache to enable its use by vsg::findFile(filename, options).
+    class VSG_DECLSPEC DirectoryCache : public Inherit<Object, DirectoryCache>
+    {
+    public:
+        DirectoryCache();
+
+        /// number of seconds a directory listing is used before it's re-read, a negative value disables expiry.
+        double expiryTime = -1.0;
+
+        /// return true if path exists, checking the cached listing of the directory containing it.
+        bool fileExists(const Path& path);
+
+        /// discard all the cached listings.
+        void flush();
+
+        /// discard the cached listing of directory.
+        void flush(const Path& directory);
+
+    protected:
+        struct Listing
+        {
+            time_point timeRead;
+            std::set<Path::string_type> entries;
+        };
+
+        std::mutex _mutex;
+        std::map<Path, Listing> _listings;
+    };
+    VSG_type_name(vsg::DirectoryCache);
+
+} // namespace vsg
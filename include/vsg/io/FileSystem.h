@@ -57,6 +57,13 @@ namespace vsg
     /// make a directory, return true if path already exists or full path has been created successfully, return false on failure.
     extern VSG_DECLSPEC bool makeDirectory(const Path& path);
 
+    /// rename a file, replacing the destination file if it already exists, return true on success.
+    /// On the same file system the replacement is atomic so can be used to safely publish files that other processes may be reading concurrently.
+    extern VSG_DECLSPEC bool renameFile(const Path& src, const Path& dst);
+
+    /// remove a file, return true on success.
+    extern VSG_DECLSPEC bool removeFile(const Path& path);
+
     /// get the contents of a directory, return {} if directory name is not a directory
     extern VSG_DECLSPEC Paths getDirectoryContents(const Path& directoryName);
 
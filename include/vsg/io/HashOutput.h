@@ -0,0 +1,65 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/hash.h>
+#include <vsg/io/Output.h>
+
+namespace vsg
+{
+
+    /// vsg::Output subclass that accumulates a hash of the values written rather than writing them to a stream.
+    /// Used by Object::hash() to compute a hash of an object's contents from its write(Output&) implementation.
+    class VSG_DECLSPEC HashOutput : public vsg::Output
+    {
+    public:
+        explicit HashOutput(uint64_t in_seed = 0);
+
+        /// hash of all the values written so far.
+        uint64_t value = 0;
+
+        /// property names aren't included in the hash
+        void writePropertyName(const char*) override {}
+
+        /// write end of line is a non op for hashing
+        void writeEndOfLine() override {}
+
+        template<typename T>
+        void _hash(size_t num, const T* value_ptr)
+        {
+            value = hash_bytes(value_ptr, num * sizeof(T), value);
+        }
+
+        // hash contiguous array of value(s)
+        void write(size_t num, const int8_t* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const uint8_t* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const int16_t* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const uint16_t* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const int32_t* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const uint32_t* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const int64_t* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const uint64_t* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const float* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const double* value_ptr) override { _hash(num, value_ptr); }
+        void write(size_t num, const long double* value_ptr) override;
+        void write(size_t num, const std::string* value_ptr) override;
+        void write(size_t num, const std::wstring* value_ptr) override;
+        void write(size_t num, const Path* value_ptr) override;
+
+        /// combine the object's Object::hash() into the hash value.
+        void write(const vsg::Object* object) override;
+    };
+    VSG_type_name(vsg::HashOutput);
+
+} // namespace vsg
@@ -70,6 +70,27 @@ namespace vsg
         // read object
         virtual ref_ptr<Object> read() = 0;
 
+        /// skip any padding written in front of an array payload by Output::writePayloadAlignment(..)
+        virtual void readPayloadAlignment() {}
+
+        /// return a Data object referencing the next size bytes of the input directly, skipping over them, or null if the payload should be read via read(num, value).
+        virtual ref_ptr<Data> mapPayload(size_t /*size*/, size_t /*alignment*/) { return {}; }
+
+        /// prepare for reading the payload of num values of type T, returning a Data object that references the payload directly if supported, otherwise null.
+        template<typename T>
+        ref_ptr<Data> readPayload(size_t num)
+        {
+            if constexpr (is_raw_serializable<T>())
+            {
+                readPayloadAlignment();
+                return mapPayload(num * sizeof(T), alignof(T));
+            }
+            else
+            {
+                return {};
+            }
+        }
+
         // map char to int8_t
         void read(size_t num, char* value) { read(num, reinterpret_cast<int8_t*>(value)); }
         void read(size_t num, bool* value) { read(num, reinterpret_cast<int8_t*>(value)); }
@@ -253,8 +274,14 @@ namespace vsg
         virtual bool version_less(uint32_t major, uint32_t minor, uint32_t patch, uint32_t soversion = 0) const;
         virtual bool version_greater_equal(uint32_t major, uint32_t minor, uint32_t patch, uint32_t soversion = 0) const;
 
+        /// return a copy of options, created on first use, that is shared by all the objects read that hold their own non const Options, such as PagedLOD.
+        /// Sharing the copy avoids an Options instance per object when reading files with large numbers of PagedLOD. Returns null if options is null.
+        ref_ptr<Options> sharedCopyOfOptions();
+
     protected:
         virtual ~Input();
+
+        ref_ptr<Options> _sharedCopyOfOptions;
     };
 
     template<>
@@ -28,7 +28,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vsg/io/mem_stream.h>
 #include <vsg/io/stream.h>
 
+#include <charconv>
+#include <cstdlib>
 #include <list>
+#include <type_traits>
 
 namespace vsg
 {
@@ -62,6 +65,11 @@ namespace vsg
             virtual void read_number(JSONParser& parser, const std::string_view& name, std::istream& input);
             virtual void read_bool(JSONParser& parser, const std::string_view& name, bool value);
             virtual void read_null(JSONParser& parser, const std::string_view& name);
+
+            // numbers passed as a view of the number's characters in the JSONParser::buffer, avoiding the overhead of std::istream parsing.
+            // Use JSONParser::parse_number(..) to convert. The default implementations call the std::istream versions above.
+            virtual void read_number(JSONParser& parser, const std::string_view& value);
+            virtual void read_number(JSONParser& parser, const std::string_view& name, const std::string_view& value);
         };
 
         bool read_uri(std::string& value, ref_ptr<Object>& object);
@@ -70,6 +78,29 @@ namespace vsg
         void read_object(Schema& schema);
         void read_array(Schema& schema);
 
+        /// convert the characters of a JSON number to value using std::from_chars, return false if the characters couldn't be converted.
+        template<typename T>
+        static bool parse_number(const std::string_view& str, T& value)
+        {
+            const char* first = str.data();
+            const char* last = first + str.size();
+            if constexpr (std::is_floating_point_v<T>)
+            {
+#if defined(__cpp_lib_to_chars)
+                return std::from_chars(first, last, value).ec == std::errc();
+#else
+                std::string terminated(str);
+                char* end = nullptr;
+                value = static_cast<T>(std::strtod(terminated.c_str(), &end));
+                return end != terminated.c_str();
+#endif
+            }
+            else
+            {
+                return std::from_chars(first, last, value).ec == std::errc();
+            }
+        }
+
         std::pair<std::size_t, std::size_t> lineAndColumnAtPosition(std::size_t position) const;
         std::string_view lineEnclosingPosition(std::size_t position) const;
 
@@ -117,6 +148,9 @@ namespace vsg
         void read_number(JSONParser& parser, const std::string_view& name, std::istream& input) override;
         void read_bool(JSONParser& parser, const std::string_view& name, bool value) override;
         void read_null(JSONParser& parser, const std::string_view& name) override;
+
+        void read_number(JSONParser& parser, const std::string_view& value) override;
+        void read_number(JSONParser& parser, const std::string_view& name, const std::string_view& value) override;
     };
     VSG_type_name(vsg::JSONtoMetaDataSchema);
 
@@ -143,6 +177,71 @@ namespace vsg
             input >> value;
             values.push_back(value);
         }
+
+        void read_number(vsg::JSONParser& parser, const std::string_view& str) override
+        {
+            T value;
+            if (JSONParser::parse_number(str, value))
+                values.push_back(value);
+            else
+                parser.warning("ValuesSchema unable to parse number ", str);
+        }
+    };
+
+    /// Template class for reading a JSON array of numbers directly into a vsg Array,
+    /// numbers are assigned to the components of consecutive elements so ArraySchema<vec3Array> maps [x0, y0, z0, x1, y1, z1...] to a vec3Array.
+    template<class A>
+    struct ArraySchema : public Inherit<JSONParser::Schema, ArraySchema<A>>
+    {
+        using value_type = typename A::value_type;
+
+        template<typename V, typename = void>
+        struct Component
+        {
+            using type = V;
+            static constexpr std::size_t count = 1;
+        };
+
+        template<typename V>
+        struct Component<V, std::void_t<typename V::value_type>>
+        {
+            using type = typename V::value_type;
+            static constexpr std::size_t count = sizeof(V) / sizeof(typename V::value_type);
+        };
+
+        using component_type = typename Component<value_type>::type;
+        static constexpr std::size_t numComponents = Component<value_type>::count;
+
+        std::vector<component_type> components;
+
+        void read_number(vsg::JSONParser& parser, std::istream& input) override
+        {
+            component_type value;
+            if (input >> value)
+                components.push_back(value);
+            else
+                parser.warning("ArraySchema unable to parse number");
+        }
+
+        void read_number(vsg::JSONParser& parser, const std::string_view& str) override
+        {
+            component_type value;
+            if (JSONParser::parse_number(str, value))
+                components.push_back(value);
+            else
+                parser.warning("ArraySchema unable to parse number ", str);
+        }
+
+        /// create an Array from the numbers read, trailing numbers that don't complete an element are ignored.
+        ref_ptr<A> array() const
+        {
+            auto numElements = components.size() / numComponents;
+            if (numElements == 0) return {};
+
+            auto new_array = A::create(static_cast<uint32_t>(numElements));
+            std::memcpy(new_array->dataPointer(), components.data(), numElements * sizeof(value_type));
+            return new_array;
+        }
     };
 
     /// Template class for reading an array of objects
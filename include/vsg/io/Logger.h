@@ -15,9 +15,14 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Inherit.h>
 #include <vsg/io/stream.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <string_view>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace vsg
 {
@@ -402,6 +407,71 @@ namespace vsg
     };
     VSG_type_name(vsg::NullLogger);
 
+    /// Logger that queues messages and passes them to a destination Logger from a background thread, so that callers never wait on console or file output.
+    /// Messages are copied into a fixed size ring buffer of reusable strings, when the ring buffer is full messages are dropped rather than blocking the caller.
+    /// Identical messages repeated more than maxRepeatsPerPeriod times within rateLimitPeriod are suppressed.
+    /// Fatal messages are passed to the destination Logger on the calling thread once the queued messages have been written.
+    /// To use the AsyncLogger use:
+    ///     vsg::Logger::instance() = AsyncLogger::create(vsg::Logger::instance());
+    class VSG_DECLSPEC AsyncLogger : public Inherit<Logger, AsyncLogger>
+    {
+    public:
+        explicit AsyncLogger(ref_ptr<Logger> in_logger = {}, size_t queueSize = 1024);
+
+        AsyncLogger(const AsyncLogger&) = delete;
+        AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+        /// Logger that the background thread writes messages to, defaults to StdLogger.
+        const ref_ptr<Logger> logger;
+
+        /// period in seconds over which repeated messages are counted, 0.0 disables rate limiting.
+        double rateLimitPeriod = 1.0;
+
+        /// maximum number of times an identical message is logged within each rateLimitPeriod.
+        uint32_t maxRepeatsPerPeriod = 10;
+
+        /// number of messages dropped because the queue was full.
+        std::atomic_uint64_t droppedMessages = 0;
+
+        /// wait for the messages queued so far to be written, then flush the destination Logger.
+        void flush() override;
+
+    protected:
+        virtual ~AsyncLogger();
+
+        bool enqueue(Level msg_level, const std::string_view& message);
+        bool push(Level msg_level, const std::string_view& message);
+        void run();
+
+        void debug_implementation(const std::string_view& message) override;
+        void info_implementation(const std::string_view& message) override;
+        void warn_implementation(const std::string_view& message) override;
+        void error_implementation(const std::string_view& message) override;
+        void fatal_implementation(const std::string_view& message) override;
+
+        struct Entry
+        {
+            Level level = LOGGER_INFO;
+            std::string message;
+        };
+
+        // single producer, single consumer ring buffer, the producer side is serialized by Logger::_mutex
+        std::vector<Entry> _entries;
+        std::atomic_uint64_t _writeIndex = 0;
+        std::atomic_uint64_t _readIndex = 0;
+
+        std::atomic_bool _active = true;
+        std::mutex _wakeMutex;
+        std::condition_variable _wakeCondition;
+        std::thread _thread;
+
+        // rate limiting state, accessed under Logger::_mutex
+        std::unordered_map<size_t, uint32_t> _repeatCounts;
+        std::chrono::steady_clock::time_point _periodStart;
+        uint64_t _suppressedMessages = 0;
+    };
+    VSG_type_name(vsg::AsyncLogger);
+
     /// Helper class for recording a set of indented log output
     struct LogOutput
     {
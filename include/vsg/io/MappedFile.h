@@ -0,0 +1,68 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/io/Path.h>
+
+namespace vsg
+{
+
+    /// MappedFile maps the contents of a file into memory, pages are loaded on demand by the OS rather than read up front.
+    /// The mapping is private/copy-on-write, so data referencing the mapping can be modified without affecting the file.
+    class VSG_DECLSPEC MappedFile : public Inherit<Object, MappedFile>
+    {
+    public:
+        explicit MappedFile(const Path& in_filename);
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const Path filename;
+
+        bool valid() const { return _data != nullptr; }
+
+        uint8_t* data() { return _data; }
+        const uint8_t* data() const { return _data; }
+
+        size_t size() const { return _size; }
+
+    protected:
+        virtual ~MappedFile();
+
+        uint8_t* _data = nullptr;
+        size_t _size = 0;
+
+#if defined(_WIN32)
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#endif
+    };
+    VSG_type_name(vsg::MappedFile);
+
+    /// MappedFileData is a ubyteArray that references a range of a MappedFile, keeping the MappedFile open for the lifetime of the MappedFileData.
+    /// Used as the storage for arrays loaded by BinaryInput when memory mapping is enabled, it is not subclassed via Inherit so it is written out as a regular ubyteArray.
+    class VSG_DECLSPEC MappedFileData : public ubyteArray
+    {
+    public:
+        MappedFileData(ref_ptr<MappedFile> in_mappedFile, size_t offset, size_t size, Properties in_properties = {});
+
+        ref_ptr<MappedFile> mappedFile;
+
+    protected:
+        virtual ~MappedFileData();
+    };
+
+} // namespace vsg
@@ -33,6 +33,10 @@ namespace vsg
         using CreateFunction = std::function<vsg::ref_ptr<vsg::Object>()>;
         using CreateMap = std::map<std::string, CreateFunction>;
 
+        /// return the function used to create instances of className, enabling readers to resolve class names once and then create objects without further lookups.
+        /// if className isn't registered the returned function falls back to calling create(className).
+        virtual CreateFunction getCreateFunction(const std::string& className);
+
         CreateMap& getCreateMap() { return _createMap; }
         const CreateMap& getCreateMap() const { return _createMap; }
 
@@ -28,7 +28,12 @@ namespace vsg
     class CommandLine;
     class ShaderSet;
     class FindDynamicObjects;
+    class DirectoryCache;
     class PropagateDynamicObjects;
+    class GenerateLODs;
+    class CompressTextures;
+    class OptimizeMeshes;
+    class ProcessImages;
 
     using ReaderWriters = std::vector<ref_ptr<ReaderWriter>>;
 
@@ -71,6 +76,9 @@ namespace vsg
         using FindFileCallback = std::function<Path(const Path& filename, const Options* options)>;
         FindFileCallback findFileCallback;
 
+        /// optional cache of directory contents used by vsg::findFile(filename, options) to check whether files exist without querying the file system for each of the paths.
+        ref_ptr<DirectoryCache> directoryCache;
+
         Path fileCache;
 
         Path extensionHint;
@@ -88,6 +96,7 @@ namespace vsg
         ///     "phong" will substitute for vsg::createPhongShaderSet()
         ///     "flat" will substitute for vsg::createFlatShadedShaderSet()
         ///     "text" will substitute for vsg::createTextShaderSet()
+        ///     "text_label" will substitute for vsg::createTextLabelShaderSet()
         std::map<std::string, ref_ptr<ShaderSet>> shaderSets;
 
         /// specification of any StateCommands that will be provided the parents of any newly created subgraphs
@@ -103,6 +112,18 @@ namespace vsg
         /// mechanism for propagating dynamic objects classification up parental chain so that cloning is done on all dynamic objects to avoid sharing of dynamic parts.
         ref_ptr<PropagateDynamicObjects> propagateDynamicObjects;
 
+        /// when assigned, vsg::read(..) uses it to replace loaded nodes with LODs of progressively simplified versions of them.
+        ref_ptr<GenerateLODs> generateLODs;
+
+        /// when assigned, vsg::read(..) uses it to block compress the uncompressed textures of loaded scene graphs.
+        ref_ptr<CompressTextures> compressTextures;
+
+        /// when assigned, vsg::read(..) uses it to optimize the index and vertex arrays of loaded scene graphs for vertex cache reuse and vertex fetch locality.
+        ref_ptr<OptimizeMeshes> optimizeMeshes;
+
+        /// when assigned, vsg::read(..) uses it to expand RGB textures to RGBA, premultiply alpha and generate mipmaps on the reading thread rather than during transfer.
+        ref_ptr<ProcessImages> processImages;
+
         enum InstanceNodeHint
         {
             INSTANCE_NONE = 0,
@@ -114,6 +135,9 @@ namespace vsg
 
         int instanceNodeHint = INSTANCE_NONE;
 
+        /// when true vsg::External defer reading their entries until they are accessed with External::getObject(..), prefetched, or reached by a Visitor traversal.
+        bool lazyExternalHint = false;
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return Options::create(*this, copyop); }
         int compare(const Object& rhs) const override;
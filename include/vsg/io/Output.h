@@ -71,6 +71,16 @@ namespace vsg
         /// write object
         virtual void write(const Object* object) = 0;
 
+        /// write any padding required so that the following array payload is aligned in the output, enabling it to be referenced directly from memory mapped files.
+        virtual void writePayloadAlignment(size_t /*alignment*/) {}
+
+        /// write padding in front of the payload of an array of type T, if its values are written as raw bytes.
+        template<typename T>
+        void alignPayload()
+        {
+            if constexpr (is_raw_serializable<T>()) writePayloadAlignment(alignof(T));
+        }
+
         /// map char to int8_t
         void write(size_t num, const char* value) { write(num, reinterpret_cast<const int8_t*>(value)); }
         void write(size_t num, const bool* value) { write(num, reinterpret_cast<const int8_t*>(value)); }
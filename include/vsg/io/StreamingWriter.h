@@ -0,0 +1,84 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Objects.h>
+#include <vsg/io/BinaryOutput.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/threading/OperationThreads.h>
+
+#include <fstream>
+#include <memory>
+
+namespace vsg
+{
+
+    // forward declare
+    class PagedLOD;
+
+    /// StreamingWriter writes a .vsgb file incrementally, with the children of the root Group written one at a time as they are produced,
+    /// so that each child's subgraph can be released once written rather than the whole scene graph having to be resident before it can be written.
+    /// Children are written as the independently decodable chunks used by BinaryOutput::writeChunks(..), so the file is read back with vsg::read(..) as normal.
+    /// Usage:
+    ///     auto writer = vsg::StreamingWriter::create(options);
+    ///     writer->open("model.vsgb", root, sharedObjects);
+    ///     while (auto tile = convertNextTile()) writer->write(tile);
+    ///     writer->close();
+    class VSG_DECLSPEC StreamingWriter : public Inherit<Object, StreamingWriter>
+    {
+    public:
+        explicit StreamingWriter(ref_ptr<const Options> in_options = {});
+
+        ref_ptr<const Options> options;
+
+        /// when true the resident high resolution children of PagedLOD are written to the PagedLOD::filename, relative to the directory of the file they are referenced from,
+        /// and then removed from the PagedLOD so they can be released. PagedLOD::write(..) never writes the high resolution child so it would otherwise be lost.
+        bool writePagedLODChildren = true;
+
+        /// OperationThreads used to write the PagedLOD children of each subgraph in parallel, defaults to Options::operationThreads.
+        ref_ptr<OperationThreads> operationThreads;
+
+        /// create the file and write the header, root's properties without its children, and the objects that are shared between the children that will be written.
+        /// Objects referenced by more than one child that aren't in sharedObjects are written once per child.
+        bool open(const Path& filename, ref_ptr<const Group> root = {}, const Objects::Children& sharedObjects = {});
+
+        /// write a child of the root Group, the child's subgraph is not referenced by the StreamingWriter once the call returns.
+        bool write(ref_ptr<Node> child);
+
+        /// write the PagedLOD high resolution children found in node's subgraph to their files relative to directory, clearing them from their PagedLOD.
+        bool writePagedLODs(ref_ptr<Node> node, const Path& directory);
+
+        /// complete the file by writing the number of children written, and close it.
+        bool close();
+
+        bool isOpen() const { return _output != nullptr; }
+        uint32_t numChildrenWritten() const { return _numChildren; }
+
+    protected:
+        virtual ~StreamingWriter();
+
+        bool _writePagedLOD(PagedLOD& plod, const Path& directory);
+
+        Path _filename;
+        std::ofstream _fout;
+        std::unique_ptr<BinaryOutput> _output;
+        std::streampos _numChildrenPosition = -1;
+        uint32_t _numChildren = 0;
+
+        // keep the shared objects alive while the BinaryOutput's objectIDMap references them
+        Objects::Children _sharedObjects;
+    };
+    VSG_type_name(vsg::StreamingWriter);
+
+} // namespace vsg
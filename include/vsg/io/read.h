@@ -29,7 +29,7 @@ namespace vsg
     /** convenience method for reading objects from stream.*/
     extern VSG_DECLSPEC ref_ptr<Object> read(std::istream& fin, ref_ptr<const Options> options = {});
 
-    /** convenience method for reading objects from memory.*/
+    /** convenience method for reading objects from memory, if no ReaderWriters are assigned to the options the built in formats are selected via options->extensionHint.*/
     extern VSG_DECLSPEC ref_ptr<Object> read(const uint8_t* ptr, size_t size, ref_ptr<const Options> options = {});
 
     /** convenience method for reading file with cast to specified type.*/
@@ -19,6 +19,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/utils/GraphicsPipelineConfigurator.h>
 #include <vsg/utils/ShaderSet.h>
 
+#include <list>
+
 namespace vsg
 {
 
@@ -72,8 +74,48 @@ namespace vsg
         ref_ptr<DescriptorImage> _detailFallback;
         ref_ptr<DescriptorImage> _elevationFallback;
 
+        /// geometry is shared between tiles of the same latitude band and dimensions, with the elevation applied in the vertex shader by displacement mapping
+        struct GeometryKey
+        {
+            dvec4 extents; // latitude origin, latitude range, num rows, num columns
+            float displacementScale = 0.0f;
+            bool displaced = false;
+
+            bool operator<(const GeometryKey& rhs) const
+            {
+                if (extents < rhs.extents) return true;
+                if (rhs.extents < extents) return false;
+                if (displaced != rhs.displaced) return displaced < rhs.displaced;
+                return displacementScale < rhs.displacementScale;
+            }
+        };
+
         mutable std::mutex _geometryMapMutex;
-        mutable std::map<dvec4, ref_ptr<VertexIndexDraw>> _geometryMap;
+        mutable std::map<GeometryKey, ref_ptr<VertexIndexDraw>> _geometryMap;
+
+        /// least recently used cache of the Data read for tile paths.
+        struct TileCache
+        {
+            using Entries = std::list<std::pair<Path, ref_ptr<Data>>>;
+            Entries entries;
+            std::map<Path, Entries::iterator> lookup;
+
+            /// return true and assign data if path is in the cache, making it the most recently used entry.
+            bool get(const Path& path, ref_ptr<Data>& data);
+
+            /// add path to the cache, removing the least recently used entries to keep the cache within maxSize.
+            void insert(const Path& path, ref_ptr<Data> data, size_t maxSize);
+        };
+
+        mutable std::mutex _tileCacheMutex;
+        mutable TileCache _dataCache;
+        mutable TileCache _missingCache;
+
+        /// read the tile layer files, reusing cached Data and skipping paths known to be missing.
+        PathObjects readTiles(const Paths& tiles, ref_ptr<const Options> options) const;
+
+        /// grid indices only depend on the dimensions of the tile so are shared between all geometries with the same number of rows and columns
+        mutable std::map<uivec2, ref_ptr<Data>> _indicesMap;
     };
     VSG_type_name(vsg::tile);
 
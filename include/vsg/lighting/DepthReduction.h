@@ -0,0 +1,94 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/Window.h>
+#include <vsg/commands/Command.h>
+#include <vsg/commands/Event.h>
+#include <vsg/state/Buffer.h>
+#include <vsg/state/ComputePipeline.h>
+#include <vsg/state/Sampler.h>
+#include <vsg/vk/DescriptorPool.h>
+
+namespace vsg
+{
+
+    /** DepthReduction is a compute stage used by ViewDependentState to fit the directional light shadow map cascades to the range of depths actually rendered,
+      * rather than the whole view frustum, in the manner of sample distribution shadow maps.
+      * Each frame the depth buffer of the Window, as rendered by the previous frame, is reduced to its minimum and maximum depth ignoring cleared background texels,
+      * and copied to a ring of host visible buffers whose completion is polled via vsg::Event without blocking, so the reduced range lags the rendered frames by the frames in flight.
+      * The Window's depth image must be single sampled and created with VK_IMAGE_USAGE_SAMPLED_BIT, which prepare(WindowTraits&) assigns.
+      * Usage:
+      *     DepthReduction::prepare(*windowTraits);
+      *     view->viewDependentState->depthReduction = vsg::DepthReduction::create(window); // before the viewer is compiled */
+    class VSG_DECLSPEC DepthReduction : public Inherit<Command, DepthReduction>
+    {
+    public:
+        explicit DepthReduction(ref_ptr<Window> in_window, uint32_t in_numBuffers = 3);
+
+        ref_ptr<Window> window;
+        const uint32_t numBuffers;
+
+        /// region of the depth buffer reduced, the viewport of the View, assigned by ViewDependentState each frame.
+        VkRect2D region = {{0, 0}, {0, 0}};
+
+        /// projection matrix of the current frame, assigned by ViewDependentState each frame and used to convert the reduced depths of the next frame's reduction to eye space distances.
+        dmat4 projectionMatrix;
+
+        /// assign the depth image usage required to reduce the Window's depth buffer.
+        static void prepare(WindowTraits& traits);
+
+        /// check, without blocking, for completed reductions and get the eye space near and far distances of the most recent one.
+        /// Returns false if no reduction has completed or the most recent found no rendered depths.
+        bool getDepthRange(double& nearDistance, double& farDistance) const;
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~DepthReduction();
+
+        struct Slot
+        {
+            ref_ptr<Buffer> buffer;
+            const uint32_t* mappedData = nullptr;
+            ref_ptr<Event> event;
+            ref_ptr<DescriptorSet::Implementation> descriptorSet;
+            ref_ptr<ImageView> imageView; // depth image view written to the descriptorSet
+            dmat4 projectionMatrix;       // projection matrix the reduced depths were rendered with
+            bool inFlight = false;
+        };
+
+        void poll() const;
+
+        mutable std::vector<Slot> _slots;
+        mutable uint32_t _nextSlot = 0;
+
+        // depth only ImageView of the Window's depth image, and the previous frame's image and projection matrix
+        mutable ref_ptr<ImageView> _imageView;
+        mutable Image* _previousImage = nullptr;
+        mutable dmat4 _previousProjectionMatrix;
+
+        mutable bool _rangeValid = false;
+        mutable double _nearDistance = 0.0;
+        mutable double _farDistance = 0.0;
+
+        uint32_t _deviceID = 0;
+        ref_ptr<ComputePipeline> _pipeline;
+        ref_ptr<DescriptorSetLayout> _descriptorSetLayout;
+        ref_ptr<DescriptorPool> _descriptorPool;
+        ref_ptr<Sampler> _sampler;
+    };
+    VSG_type_name(vsg::DepthReduction);
+
+} // namespace vsg
@@ -0,0 +1,66 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Command.h>
+#include <vsg/core/Array.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/ComputePipeline.h>
+
+namespace vsg
+{
+
+    /** LightClustering is a compute stage used by ViewDependentState to implement clustered forward lighting.
+      * The view frustum is divided into dimensions.x * dimensions.y screen space tiles by dimensions.z exponentially spaced depth slices, and for each cluster
+      * the compute shader writes the indices of the lights whose range overlaps the cluster to lightIndices, and their number to lightCounts.
+      * The fragment shaders of the clustered lighting ShaderSets then only iterate over the lights of the cluster that the fragment falls within.
+      * As compute dispatches can't be recorded within a render pass, ViewDependentState records LightClustering via its own CommandGraph that is submitted ahead of the View's RenderGraph.*/
+    class VSG_DECLSPEC LightClustering : public Inherit<Command, LightClustering>
+    {
+    public:
+        LightClustering(const uivec3& in_dimensions, uint32_t in_maxLights, uint32_t in_maxLightsPerCluster);
+
+        const uivec3 dimensions;
+        const uint32_t maxLights;
+        const uint32_t maxLightsPerCluster;
+
+        /// settings shared by the compute and fragment shaders, {near, far, log(far/near), numLights}, {dimensions, maxLightsPerCluster}, {viewport} and the inverse projection matrix.
+        ref_ptr<vec4Array> settings;
+        ref_ptr<BufferInfo> settingsBufferInfo;
+
+        /// 3 vec4s per light matching the spot light layout of ViewDependentState::lightData, {color, intensity}, {eye position, cos inner angle} and {eye direction, cos outer angle}.
+        /// Point lights are assigned cos inner and outer angles of -1.0 and -2.0 so that the spot light attenuation has no effect.
+        ref_ptr<vec4Array> lights;
+        ref_ptr<BufferInfo> lightsBufferInfo;
+
+        /// per cluster light counts and lists of light indices, written by the compute shader.
+        ref_ptr<BufferInfo> lightCounts;
+        ref_ptr<BufferInfo> lightIndices;
+
+        /// assign the settings for the next dispatch, dirtying settings when they have changed.
+        void assignSettings(uint32_t numLights, double nearDistance, double farDistance, const vec4& viewport, const dmat4& projectionMatrix);
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~LightClustering();
+
+        ref_ptr<PipelineLayout> _pipelineLayout;
+        ref_ptr<BindComputePipeline> _bindComputePipeline;
+        ref_ptr<BindDescriptorSet> _bindDescriptorSet;
+    };
+    VSG_type_name(vsg::LightClustering);
+
+} // namespace vsg
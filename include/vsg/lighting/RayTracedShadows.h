@@ -0,0 +1,44 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/lighting/ShadowSettings.h>
+
+namespace vsg
+{
+
+    /// RayTracedShadows evaluates the light's shadows with ray queries against the ViewDependentState::shadowAccelerationStructure in the fragment shader,
+    /// rather than rendering shadow maps. Requires the View's ViewDependentState::shaderSet and the scene graph's pipelines to use a ShaderSet created
+    /// with vsg::createRayTracedShadowsShaderSet(), and the rayQuery device feature.
+    class VSG_DECLSPEC RayTracedShadows : public Inherit<ShadowSettings, RayTracedShadows>
+    {
+    public:
+        explicit RayTracedShadows(float in_rayOffset = 0.01f, float in_maxDistance = 1e6f);
+        RayTracedShadows(const RayTracedShadows& rhs, const CopyOp& copyop = {});
+
+        /// distance along the shadow ray from the surface that intersections are accepted from, avoids surfaces shadowing themselves.
+        float rayOffset = 0.01f;
+
+        /// maximum distance along the shadow ray of a directional light that casters are tested to, spot light rays end at the light.
+        float maxDistance = 1e6f;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return RayTracedShadows::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+    };
+    VSG_type_name(vsg::RayTracedShadows);
+
+} // namespace vsg
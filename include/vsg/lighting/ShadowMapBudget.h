@@ -0,0 +1,78 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Inherit.h>
+#include <vsg/maths/mat4.h>
+
+#include <vector>
+
+namespace vsg
+{
+
+    /** ShadowMapBudget allocates the spot light shadow maps of ViewDependentState from a fixed budget, so that enabling shadows on many lights doesn't
+      * multiply the shadow map render passes. Each frame the shadow casting spot lights are ranked by their screen contribution, the projected radius in pixels
+      * of the sphere they illuminate, and the most important are assigned shadow maps with a resolution matched to that radius, the lower resolutions rendered
+      * to a corner region of the shadow map layer. The shadow maps of the less important lights are re-rendered at a reduced frequency, reusing the previous
+      * contents in between, and lights outside the budget are rendered unshadowed.
+      * Usage:
+      *     view->viewDependentState->shadowMapBudget = vsg::ShadowMapBudget::create(); // before the viewer is compiled */
+    class VSG_DECLSPEC ShadowMapBudget : public Inherit<Object, ShadowMapBudget>
+    {
+    public:
+        ShadowMapBudget();
+
+        /// maximum number of shadow map layers assigned to spot lights, also limits the shadow map layers that ViewDependentState allocates for them.
+        uint32_t maxShadowMaps = 8;
+
+        /// maximum total area, in full shadow map layers, of the shadow map regions assigned each frame.
+        double maxLayerArea = 4.0;
+
+        /// number of shadow map texels per screen pixel across the projected diameter of the light.
+        double resolutionScale = 1.0;
+
+        /// smallest fraction of the shadow map layer's width and height assigned to a shadow map, regions are power of two fractions of the layer.
+        double minRegionScale = 0.125;
+
+        /// lights whose projected radius is less than minScreenRadius pixels aren't assigned shadow maps.
+        double minScreenRadius = 4.0;
+
+        /// the shadow maps of the numFullRateLights most important lights are rendered every frame, the rest every reducedUpdateInterval frames.
+        uint32_t numFullRateLights = 4;
+        uint32_t reducedUpdateInterval = 4;
+
+        struct Candidate
+        {
+            double screenRadius = 0.0;   // projected radius in pixels of the sphere illuminated by the light
+            uint32_t shadowMapCount = 0; // shadow maps requested by the light's ShadowSettings
+        };
+
+        struct Allocation
+        {
+            uint32_t shadowMapCount = 0;
+            double regionScale = 1.0; // fraction of the shadow map layer's width and height
+            uint32_t updateInterval = 1;
+        };
+
+        /// allocate shadow maps from at most availableShadowMaps layers of layerSize x layerSize texels, assigning one Allocation per candidate in the same order.
+        virtual void allocate(const std::vector<Candidate>& candidates, uint32_t availableShadowMaps, uint32_t layerSize, std::vector<Allocation>& allocations) const;
+
+        /// compute the projected radius in pixels of a sphere with the specified eye space center and radius, returning 0 if it's outside the view frustum.
+        static double screenRadius(const dvec3& eyeCenter, double radius, const dmat4& projectionMatrix, double viewportHeight);
+
+    protected:
+        virtual ~ShadowMapBudget();
+    };
+    VSG_type_name(vsg::ShadowMapBudget);
+
+} // namespace vsg
@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/maths/plane.h>
+#include <vsg/maths/simd.h>
 #include <vsg/maths/vec3.h>
 #include <vsg/maths/vec4.h>
 
@@ -175,6 +176,103 @@ namespace vsg
                          dot(lhs, rhs, 3, 0), dot(lhs, rhs, 3, 1), dot(lhs, rhs, 3, 2), dot(lhs, rhs, 3, 3));
     }
 
+#if defined(VSG_SIMD_SSE2) || defined(VSG_SIMD_NEON)
+    /// SIMD specialization of float matrix multiplication, each result column is lhs[0] * rhs[c][0] + lhs[1] * rhs[c][1] + lhs[2] * rhs[c][2] + lhs[3] * rhs[c][3]
+    /// using the same multiply/add ordering as the scalar template so results are identical.
+    inline mat4 operator*(const mat4& lhs, const mat4& rhs)
+    {
+        mat4 result;
+#    if defined(VSG_SIMD_SSE2)
+        const __m128 l0 = _mm_loadu_ps(lhs[0].data());
+        const __m128 l1 = _mm_loadu_ps(lhs[1].data());
+        const __m128 l2 = _mm_loadu_ps(lhs[2].data());
+        const __m128 l3 = _mm_loadu_ps(lhs[3].data());
+        for (int c = 0; c < 4; ++c)
+        {
+            const auto& r = rhs[c];
+            __m128 v = _mm_mul_ps(l0, _mm_set1_ps(r[0]));
+            v = _mm_add_ps(v, _mm_mul_ps(l1, _mm_set1_ps(r[1])));
+            v = _mm_add_ps(v, _mm_mul_ps(l2, _mm_set1_ps(r[2])));
+            v = _mm_add_ps(v, _mm_mul_ps(l3, _mm_set1_ps(r[3])));
+            _mm_storeu_ps(result[c].data(), v);
+        }
+#    else
+        const float32x4_t l0 = vld1q_f32(lhs[0].data());
+        const float32x4_t l1 = vld1q_f32(lhs[1].data());
+        const float32x4_t l2 = vld1q_f32(lhs[2].data());
+        const float32x4_t l3 = vld1q_f32(lhs[3].data());
+        for (int c = 0; c < 4; ++c)
+        {
+            const auto& r = rhs[c];
+            float32x4_t v = vmulq_n_f32(l0, r[0]);
+            v = vaddq_f32(v, vmulq_n_f32(l1, r[1]));
+            v = vaddq_f32(v, vmulq_n_f32(l2, r[2]));
+            v = vaddq_f32(v, vmulq_n_f32(l3, r[3]));
+            vst1q_f32(result[c].data(), v);
+        }
+#    endif
+        return result;
+    }
+#endif
+
+#if defined(VSG_SIMD_SSE2) || (defined(VSG_SIMD_NEON) && defined(__aarch64__))
+    /// SIMD specialization of double matrix multiplication, AVX processes a whole column per instruction, SSE2 and NEON process two rows at a time.
+    inline dmat4 operator*(const dmat4& lhs, const dmat4& rhs)
+    {
+        dmat4 result;
+#    if defined(VSG_SIMD_AVX)
+        const __m256d l0 = _mm256_loadu_pd(lhs[0].data());
+        const __m256d l1 = _mm256_loadu_pd(lhs[1].data());
+        const __m256d l2 = _mm256_loadu_pd(lhs[2].data());
+        const __m256d l3 = _mm256_loadu_pd(lhs[3].data());
+        for (int c = 0; c < 4; ++c)
+        {
+            const auto& r = rhs[c];
+            __m256d v = _mm256_mul_pd(l0, _mm256_set1_pd(r[0]));
+            v = _mm256_add_pd(v, _mm256_mul_pd(l1, _mm256_set1_pd(r[1])));
+            v = _mm256_add_pd(v, _mm256_mul_pd(l2, _mm256_set1_pd(r[2])));
+            v = _mm256_add_pd(v, _mm256_mul_pd(l3, _mm256_set1_pd(r[3])));
+            _mm256_storeu_pd(result[c].data(), v);
+        }
+#    elif defined(VSG_SIMD_SSE2)
+        for (int h = 0; h < 4; h += 2)
+        {
+            const __m128d l0 = _mm_loadu_pd(lhs[0].data() + h);
+            const __m128d l1 = _mm_loadu_pd(lhs[1].data() + h);
+            const __m128d l2 = _mm_loadu_pd(lhs[2].data() + h);
+            const __m128d l3 = _mm_loadu_pd(lhs[3].data() + h);
+            for (int c = 0; c < 4; ++c)
+            {
+                const auto& r = rhs[c];
+                __m128d v = _mm_mul_pd(l0, _mm_set1_pd(r[0]));
+                v = _mm_add_pd(v, _mm_mul_pd(l1, _mm_set1_pd(r[1])));
+                v = _mm_add_pd(v, _mm_mul_pd(l2, _mm_set1_pd(r[2])));
+                v = _mm_add_pd(v, _mm_mul_pd(l3, _mm_set1_pd(r[3])));
+                _mm_storeu_pd(result[c].data() + h, v);
+            }
+        }
+#    else
+        for (int h = 0; h < 4; h += 2)
+        {
+            const float64x2_t l0 = vld1q_f64(lhs[0].data() + h);
+            const float64x2_t l1 = vld1q_f64(lhs[1].data() + h);
+            const float64x2_t l2 = vld1q_f64(lhs[2].data() + h);
+            const float64x2_t l3 = vld1q_f64(lhs[3].data() + h);
+            for (int c = 0; c < 4; ++c)
+            {
+                const auto& r = rhs[c];
+                float64x2_t v = vmulq_n_f64(l0, r[0]);
+                v = vaddq_f64(v, vmulq_n_f64(l1, r[1]));
+                v = vaddq_f64(v, vmulq_n_f64(l2, r[2]));
+                v = vaddq_f64(v, vmulq_n_f64(l3, r[3]));
+                vst1q_f64(result[c].data() + h, v);
+            }
+        }
+#    endif
+        return result;
+    }
+#endif
+
     template<typename T>
     t_vec4<T> operator*(const t_mat4<T>& lhs, const t_vec4<T>& rhs)
     {
@@ -0,0 +1,188 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/maths/quat.h>
+#include <vsg/maths/vec2.h>
+#include <vsg/maths/vec3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace vsg
+{
+
+    /// convert float to IEEE 754 half precision float bits, rounding to nearest, values beyond the half float range map to infinity.
+    inline uint16_t floatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        uint32_t sign = (bits >> 16) & 0x8000;
+        uint32_t float_exponent = (bits >> 23) & 0xff;
+        uint32_t mantissa = bits & 0x007fffff;
+
+        // infinity and NaN
+        if (float_exponent == 0xff) return static_cast<uint16_t>(sign | 0x7c00 | (mantissa ? 0x200 : 0));
+
+        int32_t exponent = static_cast<int32_t>(float_exponent) - 127 + 15;
+        if (exponent >= 31) return static_cast<uint16_t>(sign | 0x7c00);
+
+        if (exponent <= 0)
+        {
+            // too small for a half float subnormal
+            if (exponent < -10) return static_cast<uint16_t>(sign);
+
+            // subnormal, make the implicit leading bit explicit before shifting into place
+            mantissa |= 0x00800000;
+            uint32_t shift = static_cast<uint32_t>(14 - exponent);
+            uint32_t half = mantissa >> shift;
+            if ((mantissa >> (shift - 1)) & 1) ++half;
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        // rounding may carry into the exponent which correctly rounds up to the next power of two
+        uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        if (mantissa & 0x1000) ++half;
+        return static_cast<uint16_t>(half);
+    }
+
+    /// convert IEEE 754 half precision float bits to float
+    inline float halfToFloat(uint16_t half)
+    {
+        uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+        int32_t exponent = (half >> 10) & 0x1f;
+        uint32_t mantissa = half & 0x3ff;
+
+        uint32_t bits;
+        if (exponent == 0)
+        {
+            if (mantissa == 0)
+            {
+                bits = sign;
+            }
+            else
+            {
+                // subnormal, normalize the mantissa
+                exponent = 1;
+                while ((mantissa & 0x400) == 0)
+                {
+                    mantissa <<= 1;
+                    --exponent;
+                }
+                mantissa &= 0x3ff;
+                bits = sign | (static_cast<uint32_t>(exponent + 112) << 23) | (mantissa << 13);
+            }
+        }
+        else if (exponent == 31)
+        {
+            bits = sign | 0x7f800000 | (mantissa << 13);
+        }
+        else
+        {
+            bits = sign | (static_cast<uint32_t>(exponent + 112) << 23) | (mantissa << 13);
+        }
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /// convert value in the range -1 to 1 to a signed normalized 16 bit integer, as read by VK_FORMAT_R16*_SNORM formats
+    inline int16_t floatToSnorm16(float value)
+    {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    /// convert signed normalized 16 bit integer to float in the range -1 to 1
+    inline float snorm16ToFloat(int16_t value)
+    {
+        return std::max(static_cast<float>(value) / 32767.0f, -1.0f);
+    }
+
+    /// encode unit vector as a 2D octahedral projection with components in the range -1 to 1
+    inline vec2 octahedralEncode(const vec3& n)
+    {
+        float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (l1 == 0.0f) return vec2(0.0f, 0.0f);
+
+        vec2 p(n.x / l1, n.y / l1);
+        if (n.z < 0.0f)
+        {
+            // fold the lower hemisphere over the diagonals
+            p.set((1.0f - std::abs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+                  (1.0f - std::abs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+        }
+        return p;
+    }
+
+    /// decode 2D octahedral projection to unit vector
+    inline vec3 octahedralDecode(const vec2& e)
+    {
+        vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+        float t = std::max(-n.z, 0.0f);
+        n.x += (n.x >= 0.0f) ? -t : t;
+        n.y += (n.y >= 0.0f) ? -t : t;
+        return normalize(n);
+    }
+
+    /// pack unit quaternion into 32 bits using the smallest three encoding, the top 2 bits hold the index of the largest magnitude component
+    /// and the remaining three components, in the range -1/sqrt(2) to 1/sqrt(2), are stored as 10 bit unsigned normalized values in ascending component order.
+    /// Decoded by the flat, phong and pbr vertex shaders when VSG_INSTANCE_ROTATION_PACKED is defined.
+    inline uint32_t packQuatSmallestThree(const quat& q)
+    {
+        const float c[4] = {q.x, q.y, q.z, q.w};
+        uint32_t largest = 0;
+        for (uint32_t i = 1; i < 4; ++i)
+        {
+            if (std::abs(c[i]) > std::abs(c[largest])) largest = i;
+        }
+
+        float len = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2] + c[3] * c[3]);
+        if (len == 0.0f) return packQuatSmallestThree(quat());
+
+        // q and -q represent the same rotation so flip the sign to make the dropped component positive
+        float multiplier = (c[largest] < 0.0f ? -1.0f : 1.0f) * 1.41421356f / len;
+
+        uint32_t packed = largest << 30;
+        uint32_t shift = 0;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            if (i == largest) continue;
+            float v = std::clamp(c[i] * multiplier, -1.0f, 1.0f);
+            packed |= static_cast<uint32_t>(std::lround((v * 0.5f + 0.5f) * 1023.0f)) << shift;
+            shift += 10;
+        }
+        return packed;
+    }
+
+    /// unpack quaternion packed by packQuatSmallestThree(..)
+    inline quat unpackQuatSmallestThree(uint32_t packed)
+    {
+        uint32_t largest = packed >> 30;
+        float c[4];
+        float sum = 0.0f;
+        uint32_t shift = 0;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            if (i == largest) continue;
+            c[i] = (static_cast<float>((packed >> shift) & 1023u) / 1023.0f * 2.0f - 1.0f) * 0.70710678f;
+            sum += c[i] * c[i];
+            shift += 10;
+        }
+        c[largest] = std::sqrt(std::max(1.0f - sum, 0.0f));
+        return quat(c[0], c[1], c[2], c[3]);
+    }
+
+} // namespace vsg
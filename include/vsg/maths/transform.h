@@ -253,6 +253,20 @@ namespace vsg
     /// double matrix inversion with automatic selection of inverse_4x3 when appropriate, otherwise uses inverse_4x4
     extern VSG_DECLSPEC dmat4 inverse(const dmat4& m);
 
+    /// transform count float points by a float matrix, applying the same perspective divide as mat4 * vec3, src and dest may be the same array.
+    /// Uses SSE/NEON when available at compile time.
+    extern VSG_DECLSPEC void transform(const mat4& matrix, const vec3* src, vec3* dest, size_t count);
+
+    /// transform count double points by a double matrix, applying the same perspective divide as dmat4 * dvec3, src and dest may be the same array.
+    /// Uses AVX/SSE2/NEON when available at compile time.
+    extern VSG_DECLSPEC void transform(const dmat4& matrix, const dvec3* src, dvec3* dest, size_t count);
+
+    /// transform count float points by a double matrix in double precision, writing double results.
+    extern VSG_DECLSPEC void transform(const dmat4& matrix, const vec3* src, dvec3* dest, size_t count);
+
+    /// transform count float points by a double matrix in double precision, writing float results. src and dest may be the same array.
+    extern VSG_DECLSPEC void transform(const dmat4& matrix, const vec3* src, vec3* dest, size_t count);
+
     /// compute determinant of float matrix
     extern VSG_DECLSPEC float determinant(const mat4& m);
 
@@ -0,0 +1,107 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array.h>
+#include <vsg/meshshaders/DrawMeshTasks.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+
+namespace vsg
+{
+
+    // forward declare
+    class DescriptorConfigurator;
+
+    /// Meshlet struct describing a cluster of triangles, laid out to match the std430 Meshlet struct used by the meshlet ShaderSets.
+    /// sphere is the bounding sphere, xyz center and w radius, used for frustum culling.
+    /// cone is the normal cone, xyz axis and w cutoff, used for backface culling. A cutoff of 1.0 disables backface culling of the meshlet.
+    struct Meshlet
+    {
+        vec4 sphere;
+        vec4 cone{0.0f, 0.0f, 1.0f, 1.0f};
+        uint32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        uint32_t triangleOffset = 0;
+        uint32_t triangleCount = 0;
+
+        void read(vsg::Input& input)
+        {
+            input.read("sphere", sphere);
+            input.read("cone", cone);
+            input.read("vertexOffset", vertexOffset);
+            input.read("vertexCount", vertexCount);
+            input.read("triangleOffset", triangleOffset);
+            input.read("triangleCount", triangleCount);
+        }
+
+        void write(vsg::Output& output) const
+        {
+            output.write("sphere", sphere);
+            output.write("cone", cone);
+            output.write("vertexOffset", vertexOffset);
+            output.write("vertexCount", vertexCount);
+            output.write("triangleOffset", triangleOffset);
+            output.write("triangleCount", triangleCount);
+        }
+    };
+
+    template<>
+    constexpr bool has_read_write<Meshlet>() { return true; }
+
+    VSG_array(MeshletArray, Meshlet);
+
+    /// Meshlets holds the meshlets and vertex arrays of a triangle mesh for rendering with the task and mesh shaders of the ShaderSets
+    /// created by createPhongMeshletShaderSet() and createPhysicsBasedRenderingMeshletShaderSet().
+    /// vertexIndices maps each meshlet's local vertices to the vertex arrays, triangles packs the three 8 bit local vertex indices of each triangle into a uint.
+    class VSG_DECLSPEC Meshlets : public Inherit<Object, Meshlets>
+    {
+    public:
+        Meshlets();
+
+        /// number of meshlets processed by each task shader work group
+        static constexpr uint32_t taskWorkGroupSize = 32;
+
+        ref_ptr<MeshletArray> meshlets;
+        ref_ptr<uintArray> vertexIndices;
+        ref_ptr<uintArray> triangles;
+
+        ref_ptr<vec3Array> vertices;
+        ref_ptr<vec3Array> normals;
+        ref_ptr<vec2Array> texCoords;
+        ref_ptr<vec4Array> colors;
+
+        /// assign the meshlet and vertex arrays to the storage buffer descriptors of a meshlet ShaderSet.
+        void assignDescriptors(DescriptorConfigurator& descriptorConfigurator) const;
+
+        /// create the DrawMeshTasks command that dispatches the task shaders to cull and render all the meshlets.
+        ref_ptr<DrawMeshTasks> createDrawMeshTasks() const;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~Meshlets();
+    };
+    VSG_type_name(vsg::Meshlets);
+
+    /// build meshlets from an indexed triangle list, with area weighted vertex normals computed from the triangles. Each meshlet is limited to maxVertices vertices and maxTriangles triangles.
+    /// Triangles are added to the current meshlet preferring neighbouring triangles that add the fewest new vertices so meshlets are compact, which tightens their bounds.
+    /// The meshlet ShaderSets require maxVertices <= 64 and maxTriangles <= 124.
+    extern VSG_DECLSPEC ref_ptr<Meshlets> buildMeshlets(ref_ptr<vec3Array> vertices, const Data& indices, uint32_t firstIndex, uint32_t indexCount, uint32_t vertexOffset = 0, uint32_t maxVertices = 64, uint32_t maxTriangles = 124);
+
+    /// build meshlets from a VertexIndexDraw using a triangle list topology, arrays are assumed to follow the vsg::Builder layout of vertices, normals, texCoords and colors,
+    /// using the VertexIndexDraw's normals when available. Returns null if the VertexIndexDraw doesn't have a vec3Array of vertices or ushort/uint indices.
+    extern VSG_DECLSPEC ref_ptr<Meshlets> buildMeshlets(const VertexIndexDraw& vid, uint32_t maxVertices = 64, uint32_t maxTriangles = 124);
+
+} // namespace vsg
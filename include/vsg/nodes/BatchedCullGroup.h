@@ -0,0 +1,51 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Group.h>
+
+namespace vsg
+{
+
+    /// BatchedCullGroup is a Group with a bounding sphere per child, during the RecordTraversal all the child bounds are tested against the view frustum
+    /// in a single batched call to State::intersect(..), using SIMD where available, and only the visible children are traversed.
+    /// Use in place of a Group of CullNode when there are many children. bounds must be the same size as children.
+    class VSG_DECLSPEC BatchedCullGroup : public Inherit<Group, BatchedCullGroup>
+    {
+    public:
+        explicit BatchedCullGroup(size_t numChildren = 0);
+        BatchedCullGroup(const BatchedCullGroup& rhs, const CopyOp& copyop = {});
+
+        std::vector<dsphere> bounds;
+
+        void addChild(const dsphere& bound, ref_ptr<Node> child)
+        {
+            bounds.push_back(bound);
+            children.push_back(child);
+        }
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return BatchedCullGroup::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~BatchedCullGroup();
+    };
+    VSG_type_name(vsg::BatchedCullGroup);
+
+} // namespace vsg
@@ -17,17 +17,22 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 namespace vsg
 {
+    // forward declare
+    struct ScratchMemory;
 
     /// Bin node is used internally by RecordTraversal/View to collect and then sort command nodes assigned to the bin,
     /// then recorded to the command buffer in the sorted order.
     class VSG_DECLSPEC Bin : public Inherit<Node, Bin>
     {
     public:
+        /// ASCENDING and DESCENDING sort by the value passed to add(..), typically the distance from the eye point.
+        /// STATE_SORT sorts by pipeline, then other state such as descriptor sets, then vertex buffers and finally ascending value, minimizing state changes in opaque bins.
         enum SortOrder
         {
             NO_SORT,
             ASCENDING,
-            DESCENDING
+            DESCENDING,
+            STATE_SORT
         };
 
         Bin();
@@ -41,6 +46,12 @@ namespace vsg
 
         void add(State* state, double value, const Node* node);
 
+        /// append the elements collected by another Bin, used to merge Bins populated by separate RecordTraversals.
+        void add(const Bin& bin);
+
+        /// return true if no elements have been added since the last clear()
+        bool empty() const { return _elements.empty(); }
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return Bin::create(*this, copyop); }
         int compare(const Object& rhs) const override;
@@ -56,6 +67,9 @@ namespace vsg
         std::vector<dmat4> _matrices;
         std::vector<const StateCommand*> _stateCommands;
 
+        // MatrixStack::topID() of the last matrix added to _matrices, 0 when unknown, so elements sharing a modelview matrix share its index.
+        uint64_t _matrixID = 0;
+
         struct Element
         {
             uint32_t matrixIndex = 0;
@@ -68,6 +82,19 @@ namespace vsg
 
         using KeyIndex = std::pair<float, uint32_t>;
         mutable std::vector<KeyIndex> _binElements;
+
+        // sort keys and scratch buffers, retained between frames to avoid reallocation
+        using SortKey = std::pair<uint64_t, uint32_t>;
+        mutable std::vector<SortKey> _sortKeys;
+        mutable std::vector<SortKey> _sortScratch;
+        mutable std::vector<KeyIndex> _sortedBinElements;
+
+        // positions in _binElements of the last ASCENDING/DESCENDING sort's results, as successive frames add the same elements in the same traversal order
+        // applying it to the next frame's elements gives a nearly sorted sequence that an insertion sort completes in close to linear time.
+        mutable std::vector<uint32_t> _previousOrder;
+
+        /// sort the bin elements, the STATE_SORT id maps are allocated from scratchMemory when assigned.
+        void _sort(ScratchMemory* scratchMemory) const;
     };
     VSG_type_name(vsg::Bin);
 
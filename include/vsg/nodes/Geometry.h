@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/commands/Draw.h>
 #include <vsg/nodes/Node.h>
 #include <vsg/state/BufferInfo.h>
+#include <vsg/utils/CachedBounds.h>
 
 namespace vsg
 {
@@ -43,6 +44,9 @@ namespace vsg
         void assignArrays(const DataList& in_arrays);
         void assignIndices(ref_ptr<vsg::Data> in_indices);
 
+        /// local bounds of the vertices cached by ComputeBounds, reset by assignArrays(..) and assignIndices(..)
+        mutable CachedBounds cachedBounds;
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return Geometry::create(*this, copyop); }
         int compare(const Object& rhs) const override;
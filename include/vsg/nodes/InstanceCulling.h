@@ -0,0 +1,96 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/Camera.h>
+#include <vsg/commands/Command.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/InstanceDrawIndexedIndirect.h>
+#include <vsg/nodes/InstanceNode.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/ComputePipeline.h>
+
+namespace vsg
+{
+
+    /** InstanceCulling is a compute stage that frustum and LOD culls each instance of an InstanceNode on the GPU, writing the translations, rotations, scales and colors
+      * of the visible instances to compacted per instance arrays and the visible instance count to a VkDrawIndexedIndirectCommand.
+      * The culledInstanceNode, which references the compacted arrays, is placed in the scene graph in place of the source InstanceNode, and its subgraph draws the mesh
+      * via the InstanceDrawIndexedIndirect assigned as draw, so the CPU never touches individual instances.
+      * When levels are assigned each visible instance is instead drawn by a single level of detail, selected per instance on the GPU, with one indirect draw per level.
+      * As compute dispatches can't be recorded within a render pass, InstanceCulling must be placed in the CommandGraph ahead of the RenderGraph that renders the culledInstanceNode.*/
+    class VSG_DECLSPEC InstanceCulling : public Inherit<Command, InstanceCulling>
+    {
+    public:
+        InstanceCulling();
+        InstanceCulling(ref_ptr<InstanceNode> in_instanceNode, ref_ptr<InstanceDrawIndexedIndirect> in_draw, const dsphere& in_bound, ref_ptr<Camera> in_camera);
+
+        /// source instances, its translations, rotations, scales and colors are read by the compute shader.
+        ref_ptr<InstanceNode> instanceNode;
+
+        /// draw command in the instanceNode's subgraph, its indirect BufferInfo is assigned to drawCommand by init().
+        ref_ptr<InstanceDrawIndexedIndirect> draw;
+
+        /// bounding sphere of the mesh in the local coordinate frame of an instance.
+        dsphere bound;
+
+        /// camera providing the projection and view matrices that the view frustum is computed from.
+        ref_ptr<Camera> camera;
+
+        /// local to world transform of the instanceNode.
+        dmat4 matrix;
+
+        /// cull instances whose screen height ratio falls below minimumScreenHeightRatio, following the LOD::Child::minimumScreenHeightRatio convention. 0.0 disables the LOD test.
+        double minimumScreenHeightRatio = 0.0;
+
+        /// level of detail drawn with the InstanceDrawIndexedIndirect draw in its child subgraph when selected for an instance.
+        struct Level
+        {
+            double minimumScreenHeightRatio = 0.0;
+            ref_ptr<Node> child;
+            ref_ptr<InstanceDrawIndexedIndirect> draw;
+        };
+
+        /// levels of detail ordered from highest to lowest detail, each instance is drawn by the first level whose minimumScreenHeightRatio it passes, following the LOD::Child convention,
+        /// and instances that fail all of them are culled. When assigned the levels' children replace the instanceNode's child and draw/minimumScreenHeightRatio are ignored.
+        /// Call init() after changing the levels.
+        std::vector<Level> levels;
+
+        /// InstanceNode referencing the compacted per instance arrays, with the instanceNode's child (or a Group of the levels' children) as its child, set up by init().
+        ref_ptr<InstanceNode> culledInstanceNode;
+
+        /// VkDrawIndexedIndirectCommand written by the compute shader, one per level, set up by init().
+        ref_ptr<BufferInfo> drawCommand;
+
+        /// set up the culledInstanceNode, drawCommand and compute pipeline, called automatically by the constructor that takes an InstanceNode.
+        void init();
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~InstanceCulling();
+
+        BufferInfoList _sourceArrays;
+        BufferInfoList _culledArrays;
+        ref_ptr<PipelineLayout> _pipelineLayout;
+        ref_ptr<BindComputePipeline> _bindComputePipeline;
+        ref_ptr<BindDescriptorSet> _bindDescriptorSet;
+        uint32_t _numLevels = 1;
+    };
+    VSG_type_name(vsg::InstanceCulling);
+
+} // namespace vsg
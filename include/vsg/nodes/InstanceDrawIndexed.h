@@ -18,6 +18,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 namespace vsg
 {
+    // forward declare
+    class InstanceNode;
 
     /** InstanceDrawIndexed provides a lightweight way of binding vertex arrays, indices and then issuing a vkCmdDrawIndexed command.
       * Higher performance equivalent to use of individual vsg::BindVertexBuffers, vsg::BindIndexBuffer and vsg::DrawIndexed commands.*/
@@ -53,6 +55,9 @@ namespace vsg
     protected:
         virtual ~InstanceDrawIndexed();
 
+        /// bind the vertex arrays, the inherited InstanceNode's per instance arrays and the indices, returns the InstanceNode or nullptr if none is active.
+        const InstanceNode* bindArraysAndIndices(CommandBuffer& commandBuffer) const;
+
         VkIndexType indexType = VK_INDEX_TYPE_UINT16;
     };
     VSG_type_name(vsg::InstanceDrawIndexed)
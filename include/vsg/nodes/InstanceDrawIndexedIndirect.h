@@ -0,0 +1,49 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/nodes/InstanceDrawIndexed.h>
+
+namespace vsg
+{
+
+    /** InstanceDrawIndexedIndirect binds the arrays and indices in the same way as InstanceDrawIndexed, but sources the draw parameters from a buffer of VkDrawIndexedIndirectCommand
+      * via vkCmdDrawIndexedIndirect, typically written by a compute shader such as the one used by vsg::InstanceCulling.*/
+    class VSG_DECLSPEC InstanceDrawIndexedIndirect : public Inherit<InstanceDrawIndexed, InstanceDrawIndexedIndirect>
+    {
+    public:
+        InstanceDrawIndexedIndirect();
+        InstanceDrawIndexedIndirect(const InstanceDrawIndexedIndirect& rhs, const CopyOp& copyop = {});
+
+        // vkCmdDrawIndexedIndirect settings
+        // vkCmdDrawIndexedIndirect(commandBuffer, indirect->buffer, indirect->offset, drawCount, stride);
+        ref_ptr<BufferInfo> indirect;
+        uint32_t drawCount = 1;
+        uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return InstanceDrawIndexedIndirect::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~InstanceDrawIndexedIndirect();
+    };
+    VSG_type_name(vsg::InstanceDrawIndexedIndirect)
+
+} // namespace vsg
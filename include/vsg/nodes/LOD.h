@@ -28,7 +28,9 @@ namespace vsg
      *  During culling the minimumScreenHeightRatio is used as a minimum ratio of screen height that a bounding sphere needs to occupy in order for the associated child to be traversed.
      *  Once one child passes this test no more children are checked, so that no more than one child will ever be traversed in a record traversal.
      *  If no child passes the visible height test then none of the LOD's children will be visible.
-     *  During the record traversals the Bound sphere is also checked against the view frustum so that LOD's also enable view frustum culling for subgraphs so there is no need for a separate CullNode/CullGroup to decorate it. */
+     *  During the record traversals the Bound sphere is also checked against the view frustum so that LOD's also enable view frustum culling for subgraphs so there is no need for a separate CullNode/CullGroup to decorate it.
+     *  When the lowest resolution child has a non zero geometricError the children are instead selected by screen space error, a child being traversed when the geometricError of the
+     *  next lower resolution child projected to the screen exceeds View::maximumScreenSpaceError pixels, the lowest resolution child still being tested against its minimumScreenHeightRatio. */
     class VSG_DECLSPEC LOD : public Inherit<Node, LOD>
     {
     public:
@@ -39,6 +41,7 @@ namespace vsg
         {
             double minimumScreenHeightRatio = 0.0; // 0.0 is always visible
             ref_ptr<Node> node;
+            double geometricError = 0.0; // world space error of the child's representation, 0.0 selects by minimumScreenHeightRatio
         };
 
         using Children = std::vector<Child, allocator_affinity_nodes<Child>>;
@@ -0,0 +1,72 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Group.h>
+
+#include <atomic>
+
+namespace vsg
+{
+
+    // forward declare
+    class LazyCompiler;
+
+    /// LazyCompileGroup is a Group whose children are compiled on a background thread the first time its bound is visible, rather than up front by Viewer::compile().
+    /// When a LazyCompiler is assigned, the CompileTraversal and CollectResourceRequirements skip the children until compiled, and the RecordTraversal
+    /// requests the compile of visible LazyCompileGroup and skips them until the LazyCompiler has merged the compiled children.
+    /// Without a LazyCompiler assigned LazyCompileGroup behaves as a CullGroup.
+    class VSG_DECLSPEC LazyCompileGroup : public Inherit<Group, LazyCompileGroup>
+    {
+    public:
+        LazyCompileGroup();
+        LazyCompileGroup(const LazyCompileGroup& rhs, const CopyOp& copyop = {});
+        explicit LazyCompileGroup(const dsphere& in_bound);
+
+        dsphere bound;
+
+        /// LazyCompiler used to compile the children, assigned at runtime via LazyCompiler::assign(..).
+        ref_ptr<LazyCompiler> lazyCompiler;
+
+        /// return true if the children can be traversed by the CompileTraversal and RecordTraversal
+        bool compiled() const { return !lazyCompiler || requestStatus.load() == Compiled; }
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return LazyCompileGroup::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~LazyCompileGroup();
+
+    public:
+        // priority value assigned by record traversal as a guide to how important the compile is.
+        mutable std::atomic<double> priority{0.0};
+
+        enum RequestStatus : unsigned int
+        {
+            NoRequest = 0,
+            CompileRequest = 1,
+            Compiling = 2,
+            MergeRequest = 3,
+            Compiled = 4
+        };
+
+        mutable std::atomic<RequestStatus> requestStatus{NoRequest};
+    };
+    VSG_type_name(vsg::LazyCompileGroup);
+
+} // namespace vsg
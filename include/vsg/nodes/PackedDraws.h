@@ -0,0 +1,89 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/BindIndexBuffer.h>
+#include <vsg/commands/BindVertexBuffers.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Node.h>
+#include <vsg/state/StateCommand.h>
+
+#include <algorithm>
+
+namespace vsg
+{
+
+    /// PackedDraws is a lightweight representation of many static indexed draws that share vertex and index arrays, for scenes with very large numbers of leaf draws.
+    /// Rather than each draw being a VertexIndexDraw node, with its vtable, reference count, auxiliary pointer and the parent's ref_ptr to it, each draw is a record
+    /// of a bounding sphere, a state index and an index range held in parallel arrays, using 28 bytes per draw.
+    /// The RecordTraversal culls all the draws in a single batched call, binds the vertex and index buffers once and records the visible draws with vkCmdDrawIndexed,
+    /// only pushing/popping state when the state index changes between consecutive draws. Intersector and ComputeBounds intersect against and compute the bounds of the draws.
+    /// Use vsg::packDraws(..) to convert a subgraph of VertexIndexDraw/Geometry nodes to a PackedDraws.
+    class VSG_DECLSPEC PackedDraws : public Inherit<Node, PackedDraws>
+    {
+    public:
+        PackedDraws();
+        PackedDraws(const PackedDraws& rhs, const CopyOp& copyop = {});
+
+        /// vertex arrays shared by all the draws
+        ref_ptr<BindVertexBuffers> bindVertexBuffers;
+
+        /// indices shared by all the draws, index values are relative to the start of the vertex arrays
+        ref_ptr<BindIndexBuffer> bindIndexBuffer;
+
+        /// per draw bounding sphere in the local coordinate frame of the PackedDraws
+        std::vector<sphere> bounds;
+
+        /// per draw index into the stateSets array
+        std::vector<uint32_t> stateIndices;
+
+        /// per draw first index and index count passed to vkCmdDrawIndexed
+        std::vector<uint32_t> firstIndices;
+        std::vector<uint32_t> indexCounts;
+
+        /// StateCommands accumulated from the StateGroups above each draw, in the order they were pushed
+        std::vector<StateCommands> stateSets;
+
+        /// add draw, returning its index
+        uint32_t addDraw(const sphere& bound, uint32_t stateIndex, uint32_t firstIndex, uint32_t indexCount);
+
+        size_t numDraws() const { return std::min({bounds.size(), stateIndices.size(), firstIndices.size(), indexCounts.size()}); }
+
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            for (auto& stateSet : node.stateSets)
+            {
+                for (auto& stateCommand : stateSet) stateCommand->accept(visitor);
+            }
+            if (node.bindVertexBuffers) node.bindVertexBuffers->accept(visitor);
+            if (node.bindIndexBuffer) node.bindIndexBuffer->accept(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+        void traverse(RecordTraversal&) const override {}
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return PackedDraws::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~PackedDraws();
+    };
+    VSG_type_name(vsg::PackedDraws);
+
+} // namespace vsg
@@ -0,0 +1,87 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/maths/mat4.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Node.h>
+#include <vsg/state/StateCommand.h>
+
+namespace vsg
+{
+
+    /// PackedSubgraph is a flattened representation of a static subgraph of Group, StateGroup, MatrixTransform and CullGroup nodes,
+    /// with the draw leaves, the per draw bounds, transform and state indices held in parallel arrays.
+    /// The RecordTraversal culls all the draws in a single batched call then records the visible draws in order with a linear loop,
+    /// only pushing/popping transforms and state when their indices change between consecutive draws.
+    /// Use vsg::packSubgraph(..) to create a PackedSubgraph and vsg::unpackSubgraph(..) to convert back to an editable subgraph.
+    class VSG_DECLSPEC PackedSubgraph : public Inherit<Node, PackedSubgraph>
+    {
+    public:
+        PackedSubgraph();
+        PackedSubgraph(const PackedSubgraph& rhs, const CopyOp& copyop = {});
+
+        /// per draw bounding sphere in the local coordinate frame of the PackedSubgraph
+        std::vector<dsphere> bounds;
+
+        /// per draw index into the transforms array
+        std::vector<uint32_t> transformIndices;
+
+        /// per draw index into the stateSets array
+        std::vector<uint32_t> stateIndices;
+
+        /// per draw leaf, typically VertexIndexDraw, VertexDraw, Geometry, Commands or other Command
+        std::vector<ref_ptr<Node>> draws;
+
+        /// transforms relative to the local coordinate frame of the PackedSubgraph
+        std::vector<dmat4> transforms;
+
+        /// StateCommands accumulated from the StateGroups above each draw, in the order they were pushed
+        std::vector<StateCommands> stateSets;
+
+        /// add draw, returning its index
+        uint32_t addDraw(const dsphere& bound, uint32_t transformIndex, uint32_t stateIndex, ref_ptr<Node> draw);
+
+        size_t numDraws() const { return draws.size(); }
+
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            for (auto& stateSet : node.stateSets)
+            {
+                for (auto& stateCommand : stateSet) stateCommand->accept(visitor);
+            }
+            for (auto& draw : node.draws) draw->accept(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+        void traverse(RecordTraversal& visitor) const override
+        {
+            for (auto& draw : draws) draw->accept(visitor);
+        }
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return PackedSubgraph::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~PackedSubgraph();
+    };
+    VSG_type_name(vsg::PackedSubgraph);
+
+} // namespace vsg
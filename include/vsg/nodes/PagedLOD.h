@@ -31,7 +31,8 @@ namespace vsg
      *  During culling the minimumScreenHeightRatio is used as a minimum ratio of screen height that a bounding sphere needs to occupy in order for the associated child to be traversed.
      *  Once one child passes this test no more children are checked, so that no more than one child will ever be traversed in a record traversal.
      *  If no PagedLODChild passes the visible height test then none of the PagedLOD's children will be visible.
-     *  During the record traversals the Bound sphere is also checked against the view frustum so that PagedLOD's also enable view frustum culling for subgraphs so there is no need for a separate CullNode/CullGroup to decorate it. */
+     *  During the record traversals the Bound sphere is also checked against the view frustum so that PagedLOD's also enable view frustum culling for subgraphs so there is no need for a separate CullNode/CullGroup to decorate it.
+     *  When the low res child has a non zero geometricError the high res child is instead required when the low res child's geometricError projected to the screen exceeds View::maximumScreenSpaceError pixels. */
     class VSG_DECLSPEC PagedLOD : public Inherit<Node, PagedLOD>
     {
     public:
@@ -42,6 +43,7 @@ namespace vsg
         {
             double minimumScreenHeightRatio = 0.0; // 0.0 is always visible
             ref_ptr<Node> node;
+            double geometricError = 0.0; // world space error of the child's representation, 0.0 selects by minimumScreenHeightRatio
         };
 
         // external file to load when child 0 is null.
@@ -105,6 +107,10 @@ namespace vsg
         mutable uint32_t index = 0;
 
         ref_ptr<Node> pending;
+
+        // estimated bytes of CPU and GPU memory held by the high res child, assigned by the DatabasePager when the child is loaded.
+        uint64_t highResCPUMemory = 0;
+        uint64_t highResGPUMemory = 0;
     };
     VSG_type_name(vsg::PagedLOD);
 
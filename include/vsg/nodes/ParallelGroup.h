@@ -0,0 +1,50 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/nodes/Group.h>
+
+namespace vsg
+{
+
+    /// ParallelGroup is a Group whose children may be recorded by the RecordTraversal in batches across multiple threads,
+    /// with each batch of children recorded into its own secondary CommandBuffer that is then executed by the parent CommandBuffer using vkCmdExecuteCommands.
+    /// Batches are recorded using the threads assigned to RecordTraversal::recordThreads, if none are assigned the batches are recorded on the calling thread.
+    /// When used within a render pass the subpass must be begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, i.e. via RenderGraph::contents,
+    /// otherwise the children are recorded inline just like a Group.
+    /// Positional lights within the ParallelGroup's subgraph are not collected, so place lights outside the ParallelGroup.
+    class VSG_DECLSPEC ParallelGroup : public Inherit<Group, ParallelGroup>
+    {
+    public:
+        explicit ParallelGroup(size_t numChildren = 0);
+        ParallelGroup(const ParallelGroup& rhs, const CopyOp& copyop = {});
+
+        /// maximum number of batches to split the children into, 0 uses one batch per RecordTraversal::recordThreads thread plus one for the calling thread.
+        uint32_t maxNumBatches = 0;
+
+        /// minimum number of children to assign to each batch, avoids the overhead of secondary CommandBuffers for small sets of children.
+        uint32_t minimumChildrenPerBatch = 16;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return ParallelGroup::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~ParallelGroup();
+    };
+    VSG_type_name(vsg::ParallelGroup);
+
+} // namespace vsg
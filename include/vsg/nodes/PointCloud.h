@@ -0,0 +1,113 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/nodes/PagedLOD.h>
+
+#include <atomic>
+#include <vector>
+
+namespace vsg
+{
+
+    /// PointCloudTile is a node of the octree of a PointCloud, holding a chunk of points that subsamples the points of its octant of the cloud,
+    /// with the child tiles adding progressively denser subsamples of their octants, following the Potree layout.
+    /// The chunk is held as the high res child, children[0].node, and when not assigned is loaded by the DatabasePager from filename,
+    /// so tiles covering a large part of the screen are streamed in and those not used recently are expired like PagedLOD subgraphs.
+    /// The hierarchy of tiles with their bounds and point counts is held in memory so the PointCloud can select the tiles to draw within its point budget before their chunks are loaded.
+    class VSG_DECLSPEC PointCloudTile : public Inherit<PagedLOD, PointCloudTile>
+    {
+    public:
+        PointCloudTile();
+        PointCloudTile(const PointCloudTile& rhs, const CopyOp& copyop = {});
+
+        /// number of points in the chunk, counted against the PointCloud::pointBudget when the chunk is drawn.
+        uint32_t numPoints = 0;
+
+        using Tiles = std::vector<ref_ptr<PointCloudTile>>;
+
+        /// child tiles, up to one for each octant of the bound.
+        Tiles tiles;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return PointCloudTile::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            PagedLOD::t_traverse(node, visitor);
+            for (auto& tile : node.tiles)
+            {
+                if (tile) tile->accept(visitor);
+            }
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+        void traverse(RecordTraversal& visitor) const override { PagedLOD::t_traverse(*this, visitor); }
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~PointCloudTile();
+    };
+    VSG_type_name(vsg::PointCloudTile);
+
+    /// PointCloud node draws an octree of PointCloudTile within a per frame budget of points.
+    /// During the record traversal the tiles within the view frustum are visited in order of the screen height ratio of their bounds,
+    /// so the budget is spent on the tiles covering the most of the screen first, drawing each tile's chunk until the next would exceed the pointBudget.
+    /// Child tiles are only visited once their parent's chunk is loaded, so the coarser chunks are drawn while the denser ones stream in.
+    /// The chunks are usually created with createPointCloudChunk(..) and drawn with the StateGroup from createPointCloudStateGroup(..) decorating the PointCloud.
+    class VSG_DECLSPEC PointCloud : public Inherit<Node, PointCloud>
+    {
+    public:
+        PointCloud();
+        PointCloud(const PointCloud& rhs, const CopyOp& copyop = {});
+        explicit PointCloud(ref_ptr<PointCloudTile> in_root);
+
+        ref_ptr<PointCloudTile> root;
+
+        /// maximum number of points drawn each frame, for each View.
+        uint64_t pointBudget = 5000000;
+
+        /// tiles whose bound occupies less than this ratio of the screen height aren't drawn, following the LOD::Child convention.
+        double minimumScreenHeightRatio = 0.05;
+
+        /// number of points drawn by the most recent record traversal.
+        mutable std::atomic_uint64_t numPointsDrawn{0};
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return PointCloud::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            if (node.root) node.root->accept(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+        void traverse(RecordTraversal& visitor) const override { t_traverse(*this, visitor); }
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~PointCloud();
+    };
+    VSG_type_name(vsg::PointCloud);
+
+} // namespace vsg
@@ -19,6 +19,9 @@ namespace vsg
 {
 
     /// RegionOfInterest node is inform applications/algorithms extents that should take account of.
+    /// The ViewDependentState fits the shadow map frustum to the regions found during the RecordTraversal of a View.
+    /// When focusRadius is set the region also acts as a focus for streaming, the PagedLOD within focusRadius of the region's points being requested
+    /// at the resolution they'd require if viewed from the region, so the area around it is loaded ahead of the camera reaching it, such as around a vehicle or a point of interest shared by several Views.
     class VSG_DECLSPEC RegionOfInterest : public Inherit<Node, RegionOfInterest>
     {
     public:
@@ -29,6 +32,15 @@ namespace vsg
         std::string name;
         std::vector<dvec3> points;
 
+        /// radius around the bounding sphere of the points within which PagedLOD are requested for the focus area, 0.0 disables the focus.
+        double focusRadius = 0.0;
+
+        /// scale applied to the priority of focus requests, greater than 1.0 loads the focus area ahead of the rest of the current frame's requests.
+        double focusPriorityScale = 2.0;
+
+        /// maximum bytes of GPU memory of the high res subgraphs loaded for the focus area, once reached no further focus requests are made. 0 for no limit.
+        uint64_t focusMemoryBudget = 0;
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return RegionOfInterest::create(*this, copyop); }
         int compare(const Object& rhs) const override;
@@ -0,0 +1,96 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Group.h>
+
+#include <unordered_map>
+
+namespace vsg
+{
+
+    /// SpatialGrid is a Group that maintains a loose uniform grid over the bounds of its children, for scenes with many moving children such as vehicle or aircraft tracks
+    /// where a static hierarchy of CullGroups would soon be invalid. Children are assigned to the cell containing the center of their bound and each cell's bound is
+    /// loosened by the radius of the largest child assigned to it, so children moving within a cell need no changes to the grid.
+    /// The RecordTraversal culls the cells in a single batched intersection test and then only the children of the visible cells, Intersectors only test the children of intersected cells.
+    /// The bounds of MatrixTransform children are recomputed from their matrix and the cached bound of their subgraph, so after moving children call update() to update the bounds
+    /// and move the children whose centers have crossed into another cell. Add and remove children with addChild()/removeChild() so the grid is kept in sync.
+    class VSG_DECLSPEC SpatialGrid : public Inherit<Group, SpatialGrid>
+    {
+    public:
+        explicit SpatialGrid(double in_cellSize = 1000.0);
+        SpatialGrid(const SpatialGrid& rhs, const CopyOp& copyop = {});
+
+        /// width of the cubic cells, best set to several times the size of the typical child. Call rebuild() after changing.
+        double cellSize;
+
+        /// bounding sphere of each child in the SpatialGrid's coordinate frame, updated by update()
+        std::vector<dsphere> bounds;
+
+        struct Cell
+        {
+            uint64_t key = 0;
+            std::vector<uint32_t> children; // indices into children/bounds
+            double maxRadius = 0.0;
+        };
+
+        /// cells of the grid and their bounding spheres, empty cells are retained for reuse
+        const std::vector<Cell>& getCells() const { return _cells; }
+        const std::vector<dsphere>& getCellBounds() const { return _cellBounds; }
+
+        void addChild(ref_ptr<Node> child);
+
+        /// remove child, the last child is moved into its place so the order of children isn't preserved.
+        void removeChild(size_t index);
+
+        /// update the bounds of all children, moving those that have crossed into another cell.
+        void update();
+
+        /// update the bound of a single child, moving it if it's crossed into another cell.
+        void update(size_t index);
+
+        /// recompute the cached subgraph bounds of all the children and rebuild the grid, call after changing the subgraphs of children or the cellSize.
+        void rebuild();
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return SpatialGrid::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~SpatialGrid();
+
+        struct Entry
+        {
+            dsphere localBound; // bound of the child's subgraph, beneath its matrix for MatrixTransform children
+            uint32_t cell = 0;
+        };
+
+        std::vector<Entry> _entries;
+        std::vector<Cell> _cells;
+        std::vector<dsphere> _cellBounds;
+        std::vector<uint32_t> _freeCells;
+        std::unordered_map<uint64_t, uint32_t> _cellIndices;
+
+        uint64_t _cellKey(const dvec3& position) const;
+        dsphere _computeBound(size_t index) const;
+        void _insert(size_t index);
+        void _remove(size_t index);
+    };
+    VSG_type_name(vsg::SpatialGrid);
+
+} // namespace vsg
@@ -0,0 +1,116 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/Options.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/state/ImageInfo.h>
+
+#include <atomic>
+
+namespace vsg
+{
+
+    // forward declare
+    class TextureStreamer;
+
+    /// StreamedTexture tracks the mipmap levels resident on the GPU for a texture of a StreamingStateGroup.
+    /// The imageInfo is the ImageInfo currently assigned to the StateGroup's DescriptorImage, containing the mipmap levels from residentLevel down to the smallest level.
+    /// The full resolution mipmap chain is taken from data when assigned, otherwise it's read from filename each time higher resolution levels are required.
+    class VSG_DECLSPEC StreamedTexture : public Inherit<Object, StreamedTexture>
+    {
+    public:
+        StreamedTexture();
+
+        /// imageInfo holds the mipmap levels from in_residentLevel onwards, in_data, if assigned, provides the full mipmap chain.
+        StreamedTexture(ref_ptr<ImageInfo> in_imageInfo, uint32_t in_residentLevel, ref_ptr<Data> in_data = {});
+
+        /// convenience constructor that creates the imageInfo from the mipmap levels of in_data from in_residentLevel onwards.
+        StreamedTexture(ref_ptr<Sampler> sampler, ref_ptr<Data> in_data, uint32_t in_residentLevel);
+
+        ref_ptr<ImageInfo> imageInfo;
+
+        ref_ptr<Data> data;
+        Path filename;
+        ref_ptr<Options> options;
+
+        /// dimensions and number of mipmap levels of the full resolution texture
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t mipLevels = 1;
+
+        /// first mipmap level of the full resolution texture held by imageInfo, assigned by the TextureStreamer when new levels are merged.
+        std::atomic_uint residentLevel{0};
+
+        /// first mipmap level required by the most recent RecordTraversal.
+        mutable std::atomic_uint requestedLevel{0};
+
+        int compare(const Object& rhs_object) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~StreamedTexture();
+
+        void _computeDimensions();
+    };
+    VSG_type_name(vsg::StreamedTexture);
+
+    /// StreamingStateGroup is a StateGroup whose textures are streamed in and out a mipmap level at a time based on the screen space size of its bound.
+    /// During the RecordTraversal the mipmap level required for each of the textures is computed and, when this differs from the resident level,
+    /// the StreamingStateGroup is passed to the TextureStreamer which loads, compiles and then merges replacement descriptor sets.
+    /// StreamedTexture should not be shared between StreamingStateGroup.
+    class VSG_DECLSPEC StreamingStateGroup : public Inherit<StateGroup, StreamingStateGroup>
+    {
+    public:
+        StreamingStateGroup();
+        StreamingStateGroup(const StreamingStateGroup& rhs, const CopyOp& copyop = {});
+
+        dsphere bound;
+        std::vector<ref_ptr<StreamedTexture>> textures;
+
+        /// TextureStreamer used to update the resident mipmap levels, assigned at runtime via TextureStreamer::assign(..).
+        ref_ptr<TextureStreamer> textureStreamer;
+
+        void addTexture(ref_ptr<StreamedTexture> texture) { textures.push_back(texture); }
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return StreamingStateGroup::create(*this, copyop); }
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~StreamingStateGroup();
+
+    public:
+        // priority value assigned by record traversal as a guide to how important the texture update is.
+        mutable std::atomic<double> priority{0.0};
+
+        enum RequestStatus : unsigned int
+        {
+            NoRequest = 0,
+            StreamRequest = 1,
+            Streaming = 2,
+            MergeRequest = 3
+        };
+
+        mutable std::atomic<RequestStatus> requestStatus{NoRequest};
+    };
+    VSG_type_name(vsg::StreamingStateGroup);
+
+} // namespace vsg
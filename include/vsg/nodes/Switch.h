@@ -48,6 +48,19 @@ namespace vsg
         /// set specified child to be on and all other children off.
         void setSingleChildOn(size_t index);
 
+        /// set the mask of the specified child.
+        void setChildMask(size_t index, Mask mask);
+
+        /// when true traversals only visit the children listed in activeChildren so their cost is proportional to the number of active children rather than the total number of children.
+        /// The Switch methods keep activeChildren up to date, call updateActiveChildren() after modifying children directly.
+        bool indexActiveChildren = false;
+
+        /// indices of the children whose mask isn't MASK_OFF, only maintained when indexActiveChildren is true.
+        std::vector<uint32_t> activeChildren;
+
+        /// rebuild activeChildren from the children's masks.
+        void updateActiveChildren();
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return Switch::create(*this, copyop); }
         int compare(const Object& rhs) const override;
@@ -55,6 +68,16 @@ namespace vsg
         template<class N, class V>
         static void t_traverse(N& node, V& visitor)
         {
+            if (node.indexActiveChildren)
+            {
+                for (auto index : node.activeChildren)
+                {
+                    auto& child = node.children[index];
+                    if ((visitor.traversalMask & (visitor.overrideMask | child.mask)) != MASK_OFF) child.node->accept(visitor);
+                }
+                return;
+            }
+
             for (auto& child : node.children)
             {
                 if ((visitor.traversalMask & (visitor.overrideMask | child.mask)) != MASK_OFF) child.node->accept(visitor);
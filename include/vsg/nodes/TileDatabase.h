@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/app/EllipsoidModel.h>
+#include <vsg/app/TerrainHeightCache.h>
 #include <vsg/io/ReaderWriter.h>
 #include <vsg/nodes/Node.h>
 #include <vsg/state/DescriptorSetLayout.h>
@@ -58,12 +59,34 @@ namespace vsg
 
         uint32_t mipmapLevelsHint = 16;
 
+        /// maximum number of decoded image, detail and elevation tiles kept in the tile ReaderWriter's least recently used cache so that revisited tiles aren't re-read, 0 disables the cache.
+        /// Runtime setting that isn't serialized.
+        uint32_t maxCachedTiles = 0;
+
+        /// maximum number of tile paths that failed to load remembered so that missing tiles in sparse or remote datasets aren't requested again, 0 disables the negative cache.
+        /// Runtime setting that isn't serialized.
+        uint32_t maxMissingTiles = 4096;
+
         /// hint of whether to use flat shaded shaders or with lighting enabled.
         bool lighting = true;
 
         /// optional shaderSet to use for setting up shaders, if left null use vsg::createTileShaderSet().
         ref_ptr<ShaderSet> shaderSet;
 
+        /// when true and an ellipsoidModel is assigned, tiles share a coarse grid of quad patches that are adaptively subdivided and displaced by the elevation data using
+        /// vsg::createTessellatedTerrainShaderSet(), rather than using a vertex per elevation sample. Requires the tessellationShader device feature.
+        bool tessellation = false;
+
+        /// number of patches along each side of a tile when tessellation is enabled.
+        uint32_t tessellationPatchDimension = 8;
+
+        /// target screen space length, in pixels, of the edges generated by tessellation.
+        float tessellationPixelsPerEdge = 16.0f;
+
+        /// optional cache that the heightfields of tiles with elevation data are added to as they are loaded, providing ground height queries without intersecting
+        /// the scene graph. The tile ReaderWriter assigns the projection, and the ellipsoidModel if not already set, of the cache. Runtime setting that isn't serialized.
+        ref_ptr<TerrainHeightCache> terrainHeightCache;
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return TileDatabaseSettings::create(*this, copyop); }
         int compare(const Object& rhs) const override;
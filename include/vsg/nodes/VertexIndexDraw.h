@@ -15,9 +15,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/commands/Command.h>
 #include <vsg/nodes/Node.h>
 #include <vsg/state/BufferInfo.h>
+#include <vsg/utils/CachedBounds.h>
 
 namespace vsg
 {
+    // forward declare
+    class DrawBatch;
 
     /** VertexIndexDraw provides a lightweight way of binding vertex arrays, indices and then issuing a vkCmdDrawIndexed command.
       * Higher performance equivalent to use of individual vsg::BindVertexBuffers, vsg::BindIndexBuffer and vsg::DrawIndexed commands.*/
@@ -42,6 +45,9 @@ namespace vsg
         void assignArrays(const DataList& in_arrays);
         void assignIndices(ref_ptr<Data> in_indices);
 
+        /// local bounds of the vertices cached by ComputeBounds, reset by assignArrays(..) and assignIndices(..)
+        mutable CachedBounds cachedBounds;
+
     public:
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return VertexIndexDraw::create(*this, copyop); }
         int compare(const Object& rhs) const override;
@@ -52,6 +58,9 @@ namespace vsg
         void compile(Context& context) override;
         void record(CommandBuffer& commandBuffer) const override;
 
+        /// add the draw, along with the vertex and index buffers it binds, to drawBatch so it can be coalesced with neighbouring draws.
+        void record(CommandBuffer& commandBuffer, DrawBatch& drawBatch) const;
+
     protected:
         virtual ~VertexIndexDraw();
 
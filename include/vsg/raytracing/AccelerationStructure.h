@@ -35,6 +35,10 @@ namespace vsg
         uint64_t handle() const { return _handle; }
 
         VkDeviceSize requiredScratchSize() const { return _requiredBuildScratchSize; }
+        VkDeviceSize requiredUpdateScratchSize() const { return _requiredUpdateScratchSize; }
+
+        /// size of the acceleration structure's storage, 0 until compiled.
+        VkDeviceSize size() const { return _accelerationStructureInfo.size; }
 
     protected:
         virtual ~AccelerationStructure();
@@ -47,6 +51,7 @@ namespace vsg
         ref_ptr<DeviceMemory> _memory;
         uint64_t _handle = 0;
         VkDeviceSize _requiredBuildScratchSize;
+        VkDeviceSize _requiredUpdateScratchSize = 0;
 
         ref_ptr<Device> _device;
     };
@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/raytracing/AccelerationGeometry.h>
 #include <vsg/raytracing/AccelerationStructure.h>
+#include <vsg/state/QueryPool.h>
 
 namespace vsg
 {
@@ -28,10 +29,38 @@ namespace vsg
 
         AccelerationGeometries geometries;
 
+        /// when true the structure is built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR and its compacted size queried after the build, must be set before compile.
+        bool allowCompaction = false;
+
+        /// replace the acceleration structure with a compacted copy once its build has completed, the copy is added to context.commands and
+        /// the original is released when the context's commands are cleared after completion.
+        /// Returns true if the compacted copy was set up, TopLevelAccelerationStructure referencing this structure then need to be updated.
+        bool compact(Context& context);
+
     protected:
         // compiled data
         std::vector<VkAccelerationStructureGeometryKHR> _vkGeometries;
+        ref_ptr<QueryPool> _compactedSizeQuery;
     };
     VSG_type_name(vsg::BottomLevelAccelerationStructure);
 
+    /// CompactAccelerationStructureCommand copies an acceleration structure into a smaller one using VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR,
+    /// taking ownership of the source structure and its buffer so that they are released when the command is destroyed.
+    class VSG_DECLSPEC CompactAccelerationStructureCommand : public Inherit<Command, CompactAccelerationStructureCommand>
+    {
+    public:
+        CompactAccelerationStructureCommand(Device* device, VkAccelerationStructureKHR source, ref_ptr<Buffer> sourceBuffer, VkAccelerationStructureKHR destination);
+
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~CompactAccelerationStructureCommand();
+
+        ref_ptr<Device> _device;
+        VkAccelerationStructureKHR _source;
+        ref_ptr<Buffer> _sourceBuffer;
+        VkAccelerationStructureKHR _destination;
+    };
+    VSG_type_name(vsg::CompactAccelerationStructureCommand);
+
 } // namespace vsg
@@ -35,6 +35,7 @@ namespace vsg
         explicit BuildAccelerationStructureTraversal(Device* in_device);
 
         void apply(Object& object) override;
+        void apply(Node& node) override;
         void apply(Transform& transform) override;
         void apply(Geometry& geometry) override;
         void apply(VertexIndexDraw& vid) override;
@@ -48,6 +49,7 @@ namespace vsg
         ref_ptr<Device> _device;
 
         MatrixStack _transformStack;
+        std::vector<const Node*> _nodePath;
 
         // cache blas's created for various types of draw node
         std::map<VertexIndexDraw*, ref_ptr<BottomLevelAccelerationStructure>> _vertexIndexDrawBlasMap;
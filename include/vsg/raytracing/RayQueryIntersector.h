@@ -0,0 +1,95 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/raytracing/TopLevelAccelerationStructure.h>
+#include <vsg/state/ComputePipeline.h>
+#include <vsg/state/DescriptorSet.h>
+#include <vsg/utils/MultiLineSegmentIntersector.h>
+#include <vsg/vk/CommandPool.h>
+#include <vsg/vk/Fence.h>
+#include <vsg/vk/Queue.h>
+
+#include <limits>
+
+namespace vsg
+{
+
+    /// RayQueryHit is the std430 layout of the per line segment results written by the RayQueryIntersector compute shader.
+    struct RayQueryHit
+    {
+        float ratio;             // ratio along the line segment of the nearest hit, negative when the line segment missed
+        uint32_t instanceIndex;  // gl_InstanceCustomIndexEXT of the hit, set to GeometryInstance::id by BuildAccelerationStructureTraversal
+        uint32_t primitiveIndex; // index of the triangle within the bottom level acceleration structure geometry
+        uint32_t geometryIndex;  // index of the geometry within the bottom level acceleration structure
+        vec2 barycentrics;       // barycentric coords of the second and third vertices of the triangle
+        uint32_t padding[2];
+    };
+    VSG_array(RayQueryHitArray, RayQueryHit);
+
+    /// RayQueryIntersector computes the intersections of a batch of line segments on the GPU using VK_KHR_ray_query against a
+    /// TopLevelAccelerationStructure built by BuildAccelerationStructureTraversal and compiled, avoiding a CPU traversal of the scene graph.
+    /// The Device must be created with the VK_KHR_ray_query extension and rayQuery feature enabled, and the shaderStage requires
+    /// ShaderCompiler support unless it is replaced by one with precompiled SPIR-V.
+    /// The nearest hit of each line segment is reported, with the GeometryInstance::nodePath used to map the hit back to the scene graph.
+    class VSG_DECLSPEC RayQueryIntersector : public Inherit<Object, RayQueryIntersector>
+    {
+    public:
+        explicit RayQueryIntersector(ref_ptr<TopLevelAccelerationStructure> in_tlas);
+
+        using LineSegment = MultiLineSegmentIntersector::LineSegment;
+        using LineSegments = MultiLineSegmentIntersector::LineSegments;
+        using Intersection = LineSegmentIntersector::Intersection;
+        using Intersections = LineSegmentIntersector::Intersections;
+
+        ref_ptr<TopLevelAccelerationStructure> tlas;
+
+        /// compute shader dispatched for each batch, bindings: 0 the tlas, 1 the line segments, 2 the RayQueryHit results, push constant: uint line segment count.
+        ref_ptr<ShaderStage> shaderStage;
+
+        static constexpr uint32_t workgroupSize = 64;
+
+        /// record and submit the dispatch for lineSegments to the queue, returning without waiting for the results.
+        /// The context provides the Device, DescriptorPools and ShaderCompiler used to set up the compute pipeline on first use.
+        /// Waits for any previously submitted batch to complete before submitting the new one.
+        VkResult submit(Context& context, Queue* queue, const LineSegments& lineSegments);
+
+        /// return true if the submitted batch has completed
+        bool completed() const;
+
+        /// wait for the submitted batch to complete
+        VkResult wait(uint64_t timeout = std::numeric_limits<uint64_t>::max()) const;
+
+        /// wait for the submitted batch to complete and return the intersections of each line segment, in the order they were submitted.
+        std::vector<Intersections> intersections(uint64_t timeout = std::numeric_limits<uint64_t>::max());
+
+    protected:
+        void _compile(Context& context, Queue* queue);
+
+        uint32_t _deviceID = 0;
+        ref_ptr<PipelineLayout> _pipelineLayout;
+        ref_ptr<ComputePipeline> _pipeline;
+        ref_ptr<CommandPool> _commandPool;
+        ref_ptr<CommandBuffer> _commandBuffer;
+        ref_ptr<Fence> _fence;
+
+        // resources of the submitted batch
+        bool _submitted = false;
+        LineSegments _lineSegments;
+        ref_ptr<DescriptorSet> _descriptorSet;
+        ref_ptr<BufferInfo> _hitBufferInfo;
+    };
+    VSG_type_name(vsg::RayQueryIntersector);
+
+} // namespace vsg
@@ -19,6 +19,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 namespace vsg
 {
+    // forward declare
+    class Node;
 
     // VkGeometryInstance encapsulates the VkAccelerationStructureInstanceKHR settings.
     // This structure is required to populate the top level structures instance buffer and is essentially the same as VkAccelerationStructureInstanceKHR
@@ -74,6 +76,9 @@ namespace vsg
         uint32_t shaderOffset;
         uint32_t flags;
         ref_ptr<BottomLevelAccelerationStructure> accelerationStructure;
+
+        /// path from the root of the scene graph to the draw node this instance was created from, used to map ray query results back to the scene graph
+        std::vector<const Node*> nodePath;
     };
     VSG_type_name(vsg::GeometryInstance);
 
@@ -89,10 +94,23 @@ namespace vsg
 
         GeometryInstances geometryInstances;
 
+        /// when true the structure is built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR so update(..) refits it rather than rebuilding it, must be set before compile.
+        bool allowUpdate = false;
+
+        /// copy the geometryInstances that have changed since the last compile/update into the instance buffer and add an update of the structure to context.buildAccelerationStructureCommands.
+        /// The number of geometryInstances must be unchanged since compile, returns the number of instances that changed.
+        uint32_t update(Context& context);
+
+        /// compact the BottomLevelAccelerationStructure referenced by the geometryInstances that were built with allowCompaction and update this structure to reference the compacted copies.
+        /// Call once the builds recorded by compile have completed, then record() the context, returns the number of structures compacted.
+        uint32_t compact(Context& context);
+
     protected:
         // compiled data
         ref_ptr<VkGeometryInstanceArray> _instances;
         ref_ptr<Buffer> _instanceBuffer;
+        ref_ptr<BufferInfo> _instanceBufferInfo;
+        VkAccelerationStructureGeometryKHR _instanceGeometry;
     };
     VSG_type_name(vsg::TopLevelAccelerationStructure);
 
@@ -19,6 +19,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 namespace vsg
 {
+    // forward declare
+    class RingDescriptorBuffer;
 
     /// BindDescriptorSets state command encapsulates vkCmdBindDescriptorSets call and associated settings for multiple DescriptorSets.
     class VSG_DECLSPEC BindDescriptorSets : public Inherit<StateCommand, BindDescriptorSets>
@@ -112,6 +114,19 @@ namespace vsg
         {
         }
 
+        /// convenience BindDescriptorSet constructor for DescriptorSet containing dynamic uniform/storage buffers, such as a DynamicDescriptorBuffer shared between objects,
+        /// with the dynamicOffsets selecting the range used by this BindDescriptorSet. The dynamic offsets of any RingDescriptorBuffer in the DescriptorSet are assigned
+        /// by record(..) so their entries in dynamicOffsets, which are in binding order, are ignored and may be omitted if they are last.
+        BindDescriptorSet(VkPipelineBindPoint in_bindPoint, PipelineLayout* in_pipelineLayout, uint32_t in_firstSet, DescriptorSet* in_descriptorSet, const std::vector<uint32_t>& in_dynamicOffsets) :
+            Inherit(1 + in_firstSet),
+            pipelineBindPoint(in_bindPoint),
+            layout(in_pipelineLayout),
+            firstSet(in_firstSet),
+            descriptorSet(in_descriptorSet),
+            dynamicOffsets(in_dynamicOffsets)
+        {
+        }
+
         /// convenience BindDescriptorSet constructor which creates and assigns the DescriptorSet required for specified descriptors.
         BindDescriptorSet(VkPipelineBindPoint in_bindPoint, PipelineLayout* in_pipelineLayout, uint32_t in_firstSet, const vsg::Descriptors& in_descriptors) :
             Inherit(1 + in_firstSet),
@@ -153,10 +168,15 @@ namespace vsg
     protected:
         virtual ~BindDescriptorSet() {}
 
+        // larger than the maxDescriptorSetUniformBuffersDynamic + maxDescriptorSetStorageBuffersDynamic limits of current devices
+        static constexpr uint32_t maxDynamicOffsets = 64;
+
         struct VulkanData
         {
             VkPipelineLayout _vkPipelineLayout = 0;
             VkDescriptorSet _vkDescriptorSet = VK_NULL_HANDLE;
+            uint32_t _numDynamicOffsets = 0;
+            std::vector<std::pair<uint32_t, const RingDescriptorBuffer*>> _ringDescriptorBuffers; // index into the dynamic offsets of each RingDescriptorBuffer
         };
 
         vk_buffer<VulkanData> _vulkanData;
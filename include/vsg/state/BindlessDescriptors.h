@@ -0,0 +1,105 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/state/DescriptorImage.h>
+
+#include <map>
+#include <mutex>
+
+namespace vsg
+{
+
+    /// BindlessDescriptors is a registry that manages a single global DescriptorSet containing an array of combined image samplers and a storage buffer of materials.
+    /// Shaders index the texture and material arrays via a per draw material index, typically passed as a push constant, so subgraphs no longer need a BindDescriptorSet per material.
+    /// Requires VK_EXT_descriptor_indexing/Vulkan 1.2 with the runtimeDescriptorArray, descriptorBindingPartiallyBound, descriptorBindingUpdateUnusedWhilePending
+    /// and shaderSampledImageArrayNonUniformIndexing features enabled.
+    class VSG_DECLSPEC BindlessDescriptors : public Inherit<Object, BindlessDescriptors>
+    {
+    public:
+        BindlessDescriptors();
+
+        /// materials is an Array of material structs, its size sets the maximum number of materials that can be added.
+        explicit BindlessDescriptors(ref_ptr<Data> in_materials, uint32_t in_maxTextures = 4096, uint32_t in_textureBinding = 0, uint32_t in_materialBinding = 1);
+
+        uint32_t maxTextures = 4096;
+        uint32_t textureBinding = 0;
+        uint32_t materialBinding = 1;
+
+        ref_ptr<Data> materials;
+        ImageInfoList textures;
+
+        ref_ptr<DescriptorSetLayout> descriptorSetLayout;
+        ref_ptr<DescriptorSet> descriptorSet;
+
+        /// add a texture, returning its index in the texture array. Adding an ImageInfo already registered returns its existing index.
+        /// returns maxTextures if the texture array is full.
+        uint32_t addTexture(ref_ptr<ImageInfo> imageInfo);
+        uint32_t addTexture(ref_ptr<Sampler> sampler, ref_ptr<Data> image) { return addTexture(ImageInfo::create(sampler, image)); }
+
+        /// copy material value into the next free material entry and return its index, returns materials->valueCount() if the material array is full.
+        /// material must have the same value size as the materials array.
+        uint32_t addMaterial(const Data* material);
+
+        /// update an existing material entry
+        void setMaterial(uint32_t index, const Data* material);
+
+        uint32_t numTextures() const;
+        uint32_t numMaterials() const;
+
+        /// set up the descriptorSetLayout and descriptorSet, called automatically by the constructor that takes a materials array.
+        void init();
+
+        /// compile the descriptor set and write the descriptors of any textures added since the previous compile.
+        void compile(Context& context);
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~BindlessDescriptors();
+
+        mutable std::mutex _mutex;
+        std::map<const ImageInfo*, uint32_t> _textureIndices;
+        uint32_t _numMaterials = 0;
+        std::vector<uint32_t> _numTexturesAssigned; // indexed by deviceID
+    };
+    VSG_type_name(vsg::BindlessDescriptors);
+
+    /// BindBindlessDescriptorSet binds the DescriptorSet of a BindlessDescriptors registry, compiling any newly added textures when compiled.
+    /// Share a single instance across subgraphs so that the State stacking avoids redundant vkCmdBindDescriptorSets calls.
+    class VSG_DECLSPEC BindBindlessDescriptorSet : public Inherit<BindDescriptorSet, BindBindlessDescriptorSet>
+    {
+    public:
+        BindBindlessDescriptorSet();
+        BindBindlessDescriptorSet(const BindBindlessDescriptorSet& rhs, const CopyOp& copyop = {});
+        BindBindlessDescriptorSet(VkPipelineBindPoint in_bindPoint, PipelineLayout* in_pipelineLayout, uint32_t in_firstSet, BindlessDescriptors* in_bindlessDescriptors);
+
+        ref_ptr<BindlessDescriptors> bindlessDescriptors;
+
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return BindBindlessDescriptorSet::create(*this, copyop); }
+        int compare(const Object& rhs_object) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        void compile(Context& context) override;
+
+    protected:
+        virtual ~BindBindlessDescriptorSet() {}
+    };
+    VSG_type_name(vsg::BindBindlessDescriptorSet);
+
+} // namespace vsg
@@ -49,6 +49,9 @@ namespace vsg
         size_t totalAvailableSize() const;
         size_t totalReservedSize() const;
 
+        /// ratio of the available memory that is not part of the largest available slot.
+        double fragmentation() const;
+
         VkMemoryRequirements getMemoryRequirements(uint32_t deviceID) const;
 
         DeviceMemory* getDeviceMemory(uint32_t deviceID) { return _vulkanData[deviceID].deviceMemory; }
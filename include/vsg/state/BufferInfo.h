@@ -71,6 +71,33 @@ namespace vsg
 
         vk_buffer<ModifiedCount> copiedModifiedCounts;
 
+        /// mark the byte range [rangeOffset, rangeOffset + rangeSize) of data as modified and dirty the data, so that TransferTask copies just the ranges marked since the last copy
+        /// rather than the whole of data. Modifications signalled by calling data->dirty() directly fall back to copying the whole of data.
+        /// Overlapping and adjacent ranges are merged, and when more than maxDirtyRanges remain the closest ranges are merged together.
+        void dirty(VkDeviceSize rangeOffset, VkDeviceSize rangeSize);
+
+        struct DirtyRange
+        {
+            VkDeviceSize begin = 0;
+            VkDeviceSize end = 0;
+        };
+
+        using DirtyRangeList = std::vector<DirtyRange>;
+
+        /// maximum number of disjoint ranges tracked per device before the closest ranges are merged.
+        static constexpr size_t maxDirtyRanges = 8;
+
+        /// return the sorted, disjoint ranges, relative to the start of data, that need to be copied to the buffer for the specified device.
+        DirtyRangeList dirtyRanges(uint32_t deviceID) const;
+
+        struct PendingDirtyRanges
+        {
+            DirtyRangeList ranges;
+            ModifiedCount modifiedCount;
+        };
+
+        vk_buffer<PendingDirtyRanges> pendingDirtyRanges;
+
     protected:
         virtual ~BufferInfo();
     };
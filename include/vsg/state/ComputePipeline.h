@@ -50,9 +50,16 @@ namespace vsg
         struct Implementation : public Inherit<Object, Implementation>
         {
             Implementation(Context& context, Device* device, const PipelineLayout* pipelineLayout, const ShaderStage* shaderStage);
+
+            /// construct without creating the VkPipeline, used when the pipeline is created later via create(..)
+            explicit Implementation(Device* device);
+
             virtual ~Implementation();
 
-            VkPipeline _pipeline;
+            /// create the VkPipeline
+            void create(Context& context, const PipelineLayout* pipelineLayout, const ShaderStage* shaderStage);
+
+            VkPipeline _pipeline = VK_NULL_HANDLE;
             ref_ptr<Device> _device;
         };
 
@@ -82,6 +82,9 @@ namespace vsg
 
             ref_ptr<DescriptorPool> _descriptorPool;
             ref_ptr<DescriptorSetLayout> _descriptorSetLayout;
+
+            /// write the descriptors using the DescriptorSetLayout's VkDescriptorUpdateTemplate, returns false if the writes can't be represented by a template.
+            bool _assignWithTemplate(Context& context, const VkWriteDescriptorSet* descriptorWrites, uint32_t descriptorWriteCount);
         };
 
     protected:
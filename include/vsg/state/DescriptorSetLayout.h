@@ -15,6 +15,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/Device.h>
 #include <vsg/vk/vk_buffer.h>
 
+#include <mutex>
+
 namespace vsg
 {
     // forward declare
@@ -52,6 +54,10 @@ namespace vsg
         // compile the Vulkan object, context parameter used for Device
         virtual void compile(Context& context);
 
+        /// get or create the VkDescriptorUpdateTemplate for writing descriptors laid out as specified by entries, the template is created once per distinct set of entries and reused.
+        /// Returns VK_NULL_HANDLE if descriptor update templates aren't supported by the device, requires Vulkan 1.1 or VK_KHR_descriptor_update_template.
+        VkDescriptorUpdateTemplate getOrCreateUpdateTemplate(uint32_t deviceID, const VkDescriptorUpdateTemplateEntry* entries, uint32_t entryCount);
+
         // remove the local reference to the Vulkan implementation
         void release(uint32_t deviceID) { _implementation[deviceID] = {}; }
         void release() { _implementation.clear(); }
@@ -74,6 +80,15 @@ namespace vsg
 
             ref_ptr<Device> _device;
             VkDescriptorSetLayout _descriptorSetLayout;
+
+            struct UpdateTemplate
+            {
+                std::vector<VkDescriptorUpdateTemplateEntry> entries;
+                VkDescriptorUpdateTemplate updateTemplate = VK_NULL_HANDLE;
+            };
+
+            std::mutex _updateTemplatesMutex;
+            std::vector<UpdateTemplate> _updateTemplates;
         };
 
         vk_buffer<ref_ptr<Implementation>> _implementation;
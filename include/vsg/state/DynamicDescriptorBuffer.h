@@ -0,0 +1,72 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array.h>
+#include <vsg/state/DescriptorBuffer.h>
+
+namespace vsg
+{
+
+    /// DynamicDescriptorBuffer is a DescriptorBuffer for VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC/VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC descriptors
+    /// that packs the data of numObjects objects into a single Data, each object's data placed at a multiple of stride.
+    /// A single DescriptorSet containing the DynamicDescriptorBuffer can be shared by all the objects, with each object's
+    /// BindDescriptorSet::dynamicOffsets set to dynamicOffset(index) to select its data, avoiding a DescriptorSet and buffer allocation per object.
+    class VSG_DECLSPEC DynamicDescriptorBuffer : public Inherit<DescriptorBuffer, DynamicDescriptorBuffer>
+    {
+    public:
+        DynamicDescriptorBuffer();
+        DynamicDescriptorBuffer(const DynamicDescriptorBuffer& rhs, const CopyOp& copyop = {});
+
+        /// allocate the storage for numObjects objects of objectSize bytes, with stride set to objectSize rounded up to a multiple of alignment.
+        /// The default alignment of 256 is the largest minUniformBufferOffsetAlignment/minStorageBufferOffsetAlignment permitted by the Vulkan spec so is valid for all devices,
+        /// when the target device is known a smaller alignment that matches its limits can be passed to reduce memory usage.
+        DynamicDescriptorBuffer(uint32_t in_numObjects, uint32_t in_objectSize, uint32_t dstBinding = 0, VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, uint32_t alignment = 256);
+
+        uint32_t numObjects = 0;
+        uint32_t objectSize = 0;
+        uint32_t stride = 0;
+
+        /// data containing all the objects, assigned to bufferInfoList[0]
+        ref_ptr<ubyteArray> data;
+
+        /// dynamic offset to assign to BindDescriptorSet::dynamicOffsets to select the object at index
+        uint32_t dynamicOffset(uint32_t index) const { return index * stride; }
+
+        /// access the data of the object at index
+        template<typename T>
+        T& at(uint32_t index) { return *reinterpret_cast<T*>(data->data(dynamicOffset(index))); }
+
+        template<typename T>
+        const T& at(uint32_t index) const { return *reinterpret_cast<const T*>(data->data(dynamicOffset(index))); }
+
+        /// copy objectData into the object at index and mark the data as dirty, objectData->dataSize() must not exceed objectSize.
+        void assign(uint32_t index, const Data& objectData);
+
+        void compile(Context& context) override;
+        void assignTo(Context& context, VkWriteDescriptorSet& wds) const override;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return DynamicDescriptorBuffer::create(*this, copyop); }
+        int compare(const Object& rhs_object) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~DynamicDescriptorBuffer();
+    };
+    VSG_type_name(vsg::DynamicDescriptorBuffer)
+
+} // namespace vsg
@@ -0,0 +1,110 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/state/DynamicState.h>
+
+namespace vsg
+{
+
+    /// ExtendedDynamicState holds the pipeline state values that VK_EXT_extended_dynamic_state, 2 and 3 (or Vulkan 1.3) allow to be set
+    /// with vkCmdSet* calls rather than baked into the GraphicsPipeline. Pipelines that only differ in these states can then share one
+    /// GraphicsPipeline with each BindGraphicsPipeline recording its own ExtendedDynamicState after the vkCmdBindPipeline.
+    /// The application is responsible for enabling the device extensions and features required for the states in the mask.
+    class VSG_DECLSPEC ExtendedDynamicState : public Inherit<Object, ExtendedDynamicState>
+    {
+    public:
+        enum StateMask : uint32_t
+        {
+            NO_STATES = 0,
+            // VK_EXT_extended_dynamic_state
+            CULL_MODE = (1 << 0),
+            FRONT_FACE = (1 << 1),
+            PRIMITIVE_TOPOLOGY = (1 << 2),
+            DEPTH_TEST_ENABLE = (1 << 3),
+            DEPTH_WRITE_ENABLE = (1 << 4),
+            DEPTH_COMPARE_OP = (1 << 5),
+            DEPTH_BOUNDS_TEST_ENABLE = (1 << 6),
+            STENCIL_TEST_ENABLE = (1 << 7),
+            // VK_EXT_extended_dynamic_state2
+            RASTERIZER_DISCARD_ENABLE = (1 << 8),
+            DEPTH_BIAS_ENABLE = (1 << 9),
+            PRIMITIVE_RESTART_ENABLE = (1 << 10),
+            // VK_EXT_extended_dynamic_state3
+            POLYGON_MODE = (1 << 11),
+            COLOR_BLEND_ENABLE = (1 << 12),
+            COLOR_WRITE_MASK = (1 << 13),
+
+            EXTENDED_DYNAMIC_STATE_1 = CULL_MODE | FRONT_FACE | PRIMITIVE_TOPOLOGY | DEPTH_TEST_ENABLE | DEPTH_WRITE_ENABLE | DEPTH_COMPARE_OP | DEPTH_BOUNDS_TEST_ENABLE | STENCIL_TEST_ENABLE,
+            EXTENDED_DYNAMIC_STATE_2 = RASTERIZER_DISCARD_ENABLE | DEPTH_BIAS_ENABLE | PRIMITIVE_RESTART_ENABLE,
+            EXTENDED_DYNAMIC_STATE_3 = POLYGON_MODE | COLOR_BLEND_ENABLE | COLOR_WRITE_MASK,
+            ALL_STATES = EXTENDED_DYNAMIC_STATE_1 | EXTENDED_DYNAMIC_STATE_2 | EXTENDED_DYNAMIC_STATE_3
+        };
+
+        explicit ExtendedDynamicState(uint32_t in_mask = NO_STATES);
+        ExtendedDynamicState(const ExtendedDynamicState& eds);
+
+        /// StateMask bits of the states that are dynamic
+        uint32_t mask = NO_STATES;
+
+        // InputAssemblyState values
+        VkPrimitiveTopology primitiveTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        VkBool32 primitiveRestartEnable = VK_FALSE;
+
+        // RasterizationState values
+        VkBool32 rasterizerDiscardEnable = VK_FALSE;
+        VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+        VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+        VkFrontFace frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+        VkBool32 depthBiasEnable = VK_FALSE;
+
+        // DepthStencilState values
+        VkBool32 depthTestEnable = VK_TRUE;
+        VkBool32 depthWriteEnable = VK_TRUE;
+        VkCompareOp depthCompareOp = VK_COMPARE_OP_GREATER;
+        VkBool32 depthBoundsTestEnable = VK_FALSE;
+        VkBool32 stencilTestEnable = VK_FALSE;
+
+        // ColorBlendState values, one entry per color attachment
+        std::vector<VkBool32> colorBlendEnables;
+        std::vector<VkColorComponentFlags> colorWriteMasks;
+
+        /// return the StateMask bits of the states whose vkCmdSet* functions are available on the device.
+        static uint32_t supportedStates(Device* device);
+
+        /// copy the values of the dynamic states from the InputAssemblyState, RasterizationState, DepthStencilState and ColorBlendState in pipelineStates.
+        void set(const GraphicsPipelineStates& pipelineStates);
+
+        /// return a copy of pipelineStates with the dynamic states reset to their defaults, and the VkDynamicState entries added to the DynamicState,
+        /// so that pipelines that only differ in the dynamic states compare as equal.
+        GraphicsPipelineStates normalize(const GraphicsPipelineStates& pipelineStates) const;
+
+        /// return the VkDynamicState entries for the states in the mask.
+        DynamicState::DynamicStates dynamicStates() const;
+
+        /// issue the vkCmdSet* calls for the states in the mask, states whose functions aren't available on the device are skipped.
+        void record(CommandBuffer& commandBuffer) const;
+
+    public:
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~ExtendedDynamicState();
+    };
+    VSG_type_name(vsg::ExtendedDynamicState);
+
+} // namespace vsg
@@ -17,14 +17,17 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/StateCommand.h>
 #include <vsg/vk/RenderPass.h>
 
+#include <atomic>
+
 namespace vsg
 {
     // forward declare
     class Context;
+    class ExtendedDynamicState;
 
     /// Base class for setting up the various pipeline states with the VkGraphicsPipelineCreateInfo
     /// Subclasses are ColorBlendState, DepthStencilState, DynamicState, InputAssemblyState,
-    /// MultisampleState, RasterizationState, TessellationState, VertexInputState and ViewportState.
+    /// MultisampleState, RasterizationState, RenderingState, TessellationState, VertexInputState and ViewportState.
     class VSG_DECLSPEC GraphicsPipelineState : public Inherit<StateCommand, GraphicsPipelineState>
     {
     public:
@@ -66,6 +69,9 @@ namespace vsg
         /// variant of vk(viewID) method that is slower but adds validation of the viewID parameter
         VkPipeline validated_vk(uint32_t viewID) const { return (viewID < _implementation.size()) ? (_implementation[viewID] ? _implementation[viewID]->_pipeline : 0) : 0; }
 
+        /// return true if the Vulkan Pipeline for specified viewID has been created, used to check on pipelines being created asynchronously.
+        bool ready(uint32_t viewID) const { return (viewID < _implementation.size()) && _implementation[viewID] && _implementation[viewID]->_ready.load(std::memory_order_acquire); }
+
         /// VkGraphicsPipelineCreateInfo settings
         ShaderStages stages;
         GraphicsPipelineStates pipelineStates;
@@ -94,10 +100,17 @@ namespace vsg
         {
             Implementation(Context& context, Device* device, const RenderPass* renderPass, const PipelineLayout* pipelineLayout, const ShaderStages& shaderStages, const GraphicsPipelineStates& pipelineStates, uint32_t subpass);
 
+            /// construct without creating the VkPipeline, used when the pipeline is created later via create(..)
+            Implementation(Device* device, const GraphicsPipelineStates& pipelineStates);
+
             virtual ~Implementation();
 
+            /// create the VkPipeline
+            void create(Context& context, const RenderPass* renderPass, const PipelineLayout* pipelineLayout, const ShaderStages& shaderStages, uint32_t subpass);
+
             GraphicsPipelineStates _pipelineStates;
-            VkPipeline _pipeline;
+            VkPipeline _pipeline = VK_NULL_HANDLE;
+            std::atomic_bool _ready{false};
 
             ref_ptr<Device> _device;
         };
@@ -115,6 +128,9 @@ namespace vsg
         /// pipeline to pass in the vkCmdBindPipeline call;
         ref_ptr<GraphicsPipeline> pipeline;
 
+        /// optional extended dynamic state recorded after the vkCmdBindPipeline call, used when the pipeline is created with the equivalent VkDynamicState entries.
+        ref_ptr<ExtendedDynamicState> dynamicState;
+
         int compare(const Object& rhs_object) const override;
 
         void read(Input& input) override;
@@ -125,6 +141,9 @@ namespace vsg
         // compile the Vulkan object, context parameter used for Device
         void compile(Context& context) override;
 
+        /// return true if the pipeline is ready to be bound for specified viewID
+        bool ready(uint32_t viewID) const { return pipeline && pipeline->ready(viewID); }
+
         virtual void release();
 
     public:
@@ -33,6 +33,8 @@ namespace vsg
         /// Vulkan VkImage handle
         VkImage vk(uint32_t deviceID) const { return _vulkanData[deviceID].image; }
 
+        uint32_t sizeVulkanData() const { return _vulkanData.size(); }
+
         /// VkImageCreateInfo settings
         ref_ptr<Data> data;
         VkImageCreateFlags flags = 0;
@@ -69,7 +71,8 @@ namespace vsg
 
         virtual VkResult compile(Device* device);
         virtual VkResult compile(Context& context);
-        virtual VkResult compile(MemoryBufferPools& memoryBufferPools);
+        /// create the VkImage and reserve its memory from the memoryBufferPools with the specified memory priority, see DeviceMemory for details of memory priority.
+        virtual VkResult compile(MemoryBufferPools& memoryBufferPools, float memoryPriority = 0.5f);
 
     protected:
         virtual ~Image();
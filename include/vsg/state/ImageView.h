@@ -17,6 +17,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 namespace vsg
 {
     class Context;
+    class DeviceResourceCache;
 
     extern VSG_DECLSPEC VkImageAspectFlags computeAspectFlagsForFormat(VkFormat format);
 
@@ -50,12 +51,15 @@ namespace vsg
         {
             VkImageView imageView = VK_NULL_HANDLE;
             ref_ptr<Device> device;
+            ref_ptr<Object> shared; // when assigned the imageView is owned by shared, typically a DeviceResourceCache::SharedImageView
 
             ~VulkanData() { release(); }
             void release();
         };
 
         vk_buffer<VulkanData> _vulkanData;
+
+        void _createImageView(VulkanData& vd, const VkImageViewCreateInfo& info, DeviceResourceCache* resourceCache);
     };
     VSG_type_name(vsg::ImageView);
 
@@ -0,0 +1,50 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/state/GraphicsPipeline.h>
+
+namespace vsg
+{
+
+    /// RenderingState encapsulates VkPipelineRenderingCreateInfo settings passed when setting up GraphicsPipeline used with dynamic rendering,
+    /// chained to the VkGraphicsPipelineCreateInfo.pNext in place of the pipeline being created for a specific RenderPass.
+    class VSG_DECLSPEC RenderingState : public Inherit<GraphicsPipelineState, RenderingState>
+    {
+    public:
+        using Formats = std::vector<VkFormat>;
+
+        RenderingState();
+        RenderingState(const RenderingState& rs);
+        RenderingState(const Formats& in_colorAttachmentFormats, VkFormat in_depthAttachmentFormat, VkFormat in_stencilAttachmentFormat = VK_FORMAT_UNDEFINED);
+
+        /// VkPipelineRenderingCreateInfo settings
+        uint32_t viewMask = 0;
+        Formats colorAttachmentFormats;
+        VkFormat depthAttachmentFormat = VK_FORMAT_UNDEFINED;
+        VkFormat stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        void apply(Context& context, VkGraphicsPipelineCreateInfo& pipelineInfo) const override;
+
+    protected:
+        virtual ~RenderingState();
+    };
+    VSG_type_name(vsg::RenderingState);
+
+} // namespace vsg
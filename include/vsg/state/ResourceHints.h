@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/io/Path.h>
 #include <vsg/maths/vec2.h>
 #include <vsg/state/BufferInfo.h>
 #include <vsg/state/ImageInfo.h>
@@ -87,6 +88,25 @@ namespace vsg
         /// Ratio of 1.0 (or greater) will switch off checks for available memory and keep allocating till Vulkan memory allocations fail.
         double allocatedMemoryLimit = 1.0;
 
+        /// Directory to load/save the VkPipelineCache contents from/to, the filename used is keyed to the physical device's vendorID, deviceID, driverVersion and pipelineCacheUUID.
+        /// If empty no PipelineCache file is used.
+        Path pipelineCacheDirectory;
+
+        /// Priority, in the range 0.0 to 1.0, of the device memory allocated for the subgraph, passed to VK_EXT_memory_priority when it is enabled on the Device.
+        /// Lower priorities make the memory the first candidate to be demoted to system memory by the driver when device memory is over subscribed.
+        float memoryPriority = 0.5f;
+
+        /// when true the ResourceHints capture all the resource requirements of the subgraph they are assigned to, as created by CollectResourceRequirements::createSubgraphResourceHints(),
+        /// so CollectResourceRequirements applies them in place of traversing the subgraph. Assign to paged tiles before writing them out to remove the per tile collection cost when they are compiled.
+        bool complete = false;
+
+        /// bin numbers of the DepthSorted and Layer nodes in the subgraph, used when complete is true.
+        std::vector<int32_t> binNumbers;
+
+        /// estimated bytes of CPU and GPU memory held by the subgraph's buffers and images, used when complete is true.
+        uint64_t cpuMemory = 0;
+        uint64_t gpuMemory = 0;
+
     public:
         void read(Input& input) override;
         void write(Output& output) const override;
@@ -0,0 +1,72 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Data.h>
+#include <vsg/state/Buffer.h>
+#include <vsg/state/Descriptor.h>
+
+#include <mutex>
+
+namespace vsg
+{
+
+    /// RingDescriptorBuffer is a Descriptor for VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC/VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC descriptors, for small
+    /// data updated every frame such as per object transforms, that places the data in a persistently mapped host visible and coherent ring buffer with numSlices slices,
+    /// rather than a device local buffer updated by the TransferTask. When the BindDescriptorSet binding it is recorded after the data has been modified, by calling data->dirty(),
+    /// the data is written to the next slice and the BindDescriptorSet's dynamic offset for it selects that slice, so updates need no staging copies or transfer commands.
+    /// The slice written on a frame isn't reused till numSlices modifications later, so numSlices must be at least the number of frames in flight.
+    /// The DescriptorSetLayout binding must use the matching dynamic descriptor type.
+    class VSG_DECLSPEC RingDescriptorBuffer : public Inherit<Descriptor, RingDescriptorBuffer>
+    {
+    public:
+        RingDescriptorBuffer();
+        RingDescriptorBuffer(const RingDescriptorBuffer& rhs, const CopyOp& copyop = {});
+        explicit RingDescriptorBuffer(ref_ptr<Data> in_data, uint32_t in_dstBinding = 0, uint32_t in_numSlices = 3, VkDescriptorType in_descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+
+        /// data copied to the ring buffer, its size must not change after the RingDescriptorBuffer is compiled.
+        ref_ptr<Data> data;
+        uint32_t numSlices = 3;
+
+        /// copy the data to the next slice if it has been modified since the last call, and return the dynamic offset of the slice holding the latest data.
+        /// Called by BindDescriptorSet::record(..).
+        uint32_t dynamicOffset(uint32_t deviceID) const;
+
+        void compile(Context& context) override;
+        void assignTo(Context& context, VkWriteDescriptorSet& wds) const override;
+
+    public:
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return RingDescriptorBuffer::create(*this, copyop); }
+        int compare(const Object& rhs_object) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~RingDescriptorBuffer();
+
+        struct VulkanData
+        {
+            ref_ptr<Buffer> buffer;
+            uint8_t* mappedData = nullptr;
+            uint32_t stride = 0;
+            uint32_t slice = 0;
+            ModifiedCount modifiedCount;
+        };
+
+        mutable std::mutex _mutex;
+        mutable vk_buffer<VulkanData> _vulkanData;
+    };
+    VSG_type_name(vsg::RingDescriptorBuffer)
+
+} // namespace vsg
@@ -65,10 +65,14 @@ namespace vsg
         {
             Implementation(Device* device, const VkSamplerCreateInfo& createSamplerInfo);
 
+            /// use a VkSampler owned by shared, typically a DeviceResourceCache::SharedSampler
+            Implementation(Device* device, VkSampler sampler, ref_ptr<Object> shared);
+
             virtual ~Implementation();
 
             VkSampler _sampler;
             ref_ptr<Device> _device;
+            ref_ptr<Object> _shared;
         };
 
         vk_buffer<ref_ptr<Implementation>> _implementation;
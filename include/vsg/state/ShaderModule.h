@@ -61,6 +61,9 @@ namespace vsg
         ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return ShaderCompileSettings::create(*this, copyop); }
         int compare(const Object& rhs_object) const override;
 
+        /// compare all the settings other than the defines.
+        int compareExcludingDefines(const ShaderCompileSettings& rhs) const;
+
         void read(Input& input) override;
         void write(Output& output) const override;
     };
@@ -14,12 +14,19 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/app/CommandGraph.h>
 #include <vsg/app/RenderGraph.h>
+#include <vsg/commands/BlitImage.h>
 #include <vsg/io/Logger.h>
+#include <vsg/lighting/DepthReduction.h>
 #include <vsg/lighting/Light.h>
+#include <vsg/lighting/LightClustering.h>
+#include <vsg/lighting/ShadowMapBudget.h>
 #include <vsg/nodes/Switch.h>
+#include <vsg/raytracing/TopLevelAccelerationStructure.h>
 #include <vsg/state/BindDescriptorSet.h>
 #include <vsg/state/DescriptorBuffer.h>
 #include <vsg/state/DescriptorImage.h>
+#include <vsg/threading/Latch.h>
+#include <vsg/threading/OperationThreads.h>
 #include <vsg/utils/ShaderSet.h>
 
 namespace vsg
@@ -112,6 +119,8 @@ namespace vsg
         {
             node.descriptorSet->accept(visitor);
             if (node.preRenderCommandGraph) node.preRenderCommandGraph->accept(visitor);
+            if (node.lightClusteringCommandGraph) node.lightClusteringCommandGraph->accept(visitor);
+            if (node.depthReductionCommandGraph) node.depthReductionCommandGraph->accept(visitor);
         }
 
         void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
@@ -128,7 +137,7 @@ namespace vsg
         virtual void update(ResourceRequirements& requirements);
 
         virtual void clear();
-        virtual void bindDescriptorSets(CommandBuffer& commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, uint32_t firstSet);
+        virtual void bindDescriptorSets(CommandBuffer& commandBuffer, VkPipelineBindPoint pipelineBindPoint, const PipelineLayout* layout, uint32_t firstSet);
 
         virtual void compile(Context& context);
 
@@ -144,6 +153,8 @@ namespace vsg
         ref_ptr<BufferInfo> viewportDataBufferInfo;
 
         ref_ptr<Image> shadowDepthImage;
+        ref_ptr<Image> staticShadowDepthImage;
+        ref_ptr<Image> pagedShadowDepthImage;
 
         ref_ptr<DescriptorSetLayout> descriptorSetLayout;
         ref_ptr<DescriptorSet> descriptorSet;
@@ -161,6 +172,65 @@ namespace vsg
 
         virtual ref_ptr<ShadowSettings> getActiveShadowSettings(const Light* light) const;
 
+        /// when true a shadow map whose light space projection and view matrices are unchanged since it was last rendered isn't re-rendered, its previous contents being reused.
+        /// Suitable for static lights viewed from a static viewpoint, call dirtyShadowMaps() when the shadow casting subgraph changes.
+        bool cacheStaticShadowMaps = false;
+
+        /// force all shadow maps to be re-rendered on the next frame.
+        void dirtyShadowMaps();
+
+        /// ratio of the receiver bounds' size that directional light shadow maps extrude their receiver bounds towards the light, so that casters between the light
+        /// and the receivers are rendered while casters that can't cast into the receiver bounds are culled. When non zero spot light shadow maps extrude to the light's position.
+        double shadowCasterExtrusion = 1.0;
+
+        /// when non zero each directional light shadow map is rendered to the square of shadowMapPageSize x shadowMapPageSize texel pages that provides
+        /// shadowMapResolutionScale shadow map texels per screen pixel at the near plane of its receiver bounds, so distant cascades rasterize fewer texels.
+        /// The pages are rendered to pagedShadowDepthImage and blitted up to the shadow map's layer. Requires the default DYNAMIC_VIEWPORTSTATE viewportStateHint,
+        /// and is disabled when staticShadowCasterMask is set or the device doesn't support blitting the shadow map depth format.
+        uint32_t shadowMapPageSize = 0;
+        double shadowMapResolutionScale = 1.0;
+
+        /// when assigned, before the ViewDependentState is initialized, the spot light shadow maps are allocated from its budget, ranked by screen contribution
+        /// each frame, rather than assigned to every shadow casting spot light in turn. Reduced resolution shadow maps are rendered to a corner region of their
+        /// layer, or with fewer pages when shadowMapPageSize is set, so require the default DYNAMIC_VIEWPORTSTATE viewportStateHint.
+        ref_ptr<ShadowMapBudget> shadowMapBudget;
+
+        /// mask of the shadow map views used for the casters rendered every frame.
+        Mask shadowCasterMask = 0x1;
+
+        /// when not MASK_OFF the subgraphs whose mask matches staticShadowCasterMask are rendered to a cached static caster depth layer, only re-rendered when the
+        /// shadow map's light space matrices change, that is copied into the shadow map each frame before the shadowCasterMask matching dynamic casters are rendered on top.
+        /// Static caster subgraphs should have masks that don't match shadowCasterMask, and dynamic caster subgraphs masks that don't match staticShadowCasterMask.
+        /// Must be set before the ViewDependentState is initialized.
+        Mask staticShadowCasterMask = MASK_OFF;
+
+        /// clustered lighting settings, used when the View's features include CLUSTERED_LIGHTING.
+        /// The view frustum is divided into clusterDimensions.x * clusterDimensions.y screen space tiles by clusterDimensions.z exponentially spaced depth slices,
+        /// with point lights and spot lights without shadow maps binned into the clusters on the GPU rather than packed into lightData.
+        /// Requires shaderSet to be a clustered lighting ShaderSet, createPhysicsBasedRenderingClusteredLightingShaderSet() is used when none is assigned.
+        uivec3 clusterDimensions = {16, 9, 24};
+        uint32_t maxLightsPerCluster = 128;
+        uint32_t maxClusteredLights = 4096;
+        double maxClusterDistance = 1e5;
+
+        ref_ptr<LightClustering> lightClustering;
+        ref_ptr<CommandGraph> lightClusteringCommandGraph;
+
+        /// when assigned, before the ViewDependentState is initialized, the directional light shadow map cascades are fitted to the eye space depth range reduced from the
+        /// previous frames' depth buffer rather than the whole view frustum, with the range widened by depthReductionMargin to allow for the latency of the reduction.
+        /// When depthReductionCascadeRatio is greater than 1 the number of cascades is also limited so each covers at least that ratio of far to near distance.
+        ref_ptr<DepthReduction> depthReduction;
+        ref_ptr<CommandGraph> depthReductionCommandGraph;
+        double depthReductionMargin = 0.1;
+        double depthReductionCascadeRatio = 0.0;
+
+        /// top level acceleration structure, in world coordinates, of the shadow casters of the lights with vsg::RayTracedShadows. Must be assigned before the ViewDependentState
+        /// is initialized, and requires shaderSet to be created with createRayTracedShadowsShaderSet(), a ray traced shadows variant of the default ShaderSet is used when none is assigned.
+        ref_ptr<TopLevelAccelerationStructure> shadowAccelerationStructure;
+
+        /// eye to world matrix used to transform the shadow rays into the coordinate frame of the shadowAccelerationStructure, updated each frame.
+        ref_ptr<mat4Value> rayTracedShadowSettings;
+
         // Shadow backend.
         bool compiled = false;
         ref_ptr<CommandGraph> preRenderCommandGraph;
@@ -170,12 +240,47 @@ namespace vsg
         {
             ref_ptr<RenderGraph> renderGraph;
             ref_ptr<View> view;
+
+            // CommandGraph, and the Operation that records it, used to record the shadow map to its own CommandBuffer when RecordTraversal::recordThreads is assigned
+            ref_ptr<CommandGraph> commandGraph;
+            ref_ptr<Operation> recordOperation;
+
+            // projection * view matrix that the shadow map was last rendered with, used by cacheStaticShadowMaps
+            dmat4 renderedProjectionViewMatrix;
+            bool rendered = false;
+
+            // static caster pass used when staticShadowCasterMask is set, staticSwitch toggles the re-rendering of the cached static caster depth
+            ref_ptr<View> staticView;
+            ref_ptr<RenderGraph> staticRenderGraph;
+            ref_ptr<Switch> staticSwitch;
+            dmat4 staticProjectionViewMatrix;
+            bool staticRendered = false;
+
+            // blit of the rendered pages up to the shadow map's layer used when shadowMapPageSize is set, pageCommands holds the barriers and blit
+            ref_ptr<Group> pageCommands;
+            ref_ptr<BlitImage> pageBlit;
+
+            // fraction of the layer's width and height rendered to when assigned a reduced resolution region by the shadowMapBudget
+            double regionScale = 1.0;
+
+            // light the shadow map was last rendered for, with the frame number and projection * view matrix, used by the shadowMapBudget to reuse shadow maps between reduced frequency updates
+            const Light* renderedLight = nullptr;
+            uint64_t renderedFrameCount = 0;
+            dmat4 renderedShadowMapProjView;
         };
 
         mutable std::vector<ShadowMap> shadowMaps;
 
     protected:
         ~ViewDependentState();
+
+        /// record the active shadow maps to their own CommandBuffers, each on one of the RecordTraversal::recordThreads.
+        void recordShadowMapsInParallel(RecordTraversal& rt) const;
+
+        mutable ref_ptr<Latch> _shadowMapsLatch;
+
+        mutable std::vector<ShadowMapBudget::Candidate> _shadowMapCandidates;
+        mutable std::vector<ShadowMapBudget::Allocation> _shadowMapAllocations;
     };
     VSG_type_name(vsg::ViewDependentState);
 
@@ -134,6 +134,39 @@ namespace vsg
     VSG_value(PbrMaterialValue, PbrMaterial);
     VSG_array(PbrMaterialArray, PbrMaterial);
 
+    /// BindlessMaterial struct for passing material settings via the materials storage buffer of a BindlessDescriptors registry.
+    /// Used in conjunction with vsg::createBindlessFlatShadedShaderSet(), diffuseMap is the index into the registry's texture array, -1 for no texture.
+    struct BindlessMaterial
+    {
+        vec4 baseColorFactor{1.0f, 1.0f, 1.0f, 1.0f};
+        int32_t diffuseMap{-1};
+        float alphaMask{1.0f};
+        float alphaMaskCutoff{0.5f};
+        int32_t padding{0};
+
+        void read(vsg::Input& input)
+        {
+            input.read("baseColorFactor", baseColorFactor);
+            input.read("diffuseMap", diffuseMap);
+            input.read("alphaMask", alphaMask);
+            input.read("alphaMaskCutoff", alphaMaskCutoff);
+        }
+
+        void write(vsg::Output& output) const
+        {
+            output.write("baseColorFactor", baseColorFactor);
+            output.write("diffuseMap", diffuseMap);
+            output.write("alphaMask", alphaMask);
+            output.write("alphaMaskCutoff", alphaMaskCutoff);
+        }
+    };
+
+    template<>
+    constexpr bool has_read_write<BindlessMaterial>() { return true; }
+
+    VSG_value(BindlessMaterialValue, BindlessMaterial);
+    VSG_array(BindlessMaterialArray, BindlessMaterial);
+
     /// texCoord[] array indices for each texture type
     struct TexCoordIndices
     {
@@ -40,6 +40,8 @@ namespace vsg
         void setup(TextGroup* textGroup, uint32_t minimumAllocation = 0, ref_ptr<const Options> options = {}) override;
         dbox extents() const override { return textExtents; }
 
+        /// create the rendering subgraph for the quads, or when called again with compatible settings update the existing subgraph in place,
+        /// rewriting and marking for transfer only the range of quads that differ from the previous call.
         virtual ref_ptr<Node> createRenderingSubgraph(ref_ptr<ShaderSet> shaderSet, ref_ptr<Font> font, bool billboard, TextQuads& textQuads, uint32_t minimumAllocation);
 
         // implementation data structure
@@ -57,6 +59,15 @@ namespace vsg
 
         ref_ptr<BindVertexBuffers> bindVertexBuffers;
         ref_ptr<BindIndexBuffer> bindIndexBuffer;
+
+        /// quads of the last layout, compared against by createRenderingSubgraph(..) to find the quads that have changed
+        TextQuads textQuads;
+
+    protected:
+        TextQuads _layoutQuads;
+        ref_ptr<Font> _font;
+        ref_ptr<ShaderSet> _shaderSet;
+        bool _billboard = false;
     };
     VSG_type_name(vsg::CpuLayoutTechnique);
 
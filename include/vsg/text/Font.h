@@ -15,9 +15,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Data.h>
 #include <vsg/io/Options.h>
 #include <vsg/state/ImageInfo.h>
+#include <vsg/text/GlyphGenerator.h>
 #include <vsg/text/GlyphMetrics.h>
+#include <vsg/threading/OperationThreads.h>
 #include <vsg/utils/SharedObjects.h>
 
+#include <mutex>
+
 namespace vsg
 {
     class VSG_DECLSPEC Font : public Inherit<Object, Font>
@@ -47,7 +51,49 @@ namespace vsg
         }
         void createFontImages();
 
+        /// when assigned glyphs are rasterized on demand by requestGlyphs(..) into an atlas that is filled as glyphs are required,
+        /// rather than the font loader populating the whole atlas up front. The loader must still set up the charmap, the glyphMetrics,
+        /// leaving the uvrect of glyphs not yet in the atlas as zero, and allocate the atlas at the size it can grow to.
+        ref_ptr<GlyphGenerator> glyphGenerator;
+
+        /// threads to run glyphGenerator on, when not assigned glyphs are generated on the thread calling requestGlyphs(..)
+        ref_ptr<OperationThreads> operationThreads;
+
+        /// spacing in texels between glyphs added to a dynamic atlas
+        uint32_t atlasPadding = 2;
+
+        /// request the glyphs of the characters in text, return true if they are all available in the atlas.
+        bool requestGlyphs(const Data& text);
+
+        /// request the glyphs at glyphIndices, return true if they are all available in the atlas.
+        bool requestGlyphIndices(const std::vector<uint32_t>& glyphIndices);
+
+        /// generate the glyph at glyphIndex with the glyphGenerator and queue it for mergeGeneratedGlyphs(), used by requestGlyphIndices(..)
+        void generateGlyph(uint32_t glyphIndex);
+
+        /// copy generated glyphs into the atlas and set their uvrect, dirtying the atlas and glyphMetrics so they are transferred to the GPU,
+        /// returns the number of glyphs added. Call from the update thread, Text using CpuLayoutTechnique need setup() again to pick up new glyphs.
+        uint32_t mergeGeneratedGlyphs();
+
     protected:
+        enum GlyphState : uint8_t
+        {
+            GLYPH_NOT_REQUESTED,
+            GLYPH_PENDING,
+            GLYPH_AVAILABLE
+        };
+
+        bool _addToAtlas(uint32_t glyphIndex, const Data* image);
+
+        std::mutex _glyphMutex;
+        std::vector<GlyphState> _glyphStates;
+        std::vector<std::pair<uint32_t, ref_ptr<Data>>> _generatedGlyphs;
+
+        // shelf packing of glyphs into the dynamic atlas
+        uint32_t _packX = 0;
+        uint32_t _packY = 0;
+        uint32_t _rowHeight = 0;
+        bool _atlasFull = false;
     };
     VSG_type_name(vsg::Font);
 
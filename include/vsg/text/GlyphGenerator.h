@@ -0,0 +1,36 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Data.h>
+
+namespace vsg
+{
+
+    /// GlyphGenerator is an interface for rasterizing the signed distance field of individual glyphs on demand,
+    /// implemented by font loaders to enable the dynamic atlas support in Font.
+    class VSG_DECLSPEC GlyphGenerator : public Inherit<Object, GlyphGenerator>
+    {
+    public:
+        /// generate the signed distance field image of the glyph at glyphIndex in the Font::glyphMetrics.
+        /// The image must have the same format as the Font::atlas, cover the quad described by the glyph's metrics and have its first row at the top of the glyph.
+        /// Called from the Font::operationThreads when assigned so implementations must be thread safe.
+        virtual ref_ptr<Data> generate(uint32_t glyphIndex) = 0;
+
+    protected:
+        virtual ~GlyphGenerator() {}
+    };
+    VSG_type_name(vsg::GlyphGenerator);
+
+} // namespace vsg
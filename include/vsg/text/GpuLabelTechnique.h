@@ -0,0 +1,161 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/Camera.h>
+#include <vsg/commands/BindVertexBuffers.h>
+#include <vsg/commands/DrawIndirect.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/ComputePipeline.h>
+#include <vsg/text/StandardLayout.h>
+#include <vsg/text/TextTechnique.h>
+
+namespace vsg
+{
+    /// per label data read by the LabelCulling compute shader and the label vertex shader, matches the std430 layout of the Label struct used by both shaders.
+    struct GpuLabelStruct
+    {
+        vec3 position = vec3(0.0f, 0.0f, 0.0f);
+        float billboardAutoScaleDistance = 0.0f;
+        vec3 horizontal = vec3(1.0f, 0.0f, 0.0f);
+        float padding0 = 0.0f;
+        vec3 vertical = vec3(0.0f, 1.0f, 0.0f);
+        float padding1 = 0.0f;
+        vec4 color = vec4(1.0f, 1.0f, 1.0f, 1.0f);
+        vec4 outlineColor = vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        vec4 bound = vec4(0.0f, 0.0f, 0.0f, 0.0f); // center relative to position and radius of the label's glyphs
+        float outlineWidth = 0.0f;
+        uint32_t firstGlyph = 0;
+        uint32_t glyphCount = 0;
+        uint32_t flags = 0; // combination of GpuLabelTechnique::LabelFlags
+    };
+    VSG_value(GpuLabelValue, GpuLabelStruct);
+
+    /// glyph quad laid out in the horizontal/vertical plane of its label.
+    struct GpuLabelGlyph
+    {
+        vec4 rect;   // left, bottom, right, top
+        vec4 uvrect; // texcoords of the left/bottom and right/top corners
+    };
+    VSG_array(GpuLabelGlyphArray, GpuLabelGlyph);
+
+    /** LabelCulling is a compute stage that frustum and screen size culls the labels of a GpuLabelTechnique, writing the indices of the visible labels
+      * to a compacted per instance vertex array and their count to the instanceCount of a VkDrawIndirectCommand.
+      * LabelCulling is created by GpuLabelTechnique::setup(TextGroup*), and as compute dispatches can't be recorded within a render pass it must be placed in the
+      * CommandGraph ahead of the RenderGraph that renders the TextGroup. It also allocates and transfers the label and glyph buffers so must be compiled before the TextGroup.*/
+    class VSG_DECLSPEC LabelCulling : public Inherit<Command, LabelCulling>
+    {
+    public:
+        LabelCulling();
+
+        /// camera providing the projection and view matrices that the view frustum is computed from.
+        ref_ptr<Camera> camera;
+
+        /// local to world transform of the TextGroup.
+        dmat4 matrix;
+
+        /// cull labels whose screen height ratio falls below minimumScreenHeightRatio, following the LOD::Child::minimumScreenHeightRatio convention. 0.0 disables the screen size test.
+        double minimumScreenHeightRatio = 0.0;
+
+        uint32_t labelCount = 0;
+        uint32_t glyphsPerLabel = 0;
+
+        /// buffers shared with the GpuLabelTechnique, each label has its own slice of the labels and glyphs buffers so updating a label only transfers its slices.
+        ref_ptr<BufferInfo> labels;
+        BufferInfoList labelSlices;
+        ref_ptr<BufferInfo> glyphs;
+        BufferInfoList glyphSlices;
+
+        /// VkDrawIndirectCommand and compacted label indices written by the compute shader.
+        ref_ptr<BufferInfo> drawCommand;
+        ref_ptr<BufferInfo> visibleLabels;
+
+        /// set up the draw command, visible label and compute pipeline, called by GpuLabelTechnique::setup(TextGroup*) once the label buffers have been assigned.
+        void init();
+
+        void compile(Context& context) override;
+        void record(CommandBuffer& commandBuffer) const override;
+
+    protected:
+        virtual ~LabelCulling();
+
+        ref_ptr<PipelineLayout> _pipelineLayout;
+        ref_ptr<BindComputePipeline> _bindComputePipeline;
+        ref_ptr<BindDescriptorSet> _bindDescriptorSet;
+    };
+    VSG_type_name(vsg::LabelCulling);
+
+    /** GpuLabelTechnique renders large TextGroup label sets with GPU culling. Each label is laid out into its own fixed capacity slice of a glyph buffer
+      * and drawn as an instance, the per label position, colours and visibility are read by the vertex shader using the per instance label index written
+      * by the LabelCulling compute stage, so only visible labels are drawn and the CPU never touches individual labels during the frame.
+      * Changing a label's text or layout only requires updateLabel(..) which rewrites that label's slices rather than calling TextGroup::setup() again.
+      * The culling command must be added to the CommandGraph ahead of the RenderGraph, see LabelCulling.*/
+    class VSG_DECLSPEC GpuLabelTechnique : public Inherit<TextTechnique, GpuLabelTechnique>
+    {
+    public:
+        template<class N, class V>
+        static void t_traverse(N& node, V& visitor)
+        {
+            if (node.scenegraph) node.scenegraph->accept(visitor);
+        }
+
+        void traverse(Visitor& visitor) override { t_traverse(*this, visitor); }
+        void traverse(ConstVisitor& visitor) const override { t_traverse(*this, visitor); }
+        void traverse(RecordTraversal& visitor) const override { t_traverse(*this, visitor); }
+
+        enum LabelFlags : uint32_t
+        {
+            LABEL_VISIBLE = 1,
+            LABEL_BILLBOARD = 2
+        };
+
+        /// single Text rendering isn't supported, use GpuLayoutTechnique or CpuLayoutTechnique for individual Text.
+        void setup(Text* text, uint32_t minimumAllocation = 0, ref_ptr<const Options> options = {}) override;
+
+        /// set up the label buffers, culling and rendering subgraph, minimumAllocation sets the minimum number of glyphs reserved for each label.
+        void setup(TextGroup* textGroup, uint32_t minimumAllocation = 0, ref_ptr<const Options> options = {}) override;
+
+        dbox extents() const override { return textExtents; }
+
+        /// lay out the text and layout of the TextGroup's child at index into its slices, labels longer than glyphsPerLabel are truncated.
+        /// The updated slices have their Data dirtied so they are transferred on the next frame.
+        void updateLabel(uint32_t index);
+
+        /// show or hide the label at index.
+        void setLabelVisible(uint32_t index, bool visible);
+        bool getLabelVisible(uint32_t index) const;
+
+        // implementation data structure
+        dbox textExtents;
+        ref_ptr<Node> scenegraph;
+        ref_ptr<LabelCulling> culling;
+
+        uint32_t glyphsPerLabel = 0;
+        std::vector<ref_ptr<GpuLabelValue>> labels;
+        std::vector<ref_ptr<GpuLabelGlyphArray>> labelGlyphs;
+
+    protected:
+        void _layoutLabel(uint32_t index, const Text& text);
+
+        observer_ptr<TextGroup> _textGroup;
+        ref_ptr<StandardLayout> _planarLayout;
+        TextQuads _textQuads;
+    };
+    VSG_type_name(vsg::GpuLabelTechnique);
+
+    /// create a ShaderSet for rendering labels with GpuLabelTechnique, reusing the fragment shader and atlas binding of createTextShaderSet(options).
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createTextLabelShaderSet(ref_ptr<const Options> options = {});
+
+} // namespace vsg
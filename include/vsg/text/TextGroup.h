@@ -22,7 +22,7 @@ namespace vsg
       * positioned by their local TextLayout. TextGroup does not provide view frustum culling or level of detail, but you
       * can add this if required by decorating the TextGroup with a CullNode/LOD and after TextGroup::setup() is called
       * to initialize the rendering component, you can use the TextGroup->technique->extents() value to help set the
-      * CullNode/LOD.bounds value.*/
+      * CullNode/LOD.bounds value. For very large label sets GpuLabelTechnique culls the individual labels on the GPU.*/
     class VSG_DECLSPEC TextGroup : public vsg::Inherit<vsg::Node, TextGroup>
     {
     public:
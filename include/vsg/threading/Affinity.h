@@ -16,6 +16,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <set>
 #include <thread>
+#include <vector>
 
 namespace vsg
 {
@@ -35,6 +36,58 @@ namespace vsg
         operator bool() const { return !cpus.empty(); }
     };
 
+    /// type of core that a logical processor belongs to on hybrid CPUs
+    enum CoreType : uint8_t
+    {
+        CORE_TYPE_UNKNOWN = 0,
+        CORE_TYPE_PERFORMANCE = 1,
+        CORE_TYPE_EFFICIENCY = 2
+    };
+
+    /// LogicalProcessor provides the details of where a cpu id sits within the processor topology.
+    struct LogicalProcessor
+    {
+        uint32_t cpu = 0;
+        uint32_t core = 0;      // physical core within its package, hyper-threads of the same core share the same core id
+        uint32_t package = 0;   // socket
+        uint32_t numaNode = 0;
+        CoreType coreType = CORE_TYPE_UNKNOWN;
+    };
+
+    /// ProcessorTopology describes the packages, NUMA nodes and types of core of the logical processors in the system,
+    /// used to build Affinity that places threads on performance or efficiency cores, or keeps them local to a NUMA node.
+    struct VSG_DECLSPEC ProcessorTopology
+    {
+        std::vector<LogicalProcessor> processors;
+
+        /// return true if the system has both performance and efficiency cores
+        bool hybrid() const;
+
+        uint32_t numNumaNodes() const;
+
+        /// return the NUMA node that the specified cpu belongs to
+        uint32_t numaNodeOf(uint32_t cpu) const;
+
+        /// return Affinity of all the cpus of the specified core type
+        Affinity cpus(CoreType coreType) const;
+
+        /// return Affinity of all the cpus of the specified NUMA node
+        Affinity numaNode(uint32_t node) const;
+    };
+
+    /// return the ProcessorTopology of the system, queried from the OS on first call.
+    /// Under Linux the topology is read from sysfs, under Windows from GetLogicalProcessorInformationEx(..), on other platforms all the cpus are reported as a single NUMA node of unknown core type.
+    extern VSG_DECLSPEC const ProcessorTopology& processorTopology();
+
+    /// return Affinity of the performance cores on hybrid CPUs, or an empty Affinity when all the cores are of the same type.
+    extern VSG_DECLSPEC Affinity performanceCoreAffinity();
+
+    /// return Affinity of the efficiency cores on hybrid CPUs, or an empty Affinity when all the cores are of the same type.
+    extern VSG_DECLSPEC Affinity efficiencyCoreAffinity();
+
+    /// return the NUMA node of the cpu that the current thread is running on, 0 if it can't be determined.
+    extern VSG_DECLSPEC uint32_t currentNumaNode();
+
     /// Set the CPU affinity of specified std::thread
     extern VSG_DECLSPEC void setAffinity(std::thread& thread, const Affinity& affinity);
 
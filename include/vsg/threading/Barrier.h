@@ -13,20 +13,23 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/core/Inherit.h>
-
-#include <condition_variable>
+#include <vsg/threading/HybridWait.h>
 
 namespace vsg
 {
 
     /// Barrier provides a means for synchronizing multiple threads that all release together once specified number of threads joined the Barrier.
+    /// Set spinCount, before the threads join the Barrier, to have waiting threads spin before blocking, see vsg::HybridWait.
     class Barrier : public Inherit<Object, Barrier>
     {
     public:
-        explicit Barrier(uint32_t num_thread) :
+        explicit Barrier(uint32_t num_thread, uint32_t spinCount = 0) :
             _num_threads(num_thread),
             _num_arrived(0),
-            _phase(0) {}
+            _phase(0)
+        {
+            _wait.spinCount = spinCount;
+        }
 
         Barrier(const Barrier&) = delete;
         Barrier& operator=(const Barrier&) = delete;
@@ -34,22 +37,21 @@ namespace vsg
         /// increment the arrived count and release the barrier if count matches number of threads to arrive otherwise wait for the arrived count to match the number of threads to arrive
         void arrive_and_wait()
         {
-            std::unique_lock lock(_mutex);
+            // the phase can't advance till this thread has arrived so read it first
+            auto my_phase = _phase.load();
             if (++_num_arrived == _num_threads)
             {
                 _release();
             }
             else
             {
-                auto my_phase = _phase;
-                _cv.wait(lock, [this, my_phase]() { return this->_phase != my_phase; });
+                _wait.wait([this, my_phase]() { return this->_phase.load() != my_phase; });
             }
         }
 
         /// increment the arrived count and release the barrier if count matches number of threads to arrive, return immediately without waiting for release condition
         void arrive_and_drop()
         {
-            std::unique_lock lock(_mutex);
             if (++_num_arrived == _num_threads)
             {
                 _release();
@@ -61,17 +63,17 @@ namespace vsg
 
         void _release()
         {
+            // reset the count before advancing the phase, as released threads may immediately arrive again
             _num_arrived = 0;
             ++_phase;
-            _cv.notify_all();
+            _wait.notify_all();
         }
 
         const uint32_t _num_threads;
-        uint32_t _num_arrived;
-        uint32_t _phase;
+        std::atomic_uint32_t _num_arrived;
+        std::atomic_uint32_t _phase;
 
-        std::mutex _mutex;
-        std::condition_variable _cv;
+        HybridWait _wait;
     };
     VSG_type_name(vsg::Barrier);
 
@@ -20,21 +20,25 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 namespace vsg
 {
+    class DescriptorPools;
 
     /// Thread safe queue deleting nodes/subgraphs as batches, typically done from a background thread.
+    /// Objects are added as frame tagged batches pushed onto a lock-free multiple producer, single consumer list so that adding
+    /// never blocks on the thread doing the deletion, with each batch released as a whole once its frame has been retired.
     class VSG_DECLSPEC DeleteQueue : public Inherit<Object, DeleteQueue>
     {
     public:
         explicit DeleteQueue(ref_ptr<ActivityStatus> status);
 
-        struct ObjectToDelete
+        /// batch of objects to delete, and SharedObjects to prune once they have been deleted, retired when DeleteQueue::frameCount reaches the batch's frameCount.
+        struct Batch
         {
             uint64_t frameCount = 0;
-            ref_ptr<Object> object;
+            std::vector<ref_ptr<Object>> objects;
+            std::vector<ref_ptr<SharedObjects>> sharedObjectsToPrune;
+            Batch* next = nullptr;
         };
 
-        using ObjectsToDelete = std::list<ObjectToDelete>;
-
         std::atomic_uint64_t frameCount = 0;
         uint64_t retainForFrameCount = 3;
 
@@ -45,84 +49,94 @@ namespace vsg
 
         void add(ref_ptr<Object> object)
         {
-            std::scoped_lock lock(_mutex);
-            _objectsToDelete.push_back(ObjectToDelete{frameCount + retainForFrameCount, object});
-            _cv.notify_one();
+            auto batch = _createBatch();
+            batch->objects.push_back(object);
+            _push(batch);
         }
 
         template<typename T>
         void add(T& objects)
         {
-            std::scoped_lock lock(_mutex);
-
-            // register the Objects to delete
+            auto batch = _createBatch();
+            batch->objects.reserve(objects.size());
             for (auto& object : objects)
             {
-                _objectsToDelete.emplace_back(ObjectToDelete{frameCount + retainForFrameCount, object});
+                batch->objects.emplace_back(object);
             }
-
-            _cv.notify_one();
+            _push(batch);
         }
 
         void prune(ref_ptr<SharedObjects> sharedObjects)
         {
-            std::scoped_lock lock(_mutex);
-
-            // register the SharedObjects to call prune on
-            if (std::find(_sharedObjectsToPrune.begin(), _sharedObjectsToPrune.end(), sharedObjects) == _sharedObjectsToPrune.end())
-            {
-                _sharedObjectsToPrune.push_back(sharedObjects);
-            }
-
-            _cv.notify_one();
+            auto batch = _createBatch();
+            batch->sharedObjectsToPrune.push_back(sharedObjects);
+            _push(batch);
         }
 
         template<typename T>
         void prune(T& sharedObjectsList)
         {
-            std::scoped_lock lock(_mutex);
-
-            // register the Objects to delete
+            auto batch = _createBatch();
             for (auto& sharedObjects : sharedObjectsList)
             {
-                if (std::find(_sharedObjectsToPrune.begin(), _sharedObjectsToPrune.end(), sharedObjects) == _sharedObjectsToPrune.end())
-                    _sharedObjectsToPrune.push_back(sharedObjects);
+                batch->sharedObjectsToPrune.emplace_back(sharedObjects);
             }
-
-            _cv.notify_one();
+            _push(batch);
         }
 
         template<typename T, typename R>
         void add_prune(T& objects, R& sharedObjectsList)
         {
-            std::scoped_lock lock(_mutex);
-
-            // register the Objects to delete
+            auto batch = _createBatch();
+            batch->objects.reserve(objects.size());
             for (auto& object : objects)
             {
-                _objectsToDelete.emplace_back(ObjectToDelete{frameCount + retainForFrameCount, object});
+                batch->objects.emplace_back(object);
             }
-
-            // register the SharedObjects to call prune on
             for (auto& sharedObjects : sharedObjectsList)
             {
-                if (std::find(_sharedObjectsToPrune.begin(), _sharedObjectsToPrune.end(), sharedObjects) == _sharedObjectsToPrune.end())
-                    _sharedObjectsToPrune.push_back(sharedObjects);
+                batch->sharedObjectsToPrune.emplace_back(sharedObjects);
             }
-            _cv.notify_one();
+            _push(batch);
         }
 
+        /// register DescriptorPools to reclaim empty DescriptorPools from after each subsequent batch of objects has been deleted.
+        void reclaim(ref_ptr<DescriptorPools> descriptorPools);
+
+        /// wait for the frameCount to advance, then delete all the batches that have been retired.
         void wait_then_clear();
 
+        /// delete all the batches regardless of whether they have been retired.
         void clear();
 
     protected:
         virtual ~DeleteQueue();
 
+        Batch* _createBatch() const { return new Batch{frameCount.load() + retainForFrameCount, {}, {}, nullptr}; }
+
+        void _push(Batch* batch)
+        {
+            batch->next = _incoming.load(std::memory_order_relaxed);
+            while (!_incoming.compare_exchange_weak(batch->next, batch, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+
+        // move the batches pushed by add()/prune() onto the end of the pending list, must be called with _retireMutex locked
+        void _takeIncoming();
+
+        // delete pending batches with a frameCount up to and including retireFrameCount, must be called with _retireMutex locked
+        size_t _retire(uint64_t retireFrameCount, std::list<ref_ptr<SharedObjects>>& sharedObjectsToPrune);
+
         std::mutex _mutex;
         std::condition_variable _cv;
-        ObjectsToDelete _objectsToDelete;
-        std::list<ref_ptr<SharedObjects>> _sharedObjectsToPrune;
+        std::list<ref_ptr<DescriptorPools>> _descriptorPoolsToReclaim;
+
+        // lock-free list of batches pushed by producer threads, most recent first
+        std::atomic<Batch*> _incoming{nullptr};
+
+        // batches taken from _incoming in the order they were added, only accessed by the thread retiring them
+        std::mutex _retireMutex;
+        Batch* _pendingHead = nullptr;
+        Batch* _pendingTail = nullptr;
 
         ref_ptr<ActivityStatus> _status;
     };
@@ -13,31 +13,37 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/threading/ActivityStatus.h>
+#include <vsg/threading/HybridWait.h>
 #include <vsg/ui/ApplicationEvent.h>
 
-#include <condition_variable>
-
 namespace vsg
 {
 
     /// FrameBlock provides a mechanism for synchronizing threads that are waiting on the start of a new frame.
+    /// Set spinCount, before the waiting threads are started, to have waiting threads spin before blocking, see vsg::HybridWait.
     class FrameBlock : public Inherit<Object, FrameBlock>
     {
     public:
         inline static const ref_ptr<FrameStamp> initial_value = {};
 
-        explicit FrameBlock(ref_ptr<ActivityStatus> status) :
+        explicit FrameBlock(ref_ptr<ActivityStatus> status, uint32_t spinCount = 0) :
             _value(initial_value),
-            _status(status) {}
+            _status(status)
+        {
+            _wait.spinCount = spinCount;
+        }
 
         FrameBlock(const FrameBlock&) = delete;
         FrameBlock& operator=(const FrameBlock&) = delete;
 
         void set(ref_ptr<FrameStamp> frameStamp)
         {
-            std::scoped_lock lock(_mutex);
-            _value = frameStamp;
-            _cv.notify_all();
+            {
+                std::scoped_lock lock(_mutex);
+                _value = frameStamp;
+                _current = frameStamp.get();
+            }
+            _wait.notify_all();
         }
 
         ref_ptr<FrameStamp> get()
@@ -50,19 +56,15 @@ namespace vsg
 
         void wake()
         {
-            std::scoped_lock lock(_mutex);
-            _cv.notify_all();
+            _wait.notify_all();
         }
 
         bool wait_for_change(ref_ptr<FrameStamp>& value)
         {
-            std::unique_lock lock(_mutex);
-            while (_value == value && _status->active())
-            {
-                _cv.wait(lock);
-            }
+            const FrameStamp* previous = value.get();
+            _wait.wait([&]() { return _current.load() != previous || !_status->active(); });
 
-            value = _value;
+            value = get();
             return _status->active();
         }
 
@@ -70,8 +72,9 @@ namespace vsg
         virtual ~FrameBlock() {}
 
         std::mutex _mutex;
-        std::condition_variable _cv;
+        HybridWait _wait;
         ref_ptr<FrameStamp> _value;
+        std::atomic<const FrameStamp*> _current{nullptr};
         ref_ptr<ActivityStatus> _status;
     };
     VSG_type_name(vsg::FrameBlock);
@@ -0,0 +1,126 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#    include <immintrin.h>
+#endif
+
+namespace vsg
+{
+
+    /// hint to the CPU that the calling thread is spinning, reducing the power and the hyperthread resources consumed by a spin loop.
+    inline void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /// HybridWait provides the low latency waiting used by FrameBlock, Barrier and Latch, a waiting thread first spins for up to spinCount iterations
+    /// and then blocks, with std::atomic wait/notify (a futex on Linux) when built with C++20, or a mutex and condition variable otherwise.
+    /// The spin is adaptive, lengthening while spins succeed and shortening while they time out so that waits that will be long don't burn CPU time.
+    /// The state that the wait predicate tests must be std::atomic and be modified before calling notify_all().
+    class HybridWait
+    {
+    public:
+        HybridWait() = default;
+        HybridWait(const HybridWait&) = delete;
+        HybridWait& operator=(const HybridWait&) = delete;
+
+        /// maximum number of iterations to spin before blocking, 0 blocks immediately.
+        uint32_t spinCount = 0;
+
+        /// wait till predicate returns true
+        template<class P>
+        void wait(P predicate)
+        {
+            if (predicate() || _spin(predicate)) return;
+
+#if defined(__cpp_lib_atomic_wait)
+            for (;;)
+            {
+                auto generation = _generation.load();
+                if (predicate()) return;
+                _generation.wait(generation);
+            }
+#else
+            std::unique_lock lock(_mutex);
+            ++_sleepers;
+            _cv.wait(lock, predicate);
+            --_sleepers;
+#endif
+        }
+
+        /// wake all the threads blocked in wait(..)
+        void notify_all()
+        {
+#if defined(__cpp_lib_atomic_wait)
+            ++_generation;
+            _generation.notify_all();
+#else
+            // spinning threads will see the modified state so only take the mutex when threads are blocked
+            if (_sleepers.load() > 0)
+            {
+                std::scoped_lock lock(_mutex);
+                _cv.notify_all();
+            }
+#endif
+        }
+
+    protected:
+        template<class P>
+        bool _spin(P predicate)
+        {
+            if (spinCount == 0) return false;
+
+            // the first wait spins for the full spinCount
+            auto previousLimit = _spinLimit.load(std::memory_order_relaxed);
+            uint32_t limit = (previousLimit == 0) ? spinCount : std::min(std::max(previousLimit, minimumSpinCount), spinCount);
+            for (uint32_t i = 0; i < limit; ++i)
+            {
+                cpu_relax();
+                if (predicate())
+                {
+                    _spinLimit.store(std::min(limit * 2, spinCount), std::memory_order_relaxed);
+                    return true;
+                }
+            }
+
+            _spinLimit.store(limit / 2, std::memory_order_relaxed);
+            return false;
+        }
+
+        static constexpr uint32_t minimumSpinCount = 16;
+        std::atomic_uint32_t _spinLimit{0};
+
+#if defined(__cpp_lib_atomic_wait)
+        std::atomic_uint32_t _generation{0};
+#else
+        std::atomic_uint32_t _sleepers{0};
+        std::mutex _mutex;
+        std::condition_variable _cv;
+#endif
+    };
+
+} // namespace vsg
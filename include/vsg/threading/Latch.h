@@ -13,22 +13,24 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/core/Inherit.h>
-
-#include <condition_variable>
-#include <mutex>
+#include <vsg/threading/HybridWait.h>
 
 namespace vsg
 {
 
     /// Latch provides a means for synchronizing multiple threads that waits for the latch count to be decremented to zero.
+    /// Pass a non zero spinCount to have waiting threads spin before blocking, see vsg::HybridWait.
     class Latch : public Inherit<Object, Latch>
     {
     public:
-        explicit Latch(int num) :
-            _count(num) {}
+        explicit Latch(int num, uint32_t spinCount = 0) :
+            _count(num)
+        {
+            _wait.spinCount = spinCount;
+        }
 
-        explicit Latch(size_t num) :
-            Latch(static_cast<int>(num)) {}
+        explicit Latch(size_t num, uint32_t spinCount = 0) :
+            Latch(static_cast<int>(num), spinCount) {}
 
         void set(int num)
         {
@@ -68,17 +70,12 @@ namespace vsg
 
         void wait()
         {
-            std::unique_lock lock(_mutex);
-            while (_count > 0)
-            {
-                _cv.wait(lock);
-            }
+            _wait.wait([this]() { return _count.load() <= 0; });
         }
 
         virtual void release()
         {
-            std::unique_lock lock(_mutex);
-            _cv.notify_all();
+            _wait.notify_all();
         }
 
         int count() const { return _count.load(); }
@@ -87,8 +84,7 @@ namespace vsg
         virtual ~Latch() {}
 
         std::atomic_int _count;
-        std::mutex _mutex;
-        std::condition_variable _cv;
+        HybridWait _wait;
     };
     VSG_type_name(vsg::Latch)
 
@@ -14,14 +14,56 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/threading/OperationQueue.h>
 
+#include <algorithm>
+#include <deque>
+#include <memory>
 #include <thread>
+#include <vector>
 
 namespace vsg
 {
 
-    /// OperationThreads provides a collection of std::threads that share a single OperationQueue.
-    /// Each thread polls the queue for vsg::Operation to process, when one is available it's removed
-    /// from the queue and its Operation::run() method is called.
+    // forward declare
+    class OperationThreads;
+
+    /// Task is an Operation that is only run once all the Tasks it depends upon have completed.
+    /// Set up the dependencies with dependsOn(..) and then pass the Task to OperationThreads::submit(..), the Task is added
+    /// to the OperationThreads once it has been submitted and all its dependencies have completed.
+    class VSG_DECLSPEC Task : public Inherit<Operation, Task>
+    {
+    public:
+        explicit Task(ref_ptr<Operation> in_operation = {});
+
+        /// operation to run, if not assigned the Task's derived class should override run().
+        ref_ptr<Operation> operation;
+
+        /// latch released once the Task has run.
+        ref_ptr<Latch> completed;
+
+        /// make this Task wait for dependency to complete before it runs, must be called before this Task is submitted.
+        void dependsOn(ref_ptr<Task> dependency);
+
+        void run() override;
+
+    protected:
+        friend class OperationThreads;
+
+        void _submit(OperationThreads* operationThreads);
+        void _release();
+
+        std::mutex _mutex;
+        std::atomic_int _remaining;
+        bool _completed = false;
+        std::vector<ref_ptr<Task>> _dependents;
+        ref_ptr<OperationThreads> _operationThreads;
+    };
+    VSG_type_name(vsg::Task)
+
+    /// OperationThreads provides a work stealing pool of std::threads for running vsg::Operation.
+    /// Operations added from threads other than the OperationThreads' own are added to the shared queue, while operations added by the
+    /// OperationThreads' threads are pushed onto the adding thread's own deque, which it runs last in first out, with idle threads stealing
+    /// from the other end of the other threads' deques. Idle threads spin briefly before sleeping so that bursts of short operations
+    /// aren't delayed by wake up latency.
     class VSG_DECLSPEC OperationThreads : public Inherit<Object, OperationThreads>
     {
     public:
@@ -29,32 +71,106 @@ namespace vsg
         OperationThreads(const OperationThreads&) = delete;
         OperationThreads& operator=(const OperationThreads& rhs) = delete;
 
-        void add(ref_ptr<Operation> operation, InsertionPosition insertionPosition = INSERT_BACK)
-        {
-            queue->add(operation, insertionPosition);
-        }
+        /// add operation to be run, when called from one of this OperationThreads' threads the operation is pushed onto that thread's deque, with INSERT_FRONT making it the first to be stolen.
+        void add(ref_ptr<Operation> operation, InsertionPosition insertionPosition = INSERT_BACK);
 
         template<typename Iterator>
         void add(Iterator begin, Iterator end, InsertionPosition insertionPosition = INSERT_BACK)
         {
-            queue->add(begin, end, insertionPosition);
+            for (auto itr = begin; itr != end; ++itr) add(*itr, insertionPosition);
         }
 
+        /// submit task to be run once all its dependencies have completed.
+        void submit(ref_ptr<Task> task);
+
         /// use this thread to run operations till the queue is empty as well
         /// this thread will consume and run operations in parallel with any threads associated with this OperationThreads.
         void run();
 
+        /// wait for latch to be released, using this thread to run available operations while waiting.
+        void wait(Latch& latch);
+
+        /// call function(chunkBegin, chunkEnd) for chunks of at least grainSize covering the range [begin, end), using this thread along with the OperationThreads,
+        /// returning once all the chunks have completed.
+        template<typename F>
+        void parallel_for(size_t begin, size_t end, size_t grainSize, F function);
+
         /// stop threads
         void stop();
 
         using Threads = std::list<std::thread>;
         Threads threads;
+
+        /// shared queue for operations added from threads other than the OperationThreads' threads, use add(..) rather than adding to the queue directly so idle threads are woken.
         ref_ptr<OperationQueue> queue;
         ref_ptr<ActivityStatus> status;
 
     protected:
         virtual ~OperationThreads();
+
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<ref_ptr<Operation>> operations;
+        };
+
+        void _runThread(size_t index);
+        ref_ptr<Operation> _take(size_t index);
+        size_t _workerIndex() const;
+        void _wake();
+
+        std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
+        std::atomic<int64_t> _pending;
+        std::atomic_uint _sleeping;
+        std::mutex _sleepMutex;
+        std::condition_variable _sleepCondition;
     };
     VSG_type_name(vsg::OperationThreads)
 
+    template<typename F>
+    void OperationThreads::parallel_for(size_t begin, size_t end, size_t grainSize, F function)
+    {
+        if (end <= begin) return;
+
+        size_t count = end - begin;
+        size_t maxChunks = (threads.size() + 1) * 4;
+        size_t numChunks = std::min((count + grainSize - 1) / std::max(grainSize, size_t(1)), maxChunks);
+        if (numChunks <= 1 || threads.empty())
+        {
+            function(begin, end);
+            return;
+        }
+
+        struct ParallelForOperation : public Inherit<Operation, ParallelForOperation>
+        {
+            ParallelForOperation(F* in_function, size_t in_begin, size_t in_end, ref_ptr<Latch> in_latch) :
+                function(in_function),
+                begin(in_begin),
+                end(in_end),
+                latch(in_latch) {}
+
+            F* function;
+            size_t begin;
+            size_t end;
+            ref_ptr<Latch> latch;
+
+            void run() override
+            {
+                (*function)(begin, end);
+                latch->count_down();
+            }
+        };
+
+        // the chunks reference function directly as this method doesn't return until all the chunks have run
+        auto latch = Latch::create(static_cast<int>(numChunks - 1));
+        for (size_t i = 1; i < numChunks; ++i)
+        {
+            add(ParallelForOperation::create(&function, begin + (count * i) / numChunks, begin + (count * (i + 1)) / numChunks, latch));
+        }
+
+        function(begin, begin + count / numChunks);
+
+        wait(*latch);
+    }
+
 } // namespace vsg
@@ -0,0 +1,48 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Object.h>
+
+#include <vector>
+
+namespace vsg
+{
+
+    /// ThreadConfinedScope marks the objects of a subgraph as thread confined for the lifetime of the scope, so that ref_ptr<> copies made while
+    /// operating on the subgraph, such as post processing a newly loaded model before it's merged with the main scene graph, use non atomic
+    /// reference counting. The subgraph must only be accessed by the thread that created the scope, and must not contain objects shared with
+    /// other threads, such as objects held by SharedObjects, until the scope is destroyed.
+    ///
+    /// The scope takes a reference to each object it marks so no marked object is deleted while confined. Objects created during the scope are not
+    /// marked and keep using atomic reference counting. Objects already marked by an enclosing scope are left to that scope.
+    class VSG_DECLSPEC ThreadConfinedScope
+    {
+    public:
+        explicit ThreadConfinedScope(ref_ptr<const Object> object);
+        ThreadConfinedScope(const ThreadConfinedScope&) = delete;
+        ThreadConfinedScope& operator=(const ThreadConfinedScope&) = delete;
+
+        /// restore atomic reference counting for all the marked objects and publish the reference counts to other threads
+        ~ThreadConfinedScope();
+
+        /// number of objects marked by this scope
+        size_t numObjects() const { return _objects.size(); }
+
+    protected:
+        std::vector<ref_ptr<const Object>> _objects;
+    };
+    VSG_type_name(vsg::ThreadConfinedScope);
+
+} // namespace vsg
@@ -131,6 +131,26 @@ namespace vsg
 
         ref_ptr<StateGroup> createStateGroup(const StateInfo& stateInfo = {});
 
+        enum Shape
+        {
+            BOX,
+            CAPSULE,
+            CONE,
+            CYLINDER,
+            DISK,
+            QUAD,
+            SPHERE
+        };
+
+        /// add an instance of shape to the batch of instances for stateInfo that will be created by createInstances().
+        /// Each shape's unit mesh is only created once, the GeometryInfo's position, dx, dy, dz and transform are passed to the shaders as a per instance translation, rotation and scale,
+        /// with non orthogonal dx, dy, dz approximated by the nearest rotation and scale. When GeometryInfo::positions is a vec3Array an instance is added for each position.
+        void addInstance(Shape shape, const GeometryInfo& info = {}, const StateInfo& stateInfo = {});
+
+        /// create a subgraph that renders all the instances added by addInstance(..) since the previous call, with a StateGroup for each StateInfo decorating
+        /// a single Geometry whose vertex, index and instance arrays are shared by all the shapes, drawing each shape's instances with one DrawIndexed.
+        ref_ptr<Node> createInstances();
+
         /// assign compile traversal to enable compilation.
         void assignCompileTraversal(ref_ptr<CompileTraversal> ct);
 
@@ -143,6 +163,8 @@ namespace vsg
         vec3 y_texcoord(const StateInfo& info) const;
 
         ref_ptr<Node> decorateAndCompileIfRequired(const GeometryInfo& info, const StateInfo& stateInfo, ref_ptr<Node> node);
+        ref_ptr<StateGroup> _createStateGroup(const StateInfo& stateInfo, bool instanceTransforms);
+        ref_ptr<Node> _createUnitMesh(Shape shape, const StateInfo& stateInfo);
 
         ref_ptr<ShaderSet> _flatShadedShaderSet;
         ref_ptr<ShaderSet> _phongShaderSet;
@@ -157,6 +179,19 @@ namespace vsg
         GeometryMap _spheres;
         GeometryMap _heightfields;
 
+        struct Instance
+        {
+            vec3 translation;
+            quat rotation;
+            vec3 scale;
+            vec4 color;
+        };
+
+        // used by addInstance(..)/createInstances(), the unit mesh builder returns the undecorated VertexIndexDraw of each shape
+        bool _unitMeshes = false;
+        ref_ptr<Builder> _unitMeshBuilder;
+        std::map<StateInfo, std::map<Shape, std::vector<Instance>>> _instances;
+
         // used for comparisons
         mat4 identity;
     };
@@ -0,0 +1,84 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Data.h>
+#include <vsg/maths/box.h>
+
+#include <mutex>
+
+namespace vsg
+{
+
+    /// CachedBounds holds the local bounds of the vertices of a VertexIndexDraw or Geometry along with the vertex and index Data they were computed from.
+    /// Used by ComputeBounds so that repeated bounds computations of static geometry don't need to revisit every vertex.
+    /// The cached bounds are invalidated when the vertex or index Data is replaced, modified or isn't STATIC_DATA,
+    /// changes to the draw ranges need to be followed by a call to reset().
+    class CachedBounds
+    {
+    public:
+        CachedBounds() = default;
+        CachedBounds(const CachedBounds&) {}
+        CachedBounds& operator=(const CachedBounds&)
+        {
+            reset();
+            return *this;
+        }
+
+        /// get the cached bounds, return false if they weren't computed from the current vertices and indices.
+        bool get(const Data* vertices, const Data* indices, dbox& bounds) const
+        {
+            std::scoped_lock<std::mutex> lock(_mutex);
+            if (!_valid || vertices != _vertices || indices != _indices) return false;
+            if (vertices && vertices->differentModifiedCount(_verticesModifiedCount)) return false;
+            if (indices && indices->differentModifiedCount(_indicesModifiedCount)) return false;
+            bounds = _bounds;
+            return true;
+        }
+
+        /// cache bounds computed from the vertices and indices, return false if the Data isn't STATIC_DATA so can't be cached.
+        bool set(const Data* vertices, const Data* indices, const dbox& bounds)
+        {
+            if (!cacheable(vertices) || !cacheable(indices)) return false;
+
+            std::scoped_lock<std::mutex> lock(_mutex);
+            _vertices = vertices;
+            _indices = indices;
+            if (vertices) vertices->getModifiedCount(_verticesModifiedCount);
+            if (indices) indices->getModifiedCount(_indicesModifiedCount);
+            _bounds = bounds;
+            _valid = true;
+            return true;
+        }
+
+        void reset()
+        {
+            std::scoped_lock<std::mutex> lock(_mutex);
+            _valid = false;
+            _vertices = nullptr;
+            _indices = nullptr;
+        }
+
+        static bool cacheable(const Data* data) { return !data || data->properties.dataVariance == STATIC_DATA; }
+
+    protected:
+        mutable std::mutex _mutex;
+        bool _valid = false;
+        const Data* _vertices = nullptr;
+        const Data* _indices = nullptr;
+        ModifiedCount _verticesModifiedCount;
+        ModifiedCount _indicesModifiedCount;
+        dbox _bounds;
+    };
+
+} // namespace vsg
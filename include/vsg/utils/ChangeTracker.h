@@ -0,0 +1,96 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Data.h>
+#include <vsg/core/observer_ptr.h>
+#include <vsg/maths/box.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/nodes/MatrixTransform.h>
+
+namespace vsg
+{
+
+    /// ChangeRecord is attached to a tracked Object via its Auxiliary, recording the parents that changes are propagated up to and the cached results that the changes invalidate.
+    class VSG_DECLSPEC ChangeRecord : public Inherit<Object, ChangeRecord>
+    {
+    public:
+        std::vector<observer_ptr<Object>> parents;
+
+        /// true when the object, or an object in its subgraph, has changed since the last ChangeTracker::clear().
+        bool changed = false;
+
+        /// local bounds of the node's subgraph, cached by ComputeBounds when useChangeRecords is enabled and invalidated by changes.
+        bool boundsValid = false;
+        dbox bounds;
+
+        void addParent(Object* parent);
+        void removeParent(const Object* parent);
+    };
+    VSG_type_name(vsg::ChangeRecord);
+
+    /// ChangeTracker provides opt-in incremental change tracking of a scene graph.
+    /// Tracked nodes, and the vertex and index Data they draw, are assigned a ChangeRecord that records their parents so that modifications made via the ChangeTracker,
+    /// or picked up from Data modified counts by update(), mark the changed objects and all their ancestors as changed. Consumers can then skip unchanged subgraphs,
+    /// ComputeBounds reuses the cached bounds of unchanged subgraphs when useChangeRecords is enabled, and only the added subgraphs need to be compiled.
+    /// Changes to state that alter how a subgraph is interpreted, such as the vertex bindings of an ancestor StateGroup, need the subgraph to be explicitly marked as changed.
+    /// ChangeTracker isn't thread safe, updates should be made from the update phase of the frame.
+    class VSG_DECLSPEC ChangeTracker : public Inherit<Object, ChangeTracker>
+    {
+    public:
+        ChangeTracker();
+
+        /// return the ChangeRecord attached to object, or nullptr if object isn't tracked.
+        static ChangeRecord* getRecord(const Object* object);
+
+        /// return true if object, or an object in its subgraph, has changed since the last clear(). Untracked objects are treated as changed.
+        static bool hasChanged(const Object* object);
+
+        /// attach ChangeRecords to root and the nodes and Data in its subgraph, subgraphs that are already tracked aren't traversed again.
+        void track(ref_ptr<Node> root);
+
+        /// add child to parent, tracking the child's subgraph and marking parent and its ancestors as changed.
+        void addChild(ref_ptr<Group> parent, ref_ptr<Node> child);
+
+        /// remove child from parent and mark parent and its ancestors as changed, return false if child isn't one of parent's children.
+        bool removeChild(ref_ptr<Group> parent, ref_ptr<Node> child);
+
+        /// assign matrix to transform and mark transform and its ancestors as changed.
+        void setMatrix(ref_ptr<MatrixTransform> transform, const dmat4& matrix);
+
+        /// mark object and all its tracked ancestors as changed.
+        void changed(const Object* object);
+
+        /// check the tracked Data for modifications since the last update(), marking the Data and the nodes that use them as changed, return the number of modified Data.
+        size_t update();
+
+        /// subgraphs added via addChild(..) since the last clear(), pass these to CompileManager::compile(..) rather than compiling the whole scene graph.
+        std::vector<ref_ptr<Node>> added;
+
+        /// reset the changed flags and the list of added subgraphs, call once all the consumers have handled the changes.
+        void clear();
+
+    protected:
+        struct TrackedData
+        {
+            observer_ptr<Data> data;
+            ModifiedCount modifiedCount;
+        };
+
+        std::vector<TrackedData> _trackedData;
+        std::vector<observer_ptr<Object>> _changed;
+    };
+    VSG_type_name(vsg::ChangeTracker);
+
+} // namespace vsg
@@ -0,0 +1,120 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/ConstVisitor.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/state/BufferInfo.h>
+#include <vsg/state/ImageInfo.h>
+
+#include <array>
+#include <map>
+#include <set>
+
+namespace vsg
+{
+    // forward declare
+    class AccelerationStructure;
+
+    /// MemoryUsage holds the number and bytes of GPU resources by category.
+    struct VSG_DECLSPEC MemoryUsage
+    {
+        enum Category
+        {
+            IMAGE,
+            VERTEX_BUFFER,
+            INDEX_BUFFER,
+            UNIFORM_BUFFER,
+            STORAGE_BUFFER,
+            ACCELERATION_STRUCTURE,
+            OTHER_BUFFER,
+            CATEGORY_COUNT
+        };
+
+        std::array<uint32_t, CATEGORY_COUNT> counts = {};
+        std::array<VkDeviceSize, CATEGORY_COUNT> bytes = {};
+
+        void add(Category category, VkDeviceSize size)
+        {
+            ++counts[category];
+            bytes[category] += size;
+        }
+
+        void add(const MemoryUsage& rhs)
+        {
+            for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+            {
+                counts[i] += rhs.counts[i];
+                bytes[i] += rhs.bytes[i];
+            }
+        }
+
+        VkDeviceSize totalBytes() const;
+
+        static const char* categoryName(Category category);
+    };
+    VSG_type_name(vsg::MemoryUsage);
+
+    /// CollectMemoryUsage is a visitor that totals the GPU memory used by the compiled Image, BufferInfo and AccelerationStructure of a scene graph.
+    /// Usage is categorised by how each resource is used and attributed to the nearest CommandGraph or PagedLOD above where it's first encountered,
+    /// so shared resources are only counted once. Resources that haven't been compiled for deviceID aren't counted.
+    class VSG_DECLSPEC CollectMemoryUsage : public Inherit<ConstVisitor, CollectMemoryUsage>
+    {
+    public:
+        explicit CollectMemoryUsage(uint32_t in_deviceID = 0);
+
+        uint32_t deviceID = 0;
+
+        /// usage of all the resources found
+        MemoryUsage total;
+
+        /// usage attributed to each CommandGraph/PagedLOD, resources outside any CommandGraph or PagedLOD are attributed to nullptr
+        std::map<const Object*, MemoryUsage> owners;
+
+        /// write total, owners and, if device is assigned, the device's DeviceMemory allocations and memory heap budgets to out.
+        void report(std::ostream& out, const Device* device = nullptr) const;
+
+        void clear();
+
+        using ConstVisitor::apply;
+
+        void apply(const Object& object) override;
+        void apply(const PagedLOD& plod) override;
+        void apply(const CommandGraph& commandGraph) override;
+        void apply(const DescriptorSet& descriptorSet) override;
+        void apply(const Descriptor& descriptor) override;
+        void apply(const DescriptorBuffer& descriptorBuffer) override;
+        void apply(const DescriptorImage& descriptorImage) override;
+        void apply(const Geometry& geometry) override;
+        void apply(const VertexDraw& vd) override;
+        void apply(const VertexIndexDraw& vid) override;
+        void apply(const BindVertexBuffers& bvb) override;
+        void apply(const BindIndexBuffer& bib) override;
+        void apply(const InstanceNode& in) override;
+        void apply(const InstanceDraw& id) override;
+        void apply(const InstanceDrawIndexed& idi) override;
+
+        virtual void apply(const BufferInfo* bufferInfo, MemoryUsage::Category category);
+        virtual void apply(const ImageInfo* imageInfo);
+        virtual void apply(const AccelerationStructure* accelerationStructure);
+
+    protected:
+        void add(const Object* resource, MemoryUsage::Category category, VkDeviceSize size);
+        void traverseOwner(const Object& owner);
+
+        std::vector<const Object*> _ownerStack;
+        std::set<const Object*> _visited;
+    };
+    VSG_type_name(vsg::CollectMemoryUsage);
+
+} // namespace vsg
@@ -0,0 +1,124 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/nodes/InstanceNode.h>
+#include <vsg/state/GraphicsPipeline.h>
+
+#include <list>
+#include <set>
+
+namespace vsg
+{
+
+    /// CompactInstanceArrays reduces the memory and bandwidth of the per instance arrays of InstanceNode by converting them to compact formats:
+    ///   translations (location 7) to VK_FORMAT_R16G16B16A16_SFLOAT half floats relative to the center of their bounds, or when quantizeTranslations is set to VK_FORMAT_R16G16B16A16_SNORM
+    ///   values normalized to their bounds with the scales divided by the bound's half extent, the InstanceNode is placed under a MatrixTransform that maps them back to the original positions,
+    ///   rotations (location 8) to VK_FORMAT_R32_UINT smallest three packed quaternions, when the vertex shader supports the VSG_INSTANCE_ROTATION_PACKED define,
+    ///   scales (location 9) that are uniform in x, y and z to a VK_FORMAT_R32_SFLOAT scale, when the vertex shader supports the VSG_INSTANCE_UNIFORM_SCALE define,
+    ///   colors (location 6) to VK_FORMAT_R8G8B8A8_UNORM.
+    /// The flat, phong and pbr ShaderSet support the defines, enable the vsg_RotationPacked and vsg_UniformScale attributes when setting up a GraphicsPipelineConfigurator directly.
+    /// The GraphicsPipeline bound by the StateGroups above and within the InstanceNode subgraphs have their VertexInputState updated and vertex shader replaced to match,
+    /// so each kind of array is only converted when all the InstanceNode and GraphicsPipeline found can use it. Arrays that are dynamic or not of the expected type are left unchanged.
+    /// Must be applied before the scene graph is compiled.
+    class VSG_DECLSPEC CompactInstanceArrays : public Inherit<Visitor, CompactInstanceArrays>
+    {
+    public:
+        CompactInstanceArrays();
+
+        /// convert translations to half floats relative to the center of the translations
+        bool halfFloatTranslations = true;
+
+        /// convert translations to 16 bit snorm values in place of half floats, requires the InstanceNode to have scales
+        bool quantizeTranslations = false;
+
+        /// convert rotations to smallest three packed quaternions
+        bool packRotations = true;
+
+        /// convert scales that are uniform in x, y and z to a single float
+        bool uniformScales = true;
+
+        /// convert colors to 8 bit unorm values
+        bool packColors = true;
+
+        // statistics of the changes made
+        uint32_t numArraysConverted = 0;
+        uint32_t numPipelinesUpdated = 0;
+        uint64_t numBytesBefore = 0;
+        uint64_t numBytesAfter = 0;
+
+        /// convert the InstanceNode arrays in the subgraph, node itself is never replaced.
+        void compact(Node& node);
+
+        /// write out the statistics of the changes made
+        void report(LogOutput& output) const;
+
+        /// convert translations to half floats relative to origin
+        static ref_ptr<usvec4Array> halfFloatTranslationArray(const vec3Array& translations, const dvec3& origin);
+
+        /// convert translations to 16 bit snorm values relative to center, normalized by halfExtent
+        static ref_ptr<svec4Array> quantizeTranslationArray(const vec3Array& translations, const dvec3& center, double halfExtent);
+
+        /// convert unit quaternions to smallest three packed values
+        static ref_ptr<uintArray> packRotationArray(const quatArray& rotations);
+        static ref_ptr<uintArray> packRotationArray(const vec4Array& rotations);
+
+        /// convert uniform scales to a single float per instance, multiplied by multiplier
+        static ref_ptr<floatArray> uniformScaleArray(const vec3Array& scales, float multiplier = 1.0f);
+
+        /// convert colors to 8 bit unorm values
+        static ref_ptr<ubvec4Array> packColorArray(const vec3Array& colors);
+        static ref_ptr<ubvec4Array> packColorArray(const vec4Array& colors);
+
+        /// decode the translation of an instance from vec3Array, half float usvec4Array or snorm svec4Array translations, return false if not supported.
+        /// Values decoded from the compact formats are relative to any dequantizing MatrixTransform above the InstanceNode.
+        static bool decodeTranslation(const Data* translations, uint32_t index, vec3& translation);
+
+        /// decode the rotation of an instance from quatArray, vec4Array or packed uintArray rotations, return false if not supported.
+        static bool decodeRotation(const Data* rotations, uint32_t index, quat& rotation);
+
+        /// decode the scale of an instance from vec3Array or uniform floatArray scales, return false if not supported.
+        static bool decodeScale(const Data* scales, uint32_t index, vec3& scale);
+
+        void apply(Node& node) override;
+        void apply(Group& group) override;
+        void apply(StateGroup& stateGroup) override;
+        void apply(InstanceNode& instanceNode) override;
+
+    protected:
+        virtual ~CompactInstanceArrays();
+
+        struct Instances
+        {
+            InstanceNode* node = nullptr;
+            Group* parent = nullptr;
+            size_t childIndex = 0;
+            std::vector<GraphicsPipeline*> pipelines;
+        };
+
+        void _convert();
+
+        Group* _parent = nullptr;
+        size_t _childIndex = 0;
+        Instances* _currentInstances = nullptr;
+        std::vector<GraphicsPipeline*> _pipelineStack;
+        std::list<Instances> _instances;
+        std::set<const Node*> _visited;
+    };
+    VSG_type_name(vsg::CompactInstanceArrays);
+
+} // namespace vsg
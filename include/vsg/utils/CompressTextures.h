@@ -0,0 +1,63 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Data.h>
+#include <vsg/core/Inherit.h>
+
+namespace vsg
+{
+    // forward declare
+    class PhysicalDevice;
+
+    /// CompressTextures converts 8 bit per component R, RG, RGB and RGBA 2D images into the block compressed formats supported by the GPU,
+    /// generating the mipmap chain on the CPU as block compressed images can't have their mipmaps generated on the GPU.
+    /// Opaque RGB(A) images are compressed to BC1 or ETC2 RGB, RGBA images with alpha to BC3 or ETC2 RGBA, R images to BC4 or EAC R11 and RG images to BC5 or EAC RG11.
+    /// BC formats are preferred when both BC and ETC2 are supported. The corresponding textureCompressionBC/textureCompressionETC2 feature must be enabled on the Device.
+    /// Can be used directly, or assigned to Options::compressTextures so vsg::read(..) applies it to the textures of the subgraphs loaded.
+    class VSG_DECLSPEC CompressTextures : public Inherit<Object, CompressTextures>
+    {
+    public:
+        CompressTextures();
+
+        /// set the supported formats from the texture compression features of the PhysicalDevice.
+        explicit CompressTextures(const PhysicalDevice* physicalDevice);
+
+        /// enable compression to BC1, BC3, BC4 and BC5 formats, typically supported by desktop GPUs.
+        bool supportsBC = true;
+
+        /// enable compression to ETC2 and EAC formats, typically supported by mobile GPUs.
+        bool supportsETC2 = false;
+
+        /// images with a width or height smaller than minimumDimension are left uncompressed.
+        uint32_t minimumDimension = 16;
+
+        /// return the block compressed format that image would be compressed to, or VK_FORMAT_UNDEFINED if it can't be compressed.
+        VkFormat selectFormat(const Data& image) const;
+
+        /// return a block compressed version of image containing mipLevels mipmap levels generated from it, or null if image can't be compressed.
+        ref_ptr<Data> compress(const Data& image, uint32_t mipLevels = 1) const;
+
+        /// replace the images of the DescriptorImage in the object's subgraph with compressed versions, with mipmaps generated for those whose Sampler requires them.
+        void apply(Object& object) const;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~CompressTextures();
+    };
+    VSG_type_name(vsg::CompressTextures);
+
+} // namespace vsg
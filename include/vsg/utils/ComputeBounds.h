@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/maths/box.h>
 #include <vsg/state/ArrayState.h>
+#include <vsg/threading/OperationThreads.h>
 
 namespace vsg
 {
@@ -31,6 +32,21 @@ namespace vsg
         /// Using the bounding volumes is faster but may result in less tight bounds around the geometry in the scene.
         bool useNodeBounds = true;
 
+        /// Cache the local bounds of VertexIndexDraw/Geometry with STATIC_DATA vertices and indices so repeated traversals are O(nodes) rather than O(vertices).
+        /// Cached bounds are only used with the default ArrayState, and when the current matrix contains rotations only when useNodeBounds is true
+        /// as the transformed box then encloses the geometry less tightly. Subclasses that override applyDraw(..)/applyDrawIndexed(..) should disable it.
+        bool useCachedBounds = true;
+
+        /// Cache the local bounds of the subgraphs of nodes tracked by a ChangeTracker in their ChangeRecord, reusing them until the ChangeTracker marks the subgraph as changed.
+        /// Subject to the same ArrayState and matrix restrictions as useCachedBounds.
+        bool useChangeRecords = false;
+
+        /// OperationThreads used to split the vertices of large draws into ranges that are bounded in parallel, when not assigned all vertices are processed on the calling thread.
+        ref_ptr<OperationThreads> operationThreads;
+
+        /// minimum number of vertices/indices in a draw before it's split across the operationThreads.
+        uint32_t parallelThreshold = 65536;
+
         using ArrayStateStack = std::vector<ref_ptr<ArrayState>>;
         ArrayStateStack arrayStateStack;
 
@@ -49,6 +65,8 @@ namespace vsg
         void apply(const MatrixTransform& transform) override;
         void apply(const CullNode& cullNode) override;
         void apply(const CullGroup& cullGroup) override;
+        void apply(const PackedSubgraph& packedSubgraph) override;
+        void apply(const PackedDraws& packedDraws) override;
         void apply(const LOD& lod) override;
         void apply(const PagedLOD& plod) override;
         void apply(const Geometry& geometry) override;
@@ -75,6 +93,11 @@ namespace vsg
 
         void add(const dbox& bb);
         void add(const dsphere& bs);
+
+    protected:
+        bool _useCachedBounds() const;
+
+        ConstVisitorDispatcher _dispatcher;
     };
     VSG_type_name(vsg::ComputeBounds);
 
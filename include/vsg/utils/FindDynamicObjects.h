@@ -24,6 +24,8 @@ namespace vsg
     class VSG_DECLSPEC FindDynamicObjects : public Inherit<ConstVisitor, FindDynamicObjects>
     {
     public:
+        FindDynamicObjects();
+
         std::mutex mutex;
         std::set<const Object*> dynamicObjects;
 
@@ -57,6 +59,8 @@ namespace vsg
         void apply(const VertexDraw& vd) override;
         void apply(const VertexIndexDraw& vid) override;
         void apply(const Geometry& geom) override;
+
+        ConstVisitorDispatcher _dispatcher;
     };
     VSG_type_name(FindDynamicObjects);
 
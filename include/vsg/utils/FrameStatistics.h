@@ -0,0 +1,112 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Inherit.h>
+
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace vsg
+{
+
+    /// FrameStatistics aggregates counters, gauges and histograms per frame over a sliding window of frames,
+    /// providing min/max/mean and p50/p95/p99 summaries that are passed to exporters at regular intervals.
+    /// Assign to Profiler::statistics to collect frame, record and GPU times along with the values passed to Instrumentation::plot(..).
+    /// All methods are thread safe.
+    class VSG_DECLSPEC FrameStatistics : public Inherit<Object, FrameStatistics>
+    {
+    public:
+        explicit FrameStatistics(uint32_t in_windowSize = 300);
+
+        enum Type
+        {
+            COUNTER,  // amounts added during a frame are summed, the window holds the per frame totals
+            GAUGE,    // last value set during a frame, the window holds the per frame values
+            HISTOGRAM // every value sampled is added to the window
+        };
+
+        struct Summary
+        {
+            std::string name;
+            Type type = GAUGE;
+            double total = 0.0; // total of all counter increments, or last value of a gauge or histogram
+            size_t count = 0;   // number of values in the window
+            double min = 0.0;
+            double max = 0.0;
+            double mean = 0.0;
+            double p50 = 0.0;
+            double p95 = 0.0;
+            double p99 = 0.0;
+        };
+
+        using Summaries = std::vector<Summary>;
+        using Exporter = std::function<void(uint64_t frameCount, const Summaries& summaries)>;
+
+        /// maximum number of values held for each metric
+        const uint32_t windowSize;
+
+        /// number of frames between calls to the exporters, 0 disables exporting
+        uint32_t exportInterval = 60;
+
+        /// exporters called from advanceFrame(..) with the summaries of all the metrics
+        std::vector<Exporter> exporters;
+
+        /// add amount to the counter for the current frame
+        void increment(const std::string& name, double amount = 1.0);
+
+        /// set the value of the gauge for the current frame
+        void set(const std::string& name, double value);
+
+        /// add a value to the histogram
+        void sample(const std::string& name, double value);
+
+        /// complete the current frame, pushing counters and gauges into their windows and calling the exporters when an export is due.
+        void advanceFrame(uint64_t frameCount);
+
+        /// compute the summaries of all the metrics
+        Summaries summaries() const;
+
+        /// compute the summary of the named metric, returns false if no such metric exists
+        bool summary(const std::string& name, Summary& result) const;
+
+        /// remove all metrics
+        void clear();
+
+        /// write summaries as a single line JSON object, suitable for use as an Exporter writing to a log file or pipe for further processing.
+        static void writeJSON(std::ostream& out, uint64_t frameCount, const Summaries& summaries);
+
+    protected:
+        struct Metric
+        {
+            Type type = GAUGE;
+            double current = 0.0;
+            double total = 0.0;
+            bool updated = false;
+            std::vector<double> window;
+            size_t next = 0;
+        };
+
+        void _push(Metric& metric, double value);
+        void _summarize(const std::string& name, const Metric& metric, Summary& result) const;
+
+        mutable std::mutex _mutex;
+        std::map<std::string, Metric> _metrics;
+        uint64_t _lastExportFrameCount = 0;
+    };
+    VSG_type_name(vsg::FrameStatistics);
+
+} // namespace vsg
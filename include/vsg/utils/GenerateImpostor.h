@@ -0,0 +1,79 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Array2D.h>
+#include <vsg/maths/sphere.h>
+#include <vsg/nodes/Node.h>
+#include <vsg/utils/ShaderSet.h>
+#include <vsg/utils/SharedObjects.h>
+#include <vsg/vk/Device.h>
+
+namespace vsg
+{
+
+    /// create a ShaderSet for drawing the camera facing quads of the octahedral impostors created by vsg::GenerateImpostor
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createImpostorShaderSet(ref_ptr<const Options> options = {});
+
+    /// GenerateImpostor renders a subgraph from a grid of directions spread over an octahedron into an impostor atlas, and creates an LOD that switches from the subgraph
+    /// to camera facing quads textured with the atlas once the subgraph falls below a screen height ratio, so distant buildings, trees etc. cost two triangles rather than their full geometry.
+    /// Each frame of the atlas holds the color, and derived from the depth buffer the normal and depth, of the subgraph seen from the direction at the center of the frame.
+    /// The quads select the frame nearest to the view direction, are lit by a headlight using the frame's normals, and write their depth so they intersect correctly with the rest of the scene.
+    /// The subgraph is rendered with an AmbientLight, so the atlas approximates unlit colors, on the device passed in at the time createAtlas()/generate() is called,
+    /// so can be run as part of loading a model or on demand when a subgraph is first needed in the distance.
+    class VSG_DECLSPEC GenerateImpostor : public Inherit<Object, GenerateImpostor>
+    {
+    public:
+        GenerateImpostor(ref_ptr<Device> in_device, int in_queueFamily);
+
+        ref_ptr<Device> device;
+        int queueFamily = -1;
+
+        /// number of frames along each side of the atlas
+        uint32_t numFrames = 8;
+
+        /// width and height in pixels of each frame
+        uint32_t frameSize = 128;
+
+        /// minimum screen height ratio of the subgraph, below it the impostor is drawn instead, following the LOD::Child convention
+        double minimumScreenHeightRatio = 0.1;
+
+        ref_ptr<const Options> options;
+        ref_ptr<SharedObjects> sharedObjects;
+
+        struct Atlas
+        {
+            ref_ptr<ubvec4Array2D> color;       // alpha of 0 where the subgraph doesn't cover the frame
+            ref_ptr<ubvec4Array2D> normalDepth; // normal in the subgraph's coordinate frame encoded as 0.5 + 0.5 * normal, depth of 0 to 1 from the back to the front of the bound
+            dsphere bound;
+            uint32_t numFrames = 0;
+        };
+
+        /// render the subgraph into a numFrames x numFrames grid of frames, returns an Atlas without color/normalDepth data if the subgraph has no bounds.
+        Atlas createAtlas(ref_ptr<Node> subgraph) const;
+
+        /// create the subgraph that draws an impostor for each of the positions, in the same style as billboards the positions are vec4{x, y, z, scale},
+        /// when no positions are provided a single impostor is drawn in place of the original subgraph.
+        ref_ptr<Node> createImpostor(const Atlas& atlas, ref_ptr<vec4Array> positions = {}) const;
+
+        /// create an LOD with the subgraph as its first child and its impostor as the second, returns the original subgraph if it has no bounds.
+        ref_ptr<Node> generate(ref_ptr<Node> subgraph) const;
+
+    protected:
+        virtual ~GenerateImpostor();
+    };
+    VSG_type_name(vsg::GenerateImpostor);
+
+} // namespace vsg
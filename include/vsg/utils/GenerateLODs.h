@@ -0,0 +1,68 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array.h>
+#include <vsg/nodes/Node.h>
+
+namespace vsg
+{
+
+    /// Simplify an indexed triangle list using quadric error metric guided half edge collapses.
+    /// Vertices are collapsed on to existing vertices so the simplified indices can be used with the original vertex arrays.
+    /// Collapses stop once the number of indices is at or below targetIndexCount, or when no collapse has an error below targetError,
+    /// where targetError is a fraction of the extent of the mesh. Mesh boundaries are preserved by additional boundary quadrics,
+    /// and vertices that share their position with other vertices, such as at texture coordinate or normal seams, are locked.
+    /// Returns the simplified indices, of the same type as the indices passed in, or null if the indices aren't ushortArray or uintArray.
+    /// If resultError is non null it's assigned the error of the simplified mesh as a fraction of the extent of the mesh.
+    extern VSG_DECLSPEC ref_ptr<Data> simplify(const vec3Array& vertices, const Data& indices, uint32_t firstIndex, uint32_t indexCount, uint32_t vertexOffset,
+                                               uint32_t targetIndexCount, float targetError = 0.01f, float* resultError = nullptr);
+
+    /// GenerateLODs creates an LOD node with a chain of progressively simplified versions of a subgraph.
+    /// The VertexIndexDraw and Geometry nodes with triangle list indices in the subgraph are simplified, sharing the original vertex arrays,
+    /// with the internal Group, StateGroup, MatrixTransform etc. nodes that lead to them duplicated and all other nodes shared with the original subgraph.
+    /// Can be used directly, or assigned to Options::generateLODs so vsg::read(..) applies it to the nodes loaded.
+    class VSG_DECLSPEC GenerateLODs : public Inherit<Object, GenerateLODs>
+    {
+    public:
+        GenerateLODs();
+
+        /// maximum number of levels in the LOD, including the original subgraph
+        uint32_t numLevels = 3;
+
+        /// ratio of the number of triangles of each level to the level above it
+        float reductionRatio = 0.25f;
+
+        /// maximum error of each simplified level, as a fraction of the extent of each mesh
+        float targetError = 0.02f;
+
+        /// minimum screen height ratio of the original subgraph, subsequent levels reduce this by sqrt(reductionRatio) so the triangle density on screen stays similar.
+        /// The lowest level is given a minimumScreenHeightRatio of 0.0 so that it's always visible when within the view frustum.
+        double minimumScreenHeightRatio = 0.5;
+
+        /// subgraphs with fewer triangles than this are returned unchanged
+        uint32_t minimumNumTriangles = 256;
+
+        /// generate an LOD for the subgraph, returns the original subgraph if no simplified levels could be created.
+        ref_ptr<Node> generate(ref_ptr<Node> subgraph) const;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~GenerateLODs();
+    };
+    VSG_type_name(vsg::GenerateLODs);
+
+} // namespace vsg
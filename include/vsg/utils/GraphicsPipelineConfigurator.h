@@ -19,6 +19,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/DescriptorImage.h>
 #include <vsg/state/DescriptorSetLayout.h>
 #include <vsg/state/DynamicState.h>
+#include <vsg/state/ExtendedDynamicState.h>
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/state/InputAssemblyState.h>
 #include <vsg/state/MultisampleState.h>
@@ -93,6 +94,37 @@ namespace vsg
     };
     VSG_type_name(vsg::ArrayConfigurator);
 
+    // forward declare
+    class GraphicsPipelineConfigurator;
+
+    /// GraphicsPipelineConfiguratorCache deduplicates the PipelineLayout, ShaderStages and GraphicsPipeline created by GraphicsPipelineConfigurator::init() when configuring many materials that use the same ShaderSet.
+    /// Configurations are matched on the ShaderSet::DefinesMask of their defines rather than by comparing sets of strings.
+    /// Assign to GraphicsPipelineConfigurator::cache, or call init(configurators) to initialize a batch of configurators.
+    class VSG_DECLSPEC GraphicsPipelineConfiguratorCache : public vsg::Inherit<Object, GraphicsPipelineConfiguratorCache>
+    {
+    public:
+        explicit GraphicsPipelineConfiguratorCache(ref_ptr<ShaderSet> in_shaderSet);
+
+        const ref_ptr<ShaderSet> shaderSet;
+
+        using DefinesMask = ShaderSet::DefinesMask;
+
+        /// initialize configurator using the cached objects, falls back to an uncached configurator.init() if its defines can't be mapped to a DefinesMask.
+        void init(GraphicsPipelineConfigurator& configurator);
+
+        /// initialize a batch of configurators, equivalent to calling init(*configurator) for each one.
+        void init(const std::vector<ref_ptr<GraphicsPipelineConfigurator>>& configurators);
+
+        ref_ptr<PipelineLayout> getOrCreatePipelineLayout(DefinesMask mask);
+        ref_ptr<GraphicsPipeline> getOrCreateGraphicsPipeline(DefinesMask mask, ref_ptr<PipelineLayout> layout, const ShaderStages& stages, const GraphicsPipelineStates& pipelineStates, uint32_t subpass);
+
+    protected:
+        std::mutex _mutex;
+        std::map<DefinesMask, ref_ptr<PipelineLayout>> _layouts;
+        std::map<DefinesMask, std::vector<ref_ptr<GraphicsPipeline>>> _graphicsPipelines;
+    };
+    VSG_type_name(vsg::GraphicsPipelineConfiguratorCache);
+
     /// GraphicsPipelineConfigurator utility provides a means of setting up state and geometry using ShaderSet as a guide for required layouts/bindings.
     class VSG_DECLSPEC GraphicsPipelineConfigurator : public vsg::Inherit<Object, GraphicsPipelineConfigurator>
     {
@@ -109,6 +141,14 @@ namespace vsg
         uint32_t baseAttributeBinding = 0;
         ref_ptr<ShaderSet> shaderSet;
 
+        /// ExtendedDynamicState::StateMask bits of the pipeline states to set dynamically, when non zero init() assigns an ExtendedDynamicState to the BindGraphicsPipeline
+        /// and creates the GraphicsPipeline with these states reset to defaults, so configurations that only differ in them can share the same GraphicsPipeline.
+        /// Use ExtendedDynamicState::supportedStates(device) to restrict the mask to the states the device supports.
+        uint32_t dynamicStateMask = 0;
+
+        /// when assigned init() reuses the PipelineLayout, ShaderStages and GraphicsPipeline of earlier configurators with the same settings.
+        ref_ptr<GraphicsPipelineConfiguratorCache> cache;
+
         void reset();
 
         bool enableArray(const std::string& name, VkVertexInputRate vertexInputRate, uint32_t stride, VkFormat format = VK_FORMAT_UNDEFINED);
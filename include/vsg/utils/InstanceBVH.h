@@ -0,0 +1,107 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/maths/sphere.h>
+
+namespace vsg
+{
+
+    /// InstanceBVH is a bounding volume hierarchy over the per instance translations of an InstanceNode, used by the Intersector to only test the instances
+    /// whose bounds the intersector reaches rather than every instance of large instance counts.
+    /// The Intersector builds it lazily and caches it on the InstanceNode via setObject("InstanceBVH", bvh), valid(..) checks whether the translation and scale Data
+    /// it was built from have since been replaced or modified so that it needs rebuilding.
+    class VSG_DECLSPEC InstanceBVH : public Inherit<Object, InstanceBVH>
+    {
+    public:
+        InstanceBVH();
+
+        /// node of the hierarchy, leaves have count > 0 and reference instances[index, index + count),
+        /// internal nodes have count == 0 with their first child immediately following them and their second child at nodes[index].
+        /// min/max bound the translations of the instances below the node and maxScale is the largest absolute scale component of those instances.
+        struct Node
+        {
+            vec3 min;
+            uint32_t index = 0;
+            vec3 max;
+            uint32_t count = 0;
+            float maxScale = 1.0f;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> instances; /// instance indices, reordered during build so that the instances of each leaf are contiguous
+
+        /// build the hierarchy over the instances [firstInstance, firstInstance + instanceCount), splitting each node at the median translation along its longest axis.
+        /// scales may be null, in which case all instances have a scale of 1.
+        void build(const vec3Array& translations, const vec3Array* scales, uint32_t firstInstance, uint32_t instanceCount, uint32_t maxInstancesPerLeaf = 8);
+
+        /// record the translation/scale Data and range the BVH was built from.
+        void setSource(const Data* translations, const Data* scales, uint32_t first, uint32_t count);
+
+        /// return true if the BVH was built from the specified Data and range, and the Data hasn't been modified since.
+        bool valid(const Data* translations, const Data* scales, uint32_t first, uint32_t count) const;
+
+        /// call intersectInstance(instanceIndex) for every instance in the leaves whose bounds pass intersects(sphere), where the bounds of a node enclose
+        /// localBound, the bound of the instanced geometry in its local coordinates, once scaled, rotated and translated by any of the node's instances.
+        template<typename H, typename F>
+        void intersect(const dsphere& localBound, H intersects, F intersectInstance) const
+        {
+            if (nodes.empty()) return;
+
+            // the scaled and rotated localBound lies within maxScale * extent of the instance's translation
+            double extent = length(localBound.center) + localBound.radius;
+
+            uint32_t stack[64];
+            uint32_t stackSize = 0;
+            stack[stackSize++] = 0;
+            while (stackSize > 0)
+            {
+                const Node& node = nodes[stack[--stackSize]];
+
+                dvec3 min(node.min), max(node.max);
+                if (!intersects(dsphere((min + max) * 0.5, length(max - min) * 0.5 + static_cast<double>(node.maxScale) * extent))) continue;
+
+                if (node.count > 0)
+                {
+                    for (uint32_t i = node.index; i < node.index + node.count; ++i)
+                    {
+                        intersectInstance(instances[i]);
+                    }
+                }
+                else
+                {
+                    uint32_t first = static_cast<uint32_t>(&node - nodes.data()) + 1;
+                    stack[stackSize++] = node.index;
+                    stack[stackSize++] = first;
+                }
+            }
+        }
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~InstanceBVH();
+
+        const Data* _translations = nullptr;
+        const Data* _scales = nullptr;
+        ModifiedCount _translationsModifiedCount;
+        ModifiedCount _scalesModifiedCount;
+        uint32_t _first = 0;
+        uint32_t _count = 0;
+    };
+    VSG_type_name(vsg::InstanceBVH);
+
+} // namespace vsg
@@ -17,6 +17,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 #include <vsg/maths/vec4.h>
 
+#include <atomic>
+#include <type_traits>
+
 namespace vsg
 {
 
@@ -68,6 +71,9 @@ namespace vsg
         virtual void enter(const SourceLocation* /*sl*/, uint64_t& /*reference*/, CommandBuffer& /*commandBuffer*/, const Object* /*object*/ = nullptr) const {};
         virtual void leave(const SourceLocation* /*sl*/, uint64_t& /*reference*/, CommandBuffer& /*commandBuffer*/, const Object* /*object*/ = nullptr) const {};
 
+        /// record the current value of a named counter, name must be a string literal or otherwise remain valid for the lifetime of the Instrumentation.
+        virtual void plot(const char* /*name*/, double /*value*/) const {};
+
         virtual void finish() const {};
 
     protected:
@@ -133,6 +139,48 @@ namespace vsg
         }
     };
 
+    /// Instrumentation that contended locks taken via LOCK_INSTRUMENTATION/SCOPED_LOCK_INSTRUMENTATION report their wait to, as a CPU zone named after the lock.
+    /// Assign before starting the threads that take the locks and keep a reference to the Instrumentation for as long as it remains assigned.
+    extern VSG_DECLSPEC std::atomic<const Instrumentation*> lockInstrumentation;
+
+    /// lock lockable, if it's held by another thread report the time spent waiting for it to lockInstrumentation.
+    template<class Lockable>
+    inline void instrumentedLock(Lockable& lockable, const SourceLocation* sl)
+    {
+        if (lockable.try_lock()) return;
+
+        if (auto instr = lockInstrumentation.load(std::memory_order_acquire))
+        {
+            uint64_t reference = 0;
+            instr->enter(sl, reference, nullptr);
+            lockable.lock();
+            instr->leave(sl, reference, nullptr);
+        }
+        else
+        {
+            lockable.lock();
+        }
+    }
+
+    template<class Mutex>
+    struct ScopedLockInstrumentation
+    {
+        Mutex& mutex;
+
+        inline ScopedLockInstrumentation(Mutex& in_mutex, const SourceLocation* sl) :
+            mutex(in_mutex)
+        {
+            instrumentedLock(mutex, sl);
+        }
+        inline ~ScopedLockInstrumentation()
+        {
+            mutex.unlock();
+        }
+
+        ScopedLockInstrumentation(const ScopedLockInstrumentation&) = delete;
+        ScopedLockInstrumentation& operator=(const ScopedLockInstrumentation&) = delete;
+    };
+
 // standard colours specified in {r, g, b, a} ordering
 #define COLOR_DEFAULT vsg::uint_color(255, 255, 255, 255)
 #define COLOR_VIEWER vsg::uint_color(127, 240, 240, 255)
@@ -146,6 +194,7 @@ namespace vsg
 #define COLOR_PAGER vsg::uint_color(240, 255, 64, 255)
 #define COLOR_READ vsg::uint_color(0, 255, 128, 255)
 #define COLOR_WRITE vsg::uint_color(0, 128, 255, 255)
+#define COLOR_LOCK vsg::uint_color(255, 0, 0, 255)
 
 #if defined(__clang__) || defined(__GNUC__)
 #    define VsgFunctionName __PRETTY_FUNCTION__
@@ -161,6 +210,14 @@ namespace vsg
     static constexpr vsg::SourceLocation s_gpu_source_location_##__LINE__{name, VsgFunctionName, __FILE__, __LINE__, color, level}; \
     vsg::GpuInstrumentation __gpu_scoped_instrumentation_##__LINE__(instrumentation, &(s_gpu_source_location_##__LINE__), cg, object);
 
+#define __LOCK_INSTRUMENTATION(level, lockable, name)                                                                                  \
+    static constexpr vsg::SourceLocation s_lock_source_location_##__LINE__{name, VsgFunctionName, __FILE__, __LINE__, COLOR_LOCK, level}; \
+    vsg::instrumentedLock(lockable, &(s_lock_source_location_##__LINE__));
+
+#define __SCOPED_LOCK_INSTRUMENTATION(level, lockable, name)                                                                           \
+    static constexpr vsg::SourceLocation s_lock_source_location_##__LINE__{name, VsgFunctionName, __FILE__, __LINE__, COLOR_LOCK, level}; \
+    vsg::ScopedLockInstrumentation<std::remove_reference_t<decltype(lockable)>> __scoped_lock_instrumentation_##__LINE__(lockable, &(s_lock_source_location_##__LINE__));
+
 #define __COMMAND_BUFFER_INSTRUMENTATION(level, instrumentation, cg, name, color)                                                  \
     static constexpr vsg::SourceLocation s_cg_source_location_##__LINE__{name, VsgFunctionName, __FILE__, __LINE__, color, level}; \
     vsg::CommandBufferInstrumentation __cg_scoped_instrumentation_##__LINE__(instrumentation, &(s_cg_source_location_##__LINE__), cg);
@@ -189,6 +246,11 @@ namespace vsg
 
 #    define COMMAND_BUFFER_INSTRUMENTATION(instrumentation, cg, name, color) __COMMAND_BUFFER_INSTRUMENTATION(1, instrumentation, cg, name, color)
 
+// lock lockable, reporting contention to vsg::lockInstrumentation
+#    define LOCK_INSTRUMENTATION(lockable, name) __LOCK_INSTRUMENTATION(1, lockable, name)
+// declare a scoped lock of lockable, reporting contention to vsg::lockInstrumentation
+#    define SCOPED_LOCK_INSTRUMENTATION(lockable, name) __SCOPED_LOCK_INSTRUMENTATION(1, lockable, name)
+
 #else
 
 #    define CPU_INSTRUMENTATION_L1(instrumentation)
@@ -213,6 +275,9 @@ namespace vsg
 
 #    define COMMAND_BUFFER_INSTRUMENTATION(instrumentation, cg, name, color)
 
+#    define LOCK_INSTRUMENTATION(lockable, name) lockable.lock();
+#    define SCOPED_LOCK_INSTRUMENTATION(lockable, name) std::scoped_lock __scoped_lock_instrumentation_##__LINE__(lockable);
+
 #endif
 
 #if VSG_MAX_INSTRUMENTATION_LEVEL >= 2
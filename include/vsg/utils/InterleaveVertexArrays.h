@@ -0,0 +1,87 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/state/BufferInfo.h>
+#include <vsg/state/GraphicsPipeline.h>
+
+#include <map>
+#include <set>
+
+namespace vsg
+{
+
+    /// copy arrays with the same number of elements into a single interleaved ubyteArray, with each array's elements placed at an offset aligned to 4 bytes
+    /// within each stride, and reassign the arrays to be strided views into it. Returns null and leaves the arrays unchanged if they aren't all 1D Arrays of the same size.
+    /// As the views have the interleaved stride they should only be bound with a matching VkVertexInputBindingDescription::stride. When offsets is provided it's filled in with the offset of each array within the stride.
+    extern VSG_DECLSPEC ref_ptr<ubyteArray> interleaveArrays(const DataList& arrays, std::vector<uint32_t>* offsets = nullptr);
+
+    /// copy arrays one after another into a single ubyteArray, with each array starting at an offset aligned to 4 bytes, and reassign the arrays to be contiguous views into it.
+    /// Unlike interleaveArrays(..) the arrays keep their stride so can be used in place of the originals. Returns null and leaves the arrays unchanged if they aren't all 1D Arrays.
+    extern VSG_DECLSPEC ref_ptr<ubyteArray> packArrays(const DataList& arrays);
+
+    /// copy strided or packed views back into contiguous arrays that each own their values, the reverse of interleaveArrays(..) and packArrays(..).
+    extern VSG_DECLSPEC void deinterleaveArrays(const DataList& arrays);
+
+    /// InterleaveVertexArrays converts the per vertex arrays of VertexIndexDraw, VertexDraw and Geometry nodes that are bound as separate vertex buffers into a single
+    /// interleaved vertex buffer, so each vertex's attributes are fetched from one location and each draw binds one buffer for them. The GraphicsPipeline bound by the
+    /// parent StateGroups have their VertexInputState updated to use a single binding with the attribute offsets of the interleaved layout, so only pipelines
+    /// whose draws all provide static arrays with the same number of vertices for every per vertex binding are converted. Per instance arrays are kept as separate bindings.
+    /// Must be applied before the scene graph is compiled.
+    class VSG_DECLSPEC InterleaveVertexArrays : public Inherit<Visitor, InterleaveVertexArrays>
+    {
+    public:
+        InterleaveVertexArrays();
+
+        // statistics of the changes made
+        uint32_t numDrawsConverted = 0;
+        uint32_t numPipelinesUpdated = 0;
+        uint32_t numBindingsBefore = 0;
+        uint32_t numBindingsAfter = 0;
+
+        /// convert the vertex arrays in the subgraph
+        void interleave(Node& node);
+
+        /// write out the statistics of the changes made
+        void report(LogOutput& output) const;
+
+        void apply(Node& node) override;
+        void apply(StateGroup& stateGroup) override;
+        void apply(VertexIndexDraw& vid) override;
+        void apply(VertexDraw& vd) override;
+        void apply(Geometry& geometry) override;
+
+    protected:
+        virtual ~InterleaveVertexArrays();
+
+        struct Draw
+        {
+            Node* node = nullptr;
+            uint32_t* firstBinding = nullptr;
+            BufferInfoList* arrays = nullptr;
+        };
+
+        void _collect(Node& node, uint32_t& firstBinding, BufferInfoList& arrays);
+        void _convert(GraphicsPipeline& pipeline, std::vector<Draw>& draws);
+
+        std::vector<GraphicsPipeline*> _pipelineStack;
+        std::map<GraphicsPipeline*, std::vector<Draw>> _draws;
+    };
+    VSG_type_name(vsg::InterleaveVertexArrays);
+
+} // namespace vsg
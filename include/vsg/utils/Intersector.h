@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/nodes/Node.h>
 #include <vsg/state/ArrayState.h>
+#include <vsg/utils/TriangleBVH.h>
 
 namespace vsg
 {
@@ -38,11 +39,16 @@ namespace vsg
         void apply(const PagedLOD& plod) override;
         void apply(const CullNode& cn) override;
         void apply(const CullGroup& cn) override;
+        void apply(const SpatialGrid& spatialGrid) override;
         void apply(const DepthSorted& cn) override;
 
         void apply(const VertexDraw& vid) override;
         void apply(const VertexIndexDraw& vid) override;
         void apply(const Geometry& geometry) override;
+        void apply(const PackedDraws& packedDraws) override;
+        void apply(const InstanceNode& instanceNode) override;
+        void apply(const InstanceDraw& instanceDraw) override;
+        void apply(const InstanceDrawIndexed& instanceDrawIndexed) override;
 
         void apply(const BindVertexBuffers& bvb) override;
         void apply(const BindIndexBuffer& bib) override;
@@ -74,6 +80,14 @@ namespace vsg
         /// intersect with a vkCmdDrawIndexed primitive
         virtual bool intersectDrawIndexed(uint32_t firstIndex, uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount) = 0;
 
+        /// minimum number of triangles in a triangle list draw before a TriangleBVH is built and cached on the draw node to accelerate the triangle queries,
+        /// a value of 0 disables the use of TriangleBVH.
+        uint32_t triangleBVHThreshold = 4096;
+
+        /// minimum number of instances in an InstanceNode before an InstanceBVH is built and cached on the InstanceNode so that only the instances whose bounds
+        /// the intersector reaches are visited, below it each instance's transformed bound is tested in turn. A value of 0 disables the use of InstanceBVH.
+        uint32_t instanceBVHThreshold = 1024;
+
         /// get the current local to world matrix stack
         std::vector<dmat4>& localToWorldStack() { return arrayStateStack.back()->localToWorldStack; }
 
@@ -81,6 +95,16 @@ namespace vsg
         std::vector<dmat4>& worldToLocalStack() { return arrayStateStack.back()->worldToLocalStack; }
 
     protected:
+        /// get the TriangleBVH for the current triangle list draw, building it and caching it on the draw node when it's missing or out of date.
+        /// Returns null when the draw is below the triangleBVHThreshold or its vertices are computed per instance by an ArrayState subclass.
+        ref_ptr<const TriangleBVH> getTriangleBVH(uint32_t first, uint32_t count, bool indexed);
+
+        /// collect the indices of the current InstanceNode's instances whose bounds, computed by transforming localBound by each instance's scale, rotation and translation, pass intersects(..).
+        const std::vector<uint32_t>& candidateInstances(const dsphere& localBound);
+
+        const InstanceNode* instanceNode = nullptr;
+        std::vector<uint32_t> _candidateInstances;
+
         ArrayStateStack arrayStateStack;
 
         ref_ptr<const ubyteArray> ubyte_indices;
@@ -13,19 +13,30 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/app/Camera.h>
+#include <vsg/app/CompileManager.h>
 #include <vsg/core/Visitor.h>
 #include <vsg/maths/transform.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/threading/OperationThreads.h>
 
+#include <functional>
+#include <mutex>
+#include <set>
 #include <stack>
 
 namespace vsg
 {
     // Traverse the scene graph loading any PLOD that are required for a camera view.
+    // Traversing with accept(..) loads the tiles serially as they are encountered, use load(..) to read, and optionally compile, the tiles of each level concurrently.
     class VSG_DECLSPEC LoadPagedLOD : public vsg::Visitor
     {
     public:
         explicit LoadPagedLOD(ref_ptr<Camera> in_camera, int in_loadLevels = 30);
 
+        /// load the tiles required below node, the tiles are loaded a level at a time with all the tiles of a level read concurrently using the OperationThreads.
+        /// Falls back to reading the tiles serially when no OperationThreads are available. Returns the number of tiles loaded.
+        unsigned int load(ref_ptr<Node> node);
+
         void apply(Node& node) override;
         void apply(CullNode& node) override;
         void apply(Transform& transform) override;
@@ -37,6 +48,31 @@ namespace vsg
         int level = 0;
         unsigned int numTiles = 0;
 
+        /// OperationThreads used by load(..), if not assigned the operationThreads of the PagedLOD's options are used.
+        ref_ptr<OperationThreads> operationThreads;
+
+        /// if assigned, load(..) compiles each tile on the loading thread once it's been read, with the results accumulated in compileResult.
+        /// Call updateViewer(viewer, compileResult) after load(..) if compileResult.requiresViewerUpdate().
+        ref_ptr<CompileManager> compileManager;
+        CompileResult compileResult;
+
+        /// estimate of the GPU memory, in bytes, that the tiles loaded by load(..) may use, once exceeded no further tiles are scheduled. 0 for no limit.
+        /// As the tiles of a level are read concurrently the final level can overshoot the budget.
+        uint64_t memoryBudget = 0;
+
+        /// estimate of the GPU memory, in bytes, required by the tiles loaded so far.
+        uint64_t memoryUsed = 0;
+
+        /// number of tiles that weren't loaded because the memoryBudget was exceeded.
+        unsigned int numTilesSkipped = 0;
+
+        /// callback invoked by load(..) each time a tile has been read, and compiled if required, passing in the numbers of tiles loaded and still pending.
+        /// Called from the loading threads, calls are serialized.
+        using ProgressFunction = std::function<void(const LoadPagedLOD&, unsigned int numLoaded, unsigned int numPending)>;
+        ProgressFunction progress;
+
+        bool budgetExceeded() const { return memoryBudget > 0 && memoryUsed >= memoryBudget; }
+
     protected:
         using Plane = dplane;
         using Polytope = std::array<Plane, 4>;
@@ -63,6 +99,33 @@ namespace vsg
         }
 
         void pushFrustum();
+
+        struct PendingTile
+        {
+            ref_ptr<PagedLOD> plod;
+            size_t childIndex = 0;
+            Path filename;
+            dmat4 modelview;
+            Paths pathStack;
+            int level = 0;
+
+            // set by the loading thread
+            ref_ptr<Node> node;
+            uint64_t memory = 0;
+        };
+        using PendingTiles = std::vector<PendingTile>;
+
+        /// true while load(..) is traversing, PagedLOD tiles are then added to _pendingTiles rather than read directly.
+        bool _deferLoading = false;
+        PendingTiles _pendingTiles;
+        std::set<const PagedLOD*> _pendingPagedLODs;
+
+        std::mutex _progressMutex;
+        unsigned int _numLoaded = 0;
+        unsigned int _numPending = 0;
+
+        void _loadTile(PendingTile& tile);
+        void _loadPendingTiles(PendingTiles& tiles);
     };
     VSG_type_name(vsg::LoadPagedLOD);
 
@@ -0,0 +1,100 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/maths/mat4.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+
+#include <map>
+#include <set>
+
+namespace vsg
+{
+
+    /// MergeGeometries reduces the number of draw calls in scenes made up of many small VertexIndexDraw nodes that share the same state.
+    /// Within each Group, VertexIndexDraw nodes that are reached via Group and MatrixTransform nodes, with no intervening StateGroup, CullGroup, LOD etc.,
+    /// are merged into VertexIndexDraw nodes with combined vertex arrays and indices so that each batch is rendered with a single vkCmdDrawIndexed.
+    /// MatrixTransforms are treated as static and their matrices applied to the vertex, and optionally normal, arrays.
+    /// The merged VertexIndexDraw are regular scene graph nodes so ComputeBounds and the Intersectors continue to work on the result.
+    /// VertexIndexDraw that are instanced, have dynamic data or have vertex array types that can't be merged are left unchanged.
+    /// As merged draws are placed at the end of the Group's children the draw order within a Group may change.
+    class VSG_DECLSPEC MergeGeometries : public Inherit<Visitor, MergeGeometries>
+    {
+    public:
+        MergeGeometries();
+
+        /// minimum number of VertexIndexDraw required to create a merged VertexIndexDraw
+        uint32_t minimumNumDraws = 2;
+
+        /// maximum number of vertices in a merged VertexIndexDraw, draws are split into multiple batches when exceeded.
+        uint32_t maxNumVertices = 1 << 20;
+
+        /// apply MatrixTransform matrices to the vertices so draws under different MatrixTransforms can be merged
+        bool preTransform = true;
+
+        /// index of the vec3Array treated as vertices when applying MatrixTransforms
+        uint32_t vertexArrayIndex = 0;
+
+        /// index of the vec3Array treated as normals when applying MatrixTransforms, -1 to not transform normals. Defaults to the vsg::Builder layout.
+        int normalArrayIndex = 1;
+
+        // statistics of the changes made
+        uint32_t numDrawsMerged = 0;
+        uint32_t numMergedDraws = 0;
+
+        /// merge the geometries in the subgraph, node itself is never replaced.
+        void merge(Node& node);
+
+        /// write out the statistics of the changes made
+        void report(LogOutput& output) const;
+
+        void apply(Node& node) override;
+        void apply(Group& group) override;
+
+    protected:
+        virtual ~MergeGeometries();
+
+        struct Candidate
+        {
+            ref_ptr<VertexIndexDraw> vertexIndexDraw;
+            Group* parent = nullptr;
+            dmat4 matrix;
+            bool transformed = false;
+        };
+
+        struct Layout
+        {
+            uint32_t firstBinding = 0;
+            std::vector<std::type_index> arrayTypes;
+
+            bool operator<(const Layout& rhs) const { return firstBinding < rhs.firstBinding || (firstBinding == rhs.firstBinding && arrayTypes < rhs.arrayTypes); }
+        };
+
+        void _collect(Group& group, const dmat4& matrix, bool transformed, std::map<Layout, std::vector<Candidate>>& candidates);
+        bool _mergeable(const VertexIndexDraw& vid, bool transformed) const;
+        ref_ptr<VertexIndexDraw> _merge(const Layout& layout, const std::vector<Candidate>& batch) const;
+        using MergedDraws = std::set<std::pair<const Group*, const Node*>>;
+
+        bool _prune(Group& group, const MergedDraws& merged);
+        bool _isShared(const Node* node) const;
+
+        std::map<const Node*, uint32_t> _parentCounts;
+        std::set<const Node*> _visited;
+    };
+    VSG_type_name(vsg::MergeGeometries);
+
+} // namespace vsg
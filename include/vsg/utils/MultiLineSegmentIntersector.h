@@ -0,0 +1,78 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/utils/LineSegmentIntersector.h>
+
+namespace vsg
+{
+
+    /// MultiLineSegmentIntersector computes the intersections of a batch of line segments with a scene graph in a single traversal.
+    /// The set of segments still reaching a subgraph is culled against each bounded node, triangles of small draws are tested against
+    /// packets of segments with SIMD kernels, and draws large enough to have a TriangleBVH are queried per segment through the BVH.
+    class VSG_DECLSPEC MultiLineSegmentIntersector : public Inherit<Intersector, MultiLineSegmentIntersector>
+    {
+    public:
+        struct LineSegment
+        {
+            dvec3 start;
+            dvec3 end;
+        };
+
+        using LineSegments = std::vector<LineSegment>;
+
+        explicit MultiLineSegmentIntersector(const LineSegments& in_lineSegments, ref_ptr<ArrayState> initialArrayData = {});
+
+        using Intersection = LineSegmentIntersector::Intersection;
+        using Intersections = LineSegmentIntersector::Intersections;
+
+        /// intersections of each line segment, in the same order as the line segments passed to the constructor.
+        std::vector<Intersections> intersections;
+
+        ref_ptr<Intersection> add(uint32_t segmentIndex, const dvec3& coord, double ratio, const IndexRatios& indexRatios, uint32_t instanceIndex);
+
+        using Intersector::apply;
+
+        // cull the active line segments against the bounds of these nodes
+        void apply(const LOD& lod) override;
+        void apply(const PagedLOD& plod) override;
+        void apply(const CullNode& cn) override;
+        void apply(const CullGroup& cg) override;
+        void apply(const DepthSorted& ds) override;
+
+        void pushTransform(const Transform& transform) override;
+        void popTransform() override;
+
+        /// check whether any of the active line segments intersect the sphere
+        bool intersects(const dsphere& bs) override;
+
+        bool intersectDraw(uint32_t firstVertex, uint32_t vertexCount, uint32_t firstInstance, uint32_t instanceCount) override;
+        bool intersectDrawIndexed(uint32_t firstIndex, uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount) override;
+
+    protected:
+        /// push the subset of the active line segments that intersect bs, return false and push nothing if none do.
+        bool _pushActive(const dsphere& bs);
+        void _popActive() { _activeStack.pop_back(); }
+
+        template<typename F>
+        bool _intersectTriangles(uint32_t first, uint32_t count, bool indexed, uint32_t firstInstance, uint32_t instanceCount, F forEachTriangle);
+
+        /// line segments in the local coordinate frame of each transform, with the world coordinate segments at the bottom of the stack
+        std::vector<LineSegments> _lineSegmentsStack;
+
+        /// indices of the line segments that reach the current subgraph
+        std::vector<std::vector<uint32_t>> _activeStack;
+    };
+    VSG_type_name(vsg::MultiLineSegmentIntersector);
+
+} // namespace vsg
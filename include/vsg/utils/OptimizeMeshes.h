@@ -0,0 +1,67 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Inherit.h>
+
+namespace vsg
+{
+
+    /// reorder the triangles of a triangle list to improve post-transform vertex cache reuse, using Tom Forsyth's linear speed vertex cache optimization.
+    /// indices are relative to the start of the vertex arrays and must be less than numVertices.
+    extern VSG_DECLSPEC void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t numVertices, uint32_t cacheSize = 32);
+
+    /// reorder clusters of triangles of a vertex cache optimized triangle list so that the outward facing triangles on the outside of the mesh are drawn first,
+    /// reducing overdraw for closed meshes drawn with depth testing. Clusters are split where the simulated vertex cache of cacheSize misses all the vertices of a triangle
+    /// so the reordering costs little of the vertex cache reuse.
+    extern VSG_DECLSPEC void optimizeOverdraw(std::vector<uint32_t>& indices, const vec3Array& vertices, uint32_t cacheSize = 32);
+
+    /// return the remapping of vertices that orders them by their first use in indices, improving vertex fetch locality. Unreferenced vertices are placed after the referenced ones.
+    /// remap[oldIndex] provides the new index of each vertex.
+    extern VSG_DECLSPEC std::vector<uint32_t> optimizeVertexFetch(const std::vector<uint32_t>& indices, uint32_t numVertices);
+
+    /// return the average number of vertex cache misses per triangle of a triangle list, simulating a FIFO vertex cache of cacheSize entries.
+    extern VSG_DECLSPEC float averageCacheMissRatio(const std::vector<uint32_t>& indices, uint32_t numVertices, uint32_t cacheSize = 32);
+
+    /// OptimizeMeshes reorders the indices of the triangle list VertexIndexDraw and Geometry nodes in a subgraph for post-transform vertex cache reuse, optionally
+    /// reordering the clusters of triangles to reduce overdraw, and remaps the vertex arrays so they are fetched in the order they are used.
+    /// The index and vertex arrays are modified in place so should be applied before the subgraph is compiled. Arrays that are dynamic are left unchanged,
+    /// and vertex arrays are only remapped when a single draw uses all of their indices and no other draw shares them.
+    /// Can be used directly, or assigned to Options::optimizeMeshes so vsg::read(..) applies it to the subgraphs loaded.
+    class VSG_DECLSPEC OptimizeMeshes : public Inherit<Object, OptimizeMeshes>
+    {
+    public:
+        OptimizeMeshes();
+
+        /// number of entries in the vertex cache that indices are optimized for
+        uint32_t vertexCacheSize = 32;
+
+        /// reorder the vertex cache optimized triangles to reduce overdraw, requires a vec3Array as the first vertex array.
+        bool reduceOverdraw = false;
+
+        /// remap the vertex arrays so they are ordered by their first use in the indices
+        bool remapVertices = true;
+
+        /// optimize the meshes in the object's subgraph
+        void apply(Object& object) const;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~OptimizeMeshes();
+    };
+    VSG_type_name(vsg::OptimizeMeshes);
+
+} // namespace vsg
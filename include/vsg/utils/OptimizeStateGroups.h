@@ -0,0 +1,93 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Visitor.h>
+#include <vsg/core/compare.h>
+#include <vsg/io/Logger.h>
+#include <vsg/nodes/StateGroup.h>
+
+#include <map>
+#include <set>
+
+namespace vsg
+{
+
+    /// OptimizeStateGroups reduces the number of StateCommands pushed, and vkCmd* calls recorded, during the RecordTraversal.
+    /// It shares StateCommands that compare as equal so that vsg::State's pointer based filtering of binds works across StateGroups,
+    /// removes StateCommands that rebind state inherited from a parent StateGroup, merges sibling StateGroups with the same state,
+    /// and hoists StateCommands common to all the StateGroup children of a Group up into a single StateGroup.
+    /// Nodes that are reached via more than one path through the scene graph, and all nodes beneath them, are not modified.
+    ///
+    /// Usage:
+    ///     vsg::OptimizeStateGroups optimizeStateGroups;
+    ///     optimizeStateGroups.optimize(scene);
+    ///     vsg::LogOutput output;
+    ///     optimizeStateGroups.report(output);
+    class VSG_DECLSPEC OptimizeStateGroups : public Inherit<Visitor, OptimizeStateGroups>
+    {
+    public:
+        OptimizeStateGroups();
+
+        /// replace StateCommands that compare as equal with a single shared instance
+        bool shareStateCommands = true;
+
+        /// remove StateCommands that are equal to state already inherited from a parent StateGroup
+        bool removeRedundantStateCommands = true;
+
+        /// merge sibling StateGroups that have the same StateCommands
+        bool mergeSiblingStateGroups = true;
+
+        /// by default only adjacent siblings are merged so that the draw order is preserved, set to true to also merge non adjacent siblings.
+        bool mergeNonAdjacentSiblings = false;
+
+        /// move StateCommands common to all the StateGroup children of a Group up into a single StateGroup
+        bool hoistCommonStateCommands = true;
+
+        /// replace empty StateGroups with their children
+        bool removeEmptyStateGroups = true;
+
+        // statistics of the changes made
+        uint32_t numStateCommandsShared = 0;
+        uint32_t numRedundantStateCommandsRemoved = 0;
+        uint32_t numStateGroupsMerged = 0;
+        uint32_t numStateCommandsHoisted = 0;
+        uint32_t numStateGroupsRemoved = 0;
+
+        /// optimize the subgraph, node itself is never replaced.
+        void optimize(Node& node);
+
+        /// write out the statistics of the changes made
+        void report(LogOutput& output) const;
+
+        void apply(Node& node) override;
+        void apply(Group& group) override;
+        void apply(StateGroup& stateGroup) override;
+
+    protected:
+        virtual ~OptimizeStateGroups();
+
+        void _optimizeChildren(Group& group);
+        void _mergeSiblings(Group& group);
+        void _hoist(Group& group);
+        void _removeEmptyStateGroups(Group& group);
+        bool _isShared(const Node* node) const;
+
+        std::map<const Node*, uint32_t> _parentCounts;
+        std::set<ref_ptr<StateCommand>, DereferenceLess> _sharedStateCommands;
+        std::vector<const StateCommand*> _inheritedState; // indexed by StateCommand::slot
+    };
+    VSG_type_name(vsg::OptimizeStateGroups);
+
+} // namespace vsg
@@ -0,0 +1,40 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/nodes/PackedDraws.h>
+#include <vsg/nodes/PackedSubgraph.h>
+
+namespace vsg
+{
+
+    /// Convert static subgraphs into PackedSubgraph nodes.
+    /// Subgraphs made up solely of Group, StateGroup, MatrixTransform, CullGroup, BatchedCullGroup and CullNode internal nodes, with Command/Commands leaves
+    /// such as VertexIndexDraw and Geometry, are replaced by a PackedSubgraph. When the whole subgraph can't be packed the children of Group nodes
+    /// are packed individually, modifying the subgraph in place. Subgraphs with fewer than minimumNumDraws draws are left unchanged.
+    /// Returns the packed subgraph, or the original subgraph if it couldn't be packed as a whole.
+    extern VSG_DECLSPEC ref_ptr<Node> packSubgraph(ref_ptr<Node> subgraph, size_t minimumNumDraws = 2);
+
+    /// Convert a PackedSubgraph back to an editable subgraph of Group, StateGroup and MatrixTransform nodes that renders the draws in the same order.
+    /// The original hierarchy isn't restored, consecutive draws that share the same transform and state are placed under the same MatrixTransform/StateGroup.
+    extern VSG_DECLSPEC ref_ptr<Node> unpackSubgraph(const PackedSubgraph& packedSubgraph);
+
+    /// Convert static subgraphs of indexed draws into PackedDraws nodes.
+    /// Subgraphs made up solely of Group, StateGroup, CullGroup, BatchedCullGroup and CullNode internal nodes, with non instanced VertexIndexDraw and Geometry leaves
+    /// that use the same vertex array types, are replaced by a PackedDraws with the vertex arrays and indices of the leaves concatenated.
+    /// When the whole subgraph can't be packed the children of Group nodes are packed individually, modifying the subgraph in place.
+    /// Subgraphs with fewer than minimumNumDraws draws are left unchanged. Returns the packed subgraph, or the original subgraph if it couldn't be packed as a whole.
+    extern VSG_DECLSPEC ref_ptr<Node> packDraws(ref_ptr<Node> subgraph, size_t minimumNumDraws = 2);
+
+} // namespace vsg
@@ -0,0 +1,107 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/maths/vec2.h>
+#include <vsg/state/BufferInfo.h>
+#include <vsg/state/DescriptorImage.h>
+
+#include <map>
+#include <set>
+
+namespace vsg
+{
+
+    /// PackTextures reduces the number of Images, ImageViews and distinct descriptors in scenes made up of many small textures,
+    /// packing the small 2D textures bound via BindDescriptorSet into texture atlases and remapping the texture coordinates of the geometry that uses them.
+    /// Textures with the same data type, format, origin and Sampler settings are packed together, with the edge texels replicated into the padding between them
+    /// to avoid bleeding when filtering. The DescriptorImage that referenced textures packed into the same atlas all share the same ImageInfo so that,
+    /// once packed, DescriptorSets that only differed by their texture compare as equal and can be shared by running OptimizeStateGroups afterwards.
+    /// Only textures in a DescriptorSet with a single DescriptorImage, and whose texture coordinates are all in the 0 to 1 range and aren't shared
+    /// with geometry using another texture, are packed. Textures with mipmaps, block compressed or dynamic data are left unchanged.
+    /// Apply before the scene graph is compiled.
+    ///
+    /// Usage:
+    ///     vsg::PackTextures packTextures;
+    ///     packTextures.pack(scene);
+    ///     vsg::OptimizeStateGroups optimizeStateGroups;
+    ///     optimizeStateGroups.optimize(scene);
+    class VSG_DECLSPEC PackTextures : public Inherit<Visitor, PackTextures>
+    {
+    public:
+        PackTextures();
+
+        /// textures with a width or height larger than maxTextureDimension are left unchanged
+        uint32_t maxTextureDimension = 256;
+
+        /// maximum width and height of the atlases
+        uint32_t atlasDimension = 2048;
+
+        /// number of texels between the textures in the atlas, filled with the texture's edge texels
+        uint32_t padding = 2;
+
+        /// minimum number of textures required to create an atlas
+        uint32_t minimumNumTextures = 2;
+
+        /// index of the vec2Array treated as texture coordinates. Defaults to the vsg::Builder layout.
+        uint32_t texCoordArrayIndex = 2;
+
+        // statistics of the changes made
+        uint32_t numTexturesPacked = 0;
+        uint32_t numAtlases = 0;
+        uint32_t numDescriptorImagesReplaced = 0;
+        uint32_t numTexCoordArraysRemapped = 0;
+
+        /// pack the textures in the subgraph
+        void pack(Node& node);
+
+        /// write out the statistics of the changes made
+        void report(LogOutput& output) const;
+
+        void apply(Node& node) override;
+        void apply(StateGroup& stateGroup) override;
+        void apply(Geometry& geometry) override;
+        void apply(VertexDraw& vd) override;
+        void apply(VertexIndexDraw& vid) override;
+        void apply(BindVertexBuffers& bvb) override;
+
+    protected:
+        virtual ~PackTextures();
+
+        struct Texture
+        {
+            ref_ptr<Data> image;
+            ref_ptr<Sampler> sampler;
+            std::set<DescriptorImage*> descriptorImages;
+            bool valid = true;
+            bool packed = false;
+            vec2 texCoordScale = {1.0f, 1.0f};
+            vec2 texCoordOffset = {0.0f, 0.0f};
+        };
+
+        Texture* _texture(const DescriptorSet& descriptorSet, bool& unpackable);
+        bool _packable(const ImageInfo& imageInfo) const;
+        void _texCoords(const BufferInfoList& arrays);
+        void _invalidateConflicts();
+        void _packTextures(const std::vector<Texture*>& textures);
+
+        std::map<const Data*, Texture> _textures;
+        std::map<ref_ptr<vec2Array>, std::set<Texture*>> _texCoordUsers;
+        std::set<std::pair<const Node*, const Texture*>> _visited;
+        Texture* _current = nullptr;
+    };
+    VSG_type_name(vsg::PackTextures);
+
+} // namespace vsg
@@ -0,0 +1,85 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/maths/box.h>
+
+#include <map>
+
+namespace vsg
+{
+
+    /// PartitionGroups rebuilds wide Groups, such as the flat Groups with many thousands of children that loaders often produce, into a bounding volume hierarchy of CullGroups
+    /// so that the RecordTraversal culls whole regions at a time rather than testing every child, making culling logarithmic rather than linear in the number of children.
+    /// The bounds of each child are computed with ComputeBounds and the hierarchy is built by recursively splitting the children using the surface area heuristic,
+    /// or at the median along the longest axis when useSurfaceAreaHeuristic is false.
+    /// Only Groups of exactly type Group are partitioned, and only when all their children have valid bounds and none are Commands, as the partitioning changes the order children are traversed in.
+    /// Nodes that are reached via more than one path through the scene graph, and all nodes beneath them, are not modified.
+    ///
+    /// Usage:
+    ///     vsg::PartitionGroups partitionGroups;
+    ///     partitionGroups.partition(scene);
+    class VSG_DECLSPEC PartitionGroups : public Inherit<Visitor, PartitionGroups>
+    {
+    public:
+        PartitionGroups();
+
+        /// Groups with more children than minChildren are partitioned.
+        uint32_t minChildren = 64;
+
+        /// maximum number of children of the CullGroups at the leaves of the hierarchy.
+        uint32_t maxLeafChildren = 8;
+
+        /// split using the surface area heuristic, otherwise split at the median of the longest axis.
+        bool useSurfaceAreaHeuristic = true;
+
+        /// number of bins used to evaluate the surface area heuristic along each axis.
+        uint32_t numBins = 16;
+
+        // statistics of the changes made
+        uint32_t numGroupsPartitioned = 0;
+        uint32_t numCullGroupsCreated = 0;
+
+        /// partition the subgraph, node itself is never replaced.
+        void partition(Node& node);
+
+        /// write out the statistics of the changes made
+        void report(LogOutput& output) const;
+
+        void apply(Node& node) override;
+        void apply(Group& group) override;
+
+    protected:
+        virtual ~PartitionGroups();
+
+        struct Item
+        {
+            ref_ptr<Node> node;
+            dbox bounds;
+            dvec3 centroid;
+        };
+        using Items = std::vector<Item>;
+
+        void _partition(Group& group);
+        ref_ptr<Node> _build(Items::iterator begin, Items::iterator end);
+        Items::iterator _split(Items::iterator begin, Items::iterator end, const dbox& centroidBounds);
+        bool _isShared(const Node* node) const;
+
+        std::map<const Node*, uint32_t> _parentCounts;
+    };
+    VSG_type_name(vsg::PartitionGroups);
+
+} // namespace vsg
@@ -0,0 +1,37 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Value.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/utils/ShaderSet.h>
+#include <vsg/utils/SharedObjects.h>
+
+namespace vsg
+{
+
+    /// create a ShaderSet for drawing the chunks of a PointCloud as round points, sized on screen by the spacing between the points of each chunk.
+    /// The "pointCloudSettings" uniform is a vec4 of the point size scale, the minimum and maximum point sizes in pixels, and the viewport height in pixels.
+    /// Point sizes larger than 1 pixel require the largePoints device feature to be enabled.
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createPointCloudShaderSet(ref_ptr<const Options> options = {});
+
+    /// create a StateGroup, to be placed above a PointCloud, with the GraphicsPipeline and pointCloudSettings descriptor for drawing the chunks created by createPointCloudChunk(..).
+    /// The settings are a vec4 of the point size scale, the minimum and maximum point sizes in pixels, and the viewport height in pixels, which should be updated when the viewport is resized.
+    extern VSG_DECLSPEC ref_ptr<StateGroup> createPointCloudStateGroup(ref_ptr<vec4Value> settings, ref_ptr<const Options> options = {}, ref_ptr<SharedObjects> sharedObjects = {});
+
+    /// create a chunk of points for a PointCloudTile, spacing is the average distance between the points in the chunk's coordinate frame, halving with each level of the octree.
+    /// Chunks written to file for paging must follow the same layout of arrays to be drawn with the StateGroup from createPointCloudStateGroup(..).
+    extern VSG_DECLSPEC ref_ptr<Node> createPointCloudChunk(ref_ptr<vec3Array> vertices, ref_ptr<ubvec4Array> colors, float spacing);
+
+} // namespace vsg
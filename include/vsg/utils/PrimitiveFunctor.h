@@ -13,166 +13,237 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/io/Logger.h>
+#include <vsg/maths/vec3.h>
 #include <vsg/vk/vulkan.h>
 
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
 namespace vsg
 {
 
-    /** template helper class that decomposed draw(..) and drawIndexed(..) calls into individual points, lines or triangles.*/
+    /// index accessors used by PrimitiveFunctor, the primitive loops are instantiated for each so that index fetches compile down to a plain load or increment.
+    namespace primitive_indices
+    {
+        /// the vertex indices of a non indexed draw.
+        struct Sequential
+        {
+            uint32_t operator[](uint32_t i) const { return i; }
+        };
+
+        /// indices tightly packed in memory, the common case for index arrays.
+        template<typename V>
+        struct Contiguous
+        {
+            const V* data;
+            uint32_t operator[](uint32_t i) const { return static_cast<uint32_t>(data[i]); }
+        };
+
+        /// indices in an array with a stride larger than the index type.
+        template<class A>
+        struct Strided
+        {
+            const A& array;
+            uint32_t operator[](uint32_t i) const { return static_cast<uint32_t>(array.at(i)); }
+        };
+
+        /// true if T provides a triangles(const uivec3* triangles, uint32_t count) method for processing batches of triangles.
+        template<class T, typename = void>
+        struct has_triangles : std::false_type
+        {
+        };
+
+        template<class T>
+        struct has_triangles<T, std::void_t<decltype(std::declval<T&>().triangles(std::declval<const uivec3*>(), uint32_t{}))>> : std::true_type
+        {
+        };
+    } // namespace primitive_indices
+
+    /** template helper class that decomposed draw(..) and drawIndexed(..) calls into individual points, lines or triangles.
+      * T must provide instance(uint32_t), point(i0), line(i0, i1) and triangle(i0, i1, i2) methods, if T also provides triangles(const uivec3*, uint32_t count)
+      * the triangles are passed to it in blocks of up to triangleBatchSize, allowing T to process several triangles at once.*/
     template<class T>
     struct PrimitiveFunctor : public T
     {
+        static constexpr uint32_t triangleBatchSize = 32;
+
         template<typename... Args>
         PrimitiveFunctor(Args&&... args) :
             T(std::forward<Args>(args)...) {}
 
         void draw(VkPrimitiveTopology topology, uint32_t firstVertex, uint32_t vertexCount, uint32_t firstInstance, uint32_t instanceCount)
         {
-            uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
-            for (uint32_t inst = firstInstance; inst < lastIndex; ++inst)
+            if (!primitives(topology, primitive_indices::Sequential{}, firstVertex, firstVertex + vertexCount, firstInstance, instanceCount))
+            {
+                warn("PrimitiveFunctor::draw(topology = ", topology, ", ...) not implemented.");
+            }
+        }
+
+        template<class IndexArray>
+        void drawIndexed(VkPrimitiveTopology topology, IndexArray indices, uint32_t firstIndex, uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount)
+        {
+            if (!indices) return;
+
+            using array_type = std::decay_t<decltype(*indices)>;
+            using value_type = typename array_type::value_type;
+
+            // clamp to the indices available so the loops needn't check
+            uint32_t endIndex = std::min(firstIndex + indexCount, static_cast<uint32_t>(indices->size()));
+            if (firstIndex >= endIndex) return;
+
+            bool supported = false;
+            if (indices->stride() == sizeof(value_type))
+                supported = primitives(topology, primitive_indices::Contiguous<value_type>{indices->data()}, firstIndex, endIndex, firstInstance, instanceCount);
+            else
+                supported = primitives(topology, primitive_indices::Strided<array_type>{*indices}, firstIndex, endIndex, firstInstance, instanceCount);
+
+            if (!supported)
             {
-                if (!T::instance(inst)) continue;
+                warn("PrimitiveFunctor::drawIndexed(topology = ", topology, ", ...) not implemented.");
+            }
+        }
+
+    protected:
+        /// collects triangles into blocks when T supports batches, otherwise passes each triangle straight to T::triangle(..)
+        struct TriangleBatch
+        {
+            T& functor;
+            uivec3 triangles[triangleBatchSize];
+            uint32_t count = 0;
 
-                switch (topology)
+            void add(uint32_t i0, uint32_t i1, uint32_t i2)
+            {
+                if constexpr (primitive_indices::has_triangles<T>::value)
                 {
-                case (VK_PRIMITIVE_TOPOLOGY_POINT_LIST): {
-                    uint32_t endVertex = firstVertex + vertexCount;
-                    for (uint32_t i = firstVertex; i < endVertex; ++i)
-                    {
-                        T::point(i);
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_LINE_LIST): {
-                    // primitive restart not yet supported.
-                    uint32_t primitiveCount = vertexCount / 2;
-                    uint32_t endVertex = firstVertex + primitiveCount * 2;
-                    for (uint32_t i = firstVertex; i < endVertex; i += 2)
-                    {
-                        T::line(i, i + 1);
-                    }
-                    break;
+                    triangles[count++].set(i0, i1, i2);
+                    if (count == triangleBatchSize) flush();
                 }
-                case (VK_PRIMITIVE_TOPOLOGY_LINE_STRIP): {
-                    uint32_t endVertex = firstVertex + ((vertexCount >= 2) ? (vertexCount - 1) : 0);
-                    for (uint32_t i = firstVertex; i < endVertex; ++i)
-                    {
-                        T::line(i, i + 1);
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST): {
-                    uint32_t primtiveCount = vertexCount / 3;
-                    uint32_t endVertex = firstVertex + primtiveCount * 3;
-                    for (uint32_t i = firstVertex; i < endVertex; i += 3)
-                    {
-                        T::triangle(i, i + 1, i + 2);
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP): {
-                    // primitive restart not yet supported.
-                    uint32_t endVertex = firstVertex + ((vertexCount >= 3) ? (vertexCount - 2) : 0);
-                    for (uint32_t i = firstVertex; i < endVertex; ++i)
-                    {
-                        T::triangle(i, i + 1, i + 2); // do we need to reverse the i+1 and i+2 order on odd triangles?
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN): {
-                    // primitive restart not yet supported.
-                    uint32_t endVertex = firstVertex + ((vertexCount >= 3) ? (vertexCount - 2) : 0);
-                    for (uint32_t i = firstVertex + 1; i < endVertex; ++i)
-                    {
-                        T::triangle(firstVertex, i + 1, i + 2);
-                    }
-                    break;
+                else
+                {
+                    functor.triangle(i0, i1, i2);
                 }
-                case (VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY):
-                case (VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY):
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY):
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY):
-                case (VK_PRIMITIVE_TOPOLOGY_PATCH_LIST):
-                default:
-                    warn("PrimitiveFunctor::draw(topology = ", topology, ", ...) not implemented.");
-                    break;
+            }
+
+            void flush()
+            {
+                if constexpr (primitive_indices::has_triangles<T>::value)
+                {
+                    if (count > 0) functor.triangles(triangles, count);
                 }
+                count = 0;
+            }
+        };
+
+        /// select the primitive loop for the topology once, then run it for each instance. Returns false if the topology isn't supported.
+        template<class Indices>
+        bool primitives(VkPrimitiveTopology topology, const Indices& indices, uint32_t begin, uint32_t end, uint32_t firstInstance, uint32_t instanceCount)
+        {
+            switch (topology)
+            {
+            case (VK_PRIMITIVE_TOPOLOGY_POINT_LIST):
+                instances(firstInstance, instanceCount, [&]() { pointList(indices, begin, end); });
+                return true;
+            case (VK_PRIMITIVE_TOPOLOGY_LINE_LIST):
+                instances(firstInstance, instanceCount, [&]() { lineList(indices, begin, end); });
+                return true;
+            case (VK_PRIMITIVE_TOPOLOGY_LINE_STRIP):
+                instances(firstInstance, instanceCount, [&]() { lineStrip(indices, begin, end); });
+                return true;
+            case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST):
+                instances(firstInstance, instanceCount, [&]() { triangleList(indices, begin, end); });
+                return true;
+            case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP):
+                instances(firstInstance, instanceCount, [&]() { triangleStrip(indices, begin, end); });
+                return true;
+            case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN):
+                instances(firstInstance, instanceCount, [&]() { triangleFan(indices, begin, end); });
+                return true;
+            case (VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY):
+            case (VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY):
+            case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY):
+            case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY):
+            case (VK_PRIMITIVE_TOPOLOGY_PATCH_LIST):
+            default:
+                return false;
             }
         }
 
-        template<class IndexArray>
-        void drawIndexed(VkPrimitiveTopology topology, IndexArray indices, uint32_t firstIndex, uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount)
+        template<typename F>
+        void instances(uint32_t firstInstance, uint32_t instanceCount, F primitiveLoop)
         {
             uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
             for (uint32_t inst = firstInstance; inst < lastIndex; ++inst)
             {
-                if (!T::instance(inst)) continue;
+                if (T::instance(inst)) primitiveLoop();
+            }
+        }
 
-                switch (topology)
-                {
-                case (VK_PRIMITIVE_TOPOLOGY_POINT_LIST): {
-                    uint32_t endIndex = firstIndex + indexCount;
-                    for (uint32_t i = firstIndex; i < endIndex; ++i)
-                    {
-                        T::point(indices->at(i));
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_LINE_LIST): {
-                    uint32_t primtiveCount = indexCount / 2;
-                    uint32_t endIndex = firstIndex + primtiveCount * 2;
-                    for (uint32_t i = firstIndex; i < endIndex; i += 2)
-                    {
-                        T::line(indices->at(i), indices->at(i + 1));
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_LINE_STRIP): {
-                    // primitive restart not yet supported.
-                    uint32_t endIndex = firstIndex + ((indexCount >= 2) ? (indexCount - 1) : 0);
-                    for (uint32_t i = firstIndex; i < endIndex; ++i)
-                    {
-                        T::line(indices->at(i), indices->at(i + 1));
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST): {
-                    uint32_t primtiveCount = indexCount / 3;
-                    uint32_t endIndex = firstIndex + primtiveCount * 3;
-                    for (uint32_t i = firstIndex; i < endIndex; i += 3)
-                    {
-                        T::triangle(indices->at(i), indices->at(i + 1), indices->at(i + 2));
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP): {
-                    // primitive restart not yet supported.
-                    uint32_t endIndex = firstIndex + ((indexCount >= 3) ? (indexCount - 2) : 0);
-                    for (uint32_t i = firstIndex; i < endIndex; ++i)
-                    {
-                        T::triangle(indices->at(i), indices->at(i + 1), indices->at(i + 2)); // do we need to reverse the i+1 and i+2 order on odd triangles?
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN): {
-                    // primitive restart not yet supported.
-                    uint32_t endIndex = firstIndex + ((indexCount >= 3) ? (indexCount - 2) : 0);
-                    for (uint32_t i = firstIndex + 1; i < endIndex; ++i)
-                    {
-                        T::triangle(indices->at(firstIndex), indices->at(i + 1), indices->at(i + 2));
-                    }
-                    break;
-                }
-                case (VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY):
-                case (VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY):
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY):
-                case (VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY):
-                case (VK_PRIMITIVE_TOPOLOGY_PATCH_LIST):
-                default:
-                    warn("PrimitiveFunctor::drawIndexed(topology = ", topology, ", ...) not implemented.");
-                    break;
-                }
+        template<class Indices>
+        void pointList(const Indices& indices, uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                T::point(indices[i]);
+            }
+        }
+
+        template<class Indices>
+        void lineList(const Indices& indices, uint32_t begin, uint32_t end)
+        {
+            // primitive restart not yet supported.
+            uint32_t endLine = begin + ((end - begin) / 2) * 2;
+            for (uint32_t i = begin; i < endLine; i += 2)
+            {
+                T::line(indices[i], indices[i + 1]);
+            }
+        }
+
+        template<class Indices>
+        void lineStrip(const Indices& indices, uint32_t begin, uint32_t end)
+        {
+            // primitive restart not yet supported.
+            for (uint32_t i = begin; (i + 1) < end; ++i)
+            {
+                T::line(indices[i], indices[i + 1]);
+            }
+        }
+
+        template<class Indices>
+        void triangleList(const Indices& indices, uint32_t begin, uint32_t end)
+        {
+            TriangleBatch batch{*this};
+            uint32_t endTriangle = begin + ((end - begin) / 3) * 3;
+            for (uint32_t i = begin; i < endTriangle; i += 3)
+            {
+                batch.add(indices[i], indices[i + 1], indices[i + 2]);
+            }
+            batch.flush();
+        }
+
+        template<class Indices>
+        void triangleStrip(const Indices& indices, uint32_t begin, uint32_t end)
+        {
+            // primitive restart not yet supported.
+            TriangleBatch batch{*this};
+            for (uint32_t i = begin; (i + 2) < end; ++i)
+            {
+                batch.add(indices[i], indices[i + 1], indices[i + 2]); // do we need to reverse the i+1 and i+2 order on odd triangles?
+            }
+            batch.flush();
+        }
+
+        template<class Indices>
+        void triangleFan(const Indices& indices, uint32_t begin, uint32_t end)
+        {
+            // primitive restart not yet supported.
+            TriangleBatch batch{*this};
+            uint32_t center = indices[begin];
+            for (uint32_t i = begin + 1; (i + 1) < end; ++i)
+            {
+                batch.add(center, indices[i], indices[i + 1]);
             }
+            batch.flush();
         }
     };
 
@@ -0,0 +1,68 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Data.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/utils/CoordinateSpace.h>
+
+namespace vsg
+{
+
+    /// copy count pixels of sourceSize bytes to pixels of targetSize bytes, filling the extra bytes of each target pixel from defaultValue.
+    /// The 8 bit RGB to RGBA expansion used when mapping RGB formats to RGBA is vectorized.
+    extern VSG_DECLSPEC void expandPixels(const uint8_t* source, uint32_t sourceSize, uint8_t* target, uint32_t targetSize, const uint8_t* defaultValue, size_t count);
+
+    /// convert the color components of count 8 bit per component pixels between sRGB and linear, leaving the components after numColorComponents, such as alpha, unchanged.
+    extern VSG_DECLSPEC void convertColorSpace(uint8_t* pixels, size_t count, uint32_t numComponents, uint32_t numColorComponents, CoordinateSpace source, CoordinateSpace target);
+
+    /// multiply the color components of count 8 bit RGBA or BGRA pixels by their alpha.
+    extern VSG_DECLSPEC void premultiplyAlpha(uint8_t* pixels, size_t count);
+
+    /// box filter a width x height image of 8 bit per component pixels to a max(width/2, 1) x max(height/2, 1) image,
+    /// sRGB images are filtered in linear space with the 4th component treated as linear alpha.
+    extern VSG_DECLSPEC void downsample(const uint8_t* source, uint32_t width, uint32_t height, uint32_t numComponents, bool sRGB, uint8_t* target);
+
+    /// ProcessImages prepares the 8 bit per component R, RG, RGB and RGBA 2D images of loaded subgraphs for upload, expanding RGB to RGBA,
+    /// premultiplying alpha and generating mipmaps on the CPU, so the conversions are done on the thread loading the data rather than
+    /// when the images are transferred during the frame.
+    /// Can be used directly, or assigned to Options::processImages so vsg::read(..) and the DatabasePager apply it to the textures of the subgraphs loaded.
+    class VSG_DECLSPEC ProcessImages : public Inherit<Object, ProcessImages>
+    {
+    public:
+        ProcessImages();
+
+        /// expand RGB images to RGBA, matching the RGBA format vsg::Image maps RGB formats to as RGB formats are rarely supported as sampled images.
+        bool mapRGBtoRGBA = true;
+
+        /// multiply the color components of RGBA images by alpha, for use with premultiplied alpha blending.
+        bool premultiplyAlpha = false;
+
+        /// generate the mipmap levels required by the Sampler on the CPU rather than with vkCmdBlitImage when the image is transferred.
+        bool generateMipmaps = false;
+
+        /// return a processed version of image containing mipLevels mipmap levels, or null if image doesn't require processing or isn't supported.
+        ref_ptr<Data> process(const Data& image, uint32_t mipLevels = 1) const;
+
+        /// replace the images of the DescriptorImage in the object's subgraph with processed versions.
+        void apply(Object& object) const;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~ProcessImages();
+    };
+    VSG_type_name(vsg::ProcessImages);
+
+} // namespace vsg
@@ -15,14 +15,23 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/stream.h>
 #include <vsg/state/QueryPool.h>
 #include <vsg/ui/FrameStamp.h>
+#include <vsg/utils/FrameStatistics.h>
 #include <vsg/utils/Instrumentation.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace vsg
 {
+    /// ProfileLog records the enter/leave entries of the Profiler to per thread ring buffers, each only written to by its own thread so that recording
+    /// doesn't contend on shared state, with the entries of all threads merged by report().
     class VSG_DECLSPEC ProfileLog : public Inherit<Object, ProfileLog>
     {
     public:
-        explicit ProfileLog(size_t size = 16384);
+        /// size is the number of entries in each thread's ring buffer, maxThreads the maximum number of threads with their own ring buffer,
+        /// further threads share the last thread's ring buffer.
+        explicit ProfileLog(size_t size = 16384, uint32_t maxThreads = 64);
 
         enum Type : uint8_t
         {
@@ -45,15 +54,46 @@ namespace vsg
             std::thread::id thread_id = {};
         };
 
+        /// ring buffer of the entries recorded by a single thread
+        struct ThreadLog
+        {
+            std::thread::id thread_id;
+            uint64_t threadIndex = 0;
+            std::vector<Entry> entries;
+            std::atomic_uint64_t index = 0;
+        };
+
+        /// references hold the index of the ThreadLog in the top bits and the index of the entry in the ThreadLog in the remaining bits.
+        static constexpr uint64_t threadShift = 48;
+        static constexpr uint64_t entryMask = (uint64_t(1) << threadShift) - 1;
+
         std::map<std::thread::id, std::string> threadNames;
-        std::vector<Entry> entries;
-        std::atomic_uint64_t index = 0;
+        std::vector<std::unique_ptr<ThreadLog>> threadLogs;
+        std::atomic_uint32_t numThreadLogs = 0;
+        size_t size = 16384;
         std::vector<uint64_t> frameIndices;
         double timestampScaleToMilliseconds = 1e-6;
 
+        /// pipeline statistics query results of an instrumented command buffer, values are in the order of the bits set in flags.
+        struct PipelineStatistics
+        {
+            VkQueryPipelineStatisticFlags flags = 0;
+            std::vector<uint64_t> values;
+        };
+
+        /// pipeline statistics results mapped to the reference of the command buffer's enter entry.
+        std::map<uint64_t, PipelineStatistics> pipelineStatistics;
+
+        /// get the ThreadLog for the calling thread, creating it on first use.
+        ThreadLog& threadLog();
+
+        /// assign the name of the calling thread used in reports.
+        void setThreadName(const std::string& name);
+
         Entry& enter(uint64_t& reference, Type type)
         {
-            reference = index.fetch_add(1);
+            auto& log = threadLog();
+            reference = (log.threadIndex << threadShift) | log.index.fetch_add(1, std::memory_order_relaxed);
             Entry& enter_entry = entry(reference);
             enter_entry.enter = true;
             enter_entry.type = type;
@@ -68,7 +108,8 @@ namespace vsg
         {
             Entry& enter_entry = entry(reference);
 
-            uint64_t new_reference = index.fetch_add(1);
+            auto& log = threadLog();
+            uint64_t new_reference = (log.threadIndex << threadShift) | log.index.fetch_add(1, std::memory_order_relaxed);
             Entry& leave_entry = entry(new_reference);
 
             enter_entry.reference = new_reference;
@@ -84,15 +125,22 @@ namespace vsg
 
         Entry& entry(uint64_t reference)
         {
-            return entries[reference % entries.size()];
+            return threadLogs[reference >> threadShift]->entries[(reference & entryMask) % size];
         }
 
+        /// return true if the entry for reference hasn't yet been overwritten by the wrapping around of its ThreadLog.
+        bool valid(uint64_t reference) const;
+
         void report(std::ostream& out);
         uint64_t report(std::ostream& out, uint64_t reference);
 
     public:
         void read(Input& input) override;
         void write(Output& output) const override;
+
+    protected:
+        std::mutex _mutex;
+        uint64_t _logID = 0;
     };
     VSG_type_name(ProfileLog);
 
@@ -107,6 +155,15 @@ namespace vsg
         std::vector<uint64_t> timestamps;
 
         void writeGpuTimestamp(CommandBuffer& commandBuffer, uint64_t reference, VkPipelineStageFlagBits pipelineStage);
+
+        /// optional pipeline statistics query covering the whole of an instrumented primary command buffer
+        mutable ref_ptr<QueryPool> statisticsQueryPool;
+        bool statisticsQueryActive = false;
+        uint64_t statisticsReference = 0;
+        std::vector<uint64_t> statistics;
+
+        void beginPipelineStatistics(CommandBuffer& commandBuffer, uint64_t reference);
+        void endPipelineStatistics(CommandBuffer& commandBuffer);
     };
     VSG_type_name(GPUStatsCollection);
 
@@ -117,8 +174,10 @@ namespace vsg
         {
             unsigned int cpu_instrumentation_level = 1;
             unsigned int gpu_instrumentation_level = 1;
-            uint32_t log_size = 16384;
+            uint32_t log_size = 16384; // number of log entries per thread
+            uint32_t max_threads = 64; // number of threads with their own log entries
             uint32_t gpu_timestamp_size = 1024;
+            VkQueryPipelineStatisticFlags pipeline_statistics = 0; // pipeline statistics to query for each instrumented primary command buffer, requires the pipelineStatisticsQuery device feature
         };
 
         explicit Profiler(ref_ptr<Settings> in_settings = {});
@@ -126,6 +185,11 @@ namespace vsg
         ref_ptr<Settings> settings;
         mutable ref_ptr<ProfileLog> log;
 
+        /// optional FrameStatistics that collects "frame cpu ms" and "<name> cpu ms"/"<name> gpu ms" histograms for each instrumented
+        /// command buffer, "<name> <statistic>" histograms for the enabled pipeline statistics, gauges for the values passed to plot(..),
+        /// and is advanced at the end of each frame.
+        ref_ptr<FrameStatistics> statistics;
+
         /// resources for collecting GPU stats for all devices for a single frame
         struct FrameStatsCollection
         {
@@ -153,6 +217,8 @@ namespace vsg
         void enter(const SourceLocation* /*sl*/, uint64_t& /*reference*/, CommandBuffer& /*commandBuffer*/, const Object* /*object*/ = nullptr) const override;
         void leave(const SourceLocation* /*sl*/, uint64_t& /*reference*/, CommandBuffer& /*commandBuffer*/, const Object* /*object*/ = nullptr) const override;
 
+        void plot(const char* /*name*/, double /*value*/) const override;
+
         void finish() const override;
     };
     VSG_type_name(Profiler);
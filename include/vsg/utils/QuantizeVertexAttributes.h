@@ -0,0 +1,101 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/maths/mat4.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/state/GraphicsPipeline.h>
+
+#include <map>
+#include <set>
+
+namespace vsg
+{
+
+    /// QuantizeVertexAttributes reduces the vertex memory and bandwidth of static geometry by converting the float vertex arrays of
+    /// VertexIndexDraw, VertexDraw and Geometry nodes to 16 bit formats that the GPU's vertex fetch decodes back to floats:
+    ///   vertices (location 0) to VK_FORMAT_R16G16B16A16_SNORM, with the draw placed under a MatrixTransform that maps the snorm range back to the original bounds,
+    ///   normals (location 1) to octahedral encoded VK_FORMAT_R16G16_SNORM, when the vertex shader supports the VSG_OCTAHEDRAL_NORMAL define as the flat, phong and pbr ShaderSet do,
+    ///   texture coordinates (locations 2 to 5) to VK_FORMAT_R16G16_SFLOAT half floats.
+    /// The location layout follows the vsg::Builder and the flat, phong and pbr ShaderSet. The GraphicsPipeline bound by the parent StateGroups have their VertexInputState
+    /// updated to match, so all the draws using a GraphicsPipeline have an attribute converted or none do. Vertex arrays that are dynamic, interleaved, per instance or not of the expected type are left unchanged.
+    /// Must be applied before the scene graph is compiled.
+    class VSG_DECLSPEC QuantizeVertexAttributes : public Inherit<Visitor, QuantizeVertexAttributes>
+    {
+    public:
+        QuantizeVertexAttributes();
+
+        /// convert vertices to VK_FORMAT_R16G16B16A16_SNORM with a dequantizing MatrixTransform
+        bool quantizeVertices = true;
+
+        /// convert normals to octahedral encoded VK_FORMAT_R16G16_SNORM
+        bool encodeNormals = true;
+
+        /// convert texture coordinates to VK_FORMAT_R16G16_SFLOAT
+        bool halfFloatTexCoords = true;
+
+        // statistics of the changes made
+        uint32_t numArraysConverted = 0;
+        uint32_t numPipelinesUpdated = 0;
+        uint64_t numBytesBefore = 0;
+        uint64_t numBytesAfter = 0;
+
+        /// convert the vertex arrays in the subgraph, node itself is never replaced.
+        void quantize(Node& node);
+
+        /// write out the statistics of the changes made
+        void report(LogOutput& output) const;
+
+        /// convert vertices to 16 bit snorm values relative to the vertices bounds, with matrix set to the dequantizing transform.
+        static ref_ptr<svec4Array> quantizeVertexArray(const vec3Array& vertices, dmat4& matrix);
+
+        /// convert unit length normals to octahedral encoded 16 bit snorm values
+        static ref_ptr<svec2Array> encodeNormalArray(const vec3Array& normals);
+
+        /// convert texture coordinates to half floats
+        static ref_ptr<usvec2Array> halfFloatTexCoordArray(const vec2Array& texCoords);
+
+        void apply(Node& node) override;
+        void apply(Group& group) override;
+        void apply(StateGroup& stateGroup) override;
+        void apply(VertexIndexDraw& vid) override;
+        void apply(VertexDraw& vd) override;
+        void apply(Geometry& geometry) override;
+
+    protected:
+        virtual ~QuantizeVertexAttributes();
+
+        struct Draw
+        {
+            Node* node = nullptr;
+            uint32_t firstBinding = 0;
+            BufferInfoList* arrays = nullptr;
+            Group* parent = nullptr;
+            size_t childIndex = 0;
+        };
+
+        void _collect(Node& node, uint32_t firstBinding, BufferInfoList& arrays);
+        void _convert(GraphicsPipeline& pipeline, std::vector<Draw>& draws);
+
+        Group* _parent = nullptr;
+        size_t _childIndex = 0;
+        std::vector<GraphicsPipeline*> _pipelineStack;
+        std::map<GraphicsPipeline*, std::vector<Draw>> _draws;
+        std::set<const Node*> _visited;
+    };
+    VSG_type_name(vsg::QuantizeVertexAttributes);
+
+} // namespace vsg
@@ -25,9 +25,15 @@ namespace vsg
         // default ShaderCompileSettings
         ref_ptr<ShaderCompileSettings> defaults;
 
+        /// compile the shaders to SPIR-V. If options->fileCache is set the SPIR-V is read from, and written to, a cache in the fileCache/spirv directory
+        /// keyed by a hash of the shader sources with includes and defines inserted, and the ShaderCompileSettings, so later runs can skip compilation.
         bool compile(ShaderStages& shaders, const std::vector<std::string>& defines = {}, ref_ptr<const Options> options = {});
         bool compile(ref_ptr<ShaderStage> shaderStage, const std::vector<std::string>& defines = {}, ref_ptr<const Options> options = {});
 
+        /// compile a batch of ShaderStages, such as the variants of a ShaderSet, with each ShaderStages compiled in parallel when options->operationThreads is assigned.
+        /// Returns true if all the ShaderStages compiled successfully.
+        bool compileBatch(std::vector<ShaderStages>& batch, const std::vector<std::string>& defines = {}, ref_ptr<const Options> options = {});
+
         std::string combineSourceAndDefines(const std::string& source, const std::vector<std::string>& defines);
 
         void apply(Node& node) override;
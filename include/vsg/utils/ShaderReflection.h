@@ -0,0 +1,128 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/state/PipelineLayout.h>
+#include <vsg/state/ShaderStage.h>
+#include <vsg/state/VertexInputState.h>
+#include <vsg/utils/SharedObjects.h>
+
+#include <map>
+#include <mutex>
+
+namespace vsg
+{
+
+    // forward declare
+    class ShaderSet;
+
+    /// ShaderReflection holds the descriptor bindings, vertex attributes and push constant block declared by a SPIR-V module, gathered by parsing the SPIR-V
+    /// decorations and types directly so no external reflection library is required. Only the resources that the shader declares are reported, whether or not
+    /// the entry points statically use them, and runtime sized descriptor arrays are reported with a descriptorCount of 1.
+    class VSG_DECLSPEC ShaderReflection : public Inherit<Object, ShaderReflection>
+    {
+    public:
+        ShaderReflection();
+        explicit ShaderReflection(const ShaderModule::SPIRV& code);
+
+        struct DescriptorBinding
+        {
+            std::string name;
+            uint32_t set = 0;
+            uint32_t binding = 0;
+            VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_MAX_ENUM;
+            uint32_t descriptorCount = 1;
+            bool runtimeArray = false;
+        };
+
+        struct VertexAttribute
+        {
+            std::string name;
+            uint32_t location = 0;
+            VkFormat format = VK_FORMAT_UNDEFINED;
+        };
+
+        /// stages of the entry points declared by the module
+        VkShaderStageFlags stageFlags = 0;
+
+        /// descriptor bindings sorted by set and binding
+        std::vector<DescriptorBinding> descriptorBindings;
+
+        /// vertex shader inputs sorted by location, matrix inputs are reported as one attribute per column
+        std::vector<VertexAttribute> vertexAttributes;
+
+        /// size in bytes of the push constant block, 0 if the module has none
+        uint32_t pushConstantSize = 0;
+
+        /// true if the SPIR-V was parsed successfully
+        bool valid = false;
+
+        /// parse the SPIR-V, replacing any previous results, return true on success.
+        bool reflect(const ShaderModule::SPIRV& code);
+
+    protected:
+        virtual ~ShaderReflection();
+    };
+    VSG_type_name(vsg::ShaderReflection);
+
+    /// ReflectedLayoutCache derives the DescriptorSetLayout, PipelineLayout and VertexInputState required by ShaderStages from the reflected SPIR-V,
+    /// caching the ShaderReflection of each module by the hash of its SPIR-V so that modules that are reused, or loaded multiple times, are only parsed once.
+    /// The layouts are shared through sharedObjects so pipelines that use compatible shaders end up with the same layout objects. Thread safe.
+    class VSG_DECLSPEC ReflectedLayoutCache : public Inherit<Object, ReflectedLayoutCache>
+    {
+    public:
+        explicit ReflectedLayoutCache(ref_ptr<SharedObjects> in_sharedObjects = {});
+
+        /// SharedObjects used to share the DescriptorSetLayout, PipelineLayout and VertexInputState created, a SharedObjects is created if none is assigned.
+        ref_ptr<SharedObjects> sharedObjects;
+
+        /// get the ShaderReflection of the module, returns null if the module has no SPIR-V, compile GLSL source first with ShaderCompiler.
+        ref_ptr<ShaderReflection> reflect(const ShaderModule& module);
+
+        /// get the DescriptorSetLayoutBindings of the specified set merged across all stages.
+        DescriptorSetLayoutBindings getDescriptorSetLayoutBindings(const ShaderStages& stages, uint32_t set);
+
+        /// get or create the DescriptorSetLayout of the specified set merged across all stages.
+        ref_ptr<DescriptorSetLayout> getOrCreateDescriptorSetLayout(const ShaderStages& stages, uint32_t set);
+
+        /// get or create the PipelineLayout with descriptor set layouts for sets 0 to the highest set used, and a push constant range covering the stages that declare a push constant block.
+        ref_ptr<PipelineLayout> getOrCreatePipelineLayout(const ShaderStages& stages);
+
+        /// get or create a VertexInputState for the vertex stage inputs, one binding per attribute with the binding number matching the attribute location.
+        ref_ptr<VertexInputState> getOrCreateVertexInputState(const ShaderStages& stages, VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX);
+
+        /// add the attribute, descriptor and push constant bindings reflected from the ShaderSet's stages that it doesn't already declare, so hand written ShaderSet
+        /// only need to assign defines and default data. Reflected bindings are added without a define and without data. Not thread safe with respect to the ShaderSet,
+        /// should only be called when initially setting up the ShaderSet.
+        void assignBindings(ShaderSet& shaderSet);
+
+        /// number of modules parsed and number of reflect(..) requests satisfied from the cache.
+        uint32_t numReflected = 0;
+        uint32_t numCacheHits = 0;
+
+        void clear();
+
+    protected:
+        virtual ~ReflectedLayoutCache();
+
+        using Key = std::pair<uint64_t, size_t>;
+
+        ref_ptr<ShaderReflection> _reflect(const ShaderModule& module, uint64_t& hash);
+
+        std::recursive_mutex _mutex;
+        std::map<Key, ref_ptr<ShaderReflection>> _reflections;
+        std::map<std::vector<uint64_t>, ref_ptr<PipelineLayout>> _pipelineLayouts;
+    };
+    VSG_type_name(vsg::ReflectedLayoutCache);
+
+} // namespace vsg
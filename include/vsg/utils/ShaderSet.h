@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/core/compare.h>
 #include <vsg/state/ArrayState.h>
+#include <vsg/state/BindlessDescriptors.h>
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/state/Sampler.h>
 #include <vsg/state/ShaderStage.h>
@@ -22,6 +23,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 namespace vsg
 {
 
+    // forward declare
+    class ShaderCompiler;
+
     struct VSG_DECLSPEC AttributeBinding
     {
         std::string name;
@@ -110,12 +114,35 @@ namespace vsg
     };
     VSG_type_name(vsg::ViewDependentStateBinding);
 
+    /// Custom state binding class for providing the DescriptorSetLayout and StateCommand required to bind the global texture and material arrays of a BindlessDescriptors registry.
+    struct VSG_DECLSPEC BindlessDescriptorSetBinding : public Inherit<CustomDescriptorSetBinding, BindlessDescriptorSetBinding>
+    {
+        explicit BindlessDescriptorSetBinding(uint32_t in_set = 0, ref_ptr<BindlessDescriptors> in_bindlessDescriptors = {});
+
+        int compare(const Object& rhs) const override;
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+        ref_ptr<BindlessDescriptors> bindlessDescriptors;
+
+        bool compatibleDescriptorSetLayout(const DescriptorSetLayout& dsl) const override;
+        ref_ptr<DescriptorSetLayout> createDescriptorSetLayout() override;
+        ref_ptr<StateCommand> createStateCommand(ref_ptr<PipelineLayout> layout) override;
+
+    protected:
+        std::mutex _mutex;
+        std::vector<ref_ptr<BindBindlessDescriptorSet>> _stateCommands;
+    };
+    VSG_type_name(vsg::BindlessDescriptorSetBinding);
+
     /// ShaderSet provides a collection of shader related settings to provide a form of shader introspection.
     class VSG_DECLSPEC ShaderSet : public Inherit<Object, ShaderSet>
     {
     public:
         ShaderSet();
         explicit ShaderSet(const ShaderStages& in_stages, ref_ptr<ShaderCompileSettings> in_hints = {});
+        ShaderSet(const ShaderSet& rhs, const CopyOp& copyop = {});
 
         /// base ShaderStages that other variants are based on.
         ShaderStages stages;
@@ -168,6 +195,28 @@ namespace vsg
         /// get the ShaderStages variant that uses specified ShaderCompileSettings.
         ShaderStages getShaderStages(ref_ptr<ShaderCompileSettings> scs = {});
 
+        /// bitmask of defines, each bit corresponding to a define used by the ShaderSet's bindings, push constant ranges, optional defines or DefinesArrayStates.
+        using DefinesMask = uint64_t;
+
+        /// map defines to a DefinesMask, return false if a define isn't used by the ShaderSet or the ShaderSet uses more than 64 defines.
+        /// The define registry is built on first use, call resetDefinesRegistry() after modifying the bindings directly.
+        bool definesMask(const std::set<std::string>& defines, DefinesMask& mask) const;
+
+        /// discard the define registry so that it's rebuilt from the current bindings on next use.
+        void resetDefinesRegistry();
+
+        /// get the first ArrayState that has matches with defines in the specified DefinesMask.
+        ref_ptr<ArrayState> getSuitableArrayState(DefinesMask mask) const;
+
+        /// get the ShaderStages variant that uses specified ShaderCompileSettings, whose defines must correspond to mask.
+        /// Variants are looked up by mask so only the non define settings of the ShaderCompileSettings are compared.
+        ShaderStages getShaderStages(DefinesMask mask, ref_ptr<ShaderCompileSettings> scs);
+
+        /// create the variants for every combination of the specified defines, added to the defaultShaderHints defines, and compile those that haven't been compiled yet,
+        /// so that later GraphicsPipeline compiles can reuse them. Useful for warming the shader variants and the ShaderCompiler file cache during loading screens.
+        /// The variants are compiled in parallel when options->operationThreads is assigned. Returns true if all variants compiled successfully.
+        bool precompileVariants(const std::set<std::string>& defines, ShaderCompiler& shaderCompiler, ref_ptr<const Options> options = {});
+
         /// return the <minimum_set, maximum_set+1> range of set numbers encompassing DescriptorBindings
         std::pair<uint32_t, uint32_t> descriptorSetRange() const;
 
@@ -180,9 +229,24 @@ namespace vsg
         /// return true of specified pipeline layout is compatible with what is required for this ShaderSet
         virtual bool compatiblePipelineLayout(const PipelineLayout& layout, const std::set<std::string>& defines) const;
 
+        /// return true of specified descriptor set layout is compatible with the bindings enabled by the DefinesMask.
+        bool compatibleDescriptorSetLayout(const DescriptorSetLayout& dsl, DefinesMask mask, uint32_t set) const;
+
+        /// create the descriptor set layout for the bindings enabled by the DefinesMask.
+        ref_ptr<DescriptorSetLayout> createDescriptorSetLayout(DefinesMask mask, uint32_t set) const;
+
+        /// return true of specified pipeline layout is compatible with the bindings enabled by the DefinesMask.
+        bool compatiblePipelineLayout(const PipelineLayout& layout, DefinesMask mask) const;
+
         /// create the pipeline layout for all descriptor sets enabled by specified defines or required by default.
         inline ref_ptr<PipelineLayout> createPipelineLayout(const std::set<std::string>& defines) { return createPipelineLayout(defines, descriptorSetRange()); }
 
+        /// create the pipeline layout for all descriptor sets enabled by the DefinesMask or required by default.
+        inline ref_ptr<PipelineLayout> createPipelineLayout(DefinesMask mask) { return createPipelineLayout(mask, descriptorSetRange()); }
+
+        /// create pipeline layout for specified range <minimum_set, maximum_set+1> of descriptor sets that are enabled by the DefinesMask or required by default.
+        ref_ptr<PipelineLayout> createPipelineLayout(DefinesMask mask, std::pair<uint32_t, uint32_t> range) const;
+
         /// create pipeline layout for specified range <minimum_set, maximum_set+1> of descriptor sets that are enabled by specified defines or required by default.
         ///
         /// Note: the underlying Vulkan call vkCreatePipelineLayout assumes that the array of
@@ -190,6 +254,7 @@ namespace vsg
         /// you really know what you're doing.
         virtual ref_ptr<PipelineLayout> createPipelineLayout(const std::set<std::string>& defines, std::pair<uint32_t, uint32_t> range) const;
 
+        ref_ptr<Object> clone(const CopyOp& copyop = {}) const override { return ShaderSet::create(*this, copyop); }
         int compare(const Object& rhs) const override;
 
         void read(Input& input) override;
@@ -200,6 +265,23 @@ namespace vsg
 
         AttributeBinding _nullAttributeBinding;
         DescriptorBinding _nullDescriptorBinding;
+
+        struct DefinesRegistry
+        {
+            bool valid = false;
+            std::map<std::string, uint32_t> indices;
+            std::vector<DefinesMask> descriptorBindingMasks;
+            std::vector<DefinesMask> pushConstantRangeMasks;
+            std::vector<DefinesMask> definesArrayStateMasks;
+            DefinesMask arrayStateDefines = 0;
+        };
+
+        const DefinesRegistry& _getDefinesRegistry() const;
+        ShaderStages _getShaderStages(ref_ptr<ShaderCompileSettings> scs);
+
+        mutable std::mutex _definesRegistryMutex;
+        mutable std::unique_ptr<DefinesRegistry> _definesRegistry;
+        std::map<DefinesMask, std::vector<std::pair<ref_ptr<ShaderCompileSettings>, ShaderStages>>> _variantsByMask;
     };
     VSG_type_name(vsg::ShaderSet);
 
@@ -212,4 +294,37 @@ namespace vsg
     /// create a ShaderSet for Physics Based Rendering
     extern VSG_DECLSPEC ref_ptr<ShaderSet> createPhysicsBasedRenderingShaderSet(ref_ptr<const Options> options = {});
 
+    /// create a ShaderSet for Phong shaded rendering with clustered forward lighting, derived from createPhongShaderSet() with its fragment shader extended to iterate over
+    /// the point and spot lights that ViewDependentState bins into the cluster that each fragment falls within. Use with a View whose features include CLUSTERED_LIGHTING,
+    /// assigning the ShaderSet to the View's ViewDependentState::shaderSet. The fragment shader is compiled at runtime so requires a ShaderCompiler.
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createPhongClusteredLightingShaderSet(ref_ptr<const Options> options = {});
+
+    /// create a ShaderSet for Physics Based Rendering with clustered forward lighting, see createPhongClusteredLightingShaderSet().
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createPhysicsBasedRenderingClusteredLightingShaderSet(ref_ptr<const Options> options = {});
+
+    /// create a ShaderSet derived from baseShaderSet, typically createPhongShaderSet() or createPhysicsBasedRenderingShaderSet(), with its fragment shader extended to evaluate
+    /// the shadows of directional and spot lights with vsg::RayTracedShadows by ray queries against the ViewDependentState::shadowAccelerationStructure. Assign the ShaderSet
+    /// to the View's ViewDependentState::shaderSet as well as using it for the scene graph. Requires the rayQuery device feature and a ShaderCompiler.
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createRayTracedShadowsShaderSet(ref_ptr<ShaderSet> baseShaderSet);
+
+    /// create a ShaderSet for Phong shaded rendering of vsg::Meshlets using task and mesh shaders, the task shader culls meshlets against the view frustum
+    /// and, unless VSG_TWO_SIDED_LIGHTING is defined, their normal cones. Uses the fragment shader and descriptor sets 0 and 1 of createPhongShaderSet(),
+    /// with the meshlet storage buffers in set 2. Use Meshlets::assignDescriptors(..) to assign the buffers and Meshlets::createDrawMeshTasks() to draw.
+    /// Requires the VK_EXT_mesh_shader taskShader and meshShader features and a Vulkan 1.3 capable shader compiler.
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createPhongMeshletShaderSet(ref_ptr<const Options> options = {});
+
+    /// create a ShaderSet for Physics Based Rendering of vsg::Meshlets using task and mesh shaders, see createPhongMeshletShaderSet().
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createPhysicsBasedRenderingMeshletShaderSet(ref_ptr<const Options> options = {});
+
+    /// create a ShaderSet for rendering terrain tiles as quad patches that are adaptively subdivided by tessellation shaders, with the displacementMap sampled at each generated vertex.
+    /// Uses the fragment shader, attributes and descriptor bindings of the baseShaderSet, typically createPhongShaderSet() or createFlatShadedShaderSet(). Patches are 4 control points using
+    /// vsg_Vertex, vsg_Normal, vsg_TexCoord0 and vsg_Color, edges are subdivided to approach pixelsPerEdge on screen, up to maxTessellationLevel or the resolution of the displacementMap.
+    /// Requires the tessellationShader device feature and a ShaderCompiler.
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createTessellatedTerrainShaderSet(ref_ptr<ShaderSet> baseShaderSet, float pixelsPerEdge = 16.0f, float maxTessellationLevel = 64.0f);
+
+    /// create a ShaderSet for unlit, flat shaded rendering that reads its material and diffuse texture from the arrays of a BindlessDescriptors registry.
+    /// The registry's descriptor set is bound to set 0 and its materials must be a BindlessMaterialArray. The material index is passed as a uint push constant at offset 128,
+    /// following the projection and modelView matrices, so requires a device maxPushConstantsSize of at least 132 bytes.
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createBindlessFlatShadedShaderSet(ref_ptr<BindlessDescriptors> bindlessDescriptors, ref_ptr<const Options> options = {});
+
 } // namespace vsg
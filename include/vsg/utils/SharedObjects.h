@@ -16,10 +16,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/compare.h>
 #include <vsg/io/stream.h>
 
+#include <array>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <ostream>
 #include <set>
+#include <unordered_map>
 
 namespace vsg
 {
@@ -48,6 +51,14 @@ namespace vsg
         /// visitor that checks a loaded object and its children for suitability for sharing in SharedObjects
         ref_ptr<SuitableForSharing> suitableForSharing;
 
+        /// when true share(..) and shared_default() look up objects by their Object::hash() in a sharded hash table, so most lookups need no deep compare
+        /// and threads sharing objects concurrently only contend when their objects fall in the same shard. Should be set before any objects are shared.
+        bool useObjectHashes = false;
+
+        /// when true the dynamic objects cloned for each read of a file share the loaded Arrays' values until an instance first modifies them,
+        /// saving memory when many instances of an animated model are loaded. See CopyOp::copyOnWriteData.
+        bool copyOnWriteData = false;
+
         /// set of lower case file extensions for file types that should not be included in this SharedObjects
         std::set<Path> excludedExtensions;
 
@@ -63,6 +74,13 @@ namespace vsg
         /// remove entry associated with filename.
         virtual bool remove(const Path& filename, ref_ptr<const Options> options = {});
 
+        /// wait while another thread is loading an object that compares equal to loadedObject, then mark loadedObject as being loaded.
+        /// Used by vsg::read(..) so that concurrent reads of the same file, such as external references loaded in parallel, only load the file once.
+        void beginLoad(ref_ptr<Object> loadedObject);
+
+        /// mark the load started by beginLoad(loadedObject) as complete, releasing any threads waiting on it.
+        void endLoad(ref_ptr<Object> loadedObject);
+
         /// clear all the internal structures leaving no Objects cached.
         void clear();
 
@@ -75,9 +93,36 @@ namespace vsg
     protected:
         virtual ~SharedObjects();
 
+        /// thread safe check of suitableForSharing, used by the hashed code path which doesn't hold _mutex.
+        bool _suitable(const Object* object);
+
+        /// find an object of the specified type that compares equal to object in the hash table, inserting object if no match is found and insert is true.
+        /// returns the matching object, object itself if it was inserted, or null if no match was found and insert is false.
+        ref_ptr<Object> _findHashed(const std::type_index& id, ref_ptr<Object> object, uint64_t hash, bool insert);
+
         mutable std::recursive_mutex _mutex;
         std::map<std::type_index, ref_ptr<Object>> _defaults;
         std::map<std::type_index, std::set<ref_ptr<Object>, DereferenceLess>> _sharedObjects;
+
+        struct HashedObject
+        {
+            std::type_index id;
+            ref_ptr<Object> object;
+        };
+
+        struct Shard
+        {
+            std::mutex mutex;
+            std::unordered_multimap<uint64_t, HashedObject> objects;
+        };
+
+        static constexpr size_t numShards = 32;
+        std::array<Shard, numShards> _shards;
+        std::mutex _suitableMutex;
+
+        std::mutex _pendingLoadsMutex;
+        std::condition_variable _pendingLoadsCondition;
+        std::set<ref_ptr<Object>, DereferenceLess> _pendingLoads;
     };
     VSG_type_name(vsg::SharedObjects);
 
@@ -135,6 +180,13 @@ namespace vsg
         if (!def_T)
         {
             def_T = T::create();
+            if (useObjectHashes)
+            {
+                def_T = ref_ptr<T>(static_cast<T*>(_findHashed(id, def_T, def_T->hash(), true).get()));
+                def = def_T;
+                return def_T;
+            }
+
             auto& shared_objects = _sharedObjects[id];
             if (auto itr = shared_objects.find(def_T); itr != shared_objects.end())
             {
@@ -155,6 +207,16 @@ namespace vsg
     template<class T>
     void SharedObjects::share(ref_ptr<T>& object)
     {
+        if (useObjectHashes)
+        {
+            if (!object || !_suitable(object.get())) return;
+
+            // compute the hash before taking any locks as it's the expensive part of sharing
+            auto shared = _findHashed(std::type_index(typeid(T)), object, object->hash(), true);
+            if (shared != object) object = ref_ptr<T>(static_cast<T*>(shared.get()));
+            return;
+        }
+
         std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
         if (suitableForSharing && !suitableForSharing->suitable(object.get())) return;
@@ -174,6 +236,29 @@ namespace vsg
     template<class T, typename Func>
     void SharedObjects::share(ref_ptr<T>& object, Func init)
     {
+        if (useObjectHashes)
+        {
+            if (!object) return;
+
+            auto id = std::type_index(typeid(T));
+            auto hash = object->hash();
+            if (auto shared = _findHashed(id, object, hash, false))
+            {
+                object = ref_ptr<T>(static_cast<T*>(shared.get()));
+                return;
+            }
+
+            init(object);
+
+            // another thread may have shared an equivalent object while this one was being initialized, in which case use that one
+            if (_suitable(object.get()))
+            {
+                auto shared = _findHashed(id, object, hash, true);
+                if (shared != object) object = ref_ptr<T>(static_cast<T*>(shared.get()));
+            }
+            return;
+        }
+
         {
             std::scoped_lock<std::recursive_mutex> lock(_mutex);
 
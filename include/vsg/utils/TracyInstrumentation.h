@@ -133,6 +133,11 @@ namespace vsg
             FrameMark;
         }
 
+        void plot(const char* name, double value) const override
+        {
+            TracyPlot(name, value);
+        }
+
         void enter(const SourceLocation* slcloc, uint64_t& reference, const Object*) const override
         {
 #    ifdef TRACY_ON_DEMAND
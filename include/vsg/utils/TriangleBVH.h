@@ -0,0 +1,146 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Array.h>
+#include <vsg/core/Inherit.h>
+#include <vsg/maths/plane.h>
+
+namespace vsg
+{
+
+    /// TriangleBVH is a bounding volume hierarchy over the triangles of a triangle list draw, used by LineSegmentIntersector and PolytopeIntersector
+    /// to only test the triangles whose leaf bounds the line segment or polytope reaches rather than every triangle of large meshes.
+    /// The Intersector builds it lazily and caches it on the draw node via setObject("TriangleBVH", bvh), valid(..) checks whether the vertex and index Data
+    /// it was built from have since been replaced or modified so that it needs rebuilding.
+    class VSG_DECLSPEC TriangleBVH : public Inherit<Object, TriangleBVH>
+    {
+    public:
+        TriangleBVH();
+
+        /// node of the hierarchy, leaves have count > 0 and reference triangles[index, index + count),
+        /// internal nodes have count == 0 with their first child immediately following them and their second child at nodes[index].
+        struct Node
+        {
+            vec3 min;
+            uint32_t index = 0;
+            vec3 max;
+            uint32_t count = 0;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<uivec3> triangles; /// vertex indices of each triangle, reordered during build so that the triangles of each leaf are contiguous
+
+        /// build the hierarchy over in_triangles, splitting each node at the median centroid along its longest axis.
+        void build(const vec3Array& vertices, std::vector<uivec3> in_triangles, uint32_t maxTrianglesPerLeaf = 4);
+
+        /// record the vertex/index Data and range the BVH was built from.
+        void setSource(const Data* vertices, const Data* indices, uint32_t first, uint32_t count);
+
+        /// return true if the BVH was built from the specified Data and range, and the Data hasn't been modified since.
+        bool valid(const Data* vertices, const Data* indices, uint32_t first, uint32_t count) const;
+
+        /// call intersectTriangle(i0, i1, i2) for every triangle in the leaves whose bounds the line segment from start to end passes through.
+        template<typename F>
+        void intersect(const dvec3& start, const dvec3& end, F intersectTriangle) const
+        {
+            if (nodes.empty()) return;
+
+            dvec3 d = end - start;
+            dvec3 inv_d(d.x != 0.0 ? 1.0 / d.x : 0.0, d.y != 0.0 ? 1.0 / d.y : 0.0, d.z != 0.0 ? 1.0 / d.z : 0.0);
+
+            auto hit = [&](const Node& node) -> bool {
+                double t_near = 0.0, t_far = 1.0;
+                for (int a = 0; a < 3; ++a)
+                {
+                    if (d[a] == 0.0)
+                    {
+                        if (start[a] < node.min[a] || start[a] > node.max[a]) return false;
+                        continue;
+                    }
+                    double t0 = (static_cast<double>(node.min[a]) - start[a]) * inv_d[a];
+                    double t1 = (static_cast<double>(node.max[a]) - start[a]) * inv_d[a];
+                    if (t0 > t1) std::swap(t0, t1);
+                    if (t0 > t_near) t_near = t0;
+                    if (t1 < t_far) t_far = t1;
+                    if (t_near > t_far) return false;
+                }
+                return true;
+            };
+
+            traverse(hit, intersectTriangle);
+        }
+
+        /// call intersectTriangle(i0, i1, i2) for every triangle in the leaves whose bounds aren't wholly outside any of the polytope's planes.
+        template<typename F>
+        void intersect(const std::vector<dplane>& polytope, F intersectTriangle) const
+        {
+            if (nodes.empty()) return;
+
+            auto hit = [&](const Node& node) -> bool {
+                for (const auto& pl : polytope)
+                {
+                    // test the corner of the box furthest along the plane normal
+                    dvec3 corner(pl.n.x >= 0.0 ? node.max.x : node.min.x, pl.n.y >= 0.0 ? node.max.y : node.min.y, pl.n.z >= 0.0 ? node.max.z : node.min.z);
+                    if (distance(pl, corner) < 0.0) return false;
+                }
+                return true;
+            };
+
+            traverse(hit, intersectTriangle);
+        }
+
+        void read(Input& input) override;
+        void write(Output& output) const override;
+
+    protected:
+        virtual ~TriangleBVH();
+
+        template<typename H, typename F>
+        void traverse(H hit, F intersectTriangle) const
+        {
+            uint32_t stack[64];
+            uint32_t stackSize = 0;
+            stack[stackSize++] = 0;
+            while (stackSize > 0)
+            {
+                const Node& node = nodes[stack[--stackSize]];
+                if (!hit(node)) continue;
+
+                if (node.count > 0)
+                {
+                    for (uint32_t i = node.index; i < node.index + node.count; ++i)
+                    {
+                        const auto& triangle = triangles[i];
+                        intersectTriangle(triangle.x, triangle.y, triangle.z);
+                    }
+                }
+                else
+                {
+                    uint32_t first = static_cast<uint32_t>(&node - nodes.data()) + 1;
+                    stack[stackSize++] = node.index;
+                    stack[stackSize++] = first;
+                }
+            }
+        }
+
+        const Data* _vertices = nullptr;
+        const Data* _indices = nullptr;
+        ModifiedCount _verticesModifiedCount;
+        ModifiedCount _indicesModifiedCount;
+        uint32_t _first = 0;
+        uint32_t _count = 0;
+    };
+    VSG_type_name(vsg::TriangleBVH);
+
+} // namespace vsg
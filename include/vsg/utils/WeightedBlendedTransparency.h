@@ -0,0 +1,70 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/RenderPassChain.h>
+#include <vsg/utils/ShaderSet.h>
+
+namespace vsg
+{
+
+    /// create a ShaderSet for weighted blended order independent transparency derived from baseShaderSet, such as createPhongShaderSet(), whose fragment shader
+    /// writes depth weighted premultiplied color to an accumulation attachment and coverage to a revealage attachment rather than blending with the color attachment.
+    /// Use for the pipelines of the transparent subgraph passed to WeightedBlendedTransparency::addPasses(), assigning its returned subpass to GraphicsPipelineConfigurator::subpass
+    /// and leaving blending disabled as the ShaderSet's ColorBlendState provides the accumulation blending. The fragment shader is compiled at runtime so requires a ShaderCompiler.
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createWeightedBlendedTransparencyShaderSet(ref_ptr<ShaderSet> baseShaderSet);
+
+    /// create a ShaderSet for the full screen pass that resolves the accumulation and revealage attachments and blends the result over the opaque color attachment.
+    extern VSG_DECLSPEC ref_ptr<ShaderSet> createWeightedBlendedCompositeShaderSet(ref_ptr<const Options> options = {});
+
+    /// WeightedBlendedTransparency adds weighted blended order independent transparency passes to a RenderPassChain, so transparent geometry can be recorded in any order,
+    /// such as the state order of a Bin with Bin::STATE_SORT or plain traversal order, with no per frame CPU depth sort and correct results for intersecting surfaces.
+    /// The transparent pass depth tests against the opaque passes' depth attachment without writing to it, accumulating into transient attachments that stay in tile memory,
+    /// and the composite pass then resolves them into the color attachment. The blend is an approximation that weights surfaces by depth and coverage, so very opaque layers
+    /// don't fully occlude those behind them as they would with exact ordering.
+    class VSG_DECLSPEC WeightedBlendedTransparency : public Inherit<Object, WeightedBlendedTransparency>
+    {
+    public:
+        WeightedBlendedTransparency(ref_ptr<RenderPassChain> in_chain, uint32_t in_colorAttachment, uint32_t in_depthAttachment);
+
+        ref_ptr<RenderPassChain> chain;
+        uint32_t colorAttachment = 0;
+        uint32_t depthAttachment = 0;
+
+        VkFormat accumulationFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+        VkFormat revealageFormat = VK_FORMAT_R16_SFLOAT;
+
+        ref_ptr<const Options> options;
+
+        /// add the accumulation and revealage attachments, the pass that renders transparentSubgraph into them and the composite pass, after the passes already added to chain.
+        /// Returns the subpass index of the transparent pass.
+        uint32_t addPasses(ref_ptr<Node> transparentSubgraph);
+
+        /// create the chain's RenderGraph, setting up the composite pass to read the accumulation and revealage attachments.
+        ref_ptr<RenderGraph> createRenderGraph(Device* device);
+
+        // set up by addPasses()
+        uint32_t accumulationAttachment = 0;
+        uint32_t revealageAttachment = 0;
+        uint32_t transparentPass = 0;
+        uint32_t compositePass = 0;
+
+    protected:
+        virtual ~WeightedBlendedTransparency();
+
+        ref_ptr<Group> _compositeSubgraph;
+    };
+    VSG_type_name(vsg::WeightedBlendedTransparency);
+
+} // namespace vsg
@@ -16,6 +16,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/PipelineLayout.h>
 #include <vsg/vk/CommandPool.h>
 
+#include <array>
+
 namespace vsg
 {
 
@@ -55,11 +57,27 @@ namespace vsg
         CommandPool* getCommandPool() { return _commandPool; }
         const CommandPool* getCommandPool() const { return _commandPool; }
 
-        void setCurrentPipelineLayout(const PipelineLayout* pipelineLayout);
+        /// set the layout of the pipeline just bound, descriptor sets and push constants that remain valid with the new layout are retained so that rebinding them can be skipped.
+        void setCurrentPipelineLayout(const PipelineLayout* pipelineLayout, VkPipelineBindPoint pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS);
 
         VkPipelineLayout getCurrentPipelineLayout() const { return _currentPipelineLayout; }
         VkShaderStageFlags getCurrentPushConstantStageFlags() const { return _currentPushConstantStageFlags; }
 
+        /// record vkCmdBindDescriptorSets unless the descriptor sets, with the same dynamic offsets, are already bound with a layout compatible with pipelineLayout.
+        /// If pipelineLayout is null the compatibility can't be determined so the bind is always recorded and the tracking of the bind point's descriptor sets is discarded.
+        void bindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, const PipelineLayout* pipelineLayout, uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet* descriptorSets, uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets);
+
+        /// record vkCmdPushConstants with the current pipeline layout unless the same values have already been pushed to the same stages.
+        void pushConstants(VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values);
+
+        /// discard the tracking of the bound descriptor sets and push constants, call after recording vkCmdBindPipeline, vkCmdBindDescriptorSets or vkCmdPushConstants directly.
+        /// Called by State::dirtyStateStacks().
+        void dirtyBindings();
+
+        /// number of vkCmdBindDescriptorSets and vkCmdPushConstants calls skipped since the last reset() because they would have had no effect.
+        uint32_t numSkippedDescriptorSetBinds = 0;
+        uint32_t numSkippedPushConstants = 0;
+
         ref_ptr<ScratchMemory> scratchMemory;
 
     protected:
@@ -76,6 +94,44 @@ namespace vsg
         ref_ptr<CommandPool> _commandPool;
         VkPipelineLayout _currentPipelineLayout;
         VkShaderStageFlags _currentPushConstantStageFlags;
+
+        static constexpr uint32_t maxTrackedDescriptorSets = 8;
+        static constexpr uint32_t maxTrackedDynamicOffsets = 8;
+        static constexpr uint32_t maxTrackedPushConstantsSize = 256;
+
+        struct BoundDescriptorSet
+        {
+            VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+            uint32_t numDynamicOffsets = 0;
+            std::array<uint32_t, maxTrackedDynamicOffsets> dynamicOffsets;
+        };
+
+        struct BoundDescriptorSets
+        {
+            const PipelineLayout* pipelineLayout = nullptr;
+            std::array<BoundDescriptorSet, maxTrackedDescriptorSets> sets;
+
+            void invalidate(uint32_t firstSet = 0)
+            {
+                for (uint32_t i = firstSet; i < maxTrackedDescriptorSets; ++i) sets[i].descriptorSet = VK_NULL_HANDLE;
+            }
+        };
+
+        // graphics, compute and ray tracing bind points
+        std::array<BoundDescriptorSets, 3> _boundDescriptorSets;
+
+        // values pushed so far and the stages they were pushed to, tracked per 4 byte word as push constant offsets and sizes are multiples of 4
+        std::array<uint8_t, maxTrackedPushConstantsSize> _pushConstantValues;
+        std::array<VkShaderStageFlags, maxTrackedPushConstantsSize / 4> _pushConstantStages;
+        const PipelineLayout* _pushConstantsLayout = nullptr;
+
+        // last computed compatibility, as consecutive binds usually compare the same pair of layouts
+        const PipelineLayout* _compatibilityLhs = nullptr;
+        const PipelineLayout* _compatibilityRhs = nullptr;
+        uint32_t _compatibleSets = 0;
+
+        BoundDescriptorSets* _getBoundDescriptorSets(VkPipelineBindPoint pipelineBindPoint);
+        uint32_t _computeCompatibleSets(const PipelineLayout* lhs, const PipelineLayout* rhs);
     };
     VSG_type_name(vsg::CommandBuffer);
 
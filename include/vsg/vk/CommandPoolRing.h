@@ -0,0 +1,62 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/CommandPool.h>
+
+namespace vsg
+{
+
+    /// CommandPoolRing provides a ring of CommandPools, each with the CommandBuffers allocated from it, for recording the command buffers of successive frames.
+    /// Calling advance() selects a CommandPool whose CommandBuffers have no pending submissions and resets all of them with a single vkResetCommandPool call,
+    /// next() then hands out the CommandPool's CommandBuffers, recycling those allocated by previous frames rather than freeing them.
+    /// The CommandPools are created without VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT and a CommandPoolRing is intended to be owned by a single recording thread,
+    /// such as the one recording a CommandGraph, so the CommandPools are never accessed concurrently.
+    class VSG_DECLSPEC CommandPoolRing : public Inherit<Object, CommandPoolRing>
+    {
+    public:
+        CommandPoolRing(Device* in_device, uint32_t in_queueFamilyIndex, VkCommandBufferLevel in_level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+
+        ref_ptr<Device> device;
+        const uint32_t queueFamilyIndex;
+        const VkCommandBufferLevel level;
+
+        /// start recording a new frame, selecting and resetting a CommandPool whose CommandBuffers have all completed their submissions, creating a new CommandPool if none are available.
+        void advance();
+
+        /// return the next available CommandBuffer of the current frame for recording.
+        ref_ptr<CommandBuffer> next();
+
+        /// number of CommandPools in the ring
+        size_t size() const { return _frames.size(); }
+
+    protected:
+        virtual ~CommandPoolRing();
+
+        struct Frame
+        {
+            ref_ptr<CommandPool> commandPool;
+            CommandBuffers commandBuffers;
+            size_t numUsed = 0;
+
+            bool available() const;
+        };
+
+        std::vector<Frame> _frames;
+        size_t _currentFrame = 0;
+    };
+    VSG_type_name(vsg::CommandPoolRing);
+
+} // namespace vsg
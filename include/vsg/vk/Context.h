@@ -13,23 +13,29 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <deque>
+#include <functional>
 #include <memory>
 
 #include <vsg/app/TransferTask.h>
 #include <vsg/commands/Command.h>
 #include <vsg/commands/CopyAndReleaseBuffer.h>
 #include <vsg/commands/CopyAndReleaseImage.h>
+#include <vsg/core/Exception.h>
 #include <vsg/core/ScratchMemory.h>
 #include <vsg/nodes/Group.h>
 #include <vsg/state/BufferInfo.h>
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/state/ImageInfo.h>
+#include <vsg/threading/Latch.h>
+#include <vsg/threading/OperationThreads.h>
 #include <vsg/utils/Instrumentation.h>
 #include <vsg/utils/ShaderCompiler.h>
 #include <vsg/vk/CommandPool.h>
 #include <vsg/vk/DescriptorPool.h>
+#include <vsg/vk/DeviceResourceCache.h>
 #include <vsg/vk/Fence.h>
 #include <vsg/vk/MemoryBufferPools.h>
+#include <vsg/vk/PipelineCache.h>
 #include <vsg/vk/ResourceRequirements.h>
 
 namespace vsg
@@ -37,6 +43,7 @@ namespace vsg
     // forward declare
     class View;
     class ViewDependentState;
+    class QueryPool;
 
     /// Helper command for setting up RayTracing structures.
     class VSG_DECLSPEC BuildAccelerationStructureCommand : public Inherit<Command, BuildAccelerationStructureCommand>
@@ -44,11 +51,15 @@ namespace vsg
     public:
         // the primitive Count is A) the amount of triangles to be built for type VK_GEOMETRY_TYPE_TRIANGLES_KHR (blas) B) the amount of AABBs for type VK_GEOMETRY_TYPE_AABBS_KHR
         // and C) the number of acceleration structures for type VK_GEOMETRY_TYPE_INSTANCES_KHR
-        BuildAccelerationStructureCommand(Device* device, const VkAccelerationStructureBuildGeometryInfoKHR& info, const VkAccelerationStructureKHR& structure, const std::vector<uint32_t>& primitiveCounts);
+        // mode VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR refits the structure in place, which requires it to have been built with VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR
+        BuildAccelerationStructureCommand(Device* device, const VkAccelerationStructureBuildGeometryInfoKHR& info, const VkAccelerationStructureKHR& structure, const std::vector<uint32_t>& primitiveCounts, VkBuildAccelerationStructureModeKHR mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR);
 
         void record(CommandBuffer& commandBuffer) const override;
         void setScratchBuffer(ref_ptr<Buffer> scratchBuffer);
 
+        /// when assigned the compacted size of the structure is written to the first query of compactedSizeQuery after the build
+        ref_ptr<QueryPool> compactedSizeQuery;
+
         ref_ptr<Device> _device;
         VkAccelerationStructureBuildGeometryInfoKHR _accelerationStructureInfo;
         std::vector<VkAccelerationStructureGeometryKHR> _accelerationStructureGeometries;
@@ -91,6 +102,28 @@ namespace vsg
 
         ref_ptr<DescriptorSet::Implementation> allocateDescriptorSet(DescriptorSetLayout* descriptorSetLayout);
 
+        /// OperationThreads used to create Vulkan objects such as pipelines in parallel with the rest of the compile traversal.
+        /// When not assigned all compile work is done on the calling thread.
+        ref_ptr<OperationThreads> operationThreads;
+
+        using CompileFunction = std::function<void(Context& context)>;
+
+        /// run function on the operationThreads passing it a copy of this Context, or run it immediately with this Context if no operationThreads are assigned.
+        /// The function must only read from objects that are shared with the compile traversal.
+        void compileInParallel(CompileFunction function);
+
+        /// wait for all the functions passed to compileInParallel(..) to complete, rethrowing the first vsg::Exception that any of them threw.
+        void waitForParallelCompiles();
+
+        /// when true and operationThreads are assigned GraphicsPipeline are created without the compile waiting for them,
+        /// the RecordTraversal skips StateGroup subgraphs whose BindGraphicsPipeline isn't ready yet.
+        /// Pipelines bound by means other than a StateGroup must not be compiled with asynchronousPipelines enabled.
+        bool asynchronousPipelines = false;
+
+        /// run function on the operationThreads passing it a copy of this Context without waitForParallelCompiles() waiting for it, exceptions are reported as warnings.
+        /// Runs the function immediately with this Context if no operationThreads are assigned.
+        void compileAsynchronously(CompileFunction function);
+
         // used by GraphicsPipeline.cpp
         ref_ptr<RenderPass> renderPass;
 
@@ -108,6 +141,13 @@ namespace vsg
 
         // DescriptorPools
         ref_ptr<DescriptorPools> descriptorPools;
+        uint32_t descriptorPoolShard = 0; // shard of descriptorPools used by this Context, acquired on construction
+
+        // pipeline cache shared by all pipelines compiled for this device
+        ref_ptr<PipelineCache> pipelineCache;
+
+        // cache of the VkSampler and VkImageView shared by the Samplers and ImageViews with identical settings compiled for this device
+        ref_ptr<DeviceResourceCache> resourceCache;
 
         // ShaderCompiler
         ref_ptr<ShaderCompiler> shaderCompiler;
@@ -141,11 +181,19 @@ namespace vsg
         ref_ptr<MemoryBufferPools> deviceMemoryBufferPools;
         ref_ptr<MemoryBufferPools> stagingMemoryBufferPools;
 
+        /// priority of the device memory allocated for buffers and images during the compile, set from ResourceRequirements::memoryPriority by reserve(..)
+        float memoryPriority = 0.5f;
+
         // RTX ray tracing
         VkDeviceSize scratchBufferSize;
         std::vector<ref_ptr<BuildAccelerationStructureCommand>> buildAccelerationStructureCommands;
 
         ref_ptr<TransferTask> transferTask;
+
+    protected:
+        std::mutex _parallelCompileMutex;
+        ref_ptr<Latch> _parallelCompileLatch;
+        std::vector<Exception> _parallelCompileExceptions;
     };
     VSG_type_name(vsg::Context);
 
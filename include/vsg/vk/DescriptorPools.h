@@ -16,32 +16,77 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/DescriptorPool.h>
 #include <vsg/vk/ResourceRequirements.h>
 
+#include <atomic>
+#include <map>
+#include <memory>
+
 namespace vsg
 {
 
     /// Container for DescriptorPools.
+    /// DescriptorPools are held in independently locked shards, each Context acquires its own shard on construction so that
+    /// CompileTraversal/parallel compile threads allocate DescriptorSets without contending on a single list.
+    /// When a shard has no space, shards not locked by other threads are searched before allocating a new DescriptorPool.
+    /// Within a shard, DescriptorPools allocated on demand are grouped by the size class of the DescriptorSetLayout they were created for,
+    /// so allocation only searches pools likely to have compatible space.
     class VSG_DECLSPEC DescriptorPools : public Inherit<Object, DescriptorPools>
     {
     public:
-        explicit DescriptorPools(ref_ptr<Device> in_device);
+        explicit DescriptorPools(ref_ptr<Device> in_device, uint32_t in_numShards = 4);
 
         ref_ptr<Device> device;
-        std::list<ref_ptr<DescriptorPool>> descriptorPools;
 
         uint32_t minimum_maxSets = 0;    // minimum value of maxSets when allocating new DescriptoPool.
         uint32_t maximum_maxSets = 2048; // maximum value of minimum_maxSets can grow to.
         double scale_maxSets = 2.0;      // how to scale minimum_maxSets on each successive DescriptorPool allocation.
 
-        // totals of all the calls to reserve(const ResourceRequirements& requirements), used to guide allocation of new DescritproPool
-        uint32_t reserve_count = 0;
-        uint32_t reserve_maxSets = 0;
-        DescriptorPoolSizes reserve_descriptorPoolSizes;
+        using DescriptorPoolList = std::list<ref_ptr<DescriptorPool>>;
+
+        struct Statistics
+        {
+            uint64_t numAllocations = 0;        // calls to allocateDescriptorSet(..)
+            uint64_t numDescriptorPoolsCreated = 0;
+            uint64_t numDescriptorPoolsReclaimed = 0;
+        };
+
+        struct Shard
+        {
+            mutable std::mutex mutex;
+
+            DescriptorPoolList reservedDescriptorPools;                       // allocated by reserve(..) to meet the ResourceRequirements of a subgraph
+            std::map<uint32_t, DescriptorPoolList> sizeClassDescriptorPools; // allocated on demand by allocateDescriptorSet(..), keyed by size class
+
+            uint32_t minimum_maxSets = 0;
+
+            // totals of all the calls to reserve(const ResourceRequirements& requirements), used to guide allocation of new DescritproPool
+            uint32_t reserve_count = 0;
+            uint32_t reserve_maxSets = 0;
+            DescriptorPoolSizes reserve_descriptorPoolSizes;
+
+            Statistics statistics;
+        };
+
+        uint32_t numShards() const { return static_cast<uint32_t>(_shards.size()); }
+
+        /// return the index of the shard to use for a new Context, shards are assigned round robin
+        uint32_t acquireShard();
 
         /// check if there are enough Descriptorsets/Descrioptors, if not allocated a new DescriptorPool for these resources
-        void reserve(const ResourceRequirements& requirements);
+        void reserve(const ResourceRequirements& requirements, uint32_t shardIndex = 0);
 
         // allocate vkDescriptorSet
-        ref_ptr<DescriptorSet::Implementation> allocateDescriptorSet(DescriptorSetLayout* descriptorSetLayout);
+        ref_ptr<DescriptorSet::Implementation> allocateDescriptorSet(DescriptorSetLayout* descriptorSetLayout, uint32_t shardIndex = 0);
+
+        /// destroy DescriptorPools that no longer have any DescriptorSets in use, releasing the fragmented recycled DescriptorSets with them.
+        /// numEmptyPoolsToRetain empty DescriptorPools are kept in each shard to avoid reallocating them on the next allocation.
+        /// Called by the DeleteQueue background thread after paged subgraphs have been deleted. Returns the number of DescriptorPools destroyed.
+        size_t reclaim(size_t numEmptyPoolsToRetain = 1);
+
+        /// return the totals of the per shard statistics.
+        Statistics getStatistics() const;
+
+        /// return the number of DescriptorPools across all shards.
+        size_t numDescriptorPools() const;
 
         /// write the internal details to stream.
         void report(std::ostream& out, indentation indent = {}) const;
@@ -55,11 +100,33 @@ namespace vsg
         /// compute the number of sets and descriptors allocated.
         bool allocated(uint32_t& numSets, DescriptorPoolSizes& descriptorPoolSizes) const;
 
+        /// compute the size class used to select DescriptorPools for a DescriptorSetLayout, based on its total number of descriptors.
+        static uint32_t sizeClass(DescriptorSetLayout* descriptorSetLayout);
+
     protected:
         virtual ~DescriptorPools();
 
+        Shard& _shard(uint32_t shardIndex) { return *_shards[shardIndex % _shards.size()]; }
+
         /// get the maxSets and descriptorPoolSizes to use
-        void getDescriptorPoolSizesToUse(uint32_t& maxSets, DescriptorPoolSizes& descriptorPoolSizes);
+        void getDescriptorPoolSizesToUse(Shard& shard, uint32_t& maxSets, DescriptorPoolSizes& descriptorPoolSizes);
+
+        ref_ptr<DescriptorSet::Implementation> _allocateDescriptorSet(Shard& shard, DescriptorSetLayout* descriptorSetLayout, uint32_t layoutSizeClass);
+
+        template<class F>
+        void _forEachDescriptorPool(F function) const
+        {
+            for (auto& shard : _shards)
+            {
+                std::scoped_lock<std::mutex> lock(shard->mutex);
+                for (auto& dp : shard->reservedDescriptorPools) function(*dp);
+                for (auto& [sc, descriptorPools] : shard->sizeClassDescriptorPools)
+                    for (auto& dp : descriptorPools) function(*dp);
+            }
+        }
+
+        std::vector<std::unique_ptr<Shard>> _shards;
+        std::atomic_uint32_t _nextShard{0};
     };
     VSG_type_name(vsg::DescriptorPools);
 
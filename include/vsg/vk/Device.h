@@ -25,6 +25,8 @@ namespace vsg
     class WindowTraits;
     class MemoryBufferPools;
     class DescriptorPools;
+    class PipelineCache;
+    class DeviceResourceCache;
 
     struct QueueSetting
     {
@@ -84,13 +86,33 @@ namespace vsg
         /// return true if Device was created with specified extension
         bool supportsDeviceExtension(const char* extensionName) const;
 
+        /// return true if Device was created with the timelineSemaphore feature enabled, via VkPhysicalDeviceTimelineSemaphoreFeatures or VkPhysicalDeviceVulkan12Features.
+        bool supportsTimelineSemaphores() const { return _timelineSemaphores; }
+
+        /// return true if Device was created with the pipelineStatisticsQuery feature enabled, via VkPhysicalDeviceFeatures2.
+        bool supportsPipelineStatisticsQuery() const { return _pipelineStatisticsQuery; }
+
         /// return the amount of memory available in deviceMemoryBufferPools and allocatable on device
         VkDeviceSize availableMemory(bool includeMemoryPools = true) const;
 
+        struct MemoryHeapBudget
+        {
+            VkMemoryHeapFlags flags = 0;
+            VkDeviceSize size = 0;
+            VkDeviceSize budget = 0;
+            VkDeviceSize usage = 0;
+        };
+
+        /// return the size, budget and current usage of each of the physical device's memory heaps.
+        /// budget and usage are only reported by the driver when VK_EXT_memory_budget is enabled, otherwise budget is set to the heap size and usage to 0.
+        std::vector<MemoryHeapBudget> memoryHeapBudgets() const;
+
         // provide observer_ptr to memory buffer and descriptor pools so that these can be accessed when required
         observer_ptr<MemoryBufferPools> deviceMemoryBufferPools;
         observer_ptr<MemoryBufferPools> stagingMemoryBufferPools;
         observer_ptr<DescriptorPools> descriptorPools;
+        observer_ptr<PipelineCache> pipelineCache;
+        observer_ptr<DeviceResourceCache> resourceCache;
 
     protected:
         virtual ~Device();
@@ -103,6 +125,8 @@ namespace vsg
         ref_ptr<DeviceExtensions> _extensions;
 
         Queues _queues;
+        bool _timelineSemaphores = false;
+        bool _pipelineStatisticsQuery = false;
     };
     VSG_type_name(vsg::Device);
 
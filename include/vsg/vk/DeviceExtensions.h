@@ -37,6 +37,8 @@ namespace vsg
         PFN_vkGetAccelerationStructureDeviceAddressKHR vkGetAccelerationStructureDeviceAddressKHR = nullptr;
         PFN_vkGetAccelerationStructureBuildSizesKHR vkGetAccelerationStructureBuildSizesKHR = nullptr;
         PFN_vkCmdBuildAccelerationStructuresKHR vkCmdBuildAccelerationStructuresKHR = nullptr;
+        PFN_vkCmdCopyAccelerationStructureKHR vkCmdCopyAccelerationStructureKHR = nullptr;
+        PFN_vkCmdWriteAccelerationStructuresPropertiesKHR vkCmdWriteAccelerationStructuresPropertiesKHR = nullptr;
         PFN_vkCreateRayTracingPipelinesKHR vkCreateRayTracingPipelinesKHR = nullptr;
         PFN_vkGetRayTracingShaderGroupHandlesKHR vkGetRayTracingShaderGroupHandlesKHR = nullptr;
         PFN_vkCmdTraceRaysKHR vkCmdTraceRaysKHR = nullptr;
@@ -48,6 +50,10 @@ namespace vsg
         PFN_vkCmdDrawMeshTasksIndirectEXT vkCmdDrawMeshTasksIndirectEXT = nullptr;
         PFN_vkCmdDrawMeshTasksIndirectCountEXT vkCmdDrawMeshTasksIndirectCountEXT = nullptr;
 
+        // VK_EXT_multi_draw
+        PFN_vkCmdDrawMultiEXT vkCmdDrawMultiEXT = nullptr;
+        PFN_vkCmdDrawMultiIndexedEXT vkCmdDrawMultiIndexedEXT = nullptr;
+
         // VK_EXT_extended_dynamic_state / Vulkan 1.3
         PFN_vkCmdSetCullModeEXT vkCmdSetCullMode = nullptr;
         PFN_vkCmdSetFrontFaceEXT vkCmdSetFrontFace = nullptr;
@@ -61,6 +67,39 @@ namespace vsg
         PFN_vkCmdSetDepthBoundsTestEnableEXT vkCmdSetDepthBoundsTestEnable = nullptr;
         PFN_vkCmdSetStencilTestEnableEXT vkCmdSetStencilTestEnable = nullptr;
         PFN_vkCmdSetStencilOpEXT vkCmdSetStencilOp = nullptr;
+
+        // VK_EXT_extended_dynamic_state2 / Vulkan 1.3
+        PFN_vkCmdSetRasterizerDiscardEnableEXT vkCmdSetRasterizerDiscardEnable = nullptr;
+        PFN_vkCmdSetDepthBiasEnableEXT vkCmdSetDepthBiasEnable = nullptr;
+        PFN_vkCmdSetPrimitiveRestartEnableEXT vkCmdSetPrimitiveRestartEnable = nullptr;
+
+        // VK_EXT_extended_dynamic_state3
+        PFN_vkCmdSetPolygonModeEXT vkCmdSetPolygonModeEXT = nullptr;
+        PFN_vkCmdSetColorBlendEnableEXT vkCmdSetColorBlendEnableEXT = nullptr;
+        PFN_vkCmdSetColorWriteMaskEXT vkCmdSetColorWriteMaskEXT = nullptr;
+
+        // VK_KHR_fragment_shading_rate
+        PFN_vkCmdSetFragmentShadingRateKHR vkCmdSetFragmentShadingRateKHR = nullptr;
+
+        // VK_KHR_dynamic_rendering / Vulkan 1.3
+        PFN_vkCmdBeginRenderingKHR vkCmdBeginRendering = nullptr;
+        PFN_vkCmdEndRenderingKHR vkCmdEndRendering = nullptr;
+
+        // VK_KHR_descriptor_update_template / Vulkan 1.1
+        PFN_vkCreateDescriptorUpdateTemplateKHR vkCreateDescriptorUpdateTemplate = nullptr;
+        PFN_vkDestroyDescriptorUpdateTemplateKHR vkDestroyDescriptorUpdateTemplate = nullptr;
+        PFN_vkUpdateDescriptorSetWithTemplateKHR vkUpdateDescriptorSetWithTemplate = nullptr;
+
+        // VK_KHR_push_descriptor
+        PFN_vkCmdPushDescriptorSetKHR vkCmdPushDescriptorSetKHR = nullptr;
+
+        // VK_KHR_timeline_semaphore / Vulkan 1.2
+        PFN_vkGetSemaphoreCounterValueKHR vkGetSemaphoreCounterValue = nullptr;
+        PFN_vkWaitSemaphoresKHR vkWaitSemaphores = nullptr;
+        PFN_vkSignalSemaphoreKHR vkSignalSemaphore = nullptr;
+
+        // VK_KHR_present_wait
+        PFN_vkWaitForPresentKHR vkWaitForPresentKHR = nullptr;
     };
     VSG_type_name(vsg::DeviceExtensions);
 
@@ -30,6 +30,10 @@ namespace vsg
     public:
         DeviceMemory(Device* device, const VkMemoryRequirements& memRequirements, VkMemoryPropertyFlags properties, void* pNextAllocInfo = nullptr);
 
+        /// allocate DeviceMemory with a priority in the range 0.0 to 1.0, passed to the driver via VkMemoryPriorityAllocateInfoEXT when the VK_EXT_memory_priority extension is enabled on the device.
+        /// Under memory pressure drivers evict lower priority allocations from device local memory first.
+        DeviceMemory(Device* device, const VkMemoryRequirements& memRequirements, VkMemoryPropertyFlags properties, float in_priority, void* pNextAllocInfo = nullptr);
+
         operator VkDeviceMemory() const { return _deviceMemory; }
         VkDeviceMemory vk() const { return _deviceMemory; }
 
@@ -43,6 +47,12 @@ namespace vsg
         const VkMemoryRequirements& getMemoryRequirements() const { return _memoryRequirements; }
         const VkMemoryPropertyFlags& getMemoryPropertyFlags() const { return _properties; }
 
+        /// property flags of the memory type selected for the allocation, may include flags beyond those requested, such as HOST_VISIBLE on device local memory of integrated GPUs or with resizable BAR.
+        const VkMemoryPropertyFlags& getMemoryTypePropertyFlags() const { return _memoryTypePropertyFlags; }
+
+        /// priority the memory was allocated with.
+        float getPriority() const { return _priority; }
+
         MemorySlots::OptionalOffset reserve(VkDeviceSize size);
         void release(VkDeviceSize offset, VkDeviceSize size);
 
@@ -52,6 +62,9 @@ namespace vsg
         size_t totalReservedSize() const;
         size_t totalMemorySize() const;
 
+        /// ratio of the available memory that is not part of the largest available slot.
+        double fragmentation() const;
+
         Device* getDevice() { return _device; }
         const Device* getDevice() const { return _device; }
 
@@ -61,6 +74,8 @@ namespace vsg
         VkDeviceMemory _deviceMemory;
         VkMemoryRequirements _memoryRequirements;
         VkMemoryPropertyFlags _properties;
+        VkMemoryPropertyFlags _memoryTypePropertyFlags = 0;
+        float _priority = 0.5f;
         ref_ptr<Device> _device;
 
         mutable std::mutex _mutex;
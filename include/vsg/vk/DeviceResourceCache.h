@@ -0,0 +1,99 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/vk/Device.h>
+
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace vsg
+{
+
+    /// DeviceResourceCache provides a Device level cache of the VkSampler and VkImageView created by Sampler::compile(..) and ImageView::compile(..),
+    /// so that Sampler and ImageView objects with identical settings share a single Vulkan object. Avoids redundant allocations when loading many textures
+    /// and helps applications stay within VkPhysicalDeviceLimits::maxSamplerAllocationCount. The Vulkan objects are destroyed once no Sampler/ImageView uses them.
+    class VSG_DECLSPEC DeviceResourceCache : public Inherit<Object, DeviceResourceCache>
+    {
+    public:
+        explicit DeviceResourceCache(Device* in_device);
+
+        /// VkSampler shared by Samplers with the same VkSamplerCreateInfo settings.
+        class VSG_DECLSPEC SharedSampler : public Inherit<Object, SharedSampler>
+        {
+        public:
+            SharedSampler(DeviceResourceCache* in_cache, const VkSamplerCreateInfo& in_info);
+
+            const VkSamplerCreateInfo info;
+            VkSampler sampler = VK_NULL_HANDLE;
+            ref_ptr<Device> device;
+
+        protected:
+            virtual ~SharedSampler();
+
+            observer_ptr<DeviceResourceCache> _cache;
+        };
+
+        /// VkImageView shared by ImageViews with the same VkImageViewCreateInfo settings.
+        class VSG_DECLSPEC SharedImageView : public Inherit<Object, SharedImageView>
+        {
+        public:
+            SharedImageView(DeviceResourceCache* in_cache, const VkImageViewCreateInfo& in_info);
+
+            const VkImageViewCreateInfo info;
+            VkImageView imageView = VK_NULL_HANDLE;
+            ref_ptr<Device> device;
+
+        protected:
+            virtual ~SharedImageView();
+
+            observer_ptr<DeviceResourceCache> _cache;
+        };
+
+        /// return the SharedSampler for the VkSamplerCreateInfo settings, creating a new VkSampler if no existing one matches. info.pNext must be nullptr.
+        ref_ptr<SharedSampler> getOrCreateSampler(const VkSamplerCreateInfo& info);
+
+        /// return the SharedImageView for the VkImageViewCreateInfo settings, creating a new VkImageView if no existing one matches. info.pNext must be nullptr.
+        ref_ptr<SharedImageView> getOrCreateImageView(const VkImageViewCreateInfo& info);
+
+        /// number of VkSampler currently held by the cache
+        size_t numSamplers() const;
+
+        /// number of VkImageView currently held by the cache
+        size_t numImageViews() const;
+
+        Device* getDevice() { return _device; }
+        const Device* getDevice() const { return _device; }
+
+    protected:
+        virtual ~DeviceResourceCache();
+
+        struct MemoryLess
+        {
+            template<typename T>
+            bool operator()(const T& lhs, const T& rhs) const { return std::memcmp(&lhs, &rhs, sizeof(T)) < 0; }
+        };
+
+        void _remove(const SharedSampler* sharedSampler);
+        void _remove(const SharedImageView* sharedImageView);
+
+        ref_ptr<Device> _device;
+
+        mutable std::mutex _mutex;
+        std::map<VkSamplerCreateInfo, observer_ptr<SharedSampler>, MemoryLess> _samplers;
+        std::map<VkImageViewCreateInfo, observer_ptr<SharedImageView>, MemoryLess> _imageViews;
+    };
+    VSG_type_name(vsg::DeviceResourceCache);
+
+} // namespace vsg
@@ -37,6 +37,9 @@ namespace vsg
 
         void resetFenceAndDependencies();
 
+        /// reset the numDependentSubmissions of dependent semaphores and command buffers and clear the dependency lists without resetting the VkFence.
+        void resetDependencies();
+
         Semaphores& dependentSemaphores() { return _dependentSemaphores; }
         CommandBuffers& dependentCommandBuffers() { return _dependentCommandBuffers; }
 
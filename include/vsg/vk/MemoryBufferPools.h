@@ -16,6 +16,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <memory>
 
 #include <vsg/core/Object.h>
+#include <vsg/io/stream.h>
 #include <vsg/state/BufferInfo.h>
 #include <vsg/vk/ResourceRequirements.h>
 
@@ -42,15 +43,35 @@ namespace vsg
         /// throw vsg::Exception when reserveMemory() fails to allocated memory on device.
         bool throwOutOfDeviceMemoryException = true;
 
+        /// allocate images that the driver reports require or prefer a dedicated allocation (Vulkan 1.1/VK_KHR_dedicated_allocation) in their own DeviceMemory rather than sub-allocating them.
+        bool useDedicatedAllocations = true;
+
+        /// images with memory requirements of at least this size are allocated their own DeviceMemory, such as large render targets and shadow maps. 0 disables the size check.
+        VkDeviceSize dedicatedAllocationThreshold = 16 * 1024 * 1024;
+
         VkDeviceSize computeMemoryTotalAvailable() const;
         VkDeviceSize computeMemoryTotalReserved() const;
         VkDeviceSize computeBufferTotalAvailable() const;
         VkDeviceSize computeBufferTotalReserved() const;
 
-        ref_ptr<BufferInfo> reserveBuffer(VkDeviceSize totalSize, VkDeviceSize alignment, VkBufferUsageFlags bufferUsageFlags, VkSharingMode sharingMode, VkMemoryPropertyFlags memoryProperties);
+        /// compute the ratio of the total available memory/buffer space that isn't part of the largest available slot of each DeviceMemory/Buffer,
+        /// 0.0 when the available space in each is contiguous, approaching 1.0 as the available space becomes fragmented into small slots.
+        double computeMemoryFragmentation() const;
+        double computeBufferFragmentation() const;
+
+        /// write the allocation and fragmentation stats to stream.
+        void report(std::ostream& out, indentation indent = {}) const;
+
+        /// reserve a range of a Buffer whose memory is of the specified priority, see DeviceMemory for details of memory priority.
+        ref_ptr<BufferInfo> reserveBuffer(VkDeviceSize totalSize, VkDeviceSize alignment, VkBufferUsageFlags bufferUsageFlags, VkSharingMode sharingMode, VkMemoryPropertyFlags memoryProperties, float priority = 0.5f);
 
         using DeviceMemoryOffset = std::pair<ref_ptr<DeviceMemory>, VkDeviceSize>;
-        DeviceMemoryOffset reserveMemory(VkMemoryRequirements memRequirements, VkMemoryPropertyFlags memoryProperties, void* pNextAllocInfo = nullptr);
+
+        /// reserve memory from a DeviceMemory of the specified priority, see DeviceMemory for details of memory priority.
+        DeviceMemoryOffset reserveMemory(VkMemoryRequirements memRequirements, VkMemoryPropertyFlags memoryProperties, void* pNextAllocInfo = nullptr, float priority = 0.5f);
+
+        /// reserve memory for an image, using a dedicated DeviceMemory when required/preferred by the driver or its size exceeds the dedicatedAllocationThreshold.
+        DeviceMemoryOffset reserveImageMemory(VkImage image, VkMemoryPropertyFlags memoryProperties, float priority = 0.5f);
 
         VkResult reserve(ResourceRequirements& requirements);
 
@@ -0,0 +1,60 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Path.h>
+#include <vsg/vk/Device.h>
+
+namespace vsg
+{
+
+    /// PipelineCache encapsulates VkPipelineCache, used by GraphicsPipeline, ComputePipeline and RayTracingPipeline to reuse the results of pipeline compilation.
+    /// If a filename is assigned the cache is initialized from the file's contents, if it's compatible with the Device, and written back to the file on destruction.
+    class VSG_DECLSPEC PipelineCache : public Inherit<Object, PipelineCache>
+    {
+    public:
+        explicit PipelineCache(Device* device, const Path& in_filename = {});
+
+        operator VkPipelineCache() const { return _pipelineCache; }
+        VkPipelineCache vk() const { return _pipelineCache; }
+
+        Device* getDevice() { return _device; }
+        const Device* getDevice() const { return _device; }
+
+        /// file used to initialize the cache and to write the cache contents to on destruction, empty if no file is associated with the cache.
+        const Path filename;
+
+        /// return the contents of the cache
+        std::vector<uint8_t> getData() const;
+
+        /// write the contents of the cache to the specified file, return true on success.
+        bool write(const Path& in_filename) const;
+
+        /// write the contents of the cache to PipelineCache::filename, return true on success.
+        bool write() const { return write(filename); }
+
+        /// return true if the data has a VkPipelineCacheHeaderVersionOne header that matches the vendorID, deviceID and pipelineCacheUUID of the physical device.
+        static bool compatible(const PhysicalDevice* physicalDevice, const std::vector<uint8_t>& data);
+
+        /// return a filename within the specified directory that is unique to the physical device's vendorID, deviceID, driverVersion and pipelineCacheUUID.
+        static Path filenameForDevice(const PhysicalDevice* physicalDevice, const Path& directory);
+
+    protected:
+        virtual ~PipelineCache();
+
+        VkPipelineCache _pipelineCache;
+        ref_ptr<Device> _device;
+    };
+    VSG_type_name(vsg::PipelineCache);
+
+} // namespace vsg
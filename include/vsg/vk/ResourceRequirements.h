@@ -22,6 +22,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <map>
 #include <set>
 #include <stack>
+#include <unordered_set>
 
 namespace vsg
 {
@@ -40,6 +41,9 @@ namespace vsg
         uint32_t computeNumDescriptorSets() const;
         DescriptorPoolSizes computeDescriptorPoolSizes() const;
 
+        /// estimate the bytes of CPU memory held by the Data of the collected buffers and images and the bytes of GPU memory required for the buffers and images.
+        void computeMemoryUsage(uint64_t& cpuMemory, uint64_t& gpuMemory) const;
+
         struct ViewDetails
         {
             std::set<int32_t> indices;
@@ -54,8 +58,8 @@ namespace vsg
             }
         };
 
-        using Descriptors = std::set<const Descriptor*>;
-        using DescriptorSets = std::set<const DescriptorSet*>;
+        using Descriptors = std::unordered_set<const Descriptor*>;
+        using DescriptorSets = std::unordered_set<const DescriptorSet*>;
         using DescriptorTypeMap = std::map<VkDescriptorType, uint32_t>;
         using Views = std::map<const View*, ViewDetails>;
         using ViewDetailStack = std::stack<ViewDetails>;
@@ -72,6 +76,10 @@ namespace vsg
         uint32_t externalNumDescriptorSets = 0;
         bool containsPagedLOD = false;
 
+        /// memory of the subgraphs whose complete ResourceHints were applied in place of collecting their buffers and images, added by computeMemoryUsage(..)
+        uint64_t externalCPUMemory = 0;
+        uint64_t externalGPUMemory = 0;
+
         struct BufferProperties
         {
             VkBufferUsageFlags usageFlags = 0;
@@ -94,6 +102,8 @@ namespace vsg
 
         DataTransferHint dataTransferHint = COMPILE_TRAVERSAL_USE_TRANSFER_TASK;
         uint32_t viewportStateHint = DYNAMIC_VIEWPORTSTATE;
+        Path pipelineCacheDirectory;
+        float memoryPriority = 0.5f;
     };
     VSG_type_name(vsg::ResourceRequirements);
 
@@ -108,8 +118,13 @@ namespace vsg
         /// create ResouceHints that capture the collected ResourceRequirements. Note, call after the CollectResourceRequirements traversal.
         ref_ptr<ResourceHints> createResourceHints(uint32_t tileMultiplier = 1) const;
 
+        /// create complete ResourceHints that can be assigned to the traversed subgraph so later collections needn't traverse it.
+        /// Returns null if the subgraph contains Views, Bins or Lights, as these can't be captured by ResourceHints.
+        ref_ptr<ResourceHints> createSubgraphResourceHints() const;
+
         using ConstVisitor::apply;
 
+        /// apply any ResourceHints assigned to object, returning true if they are complete so the object needn't be traversed.
         bool checkForResourceHints(const Object& object);
 
         void apply(const Object& object) override;
@@ -121,6 +136,7 @@ namespace vsg
         void apply(const DescriptorBuffer& descriptorBuffer) override;
         void apply(const DescriptorImage& descriptorImage) override;
         void apply(const PagedLOD& plod) override;
+        void apply(const LazyCompileGroup& lcg) override;
         void apply(const Light& light) override;
         void apply(const RenderGraph& rg) override;
         void apply(const View& view) override;
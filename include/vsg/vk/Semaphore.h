@@ -22,6 +22,9 @@ namespace vsg
     public:
         explicit Semaphore(Device* device, VkPipelineStageFlags pipelineStageFlags = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, void* pNextCreateInfo = nullptr);
 
+        /// create a semaphore of specified type, VK_SEMAPHORE_TYPE_TIMELINE requires the Device to be created with the timelineSemaphore feature enabled.
+        Semaphore(Device* device, VkSemaphoreType semaphoreType, uint64_t initialValue, VkPipelineStageFlags pipelineStageFlags = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
         operator VkSemaphore() const { return _semaphore; }
         VkSemaphore vk() const { return _semaphore; }
 
@@ -32,6 +35,24 @@ namespace vsg
 
         const VkSemaphore* data() const { return &_semaphore; }
 
+        /// return true if this is a timeline semaphore
+        bool timeline() const { return _timeline; }
+
+        /// timeline semaphore only : return the next value for a submission to signal, values are handed out in increasing order so submissions to a single queue stay monotonic.
+        uint64_t nextSignalValue() { return ++_signalValue; }
+
+        /// timeline semaphore only : return the last value handed out by nextSignalValue().
+        uint64_t lastSignalValue() const { return _signalValue.load(); }
+
+        /// timeline semaphore only : return the current counter value of the semaphore, the largest value that the GPU (or host) has signaled.
+        uint64_t counterValue() const;
+
+        /// timeline semaphore only : wait until the counter value reaches the specified value, timeout is in nanoseconds.
+        VkResult wait(uint64_t value, uint64_t timeout) const;
+
+        /// timeline semaphore only : signal the semaphore from the host.
+        VkResult signal(uint64_t value) const;
+
         Device* getDevice() { return _device; }
         const Device* getDevice() const { return _device; }
 
@@ -41,6 +62,8 @@ namespace vsg
         VkSemaphore _semaphore;
         VkPipelineStageFlags _pipelineStageFlags = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
         std::atomic_uint _numDependentSubmissions{0};
+        bool _timeline = false;
+        std::atomic_uint64_t _signalValue{0};
         ref_ptr<Device> _device;
     };
     VSG_type_name(vsg::Semaphore);
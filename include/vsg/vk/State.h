@@ -15,14 +15,19 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/maths/plane.h>
 #include <vsg/maths/transform.h>
 #include <vsg/nodes/MatrixTransform.h>
+#include <vsg/state/BufferInfo.h>
 #include <vsg/state/PushConstants.h>
 #include <vsg/vk/CommandBuffer.h>
 
+#include <algorithm>
 #include <array>
 #include <stack>
+#include <vector>
 
 namespace vsg
 {
+    // forward declare
+    class Commands;
 
 #define POLYTOPE_SIZE 5
 #define STATESTACK_SIZE 16
@@ -73,18 +78,26 @@ namespace vsg
         size_t size() const { return pos; }
         const T* top() const { return stack[pos]; }
 
-        inline void record(CommandBuffer& commandBuffer)
+        /// return true if the top of the stack differs from the last recorded
+        bool changed() const { return stack[pos] != stack[0]; }
+
+        /// record the top of the stack if it differs from the last recorded, returning the recorded command or nullptr if none was recorded.
+        inline const T* record(CommandBuffer& commandBuffer)
         {
             const T* current = stack[pos];
             if (current != stack[0])
             {
                 current->record(commandBuffer);
                 stack[0] = current;
+                return current;
             }
+            return nullptr;
         }
     };
 
-    /// MatrixStack used internally by vsg::State to manage stack of projection or modelview matrices
+    /// MatrixStack used internally by vsg::State to manage stack of projection or modelview matrices.
+    /// Matrices are held in a contiguous array that is retained between frames so push/pop don't allocate,
+    /// with the float conversion used for push constants computed lazily and cached for each level of the stack.
     class MatrixStack
     {
     public:
@@ -92,70 +105,104 @@ namespace vsg
             offset(in_offset)
         {
             // make sure there is an initial matrix
-            matrixStack.emplace(dmat4());
+            _entries.resize(initialCapacity);
+            _size = 1;
+            dirty = true;
+        }
+
+        MatrixStack(const MatrixStack& rhs) :
+            offset(rhs.offset)
+        {
+            _entries.resize(std::max(rhs._entries.size(), initialCapacity));
+            std::copy(rhs._entries.begin(), rhs._entries.begin() + rhs._size, _entries.begin());
+            _size = rhs._size;
+            _nextID = rhs._nextID;
             dirty = true;
         }
 
         using value_type = double;
 
-        std::stack<dmat4> matrixStack;
+        static constexpr size_t initialCapacity = 32;
+
         uint32_t offset = 0;
         bool dirty = false;
 
         MatrixStack& operator=(const MatrixStack& rhs)
         {
-            matrixStack = rhs.matrixStack;
+            if (&rhs == this) return *this;
+
+            if (_entries.size() < rhs._size) _entries.resize(rhs._entries.size());
+            std::copy(rhs._entries.begin(), rhs._entries.begin() + rhs._size, _entries.begin());
+            _size = rhs._size;
+            _nextID = rhs._nextID;
             offset = rhs.offset;
             dirty = true;
 
             return *this;
         }
 
+        /// number of matrices on the stack
+        size_t size() const { return _size; }
+
         inline void set(const mat4& matrix)
         {
-            matrixStack = {};
-            matrixStack.emplace(matrix);
-            dirty = true;
+            _size = 0;
+            _push().matrix = matrix;
         }
 
         inline void set(const dmat4& matrix)
         {
-            matrixStack = {};
-            matrixStack.emplace(matrix);
-            dirty = true;
+            _size = 0;
+            _push().matrix = matrix;
         }
 
         inline void push(const mat4& matrix)
         {
-            matrixStack.emplace(matrix);
-            dirty = true;
+            _push().matrix = matrix;
         }
         inline void push(const dmat4& matrix)
         {
-            matrixStack.emplace(matrix);
-            dirty = true;
+            _push().matrix = matrix;
         }
         inline void push(const Transform& transform)
         {
-            matrixStack.emplace(transform.transform(matrixStack.top()));
-            dirty = true;
+            auto& entry = _push();
+            entry.matrix = transform.transform(_entries[_size - 2].matrix);
         }
 
         inline void push(const MatrixTransform& transform)
         {
-            matrixStack.emplace(matrixStack.top() * transform.matrix);
-            dirty = true;
+            auto& entry = _push();
+            const auto& parent = _entries[_size - 2].matrix;
+            const auto& m = transform.matrix;
+
+            if (isTranslation(m))
+            {
+                // translation only, so only the last column differs from the parent
+                entry.matrix[0] = parent[0];
+                entry.matrix[1] = parent[1];
+                entry.matrix[2] = parent[2];
+                entry.matrix[3] = parent[0] * m[3][0] + parent[1] * m[3][1] + parent[2] * m[3][2] + parent[3];
+            }
+            else
+            {
+                entry.matrix = parent * m;
+            }
         }
 
-        const dmat4& top() const { return matrixStack.top(); }
+        const dmat4& top() const { return _entries[_size - 1].matrix; }
+
+        /// identifier of the top matrix, unique to each push so callers can detect a matrix they've already seen without comparing matrices.
+        uint64_t topID() const { return _entries[_size - 1].id; }
 
         inline void pop()
         {
-            matrixStack.pop();
+            --_size;
             dirty = true;
         }
 
-        inline void record(CommandBuffer& commandBuffer)
+        /// push the top matrix if it's dirty, returning the float matrix pushed or nullptr if none was pushed.
+        inline const mat4* record(CommandBuffer& commandBuffer)
         {
             if (dirty)
             {
@@ -165,19 +212,104 @@ namespace vsg
                 // don't attempt to push matrices if no pipeline is current or no stages are enabled for push constants
                 if (pipeline == 0 || stageFlags == 0)
                 {
-                    return;
+                    return nullptr;
+                }
+
+                // make sure matrix is a float matrix, reusing the conversion when returning to a level already recorded.
+                auto& entry = _entries[_size - 1];
+                if (!entry.converted)
+                {
+                    entry.floatMatrix = entry.matrix;
+                    entry.converted = true;
                 }
 
-                // make sure matrix is a float matrix.
-                mat4 newmatrix(matrixStack.top());
-                vkCmdPushConstants(commandBuffer, pipeline, stageFlags, offset, sizeof(newmatrix), newmatrix.data());
+                commandBuffer.pushConstants(stageFlags, offset, sizeof(entry.floatMatrix), entry.floatMatrix.data());
                 dirty = false;
+                return &entry.floatMatrix;
             }
+            return nullptr;
         }
+
+        /// return true if the matrix only contains a translation
+        static bool isTranslation(const dmat4& m)
+        {
+            return m[0][0] == 1.0 && m[0][1] == 0.0 && m[0][2] == 0.0 && m[0][3] == 0.0 &&
+                   m[1][0] == 0.0 && m[1][1] == 1.0 && m[1][2] == 0.0 && m[1][3] == 0.0 &&
+                   m[2][0] == 0.0 && m[2][1] == 0.0 && m[2][2] == 1.0 && m[2][3] == 0.0 &&
+                   m[3][3] == 1.0;
+        }
+
+    protected:
+        struct Entry
+        {
+            dmat4 matrix;
+            mat4 floatMatrix;
+            bool converted = false;
+            uint64_t id = 0;
+        };
+
+        std::vector<Entry> _entries;
+        size_t _size = 0;
+        uint64_t _nextID = 0;
+
+        inline Entry& _push()
+        {
+            if (_size == _entries.size()) _entries.resize(_entries.size() * 2);
+
+            auto& entry = _entries[_size++];
+            entry.converted = false;
+            entry.id = ++_nextID;
+            dirty = true;
+            return entry;
+        }
+    };
+
+    /// DrawBatch used internally by vsg::State to coalesce consecutive indexed draws into single vkCmdDrawMultiIndexedEXT calls when VK_EXT_multi_draw is enabled.
+    /// Draws that bind the same vertex buffers and offsets and the same index buffer are coalesced with the difference in index buffer offsets folded into
+    /// each draw's firstIndex, so draws whose indices are sub-allocated from a shared buffer can be coalesced. The buffers are bound when the batch is flushed.
+    class VSG_DECLSPEC DrawBatch
+    {
+    public:
+        PFN_vkCmdDrawMultiIndexedEXT vkCmdDrawMultiIndexedEXT = nullptr;
+        uint32_t maxDrawCount = 0;
+
+        /// number of draws flushed and the number of vkCmdDrawMultiIndexedEXT calls they were recorded with.
+        uint64_t numDraws = 0;
+        uint64_t numMultiDraws = 0;
+
+        /// assign vkCmdDrawMultiIndexedEXT and maxDrawCount for the device, requires the VK_EXT_multi_draw extension and its multiDraw feature to be enabled.
+        void connect(Device* device);
+
+        bool enabled() const { return vkCmdDrawMultiIndexedEXT != nullptr && maxDrawCount > 1; }
+        bool empty() const { return _draws.empty(); }
+
+        /// add an indexed draw along with the vertex and index buffers it binds, flushing the pending draws first if it can't be coalesced with them.
+        void add(CommandBuffer& commandBuffer, uint32_t firstBinding, const VulkanArrayData& vertexArrays, VkBuffer indexBuffer, VkDeviceSize indexOffset, VkIndexType indexType,
+                 uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+
+        /// add an indexed draw that uses the vertex and index buffers already bound, flushing the pending draws first if it can't be coalesced with them.
+        void add(CommandBuffer& commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+
+        /// record the pending draws
+        void flush(CommandBuffer& commandBuffer);
+
+    protected:
+        const Device* _device = nullptr;
+
+        bool _bindBuffers = false;
+        uint32_t _firstBinding = 0;
+        std::vector<VkBuffer> _vertexBuffers;
+        std::vector<VkDeviceSize> _vertexOffsets;
+        VkBuffer _indexBuffer = VK_NULL_HANDLE;
+        VkDeviceSize _indexOffset = 0;
+        VkIndexType _indexType = VK_INDEX_TYPE_UINT16;
+        uint32_t _instanceCount = 0;
+        uint32_t _firstInstance = 0;
+        std::vector<VkMultiDrawIndexedInfoEXT> _draws;
     };
 
     /// Frustum used internally by vsg::State to manage view fustum culling during vsg::RecordTraversal
-    struct Frustum
+    struct VSG_DECLSPEC Frustum
     {
         using value_type = MatrixStack::value_type;
         using Plane = t_plane<value_type>;
@@ -243,6 +375,23 @@ namespace vsg
                 if (distance(face[5], s.center) < negative_radius) return false;
             return true;
         }
+
+        /// test an array of spheres against the frustum, setting visible[i] to 1 if spheres[i] intersects the frustum and 0 if it doesn't, returns the number of visible spheres.
+        /// Uses AVX, SSE2 or NEON when available to test several spheres at once.
+        size_t intersect(const dsphere* spheres, size_t count, uint8_t* visible) const;
+
+        template<typename T>
+        size_t intersect(const t_sphere<T>* spheres, size_t count, uint8_t* visible) const
+        {
+            size_t numVisible = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                bool result = intersect(spheres[i]);
+                visible[i] = result ? 1 : 0;
+                if (result) ++numVisible;
+            }
+            return numVisible;
+        }
     };
 
     /// vsg::State is used by vsg::RecordTraversal to manage state stacks, projection and modelview matrices and frustum stacks.
@@ -276,9 +425,30 @@ namespace vsg
 
         uint32_t viewportStateHint = 0;
 
+        /// settings of the currently active render pass and subpass, assigned by RenderGraph and NextSubPass, used to set up the VkCommandBufferInheritanceInfo of secondary CommandBuffers recorded within the subpass.
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        VkFramebuffer framebuffer = VK_NULL_HANDLE;
+        uint32_t subpass = 0;
+        VkSubpassContents subpassContents = VK_SUBPASS_CONTENTS_INLINE;
+
+        /// true when between vkCmdBeginRendering/vkCmdEndRendering, assigned by RenderGraph when using dynamic rendering.
+        bool dynamicRendering = false;
+
         MatrixStack projectionMatrixStack{0};
         MatrixStack modelviewMatrixStack{64};
 
+        /// coalesces consecutive indexed draws when VK_EXT_multi_draw is enabled, see RecordTraversal::apply(const VertexIndexDraw&).
+        DrawBatch drawBatch;
+
+        /// when assigned, the commands recorded by record() and the RecordTraversal are appended to capturedCommands, used by FrameCapture.
+        Commands* capturedCommands = nullptr;
+
+        /// append command to capturedCommands
+        void capture(const Command& command);
+
+        /// append a PushConstants of the matrix pushed at offset to capturedCommands
+        void capture(uint32_t offset, const mat4& matrix);
+
         void reserve(const Slots& in_maxSlots);
 
         void connect(ref_ptr<CommandBuffer> commandBuffer);
@@ -298,13 +468,16 @@ namespace vsg
 
         void inherit(const State& state);
 
-        inline void dirtyStateStacks()
+        /// dirty the state stacks so the next record() re-records the current state. If dirtyBindings is true the CommandBuffer's tracking of the bound
+        /// descriptor sets and push constants is discarded as well, so this must be called after recording Vulkan bind or push constant commands directly.
+        inline void dirtyStateStacks(bool dirtyBindings = true)
         {
             dirty = true;
             for (auto& stateStack : stateStacks)
             {
                 stateStack.dirty();
             }
+            if (dirtyBindings && _commandBuffer) _commandBuffer->dirtyBindings();
         }
 
         void setInhertiedViewProjectionAndViewMatrix(const dmat4& projMatrix, const dmat4& viewMatrix)
@@ -335,20 +508,64 @@ namespace vsg
             pushFrustum();
         }
 
+        /// replace the view frustum used for culling with that of a separate culling camera, such as one enclosing a stereo pair, must be called after setProjectionAndViewMatrix(..).
+        /// The LOD scaling continues to use the projection and view matrix passed to setProjectionAndViewMatrix(..).
+        void setCullingProjectionAndViewMatrix(const dmat4& projMatrix, const dmat4& viewMatrix)
+        {
+            const auto& mv = modelviewMatrixStack.top();
+            _frustumProjected.set(_frustumUnit, projMatrix * viewMatrix * inverse(mv));
+            _frustumStack.top().set(_frustumProjected, mv);
+        }
+
+        /// record any draws held back by drawBatch, must be called before recording commands that aren't preceded by a call to record().
+        inline void flushDraws()
+        {
+            if (!drawBatch.empty()) drawBatch.flush(*_commandBuffer);
+        }
+
+        /// record the state required by a draw that's to be added to drawBatch, the pending draws are only flushed if the recorded state changes.
+        inline void recordForDrawBatch()
+        {
+            if (dirty)
+            {
+                if (!drawBatch.empty())
+                {
+                    bool changed = projectionMatrixStack.dirty || modelviewMatrixStack.dirty;
+                    for (uint32_t slot = 0; slot <= activeMaxStateSlot && !changed; ++slot)
+                    {
+                        changed = stateStacks[slot].changed();
+                    }
+                    if (changed) drawBatch.flush(*_commandBuffer);
+                }
+
+                _record();
+            }
+        }
+
         inline void record()
+        {
+            flushDraws();
+            _record();
+        }
+
+        inline void _record()
         {
             if (dirty)
             {
                 for (uint32_t slot = 0; slot <= activeMaxStateSlot; ++slot)
                 {
-                    stateStacks[slot].record(*_commandBuffer);
+                    auto recorded = stateStacks[slot].record(*_commandBuffer);
+                    if (recorded && capturedCommands) capture(*recorded);
                 }
 
                 // reset the active maxslot to the minimum required
                 activeMaxStateSlot = maxSlots.state;
 
-                projectionMatrixStack.record(*_commandBuffer);
-                modelviewMatrixStack.record(*_commandBuffer);
+                auto projectionMatrix = projectionMatrixStack.record(*_commandBuffer);
+                if (projectionMatrix && capturedCommands) capture(projectionMatrixStack.offset, *projectionMatrix);
+
+                auto modelviewMatrix = modelviewMatrixStack.record(*_commandBuffer);
+                if (modelviewMatrix && capturedCommands) capture(modelviewMatrixStack.offset, *modelviewMatrix);
 
                 dirty = false;
             }
@@ -430,6 +647,13 @@ namespace vsg
             return _frustumStack.top().intersect(s);
         }
 
+        /// batched version of intersect(sphere), see Frustum::intersect(spheres, count, visible)
+        template<typename T>
+        size_t intersect(const t_sphere<T>* spheres, size_t count, uint8_t* visible) const
+        {
+            return _frustumStack.top().intersect(spheres, count, visible);
+        }
+
         template<typename T>
         T lodDistance(const t_sphere<T>& s) const
         {
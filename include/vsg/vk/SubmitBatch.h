@@ -0,0 +1,52 @@
+#pragma once
+
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/vk/Fence.h>
+#include <vsg/vk/Queue.h>
+
+namespace vsg
+{
+
+    /// SubmitBatch collects the VkSubmitInfo of several submissions to the same Queue so that they can be submitted with a single vkQueueSubmit call.
+    /// The VkSubmitInfo, and the arrays they point to, must remain valid until submit() has been called.
+    /// Used by the Viewer to combine the submissions of the RecordAndSubmitTasks that share a Queue.
+    class VSG_DECLSPEC SubmitBatch : public Inherit<Object, SubmitBatch>
+    {
+    public:
+        explicit SubmitBatch(ref_ptr<Queue> in_queue);
+
+        ref_ptr<Queue> queue;
+        std::vector<VkSubmitInfo> submitInfos;
+
+        /// Fence signaled once all the batched submissions have completed
+        ref_ptr<Fence> fence;
+
+        /// add a submission, thread safe so tasks submitting from different threads can share a SubmitBatch.
+        /// As vkQueueSubmit only takes a single Fence any submissions already batched with a Fence are submitted first when in_fence is assigned.
+        VkResult add(const VkSubmitInfo& submitInfo, Fence* in_fence = nullptr);
+
+        /// submit all the batched submissions in a single vkQueueSubmit call and clear the batch.
+        VkResult submit();
+
+    protected:
+        virtual ~SubmitBatch();
+
+        std::mutex _mutex;
+
+        VkResult _submit();
+    };
+    VSG_type_name(vsg::SubmitBatch);
+
+} // namespace vsg
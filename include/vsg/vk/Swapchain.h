@@ -59,6 +59,19 @@ namespace vsg
         /// call vkAcquireNextImageKHR
         VkResult acquireNextImage(uint64_t timeout, ref_ptr<Semaphore> semaphore, ref_ptr<Fence> fence, uint32_t& imageIndex);
 
+        /// return true if the Device was created with the VK_KHR_present_id extension, requires the VkPhysicalDevicePresentIdFeaturesKHR::presentId feature to be enabled.
+        bool supportsPresentId() const;
+
+        /// return true if the Device was created with the VK_KHR_present_wait extension, requires the VkPhysicalDevicePresentWaitFeaturesKHR::presentWait feature to be enabled.
+        bool supportsPresentWait() const;
+
+        /// return the next present id to pass to vkQueuePresentKHR via VkPresentIdKHR, present ids start at 1 and increase with each present.
+        uint64_t nextPresentId() { return ++_presentId; }
+
+        /// call vkWaitForPresentKHR to wait till the image presented with presentId has been displayed, timeout is in nanoseconds.
+        /// Returns VK_ERROR_EXTENSION_NOT_PRESENT when VK_KHR_present_wait isn't supported.
+        VkResult waitForPresent(uint64_t presentId, uint64_t timeout) const;
+
     protected:
         virtual ~Swapchain();
 
@@ -68,6 +81,7 @@ namespace vsg
         VkFormat _format;
         VkExtent2D _extent;
         ImageViews _imageViews;
+        uint64_t _presentId = 0;
     };
     VSG_type_name(vsg::Swapchain);
 
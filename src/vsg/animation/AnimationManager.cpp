@@ -11,6 +11,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/animation/AnimationManager.h>
+#include <vsg/threading/Latch.h>
 
 using namespace vsg;
 
@@ -81,6 +82,66 @@ void AnimationManager::run(vsg::ref_ptr<vsg::FrameStamp> frameStamp)
 
     _simulationTime = frameStamp->simulationTime;
 
+    uint32_t animationsPerOperation = std::max(minimumAnimationsPerOperation, 1u);
+    if (operationThreads && animations.size() > animationsPerOperation)
+    {
+        struct UpdateAnimations : public Inherit<Operation, UpdateAnimations>
+        {
+            UpdateAnimations(AnimationManager* in_manager, Animation** in_animations, uint8_t* in_results, size_t in_count, ref_ptr<Latch> in_latch) :
+                manager(in_manager),
+                animations(in_animations),
+                results(in_results),
+                count(in_count),
+                latch(in_latch) {}
+
+            void run() override
+            {
+                for (size_t i = 0; i < count; ++i)
+                {
+                    results[i] = manager->update(*animations[i]) ? 1 : 0;
+                }
+                latch->count_down();
+            }
+
+            AnimationManager* manager;
+            Animation** animations;
+            uint8_t* results;
+            size_t count;
+            ref_ptr<Latch> latch;
+        };
+
+        _updateAnimations.clear();
+        for (auto& animation : animations) _updateAnimations.push_back(animation.get());
+        _updateResults.resize(_updateAnimations.size());
+
+        size_t numAnimations = _updateAnimations.size();
+        size_t numOperations = (numAnimations + animationsPerOperation - 1) / animationsPerOperation;
+        auto latch = Latch::create(static_cast<int>(numOperations));
+
+        // hand all but the first batch to the operationThreads, the first batch is updated by this thread before helping with the rest
+        for (size_t begin = animationsPerOperation; begin < numAnimations; begin += animationsPerOperation)
+        {
+            size_t count = std::min(static_cast<size_t>(animationsPerOperation), numAnimations - begin);
+            operationThreads->add(UpdateAnimations::create(this, &_updateAnimations[begin], &_updateResults[begin], count, latch));
+        }
+
+        UpdateAnimations(this, _updateAnimations.data(), _updateResults.data(), animationsPerOperation, latch).run();
+
+        // help out with any batches not yet taken by the operationThreads
+        operationThreads->wait(*latch);
+
+        // remove the animations that have finished
+        auto result_itr = _updateResults.begin();
+        for (auto itr = animations.begin(); itr != animations.end();)
+        {
+            if (*(result_itr++))
+                ++itr;
+            else
+                itr = animations.erase(itr);
+        }
+        return;
+    }
+
     for (auto itr = animations.begin(); itr != animations.end();)
     {
         if (update(**itr))
@@ -0,0 +1,322 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/animation/JointPalette.h>
+#include <vsg/core/Exception.h>
+#include <vsg/io/Logger.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
+
+using namespace vsg;
+
+namespace
+{
+    const uint32_t s_workgroupSize = 64;
+
+    // matches the PushConstants block in the joint palette and skinning compute shaders.
+    struct JointPalettePushConstants
+    {
+        uint32_t jointCount;
+        uint32_t instanceCount;
+        uint32_t jointStride;
+        uint32_t vertexCount;
+    };
+
+    const char* s_jointPaletteSource = R"(#version 450
+
+layout(local_size_x = 64) in;
+
+layout(push_constant) uniform PushConstants {
+    uint jointCount;
+    uint instanceCount;
+    uint jointStride;
+    uint vertexCount;
+} pc;
+
+layout(std430, set = 0, binding = 0) readonly buffer LocalMatrices { mat4 localMatrices[]; };
+layout(std430, set = 0, binding = 1) readonly buffer ParentIndices { int parentIndices[]; };
+layout(std430, set = 0, binding = 2) readonly buffer OffsetMatrices { mat4 offsetMatrices[]; };
+layout(std430, set = 0, binding = 3) writeonly buffer JointMatrices { mat4 jointMatrices[]; };
+
+void main()
+{
+    uint joint = gl_GlobalInvocationID.x;
+    uint instance = gl_GlobalInvocationID.y;
+    if (joint >= pc.jointCount || instance >= pc.instanceCount) return;
+
+    // accumulate the local matrices up the parent chain, the depth check guards against cycles
+    uint base = instance * pc.jointCount;
+    mat4 matrix = localMatrices[base + joint];
+    int parent = parentIndices[joint];
+    for (uint depth = 0; parent >= 0 && depth < pc.jointCount; ++depth)
+    {
+        matrix = localMatrices[base + uint(parent)] * matrix;
+        parent = parentIndices[parent];
+    }
+
+    jointMatrices[instance * pc.jointStride + joint] = matrix * offsetMatrices[joint];
+}
+)";
+
+    const char* s_skinningHeader = R"(#version 450
+)";
+
+    const char* s_skinningSource = R"(
+layout(local_size_x = 64) in;
+
+layout(push_constant) uniform PushConstants {
+    uint jointCount;
+    uint instanceCount;
+    uint jointStride;
+    uint vertexCount;
+} pc;
+
+layout(std430, set = 0, binding = 3) readonly buffer JointMatrices { mat4 jointMatrices[]; };
+layout(std430, set = 0, binding = 4) readonly buffer Vertices { float vertices[]; };
+layout(std430, set = 0, binding = 6) readonly buffer JointIndices { ivec4 jointIndices[]; };
+layout(std430, set = 0, binding = 7) readonly buffer JointWeights { vec4 jointWeights[]; };
+layout(std430, set = 0, binding = 8) writeonly buffer SkinnedVertices { float skinnedVertices[]; };
+
+#ifdef SKIN_NORMALS
+layout(std430, set = 0, binding = 5) readonly buffer Normals { float normals[]; };
+layout(std430, set = 0, binding = 9) writeonly buffer SkinnedNormals { float skinnedNormals[]; };
+#endif
+
+void main()
+{
+    uint v = gl_GlobalInvocationID.x;
+    uint instance = gl_GlobalInvocationID.y;
+    if (v >= pc.vertexCount || instance >= pc.instanceCount) return;
+
+    uint base = instance * pc.jointStride;
+    ivec4 indices = jointIndices[v];
+    vec4 weights = jointWeights[v];
+    mat4 skinMatrix = weights.x * jointMatrices[base + uint(indices.x)] +
+                      weights.y * jointMatrices[base + uint(indices.y)] +
+                      weights.z * jointMatrices[base + uint(indices.z)] +
+                      weights.w * jointMatrices[base + uint(indices.w)];
+
+    uint src = v * 3;
+    uint dest = (instance * pc.vertexCount + v) * 3;
+
+    vec3 vertex = (skinMatrix * vec4(vertices[src], vertices[src + 1], vertices[src + 2], 1.0)).xyz;
+    skinnedVertices[dest] = vertex.x;
+    skinnedVertices[dest + 1] = vertex.y;
+    skinnedVertices[dest + 2] = vertex.z;
+
+#ifdef SKIN_NORMALS
+    vec3 normal = normalize(mat3(skinMatrix) * vec3(normals[src], normals[src + 1], normals[src + 2]));
+    skinnedNormals[dest] = normal.x;
+    skinnedNormals[dest + 1] = normal.y;
+    skinnedNormals[dest + 2] = normal.z;
+#endif
+}
+)";
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// JointPalette
+//
+JointPalette::JointPalette()
+{
+}
+
+JointPalette::~JointPalette()
+{
+}
+
+void JointPalette::init()
+{
+    _bindPaletteComputePipeline = {};
+    _bindSkinningComputePipeline = {};
+    _bindDescriptorSet = {};
+    _skinningInputs.clear();
+    instanceJointMatrices.clear();
+    instanceSkinnedVertices.clear();
+    instanceSkinnedNormals.clear();
+
+    if (jointCount == 0 || instanceCount == 0 || !localMatrices || !parentIndices || !offsetMatrices) return;
+
+    if (localMatrices->size() < instanceCount * jointCount || parentIndices->size() < jointCount || offsetMatrices->size() < jointCount)
+    {
+        warn("JointPalette::init() localMatrices, parentIndices or offsetMatrices too small for jointCount = ", jointCount, ", instanceCount = ", instanceCount);
+        return;
+    }
+
+    // the local matrices are updated each frame so must be dynamic to be transferred by the TransferTask
+    localMatrices->properties.dataVariance = DYNAMIC_DATA;
+
+    _localMatrices = BufferInfo::create(localMatrices);
+    _parentIndices = BufferInfo::create(parentIndices);
+    _offsetMatrices = BufferInfo::create(offsetMatrices);
+
+    VkDeviceSize paletteSize = sizeof(mat4) * jointStride();
+    jointMatrices = BufferInfo::create(Buffer::create(paletteSize * instanceCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE), 0, paletteSize * instanceCount);
+    for (uint32_t i = 0; i < instanceCount; ++i)
+    {
+        instanceJointMatrices.push_back(BufferInfo::create(jointMatrices->buffer, paletteSize * i, sizeof(mat4) * jointCount));
+    }
+
+    VkShaderStageFlags stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    DescriptorSetLayoutBindings bindings;
+    Descriptors descriptors;
+    auto addBinding = [&](uint32_t binding, ref_ptr<BufferInfo> bufferInfo) {
+        bindings.push_back(VkDescriptorSetLayoutBinding{binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr});
+        descriptors.push_back(DescriptorBuffer::create(BufferInfoList{bufferInfo}, binding, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+    };
+
+    addBinding(0, _localMatrices);
+    addBinding(1, _parentIndices);
+    addBinding(2, _offsetMatrices);
+    addBinding(3, jointMatrices);
+
+    bool preSkinning = vertices && jointIndices && jointWeights && jointIndices->size() >= vertices->size() && jointWeights->size() >= vertices->size();
+    bool skinNormals = preSkinning && normals && normals->size() >= vertices->size();
+    if (preSkinning)
+    {
+        VkDeviceSize skinnedSize = sizeof(vec3) * vertices->size();
+        VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+
+        auto vertexInput = BufferInfo::create(vertices);
+        auto jointIndicesInput = BufferInfo::create(jointIndices);
+        auto jointWeightsInput = BufferInfo::create(jointWeights);
+        _skinningInputs = {vertexInput, jointIndicesInput, jointWeightsInput};
+
+        skinnedVertices = BufferInfo::create(Buffer::create(skinnedSize * instanceCount, usage, VK_SHARING_MODE_EXCLUSIVE), 0, skinnedSize * instanceCount);
+        for (uint32_t i = 0; i < instanceCount; ++i) instanceSkinnedVertices.push_back(BufferInfo::create(skinnedVertices->buffer, skinnedSize * i, skinnedSize));
+
+        addBinding(4, vertexInput);
+        addBinding(6, jointIndicesInput);
+        addBinding(7, jointWeightsInput);
+        addBinding(8, skinnedVertices);
+
+        if (skinNormals)
+        {
+            auto normalInput = BufferInfo::create(normals);
+            _skinningInputs.push_back(normalInput);
+
+            skinnedNormals = BufferInfo::create(Buffer::create(skinnedSize * instanceCount, usage, VK_SHARING_MODE_EXCLUSIVE), 0, skinnedSize * instanceCount);
+            for (uint32_t i = 0; i < instanceCount; ++i) instanceSkinnedNormals.push_back(BufferInfo::create(skinnedNormals->buffer, skinnedSize * i, skinnedSize));
+
+            addBinding(5, normalInput);
+            addBinding(9, skinnedNormals);
+        }
+        else
+        {
+            skinnedNormals = {};
+        }
+    }
+    else
+    {
+        skinnedVertices = {};
+        skinnedNormals = {};
+    }
+
+    auto descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    _pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{descriptorSetLayout}, PushConstantRanges{{stageFlags, 0, static_cast<uint32_t>(sizeof(JointPalettePushConstants))}});
+
+    auto paletteShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", s_jointPaletteSource);
+    _bindPaletteComputePipeline = BindComputePipeline::create(ComputePipeline::create(_pipelineLayout, paletteShader));
+
+    if (preSkinning)
+    {
+        std::string source = std::string(s_skinningHeader) + (skinNormals ? "#define SKIN_NORMALS\n" : "") + s_skinningSource;
+        auto skinningShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", source);
+        _bindSkinningComputePipeline = BindComputePipeline::create(ComputePipeline::create(_pipelineLayout, skinningShader));
+    }
+
+    _bindDescriptorSet = BindDescriptorSet::create(VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout, 0, DescriptorSet::create(descriptorSetLayout, descriptors));
+}
+
+void JointPalette::compile(Context& context)
+{
+    if (!_bindPaletteComputePipeline) return;
+
+    auto deviceID = context.deviceID;
+
+    // the output buffers are allocated up front so that they can be shared with the descriptors and vertex bindings of the subgraphs that use them
+    auto allocate = [&](BufferInfo& bufferInfo) -> void {
+        auto& buffer = bufferInfo.buffer;
+        buffer->compile(context.device);
+        if (buffer->getDeviceMemory(deviceID) == nullptr)
+        {
+            auto memRequirements = buffer->getMemoryRequirements(deviceID);
+            auto [deviceMemory, offset] = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            if (!deviceMemory)
+            {
+                throw Exception{"Error: JointPalette::compile(..) failed to allocate buffer from deviceMemoryBufferPools.", VK_ERROR_OUT_OF_DEVICE_MEMORY};
+            }
+            buffer->bind(deviceMemory, offset);
+        }
+    };
+
+    allocate(*jointMatrices);
+    if (skinnedVertices) allocate(*skinnedVertices);
+    if (skinnedNormals) allocate(*skinnedNormals);
+
+    // each input is given its own buffer so that it starts at an offset suitably aligned for binding as a storage buffer
+    auto transfer = [&](ref_ptr<BufferInfo> bufferInfo) -> void {
+        createBufferAndTransferData(context, BufferInfoList{bufferInfo}, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE);
+    };
+
+    transfer(_localMatrices);
+    transfer(_parentIndices);
+    transfer(_offsetMatrices);
+    for (auto& input : _skinningInputs) transfer(input);
+
+    _bindPaletteComputePipeline->compile(context);
+    if (_bindSkinningComputePipeline) _bindSkinningComputePipeline->compile(context);
+    _bindDescriptorSet->compile(context);
+}
+
+void JointPalette::record(CommandBuffer& commandBuffer) const
+{
+    if (!_bindPaletteComputePipeline) return;
+
+    auto deviceID = commandBuffer.deviceID;
+    VkCommandBuffer cmdBuffer{commandBuffer};
+
+    JointPalettePushConstants pushConstants;
+    pushConstants.jointCount = jointCount;
+    pushConstants.instanceCount = instanceCount;
+    pushConstants.jointStride = jointStride();
+    pushConstants.vertexCount = vertices ? static_cast<uint32_t>(vertices->size()) : 0;
+
+    // wait for previous frames reading the palettes and skinned vertices before overwriting them
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+    _bindPaletteComputePipeline->record(commandBuffer);
+    _bindDescriptorSet->record(commandBuffer);
+    vkCmdPushConstants(cmdBuffer, _pipelineLayout->vk(deviceID), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+    vkCmdDispatch(cmdBuffer, (jointCount + s_workgroupSize - 1) / s_workgroupSize, instanceCount, 1);
+
+    if (_bindSkinningComputePipeline)
+    {
+        VkMemoryBarrier paletteBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT};
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &paletteBarrier, 0, nullptr, 0, nullptr);
+
+        // the skinning pipeline shares the pipeline layout so the descriptor set and push constants remain bound
+        _bindSkinningComputePipeline->record(commandBuffer);
+        vkCmdDispatch(cmdBuffer, (pushConstants.vertexCount + s_workgroupSize - 1) / s_workgroupSize, instanceCount, 1);
+    }
+
+    VkMemoryBarrier outputBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT};
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1, &outputBarrier, 0, nullptr, 0, nullptr);
+
+    // compute pipelines and pipeline layout have been bound outside of vsg::State so force state to be reapplied
+    if (commandBuffer.state) commandBuffer.state->dirtyStateStacks();
+}
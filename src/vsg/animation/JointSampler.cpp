@@ -33,7 +33,10 @@ JointSampler::JointSampler(const JointSampler& rhs, const CopyOp& copyop) :
     Inherit(rhs, copyop),
     jointMatrices(copyop(rhs.jointMatrices)),
     offsetMatrices(rhs.offsetMatrices),
-    subgraph(copyop(rhs.subgraph))
+    subgraph(copyop(rhs.subgraph)),
+    localMatrices(rhs.localMatrices),
+    parentIndices(rhs.parentIndices),
+    localMatricesOffset(rhs.localMatricesOffset)
 {
 }
 
@@ -50,17 +53,27 @@ int JointSampler::compare(const Object& rhs_object) const
 
 void JointSampler::update(double)
 {
-    if (!jointMatrices) return;
+    if (!jointMatrices && !localMatrices) return;
 
     _matrixStack.clear();
     _matrixStack.push_back(dmat4());
+    _parentIndex = -1;
+    _parentIndicesModified = false;
 
     if (subgraph)
     {
         subgraph->accept(*this);
     }
 
-    jointMatrices->dirty();
+    if (localMatrices)
+    {
+        localMatrices->dirty();
+        if (parentIndices && _parentIndicesModified) parentIndices->dirty();
+    }
+    else
+    {
+        jointMatrices->dirty();
+    }
 }
 
 double JointSampler::maxTime() const
@@ -116,6 +129,34 @@ void JointSampler::apply(MatrixTransform& mt)
 
 void JointSampler::apply(Joint& joint)
 {
+    if (localMatrices)
+    {
+        // matrix relative to the parent joint, the transforms between joints are accumulated from identity for each joint's children
+        localMatrices->set(localMatricesOffset + joint.index, mat4(_matrixStack.back() * joint.matrix));
+
+        if (parentIndices && parentIndices->at(joint.index) != _parentIndex)
+        {
+            parentIndices->set(joint.index, _parentIndex);
+            _parentIndicesModified = true;
+        }
+
+        if (!joint.children.empty())
+        {
+            int previousParentIndex = _parentIndex;
+            _parentIndex = static_cast<int>(joint.index);
+            _matrixStack.push_back(dmat4());
+
+            for (auto& child : joint.children)
+            {
+                child->accept(*this);
+            }
+
+            _matrixStack.pop_back();
+            _parentIndex = previousParentIndex;
+        }
+        return;
+    }
+
     auto matrix = _matrixStack.back() * joint.matrix;
     jointMatrices->set(joint.index, mat4(matrix * offsetMatrices[joint.index]));
 
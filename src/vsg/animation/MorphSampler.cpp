@@ -11,6 +11,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/animation/MorphSampler.h>
+#include <vsg/animation/MorphTargets.h>
 #include <vsg/core/compare.h>
 #include <vsg/io/Input.h>
 #include <vsg/io/Logger.h>
@@ -70,7 +71,9 @@ MorphSampler::MorphSampler()
 MorphSampler::MorphSampler(const MorphSampler& rhs, const CopyOp& copyop) :
     Inherit(rhs, copyop),
     keyframes(copyop(rhs.keyframes)),
-    object(copyop(rhs.object))
+    object(copyop(rhs.object)),
+    weights(rhs.weights),
+    weightsOffset(rhs.weightsOffset)
 {
 }
 
@@ -84,10 +87,75 @@ int MorphSampler::compare(const Object& rhs_object) const
     return compare_pointer(object, rhs.object);
 }
 
-void MorphSampler::update(double /*time*/)
+void MorphSampler::update(double time)
 {
-    // TODO write implementation of passing morph values to associated scene graph data structures
-    vsg::warn("MorphSampler::update(double time) not implemented yet");
+    if (!keyframes || keyframes->keyframes.empty()) return;
+
+    // find the key frames that bracket time
+    const auto& keys = keyframes->keyframes;
+    size_t before = 0, after = 0;
+    double r = 0.0;
+    if (keys.size() == 1 || time <= keys.front().time)
+    {
+        before = after = 0;
+    }
+    else if (time >= keys.back().time)
+    {
+        before = after = keys.size() - 1;
+    }
+    else
+    {
+        before = bracket(time, keys, _keyframeIndex, [](const MorphKey& key) { return key.time; });
+        after = before + 1;
+        double delta_time = keys[after].time - keys[before].time;
+        r = delta_time != 0.0 ? (time - keys[before].time) / delta_time : 0.5;
+    }
+    _keyframeIndex = before;
+
+    // blend the weights of the bracketing key frames
+    unsigned int numTargets = 0;
+    for (auto index : {before, after})
+    {
+        for (auto target : keys[index].values) numTargets = std::max(numTargets, target + 1);
+    }
+
+    weights.assign(numTargets, 0.0);
+
+    auto accumulate = [&](const MorphKey& key, double ratio) {
+        size_t count = std::min(key.values.size(), key.weights.size());
+        for (size_t i = 0; i < count; ++i) weights[key.values[i]] += key.weights[i] * ratio;
+    };
+
+    if (before == after)
+    {
+        accumulate(keys[before], 1.0);
+    }
+    else
+    {
+        accumulate(keys[before], 1.0 - r);
+        accumulate(keys[after], r);
+    }
+
+    // pass the weights on to the MorphTargets or floatArray assigned as the object
+    floatArray* targetWeights = nullptr;
+    if (auto morphTargets = object.cast<MorphTargets>())
+        targetWeights = morphTargets->weights;
+    else
+        targetWeights = object.cast<floatArray>();
+
+    if (targetWeights)
+    {
+        if (weightsOffset < targetWeights->size())
+        {
+            size_t count = std::min(weights.size(), targetWeights->size() - weightsOffset);
+            for (size_t i = 0; i < count; ++i) targetWeights->set(weightsOffset + i, static_cast<float>(weights[i]));
+            targetWeights->dirty();
+        }
+    }
+    else if (object)
+    {
+        vsg::warn("MorphSampler::update(double time) object type ", object->className(), " not supported, weights not passed on.");
+    }
 }
 
 double MorphSampler::maxTime() const
@@ -0,0 +1,391 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/animation/MorphTargets.h>
+#include <vsg/core/Exception.h>
+#include <vsg/io/Logger.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
+
+using namespace vsg;
+
+namespace
+{
+    const uint32_t s_workgroupSize = 64;
+
+    // matches the PushConstants block in the morph compute shader.
+    struct MorphPushConstants
+    {
+        uint32_t vertexCount;
+        uint32_t instanceCount;
+        uint32_t targetCount;
+        uint32_t affectedVertexCount;
+    };
+
+    const char* s_morphHeader = R"(#version 450
+)";
+
+    const char* s_morphSource = R"(
+layout(local_size_x = 64) in;
+
+layout(push_constant) uniform PushConstants {
+    uint vertexCount;
+    uint instanceCount;
+    uint targetCount;
+    uint affectedVertexCount;
+} pc;
+
+layout(std430, set = 0, binding = 0) readonly buffer Vertices { float vertices[]; };
+layout(std430, set = 0, binding = 2) readonly buffer AffectedVertices { uint affectedVertices[]; };
+layout(std430, set = 0, binding = 3) readonly buffer DeltaOffsets { uint deltaOffsets[]; };
+layout(std430, set = 0, binding = 4) readonly buffer DeltaTargets { uint deltaTargets[]; };
+layout(std430, set = 0, binding = 5) readonly buffer VertexDeltas { float vertexDeltas[]; };
+layout(std430, set = 0, binding = 7) readonly buffer Weights { float weights[]; };
+layout(std430, set = 0, binding = 8) writeonly buffer MorphedVertices { float morphedVertices[]; };
+
+#ifdef MORPH_NORMALS
+layout(std430, set = 0, binding = 1) readonly buffer Normals { float normals[]; };
+layout(std430, set = 0, binding = 6) readonly buffer NormalDeltas { float normalDeltas[]; };
+layout(std430, set = 0, binding = 9) writeonly buffer MorphedNormals { float morphedNormals[]; };
+#endif
+
+void main()
+{
+    uint a = gl_GlobalInvocationID.x;
+    uint instance = gl_GlobalInvocationID.y;
+    if (a >= pc.affectedVertexCount || instance >= pc.instanceCount) return;
+
+    uint v = affectedVertices[a];
+    uint src = v * 3;
+    vec3 vertex = vec3(vertices[src], vertices[src + 1], vertices[src + 2]);
+#ifdef MORPH_NORMALS
+    vec3 normal = vec3(normals[src], normals[src + 1], normals[src + 2]);
+#endif
+
+    uint weightBase = instance * pc.targetCount;
+    for (uint i = deltaOffsets[a]; i < deltaOffsets[a + 1]; ++i)
+    {
+        float weight = weights[weightBase + deltaTargets[i]];
+        if (weight == 0.0) continue;
+
+        uint d = i * 3;
+        vertex += weight * vec3(vertexDeltas[d], vertexDeltas[d + 1], vertexDeltas[d + 2]);
+#ifdef MORPH_NORMALS
+        normal += weight * vec3(normalDeltas[d], normalDeltas[d + 1], normalDeltas[d + 2]);
+#endif
+    }
+
+    uint dest = (instance * pc.vertexCount + v) * 3;
+    morphedVertices[dest] = vertex.x;
+    morphedVertices[dest + 1] = vertex.y;
+    morphedVertices[dest + 2] = vertex.z;
+
+#ifdef MORPH_NORMALS
+    normal = normalize(normal);
+    morphedNormals[dest] = normal.x;
+    morphedNormals[dest + 1] = normal.y;
+    morphedNormals[dest + 2] = normal.z;
+#endif
+}
+)";
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// MorphTargets
+//
+MorphTargets::MorphTargets()
+{
+}
+
+MorphTargets::~MorphTargets()
+{
+}
+
+void MorphTargets::addTarget(ref_ptr<uintArray> indices, ref_ptr<vec3Array> vertexDeltas, ref_ptr<vec3Array> normalDeltas)
+{
+    targets.push_back(Target{indices, vertexDeltas, normalDeltas});
+}
+
+void MorphTargets::addTarget(const vec3Array& vertexDeltas, const vec3Array* normalDeltas, float threshold)
+{
+    auto exceeds = [&](const vec3& delta) { return std::abs(delta.x) > threshold || std::abs(delta.y) > threshold || std::abs(delta.z) > threshold; };
+
+    std::vector<uint32_t> affected;
+    for (uint32_t i = 0; i < vertexDeltas.size(); ++i)
+    {
+        if (exceeds(vertexDeltas[i]) || (normalDeltas && i < normalDeltas->size() && exceeds(normalDeltas->at(i)))) affected.push_back(i);
+    }
+
+    auto indices = uintArray::create(static_cast<uint32_t>(affected.size()));
+    auto sparseVertexDeltas = vec3Array::create(static_cast<uint32_t>(affected.size()));
+    auto sparseNormalDeltas = normalDeltas ? vec3Array::create(static_cast<uint32_t>(affected.size())) : ref_ptr<vec3Array>();
+    for (uint32_t i = 0; i < affected.size(); ++i)
+    {
+        uint32_t index = affected[i];
+        indices->set(i, index);
+        sparseVertexDeltas->set(i, vertexDeltas[index]);
+        if (sparseNormalDeltas) sparseNormalDeltas->set(i, index < normalDeltas->size() ? normalDeltas->at(index) : vec3());
+    }
+
+    addTarget(indices, sparseVertexDeltas, sparseNormalDeltas);
+}
+
+void MorphTargets::init()
+{
+    _bindComputePipeline = {};
+    _bindDescriptorSet = {};
+    _inputs.clear();
+    morphedVertices = {};
+    morphedNormals = {};
+    instanceMorphedVertices.clear();
+    instanceMorphedNormals.clear();
+    affectedVertexCount = 0;
+
+    if (instanceCount == 0 || !vertices || vertices->size() == 0 || targets.empty()) return;
+
+    uint32_t vertexCount = static_cast<uint32_t>(vertices->size());
+    bool morphNormals = normals && normals->size() >= vertexCount && std::any_of(targets.begin(), targets.end(), [](const Target& target) { return target.normalDeltas.valid(); });
+
+    // count the deltas of each vertex so the targets can be merged into a list of deltas per affected vertex
+    std::vector<uint32_t> deltaCounts(vertexCount, 0);
+    uint32_t deltaCount = 0;
+    bool invalidIndices = false;
+    for (auto& target : targets)
+    {
+        if (!target.indices || !target.vertexDeltas) continue;
+
+        uint32_t count = std::min(static_cast<uint32_t>(target.indices->size()), static_cast<uint32_t>(target.vertexDeltas->size()));
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t index = target.indices->at(i);
+            if (index < vertexCount)
+            {
+                ++deltaCounts[index];
+                ++deltaCount;
+            }
+            else
+            {
+                invalidIndices = true;
+            }
+        }
+    }
+
+    if (invalidIndices) warn("MorphTargets::init() ignoring target indices beyond the ", vertexCount, " vertices.");
+
+    if (deltaCount == 0)
+    {
+        warn("MorphTargets::init() no target deltas, nothing to morph.");
+        return;
+    }
+
+    std::vector<uint32_t> affectedIndex(vertexCount, 0);
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        if (deltaCounts[v] > 0) affectedIndex[v] = affectedVertexCount++;
+    }
+
+    auto affectedVertices = uintArray::create(affectedVertexCount);
+    auto deltaOffsets = uintArray::create(affectedVertexCount + 1);
+    uint32_t offset = 0;
+    for (uint32_t v = 0; v < vertexCount; ++v)
+    {
+        if (deltaCounts[v] == 0) continue;
+
+        affectedVertices->set(affectedIndex[v], v);
+        deltaOffsets->set(affectedIndex[v], offset);
+        offset += deltaCounts[v];
+    }
+    deltaOffsets->set(affectedVertexCount, offset);
+
+    auto deltaTargets = uintArray::create(deltaCount);
+    auto vertexDeltas = vec3Array::create(deltaCount);
+    auto normalDeltas = morphNormals ? vec3Array::create(deltaCount) : ref_ptr<vec3Array>();
+
+    std::vector<uint32_t> cursors(affectedVertexCount);
+    for (uint32_t a = 0; a < affectedVertexCount; ++a) cursors[a] = deltaOffsets->at(a);
+
+    for (uint32_t t = 0; t < targets.size(); ++t)
+    {
+        auto& target = targets[t];
+        if (!target.indices || !target.vertexDeltas) continue;
+
+        uint32_t count = std::min(static_cast<uint32_t>(target.indices->size()), static_cast<uint32_t>(target.vertexDeltas->size()));
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint32_t index = target.indices->at(i);
+            if (index >= vertexCount) continue;
+
+            uint32_t d = cursors[affectedIndex[index]]++;
+            deltaTargets->set(d, t);
+            vertexDeltas->set(d, target.vertexDeltas->at(i));
+            if (normalDeltas) normalDeltas->set(d, (target.normalDeltas && i < target.normalDeltas->size()) ? target.normalDeltas->at(i) : vec3());
+        }
+    }
+
+    uint32_t weightCount = instanceCount * targetCount();
+    if (!weights || weights->size() < weightCount) weights = floatArray::create(weightCount, 0.0f);
+
+    // the weights are updated each frame so must be dynamic to be transferred by the TransferTask
+    weights->properties.dataVariance = DYNAMIC_DATA;
+
+    _vertices = BufferInfo::create(vertices);
+    _weights = BufferInfo::create(weights);
+
+    VkDeviceSize morphedSize = sizeof(vec3) * vertexCount;
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    morphedVertices = BufferInfo::create(Buffer::create(morphedSize * instanceCount, usage, VK_SHARING_MODE_EXCLUSIVE), 0, morphedSize * instanceCount);
+    for (uint32_t i = 0; i < instanceCount; ++i) instanceMorphedVertices.push_back(BufferInfo::create(morphedVertices->buffer, morphedSize * i, morphedSize));
+
+    VkShaderStageFlags stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    DescriptorSetLayoutBindings bindings;
+    Descriptors descriptors;
+    auto addBinding = [&](uint32_t binding, ref_ptr<BufferInfo> bufferInfo) {
+        bindings.push_back(VkDescriptorSetLayoutBinding{binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr});
+        descriptors.push_back(DescriptorBuffer::create(BufferInfoList{bufferInfo}, binding, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+    };
+    auto addInput = [&](uint32_t binding, ref_ptr<Data> data) {
+        auto bufferInfo = BufferInfo::create(data);
+        _inputs.push_back(bufferInfo);
+        addBinding(binding, bufferInfo);
+    };
+
+    addBinding(0, _vertices);
+    addInput(2, affectedVertices);
+    addInput(3, deltaOffsets);
+    addInput(4, deltaTargets);
+    addInput(5, vertexDeltas);
+    addBinding(7, _weights);
+    addBinding(8, morphedVertices);
+
+    if (morphNormals)
+    {
+        _normals = BufferInfo::create(normals);
+
+        morphedNormals = BufferInfo::create(Buffer::create(morphedSize * instanceCount, usage, VK_SHARING_MODE_EXCLUSIVE), 0, morphedSize * instanceCount);
+        for (uint32_t i = 0; i < instanceCount; ++i) instanceMorphedNormals.push_back(BufferInfo::create(morphedNormals->buffer, morphedSize * i, morphedSize));
+
+        addBinding(1, _normals);
+        addInput(6, normalDeltas);
+        addBinding(9, morphedNormals);
+    }
+    else
+    {
+        _normals = {};
+    }
+
+    auto descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    _pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{descriptorSetLayout}, PushConstantRanges{{stageFlags, 0, static_cast<uint32_t>(sizeof(MorphPushConstants))}});
+
+    std::string source = std::string(s_morphHeader) + (morphNormals ? "#define MORPH_NORMALS\n" : "") + s_morphSource;
+    auto morphShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", source);
+    _bindComputePipeline = BindComputePipeline::create(ComputePipeline::create(_pipelineLayout, morphShader));
+
+    _bindDescriptorSet = BindDescriptorSet::create(VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout, 0, DescriptorSet::create(descriptorSetLayout, descriptors));
+}
+
+void MorphTargets::compile(Context& context)
+{
+    if (!_bindComputePipeline) return;
+
+    auto deviceID = context.deviceID;
+
+    // the output buffers are allocated up front so that they can be shared with the vertex bindings of the subgraphs that use them
+    auto allocate = [&](BufferInfo& bufferInfo) -> void {
+        auto& buffer = bufferInfo.buffer;
+        buffer->compile(context.device);
+        if (buffer->getDeviceMemory(deviceID) == nullptr)
+        {
+            auto memRequirements = buffer->getMemoryRequirements(deviceID);
+            auto [deviceMemory, offset] = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            if (!deviceMemory)
+            {
+                throw Exception{"Error: MorphTargets::compile(..) failed to allocate buffer from deviceMemoryBufferPools.", VK_ERROR_OUT_OF_DEVICE_MEMORY};
+            }
+            buffer->bind(deviceMemory, offset);
+        }
+    };
+
+    allocate(*morphedVertices);
+    if (morphedNormals) allocate(*morphedNormals);
+
+    // each input is given its own buffer so that it starts at an offset suitably aligned for binding as a storage buffer,
+    // the base vertices and normals are also the source of the copies that initialize the outputs
+    auto transfer = [&](ref_ptr<BufferInfo> bufferInfo, VkBufferUsageFlags usage) -> void {
+        createBufferAndTransferData(context, BufferInfoList{bufferInfo}, usage, VK_SHARING_MODE_EXCLUSIVE);
+    };
+
+    transfer(_vertices, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    if (_normals) transfer(_normals, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    transfer(_weights, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    for (auto& input : _inputs) transfer(input, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+
+    _bindComputePipeline->compile(context);
+    _bindDescriptorSet->compile(context);
+}
+
+void MorphTargets::record(CommandBuffer& commandBuffer) const
+{
+    if (!_bindComputePipeline) return;
+
+    auto deviceID = commandBuffer.deviceID;
+    auto& recordState = _recordState[deviceID];
+
+    // the outputs from the last record remain valid until the weights are modified
+    bool initialize = !recordState.initialized;
+    bool weightsModified = _weights->data->getModifiedCount(recordState.weightsModifiedCount);
+    if (!initialize && !weightsModified) return;
+
+    VkCommandBuffer cmdBuffer{commandBuffer};
+
+    // wait for previous frames reading the morphed vertices before overwriting them
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+    if (initialize)
+    {
+        // the vertices not affected by any target are never written by the compute shader, so copy the base vertices and normals to all the outputs once
+        auto copyBase = [&](const BufferInfo& base, const BufferInfo& output) {
+            VkDeviceSize size = base.range;
+            std::vector<VkBufferCopy> regions;
+            for (uint32_t i = 0; i < instanceCount; ++i) regions.push_back(VkBufferCopy{base.offset, output.offset + size * i, size});
+            vkCmdCopyBuffer(cmdBuffer, base.buffer->vk(deviceID), output.buffer->vk(deviceID), static_cast<uint32_t>(regions.size()), regions.data());
+        };
+
+        copyBase(*_vertices, *morphedVertices);
+        if (morphedNormals) copyBase(*_normals, *morphedNormals);
+
+        VkMemoryBarrier copyBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_WRITE_BIT};
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &copyBarrier, 0, nullptr, 0, nullptr);
+
+        recordState.initialized = true;
+    }
+
+    MorphPushConstants pushConstants;
+    pushConstants.vertexCount = static_cast<uint32_t>(vertices->size());
+    pushConstants.instanceCount = instanceCount;
+    pushConstants.targetCount = targetCount();
+    pushConstants.affectedVertexCount = affectedVertexCount;
+
+    _bindComputePipeline->record(commandBuffer);
+    _bindDescriptorSet->record(commandBuffer);
+    vkCmdPushConstants(cmdBuffer, _pipelineLayout->vk(deviceID), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+    vkCmdDispatch(cmdBuffer, (affectedVertexCount + s_workgroupSize - 1) / s_workgroupSize, instanceCount, 1);
+
+    VkMemoryBarrier outputBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT};
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1, &outputBarrier, 0, nullptr, 0, nullptr);
+
+    // compute pipelines and pipeline layout have been bound outside of vsg::State so force state to be reapplied
+    if (commandBuffer.state) commandBuffer.state->dirtyStateStacks();
+}
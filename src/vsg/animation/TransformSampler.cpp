@@ -29,6 +29,35 @@ TransformKeyframes::TransformKeyframes()
 {
 }
 
+void TransformKeyframes::compact(bool quantizeRotations)
+{
+    compactPositions.clear();
+    compactPositions.reserve(positions.size());
+    for (const auto& position : positions) compactPositions.push_back(position.time, vec3(position.value));
+
+    compactRotations.clear();
+    quantizedRotations.clear();
+    if (quantizeRotations)
+    {
+        quantizedRotations.reserve(rotations.size());
+        for (const auto& rotation : rotations) quantizedRotations.push_back(rotation.time, quantized_quat(rotation.value));
+    }
+    else
+    {
+        compactRotations.reserve(rotations.size());
+        for (const auto& rotation : rotations) compactRotations.push_back(rotation.time, quat(rotation.value));
+    }
+
+    compactScales.clear();
+    compactScales.reserve(scales.size());
+    for (const auto& scale : scales) compactScales.push_back(scale.time, vec3(scale.value));
+
+    // release the original key frames
+    std::vector<VectorKey>().swap(positions);
+    std::vector<QuatKey>().swap(rotations);
+    std::vector<VectorKey>().swap(scales);
+}
+
 void TransformKeyframes::read(Input& input)
 {
     Object::read(input);
@@ -72,35 +101,49 @@ void TransformKeyframes::write(Output& output) const
 
     output.write("name", name);
 
+    // compact key frames are written out in the same form as the original key frames
+    auto writeKeys = [&output](const char* keysName, const char* keyName, const auto& keys) {
+        output.writeValue<uint32_t>(keysName, keys.size());
+        for (const auto& key : keys)
+        {
+            output.writePropertyName(keyName);
+            output.write(1, &key.time);
+            output.write(1, &key.value);
+            output.writeEndOfLine();
+        }
+    };
+
+    auto writeCompactKeys = [&output](const char* keysName, const char* keyName, const auto& keys, auto value) {
+        output.writeValue<uint32_t>(keysName, keys.size());
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            value = decltype(value)(keys.values[i]);
+            output.writePropertyName(keyName);
+            output.write(1, &keys.times[i]);
+            output.write(1, &value);
+            output.writeEndOfLine();
+        }
+    };
+
     // write position key frames
-    output.writeValue<uint32_t>("positions", positions.size());
-    for (const auto& position : positions)
-    {
-        output.writePropertyName("position");
-        output.write(1, &position.time);
-        output.write(1, &position.value);
-        output.writeEndOfLine();
-    }
+    if (!compactPositions.empty())
+        writeCompactKeys("positions", "position", compactPositions, dvec3());
+    else
+        writeKeys("positions", "position", positions);
 
     // write rotation key frames
-    output.writeValue<uint32_t>("rotations", rotations.size());
-    for (const auto& rotation : rotations)
-    {
-        output.writePropertyName("rotation");
-        output.write(1, &rotation.time);
-        output.write(1, &rotation.value);
-        output.writeEndOfLine();
-    }
+    if (!quantizedRotations.empty())
+        writeCompactKeys("rotations", "rotation", quantizedRotations, dquat());
+    else if (!compactRotations.empty())
+        writeCompactKeys("rotations", "rotation", compactRotations, dquat());
+    else
+        writeKeys("rotations", "rotation", rotations);
 
     // write scale key frames
-    output.writeValue<uint32_t>("scales", scales.size());
-    for (const auto& scale : scales)
-    {
-        output.writePropertyName("scale");
-        output.write(1, &scale.time);
-        output.write(1, &scale.value);
-        output.writeEndOfLine();
-    }
+    if (!compactScales.empty())
+        writeCompactKeys("scales", "scale", compactScales, dvec3());
+    else
+        writeKeys("scales", "scale", scales);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -138,9 +181,24 @@ void TransformSampler::update(double time)
 {
     if (keyframes)
     {
-        sample(time, keyframes->positions, position);
-        sample(time, keyframes->rotations, rotation);
-        sample(time, keyframes->scales, scale);
+        const auto& kf = *keyframes;
+
+        if (!kf.compactPositions.empty())
+            sample(time, kf.compactPositions, position, _positionIndex);
+        else
+            sample(time, kf.positions, position, _positionIndex);
+
+        if (!kf.quantizedRotations.empty())
+            sample(time, kf.quantizedRotations, rotation, _rotationIndex);
+        else if (!kf.compactRotations.empty())
+            sample(time, kf.compactRotations, rotation, _rotationIndex);
+        else
+            sample(time, kf.rotations, rotation, _rotationIndex);
+
+        if (!kf.compactScales.empty())
+            sample(time, kf.compactScales, scale, _scaleIndex);
+        else
+            sample(time, kf.scales, scale, _scaleIndex);
     }
 
     if (object) object->accept(*this);
@@ -154,6 +212,10 @@ double TransformSampler::maxTime() const
         if (!keyframes->positions.empty()) maxTime = std::max(maxTime, keyframes->positions.back().time);
         if (!keyframes->rotations.empty()) maxTime = std::max(maxTime, keyframes->rotations.back().time);
         if (!keyframes->scales.empty()) maxTime = std::max(maxTime, keyframes->scales.back().time);
+        if (!keyframes->compactPositions.empty()) maxTime = std::max(maxTime, keyframes->compactPositions.times.back());
+        if (!keyframes->compactRotations.empty()) maxTime = std::max(maxTime, keyframes->compactRotations.times.back());
+        if (!keyframes->quantizedRotations.empty()) maxTime = std::max(maxTime, keyframes->quantizedRotations.times.back());
+        if (!keyframes->compactScales.empty()) maxTime = std::max(maxTime, keyframes->compactScales.times.back());
     }
 
     return maxTime;
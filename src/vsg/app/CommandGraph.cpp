@@ -13,9 +13,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/CommandGraph.h>
 #include <vsg/app/RenderGraph.h>
 #include <vsg/app/View.h>
+#include <vsg/core/ScratchMemory.h>
 #include <vsg/io/DatabasePager.h>
 #include <vsg/state/ViewDependentState.h>
 #include <vsg/ui/ApplicationEvent.h>
+#include <vsg/utils/ChangeTracker.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/vk/State.h>
 
@@ -73,6 +75,100 @@ ref_ptr<RecordTraversal> CommandGraph::getOrCreateRecordTraversal()
     return recordTraversal;
 }
 
+void CommandGraph::releaseRecordedCommandBuffers()
+{
+    _recordedCommandBuffers.clear();
+    _recordedViews.clear();
+}
+
+ref_ptr<CommandBuffer> CommandGraph::_reuseCommandBuffer(const Object* target)
+{
+    if (!reuseCommandBuffers || ChangeTracker::hasChanged(this))
+    {
+        releaseRecordedCommandBuffers();
+        return {};
+    }
+
+    for (auto& recordedView : _recordedViews)
+    {
+        auto view = recordedView.view.ref_ptr();
+        if (!view || !view->camera) continue;
+
+        auto& camera = view->camera;
+        if ((camera->projectionMatrix && camera->projectionMatrix->transform() != recordedView.projectionMatrix) ||
+            (camera->viewMatrix && camera->viewMatrix->transform() != recordedView.viewMatrix))
+        {
+            releaseRecordedCommandBuffers();
+            return {};
+        }
+    }
+
+    for (auto& recorded : _recordedCommandBuffers)
+    {
+        if (recorded.target == target) return recorded.commandBuffer;
+    }
+    return {};
+}
+
+ref_ptr<CommandBuffer> CommandGraph::_availableCommandBuffer()
+{
+    if (!reuseCommandBuffers)
+    {
+        // the CommandGraph is only recorded by one thread at a time so its CommandPoolRing needs no locking
+        if (!_commandPoolRing) _commandPoolRing = CommandPoolRing::create(device, queueFamily, level());
+        _commandPoolRing->advance();
+        return _commandPoolRing->next();
+    }
+
+    for (auto& cb : _commandBuffers)
+    {
+        if (cb->numDependentSubmissions() == 0)
+        {
+            auto itr = std::find_if(_recordedCommandBuffers.begin(), _recordedCommandBuffers.end(), [&](const RecordedCommandBuffer& recorded) { return recorded.commandBuffer == cb; });
+            if (itr == _recordedCommandBuffers.end())
+            {
+                cb->reset();
+                return cb;
+            }
+        }
+    }
+
+    ref_ptr<CommandPool> cp = CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    auto commandBuffer = cp->allocate(level());
+    _commandBuffers.push_back(commandBuffer);
+    return commandBuffer;
+}
+
+void CommandGraph::_retainCommandBuffer(const Object* target, ref_ptr<CommandBuffer> commandBuffer)
+{
+    if (!reuseCommandBuffers) return;
+
+    // capture the camera matrices of the Views that the command buffers are recorded with
+    if (_recordedCommandBuffers.empty())
+    {
+        struct FindViews : public Visitor
+        {
+            std::vector<RecordedView>& recordedViews;
+            explicit FindViews(std::vector<RecordedView>& in_recordedViews) :
+                recordedViews(in_recordedViews) {}
+
+            void apply(Node& node) override { node.traverse(*this); }
+            void apply(View& view) override
+            {
+                RecordedView recordedView{observer_ptr<View>(&view), {}, {}};
+                if (view.camera && view.camera->projectionMatrix) recordedView.projectionMatrix = view.camera->projectionMatrix->transform();
+                if (view.camera && view.camera->viewMatrix) recordedView.viewMatrix = view.camera->viewMatrix->transform();
+                recordedViews.push_back(recordedView);
+            }
+        } findViews(_recordedViews);
+
+        _recordedViews.clear();
+        traverse(findViews);
+    }
+
+    _recordedCommandBuffers.push_back(RecordedCommandBuffer{target, commandBuffer});
+}
+
 void CommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedCommandBuffers, ref_ptr<FrameStamp> frameStamp, ref_ptr<DatabasePager> databasePager)
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "CommandGraph record", COLOR_RECORD_L1);
@@ -83,6 +179,21 @@ void CommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedCommandBuffers
         return;
     }
 
+    // the framebuffer or swapchain image that the command buffer is recorded for
+    const Object* target = this;
+    if (framebuffer)
+        target = framebuffer.get();
+    else if (window && window->imageIndex() < window->numFrames())
+        target = window->imageView(window->imageIndex()).get();
+
+    // resubmit the command buffer previously recorded for this target if nothing has changed
+    if (auto reusedCommandBuffer = _reuseCommandBuffer(target))
+    {
+        reusedCommandBuffer->numDependentSubmissions().fetch_add(1);
+        recordedCommandBuffers->add(submitOrder, reusedCommandBuffer);
+        return;
+    }
+
     // create the RecordTraversal if it isn't already created
     getOrCreateRecordTraversal();
 
@@ -91,26 +202,9 @@ void CommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedCommandBuffers
     recordTraversal->setDatabasePager(databasePager);
     recordTraversal->clearBins();
     recordTraversal->regionsOfInterest.clear();
+    recordTraversal->scratchMemory->release();
 
-    ref_ptr<CommandBuffer> commandBuffer;
-    for (auto& cb : _commandBuffers)
-    {
-        if (cb->numDependentSubmissions() == 0)
-        {
-            commandBuffer = cb;
-            break;
-        }
-    }
-    if (!commandBuffer)
-    {
-        ref_ptr<CommandPool> cp = CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
-        commandBuffer = cp->allocate(level());
-        _commandBuffers.push_back(commandBuffer);
-    }
-    else
-    {
-        commandBuffer->reset();
-    }
+    auto commandBuffer = _availableCommandBuffer();
 
     commandBuffer->numDependentSubmissions().fetch_add(1);
 
@@ -123,7 +217,8 @@ void CommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedCommandBuffers
     // if we are nested within a CommandBuffer already then use VkCommandBufferInheritanceInfo
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    // retained command buffers may be resubmitted while a previous submission is still pending
+    beginInfo.flags = reuseCommandBuffers ? VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT : VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
     beginInfo.pInheritanceInfo = nullptr;
 
     vkBeginCommandBuffer(vk_commandBuffer, &beginInfo);
@@ -131,10 +226,13 @@ void CommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedCommandBuffers
     {
         COMMAND_BUFFER_INSTRUMENTATION(instrumentation, *commandBuffer, "CommandGraph record", COLOR_RECORD)
         traverse(*recordTraversal);
+        recordTraversal->getState()->flushDraws();
     }
 
     vkEndCommandBuffer(vk_commandBuffer);
 
+    _retainCommandBuffer(target, commandBuffer);
+
     recordedCommandBuffers->add(submitOrder, commandBuffer);
 }
 
@@ -146,3 +244,53 @@ ref_ptr<CommandGraph> vsg::createCommandGraphForView(ref_ptr<Window> window, ref
 
     return commandGraph;
 }
+
+CommandGraphs vsg::createTiledCommandGraphs(ref_ptr<Window> window, ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, uint32_t columns, uint32_t rows, VkSubpassContents contents, bool assignHeadlight)
+{
+    if (columns == 0 || rows == 0) return {};
+
+    if (window->traits()->dynamicRendering)
+    {
+        throw Exception{"Error: vsg::createTiledCommandGraphs(..) doesn't support Windows using dynamicRendering."};
+    }
+
+    // the tiles after the first must preserve the swapchain image contents rendered by the previous tiles, making their writes available before the layout transition.
+    auto renderPass = window->getOrCreateRenderPass();
+    auto attachments = renderPass->attachments;
+    for (auto& attachment : attachments)
+    {
+        if (attachment.finalLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR) attachment.initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    }
+    auto dependencies = renderPass->dependencies;
+    for (auto& dependency : dependencies)
+    {
+        if (dependency.srcSubpass == VK_SUBPASS_EXTERNAL && (dependency.dstAccessMask & VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT)) dependency.srcAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    }
+    auto tileRenderPass = RenderPass::create(renderPass->device, attachments, renderPass->subpasses, dependencies, renderPass->correlatedViewMasks);
+
+    auto extent = window->extent2D();
+    auto edge = [](uint32_t size, uint32_t index, uint32_t count) { return static_cast<uint32_t>((static_cast<uint64_t>(size) * index) / count); };
+
+    CommandGraphs commandGraphs;
+    for (uint32_t r = 0; r < rows; ++r)
+    {
+        for (uint32_t c = 0; c < columns; ++c)
+        {
+            uint32_t x0 = edge(extent.width, c, columns), x1 = edge(extent.width, c + 1, columns);
+            uint32_t y0 = edge(extent.height, r, rows), y1 = edge(extent.height, r + 1, rows);
+
+            dvec4 tile(static_cast<double>(x0) / extent.width, static_cast<double>(y0) / extent.height, static_cast<double>(x1 - x0) / extent.width, static_cast<double>(y1 - y0) / extent.height);
+            auto projectionMatrix = TileProjection::create(camera->projectionMatrix, tile, commandGraphs.empty());
+            auto tileCamera = Camera::create(projectionMatrix, camera->viewMatrix, ViewportState::create(static_cast<int32_t>(x0), static_cast<int32_t>(y0), x1 - x0, y1 - y0));
+
+            auto renderGraph = createRenderGraphForView(window, tileCamera, scenegraph, contents, assignHeadlight);
+            if (!commandGraphs.empty()) renderGraph->renderPass = tileRenderPass;
+
+            auto commandGraph = CommandGraph::create(window);
+            commandGraph->addChild(renderGraph);
+            commandGraphs.push_back(commandGraph);
+        }
+    }
+
+    return commandGraphs;
+}
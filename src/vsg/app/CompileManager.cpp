@@ -50,7 +50,7 @@ void CompileResult::add(const CompileResult& cr)
         binDetails.bins.insert(src_binDetails.bins.begin(), src_binDetails.bins.end());
     }
 
-    dynamicData.add(dynamicData);
+    dynamicData.add(cr.dynamicData);
 }
 
 bool CompileResult::requiresViewerUpdate() const
@@ -159,6 +159,16 @@ void CompileManager::assignInstrumentation(ref_ptr<Instrumentation> in_instrumen
     }
 }
 
+void CompileManager::assignOperationThreads(ref_ptr<OperationThreads> in_operationThreads, bool in_asynchronousPipelines)
+{
+    auto cts = takeCompileTraversals(numCompileTraversals);
+    for (auto& ct : cts)
+    {
+        ct->assignOperationThreads(in_operationThreads, in_asynchronousPipelines);
+        compileTraversals->add(ct);
+    }
+}
+
 CompileResult CompileManager::compile(ref_ptr<Object> object, ContextSelectionFunction contextSelection)
 {
     CollectResourceRequirements collectRequirements;
@@ -196,6 +206,10 @@ CompileResult CompileManager::compile(ref_ptr<Object> object, ContextSelectionFu
                             {
                                 result.views[sm.view].add(requirements.viewDetailsStack.top());
                             }
+                            if (sm.staticView)
+                            {
+                                result.views[sm.staticView].add(requirements.viewDetailsStack.top());
+                            }
                         }
                     }
                 }
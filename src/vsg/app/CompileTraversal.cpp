@@ -13,6 +13,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/CompileTraversal.h>
 
 #include <vsg/app/CommandGraph.h>
+#include <vsg/app/PagedLODOcclusionQueries.h>
 #include <vsg/app/RenderGraph.h>
 #include <vsg/app/SecondaryCommandGraph.h>
 #include <vsg/app/View.h>
@@ -20,9 +21,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/commands/Command.h>
 #include <vsg/commands/Commands.h>
 #include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/LazyCompileGroup.h>
 #include <vsg/nodes/Group.h>
 #include <vsg/nodes/StateGroup.h>
 #include <vsg/state/MultisampleState.h>
+#include <vsg/state/RenderingState.h>
 #include <vsg/state/ViewDependentState.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/vk/RenderPass.h>
@@ -61,11 +64,35 @@ CompileTraversal::~CompileTraversal()
 {
 }
 
+// assign the RenderPass, or when the window uses dynamic rendering the RenderingState, that GraphicsPipeline compiled for the window require
+static void assignWindowRenderingSettings(Context& context, Window& window)
+{
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    if (window.traits()->dynamicRendering)
+    {
+        auto depthFormat = window.depthFormat();
+        auto stencilFormat = (computeAspectFlagsForFormat(depthFormat) & VK_IMAGE_ASPECT_STENCIL_BIT) ? depthFormat : VK_FORMAT_UNDEFINED;
+
+        context.renderPass = {};
+        context.overridePipelineStates.emplace_back(RenderingState::create(RenderingState::Formats{window.surfaceFormat().format}, depthFormat, stencilFormat));
+        samples = window.framebufferSamples();
+    }
+    else
+    {
+        context.renderPass = window.getOrCreateRenderPass();
+        samples = context.renderPass->maxSamples;
+    }
+
+    if (samples != VK_SAMPLE_COUNT_1_BIT) context.overridePipelineStates.emplace_back(MultisampleState::create(samples));
+}
+
 void CompileTraversal::add(ref_ptr<Device> device, ref_ptr<TransferTask> transferTask, const ResourceRequirements& resourceRequirements)
 {
     auto queueFamily = device->getPhysicalDevice()->getQueueFamily(queueFlags);
     auto context = Context::create(device, resourceRequirements);
     context->instrumentation = instrumentation;
+    context->operationThreads = operationThreads;
+    context->asynchronousPipelines = asynchronousPipelines;
     context->commandPool = CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
     context->graphicsQueue = device->getQueue(queueFamily, queueFamilyIndex);
     context->transferTask = transferTask;
@@ -80,11 +107,11 @@ void CompileTraversal::add(ref_ptr<Device> device, const ResourceRequirements& r
 void CompileTraversal::add(Window& window, ref_ptr<TransferTask> transferTask, ref_ptr<ViewportState> viewport, const ResourceRequirements& resourceRequirements)
 {
     auto device = window.getOrCreateDevice();
-    auto renderPass = window.getOrCreateRenderPass();
     auto queueFamily = device->getPhysicalDevice()->getQueueFamily(queueFlags);
     auto context = Context::create(device, resourceRequirements);
     context->instrumentation = instrumentation;
-    context->renderPass = renderPass;
+    context->operationThreads = operationThreads;
+    context->asynchronousPipelines = asynchronousPipelines;
     context->commandPool = CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
     context->graphicsQueue = device->getQueue(queueFamily, queueFamilyIndex);
     context->transferTask = transferTask;
@@ -94,7 +121,7 @@ void CompileTraversal::add(Window& window, ref_ptr<TransferTask> transferTask, r
     else
         context->defaultPipelineStates.emplace_back(vsg::ViewportState::create(window.extent2D()));
 
-    if (renderPass->maxSamples != VK_SAMPLE_COUNT_1_BIT) context->overridePipelineStates.emplace_back(MultisampleState::create(renderPass->maxSamples));
+    assignWindowRenderingSettings(*context, window);
 
     contexts.push_back(context);
 }
@@ -107,16 +134,16 @@ void CompileTraversal::add(Window& window, ref_ptr<ViewportState> viewport, cons
 void CompileTraversal::add(Window& window, ref_ptr<TransferTask> transferTask, ref_ptr<View> view, const ResourceRequirements& resourceRequirements)
 {
     auto device = window.getOrCreateDevice();
-    auto renderPass = window.getOrCreateRenderPass();
     auto queueFamily = device->getPhysicalDevice()->getQueueFamily(queueFlags);
     auto context = Context::create(device, resourceRequirements);
     context->instrumentation = instrumentation;
-    context->renderPass = renderPass;
+    context->operationThreads = operationThreads;
+    context->asynchronousPipelines = asynchronousPipelines;
     context->commandPool = vsg::CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
     context->graphicsQueue = device->getQueue(queueFamily, queueFamilyIndex);
     context->transferTask = transferTask;
 
-    if (renderPass->maxSamples != VK_SAMPLE_COUNT_1_BIT) context->overridePipelineStates.emplace_back(vsg::MultisampleState::create(renderPass->maxSamples));
+    assignWindowRenderingSettings(*context, window);
 
     context->overridePipelineStates.insert(context->overridePipelineStates.end(), view->overridePipelineStates.begin(), view->overridePipelineStates.end());
 
@@ -145,6 +172,8 @@ void CompileTraversal::add(Framebuffer& framebuffer, ref_ptr<TransferTask> trans
     auto context = Context::create(device, resourceRequirements);
     auto queueFamily = device->getPhysicalDevice()->getQueueFamily(VK_QUEUE_GRAPHICS_BIT);
     context->instrumentation = instrumentation;
+    context->operationThreads = operationThreads;
+    context->asynchronousPipelines = asynchronousPipelines;
     context->commandPool = vsg::CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
     context->graphicsQueue = device->getQueue(queueFamily, queueFamilyIndex);
     context->transferTask = transferTask;
@@ -246,6 +275,9 @@ void CompileTraversal::addViewDependentState(ViewDependentState& viewDependentSt
         auto context = Context::create(device, resourceRequirements);
         auto queueFamily = device->getPhysicalDevice()->getQueueFamily(VK_QUEUE_GRAPHICS_BIT);
         context->instrumentation = instrumentation;
+        context->operationThreads = operationThreads;
+        context->asynchronousPipelines = asynchronousPipelines;
+    context->asynchronousPipelines = asynchronousPipelines;
         context->commandPool = vsg::CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
         context->graphicsQueue = device->getQueue(queueFamily, queueFamilyIndex);
         context->transferTask = transferTask;
@@ -279,6 +311,18 @@ void CompileTraversal::assignInstrumentation(ref_ptr<Instrumentation> in_instrum
     }
 }
 
+void CompileTraversal::assignOperationThreads(ref_ptr<OperationThreads> in_operationThreads, bool in_asynchronousPipelines)
+{
+    operationThreads = in_operationThreads;
+    asynchronousPipelines = in_asynchronousPipelines;
+    for (const auto& context : contexts)
+    {
+        context->operationThreads = operationThreads;
+        context->asynchronousPipelines = asynchronousPipelines;
+    context->asynchronousPipelines = asynchronousPipelines;
+    }
+}
+
 void CompileTraversal::apply(Object& object)
 {
     CPU_INSTRUMENTATION_L2_NC(instrumentation, "CompileTraversal Object", COLOR_COMPILE);
@@ -319,6 +363,12 @@ void CompileTraversal::apply(Geometry& geometry)
     geometry.traverse(*this);
 }
 
+void CompileTraversal::apply(LazyCompileGroup& lcg)
+{
+    // children of LazyCompileGroup assigned a LazyCompiler are compiled when they first become visible
+    if (lcg.compiled()) lcg.traverse(*this);
+}
+
 void CompileTraversal::apply(CommandGraph& commandGraph)
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "CompileTraversal CommandGraph", COLOR_COMPILE);
@@ -393,6 +443,11 @@ void CompileTraversal::apply(RenderGraph& renderGraph)
         {
             mergeGraphicsPipelineStates(context->mask, context->overridePipelineStates, MultisampleState::create(context->renderPass->maxSamples));
         }
+        else if (renderGraph.dynamicRendering)
+        {
+            mergeGraphicsPipelineStates(context->mask, context->overridePipelineStates, MultisampleState::create(renderGraph.getSamples()));
+            mergeGraphicsPipelineStates(context->mask, context->overridePipelineStates, renderGraph.createRenderingState());
+        }
 
         renderGraph.traverse(*this);
 
@@ -434,6 +489,11 @@ void CompileTraversal::apply(View& view)
         mergeGraphicsPipelineStates(context->mask, context->defaultPipelineStates, view.camera->viewportState);
         mergeGraphicsPipelineStates(context->mask, context->overridePipelineStates, view.overridePipelineStates);
 
+        if (view.pagedLODOcclusionQueries)
+        {
+            view.pagedLODOcclusionQueries->compile(*context);
+        }
+
         view.traverse(*this);
 
         // restore previous states
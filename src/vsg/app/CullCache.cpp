@@ -0,0 +1,107 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/CullCache.h>
+
+using namespace vsg;
+
+CullCache::CullCache()
+{
+}
+
+CullCache::~CullCache()
+{
+}
+
+void CullCache::dirty()
+{
+    _dirty = true;
+}
+
+void CullCache::begin(const dmat4& projection, const dmat4& view, double LODScale)
+{
+    _mutex.lock();
+
+    _reusing = !_dirty.exchange(false) && _valid && projection == _projection && view == _view && LODScale == _LODScale;
+    if (!_reusing)
+    {
+        _projection = projection;
+        _view = view;
+        _LODScale = LODScale;
+        _entries.clear();
+        _matrices.clear();
+    }
+
+    _position = 0;
+    _matrixPosition = 0;
+    numResultsReused = 0;
+    numResultsComputed = 0;
+}
+
+void CullCache::end()
+{
+    _discardRemaining();
+
+    _valid = true;
+    _mutex.unlock();
+}
+
+void CullCache::_discardRemaining()
+{
+    _entries.resize(_position);
+    _matrices.resize(_matrixPosition);
+    _reusing = false;
+}
+
+bool CullCache::lookup(const Node* node, int32_t& value)
+{
+    if (_reusing)
+    {
+        if (_position < _entries.size() && _entries[_position].node == node)
+        {
+            value = _entries[_position++].value;
+            ++numResultsReused;
+            return true;
+        }
+
+        _discardRemaining();
+    }
+    return false;
+}
+
+void CullCache::store(const Node* node, int32_t value)
+{
+    _entries.push_back(Entry{node, value});
+    ++_position;
+    ++numResultsComputed;
+}
+
+void CullCache::validate(const Node* node, const dmat4& matrix)
+{
+    if (_reusing)
+    {
+        if (_position < _entries.size() && _entries[_position].node == node && _matrixPosition < _matrices.size() && _matrices[_matrixPosition] == matrix)
+        {
+            ++_position;
+            ++_matrixPosition;
+            return;
+        }
+
+        _discardRemaining();
+    }
+
+    _entries.push_back(Entry{node, static_cast<int32_t>(_matrices.size())});
+    _matrices.push_back(matrix);
+    ++_position;
+    ++_matrixPosition;
+}
@@ -0,0 +1,305 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/DynamicResolution.h>
+#include <vsg/app/View.h>
+#include <vsg/commands/BlitImage.h>
+#include <vsg/commands/PipelineBarrier.h>
+#include <vsg/io/Logger.h>
+#include <vsg/lighting/Light.h>
+#include <vsg/vk/RenderPass.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vsg;
+
+namespace
+{
+    /// blit the rendered region of the DynamicResolution's color attachment to the whole of the Window's current swapchain image
+    class UpscaleToWindow : public Inherit<Command, UpscaleToWindow>
+    {
+    public:
+        explicit UpscaleToWindow(DynamicResolution* in_dynamicResolution) :
+            dynamicResolution(in_dynamicResolution) {}
+
+        ref_ptr<DynamicResolution> dynamicResolution;
+
+        void record(CommandBuffer& commandBuffer) const override
+        {
+            auto& window = dynamicResolution->window;
+            auto& colorImage = dynamicResolution->colorImage;
+
+            // do nothing if the imageIndex() is invalid.
+            size_t imageIndex = window->imageIndex();
+            if (imageIndex >= window->numFrames() || !colorImage) return;
+
+            auto swapchainImage = window->imageView(imageIndex)->image;
+
+            // the swapchain image is available by the COLOR_ATTACHMENT_OUTPUT stage the imageAvailableSemaphore waits on, and the color attachment has been left in TRANSFER_SRC_OPTIMAL by the render pass
+            auto swapchainToTransferDst = ImageMemoryBarrier::create(
+                0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+                swapchainImage,
+                VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+            auto colorToTransferSrc = ImageMemoryBarrier::create(
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+                colorImage,
+                VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+            PipelineBarrier::create(
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0,
+                swapchainToTransferDst,
+                colorToTransferSrc)
+                ->record(commandBuffer);
+
+            auto srcExtent = dynamicResolution->scaledExtent();
+            srcExtent.width = std::min(srcExtent.width, colorImage->extent.width);
+            srcExtent.height = std::min(srcExtent.height, colorImage->extent.height);
+            auto dstExtent = window->extent2D();
+
+            VkImageBlit region{};
+            region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            region.srcOffsets[0] = {0, 0, 0};
+            region.srcOffsets[1] = {static_cast<int32_t>(srcExtent.width), static_cast<int32_t>(srcExtent.height), 1};
+            region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+            region.dstOffsets[0] = {0, 0, 0};
+            region.dstOffsets[1] = {static_cast<int32_t>(dstExtent.width), static_cast<int32_t>(dstExtent.height), 1};
+
+            auto blitImage = BlitImage::create();
+            blitImage->srcImage = colorImage;
+            blitImage->srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            blitImage->dstImage = swapchainImage;
+            blitImage->dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            blitImage->regions.emplace_back(region);
+            blitImage->filter = (srcExtent.width == dstExtent.width && srcExtent.height == dstExtent.height) ? VK_FILTER_NEAREST : VK_FILTER_LINEAR;
+            blitImage->record(commandBuffer);
+
+            auto swapchainToPresent = ImageMemoryBarrier::create(
+                VK_ACCESS_TRANSFER_WRITE_BIT, 0,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED,
+                swapchainImage,
+                VkImageSubresourceRange{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+
+            PipelineBarrier::create(
+                VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0,
+                swapchainToPresent)
+                ->record(commandBuffer);
+        }
+    };
+} // namespace
+
+DynamicResolution::DynamicResolution(ref_ptr<Window> in_window) :
+    window(in_window)
+{
+    if (!window) throw Exception{"Error: vsg::DynamicResolution::DynamicResolution(..) requires a valid Window."};
+
+    if ((window->traits()->swapchainPreferences.imageUsage & VK_IMAGE_USAGE_TRANSFER_DST_BIT) == 0)
+    {
+        warn("vsg::DynamicResolution::DynamicResolution(..) Window swapchain not created with VK_IMAGE_USAGE_TRANSFER_DST_BIT, blit to the swapchain image will not be valid.");
+    }
+
+    colorFormat = window->surfaceFormat().format;
+
+    _initRenderPass();
+    _initFramebuffer(window->extent2D());
+}
+
+DynamicResolution::~DynamicResolution()
+{
+}
+
+void DynamicResolution::_initRenderPass()
+{
+    auto device = window->getOrCreateDevice();
+    auto depthFormat = window->depthFormat();
+
+    // set up a render pass matching vsg::createRenderPass(..) but leaving the color attachment ready for the blit to the swapchain image rather than presenting
+    auto colorAttachment = defaultColorAttachment(colorFormat);
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    auto depthAttachment = defaultDepthAttachment(depthFormat);
+
+    AttachmentReference colorAttachmentRef = {};
+    colorAttachmentRef.attachment = 0;
+    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    AttachmentReference depthAttachmentRef = {};
+    depthAttachmentRef.attachment = 1;
+    depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    SubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachments.emplace_back(colorAttachmentRef);
+    subpass.depthStencilAttachments.emplace_back(depthAttachmentRef);
+
+    // the previous frame's blit and depth writes must complete before the next frame renders to the attachments
+    SubpassDependency colorDependency = {};
+    colorDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    colorDependency.dstSubpass = 0;
+    colorDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    colorDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    colorDependency.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    colorDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    colorDependency.dependencyFlags = 0;
+
+    SubpassDependency depthDependency = {};
+    depthDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    depthDependency.dstSubpass = 0;
+    depthDependency.srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    depthDependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    depthDependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthDependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthDependency.dependencyFlags = 0;
+
+    renderPass = RenderPass::create(device, RenderPass::Attachments{colorAttachment, depthAttachment}, RenderPass::Subpasses{subpass}, RenderPass::Dependencies{colorDependency, depthDependency});
+}
+
+void DynamicResolution::_initFramebuffer(const VkExtent2D& extent)
+{
+    auto device = window->getOrCreateDevice();
+    auto depthFormat = window->depthFormat();
+
+    // the attachments are allocated at the full Window size so that changing scale only changes the region rendered to
+    colorImage = Image::create();
+    colorImage->imageType = VK_IMAGE_TYPE_2D;
+    colorImage->format = colorFormat;
+    colorImage->extent = VkExtent3D{extent.width, extent.height, 1};
+    colorImage->mipLevels = 1;
+    colorImage->arrayLayers = 1;
+    colorImage->samples = VK_SAMPLE_COUNT_1_BIT;
+    colorImage->tiling = VK_IMAGE_TILING_OPTIMAL;
+    colorImage->usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    colorImage->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorImage->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    colorImage->compile(device);
+    colorImage->allocateAndBindMemory(device);
+
+    colorImageView = ImageView::create(colorImage, VK_IMAGE_ASPECT_COLOR_BIT);
+    colorImageView->compile(device);
+
+    depthImage = Image::create();
+    depthImage->imageType = VK_IMAGE_TYPE_2D;
+    depthImage->format = depthFormat;
+    depthImage->extent = VkExtent3D{extent.width, extent.height, 1};
+    depthImage->mipLevels = 1;
+    depthImage->arrayLayers = 1;
+    depthImage->samples = VK_SAMPLE_COUNT_1_BIT;
+    depthImage->tiling = VK_IMAGE_TILING_OPTIMAL;
+    depthImage->usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    depthImage->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    depthImage->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    depthImage->compile(device);
+    depthImage->allocateAndBindMemory(device);
+
+    depthImageView = ImageView::create(depthImage, computeAspectFlagsForFormat(depthFormat));
+    depthImageView->compile(device);
+
+    framebuffer = Framebuffer::create(renderPass, ImageViews{colorImageView, depthImageView}, extent.width, extent.height, 1);
+
+    if (renderGraph) renderGraph->framebuffer = framebuffer;
+}
+
+VkExtent2D DynamicResolution::scaledExtent() const
+{
+    auto extent = framebuffer ? framebuffer->extent2D() : window->extent2D();
+    double s = std::clamp(scale, minScale, maxScale);
+    return VkExtent2D{std::max(1u, static_cast<uint32_t>(std::round(static_cast<double>(extent.width) * s))),
+                      std::max(1u, static_cast<uint32_t>(std::round(static_cast<double>(extent.height) * s)))};
+}
+
+ref_ptr<RenderGraph> DynamicResolution::createRenderGraphForView(ref_ptr<Camera> in_camera, ref_ptr<Node> scenegraph, VkSubpassContents contents, bool assignHeadlight)
+{
+    camera = in_camera;
+    if (!camera->viewportState) camera->viewportState = ViewportState::create(framebuffer->extent2D());
+
+    // set up the view
+    auto view = View::create(camera);
+    if (assignHeadlight) view->addChild(createHeadlight());
+    if (scenegraph) view->addChild(scenegraph);
+
+    // set up the render graph, the viewport and renderArea are managed by apply() rather than by a WindowResizeHandler
+    renderGraph = RenderGraph::create();
+    renderGraph->framebuffer = framebuffer;
+    renderGraph->contents = contents;
+    renderGraph->windowResizeHandler = {};
+    renderGraph->setClearValues();
+    renderGraph->addChild(view);
+
+    apply();
+
+    return renderGraph;
+}
+
+ref_ptr<CommandGraph> DynamicResolution::createCommandGraphForView(ref_ptr<Camera> in_camera, ref_ptr<Node> scenegraph, VkSubpassContents contents, bool assignHeadlight)
+{
+    auto commandGraph = CommandGraph::create(window);
+    commandGraph->addChild(createRenderGraphForView(in_camera, scenegraph, contents, assignHeadlight));
+    commandGraph->addChild(UpscaleToWindow::create(this));
+
+    return commandGraph;
+}
+
+void DynamicResolution::update(double gpuTime)
+{
+    if (targetGPUTime > 0.0 && gpuTime > 0.0 && std::abs(gpuTime - targetGPUTime) > targetGPUTime * tolerance)
+    {
+        // fragment cost scales with the number of pixels, so scale each dimension by the square root of the time ratio
+        double idealScale = scale * std::sqrt(targetGPUTime / gpuTime);
+        scale = std::clamp(scale + (idealScale - scale) * damping, minScale, maxScale);
+    }
+
+    apply();
+}
+
+void DynamicResolution::update(const FrameStatistics& statistics)
+{
+    FrameStatistics::Summary summary;
+    if (statistics.summary(statisticName, summary) && summary.count > 0)
+        update(summary.total);
+    else
+        apply();
+}
+
+void DynamicResolution::apply()
+{
+    auto extent = window->extent2D();
+    if (framebuffer && extent.width > 0 && extent.height > 0 && (framebuffer->width() != extent.width || framebuffer->height() != extent.height))
+    {
+        // the attachments may still be in use by frames in flight
+        auto device = window->getOrCreateDevice();
+        vkDeviceWaitIdle(*device);
+
+        if (camera && camera->projectionMatrix) camera->projectionMatrix->changeExtent(framebuffer->extent2D(), extent);
+
+        _initFramebuffer(extent);
+    }
+
+    auto scaled = scaledExtent();
+
+    if (camera && camera->viewportState) camera->viewportState->set(0, 0, scaled.width, scaled.height);
+
+    if (renderGraph)
+    {
+        renderGraph->renderArea.offset = {0, 0};
+        renderGraph->renderArea.extent = scaled;
+    }
+}
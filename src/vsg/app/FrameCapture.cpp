@@ -0,0 +1,71 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/FrameCapture.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/write.h>
+
+using namespace vsg;
+
+FrameCapture::FrameCapture() :
+    _captured(Objects::create())
+{
+}
+
+void FrameCapture::request()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _requested = true;
+}
+
+bool FrameCapture::capturing(uint64_t in_frameCount)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    if (_requested)
+    {
+        _requested = false;
+        _active = true;
+        _frameCount = in_frameCount;
+        _captured = Objects::create();
+    }
+    return _active && in_frameCount == _frameCount;
+}
+
+void FrameCapture::add(ref_ptr<Commands> commands)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _captured->children.push_back(commands);
+}
+
+uint64_t FrameCapture::frameCount() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _frameCount;
+}
+
+ref_ptr<Objects> FrameCapture::captured() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _captured;
+}
+
+bool FrameCapture::write(const Path& filename, ref_ptr<const Options> options) const
+{
+    auto objects = captured();
+    if (objects->children.empty())
+    {
+        warn("FrameCapture::write(", filename, ") no frame captured.");
+        return false;
+    }
+
+    return vsg::write(objects, filename, options);
+}
@@ -0,0 +1,434 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/FrameGraph.h>
+#include <vsg/core/Exception.h>
+#include <vsg/io/Logger.h>
+#include <vsg/state/ImageView.h>
+
+#include <algorithm>
+#include <map>
+
+using namespace vsg;
+
+namespace
+{
+    constexpr VkAccessFlags s_writeAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                                VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+    /// synchronization state of a resource while stepping through the passes
+    struct ResourceState
+    {
+        VkPipelineStageFlags writeStages = 0;
+        VkAccessFlags writeAccess = 0;
+        int32_t writePass = -1;
+
+        VkPipelineStageFlags readStages = 0;
+        int32_t readPass = -1;
+
+        // stages and accesses that the last write has been made visible to
+        VkPipelineStageFlags visibleStages = 0;
+        VkAccessFlags visibleAccess = 0;
+
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        void apply(const FrameGraph::Access& access, int32_t pass, bool barrier)
+        {
+            if ((access.accessMask & s_writeAccessMask) != 0)
+            {
+                writeStages = access.stageMask;
+                writeAccess = access.accessMask & s_writeAccessMask;
+                writePass = pass;
+                readStages = 0;
+                readPass = -1;
+                visibleStages = 0;
+                visibleAccess = 0;
+            }
+            else
+            {
+                readStages |= access.stageMask;
+                readPass = pass;
+                if (barrier)
+                {
+                    visibleStages |= access.stageMask;
+                    visibleAccess |= access.accessMask;
+                }
+            }
+
+            if (access.layout != VK_IMAGE_LAYOUT_UNDEFINED) layout = access.layout;
+        }
+    };
+
+    struct TransientAllocation
+    {
+        int32_t memory = -1;
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+
+        bool overlaps(const TransientAllocation& rhs) const
+        {
+            return memory >= 0 && memory == rhs.memory && offset < (rhs.offset + rhs.size) && rhs.offset < (offset + size);
+        }
+    };
+
+    /// combine the accesses a pass makes to the same resource as barriers can't be placed within a pass
+    std::vector<FrameGraph::Access> mergeAccesses(const std::vector<FrameGraph::Access>& accesses)
+    {
+        std::vector<FrameGraph::Access> merged;
+        for (auto& access : accesses)
+        {
+            auto itr = std::find_if(merged.begin(), merged.end(), [&](const FrameGraph::Access& existing) { return existing.resource == access.resource; });
+            if (itr == merged.end())
+            {
+                merged.push_back(access);
+            }
+            else
+            {
+                itr->stageMask |= access.stageMask;
+                itr->accessMask |= access.accessMask;
+                if (itr->layout == VK_IMAGE_LAYOUT_UNDEFINED) itr->layout = access.layout;
+            }
+        }
+        return merged;
+    }
+
+    VkImageSubresourceRange wholeImage(const Image& image)
+    {
+        return VkImageSubresourceRange{computeAspectFlagsForFormat(image.format), 0, image.mipLevels, 0, image.arrayLayers};
+    }
+
+    /// assign each transient resource an offset in a shared DeviceMemory, resources whose lifetimes don't overlap may share the same memory.
+    std::vector<TransientAllocation> allocateTransientResources(FrameGraph& frameGraph, Device* device, const std::vector<int32_t>& firstUse, const std::vector<int32_t>& lastUse)
+    {
+        auto& resources = frameGraph.resources;
+        std::vector<TransientAllocation> allocations(resources.size());
+
+        frameGraph.transientMemory.clear();
+        frameGraph.unaliasedTransientSize = 0;
+
+        // images and buffers sharing memory must be placed on separate pages
+        VkDeviceSize granularity = device->getPhysicalDevice()->getProperties().limits.bufferImageGranularity;
+
+        // group the resources by compatible memory types
+        std::map<uint32_t, std::vector<std::pair<uint32_t, VkMemoryRequirements>>> memoryTypeGroups;
+        for (uint32_t r = 0; r < static_cast<uint32_t>(resources.size()); ++r)
+        {
+            auto& resource = resources[r];
+            if (!resource.transient) continue;
+            if (firstUse[r] < 0)
+            {
+                warn("FrameGraph::build(..) transient resource ", r, " not used by any pass.");
+                continue;
+            }
+
+            VkMemoryRequirements requirements;
+            if (resource.image)
+            {
+                resource.image->compile(device);
+                requirements = resource.image->getMemoryRequirements(device->deviceID);
+            }
+            else
+            {
+                resource.buffer->compile(device);
+                requirements = resource.buffer->getMemoryRequirements(device->deviceID);
+            }
+
+            requirements.alignment = std::max(requirements.alignment, granularity);
+            memoryTypeGroups[requirements.memoryTypeBits].emplace_back(r, requirements);
+            frameGraph.unaliasedTransientSize += requirements.size;
+        }
+
+        for (auto& [memoryTypeBits, group] : memoryTypeGroups)
+        {
+            // place the largest resources first, each at the lowest offset that doesn't overlap a resource used at the same time
+            std::sort(group.begin(), group.end(), [](const auto& lhs, const auto& rhs) { return lhs.second.size > rhs.second.size; });
+
+            int32_t memoryIndex = static_cast<int32_t>(frameGraph.transientMemory.size());
+            VkDeviceSize totalSize = 0;
+            VkDeviceSize maxAlignment = 1;
+            std::vector<uint32_t> placed;
+            for (auto& [r, requirements] : group)
+            {
+                auto alignUp = [&](VkDeviceSize offset) { return ((offset + requirements.alignment - 1) / requirements.alignment) * requirements.alignment; };
+
+                std::vector<VkDeviceSize> candidates{0};
+                for (auto p : placed)
+                {
+                    if (firstUse[p] <= lastUse[r] && firstUse[r] <= lastUse[p]) candidates.push_back(alignUp(allocations[p].offset + allocations[p].size));
+                }
+                std::sort(candidates.begin(), candidates.end());
+
+                TransientAllocation allocation{memoryIndex, 0, requirements.size};
+                for (auto offset : candidates)
+                {
+                    allocation.offset = offset;
+                    bool fits = std::none_of(placed.begin(), placed.end(), [&](uint32_t p) {
+                        return firstUse[p] <= lastUse[r] && firstUse[r] <= lastUse[p] && allocation.overlaps(allocations[p]);
+                    });
+                    if (fits) break;
+                }
+
+                allocations[r] = allocation;
+                placed.push_back(r);
+                totalSize = std::max(totalSize, allocation.offset + allocation.size);
+                maxAlignment = std::max(maxAlignment, requirements.alignment);
+            }
+
+            VkMemoryRequirements memoryRequirements{totalSize, maxAlignment, memoryTypeBits};
+            auto deviceMemory = DeviceMemory::create(device, memoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            deviceMemory->reserve(totalSize);
+            frameGraph.transientMemory.push_back(deviceMemory);
+
+            for (auto r : placed)
+            {
+                auto& resource = resources[r];
+                VkResult result = resource.image ? resource.image->bind(deviceMemory, allocations[r].offset) : resource.buffer->bind(deviceMemory, allocations[r].offset);
+                if (result != VK_SUCCESS)
+                {
+                    throw Exception{"Error: vsg::FrameGraph::build(..) failed to bind transient resource memory.", result};
+                }
+            }
+        }
+
+        return allocations;
+    }
+
+    /// barriers between a pair of non adjacent passes, recorded as a SetEvent after the source pass and a WaitEvents before the destination pass
+    struct SplitBarrier
+    {
+        ref_ptr<Event> event;
+        ref_ptr<SetEvent> setEvent;
+        ref_ptr<WaitEvents> waitEvents;
+    };
+} // namespace
+
+FrameGraph::FrameGraph()
+{
+}
+
+FrameGraph::~FrameGraph()
+{
+}
+
+uint32_t FrameGraph::addImage(ref_ptr<Image> image, bool transient, VkImageLayout initialLayout, VkImageLayout finalLayout)
+{
+    Resource resource;
+    resource.image = image;
+    resource.transient = transient;
+    resource.initialLayout = initialLayout;
+    resource.finalLayout = finalLayout;
+    resources.push_back(resource);
+    return static_cast<uint32_t>(resources.size() - 1);
+}
+
+uint32_t FrameGraph::addBuffer(ref_ptr<Buffer> buffer, bool transient)
+{
+    Resource resource;
+    resource.buffer = buffer;
+    resource.transient = transient;
+    resources.push_back(resource);
+    return static_cast<uint32_t>(resources.size() - 1);
+}
+
+uint32_t FrameGraph::addPass(ref_ptr<Node> node, const std::vector<Access>& accesses)
+{
+    passes.push_back(Pass{node, accesses});
+    return static_cast<uint32_t>(passes.size() - 1);
+}
+
+void FrameGraph::build(Device* device)
+{
+    uint32_t numResources = static_cast<uint32_t>(resources.size());
+    int32_t numPasses = static_cast<int32_t>(passes.size());
+
+    for (auto& resource : resources)
+    {
+        if (!resource.image && !resource.buffer) throw Exception{"Error: vsg::FrameGraph::build(..) resource has no image or buffer assigned."};
+    }
+
+    std::vector<std::vector<Access>> passAccesses;
+    for (auto& pass : passes)
+    {
+        passAccesses.push_back(mergeAccesses(pass.accesses));
+        for (auto& access : passAccesses.back())
+        {
+            if (access.resource >= numResources) throw Exception{"Error: vsg::FrameGraph::build(..) access resource index out of range."};
+        }
+    }
+
+    // lifetimes and end of frame state of each resource, the start of the next frame has to synchronize with the end of the previous one
+    std::vector<int32_t> firstUse(numResources, -1);
+    std::vector<int32_t> lastUse(numResources, -1);
+    std::vector<ResourceState> finalStates(numResources);
+    for (int32_t p = 0; p < numPasses; ++p)
+    {
+        for (auto& access : passAccesses[p])
+        {
+            if (firstUse[access.resource] < 0) firstUse[access.resource] = p;
+            lastUse[access.resource] = p;
+            finalStates[access.resource].apply(access, p, false);
+        }
+    }
+
+    auto allocations = allocateTransientResources(*this, device, firstUse, lastUse);
+
+    std::vector<ResourceState> states(numResources);
+    for (uint32_t r = 0; r < numResources; ++r)
+    {
+        auto& state = states[r];
+        if (resources[r].transient && allocations[r].memory >= 0)
+        {
+            // wait on the resources that previously used the same memory within this frame, or if none, those that used it at the end of the previous frame
+            std::vector<uint32_t> predecessors;
+            for (uint32_t q = 0; q < numResources; ++q)
+            {
+                if (q != r && allocations[q].overlaps(allocations[r]) && lastUse[q] < firstUse[r]) predecessors.push_back(q);
+            }
+            bool previousFrame = predecessors.empty();
+            if (previousFrame)
+            {
+                for (uint32_t q = 0; q < numResources; ++q)
+                {
+                    if (q == r || allocations[q].overlaps(allocations[r])) predecessors.push_back(q);
+                }
+            }
+
+            for (auto q : predecessors)
+            {
+                auto& finalState = finalStates[q];
+                state.writeStages |= finalState.writeStages;
+                state.writeAccess |= finalState.writeAccess;
+                state.readStages |= finalState.readStages;
+                if (!previousFrame) state.writePass = std::max(state.writePass, std::max(finalState.writePass, finalState.readPass));
+            }
+            state.readPass = -1;
+            state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        }
+        else
+        {
+            state = finalStates[r];
+            state.writePass = -1;
+            state.readPass = -1;
+            state.layout = resources[r].initialLayout;
+        }
+        state.visibleStages = 0;
+        state.visibleAccess = 0;
+    }
+
+    std::vector<std::vector<ref_ptr<Command>>> before(numPasses);
+    std::vector<std::vector<ref_ptr<Command>>> after(numPasses);
+
+    for (int32_t p = 0; p < numPasses; ++p)
+    {
+        ref_ptr<PipelineBarrier> pipelineBarrier;
+        std::map<int32_t, SplitBarrier> splitBarriers;
+
+        for (auto& access : passAccesses[p])
+        {
+            auto& resource = resources[access.resource];
+            auto& state = states[access.resource];
+
+            bool isWrite = (access.accessMask & s_writeAccessMask) != 0;
+            bool layoutTransition = resource.image && access.layout != VK_IMAGE_LAYOUT_UNDEFINED && access.layout != state.layout;
+            bool visible = (access.stageMask & ~state.visibleStages) == 0 && (access.accessMask & ~state.visibleAccess) == 0;
+
+            VkPipelineStageFlags srcStageMask = 0;
+            VkAccessFlags srcAccessMask = 0;
+            int32_t srcPass = -1;
+            if (state.writeStages != 0 && (isWrite || !visible))
+            {
+                srcStageMask |= state.writeStages;
+                srcAccessMask |= state.writeAccess;
+                srcPass = state.writePass;
+            }
+            if (isWrite && state.readStages != 0)
+            {
+                srcStageMask |= state.readStages;
+                srcPass = std::max(srcPass, state.readPass);
+            }
+
+            if (srcStageMask == 0 && !layoutTransition)
+            {
+                state.apply(access, p, false);
+                continue;
+            }
+            if (srcStageMask == 0) srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+            VkImageLayout newLayout = (access.layout != VK_IMAGE_LAYOUT_UNDEFINED) ? access.layout : state.layout;
+
+            auto addBarrier = [&](auto& command) {
+                if (resource.image && newLayout != VK_IMAGE_LAYOUT_UNDEFINED)
+                    command.add(ImageMemoryBarrier::create(srcAccessMask, access.accessMask, state.layout, newLayout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, resource.image, wholeImage(*resource.image)));
+                else if (resource.buffer)
+                    command.add(BufferMemoryBarrier::create(srcAccessMask, access.accessMask, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, resource.buffer, 0, VK_WHOLE_SIZE));
+                else
+                    command.add(MemoryBarrier::create(srcAccessMask, access.accessMask));
+                command.srcStageMask |= srcStageMask;
+                command.dstStageMask |= access.stageMask;
+            };
+
+            if (splitBarriers && srcPass >= 0 && srcPass < p - 1)
+            {
+                auto& splitBarrier = splitBarriers[srcPass];
+                if (!splitBarrier.event)
+                {
+                    splitBarrier.event = Event::create(device);
+                    splitBarrier.setEvent = SetEvent::create(splitBarrier.event, 0);
+                    splitBarrier.waitEvents = WaitEvents::create(0, 0, splitBarrier.event);
+                }
+                addBarrier(*splitBarrier.waitEvents);
+                splitBarrier.setEvent->stageMask = splitBarrier.waitEvents->srcStageMask;
+            }
+            else
+            {
+                if (!pipelineBarrier) pipelineBarrier = PipelineBarrier::create(0, 0, 0);
+                addBarrier(*pipelineBarrier);
+            }
+
+            state.apply(access, p, true);
+        }
+
+        for (auto& [srcPass, splitBarrier] : splitBarriers)
+        {
+            after[srcPass].push_back(splitBarrier.setEvent);
+            before[p].push_back(splitBarrier.waitEvents);
+
+            // the event is reset once waited on so that it can be set again next frame
+            before[p].push_back(ResetEvent::create(splitBarrier.event, splitBarrier.waitEvents->dstStageMask));
+        }
+        if (pipelineBarrier) before[p].push_back(pipelineBarrier);
+    }
+
+    // transition persistent images to the layout they are used in after the frame
+    ref_ptr<PipelineBarrier> finalBarrier;
+    for (uint32_t r = 0; r < numResources; ++r)
+    {
+        auto& resource = resources[r];
+        auto& state = states[r];
+        if (resource.transient || !resource.image || resource.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || resource.finalLayout == state.layout) continue;
+
+        if (!finalBarrier) finalBarrier = PipelineBarrier::create(0, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0);
+        finalBarrier->add(ImageMemoryBarrier::create(state.writeAccess, 0, state.layout, resource.finalLayout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, resource.image, wholeImage(*resource.image)));
+        VkPipelineStageFlags stages = state.writeStages | state.readStages;
+        finalBarrier->srcStageMask |= (stages != 0) ? stages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    }
+
+    children.clear();
+    for (int32_t p = 0; p < numPasses; ++p)
+    {
+        for (auto& command : before[p]) addChild(command);
+        if (passes[p].node) addChild(passes[p].node);
+        for (auto& command : after[p]) addChild(command);
+    }
+    if (finalBarrier) addChild(finalBarrier);
+}
@@ -0,0 +1,122 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/FramePacing.h>
+#include <vsg/io/Logger.h>
+
+#include <thread>
+
+using namespace vsg;
+
+FramePacing::FramePacing()
+{
+}
+
+FramePacing::~FramePacing()
+{
+}
+
+void FramePacing::reset()
+{
+    _presentedFrames.clear();
+    _displayed = false;
+}
+
+void FramePacing::waitForFrameStart(const std::vector<ref_ptr<Presentation>>& /*presentations*/, const Instrumentation* instrumentation)
+{
+    CPU_INSTRUMENTATION_L1_NC(instrumentation, "FramePacing waitForFrameStart", COLOR_VIEWER);
+
+    using seconds = std::chrono::duration<double, std::chrono::seconds::period>;
+
+    // wait for the oldest frames to be displayed
+    while (_presentedFrames.size() > maxFramesInFlight)
+    {
+        auto& frame = _presentedFrames.front();
+
+        bool displayed = true;
+        for (auto& [swapchain, presentId] : frame.presentIds)
+        {
+            if (swapchain->waitForPresent(presentId, presentWaitTimeout) != VK_SUCCESS) displayed = false;
+        }
+
+        if (displayed)
+        {
+            auto now = clock::now();
+            latency = seconds(now - frame.frameStart).count();
+
+            if (_displayed)
+            {
+                // ignore intervals where a refresh was missed, but adopt shorter ones straight away as the display may have been changed
+                double interval = seconds(now - _lastDisplayed).count();
+                if (refreshInterval == 0.0 || interval < 0.75 * refreshInterval)
+                    refreshInterval = interval;
+                else if (interval < 1.5 * refreshInterval)
+                    refreshInterval += smoothing * (interval - refreshInterval);
+            }
+
+            _lastDisplayed = now;
+
+            if (instrumentation)
+            {
+                instrumentation->plot("FramePacing latency ms", latency * 1000.0);
+                instrumentation->plot("FramePacing refresh interval ms", refreshInterval * 1000.0);
+            }
+        }
+
+        // timeouts and out of date swapchains leave the time of display unknown so don't provide a reference for the just in time start
+        _displayed = displayed;
+
+        _presentedFrames.pop_front();
+    }
+
+    if (justInTime && _displayed && refreshInterval > 0.0)
+    {
+        // the next frame will be displayed on the refresh after those of frames still waiting to be displayed
+        double refreshes = static_cast<double>(_presentedFrames.size() + 1);
+        auto start = _lastDisplayed + std::chrono::duration_cast<clock::duration>(seconds(refreshes * refreshInterval - frameDuration - safetyMargin));
+
+        auto now = clock::now();
+        if (start > now)
+        {
+            if (instrumentation) instrumentation->plot("FramePacing delay ms", seconds(start - now).count() * 1000.0);
+
+            std::this_thread::sleep_until(start);
+        }
+    }
+
+    _frameStart = clock::now();
+    _frameStarted = true;
+}
+
+void FramePacing::presented(const std::vector<ref_ptr<Presentation>>& presentations, const Instrumentation* instrumentation)
+{
+    if (!_frameStarted) return;
+    _frameStarted = false;
+
+    double duration = std::chrono::duration<double, std::chrono::seconds::period>(clock::now() - _frameStart).count();
+    frameDuration = (frameDuration == 0.0) ? duration : (frameDuration + smoothing * (duration - frameDuration));
+
+    if (instrumentation) instrumentation->plot("FramePacing frame duration ms", frameDuration * 1000.0);
+
+    PresentedFrame frame;
+    frame.frameStart = _frameStart;
+    for (auto& presentation : presentations)
+    {
+        for (auto& presentId : presentation->presentIds)
+        {
+            if (presentId.first->supportsPresentWait()) frame.presentIds.push_back(presentId);
+        }
+    }
+
+    if (!frame.presentIds.empty()) _presentedFrames.push_back(frame);
+}
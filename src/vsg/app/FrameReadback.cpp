@@ -0,0 +1,516 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/FrameReadback.h>
+#include <vsg/io/Logger.h>
+#include <vsg/state/ImageInfo.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/Context.h>
+
+#include <algorithm>
+
+using namespace vsg;
+
+namespace
+{
+    // local size of the conversion, each invocation converts a block of 8x2 pixels
+    constexpr uint32_t s_localSize = 8;
+    constexpr uint32_t s_blockWidth = 8;
+    constexpr uint32_t s_blockHeight = 2;
+
+    const char* s_yuvSource = R"(
+#version 450
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+layout(push_constant) uniform PushConstants
+{
+    uint width;
+    uint height;
+    uint lumaStride;
+    uint swizzle;
+} pc;
+
+layout(std430, set = 0, binding = 0) readonly buffer Source { uint pixels[]; };
+layout(std430, set = 0, binding = 1) writeonly buffer Destination { uint planes[]; };
+
+vec3 fetch(uint x, uint y)
+{
+    vec4 c = unpackUnorm4x8(pixels[min(y, pc.height - 1) * pc.width + min(x, pc.width - 1)]);
+    return (pc.swizzle != 0) ? c.bgr : c.rgb;
+}
+
+// BT.709 luma
+float luma(vec3 c) { return dot(c, vec3(0.2126, 0.7152, 0.0722)); }
+
+// scale to limited range and pack four 8 bit values to a word
+uint packLuma(vec4 y) { return packUnorm4x8((16.0 + 219.0 * y) / 255.0); }
+uint packChroma(vec4 c) { return packUnorm4x8((128.0 + 224.0 * c) / 255.0); }
+
+void main()
+{
+    uint blocksX = pc.lumaStride / 8;
+    uint paddedHeight = (pc.height + 1) & ~1u;
+    uint bx = gl_GlobalInvocationID.x;
+    uint by = gl_GlobalInvocationID.y;
+    if (bx >= blocksX || by * 2 >= paddedHeight) return;
+
+    uint x0 = bx * 8;
+    uint y0 = by * 2;
+
+    vec4 y00, y01, y10, y11; // luma words, [row][word]
+    vec4 u, v;
+    for (uint i = 0; i < 4; ++i)
+    {
+        uint x = x0 + i * 2;
+        vec3 c00 = fetch(x, y0);
+        vec3 c10 = fetch(x + 1, y0);
+        vec3 c01 = fetch(x, y0 + 1);
+        vec3 c11 = fetch(x + 1, y0 + 1);
+
+        uint c = (i & 1) * 2;
+        if (i < 2)
+        {
+            y00[c] = luma(c00); y00[c + 1] = luma(c10);
+            y10[c] = luma(c01); y10[c + 1] = luma(c11);
+        }
+        else
+        {
+            y01[c] = luma(c00); y01[c + 1] = luma(c10);
+            y11[c] = luma(c01); y11[c + 1] = luma(c11);
+        }
+
+        vec3 average = (c00 + c10 + c01 + c11) * 0.25;
+        float l = luma(average);
+        u[i] = (average.b - l) / 1.8556;
+        v[i] = (average.r - l) / 1.5748;
+    }
+
+    uint lumaWords = pc.lumaStride / 4;
+    uint lumaIndex = y0 * lumaWords + bx * 2;
+    planes[lumaIndex] = packLuma(y00);
+    planes[lumaIndex + 1] = packLuma(y01);
+    planes[lumaIndex + lumaWords] = packLuma(y10);
+    planes[lumaIndex + lumaWords + 1] = packLuma(y11);
+
+    // the chroma planes have half the stride and height of the luma plane, so a row of chroma words has blocksX words
+    uint uOffset = (pc.lumaStride * paddedHeight) / 4;
+    uint vOffset = uOffset + (pc.lumaStride * paddedHeight) / 16;
+    planes[uOffset + by * blocksX + bx] = packChroma(u);
+    planes[vOffset + by * blocksX + bx] = packChroma(v);
+}
+)";
+
+    struct PushConstants
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t lumaStride;
+        uint32_t swizzle;
+    };
+
+    // return 0 for RGBA ordered formats, 1 for BGRA ordered formats or -1 for formats the conversion doesn't support
+    int swizzle(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_A8B8G8R8_UNORM_PACK32:
+        case VK_FORMAT_A8B8G8R8_SRGB_PACK32:
+            return 0;
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            return 1;
+        default:
+            return -1;
+        }
+    }
+
+} // namespace
+
+FrameReadback::FrameReadback(ref_ptr<Window> in_window, uint32_t in_numBuffers) :
+    window(in_window),
+    numBuffers(std::max(in_numBuffers, 1u)),
+    _status(ActivityStatus::create(false)),
+    _slots(numBuffers)
+{
+}
+
+FrameReadback::~FrameReadback()
+{
+    stop();
+}
+
+void FrameReadback::prepare(WindowTraits& traits)
+{
+    traits.swapchainPreferences.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+}
+
+void FrameReadback::start()
+{
+    if (_thread.joinable()) return;
+
+    _status->set(true);
+
+    auto callbackThread = [](FrameReadback& frameReadback) {
+        debug("Started FrameReadback callback thread");
+
+        while (frameReadback._status->active())
+        {
+            auto slot = frameReadback._takeCompleted();
+            if (!slot) continue;
+
+            if (frameReadback.callback)
+            {
+                frameReadback.callback(slot->frame);
+                ++frameReadback.numCapturedFrames;
+            }
+
+            // the event can only be reset once the GPU has set it, which has been checked by poll()
+            slot->event->reset();
+
+            std::scoped_lock<std::mutex> lock(frameReadback._mutex);
+            slot->status = AVAILABLE;
+        }
+
+        debug("Finished FrameReadback callback thread");
+    };
+
+    _thread = std::thread(callbackThread, std::ref(*this));
+}
+
+void FrameReadback::stop()
+{
+    if (!_thread.joinable()) return;
+
+    _status->set(false);
+    _completedCV.notify_all();
+    _thread.join();
+
+    // discard completed frames that haven't been passed to the callback
+    std::scoped_lock<std::mutex> lock(_mutex);
+    for (auto slot : _completed)
+    {
+        slot->event->reset();
+        slot->status = AVAILABLE;
+    }
+    _completed.clear();
+}
+
+FrameReadback::Slot* FrameReadback::_takeCompleted()
+{
+    std::chrono::duration waitDuration = std::chrono::milliseconds(100);
+    std::unique_lock lock(_mutex);
+
+    // wait until the conditional variable signals that a readback has completed
+    while (_completed.empty() && _status->active())
+    {
+        _completedCV.wait_for(lock, waitDuration);
+    }
+
+    if (_completed.empty() || !_status->active()) return nullptr;
+
+    auto slot = _completed.front();
+    _completed.pop_front();
+    return slot;
+}
+
+void FrameReadback::poll() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    bool completed = false;
+    for (auto& slot : _slots)
+    {
+        if (slot.status == IN_FLIGHT && slot.event->status() == VK_EVENT_SET)
+        {
+            slot.status = COMPLETED;
+            _completed.push_back(&slot);
+            completed = true;
+        }
+    }
+
+    // release the resources replaced on resize once the frames that may reference them have completed
+    uint64_t maxFramesInFlight = window->numFrames() + 1;
+    while (!_retired.empty() && _retired.front().first + maxFramesInFlight < _frameNumber)
+    {
+        _retired.pop_front();
+    }
+
+    if (completed) _completedCV.notify_one();
+}
+
+void FrameReadback::compile(Context& context)
+{
+    auto device = context.device;
+
+    for (auto& slot : _slots)
+    {
+        if (!slot.event) slot.event = Event::create(device);
+    }
+
+    if (pixelFormat != YUV420 || _pipeline) return;
+
+    if (!context.getOrCreateShaderCompiler())
+    {
+        warn("FrameReadback::compile() shader compiler not available for YUV420 conversion, falling back to IMAGE_FORMAT.");
+        pixelFormat = IMAGE_FORMAT;
+        return;
+    }
+
+    DescriptorSetLayoutBindings bindings{
+        {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr}};
+
+    _descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    auto pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{_descriptorSetLayout}, PushConstantRanges{{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants)}});
+    auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", s_yuvSource);
+
+    try
+    {
+        _pipeline = ComputePipeline::create(pipelineLayout, computeShader);
+        _pipeline->compile(context);
+    }
+    catch (const Exception& exception)
+    {
+        warn("FrameReadback::compile() unable to create YUV420 conversion pipeline, falling back to IMAGE_FORMAT. ", exception.message);
+        _pipeline = {};
+        pixelFormat = IMAGE_FORMAT;
+        return;
+    }
+
+    // descriptor sets are replaced when the readback buffers are resized, so allow for the replaced sets while they're retired
+    uint32_t maxSets = numBuffers * 2;
+    _descriptorPool = DescriptorPool::create(device, maxSets, DescriptorPoolSizes{{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, maxSets * 2}});
+}
+
+void FrameReadback::_retire(ref_ptr<Object> object) const
+{
+    if (object) _retired.emplace_back(_frameNumber, object);
+}
+
+bool FrameReadback::_allocate(Slot& slot, const VkExtent2D& extent, VkFormat imageFormat, PixelFormat format) const
+{
+    auto device = window->getOrCreateDevice();
+    auto deviceID = device->deviceID;
+    auto& frame = slot.frame;
+
+    VkDeviceSize imageSize = VkDeviceSize(extent.width) * extent.height * getFormatTraits(imageFormat).size;
+
+    if (!slot.buffer || frame.width != extent.width || frame.height != extent.height || frame.imageFormat != imageFormat || frame.pixelFormat != format)
+    {
+        Frame layout;
+        layout.width = extent.width;
+        layout.height = extent.height;
+        layout.pixelFormat = format;
+        layout.imageFormat = imageFormat;
+
+        if (format == YUV420)
+        {
+            // luma stride padded to whole conversion blocks and height to whole chroma rows
+            uint32_t lumaStride = ((extent.width + s_blockWidth - 1) / s_blockWidth) * s_blockWidth;
+            uint32_t paddedHeight = ((extent.height + 1) / 2) * 2;
+            VkDeviceSize lumaSize = VkDeviceSize(lumaStride) * paddedHeight;
+
+            layout.planeStrides[0] = lumaStride;
+            layout.planeStrides[1] = layout.planeStrides[2] = lumaStride / 2;
+            layout.planeOffsets[1] = lumaSize;
+            layout.planeOffsets[2] = lumaSize + lumaSize / 4;
+            layout.size = lumaSize + lumaSize / 2;
+        }
+        else
+        {
+            layout.planeStrides[0] = extent.width * getFormatTraits(imageFormat).size;
+            layout.size = imageSize;
+        }
+
+        if (slot.buffer)
+        {
+            slot.buffer->getDeviceMemory(deviceID)->unmap();
+            slot.mappedData = nullptr;
+            _retire(slot.buffer);
+            _retire(slot.descriptorSet);
+            slot.buffer = {};
+            slot.descriptorSet = {};
+        }
+
+        VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | (format == YUV420 ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT : 0);
+        auto buffer = createBufferAndMemory(device, layout.size, usage, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        // the buffer is mapped for its lifetime so the callback can read each frame in place
+        void* data = nullptr;
+        if (buffer->getDeviceMemory(deviceID)->map(buffer->getMemoryOffset(deviceID), layout.size, 0, &data) != VK_SUCCESS)
+        {
+            warn("FrameReadback unable to map readback buffer, frame not read back.");
+            return false;
+        }
+
+        slot.buffer = buffer;
+        slot.mappedData = static_cast<uint8_t*>(data);
+        frame = layout;
+    }
+
+    if (format != YUV420) return true;
+
+    if (!_sourceBuffer || _sourceBuffer->size < imageSize)
+    {
+        _retire(_sourceBuffer);
+        _sourceBuffer = createBufferAndMemory(device, imageSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        // all the descriptor sets reference the previous source buffer so have to be replaced
+        for (auto& other : _slots)
+        {
+            _retire(other.descriptorSet);
+            other.descriptorSet = {};
+        }
+    }
+
+    if (!slot.descriptorSet)
+    {
+        // a new descriptor set is allocated rather than the previous one updated, as the previous one may still be referenced by frames in flight
+        slot.descriptorSet = _descriptorPool->allocateDescriptorSet(_descriptorSetLayout);
+        if (!slot.descriptorSet)
+        {
+            warn("FrameReadback unable to allocate descriptor set, frame not read back.");
+            return false;
+        }
+
+        VkDescriptorBufferInfo bufferInfos[2] = {
+            {_sourceBuffer->vk(deviceID), 0, _sourceBuffer->size},
+            {slot.buffer->vk(deviceID), 0, frame.size}};
+
+        VkWriteDescriptorSet writes[2] = {};
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = slot.descriptorSet->_descriptorSet;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &bufferInfos[i];
+        }
+        vkUpdateDescriptorSets(*device, 2, writes, 0, nullptr);
+    }
+
+    return true;
+}
+
+void FrameReadback::record(CommandBuffer& commandBuffer) const
+{
+    poll();
+
+    uint64_t frameNumber = _frameNumber++;
+    if (!active || !callback || !_status->active() || (captureInterval > 1 && (frameNumber % captureInterval) != 0)) return;
+
+    // do nothing if the imageIndex() is invalid.
+    size_t imageIndex = window->imageIndex();
+    if (imageIndex >= window->numFrames()) return;
+
+    auto image = window->imageView(imageIndex)->image;
+    auto extent = window->extent2D();
+    auto imageFormat = image->format;
+
+    PixelFormat format = pixelFormat;
+    int swizzleFormat = swizzle(imageFormat);
+    if (format == YUV420 && (!_pipeline || swizzleFormat < 0)) format = IMAGE_FORMAT;
+
+    Slot* slot = nullptr;
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        for (auto& candidate : _slots)
+        {
+            if (candidate.status == AVAILABLE && candidate.event)
+            {
+                slot = &candidate;
+                break;
+            }
+        }
+
+        // all the buffers are in flight or waiting on the callback, drop the frame rather than stall
+        if (!slot)
+        {
+            ++numDroppedFrames;
+            return;
+        }
+
+        if (!_allocate(*slot, extent, imageFormat, format)) return;
+
+        slot->status = IN_FLIGHT;
+        slot->frame.frameNumber = frameNumber;
+        slot->frame.data = slot->mappedData;
+    }
+
+    auto deviceID = commandBuffer.deviceID;
+    VkCommandBuffer vk_commandBuffer = commandBuffer;
+    VkImageSubresourceRange range{VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+    // the swapchain image has been left in PRESENT_SRC_KHR by the render pass, any earlier conversion must have finished reading the source buffer before it's overwritten
+    VkImageMemoryBarrier toTransferSrc{};
+    toTransferSrc.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransferSrc.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    toTransferSrc.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toTransferSrc.oldLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    toTransferSrc.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toTransferSrc.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransferSrc.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransferSrc.image = image->vk(deviceID);
+    toTransferSrc.subresourceRange = range;
+
+    vkCmdPipelineBarrier(vk_commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransferSrc);
+
+    VkBufferImageCopy region{};
+    region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1};
+    region.imageExtent = {extent.width, extent.height, 1};
+
+    auto destination = (format == YUV420) ? _sourceBuffer : slot->buffer;
+    vkCmdCopyImageToBuffer(vk_commandBuffer, image->vk(deviceID), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, destination->vk(deviceID), 1, &region);
+
+    VkImageMemoryBarrier toPresentSrc = toTransferSrc;
+    toPresentSrc.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    toPresentSrc.dstAccessMask = 0;
+    toPresentSrc.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    toPresentSrc.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkPipelineStageFlags completedStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    if (format == YUV420)
+    {
+        VkMemoryBarrier copyToShader{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT};
+        vkCmdPipelineBarrier(vk_commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 1, &copyToShader, 0, nullptr, 1, &toPresentSrc);
+
+        PushConstants pushConstants{extent.width, extent.height, slot->frame.planeStrides[0], static_cast<uint32_t>(swizzleFormat)};
+        auto vk_pipelineLayout = _pipeline->layout->vk(deviceID);
+
+        vkCmdBindPipeline(vk_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipeline->vk(deviceID));
+        vkCmdBindDescriptorSets(vk_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vk_pipelineLayout, 0, 1, &(slot->descriptorSet->_descriptorSet), 0, nullptr);
+        vkCmdPushConstants(vk_commandBuffer, vk_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
+
+        uint32_t blocksX = slot->frame.planeStrides[0] / s_blockWidth;
+        uint32_t blocksY = (extent.height + s_blockHeight - 1) / s_blockHeight;
+        vkCmdDispatch(vk_commandBuffer, (blocksX + s_localSize - 1) / s_localSize, (blocksY + s_localSize - 1) / s_localSize, 1);
+
+        // the compute pipeline, descriptor set and push constants were recorded directly so discard the CommandBuffer's tracking of them
+        commandBuffer.dirtyBindings();
+
+        completedStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    }
+    else
+    {
+        vkCmdPipelineBarrier(vk_commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &toPresentSrc);
+    }
+
+    // make the writes visible to the host before signaling the event that poll() checks
+    VkMemoryBarrier toHost{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, (format == YUV420) ? VkAccessFlags(VK_ACCESS_SHADER_WRITE_BIT) : VkAccessFlags(VK_ACCESS_TRANSFER_WRITE_BIT), VK_ACCESS_HOST_READ_BIT};
+    vkCmdPipelineBarrier(vk_commandBuffer, completedStage, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &toHost, 0, nullptr, 0, nullptr);
+
+    vkCmdSetEvent(vk_commandBuffer, slot->event->vk(), completedStage);
+}
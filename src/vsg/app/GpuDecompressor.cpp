@@ -0,0 +1,418 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/GpuDecompressor.h>
+#include <vsg/app/TransferTask.h>
+#include <vsg/io/Logger.h>
+#include <vsg/state/Buffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/DescriptorPool.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace vsg;
+
+namespace
+{
+    struct ChunkParams
+    {
+        uint32_t srcOffset;
+        uint32_t srcSize;
+        uint32_t dstOffset;
+        uint32_t dstSize;
+    };
+
+    // scratch offsets are aligned to cover the texel size requirements of vkCmdCopyBufferToImage
+    constexpr VkDeviceSize s_scratchAlignment = 16;
+
+    const char* s_decompressSource = R"(#version 450
+
+#define WORKGROUP_SIZE 64
+
+layout(local_size_x = WORKGROUP_SIZE) in;
+
+struct Chunk
+{
+    uint srcOffset;
+    uint srcSize;
+    uint dstOffset;
+    uint dstSize;
+};
+
+// bytes are packed 4 to a uint, destination bytes are written with atomicOr into the zeroed scratch buffer as neighbouring bytes may be written by other invocations
+layout(set = 0, binding = 0) readonly buffer Source { uint src[]; };
+layout(set = 0, binding = 1) coherent buffer Destination { uint dst[]; };
+layout(set = 0, binding = 2) readonly buffer Chunks { Chunk chunks[]; };
+
+shared uint s_srcPos;
+shared uint s_dstPos;
+shared uint s_literalStart;
+shared uint s_literalLength;
+shared uint s_matchOffset;
+shared uint s_matchLength;
+
+uint readSource(uint i) { return (src[i >> 2] >> ((i & 3u) * 8u)) & 0xffu; }
+uint readDestination(uint i) { return (dst[i >> 2] >> ((i & 3u) * 8u)) & 0xffu; }
+void writeDestination(uint i, uint value) { atomicOr(dst[i >> 2], value << ((i & 3u) * 8u)); }
+
+void main()
+{
+    Chunk chunk = chunks[gl_WorkGroupID.x];
+    uint t = gl_LocalInvocationIndex;
+    uint dstEnd = chunk.dstOffset + chunk.dstSize;
+
+    // chunks that didn't compress are stored as is
+    if (chunk.srcSize == chunk.dstSize)
+    {
+        for (uint i = t; i < chunk.dstSize; i += WORKGROUP_SIZE) writeDestination(chunk.dstOffset + i, readSource(chunk.srcOffset + i));
+        return;
+    }
+
+    uint srcEnd = chunk.srcOffset + chunk.srcSize;
+    if (t == 0)
+    {
+        s_srcPos = chunk.srcOffset;
+        s_dstPos = chunk.dstOffset;
+    }
+
+    while (true)
+    {
+        memoryBarrierShared();
+        barrier();
+
+        // the first invocation parses the next LZ4 sequence
+        if (t == 0)
+        {
+            uint p = s_srcPos;
+            uint token = readSource(p++);
+            uint literalLength = token >> 4;
+            if (literalLength == 15)
+            {
+                uint b;
+                do { b = readSource(p++); literalLength += b; } while (b == 255 && p < srcEnd);
+            }
+            s_literalStart = p;
+            s_literalLength = literalLength;
+            p += literalLength;
+
+            // the last sequence of a block only has literals
+            if (p >= srcEnd)
+            {
+                s_matchOffset = 0;
+                s_matchLength = 0;
+            }
+            else
+            {
+                uint offset = readSource(p) | (readSource(p + 1) << 8);
+                p += 2;
+                uint matchLength = token & 15;
+                if (matchLength == 15)
+                {
+                    uint b;
+                    do { b = readSource(p++); matchLength += b; } while (b == 255 && p < srcEnd);
+                }
+                s_matchOffset = offset;
+                s_matchLength = (offset == 0) ? 0 : matchLength + 4;
+            }
+            s_srcPos = p;
+        }
+
+        memoryBarrierShared();
+        barrier();
+
+        uint dstPos = s_dstPos;
+        uint literalStart = s_literalStart;
+        uint literalLength = min(s_literalLength, dstEnd - dstPos);
+        uint matchOffset = s_matchOffset;
+        uint matchLength = s_matchLength;
+
+        for (uint i = t; i < literalLength; i += WORKGROUP_SIZE) writeDestination(dstPos + i, readSource(literalStart + i));
+        dstPos += literalLength;
+
+        if (matchLength == 0 || matchOffset > (dstPos - chunk.dstOffset)) break;
+
+        // make the bytes written so far visible, the match only reads bytes before dstPos, repeating with a period of matchOffset when it overlaps itself
+        memoryBarrierBuffer();
+        barrier();
+
+        matchLength = min(matchLength, dstEnd - dstPos);
+        for (uint i = t; i < matchLength; i += WORKGROUP_SIZE) writeDestination(dstPos + i, readDestination(dstPos - matchOffset + (i % matchOffset)));
+
+        memoryBarrierBuffer();
+        barrier();
+
+        if (t == 0) s_dstPos = dstPos + matchLength;
+    }
+}
+)";
+
+} // namespace
+
+GpuDecompressor::GpuDecompressor(Device* in_device) :
+    device(in_device)
+{
+}
+
+GpuDecompressor::~GpuDecompressor()
+{
+}
+
+bool GpuDecompressor::supported(const CompressedData& data)
+{
+    if (!data.valid() || data.method != COMPRESSION_LZ4) return false;
+
+    // each payload and its decompressed values must fit within a single storage buffer binding
+    const auto& limits = device->getPhysicalDevice()->getProperties().limits;
+    VkDeviceSize maxSize = limits.maxStorageBufferRange - std::max(limits.minStorageBufferOffsetAlignment, s_scratchAlignment);
+    if (data.payload->dataSize() > maxSize || data.dataSize() > maxSize) return false;
+
+    return _getPipeline() != nullptr;
+}
+
+void GpuDecompressor::add(ref_ptr<CompressedData> data, ref_ptr<Buffer> stagingBuffer, VkDeviceSize stagingOffset, ref_ptr<Buffer> buffer, VkDeviceSize offset)
+{
+    Entry entry;
+    entry.data = data;
+    entry.stagingBuffer = stagingBuffer;
+    entry.stagingOffset = stagingOffset;
+    entry.buffer = buffer;
+    entry.offset = offset;
+    _entries.push_back(entry);
+}
+
+void GpuDecompressor::add(ref_ptr<CompressedData> data, ref_ptr<Buffer> stagingBuffer, VkDeviceSize stagingOffset, ref_ptr<ImageView> imageView, VkImageLayout targetImageLayout, uint32_t mipLevels)
+{
+    Entry entry;
+    entry.data = data;
+    entry.stagingBuffer = stagingBuffer;
+    entry.stagingOffset = stagingOffset;
+    entry.imageView = imageView;
+    entry.targetImageLayout = targetImageLayout;
+    entry.mipLevels = mipLevels;
+    _entries.push_back(entry);
+}
+
+ComputePipeline* GpuDecompressor::_getPipeline()
+{
+    if (_pipeline || _pipelineFailed) return _pipeline.get();
+
+    _context = Context::create(device);
+    if (!_context->getOrCreateShaderCompiler())
+    {
+        warn("GpuDecompressor::_getPipeline() no shader compiler available, payloads will be decompressed on the CPU.");
+        _pipelineFailed = true;
+        return nullptr;
+    }
+
+    DescriptorSetLayoutBindings bindings{
+        {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr}};
+
+    _descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    _pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{_descriptorSetLayout}, PushConstantRanges{});
+
+    auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", s_decompressSource);
+
+    try
+    {
+        _pipeline = ComputePipeline::create(_pipelineLayout, computeShader);
+        _pipeline->compile(*_context);
+    }
+    catch (const Exception& exception)
+    {
+        warn("GpuDecompressor::_getPipeline() unable to create compute pipeline, payloads will be decompressed on the CPU. ", exception.message);
+        _pipeline = {};
+        _pipelineFailed = true;
+    }
+
+    return _pipeline.get();
+}
+
+ref_ptr<Objects> GpuDecompressor::record(VkCommandBuffer commandBuffer, MipmapGenerator* mipmapGenerator)
+{
+    if (_entries.empty()) return {};
+
+    auto deviceID = device->deviceID;
+    auto resources = Objects::create();
+
+    // entries are only added once supported(..) has confirmed the pipeline is available
+    auto pipeline = _getPipeline();
+    if (!pipeline)
+    {
+        _entries.clear();
+        return resources;
+    }
+
+    const auto& limits = device->getPhysicalDevice()->getProperties().limits;
+    VkDeviceSize maxRange = limits.maxStorageBufferRange;
+    VkDeviceSize bindAlignment = std::max(limits.minStorageBufferOffsetAlignment, s_scratchAlignment);
+    auto alignUp = [](VkDeviceSize value, VkDeviceSize alignment) { return ((value + alignment - 1) / alignment) * alignment; };
+
+    // entries are grouped so that each dispatch reads from a single window of a staging buffer and writes to a single window of the scratch buffer,
+    // both within maxStorageBufferRange, typically all the entries of a transfer fit in one group.
+    std::stable_sort(_entries.begin(), _entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return (lhs.stagingBuffer < rhs.stagingBuffer) || (lhs.stagingBuffer == rhs.stagingBuffer && lhs.stagingOffset < rhs.stagingOffset);
+    });
+
+    struct Group
+    {
+        size_t first = 0;
+        size_t last = 0;
+        VkDeviceSize stagingBase = 0;
+        VkDeviceSize stagingEnd = 0;
+        VkDeviceSize scratchBase = 0;
+        VkDeviceSize scratchEnd = 0;
+        VkDeviceSize paramsOffset = 0;
+        size_t numChunks = 0;
+    };
+    std::vector<Group> groups;
+
+    std::vector<VkDeviceSize> scratchOffsets(_entries.size());
+    VkDeviceSize scratchSize = 0;
+    for (size_t i = 0; i < _entries.size(); ++i)
+    {
+        auto& entry = _entries[i];
+        VkDeviceSize payloadEnd = entry.stagingOffset + entry.data->payload->dataSize();
+        VkDeviceSize decompressedSize = alignUp(entry.data->dataSize(), s_scratchAlignment);
+
+        Group* group = groups.empty() ? nullptr : &groups.back();
+        if (!group || _entries[group->first].stagingBuffer != entry.stagingBuffer || (payloadEnd - group->stagingBase) > maxRange || (scratchSize + decompressedSize - group->scratchBase) > maxRange)
+        {
+            Group newGroup;
+            newGroup.first = i;
+            newGroup.stagingBase = (entry.stagingOffset / limits.minStorageBufferOffsetAlignment) * limits.minStorageBufferOffsetAlignment;
+            newGroup.scratchBase = scratchSize = alignUp(scratchSize, bindAlignment);
+            groups.push_back(newGroup);
+            group = &groups.back();
+        }
+
+        scratchOffsets[i] = scratchSize;
+        scratchSize += decompressedSize;
+
+        group->last = i + 1;
+        group->stagingEnd = std::max(group->stagingEnd, payloadEnd);
+        group->scratchEnd = scratchSize;
+        group->numChunks += entry.data->chunks.size();
+    }
+
+    VkDeviceSize paramsSize = 0;
+    for (auto& group : groups)
+    {
+        group.paramsOffset = paramsSize;
+        paramsSize = alignUp(paramsSize + sizeof(ChunkParams) * group.numChunks, limits.minStorageBufferOffsetAlignment);
+    }
+
+    auto scratchBuffer = createBufferAndMemory(device, scratchSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    resources->addChild(scratchBuffer);
+
+    auto paramsBuffer = createBufferAndMemory(device, paramsSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    resources->addChild(paramsBuffer);
+
+    void* params_data = nullptr;
+    auto paramsMemory = paramsBuffer->getDeviceMemory(deviceID);
+    if (paramsMemory->map(paramsBuffer->getMemoryOffset(deviceID), paramsBuffer->size, 0, &params_data) != VK_SUCCESS)
+    {
+        warn("GpuDecompressor::record() unable to map parameter buffer, payloads dropped.");
+        _entries.clear();
+        return resources;
+    }
+
+    uint32_t numGroups = static_cast<uint32_t>(groups.size());
+    auto descriptorPool = DescriptorPool::create(device, numGroups, DescriptorPoolSizes{{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, numGroups * 3}});
+    resources->addChild(descriptorPool);
+
+    // the decoder ORs bytes into the scratch buffer so it must start zeroed
+    vkCmdFillBuffer(commandBuffer, scratchBuffer->vk(deviceID), 0, VK_WHOLE_SIZE, 0);
+
+    VkMemoryBarrier fillBarrier = {};
+    fillBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    fillBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    fillBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &fillBarrier, 0, nullptr, 0, nullptr);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->vk(deviceID));
+
+    for (auto& group : groups)
+    {
+        // chunk offsets are relative to the start of the group's windows of the staging and scratch buffers
+        auto params = reinterpret_cast<ChunkParams*>(static_cast<uint8_t*>(params_data) + group.paramsOffset);
+        for (size_t i = group.first; i < group.last; ++i)
+        {
+            auto& entry = _entries[i];
+            auto& data = *entry.data;
+            for (size_t c = 0; c < data.chunks.size(); ++c)
+            {
+                auto& chunk = data.chunks[c];
+                *(params++) = ChunkParams{static_cast<uint32_t>(entry.stagingOffset + chunk.offset - group.stagingBase), chunk.size, static_cast<uint32_t>(scratchOffsets[i] + c * data.chunkSize - group.scratchBase), data.chunkDataSize(c)};
+            }
+
+            numCompressedBytes += data.payload->dataSize();
+            numDecompressedBytes += data.dataSize();
+        }
+
+        auto dsi = descriptorPool->allocateDescriptorSet(_descriptorSetLayout);
+        resources->addChild(dsi);
+
+        // the source range is rounded up to whole uints as the shader reads the bytes 4 at a time
+        VkDeviceSize stagingRange = std::min(alignUp(group.stagingEnd - group.stagingBase, 4), _entries[group.first].stagingBuffer->size - group.stagingBase);
+        VkDescriptorBufferInfo bufferInfos[3] = {
+            {_entries[group.first].stagingBuffer->vk(deviceID), group.stagingBase, stagingRange},
+            {scratchBuffer->vk(deviceID), group.scratchBase, group.scratchEnd - group.scratchBase},
+            {paramsBuffer->vk(deviceID), group.paramsOffset, sizeof(ChunkParams) * group.numChunks}};
+
+        VkWriteDescriptorSet writes[3] = {};
+        for (uint32_t b = 0; b < 3; ++b)
+        {
+            writes[b].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[b].dstSet = dsi->_descriptorSet;
+            writes[b].dstBinding = b;
+            writes[b].descriptorCount = 1;
+            writes[b].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[b].pBufferInfo = &bufferInfos[b];
+        }
+        vkUpdateDescriptorSets(*device, 3, writes, 0, nullptr);
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout->vk(deviceID), 0, 1, &(dsi->_descriptorSet), 0, nullptr);
+        vkCmdDispatch(commandBuffer, static_cast<uint32_t>(group.numChunks), 1, 1);
+    }
+
+    paramsMemory->unmap();
+
+    VkMemoryBarrier decompressBarrier = {};
+    decompressBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    decompressBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    decompressBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &decompressBarrier, 0, nullptr, 0, nullptr);
+
+    // copy the decompressed values to their destinations
+    for (size_t i = 0; i < _entries.size(); ++i)
+    {
+        auto& entry = _entries[i];
+        auto& data = *entry.data;
+        if (entry.buffer)
+        {
+            VkBufferCopy region{scratchOffsets[i], entry.offset, data.dataSize()};
+            vkCmdCopyBuffer(commandBuffer, scratchBuffer->vk(deviceID), entry.buffer->vk(deviceID), 1, &region);
+        }
+        else if (entry.imageView)
+        {
+            transferImageData(entry.imageView, entry.targetImageLayout, data.properties, data.width(), data.height(), data.depth(), entry.mipLevels, scratchBuffer, scratchOffsets[i], commandBuffer, device, mipmapGenerator);
+        }
+    }
+
+    _entries.clear();
+
+    return resources;
+}
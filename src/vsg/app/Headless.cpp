@@ -0,0 +1,160 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/Headless.h>
+#include <vsg/app/View.h>
+#include <vsg/core/Exception.h>
+#include <vsg/lighting/Light.h>
+#include <vsg/vk/RenderPass.h>
+
+using namespace vsg;
+
+Headless::Headless(ref_ptr<WindowTraits> in_traits) :
+    traits(in_traits ? in_traits : WindowTraits::create())
+{
+    _initDevice();
+    _initFramebuffer();
+}
+
+void Headless::_initDevice()
+{
+    traits->validate();
+
+    instance = Instance::create(traits->instanceExtensionNames, traits->requestedLayers, traits->vulkanVersion);
+
+    auto [selectedPhysicalDevice, selectedQueueFamily] = instance->getPhysicalDeviceAndQueueFamily(traits->queueFlags, traits->deviceTypePreferences);
+    if (!selectedPhysicalDevice || selectedQueueFamily < 0) throw Exception{"Error: vsg::Headless::create(...) failed, no suitable Vulkan PhysicalDevice available.", VK_ERROR_INVALID_EXTERNAL_HANDLE};
+
+    physicalDevice = selectedPhysicalDevice;
+    queueFamily = selectedQueueFamily;
+
+    QueueSettings queueSettings{QueueSetting{queueFamily, traits->queuePriorities}};
+    if (traits->asyncComputeQueue)
+    {
+        int computeFamily = physicalDevice->getQueueFamily(VK_QUEUE_COMPUTE_BIT);
+        if (computeFamily >= 0 && computeFamily != queueFamily) queueSettings.push_back(QueueSetting{computeFamily, {1.0}});
+    }
+
+    device = Device::create(physicalDevice, queueSettings, traits->requestedLayers, traits->deviceExtensionNames, traits->deviceFeatures, instance->getAllocationCallbacks());
+}
+
+void Headless::_initFramebuffer()
+{
+    // set up a render pass matching vsg::createRenderPass(..) but leaving the color attachment ready for copying back rather than presenting
+    auto colorAttachment = defaultColorAttachment(colorFormat);
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    auto depthAttachment = defaultDepthAttachment(traits->depthFormat);
+    if ((traits->depthImageUsage & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0) depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+
+    AttachmentReference colorAttachmentRef = {};
+    colorAttachmentRef.attachment = 0;
+    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    AttachmentReference depthAttachmentRef = {};
+    depthAttachmentRef.attachment = 1;
+    depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    SubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachments.emplace_back(colorAttachmentRef);
+    subpass.depthStencilAttachments.emplace_back(depthAttachmentRef);
+
+    // the previous frame's color attachment copy and depth writes must complete before the next frame renders to them
+    SubpassDependency colorDependency = {};
+    colorDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    colorDependency.dstSubpass = 0;
+    colorDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+    colorDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    colorDependency.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    colorDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    colorDependency.dependencyFlags = 0;
+
+    SubpassDependency depthDependency = {};
+    depthDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    depthDependency.dstSubpass = 0;
+    depthDependency.srcStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    depthDependency.dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    depthDependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthDependency.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    depthDependency.dependencyFlags = 0;
+
+    renderPass = RenderPass::create(device, RenderPass::Attachments{colorAttachment, depthAttachment}, RenderPass::Subpasses{subpass}, RenderPass::Dependencies{colorDependency, depthDependency});
+
+    // create color buffer
+    colorImage = Image::create();
+    colorImage->imageType = VK_IMAGE_TYPE_2D;
+    colorImage->format = colorFormat;
+    colorImage->extent = VkExtent3D{traits->width, traits->height, 1};
+    colorImage->mipLevels = 1;
+    colorImage->arrayLayers = 1;
+    colorImage->samples = VK_SAMPLE_COUNT_1_BIT;
+    colorImage->tiling = VK_IMAGE_TILING_OPTIMAL;
+    colorImage->usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+    colorImage->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorImage->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    colorImage->compile(device);
+    colorImage->allocateAndBindMemory(device);
+
+    colorImageView = ImageView::create(colorImage, VK_IMAGE_ASPECT_COLOR_BIT);
+    colorImageView->compile(device);
+
+    // create depth buffer
+    depthImage = Image::create();
+    depthImage->imageType = VK_IMAGE_TYPE_2D;
+    depthImage->format = traits->depthFormat;
+    depthImage->extent = VkExtent3D{traits->width, traits->height, 1};
+    depthImage->mipLevels = 1;
+    depthImage->arrayLayers = 1;
+    depthImage->samples = VK_SAMPLE_COUNT_1_BIT;
+    depthImage->tiling = VK_IMAGE_TILING_OPTIMAL;
+    depthImage->usage = traits->depthImageUsage;
+    depthImage->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    depthImage->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    depthImage->compile(device);
+    depthImage->allocateAndBindMemory(device);
+
+    depthImageView = ImageView::create(depthImage, computeAspectFlagsForFormat(traits->depthFormat));
+    depthImageView->compile(device);
+
+    framebuffer = Framebuffer::create(renderPass, ImageViews{colorImageView, depthImageView}, traits->width, traits->height, 1);
+}
+
+ref_ptr<RenderGraph> Headless::createRenderGraphForView(ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, VkSubpassContents contents, bool assignHeadlight)
+{
+    // set up the view
+    auto view = View::create(camera);
+    if (assignHeadlight) view->addChild(createHeadlight());
+    if (scenegraph) view->addChild(scenegraph);
+
+    // set up the render graph
+    auto renderGraph = RenderGraph::create();
+    renderGraph->framebuffer = framebuffer;
+    renderGraph->contents = contents;
+    renderGraph->renderArea.offset = {0, 0};
+    renderGraph->renderArea.extent = extent2D();
+    renderGraph->setClearValues();
+    renderGraph->addChild(view);
+
+    return renderGraph;
+}
+
+ref_ptr<CommandGraph> Headless::createCommandGraphForView(ref_ptr<Camera> camera, ref_ptr<Node> scenegraph, VkSubpassContents contents, bool assignHeadlight)
+{
+    auto commandGraph = CommandGraph::create(device, queueFamily);
+    commandGraph->framebuffer = framebuffer;
+    commandGraph->addChild(createRenderGraphForView(camera, scenegraph, contents, assignHeadlight));
+
+    return commandGraph;
+}
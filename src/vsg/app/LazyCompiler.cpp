@@ -0,0 +1,233 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/LazyCompiler.h>
+#include <vsg/app/Viewer.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/threading/atomics.h>
+#include <vsg/utils/ComputeBounds.h>
+
+#include <algorithm>
+
+using namespace vsg;
+
+namespace
+{
+    struct AssignLazyCompiler : public Visitor
+    {
+        ref_ptr<LazyCompiler> lazyCompiler;
+
+        explicit AssignLazyCompiler(LazyCompiler* in_lazyCompiler) :
+            lazyCompiler(in_lazyCompiler) {}
+
+        void apply(Object& object) override
+        {
+            object.traverse(*this);
+        }
+
+        void apply(LazyCompileGroup& lcg) override
+        {
+            lcg.lazyCompiler = lazyCompiler;
+            lcg.traverse(*this);
+        }
+    };
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// LazyCompiler
+//
+LazyCompiler::LazyCompiler(Viewer* viewer) :
+    _viewer(viewer),
+    _status(ActivityStatus::create(false))
+{
+}
+
+LazyCompiler::~LazyCompiler()
+{
+    stop();
+}
+
+void LazyCompiler::assign(Object& object)
+{
+    AssignLazyCompiler assignLazyCompiler(this);
+    object.accept(assignLazyCompiler);
+}
+
+void LazyCompiler::wrapChildren(Group& group)
+{
+    for (auto& child : group.children)
+    {
+        if (!child || child->is_compatible(typeid(LazyCompileGroup))) continue;
+
+        ComputeBounds computeBounds;
+        child->accept(computeBounds);
+        if (!computeBounds.bounds.valid()) continue;
+
+        auto& bounds = computeBounds.bounds;
+        auto lcg = LazyCompileGroup::create(dsphere((bounds.min + bounds.max) * 0.5, length(bounds.max - bounds.min) * 0.5));
+        lcg->addChild(child);
+        lcg->lazyCompiler = this;
+
+        child = lcg;
+    }
+}
+
+void LazyCompiler::start()
+{
+    if (!_threads.empty()) return;
+
+    if (!compileManager)
+    {
+        // take a ref_ptr<> of the observer_ptr<> to be able to safely access it
+        ref_ptr<Viewer> viewer = _viewer;
+        if (viewer) compileManager = viewer->compileManager;
+    }
+
+    if (!compileManager)
+    {
+        warn("LazyCompiler::start() no CompileManager assigned, call Viewer::compile() before starting the LazyCompiler.");
+        return;
+    }
+
+    _status->set(true);
+
+    auto compileThread = [](LazyCompiler& lazyCompiler) {
+        debug("Started LazyCompiler compile thread");
+
+        while (lazyCompiler._status->active())
+        {
+            if (auto lcg = lazyCompiler._takeRequest()) lazyCompiler._compile(lcg);
+        }
+
+        debug("Finished LazyCompiler compile thread");
+    };
+
+    for (uint32_t i = 0; i < std::max(numThreads, 1u); ++i)
+    {
+        _threads.emplace_back(compileThread, std::ref(*this));
+    }
+}
+
+void LazyCompiler::stop()
+{
+    if (_threads.empty()) return;
+
+    _status->set(false);
+    _requestCV.notify_all();
+
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+    _threads.clear();
+
+    // release any outstanding requests so they can be requested again if the LazyCompiler is restarted.
+    std::scoped_lock<std::mutex> lock(_requestMutex);
+    for (auto& lcg : _requests)
+    {
+        lcg->requestStatus = LazyCompileGroup::NoRequest;
+    }
+    numActiveRequests -= _requests.size();
+    _requests.clear();
+}
+
+void LazyCompiler::request(const LazyCompileGroup& lcg, double priority)
+{
+    if (!_status->active()) return;
+
+    lcg.priority = priority;
+
+    if (compare_exchange(lcg.requestStatus, LazyCompileGroup::NoRequest, LazyCompileGroup::CompileRequest))
+    {
+        ++numActiveRequests;
+
+        std::scoped_lock<std::mutex> lock(_requestMutex);
+        _requests.emplace_back(const_cast<LazyCompileGroup*>(&lcg));
+        _requestCV.notify_one();
+    }
+}
+
+ref_ptr<LazyCompileGroup> LazyCompiler::_takeRequest()
+{
+    std::chrono::duration waitDuration = std::chrono::milliseconds(100);
+    std::unique_lock lock(_requestMutex);
+
+    // wait until the conditional variable signals that a request has been added
+    while (_requests.empty() && _status->active())
+    {
+        _requestCV.wait_for(lock, waitDuration);
+    }
+
+    if (_requests.empty() || !_status->active()) return {};
+
+    // take the highest priority request, the priorities are updated by the RecordTraversal so have to be searched each time.
+    auto itr = std::max_element(_requests.begin(), _requests.end(), [](const ref_ptr<LazyCompileGroup>& lhs, const ref_ptr<LazyCompileGroup>& rhs) { return lhs->priority < rhs->priority; });
+    auto lcg = *itr;
+    _requests.erase(itr);
+
+    lcg->requestStatus = LazyCompileGroup::Compiling;
+    return lcg;
+}
+
+void LazyCompiler::_compile(ref_ptr<LazyCompileGroup> lcg)
+{
+    // compile the children via a separate Group as the CompileTraversal doesn't traverse uncompiled LazyCompileGroup
+    auto subgraph = Group::create();
+    subgraph->children = lcg->children;
+
+    auto result = compileManager->compile(subgraph);
+    if (!result)
+    {
+        warn("LazyCompiler::_compile(", lcg, ") compile failed, ", result.message);
+
+        lcg->requestStatus = LazyCompileGroup::NoRequest;
+        --numActiveRequests;
+        return;
+    }
+
+    lcg->requestStatus = LazyCompileGroup::MergeRequest;
+
+    std::scoped_lock<std::mutex> lock(_mergeMutex);
+    _toMerge.push_back(lcg);
+    _mergeResult.add(result);
+}
+
+void LazyCompiler::run()
+{
+    std::list<ref_ptr<LazyCompileGroup>> toMerge;
+    CompileResult mergeResult;
+    {
+        std::scoped_lock<std::mutex> lock(_mergeMutex);
+        toMerge.swap(_toMerge);
+        std::swap(mergeResult, _mergeResult);
+    }
+
+    if (toMerge.empty()) return;
+
+    // make sure the Viewer has the bins, view dependent state and dynamic data transfers required by the compiled subgraphs before they are recorded
+    if (mergeResult.requiresViewerUpdate())
+    {
+        // take a ref_ptr<> of the observer_ptr<> to be able to safely access it
+        ref_ptr<Viewer> viewer = _viewer;
+        if (viewer) updateViewer(*viewer, mergeResult);
+    }
+
+    for (auto& lcg : toMerge)
+    {
+        lcg->requestStatus = LazyCompileGroup::Compiled;
+        --numActiveRequests;
+        ++numCompiled;
+    }
+}
@@ -0,0 +1,537 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/MipmapGenerator.h>
+#include <vsg/io/Logger.h>
+#include <vsg/state/Buffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/DescriptorPool.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace vsg;
+
+namespace
+{
+    // format classes map to the storage image format qualifiers the shader is compiled with
+    enum FormatClass : uint32_t
+    {
+        FORMAT_RGBA8 = 0,
+        FORMAT_RG8,
+        FORMAT_R8,
+        FORMAT_RGBA16F,
+        FORMAT_RGBA32F,
+        FORMAT_COUNT
+    };
+
+    struct StorageFormat
+    {
+        VkFormat viewFormat = VK_FORMAT_UNDEFINED;
+        uint32_t formatClass = FORMAT_COUNT;
+        bool srgb = false;
+    };
+
+    StorageFormat storageFormat(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_R8G8B8A8_UNORM: return {VK_FORMAT_R8G8B8A8_UNORM, FORMAT_RGBA8, false};
+        case VK_FORMAT_R8G8B8A8_SRGB: return {VK_FORMAT_R8G8B8A8_UNORM, FORMAT_RGBA8, true};
+        case VK_FORMAT_R8G8_UNORM: return {VK_FORMAT_R8G8_UNORM, FORMAT_RG8, false};
+        case VK_FORMAT_R8_UNORM: return {VK_FORMAT_R8_UNORM, FORMAT_R8, false};
+        case VK_FORMAT_R16G16B16A16_SFLOAT: return {VK_FORMAT_R16G16B16A16_SFLOAT, FORMAT_RGBA16F, false};
+        case VK_FORMAT_R32G32B32A32_SFLOAT: return {VK_FORMAT_R32G32B32A32_SFLOAT, FORMAT_RGBA32F, false};
+        default: return {};
+        }
+    }
+
+    const char* s_formatDefines[FORMAT_COUNT] = {nullptr, "VSG_FORMAT_RG8", "VSG_FORMAT_R8", "VSG_FORMAT_RGBA16F", "VSG_FORMAT_RGBA32F"};
+
+    // base level is reduced in 64x64 tiles, 6 levels per pass
+    constexpr uint32_t s_tileSize = 64;
+    constexpr uint32_t s_levelsPerPass = 6;
+    constexpr uint32_t s_maxDimension = s_tileSize << s_levelsPerPass;
+
+    struct ImageParams
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipLevels;
+        uint32_t srgb;
+        uint32_t numTilesX;
+        uint32_t numTilesY;
+        uint32_t counter;
+        uint32_t padding;
+    };
+
+    const char* s_mipmapSource = R"(#version 450
+
+#pragma import_defines (VSG_FORMAT_RG8, VSG_FORMAT_R8, VSG_FORMAT_RGBA16F, VSG_FORMAT_RGBA32F)
+
+#if defined(VSG_FORMAT_RG8)
+#define IMAGE_FORMAT rg8
+#elif defined(VSG_FORMAT_R8)
+#define IMAGE_FORMAT r8
+#elif defined(VSG_FORMAT_RGBA16F)
+#define IMAGE_FORMAT rgba16f
+#elif defined(VSG_FORMAT_RGBA32F)
+#define IMAGE_FORMAT rgba32f
+#else
+#define IMAGE_FORMAT rgba8
+#endif
+
+#define MAX_MIP_LEVELS 13
+
+layout(local_size_x = 256) in;
+
+// number of level views, MAX_MIP_LEVELS per image
+layout(constant_id = 0) const uint numLevelViews = MAX_MIP_LEVELS;
+
+layout(set = 0, binding = 0, IMAGE_FORMAT) uniform coherent image2D levels[numLevelViews];
+
+struct ImageParams
+{
+    uvec2 extent;
+    uint mipLevels;
+    uint srgb;
+    uvec2 numTiles;
+    uint counter;
+    uint padding;
+};
+
+layout(set = 0, binding = 1) buffer Params { ImageParams images[]; };
+
+// 32x32 texels of the first level reduced by a tile, packed as half floats to fit within the minimum shared memory limit
+shared uvec2 s_texels[32 * 32];
+shared uint s_lastWorkgroup;
+
+vec4 toLinear(vec4 c)
+{
+    return vec4(mix(c.rgb / 12.92, pow((c.rgb + 0.055) / 1.055, vec3(2.4)), greaterThan(c.rgb, vec3(0.04045))), c.a);
+}
+
+vec4 toSRGB(vec4 c)
+{
+    return vec4(mix(c.rgb * 12.92, 1.055 * pow(c.rgb, vec3(1.0 / 2.4)) - 0.055, greaterThan(c.rgb, vec3(0.0031308))), c.a);
+}
+
+uvec2 packTexel(vec4 c) { return uvec2(packHalf2x16(c.xy), packHalf2x16(c.zw)); }
+vec4 unpackTexel(uvec2 p) { return vec4(unpackHalf2x16(p.x), unpackHalf2x16(p.y)); }
+
+ivec2 levelExtent(uvec2 extent, uint level) { return ivec2(max(extent >> level, uvec2(1))); }
+
+vec4 loadTexel(uint image, uint level, ivec2 coord, ivec2 extent, bool srgb)
+{
+    vec4 c = imageLoad(levels[image * MAX_MIP_LEVELS + level], min(coord, extent - 1));
+    return srgb ? toLinear(c) : c;
+}
+
+void storeTexel(uint image, uint level, ivec2 coord, ivec2 extent, bool srgb, vec4 c)
+{
+    if (all(lessThan(coord, extent))) imageStore(levels[image * MAX_MIP_LEVELS + level], coord, srgb ? toSRGB(c) : c);
+}
+
+// reduce a 64x64 tile of srcLevel to the levels up to endLevel, at most 6, the first read from the image and the rest from shared memory
+void reduceTile(uint image, uvec2 extent, uint srcLevel, uint endLevel, bool srgb, ivec2 tile)
+{
+    uint t = gl_LocalInvocationIndex;
+
+    uint level = srcLevel + 1;
+    ivec2 srcExtent = levelExtent(extent, srcLevel);
+    ivec2 dstExtent = levelExtent(extent, level);
+    for (uint i = 0; i < 4; ++i)
+    {
+        uint index = t + i * 256;
+        ivec2 coord = tile * 32 + ivec2(index % 32, index / 32);
+        ivec2 src = coord * 2;
+        vec4 c = 0.25 * (loadTexel(image, srcLevel, src, srcExtent, srgb) + loadTexel(image, srcLevel, src + ivec2(1, 0), srcExtent, srgb) +
+                         loadTexel(image, srcLevel, src + ivec2(0, 1), srcExtent, srgb) + loadTexel(image, srcLevel, src + ivec2(1, 1), srcExtent, srgb));
+        storeTexel(image, level, coord, dstExtent, srgb, c);
+        s_texels[index] = packTexel(c);
+    }
+
+    for (int size = 16; size >= 1 && (level + 1) < endLevel; size /= 2)
+    {
+        barrier();
+
+        ++level;
+        int previousSize = size * 2;
+        ivec2 previousExtent = dstExtent;
+        dstExtent = levelExtent(extent, level);
+
+        // clamp reads to the texels of the previous level that lie within its extent
+        ivec2 maxPrevious = clamp(previousExtent - 1 - tile * previousSize, ivec2(0), ivec2(previousSize - 1));
+
+        bool active = t < uint(size * size);
+        ivec2 local = ivec2(int(t) % size, int(t) / size);
+        vec4 c = vec4(0.0);
+        if (active)
+        {
+            ivec2 p0 = min(local * 2, maxPrevious);
+            ivec2 p1 = min(local * 2 + 1, maxPrevious);
+            c = 0.25 * (unpackTexel(s_texels[p0.y * previousSize + p0.x]) + unpackTexel(s_texels[p0.y * previousSize + p1.x]) +
+                        unpackTexel(s_texels[p1.y * previousSize + p0.x]) + unpackTexel(s_texels[p1.y * previousSize + p1.x]));
+            storeTexel(image, level, tile * size + local, dstExtent, srgb, c);
+        }
+
+        barrier();
+
+        if (active) s_texels[local.y * size + local.x] = packTexel(c);
+    }
+}
+
+void main()
+{
+    uint image = gl_WorkGroupID.z;
+    uvec2 extent = images[image].extent;
+    uvec2 numTiles = images[image].numTiles;
+
+    // the dispatch covers the largest image in the batch
+    if (any(greaterThanEqual(gl_WorkGroupID.xy, numTiles))) return;
+
+    uint mipLevels = images[image].mipLevels;
+    bool srgb = images[image].srgb != 0;
+
+    reduceTile(image, extent, 0, min(mipLevels, 7), srgb, ivec2(gl_WorkGroupID.xy));
+
+    if (mipLevels <= 7) return;
+
+    // make level 6 visible to the other workgroups, then the last workgroup to complete reduces it to the remaining levels
+    memoryBarrierImage();
+    barrier();
+
+    if (gl_LocalInvocationIndex == 0)
+    {
+        s_lastWorkgroup = (atomicAdd(images[image].counter, 1) == (numTiles.x * numTiles.y - 1)) ? 1 : 0;
+    }
+
+    barrier();
+
+    if (s_lastWorkgroup == 0) return;
+
+    memoryBarrierImage();
+
+    reduceTile(image, extent, 6, mipLevels, srgb, ivec2(0));
+}
+)";
+
+} // namespace
+
+MipmapGenerator::MipmapGenerator(Device* in_device) :
+    device(in_device)
+{
+}
+
+MipmapGenerator::~MipmapGenerator()
+{
+}
+
+bool MipmapGenerator::prepare(Image& image) const
+{
+    if (!device || image.vk(device->deviceID) != VK_NULL_HANDLE) return false;
+
+    const auto& data = image.data;
+    if (!data || data->properties.mipLevels > 1 || data->properties.blockWidth > 1 || data->properties.blockHeight > 1) return false;
+    if (image.imageType != VK_IMAGE_TYPE_2D || image.arrayLayers > 1 || image.extent.depth > 1) return false;
+    if (image.mipLevels <= 1 || image.mipLevels > maxMipLevels || image.extent.width > s_maxDimension || image.extent.height > s_maxDimension) return false;
+
+    auto format = storageFormat(image.format);
+    if (format.formatClass == FORMAT_COUNT) return false;
+
+    VkFormatProperties props;
+    vkGetPhysicalDeviceFormatProperties(*(device->getPhysicalDevice()), format.viewFormat, &props);
+    if ((props.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) == 0) return false;
+
+    if (format.srgb)
+    {
+        // sRGB formats don't support storage so the levels are written via UNORM views, which requires the extended usage of Vulkan 1.1
+        if (device->getInstance()->apiVersion < VK_API_VERSION_1_1) return false;
+        image.flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT;
+    }
+
+    image.usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    return true;
+}
+
+bool MipmapGenerator::supported(const ImageView& imageView, uint32_t mipLevels)
+{
+    const auto& image = imageView.image;
+    if (!image || imageView.viewType != VK_IMAGE_VIEW_TYPE_2D) return false;
+    if (mipLevels <= 1 || mipLevels > maxMipLevels || image->extent.width > s_maxDimension || image->extent.height > s_maxDimension) return false;
+    if ((image->usage & VK_IMAGE_USAGE_STORAGE_BIT) == 0 || image->arrayLayers > 1 || image->extent.depth > 1) return false;
+
+    auto format = storageFormat(image->format);
+    if (format.formatClass == FORMAT_COUNT) return false;
+    if (format.srgb && (image->flags & VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT) == 0) return false;
+
+    return _getPipeline(format.formatClass) != nullptr;
+}
+
+void MipmapGenerator::add(ref_ptr<ImageView> imageView, VkImageLayout targetImageLayout, uint32_t mipLevels)
+{
+    auto format = storageFormat(imageView->image->format);
+    _images.push_back(ImageToGenerate{imageView, targetImageLayout, mipLevels, format.formatClass, format.srgb});
+}
+
+ComputePipeline* MipmapGenerator::_getPipeline(uint32_t formatClass)
+{
+    if (!_context)
+    {
+        _context = Context::create(device);
+        _pipelines.resize(FORMAT_COUNT);
+        _pipelineFailed.resize(FORMAT_COUNT, false);
+
+        const auto& physicalDevice = *(device->getPhysicalDevice());
+        const auto& limits = physicalDevice.getProperties().limits;
+        uint32_t maxStorageImages = std::min(limits.maxPerStageDescriptorStorageImages, limits.maxDescriptorSetStorageImages);
+        _imagesPerDispatch = std::min(maxImagesPerDispatch, maxStorageImages / maxMipLevels);
+
+        if (!physicalDevice.getFeatures().shaderStorageImageArrayDynamicIndexing || !_context->getOrCreateShaderCompiler())
+        {
+            _imagesPerDispatch = 0;
+        }
+
+        if (_imagesPerDispatch == 0)
+        {
+            warn("MipmapGenerator::_getPipeline() compute mipmap generation not supported by device, falling back to blits.");
+        }
+        else
+        {
+            DescriptorSetLayoutBindings bindings{
+                {0, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, _imagesPerDispatch * maxMipLevels, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+                {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr}};
+
+            _descriptorSetLayout = DescriptorSetLayout::create(bindings);
+            _pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{_descriptorSetLayout}, PushConstantRanges{});
+        }
+    }
+
+    if (_imagesPerDispatch == 0 || formatClass >= FORMAT_COUNT || _pipelineFailed[formatClass]) return nullptr;
+
+    auto& pipeline = _pipelines[formatClass];
+    if (!pipeline)
+    {
+        auto shaderHints = ShaderCompileSettings::create();
+        if (s_formatDefines[formatClass]) shaderHints->defines.insert(s_formatDefines[formatClass]);
+
+        auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", s_mipmapSource, shaderHints);
+        computeShader->specializationConstants[0] = uintValue::create(_imagesPerDispatch * maxMipLevels);
+
+        try
+        {
+            pipeline = ComputePipeline::create(_pipelineLayout, computeShader);
+            pipeline->compile(*_context);
+        }
+        catch (const Exception& exception)
+        {
+            warn("MipmapGenerator::_getPipeline() unable to create compute pipeline, falling back to blits. ", exception.message);
+            pipeline = {};
+            _pipelineFailed[formatClass] = true;
+        }
+    }
+
+    return pipeline.get();
+}
+
+ref_ptr<Objects> MipmapGenerator::record(VkCommandBuffer commandBuffer, VkPipelineStageFlags dstStageMask)
+{
+    if (_images.empty()) return {};
+    if (_imagesPerDispatch == 0)
+    {
+        // images are only added once supported(..) has confirmed compute mipmap generation is available
+        _images.clear();
+        return {};
+    }
+
+    auto deviceID = device->deviceID;
+    auto resources = Objects::create();
+
+    // split the images into batches that share a format class, each batch is downsampled by a single dispatch.
+    std::stable_sort(_images.begin(), _images.end(), [](const ImageToGenerate& lhs, const ImageToGenerate& rhs) { return lhs.formatClass < rhs.formatClass; });
+
+    struct Batch
+    {
+        ComputePipeline* pipeline = nullptr;
+        size_t first = 0;
+        size_t count = 0;
+    };
+    std::vector<Batch> batches;
+
+    for (size_t i = 0; i < _images.size();)
+    {
+        Batch batch{_getPipeline(_images[i].formatClass), i, 0};
+        while (i < _images.size() && _images[i].formatClass == _images[batch.first].formatClass && batch.count < _imagesPerDispatch)
+        {
+            ++batch.count;
+            ++i;
+        }
+        batches.push_back(batch);
+    }
+
+    std::vector<VkImageMemoryBarrier> barriers;
+    auto imageBarrier = [&](const ImageToGenerate& entry, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask) {
+        VkImageMemoryBarrier barrier = {};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = srcAccessMask;
+        barrier.dstAccessMask = dstAccessMask;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = entry.imageView->image->vk(deviceID);
+        barrier.subresourceRange = {entry.imageView->subresourceRange.aspectMask, 0, entry.mipLevels, 0, 1};
+        barriers.push_back(barrier);
+    };
+
+    // per image parameters, written by the host and the atomic counters reset, ahead of submission
+    VkDeviceSize alignment = std::max(device->getPhysicalDevice()->getProperties().limits.minStorageBufferOffsetAlignment, VkDeviceSize(4));
+    VkDeviceSize paramsSize = ((sizeof(ImageParams) * _imagesPerDispatch + alignment - 1) / alignment) * alignment;
+    auto paramsBuffer = createBufferAndMemory(device, paramsSize * batches.size(), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    resources->addChild(paramsBuffer);
+
+    void* params_data = nullptr;
+    auto paramsMemory = paramsBuffer->getDeviceMemory(deviceID);
+    if (paramsMemory->map(paramsBuffer->getMemoryOffset(deviceID), paramsBuffer->size, 0, &params_data) != VK_SUCCESS)
+    {
+        warn("MipmapGenerator::record() unable to map parameter buffer, images will not have mipmaps generated.");
+
+        for (auto& entry : _images)
+        {
+            imageBarrier(entry, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, entry.targetImageLayout, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+        }
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStageMask, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+        _images.clear();
+        return resources;
+    }
+
+    uint32_t numBatches = static_cast<uint32_t>(batches.size());
+    auto descriptorPool = DescriptorPool::create(device, numBatches, DescriptorPoolSizes{{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, numBatches * _imagesPerDispatch * maxMipLevels}, {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, numBatches}});
+    resources->addChild(descriptorPool);
+
+    // a single barrier transitions all the levels of all the images for the compute shader
+    for (auto& batch : batches)
+    {
+        for (size_t i = batch.first; i < batch.first + batch.count; ++i)
+        {
+            imageBarrier(_images[i], VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+        }
+    }
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+    barriers.clear();
+
+    auto vk_pipelineLayout = _pipelineLayout->vk(deviceID);
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+
+    std::vector<VkDescriptorImageInfo> imageInfos(_imagesPerDispatch * maxMipLevels);
+    for (uint32_t b = 0; b < numBatches; ++b)
+    {
+        auto& batch = batches[b];
+
+        auto params = reinterpret_cast<ImageParams*>(static_cast<uint8_t*>(params_data) + paramsSize * b);
+        std::memset(params, 0, paramsSize);
+
+        uint32_t maxTilesX = 1, maxTilesY = 1;
+        for (size_t i = 0; i < batch.count; ++i)
+        {
+            auto& entry = _images[batch.first + i];
+            auto& image = *entry.imageView->image;
+
+            auto& param = params[i];
+            param.width = image.extent.width;
+            param.height = image.extent.height;
+            param.mipLevels = entry.mipLevels;
+            param.srgb = entry.srgb ? 1 : 0;
+            param.numTilesX = (image.extent.width + s_tileSize - 1) / s_tileSize;
+            param.numTilesY = (image.extent.height + s_tileSize - 1) / s_tileSize;
+            param.counter = 0;
+
+            maxTilesX = std::max(maxTilesX, param.numTilesX);
+            maxTilesY = std::max(maxTilesY, param.numTilesY);
+
+            // a storage view per level, levels beyond the image's mipLevels are never written so reuse the last level's view
+            auto format = storageFormat(image.format);
+            for (uint32_t level = 0; level < maxMipLevels; ++level)
+            {
+                auto& imageInfo = imageInfos[i * maxMipLevels + level];
+                if (level < entry.mipLevels)
+                {
+                    auto levelView = ImageView::create(entry.imageView->image);
+                    levelView->viewType = VK_IMAGE_VIEW_TYPE_2D;
+                    levelView->format = format.viewFormat;
+                    levelView->subresourceRange = {entry.imageView->subresourceRange.aspectMask, level, 1, 0, 1};
+                    levelView->compile(device);
+                    resources->addChild(levelView);
+
+                    imageInfo = VkDescriptorImageInfo{VK_NULL_HANDLE, levelView->vk(deviceID), VK_IMAGE_LAYOUT_GENERAL};
+                }
+                else
+                {
+                    imageInfo = imageInfos[i * maxMipLevels + entry.mipLevels - 1];
+                }
+            }
+        }
+
+        // unused slots of the batch must still reference valid views, they're never accessed as the dispatch only covers the batch's images
+        for (size_t slot = batch.count * maxMipLevels; slot < imageInfos.size(); ++slot)
+        {
+            imageInfos[slot] = imageInfos[slot % maxMipLevels];
+        }
+
+        auto dsi = descriptorPool->allocateDescriptorSet(_descriptorSetLayout);
+        resources->addChild(dsi);
+
+        VkDescriptorBufferInfo bufferInfo{paramsBuffer->vk(deviceID), paramsSize * b, paramsSize};
+
+        VkWriteDescriptorSet writes[2] = {};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = dsi->_descriptorSet;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = static_cast<uint32_t>(imageInfos.size());
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[0].pImageInfo = imageInfos.data();
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = dsi->_descriptorSet;
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[1].pBufferInfo = &bufferInfo;
+        vkUpdateDescriptorSets(*device, 2, writes, 0, nullptr);
+
+        auto vk_pipeline = batch.pipeline->vk(deviceID);
+        if (vk_pipeline != boundPipeline)
+        {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vk_pipeline);
+            boundPipeline = vk_pipeline;
+        }
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vk_pipelineLayout, 0, 1, &(dsi->_descriptorSet), 0, nullptr);
+        vkCmdDispatch(commandBuffer, maxTilesX, maxTilesY, static_cast<uint32_t>(batch.count));
+    }
+
+    paramsMemory->unmap();
+
+    // a single barrier transitions all the images to their target layouts
+    for (auto& batch : batches)
+    {
+        for (size_t i = batch.first; i < batch.first + batch.count; ++i)
+        {
+            imageBarrier(_images[i], VK_IMAGE_LAYOUT_GENERAL, _images[i].targetImageLayout, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT);
+        }
+    }
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStageMask, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+
+    _images.clear();
+
+    return resources;
+}
@@ -0,0 +1,268 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/OcclusionBuffer.h>
+#include <vsg/io/Logger.h>
+#include <vsg/maths/transform.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace vsg;
+
+namespace
+{
+    constexpr double epsilon = 1e-6;
+
+    // returns true if the normalized device z coordinate lies in front of the near plane
+    inline bool inFrontOfNear(double ndcZ, double depthSign)
+    {
+        return (depthSign < 0.0) ? (ndcZ <= 1.0) : (ndcZ >= 0.0);
+    }
+} // namespace
+
+OcclusionBuffer::OcclusionBuffer(uint32_t in_width, uint32_t in_height) :
+    width(std::max(in_width, 1u)),
+    height(std::max(in_height, 1u))
+{
+    uint32_t w = width;
+    uint32_t h = height;
+    for (;;)
+    {
+        auto& level = _levels.emplace_back();
+        level.width = w;
+        level.height = h;
+        level.depths.resize(static_cast<size_t>(w) * h, std::numeric_limits<float>::max());
+
+        if (w == 1 && h == 1) break;
+
+        w = std::max((w + 1) / 2, 1u);
+        h = std::max((h + 1) / 2, 1u);
+    }
+}
+
+OcclusionBuffer::~OcclusionBuffer()
+{
+}
+
+void OcclusionBuffer::begin(const dmat4& projection, const dmat4& view)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    _projection = projection;
+    _inverseViewMatrix = inverse(view);
+
+    // reverse depth projections map nearer points to larger depth values
+    auto ndcZ = [&](double z) {
+        auto clip = projection * dvec4(0.0, 0.0, z, 1.0);
+        return clip.z / clip.w;
+    };
+    _depthSign = (ndcZ(-2.0) < ndcZ(-1.0)) ? -1.0 : 1.0;
+
+    _previousOccluders.swap(_occluders);
+    _occluders.clear();
+
+    clear();
+
+    auto viewProjection = projection * view;
+    for (auto& [occluder, matrix] : _previousOccluders)
+    {
+        rasterize(viewProjection * matrix, *occluder->vertices, *occluder->indices);
+    }
+
+    buildPyramid();
+}
+
+void OcclusionBuffer::add(const Occluder& occluder, const dmat4& modelview)
+{
+    if (!occluder.vertices || !occluder.indices) return;
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _occluders.emplace_back(ref_ptr<const Occluder>(&occluder), _inverseViewMatrix * modelview);
+}
+
+void OcclusionBuffer::clear()
+{
+    for (auto& level : _levels)
+    {
+        std::fill(level.depths.begin(), level.depths.end(), std::numeric_limits<float>::max());
+    }
+    numTrianglesRasterized = 0;
+}
+
+void OcclusionBuffer::rasterize(const dmat4& mvp, const vec3Array& vertices, const Data& indices)
+{
+    // transform vertices into screen coordinates, with depth increasing away from the eye
+    std::vector<dvec3> screen(vertices.size());
+    std::vector<uint8_t> valid(vertices.size(), 0);
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        const auto& v = vertices[i];
+        auto clip = mvp * dvec4(v.x, v.y, v.z, 1.0);
+        if (clip.w <= epsilon) continue;
+
+        double ndcZ = clip.z / clip.w;
+        if (!inFrontOfNear(ndcZ, _depthSign)) continue;
+
+        screen[i].set((clip.x / clip.w * 0.5 + 0.5) * width, (clip.y / clip.w * 0.5 + 0.5) * height, _depthSign * ndcZ);
+        valid[i] = 1;
+    }
+
+    auto rasterizeTriangles = [&](const auto& array) {
+        for (size_t i = 0; i + 2 < array.size(); i += 3)
+        {
+            size_t i0 = array[i], i1 = array[i + 1], i2 = array[i + 2];
+            if (i0 >= valid.size() || i1 >= valid.size() || i2 >= valid.size()) continue;
+
+            // skip triangles crossing the near plane rather than clipping them, this only ever loses occlusion
+            if (valid[i0] && valid[i1] && valid[i2]) _rasterizeTriangle(screen[i0], screen[i1], screen[i2]);
+        }
+    };
+
+    if (auto us = indices.cast<ushortArray>())
+        rasterizeTriangles(*us);
+    else if (auto ui = indices.cast<uintArray>())
+        rasterizeTriangles(*ui);
+    else
+        warn("OcclusionBuffer::rasterize() unsupported indices type ", indices.className());
+}
+
+void OcclusionBuffer::_rasterizeTriangle(const dvec3& v0, const dvec3& in_v1, const dvec3& in_v2)
+{
+    // occluders are two sided so reorder to a consistent winding
+    double area = (in_v1.x - v0.x) * (in_v2.y - v0.y) - (in_v1.y - v0.y) * (in_v2.x - v0.x);
+    if (std::abs(area) < epsilon) return;
+
+    const dvec3& v1 = (area > 0.0) ? in_v1 : in_v2;
+    const dvec3& v2 = (area > 0.0) ? in_v2 : in_v1;
+    area = std::abs(area);
+
+    auto& level = _levels.front();
+    double minX = std::max(std::floor(std::min({v0.x, v1.x, v2.x})), 0.0);
+    double maxX = std::min(std::floor(std::max({v0.x, v1.x, v2.x})), static_cast<double>(level.width - 1));
+    double minY = std::max(std::floor(std::min({v0.y, v1.y, v2.y})), 0.0);
+    double maxY = std::min(std::floor(std::max({v0.y, v1.y, v2.y})), static_cast<double>(level.height - 1));
+    if (minX > maxX || minY > maxY) return;
+
+    auto edge = [](const dvec3& a, const dvec3& b, double px, double py) {
+        return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+    };
+
+    // sample at pixel centers, keeping the nearest occluder depth for each pixel
+    for (auto y = static_cast<uint32_t>(minY); y <= static_cast<uint32_t>(maxY); ++y)
+    {
+        double py = static_cast<double>(y) + 0.5;
+        float* row = level.depths.data() + static_cast<size_t>(y) * level.width;
+        for (auto x = static_cast<uint32_t>(minX); x <= static_cast<uint32_t>(maxX); ++x)
+        {
+            double px = static_cast<double>(x) + 0.5;
+            double w0 = edge(v1, v2, px, py);
+            double w1 = edge(v2, v0, px, py);
+            double w2 = edge(v0, v1, px, py);
+            if (w0 < 0.0 || w1 < 0.0 || w2 < 0.0) continue;
+
+            auto depth = static_cast<float>((w0 * v0.z + w1 * v1.z + w2 * v2.z) / area);
+            if (depth < row[x]) row[x] = depth;
+        }
+    }
+
+    ++numTrianglesRasterized;
+}
+
+void OcclusionBuffer::buildPyramid()
+{
+    // each texel holds the furthest depth of the four texels below it so a single texel conservatively covers its footprint
+    for (size_t l = 1; l < _levels.size(); ++l)
+    {
+        const auto& src = _levels[l - 1];
+        auto& dest = _levels[l];
+        for (uint32_t y = 0; y < dest.height; ++y)
+        {
+            uint32_t y0 = y * 2;
+            uint32_t y1 = std::min(y0 + 1, src.height - 1);
+            for (uint32_t x = 0; x < dest.width; ++x)
+            {
+                uint32_t x0 = x * 2;
+                uint32_t x1 = std::min(x0 + 1, src.width - 1);
+                dest.depths[static_cast<size_t>(y) * dest.width + x] = std::max({src.depths[static_cast<size_t>(y0) * src.width + x0],
+                                                                                 src.depths[static_cast<size_t>(y0) * src.width + x1],
+                                                                                 src.depths[static_cast<size_t>(y1) * src.width + x0],
+                                                                                 src.depths[static_cast<size_t>(y1) * src.width + x1]});
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::occluded(const dsphere& bound, const dmat4& modelview) const
+{
+    if (numTrianglesRasterized == 0 || !bound.valid()) return false;
+
+    auto center = modelview * dvec4(bound.center.x, bound.center.y, bound.center.z, 1.0);
+    double scale = std::max({length(dvec3(modelview[0][0], modelview[0][1], modelview[0][2])),
+                             length(dvec3(modelview[1][0], modelview[1][1], modelview[1][2])),
+                             length(dvec3(modelview[2][0], modelview[2][1], modelview[2][2]))});
+    double radius = bound.radius * scale;
+
+    // depth of the point on the sphere nearest the eye, bounds that reach the near plane are never occluded
+    auto clipNearest = _projection * dvec4(center.x, center.y, center.z + radius, 1.0);
+    if (clipNearest.w <= epsilon) return false;
+
+    double ndcZ = clipNearest.z / clipNearest.w;
+    if (!inFrontOfNear(ndcZ, _depthSign)) return false;
+    auto depth = static_cast<float>(_depthSign * ndcZ);
+
+    // screen space extents of the eye space bounding box of the sphere
+    double minX = std::numeric_limits<double>::max(), maxX = std::numeric_limits<double>::lowest();
+    double minY = minX, maxY = maxX;
+    for (int i = 0; i < 8; ++i)
+    {
+        dvec4 corner(center.x + ((i & 1) ? radius : -radius), center.y + ((i & 2) ? radius : -radius), center.z + ((i & 4) ? radius : -radius), 1.0);
+        auto clip = _projection * corner;
+        if (clip.w <= epsilon) return false;
+
+        double x = (clip.x / clip.w * 0.5 + 0.5) * width;
+        double y = (clip.y / clip.w * 0.5 + 0.5) * height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+
+    if (maxX < 0.0 || maxY < 0.0 || minX >= static_cast<double>(width) || minY >= static_cast<double>(height)) return false;
+
+    auto x0 = static_cast<uint32_t>(std::max(std::floor(minX), 0.0));
+    auto y0 = static_cast<uint32_t>(std::max(std::floor(minY), 0.0));
+    auto x1 = static_cast<uint32_t>(std::min(std::floor(maxX), static_cast<double>(width - 1)));
+    auto y1 = static_cast<uint32_t>(std::min(std::floor(maxY), static_cast<double>(height - 1)));
+
+    // pick the pyramid level where the extents span at most a few texels
+    size_t l = 0;
+    uint32_t extent = std::max(x1 - x0, y1 - y0);
+    while (extent > 1 && (l + 1) < _levels.size())
+    {
+        extent >>= 1;
+        ++l;
+    }
+
+    const auto& level = _levels[l];
+    for (uint32_t y = (y0 >> l); y <= (y1 >> l); ++y)
+    {
+        for (uint32_t x = (x0 >> l); x <= (x1 >> l); ++x)
+        {
+            if (level.depths[static_cast<size_t>(y) * level.width + x] >= depth) return false;
+        }
+    }
+
+    return true;
+}
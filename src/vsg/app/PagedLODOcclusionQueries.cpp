@@ -0,0 +1,230 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/PagedLODOcclusionQueries.h>
+#include <vsg/io/Logger.h>
+#include <vsg/maths/transform.h>
+#include <vsg/state/ColorBlendState.h>
+#include <vsg/state/DepthStencilState.h>
+#include <vsg/state/InputAssemblyState.h>
+#include <vsg/state/MultisampleState.h>
+#include <vsg/state/RasterizationState.h>
+#include <vsg/state/VertexInputState.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/RenderPass.h>
+
+#include <algorithm>
+
+using namespace vsg;
+
+namespace
+{
+    // the box enclosing the unit sphere, drawn as 12 triangles generated from gl_VertexIndex
+    const char* s_boxVertexSource = R"(#version 450
+layout(push_constant) uniform PushConstants { mat4 mvp; } pc;
+const int corners[36] = int[36](0, 1, 2, 2, 1, 3, 4, 6, 5, 5, 6, 7, 0, 4, 1, 1, 4, 5, 2, 3, 6, 6, 3, 7, 0, 2, 4, 4, 2, 6, 1, 5, 3, 3, 5, 7);
+out gl_PerVertex { vec4 gl_Position; };
+void main()
+{
+    int c = corners[gl_VertexIndex];
+    vec3 corner = vec3((c & 1) != 0 ? 1.0 : -1.0, (c & 2) != 0 ? 1.0 : -1.0, (c & 4) != 0 ? 1.0 : -1.0);
+    gl_Position = pc.mvp * vec4(corner, 1.0);
+}
+)";
+
+    const char* s_boxFragmentSource = R"(#version 450
+void main()
+{
+}
+)";
+} // namespace
+
+PagedLODOcclusionQueries::PagedLODOcclusionQueries(uint32_t in_maxQueriesPerFrame, uint32_t in_numFrames) :
+    maxQueriesPerFrame(in_maxQueriesPerFrame),
+    numFrames(std::max(in_numFrames, 2u))
+{
+}
+
+PagedLODOcclusionQueries::~PagedLODOcclusionQueries()
+{
+}
+
+void PagedLODOcclusionQueries::compile(Context& context)
+{
+    if (_pipeline) return;
+
+    if (!context.device->getExtensions()->vkResetQueryPool)
+    {
+        warn("PagedLODOcclusionQueries::compile() vkResetQueryPool not supported, enable the hostQueryReset device feature, PagedLOD occlusion queries disabled.");
+        return;
+    }
+
+    auto pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{}, PushConstantRanges{{VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(mat4)}});
+    ShaderStages shaderStages{
+        ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, "main", s_boxVertexSource),
+        ShaderStage::create(VK_SHADER_STAGE_FRAGMENT_BIT, "main", s_boxFragmentSource)};
+
+    auto rasterizationState = RasterizationState::create();
+    rasterizationState->cullMode = VK_CULL_MODE_NONE; // back faces still pass when the near plane clips the front faces
+
+    auto depthStencilState = DepthStencilState::create();
+    depthStencilState->depthWriteEnable = VK_FALSE;
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
+    colorBlendAttachment.colorWriteMask = 0;
+    auto colorBlendState = ColorBlendState::create(ColorBlendState::ColorBlendAttachments{colorBlendAttachment});
+
+    auto samples = context.renderPass ? context.renderPass->maxSamples : VK_SAMPLE_COUNT_1_BIT;
+
+    GraphicsPipelineStates pipelineStates{
+        VertexInputState::create(),
+        InputAssemblyState::create(),
+        rasterizationState,
+        MultisampleState::create(samples),
+        colorBlendState,
+        depthStencilState};
+
+    try
+    {
+        _pipeline = GraphicsPipeline::create(pipelineLayout, shaderStages, pipelineStates);
+        _bindPipeline = BindGraphicsPipeline::create(_pipeline);
+        _bindPipeline->compile(context);
+
+        _slots.resize(numFrames);
+        for (auto& slot : _slots)
+        {
+            slot.queryPool = QueryPool::create();
+            slot.queryPool->queryType = VK_QUERY_TYPE_OCCLUSION;
+            slot.queryPool->queryCount = maxQueriesPerFrame;
+            slot.queryPool->compile(context);
+            slot.queryPool->reset();
+        }
+    }
+    catch (const Exception& exception)
+    {
+        warn("PagedLODOcclusionQueries::compile() unable to create occlusion query pipeline, PagedLOD occlusion queries disabled. ", exception.message);
+        _pipeline = {};
+        _bindPipeline = {};
+        _slots.clear();
+    }
+}
+
+void PagedLODOcclusionQueries::begin(uint64_t frameCount)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    _frameCount = frameCount;
+    _currentSlot = nullptr;
+    numQueriesRecorded = 0;
+    numRequestsSuppressed = 0;
+
+    // collect the results of completed queries, without waiting on those still in flight
+    for (auto& slot : _slots)
+    {
+        if (!slot.submitted) continue;
+
+        _samples.resize(slot.queries.size());
+        if (slot.queryPool->getResults(_samples, 0, 0) == VK_SUCCESS)
+        {
+            for (size_t i = 0; i < slot.queries.size(); ++i)
+            {
+                _results[slot.queries[i].plod.get()] = Result{_samples[i] == 0, frameCount};
+            }
+        }
+        else if ((frameCount - slot.frameCount) <= resultLifetime)
+        {
+            continue;
+        }
+        // else the command buffer the queries were recorded to was never submitted so discard them
+
+        slot.queries.clear();
+        slot.submitted = false;
+        slot.queryPool->reset();
+    }
+
+    // discard stale results, including those of PagedLOD that may have been deleted
+    for (auto itr = _results.begin(); itr != _results.end();)
+    {
+        if ((frameCount - itr->second.frameCount) > resultLifetime)
+            itr = _results.erase(itr);
+        else
+            ++itr;
+    }
+
+    // use the first free slot for this frame's queries, if all are still in flight no queries are issued
+    for (auto& slot : _slots)
+    {
+        if (!slot.submitted)
+        {
+            slot.queries.clear();
+            _currentSlot = &slot;
+            break;
+        }
+    }
+}
+
+bool PagedLODOcclusionQueries::suppressRequest(const PagedLOD& plod, const dmat4& projection, const dmat4& modelview)
+{
+    if (!_pipeline) return false;
+
+    const auto& sphere = plod.bound;
+
+    // the box can't be tested when the eye is within it
+    double boxRadius = sphere.radius * 1.7320508075688772 * 1.01;
+    if (length(modelview * sphere.center) < boxRadius) return false;
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    bool queued = false;
+    if (_currentSlot && _currentSlot->queries.size() < maxQueriesPerFrame)
+    {
+        dmat4 mvp = projection * modelview * translate(sphere.center) * scale(sphere.radius);
+        _currentSlot->queries.push_back(Query{ref_ptr<const PagedLOD>(&plod), mat4(mvp)});
+        queued = true;
+    }
+
+    bool suppress = false;
+    if (auto itr = _results.find(&plod); itr != _results.end())
+        suppress = itr->second.occluded;
+    else
+        suppress = queued && waitForFirstResult;
+
+    if (suppress) ++numRequestsSuppressed;
+    return suppress;
+}
+
+void PagedLODOcclusionQueries::record(CommandBuffer& commandBuffer)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    if (!_currentSlot || _currentSlot->queries.empty()) return;
+
+    auto& slot = *_currentSlot;
+    _currentSlot = nullptr;
+
+    _bindPipeline->record(commandBuffer);
+
+    VkPipelineLayout pipelineLayout = _pipeline->layout->vk(commandBuffer.deviceID);
+    VkQueryPool queryPool = slot.queryPool->vk();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(slot.queries.size()); ++i)
+    {
+        vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(mat4), slot.queries[i].mvp.data());
+        vkCmdBeginQuery(commandBuffer, queryPool, i, 0);
+        vkCmdDraw(commandBuffer, 36, 1, 0, 0);
+        vkCmdEndQuery(commandBuffer, queryPool, i);
+    }
+
+    slot.submitted = true;
+    slot.frameCount = _frameCount;
+    numQueriesRecorded = static_cast<uint32_t>(slot.queries.size());
+}
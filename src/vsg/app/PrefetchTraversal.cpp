@@ -0,0 +1,309 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/PrefetchTraversal.h>
+#include <vsg/app/RecordTraversal.h>
+#include <vsg/app/View.h>
+#include <vsg/io/DatabasePager.h>
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/LOD.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/RegionOfInterest.h>
+#include <vsg/nodes/Transform.h>
+#include <vsg/threading/atomics.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vsg;
+
+PrefetchTraversal::PrefetchTraversal()
+{
+}
+
+PrefetchTraversal::~PrefetchTraversal()
+{
+}
+
+void PrefetchTraversal::reset()
+{
+    _previousValid = false;
+    predictedViewMatrices.clear();
+}
+
+void PrefetchTraversal::_predictViewMatrices(const dmat4& viewMatrix, const FrameStamp& frameStamp)
+{
+    if (!_previousValid || numPredictionSteps == 0 || predictionTime <= 0.0) return;
+
+    double dt = std::chrono::duration<double, std::chrono::seconds::period>(frameStamp.time - _previousTime).count();
+    if (dt <= 0.0) return;
+
+    // the camera moved by inverse(step) over the last frame, so continuing at the same rate the view matrix n frames ahead is step^n * viewMatrix
+    dmat4 step = viewMatrix * inverse(_previousViewMatrix);
+
+    double translation = length(dvec3(step[3][0], step[3][1], step[3][2]));
+    double cosAngle = std::clamp((step[0][0] + step[1][1] + step[2][2] - 1.0) * 0.5, -1.0, 1.0);
+    double rotation = std::acos(cosAngle);
+    if (translation < minimumMotion && rotation < minimumMotion) return;
+
+    // cap the number of frames extrapolated so a stalled frame rate doesn't result in a runaway prediction
+    const double maxFramesAhead = 1024.0;
+    double framesAhead = std::min(predictionTime / dt, maxFramesAhead);
+
+    uint32_t power = 0;
+    dmat4 stepPower;
+    for (uint32_t i = 1; i <= numPredictionSteps; ++i)
+    {
+        auto n = std::max(1u, static_cast<uint32_t>(std::round(framesAhead * static_cast<double>(i) / static_cast<double>(numPredictionSteps))));
+        if (n <= power) continue;
+
+        for (; power < n; ++power) stepPower = step * stepPower;
+
+        predictedViewMatrices.push_back(stepPower * viewMatrix);
+    }
+}
+
+void PrefetchTraversal::prefetch(const View& view, RecordTraversal& recordTraversal)
+{
+    numRequests = 0;
+    predictedViewMatrices.clear();
+
+    auto frameStamp = recordTraversal.getFrameStamp();
+    if (!view.camera || !frameStamp) return;
+
+    auto viewMatrix = view.camera->viewMatrix->transform();
+
+    if (viewMatrixHints.empty())
+        _predictViewMatrices(viewMatrix, *frameStamp);
+    else
+        predictedViewMatrices = viewMatrixHints;
+
+    _previousViewMatrix = viewMatrix;
+    _previousTime = frameStamp->time;
+    _previousValid = true;
+
+    if (predictedViewMatrices.empty() || !_begin(view, recordTraversal)) return;
+
+    _requestPriorityScale = priorityScale;
+
+    for (const auto& predictedViewMatrix : predictedViewMatrices)
+    {
+        _modelviewMatrixStack.push(predictedViewMatrix);
+        _frustumStack.push(Frustum(_frustumProjected, predictedViewMatrix));
+        _frustumStack.top().computeLodScale(_projectionMatrix, predictedViewMatrix);
+
+        view.traverse(*this);
+
+        _frustumStack.pop();
+        _modelviewMatrixStack.pop();
+    }
+
+    _databasePager = nullptr;
+    _culledPagedLODs = nullptr;
+}
+
+bool PrefetchTraversal::_begin(const View& view, RecordTraversal& recordTraversal)
+{
+    auto frameStamp = recordTraversal.getFrameStamp();
+    _databasePager = recordTraversal.getDatabasePager();
+    if (!view.camera || !frameStamp || !_databasePager) return false;
+
+    _culledPagedLODs = recordTraversal.culledPagedLODs;
+    _frameCount = frameStamp->frameCount;
+
+    // match the RecordTraversal, which only applies the View::LODScale when a ViewDependentState is assigned.
+    _LODScale = view.viewDependentState ? view.LODScale : 1.0;
+
+    auto viewportHeight = static_cast<double>(view.camera->getViewport().height);
+    _screenSpaceErrorScale = (viewportHeight > 0.0 && view.maximumScreenSpaceError > 0.0) ? viewportHeight / view.maximumScreenSpaceError : 0.0;
+
+    traversalMask = recordTraversal.traversalMask;
+    overrideMask = recordTraversal.overrideMask;
+
+    _projectionMatrix = view.camera->projectionMatrix->transform();
+    _frustumProjected.set(Frustum(), _projectionMatrix);
+
+    return true;
+}
+
+void PrefetchTraversal::focus(const View& view, RecordTraversal& recordTraversal)
+{
+    numFocusRequests = 0;
+
+    if (!_begin(view, recordTraversal)) return;
+
+    // the lod distance of a sphere at the center of the screen at depth d is d * 2 / f
+    _focusLodScale = 2.0 / std::abs(_projectionMatrix[1][1]);
+
+    auto viewMatrix = view.camera->viewMatrix->transform();
+
+    for (const auto& [mv, regionOfInterest] : recordTraversal.regionsOfInterest)
+    {
+        if (regionOfInterest->focusRadius <= 0.0 || regionOfInterest->points.empty()) continue;
+
+        // bounding sphere of the region's points in eye coordinates
+        dvec3 center;
+        for (const auto& point : regionOfInterest->points) center += mv * point;
+        center /= static_cast<double>(regionOfInterest->points.size());
+
+        double radius = 0.0;
+        for (const auto& point : regionOfInterest->points) radius = std::max(radius, length(mv * point - center));
+
+        _focusRadius = radius + regionOfInterest->focusRadius;
+        _focusMemory = 0;
+        _focusMemoryBudget = regionOfInterest->focusMemoryBudget;
+        _requestPriorityScale = regionOfInterest->focusPriorityScale;
+
+        // the camera's orientation with the origin moved to the region's center
+        auto focusViewMatrix = translate(-center) * viewMatrix;
+        _modelviewMatrixStack.push(focusViewMatrix);
+        _frustumStack.push(Frustum(_frustumProjected, focusViewMatrix));
+
+        view.traverse(*this);
+
+        _frustumStack.pop();
+        _modelviewMatrixStack.pop();
+    }
+
+    _focusRadius = 0.0;
+    _databasePager = nullptr;
+    _culledPagedLODs = nullptr;
+}
+
+void PrefetchTraversal::apply(const Node& node)
+{
+    node.traverse(*this);
+}
+
+void PrefetchTraversal::apply(const CullGroup& cullGroup)
+{
+    if (_intersect(cullGroup.bound)) cullGroup.traverse(*this);
+}
+
+void PrefetchTraversal::apply(const CullNode& cullNode)
+{
+    if (_intersect(cullNode.bound)) cullNode.traverse(*this);
+}
+
+void PrefetchTraversal::apply(const LOD& lod)
+{
+    const auto& sphere = lod.bound;
+    auto lodDistance = _lodDistance(sphere);
+    if (lodDistance < 0.0) return;
+
+    lodDistance *= _LODScale;
+
+    bool screenSpaceError = _screenSpaceErrorScale > 0.0 && !lod.children.empty() && lod.children.back().geometricError > 0.0;
+
+    for (size_t i = 0; i < lod.children.size(); ++i)
+    {
+        const auto& child = lod.children[i];
+
+        bool child_visible;
+        if (screenSpaceError && (i + 1) < lod.children.size())
+            child_visible = lod.children[i + 1].geometricError * _screenSpaceErrorScale > lodDistance;
+        else
+            child_visible = sphere.r > lodDistance * child.minimumScreenHeightRatio;
+
+        if (child_visible)
+        {
+            if (child.node) child.node->accept(*this);
+            return;
+        }
+    }
+}
+
+void PrefetchTraversal::apply(const PagedLOD& plod)
+{
+    const auto& sphere = plod.bound;
+    auto lodDistance = _lodDistance(sphere);
+    if (lodDistance < 0.0) return;
+
+    lodDistance *= _LODScale;
+
+    // check the high res child to see if it will be visible
+    {
+        const auto& child = plod.children[0];
+
+        double size = sphere.r;
+        double cutoff = lodDistance * child.minimumScreenHeightRatio;
+        if (_screenSpaceErrorScale > 0.0 && plod.children[1].geometricError > 0.0)
+        {
+            size = plod.children[1].geometricError * _screenSpaceErrorScale;
+            cutoff = lodDistance;
+        }
+
+        // once a focus area's memory budget is used up only the high res children already loaded are kept alive
+        bool overBudget = _focusMemoryBudget > 0 && _focusMemory >= _focusMemoryBudget;
+
+        if (size > cutoff && (child.node || !overBudget))
+        {
+            // mark the high res child as used so that it isn't expired, or the request made for it cancelled, while it remains on the predicted path
+            auto previousHighResUsed = plod.frameHighResLastUsed.exchange(_frameCount);
+            if (_culledPagedLODs && ((_frameCount - previousHighResUsed) > 1))
+            {
+                _culledPagedLODs->newHighresRequired.emplace_back(&plod);
+            }
+
+            if (child.node)
+            {
+                if (_focusRadius > 0.0) _focusMemory += plod.highResGPUMemory;
+                child.node->accept(*this);
+                return;
+            }
+
+            auto priority = (size / cutoff) * _requestPriorityScale;
+            if (previousHighResUsed != _frameCount)
+                plod.priority.exchange(priority);
+            else
+                exchange_if_greater(plod.priority, priority);
+
+            if (plod.requestCount.fetch_add(1) == 0)
+            {
+                _databasePager->request(ref_ptr<PagedLOD>(const_cast<PagedLOD*>(&plod)));
+                if (_focusRadius > 0.0)
+                    ++numFocusRequests;
+                else
+                    ++numRequests;
+            }
+        }
+    }
+
+    // check the low res child to see if it will be visible
+    {
+        const auto& child = plod.children[1];
+        if (child.node && sphere.r > lodDistance * child.minimumScreenHeightRatio)
+        {
+            child.node->accept(*this);
+        }
+    }
+}
+
+void PrefetchTraversal::apply(const Transform& transform)
+{
+    // subgraphs without culling nodes have no PagedLOD to prefetch
+    if (!transform.subgraphRequiresLocalFrustum) return;
+
+    _modelviewMatrixStack.push(transform.transform(_modelviewMatrixStack.top()));
+
+    const auto& mv = _modelviewMatrixStack.top();
+    _frustumStack.push(Frustum(_frustumProjected, mv));
+    _frustumStack.top().computeLodScale(_projectionMatrix, mv);
+
+    transform.traverse(*this);
+
+    _frustumStack.pop();
+    _modelviewMatrixStack.pop();
+}
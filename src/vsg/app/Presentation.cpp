@@ -13,30 +13,70 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/Presentation.h>
 #include <vsg/io/Logger.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 VkResult Presentation::present()
 {
-    //debug("Presentation::present()");
+    return _present(*queue, {this});
+}
 
-    std::vector<VkSemaphore> vk_semaphores;
-    for (auto& semaphore : waitSemaphores)
+VkResult Presentation::present(const std::vector<ref_ptr<Presentation>>& presentations)
+{
+    // group the presentations by the Queue they present on, preserving their order
+    std::vector<std::pair<Queue*, std::vector<Presentation*>>> queuePresentations;
+    for (auto& presentation : presentations)
     {
-        vk_semaphores.emplace_back(*(semaphore));
+        auto itr = std::find_if(queuePresentations.begin(), queuePresentations.end(), [&](const auto& entry) { return entry.first == presentation->queue.get(); });
+        if (itr != queuePresentations.end())
+            itr->second.push_back(presentation.get());
+        else
+            queuePresentations.emplace_back(presentation->queue.get(), std::vector<Presentation*>{presentation.get()});
     }
 
+    VkResult result = VK_SUCCESS;
+    for (auto& [presentQueue, queuedPresentations] : queuePresentations)
+    {
+        if (VkResult queueResult = _present(*presentQueue, queuedPresentations); queueResult != VK_SUCCESS && result == VK_SUCCESS) result = queueResult;
+    }
+    return result;
+}
+
+VkResult Presentation::_present(Queue& presentQueue, const std::vector<Presentation*>& presentations)
+{
+    //debug("Presentation::present()");
+
+    std::vector<VkSemaphore> vk_semaphores;
     std::vector<VkSwapchainKHR> vk_swapchains;
     std::vector<uint32_t> indices;
-    for (auto& window : windows)
+    bool usePresentIds = true;
+
+    for (auto& presentation : presentations)
     {
-        size_t imageIndex = window->imageIndex();
-        if (window->visible() && imageIndex < window->numFrames())
+        for (auto& semaphore : presentation->waitSemaphores)
         {
-            vk_swapchains.emplace_back(*(window->getOrCreateSwapchain()));
-            indices.emplace_back(static_cast<uint32_t>(imageIndex));
+            vk_semaphores.emplace_back(*(semaphore));
+        }
 
-            auto& renderFinishedSemaphore = window->frame(imageIndex).renderFinishedSemaphore;
-            vk_semaphores.push_back(renderFinishedSemaphore->vk());
+        presentation->presentIds.clear();
+
+        for (auto& window : presentation->windows)
+        {
+            size_t imageIndex = window->imageIndex();
+            if (window->visible() && imageIndex < window->numFrames())
+            {
+                auto swapchain = window->getOrCreateSwapchain();
+                vk_swapchains.emplace_back(*swapchain);
+                if (swapchain->supportsPresentId())
+                    presentation->presentIds.emplace_back(swapchain, 0);
+                else
+                    usePresentIds = false;
+                indices.emplace_back(static_cast<uint32_t>(imageIndex));
+
+                auto& renderFinishedSemaphore = window->frame(imageIndex).renderFinishedSemaphore;
+                vk_semaphores.push_back(renderFinishedSemaphore->vk());
+            }
         }
     }
 
@@ -54,6 +94,30 @@ VkResult Presentation::present()
     presentInfo.pSwapchains = vk_swapchains.data();
     presentInfo.pImageIndices = indices.data();
 
+    // tag each present with an id so that FramePacing can wait for the images to be displayed, the ids are in the same order as the swapchains
+    std::vector<uint64_t> vk_presentIds;
+    VkPresentIdKHR presentIdInfo = {};
+    if (usePresentIds)
+    {
+        for (auto& presentation : presentations)
+        {
+            for (auto& [swapchain, presentId] : presentation->presentIds)
+            {
+                presentId = swapchain->nextPresentId();
+                vk_presentIds.push_back(presentId);
+            }
+        }
+
+        presentIdInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+        presentIdInfo.swapchainCount = static_cast<uint32_t>(vk_presentIds.size());
+        presentIdInfo.pPresentIds = vk_presentIds.data();
+        presentInfo.pNext = &presentIdInfo;
+    }
+    else
+    {
+        for (auto& presentation : presentations) presentation->presentIds.clear();
+    }
+
 #if 0
     debug( "pdo.presentInfo->present(..)");
     debug( "    presentInfo.waitSemaphoreCount = ", presentInfo.waitSemaphoreCount);
@@ -70,5 +134,5 @@ VkResult Presentation::present()
     debug("\n");
 #endif
 
-    return queue->present(presentInfo);
+    return presentQueue.present(presentInfo);
 }
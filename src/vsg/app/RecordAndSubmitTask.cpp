@@ -35,10 +35,31 @@ RecordAndSubmitTask::RecordAndSubmitTask(Device* in_device, uint32_t numBuffers)
         _fences[i] = Fence::create(device);
     }
 
+    _timelineValues.resize(numBuffers, 0);
+
     transferTask = TransferTask::create(in_device, numBuffers);
 
     earlyTransferConsumerCompletedSemaphore = Semaphore::create(in_device);
     lateTransferConsumerCompletedSemaphore = Semaphore::create(in_device);
+
+    scratchMemory = ScratchMemory::create(4096);
+}
+
+void RecordAndSubmitTask::enableTimelineSemaphore()
+{
+    if (!device->supportsTimelineSemaphores())
+    {
+        warn("RecordAndSubmitTask::enableTimelineSemaphore() Device not created with timelineSemaphore feature enabled, falling back to Fence based synchronization.");
+        return;
+    }
+
+    if (!timelineSemaphore) timelineSemaphore = Semaphore::create(device, VK_SEMAPHORE_TYPE_TIMELINE, 0);
+
+    if (transferTask && !transferTask->timelineSemaphore)
+    {
+        bool sharedQueue = !transferTask->transferQueue || transferTask->transferQueue == queue;
+        transferTask->timelineSemaphore = sharedQueue ? timelineSemaphore : Semaphore::create(device, VK_SEMAPHORE_TYPE_TIMELINE, 0);
+    }
 }
 
 void RecordAndSubmitTask::advance()
@@ -66,6 +87,15 @@ void RecordAndSubmitTask::advance()
 
     // pass the index for the current frame
     _indices[0] = _currentFrameIndex;
+
+    std::scoped_lock<std::mutex> lock(_submissionMutex);
+    ++_advanceCount;
+}
+
+bool RecordAndSubmitTask::waitForSubmission(uint64_t timeout)
+{
+    std::unique_lock<std::mutex> lock(_submissionMutex);
+    return _submissionCondition.wait_for(lock, std::chrono::nanoseconds(timeout), [&]() { return _submissionCount >= _advanceCount; });
 }
 
 size_t RecordAndSubmitTask::index(size_t relativeFrameIndex) const
@@ -76,10 +106,49 @@ size_t RecordAndSubmitTask::index(size_t relativeFrameIndex) const
 /// fence() and fence(0) return the Fence for the frame currently being rendered, fence(1) returns the previous frame's Fence etc.
 ref_ptr<Fence> RecordAndSubmitTask::fence(size_t relativeFrameIndex)
 {
+    if (timelineSemaphore) return {};
+
     size_t i = index(relativeFrameIndex);
     return i < _fences.size() ? _fences[i] : nullptr;
 }
 
+uint64_t RecordAndSubmitTask::timelineValue(size_t relativeFrameIndex) const
+{
+    size_t i = index(relativeFrameIndex);
+    return i < _timelineValues.size() ? _timelineValues[i] : 0;
+}
+
+VkResult RecordAndSubmitTask::wait(size_t relativeFrameIndex, uint64_t timeout)
+{
+    if (timelineSemaphore)
+    {
+        uint64_t value = timelineValue(relativeFrameIndex);
+        return value > 0 ? timelineSemaphore->wait(value, timeout) : VK_SUCCESS;
+    }
+
+    auto fenceToWait = fence(relativeFrameIndex);
+    return fenceToWait ? fenceToWait->wait(timeout) : VK_SUCCESS;
+}
+
+VkResult RecordAndSubmitTask::waitForFramesInFlight(uint64_t timeout)
+{
+    for (size_t i = 0; i < _fences.size(); ++i)
+    {
+        VkResult result = VK_SUCCESS;
+        if (timelineSemaphore && _timelineValues[i] > 0)
+        {
+            result = timelineSemaphore->wait(_timelineValues[i], timeout);
+        }
+        else if (_fences[i]->hasDependencies())
+        {
+            // only Fences that have been submitted have dependencies, unsubmitted Fences would never signal
+            result = _fences[i]->wait(timeout);
+        }
+        if (result != VK_SUCCESS) return result;
+    }
+    return VK_SUCCESS;
+}
+
 VkResult RecordAndSubmitTask::submit(ref_ptr<FrameStamp> frameStamp)
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "RecordAndSubmitTask submit", COLOR_RECORD);
@@ -88,6 +157,36 @@ VkResult RecordAndSubmitTask::submit(ref_ptr<FrameStamp> frameStamp)
 
     if (VkResult result = start(); result != VK_SUCCESS) return result;
 
+    if (VkResult result = transferBeforeRecordTraversal(); result != VK_SUCCESS) return result;
+
+    // reuse the RecordedCommandBuffers container between frames
+    if (!_recordedCommandBuffers)
+        _recordedCommandBuffers = RecordedCommandBuffers::create();
+    else
+        _recordedCommandBuffers->clear();
+
+    if (VkResult result = record(_recordedCommandBuffers, frameStamp); result != VK_SUCCESS) return result;
+
+    return finish(_recordedCommandBuffers);
+}
+
+void RecordAndSubmitTask::releaseScratchMemory(ScratchMemory& frameScratchMemory, const char* description) const
+{
+    size_t numAllocations = frameScratchMemory.numAllocations;
+    if (frameScratchMemory.consolidate())
+    {
+        debug("RecordAndSubmitTask::start() ", description, " ScratchMemory overflowed with ", numAllocations, " allocations, resized to ", frameScratchMemory.size, " bytes.");
+    }
+}
+
+VkResult RecordAndSubmitTask::transferBeforeRecordTraversal()
+{
+    if (_transferredBeforeRecordTraversal) return VK_SUCCESS;
+    _transferredBeforeRecordTraversal = true;
+
+    earlyDataTransferredSemaphore.reset();
+    earlyDataTransferredValue = 0;
+
     if (transferTask)
     {
         if (auto transfer = transferTask->transferData(TransferTask::TRANSFER_BEFORE_RECORD_TRAVERSAL); transfer.result == VK_SUCCESS)
@@ -96,6 +195,7 @@ VkResult RecordAndSubmitTask::submit(ref_ptr<FrameStamp> frameStamp)
             {
                 //info("    adding early transfer dataTransferredSemaphore ", transfer.dataTransferredSemaphore);
                 earlyDataTransferredSemaphore = transfer.dataTransferredSemaphore;
+                earlyDataTransferredValue = transfer.dataTransferredValue;
             }
         }
         else
@@ -104,21 +204,53 @@ VkResult RecordAndSubmitTask::submit(ref_ptr<FrameStamp> frameStamp)
         }
     }
 
-    auto recordedCommandBuffers = RecordedCommandBuffers::create();
-
-    if (VkResult result = record(recordedCommandBuffers, frameStamp); result != VK_SUCCESS) return result;
-
-    return finish(recordedCommandBuffers);
+    return VK_SUCCESS;
 }
 
 VkResult RecordAndSubmitTask::start()
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "RecordAndSubmitTask start", COLOR_RECORD);
 
-    earlyDataTransferredSemaphore.reset();
+    // the previous frame's record traversals and finish() have completed so their frame scoped memory can be reused
+    if (scratchMemory) releaseScratchMemory(*scratchMemory, "finish");
+    for (auto& commandGraph : commandGraphs)
+    {
+        if (commandGraph->recordTraversal && commandGraph->recordTraversal->scratchMemory) releaseScratchMemory(*commandGraph->recordTraversal->scratchMemory, "RecordTraversal");
+    }
+
+    // the early transfer may already have been done for this frame by transferBeforeRecordTraversal()
+    if (!_transferredBeforeRecordTraversal)
+    {
+        earlyDataTransferredSemaphore.reset();
+        earlyDataTransferredValue = 0;
+    }
     lateDataTransferredSemaphore.reset();
+    lateDataTransferredValue = 0;
+
+    size_t currentIndex = index();
+    auto current_fence = _fences[currentIndex];
+
+    if (timelineSemaphore)
+    {
+        uint64_t timeout = std::numeric_limits<uint64_t>::max();
+        if (uint64_t& value = _timelineValues[currentIndex]; value > 0)
+        {
+            // wait on the GPU progress value signaled by the previous submission that used this frame's resources, no Fence reset required.
+            if (VkResult result = timelineSemaphore->wait(value, timeout); result != VK_SUCCESS) return result;
+            value = 0;
+
+            current_fence->resetDependencies();
+        }
+        else if (current_fence->hasDependencies())
+        {
+            // previous submission for this frame was made before the timelineSemaphore was assigned so wait on its Fence
+            if (VkResult result = current_fence->wait(timeout); result != VK_SUCCESS) return result;
+            current_fence->resetFenceAndDependencies();
+        }
+
+        return VK_SUCCESS;
+    }
 
-    auto current_fence = fence();
     if (current_fence->hasDependencies())
     {
         //info("RecordAndSubmitTask::start() waiting on fence ", current_fence, ", ", current_fence->status(), ", current_fence->hasDependencies() = ", current_fence->hasDependencies());
@@ -156,7 +288,25 @@ VkResult RecordAndSubmitTask::finish(ref_ptr<RecordedCommandBuffers> recordedCom
 
     //info("RecordAndSubmitTask::finish()");
 
-    auto current_fence = fence();
+    // release any tasks waiting on this frame's submission however finish() returns
+    struct SubmissionCompleted
+    {
+        RecordAndSubmitTask* task;
+        ~SubmissionCompleted()
+        {
+            {
+                std::scoped_lock<std::mutex> lock(task->_submissionMutex);
+                task->_submissionCount = task->_advanceCount;
+            }
+            task->_submissionCondition.notify_all();
+        }
+    } submissionCompleted{this};
+
+    // the record traversals have completed so the next frame will need its own early transfer
+    _transferredBeforeRecordTraversal = false;
+
+    size_t currentIndex = index();
+    auto current_fence = _fences[currentIndex];
 
     if (transferTask)
     {
@@ -168,6 +318,7 @@ VkResult RecordAndSubmitTask::finish(ref_ptr<RecordedCommandBuffers> recordedCom
             {
                 //info("    adding late transfer dataTransferredSemaphore ", transfer.dataTransferredSemaphore);
                 lateDataTransferredSemaphore = transfer.dataTransferredSemaphore;
+                lateDataTransferredValue = transfer.dataTransferredValue;
             }
         }
         else
@@ -178,8 +329,8 @@ VkResult RecordAndSubmitTask::finish(ref_ptr<RecordedCommandBuffers> recordedCom
 
     if (recordedCommandBuffers->empty())
     {
-        if (earlyDataTransferredSemaphore) transferTask->assignTransferConsumedCompletedSemaphore(TransferTask::TRANSFER_BEFORE_RECORD_TRAVERSAL, earlyDataTransferredSemaphore);
-        if (lateDataTransferredSemaphore) transferTask->assignTransferConsumedCompletedSemaphore(TransferTask::TRANSFER_AFTER_RECORD_TRAVERSAL, lateDataTransferredSemaphore);
+        if (earlyDataTransferredSemaphore) transferTask->assignTransferConsumedCompletedSemaphore(TransferTask::TRANSFER_BEFORE_RECORD_TRAVERSAL, earlyDataTransferredSemaphore, earlyDataTransferredValue);
+        if (lateDataTransferredSemaphore) transferTask->assignTransferConsumedCompletedSemaphore(TransferTask::TRANSFER_AFTER_RECORD_TRAVERSAL, lateDataTransferredSemaphore, lateDataTransferredValue);
 
         // nothing to do so return early
         std::this_thread::sleep_for(std::chrono::milliseconds(16)); // sleep for 1/60th of a second
@@ -187,10 +338,14 @@ VkResult RecordAndSubmitTask::finish(ref_ptr<RecordedCommandBuffers> recordedCom
     }
 
     // convert VSG CommandBuffer to Vulkan handles and add to the Fence's list of dependent CommandBuffers
-    std::vector<VkCommandBuffer> vk_commandBuffers;
-    std::vector<VkSemaphore> vk_waitSemaphores;
-    std::vector<VkPipelineStageFlags> vk_waitStages;
-    std::vector<VkSemaphore> vk_signalSemaphores;
+    // the containers are allocated from the frame scoped scratchMemory so no heap allocations are required
+    auto frameScratchMemory = scratchMemory.get();
+    scratch_vector<VkCommandBuffer> vk_commandBuffers(frameScratchMemory);
+    scratch_vector<VkSemaphore> vk_waitSemaphores(frameScratchMemory);
+    scratch_vector<VkPipelineStageFlags> vk_waitStages(frameScratchMemory);
+    scratch_vector<uint64_t> vk_waitValues(frameScratchMemory);
+    scratch_vector<VkSemaphore> vk_signalSemaphores(frameScratchMemory);
+    scratch_vector<uint64_t> vk_signalValues(frameScratchMemory);
 
     // convert VSG CommandBuffer to Vulkan handles and add to the Fence's list of dependent CommandBuffers
     auto buffers = recordedCommandBuffers->buffers();
@@ -205,15 +360,21 @@ VkResult RecordAndSubmitTask::finish(ref_ptr<RecordedCommandBuffers> recordedCom
     {
         vk_waitSemaphores.emplace_back(*earlyDataTransferredSemaphore);
         vk_waitStages.emplace_back(earlyDataTransferredSemaphore->pipelineStageFlags());
+        vk_waitValues.emplace_back(earlyDataTransferredValue);
     }
     if (lateDataTransferredSemaphore)
     {
         vk_waitSemaphores.emplace_back(*lateDataTransferredSemaphore);
         vk_waitStages.emplace_back(lateDataTransferredSemaphore->pipelineStageFlags());
+        vk_waitValues.emplace_back(lateDataTransferredValue);
     }
 
-    if (earlyDataTransferredSemaphore) transferTask->assignTransferConsumedCompletedSemaphore(TransferTask::TRANSFER_BEFORE_RECORD_TRAVERSAL, earlyTransferConsumerCompletedSemaphore);
-    if (lateDataTransferredSemaphore) transferTask->assignTransferConsumedCompletedSemaphore(TransferTask::TRANSFER_AFTER_RECORD_TRAVERSAL, lateTransferConsumerCompletedSemaphore);
+    // with a timeline semaphore the value signaled by this submission tells the TransferTask when the transferred data has been consumed.
+    uint64_t signalValue = timelineSemaphore ? timelineSemaphore->nextSignalValue() : 0;
+    auto transferConsumerCompletedSemaphore = [&](ref_ptr<Semaphore> semaphore) { return timelineSemaphore ? timelineSemaphore : semaphore; };
+
+    if (earlyDataTransferredSemaphore) transferTask->assignTransferConsumedCompletedSemaphore(TransferTask::TRANSFER_BEFORE_RECORD_TRAVERSAL, transferConsumerCompletedSemaphore(earlyTransferConsumerCompletedSemaphore), signalValue);
+    if (lateDataTransferredSemaphore) transferTask->assignTransferConsumedCompletedSemaphore(TransferTask::TRANSFER_AFTER_RECORD_TRAVERSAL, transferConsumerCompletedSemaphore(lateTransferConsumerCompletedSemaphore), signalValue);
 
     current_fence->dependentSemaphores().clear();
 
@@ -226,8 +387,10 @@ VkResult RecordAndSubmitTask::finish(ref_ptr<RecordedCommandBuffers> recordedCom
 
         vk_waitSemaphores.emplace_back(frame.imageAvailableSemaphore->vk());
         vk_waitStages.emplace_back(frame.imageAvailableSemaphore->pipelineStageFlags());
+        vk_waitValues.emplace_back(0);
 
         vk_signalSemaphores.emplace_back(frame.renderFinishedSemaphore->vk());
+        vk_signalValues.emplace_back(0);
         current_fence->dependentSemaphores().push_back(frame.renderFinishedSemaphore);
     }
 
@@ -235,24 +398,58 @@ VkResult RecordAndSubmitTask::finish(ref_ptr<RecordedCommandBuffers> recordedCom
     {
         vk_waitSemaphores.emplace_back(semaphore->vk());
         vk_waitStages.emplace_back(semaphore->pipelineStageFlags());
+        vk_waitValues.emplace_back(0);
+    }
+
+    // wait on the timeline values signaled by the submissions of the tasks this task depends upon, the wait values are only passed on when this task has a timelineSemaphore
+    if (timelineSemaphore)
+    {
+        for (auto& dependency : dependencies)
+        {
+            auto task = dependency.task.ref_ptr();
+            if (!task || !task->timelineSemaphore) continue;
+
+            // make sure the task has submitted the current frame, it may be submitting on another thread
+            if (dependency.frameLag == 0 && !task->waitForSubmission(1000000000))
+            {
+                warn("RecordAndSubmitTask::finish() timed out waiting on dependency's submission.");
+                continue;
+            }
+
+            uint64_t waitValue = task->timelineValue(dependency.frameLag);
+            if (waitValue == 0) continue; // nothing submitted yet
+
+            vk_waitSemaphores.emplace_back(task->timelineSemaphore->vk());
+            vk_waitStages.emplace_back(dependency.waitStages);
+            vk_waitValues.emplace_back(waitValue);
+        }
     }
 
     current_fence->dependentSemaphores() = signalSemaphores;
     for (auto& semaphore : signalSemaphores)
     {
         vk_signalSemaphores.emplace_back(semaphore->vk());
+        vk_signalValues.emplace_back(0);
         current_fence->dependentSemaphores().push_back(semaphore);
     }
 
-    if (earlyDataTransferredSemaphore)
+    if (timelineSemaphore)
     {
-        vk_signalSemaphores.emplace_back(earlyTransferConsumerCompletedSemaphore->vk());
-        current_fence->dependentSemaphores().push_back(earlyTransferConsumerCompletedSemaphore);
+        vk_signalSemaphores.emplace_back(timelineSemaphore->vk());
+        vk_signalValues.emplace_back(signalValue);
     }
-    if (lateDataTransferredSemaphore)
+    else
     {
-        vk_signalSemaphores.emplace_back(lateTransferConsumerCompletedSemaphore->vk());
-        current_fence->dependentSemaphores().push_back(lateTransferConsumerCompletedSemaphore);
+        if (earlyDataTransferredSemaphore)
+        {
+            vk_signalSemaphores.emplace_back(earlyTransferConsumerCompletedSemaphore->vk());
+            current_fence->dependentSemaphores().push_back(earlyTransferConsumerCompletedSemaphore);
+        }
+        if (lateDataTransferredSemaphore)
+        {
+            vk_signalSemaphores.emplace_back(lateTransferConsumerCompletedSemaphore->vk());
+            current_fence->dependentSemaphores().push_back(lateTransferConsumerCompletedSemaphore);
+        }
     }
 
     VkSubmitInfo submitInfo = {};
@@ -268,6 +465,28 @@ VkResult RecordAndSubmitTask::finish(ref_ptr<RecordedCommandBuffers> recordedCom
     submitInfo.signalSemaphoreCount = static_cast<uint32_t>(vk_signalSemaphores.size());
     submitInfo.pSignalSemaphores = vk_signalSemaphores.data();
 
+    if (timelineSemaphore)
+    {
+        // allocate from the frame scoped scratchMemory so that it remains valid if the submission is batched
+        VkTimelineSemaphoreSubmitInfo local_timelineSubmitInfo = {};
+        auto timelineSubmitInfo = frameScratchMemory ? frameScratchMemory->allocate<VkTimelineSemaphoreSubmitInfo>() : &local_timelineSubmitInfo;
+        *timelineSubmitInfo = {};
+        timelineSubmitInfo->sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo->pNext = nullptr;
+        timelineSubmitInfo->waitSemaphoreValueCount = static_cast<uint32_t>(vk_waitValues.size());
+        timelineSubmitInfo->pWaitSemaphoreValues = vk_waitValues.data();
+        timelineSubmitInfo->signalSemaphoreValueCount = static_cast<uint32_t>(vk_signalValues.size());
+        timelineSubmitInfo->pSignalSemaphoreValues = vk_signalValues.data();
+
+        submitInfo.pNext = timelineSubmitInfo;
+
+        _timelineValues[currentIndex] = signalValue;
+
+        if (submitBatch) return submitBatch->add(submitInfo);
+        return queue->submit(submitInfo);
+    }
+
+    if (submitBatch) return submitBatch->add(submitInfo, current_fence);
     return queue->submit(submitInfo, current_fence);
 }
 
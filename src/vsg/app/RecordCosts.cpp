@@ -0,0 +1,188 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/RecordCosts.h>
+#include <vsg/nodes/PagedLOD.h>
+
+#include <algorithm>
+
+using namespace vsg;
+
+RecordCosts::RecordCosts()
+{
+}
+
+bool RecordCosts::track(const Node& node, std::string& name) const
+{
+    return trackNamedNodes && node.getAuxiliary() && node.getValue("name", name);
+}
+
+bool RecordCosts::track(const PagedLOD& plod, std::string& name) const
+{
+    if (trackPagedLOD)
+    {
+        name = plod.filename.string();
+        return true;
+    }
+    return track(static_cast<const Node&>(plod), name);
+}
+
+void RecordCosts::add(const Costs& costs)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    for (auto& [node, cost] : costs)
+    {
+        auto& accumulated = _costs[node];
+        if (accumulated.name.empty()) accumulated.name = cost.name;
+        accumulated.add(cost);
+    }
+}
+
+std::vector<RecordCosts::NodeCost> RecordCosts::top(size_t n, SortBy sortBy) const
+{
+    std::vector<NodeCost> results;
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        results.assign(_costs.begin(), _costs.end());
+    }
+
+    auto value = [sortBy](const Cost& cost) -> double {
+        switch (sortBy)
+        {
+        case (DRAWS): return static_cast<double>(cost.draws);
+        case (VERTICES): return static_cast<double>(cost.vertices);
+        case (STATE_BINDS): return static_cast<double>(cost.stateBinds);
+        default: return cost.cpuTime;
+        }
+    };
+
+    n = std::min(n, results.size());
+    std::partial_sort(results.begin(), results.begin() + n, results.end(), [&](const NodeCost& lhs, const NodeCost& rhs) { return value(lhs.second) > value(rhs.second); });
+    results.resize(n);
+
+    return results;
+}
+
+void RecordCosts::report(std::ostream& out, size_t n, SortBy sortBy) const
+{
+    auto results = top(n, sortBy);
+
+    out << "RecordCosts::report() " << results.size() << " most expensive subgraphs" << std::endl;
+    for (auto& [node, cost] : results)
+    {
+        out << "    { ";
+        if (node)
+            out << (cost.name.empty() ? std::string("unnamed") : cost.name);
+        else
+            out << "untracked";
+        out << ", visits = " << cost.visits << ", draws = " << cost.draws << ", vertices = " << cost.vertices << ", stateBinds = " << cost.stateBinds << ", cpuTime = " << cost.cpuTime << "ms }" << std::endl;
+    }
+}
+
+void RecordCosts::clear()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    _costs.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// RecordCostCollector
+//
+void RecordCostCollector::_accumulateTime(time_point now)
+{
+    if (!_stack.empty()) _stack.back().second->cpuTime += std::chrono::duration<double, std::chrono::milliseconds::period>(now - _start).count();
+    _start = now;
+}
+
+RecordCosts::Cost& RecordCostCollector::current()
+{
+    if (_stack.empty())
+    {
+        _stack.emplace_back(nullptr, &costs[nullptr]);
+        _start = clock::now();
+    }
+    return *_stack.back().second;
+}
+
+void RecordCostCollector::enter(const Node* node, const std::string& name)
+{
+    _accumulateTime(clock::now());
+
+    auto& cost = costs[node];
+    if (cost.name.empty()) cost.name = name;
+    ++cost.visits;
+
+    _stack.emplace_back(node, &cost);
+}
+
+void RecordCostCollector::leave()
+{
+    _accumulateTime(clock::now());
+    _stack.pop_back();
+}
+
+void RecordCostCollector::inherit(const RecordCostCollector& parent)
+{
+    costs.clear();
+    _stack.clear();
+
+    if (!parent._stack.empty())
+    {
+        auto& [node, parentCost] = parent._stack.back();
+        auto& cost = costs[node];
+        cost.name = parentCost->name;
+        _stack.emplace_back(node, &cost);
+        _start = clock::now();
+    }
+}
+
+void RecordCostCollector::merge(RecordCostCollector& batch)
+{
+    batch._accumulateTime(clock::now());
+
+    for (auto& [node, cost] : batch.costs)
+    {
+        auto& merged = costs[node];
+        if (merged.name.empty()) merged.name = cost.name;
+        merged.add(cost);
+    }
+
+    batch.costs.clear();
+    batch._stack.clear();
+}
+
+void RecordCostCollector::flush(RecordCosts& recordCosts)
+{
+    if (costs.empty()) return;
+
+    _accumulateTime(clock::now());
+
+    recordCosts.add(costs);
+
+    if (_stack.size() <= 1)
+    {
+        // no tracked subgraphs are being traversed so the costs can be discarded
+        costs.clear();
+        _stack.clear();
+    }
+    else
+    {
+        // reset the costs while retaining the entries referenced by the scopes still being traversed
+        for (auto& entry : costs)
+        {
+            entry.second = RecordCosts::Cost{entry.second.name};
+        }
+    }
+}
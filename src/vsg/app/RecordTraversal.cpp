@@ -12,10 +12,21 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/animation/Animation.h>
 #include <vsg/app/CommandGraph.h>
+#include <vsg/app/CullCache.h>
+#include <vsg/app/FrameCapture.h>
+#include <vsg/app/LazyCompiler.h>
+#include <vsg/app/OcclusionBuffer.h>
+#include <vsg/app/PagedLODOcclusionQueries.h>
+#include <vsg/app/StaticTileCache.h>
+#include <vsg/app/PrefetchTraversal.h>
+#include <vsg/app/RecordCosts.h>
 #include <vsg/app/RecordTraversal.h>
+#include <vsg/app/TextureStreamer.h>
 #include <vsg/app/View.h>
 #include <vsg/commands/Command.h>
 #include <vsg/commands/Commands.h>
+#include <vsg/commands/DrawIndexed.h>
+#include <vsg/core/ScratchMemory.h>
 #include <vsg/io/DatabasePager.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/stream.h>
@@ -25,6 +36,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/lighting/PointLight.h>
 #include <vsg/lighting/SpotLight.h>
 #include <vsg/maths/plane.h>
+#include <vsg/nodes/BatchedCullGroup.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/nodes/CoordinateFrame.h>
 #include <vsg/nodes/CullGroup.h>
@@ -37,30 +49,68 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/InstanceNode.h>
 #include <vsg/nodes/LOD.h>
 #include <vsg/nodes/Layer.h>
+#include <vsg/nodes/LazyCompileGroup.h>
 #include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/Occluder.h>
+#include <vsg/nodes/PackedDraws.h>
+#include <vsg/nodes/PackedSubgraph.h>
 #include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/ParallelGroup.h>
+#include <vsg/nodes/PointCloud.h>
 #include <vsg/nodes/QuadGroup.h>
 #include <vsg/nodes/RegionOfInterest.h>
+#include <vsg/nodes/SpatialGrid.h>
 #include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/StreamingStateGroup.h>
 #include <vsg/nodes/Switch.h>
 #include <vsg/nodes/TileDatabase.h>
 #include <vsg/nodes/VertexDraw.h>
 #include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/state/GraphicsPipeline.h>
 #include <vsg/state/ViewDependentState.h>
+#include <vsg/threading/Latch.h>
+#include <vsg/threading/OperationThreads.h>
 #include <vsg/threading/atomics.h>
 #include <vsg/ui/ApplicationEvent.h>
 #include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/CommandPoolRing.h>
 #include <vsg/vk/RenderPass.h>
 #include <vsg/vk/State.h>
 
 #include <vsg/utils/Instrumentation.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace vsg;
 
 #define INLINE_TRAVERSE 0
 
+namespace
+{
+    // records a range of a ParallelGroup's children, retained by the ParallelBatch so that no Operation needs to be allocated each frame
+    struct RecordBatchOperation : public Inherit<Operation, RecordBatchOperation>
+    {
+        RecordTraversal* recordTraversal = nullptr;
+        const ParallelGroup* parallelGroup = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        Latch* latch = nullptr;
+
+        void run() override
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                parallelGroup->children[i]->accept(*recordTraversal);
+            }
+            if (latch) latch->count_down();
+        }
+    };
+} // namespace
+
 RecordTraversal::RecordTraversal(const Slots& in_maxSlots, const std::set<Bin*>& in_bins) :
-    state(new State(in_maxSlots))
+    state(new State(in_maxSlots)),
+    scratchMemory(ScratchMemory::create(16384))
 {
     CPU_INSTRUMENTATION_L1_C(instrumentation, COLOR_RECORD);
 
@@ -129,6 +179,7 @@ void RecordTraversal::apply(const Object& object)
 void RecordTraversal::apply(const Group& group)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "Group", COLOR_RECORD_L2, &group);
+    CostScope costScope(*this, group);
 
     //debug("Visiting Group");
 #if INLINE_TRAVERSE
@@ -150,43 +201,142 @@ void RecordTraversal::apply(const QuadGroup& quadGroup)
 #endif
 }
 
-void RecordTraversal::apply(const LOD& lod)
+void RecordTraversal::apply(const ParallelGroup& parallelGroup)
 {
-    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "LOD", COLOR_RECORD_L2, &lod);
+    CPU_INSTRUMENTATION_L1_NCO(instrumentation, "ParallelGroup", COLOR_RECORD_L1, &parallelGroup);
 
-    const auto& sphere = lod.bound;
+    const auto& children = parallelGroup.children;
 
-    // check if lod bounding sphere is in view frustum.
-    auto lodDistance = state->lodDistance(sphere);
-    if (lodDistance < 0.0)
+    // secondary CommandBuffers can only be executed from a primary CommandBuffer, and within a render pass only when the subpass contents are VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+    // secondary CommandBuffers aren't used within dynamic rendering as they would require VkCommandBufferInheritanceRenderingInfo
+    bool insideRenderPass = state->renderPass != VK_NULL_HANDLE || state->dynamicRendering;
+    if (!recordedCommandBuffers || children.empty() || (insideRenderPass && !_secondaryCommandBuffersRequired()) ||
+        state->_commandBuffer->level() != VK_COMMAND_BUFFER_LEVEL_PRIMARY)
     {
+        parallelGroup.traverse(*this);
         return;
     }
 
-    if (viewDependentState) lodDistance *= viewDependentState->LODScale;
+    size_t numBatches = parallelGroup.maxNumBatches;
+    if (numBatches == 0) numBatches = recordThreads ? recordThreads->threads.size() + 1 : 1;
+
+    size_t maxNumBatchesForChildren = children.size() / std::max(parallelGroup.minimumChildrenPerBatch, 1u);
+    numBatches = std::max(std::min(numBatches, maxNumBatchesForChildren), size_t(1));
 
-    for (auto& child : lod.children)
+    // outside a render pass there is no benefit in recording a single batch to a secondary CommandBuffer
+    if (numBatches == 1 && !insideRenderPass)
     {
-        auto cutoff = lodDistance * child.minimumScreenHeightRatio;
-        bool child_visible = sphere.r > cutoff;
-        if (child_visible)
+        parallelGroup.traverse(*this);
+        return;
+    }
+
+    for (size_t i = 0; i < numBatches; ++i)
+    {
+        _beginParallelBatch(i);
+    }
+
+    bool useRecordThreads = recordThreads && numBatches > 1;
+    if (useRecordThreads)
+    {
+        // use latch to synchronize this thread with the record threads
+        if (!_parallelBatchLatch)
+            _parallelBatchLatch = Latch::create(static_cast<int>(numBatches - 1));
+        else
+            _parallelBatchLatch->set(static_cast<int>(numBatches - 1));
+    }
+
+    for (size_t i = 0; i < numBatches; ++i)
+    {
+        auto& batch = _parallelBatches[i];
+        if (!batch.operation) batch.operation = RecordBatchOperation::create();
+
+        auto operation = static_cast<RecordBatchOperation*>(batch.operation.get());
+        operation->recordTraversal = batch.recordTraversal.get();
+        operation->parallelGroup = &parallelGroup;
+        operation->begin = (children.size() * i) / numBatches;
+        operation->end = (children.size() * (i + 1)) / numBatches;
+        operation->latch = (useRecordThreads && i > 0) ? _parallelBatchLatch.get() : nullptr;
+    }
+
+    if (useRecordThreads)
+    {
+        for (size_t i = 1; i < numBatches; ++i)
         {
-            child.node->accept(*this);
-            return;
+            recordThreads->add(_parallelBatches[i].operation);
+        }
+
+        // use this thread to record the first batch and then help out with any batches not yet taken by the record threads
+        _parallelBatches[0].operation->run();
+        recordThreads->run();
+
+        _parallelBatchLatch->wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < numBatches; ++i)
+        {
+            _parallelBatches[i].operation->run();
+        }
+    }
+
+    _endParallelBatches(numBatches);
+}
+
+void RecordTraversal::apply(const LOD& lod)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "LOD", COLOR_RECORD_L2, &lod);
+    CostScope costScope(*this, lod);
+
+    int32_t selected = -1;
+    if (!cullCache || !cullCache->lookup(&lod, selected))
+    {
+        const auto& sphere = lod.bound;
+
+        // check if lod bounding sphere is in view frustum.
+        auto lodDistance = state->lodDistance(sphere);
+        if (lodDistance >= 0.0 && !_occluded(sphere))
+        {
+            if (viewDependentState) lodDistance *= viewDependentState->LODScale;
+
+            // select by screen space error when the lowest res child has a geometric error, a child being required when the next lower res child's error is visible
+            bool screenSpaceError = _screenSpaceErrorScale > 0.0 && !lod.children.empty() && lod.children.back().geometricError > 0.0;
+
+            for (size_t i = 0; i < lod.children.size(); ++i)
+            {
+                bool child_visible;
+                if (screenSpaceError && (i + 1) < lod.children.size())
+                    child_visible = lod.children[i + 1].geometricError * _screenSpaceErrorScale > lodDistance;
+                else
+                    child_visible = sphere.r > lodDistance * lod.children[i].minimumScreenHeightRatio;
+
+                if (child_visible)
+                {
+                    selected = static_cast<int32_t>(i);
+                    break;
+                }
+            }
         }
+
+        if (cullCache) cullCache->store(&lod, selected);
+    }
+
+    if (selected >= 0 && static_cast<size_t>(selected) < lod.children.size())
+    {
+        lod.children[selected].node->accept(*this);
     }
 }
 
 void RecordTraversal::apply(const PagedLOD& plod)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "PagedLOD", COLOR_PAGER, &plod);
+    CostScope costScope(*this, plod);
 
     const auto& sphere = plod.bound;
     auto frameCount = frameStamp->frameCount;
 
     // check if lod bounding sphere is in view frustum.
     auto lodDistance = state->lodDistance(sphere);
-    if (lodDistance < 0.0)
+    if (lodDistance < 0.0 || _occluded(sphere))
     {
         if ((frameCount - plod.frameHighResLastUsed) > 1 && culledPagedLODs)
         {
@@ -202,8 +352,19 @@ void RecordTraversal::apply(const PagedLOD& plod)
     {
         const auto& child = plod.children[0];
 
-        auto cutoff = lodDistance * child.minimumScreenHeightRatio;
-        bool child_visible = sphere.r > cutoff;
+        // relax the test while the high res child is in use to avoid it being expired and reloaded when the viewpoint hovers around the transition
+        double hysteresis = ((frameCount - plod.frameHighResLastUsed) <= 1) ? (1.0 - _LODHysteresis) : 1.0;
+
+        // when the low res child has a geometric error the high res child is required once that error projected to the screen exceeds the error budget
+        double size = sphere.r;
+        double cutoff = lodDistance * child.minimumScreenHeightRatio * hysteresis;
+        if (_screenSpaceErrorScale > 0.0 && plod.children[1].geometricError > 0.0)
+        {
+            size = plod.children[1].geometricError * _screenSpaceErrorScale;
+            cutoff = lodDistance * hysteresis;
+        }
+
+        bool child_visible = size > cutoff;
         if (child_visible)
         {
             auto previousHighResUsed = plod.frameHighResLastUsed.exchange(frameCount);
@@ -215,23 +376,15 @@ void RecordTraversal::apply(const PagedLOD& plod)
             if (child.node)
             {
                 // high res visible and available so traverse it
-                child.node->accept(*this);
+                _recordTile(*child.node);
                 return;
             }
             else if (databasePager)
             {
-                auto priority = sphere.r / cutoff;
-                exchange_if_greater(plod.priority, priority);
-
-                auto previousRequestCount = plod.requestCount.fetch_add(1);
-                if (previousRequestCount == 0)
-                {
-                    // we are the first request so tell the databasePager about it
-                    databasePager->request(ref_ptr<PagedLOD>(const_cast<PagedLOD*>(&plod)));
-                }
-                else
+                // withhold the request while the PagedLOD's bounds are hidden behind the rendered scene
+                if (!pagedLODOcclusionQueries || !pagedLODOcclusionQueries->suppressRequest(plod, state->projectionMatrixStack.top(), state->modelviewMatrixStack.top()))
                 {
-                    //debug("repeat request ",&plod,", ",plod.filename,", ",plod.requestCount.load(),", plod.requestStatus = ",plod.requestStatus.load());
+                    _requestPagedLOD(plod, size / cutoff, previousHighResUsed != frameCount);
                 }
             }
         }
@@ -253,12 +406,117 @@ void RecordTraversal::apply(const PagedLOD& plod)
         {
             if (child.node)
             {
-                child.node->accept(*this);
+                _recordTile(*child.node);
             }
         }
     }
 }
 
+void RecordTraversal::_recordTile(const Node& tile)
+{
+    if (staticTileCache && frameStamp)
+    {
+        auto staticTile = staticTileCache->getTile(tile, frameStamp->frameCount);
+        if (staticTile && staticTile->ready(state->_commandBuffer->viewID))
+        {
+            staticTile->record(*this);
+            return;
+        }
+    }
+
+    tile.accept(*this);
+}
+
+void RecordTraversal::_requestPagedLOD(const PagedLOD& plod, double priority, bool firstRequestOfFrame)
+{
+    // reset the priority on the first visit of each frame so it tracks the current view rather than the highest value ever seen.
+    if (firstRequestOfFrame)
+        plod.priority.exchange(priority);
+    else
+        exchange_if_greater(plod.priority, priority);
+
+    auto previousRequestCount = plod.requestCount.fetch_add(1);
+    if (previousRequestCount == 0)
+    {
+        // we are the first request so tell the databasePager about it
+        databasePager->request(ref_ptr<PagedLOD>(const_cast<PagedLOD*>(&plod)));
+    }
+    else
+    {
+        //debug("repeat request ",&plod,", ",plod.filename,", ",plod.requestCount.load(),", plod.requestStatus = ",plod.requestStatus.load());
+    }
+}
+
+void RecordTraversal::apply(const PointCloud& pointCloud)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "PointCloud", COLOR_PAGER, &pointCloud);
+    CostScope costScope(*this, pointCloud);
+
+    if (!pointCloud.root) return;
+
+    auto frameCount = frameStamp->frameCount;
+    double lodScale = viewDependentState ? viewDependentState->LODScale : 1.0;
+    double minimumScreenHeightRatio = pointCloud.minimumScreenHeightRatio;
+
+    // tiles within the view frustum ordered by the screen height ratio of their bounds, so the point budget is spent on the tiles covering the most of the screen first
+    using Candidate = std::pair<double, const PointCloudTile*>;
+    std::vector<Candidate> candidates;
+
+    auto addCandidate = [&](const PointCloudTile& tile) {
+        auto lodDistance = state->lodDistance(tile.bound);
+        if (lodDistance < 0.0 || _occluded(tile.bound)) return;
+
+        lodDistance *= lodScale;
+        double ratio = (lodDistance > 0.0) ? (tile.bound.r / lodDistance) : std::numeric_limits<double>::max();
+        if (ratio < minimumScreenHeightRatio) return;
+
+        candidates.emplace_back(ratio, &tile);
+        std::push_heap(candidates.begin(), candidates.end());
+    };
+
+    addCandidate(*pointCloud.root);
+
+    uint64_t numPoints = 0;
+    while (!candidates.empty())
+    {
+        std::pop_heap(candidates.begin(), candidates.end());
+        auto [ratio, tile] = candidates.back();
+        candidates.pop_back();
+
+        if (numPoints + tile->numPoints > pointCloud.pointBudget) break;
+
+        const auto& chunk = tile->children[0].node;
+        if (!tile->filename.empty())
+        {
+            auto previousHighResUsed = tile->frameHighResLastUsed.exchange(frameCount);
+            if (culledPagedLODs && ((frameCount - previousHighResUsed) > 1))
+            {
+                culledPagedLODs->newHighresRequired.emplace_back(tile);
+            }
+
+            if (!chunk)
+            {
+                // the child tiles refine the chunk so aren't visited until it's loaded
+                if (databasePager) _requestPagedLOD(*tile, (minimumScreenHeightRatio > 0.0) ? (ratio / minimumScreenHeightRatio) : ratio, previousHighResUsed != frameCount);
+                continue;
+            }
+        }
+
+        if (chunk)
+        {
+            numPoints += tile->numPoints;
+            chunk->accept(*this);
+        }
+
+        for (auto& child : tile->tiles)
+        {
+            if (child) addCandidate(*child);
+        }
+    }
+
+    pointCloud.numPointsDrawn = numPoints;
+}
+
 void RecordTraversal::apply(const TileDatabase& tileDatabase)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "TileDatabase", COLOR_RECORD_L2, &tileDatabase);
@@ -269,19 +527,234 @@ void RecordTraversal::apply(const TileDatabase& tileDatabase)
 void RecordTraversal::apply(const CullGroup& cullGroup)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "CullGroup", COLOR_RECORD_L2, &cullGroup);
+    CostScope costScope(*this, cullGroup);
 
-    if (state->intersect(cullGroup.bound))
+    if (_intersect(cullGroup, cullGroup.bound))
     {
         // debug("Passed node");
         cullGroup.traverse(*this);
     }
 }
 
+void RecordTraversal::apply(const LazyCompileGroup& lcg)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "LazyCompileGroup", COLOR_RECORD_L2, &lcg);
+    CostScope costScope(*this, lcg);
+
+    if (!_intersect(lcg, lcg.bound)) return;
+
+    if (lcg.compiled())
+    {
+        lcg.traverse(*this);
+        return;
+    }
+
+    // request the compile of the visible children, prioritized by the screen space size of the bounding sphere, and skip them until they've been merged
+    auto lodDistance = state->lodDistance(lcg.bound);
+    if (viewDependentState) lodDistance *= viewDependentState->LODScale;
+
+    double screenHeightRatio = (lodDistance > 0.0) ? (lcg.bound.r / lodDistance) : std::numeric_limits<double>::max();
+    lcg.lazyCompiler->request(lcg, screenHeightRatio);
+}
+
+void RecordTraversal::apply(const BatchedCullGroup& cullGroup)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "BatchedCullGroup", COLOR_RECORD_L2, &cullGroup);
+
+    const auto& children = cullGroup.children;
+    size_t count = std::min(children.size(), cullGroup.bounds.size());
+    if (count == 0) return;
+
+    if (cullCache)
+    {
+        // cached results are recorded per child
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (_intersect(*children[i], cullGroup.bounds[i])) children[i]->accept(*this);
+        }
+        return;
+    }
+
+    // nested BatchedCullGroup append their results so use an index rather than a pointer into the visibility vector
+    size_t base = _batchedCullVisibility.size();
+    _batchedCullVisibility.resize(base + count);
+
+    if (state->intersect(cullGroup.bounds.data(), count, _batchedCullVisibility.data() + base) > 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (_batchedCullVisibility[base + i] && !_occluded(cullGroup.bounds[i])) children[i]->accept(*this);
+        }
+    }
+
+    _batchedCullVisibility.resize(base);
+}
+
+void RecordTraversal::apply(const SpatialGrid& spatialGrid)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "SpatialGrid", COLOR_RECORD_L2, &spatialGrid);
+
+    const auto& children = spatialGrid.children;
+    const auto& cells = spatialGrid.getCells();
+    const auto& cellBounds = spatialGrid.getCellBounds();
+    size_t count = std::min(cells.size(), cellBounds.size());
+    if (count == 0) return;
+
+    if (cullCache)
+    {
+        // cached results are recorded per child
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            if (_intersect(*children[i], spatialGrid.bounds[i])) children[i]->accept(*this);
+        }
+        return;
+    }
+
+    size_t base = _batchedCullVisibility.size();
+    _batchedCullVisibility.resize(base + count);
+
+    if (state->intersect(cellBounds.data(), count, _batchedCullVisibility.data() + base) > 0)
+    {
+        for (size_t c = 0; c < count; ++c)
+        {
+            if (!_batchedCullVisibility[base + c] || cells[c].children.empty()) continue;
+
+            // cells are loose so the children of visible cells are still culled individually
+            for (auto index : cells[c].children)
+            {
+                if (_intersect(*children[index], spatialGrid.bounds[index])) children[index]->accept(*this);
+            }
+        }
+    }
+
+    _batchedCullVisibility.resize(base);
+}
+
+void RecordTraversal::apply(const PackedSubgraph& packedSubgraph)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "PackedSubgraph", COLOR_RECORD_L2, &packedSubgraph);
+
+    const auto& draws = packedSubgraph.draws;
+    size_t count = std::min({draws.size(), packedSubgraph.bounds.size(), packedSubgraph.transformIndices.size(), packedSubgraph.stateIndices.size()});
+    if (count == 0) return;
+
+    size_t base = _batchedCullVisibility.size();
+    _batchedCullVisibility.resize(base + count);
+
+    if (state->intersect(packedSubgraph.bounds.data(), count, _batchedCullVisibility.data() + base) > 0)
+    {
+        const auto& transforms = packedSubgraph.transforms;
+        const auto& stateSets = packedSubgraph.stateSets;
+        const dmat4 modelview = state->modelviewMatrixStack.top();
+
+        // only push/pop transforms and state when they change between consecutive draws
+        const StateCommands* currentStateSet = nullptr;
+        uint32_t currentTransformIndex = 0;
+        bool transformPushed = false;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!_batchedCullVisibility[base + i]) continue;
+
+            const auto* stateSet = &stateSets[packedSubgraph.stateIndices[i]];
+            if (stateSet != currentStateSet)
+            {
+                if (currentStateSet) state->pop(*currentStateSet);
+                state->push(*stateSet);
+                currentStateSet = stateSet;
+            }
+
+            uint32_t transformIndex = packedSubgraph.transformIndices[i];
+            if (!transformPushed || transformIndex != currentTransformIndex)
+            {
+                if (transformPushed) state->modelviewMatrixStack.pop();
+                state->modelviewMatrixStack.push(modelview * transforms[transformIndex]);
+                state->dirty = true;
+                currentTransformIndex = transformIndex;
+                transformPushed = true;
+            }
+
+            draws[i]->accept(*this);
+        }
+
+        if (currentStateSet) state->pop(*currentStateSet);
+        if (transformPushed)
+        {
+            state->modelviewMatrixStack.pop();
+            state->dirty = true;
+        }
+    }
+
+    _batchedCullVisibility.resize(base);
+}
+
+void RecordTraversal::apply(const PackedDraws& packedDraws)
+{
+    GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "PackedDraws", COLOR_RECORD_L2, &packedDraws);
+
+    size_t count = packedDraws.numDraws();
+    if (count == 0 || !packedDraws.bindVertexBuffers || !packedDraws.bindIndexBuffer) return;
+
+    size_t base = _batchedCullVisibility.size();
+    _batchedCullVisibility.resize(base + count);
+
+    if (state->intersect(packedDraws.bounds.data(), count, _batchedCullVisibility.data() + base) > 0)
+    {
+        const auto& stateSets = packedDraws.stateSets;
+        auto& commandBuffer = *(state->_commandBuffer);
+
+        // only push/pop state when it changes between consecutive draws, the vertex and index buffers are bound once for all the draws
+        const StateCommands* currentStateSet = nullptr;
+        bool buffersBound = false;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!_batchedCullVisibility[base + i]) continue;
+
+            const auto* stateSet = &stateSets[packedDraws.stateIndices[i]];
+            if (stateSet != currentStateSet)
+            {
+                if (currentStateSet) state->pop(*currentStateSet);
+                state->push(*stateSet);
+                currentStateSet = stateSet;
+            }
+
+            state->record();
+
+            if (!buffersBound)
+            {
+                packedDraws.bindVertexBuffers->record(commandBuffer);
+                packedDraws.bindIndexBuffer->record(commandBuffer);
+                if (state->capturedCommands)
+                {
+                    state->capture(*packedDraws.bindVertexBuffers);
+                    state->capture(*packedDraws.bindIndexBuffer);
+                }
+                buffersBound = true;
+            }
+
+            vkCmdDrawIndexed(commandBuffer, packedDraws.indexCounts[i], 1, packedDraws.firstIndices[i], 0, 0);
+            if (state->capturedCommands) state->capture(*DrawIndexed::create(packedDraws.indexCounts[i], 1, packedDraws.firstIndices[i], 0, 0));
+
+            if (recordCosts)
+            {
+                auto& cost = _costs().current();
+                ++cost.draws;
+                cost.vertices += packedDraws.indexCounts[i];
+            }
+        }
+
+        if (currentStateSet) state->pop(*currentStateSet);
+    }
+
+    _batchedCullVisibility.resize(base);
+}
+
 void RecordTraversal::apply(const CullNode& cullNode)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "CullNode", COLOR_RECORD_L2, &cullNode);
 
-    if (state->intersect(cullNode.bound))
+    if (_intersect(cullNode, cullNode.bound))
     {
         //debug("Passed node");
         cullNode.traverse(*this);
@@ -291,6 +764,20 @@ void RecordTraversal::apply(const CullNode& cullNode)
 void RecordTraversal::apply(const Switch& sw)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "Switch", COLOR_RECORD_L2, &sw);
+    CostScope costScope(*this, sw);
+
+    if (sw.indexActiveChildren)
+    {
+        for (auto index : sw.activeChildren)
+        {
+            auto& child = sw.children[index];
+            if ((traversalMask & (overrideMask | child.mask)) != MASK_OFF)
+            {
+                child.node->accept(*this);
+            }
+        }
+        return;
+    }
 
     for (auto& child : sw.children)
     {
@@ -308,6 +795,11 @@ void RecordTraversal::apply(const RegionOfInterest& roi)
     regionsOfInterest.emplace_back(state->modelviewMatrixStack.top(), &roi);
 }
 
+void RecordTraversal::apply(const Occluder& occluder)
+{
+    if (occlusionBuffer) occlusionBuffer->add(occluder, state->modelviewMatrixStack.top());
+}
+
 void RecordTraversal::apply(const DepthSorted& depthSorted)
 {
     CPU_INSTRUMENTATION_L2_NCO(instrumentation, "DepthSorted", COLOR_RECORD_L2, &depthSorted);
@@ -338,6 +830,14 @@ void RecordTraversal::apply(const VertexDraw& vd)
     //debug("Visiting VertexDraw");
     state->record();
     vd.record(*(state->_commandBuffer));
+    if (state->capturedCommands) state->capture(vd);
+
+    if (recordCosts)
+    {
+        auto& cost = _costs().current();
+        ++cost.draws;
+        cost.vertices += static_cast<uint64_t>(vd.vertexCount) * vd.instanceCount;
+    }
 }
 
 void RecordTraversal::apply(const VertexIndexDraw& vid)
@@ -345,8 +845,49 @@ void RecordTraversal::apply(const VertexIndexDraw& vid)
     GPU_INSTRUMENTATION_L3_NCO(instrumentation, *getCommandBuffer(), "VertexIndexDraw", COLOR_GPU, &vid);
 
     //debug("Visiting VertexIndexDraw");
-    state->record();
-    vid.record(*(state->_commandBuffer));
+    if (state->drawBatch.enabled() && !state->capturedCommands)
+    {
+        // coalesce with neighbouring draws that share the same buffers and state into a vkCmdDrawMultiIndexedEXT call
+        state->recordForDrawBatch();
+        vid.record(*(state->_commandBuffer), state->drawBatch);
+    }
+    else
+    {
+        state->record();
+        vid.record(*(state->_commandBuffer));
+        if (state->capturedCommands) state->capture(vid);
+    }
+
+    if (recordCosts)
+    {
+        auto& cost = _costs().current();
+        ++cost.draws;
+        cost.vertices += static_cast<uint64_t>(vid.indexCount) * vid.instanceCount;
+    }
+}
+
+void RecordTraversal::apply(const DrawIndexed& drawIndexed)
+{
+    GPU_INSTRUMENTATION_L3_NCO(instrumentation, *getCommandBuffer(), "DrawIndexed", COLOR_GPU, &drawIndexed);
+
+    if (state->drawBatch.enabled() && !state->capturedCommands)
+    {
+        state->recordForDrawBatch();
+        state->drawBatch.add(*(state->_commandBuffer), drawIndexed.indexCount, drawIndexed.instanceCount, drawIndexed.firstIndex, static_cast<int32_t>(drawIndexed.vertexOffset), drawIndexed.firstInstance);
+    }
+    else
+    {
+        state->record();
+        drawIndexed.record(*(state->_commandBuffer));
+        if (state->capturedCommands) state->capture(drawIndexed);
+    }
+
+    if (recordCosts)
+    {
+        auto& cost = _costs().current();
+        ++cost.draws;
+        cost.vertices += static_cast<uint64_t>(drawIndexed.indexCount) * drawIndexed.instanceCount;
+    }
 }
 
 void RecordTraversal::apply(const Geometry& geometry)
@@ -356,6 +897,9 @@ void RecordTraversal::apply(const Geometry& geometry)
     //debug("Visiting Geometry");
     state->record();
     geometry.record(*(state->_commandBuffer));
+    if (state->capturedCommands) state->capture(geometry);
+
+    if (recordCosts) ++_costs().current().draws;
 }
 
 void RecordTraversal::apply(const Light&)
@@ -370,7 +914,7 @@ void RecordTraversal::apply(const AmbientLight& light)
     CPU_INSTRUMENTATION_L2_O(instrumentation, &light);
 
     //debug("RecordTraversal::apply(AmbientLight) ", light.className());
-    if (light.intensity >= intensityMinimum && viewDependentState) viewDependentState->ambientLights.emplace_back(state->modelviewMatrixStack.top(), &light);
+    if (light.intensity >= intensityMinimum && viewDependentState && !_parallelBatch) viewDependentState->ambientLights.emplace_back(state->modelviewMatrixStack.top(), &light);
 }
 
 void RecordTraversal::apply(const DirectionalLight& light)
@@ -378,7 +922,7 @@ void RecordTraversal::apply(const DirectionalLight& light)
     CPU_INSTRUMENTATION_L2_O(instrumentation, &light);
 
     //debug("RecordTraversal::apply(DirectionalLight) ", light.className());
-    if (light.intensity >= intensityMinimum && viewDependentState) viewDependentState->directionalLights.emplace_back(state->modelviewMatrixStack.top(), &light);
+    if (light.intensity >= intensityMinimum && viewDependentState && !_parallelBatch) viewDependentState->directionalLights.emplace_back(state->modelviewMatrixStack.top(), &light);
 }
 
 void RecordTraversal::apply(const PointLight& light)
@@ -386,7 +930,7 @@ void RecordTraversal::apply(const PointLight& light)
     CPU_INSTRUMENTATION_L2_O(instrumentation, &light);
 
     //debug("RecordTraversal::apply(PointLight) ", light.className());
-    if (light.intensity >= intensityMinimum && viewDependentState) viewDependentState->pointLights.emplace_back(state->modelviewMatrixStack.top(), &light);
+    if (light.intensity >= intensityMinimum && viewDependentState && !_parallelBatch) viewDependentState->pointLights.emplace_back(state->modelviewMatrixStack.top(), &light);
 }
 
 void RecordTraversal::apply(const SpotLight& light)
@@ -394,19 +938,22 @@ void RecordTraversal::apply(const SpotLight& light)
     CPU_INSTRUMENTATION_L2_O(instrumentation, &light);
 
     //debug("RecordTraversal::apply(SpotLight) ", light.className());
-    if (light.intensity >= intensityMinimum && viewDependentState) viewDependentState->spotLights.emplace_back(state->modelviewMatrixStack.top(), &light);
+    if (light.intensity >= intensityMinimum && viewDependentState && !_parallelBatch) viewDependentState->spotLights.emplace_back(state->modelviewMatrixStack.top(), &light);
 }
 
 // transform nodes
 void RecordTraversal::apply(const Transform& transform)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "Transform", COLOR_RECORD_L2, &transform);
+    CostScope costScope(*this, transform);
 
     state->modelviewMatrixStack.push(transform);
     state->dirty = true;
 
     if (transform.subgraphRequiresLocalFrustum)
     {
+        if (cullCache) cullCache->validate(&transform, transform.transform(dmat4()));
+
         state->pushFrustum();
         transform.traverse(*this);
         state->popFrustum();
@@ -423,12 +970,15 @@ void RecordTraversal::apply(const Transform& transform)
 void RecordTraversal::apply(const MatrixTransform& mt)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "MatrixTransform", COLOR_RECORD_L2, &mt);
+    CostScope costScope(*this, mt);
 
     state->modelviewMatrixStack.push(mt);
     state->dirty = true;
 
     if (mt.subgraphRequiresLocalFrustum)
     {
+        if (cullCache) cullCache->validate(&mt, mt.matrix);
+
         state->pushFrustum();
         mt.traverse(*this);
         state->popFrustum();
@@ -452,7 +1002,7 @@ void RecordTraversal::apply(const CoordinateFrame& cf)
 
     if (viewMatrix)
     {
-        state->modelviewMatrixStack.push(viewMatrix->transform(cf.origin) * vsg::rotate(cf.rotation));
+        state->modelviewMatrixStack.push(_originViewMatrix(*viewMatrix, cf.origin) * vsg::rotate(cf.rotation));
     }
     else
     {
@@ -463,6 +1013,8 @@ void RecordTraversal::apply(const CoordinateFrame& cf)
 
     if (cf.subgraphRequiresLocalFrustum)
     {
+        if (cullCache) cullCache->validate(&cf, cf.transform(dmat4()));
+
         state->pushFrustum();
         cf.traverse(*this);
         state->popFrustum();
@@ -476,6 +1028,19 @@ void RecordTraversal::apply(const CoordinateFrame& cf)
     state->dirty = true;
 }
 
+dmat4 RecordTraversal::_originViewMatrix(const ViewMatrix& viewMatrix, const dvec3& origin)
+{
+    for (auto& [entry_origin, matrix] : _originViewMatrices)
+    {
+        if (entry_origin == origin) return matrix;
+    }
+
+    // scenes usually share a handful of origins, keep the linear search short when they don't
+    auto matrix = viewMatrix.transform(origin);
+    if (_originViewMatrices.size() < 16) _originViewMatrices.emplace_back(origin, matrix);
+    return matrix;
+}
+
 // Animation nodes
 void RecordTraversal::apply(const Joint&)
 {
@@ -501,6 +1066,13 @@ void RecordTraversal::apply(const InstanceDraw& instanceDraw)
 
     state->record();
     instanceDraw.record(*(state->_commandBuffer));
+
+    if (recordCosts)
+    {
+        auto& cost = _costs().current();
+        ++cost.draws;
+        if (auto instanceNode = state->_commandBuffer->instanceNode) cost.vertices += static_cast<uint64_t>(instanceDraw.vertexCount) * instanceNode->instanceCount;
+    }
 }
 
 void RecordTraversal::apply(const InstanceDrawIndexed& instanceDrawIndexed)
@@ -509,25 +1081,64 @@ void RecordTraversal::apply(const InstanceDrawIndexed& instanceDrawIndexed)
 
     state->record();
     instanceDrawIndexed.record(*(state->_commandBuffer));
+
+    if (recordCosts)
+    {
+        auto& cost = _costs().current();
+        ++cost.draws;
+        if (auto instanceNode = state->_commandBuffer->instanceNode) cost.vertices += static_cast<uint64_t>(instanceDrawIndexed.indexCount) * instanceNode->instanceCount;
+    }
 }
 
 // Vulkan nodes
 void RecordTraversal::apply(const StateGroup& stateGroup)
 {
     GPU_INSTRUMENTATION_L2_NCO(instrumentation, *getCommandBuffer(), "StateGroup", COLOR_RECORD_L2, &stateGroup);
+    CostScope costScope(*this, stateGroup);
 
     //debug("Visiting StateGroup");
 
+    // skip subgraphs whose GraphicsPipeline is still being created asynchronously
+    for (const auto& stateCommand : stateGroup.stateCommands)
+    {
+        if (stateCommand->slot == 0)
+        {
+            if (auto bindPipeline = stateCommand->cast<BindGraphicsPipeline>(); bindPipeline && !bindPipeline->ready(state->_commandBuffer->viewID)) return;
+        }
+    }
+
     auto begin = stateGroup.stateCommands.begin();
     auto end = stateGroup.stateCommands.end();
 
     state->push(begin, end);
 
+    if (recordCosts) _costs().current().stateBinds += stateGroup.stateCommands.size();
+
     stateGroup.traverse(*this);
 
     state->pop(begin, end);
 }
 
+void RecordTraversal::apply(const StreamingStateGroup& ssg)
+{
+    CPU_INSTRUMENTATION_L2_O(instrumentation, &ssg);
+
+    if (ssg.textureStreamer)
+    {
+        // request the mipmap levels required for the screen space size of the bounding sphere
+        auto lodDistance = state->lodDistance(ssg.bound);
+        if (lodDistance >= 0.0 && !_occluded(ssg.bound))
+        {
+            if (viewDependentState) lodDistance *= viewDependentState->LODScale;
+
+            double screenHeightRatio = (lodDistance > 0.0) ? (ssg.bound.r / lodDistance) : std::numeric_limits<double>::max();
+            ssg.textureStreamer->request(ssg, screenHeightRatio);
+        }
+    }
+
+    apply(static_cast<const StateGroup&>(ssg));
+}
+
 void RecordTraversal::apply(const Commands& commands)
 {
     GPU_INSTRUMENTATION_L3_NCO(instrumentation, *getCommandBuffer(), "Commands", COLOR_GPU, &commands);
@@ -536,6 +1147,7 @@ void RecordTraversal::apply(const Commands& commands)
     for (auto& command : commands.children)
     {
         command->record(*(state->_commandBuffer));
+        if (state->capturedCommands) state->capture(*command);
     }
 }
 
@@ -546,6 +1158,7 @@ void RecordTraversal::apply(const Command& command)
     //debug("Visiting Command");
     state->record();
     command.record(*(state->_commandBuffer));
+    if (state->capturedCommands) state->capture(command);
 }
 
 void RecordTraversal::apply(const Bin& bin)
@@ -561,8 +1174,18 @@ void RecordTraversal::apply(const View& view)
     GPU_INSTRUMENTATION_L1_NCO(instrumentation, *getCommandBuffer(), "View", COLOR_RECORD_L1, &view);
 
     // dirty the state stacks to ensure state is newly applied for the View.
+    state->flushDraws();
     state->dirtyStateStacks();
 
+    // capture the commands recorded for the View when a frame capture has been requested
+    ref_ptr<Commands> capturedCommands;
+    auto cached_capturedCommands = state->capturedCommands;
+    if (frameCapture && frameStamp && frameCapture->capturing(frameStamp->frameCount))
+    {
+        capturedCommands = Commands::create();
+        state->capturedCommands = capturedCommands.get();
+    }
+
     // note, View::accept() updates the RecordTraversal's traversalMask
     auto cached_traversalMask = state->_commandBuffer->traversalMask;
     state->_commandBuffer->traversalMask = traversalMask;
@@ -576,6 +1199,10 @@ void RecordTraversal::apply(const View& view)
     cached_bins.swap(bins);
 
     auto cached_viewDependentState = viewDependentState;
+    auto cached_occlusionBuffer = occlusionBuffer;
+    auto cached_pagedLODOcclusionQueries = pagedLODOcclusionQueries;
+    auto cached_staticTileCache = staticTileCache;
+    auto cached_cullCache = cullCache;
 
     decltype(regionsOfInterest) cached_regionsOfInterest;
     cached_regionsOfInterest.swap(regionsOfInterest);
@@ -605,15 +1232,55 @@ void RecordTraversal::apply(const View& view)
         viewDependentState->LODScale = view.LODScale;
     }
 
+    // expire the tiles of the View's StaticTileCache that are no longer being recorded
+    staticTileCache = view.staticTileCache;
+    if (staticTileCache) staticTileCache->begin(frameStamp ? frameStamp->frameCount : 0);
+
     state->pushView(view);
 
+    auto previous_screenSpaceErrorScale = _screenSpaceErrorScale;
+    auto previous_LODHysteresis = _LODHysteresis;
+    _screenSpaceErrorScale = 0.0;
+    _LODHysteresis = view.LODHysteresis;
+
+    // the origin relative view matrices are only valid for the View's camera in the current frame
+    decltype(_originViewMatrices) cached_originViewMatrices;
+    cached_originViewMatrices.swap(_originViewMatrices);
+
     if (view.camera)
     {
+        // compute the camera matrices once for the frame, as ViewMatrix such as TrackingViewMatrix are costly to evaluate
+        dmat4 projectionMatrix = view.camera->projectionMatrix->transform();
+        dmat4 viewMatrix = view.camera->viewMatrix->transform();
+
         state->inheritViewForLODScaling = (view.features & INHERIT_VIEWPOINT) != 0;
-        state->setProjectionAndViewMatrix(view.camera->projectionMatrix->transform(), view.camera->viewMatrix->transform());
+        state->setProjectionAndViewMatrix(projectionMatrix, viewMatrix);
+
+        // rasterize the occluders collected on the previous frame with the new viewpoint
+        occlusionBuffer = view.occlusionBuffer;
+        if (occlusionBuffer) occlusionBuffer->begin(projectionMatrix, viewMatrix);
+
+        // collect the PagedLOD occlusion query results of previous frames
+        pagedLODOcclusionQueries = view.pagedLODOcclusionQueries;
+        if (pagedLODOcclusionQueries) pagedLODOcclusionQueries->begin(frameStamp ? frameStamp->frameCount : 0);
+
+        dmat4 cullingProjectionMatrix = projectionMatrix;
+        dmat4 cullingViewMatrix = viewMatrix;
+        if (view.cullingCamera)
+        {
+            cullingProjectionMatrix = view.cullingCamera->projectionMatrix->transform();
+            cullingViewMatrix = view.cullingCamera->viewMatrix->transform();
+            state->setCullingProjectionAndViewMatrix(cullingProjectionMatrix, cullingViewMatrix);
+        }
+
+        cullCache = view.cullCache;
+        if (cullCache) cullCache->begin(cullingProjectionMatrix, cullingViewMatrix, view.LODScale);
 
         if (const auto& viewportState = view.camera->viewportState)
         {
+            auto viewportHeight = static_cast<double>(view.camera->getViewport().height);
+            if (viewportHeight > 0.0 && view.maximumScreenSpaceError > 0.0) _screenSpaceErrorScale = viewportHeight / view.maximumScreenSpaceError;
+
             if (viewDependentState)
             {
                 auto& viewportData = viewDependentState->viewportData;
@@ -648,24 +1315,100 @@ void RecordTraversal::apply(const View& view)
         view.traverse(*this);
     }
 
+    // request the PagedLOD that will be required by the predicted viewpoints
+    if (view.prefetchTraversal && view.camera && databasePager) view.prefetchTraversal->prefetch(view, *this);
+
+    // request the PagedLOD around the RegionOfInterest that act as a focus for streaming
+    if (view.camera && databasePager)
+    {
+        auto hasFocus = [](const std::pair<dmat4, const RegionOfInterest*>& entry) { return entry.second->focusRadius > 0.0; };
+        if (std::any_of(regionsOfInterest.begin(), regionsOfInterest.end(), hasFocus))
+        {
+            auto focusTraversal = view.prefetchTraversal;
+            if (!focusTraversal)
+            {
+                if (!_focusTraversal) _focusTraversal = PrefetchTraversal::create();
+                focusTraversal = _focusTraversal;
+            }
+            focusTraversal->focus(view, *this);
+        }
+    }
+
+    // the contents of bins aren't culled in traversal order so aren't cached
+    if (cullCache && cullCache != cached_cullCache) cullCache->end();
+    cullCache = {};
+
     state->popView(view);
 
-    for (auto& bin : view.bins)
+    _originViewMatrices.swap(cached_originViewMatrices);
+    _screenSpaceErrorScale = previous_screenSpaceErrorScale;
+    _LODHysteresis = previous_LODHysteresis;
+
+    if (_secondaryCommandBuffersRequired())
     {
-        bin->accept(*this);
+        // the current subpass doesn't permit inline commands so record the bins into a secondary CommandBuffer
+        bool binsEmpty = true;
+        for (auto& bin : view.bins)
+        {
+            if (!bin->empty()) binsEmpty = false;
+        }
+
+        if (!binsEmpty)
+        {
+            auto& batch = _beginParallelBatch(0);
+            for (auto& bin : view.bins)
+            {
+                bin->accept(*batch.recordTraversal);
+            }
+            _endParallelBatches(1);
+        }
     }
+    else
+    {
+        for (auto& bin : view.bins)
+        {
+            bin->accept(*this);
+        }
+
+        state->flushDraws();
+
+        // query the bounds of the PagedLOD waiting on their high res children against the rendered scene
+        if (pagedLODOcclusionQueries)
+        {
+            pagedLODOcclusionQueries->record(*(state->_commandBuffer));
+            state->dirtyStateStacks();
+        }
+    }
+
+    // occlusion culling doesn't apply to the ViewDependentState's shadow map views
+    occlusionBuffer = {};
+    pagedLODOcclusionQueries = {};
 
     if (viewDependentState)
     {
         viewDependentState->traverse(*this);
     }
 
+    state->flushDraws();
+
     // swap back previous bin setup.
     minimumBinNumber = cached_minimumBinNumber;
     cached_bins.swap(bins);
     cached_regionsOfInterest.swap(regionsOfInterest);
     state->_commandBuffer->traversalMask = cached_traversalMask;
     viewDependentState = cached_viewDependentState;
+    occlusionBuffer = cached_occlusionBuffer;
+    pagedLODOcclusionQueries = cached_pagedLODOcclusionQueries;
+    staticTileCache = cached_staticTileCache;
+    cullCache = cached_cullCache;
+
+    if (capturedCommands)
+    {
+        state->capturedCommands = cached_capturedCommands;
+        frameCapture->add(capturedCommands);
+    }
+
+    if (recordCosts && _costCollector) _costCollector->flush(*recordCosts);
 }
 
 void RecordTraversal::apply(const CommandGraph& commandGraph)
@@ -702,3 +1445,207 @@ void RecordTraversal::addToBin(int32_t binNumber, double value, const Node* node
 {
     bins[binNumber - minimumBinNumber]->add(state, value, node);
 }
+
+bool RecordTraversal::_occluded(const dsphere& bound) const
+{
+    return occlusionBuffer && occlusionBuffer->occluded(bound, state->modelviewMatrixStack.top());
+}
+
+bool RecordTraversal::_intersect(const Node& node, const dsphere& bound)
+{
+    int32_t visible = 0;
+    if (cullCache && cullCache->lookup(&node, visible)) return visible != 0;
+
+    visible = (state->intersect(bound) && !_occluded(bound)) ? 1 : 0;
+    if (cullCache) cullCache->store(&node, visible);
+    return visible != 0;
+}
+
+bool RecordTraversal::_secondaryCommandBuffersRequired() const
+{
+    return state->renderPass != VK_NULL_HANDLE && state->subpassContents == VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS &&
+           state->_commandBuffer->level() == VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+}
+
+RecordTraversal::ParallelBatch& RecordTraversal::_beginParallelBatch(size_t index)
+{
+    CPU_INSTRUMENTATION_L2_NC(instrumentation, "RecordTraversal beginParallelBatch", COLOR_RECORD_L2);
+
+    if (index >= _parallelBatches.size()) _parallelBatches.resize(index + 1);
+
+    auto& batch = _parallelBatches[index];
+    if (!batch.recordTraversal)
+    {
+        batch.recordTraversal = RecordTraversal::create(state->maxSlots);
+        batch.recordTraversal->_parallelBatch = true;
+        batch.recordTraversal->instrumentation = shareOrDuplicateForThreadSafety(instrumentation);
+    }
+
+    auto& rt = *batch.recordTraversal;
+    rt.traversalMask = traversalMask;
+    rt.overrideMask = overrideMask;
+    rt.intensityMinimum = intensityMinimum;
+    rt.recordedCommandBuffers = recordedCommandBuffers;
+    rt.frameStamp = frameStamp;
+    rt.databasePager = databasePager;
+    rt.viewDependentState = viewDependentState;
+    rt.occlusionBuffer = occlusionBuffer;
+    rt.pagedLODOcclusionQueries = pagedLODOcclusionQueries;
+    rt.staticTileCache = staticTileCache;
+    rt._originViewMatrices = _originViewMatrices;
+    rt._screenSpaceErrorScale = _screenSpaceErrorScale;
+    rt._LODHysteresis = _LODHysteresis;
+    rt.cullCache = {}; // batches are traversed concurrently so can't use the traversal order of the CullCache
+    rt.regionsOfInterest.clear();
+    rt.scratchMemory->consolidate();
+
+    // the batch attributes its costs starting from the current cost scope
+    rt.recordCosts = recordCosts;
+    if (recordCosts) rt._costs().inherit(_costs());
+
+    // each batch collects PagedLOD usage in its own container so that results can be merged without locking
+    if (culledPagedLODs)
+    {
+        if (rt.culledPagedLODs)
+            rt.culledPagedLODs->clear();
+        else
+            rt.culledPagedLODs = CulledPagedLODs::create();
+    }
+    else
+    {
+        rt.culledPagedLODs = {};
+    }
+
+    // mirror the current bins so that the batch results can be merged back in batch order
+    rt.minimumBinNumber = minimumBinNumber;
+    rt.bins.resize(bins.size());
+    for (size_t i = 0; i < bins.size(); ++i)
+    {
+        auto& bin = bins[i];
+        auto& batch_bin = rt.bins[i];
+        if (!bin)
+            batch_bin = {};
+        else if (!batch_bin || batch_bin->binNumber != bin->binNumber || batch_bin->sortOrder != bin->sortOrder)
+            batch_bin = Bin::create(bin->binNumber, bin->sortOrder);
+        else
+            batch_bin->clear();
+    }
+
+    auto parentCommandBuffer = state->_commandBuffer;
+
+    // each batch is only ever recorded by one thread at a time so its CommandPoolRing needs no locking
+    if (!batch.commandPoolRing) batch.commandPoolRing = CommandPoolRing::create(parentCommandBuffer->getDevice(), parentCommandBuffer->getCommandPool()->queueFamilyIndex, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    batch.commandPoolRing->advance();
+    auto commandBuffer = batch.commandPoolRing->next();
+
+    commandBuffer->numDependentSubmissions().fetch_add(1);
+    commandBuffer->viewID = parentCommandBuffer->viewID;
+    commandBuffer->traversalMask = parentCommandBuffer->traversalMask;
+    commandBuffer->overrideMask = parentCommandBuffer->overrideMask;
+    commandBuffer->viewDependentState = parentCommandBuffer->viewDependentState;
+    commandBuffer->instanceNode = parentCommandBuffer->instanceNode;
+
+    batch.commandBuffer = commandBuffer;
+
+    // inherit the state stacks, matrices and frustum so the batch records as if it was inline with the parent traversal
+    rt.state->inherit(*state);
+    rt.state->connect(commandBuffer);
+    rt.state->renderPass = state->renderPass;
+    rt.state->framebuffer = state->framebuffer;
+    rt.state->subpass = state->subpass;
+    rt.state->subpassContents = VK_SUBPASS_CONTENTS_INLINE;
+
+    VkCommandBufferInheritanceInfo inheritanceInfo = {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = state->renderPass;
+    inheritanceInfo.subpass = state->subpass;
+    inheritanceInfo.framebuffer = state->framebuffer;
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (state->renderPass != VK_NULL_HANDLE) beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    vkBeginCommandBuffer(*commandBuffer, &beginInfo);
+
+    return batch;
+}
+
+void RecordTraversal::_endParallelBatches(size_t numBatches)
+{
+    CPU_INSTRUMENTATION_L2_NC(instrumentation, "RecordTraversal endParallelBatches", COLOR_RECORD_L2);
+
+    scratch_vector<VkCommandBuffer> vk_commandBuffers(scratchMemory.get());
+    vk_commandBuffers.reserve(numBatches);
+
+    // merge in batch order so that the results are deterministic regardless of which thread recorded each batch
+    for (size_t i = 0; i < numBatches; ++i)
+    {
+        auto& batch = _parallelBatches[i];
+        auto& rt = *batch.recordTraversal;
+
+        rt.state->flushDraws();
+        vkEndCommandBuffer(*batch.commandBuffer);
+
+        recordedCommandBuffers->add(0, batch.commandBuffer);
+        vk_commandBuffers.push_back(*batch.commandBuffer);
+
+        for (size_t b = 0; b < bins.size(); ++b)
+        {
+            if (bins[b] && rt.bins[b] && !rt.bins[b]->empty()) bins[b]->add(*rt.bins[b]);
+        }
+
+        regionsOfInterest.insert(regionsOfInterest.end(), rt.regionsOfInterest.begin(), rt.regionsOfInterest.end());
+
+        if (culledPagedLODs && rt.culledPagedLODs)
+        {
+            auto& src = *rt.culledPagedLODs;
+            culledPagedLODs->highresCulled.insert(culledPagedLODs->highresCulled.end(), src.highresCulled.begin(), src.highresCulled.end());
+            culledPagedLODs->newHighresRequired.insert(culledPagedLODs->newHighresRequired.end(), src.newHighresRequired.begin(), src.newHighresRequired.end());
+        }
+
+        if (recordCosts && rt._costCollector) _costs().merge(*rt._costCollector);
+
+        batch.commandBuffer = {};
+    }
+
+    state->flushDraws();
+    vkCmdExecuteCommands(*(state->_commandBuffer), static_cast<uint32_t>(vk_commandBuffers.size()), vk_commandBuffers.data());
+
+    // state bound in the parent CommandBuffer is undefined after executing secondary CommandBuffers so make sure it's reapplied
+    state->dirtyStateStacks();
+    state->projectionMatrixStack.dirty = true;
+    state->modelviewMatrixStack.dirty = true;
+}
+
+RecordCostCollector& RecordTraversal::_costs()
+{
+    if (!_costCollector) _costCollector.reset(new RecordCostCollector);
+    return *_costCollector;
+}
+
+RecordTraversal::CostScope::CostScope(RecordTraversal& rt, const Node& node)
+{
+    std::string name;
+    if (rt.recordCosts && rt.recordCosts->track(node, name))
+    {
+        collector = &rt._costs();
+        collector->enter(&node, name);
+    }
+}
+
+RecordTraversal::CostScope::CostScope(RecordTraversal& rt, const PagedLOD& plod)
+{
+    std::string name;
+    if (rt.recordCosts && rt.recordCosts->track(plod, name))
+    {
+        collector = &rt._costs();
+        collector->enter(&plod, name);
+    }
+}
+
+RecordTraversal::CostScope::~CostScope()
+{
+    if (collector) collector->leave();
+}
@@ -21,6 +21,144 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 using namespace vsg;
 
+namespace
+{
+    using RenderingAttachment = RenderGraph::RenderingAttachment;
+    using RenderingAttachments = RenderGraph::RenderingAttachments;
+
+    bool hasStencilComponent(VkFormat format)
+    {
+        return (computeAspectFlagsForFormat(format) & VK_IMAGE_ASPECT_STENCIL_BIT) != 0;
+    }
+
+    VkFormat attachmentFormat(const RenderingAttachment& attachment)
+    {
+        if (!attachment.imageView) return VK_FORMAT_UNDEFINED;
+        if (attachment.imageView->format != VK_FORMAT_UNDEFINED) return attachment.imageView->format;
+        return attachment.imageView->image ? attachment.imageView->image->format : VK_FORMAT_UNDEFINED;
+    }
+
+    // set up the attachments that match the Framebuffer attachments that a Window creates for the specified swapchain image
+    void assignWindowAttachments(Window& window, size_t imageIndex, RenderingAttachments& colorAttachments, RenderingAttachment& depthAttachment)
+    {
+        colorAttachments.resize(1);
+        auto& colorAttachment = colorAttachments[0];
+        if (auto multisampleImageView = window.getMultisampleImageView())
+        {
+            colorAttachment.imageView = multisampleImageView;
+            colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            colorAttachment.resolveImageView = window.imageView(imageIndex);
+            colorAttachment.resolveMode = VK_RESOLVE_MODE_AVERAGE_BIT;
+            colorAttachment.resolveFinalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        }
+        else
+        {
+            colorAttachment.imageView = window.imageView(imageIndex);
+            colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        }
+
+        if (auto multisampleDepthImageView = window.getMultisampleDepthImageView())
+        {
+            depthAttachment.imageView = multisampleDepthImageView;
+            depthAttachment.resolveImageView = window.getDepthImageView();
+            depthAttachment.resolveMode = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT;
+        }
+        else
+        {
+            depthAttachment.imageView = window.getDepthImageView();
+        }
+    }
+
+    // pipeline barriers that transition the attachments to their imageLayout before rendering, or to their final layouts after rendering
+    void transitionAttachments(CommandBuffer& commandBuffer, const RenderingAttachments& colorAttachments, const RenderingAttachment& depthAttachment, bool beforeRendering)
+    {
+        std::vector<VkImageMemoryBarrier> barriers;
+        VkPipelineStageFlags srcStageMask = 0;
+        VkPipelineStageFlags dstStageMask = 0;
+
+        auto add = [&](const ref_ptr<ImageView>& imageView, VkImageLayout oldLayout, VkImageLayout newLayout, bool depth) {
+            if (!imageView || !imageView->image) return;
+
+            VkAccessFlags attachmentWrite = depth ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            VkAccessFlags attachmentRead = depth ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT : VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+            VkPipelineStageFlags attachmentStages = depth ? (VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT) : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout = oldLayout;
+            barrier.newLayout = newLayout;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = imageView->image->vk(commandBuffer.deviceID);
+            barrier.subresourceRange = imageView->subresourceRange;
+
+            if (beforeRendering)
+            {
+                // contents of images in an undefined layout are only written by earlier rendering, otherwise wait on all prior work
+                bool discard = (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+                barrier.srcAccessMask = discard ? attachmentWrite : VK_ACCESS_MEMORY_WRITE_BIT;
+                barrier.dstAccessMask = attachmentRead | attachmentWrite;
+                srcStageMask |= discard ? attachmentStages : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+                dstStageMask |= attachmentStages;
+            }
+            else
+            {
+                bool present = (newLayout == VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+                barrier.srcAccessMask = attachmentWrite;
+                barrier.dstAccessMask = present ? 0 : (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT);
+                srcStageMask |= attachmentStages;
+                dstStageMask |= present ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            }
+
+            barriers.push_back(barrier);
+        };
+
+        auto addAttachment = [&](const RenderingAttachment& attachment, bool depth) {
+            if (beforeRendering)
+            {
+                add(attachment.imageView, attachment.initialLayout, attachment.imageLayout, depth);
+                add(attachment.resolveImageView, VK_IMAGE_LAYOUT_UNDEFINED, attachment.imageLayout, depth);
+            }
+            else
+            {
+                if (attachment.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED && attachment.finalLayout != attachment.imageLayout) add(attachment.imageView, attachment.imageLayout, attachment.finalLayout, depth);
+                if (attachment.resolveFinalLayout != VK_IMAGE_LAYOUT_UNDEFINED && attachment.resolveFinalLayout != attachment.imageLayout) add(attachment.resolveImageView, attachment.imageLayout, attachment.resolveFinalLayout, depth);
+            }
+        };
+
+        for (auto& colorAttachment : colorAttachments) addAttachment(colorAttachment, false);
+        addAttachment(depthAttachment, true);
+
+        if (barriers.empty()) return;
+
+        vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(barriers.size()), barriers.data());
+    }
+
+    VkRenderingAttachmentInfoKHR renderingAttachmentInfo(const RenderingAttachment& attachment, uint32_t deviceID, const VkClearValue* clearValue)
+    {
+        VkRenderingAttachmentInfoKHR info = {};
+        info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        info.imageView = attachment.imageView->vk(deviceID);
+        info.imageLayout = attachment.imageLayout;
+        if (attachment.resolveImageView)
+        {
+            info.resolveMode = attachment.resolveMode;
+            info.resolveImageView = attachment.resolveImageView->vk(deviceID);
+            info.resolveImageLayout = attachment.imageLayout;
+        }
+        else
+        {
+            info.resolveMode = VK_RESOLVE_MODE_NONE;
+            info.resolveImageView = VK_NULL_HANDLE;
+            info.resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        }
+        info.loadOp = attachment.loadOp;
+        info.storeOp = attachment.storeOp;
+        if (clearValue) info.clearValue = *clearValue;
+        return info;
+    }
+} // namespace
+
 RenderGraph::RenderGraph() :
     viewportState(ViewportState::create()),
     windowResizeHandler(WindowResizeHandler::create())
@@ -39,6 +177,8 @@ RenderGraph::RenderGraph(ref_ptr<Window> in_window, ref_ptr<View> in_view) :
 
     previous_extent = window->extent2D();
 
+    dynamicRendering = window->traits()->dynamicRendering;
+
     if (in_view && in_view->camera && in_view->camera->viewportState)
     {
         renderArea = in_view->camera->getRenderArea();
@@ -57,7 +197,11 @@ RenderGraph::RenderGraph(ref_ptr<Window> in_window, ref_ptr<View> in_view) :
 
 RenderPass* RenderGraph::getRenderPass()
 {
-    if (renderPass)
+    if (dynamicRendering)
+    {
+        return nullptr;
+    }
+    else if (renderPass)
     {
         return renderPass;
     }
@@ -74,6 +218,18 @@ RenderPass* RenderGraph::getRenderPass()
 
 void RenderGraph::setClearValues(VkClearColorValue clearColor, VkClearDepthStencilValue clearDepthStencil)
 {
+    if (dynamicRendering)
+    {
+        size_t numColorAttachments = (colorAttachments.empty() && window) ? 1 : colorAttachments.size();
+        clearValues.resize(numColorAttachments + 1);
+        for (size_t i = 0; i < numColorAttachments; ++i)
+        {
+            clearValues[i].color = clearColor;
+        }
+        clearValues[numColorAttachments].depthStencil = clearDepthStencil;
+        return;
+    }
+
     auto activeRenderPass = getRenderPass();
     if (!activeRenderPass) return;
 
@@ -92,8 +248,52 @@ void RenderGraph::setClearValues(VkClearColorValue clearColor, VkClearDepthStenc
     }
 }
 
+ref_ptr<RenderingState> RenderGraph::createRenderingState()
+{
+    auto renderingState = RenderingState::create();
+    renderingState->viewMask = viewMask;
+
+    if (colorAttachments.empty() && window)
+    {
+        renderingState->colorAttachmentFormats.push_back(window->surfaceFormat().format);
+        renderingState->depthAttachmentFormat = window->depthFormat();
+    }
+    else
+    {
+        for (auto& colorAttachment : colorAttachments)
+        {
+            renderingState->colorAttachmentFormats.push_back(attachmentFormat(colorAttachment));
+        }
+        renderingState->depthAttachmentFormat = attachmentFormat(depthAttachment);
+    }
+
+    if (hasStencilComponent(renderingState->depthAttachmentFormat)) renderingState->stencilAttachmentFormat = renderingState->depthAttachmentFormat;
+
+    return renderingState;
+}
+
+VkSampleCountFlagBits RenderGraph::getSamples()
+{
+    if (colorAttachments.empty() && window) return window->framebufferSamples();
+
+    for (auto& colorAttachment : colorAttachments)
+    {
+        if (colorAttachment.imageView && colorAttachment.imageView->image) return colorAttachment.imageView->image->samples;
+    }
+
+    if (depthAttachment.imageView && depthAttachment.imageView->image) return depthAttachment.imageView->image->samples;
+
+    return VK_SAMPLE_COUNT_1_BIT;
+}
+
 VkExtent2D RenderGraph::getExtent() const
 {
+    if (dynamicRendering && !colorAttachments.empty())
+    {
+        auto& imageView = colorAttachments.front().imageView;
+        if (imageView && imageView->image) return VkExtent2D{imageView->image->extent.width, imageView->image->extent.height};
+    }
+
     if (framebuffer)
         return framebuffer->extent2D();
     else if (window)
@@ -117,6 +317,74 @@ void RenderGraph::accept(RecordTraversal& recordTraversal) const
         this_renderGraph->resized();
     }
 
+    auto state = recordTraversal.getState();
+    auto& commandBuffer = *(state->_commandBuffer);
+
+    if (dynamicRendering)
+    {
+        auto vkCmdBeginRendering = commandBuffer.getDevice()->getExtensions()->vkCmdBeginRendering;
+        if (!vkCmdBeginRendering)
+        {
+            warn("RenderGraph::accept() dynamicRendering enabled but vkCmdBeginRendering not available, requires VK_KHR_dynamic_rendering or Vulkan 1.3.");
+            return;
+        }
+
+        RenderingAttachments windowColorAttachments;
+        RenderingAttachment windowDepthAttachment = depthAttachment;
+        if (colorAttachments.empty() && window)
+        {
+            size_t imageIndex = window->imageIndex();
+            if (imageIndex >= window->numFrames()) return;
+
+            assignWindowAttachments(*window, imageIndex, windowColorAttachments, windowDepthAttachment);
+        }
+
+        const auto& activeColorAttachments = windowColorAttachments.empty() ? colorAttachments : windowColorAttachments;
+        const auto& activeDepthAttachment = windowColorAttachments.empty() ? depthAttachment : windowDepthAttachment;
+
+        transitionAttachments(commandBuffer, activeColorAttachments, activeDepthAttachment, true);
+
+        auto clearValue = [&](size_t i) { return (i < clearValues.size()) ? &clearValues[i] : nullptr; };
+
+        std::vector<VkRenderingAttachmentInfoKHR> colorAttachmentInfos;
+        colorAttachmentInfos.reserve(activeColorAttachments.size());
+        for (size_t i = 0; i < activeColorAttachments.size(); ++i)
+        {
+            colorAttachmentInfos.push_back(renderingAttachmentInfo(activeColorAttachments[i], commandBuffer.deviceID, clearValue(i)));
+        }
+
+        VkRenderingAttachmentInfoKHR depthAttachmentInfo = {};
+        if (activeDepthAttachment.imageView) depthAttachmentInfo = renderingAttachmentInfo(activeDepthAttachment, commandBuffer.deviceID, clearValue(activeColorAttachments.size()));
+
+        VkRenderingInfoKHR renderingInfo = {};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+        renderingInfo.renderArea = renderArea;
+        renderingInfo.layerCount = layerCount;
+        renderingInfo.viewMask = viewMask;
+        renderingInfo.colorAttachmentCount = static_cast<uint32_t>(colorAttachmentInfos.size());
+        renderingInfo.pColorAttachments = colorAttachmentInfos.data();
+        if (activeDepthAttachment.imageView)
+        {
+            renderingInfo.pDepthAttachment = &depthAttachmentInfo;
+            if (hasStencilComponent(attachmentFormat(activeDepthAttachment))) renderingInfo.pStencilAttachment = &depthAttachmentInfo;
+        }
+
+        state->viewportStateHint = viewportStateHint;
+
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+
+        state->dynamicRendering = true;
+
+        _traverse(recordTraversal);
+
+        commandBuffer.getDevice()->getExtensions()->vkCmdEndRendering(commandBuffer);
+
+        state->dynamicRendering = false;
+
+        transitionAttachments(commandBuffer, activeColorAttachments, activeDepthAttachment, false);
+        return;
+    }
+
     VkRenderPassBeginInfo renderPassInfo = {};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
 
@@ -144,11 +412,27 @@ void RenderGraph::accept(RecordTraversal& recordTraversal) const
     renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     renderPassInfo.pClearValues = clearValues.data();
 
-    recordTraversal.getState()->viewportStateHint = viewportStateHint;
+    state->viewportStateHint = viewportStateHint;
+
+    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
+
+    state->renderPass = renderPassInfo.renderPass;
+    state->framebuffer = renderPassInfo.framebuffer;
+    state->subpass = 0;
+    state->subpassContents = contents;
 
-    VkCommandBuffer vk_commandBuffer = *(recordTraversal.getState()->_commandBuffer);
-    vkCmdBeginRenderPass(vk_commandBuffer, &renderPassInfo, contents);
+    _traverse(recordTraversal);
+
+    vkCmdEndRenderPass(commandBuffer);
+
+    state->renderPass = VK_NULL_HANDLE;
+    state->framebuffer = VK_NULL_HANDLE;
+    state->subpass = 0;
+    state->subpassContents = VK_SUBPASS_CONTENTS_INLINE;
+}
 
+void RenderGraph::_traverse(RecordTraversal& recordTraversal) const
+{
     // sync the viewportState and push
     viewportState->set(renderArea.offset.x, renderArea.offset.y, renderArea.extent.width, renderArea.extent.height);
 
@@ -167,7 +451,8 @@ void RenderGraph::accept(RecordTraversal& recordTraversal) const
         traverse(recordTraversal);
     }
 
-    vkCmdEndRenderPass(vk_commandBuffer);
+    // make sure any coalesced draws are recorded before the render pass ends
+    recordTraversal.getState()->flushDraws();
 }
 
 void RenderGraph::resized()
@@ -176,9 +461,8 @@ void RenderGraph::resized()
     if (!window && !framebuffer) return;
 
     auto activeRenderPass = getRenderPass();
-    if (!activeRenderPass) return;
-
-    auto device = activeRenderPass->device;
+    ref_ptr<Device> device = activeRenderPass ? activeRenderPass->device : (dynamicRendering && window ? window->getDevice() : ref_ptr<Device>());
+    if (!device) return;
 
     auto extent = getExtent();
 
@@ -196,12 +480,19 @@ void RenderGraph::resized()
             windowResizeHandler->context = vsg::Context::create(device, resourceRequirements);
         }
 
-        windowResizeHandler->context->commandPool = nullptr;
-        windowResizeHandler->context->renderPass = activeRenderPass;
+        auto& context = windowResizeHandler->context;
+        context->commandPool = nullptr;
+        context->renderPass = activeRenderPass;
+
+        VkSampleCountFlagBits samples = activeRenderPass ? activeRenderPass->maxSamples : getSamples();
+        if (samples != VK_SAMPLE_COUNT_1_BIT)
+        {
+            mergeGraphicsPipelineStates(context->mask, context->overridePipelineStates, vsg::MultisampleState::create(samples));
+        }
 
-        if (activeRenderPass->maxSamples != VK_SAMPLE_COUNT_1_BIT)
+        if (dynamicRendering)
         {
-            windowResizeHandler->context->overridePipelineStates.emplace_back(vsg::MultisampleState::create(activeRenderPass->maxSamples));
+            mergeGraphicsPipelineStates(context->mask, context->overridePipelineStates, createRenderingState());
         }
 
         // make sure the device is idle before we recreate any Vulkan objects
@@ -0,0 +1,341 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/RenderPassChain.h>
+#include <vsg/commands/NextSubPass.h>
+#include <vsg/core/Exception.h>
+#include <vsg/io/Logger.h>
+
+#include <map>
+
+using namespace vsg;
+
+namespace
+{
+    enum AttachmentUsage : uint32_t
+    {
+        USAGE_NONE = 0,
+        USAGE_COLOR = 1,
+        USAGE_DEPTH_STENCIL = 2,
+        USAGE_INPUT = 4
+    };
+
+    uint32_t attachmentUsage(const RenderPassChain::Pass& pass, uint32_t attachment)
+    {
+        uint32_t usage = USAGE_NONE;
+        for (auto index : pass.colorAttachments)
+            if (index == attachment) usage |= USAGE_COLOR;
+        if (pass.depthStencilAttachment == static_cast<int32_t>(attachment)) usage |= USAGE_DEPTH_STENCIL;
+        for (auto index : pass.inputAttachments)
+            if (index == attachment) usage |= USAGE_INPUT;
+        return usage;
+    }
+
+    bool isDepthStencilFormat(VkFormat format)
+    {
+        return (computeAspectFlagsForFormat(format) & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)) != 0;
+    }
+
+    VkImageLayout usageLayout(uint32_t usage, VkFormat format)
+    {
+        // attachments read and written in the same subpass require the general layout
+        if ((usage & USAGE_INPUT) && (usage & (USAGE_COLOR | USAGE_DEPTH_STENCIL))) return VK_IMAGE_LAYOUT_GENERAL;
+        if (usage & USAGE_COLOR) return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        if (usage & USAGE_DEPTH_STENCIL) return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        if (usage & USAGE_INPUT) return isDepthStencilFormat(format) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        return VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+
+    VkPipelineStageFlags usageStages(uint32_t usage)
+    {
+        VkPipelineStageFlags stages = 0;
+        if (usage & USAGE_COLOR) stages |= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        if (usage & USAGE_DEPTH_STENCIL) stages |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        if (usage & USAGE_INPUT) stages |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        return stages;
+    }
+
+    VkAccessFlags usageWriteAccess(uint32_t usage)
+    {
+        VkAccessFlags access = 0;
+        if (usage & USAGE_COLOR) access |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        if (usage & USAGE_DEPTH_STENCIL) access |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        return access;
+    }
+
+    VkAccessFlags usageAccess(uint32_t usage)
+    {
+        VkAccessFlags access = 0;
+        if (usage & USAGE_COLOR) access |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        if (usage & USAGE_DEPTH_STENCIL) access |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        if (usage & USAGE_INPUT) access |= VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
+        return access;
+    }
+
+    bool supportsLazilyAllocatedMemory(Device* device, uint32_t memoryTypeBits)
+    {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(*(device->getPhysicalDevice()), &memProperties);
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; ++i)
+        {
+            if ((memoryTypeBits & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) != 0) return true;
+        }
+        return false;
+    }
+} // namespace
+
+RenderPassChain::RenderPassChain()
+{
+}
+
+RenderPassChain::RenderPassChain(const VkExtent2D& in_extent) :
+    extent(in_extent)
+{
+}
+
+RenderPassChain::~RenderPassChain()
+{
+}
+
+uint32_t RenderPassChain::addAttachment(const Attachment& attachment)
+{
+    attachments.push_back(attachment);
+    return static_cast<uint32_t>(attachments.size() - 1);
+}
+
+uint32_t RenderPassChain::addPass(const Pass& pass)
+{
+    passes.push_back(pass);
+    return static_cast<uint32_t>(passes.size() - 1);
+}
+
+ref_ptr<RenderPass> RenderPassChain::createRenderPass(Device* device) const
+{
+    if (passes.empty()) throw Exception{"Error: vsg::RenderPassChain::createRenderPass(..) no passes assigned."};
+
+    uint32_t numAttachments = static_cast<uint32_t>(attachments.size());
+    uint32_t numPasses = static_cast<uint32_t>(passes.size());
+    for (auto& pass : passes)
+    {
+        for (auto index : pass.colorAttachments)
+            if (index >= numAttachments) throw Exception{"Error: vsg::RenderPassChain::createRenderPass(..) color attachment index out of range."};
+        for (auto index : pass.inputAttachments)
+            if (index >= numAttachments) throw Exception{"Error: vsg::RenderPassChain::createRenderPass(..) input attachment index out of range."};
+        if (pass.depthStencilAttachment >= static_cast<int32_t>(numAttachments)) throw Exception{"Error: vsg::RenderPassChain::createRenderPass(..) depth/stencil attachment index out of range."};
+    }
+
+    // usage of each attachment by each pass
+    std::vector<std::vector<uint32_t>> usages(numAttachments, std::vector<uint32_t>(numPasses, USAGE_NONE));
+    std::vector<int32_t> firstUse(numAttachments, -1);
+    std::vector<int32_t> lastUse(numAttachments, -1);
+    for (uint32_t a = 0; a < numAttachments; ++a)
+    {
+        for (uint32_t p = 0; p < numPasses; ++p)
+        {
+            usages[a][p] = attachmentUsage(passes[p], a);
+            if (usages[a][p] == USAGE_NONE) continue;
+            if (firstUse[a] < 0) firstUse[a] = static_cast<int32_t>(p);
+            lastUse[a] = static_cast<int32_t>(p);
+        }
+    }
+
+    // attachments are only loaded when their existing contents are required and only stored when they are used after the RenderPass
+    RenderPass::Attachments attachmentDescriptions;
+    for (uint32_t a = 0; a < numAttachments; ++a)
+    {
+        auto& attachment = attachments[a];
+        bool stored = attachment.imageView.valid();
+        bool loaded = !attachment.clear && stored && attachment.initialLayout != VK_IMAGE_LAYOUT_UNDEFINED;
+        bool hasStencil = (computeAspectFlagsForFormat(attachment.format) & VK_IMAGE_ASPECT_STENCIL_BIT) != 0;
+
+        AttachmentDescription description = {};
+        description.flags = 0;
+        description.format = attachment.format;
+        description.samples = attachment.samples;
+        description.loadOp = attachment.clear ? VK_ATTACHMENT_LOAD_OP_CLEAR : (loaded ? VK_ATTACHMENT_LOAD_OP_LOAD : VK_ATTACHMENT_LOAD_OP_DONT_CARE);
+        description.storeOp = stored ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        description.stencilLoadOp = hasStencil ? description.loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        description.stencilStoreOp = hasStencil ? description.storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        description.initialLayout = loaded ? attachment.initialLayout : VK_IMAGE_LAYOUT_UNDEFINED;
+        description.finalLayout = (stored || lastUse[a] < 0) ? attachment.finalLayout : usageLayout(usages[a][lastUse[a]], attachment.format);
+        attachmentDescriptions.push_back(description);
+    }
+
+    RenderPass::Subpasses subpasses;
+    for (uint32_t p = 0; p < numPasses; ++p)
+    {
+        auto& pass = passes[p];
+
+        SubpassDescription subpass = {};
+        subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        for (auto index : pass.colorAttachments)
+        {
+            subpass.colorAttachments.push_back(AttachmentReference{index, usageLayout(usages[index][p], attachments[index].format)});
+        }
+        if (pass.depthStencilAttachment >= 0)
+        {
+            uint32_t index = static_cast<uint32_t>(pass.depthStencilAttachment);
+            subpass.depthStencilAttachments.push_back(AttachmentReference{index, usageLayout(usages[index][p], attachments[index].format)});
+        }
+        for (auto index : pass.inputAttachments)
+        {
+            subpass.inputAttachments.push_back(AttachmentReference{index, usageLayout(usages[index][p], attachments[index].format), computeAspectFlagsForFormat(attachments[index].format)});
+        }
+
+        // keep the contents of attachments that are used before and after this subpass
+        for (uint32_t a = 0; a < numAttachments; ++a)
+        {
+            if (usages[a][p] == USAGE_NONE && firstUse[a] >= 0 && firstUse[a] < static_cast<int32_t>(p) && lastUse[a] > static_cast<int32_t>(p)) subpass.preserveAttachments.push_back(a);
+        }
+
+        subpasses.push_back(subpass);
+    }
+
+    // merge the dependencies between each pair of subpasses that use the same attachments
+    std::map<std::pair<uint32_t, uint32_t>, SubpassDependency> dependencyMap;
+    auto addDependency = [&dependencyMap](uint32_t srcSubpass, uint32_t dstSubpass, VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask) {
+        auto [itr, inserted] = dependencyMap.try_emplace(std::make_pair(srcSubpass, dstSubpass));
+        auto& dependency = itr->second;
+        if (inserted)
+        {
+            dependency.srcSubpass = srcSubpass;
+            dependency.dstSubpass = dstSubpass;
+            dependency.srcStageMask = 0;
+            dependency.dstStageMask = 0;
+            dependency.srcAccessMask = 0;
+            dependency.dstAccessMask = 0;
+            dependency.dependencyFlags = (srcSubpass == VK_SUBPASS_EXTERNAL || dstSubpass == VK_SUBPASS_EXTERNAL) ? 0 : VK_DEPENDENCY_BY_REGION_BIT;
+        }
+        dependency.srcStageMask |= srcStageMask;
+        dependency.dstStageMask |= dstStageMask;
+        dependency.srcAccessMask |= srcAccessMask;
+        dependency.dstAccessMask |= dstAccessMask;
+    };
+
+    for (uint32_t a = 0; a < numAttachments; ++a)
+    {
+        if (firstUse[a] < 0) continue;
+
+        // image layout transition and writes from previous frames or RenderPasses
+        uint32_t first = static_cast<uint32_t>(firstUse[a]);
+        VkPipelineStageFlags attachmentStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        addDependency(VK_SUBPASS_EXTERNAL, first, attachmentStages, usageWriteAccess(USAGE_COLOR | USAGE_DEPTH_STENCIL), usageStages(usages[a][first]), usageAccess(usages[a][first]));
+
+        uint32_t previous = first;
+        for (uint32_t p = first + 1; p < numPasses; ++p)
+        {
+            uint32_t usage = usages[a][p];
+            if (usage == USAGE_NONE) continue;
+
+            // reads following reads need no synchronization
+            uint32_t previousUsage = usages[a][previous];
+            if (usageWriteAccess(previousUsage) != 0 || usageWriteAccess(usage) != 0)
+            {
+                addDependency(previous, p, usageStages(previousUsage), usageWriteAccess(previousUsage), usageStages(usage), usageAccess(usage));
+            }
+            previous = p;
+        }
+
+        // stored attachments may be sampled or copied after the RenderPass
+        if (attachments[a].imageView)
+        {
+            uint32_t last = static_cast<uint32_t>(lastUse[a]);
+            addDependency(last, VK_SUBPASS_EXTERNAL, usageStages(usages[a][last]), usageWriteAccess(usages[a][last]), VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT);
+        }
+    }
+
+    RenderPass::Dependencies dependencies;
+    for (auto& [key, dependency] : dependencyMap) dependencies.push_back(dependency);
+
+    return RenderPass::create(device, attachmentDescriptions, subpasses, dependencies);
+}
+
+ref_ptr<RenderGraph> RenderPassChain::createRenderGraph(Device* device)
+{
+    if (extent.width == 0 || extent.height == 0) throw Exception{"Error: vsg::RenderPassChain::createRenderGraph(..) extent not assigned."};
+
+    auto renderPass = createRenderPass(device);
+
+    ImageViews imageViews;
+    for (uint32_t a = 0; a < static_cast<uint32_t>(attachments.size()); ++a)
+    {
+        auto& attachment = attachments[a];
+        if (attachment.imageView)
+        {
+            attachment.imageView->compile(device);
+            imageViews.push_back(attachment.imageView);
+            continue;
+        }
+
+        // intermediate attachments are only accessed within the RenderPass so can live entirely in tile memory
+        VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        for (auto& pass : passes)
+        {
+            uint32_t passUsage = attachmentUsage(pass, a);
+            if (passUsage & USAGE_COLOR) usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+            if (passUsage & USAGE_DEPTH_STENCIL) usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+            if (passUsage & USAGE_INPUT) usage |= VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        }
+        if (usage == VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) usage |= isDepthStencilFormat(attachment.format) ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+        auto image = Image::create();
+        image->imageType = VK_IMAGE_TYPE_2D;
+        image->extent = VkExtent3D{extent.width, extent.height, 1};
+        image->mipLevels = 1;
+        image->arrayLayers = 1;
+        image->format = attachment.format;
+        image->tiling = VK_IMAGE_TILING_OPTIMAL;
+        image->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        image->samples = attachment.samples;
+        image->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        image->usage = usage;
+
+        image->compile(device);
+
+        // lazily allocated memory is allocated directly rather than from the device's MemoryBufferPools, falling back to device local memory when not supported
+        if (supportsLazilyAllocatedMemory(device, image->getMemoryRequirements(device->deviceID).memoryTypeBits))
+        {
+            image->allocateAndBindMemory(device, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+        }
+        else
+        {
+            debug("RenderPassChain::createRenderGraph(..) lazily allocated memory not supported, using device local memory for transient attachment ", a);
+            image->allocateAndBindMemory(device, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        }
+
+        auto imageView = ImageView::create(image);
+        imageView->compile(device);
+        imageViews.push_back(imageView);
+    }
+
+    auto renderGraph = RenderGraph::create();
+    renderGraph->framebuffer = Framebuffer::create(renderPass, imageViews, extent.width, extent.height, 1);
+    renderGraph->renderArea.offset = {0, 0};
+    renderGraph->renderArea.extent = extent;
+    renderGraph->viewportState->set(0, 0, extent.width, extent.height);
+    renderGraph->contents = passes.front().contents;
+
+    for (auto& attachment : attachments)
+    {
+        renderGraph->clearValues.push_back(attachment.clearValue);
+    }
+
+    for (size_t p = 0; p < passes.size(); ++p)
+    {
+        auto& pass = passes[p];
+        if (p > 0) renderGraph->addChild(NextSubPass::create(pass.contents));
+        if (pass.subgraph) renderGraph->addChild(pass.subgraph);
+    }
+
+    return renderGraph;
+}
@@ -81,6 +81,21 @@ void SecondaryCommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedComma
         return;
     }
 
+    // a window's secondary command buffers are recorded without a framebuffer so can be reused for all the swapchain images
+    const Object* target = framebuffer ? static_cast<const Object*>(framebuffer.get()) : this;
+
+    // resubmit the command buffer previously recorded if nothing has changed
+    if (auto reusedCommandBuffer = _reuseCommandBuffer(target))
+    {
+        reusedCommandBuffer->numDependentSubmissions().fetch_add(1);
+        for (auto& ec : _executeCommands)
+        {
+            ec->completed(*this, reusedCommandBuffer);
+        }
+        recordedCommandBuffers->add(submitOrder, reusedCommandBuffer);
+        return;
+    }
+
     // create the RecordTraversal if it isn't already created
     getOrCreateRecordTraversal();
 
@@ -89,25 +104,7 @@ void SecondaryCommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedComma
     recordTraversal->setDatabasePager(databasePager);
     recordTraversal->clearBins();
 
-    ref_ptr<CommandBuffer> commandBuffer;
-    for (auto& cb : _commandBuffers)
-    {
-        if (cb->numDependentSubmissions() == 0)
-        {
-            commandBuffer = cb;
-            break;
-        }
-    }
-    if (!commandBuffer)
-    {
-        ref_ptr<CommandPool> cp = CommandPool::create(device, queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
-        commandBuffer = cp->allocate(level());
-        _commandBuffers.push_back(commandBuffer);
-    }
-    else
-    {
-        commandBuffer->reset();
-    }
+    auto commandBuffer = _availableCommandBuffer();
 
     commandBuffer->numDependentSubmissions().fetch_add(1);
 
@@ -121,7 +118,7 @@ void SecondaryCommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedComma
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
     beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
-    if (_executeCommands.size() > 1) beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+    if (_executeCommands.size() > 1 || reuseCommandBuffers) beginInfo.flags |= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
 
     VkCommandBufferInheritanceInfo inheritanceInfo;
     inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
@@ -151,9 +148,12 @@ void SecondaryCommandGraph::record(ref_ptr<RecordedCommandBuffers> recordedComma
     vkBeginCommandBuffer(vk_commandBuffer, &beginInfo);
 
     traverse(*recordTraversal);
+    recordTraversal->getState()->flushDraws();
 
     vkEndCommandBuffer(vk_commandBuffer);
 
+    _retainCommandBuffer(target, commandBuffer);
+
     // pass on this command buffer to connected ExecuteCommands nodes
     for (auto& ec : _executeCommands)
     {
@@ -0,0 +1,247 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/RecordTraversal.h>
+#include <vsg/app/StaticTileCache.h>
+#include <vsg/commands/Commands.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/vk/State.h>
+
+using namespace vsg;
+
+namespace
+{
+    struct FlattenStaticSubgraph : public ConstVisitor
+    {
+        explicit FlattenStaticSubgraph(StaticTileCache::Tile& in_tile) :
+            tile(in_tile) {}
+
+        StaticTileCache::Tile& tile;
+        bool isStatic = true;
+
+        void add(StaticTileCache::Operation::Type type, const Node& node)
+        {
+            tile.operations.push_back(StaticTileCache::Operation{type, &node});
+        }
+
+        // nodes without explicit support, such as LOD, PagedLOD, Switch and lights, have view dependent traversals so can't be flattened
+        void apply(const Node&) override
+        {
+            isStatic = false;
+        }
+
+        void apply(const Group& group) override
+        {
+            // subclasses of Group without explicit support may implement their own traversals
+            if (group.type_info() != typeid(Group) && group.type_info() != typeid(CullGroup))
+            {
+                isStatic = false;
+                return;
+            }
+
+            for (const auto& child : group.children)
+            {
+                if (!isStatic) return;
+                child->accept(*this);
+            }
+        }
+
+        void apply(const CullNode& cullNode) override
+        {
+            if (cullNode.type_info() != typeid(CullNode))
+            {
+                isStatic = false;
+                return;
+            }
+
+            if (cullNode.child) cullNode.child->accept(*this);
+        }
+
+        void apply(const StateGroup& stateGroup) override
+        {
+            if (stateGroup.type_info() != typeid(StateGroup))
+            {
+                isStatic = false;
+                return;
+            }
+
+            for (const auto& stateCommand : stateGroup.stateCommands)
+            {
+                if (auto bindPipeline = stateCommand->cast<BindGraphicsPipeline>()) tile.bindPipelines.push_back(bindPipeline);
+            }
+
+            add(StaticTileCache::Operation::PUSH_STATE, stateGroup);
+            for (const auto& child : stateGroup.children)
+            {
+                if (!isStatic) return;
+                child->accept(*this);
+            }
+            add(StaticTileCache::Operation::POP_STATE, stateGroup);
+        }
+
+        void apply(const Transform&) override
+        {
+            // the matrices of other Transform, such as CoordinateFrame and AbsoluteTransform, depend on the view
+            isStatic = false;
+        }
+
+        void apply(const MatrixTransform& mt) override
+        {
+            if (mt.type_info() != typeid(MatrixTransform))
+            {
+                isStatic = false;
+                return;
+            }
+
+            add(StaticTileCache::Operation::PUSH_TRANSFORM, mt);
+            for (const auto& child : mt.children)
+            {
+                if (!isStatic) return;
+                child->accept(*this);
+            }
+            add(StaticTileCache::Operation::POP_TRANSFORM, mt);
+        }
+
+        void apply(const Commands& commands) override
+        {
+            add(StaticTileCache::Operation::RECORD, commands);
+        }
+
+        void apply(const Command& command) override
+        {
+            add(StaticTileCache::Operation::RECORD, command);
+        }
+    };
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StaticTileCache::Tile
+//
+bool StaticTileCache::Tile::ready(uint32_t viewID) const
+{
+    for (const auto& bindPipeline : bindPipelines)
+    {
+        if (!bindPipeline->ready(viewID)) return false;
+    }
+    return true;
+}
+
+void StaticTileCache::Tile::record(RecordTraversal& recordTraversal) const
+{
+    auto& state = *recordTraversal.state;
+    for (const auto& operation : operations)
+    {
+        switch (operation.type)
+        {
+        case (Operation::PUSH_STATE):
+            state.push(static_cast<const StateGroup*>(operation.node)->stateCommands);
+            break;
+        case (Operation::POP_STATE):
+            state.pop(static_cast<const StateGroup*>(operation.node)->stateCommands);
+            break;
+        case (Operation::PUSH_TRANSFORM): {
+            const auto& mt = *static_cast<const MatrixTransform*>(operation.node);
+            state.modelviewMatrixStack.push(mt);
+            state.dirty = true;
+            if (mt.subgraphRequiresLocalFrustum) state.pushFrustum();
+            break;
+        }
+        case (Operation::POP_TRANSFORM): {
+            const auto& mt = *static_cast<const MatrixTransform*>(operation.node);
+            if (mt.subgraphRequiresLocalFrustum) state.popFrustum();
+            state.modelviewMatrixStack.pop();
+            state.dirty = true;
+            break;
+        }
+        case (Operation::RECORD):
+            operation.node->accept(recordTraversal);
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StaticTileCache
+//
+StaticTileCache::StaticTileCache()
+{
+}
+
+StaticTileCache::~StaticTileCache()
+{
+}
+
+void StaticTileCache::begin(uint64_t frameCount)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    if (frameCount == _frameCount) return;
+    _frameCount = frameCount;
+
+    numTilesFlattened = 0;
+    numTilesExpired = 0;
+
+    for (auto itr = _entries.begin(); itr != _entries.end();)
+    {
+        auto& entry = itr->second;
+
+        // remove tiles that haven't been used recently, or whose only remaining reference is the cache's once the DatabasePager has expired their PagedLOD child
+        if ((frameCount - entry.frameLastUsed) > expiryFrames || entry.node->referenceCount() == 1)
+        {
+            itr = _entries.erase(itr);
+            ++numTilesExpired;
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+ref_ptr<const StaticTileCache::Tile> StaticTileCache::getTile(const Node& node, uint64_t frameCount)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& entry = _entries[&node];
+    if (!entry.node)
+    {
+        entry.node = &node;
+        entry.tile = flatten(node);
+        ++numTilesFlattened;
+    }
+
+    entry.frameLastUsed = frameCount;
+    return entry.tile;
+}
+
+ref_ptr<StaticTileCache::Tile> StaticTileCache::flatten(const Node& node)
+{
+    auto tile = Tile::create();
+
+    FlattenStaticSubgraph flattenSubgraph(*tile);
+    node.accept(flattenSubgraph);
+
+    if (!flattenSubgraph.isStatic) return {};
+    return tile;
+}
+
+void StaticTileCache::clear()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _entries.clear();
+}
@@ -0,0 +1,312 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/TerrainHeightCache.h>
+#include <vsg/io/Logger.h>
+#include <vsg/maths/quantize.h>
+#include <vsg/utils/MultiLineSegmentIntersector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+using namespace vsg;
+
+namespace
+{
+    bool sphericalMercator(const std::string& projection)
+    {
+        return projection == "EPSG:3857" || projection == "spherical-mercator";
+    }
+
+    // convert the y coordinate of spherical mercator extents to latitude, matching tile::computeLatitudeLongitudeAltitude(..)
+    double mercatorToLatitude(double y)
+    {
+        return degrees(std::atan(std::sinh(2.0 * radians(y))));
+    }
+
+    double latitudeToMercator(double latitude)
+    {
+        latitude = std::clamp(latitude, -89.999, 89.999);
+        return 0.5 * degrees(std::asinh(std::tan(radians(latitude))));
+    }
+
+    // return the height of the first intersection along the line segment, the line segments start above the terrain so the lowest ratio is the terrain surface
+    bool nearestHeight(const EllipsoidModel& ellipsoidModel, const MultiLineSegmentIntersector::Intersections& intersections, double& height)
+    {
+        const MultiLineSegmentIntersector::Intersection* nearest = nullptr;
+        for (auto& intersection : intersections)
+        {
+            if (!nearest || intersection->ratio < nearest->ratio) nearest = intersection.get();
+        }
+        if (!nearest) return false;
+
+        height = ellipsoidModel.convertECEFToLatLongAltitude(nearest->worldIntersection).z;
+        return true;
+    }
+} // namespace
+
+TerrainHeightCache::TerrainHeightCache(ref_ptr<EllipsoidModel> in_ellipsoidModel, ref_ptr<Node> in_scene) :
+    ellipsoidModel(in_ellipsoidModel),
+    scene(in_scene)
+{
+}
+
+TerrainHeightCache::~TerrainHeightCache()
+{
+}
+
+dvec2 TerrainHeightCache::_project(double latitude, double longitude) const
+{
+    if (sphericalMercator(projection)) return dvec2(longitude, latitudeToMercator(latitude));
+    return dvec2(longitude, latitude);
+}
+
+void TerrainHeightCache::insert(const HeightField& heightField)
+{
+    if (!heightField.heights || heightField.heights->width() < 2 || heightField.heights->height() < 2) return;
+
+    dvec2 tileSize(heightField.extents.max.x - heightField.extents.min.x, heightField.extents.max.y - heightField.extents.min.y);
+    if (tileSize.x <= 0.0 || tileSize.y <= 0.0) return;
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& level = _levels[heightField.level];
+    if (level.tiles.empty())
+    {
+        level.origin.set(heightField.extents.min.x, heightField.extents.min.y);
+        level.tileSize = tileSize;
+    }
+    else if (std::abs(tileSize.x - level.tileSize.x) > level.tileSize.x * 1e-6 || std::abs(tileSize.y - level.tileSize.y) > level.tileSize.y * 1e-6)
+    {
+        warn("TerrainHeightCache::insert(..) heightfield size doesn't match the other heightfields of level ", heightField.level, ", ignoring heightfield.");
+        return;
+    }
+
+    std::pair<int64_t, int64_t> key(static_cast<int64_t>(std::floor((heightField.extents.min.x - level.origin.x) / level.tileSize.x + 0.5)),
+                                    static_cast<int64_t>(std::floor((heightField.extents.min.y - level.origin.y) / level.tileSize.y + 0.5)));
+
+    if (auto itr = level.tiles.find(key); itr != level.tiles.end())
+    {
+        itr->second->heightField = heightField;
+        _entries.splice(_entries.begin(), _entries, itr->second);
+    }
+    else
+    {
+        _entries.push_front(Entry{heightField.level, key, heightField});
+        level.tiles[key] = _entries.begin();
+    }
+
+    // discard the least recently used heightfields
+    while (maxHeightFields > 0 && _entries.size() > maxHeightFields)
+    {
+        auto& entry = _entries.back();
+        if (auto level_itr = _levels.find(entry.level); level_itr != _levels.end())
+        {
+            level_itr->second.tiles.erase(entry.key);
+            if (level_itr->second.tiles.empty()) _levels.erase(level_itr);
+        }
+        _entries.pop_back();
+    }
+}
+
+bool TerrainHeightCache::insert(const dbox& extents, uint32_t level, const Data& elevationData, double elevationScale)
+{
+    uint32_t width = elevationData.width();
+    uint32_t height = elevationData.height();
+    if (elevationData.dimensions() != 2 || width < 2 || height < 2 || !elevationData.dataAvailable()) return false;
+
+    std::function<float(const void*)> getValue;
+    switch (elevationData.properties.format)
+    {
+    case (VK_FORMAT_R32_SFLOAT): getValue = [](const void* ptr) { return *static_cast<const float*>(ptr); }; break;
+    case (VK_FORMAT_R16_SFLOAT): getValue = [](const void* ptr) { return halfToFloat(*static_cast<const uint16_t*>(ptr)); }; break;
+    case (VK_FORMAT_R16_UNORM): getValue = [&](const void* ptr) { return static_cast<float>(double(*static_cast<const uint16_t*>(ptr)) / 65535.0 * elevationScale); }; break;
+    case (VK_FORMAT_R16_SNORM): getValue = [&](const void* ptr) { return static_cast<float>(std::max(double(*static_cast<const int16_t*>(ptr)) / 32767.0, -1.0) * elevationScale); }; break;
+    case (VK_FORMAT_R8_UNORM): getValue = [&](const void* ptr) { return static_cast<float>(double(*static_cast<const uint8_t*>(ptr)) / 255.0 * elevationScale); }; break;
+    default:
+        return false;
+    }
+
+    // heightfield rows run from extents.min.y upwards, top left origin elevation data has its first row at extents.max.y
+    bool flip = elevationData.properties.origin == TOP_LEFT;
+
+    auto heights = floatArray2D::create(width, height);
+    for (uint32_t r = 0; r < height; ++r)
+    {
+        uint32_t source_r = flip ? (height - 1 - r) : r;
+        for (uint32_t c = 0; c < width; ++c)
+        {
+            heights->at(c, r) = getValue(elevationData.dataPointer(static_cast<size_t>(source_r) * width + c));
+        }
+    }
+
+    insert(HeightField{extents, level, heights});
+    return true;
+}
+
+bool TerrainHeightCache::extract(const Node& subgraph, const dbox& extents, uint32_t level, uint32_t numColumns, uint32_t numRows)
+{
+    if (!ellipsoidModel || numColumns < 2 || numRows < 2) return false;
+
+    bool mercator = sphericalMercator(projection);
+
+    MultiLineSegmentIntersector::LineSegments lineSegments;
+    lineSegments.reserve(numColumns * numRows);
+    for (uint32_t r = 0; r < numRows; ++r)
+    {
+        double y = extents.min.y + (extents.max.y - extents.min.y) * double(r) / double(numRows - 1);
+        double latitude = mercator ? mercatorToLatitude(y) : y;
+        for (uint32_t c = 0; c < numColumns; ++c)
+        {
+            double longitude = extents.min.x + (extents.max.x - extents.min.x) * double(c) / double(numColumns - 1);
+            lineSegments.push_back({ellipsoidModel->convertLatLongAltitudeToECEF(dvec3(latitude, longitude, intersectionAltitudeRange)),
+                                    ellipsoidModel->convertLatLongAltitudeToECEF(dvec3(latitude, longitude, -intersectionAltitudeRange))});
+        }
+    }
+
+    auto intersector = MultiLineSegmentIntersector::create(lineSegments);
+    subgraph.accept(*intersector);
+
+    auto heights = floatArray2D::create(numColumns, numRows);
+    std::vector<bool> hit(lineSegments.size(), false);
+    double lowest = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < lineSegments.size(); ++i)
+    {
+        double height = 0.0;
+        if (nearestHeight(*ellipsoidModel, intersector->intersections[i], height))
+        {
+            heights->at(static_cast<uint32_t>(i % numColumns), static_cast<uint32_t>(i / numColumns)) = static_cast<float>(height);
+            hit[i] = true;
+            lowest = std::min(lowest, height);
+        }
+    }
+
+    if (lowest == std::numeric_limits<double>::max()) return false;
+
+    // samples that missed the geometry, such as at gaps between draws, take the lowest height found
+    for (size_t i = 0; i < lineSegments.size(); ++i)
+    {
+        if (!hit[i]) heights->at(static_cast<uint32_t>(i % numColumns), static_cast<uint32_t>(i / numColumns)) = static_cast<float>(lowest);
+    }
+
+    insert(HeightField{extents, level, heights});
+    return true;
+}
+
+bool TerrainHeightCache::_getHeight(const dvec2& coord, double& height)
+{
+    // search from the finest level down
+    for (auto level_itr = _levels.rbegin(); level_itr != _levels.rend(); ++level_itr)
+    {
+        auto& level = level_itr->second;
+        std::pair<int64_t, int64_t> key(static_cast<int64_t>(std::floor((coord.x - level.origin.x) / level.tileSize.x)),
+                                        static_cast<int64_t>(std::floor((coord.y - level.origin.y) / level.tileSize.y)));
+
+        auto itr = level.tiles.find(key);
+        if (itr == level.tiles.end()) continue;
+
+        auto& heightField = itr->second->heightField;
+        const auto& extents = heightField.extents;
+        const auto& heights = *heightField.heights;
+
+        double s = (coord.x - extents.min.x) / (extents.max.x - extents.min.x);
+        double t = (coord.y - extents.min.y) / (extents.max.y - extents.min.y);
+        if (s < -1e-6 || s > 1.0 + 1e-6 || t < -1e-6 || t > 1.0 + 1e-6) continue;
+
+        double x = std::clamp(s, 0.0, 1.0) * double(heights.width() - 1);
+        double y = std::clamp(t, 0.0, 1.0) * double(heights.height() - 1);
+        uint32_t c = std::min(static_cast<uint32_t>(x), heights.width() - 2);
+        uint32_t r = std::min(static_cast<uint32_t>(y), heights.height() - 2);
+        double fx = x - double(c);
+        double fy = y - double(r);
+
+        double bottom = double(heights.at(c, r)) * (1.0 - fx) + double(heights.at(c + 1, r)) * fx;
+        double top = double(heights.at(c, r + 1)) * (1.0 - fx) + double(heights.at(c + 1, r + 1)) * fx;
+        height = bottom * (1.0 - fy) + top * fy;
+
+        _entries.splice(_entries.begin(), _entries, itr->second);
+        return true;
+    }
+    return false;
+}
+
+bool TerrainHeightCache::getHeight(double latitude, double longitude, double& height)
+{
+    auto coord = _project(latitude, longitude);
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    ++numQueries;
+    if (!_getHeight(coord, height)) return false;
+
+    ++numCacheHits;
+    return true;
+}
+
+size_t TerrainHeightCache::getHeights(std::vector<dvec3>& latitudeLongitudeHeights)
+{
+    size_t numAssigned = 0;
+    std::vector<size_t> missing;
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+
+        numQueries += latitudeLongitudeHeights.size();
+        for (size_t i = 0; i < latitudeLongitudeHeights.size(); ++i)
+        {
+            auto& lla = latitudeLongitudeHeights[i];
+            if (_getHeight(_project(lla.x, lla.y), lla.z))
+                ++numAssigned;
+            else
+                missing.push_back(i);
+        }
+        numCacheHits += numAssigned;
+
+        if (!missing.empty() && scene && ellipsoidModel) numIntersections += missing.size();
+    }
+
+    if (missing.empty() || !scene || !ellipsoidModel) return numAssigned;
+
+    // intersect the scene for the locations not yet covered by a heightfield in a single traversal
+    MultiLineSegmentIntersector::LineSegments lineSegments;
+    lineSegments.reserve(missing.size());
+    for (auto i : missing)
+    {
+        const auto& lla = latitudeLongitudeHeights[i];
+        lineSegments.push_back({ellipsoidModel->convertLatLongAltitudeToECEF(dvec3(lla.x, lla.y, intersectionAltitudeRange)),
+                                ellipsoidModel->convertLatLongAltitudeToECEF(dvec3(lla.x, lla.y, -intersectionAltitudeRange))});
+    }
+
+    auto intersector = MultiLineSegmentIntersector::create(lineSegments);
+    scene->accept(*intersector);
+
+    for (size_t m = 0; m < missing.size(); ++m)
+    {
+        if (nearestHeight(*ellipsoidModel, intersector->intersections[m], latitudeLongitudeHeights[missing[m]].z)) ++numAssigned;
+    }
+
+    return numAssigned;
+}
+
+void TerrainHeightCache::clear()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _levels.clear();
+    _entries.clear();
+}
+
+size_t TerrainHeightCache::size() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _entries.size();
+}
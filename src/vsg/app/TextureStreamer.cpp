@@ -0,0 +1,481 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/TextureStreamer.h>
+#include <vsg/app/Viewer.h>
+#include <vsg/core/MipmapLayout.h>
+#include <vsg/core/Objects.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/read.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/DescriptorImage.h>
+#include <vsg/threading/atomics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+using namespace vsg;
+
+namespace
+{
+    using ImageInfoReplacements = std::map<const ImageInfo*, ref_ptr<ImageInfo>>;
+
+    template<class A>
+    ref_ptr<Data> createArray2D(uint32_t width, uint32_t height, const uint8_t* source, size_t size, Data::Properties properties, MipmapLayout* mipmapLayout)
+    {
+        using value_type = typename A::value_type;
+        auto values = new value_type[size / sizeof(value_type)];
+        std::memcpy(static_cast<void*>(values), source, size);
+
+        properties.allocatorType = ALLOCATOR_TYPE_NEW_DELETE;
+        return A::create(width, height, values, properties, mipmapLayout);
+    }
+
+    ref_ptr<Data> createArray2D(size_t valueSize, uint32_t width, uint32_t height, const uint8_t* source, size_t size, const Data::Properties& properties, MipmapLayout* mipmapLayout)
+    {
+        switch (valueSize)
+        {
+        case 1: return createArray2D<ubyteArray2D>(width, height, source, size, properties, mipmapLayout);
+        case 2: return createArray2D<ushortArray2D>(width, height, source, size, properties, mipmapLayout);
+        case 3: return createArray2D<ubvec3Array2D>(width, height, source, size, properties, mipmapLayout);
+        case 4: return createArray2D<ubvec4Array2D>(width, height, source, size, properties, mipmapLayout);
+        case 6: return createArray2D<usvec3Array2D>(width, height, source, size, properties, mipmapLayout);
+        case 8: return createArray2D<block64Array2D>(width, height, source, size, properties, mipmapLayout);
+        case 12: return createArray2D<vec3Array2D>(width, height, source, size, properties, mipmapLayout);
+        case 16: return createArray2D<block128Array2D>(width, height, source, size, properties, mipmapLayout);
+        default: return {};
+        }
+    }
+
+    /// return a copy of the DescriptorSet with the ImageInfo replaced, or null if the DescriptorSet doesn't reference any of the ImageInfo being replaced.
+    ref_ptr<DescriptorSet> replaceImageInfos(const DescriptorSet* descriptorSet, const ImageInfoReplacements& replacements)
+    {
+        if (!descriptorSet) return {};
+
+        bool replaced = false;
+        Descriptors descriptors;
+        for (auto& descriptor : descriptorSet->descriptors)
+        {
+            auto descriptorImage = descriptor.cast<DescriptorImage>();
+            if (!descriptorImage)
+            {
+                descriptors.push_back(descriptor);
+                continue;
+            }
+
+            bool replacedImage = false;
+            ImageInfoList imageInfoList = descriptorImage->imageInfoList;
+            for (auto& imageInfo : imageInfoList)
+            {
+                if (auto itr = replacements.find(imageInfo.get()); itr != replacements.end())
+                {
+                    imageInfo = itr->second;
+                    replacedImage = true;
+                }
+            }
+
+            if (replacedImage)
+            {
+                descriptors.push_back(DescriptorImage::create(imageInfoList, descriptorImage->dstBinding, descriptorImage->dstArrayElement, descriptorImage->descriptorType));
+                replaced = true;
+            }
+            else
+            {
+                descriptors.push_back(descriptor);
+            }
+        }
+
+        if (!replaced) return {};
+        return DescriptorSet::create(descriptorSet->setLayout, descriptors);
+    }
+
+    struct AssignTextureStreamer : public Visitor
+    {
+        ref_ptr<TextureStreamer> textureStreamer;
+
+        explicit AssignTextureStreamer(TextureStreamer* in_textureStreamer) :
+            textureStreamer(in_textureStreamer) {}
+
+        void apply(Object& object) override
+        {
+            object.traverse(*this);
+        }
+
+        void apply(StreamingStateGroup& ssg) override
+        {
+            ssg.textureStreamer = textureStreamer;
+            ssg.traverse(*this);
+        }
+    };
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// TextureStreamer
+//
+TextureStreamer::TextureStreamer(Viewer* viewer) :
+    _viewer(viewer),
+    _status(ActivityStatus::create(false))
+{
+    _deleteQueue = DeleteQueue::create(_status);
+}
+
+TextureStreamer::~TextureStreamer()
+{
+    stop();
+}
+
+void TextureStreamer::assign(Object& object)
+{
+    AssignTextureStreamer assignTextureStreamer(this);
+    object.accept(assignTextureStreamer);
+}
+
+void TextureStreamer::start()
+{
+    if (!_threads.empty()) return;
+
+    if (!compileManager)
+    {
+        // take a ref_ptr<> of the observer_ptr<> to be able to safely access it
+        ref_ptr<Viewer> viewer = _viewer;
+        if (viewer) compileManager = viewer->compileManager;
+    }
+
+    if (!compileManager)
+    {
+        warn("TextureStreamer::start() no CompileManager assigned, call Viewer::compile() before starting the TextureStreamer.");
+        return;
+    }
+
+    _status->set(true);
+
+    auto streamThread = [](TextureStreamer& textureStreamer) {
+        debug("Started TextureStreamer stream thread");
+
+        while (textureStreamer._status->active())
+        {
+            if (auto ssg = textureStreamer._takeRequest()) textureStreamer._stream(ssg);
+        }
+
+        debug("Finished TextureStreamer stream thread");
+    };
+
+    auto deleteThread = [](TextureStreamer& textureStreamer) {
+        debug("Started TextureStreamer delete thread");
+
+        while (textureStreamer._status->active())
+        {
+            textureStreamer._deleteQueue->wait_then_clear();
+        }
+
+        debug("Finished TextureStreamer delete thread");
+    };
+
+    _threads.emplace_back(streamThread, std::ref(*this));
+    _threads.emplace_back(deleteThread, std::ref(*this));
+}
+
+void TextureStreamer::stop()
+{
+    if (_threads.empty()) return;
+
+    _status->set(false);
+    _requestCV.notify_all();
+
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+    _threads.clear();
+
+    // release any outstanding requests so they can be requested again if the TextureStreamer is restarted.
+    std::scoped_lock<std::mutex> lock(_requestMutex);
+    for (auto& ssg : _requests)
+    {
+        ssg->requestStatus = StreamingStateGroup::NoRequest;
+    }
+    numActiveRequests -= _requests.size();
+    _requests.clear();
+}
+
+void TextureStreamer::request(const StreamingStateGroup& ssg, double screenHeightRatio)
+{
+    // number of pixels spanned by the bounding sphere's diameter
+    double pixels = 2.0 * screenHeightRatio * screenHeight;
+
+    bool required = false;
+    for (auto& texture : ssg.textures)
+    {
+        if (!texture) continue;
+
+        uint32_t maxLevel = std::max(texture->mipLevels, 1u) - 1;
+        uint32_t requiredLevel = maxLevel;
+        if (pixels > 0.0)
+        {
+            double level = std::log2(static_cast<double>(std::max(texture->width, texture->height)) / pixels) + levelBias;
+            requiredLevel = (level > 0.0) ? std::min(static_cast<uint32_t>(level), maxLevel) : 0;
+        }
+
+        texture->requestedLevel = requiredLevel;
+
+        uint32_t residentLevel = texture->residentLevel;
+        if (requiredLevel < residentLevel || requiredLevel > residentLevel + evictionHysteresis) required = true;
+    }
+
+    if (!required || !_status->active()) return;
+
+    ssg.priority = screenHeightRatio;
+
+    if (compare_exchange(ssg.requestStatus, StreamingStateGroup::NoRequest, StreamingStateGroup::StreamRequest))
+    {
+        ++numActiveRequests;
+
+        std::scoped_lock<std::mutex> lock(_requestMutex);
+        _requests.emplace_back(const_cast<StreamingStateGroup*>(&ssg));
+        _requestCV.notify_one();
+    }
+}
+
+ref_ptr<StreamingStateGroup> TextureStreamer::_takeRequest()
+{
+    std::chrono::duration waitDuration = std::chrono::milliseconds(100);
+    std::unique_lock lock(_requestMutex);
+
+    // wait until the conditional variable signals that a request has been added
+    while (_requests.empty() && _status->active())
+    {
+        _requestCV.wait_for(lock, waitDuration);
+    }
+
+    if (_requests.empty() || !_status->active()) return {};
+
+    // take the highest priority request, the priorities are updated by the RecordTraversal so have to be searched each time.
+    auto itr = std::max_element(_requests.begin(), _requests.end(), [](const ref_ptr<StreamingStateGroup>& lhs, const ref_ptr<StreamingStateGroup>& rhs) { return lhs->priority < rhs->priority; });
+    auto ssg = *itr;
+    _requests.erase(itr);
+
+    ssg->requestStatus = StreamingStateGroup::Streaming;
+    return ssg;
+}
+
+void TextureStreamer::_stream(ref_ptr<StreamingStateGroup> ssg)
+{
+    Replacement replacement;
+    replacement.stateGroup = ssg;
+
+    // create the images containing the required mipmap levels
+    ImageInfoReplacements imageInfoReplacements;
+    for (auto& texture : ssg->textures)
+    {
+        if (!texture || !texture->imageInfo) continue;
+
+        uint32_t residentLevel = texture->residentLevel;
+        uint32_t requestedLevel = texture->requestedLevel;
+        if (requestedLevel == residentLevel || (requestedLevel > residentLevel && requestedLevel <= residentLevel + evictionHysteresis)) continue;
+
+        auto data = texture->data;
+        if (!data && texture->filename) data = read_cast<Data>(texture->filename, texture->options);
+
+        auto subset = mipmapSubset(data, requestedLevel);
+        if (!subset)
+        {
+            warn("TextureStreamer unable to create mipmap level ", requestedLevel, " for ", texture, " ", texture->filename);
+            continue;
+        }
+
+        auto imageInfo = ImageInfo::create(texture->imageInfo->sampler, subset, texture->imageInfo->imageLayout);
+        imageInfoReplacements[texture->imageInfo.get()] = imageInfo;
+
+        replacement.textures.emplace_back(texture, requestedLevel);
+        replacement.imageInfos.push_back(imageInfo);
+    }
+
+    // create replacements for the state commands that reference the textures being updated.
+    auto objects = Objects::create();
+    if (!imageInfoReplacements.empty())
+    {
+        for (auto& stateCommand : ssg->stateCommands)
+        {
+            ref_ptr<StateCommand> replacementCommand;
+            if (auto bds = stateCommand.cast<BindDescriptorSet>(); bds && bds->type_info() == typeid(BindDescriptorSet))
+            {
+                if (auto descriptorSet = replaceImageInfos(bds->descriptorSet, imageInfoReplacements))
+                {
+                    auto new_bds = BindDescriptorSet::create(bds->pipelineBindPoint, bds->layout, bds->firstSet, descriptorSet);
+                    new_bds->slot = bds->slot;
+                    new_bds->dynamicOffsets = bds->dynamicOffsets;
+                    replacementCommand = new_bds;
+                }
+            }
+            else if (auto bdss = stateCommand.cast<BindDescriptorSets>())
+            {
+                bool replaced = false;
+                DescriptorSets descriptorSets = bdss->descriptorSets;
+                for (auto& descriptorSet : descriptorSets)
+                {
+                    if (auto new_descriptorSet = replaceImageInfos(descriptorSet, imageInfoReplacements))
+                    {
+                        descriptorSet = new_descriptorSet;
+                        replaced = true;
+                    }
+                }
+
+                if (replaced)
+                {
+                    auto new_bdss = BindDescriptorSets::create(bdss->pipelineBindPoint, bdss->layout, bdss->firstSet, descriptorSets);
+                    new_bdss->slot = bdss->slot;
+                    new_bdss->dynamicOffsets = bdss->dynamicOffsets;
+                    replacementCommand = new_bdss;
+                }
+            }
+
+            if (replacementCommand)
+            {
+                objects->addChild(replacementCommand);
+                replacement.replacedStateCommands.push_back(stateCommand);
+                replacement.stateCommands.push_back(replacementCommand);
+            }
+            else
+            {
+                replacement.stateCommands.push_back(stateCommand);
+            }
+        }
+    }
+
+    if (objects->children.empty())
+    {
+        if (!replacement.textures.empty()) warn("TextureStreamer::_stream(", ssg, ") no descriptors found referencing the StreamedTexture::imageInfo.");
+
+        ssg->requestStatus = StreamingStateGroup::NoRequest;
+        --numActiveRequests;
+        return;
+    }
+
+    auto result = compileManager->compile(objects);
+    if (!result)
+    {
+        warn("TextureStreamer::_stream(", ssg, ") compile failed, ", result.message);
+
+        ssg->requestStatus = StreamingStateGroup::NoRequest;
+        --numActiveRequests;
+        return;
+    }
+
+    ssg->requestStatus = StreamingStateGroup::MergeRequest;
+
+    std::scoped_lock<std::mutex> lock(_mergeMutex);
+    _toMerge.push_back(std::move(replacement));
+}
+
+void TextureStreamer::run()
+{
+    {
+        // take a ref_ptr<> of the observer_ptr<> to be able to safely access it
+        ref_ptr<Viewer> viewer = _viewer;
+        if (viewer) _deleteQueue->advance(ref_ptr<FrameStamp>(viewer->getFrameStamp()));
+    }
+
+    std::list<Replacement> toMerge;
+    {
+        std::scoped_lock<std::mutex> lock(_mergeMutex);
+        toMerge.swap(_toMerge);
+    }
+
+    for (auto& replacement : toMerge)
+    {
+        auto& ssg = replacement.stateGroup;
+        ssg->stateCommands.swap(replacement.stateCommands);
+
+        for (size_t i = 0; i < replacement.textures.size(); ++i)
+        {
+            auto& [texture, level] = replacement.textures[i];
+            texture->imageInfo = replacement.imageInfos[i];
+            texture->residentLevel = level;
+        }
+
+        // previous descriptor sets and images may still be in use by frames in flight so defer their deletion
+        _deleteQueue->add(replacement.replacedStateCommands);
+
+        ssg->requestStatus = StreamingStateGroup::NoRequest;
+        --numActiveRequests;
+    }
+}
+
+ref_ptr<Data> TextureStreamer::mipmapSubset(ref_ptr<Data> data, uint32_t firstLevel)
+{
+    if (!data || data->dimensions() != 2) return {};
+
+    uint32_t numLevels = std::max(uint32_t(data->properties.mipLevels), 1u);
+    if (firstLevel >= numLevels) return {};
+    if (firstLevel == 0) return data;
+
+    const auto& properties = data->properties;
+    size_t valueSize = data->valueSize();
+    if (properties.stride != valueSize) return {};
+
+    uint32_t blockWidth = std::max(uint32_t(properties.blockWidth), 1u);
+    uint32_t blockHeight = std::max(uint32_t(properties.blockHeight), 1u);
+
+    // pixel dimensions and byte offsets of each of the mipmap levels
+    std::vector<uivec4> levels(numLevels);
+    auto sourceLayout = data->getMipmapLayout();
+    if (sourceLayout)
+    {
+        if (sourceLayout->size() < numLevels) return {};
+        for (uint32_t i = 0; i < numLevels; ++i) levels[i] = sourceLayout->at(i);
+    }
+    else
+    {
+        uint32_t x = data->width() * blockWidth;
+        uint32_t y = data->height() * blockHeight;
+        size_t offset = 0;
+        for (uint32_t i = 0; i < numLevels; ++i)
+        {
+            levels[i] = uivec4(x, y, 1, static_cast<uint32_t>(offset));
+            offset += static_cast<size_t>((x + blockWidth - 1) / blockWidth) * ((y + blockHeight - 1) / blockHeight) * valueSize;
+            if (x > 1) x = x / 2;
+            if (y > 1) y = y / 2;
+        }
+    }
+
+    size_t begin = levels[firstLevel].w;
+    size_t end = data->dataSize();
+    if (begin >= end) return {};
+
+    // block compressed levels needn't be a multiple of the block size so record the pixel dimensions in a MipmapLayout
+    ref_ptr<MipmapLayout> mipmapLayout;
+    if (sourceLayout || blockWidth > 1 || blockHeight > 1)
+    {
+        mipmapLayout = MipmapLayout::create(numLevels - firstLevel);
+        for (uint32_t i = firstLevel; i < numLevels; ++i)
+        {
+            const auto& level = levels[i];
+            mipmapLayout->set(i - firstLevel, uivec4(level.x, level.y, level.z, static_cast<uint32_t>(level.w - begin)));
+        }
+    }
+
+    Data::Properties subsetProperties = properties;
+    subsetProperties.mipLevels = static_cast<uint8_t>(numLevels - firstLevel);
+
+    uint32_t width = (levels[firstLevel].x + blockWidth - 1) / blockWidth;
+    uint32_t height = (levels[firstLevel].y + blockHeight - 1) / blockHeight;
+
+    auto subset = createArray2D(valueSize, width, height, static_cast<const uint8_t*>(data->dataPointer()) + begin, end - begin, subsetProperties, mipmapLayout.get());
+    if (subset) subset->dirty();
+    return subset;
+}
@@ -47,8 +47,19 @@ void Trackball::clampToGlobe()
     double ratio = location_eye.z / (location_eye.z - location_center.z);
     auto location = _ellipsoidModel->convertECEFToLatLongAltitude(_lookAt->center * ratio + _lookAt->eye * (1.0 - ratio));
 
+    // look up the terrain height at the center and below the eye in one batch, falling back to the ellipsoid where no height is available
+    double center_terrain_height = 0.0;
+    double eye_terrain_height = 0.0;
+    if (terrainHeightCache)
+    {
+        std::vector<dvec3> latitudeLongitudeHeights{dvec3(location.x, location.y, 0.0), dvec3(location_eye.x, location_eye.y, 0.0)};
+        terrainHeightCache->getHeights(latitudeLongitudeHeights);
+        center_terrain_height = latitudeLongitudeHeights[0].z;
+        eye_terrain_height = latitudeLongitudeHeights[1].z;
+    }
+
     // clamp to the globe
-    location.z = 0.0;
+    location.z = center_terrain_height;
 
     // compute clamped position back in ECEF
     auto ecef = _ellipsoidModel->convertLatLongAltitudeToECEF(location);
@@ -56,7 +67,7 @@ void Trackball::clampToGlobe()
     // apply the new clamped position to the LookAt.
     _lookAt->center = ecef;
 
-    double minimum_altitude = 0.1;
+    double minimum_altitude = eye_terrain_height + 0.1;
     if (location_eye.z < minimum_altitude)
     {
         location_eye.z = minimum_altitude;
@@ -16,8 +16,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 #include <vsg/ui/ApplicationEvent.h>
 #include <vsg/utils/Instrumentation.h>
+#include <vsg/utils/ProcessImages.h>
 #include <vsg/vk/State.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 TransferTask::TransferTask(Device* in_device, uint32_t numBuffers) :
@@ -38,6 +41,20 @@ TransferTask::TransferTask(Device* in_device, uint32_t numBuffers) :
     // level = Logger::LOGGER_INFO;
 }
 
+TransferTask::~TransferTask()
+{
+    // move any data relocated into mapped memory back into memory owned by the Data before unmapping
+    for (auto& data : _relocatedData)
+    {
+        data->relocate({}, 0);
+    }
+
+    for (auto& [deviceMemory, mapped] : _mappedDeviceMemory)
+    {
+        if (mapped) deviceMemory->unmap();
+    }
+}
+
 bool TransferTask::containsDataToTransfer(TransferMask transferMask) const
 {
     std::scoped_lock<std::mutex> lock(_mutex);
@@ -45,10 +62,25 @@ bool TransferTask::containsDataToTransfer(TransferMask transferMask) const
            (((transferMask & TRANSFER_AFTER_RECORD_TRAVERSAL) != 0) && _lateDataToCopy.containsDataToTransfer());
 }
 
-void TransferTask::assignTransferConsumedCompletedSemaphore(TransferMask transferMask, ref_ptr<Semaphore> semaphore)
+bool TransferTask::requiresTransfer(TransferMask transferMask) const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return (((transferMask & TRANSFER_BEFORE_RECORD_TRAVERSAL) != 0) && _earlyDataToCopy.requiresCopy(device->deviceID)) ||
+           (((transferMask & TRANSFER_AFTER_RECORD_TRAVERSAL) != 0) && _lateDataToCopy.requiresCopy(device->deviceID));
+}
+
+void TransferTask::assignTransferConsumedCompletedSemaphore(TransferMask transferMask, ref_ptr<Semaphore> semaphore, uint64_t value)
 {
-    if ((transferMask & TRANSFER_BEFORE_RECORD_TRAVERSAL) != 0) _earlyDataToCopy.transferConsumerCompletedSemaphore = semaphore;
-    if ((transferMask & TRANSFER_AFTER_RECORD_TRAVERSAL) != 0) _lateDataToCopy.transferConsumerCompletedSemaphore = semaphore;
+    if ((transferMask & TRANSFER_BEFORE_RECORD_TRAVERSAL) != 0)
+    {
+        _earlyDataToCopy.transferConsumerCompletedSemaphore = semaphore;
+        _earlyDataToCopy.transferConsumerCompletedValue = value;
+    }
+    if ((transferMask & TRANSFER_AFTER_RECORD_TRAVERSAL) != 0)
+    {
+        _lateDataToCopy.transferConsumerCompletedSemaphore = semaphore;
+        _lateDataToCopy.transferConsumerCompletedValue = value;
+    }
 }
 
 void TransferTask::assign(const DynamicData& dynamicData)
@@ -124,6 +156,9 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
     {
         auto& bufferInfos = buffer_itr->second;
 
+        // write directly to the buffer's memory when it's host visible, skipping the staging buffer and copy command
+        char* direct_ptr = _directWritePointer(buffer_itr->first);
+
         uint32_t regionCount = 0;
         log(level, "    copying bufferInfos.size() = ", bufferInfos.size(), "{");
         for (auto bufferInfo_itr = bufferInfos.begin(); bufferInfo_itr != bufferInfos.end();)
@@ -132,23 +167,110 @@ void TransferTask::_transferBufferInfos(DataToCopy& dataToCopy, VkCommandBuffer
             if (bufferInfo->referenceCount() == 1)
             {
                 log(level, "    BufferInfo only ref left ", bufferInfo, ", ", bufferInfo->referenceCount());
+                if (auto data_itr = _relocatedData.find(bufferInfo->data); data_itr != _relocatedData.end())
+                {
+                    bufferInfo->data->relocate({}, 0);
+                    _relocatedData.erase(data_itr);
+                }
                 bufferInfo_itr = bufferInfos.erase(bufferInfo_itr);
             }
             else
             {
+                // the ranges are computed before syncing the modified counts as only the ranges marked since the last copy are valid
+                auto dirtyRanges = bufferInfo->dirtyRanges(deviceID);
                 if (bufferInfo->syncModifiedCounts(deviceID))
                 {
-                    // copy data to staging buffer memory
-                    char* ptr = reinterpret_cast<char*>(buffer_data) + offset;
-                    std::memcpy(ptr, bufferInfo->data->dataPointer(), bufferInfo->range);
-
-                    // record region
-                    pRegions[regionCount++] = VkBufferCopy{offset, bufferInfo->offset, bufferInfo->range};
-
-                    log(level, "       copying ", bufferInfo, ", ", bufferInfo->data, " to ", static_cast<void*>(ptr));
-
-                    VkDeviceSize endOfEntry = offset + bufferInfo->range;
-                    offset = (/*alignment == 1 ||*/ (endOfEntry % alignment) == 0) ? endOfEntry : ((endOfEntry / alignment) + 1) * alignment;
+                    const char* data_ptr = reinterpret_cast<const char*>(bufferInfo->data->dataPointer());
+
+                    if (auto compressed = bufferInfo->data.cast<CompressedData>())
+                    {
+                        // compressed data is static so always copied in full
+                        VkDeviceSize copySize = compressed->dataSize();
+                        if (direct_ptr)
+                        {
+                            copyData(*compressed, direct_ptr + bufferInfo->offset);
+
+                            log(level, "       decompressing directly ", bufferInfo, ", ", bufferInfo->data, " to ", static_cast<void*>(direct_ptr + bufferInfo->offset));
+                        }
+                        else if (vk_commandBuffer && _decompressOnGpu(frame, *compressed))
+                        {
+                            copySize = compressed->payload->dataSize();
+                            std::memcpy(reinterpret_cast<char*>(buffer_data) + offset, compressed->payload->dataPointer(), copySize);
+                            gpuDecompressor->add(compressed, staging, offset, buffer_itr->first, bufferInfo->offset);
+
+                            log(level, "       copying compressed ", bufferInfo, ", ", bufferInfo->data, " for decompression, payload size = ", copySize);
+                        }
+                        else
+                        {
+                            copyData(*compressed, reinterpret_cast<char*>(buffer_data) + offset);
+                            pRegions[regionCount++] = VkBufferCopy{offset, bufferInfo->offset, copySize};
+
+                            log(level, "       decompressing ", bufferInfo, ", ", bufferInfo->data, " to staging offset ", offset);
+                        }
+
+                        if (!direct_ptr)
+                        {
+                            VkDeviceSize endOfEntry = offset + copySize;
+                            offset = (/*alignment == 1 ||*/ (endOfEntry % alignment) == 0) ? endOfEntry : ((endOfEntry / alignment) + 1) * alignment;
+                        }
+                    }
+                    else if (direct_ptr)
+                    {
+                        char* ptr = direct_ptr + bufferInfo->offset;
+                        if (ptr != data_ptr)
+                        {
+                            for (auto& dirtyRange : dirtyRanges)
+                            {
+                                std::memcpy(ptr + dirtyRange.begin, data_ptr + dirtyRange.begin, dirtyRange.end - dirtyRange.begin);
+                            }
+
+                            log(level, "       writing directly ", bufferInfo, ", ", bufferInfo->data, " to ", static_cast<void*>(ptr), ", dirtyRanges.size() = ", dirtyRanges.size());
+
+                            if (mapDataToDeviceMemory && bufferInfo->data->dynamic() && bufferInfo->data->dataSize() <= bufferInfo->range)
+                            {
+                                Data::Properties properties;
+                                properties.allocatorType = ALLOCATOR_TYPE_NO_DELETE;
+                                auto storage = ubyteArray::create(static_cast<uint32_t>(bufferInfo->range), reinterpret_cast<uint8_t*>(ptr), properties);
+                                if (bufferInfo->data->relocate(storage, 0))
+                                {
+                                    _relocatedData.insert(bufferInfo->data);
+
+                                    log(level, "       relocated ", bufferInfo->data, " to ", static_cast<void*>(ptr));
+                                }
+                            }
+                        }
+                    }
+                    else
+                    {
+                        // the ranges are placed in the staging memory at the same relative positions as in data, so the space used never exceeds the range reserved for the BufferInfo.
+                        VkDeviceSize baseOffset = offset;
+                        VkDeviceSize firstBegin = dirtyRanges.front().begin;
+                        for (auto& dirtyRange : dirtyRanges)
+                        {
+                            VkDeviceSize rangeSize = dirtyRange.end - dirtyRange.begin;
+                            VkDeviceSize dstOffset = bufferInfo->offset + dirtyRange.begin;
+
+                            // if the destination follows on directly from the previous region then extend that region rather than adding a new one.
+                            VkBufferCopy* previousRegion = (regionCount > 0) ? &pRegions[regionCount - 1] : nullptr;
+                            bool coalesce = previousRegion && (previousRegion->dstOffset + previousRegion->size) == dstOffset;
+                            VkDeviceSize srcOffset = coalesce ? (previousRegion->srcOffset + previousRegion->size) : (baseOffset + dirtyRange.begin - firstBegin);
+
+                            // copy data to staging buffer memory
+                            char* ptr = reinterpret_cast<char*>(buffer_data) + srcOffset;
+                            std::memcpy(ptr, data_ptr + dirtyRange.begin, rangeSize);
+
+                            // record region
+                            if (coalesce)
+                                previousRegion->size += rangeSize;
+                            else
+                                pRegions[regionCount++] = VkBufferCopy{srcOffset, dstOffset, rangeSize};
+
+                            log(level, "       copying ", bufferInfo, ", ", bufferInfo->data, " to ", static_cast<void*>(ptr), ", coalesce = ", coalesce, ", rangeSize = ", rangeSize);
+
+                            VkDeviceSize endOfEntry = srcOffset + rangeSize;
+                            offset = (/*alignment == 1 ||*/ (endOfEntry % alignment) == 0) ? endOfEntry : ((endOfEntry / alignment) + 1) * alignment;
+                        }
+                    }
                 }
                 else
                 {
@@ -274,23 +396,58 @@ void TransferTask::_transferImageInfo(VkCommandBuffer vk_commandBuffer, Transfer
 
     log(level, "  TransferTask::_transferImageInfo(..) ", this, ",ImageInfo needs copying ", data, ", mipLevels = ", mipLevels);
 
-    // copy data.
     VkFormat sourceFormat = data->properties.format;
     VkFormat targetFormat = imageInfo.imageView->format;
-    if (sourceFormat == targetFormat)
+    auto sourceTraits = getFormatTraits(sourceFormat);
+    auto targetTraits = getFormatTraits(targetFormat);
+    bool compatible = (sourceFormat == targetFormat) || (sourceTraits.size == targetTraits.size);
+
+    // compressed data is either uploaded as is for decompression on the GPU, or decompressed on the CPU as it's copied
+    const void* source = data->dataPointer();
+    std::vector<uint8_t> decompressed;
+    if (auto compressed = data.cast<CompressedData>())
+    {
+        if (compatible && _decompressOnGpu(frame, *compressed))
+        {
+            log(level, "    copying compressed payload for decompression, payload size = ", compressed->payload->dataSize());
+            std::memcpy(ptr, compressed->payload->dataPointer(), compressed->payload->dataSize());
+            offset += compressed->payload->dataSize();
+
+            gpuDecompressor->add(compressed, imageStagingBuffer, source_offset, imageInfo.imageView, imageInfo.imageLayout, mipLevels);
+            return;
+        }
+
+        if (compatible)
+        {
+            copyData(*compressed, ptr);
+            offset += data->dataSize();
+            source = nullptr;
+        }
+        else
+        {
+            decompressed.resize(data->dataSize());
+            copyData(*compressed, decompressed.data());
+            source = decompressed.data();
+        }
+    }
+
+    // copy data.
+    if (!source)
+    {
+        log(level, "    decompressed to staging buffer.");
+    }
+    else if (sourceFormat == targetFormat)
     {
         log(level, "    sourceFormat and targetFormat compatible.");
-        std::memcpy(ptr, data->dataPointer(), data->dataSize());
+        std::memcpy(ptr, source, data->dataSize());
         offset += data->dataSize();
     }
     else
     {
-        auto sourceTraits = getFormatTraits(sourceFormat);
-        auto targetTraits = getFormatTraits(targetFormat);
         if (sourceTraits.size == targetTraits.size)
         {
             log(level, "    sourceTraits.size and targetTraits.size compatible.");
-            std::memcpy(ptr, data->dataPointer(), data->dataSize());
+            std::memcpy(ptr, source, data->dataSize());
             offset += data->dataSize();
         }
         else
@@ -302,39 +459,17 @@ void TransferTask::_transferImageInfo(VkCommandBuffer vk_commandBuffer, Transfer
 
             log(level, "    sourceTraits.size and targetTraits.size not compatible. dataSize() = ", data->dataSize(), ", imageTotalSize = ", imageTotalSize);
 
-            // set up a vec4 worth of default values for the type
-            const uint8_t* default_ptr = targetTraits.defaultValue;
-            uint32_t bytesFromSource = sourceTraits.size;
-            uint32_t bytesToTarget = targetTraits.size;
-
             offset += imageTotalSize;
 
-            // copy data
-            using value_type = uint8_t;
-            const value_type* src_ptr = reinterpret_cast<const value_type*>(data->dataPointer());
-
-            value_type* dest_ptr = reinterpret_cast<value_type*>(ptr);
-
-            size_t valueCount = data->valueCount();
-            for (size_t i = 0; i < valueCount; ++i)
-            {
-                uint32_t s = 0;
-                for (; s < bytesFromSource; ++s)
-                {
-                    (*dest_ptr++) = *(src_ptr++);
-                }
-
-                const value_type* src_default = default_ptr;
-                for (; s < bytesToTarget; ++s)
-                {
-                    (*dest_ptr++) = *(src_default++);
-                }
-            }
+            // copy data, filling the extra components with the default values for the type.
+            // Assign ProcessImages to Options::processImages to expand images on the loading threads instead.
+            expandPixels(reinterpret_cast<const uint8_t*>(source), sourceTraits.size, reinterpret_cast<uint8_t*>(ptr), targetTraits.size, targetTraits.defaultValue, data->valueCount());
         }
     }
 
     // transfer data.
-    transferImageData(imageInfo.imageView, imageInfo.imageLayout, properties, width, height, depth, mipLevels, imageStagingBuffer, source_offset, vk_commandBuffer, device);
+    MipmapGenerator* generator = (mipmapGenerator && (transferQueue->queueFlags() & VK_QUEUE_COMPUTE_BIT) != 0) ? mipmapGenerator.get() : nullptr;
+    transferImageData(imageInfo.imageView, imageInfo.imageLayout, properties, width, height, depth, mipLevels, imageStagingBuffer, source_offset, vk_commandBuffer, device, generator);
 }
 
 TransferTask::TransferResult TransferTask::transferData(TransferMask transferMask)
@@ -368,6 +503,7 @@ TransferTask::TransferResult TransferTask::_transferData(DataToCopy& dataToCopy)
     //
     VkDeviceSize offset = 0;
     VkDeviceSize alignment = 4;
+    VkDeviceSize imageAlignmentPadding = 0;
 
     for (const auto& imageInfo : dataToCopy.imageInfoSet)
     {
@@ -375,6 +511,9 @@ TransferTask::TransferResult TransferTask::_transferData(DataToCopy& dataToCopy)
 
         // adjust offset to make sure it fits with the stride();
         VkDeviceSize image_alignment = std::max(static_cast<VkDeviceSize>(data->stride()), alignment);
+
+        // the images will be placed relative to the start of the staging ring buffer reservation, so allow for additional alignment padding.
+        imageAlignmentPadding += image_alignment;
         offset = ((offset % image_alignment) == 0) ? offset : ((offset / image_alignment) + 1) * image_alignment;
 
         VkFormat targetFormat = imageInfo->imageView->format;
@@ -391,37 +530,55 @@ TransferTask::TransferResult TransferTask::_transferData(DataToCopy& dataToCopy)
 
     offset = 0;
     dataToCopy.dataTotalRegions = 0;
+    dataToCopy.directWriteSize = 0;
     for (const auto& entry : dataToCopy.dataMap)
     {
         const auto& bufferInfos = entry.second;
+        bool directWrite = _directWritePointer(entry.first) != nullptr;
         for (const auto& offset_bufferInfo : bufferInfos)
         {
             const auto& bufferInfo = offset_bufferInfo.second;
+            if (directWrite)
+            {
+                dataToCopy.directWriteSize += bufferInfo->range;
+                continue;
+            }
+
             VkDeviceSize endOfEntry = offset + bufferInfo->range;
             offset = (/*alignment == 1 ||*/ (endOfEntry % alignment) == 0) ? endOfEntry : ((endOfEntry / alignment) + 1) * alignment;
-            ++dataToCopy.dataTotalRegions;
+            dataToCopy.dataTotalRegions += BufferInfo::maxDirtyRanges;
         }
     }
     dataToCopy.dataTotalSize = offset;
-    log(level, "    dataToCopy.dataTotalSize = ", dataToCopy.dataTotalSize);
+    log(level, "    dataToCopy.dataTotalSize = ", dataToCopy.dataTotalSize, ", dataToCopy.directWriteSize = ", dataToCopy.directWriteSize);
 
     //
     // end of compute size
     //
 
     VkDeviceSize totalSize = dataToCopy.dataTotalSize + dataToCopy.imageTotalSize;
-    if (totalSize == 0) return TransferResult{VK_SUCCESS, {}};
+    if (dataToCopy.imageTotalSize > 0) totalSize += imageAlignmentPadding;
+
+    auto& frame = *(dataToCopy.frames[dataToCopy.frameIndex]);
+
+    if (totalSize == 0)
+    {
+        // all the modified data is written directly to host visible memory so no copy commands are required
+        if (dataToCopy.directWriteSize > 0)
+        {
+            _transferBufferInfos(dataToCopy, VK_NULL_HANDLE, frame, offset);
+        }
+        return TransferResult{VK_SUCCESS, {}};
+    }
 
     log(level, "    totalSize = ", totalSize);
 
-    auto& frame = *(dataToCopy.frames[dataToCopy.frameIndex]);
     auto& fence = frame.fence;
     auto& staging = frame.staging;
     auto& commandBuffer = frame.transferCommandBuffer;
     auto& newSignalSemaphore = dataToCopy.transferCompleteSemaphore;
 
     const auto& copyRegions = frame.copyRegions;
-    auto& buffer_data = frame.buffer_data;
 
     log(level, "    frameIndex = ", dataToCopy.frameIndex);
     log(level, "    frame = ", &frame);
@@ -432,13 +589,7 @@ TransferTask::TransferResult TransferTask::_transferData(DataToCopy& dataToCopy)
     log(level, "    newSignalSemaphore = ", newSignalSemaphore, ", ", newSignalSemaphore ? newSignalSemaphore->vk() : VK_NULL_HANDLE);
     log(level, "    copyRegions.size() = ", copyRegions.size());
 
-    if (frame.waitOnFence && fence)
-    {
-        uint64_t timeout = std::numeric_limits<uint64_t>::max();
-        if (VkResult result = fence->wait(timeout); result != VK_SUCCESS) return TransferResult{result, {}};
-        fence->resetFenceAndDependencies();
-    }
-    frame.waitOnFence = false;
+    if (VkResult result = _waitForTransferBlock(frame); result != VK_SUCCESS) return TransferResult{result, {}};
 
     // advance frameIndex
     dataToCopy.frameIndex = (dataToCopy.frameIndex + 1) % dataToCopy.frames.size();
@@ -453,41 +604,30 @@ TransferTask::TransferResult TransferTask::_transferData(DataToCopy& dataToCopy)
         commandBuffer->reset();
     }
 
-    if (!newSignalSemaphore)
+    if (timelineSemaphore)
     {
-        // signal transfer submission has completed
-        newSignalSemaphore = Semaphore::create(device, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-        log(level, "    newSignalSemaphore created ", newSignalSemaphore, ", ", newSignalSemaphore->vk());
+        // timeline semaphore signals transfer submission has completed so no need for the binary semaphore and fence
     }
-
-    if (!fence) fence = Fence::create(device);
-
-    VkResult result = VK_SUCCESS;
-
-    // allocate staging buffer if required
-    if (!staging || staging->size < totalSize)
+    else
     {
-        if (totalSize < minimumStagingBufferSize)
+        if (!newSignalSemaphore)
         {
-            totalSize = minimumStagingBufferSize;
-            log(level, "    Clamping totalSize to ", minimumStagingBufferSize);
+            // signal transfer submission has completed
+            newSignalSemaphore = Semaphore::create(device, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+            log(level, "    newSignalSemaphore created ", newSignalSemaphore, ", ", newSignalSemaphore->vk());
         }
 
-        VkDeviceSize previousSize = staging ? staging->size : 0;
-
-        VkMemoryPropertyFlags stagingMemoryPropertiesFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-        staging = vsg::createBufferAndMemory(device, totalSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, stagingMemoryPropertiesFlags);
-
-        auto stagingMemory = staging->getDeviceMemory(deviceID);
-        buffer_data = nullptr;
-        result = stagingMemory->map(staging->getMemoryOffset(deviceID), staging->size, 0, &buffer_data);
+        if (!fence) fence = Fence::create(device);
+    }
 
-        log(level, "    TransferTask::transferData() frameIndex = ", dataToCopy.frameIndex, ", previousSize = ", previousSize, ", allocated staging buffer = ", staging, ", totalSize = ", totalSize, ", result = ", result);
+    VkResult result = VK_SUCCESS;
 
-        if (result != VK_SUCCESS) return TransferResult{VK_SUCCESS, {}};
-    }
+    // reserve the range of the staging ring buffer to copy the modified data into
+    VkDeviceSize stagingOffset = 0;
+    result = _reserveStagingMemory(dataToCopy, frame, totalSize, stagingOffset);
+    if (result != VK_SUCCESS) return TransferResult{result, {}};
 
-    log(level, "    totalSize = ", totalSize);
+    log(level, "    stagingOffset = ", stagingOffset, ", totalSize = ", totalSize);
 
     VkCommandBufferBeginInfo beginInfo = {};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -497,19 +637,35 @@ TransferTask::TransferResult TransferTask::_transferData(DataToCopy& dataToCopy)
     VkCommandBuffer vk_commandBuffer = *commandBuffer;
     vkBeginCommandBuffer(vk_commandBuffer, &beginInfo);
 
-    offset = 0;
+    offset = stagingOffset;
     {
         COMMAND_BUFFER_INSTRUMENTATION(instrumentation, *commandBuffer, "transferData", COLOR_GPU)
 
         // transfer the modified BufferInfo and ImageInfo
         _transferImageInfos(dataToCopy, vk_commandBuffer, frame, offset);
         _transferBufferInfos(dataToCopy, vk_commandBuffer, frame, offset);
+
+        MipmapGenerator* generator = (mipmapGenerator && (transferQueue->queueFlags() & VK_QUEUE_COMPUTE_BIT) != 0) ? mipmapGenerator.get() : nullptr;
+
+        // decompress all the compressed payloads copied above with a single dispatch, images are added to the generator once decompressed
+        if (gpuDecompressor && !gpuDecompressor->empty())
+        {
+            frame.decompressionResources = gpuDecompressor->record(vk_commandBuffer, generator);
+        }
+
+        // generate the mipmaps of all the images copied above, with the barriers batched across all of them
+        if (generator && !generator->empty())
+        {
+            frame.mipmapResources = generator->record(vk_commandBuffer);
+        }
     }
 
     vkEndCommandBuffer(vk_commandBuffer);
 
+    if (instrumentation) instrumentation->plot("TransferTask bytes", static_cast<double>(offset - stagingOffset));
+
     // if no regions to copy have been found then commandBuffer will be empty so no need to submit it to queue and signal the associated semaphore
-    if (offset > 0)
+    if (offset > stagingOffset)
     {
         // submit the transfer commands
         VkSubmitInfo submitInfo = {};
@@ -518,18 +674,35 @@ TransferTask::TransferResult TransferTask::_transferData(DataToCopy& dataToCopy)
         // set up vulkan wait semaphore
         std::vector<VkSemaphore> vk_waitSemaphores;
         std::vector<VkPipelineStageFlags> vk_waitStages;
+        std::vector<uint64_t> vk_waitValues;
         if (dataToCopy.transferConsumerCompletedSemaphore)
         {
             vk_waitSemaphores.emplace_back(dataToCopy.transferConsumerCompletedSemaphore->vk());
             vk_waitStages.emplace_back(dataToCopy.transferConsumerCompletedSemaphore->pipelineStageFlags());
+            vk_waitValues.emplace_back(dataToCopy.transferConsumerCompletedValue);
 
             log(level, "TransferTask::_transferData( ", dataToCopy.name, " ) submit dataToCopy.transferConsumerCompletedSemaphore = ", dataToCopy.transferConsumerCompletedSemaphore);
         }
 
         // set up the vulkan signal semaphore
         std::vector<VkSemaphore> vk_signalSemaphores;
+        std::vector<uint64_t> vk_signalValues;
 
-        vk_signalSemaphores.push_back(*newSignalSemaphore);
+        ref_ptr<Semaphore> signalSemaphore = timelineSemaphore ? timelineSemaphore : newSignalSemaphore;
+        uint64_t signalValue = timelineSemaphore ? timelineSemaphore->nextSignalValue() : 0;
+
+        vk_signalSemaphores.push_back(*signalSemaphore);
+        vk_signalValues.push_back(signalValue);
+
+        VkTimelineSemaphoreSubmitInfo timelineSubmitInfo = {};
+        timelineSubmitInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineSubmitInfo.pNext = nullptr;
+        timelineSubmitInfo.waitSemaphoreValueCount = static_cast<uint32_t>(vk_waitValues.size());
+        timelineSubmitInfo.pWaitSemaphoreValues = vk_waitValues.data();
+        timelineSubmitInfo.signalSemaphoreValueCount = static_cast<uint32_t>(vk_signalValues.size());
+        timelineSubmitInfo.pSignalSemaphoreValues = vk_signalValues.data();
+
+        if (timelineSemaphore) submitInfo.pNext = &timelineSubmitInfo;
 
         submitInfo.waitSemaphoreCount = static_cast<uint32_t>(vk_waitSemaphores.size());
         submitInfo.pWaitSemaphores = vk_waitSemaphores.data();
@@ -543,28 +716,157 @@ TransferTask::TransferResult TransferTask::_transferData(DataToCopy& dataToCopy)
         log(level, "   TransferTask submitInfo.waitSemaphoreCount = ", submitInfo.waitSemaphoreCount);
         log(level, "   TransferTask submitInfo.signalSemaphoreCount = ", submitInfo.signalSemaphoreCount);
 
-        result = transferQueue->submit(submitInfo, fence);
+        result = transferQueue->submit(submitInfo, timelineSemaphore ? nullptr : fence.get());
 
         frame.waitOnFence = true;
+        frame.timelineValue = signalValue;
 
         dataToCopy.transferConsumerCompletedSemaphore.reset();
+        dataToCopy.transferConsumerCompletedValue = 0;
 
         if (result != VK_SUCCESS) return TransferResult{result, {}};
 
-        return TransferResult{VK_SUCCESS, newSignalSemaphore};
+        return TransferResult{VK_SUCCESS, signalSemaphore, signalValue};
     }
     else
     {
         log(level, "Nothing to submit");
+
+        // release the staging ring buffer reservation as it's not in use.
+        dataToCopy.stagingHead = frame.stagingOffset;
+        frame.stagingSize = 0;
+
         return TransferResult{VK_SUCCESS, {}};
     }
 }
 
+VkResult TransferTask::_waitForTransferBlock(TransferBlock& frame)
+{
+    if (frame.waitOnFence)
+    {
+        uint64_t timeout = std::numeric_limits<uint64_t>::max();
+        if (frame.timelineValue > 0 && timelineSemaphore)
+        {
+            // wait on the GPU progress value signaled by this frame's previous submission
+            if (VkResult result = timelineSemaphore->wait(frame.timelineValue, timeout); result != VK_SUCCESS) return result;
+        }
+        else if (frame.fence)
+        {
+            if (VkResult result = frame.fence->wait(timeout); result != VK_SUCCESS) return result;
+            frame.fence->resetFenceAndDependencies();
+        }
+    }
+    frame.waitOnFence = false;
+    frame.timelineValue = 0;
+    frame.stagingSize = 0;
+    frame.mipmapResources = {};
+    frame.decompressionResources = {};
+    return VK_SUCCESS;
+}
+
+VkResult TransferTask::_reserveStagingMemory(DataToCopy& dataToCopy, TransferBlock& frame, VkDeviceSize size, VkDeviceSize& offset)
+{
+    auto deviceID = device->deviceID;
+    auto& staging = dataToCopy.staging;
+
+    // allocate a new ring buffer if the current one is too small, TransferBlock that are still in flight keep a reference to the previous one until they complete.
+    if (!staging || staging->size < size)
+    {
+        VkDeviceSize previousSize = staging ? staging->size : 0;
+        VkDeviceSize newSize = std::max({size, minimumStagingBufferSize, previousSize * 2});
+
+        VkMemoryPropertyFlags stagingMemoryPropertiesFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        VkBufferUsageFlags stagingUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        if (gpuDecompressor) stagingUsage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT; // compressed payloads are read by the decompression compute shader
+        staging = vsg::createBufferAndMemory(device, newSize, stagingUsage, VK_SHARING_MODE_EXCLUSIVE, stagingMemoryPropertiesFlags);
+
+        auto stagingMemory = staging->getDeviceMemory(deviceID);
+        dataToCopy.staging_data = nullptr;
+        dataToCopy.stagingHead = 0;
+        VkResult result = stagingMemory->map(staging->getMemoryOffset(deviceID), staging->size, 0, &dataToCopy.staging_data);
+
+        log(level, "    TransferTask::_reserveStagingMemory() previousSize = ", previousSize, ", allocated staging buffer = ", staging, ", newSize = ", newSize, ", result = ", result);
+
+        if (result != VK_SUCCESS)
+        {
+            staging = {};
+            return result;
+        }
+    }
+
+    // reserve from the head of the ring, wrapping around to the start if there isn't enough space left at the end
+    const VkDeviceSize reserveAlignment = 16;
+    VkDeviceSize start = ((dataToCopy.stagingHead + reserveAlignment - 1) / reserveAlignment) * reserveAlignment;
+    if ((start + size) > staging->size) start = 0;
+    VkDeviceSize end = start + size;
+
+    // wait for any in flight copies that are still reading from the range that will be overwritten
+    for (auto& other : dataToCopy.frames)
+    {
+        if (other.get() == &frame || !other->waitOnFence || other->staging != staging || other->stagingSize == 0) continue;
+
+        if (start < (other->stagingOffset + other->stagingSize) && other->stagingOffset < end)
+        {
+            log(level, "    TransferTask::_reserveStagingMemory() waiting on in flight transfer ", other);
+            if (VkResult result = _waitForTransferBlock(*other); result != VK_SUCCESS) return result;
+        }
+    }
+
+    frame.staging = staging;
+    frame.buffer_data = dataToCopy.staging_data;
+    frame.stagingOffset = start;
+    frame.stagingSize = size;
+
+    dataToCopy.stagingHead = end;
+    offset = start;
+
+    return VK_SUCCESS;
+}
+
+char* TransferTask::_directWritePointer(Buffer* buffer)
+{
+    if (!directHostWrites) return nullptr;
+
+    auto deviceID = device->deviceID;
+    auto deviceMemory = buffer->getDeviceMemory(deviceID);
+    if (!deviceMemory) return nullptr;
+
+    const VkMemoryPropertyFlags requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+    if ((deviceMemory->getMemoryTypePropertyFlags() & requiredFlags) != requiredFlags) return nullptr;
+
+    // the DeviceMemory is mapped once and kept mapped for the lifetime of the TransferTask
+    auto itr = _mappedDeviceMemory.find(ref_ptr<DeviceMemory>(deviceMemory));
+    if (itr == _mappedDeviceMemory.end())
+    {
+        void* mapped = nullptr;
+        if (VkResult result = deviceMemory->map(0, VK_WHOLE_SIZE, 0, &mapped); result != VK_SUCCESS)
+        {
+            warn("TransferTask::_directWritePointer() unable to map DeviceMemory ", deviceMemory, ", result = ", result, ", falling back to staging buffer copies.");
+            mapped = nullptr;
+        }
+        itr = _mappedDeviceMemory.emplace(ref_ptr<DeviceMemory>(deviceMemory), mapped).first;
+    }
+
+    if (!itr->second) return nullptr;
+    return static_cast<char*>(itr->second) + buffer->getMemoryOffset(deviceID);
+}
+
+bool TransferTask::_decompressOnGpu(TransferBlock& frame, const CompressedData& data) const
+{
+    if (!gpuDecompressor || !frame.staging) return false;
+    if ((transferQueue->queueFlags() & VK_QUEUE_COMPUTE_BIT) == 0) return false;
+
+    // staging buffers created before the gpuDecompressor was assigned can't be bound as storage buffers
+    if ((frame.staging->usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) == 0) return false;
+
+    return gpuDecompressor->supported(data);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // vsg::transferImageData(..)
 //
-void vsg::transferImageData(ref_ptr<ImageView> imageView, VkImageLayout targetImageLayout, Data::Properties properties, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, ref_ptr<Buffer> stagingBuffer, VkDeviceSize stagingBufferOffset, VkCommandBuffer commandBuffer, vsg::Device* device)
+void vsg::transferImageData(ref_ptr<ImageView> imageView, VkImageLayout targetImageLayout, Data::Properties properties, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, ref_ptr<Buffer> stagingBuffer, VkDeviceSize stagingBufferOffset, VkCommandBuffer commandBuffer, vsg::Device* device, MipmapGenerator* mipmapGenerator)
 {
     auto image = imageView->image;
     if (!image) return;
@@ -639,7 +941,10 @@ void vsg::transferImageData(ref_ptr<ImageView> imageView, VkImageLayout targetIm
 
     // vsg::info("vsg::transferImageData() data = ", data, ", data->properties.mipLevels = ", int(data->properties.mipLevels), ", data_mipLevels = ", data_mipLevels, " mipLevels = ", mipLevels, ", mipmapData = ", mipmapData, ", generateMipmaps = ", generateMipmaps);
 
-    if (generateMipmaps)
+    // defer to the compute shader mipmap generation, batched with the other images of the transfer
+    bool computeMipmaps = generateMipmaps && mipmapGenerator && mipmapGenerator->supported(*imageView, mipLevels);
+
+    if (generateMipmaps && !computeMipmaps)
     {
         VkFormatProperties props;
         vkGetPhysicalDeviceFormatProperties(*(device->getPhysicalDevice()), properties.format, &props);
@@ -762,7 +1067,11 @@ void vsg::transferImageData(ref_ptr<ImageView> imageView, VkImageLayout targetIm
     vkCmdCopyBufferToImage(commandBuffer, stagingBuffer->vk(device->deviceID), vk_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                            static_cast<uint32_t>(regions.size()), regions.data());
 
-    if (generateMipmaps)
+    if (computeMipmaps)
+    {
+        mipmapGenerator->add(imageView, targetImageLayout, mipLevels);
+    }
+    else if (generateMipmaps)
     {
         VkImageMemoryBarrier barrier = {};
         barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -57,6 +57,12 @@ UpdateOperations::container_type UpdateOperations::getUpdateOperationsAllFrames(
     return _updateOperationsAllFrames;
 }
 
+bool UpdateOperations::requiresRun() const
+{
+    std::scoped_lock<std::mutex> lock(_updateOperationMutex);
+    return !_updateOperationsOneTime.empty();
+}
+
 void UpdateOperations::run()
 {
     container_type updateOperations;
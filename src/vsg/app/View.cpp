@@ -10,6 +10,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/app/CullCache.h>
+#include <vsg/app/OcclusionBuffer.h>
+#include <vsg/app/PagedLODOcclusionQueries.h>
+#include <vsg/app/PrefetchTraversal.h>
 #include <vsg/app/View.h>
 #include <vsg/nodes/Bin.h>
 #include <vsg/state/ViewDependentState.h>
@@ -79,7 +83,9 @@ View::View(const View& view) :
     viewID(sharedViewID(view.viewID)),
     features(view.features),
     mask(view.mask),
-    LODScale(view.LODScale)
+    LODScale(view.LODScale),
+    maximumScreenSpaceError(view.maximumScreenSpaceError),
+    LODHysteresis(view.LODHysteresis)
 {
     if (view.camera && view.camera->viewportState)
     {
@@ -16,10 +16,14 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 #include <vsg/nodes/StateGroup.h>
 #include <vsg/state/Descriptor.h>
+#include <vsg/threading/atomics.h>
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <map>
 #include <set>
+#include <thread>
 
 using namespace vsg;
 
@@ -164,10 +168,23 @@ bool Viewer::advanceToNextFrame(double simulationTime)
         return false;
     }
 
+    // when rendering on demand wait till events or changes require a new frame, retaining the events that ended the wait
+    bool discardPreviousEvents = true;
+    if (onDemandRendering && !_firstFrame)
+    {
+        if (!_waitForRedraw()) return false;
+        discardPreviousEvents = false;
+    }
+
+    // wait for the just in time start of the frame so the events polled are as recent as possible
+    if (framePacing) framePacing->waitForFrameStart(presentations, instrumentation.get());
+
     // poll all the windows for events.
-    pollEvents(true);
+    pollEvents(discardPreviousEvents);
 
-    if (!acquireNextFrame()) return false;
+    // when the previous pipelined frame is still being recorded the acquire is deferred till recordAndSubmit() has completed it
+    _acquireDeferred = _frameInFlight;
+    if (!_acquireDeferred && !acquireNextFrame()) return false;
 
     // create FrameStamp for frame
     auto time = vsg::clock::now();
@@ -194,9 +211,12 @@ bool Viewer::advanceToNextFrame(double simulationTime)
     // signal to instrumentation the start of frame
     if (instrumentation) instrumentation->enterFrame(&s_frame_source_location, frameReference, *_frameStamp);
 
-    for (auto& task : recordAndSubmitTasks)
+    if (!_acquireDeferred)
     {
-        task->advance();
+        for (auto& task : recordAndSubmitTasks)
+        {
+            task->advance();
+        }
     }
 
     // create an event for the new frame.
@@ -205,6 +225,100 @@ bool Viewer::advanceToNextFrame(double simulationTime)
     return true;
 }
 
+void Viewer::requestRedraw(uint32_t numFrames)
+{
+    exchange_if_greater(_redrawsRequested, numFrames);
+}
+
+bool Viewer::requiresRedraw()
+{
+    if (_redrawsRequested.load() > 0) return true;
+
+    if (redrawCallback && redrawCallback(*this)) return true;
+
+    if (updateOperations && updateOperations->requiresRun()) return true;
+
+    if (animationManager && !animationManager->animations.empty()) return true;
+
+    for (const auto& task : recordAndSubmitTasks)
+    {
+        if (task->databasePager && task->databasePager->requiresUpdate()) return true;
+        if (task->transferTask && task->transferTask->requiresTransfer(TransferTask::TRANSFER_ALL)) return true;
+    }
+
+    return _camerasChanged();
+}
+
+bool Viewer::_camerasChanged()
+{
+    if (!_onDemandViewsAssigned)
+    {
+        // collect the Views without traversing their scene graphs
+        struct FindViews : public Visitor
+        {
+            std::vector<OnDemandView>& views;
+            explicit FindViews(std::vector<OnDemandView>& in_views) :
+                views(in_views) {}
+
+            void apply(Node& node) override { node.traverse(*this); }
+            void apply(View& view) override { views.push_back(OnDemandView{observer_ptr<View>(&view), {}, {}}); }
+        } findViews(_onDemandViews);
+
+        _onDemandViews.clear();
+        for (const auto& task : recordAndSubmitTasks)
+        {
+            for (auto& commandGraph : task->commandGraphs)
+            {
+                commandGraph->accept(findViews);
+            }
+        }
+
+        _onDemandViewsAssigned = true;
+    }
+
+    bool changed = false;
+    for (auto& onDemandView : _onDemandViews)
+    {
+        auto view = onDemandView.view.ref_ptr();
+        if (!view || !view->camera) continue;
+
+        dmat4 projectionMatrix = view->camera->projectionMatrix ? view->camera->projectionMatrix->transform() : dmat4();
+        dmat4 viewMatrix = view->camera->viewMatrix ? view->camera->viewMatrix->transform() : dmat4();
+        if (projectionMatrix != onDemandView.projectionMatrix || viewMatrix != onDemandView.viewMatrix)
+        {
+            onDemandView.projectionMatrix = projectionMatrix;
+            onDemandView.viewMatrix = viewMatrix;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool Viewer::_waitForRedraw()
+{
+    CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer waitForRedraw", COLOR_VIEWER);
+
+    // a pipelined frame must be presented before waiting, otherwise it wouldn't be displayed till the next frame is required
+    _completeFrameInFlight();
+
+    // the camera moving during the previous frame, such as a Trackball continuing a thrown motion, requires a further frame to continue it
+    while (!pollEvents(true) && !requiresRedraw())
+    {
+        if (!active()) return false;
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(onDemandPollInterval));
+    }
+
+    // consume one of the requested redraws
+    auto numRedrawsRequested = _redrawsRequested.load();
+    while (numRedrawsRequested > 0 && !_redrawsRequested.compare_exchange_weak(numRedrawsRequested, numRedrawsRequested - 1)) {}
+
+    // record the camera matrices used for the new frame
+    _camerasChanged();
+
+    return true;
+}
+
 bool Viewer::acquireNextFrame()
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer acquireNextFrame", COLOR_VIEWER);
@@ -224,8 +338,21 @@ bool Viewer::acquireNextFrame()
                 result == VK_ERROR_FULL_SCREEN_EXCLUSIVE_MODE_LOST_EXT ||
                 result == VK_SUBOPTIMAL_KHR)
             {
+                if (window->traits()->asynchronousSwapchainRecreation)
+                {
+                    // rather than the Window waiting on the device to idle, only wait for the frames in flight of the tasks rendering to it, leaving the other Windows' frames running
+                    for (auto& task : recordAndSubmitTasks)
+                    {
+                        if (std::find(task->windows.begin(), task->windows.end(), window) != task->windows.end())
+                        {
+                            task->waitForFramesInFlight(std::numeric_limits<uint64_t>::max());
+                        }
+                    }
+                }
+
                 // force a rebuild of the Swapchain by calling Window::resize();
                 window->resize();
+                if (framePacing) framePacing->reset();
             }
             else if (result == VK_ERROR_DEVICE_LOST)
             {
@@ -252,12 +379,8 @@ VkResult Viewer::waitForFences(size_t relativeFrameIndex, uint64_t timeout)
     VkResult result = VK_SUCCESS;
     for (auto& task : recordAndSubmitTasks)
     {
-        auto fenceToWait = task->fence(relativeFrameIndex);
-        if (fenceToWait)
-        {
-            result = fenceToWait->wait(timeout);
-            if (result != VK_SUCCESS) return result;
-        }
+        result = task->wait(relativeFrameIndex, timeout);
+        if (result != VK_SUCCESS) return result;
     }
     return result;
 }
@@ -279,6 +402,9 @@ CompileResult Viewer::compile(ref_ptr<ResourceHints> hints)
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer compile", COLOR_COMPILE);
 
+    // compile reassigns resources that a pipelined frame may still be recording with
+    _completeFrameInFlight();
+
     if (recordAndSubmitTasks.empty())
     {
         return {};
@@ -377,6 +503,12 @@ CompileResult Viewer::compile(ref_ptr<ResourceHints> hints)
     {
         compileManager = CompileManager::create(*this, hints);
         if (instrumentation) compileManager->assignInstrumentation(instrumentation);
+        if (operationThreads) compileManager->assignOperationThreads(operationThreads);
+    }
+
+    if (operationThreads && animationManager && !animationManager->operationThreads)
+    {
+        animationManager->operationThreads = operationThreads;
     }
 
     // assign CompileManager to DatabasePager
@@ -406,6 +538,8 @@ CompileResult Viewer::compile(ref_ptr<ResourceHints> hints)
     {
         if (task->databasePager)
         {
+            if (!task->databasePager->device) task->databasePager->device = task->device;
+
             if (hints)
                 task->databasePager->start(hints->numDatabasePagerReadThreads);
             else
@@ -420,6 +554,9 @@ void Viewer::assignRecordAndSubmitTaskAndPresentation(CommandGraphs in_commandGr
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer assignRecordAndSubmitTaskAndPresentation", COLOR_VIEWER);
 
+    // the Views checked for camera changes by onDemandRendering are collected again on the next frame
+    _onDemandViewsAssigned = false;
+
     // now remove any commandGraphs associated with window
     bool needToStartThreading = _threading;
     if (_threading) stopThreading();
@@ -545,6 +682,9 @@ void Viewer::assignRecordAndSubmitTaskAndPresentation(CommandGraphs in_commandGr
 
             recordAndSubmitTask->transferTask->transferQueue = transferQueue;
 
+            // use timeline semaphore based synchronization when the Device has them enabled
+            if (device->supportsTimelineSemaphores()) recordAndSubmitTask->enableTimelineSemaphore();
+
             // assign instrumentation
             if (instrumentation) recordAndSubmitTask->assignInstrumentation(instrumentation);
 
@@ -565,11 +705,43 @@ void Viewer::assignRecordAndSubmitTaskAndPresentation(CommandGraphs in_commandGr
 
             recordAndSubmitTask->transferTask->transferQueue = transferQueue;
 
+            // use timeline semaphore based synchronization when the Device has them enabled
+            if (device->supportsTimelineSemaphores()) recordAndSubmitTask->enableTimelineSemaphore();
+
             // assign instrumentation
             if (instrumentation) recordAndSubmitTask->assignInstrumentation(instrumentation);
         }
     }
 
+    // tasks submitting to compute queues without graphics support run async compute work that overlaps the rendering of the graphics tasks on the same device.
+    // Place them first so that they submit ahead of the graphics tasks, that wait on the current frame's compute submission, while the compute waits on
+    // the previous frame's graphics submission so that it doesn't overwrite data still being read.
+    auto isAsyncCompute = [](const RecordAndSubmitTask& task) {
+        return task.queue && (task.queue->queueFlags() & VK_QUEUE_GRAPHICS_BIT) == 0 && (task.queue->queueFlags() & VK_QUEUE_COMPUTE_BIT) != 0;
+    };
+
+    std::stable_partition(recordAndSubmitTasks.begin(), recordAndSubmitTasks.end(), [&](const ref_ptr<RecordAndSubmitTask>& task) { return isAsyncCompute(*task); });
+
+    for (auto& computeTask : recordAndSubmitTasks)
+    {
+        if (!isAsyncCompute(*computeTask)) continue;
+
+        for (auto& task : recordAndSubmitTasks)
+        {
+            if (isAsyncCompute(*task) || task->device != computeTask->device) continue;
+
+            if (!task->timelineSemaphore || !computeTask->timelineSemaphore)
+            {
+                warn("Viewer::assignRecordAndSubmitTaskAndPresentation() async compute requires timeline semaphores, compute and graphics submissions not synchronized.");
+                continue;
+            }
+
+            VkPipelineStageFlags graphicsWaitStages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+            task->dependencies.push_back(RecordAndSubmitTask::Dependency{observer_ptr<RecordAndSubmitTask>(computeTask), graphicsWaitStages, 0});
+            computeTask->dependencies.push_back(RecordAndSubmitTask::Dependency{observer_ptr<RecordAndSubmitTask>(task), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 1});
+        }
+    }
+
     if (needToStartThreading) setupThreading();
 }
 
@@ -616,8 +788,8 @@ void Viewer::setupThreading()
 
     status->set(true);
     _threading = true;
-    _frameBlock = FrameBlock::create(status);
-    _submissionCompleted = Barrier::create(1 + numValidTasks);
+    _frameBlock = FrameBlock::create(status, threadingSpinCount);
+    _submissionCompleted = Barrier::create(1 + numValidTasks, threadingSpinCount);
 
     // set up required threads for each task
     for (auto& task : recordAndSubmitTasks)
@@ -649,14 +821,14 @@ void Viewer::setupThreading()
             // we have multiple CommandGraphs in a single Task so set up a thread per CommandGraph
             struct SharedData : public Inherit<Object, SharedData>
             {
-                SharedData(ref_ptr<RecordAndSubmitTask> in_task, ref_ptr<FrameBlock> in_frameBlock, ref_ptr<Barrier> in_submissionCompleted, uint32_t numThreads) :
+                SharedData(ref_ptr<RecordAndSubmitTask> in_task, ref_ptr<FrameBlock> in_frameBlock, ref_ptr<Barrier> in_submissionCompleted, uint32_t numThreads, uint32_t spinCount) :
                     task(in_task),
                     frameBlock(in_frameBlock),
                     submissionCompletedBarrier(in_submissionCompleted)
                 {
                     recordedCommandBuffers = RecordedCommandBuffers::create();
-                    recordStartBarrier = Barrier::create(numThreads);
-                    recordCompletedBarrier = Barrier::create(numThreads);
+                    recordStartBarrier = Barrier::create(numThreads, spinCount);
+                    recordCompletedBarrier = Barrier::create(numThreads, spinCount);
                 }
 
                 // shared between all threads
@@ -673,7 +845,7 @@ void Viewer::setupThreading()
             uint32_t numThreads = static_cast<uint32_t>(task->commandGraphs.size());
             if (task->transferTask) ++numThreads;
 
-            ref_ptr<SharedData> sharedData = SharedData::create(task, _frameBlock, _submissionCompleted, numThreads);
+            ref_ptr<SharedData> sharedData = SharedData::create(task, _frameBlock, _submissionCompleted, numThreads, threadingSpinCount);
 
             auto run_primary = [](ref_ptr<SharedData> data, ref_ptr<CommandGraph> commandGraph, const std::string& threadName) {
                 auto local_instrumentation = shareOrDuplicateForThreadSafety(data->task->instrumentation);
@@ -725,7 +897,7 @@ void Viewer::setupThreading()
                 }
             };
 
-            auto run_transfer = [](ref_ptr<SharedData> data, ref_ptr<TransferTask> transferTask, TransferTask::TransferMask transferMask, const std::string& threadName) {
+            auto run_transfer = [](ref_ptr<SharedData> data, const std::string& threadName) {
                 auto local_instrumentation = shareOrDuplicateForThreadSafety(data->task->instrumentation);
                 if (local_instrumentation) local_instrumentation->setThreadName(threadName);
 
@@ -740,13 +912,8 @@ void Viewer::setupThreading()
 
                     //vsg::info("run_transfer");
 
-                    if (auto transfer = transferTask->transferData(transferMask); transfer.result == VK_SUCCESS)
-                    {
-                        if (transfer.dataTransferredSemaphore)
-                        {
-                            data->task->earlyDataTransferredSemaphore = transfer.dataTransferredSemaphore;
-                        }
-                    }
+                    // the early transfer will already have been done if Viewer::pipelinedFrames is enabled
+                    data->task->transferBeforeRecordTraversal();
 
                     data->recordCompletedBarrier->arrive_and_wait();
                 }
@@ -762,10 +929,17 @@ void Viewer::setupThreading()
 
             if (task->transferTask)
             {
-                threads.emplace_back(run_transfer, sharedData, task->transferTask, TransferTask::TRANSFER_BEFORE_RECORD_TRAVERSAL, make_string("Viewer early transferTask thread"));
+                threads.emplace_back(run_transfer, sharedData, make_string("Viewer early transferTask thread"));
             }
         }
     }
+
+    // keep the record threads off the efficiency cores of hybrid CPUs
+    auto affinity = recordThreadAffinity ? recordThreadAffinity : performanceCoreAffinity();
+    if (affinity)
+    {
+        for (auto& thread : threads) setAffinity(thread, affinity);
+    }
 }
 
 void Viewer::stopThreading()
@@ -773,6 +947,10 @@ void Viewer::stopThreading()
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer stopThreading", COLOR_VIEWER);
 
     if (!_threading) return;
+
+    // complete any pipelined frame before stopping the threads that are recording it
+    _completeFrameInFlight();
+
     _threading = false;
 
     debug("Viewer::stopThreading()");
@@ -789,11 +967,8 @@ void Viewer::stopThreading()
     threads.clear();
 }
 
-void Viewer::update()
+void Viewer::_mergeDatabasePagerUpdates()
 {
-    CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer update", COLOR_UPDATE);
-
-    // merge any updates from the DatabasePager
     for (const auto& task : recordAndSubmitTasks)
     {
         if (task->databasePager)
@@ -803,18 +978,134 @@ void Viewer::update()
             if (cr.requiresViewerUpdate()) updateViewer(*this, cr);
         }
     }
+}
+
+void Viewer::_completeFrameInFlight()
+{
+    if (!_frameInFlight) return;
+
+    CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer complete pipelined frame", COLOR_VIEWER);
+
+    _frameInFlight = false;
+    _submissionCompleted->arrive_and_wait();
+
+    _flushSubmitBatches();
+
+    if (_presentDeferred)
+    {
+        _presentDeferred = false;
+        present();
+    }
+}
+
+void Viewer::_assignSubmitBatches()
+{
+    // reuse the SubmitBatch from previous frames where possible
+    auto previousSubmitBatches = std::move(_submitBatches);
+    _submitBatches.clear();
+
+    if (!batchSubmissions) return;
+
+    // batch the tasks that share a Queue, the SubmitBatch are kept in the order of the tasks so async compute tasks placed first are submitted first.
+    for (auto itr = recordAndSubmitTasks.begin(); itr != recordAndSubmitTasks.end(); ++itr)
+    {
+        auto& task = *itr;
+        if (task->submitBatch || !task->queue || !task->scratchMemory || task->commandGraphs.empty()) continue;
+
+        for (auto other_itr = itr + 1; other_itr != recordAndSubmitTasks.end(); ++other_itr)
+        {
+            auto& other = *other_itr;
+            if (other->queue != task->queue || !other->scratchMemory || other->commandGraphs.empty()) continue;
+
+            if (!task->submitBatch)
+            {
+                auto previous_itr = std::find_if(previousSubmitBatches.begin(), previousSubmitBatches.end(), [&](const ref_ptr<SubmitBatch>& batch) { return batch->queue == task->queue; });
+                task->submitBatch = (previous_itr != previousSubmitBatches.end()) ? *previous_itr : SubmitBatch::create(task->queue);
+                _submitBatches.push_back(task->submitBatch);
+            }
+            other->submitBatch = task->submitBatch;
+        }
+    }
+}
+
+void Viewer::_flushSubmitBatches()
+{
+    for (auto& submitBatch : _submitBatches)
+    {
+        if (VkResult result = submitBatch->submit(); result != VK_SUCCESS)
+        {
+            warn("Viewer::recordAndSubmit() batched vkQueueSubmit failed, result = ", result);
+        }
+    }
+
+    // tasks submitted outside of recordAndSubmit() submit directly to their queue
+    for (auto& task : recordAndSubmitTasks)
+    {
+        task->submitBatch = {};
+    }
+}
+
+void Viewer::update()
+{
+    CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer update", COLOR_UPDATE);
+
+    // merge any updates from the DatabasePager, deferred to recordAndSubmit() while a pipelined frame is being recorded
+    if (!_frameInFlight) _mergeDatabasePagerUpdates();
 
     // run update operations
     updateOperations->run();
 
     // run aniamtions
     animationManager->run(_frameStamp);
+
+    if (instrumentation)
+    {
+        // report the memory reserved from the device and staging memory pools of each device
+        std::set<Device*> devices;
+        for (auto& task : recordAndSubmitTasks)
+        {
+            if (!task->device || !devices.insert(task->device.get()).second) continue;
+
+            if (auto deviceMemoryBufferPools = task->device->deviceMemoryBufferPools.ref_ptr())
+            {
+                instrumentation->plot("Device memory reserved", static_cast<double>(deviceMemoryBufferPools->computeMemoryTotalReserved()));
+                instrumentation->plot("Device memory available", static_cast<double>(deviceMemoryBufferPools->computeMemoryTotalAvailable()));
+            }
+            if (auto stagingMemoryBufferPools = task->device->stagingMemoryBufferPools.ref_ptr())
+            {
+                instrumentation->plot("Staging memory reserved", static_cast<double>(stagingMemoryBufferPools->computeMemoryTotalReserved()));
+            }
+        }
+    }
 }
 
 void Viewer::recordAndSubmit()
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer recordAndSubmitTask", COLOR_VIEWER);
 
+    bool pipelined = _threading && pipelinedFrames;
+    if (pipelined)
+    {
+        // the previous frame must be recorded and presented before this frame can acquire its images and merge the DatabasePager updates
+        _completeFrameInFlight();
+
+        if (_acquireDeferred)
+        {
+            _acquireDeferred = false;
+            if (!acquireNextFrame()) return;
+
+            for (auto& task : recordAndSubmitTasks)
+            {
+                task->advance();
+            }
+        }
+
+        _mergeDatabasePagerUpdates();
+    }
+
+    // combine the submissions of the tasks sharing a Queue
+    _assignSubmitBatches();
+
     // reset connected ExecuteCommands
     for (const auto& recordAndSubmitTask : recordAndSubmitTasks)
     {
@@ -833,8 +1124,25 @@ void Viewer::recordAndSubmit()
     if (_threading && _frameStamp->frameCount > 2)
 #endif
     {
-        _frameBlock->set(_frameStamp);
-        _submissionCompleted->arrive_and_wait();
+        if (pipelined)
+        {
+            // snapshot the dynamic data so the next frame's update can modify it while this frame is being recorded
+            for (auto& recordAndSubmitTask : recordAndSubmitTasks)
+            {
+                if (!recordAndSubmitTask->commandGraphs.empty()) recordAndSubmitTask->transferBeforeRecordTraversal();
+            }
+
+            // start the record threads without waiting for them, the wait is done by the next recordAndSubmit() or stopThreading()
+            _frameBlock->set(_frameStamp);
+            _frameInFlight = true;
+        }
+        else
+        {
+            _frameBlock->set(_frameStamp);
+            _submissionCompleted->arrive_and_wait();
+
+            _flushSubmitBatches();
+        }
     }
     else
     {
@@ -842,6 +1150,8 @@ void Viewer::recordAndSubmit()
         {
             recordAndSubmitTask->submit(_frameStamp);
         }
+
+        _flushSubmitBatches();
     }
 }
 
@@ -849,10 +1159,26 @@ void Viewer::present()
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "Viewer present", COLOR_VIEWER);
 
-    for (auto& presentation : presentations)
+    // a pipelined frame is presented once its record has completed
+    if (_frameInFlight)
     {
-        presentation->present();
+        _presentDeferred = true;
+        return;
+    }
+
+    if (batchSubmissions)
+    {
+        Presentation::present(presentations);
+    }
+    else
+    {
+        for (auto& presentation : presentations)
+        {
+            presentation->present();
+        }
     }
+
+    if (framePacing) framePacing->presented(presentations, instrumentation.get());
 }
 
 void Viewer::assignInstrumentation(ref_ptr<Instrumentation> in_instrumentation)
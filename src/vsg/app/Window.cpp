@@ -18,6 +18,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/maths/color.h>
 #include <vsg/maths/vec4.h>
 #include <vsg/ui/ApplicationEvent.h>
+#include <vsg/ui/PointerEvent.h>
 #include <vsg/utils/CoordinateSpace.h>
 #include <vsg/vk/SubmitCommands.h>
 
@@ -39,6 +40,8 @@ Window::Window(ref_ptr<WindowTraits> traits) :
     _clearColor{0.2f, 0.2f, 0.4f, 1.0f},
     _framebufferSamples(VK_SAMPLE_COUNT_1_BIT)
 {
+    if (_traits) coalesceMoveEvents = _traits->coalesceMoveEvents;
+
     if (_traits && (_traits->swapchainPreferences.surfaceFormat.format == VK_FORMAT_B8G8R8A8_SRGB || _traits->swapchainPreferences.surfaceFormat.format == VK_FORMAT_B8G8R8_SRGB))
     {
         _clearColor = sRGB_to_linear(_clearColor);
@@ -51,6 +54,7 @@ Window::~Window()
 
 void Window::clear()
 {
+    _retiredSwapchains.clear();
     _frames.clear();
     _swapchain.reset();
 
@@ -68,7 +72,7 @@ void Window::share(ref_ptr<Device> device)
     setDevice(device);
     _initSurface();
     _initFormats();
-    _initRenderPass();
+    if (!_traits->dynamicRendering) _initRenderPass();
 }
 
 VkSurfaceFormatKHR Window::surfaceFormat()
@@ -180,6 +184,23 @@ void Window::_initPhysicalDevice()
     if (!_surface) _initSurface();
 
     // if required set up physical device
+    if (!_physicalDevice && _traits->physicalDeviceIndex >= 0)
+    {
+        auto& physicalDevices = _instance->getPhysicalDevices();
+        if (static_cast<size_t>(_traits->physicalDeviceIndex) >= physicalDevices.size())
+        {
+            throw Exception{make_string("Error: vsg::Window::create(...) failed to create Window, WindowTraits::physicalDeviceIndex ", _traits->physicalDeviceIndex, " out of range, ", physicalDevices.size(), " PhysicalDevices available."), VK_ERROR_INVALID_EXTERNAL_HANDLE};
+        }
+
+        auto& physicalDevice = physicalDevices[_traits->physicalDeviceIndex];
+        if (auto [graphicsFamily, presentFamily] = physicalDevice->getQueueFamily(_traits->queueFlags, _surface); graphicsFamily < 0 || presentFamily < 0)
+        {
+            throw Exception{make_string("Error: vsg::Window::create(...) failed to create Window, PhysicalDevice ", _traits->physicalDeviceIndex, " can't present to the Window's surface."), VK_ERROR_INVALID_EXTERNAL_HANDLE};
+        }
+
+        _physicalDevice = physicalDevice;
+    }
+
     if (!_physicalDevice)
     {
         _physicalDevice = _instance->getPhysicalDevice(_traits->queueFlags, _surface, _traits->deviceTypePreferences);
@@ -231,10 +252,23 @@ void Window::_initDevice()
     deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
     deviceExtensions.insert(deviceExtensions.end(), _traits->deviceExtensionNames.begin(), _traits->deviceExtensionNames.end());
 
+    if (_traits->dynamicRendering)
+    {
+        if (_traits->vulkanVersion < VK_API_VERSION_1_3) deviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+
+        if (!_traits->deviceFeatures) _traits->deviceFeatures = DeviceFeatures::create();
+        _traits->deviceFeatures->get<VkPhysicalDeviceDynamicRenderingFeaturesKHR, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR>().dynamicRendering = VK_TRUE;
+    }
+
     auto [graphicsFamily, presentFamily] = _physicalDevice->getQueueFamily(_traits->queueFlags, _surface);
     if (graphicsFamily < 0 || presentFamily < 0) throw Exception{"Error: vsg::Window::create(...) failed to create Window, no suitable Vulkan Device available.", VK_ERROR_INVALID_EXTERNAL_HANDLE};
 
     vsg::QueueSettings queueSettings{vsg::QueueSetting{graphicsFamily, _traits->queuePriorities}, vsg::QueueSetting{presentFamily, {1.0}}};
+    if (_traits->asyncComputeQueue)
+    {
+        int computeFamily = _physicalDevice->getQueueFamily(VK_QUEUE_COMPUTE_BIT);
+        if (computeFamily >= 0 && computeFamily != graphicsFamily && computeFamily != presentFamily) queueSettings.push_back(vsg::QueueSetting{computeFamily, {1.0}});
+    }
     _device = vsg::Device::create(_physicalDevice, queueSettings, validatedNames, deviceExtensions, _traits->deviceFeatures, _instance->getAllocationCallbacks());
 
     _initFormats();
@@ -259,14 +293,36 @@ void Window::_initRenderPass()
 void Window::_initSwapchain()
 {
     if (!_device) _initDevice();
-    if (!_renderPass) _initRenderPass();
+    if (!_renderPass && !_traits->dynamicRendering) _initRenderPass();
 
     buildSwapchain();
 }
 
 void Window::buildSwapchain()
 {
-    if (_swapchain)
+    bool retireSwapchain = _swapchain && _traits->asynchronousSwapchainRecreation;
+    if (retireSwapchain)
+    {
+        // keep the previous swap chain's resources till the frames that used them have completed rather than waiting on the device.
+        RetiredSwapchain retired;
+        retired.swapchain = _swapchain;
+        retired.frames.swap(_frames);
+        retired.availableSemaphores.swap(_availableSemaphores);
+        for (auto attachment : std::initializer_list<ref_ptr<Object>>{_depthImageView, _depthImage, _multisampleImageView, _multisampleImage, _multisampleDepthImageView, _multisampleDepthImage})
+        {
+            if (attachment) retired.attachments.push_back(attachment);
+        }
+        _retiredSwapchains.push_back(retired);
+
+        _indices.clear();
+
+        _depthImageView.reset();
+        _depthImage.reset();
+
+        _multisampleImage.reset();
+        _multisampleImageView.reset();
+    }
+    else if (_swapchain)
     {
         // make sure all operations on the device have stopped before we go on deleting associated resources
         vkDeviceWaitIdle(*_device);
@@ -386,7 +442,9 @@ void Window::buildSwapchain()
         }
         attachments.push_back(_depthImageView);
 
-        ref_ptr<Framebuffer> fb = Framebuffer::create(_renderPass, attachments, _extent2D.width, _extent2D.height, 1);
+        // with dynamic rendering the RenderGraph uses the image views directly so no Framebuffer is required
+        ref_ptr<Framebuffer> fb;
+        if (!_traits->dynamicRendering) fb = Framebuffer::create(_renderPass, attachments, _extent2D.width, _extent2D.height, 1);
 
         ref_ptr<Semaphore> ias = vsg::Semaphore::create(_device, _traits->imageAvailableSemaphoreWaitFlag);
         ref_ptr<Semaphore> rfs = vsg::Semaphore::create(_device);
@@ -404,7 +462,7 @@ void Window::buildSwapchain()
     {
         // ensure image attachments are setup on GPU.
         auto commandPool = CommandPool::create(_device, graphicsFamily);
-        submitCommandsToQueue(commandPool, _device->getQueue(graphicsFamily), [&](CommandBuffer& commandBuffer) {
+        auto recordLayoutTransitions = [&](CommandBuffer& commandBuffer) {
             auto depthImageBarrier = ImageMemoryBarrier::create(
                 0, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
                 VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
@@ -430,7 +488,56 @@ void Window::buildSwapchain()
                     0, msImageBarrier);
                 msPipelineBarrier->record(commandBuffer);
             }
-        });
+        };
+
+        if (retireSwapchain)
+        {
+            // submit without waiting, the fence signal follows all the earlier submissions to the queue, including the frames that used the retired resources.
+            auto commandBuffer = commandPool->allocate();
+
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+            vkBeginCommandBuffer(*commandBuffer, &beginInfo);
+            recordLayoutTransitions(*commandBuffer);
+            vkEndCommandBuffer(*commandBuffer);
+
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = commandBuffer->data();
+
+            auto fence = Fence::create(_device);
+            if (VkResult result = _device->getQueue(graphicsFamily)->submit(submitInfo, fence); result == VK_SUCCESS)
+            {
+                auto& retired = _retiredSwapchains.back();
+                retired.commandBuffer = commandBuffer;
+                retired.fence = fence;
+            }
+            else
+            {
+                warn("Window::buildSwapchain() unable to submit layout transitions, result = ", result, ", waiting on device to release previous swapchain.");
+                vkDeviceWaitIdle(*_device);
+                _retiredSwapchains.clear();
+            }
+        }
+        else
+        {
+            submitCommandsToQueue(commandPool, _device->getQueue(graphicsFamily), recordLayoutTransitions);
+        }
+    }
+}
+
+void Window::releaseRetiredSwapchains()
+{
+    while (!_retiredSwapchains.empty())
+    {
+        // retired in submission order so the later entries can't have completed before the first
+        auto& retired = _retiredSwapchains.front();
+        if (retired.fence && retired.fence->status() != VK_SUCCESS) return;
+
+        _retiredSwapchains.pop_front();
     }
 }
 
@@ -438,6 +545,8 @@ VkResult Window::acquireNextImage(uint64_t timeout)
 {
     if (!_swapchain) _initSwapchain();
 
+    if (!_retiredSwapchains.empty()) releaseRetiredSwapchains();
+
     auto& availableSemaphore = _availableSemaphores[_availableSemaphoreIndex];
     _availableSemaphoreIndex = (_availableSemaphoreIndex + 1) % _availableSemaphores.size();
 
@@ -480,3 +589,43 @@ bool Window::pollEvents(vsg::UIEvents& events)
 
     return false;
 }
+
+void Window::bufferMoveEvent(time_point time, int32_t x, int32_t y, uint16_t buttonMask)
+{
+    auto mask = static_cast<ButtonMask>(buttonMask);
+
+    if (coalesceMoveEvents && !bufferedEvents.empty())
+    {
+        if (auto previous = bufferedEvents.back().cast<MoveEvent>(); previous && previous->mask == mask)
+        {
+            previous->time = time;
+            previous->x = x;
+            previous->y = y;
+            return;
+        }
+    }
+
+    // reuse a pooled MoveEvent that is only referenced by the pool
+    static constexpr size_t maxPoolSize = 64;
+    for (size_t i = 0; i < _moveEventPool.size(); ++i)
+    {
+        auto& moveEvent = _moveEventPool[(_moveEventPoolIndex + i) % _moveEventPool.size()];
+        if (moveEvent->referenceCount() == 1)
+        {
+            _moveEventPoolIndex = (_moveEventPoolIndex + i + 1) % _moveEventPool.size();
+
+            moveEvent->window = this;
+            moveEvent->time = time;
+            moveEvent->handled = false;
+            moveEvent->x = x;
+            moveEvent->y = y;
+            moveEvent->mask = mask;
+            bufferedEvents.emplace_back(moveEvent);
+            return;
+        }
+    }
+
+    auto moveEvent = MoveEvent::create(this, time, x, y, mask);
+    if (_moveEventPool.size() < maxPoolSize) _moveEventPool.push_back(moveEvent);
+    bufferedEvents.emplace_back(moveEvent);
+}
@@ -45,6 +45,9 @@ WindowTraits::WindowTraits(CommandLine& arguments)
     if (arguments.read({"--fullscreen", "--fs"})) fullscreen = true;
     if (arguments.read({"--window", "-w"}, width, height)) { fullscreen = false; }
     if (arguments.read({"--no-frame"})) decoration = false;
+    if (arguments.read("--dynamic-rendering")) dynamicRendering = true;
+    if (arguments.read("--coalesce-move-events")) coalesceMoveEvents = true;
+    if (arguments.read("--async-swapchain")) asynchronousSwapchainRecreation = true;
     if (arguments.read("--or")) overrideRedirect = true;
 
     if (arguments.read("--d32")) depthFormat = VK_FORMAT_D32_SFLOAT;
@@ -64,6 +67,7 @@ WindowTraits::WindowTraits(CommandLine& arguments)
     if (arguments.read("--prefer-discrete")) setDevicePref(VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU);
     if (arguments.read("--prefer-virtual")) setDevicePref(VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU);
     if (arguments.read("--prefer-cpu")) setDevicePref(VK_PHYSICAL_DEVICE_TYPE_CPU);
+    arguments.read("--gpu", physicalDeviceIndex);
 }
 
 WindowTraits::WindowTraits(const WindowTraits& traits, const CopyOp& copyop) :
@@ -87,6 +91,9 @@ WindowTraits::WindowTraits(const WindowTraits& traits, const CopyOp& copyop) :
     queueFlags(traits.queueFlags),
     queuePriorities(traits.queuePriorities),
     imageAvailableSemaphoreWaitFlag(traits.imageAvailableSemaphoreWaitFlag),
+    dynamicRendering(traits.dynamicRendering),
+    coalesceMoveEvents(traits.coalesceMoveEvents),
+    asynchronousSwapchainRecreation(traits.asynchronousSwapchainRecreation),
     debugLayer(traits.debugLayer),
     synchronizationLayer(traits.synchronizationLayer),
     apiDumpLayer(traits.apiDumpLayer),
@@ -97,6 +104,7 @@ WindowTraits::WindowTraits(const WindowTraits& traits, const CopyOp& copyop) :
     deviceExtensionNames(traits.deviceExtensionNames),
     deviceTypePreferences(traits.deviceTypePreferences),
     deviceFeatures(traits.deviceFeatures),
+    physicalDeviceIndex(traits.physicalDeviceIndex),
     samples(traits.samples) /*,
     nativeWindow(traits.nativeWindow),
     systemConnection(traits.systemConnection)*/
@@ -45,7 +45,7 @@ void CopyAndReleaseBuffer::copy(ref_ptr<Data> data, ref_ptr<BufferInfo> dest)
     if (!stagingMemory) return;
 
     // copy data to staging memory
-    stagingMemory->copy(imageStagingBuffer->getMemoryOffset(deviceID) + stagingBufferInfo->offset, dataSize, data->dataPointer());
+    stagingMemory->copy(imageStagingBuffer->getMemoryOffset(deviceID) + stagingBufferInfo->offset, data);
 
     add(stagingBufferInfo, dest);
 }
@@ -13,8 +13,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/app/TransferTask.h>
 #include <vsg/commands/CopyAndReleaseImage.h>
 #include <vsg/commands/PipelineBarrier.h>
+#include <vsg/core/CompressedData.h>
 #include <vsg/io/Logger.h>
 #include <vsg/utils/Instrumentation.h>
+#include <vsg/utils/ProcessImages.h>
 
 using namespace vsg;
 
@@ -107,35 +109,22 @@ void CopyAndReleaseImage::copy(ref_ptr<Data> data, ref_ptr<ImageInfo> dest, uint
         cd.layout.format = targetFormat;
         cd.layout.stride = targetTraits.size;
 
-        // set up a vec4 worth of default values for the type
-        const uint8_t* default_ptr = targetTraits.defaultValue;
-        uint32_t bytesFromSource = sourceTraits.size;
-        uint32_t bytesToTarget = targetTraits.size;
-
-        // copy data
-        using value_type = uint8_t;
-        const value_type* src_ptr = reinterpret_cast<const value_type*>(data->dataPointer());
-
         void* buffer_data;
         imageStagingMemory->map(imageStagingBuffer->getMemoryOffset(deviceID) + stagingBufferInfo->offset, imageTotalSize, 0, &buffer_data);
-        value_type* dest_ptr = reinterpret_cast<value_type*>(buffer_data);
 
-        size_t valueCount = data->valueCount();
-        for (size_t i = 0; i < valueCount; ++i)
+        // compressed data is decompressed to a temporary before expanding
+        const void* source = data->dataPointer();
+        std::vector<uint8_t> decompressed;
+        if (!source)
         {
-            uint32_t s = 0;
-            for (; s < bytesFromSource; ++s)
-            {
-                (*dest_ptr++) = *(src_ptr++);
-            }
-
-            const value_type* src_default = default_ptr;
-            for (; s < bytesToTarget; ++s)
-            {
-                (*dest_ptr++) = *(src_default++);
-            }
+            decompressed.resize(data->dataSize());
+            copyData(*data, decompressed.data());
+            source = decompressed.data();
         }
 
+        // copy data, filling the extra components with the default values for the type
+        expandPixels(reinterpret_cast<const uint8_t*>(source), sourceTraits.size, reinterpret_cast<uint8_t*>(buffer_data), targetTraits.size, targetTraits.defaultValue, data->valueCount());
+
         imageStagingMemory->unmap();
 
         add(cd);
@@ -158,7 +147,7 @@ void CopyAndReleaseImage::_copyDirectly(ref_ptr<Data> data, ref_ptr<ImageInfo> d
     if (!imageStagingMemory) return;
 
     // copy data to staging memory
-    imageStagingMemory->copy(imageStagingBuffer->getMemoryOffset(deviceID) + stagingBufferInfo->offset, imageTotalSize, data->dataPointer());
+    imageStagingMemory->copy(imageStagingBuffer->getMemoryOffset(deviceID) + stagingBufferInfo->offset, data);
 
     add(stagingBufferInfo, dest, numMipMapLevels);
 }
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/commands/NextSubPass.h>
 #include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/State.h>
 
 using namespace vsg;
 
@@ -36,4 +37,10 @@ void NextSubPass::write(Output& output) const
 void NextSubPass::record(CommandBuffer& commandBuffer) const
 {
     vkCmdNextSubpass(commandBuffer, contents);
+
+    if (auto state = commandBuffer.state)
+    {
+        ++(state->subpass);
+        state->subpassContents = contents;
+    }
 }
@@ -127,3 +127,31 @@ void PipelineBarrier::record(CommandBuffer& commandBuffer) const
 
     scratchMemory.release();
 }
+
+QueueFamilyOwnershipTransfer vsg::createQueueFamilyOwnershipTransfer(ref_ptr<Buffer> buffer, VkDeviceSize offset, VkDeviceSize size,
+                                                                     uint32_t srcQueueFamily, VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask,
+                                                                     uint32_t dstQueueFamily, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask)
+{
+    // the release's dstAccessMask and the acquire's srcAccessMask are ignored, visibility is provided by the semaphore between the submissions
+    auto releaseBarrier = BufferMemoryBarrier::create(srcAccessMask, 0, srcQueueFamily, dstQueueFamily, buffer, offset, size);
+    auto acquireBarrier = BufferMemoryBarrier::create(0, dstAccessMask, srcQueueFamily, dstQueueFamily, buffer, offset, size);
+
+    QueueFamilyOwnershipTransfer transfer;
+    transfer.release = PipelineBarrier::create(srcStageMask, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, releaseBarrier);
+    transfer.acquire = PipelineBarrier::create(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStageMask, 0, acquireBarrier);
+    return transfer;
+}
+
+QueueFamilyOwnershipTransfer vsg::createQueueFamilyOwnershipTransfer(ref_ptr<Image> image, const VkImageSubresourceRange& subresourceRange, VkImageLayout oldLayout, VkImageLayout newLayout,
+                                                                     uint32_t srcQueueFamily, VkPipelineStageFlags srcStageMask, VkAccessFlags srcAccessMask,
+                                                                     uint32_t dstQueueFamily, VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask)
+{
+    // the layout transition is specified identically in both barriers and happens once, between the release and the acquire
+    auto releaseBarrier = ImageMemoryBarrier::create(srcAccessMask, 0, oldLayout, newLayout, srcQueueFamily, dstQueueFamily, image, subresourceRange);
+    auto acquireBarrier = ImageMemoryBarrier::create(0, dstAccessMask, oldLayout, newLayout, srcQueueFamily, dstQueueFamily, image, subresourceRange);
+
+    QueueFamilyOwnershipTransfer transfer;
+    transfer.release = PipelineBarrier::create(srcStageMask, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, releaseBarrier);
+    transfer.acquire = PipelineBarrier::create(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, dstStageMask, 0, acquireBarrier);
+    return transfer;
+}
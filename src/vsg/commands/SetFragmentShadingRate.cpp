@@ -0,0 +1,49 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/SetFragmentShadingRate.h>
+#include <vsg/vk/CommandBuffer.h>
+
+using namespace vsg;
+
+SetFragmentShadingRate::SetFragmentShadingRate(const VkExtent2D& in_fragmentSize) :
+    fragmentSize(in_fragmentSize)
+{
+}
+
+void SetFragmentShadingRate::read(Input& input)
+{
+    Command::read(input);
+
+    input.read("fragmentSize.width", fragmentSize.width);
+    input.read("fragmentSize.height", fragmentSize.height);
+    input.readValue<uint32_t>("combinerOp0", combinerOps[0]);
+    input.readValue<uint32_t>("combinerOp1", combinerOps[1]);
+}
+
+void SetFragmentShadingRate::write(Output& output) const
+{
+    Command::write(output);
+
+    output.write("fragmentSize.width", fragmentSize.width);
+    output.write("fragmentSize.height", fragmentSize.height);
+    output.writeValue<uint32_t>("combinerOp0", combinerOps[0]);
+    output.writeValue<uint32_t>("combinerOp1", combinerOps[1]);
+}
+
+void SetFragmentShadingRate::record(CommandBuffer& commandBuffer) const
+{
+    auto extensions = commandBuffer.getDevice()->getExtensions();
+    if (!extensions->vkCmdSetFragmentShadingRateKHR) return;
+
+    extensions->vkCmdSetFragmentShadingRateKHR(commandBuffer, &fragmentSize, combinerOps);
+}
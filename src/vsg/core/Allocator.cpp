@@ -10,6 +10,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/AllocatorArena.h>
 #include <vsg/core/Exception.h>
 #include <vsg/core/IntrusiveAllocator.h>
 #include <vsg/io/FileSystem.h>
@@ -33,10 +34,42 @@ std::unique_ptr<Allocator>& Allocator::instance()
 //
 void* vsg::allocate(std::size_t size, AllocatorAffinity allocatorAffinity)
 {
+    if (auto arena = AllocatorArenaScope::current()) return arena->allocate(size);
+
     return Allocator::instance()->allocate(size, allocatorAffinity);
 }
 
 void vsg::deallocate(void* ptr, std::size_t size)
 {
+    if (auto arena = AllocatorArena::find(ptr))
+    {
+        arena->deallocate(ptr);
+        return;
+    }
+
     Allocator::instance()->deallocate(ptr, size);
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// AllocationTag
+//
+std::atomic_bool AllocationTag::enabled{false};
+
+static thread_local const char* s_currentAllocationTag = nullptr;
+
+AllocationTag::AllocationTag(const char* name) :
+    _previous(s_currentAllocationTag)
+{
+    s_currentAllocationTag = name;
+}
+
+AllocationTag::~AllocationTag()
+{
+    s_currentAllocationTag = _previous;
+}
+
+const char* AllocationTag::current()
+{
+    return s_currentAllocationTag;
+}
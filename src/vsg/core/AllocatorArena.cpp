@@ -0,0 +1,171 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/AllocatorArena.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <shared_mutex>
+
+using namespace vsg;
+
+namespace
+{
+    /// address ranges of the blocks of all the AllocatorArena, so that vsg::deallocate(..) can find the arena that a pointer was allocated from
+    struct ArenaBlocks
+    {
+        std::shared_mutex mutex;
+        std::map<const uint8_t*, std::pair<const uint8_t*, AllocatorArena*>> blocks;
+
+        // bounds of all the blocks ever registered, used to quickly reject pointers that can't be from an arena without taking the mutex
+        std::atomic<uintptr_t> minAddress{UINTPTR_MAX};
+        std::atomic<uintptr_t> maxAddress{0};
+    };
+
+    ArenaBlocks& arenaBlocks()
+    {
+        // intentionally not deleted so that it remains valid for arenas released during static destruction
+        static auto* s_arenaBlocks = new ArenaBlocks;
+        return *s_arenaBlocks;
+    }
+
+    thread_local AllocatorArena* s_currentArena = nullptr;
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// AllocatorArena
+//
+AllocatorArena::AllocatorArena(size_t in_blockSize, size_t in_alignment) :
+    blockSize(in_blockSize),
+    alignment(std::max(in_alignment, sizeof(void*)))
+{
+}
+
+AllocatorArena::~AllocatorArena()
+{
+    auto& registry = arenaBlocks();
+    {
+        std::unique_lock<std::shared_mutex> lock(registry.mutex);
+        for (auto& block : _blocks)
+        {
+            registry.blocks.erase(block.memory);
+        }
+    }
+
+    // free all the memory allocated from the arena in one pass
+    for (auto& block : _blocks)
+    {
+        ::operator delete(block.memory, std::align_val_t{alignment});
+    }
+}
+
+uint8_t* AllocatorArena::_allocateBlock(size_t size)
+{
+    auto memory = static_cast<uint8_t*>(::operator new(size, std::align_val_t{alignment}));
+    _blocks.push_back(Block{memory, size});
+    _totalMemorySize.fetch_add(size);
+
+    auto& registry = arenaBlocks();
+    {
+        std::unique_lock<std::shared_mutex> lock(registry.mutex);
+        registry.blocks[memory] = {memory + size, this};
+    }
+
+    auto address = reinterpret_cast<uintptr_t>(memory);
+    auto minAddress = registry.minAddress.load();
+    while (address < minAddress && !registry.minAddress.compare_exchange_weak(minAddress, address)) {}
+    auto maxAddress = registry.maxAddress.load();
+    while ((address + size) > maxAddress && !registry.maxAddress.compare_exchange_weak(maxAddress, address + size)) {}
+
+    return memory;
+}
+
+void* AllocatorArena::allocate(std::size_t size)
+{
+    size_t alignedSize = ((std::max(size, size_t(1)) + alignment - 1) / alignment) * alignment;
+
+    void* ptr = nullptr;
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+
+        if (alignedSize > blockSize / 2)
+        {
+            // large allocations get a block of their own so they don't waste the remainder of the current block
+            ptr = _allocateBlock(alignedSize);
+        }
+        else
+        {
+            if (!_ptr || (_ptr + alignedSize) > _end)
+            {
+                _ptr = _allocateBlock(blockSize);
+                _end = _ptr + blockSize;
+            }
+
+            ptr = _ptr;
+            _ptr += alignedSize;
+        }
+    }
+
+    // each allocation keeps the arena's memory valid until it's deallocated
+    ref();
+    _numAllocations.fetch_add(1);
+
+    return ptr;
+}
+
+void AllocatorArena::deallocate(void* /*ptr*/)
+{
+    // the memory is only reclaimed when the whole arena is freed
+    _numAllocations.fetch_sub(1);
+    unref();
+}
+
+AllocatorArena* AllocatorArena::find(const void* ptr)
+{
+    auto& registry = arenaBlocks();
+
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    if (address < registry.minAddress.load(std::memory_order_relaxed) || address >= registry.maxAddress.load(std::memory_order_relaxed)) return nullptr;
+
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+
+    auto itr = registry.blocks.upper_bound(static_cast<const uint8_t*>(ptr));
+    if (itr == registry.blocks.begin()) return nullptr;
+    --itr;
+
+    return (ptr < itr->second.first) ? itr->second.second : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// AllocatorArenaScope
+//
+AllocatorArenaScope::AllocatorArenaScope(ref_ptr<AllocatorArena> arena) :
+    _arena(arena),
+    _previous(s_currentArena)
+{
+    s_currentArena = _arena.get();
+}
+
+AllocatorArenaScope::~AllocatorArenaScope()
+{
+    s_currentArena = _previous;
+}
+
+AllocatorArena* AllocatorArenaScope::current()
+{
+    return s_currentArena;
+}
@@ -0,0 +1,206 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/CompressedData.h>
+#include <vsg/core/MipmapLayout.h>
+#include <vsg/core/compare.h>
+#include <vsg/core/hash.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/Output.h>
+
+#include <cstring>
+#include <limits>
+
+using namespace vsg;
+
+CompressedData::CompressedData()
+{
+}
+
+CompressedData::CompressedData(const Data& data, CompressionMethod in_method, uint32_t in_chunkSize, int level) :
+    Inherit(data.properties),
+    method(in_method),
+    chunkSize(std::max(in_chunkSize, 1u)),
+    _dimensions(data.dimensions()),
+    _width(data.width()),
+    _height(data.height()),
+    _depth(data.depth()),
+    _valueSize(static_cast<uint32_t>(data.valueSize())),
+    _valueCount(data.valueCount()),
+    _dataSize(data.dataSize())
+{
+    setMipmapLayout(const_cast<MipmapLayout*>(data.getMipmapLayout()));
+
+    auto src = static_cast<const uint8_t*>(data.dataPointer());
+    if (!src || _dataSize == 0)
+    {
+        warn("CompressedData::CompressedData() source ", &data, " has no values to compress.");
+        return;
+    }
+
+    if (!compressionSupported(method) || method == COMPRESSION_NONE)
+    {
+        warn("CompressedData::CompressedData() compression method ", static_cast<uint32_t>(method), " not supported by this build.");
+        return;
+    }
+
+    size_t numChunks = static_cast<size_t>((_dataSize + chunkSize - 1) / chunkSize);
+    std::vector<uint8_t> compressed;
+    compressed.reserve(static_cast<size_t>(_dataSize / 2));
+    std::vector<uint8_t> buffer(compressBound(method, chunkSize));
+
+    chunks.resize(numChunks);
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+        const uint8_t* chunk_src = src + i * chunkSize;
+        uint32_t size = chunkDataSize(i);
+
+        // chunks that don't compress are stored as is, so a chunk's compressed size is never larger than its uncompressed size
+        size_t compressedSize = compress(method, level, chunk_src, size, buffer.data(), buffer.size());
+        if (compressedSize == 0 || compressedSize >= size)
+        {
+            chunks[i] = Chunk{static_cast<uint32_t>(compressed.size()), size};
+            compressed.insert(compressed.end(), chunk_src, chunk_src + size);
+        }
+        else
+        {
+            chunks[i] = Chunk{static_cast<uint32_t>(compressed.size()), static_cast<uint32_t>(compressedSize)};
+            compressed.insert(compressed.end(), buffer.data(), buffer.data() + compressedSize);
+        }
+
+        if (compressed.size() > std::numeric_limits<uint32_t>::max())
+        {
+            warn("CompressedData::CompressedData() compressed size exceeds 4GB, unable to compress ", &data);
+            chunks.clear();
+            return;
+        }
+    }
+
+    payload = ubyteArray::create(static_cast<uint32_t>(compressed.size()));
+    std::memcpy(payload->data(), compressed.data(), compressed.size());
+
+    dirty();
+}
+
+CompressedData::~CompressedData()
+{
+}
+
+bool CompressedData::decompress(void* dest) const
+{
+    if (!valid()) return false;
+
+    auto src = payload->data();
+    auto dest_ptr = static_cast<uint8_t*>(dest);
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+        const auto& chunk = chunks[i];
+        uint32_t size = chunkDataSize(i);
+        if (static_cast<size_t>(chunk.offset) + chunk.size > payload->size()) return false;
+
+        if (chunk.size == size)
+        {
+            std::memcpy(dest_ptr + i * chunkSize, src + chunk.offset, size);
+        }
+        else if (!vsg::decompress(method, src + chunk.offset, chunk.size, dest_ptr + i * chunkSize, size))
+        {
+            warn("CompressedData::decompress() failed to decompress chunk ", i, " of ", this);
+            return false;
+        }
+    }
+    return true;
+}
+
+int CompressedData::compare(const Object& rhs_object) const
+{
+    int result = Object::compare(rhs_object);
+    if (result != 0) return result;
+
+    auto& rhs = static_cast<decltype(*this)>(rhs_object);
+
+    if ((result = properties.compare(rhs.properties))) return result;
+    if ((result = compare_value(_dataSize, rhs._dataSize))) return result;
+    if ((result = compare_value(method, rhs.method))) return result;
+    if ((result = compare_value(chunkSize, rhs.chunkSize))) return result;
+
+    if (payload == rhs.payload) return 0;
+    if (!payload) return -1;
+    if (!rhs.payload) return 1;
+    return payload->compare(*rhs.payload);
+}
+
+uint64_t CompressedData::hash() const
+{
+    uint64_t value = hash_bytes(&properties.format, sizeof(properties.format));
+    value = hash_combine(value, _dataSize);
+    value = hash_combine(value, (uint64_t(method) << 32) | chunkSize);
+    if (payload) value = hash_combine(value, payload->hash());
+    return hash_mix(value);
+}
+
+void CompressedData::read(Input& input)
+{
+    Data::read(input);
+
+    uint32_t methodValue = 0;
+    input.read("method", methodValue);
+    method = static_cast<CompressionMethod>(methodValue);
+    input.read("chunkSize", chunkSize);
+    input.read("dimensions", _dimensions, _width, _height, _depth);
+    input.read("valueSize", _valueSize);
+    input.read("valueCount", _valueCount);
+    input.read("dataSize", _dataSize);
+
+    chunks.resize(input.readValue<uint32_t>("numChunks"));
+    for (auto& chunk : chunks)
+    {
+        input.read("chunk", chunk.offset, chunk.size);
+    }
+
+    input.readObject("payload", payload);
+
+    dirty();
+}
+
+void CompressedData::write(Output& output) const
+{
+    Data::write(output);
+
+    uint32_t methodValue = method;
+    output.write("method", methodValue);
+    output.write("chunkSize", chunkSize);
+    output.write("dimensions", _dimensions, _width, _height, _depth);
+    output.write("valueSize", _valueSize);
+    output.write("valueCount", _valueCount);
+    output.write("dataSize", _dataSize);
+
+    output.writeValue<uint32_t>("numChunks", chunks.size());
+    for (const auto& chunk : chunks)
+    {
+        output.write("chunk", chunk.offset, chunk.size);
+    }
+
+    output.writeObject("payload", payload);
+}
+
+bool vsg::copyData(const Data& data, void* dest)
+{
+    if (auto compressed = data.cast<CompressedData>()) return compressed->decompress(dest);
+
+    auto src = data.dataPointer();
+    if (!src) return false;
+
+    std::memcpy(dest, src, data.dataSize());
+    return true;
+}
@@ -594,6 +594,10 @@ void ConstVisitor::apply(const QuadGroup& value)
 {
     apply(static_cast<const Node&>(value));
 }
+void ConstVisitor::apply(const ParallelGroup& value)
+{
+    apply(static_cast<const Group&>(value));
+}
 void ConstVisitor::apply(const LOD& value)
 {
     apply(static_cast<const Node&>(value));
@@ -602,14 +606,46 @@ void ConstVisitor::apply(const PagedLOD& value)
 {
     apply(static_cast<const Node&>(value));
 }
+void ConstVisitor::apply(const PointCloudTile& value)
+{
+    apply(static_cast<const PagedLOD&>(value));
+}
+void ConstVisitor::apply(const PointCloud& value)
+{
+    apply(static_cast<const Node&>(value));
+}
 void ConstVisitor::apply(const StateGroup& value)
 {
     apply(static_cast<const Group&>(value));
 }
+void ConstVisitor::apply(const StreamingStateGroup& value)
+{
+    apply(static_cast<const StateGroup&>(value));
+}
 void ConstVisitor::apply(const CullGroup& value)
 {
     apply(static_cast<const Group&>(value));
 }
+void ConstVisitor::apply(const BatchedCullGroup& value)
+{
+    apply(static_cast<const Group&>(value));
+}
+void ConstVisitor::apply(const LazyCompileGroup& value)
+{
+    apply(static_cast<const Group&>(value));
+}
+void ConstVisitor::apply(const SpatialGrid& value)
+{
+    apply(static_cast<const Group&>(value));
+}
+void ConstVisitor::apply(const PackedSubgraph& value)
+{
+    apply(static_cast<const Node&>(value));
+}
+void ConstVisitor::apply(const PackedDraws& value)
+{
+    apply(static_cast<const Node&>(value));
+}
 void ConstVisitor::apply(const CullNode& value)
 {
     apply(static_cast<const Node&>(value));
@@ -682,6 +718,10 @@ void ConstVisitor::apply(const RegionOfInterest& value)
 {
     apply(static_cast<const Node&>(value));
 }
+void ConstVisitor::apply(const Occluder& value)
+{
+    apply(static_cast<const Node&>(value));
+}
 void ConstVisitor::apply(const InstanceNode& value)
 {
     apply(static_cast<const Compilable&>(value));
@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Auxiliary.h>
 #include <vsg/core/Data.h>
 #include <vsg/core/MipmapLayout.h>
+#include <vsg/core/hash.h>
 #include <vsg/io/Input.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/Output.h>
@@ -39,6 +40,7 @@ Data::Properties& Data::Properties::operator=(const Properties& rhs)
     imageViewType = rhs.imageViewType;
     dataVariance = rhs.dataVariance;
     allocatorType = rhs.allocatorType;
+    alignment = rhs.alignment;
 
     return *this;
 }
@@ -115,8 +117,30 @@ void Data::write(Output& output) const
     }
 }
 
+uint64_t Data::hash() const
+{
+    uint64_t cached = _cachedHash.load();
+    if (cached != 0 && static_cast<uint32_t>(cached) == _modifiedCount.count) return hash_mix(cached);
+
+    auto name = className();
+    uint64_t value = hash_bytes(name, std::strlen(name));
+    value = hash_bytes(&properties.format, sizeof(properties.format), value);
+    value = hash_combine(value, properties.stride);
+    value = hash_combine(value, (uint64_t(properties.mipLevels) << 32) | (uint64_t(properties.blockWidth) << 16) | (uint64_t(properties.blockHeight) << 8) | properties.blockDepth);
+    value = hash_combine(value, (uint64_t(properties.origin) << 32) | (uint64_t(static_cast<uint8_t>(properties.imageViewType)) << 8) | uint64_t(properties.dataVariance));
+    if (size_t size = dataSize(); size > 0) value = hash_bytes(dataPointer(), size, value);
+
+    uint64_t packed = (value & 0xffffffff00000000ull) | _modifiedCount.count;
+    if (packed == 0) packed = 0x100000000ull;
+    _cachedHash.store(packed);
+
+    return hash_mix(packed);
+}
+
 void Data::_copy(const Data& rhs)
 {
+    _cachedHash.store(0);
+
     properties = rhs.properties;
     if (rhs.getAuxiliary())
     {
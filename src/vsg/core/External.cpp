@@ -15,8 +15,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/io/Input.h>
 #include <vsg/io/Output.h>
+#include <vsg/io/Options.h>
 #include <vsg/io/read.h>
 #include <vsg/io/write.h>
+#include <vsg/threading/OperationThreads.h>
 
 #include <map>
 #include <unordered_map>
@@ -78,6 +80,12 @@ void External::read(Input& input)
 {
     entries.clear();
 
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        _attempted.clear();
+        _prefetching.clear();
+    }
+
     Object::read(input);
 
     input.read("options", options);
@@ -93,15 +101,28 @@ void External::read(Input& input)
         collectIDs.objectIDRangeMap[filename] = objectIDRange;
     }
 
-    if (options)
-    {
-        entries = vsg::read(filenames, options);
-    }
-    else
+    _inputOptions = input.options;
+
+    auto readOptions = _readOptions();
+    lazy = readOptions && readOptions->lazyExternalHint;
+    if (lazy)
     {
-        entries = vsg::read(filenames, input.options);
+        // defer reading the files till they are required, any references to the objects within them are read as null.
+        for (auto& filename : filenames)
+        {
+            entries[filename] = nullptr;
+
+            const auto& objectIDRange = collectIDs.objectIDRangeMap[filename];
+            for (uint32_t objectID = objectIDRange.startID; objectID <= objectIDRange.endID; ++objectID)
+            {
+                input.objectIDMap[objectID] = nullptr;
+            }
+        }
+        return;
     }
 
+    entries = vsg::read(filenames, readOptions);
+
     // collect the ids from the files
     for (auto itr = entries.begin(); itr != entries.end(); ++itr)
     {
@@ -172,3 +193,106 @@ void External::write(Output& output) const
         }
     }
 }
+
+void External::traverse(Visitor& visitor)
+{
+    if (lazy) resolveAll();
+
+    t_traverse(*this, visitor);
+}
+
+ref_ptr<const Options> External::_readOptions() const
+{
+    if (options) return options;
+    return _inputOptions;
+}
+
+ref_ptr<Object> External::getObject(const Path& filename)
+{
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        auto itr = entries.find(filename);
+        if (itr == entries.end()) return {};
+        if (itr->second || !lazy || !filename || _attempted.count(filename) != 0) return itr->second;
+    }
+
+    // read without holding the lock so that other entries can be resolved in parallel
+    auto object = vsg::read(filename, _readOptions());
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _attempted.insert(filename);
+    _prefetching.erase(filename);
+
+    // another thread may have read the entry while this thread was reading it
+    auto& entry = entries[filename];
+    if (!entry) entry = object;
+    return entry;
+}
+
+bool External::resolved(const Path& filename) const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    auto itr = entries.find(filename);
+    if (itr == entries.end()) return false;
+    return itr->second || !lazy || _attempted.count(filename) != 0;
+}
+
+void External::prefetch(const Paths& filenames)
+{
+    auto readOptions = _readOptions();
+    if (!lazy || !readOptions || !readOptions->operationThreads) return;
+
+    struct PrefetchOperation : public Operation
+    {
+        PrefetchOperation(ref_ptr<External> in_external, const Path& in_filename) :
+            external(in_external),
+            filename(in_filename) {}
+
+        void run() override
+        {
+            external->getObject(filename);
+        }
+
+        ref_ptr<External> external;
+        Path filename;
+    };
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    for (auto& filename : filenames)
+    {
+        auto itr = entries.find(filename);
+        if (itr == entries.end() || itr->second || !filename) continue;
+        if (_attempted.count(filename) != 0 || _prefetching.count(filename) != 0) continue;
+
+        _prefetching.insert(filename);
+        readOptions->operationThreads->add(ref_ptr<Operation>(new PrefetchOperation(ref_ptr<External>(this), filename)));
+    }
+}
+
+void External::resolveAll()
+{
+    if (!lazy) return;
+
+    Paths filenames;
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        for (auto& [filename, object] : entries)
+        {
+            if (!object && filename && _attempted.count(filename) == 0) filenames.push_back(filename);
+        }
+    }
+
+    if (filenames.empty()) return;
+
+    auto objects = vsg::read(filenames, _readOptions());
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    for (auto& [filename, object] : objects)
+    {
+        _attempted.insert(filename);
+        _prefetching.erase(filename);
+
+        auto& entry = entries[filename];
+        if (!entry) entry = object;
+    }
+}
@@ -14,10 +14,18 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/IntrusiveAllocator.h>
 #include <vsg/io/FileSystem.h>
 #include <vsg/io/Logger.h>
+#include <vsg/utils/Instrumentation.h>
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <set>
+
+#if defined(__linux__)
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
 
 using namespace vsg;
 
@@ -101,6 +109,20 @@ IntrusiveAllocator::MemoryBlock::~MemoryBlock()
     operator delete(memory, std::align_val_t{blockAlignment});
 }
 
+void IntrusiveAllocator::MemoryBlock::bindToLocalNumaNode()
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    // MPOL_LOCAL from <linux/mempolicy.h>, not included to avoid requiring the kernel headers
+    constexpr int mpol_local = 4;
+
+    // mbind(..) requires a page aligned range so skip the partial pages at either end of the block
+    auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    auto begin = ((reinterpret_cast<uintptr_t>(memory) + pageSize - 1) / pageSize) * pageSize;
+    auto end = (reinterpret_cast<uintptr_t>(memoryEnd) / pageSize) * pageSize;
+    if (begin < end) syscall(SYS_mbind, begin, end - begin, mpol_local, nullptr, 0, 0);
+#endif
+}
+
 bool IntrusiveAllocator::MemoryBlock::freeSlotsAvaible(size_t size) const
 {
     if (size > maximumAllocationSize) return false;
@@ -753,6 +775,8 @@ void* IntrusiveAllocator::MemoryBlocks::allocate(std::size_t size)
     }
 
     auto new_block = std::make_shared<MemoryBlock>(name, new_blockSize, alignment);
+    new_block->affinity = affinity;
+    if (parent && parent->numaLocalBlocks) new_block->bindToLocalNumaNode();
     if (parent)
     {
         parent->memoryBlocks[new_block->memory] = new_block;
@@ -840,12 +864,241 @@ size_t IntrusiveAllocator::MemoryBlocks::totalMemorySize() const
     return count;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ThreadCache
+//
+namespace
+{
+    // registry of the IDs of live IntrusiveAllocator, so that thread caches released at thread exit only return slots to allocators that still exist.
+    // intentionally never deleted so that it remains valid for threads exiting during static destruction.
+    std::mutex& allocatorRegistryMutex()
+    {
+        static auto s_mutex = new std::mutex;
+        return *s_mutex;
+    }
+
+    std::set<uint64_t>& allocatorRegistry()
+    {
+        static auto s_registry = new std::set<uint64_t>;
+        return *s_registry;
+    }
+
+    std::atomic_uint64_t s_nextAllocatorID{1};
+
+    // set when the calling thread's caches have been released, after which all allocations fall back to taking the mutex.
+    thread_local bool s_threadCachesReleased = false;
+} // namespace
+
+struct IntrusiveAllocator::ThreadCache
+{
+    // slots are grouped into size classes of granularity bytes, slots in size class N have a capacity of at least N * granularity bytes.
+    static constexpr size_t granularity = 8;
+
+    struct BlockRange
+    {
+        const void* memory;
+        const void* memoryEnd;
+        MemoryBlock* block;
+    };
+
+    struct FreeSlots
+    {
+        void* head = nullptr;
+        size_t count = 0;
+    };
+
+    IntrusiveAllocator* allocator = nullptr;
+    uint64_t allocatorID = 0;
+    uint64_t blockGeneration = 0;
+
+    // sorted by memory, used to map pointers to their MemoryBlock without taking the mutex
+    std::vector<BlockRange> blockRanges;
+
+    // free slots indexed by [affinity][sizeClass], linked through the first pointer of each free slot
+    std::vector<std::vector<FreeSlots>> freeSlots;
+
+    // stats accumulated into the IntrusiveAllocator whenever the mutex is taken
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t flushes = 0;
+    int64_t slots = 0;
+
+    const BlockRange* find(const void* ptr) const
+    {
+        auto itr = std::upper_bound(blockRanges.begin(), blockRanges.end(), ptr, [](const void* p, const BlockRange& range) { return p < range.memory; });
+        if (itr == blockRanges.begin()) return nullptr;
+        --itr;
+        return (ptr < itr->memoryEnd) ? &(*itr) : nullptr;
+    }
+
+    void add(MemoryBlock* block)
+    {
+        BlockRange range{block->memory, block->memoryEnd, block};
+        auto itr = std::upper_bound(blockRanges.begin(), blockRanges.end(), range.memory, [](const void* p, const BlockRange& r) { return p < r.memory; });
+        blockRanges.insert(itr, range);
+    }
+
+    FreeSlots& getFreeSlots(uint32_t affinity, size_t sizeClass)
+    {
+        if (affinity >= freeSlots.size()) freeSlots.resize(affinity + 1);
+        auto& sizeClasses = freeSlots[affinity];
+        if (sizeClass >= sizeClasses.size()) sizeClasses.resize(sizeClass + 1);
+        return sizeClasses[sizeClass];
+    }
+
+    static void push(void*& head, size_t& count, void* ptr)
+    {
+        std::memcpy(ptr, &head, sizeof(void*));
+        head = ptr;
+        ++count;
+    }
+
+    static void* pop(void*& head, size_t& count)
+    {
+        void* ptr = head;
+        std::memcpy(&head, ptr, sizeof(void*));
+        --count;
+        return ptr;
+    }
+};
+
+struct IntrusiveAllocator::ThreadCaches
+{
+    std::vector<std::unique_ptr<ThreadCache>> caches;
+    ThreadCache* lastUsed = nullptr;
+
+    ~ThreadCaches()
+    {
+        s_threadCachesReleased = true;
+
+        std::scoped_lock<std::mutex> lock(allocatorRegistryMutex());
+        for (auto& cache : caches)
+        {
+            if (allocatorRegistry().count(cache->allocatorID) > 0)
+            {
+                SCOPED_LOCK_INSTRUMENTATION(cache->allocator->mutex, "Allocator::mutex");
+                cache->allocator->_releaseThreadCache(*cache);
+            }
+        }
+    }
+};
+
+IntrusiveAllocator::ThreadCache* IntrusiveAllocator::threadCache()
+{
+    if (s_threadCachesReleased) return nullptr;
+
+    thread_local ThreadCaches s_threadCaches;
+
+    auto cache = s_threadCaches.lastUsed;
+    if (cache && cache->allocator == this && cache->allocatorID == _allocatorID) return cache;
+
+    for (auto& tc : s_threadCaches.caches)
+    {
+        if (tc->allocator == this && tc->allocatorID == _allocatorID)
+        {
+            s_threadCaches.lastUsed = tc.get();
+            return tc.get();
+        }
+    }
+
+    auto new_cache = std::make_unique<ThreadCache>();
+    new_cache->allocator = this;
+    new_cache->allocatorID = _allocatorID;
+    new_cache->blockGeneration = _blockGeneration.load(std::memory_order_acquire);
+
+    s_threadCaches.lastUsed = new_cache.get();
+    s_threadCaches.caches.push_back(std::move(new_cache));
+    return s_threadCaches.lastUsed;
+}
+
+void IntrusiveAllocator::_accumulateThreadCacheStats(ThreadCache& cache)
+{
+    _threadCacheHits += cache.hits;
+    _threadCacheMisses += cache.misses;
+    _threadCacheFlushes += cache.flushes;
+    _threadCacheSlots += cache.slots;
+
+    cache.hits = 0;
+    cache.misses = 0;
+    cache.flushes = 0;
+    cache.slots = 0;
+}
+
+void* IntrusiveAllocator::_refillThreadCache(ThreadCache& cache, size_t sizeClass, AllocatorAffinity allocatorAffinity)
+{
+    // round up to the size class so that slots are returned to the same size class when deallocated
+    size_t size = sizeClass * ThreadCache::granularity;
+
+    void* ptr = _allocate(size, allocatorAffinity);
+    if (!ptr) return nullptr;
+
+    auto block = _findMemoryBlock(ptr);
+    if (!block) return ptr; // large allocation so not cacheable
+
+    if (!cache.find(ptr)) cache.add(block);
+
+    auto& freeSlots = cache.getFreeSlots(allocatorAffinity, sizeClass);
+    size_t numSlots = std::max(threadCacheSize / 4, size_t(1));
+    for (size_t i = 1; i < numSlots; ++i)
+    {
+        void* extra = _allocate(size, allocatorAffinity);
+        if (!extra) break;
+
+        if (!cache.find(extra))
+        {
+            if (auto extra_block = _findMemoryBlock(extra))
+            {
+                cache.add(extra_block);
+            }
+            else
+            {
+                _deallocate(extra, size);
+                break;
+            }
+        }
+
+        ThreadCache::push(freeSlots.head, freeSlots.count, extra);
+        ++cache.slots;
+    }
+
+    return ptr;
+}
+
+void IntrusiveAllocator::_flushThreadCache(ThreadCache& cache, void*& head, size_t& count, size_t numSlots)
+{
+    for (; numSlots > 0 && head; --numSlots)
+    {
+        void* ptr = ThreadCache::pop(head, count);
+        if (auto range = cache.find(ptr))
+            range->block->deallocate(ptr, 0);
+        else
+            _deallocate(ptr, 0);
+        --cache.slots;
+    }
+    ++cache.flushes;
+}
+
+void IntrusiveAllocator::_releaseThreadCache(ThreadCache& cache)
+{
+    for (auto& sizeClasses : cache.freeSlots)
+    {
+        for (auto& freeSlots : sizeClasses)
+        {
+            if (freeSlots.count > 0) _flushThreadCache(cache, freeSlots.head, freeSlots.count, freeSlots.count);
+        }
+    }
+
+    _accumulateThreadCacheStats(cache);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // IntrusiveAllocator
 //
 IntrusiveAllocator::IntrusiveAllocator(size_t in_defaultAlignment) :
-    Allocator(in_defaultAlignment)
+    Allocator(in_defaultAlignment),
+    _allocatorID(s_nextAllocatorID++)
 {
     size_t Megabyte = size_t(1024) * size_t(1024);
     size_t blockSize = size_t(1) * Megabyte;
@@ -855,10 +1108,16 @@ IntrusiveAllocator::IntrusiveAllocator(size_t in_defaultAlignment) :
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_DATA].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_DATA", size_t(16) * blockSize, defaultAlignment));
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_NODES].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_NODES", blockSize, defaultAlignment));
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_PHYSICS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_PHYSICS", blockSize, 16));
+
+    for (uint32_t affinity = 0; affinity < allocatorMemoryBlocks.size(); ++affinity) allocatorMemoryBlocks[affinity]->affinity = affinity;
+
+    std::scoped_lock<std::mutex> lock(allocatorRegistryMutex());
+    allocatorRegistry().insert(_allocatorID);
 }
 
 IntrusiveAllocator::IntrusiveAllocator(std::unique_ptr<Allocator> in_nestedAllocator, size_t in_defaultAlignment) :
-    Allocator(std::move(in_nestedAllocator), in_defaultAlignment)
+    Allocator(std::move(in_nestedAllocator), in_defaultAlignment),
+    _allocatorID(s_nextAllocatorID++)
 {
     size_t Megabyte = size_t(1024) * size_t(1024);
     size_t blockSize = size_t(1) * Megabyte;
@@ -868,15 +1127,22 @@ IntrusiveAllocator::IntrusiveAllocator(std::unique_ptr<Allocator> in_nestedAlloc
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_DATA].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_DATA", size_t(16) * blockSize, defaultAlignment));
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_NODES].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_NODES", blockSize, defaultAlignment));
     allocatorMemoryBlocks[vsg::ALLOCATOR_AFFINITY_PHYSICS].reset(new MemoryBlocks(this, "ALLOCATOR_AFFINITY_PHYSICS", blockSize, 16));
+
+    for (uint32_t affinity = 0; affinity < allocatorMemoryBlocks.size(); ++affinity) allocatorMemoryBlocks[affinity]->affinity = affinity;
+
+    std::scoped_lock<std::mutex> lock(allocatorRegistryMutex());
+    allocatorRegistry().insert(_allocatorID);
 }
 
 IntrusiveAllocator::~IntrusiveAllocator()
 {
+    std::scoped_lock<std::mutex> lock(allocatorRegistryMutex());
+    allocatorRegistry().erase(_allocatorID);
 }
 
 void IntrusiveAllocator::setBlockSize(AllocatorAffinity allocatorAffinity, size_t blockSize)
 {
-    std::scoped_lock<std::mutex> lock(mutex);
+    SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
 
     if (size_t(allocatorAffinity) < allocatorMemoryBlocks.size())
     {
@@ -888,12 +1154,17 @@ void IntrusiveAllocator::setBlockSize(AllocatorAffinity allocatorAffinity, size_
 
         allocatorMemoryBlocks.resize(allocatorAffinity + 1);
         allocatorMemoryBlocks[allocatorAffinity].reset(new MemoryBlocks(this, name, blockSize, defaultAlignment));
+        allocatorMemoryBlocks[allocatorAffinity]->affinity = allocatorAffinity;
     }
 }
 
 void IntrusiveAllocator::report(std::ostream& out) const
 {
+    SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
+
     out << "IntrusiveAllocator::report() " << allocatorMemoryBlocks.size() << std::endl;
+    out << "    threadCacheSize = " << threadCacheSize << ", threadCacheMaximumAllocationSize = " << threadCacheMaximumAllocationSize << std::endl;
+    out << "    thread cache hits = " << _threadCacheHits << ", misses = " << _threadCacheMisses << ", flushes = " << _threadCacheFlushes << ", slots held in thread caches = " << _threadCacheSlots << std::endl;
 
     for (const auto& memoryBlock : allocatorMemoryBlocks)
     {
@@ -905,14 +1176,39 @@ void IntrusiveAllocator::report(std::ostream& out) const
 
 void* IntrusiveAllocator::allocate(std::size_t size, AllocatorAffinity allocatorAffinity)
 {
-    std::scoped_lock<std::mutex> lock(mutex);
+    ThreadCache* cache = (size > 0 && size <= threadCacheMaximumAllocationSize && threadCacheSize > 0) ? threadCache() : nullptr;
+    if (!cache)
+    {
+        SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
+        return _allocate(size, allocatorAffinity);
+    }
 
+    size_t sizeClass = (size + ThreadCache::granularity - 1) / ThreadCache::granularity;
+    auto& freeSlots = cache->getFreeSlots(allocatorAffinity, sizeClass);
+    if (freeSlots.head)
+    {
+        ++cache->hits;
+        --cache->slots;
+        return ThreadCache::pop(freeSlots.head, freeSlots.count);
+    }
+
+    SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
+
+    ++cache->misses;
+    auto ptr = _refillThreadCache(*cache, sizeClass, allocatorAffinity);
+    _accumulateThreadCacheStats(*cache);
+    return ptr;
+}
+
+void* IntrusiveAllocator::_allocate(std::size_t size, AllocatorAffinity allocatorAffinity)
+{
     // create a MemoryBlocks entry if one doesn't already exist
     if (allocatorAffinity > allocatorMemoryBlocks.size())
     {
         size_t blockSize = 1024 * 1024; // Megabyte
         allocatorMemoryBlocks.resize(allocatorAffinity + 1);
         allocatorMemoryBlocks[allocatorAffinity].reset(new MemoryBlocks(this, "MemoryBlockAffinity", blockSize, defaultAlignment));
+        allocatorMemoryBlocks[allocatorAffinity]->affinity = allocatorAffinity;
     }
 
     void* ptr = nullptr;
@@ -941,8 +1237,70 @@ void* IntrusiveAllocator::allocate(std::size_t size, AllocatorAffinity allocator
 
 bool IntrusiveAllocator::deallocate(void* ptr, std::size_t size)
 {
-    std::scoped_lock<std::mutex> lock(mutex);
+    ThreadCache* cache = (threadCacheSize > 0) ? threadCache() : nullptr;
+    if (!cache)
+    {
+        SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
+        return _deallocate(ptr, size);
+    }
+
+    // MemoryBlock have been deleted since the block ranges were cached so discard them
+    if (auto blockGeneration = _blockGeneration.load(std::memory_order_acquire); cache->blockGeneration != blockGeneration)
+    {
+        cache->blockRanges.clear();
+        cache->blockGeneration = blockGeneration;
+    }
+
+    if (auto range = cache->find(ptr))
+    {
+        // the slot is still marked as allocated, so its extent is only modified by the owner of the slot and safe to read without the mutex
+        auto& slot = *(static_cast<const MemoryBlock::Element*>(ptr) - 1);
+        size_t capacity = sizeof(MemoryBlock::Element) * (static_cast<size_t>(slot.next) - 1);
+        size_t sizeClass = capacity / ThreadCache::granularity;
+        size_t maxSizeClass = (threadCacheMaximumAllocationSize + ThreadCache::granularity - 1) / ThreadCache::granularity;
+
+        if (sizeClass > 0 && sizeClass <= maxSizeClass)
+        {
+            auto& freeSlots = cache->getFreeSlots(range->block->affinity, sizeClass);
+            ThreadCache::push(freeSlots.head, freeSlots.count, ptr);
+            ++cache->slots;
+
+            if (freeSlots.count > threadCacheSize)
+            {
+                // return half the slots to the MemoryBlock in a single batch
+                SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
+                _flushThreadCache(*cache, freeSlots.head, freeSlots.count, freeSlots.count / 2);
+                _accumulateThreadCacheStats(*cache);
+            }
+            return true;
+        }
+
+        SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
+        return range->block->deallocate(ptr, size);
+    }
+
+    SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
+
+    // cache the MemoryBlock's range so subsequent deallocations from it can be served by the thread cache
+    if (auto block = _findMemoryBlock(ptr))
+    {
+        cache->add(block);
+        return block->deallocate(ptr, size);
+    }
+
+    return _deallocate(ptr, size);
+}
+
+IntrusiveAllocator::MemoryBlock* IntrusiveAllocator::_findMemoryBlock(const void* ptr) const
+{
+    auto itr = memoryBlocks.upper_bound(const_cast<void*>(ptr));
+    if (itr == memoryBlocks.begin()) return nullptr;
+    --itr;
+    return itr->second->within(ptr) ? itr->second.get() : nullptr;
+}
 
+bool IntrusiveAllocator::_deallocate(void* ptr, std::size_t size)
+{
     if (memoryBlocks.empty()) return false;
 
     auto itr = memoryBlocks.upper_bound(ptr);
@@ -1005,11 +1363,17 @@ bool IntrusiveAllocator::validate() const
 
 size_t IntrusiveAllocator::deleteEmptyMemoryBlocks()
 {
+    SCOPED_LOCK_INSTRUMENTATION(mutex, "Allocator::mutex");
+
     size_t count = 0;
     for (auto& blocks : allocatorMemoryBlocks)
     {
         count += blocks->deleteEmptyMemoryBlocks();
     }
+
+    // invalidate the MemoryBlock ranges cached by each thread
+    if (count > 0) ++_blockGeneration;
+
     return count;
 }
 
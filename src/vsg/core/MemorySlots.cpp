@@ -15,9 +15,31 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 
 #include <algorithm>
+#include <iterator>
 
 using namespace vsg;
 
+namespace
+{
+    inline uint32_t lowestBit(uint64_t value)
+    {
+        uint32_t bit = 0;
+        while ((value & 1) == 0)
+        {
+            value >>= 1;
+            ++bit;
+        }
+        return bit;
+    }
+
+    inline uint32_t highestBit(uint64_t value)
+    {
+        uint32_t bit = 0;
+        while (value >>= 1) ++bit;
+        return bit;
+    }
+} // namespace
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // MemorySlots
@@ -30,6 +52,12 @@ MemorySlots::MemorySlots(size_t availableMemorySize, int in_memoryTracking) :
         info("MemorySlots::MemorySlots(", availableMemorySize, ") ", this);
     }
 
+    for (uint32_t fl = 0; fl < FL_COUNT; ++fl)
+    {
+        _secondLevelBitmaps[fl] = 0;
+        for (uint32_t sl = 0; sl < SL_COUNT; ++sl) _bins[fl][sl] = NO_SLOT;
+    }
+
     insertAvailableSlot(0, availableMemorySize);
 
     _totalMemorySize = availableMemorySize;
@@ -39,7 +67,7 @@ MemorySlots::~MemorySlots()
 {
     if (memoryTracking & MEMORY_TRACKING_REPORT_ACTIONS)
     {
-        if (_availableMemory.size() == 1)
+        if (_offsetSizes.size() == 1)
         {
             info("MemorySlots::~MemorySlots() ", this, ", all slots restored correctly.");
         }
@@ -55,37 +83,77 @@ MemorySlots::~MemorySlots()
     }
 }
 
-size_t MemorySlots::totalAvailableSize() const
+void MemorySlots::mapping(size_t size, uint32_t& fl, uint32_t& sl)
 {
-    size_t totalSize = 0;
-    for (const auto& sizeOffset : _availableMemory)
+    if (size < SL_COUNT)
     {
-        totalSize += sizeOffset.first;
+        fl = 0;
+        sl = static_cast<uint32_t>(size);
+    }
+    else
+    {
+        uint32_t bit = highestBit(size);
+        fl = bit - SL_BITS + 1;
+        sl = static_cast<uint32_t>(size >> (bit - SL_BITS)) ^ SL_COUNT;
     }
-    return totalSize;
 }
 
-size_t MemorySlots::totalReservedSize() const
+size_t MemorySlots::maximumAvailableSpace() const
 {
-    size_t totalSize = 0;
-    for (const auto& sizeOffset : _reservedMemory)
+    if (_firstLevelBitmap == 0) return 0;
+
+    // all slots in the highest occupied bin are larger than those in any other bin, so only that bin needs searching
+    uint32_t fl = highestBit(_firstLevelBitmap);
+    uint32_t sl = highestBit(_secondLevelBitmaps[fl]);
+
+    size_t maxSize = 0;
+    for (size_t offset = _bins[fl][sl]; offset != NO_SLOT;)
     {
-        totalSize += sizeOffset.second;
+        auto& slot = _offsetSizes.find(offset)->second;
+        maxSize = std::max(maxSize, slot.size);
+        offset = slot.next;
     }
-    return totalSize;
+    return maxSize;
+}
+
+double MemorySlots::fragmentation() const
+{
+    if (_totalAvailableSize == 0) return 0.0;
+    return 1.0 - static_cast<double>(maximumAvailableSpace()) / static_cast<double>(_totalAvailableSize);
 }
 
 bool MemorySlots::check() const
 {
-    if (_availableMemory.size() != _offsetSizes.size())
+    size_t availableSize = 0;
+    size_t numBinned = 0;
+    for (uint32_t fl = 0; fl < FL_COUNT; ++fl)
     {
-        warn("MemorySlots::check() _availableMemory.size() ", _availableMemory.size(), " != _offsetSizes.size() ", _offsetSizes.size());
+        for (uint32_t sl = 0; sl < SL_COUNT; ++sl)
+        {
+            bool occupied = (_secondLevelBitmaps[fl] & (1u << sl)) != 0;
+            if (occupied != (_bins[fl][sl] != NO_SLOT))
+            {
+                warn("MemorySlots::check() ", this, " bitmap inconsistent for bin [", fl, ", ", sl, "]");
+            }
+
+            for (size_t offset = _bins[fl][sl]; offset != NO_SLOT;)
+            {
+                auto itr = _offsetSizes.find(offset);
+                if (itr == _offsetSizes.end())
+                {
+                    warn("MemorySlots::check() ", this, " bin [", fl, ", ", sl, "] references unknown slot ", offset);
+                    break;
+                }
+                availableSize += itr->second.size;
+                ++numBinned;
+                offset = itr->second.next;
+            }
+        }
     }
 
-    size_t availableSize = 0;
-    for (const auto& offsetSize : _offsetSizes)
+    if (numBinned != _offsetSizes.size())
     {
-        availableSize += offsetSize.second;
+        warn("MemorySlots::check() binned slots ", numBinned, " != _offsetSizes.size() ", _offsetSizes.size());
     }
 
     size_t reservedSize = 0;
@@ -94,6 +162,11 @@ bool MemorySlots::check() const
         reservedSize += offsetSize.second;
     }
 
+    if (availableSize != _totalAvailableSize || reservedSize != _totalReservedSize)
+    {
+        warn("MemorySlots::check() ", this, " totals inconsistent, availableSize ", availableSize, " != ", _totalAvailableSize, ", reservedSize = ", reservedSize, " != ", _totalReservedSize);
+    }
+
     size_t computedSize = availableSize + reservedSize;
     if (computedSize != _totalMemorySize)
     {
@@ -109,35 +182,63 @@ bool MemorySlots::check() const
 void MemorySlots::report(std::ostream& out) const
 {
     out << "MemorySlots::report() " << this << std::endl;
-    for (auto& [offset, size] : _offsetSizes)
+    for (auto& [offset, slot] : _offsetSizes)
     {
-        out << "    available " << offset << ", " << size << std::endl;
+        out << "    available " << offset << ", " << slot.size << std::endl;
     }
 
     for (auto& [offset, size] : _reservedMemory)
     {
         out << "    reserved " << std::dec << offset << ", " << size << std::endl;
     }
+
+    out << "    fragmentation " << fragmentation() << std::endl;
 }
 
 void MemorySlots::insertAvailableSlot(size_t offset, size_t size)
 {
-    _offsetSizes.emplace(offset, size);
-    _availableMemory.emplace(size, offset);
+    uint32_t fl, sl;
+    mapping(size, fl, sl);
+
+    // push to the front of the bin's list
+    size_t& head = _bins[fl][sl];
+    _offsetSizes[offset] = AvailableSlot{size, NO_SLOT, head};
+    if (head != NO_SLOT) _offsetSizes[head].previous = offset;
+    head = offset;
+
+    _firstLevelBitmap |= (uint64_t(1) << fl);
+    _secondLevelBitmaps[fl] |= (1u << sl);
+
+    _totalAvailableSize += size;
 }
 
 void MemorySlots::removeAvailableSlot(size_t offset, size_t size)
 {
-    _offsetSizes.erase(offset);
-    auto end = _availableMemory.upper_bound(size);
-    for (auto itr = _availableMemory.lower_bound(size); itr != end; ++itr)
+    auto itr = _offsetSizes.find(offset);
+    if (itr == _offsetSizes.end()) return;
+
+    auto& slot = itr->second;
+    size = slot.size;
+
+    uint32_t fl, sl;
+    mapping(size, fl, sl);
+
+    if (slot.previous != NO_SLOT)
+        _offsetSizes[slot.previous].next = slot.next;
+    else
+        _bins[fl][sl] = slot.next;
+
+    if (slot.next != NO_SLOT) _offsetSizes[slot.next].previous = slot.previous;
+
+    if (_bins[fl][sl] == NO_SLOT)
     {
-        if (itr->second == offset)
-        {
-            _availableMemory.erase(itr);
-            break;
-        }
+        _secondLevelBitmaps[fl] &= ~(1u << sl);
+        if (_secondLevelBitmaps[fl] == 0) _firstLevelBitmap &= ~(uint64_t(1) << fl);
     }
+
+    _offsetSizes.erase(itr);
+
+    _totalAvailableSize -= size;
 }
 
 MemorySlots::OptionalOffset MemorySlots::reserve(size_t size, size_t alignment)
@@ -149,46 +250,93 @@ MemorySlots::OptionalOffset MemorySlots::reserve(size_t size, size_t alignment)
 
     if (full()) return OptionalOffset(false, 0);
 
-    auto itr = _availableMemory.lower_bound(size);
-    while (itr != _availableMemory.end())
-    {
-        size_t slotSize = itr->first;
-        size_t slotStart = itr->second;
-        size_t slotEnd = slotStart + slotSize;
+    if (alignment == 0) alignment = 1;
+
+    auto fits = [&](size_t slotStart, size_t slotSize) {
         size_t alignedStart = ((slotStart + alignment - 1) / alignment) * alignment;
-        size_t alignedEnd = alignedStart + size;
-        if (alignedEnd <= slotEnd) // slot big enough
-        {
-            // remove available slot
-            removeAvailableSlot(slotStart, slotSize);
+        return alignedStart + size <= slotStart + slotSize;
+    };
+
+    // round the search size up so that any slot in the first suitable bin is guaranteed to fit the aligned size.
+    size_t searchSize = size + alignment - 1;
+    if (searchSize >= SL_COUNT) searchSize += (size_t(1) << (highestBit(searchSize) - SL_BITS)) - 1;
 
-            if (slotStart < alignedStart) // space before newly reserved slot
+    size_t slotStart = NO_SLOT;
+    uint32_t fl, sl;
+    mapping(searchSize, fl, sl);
+    if (fl < FL_COUNT && searchSize >= size)
+    {
+        uint32_t secondLevelMap = _secondLevelBitmaps[fl] & (~0u << sl);
+        if (secondLevelMap == 0)
+        {
+            uint64_t firstLevelMap = (fl + 1 < FL_COUNT) ? (_firstLevelBitmap & (~uint64_t(0) << (fl + 1))) : 0;
+            if (firstLevelMap != 0)
             {
-                insertAvailableSlot(slotStart, alignedStart - slotStart);
+                fl = lowestBit(firstLevelMap);
+                secondLevelMap = _secondLevelBitmaps[fl];
             }
+        }
+        if (secondLevelMap != 0)
+        {
+            slotStart = _bins[fl][lowestBit(secondLevelMap)];
+        }
+    }
 
-            if (alignedEnd < slotEnd) // space after newly reserved slot
+    if (slotStart == NO_SLOT)
+    {
+        // no bin guaranteed to fit so check the slots in the bins that might, starting from the bin the requested size maps to.
+        mapping(size, fl, sl);
+        for (; fl < FL_COUNT && slotStart == NO_SLOT; ++fl, sl = 0)
+        {
+            uint32_t secondLevelMap = _secondLevelBitmaps[fl] & (~0u << sl);
+            for (; secondLevelMap != 0 && slotStart == NO_SLOT; secondLevelMap &= secondLevelMap - 1)
             {
-                slotStart = alignedEnd;
-                insertAvailableSlot(slotStart, slotEnd - slotStart);
+                for (size_t offset = _bins[fl][lowestBit(secondLevelMap)]; offset != NO_SLOT;)
+                {
+                    auto& slot = _offsetSizes[offset];
+                    if (fits(offset, slot.size))
+                    {
+                        slotStart = offset;
+                        break;
+                    }
+                    offset = slot.next;
+                }
             }
+        }
+    }
 
-            // record and return reserved slot
-            _reservedMemory.emplace(alignedStart, size);
+    if (slotStart != NO_SLOT)
+    {
+        size_t slotSize = _offsetSizes[slotStart].size;
+        size_t slotEnd = slotStart + slotSize;
+        size_t alignedStart = ((slotStart + alignment - 1) / alignment) * alignment;
+        size_t alignedEnd = alignedStart + size;
 
-            if (memoryTracking & MEMORY_TRACKING_REPORT_ACTIONS)
-            {
-                info("MemorySlots::reserve(", size, ", ", alignment, ") ", this, " allocated [", alignedStart, ", ", size, "]");
-            }
+        // remove available slot
+        removeAvailableSlot(slotStart, slotSize);
 
-            if (memoryTracking & MEMORY_TRACKING_CHECK_ACTIONS) check();
+        if (slotStart < alignedStart) // space before newly reserved slot
+        {
+            insertAvailableSlot(slotStart, alignedStart - slotStart);
+        }
 
-            return {true, alignedStart};
+        if (alignedEnd < slotEnd) // space after newly reserved slot
+        {
+            insertAvailableSlot(alignedEnd, slotEnd - alignedEnd);
         }
-        else // slot not big enough so advance to the next slot
+
+        // record and return reserved slot
+        _reservedMemory.emplace(alignedStart, size);
+        _totalReservedSize += size;
+
+        if (memoryTracking & MEMORY_TRACKING_REPORT_ACTIONS)
         {
-            ++itr;
+            info("MemorySlots::reserve(", size, ", ", alignment, ") ", this, " allocated [", alignedStart, ", ", size, "]");
         }
+
+        if (memoryTracking & MEMORY_TRACKING_CHECK_ACTIONS) check();
+
+        return {true, alignedStart};
     }
 
     if (memoryTracking & MEMORY_TRACKING_CHECK_ACTIONS) check();
@@ -226,55 +374,31 @@ bool MemorySlots::release(size_t offset, size_t size)
 
     // remove from reserved list
     _reservedMemory.erase(itr);
-
-    if (_offsetSizes.empty())
-    {
-        insertAvailableSlot(offset, size);
-
-        if (memoryTracking & MEMORY_TRACKING_CHECK_ACTIONS) check();
-
-        return true;
-    }
+    _totalReservedSize -= size;
 
     size_t slotStart = offset;
     size_t slotEnd = offset + size;
 
+    // merge with the available slots either side of the released slot
     auto next_slot_itr = _offsetSizes.lower_bound(slotStart);
-    if (next_slot_itr != _offsetSizes.end())
-    {
-        if (next_slot_itr != _offsetSizes.begin())
-        {
-            auto prev_slot_itr = next_slot_itr;
-            --prev_slot_itr;
-
-            size_t prev_slotEnd = prev_slot_itr->first + prev_slot_itr->second;
-            if (prev_slotEnd == slotStart)
-            {
-                // previous slot abuts with the one being released so remove it.
-                slotStart = prev_slot_itr->first;
-                removeAvailableSlot(prev_slot_itr->first, prev_slot_itr->second);
-            }
-        }
-
-        if (next_slot_itr->first == slotEnd)
-        {
-            // next available slot abuts released so extend new slot and remove previous next available slot
-            slotEnd = next_slot_itr->first + next_slot_itr->second;
-            removeAvailableSlot(next_slot_itr->first, next_slot_itr->second);
-        }
-    }
-    else
+    if (next_slot_itr != _offsetSizes.begin())
     {
-        auto prev_slot_itr = _offsetSizes.rbegin();
-        size_t prev_slotEnd = prev_slot_itr->first + prev_slot_itr->second;
-        if (prev_slotEnd == slotStart)
+        auto prev_slot_itr = std::prev(next_slot_itr);
+        if (prev_slot_itr->first + prev_slot_itr->second.size == slotStart)
         {
             // previous slot abuts with the one being released so remove it.
             slotStart = prev_slot_itr->first;
-            removeAvailableSlot(prev_slot_itr->first, prev_slot_itr->second);
+            removeAvailableSlot(prev_slot_itr->first, prev_slot_itr->second.size);
         }
     }
 
+    if (next_slot_itr != _offsetSizes.end() && next_slot_itr->first == slotEnd)
+    {
+        // next available slot abuts released so extend new slot and remove previous next available slot
+        slotEnd = next_slot_itr->first + next_slot_itr->second.size;
+        removeAvailableSlot(next_slot_itr->first, next_slot_itr->second.size);
+    }
+
     insertAvailableSlot(slotStart, slotEnd - slotStart);
 
     if (memoryTracking & MEMORY_TRACKING_CHECK_ACTIONS) check();
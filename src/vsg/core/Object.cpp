@@ -16,6 +16,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Object.h>
 #include <vsg/core/Visitor.h>
 
+#include <vsg/io/HashOutput.h>
 #include <vsg/io/Input.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/Output.h>
@@ -24,6 +25,7 @@ using namespace vsg;
 
 Object::Object() :
     _referenceCount(0),
+    _threadConfined(false),
     _auxiliary(nullptr)
 {
 }
@@ -121,6 +123,18 @@ int Object::compare(const Object& rhs) const
     return _auxiliary ? (rhs._auxiliary ? _auxiliary->compare(*rhs._auxiliary) : 1) : (rhs._auxiliary ? -1 : 0);
 }
 
+uint64_t Object::hash() const
+{
+    HashOutput output;
+
+    auto name = className();
+    output.value = hash_bytes(name, std::strlen(name));
+
+    write(output);
+
+    return output.value;
+}
+
 void Object::accept(Visitor& visitor)
 {
     visitor.apply(*this);
@@ -0,0 +1,171 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/TrackingAllocator.h>
+#include <vsg/io/Logger.h>
+
+using namespace vsg;
+
+TrackingAllocator::TrackingAllocator(std::unique_ptr<Allocator> in_nestedAllocator) :
+    Allocator(std::move(in_nestedAllocator))
+{
+    if (nestedAllocator)
+    {
+        allocatorType = nestedAllocator->allocatorType;
+        defaultAlignment = nestedAllocator->defaultAlignment;
+    }
+
+    AllocationTag::enabled = true;
+}
+
+TrackingAllocator::~TrackingAllocator()
+{
+    AllocationTag::enabled = false;
+}
+
+void* TrackingAllocator::allocate(std::size_t size, AllocatorAffinity allocatorAffinity)
+{
+    void* ptr = nestedAllocator->allocate(size, allocatorAffinity);
+    if (!ptr) return ptr;
+
+    auto tag = AllocationTag::current();
+
+    std::scoped_lock<std::mutex> lock(_trackingMutex);
+
+    auto& tagStats = _current.tags[tag ? tag : "untagged"];
+    ++tagStats.allocations;
+    tagStats.allocatedBytes += size;
+
+    if (allocatorAffinity < ALLOCATOR_AFFINITY_LAST)
+    {
+        auto& affinityStats = _current.affinities[allocatorAffinity];
+        ++affinityStats.allocations;
+        affinityStats.allocatedBytes += size;
+    }
+
+    // std::map nodes are never relocated so the Stats* remains valid
+    _allocations[ptr] = Allocation{size, allocatorAffinity, &tagStats};
+
+    return ptr;
+}
+
+bool TrackingAllocator::deallocate(void* ptr, std::size_t size)
+{
+    if (ptr)
+    {
+        std::scoped_lock<std::mutex> lock(_trackingMutex);
+
+        // memory allocated before tracking started isn't recorded
+        if (auto itr = _allocations.find(ptr); itr != _allocations.end())
+        {
+            auto& allocation = itr->second;
+
+            ++allocation.tagStats->deallocations;
+            allocation.tagStats->deallocatedBytes += allocation.size;
+
+            if (allocation.affinity < ALLOCATOR_AFFINITY_LAST)
+            {
+                auto& affinityStats = _current.affinities[allocation.affinity];
+                ++affinityStats.deallocations;
+                affinityStats.deallocatedBytes += allocation.size;
+            }
+
+            _allocations.erase(itr);
+        }
+    }
+
+    return nestedAllocator->deallocate(ptr, size);
+}
+
+TrackingAllocator::Snapshot TrackingAllocator::snapshot() const
+{
+    std::scoped_lock<std::mutex> lock(_trackingMutex);
+    return _current;
+}
+
+TrackingAllocator::Snapshot TrackingAllocator::delta()
+{
+    std::scoped_lock<std::mutex> lock(_trackingMutex);
+
+    Snapshot result = _current;
+    for (size_t i = 0; i < result.affinities.size(); ++i)
+    {
+        result.affinities[i] -= _previous.affinities[i];
+    }
+
+    for (auto itr = result.tags.begin(); itr != result.tags.end();)
+    {
+        if (auto previous_itr = _previous.tags.find(itr->first); previous_itr != _previous.tags.end()) itr->second -= previous_itr->second;
+
+        if (itr->second.allocations == 0 && itr->second.deallocations == 0)
+            itr = result.tags.erase(itr);
+        else
+            ++itr;
+    }
+
+    _previous = _current;
+
+    return result;
+}
+
+void TrackingAllocator::report(std::ostream& out, const Snapshot& snapshot)
+{
+    static const char* affinityNames[] = {"OBJECTS", "DATA", "NODES", "PHYSICS"};
+
+    out << "TrackingAllocator affinities" << std::endl;
+    for (size_t i = 0; i < snapshot.affinities.size(); ++i)
+    {
+        auto& stats = snapshot.affinities[i];
+        out << "    " << affinityNames[i] << " allocations = " << stats.allocations << ", deallocations = " << stats.deallocations << ", allocatedBytes = " << stats.allocatedBytes
+            << ", deallocatedBytes = " << stats.deallocatedBytes << ", liveAllocations = " << stats.liveAllocations() << ", liveBytes = " << stats.liveBytes() << std::endl;
+    }
+
+    out << "TrackingAllocator tags" << std::endl;
+    for (auto& [name, stats] : snapshot.tags)
+    {
+        if (stats.allocations == 0 && stats.deallocations == 0) continue;
+
+        out << "    " << name << " allocations = " << stats.allocations << ", deallocations = " << stats.deallocations << ", allocatedBytes = " << stats.allocatedBytes
+            << ", deallocatedBytes = " << stats.deallocatedBytes << ", liveAllocations = " << stats.liveAllocations() << ", liveBytes = " << stats.liveBytes() << std::endl;
+    }
+}
+
+void TrackingAllocator::report(std::ostream& out) const
+{
+    nestedAllocator->report(out);
+    report(out, snapshot());
+}
+
+size_t TrackingAllocator::deleteEmptyMemoryBlocks()
+{
+    return nestedAllocator->deleteEmptyMemoryBlocks();
+}
+
+size_t TrackingAllocator::totalAvailableSize() const
+{
+    return nestedAllocator->totalAvailableSize();
+}
+
+size_t TrackingAllocator::totalReservedSize() const
+{
+    return nestedAllocator->totalReservedSize();
+}
+
+size_t TrackingAllocator::totalMemorySize() const
+{
+    return nestedAllocator->totalMemorySize();
+}
+
+void TrackingAllocator::setBlockSize(AllocatorAffinity allocatorAffinity, size_t blockSize)
+{
+    nestedAllocator->setBlockSize(allocatorAffinity, blockSize);
+}
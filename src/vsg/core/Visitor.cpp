@@ -594,6 +594,10 @@ void Visitor::apply(QuadGroup& value)
 {
     apply(static_cast<Node&>(value));
 }
+void Visitor::apply(ParallelGroup& value)
+{
+    apply(static_cast<Group&>(value));
+}
 void Visitor::apply(LOD& value)
 {
     apply(static_cast<Node&>(value));
@@ -602,14 +606,46 @@ void Visitor::apply(PagedLOD& value)
 {
     apply(static_cast<Node&>(value));
 }
+void Visitor::apply(PointCloudTile& value)
+{
+    apply(static_cast<PagedLOD&>(value));
+}
+void Visitor::apply(PointCloud& value)
+{
+    apply(static_cast<Node&>(value));
+}
 void Visitor::apply(StateGroup& value)
 {
     apply(static_cast<Group&>(value));
 }
+void Visitor::apply(StreamingStateGroup& value)
+{
+    apply(static_cast<StateGroup&>(value));
+}
 void Visitor::apply(CullGroup& value)
 {
     apply(static_cast<Group&>(value));
 }
+void Visitor::apply(BatchedCullGroup& value)
+{
+    apply(static_cast<Group&>(value));
+}
+void Visitor::apply(LazyCompileGroup& value)
+{
+    apply(static_cast<Group&>(value));
+}
+void Visitor::apply(SpatialGrid& value)
+{
+    apply(static_cast<Group&>(value));
+}
+void Visitor::apply(PackedSubgraph& value)
+{
+    apply(static_cast<Node&>(value));
+}
+void Visitor::apply(PackedDraws& value)
+{
+    apply(static_cast<Node&>(value));
+}
 void Visitor::apply(CullNode& value)
 {
     apply(static_cast<Node&>(value));
@@ -682,6 +718,10 @@ void Visitor::apply(RegionOfInterest& value)
 {
     apply(static_cast<Node&>(value));
 }
+void Visitor::apply(Occluder& value)
+{
+    apply(static_cast<Node&>(value));
+}
 void Visitor::apply(InstanceNode& value)
 {
     apply(static_cast<Compilable&>(value));
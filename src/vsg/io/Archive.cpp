@@ -0,0 +1,250 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Archive.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/read.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace vsg;
+
+namespace
+{
+    // archive layout:
+    //     "#vsgarc\n" signature, uint32_t version, uint32_t numEntries
+    //     for each entry: uint32_t nameLength, name characters, uint64_t offset, uint64_t size
+    //     entry data, each aligned to entryAlignment bytes from the start of the file so that payloads can be accessed in place
+    const char signature[8] = {'#', 'v', 's', 'g', 'a', 'r', 'c', '\n'};
+    const uint32_t archiveVersion = 1;
+    const uint64_t entryAlignment = 64;
+
+    template<typename T>
+    bool readValue(const uint8_t* data, size_t size, size_t& pos, T& value)
+    {
+        if (pos > size || sizeof(T) > (size - pos)) return false;
+        std::memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    template<typename T>
+    void writeValue(std::ostream& fout, T value)
+    {
+        fout.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+} // namespace
+
+Archive::Archive()
+{
+}
+
+Archive::Archive(const Path& in_filename)
+{
+    open(in_filename);
+}
+
+bool Archive::open(const Path& in_filename)
+{
+    _filename = in_filename;
+    _entries.clear();
+    _mappedFile = MappedFile::create(in_filename);
+    if (!_mappedFile->valid())
+    {
+        _mappedFile = {};
+        return false;
+    }
+
+    const uint8_t* data = _mappedFile->data();
+    size_t size = _mappedFile->size();
+    size_t pos = 0;
+
+    uint32_t version = 0;
+    uint32_t numEntries = 0;
+    if (size < sizeof(signature) || std::memcmp(data, signature, sizeof(signature)) != 0)
+    {
+        warn("Archive::open(", in_filename, ") file is not a vsgarc archive.");
+        _mappedFile = {};
+        return false;
+    }
+    pos += sizeof(signature);
+
+    if (!readValue(data, size, pos, version) || !readValue(data, size, pos, numEntries) || version > archiveVersion)
+    {
+        warn("Archive::open(", in_filename, ") unsupported archive version.");
+        _mappedFile = {};
+        return false;
+    }
+
+    for (uint32_t i = 0; i < numEntries; ++i)
+    {
+        uint32_t nameLength = 0;
+        Entry entry;
+        if (!readValue(data, size, pos, nameLength) || nameLength > (size - pos))
+        {
+            warn("Archive::open(", in_filename, ") corrupt archive index.");
+            _entries.clear();
+            _mappedFile = {};
+            return false;
+        }
+
+        std::string name(reinterpret_cast<const char*>(data + pos), nameLength);
+        pos += nameLength;
+
+        if (!readValue(data, size, pos, entry.offset) || !readValue(data, size, pos, entry.size) || entry.offset > size || entry.size > (size - entry.offset))
+        {
+            warn("Archive::open(", in_filename, ") corrupt archive index.");
+            _entries.clear();
+            _mappedFile = {};
+            return false;
+        }
+
+        _entries[name] = entry;
+    }
+
+    return true;
+}
+
+std::string Archive::_entryName(const Path& path) const
+{
+    std::string name = path.string();
+    std::replace(name.begin(), name.end(), '\\', '/');
+
+    // strip the archive filename, so that entries can be read as "archive.vsgarc/entry"
+    std::string archiveName = _filename.string();
+    std::replace(archiveName.begin(), archiveName.end(), '\\', '/');
+    if (!archiveName.empty() && name.size() > archiveName.size() && name.compare(0, archiveName.size(), archiveName) == 0 && name[archiveName.size()] == '/')
+    {
+        name.erase(0, archiveName.size() + 1);
+    }
+
+    while (name.compare(0, 2, "./") == 0) name.erase(0, 2);
+
+    return name;
+}
+
+const uint8_t* Archive::data(const Path& entryName, size_t& size) const
+{
+    size = 0;
+    if (!valid()) return nullptr;
+
+    auto itr = _entries.find(_entryName(entryName));
+    if (itr == _entries.end()) return nullptr;
+
+    size = static_cast<size_t>(itr->second.size);
+    return _mappedFile->data() + itr->second.offset;
+}
+
+ref_ptr<Object> Archive::read(const Path& entryName, ref_ptr<const Options> options) const
+{
+    size_t size = 0;
+    const uint8_t* ptr = data(entryName, size);
+    if (!ptr) return {};
+
+    // pass the MappedFile on so that readers can reference the mapped memory directly
+    auto local_options = options ? Options::create(*options) : Options::create();
+    local_options->extensionHint = lowerCaseFileExtension(entryName);
+    local_options->setObject("mapped_file", _mappedFile);
+
+    if (auto object = vsg::read(ptr, size, local_options)) return object;
+
+    // fall back to the built-in formats when none of the assigned ReaderWriters can read the entry
+    if (!local_options->readerWriters.empty())
+    {
+        local_options->readerWriters.clear();
+        return vsg::read(ptr, size, local_options);
+    }
+
+    return {};
+}
+
+bool Archive::getFeatures(Features& features) const
+{
+    features.extensionFeatureMap[".vsgarc"] = READ_FILENAME;
+    return true;
+}
+
+bool Archive::pack(const Path& archiveFilename, const std::map<std::string, Path>& files)
+{
+    // compute the size of the index so that the offsets of the entries are known before writing it
+    uint64_t indexSize = sizeof(signature) + sizeof(uint32_t) * 2;
+    for (auto& [name, filename] : files)
+    {
+        indexSize += sizeof(uint32_t) + name.size() + sizeof(uint64_t) * 2;
+    }
+
+    auto align = [](uint64_t offset) { return ((offset + entryAlignment - 1) / entryAlignment) * entryAlignment; };
+
+    std::vector<Entry> archiveEntries;
+    uint64_t offset = align(indexSize);
+    for (auto& [name, filename] : files)
+    {
+        std::ifstream fin(filename, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!fin)
+        {
+            warn("Archive::pack(", archiveFilename, ") unable to open ", filename);
+            return false;
+        }
+
+        Entry entry;
+        entry.offset = offset;
+        entry.size = static_cast<uint64_t>(fin.tellg());
+        archiveEntries.push_back(entry);
+
+        offset = align(offset + entry.size);
+    }
+
+    std::ofstream fout(archiveFilename, std::ios::out | std::ios::binary);
+    if (!fout)
+    {
+        warn("Archive::pack(", archiveFilename, ") unable to create archive.");
+        return false;
+    }
+
+    fout.write(signature, sizeof(signature));
+    writeValue(fout, archiveVersion);
+    writeValue(fout, static_cast<uint32_t>(files.size()));
+
+    auto entry_itr = archiveEntries.begin();
+    for (auto& [name, filename] : files)
+    {
+        writeValue(fout, static_cast<uint32_t>(name.size()));
+        fout.write(name.data(), name.size());
+        writeValue(fout, entry_itr->offset);
+        writeValue(fout, entry_itr->size);
+        ++entry_itr;
+    }
+
+    std::vector<char> buffer;
+    entry_itr = archiveEntries.begin();
+    for (auto& [name, filename] : files)
+    {
+        // pad up to the aligned start of the entry
+        auto position = static_cast<uint64_t>(fout.tellp());
+        for (; position < entry_itr->offset; ++position) fout.put(0);
+
+        std::ifstream fin(filename, std::ios::in | std::ios::binary);
+        buffer.resize(static_cast<size_t>(entry_itr->size));
+        fin.read(buffer.data(), buffer.size());
+        if (!fin)
+        {
+            warn("Archive::pack(", archiveFilename, ") unable to read ", filename);
+            return false;
+        }
+        fout.write(buffer.data(), buffer.size());
+        ++entry_itr;
+    }
+
+    return fout.good();
+}
@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 #include <vsg/io/ReaderWriter.h>
 
+#include <cctype>
 #include <cstring>
 
 using namespace vsg;
@@ -24,9 +25,34 @@ AsciiInput::AsciiInput(std::istream& input, ref_ptr<ObjectFactory> in_objectFact
 {
 }
 
+void AsciiInput::_readToken(std::string& token)
+{
+    using traits_type = std::istream::traits_type;
+
+    token.clear();
+
+    if (!_input.good())
+    {
+        _input.setstate(std::ios_base::failbit);
+        return;
+    }
+
+    // read directly from the stream buffer to avoid the per call overhead of std::istream::operator>>
+    auto sb = _input.rdbuf();
+    auto c = sb->sgetc();
+    while (!traits_type::eq_int_type(c, traits_type::eof()) && std::isspace(c)) c = sb->snextc();
+    while (!traits_type::eq_int_type(c, traits_type::eof()) && !std::isspace(c))
+    {
+        token.push_back(traits_type::to_char_type(c));
+        c = sb->snextc();
+    }
+
+    if (traits_type::eq_int_type(c, traits_type::eof())) _input.setstate(token.empty() ? (std::ios_base::eofbit | std::ios_base::failbit) : std::ios_base::eofbit);
+}
+
 bool AsciiInput::matchPropertyName(const char* propertyName)
 {
-    _input >> _readPropertyName;
+    _readToken(_readPropertyName);
     if (_readPropertyName != propertyName)
     {
         error("Unable to match ", propertyName, " got ", _readPropertyName, " instead.");
@@ -37,14 +63,11 @@ bool AsciiInput::matchPropertyName(const char* propertyName)
 
 AsciiInput::OptionalObjectID AsciiInput::objectID()
 {
-    std::string token;
-    _input >> token;
-    if (token.compare(0, 3, "id=") == 0)
-    {
-        token.erase(0, 3);
-        std::stringstream str(token);
-        ObjectID id;
-        str >> id;
+    _readToken(_token);
+    if (_token.compare(0, 3, "id=") == 0)
+    {
+        ObjectID id = 0;
+        std::from_chars(_token.data() + 3, _token.data() + _token.size(), id);
         return OptionalObjectID{true, id};
     }
     else
@@ -55,44 +78,56 @@ AsciiInput::OptionalObjectID AsciiInput::objectID()
 
 void AsciiInput::_read(std::string& value)
 {
+    using traits_type = std::istream::traits_type;
+
     value.clear();
 
-    char c;
-    _input >> c;
-    if (_input.good())
+    if (!_input.good())
     {
-        if (c == '"')
+        _input.setstate(std::ios_base::failbit);
+        return;
+    }
+
+    auto sb = _input.rdbuf();
+    auto c = sb->sgetc();
+    while (!traits_type::eq_int_type(c, traits_type::eof()) && std::isspace(c)) c = sb->snextc();
+
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        _input.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+        return;
+    }
+
+    if (c != '"')
+    {
+        _readToken(value);
+        return;
+    }
+
+    // skip opening quote and read up to the closing quote
+    c = sb->snextc();
+    while (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        if (c == '\\')
         {
-            _input.get(c);
-            while (_input.good())
-            {
-                if (c == '\\')
-                {
-                    _input.get(c);
-                    if (c == '"')
-                        value.push_back(c);
-                    else
-                    {
-                        value.push_back('\\');
-                        value.push_back(c);
-                    }
-                }
-                else if (c != '"')
-                {
-                    value.push_back(c);
-                }
-                else
-                {
-                    break;
-                }
-                _input.get(c);
-            }
+            c = sb->snextc();
+            if (traits_type::eq_int_type(c, traits_type::eof())) break;
+            if (c != '"') value.push_back('\\');
+            value.push_back(traits_type::to_char_type(c));
+        }
+        else if (c != '"')
+        {
+            value.push_back(traits_type::to_char_type(c));
         }
         else
         {
-            _input >> value;
+            sb->sbumpc();
+            return;
         }
+        c = sb->snextc();
     }
+
+    _input.setstate(std::ios_base::eofbit);
 }
 
 void AsciiInput::read(size_t num, std::string* value)
@@ -167,7 +202,7 @@ vsg::ref_ptr<vsg::Object> AsciiInput::read()
         else
         {
             std::string className;
-            _input >> className;
+            _readToken(className);
 
             //debug("Loading new object ", className);
 
@@ -0,0 +1,621 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/AsyncFileReader.h>
+#include <vsg/io/Logger.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#if defined(_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <sys/stat.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#    if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#        include <linux/io_uring.h>
+#        include <sys/mman.h>
+#        include <sys/syscall.h>
+#        if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#            define VSG_IO_URING_SUPPORTED 1
+#        endif
+#    endif
+#endif
+
+using namespace vsg;
+
+// cap the size of individual reads, larger files are read with successive reads
+static constexpr size_t s_maxReadSize = size_t(1) << 30;
+
+struct AsyncFileReader::PendingRead
+{
+#if defined(_WIN32)
+    // must be first member so the OVERLAPPED returned by GetQueuedCompletionStatus(..) can be cast back to the PendingRead
+    OVERLAPPED overlapped = {};
+    HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+    iovec iov = {};
+    int fd = -1;
+#endif
+    ref_ptr<AsyncRead> request;
+    size_t size = 0;
+    size_t offset = 0;
+    int64_t result = 0;
+
+    uint8_t* readPointer() { return request->data->dataPointer() ? static_cast<uint8_t*>(request->data->dataPointer()) + offset : nullptr; }
+    size_t readSize() const { return std::min(size - offset, s_maxReadSize); }
+};
+
+class AsyncFileReader::Backend
+{
+public:
+    virtual ~Backend() {}
+
+    virtual const char* name() const = 0;
+
+    /// open the file and assign the PendingRead::size
+    virtual bool open(PendingRead& pending) = 0;
+    virtual void close(PendingRead& pending) = 0;
+
+    /// start reading from PendingRead::offset to the end of the file, may complete with a short read.
+    virtual bool submit(PendingRead& pending) = 0;
+
+    /// wait for a read to complete, assigning the number of bytes read, or a negative error code, to PendingRead::result. Returns nullptr if woken by wake().
+    virtual PendingRead* wait() = 0;
+
+    /// wake the thread blocked in wait()
+    virtual void wake() = 0;
+};
+
+namespace
+{
+#if defined(_WIN32)
+    bool openFile(AsyncFileReader::PendingRead& pending, bool overlapped)
+    {
+        DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN;
+        if (overlapped) flags |= FILE_FLAG_OVERLAPPED;
+
+        pending.handle = CreateFileW(pending.request->filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (pending.handle == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(pending.handle, &fileSize))
+        {
+            CloseHandle(pending.handle);
+            pending.handle = INVALID_HANDLE_VALUE;
+            return false;
+        }
+
+        pending.size = static_cast<size_t>(fileSize.QuadPart);
+        return true;
+    }
+
+    void closeFile(AsyncFileReader::PendingRead& pending)
+    {
+        if (pending.handle != INVALID_HANDLE_VALUE) CloseHandle(pending.handle);
+        pending.handle = INVALID_HANDLE_VALUE;
+    }
+
+    int64_t readFile(AsyncFileReader::PendingRead& pending)
+    {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(pending.offset & 0xffffffff);
+        overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(pending.offset) >> 32);
+
+        DWORD bytesRead = 0;
+        if (!ReadFile(pending.handle, pending.readPointer(), static_cast<DWORD>(pending.readSize()), &bytesRead, &overlapped)) return -static_cast<int64_t>(GetLastError());
+        return static_cast<int64_t>(bytesRead);
+    }
+#else
+    bool openFile(AsyncFileReader::PendingRead& pending)
+    {
+        pending.fd = ::open(pending.request->filename.c_str(), O_RDONLY | O_CLOEXEC);
+        if (pending.fd < 0) return false;
+
+        struct stat fileStat;
+        if (::fstat(pending.fd, &fileStat) != 0)
+        {
+            ::close(pending.fd);
+            pending.fd = -1;
+            return false;
+        }
+
+        pending.size = static_cast<size_t>(fileStat.st_size);
+        return true;
+    }
+
+    void closeFile(AsyncFileReader::PendingRead& pending)
+    {
+        if (pending.fd >= 0) ::close(pending.fd);
+        pending.fd = -1;
+    }
+
+    int64_t readFile(AsyncFileReader::PendingRead& pending)
+    {
+        ssize_t result = 0;
+        do
+        {
+            result = ::pread(pending.fd, pending.readPointer(), pending.readSize(), static_cast<off_t>(pending.offset));
+        } while (result < 0 && errno == EINTR);
+
+        return result < 0 ? -static_cast<int64_t>(errno) : static_cast<int64_t>(result);
+    }
+#endif
+
+    /// fallback that reads files one at a time on the AsyncFileReader's I/O thread
+    class BlockingBackend : public AsyncFileReader::Backend
+    {
+    public:
+        const char* name() const override { return "blocking"; }
+
+#if defined(_WIN32)
+        bool open(AsyncFileReader::PendingRead& pending) override { return openFile(pending, false); }
+#else
+        bool open(AsyncFileReader::PendingRead& pending) override { return openFile(pending); }
+#endif
+        void close(AsyncFileReader::PendingRead& pending) override { closeFile(pending); }
+
+        bool submit(AsyncFileReader::PendingRead& pending) override
+        {
+            std::scoped_lock<std::mutex> lock(_mutex);
+            _queue.push_back(&pending);
+            _cv.notify_one();
+            return true;
+        }
+
+        AsyncFileReader::PendingRead* wait() override
+        {
+            AsyncFileReader::PendingRead* pending = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _cv.wait(lock, [&]() { return !_queue.empty(); });
+                pending = _queue.front();
+                _queue.pop_front();
+            }
+
+            if (pending) pending->result = readFile(*pending);
+            return pending;
+        }
+
+        void wake() override
+        {
+            std::scoped_lock<std::mutex> lock(_mutex);
+            _queue.push_back(nullptr);
+            _cv.notify_one();
+        }
+
+    protected:
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::deque<AsyncFileReader::PendingRead*> _queue;
+    };
+
+#if defined(VSG_IO_URING_SUPPORTED)
+    /// io_uring backend, uses the raw system calls so that no dependency on liburing is required
+    class IOUringBackend : public AsyncFileReader::Backend
+    {
+    public:
+        explicit IOUringBackend(uint32_t entries)
+        {
+            io_uring_params params = {};
+            _ringFD = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+            if (_ringFD < 0) return;
+
+            _sqEntries = params.sq_entries;
+            _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+            _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+            bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMap) _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+
+            _sqRing = ::mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFD, IORING_OFF_SQ_RING);
+            if (_sqRing == MAP_FAILED)
+            {
+                _sqRing = nullptr;
+                return;
+            }
+
+            if (singleMap)
+            {
+                _cqRing = _sqRing;
+            }
+            else
+            {
+                _cqRing = ::mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFD, IORING_OFF_CQ_RING);
+                if (_cqRing == MAP_FAILED)
+                {
+                    _cqRing = nullptr;
+                    return;
+                }
+            }
+
+            void* sqes = ::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFD, IORING_OFF_SQES);
+            if (sqes == MAP_FAILED) return;
+            _sqes = static_cast<io_uring_sqe*>(sqes);
+
+            auto sq = static_cast<uint8_t*>(_sqRing);
+            _sqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+            _sqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+            _sqMask = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+            _sqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+
+            auto cq = static_cast<uint8_t*>(_cqRing);
+            _cqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+            _cqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+            _cqMask = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+            _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        }
+
+        ~IOUringBackend()
+        {
+            if (_sqes) ::munmap(_sqes, _sqesSize);
+            if (_cqRing && _cqRing != _sqRing) ::munmap(_cqRing, _cqRingSize);
+            if (_sqRing) ::munmap(_sqRing, _sqRingSize);
+            if (_ringFD >= 0) ::close(_ringFD);
+        }
+
+        bool valid() const { return _sqes != nullptr; }
+
+        const char* name() const override { return "io_uring"; }
+
+        bool open(AsyncFileReader::PendingRead& pending) override { return openFile(pending); }
+        void close(AsyncFileReader::PendingRead& pending) override { closeFile(pending); }
+
+        bool submit(AsyncFileReader::PendingRead& pending) override
+        {
+            // use READV rather than READ so that kernels from 5.1 onwards are supported
+            pending.iov.iov_base = pending.readPointer();
+            pending.iov.iov_len = pending.readSize();
+            return _push(IORING_OP_READV, pending.fd, &pending.iov, 1, pending.offset, &pending);
+        }
+
+        AsyncFileReader::PendingRead* wait() override
+        {
+            for (;;)
+            {
+                // only the I/O thread consumes completions so the head can be read directly
+                uint32_t head = *_cqHead;
+                if (head != __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+                {
+                    const auto& cqe = _cqes[head & *_cqMask];
+                    auto pending = reinterpret_cast<AsyncFileReader::PendingRead*>(static_cast<uintptr_t>(cqe.user_data));
+                    if (pending) pending->result = cqe.res;
+
+                    __atomic_store_n(_cqHead, head + 1, __ATOMIC_RELEASE);
+                    return pending;
+                }
+
+                if (syscall(__NR_io_uring_enter, _ringFD, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 && errno != EINTR)
+                {
+                    warn("AsyncFileReader io_uring_enter() failed, errno = ", errno);
+                    return nullptr;
+                }
+            }
+        }
+
+        void wake() override
+        {
+            _push(IORING_OP_NOP, -1, nullptr, 0, 0, nullptr);
+        }
+
+    protected:
+        bool _push(uint8_t opcode, int fd, const void* addr, uint32_t len, uint64_t offset, AsyncFileReader::PendingRead* pending)
+        {
+            std::scoped_lock<std::mutex> lock(_sqMutex);
+
+            uint32_t tail = *_sqTail;
+            if (tail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries) return false;
+
+            uint32_t index = tail & *_sqMask;
+            auto& sqe = _sqes[index];
+            std::memset(&sqe, 0, sizeof(io_uring_sqe));
+            sqe.opcode = opcode;
+            sqe.fd = fd;
+            sqe.addr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(addr));
+            sqe.len = len;
+            sqe.off = offset;
+            sqe.user_data = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pending));
+            _sqArray[index] = index;
+
+            __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+            long result = 0;
+            do
+            {
+                result = syscall(__NR_io_uring_enter, _ringFD, 1, 0, 0, nullptr, 0);
+            } while (result < 0 && errno == EINTR);
+
+            if (result != 1)
+            {
+                // entry wasn't consumed by the kernel so withdraw it
+                __atomic_store_n(_sqTail, tail, __ATOMIC_RELEASE);
+                return false;
+            }
+            return true;
+        }
+
+        int _ringFD = -1;
+        uint32_t _sqEntries = 0;
+
+        void* _sqRing = nullptr;
+        void* _cqRing = nullptr;
+        size_t _sqRingSize = 0;
+        size_t _cqRingSize = 0;
+        size_t _sqesSize = 0;
+
+        std::mutex _sqMutex;
+        uint32_t* _sqHead = nullptr;
+        uint32_t* _sqTail = nullptr;
+        uint32_t* _sqMask = nullptr;
+        uint32_t* _sqArray = nullptr;
+        io_uring_sqe* _sqes = nullptr;
+
+        uint32_t* _cqHead = nullptr;
+        uint32_t* _cqTail = nullptr;
+        uint32_t* _cqMask = nullptr;
+        io_uring_cqe* _cqes = nullptr;
+    };
+#endif
+
+#if defined(_WIN32)
+    /// overlapped I/O backend, completions are collected from an I/O completion port
+    class OverlappedBackend : public AsyncFileReader::Backend
+    {
+    public:
+        OverlappedBackend()
+        {
+            _completionPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+        }
+
+        ~OverlappedBackend()
+        {
+            if (_completionPort) CloseHandle(_completionPort);
+        }
+
+        bool valid() const { return _completionPort != nullptr; }
+
+        const char* name() const override { return "overlapped"; }
+
+        bool open(AsyncFileReader::PendingRead& pending) override
+        {
+            if (!openFile(pending, true)) return false;
+
+            if (!CreateIoCompletionPort(pending.handle, _completionPort, 1, 0))
+            {
+                closeFile(pending);
+                return false;
+            }
+            return true;
+        }
+
+        void close(AsyncFileReader::PendingRead& pending) override { closeFile(pending); }
+
+        bool submit(AsyncFileReader::PendingRead& pending) override
+        {
+            pending.overlapped = {};
+            pending.overlapped.Offset = static_cast<DWORD>(pending.offset & 0xffffffff);
+            pending.overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(pending.offset) >> 32);
+
+            // reads that complete immediately still post a completion packet to the completion port
+            if (ReadFile(pending.handle, pending.readPointer(), static_cast<DWORD>(pending.readSize()), nullptr, &pending.overlapped)) return true;
+            return GetLastError() == ERROR_IO_PENDING;
+        }
+
+        AsyncFileReader::PendingRead* wait() override
+        {
+            DWORD bytesRead = 0;
+            ULONG_PTR key = 0;
+            LPOVERLAPPED overlapped = nullptr;
+            BOOL result = GetQueuedCompletionStatus(_completionPort, &bytesRead, &key, &overlapped, INFINITE);
+            if (!overlapped) return nullptr;
+
+            auto pending = reinterpret_cast<AsyncFileReader::PendingRead*>(overlapped);
+            pending->result = result ? static_cast<int64_t>(bytesRead) : -static_cast<int64_t>(GetLastError());
+            return pending;
+        }
+
+        void wake() override
+        {
+            PostQueuedCompletionStatus(_completionPort, 0, 0, nullptr);
+        }
+
+    protected:
+        HANDLE _completionPort = nullptr;
+    };
+#endif
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// AsyncFileReader
+//
+AsyncFileReader::AsyncFileReader(uint32_t in_queueDepth, uint32_t in_maxPendingReads) :
+    queueDepth(std::max(in_queueDepth, 1u)),
+    maxPendingReads(in_maxPendingReads)
+{
+#if defined(VSG_IO_URING_SUPPORTED)
+    // one extra entry for the NOP used to wake the I/O thread
+    auto ioUring = std::make_unique<IOUringBackend>(queueDepth + 1);
+    if (ioUring->valid())
+        _backend = std::move(ioUring);
+    else
+        info("AsyncFileReader io_uring not available, falling back to blocking reads.");
+#elif defined(_WIN32)
+    auto overlapped = std::make_unique<OverlappedBackend>();
+    if (overlapped->valid())
+        _backend = std::move(overlapped);
+    else
+        info("AsyncFileReader unable to create I/O completion port, falling back to blocking reads.");
+#endif
+
+    if (!_backend) _backend = std::make_unique<BlockingBackend>();
+
+    _thread = std::thread([this]() { _run(); });
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    _active = false;
+    _backend->wake();
+
+    if (_thread.joinable()) _thread.join();
+}
+
+const char* AsyncFileReader::backend() const
+{
+    return _backend->name();
+}
+
+void AsyncFileReader::read(ref_ptr<AsyncRead> request)
+{
+    auto pending = new PendingRead;
+    pending->request = request;
+    request->data = {};
+
+    // open the file and allocate the destination buffer before taking the lock
+    bool opened = _backend->open(*pending);
+    if (opened)
+    {
+        if (pending->size > std::numeric_limits<uint32_t>::max())
+        {
+            warn("AsyncFileReader::read(", request->filename, ") file too large to read into a ubyteArray.");
+            opened = false;
+        }
+        else if (pending->size > 0)
+        {
+            request->data = ubyteArray::create(static_cast<uint32_t>(pending->size));
+        }
+        else
+        {
+            request->data = ubyteArray::create();
+        }
+    }
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    ++_numPending;
+
+    if (!opened || pending->size == 0)
+        _complete(pending, opened);
+    else
+        _submit(pending);
+}
+
+ref_ptr<AsyncRead> AsyncFileReader::take_when_available(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_completedCV.wait_for(lock, timeout, [&]() { return !_completed.empty(); })) return {};
+
+    auto request = std::move(_completed.front());
+    _completed.pop_front();
+    --_numPending;
+
+    _capacityCV.notify_one();
+    return request;
+}
+
+bool AsyncFileReader::wait_for_capacity(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _capacityCV.wait_for(lock, timeout, [&]() { return _numPending < maxPendingReads; });
+}
+
+size_t AsyncFileReader::numPending() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _numPending;
+}
+
+void AsyncFileReader::_submit(PendingRead* pending)
+{
+    if (_numInFlight >= queueDepth)
+    {
+        _waiting.push_back(pending);
+    }
+    else if (_active && _backend->submit(*pending))
+    {
+        ++_numInFlight;
+    }
+    else
+    {
+        _complete(pending, false);
+    }
+}
+
+void AsyncFileReader::_complete(PendingRead* pending, bool success)
+{
+    _backend->close(*pending);
+
+    auto request = std::move(pending->request);
+    delete pending;
+
+    if (!success)
+    {
+        debug("AsyncFileReader failed to read ", request->filename);
+        request->data = {};
+    }
+
+    _completed.push_back(request);
+    _completedCV.notify_one();
+}
+
+void AsyncFileReader::_run()
+{
+    for (;;)
+    {
+        auto pending = _backend->wait();
+
+        std::scoped_lock<std::mutex> lock(_mutex);
+
+        if (pending)
+        {
+            bool success = false;
+            bool readComplete = true;
+            if (pending->result > 0)
+            {
+                pending->offset += static_cast<size_t>(pending->result);
+                if (pending->offset >= pending->size)
+                    success = true;
+                else if (_active && _backend->submit(*pending))
+                    readComplete = false; // short read so continue from the new offset
+            }
+
+            if (readComplete)
+            {
+                --_numInFlight;
+                _complete(pending, success);
+            }
+        }
+
+        // start the reads waiting for a free slot
+        while (!_waiting.empty() && _numInFlight < queueDepth)
+        {
+            auto waiting = _waiting.front();
+            _waiting.pop_front();
+            _submit(waiting);
+        }
+
+        if (!_active && _numInFlight == 0) break;
+    }
+
+    // discard any reads that were never started
+    for (auto waiting : _waiting) _complete(waiting, false);
+    _waiting.clear();
+}
@@ -13,14 +13,21 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/BinaryInput.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/ReaderWriter.h>
+#include <vsg/io/mem_stream.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/threading/OperationThreads.h>
 
 #include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
 
 using namespace vsg;
 
 BinaryInput::BinaryInput(std::istream& input, ref_ptr<ObjectFactory> in_objectFactory, ref_ptr<const Options> in_options) :
     Input(in_objectFactory, in_options),
-    _input(input)
+    _input(input),
+    _typeTable(1)
 {
 }
 
@@ -185,10 +192,45 @@ vsg::ref_ptr<vsg::Object> BinaryInput::read()
 {
     ObjectID id = objectID();
 
+    // an object ID of 0 marks the start of a group written by BinaryOutput::writeChunks(..)
+    if (id == 0 && version_greater_equal(1, 1, 18)) return _readChunks();
+
     if (auto itr = objectIDMap.find(id); itr != objectIDMap.end())
     {
         return itr->second;
     }
+    else if (version_greater_equal(1, 1, 17))
+    {
+        uint32_t typeID = 0;
+        _read(1, &typeID);
+        if (typeID == 0) return objectIDMap[id] = {};
+
+        if (typeID == _typeTable.size())
+        {
+            // first use of the type ID so it's followed by the class name, resolve the create function once for all subsequent objects of this type.
+            auto& entry = _typeTable.emplace_back();
+            _read(entry.className);
+            entry.create = objectFactory->getCreateFunction(entry.className);
+        }
+        else if (typeID > _typeTable.size())
+        {
+            warn("BinaryInput::read() invalid type ID : ", typeID);
+            return objectIDMap[id] = {};
+        }
+
+        const auto& entry = _typeTable[typeID];
+        auto object = entry.create ? entry.create() : ref_ptr<Object>();
+        objectIDMap[id] = object;
+        if (object)
+        {
+            object->read(*this);
+        }
+        else
+        {
+            warn("Unable to create instance of class : ", entry.className);
+        }
+        return object;
+    }
     else
     {
         std::string className = readValue<std::string>(nullptr);
@@ -212,3 +254,222 @@ vsg::ref_ptr<vsg::Object> BinaryInput::read()
         }
     }
 }
+
+void BinaryInput::readPayloadAlignment()
+{
+    if (!version_greater_equal(1, 1, 16)) return;
+
+    if (version_greater_equal(1, 1, 19))
+    {
+        uint8_t method = COMPRESSION_NONE;
+        _read(1, &method);
+        if (method != COMPRESSION_NONE)
+        {
+            // compressed payloads aren't padded, the compressed size precedes the compressed bytes
+            _read(1, &_compressedPayloadSize);
+            _payloadCompression = static_cast<CompressionMethod>(method);
+            return;
+        }
+    }
+
+    uint8_t padding = 0;
+    _read(1, &padding);
+    if (padding > 0) _input.ignore(padding);
+}
+
+ref_ptr<Data> BinaryInput::mapPayload(size_t size, size_t alignment)
+{
+    if (!mappedFile || _payloadCompression != COMPRESSION_NONE || size < mappedPayloadThreshold || size > std::numeric_limits<uint32_t>::max()) return {};
+
+    auto position = _input.tellg();
+    if (position < 0) return {};
+
+    size_t offset = mappedFileOffset + static_cast<size_t>(position);
+    if (offset > mappedFile->size() || size > (mappedFile->size() - offset)) return {};
+
+    // values can only be accessed in place if they are correctly aligned in memory
+    const uint8_t* ptr = mappedFile->data() + offset;
+    if ((reinterpret_cast<uintptr_t>(ptr) % alignment) != 0) return {};
+
+    _input.seekg(static_cast<std::streamoff>(size), std::ios_base::cur);
+
+    return ref_ptr<Data>(new MappedFileData(mappedFile, offset, size));
+}
+
+void BinaryInput::_readCompressedPayload(uint8_t* data, size_t size)
+{
+    auto method = _payloadCompression;
+    auto compressedSize = _compressedPayloadSize;
+    _payloadCompression = COMPRESSION_NONE;
+    _compressedPayloadSize = 0;
+
+    if (!compressionSupported(method))
+    {
+        warn("BinaryInput::_readCompressedPayload() compression method ", static_cast<uint32_t>(method), " not supported by this build, unable to read payload.");
+        _input.seekg(static_cast<std::streamoff>(compressedSize), std::ios_base::cur);
+        return;
+    }
+
+    // decompress directly from the mapped memory when available, otherwise read the compressed bytes into a scratch buffer
+    const uint8_t* src = nullptr;
+    auto position = _input.tellg();
+    if (mappedFile && position >= 0 && mappedFileOffset + static_cast<uint64_t>(position) + compressedSize <= mappedFile->size())
+    {
+        src = mappedFile->data() + mappedFileOffset + static_cast<size_t>(position);
+        _input.seekg(static_cast<std::streamoff>(compressedSize), std::ios_base::cur);
+    }
+    else
+    {
+        if (_compressionBuffer.size() < compressedSize) _compressionBuffer.resize(compressedSize);
+        _input.read(reinterpret_cast<char*>(_compressionBuffer.data()), compressedSize);
+        src = _compressionBuffer.data();
+    }
+
+    if (!_input.good() || !decompress(method, src, compressedSize, data, size))
+    {
+        warn("BinaryInput::_readCompressedPayload() failed to decompress payload of ", size, " bytes.");
+    }
+}
+
+void BinaryInput::continueFrom(const BinaryInput& rhs)
+{
+    filename = rhs.filename;
+    version = rhs.version;
+    objectIDMap = rhs.objectIDMap;
+    mappedFile = rhs.mappedFile;
+    mappedFileOffset = rhs.mappedFileOffset;
+    mappedPayloadThreshold = rhs.mappedPayloadThreshold;
+
+    _typeTable = rhs._typeTable;
+    _sharedCopyOfOptions = rhs._sharedCopyOfOptions;
+}
+
+ref_ptr<Object> BinaryInput::_readChunks()
+{
+    auto group = read().cast<Group>();
+
+    // read the objects shared between chunks so they are available to all the chunks
+    uint32_t numSharedObjects = readValue<uint32_t>(nullptr);
+    for (uint32_t i = 0; i < numSharedObjects; ++i)
+    {
+        read();
+    }
+
+    uint32_t numChunks = readValue<uint32_t>(nullptr);
+    if (!group || !_input.good())
+    {
+        warn("BinaryInput::_readChunks() unable to read chunked group.");
+        return {};
+    }
+
+    struct Chunk
+    {
+        size_t offset = 0;
+        std::vector<uint8_t> buffer;
+    };
+
+    // record where each chunk starts, when reading from a memory mapped file the chunks are decoded in place, otherwise they are read into buffers for decoding.
+    std::vector<Chunk> chunks(numChunks);
+    for (auto& chunk : chunks)
+    {
+        uint64_t size = readValue<uint64_t>(nullptr);
+        auto position = _input.tellg();
+        if (mappedFile && position >= 0 && mappedFileOffset + static_cast<uint64_t>(position) + size <= mappedFile->size())
+        {
+            chunk.offset = mappedFileOffset + static_cast<size_t>(position);
+            _input.seekg(static_cast<std::streamoff>(size), std::ios_base::cur);
+        }
+        else
+        {
+            chunk.buffer.resize(size);
+            _input.read(reinterpret_cast<char*>(chunk.buffer.data()), size);
+        }
+
+        if (!_input.good())
+        {
+            warn("BinaryInput::_readChunks() unable to read chunk.");
+            return {};
+        }
+    }
+
+    auto& children = group->children;
+    children.resize(numChunks);
+
+    // create the shared copy of options ahead of decoding the chunks in parallel so that all the chunks share the same copy
+    sharedCopyOfOptions();
+
+    auto readChunk = [&](size_t i) {
+        auto& chunk = chunks[i];
+
+        std::unique_ptr<mem_stream> stream;
+        if (chunk.buffer.empty())
+        {
+            // use a stream covering the whole mapped file so that payload offsets map directly to the file
+            stream.reset(new mem_stream(mappedFile->data(), mappedFile->size()));
+            stream->seekg(static_cast<std::streamoff>(chunk.offset));
+        }
+        else
+        {
+            stream.reset(new mem_stream(chunk.buffer.data(), chunk.buffer.size()));
+        }
+
+        BinaryInput chunkInput(*stream, objectFactory, options);
+        chunkInput.continueFrom(*this);
+        chunkInput.mappedFileOffset = 0;
+        if (!chunk.buffer.empty()) chunkInput.mappedFile = {};
+
+        children[i] = chunkInput.read().cast<Node>();
+
+        // release the buffer as soon as the chunk is decoded to keep peak memory down
+        chunk.buffer = {};
+    };
+
+    ref_ptr<OperationThreads> operationThreads;
+    if (options) operationThreads = options->operationThreads;
+
+    if (operationThreads && numChunks > 1)
+    {
+        struct ReadChunkOperation : public Operation
+        {
+            ReadChunkOperation(std::function<void(size_t)>& in_readChunk, size_t in_index, ref_ptr<Latch> in_latch) :
+                readChunk(in_readChunk),
+                index(in_index),
+                latch(in_latch) {}
+
+            void run() override
+            {
+                readChunk(index);
+                latch->count_down();
+            }
+
+            std::function<void(size_t)>& readChunk;
+            size_t index;
+            ref_ptr<Latch> latch;
+        };
+
+        std::function<void(size_t)> readChunkFunction(readChunk);
+
+        // use latch to synchronize this thread with the chunk decoding threads
+        auto latch = Latch::create(static_cast<int>(numChunks));
+
+        for (size_t i = 0; i < numChunks; ++i)
+        {
+            operationThreads->add(ref_ptr<Operation>(new ReadChunkOperation(readChunkFunction, i, latch)));
+        }
+
+        // use this thread to decode chunks as well
+        operationThreads->run();
+
+        // wait till all the chunks have been decoded
+        latch->wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < numChunks; ++i)
+        {
+            readChunk(i);
+        }
+    }
+
+    return group;
+}
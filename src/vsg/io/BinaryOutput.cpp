@@ -13,6 +13,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Version.h>
 
 #include <vsg/io/BinaryOutput.h>
+#include <vsg/nodes/Group.h>
+
+#include <algorithm>
+#include <set>
+#include <sstream>
 
 using namespace vsg;
 
@@ -102,7 +107,13 @@ void BinaryOutput::write(const vsg::Object* object)
     objectIDMap[object] = id;
 
     _output.write(reinterpret_cast<const char*>(&id), sizeof(id));
-    if (object)
+
+    if (version_greater_equal(1, 1, 17))
+    {
+        _writeTypeID(object ? object->className() : nullptr);
+        if (object) object->write(*this);
+    }
+    else if (object)
     {
         _write(std::string(object->className()));
         object->write(*this);
@@ -112,3 +123,198 @@ void BinaryOutput::write(const vsg::Object* object)
         _write(std::string("nullptr"));
     }
 }
+
+void BinaryOutput::_writeTypeID(const char* className)
+{
+    uint32_t typeID = 0;
+    if (!className)
+    {
+        _write(1, &typeID);
+        return;
+    }
+
+    if (auto itr = _typeIDs.find(className); itr != _typeIDs.end())
+    {
+        typeID = itr->second;
+        _write(1, &typeID);
+        return;
+    }
+
+    std::string name(className);
+    auto [itr, inserted] = _typeIDsByName.emplace(name, _nextTypeID);
+    typeID = itr->second;
+    _typeIDs[className] = typeID;
+
+    _write(1, &typeID);
+
+    // first use of the type ID so follow it with the class name so the reader can add it to its type table
+    if (inserted)
+    {
+        ++_nextTypeID;
+        _write(name);
+    }
+}
+
+void BinaryOutput::writePayloadAlignment(size_t alignment)
+{
+    if (version_less(1, 1, 16)) return;
+
+    alignment = std::max(alignment, payloadAlignment);
+
+    if (version_greater_equal(1, 1, 19))
+    {
+        // from 1.1.19 the payload is preceded by its compression method, so defer writing the header until the payload size is known.
+        _payloadPending = true;
+        _pendingAlignment = alignment;
+        return;
+    }
+
+    _writePadding(alignment);
+}
+
+void BinaryOutput::_writePadding(size_t alignment)
+{
+    // padding count is written as a single byte, followed by the padding bytes, so that the payload itself starts on the alignment boundary.
+    uint8_t padding = 0;
+    auto position = _output.tellp();
+    if (position >= 0 && alignment > 1 && alignment <= 256)
+    {
+        size_t remainder = (static_cast<size_t>(position + streamOffset) + 1) % alignment;
+        if (remainder != 0) padding = static_cast<uint8_t>(alignment - remainder);
+    }
+
+    _write(1, &padding);
+
+    static constexpr uint8_t zeros[256] = {};
+    if (padding > 0) _write(padding, zeros);
+}
+
+void BinaryOutput::_writePayload(const uint8_t* data, size_t size)
+{
+    _payloadPending = false;
+
+    // compressed payloads are written as the method, the compressed size and then the compressed bytes,
+    // uncompressed payloads as COMPRESSION_NONE followed by the padding and the raw bytes.
+    if (compression != COMPRESSION_NONE && size >= compressionThreshold && compressionSupported(compression))
+    {
+        size_t bound = compressBound(compression, size);
+        if (bound > 0)
+        {
+            if (_compressionBuffer.size() < bound) _compressionBuffer.resize(bound);
+
+            size_t compressedSize = compress(compression, compressionLevel, data, size, _compressionBuffer.data(), _compressionBuffer.size());
+            if (compressedSize > 0 && compressedSize < size)
+            {
+                uint8_t method = compression;
+                uint64_t compressedSize64 = compressedSize;
+                _write(1, &method);
+                _write(1, &compressedSize64);
+                _output.write(reinterpret_cast<const char*>(_compressionBuffer.data()), compressedSize);
+                return;
+            }
+        }
+    }
+
+    uint8_t method = COMPRESSION_NONE;
+    _write(1, &method);
+    _writePadding(_pendingAlignment);
+    _output.write(reinterpret_cast<const char*>(data), size);
+}
+
+void BinaryOutput::continueFrom(const BinaryOutput& rhs)
+{
+    version = rhs.version;
+    payloadAlignment = rhs.payloadAlignment;
+    compression = rhs.compression;
+    compressionLevel = rhs.compressionLevel;
+    compressionThreshold = rhs.compressionThreshold;
+    objectID = rhs.objectID;
+    objectIDMap = rhs.objectIDMap;
+
+    _nextTypeID = rhs._nextTypeID;
+    _typeIDs = rhs._typeIDs;
+    _typeIDsByName = rhs._typeIDsByName;
+}
+
+void BinaryOutput::writeChunks(const Group* group)
+{
+    if (!group || version_less(1, 1, 18))
+    {
+        write(group);
+        return;
+    }
+
+    const auto& children = group->children;
+
+    // find the objects that are referenced from more than one child by doing a dry run of writing each child to a null stream,
+    // recording the child index and the order each object was first encountered so that the shared objects are written in a deterministic order.
+    std::map<const Object*, std::pair<size_t, ObjectID>> firstEncountered;
+    std::set<std::pair<size_t, ObjectID>> shared;
+    {
+        std::ostream nullStream(nullptr);
+        for (size_t i = 0; i < children.size(); ++i)
+        {
+            BinaryOutput dryRun(nullStream, options);
+            dryRun.continueFrom(*this);
+            dryRun.compression = COMPRESSION_NONE;
+            dryRun.write(children[i].get());
+
+            for (const auto& [object, id] : dryRun.objectIDMap)
+            {
+                if (!object || objectIDMap.count(object) != 0) continue;
+
+                auto [itr, inserted] = firstEncountered.emplace(object, std::pair<size_t, ObjectID>(i, id));
+                if (!inserted && itr->second.first != i) shared.insert(itr->second);
+            }
+        }
+    }
+
+    std::vector<const Object*> sharedObjects(shared.size());
+    {
+        std::map<std::pair<size_t, ObjectID>, const Object*> orderedObjects;
+        for (const auto& [object, position] : firstEncountered)
+        {
+            if (shared.count(position) != 0) orderedObjects[position] = object;
+        }
+
+        size_t index = 0;
+        for (const auto& [position, object] : orderedObjects) sharedObjects[index++] = object;
+    }
+
+    // an object ID of 0 is never assigned to objects so marks the start of a chunked group
+    ObjectID marker = 0;
+    _write(1, &marker);
+
+    // write the group without its children
+    auto shell = Group::create(*group);
+    shell->children.clear();
+    write(shell.get());
+
+    uint32_t numSharedObjects = static_cast<uint32_t>(sharedObjects.size());
+    _write(1, &numSharedObjects);
+    for (auto object : sharedObjects)
+    {
+        write(object);
+    }
+
+    // write the chunks, each preceded by its size in bytes so readers can skip to the next chunk without decoding it
+    uint32_t numChunks = static_cast<uint32_t>(children.size());
+    _write(1, &numChunks);
+    for (const auto& child : children)
+    {
+        std::ostringstream chunkStream(std::ios::out | std::ios::binary);
+
+        BinaryOutput chunkOutput(chunkStream, options);
+        chunkOutput.continueFrom(*this);
+
+        auto position = _output.tellp();
+        if (position >= 0) chunkOutput.streamOffset = position + streamOffset + static_cast<std::streamoff>(sizeof(uint64_t));
+
+        chunkOutput.write(child.get());
+
+        auto chunk = chunkStream.str();
+        uint64_t size = chunk.size();
+        _write(1, &size);
+        _output.write(chunk.data(), chunk.size());
+    }
+}
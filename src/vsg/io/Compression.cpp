@@ -0,0 +1,125 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Version.h>
+#include <vsg/io/Compression.h>
+
+#if VSG_SUPPORTS_LZ4
+#    include <lz4.h>
+#    include <lz4hc.h>
+#endif
+
+#if VSG_SUPPORTS_zstd
+#    include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+using namespace vsg;
+
+bool vsg::compressionSupported(CompressionMethod method)
+{
+    switch (method)
+    {
+    case (COMPRESSION_NONE): return true;
+    case (COMPRESSION_LZ4): return VSG_SUPPORTS_LZ4 != 0;
+    case (COMPRESSION_ZSTD): return VSG_SUPPORTS_zstd != 0;
+    default: return false;
+    }
+}
+
+CompressionMethod vsg::compressionMethod(const std::string& name)
+{
+    if (name == "lz4" || name == "LZ4") return COMPRESSION_LZ4;
+    if (name == "zstd" || name == "ZSTD") return COMPRESSION_ZSTD;
+    return COMPRESSION_NONE;
+}
+
+size_t vsg::compressBound(CompressionMethod method, size_t srcSize)
+{
+    switch (method)
+    {
+#if VSG_SUPPORTS_LZ4
+    case (COMPRESSION_LZ4):
+        if (srcSize > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) return 0;
+        return static_cast<size_t>(LZ4_compressBound(static_cast<int>(srcSize)));
+#endif
+#if VSG_SUPPORTS_zstd
+    case (COMPRESSION_ZSTD): return ZSTD_compressBound(srcSize);
+#endif
+    default:
+        (void)srcSize;
+        return 0;
+    }
+}
+
+size_t vsg::compress(CompressionMethod method, int level, const void* src, size_t srcSize, void* dst, size_t dstCapacity)
+{
+    switch (method)
+    {
+#if VSG_SUPPORTS_LZ4
+    case (COMPRESSION_LZ4): {
+        if (srcSize > static_cast<size_t>(LZ4_MAX_INPUT_SIZE)) return 0;
+
+        int capacity = static_cast<int>(std::min(dstCapacity, static_cast<size_t>(std::numeric_limits<int>::max())));
+        int result = 0;
+        if (level > 0)
+            result = LZ4_compress_HC(static_cast<const char*>(src), static_cast<char*>(dst), static_cast<int>(srcSize), capacity, level);
+        else
+            result = LZ4_compress_default(static_cast<const char*>(src), static_cast<char*>(dst), static_cast<int>(srcSize), capacity);
+        return result > 0 ? static_cast<size_t>(result) : 0;
+    }
+#endif
+#if VSG_SUPPORTS_zstd
+    case (COMPRESSION_ZSTD): {
+        size_t result = ZSTD_compress(dst, dstCapacity, src, srcSize, level != 0 ? level : ZSTD_CLEVEL_DEFAULT);
+        return ZSTD_isError(result) ? 0 : result;
+    }
+#endif
+    default:
+        (void)level;
+        (void)src;
+        (void)srcSize;
+        (void)dst;
+        (void)dstCapacity;
+        return 0;
+    }
+}
+
+bool vsg::decompress(CompressionMethod method, const void* src, size_t srcSize, void* dst, size_t dstSize)
+{
+    switch (method)
+    {
+#if VSG_SUPPORTS_LZ4
+    case (COMPRESSION_LZ4): {
+        if (srcSize > static_cast<size_t>(std::numeric_limits<int>::max()) || dstSize > static_cast<size_t>(std::numeric_limits<int>::max())) return false;
+
+        int result = LZ4_decompress_safe(static_cast<const char*>(src), static_cast<char*>(dst), static_cast<int>(srcSize), static_cast<int>(dstSize));
+        return result >= 0 && static_cast<size_t>(result) == dstSize;
+    }
+#endif
+#if VSG_SUPPORTS_zstd
+    case (COMPRESSION_ZSTD): {
+        size_t result = ZSTD_decompress(dst, dstSize, src, srcSize);
+        return !ZSTD_isError(result) && result == dstSize;
+    }
+#endif
+    default:
+        (void)src;
+        (void)srcSize;
+        (void)dst;
+        (void)dstSize;
+        return false;
+    }
+}
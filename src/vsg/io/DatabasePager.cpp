@@ -11,12 +11,24 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/io/DatabasePager.h>
+#include <vsg/io/FileSystem.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/ReaderWriter.h>
 #include <vsg/io/read.h>
+#include <vsg/state/BufferInfo.h>
+#include <vsg/state/ImageInfo.h>
 #include <vsg/threading/atomics.h>
 #include <vsg/ui/ApplicationEvent.h>
+#include <vsg/utils/CompressTextures.h>
+#include <vsg/utils/ProcessImages.h>
+#include <vsg/utils/GenerateLODs.h>
+#include <vsg/utils/Instrumentation.h>
+#include <vsg/utils/OptimizeMeshes.h>
 #include <vsg/utils/SharedObjects.h>
+#include <vsg/vk/DescriptorPools.h>
+#include <vsg/vk/ResourceRequirements.h>
+
+#include <algorithm>
 
 using namespace vsg;
 
@@ -364,6 +376,87 @@ bool PagedLODContainer::check()
     return result1 && result2 && result3;
 }
 
+/////////////////////////////////////////////////////////////////////////
+//
+// RecycledSubgraphs
+//
+RecycledSubgraphs::RecycledSubgraphs(uint32_t in_maxNumSubgraphs, uint64_t in_maxGPUMemory) :
+    maxNumSubgraphs(in_maxNumSubgraphs),
+    maxGPUMemory(in_maxGPUMemory)
+{
+}
+
+RecycledSubgraphs::Subgraphs RecycledSubgraphs::add(const Path& filename, ref_ptr<Node> subgraph, uint64_t in_gpuMemory)
+{
+    Subgraphs evicted;
+    if (!subgraph) return evicted;
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto evict = [&](Entries::iterator itr) {
+        evicted.push_back(itr->subgraph);
+        _gpuMemory -= itr->gpuMemory;
+        _lookup.erase(itr->filename);
+        _entries.erase(itr);
+        ++numEvicted;
+    };
+
+    // replace any previous subgraph for the same file
+    if (auto itr = _lookup.find(filename); itr != _lookup.end()) evict(itr->second);
+
+    _entries.push_back(Entry{filename, subgraph, in_gpuMemory});
+    _lookup[filename] = std::prev(_entries.end());
+    _gpuMemory += in_gpuMemory;
+
+    while (!_entries.empty() && (_entries.size() > maxNumSubgraphs || (maxGPUMemory > 0 && _gpuMemory > maxGPUMemory)))
+    {
+        evict(_entries.begin());
+    }
+
+    return evicted;
+}
+
+ref_ptr<Node> RecycledSubgraphs::take(const Path& filename)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto itr = _lookup.find(filename);
+    if (itr == _lookup.end()) return {};
+
+    auto subgraph = itr->second->subgraph;
+    _gpuMemory -= itr->second->gpuMemory;
+    _entries.erase(itr->second);
+    _lookup.erase(itr);
+
+    return subgraph;
+}
+
+RecycledSubgraphs::Subgraphs RecycledSubgraphs::clear()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    Subgraphs subgraphs;
+    for (auto& entry : _entries) subgraphs.push_back(entry.subgraph);
+
+    _entries.clear();
+    _lookup.clear();
+    _gpuMemory = 0;
+
+    return subgraphs;
+}
+
+size_t RecycledSubgraphs::size() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+uint64_t RecycledSubgraphs::gpuMemory() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _gpuMemory;
+}
+
 /////////////////////////////////////////////////////////////////////////
 //
 // DatabaseQueue
@@ -381,17 +474,28 @@ void DatabaseQueue::add(ref_ptr<PagedLOD> plod)
 {
     // debug("DatabaseQueue::add(", plod,") status = ",plod->requestStatus.load());
 
-    std::scoped_lock lock(_mutex);
-    _queue.emplace_back(plod);
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "DatabaseQueue::_mutex");
+    _queue.push_back(Request{plod->priority.load(), plod});
+    std::push_heap(_queue.begin(), _queue.end());
     _cv.notify_one();
 }
 
 void DatabaseQueue::add(ref_ptr<PagedLOD> plod, const CompileResult& cr)
 {
-    std::scoped_lock lock(_mutex);
-    _queue.emplace_back(plod);
+    size_t dynamicDataSize = 0;
+    for (const auto& bufferInfo : cr.dynamicData.bufferInfos)
+    {
+        if (bufferInfo->data) dynamicDataSize += bufferInfo->data->dataSize();
+    }
+    for (const auto& imageInfo : cr.dynamicData.imageInfos)
+    {
+        if (imageInfo->imageView && imageInfo->imageView->image && imageInfo->imageView->image->data) dynamicDataSize += imageInfo->imageView->image->data->dataSize();
+    }
+
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "DatabaseQueue::_mutex");
+    _queue.push_back(Request{plod->priority.load(), plod, cr, dynamicDataSize});
+    std::push_heap(_queue.begin(), _queue.end());
     _cv.notify_one();
-    _compileResult.add(cr);
 }
 
 ref_ptr<PagedLOD> DatabaseQueue::take_when_available()
@@ -399,7 +503,8 @@ ref_ptr<PagedLOD> DatabaseQueue::take_when_available()
     // debug("DatabaseQueue::take_when_available() A size = ", _queue.size());
 
     std::chrono::duration waitDuration = std::chrono::milliseconds(100);
-    std::unique_lock lock(_mutex);
+    std::unique_lock lock(_mutex, std::defer_lock);
+    LOCK_INSTRUMENTATION(lock, "DatabaseQueue::_mutex");
 
     // wait until the conditional variable signals that an operation has been added
     while (_queue.empty() && _status->active())
@@ -417,17 +522,10 @@ ref_ptr<PagedLOD> DatabaseQueue::take_when_available()
 
     // debug("DatabaseQueue::take_when_available() D ", _queue.size());
 
-    // find the PagedLOD with the highest priority;
-    auto itr = _queue.begin();
-    auto highest_itr = itr++;
-
-    for (; itr != _queue.end(); ++itr)
-    {
-        if ((*itr)->priority > (*highest_itr)->priority) highest_itr = itr;
-    }
-
-    ref_ptr<PagedLOD> plod = *highest_itr;
-    _queue.erase(highest_itr);
+    // take the PagedLOD with the highest priority from the front of the heap
+    std::pop_heap(_queue.begin(), _queue.end());
+    ref_ptr<PagedLOD> plod = std::move(_queue.back().plod);
+    _queue.pop_back();
 
     // debug("Returning ", plod.get(), std::dec, ", size = ", _queue.size());
     return plod;
@@ -435,14 +533,128 @@ ref_ptr<PagedLOD> DatabaseQueue::take_when_available()
 
 DatabaseQueue::Nodes DatabaseQueue::take_all(CompileResult& cr)
 {
-    std::scoped_lock lock(_mutex);
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "DatabaseQueue::_mutex");
     Nodes nodes;
-    nodes.swap(_queue);
-    cr.add(_compileResult);
-    _compileResult.reset();
+    for (auto& request : _queue)
+    {
+        nodes.push_back(std::move(request.plod));
+        cr.add(request.compileResult);
+    }
+    _queue.clear();
     return nodes;
 }
 
+DatabaseQueue::Nodes DatabaseQueue::take(CompileResult& cr, uint32_t maxCount, size_t maxBytes)
+{
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "DatabaseQueue::_mutex");
+    Nodes nodes;
+    size_t bytes = 0;
+    while (!_queue.empty())
+    {
+        if (maxCount > 0 && nodes.size() >= maxCount) break;
+        if (maxBytes > 0 && !nodes.empty() && (bytes + _queue.front().dynamicDataSize) > maxBytes) break;
+
+        std::pop_heap(_queue.begin(), _queue.end());
+        auto& request = _queue.back();
+        bytes += request.dynamicDataSize;
+        nodes.push_back(std::move(request.plod));
+        cr.add(request.compileResult);
+        _queue.pop_back();
+    }
+    return nodes;
+}
+
+DatabaseQueue::Nodes DatabaseQueue::prioritize(uint64_t frameCount)
+{
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "DatabaseQueue::_mutex");
+
+    Nodes expired;
+
+    // remove requests for PagedLOD that weren't visible in the previous frame, and pick up the priorities assigned in the latest frame.
+    auto itr = std::remove_if(_queue.begin(), _queue.end(), [&](Request& request) {
+        if ((frameCount - request.plod->frameHighResLastUsed.load()) > 1)
+        {
+            expired.push_back(std::move(request.plod));
+            return true;
+        }
+        request.priority = request.plod->priority.load();
+        return false;
+    });
+    _queue.erase(itr, _queue.end());
+
+    std::make_heap(_queue.begin(), _queue.end());
+
+    return expired;
+}
+
+size_t DatabaseQueue::size() const
+{
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "DatabaseQueue::_mutex");
+    return _queue.size();
+}
+
+/////////////////////////////////////////////////////////////////////////
+//
+// DatabaseCompileQueue
+//
+DatabaseCompileQueue::DatabaseCompileQueue(ref_ptr<ActivityStatus> status, uint32_t in_maxSize) :
+    maxSize(std::max(in_maxSize, 1u)),
+    _status(status)
+{
+}
+
+DatabaseCompileQueue::~DatabaseCompileQueue()
+{
+}
+
+bool DatabaseCompileQueue::add(ref_ptr<PagedLOD> plod, ref_ptr<Object> object)
+{
+    std::chrono::duration waitDuration = std::chrono::milliseconds(100);
+    std::unique_lock lock(_mutex, std::defer_lock);
+    LOCK_INSTRUMENTATION(lock, "DatabaseCompileQueue::_mutex");
+
+    // wait until the compile threads have made room in the queue
+    while (_queue.size() >= maxSize && _status->active())
+    {
+        _notFullCV.wait_for(lock, waitDuration);
+    }
+
+    if (!_status->active()) return false;
+
+    _queue.push_back(Entry{plod, object});
+    _notEmptyCV.notify_one();
+    return true;
+}
+
+DatabaseCompileQueue::Entry DatabaseCompileQueue::take_when_available()
+{
+    std::chrono::duration waitDuration = std::chrono::milliseconds(100);
+    std::unique_lock lock(_mutex, std::defer_lock);
+    LOCK_INSTRUMENTATION(lock, "DatabaseCompileQueue::_mutex");
+
+    // wait until the conditional variable signals that an entry has been added
+    while (_queue.empty() && _status->active())
+    {
+        _notEmptyCV.wait_for(lock, waitDuration);
+    }
+
+    if (_queue.empty() || _status->cancel()) return {};
+
+    // take the highest priority entry, the priorities are updated by the RecordTraversal so have to be searched each time.
+    auto itr = std::max_element(_queue.begin(), _queue.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.plod->priority < rhs.plod->priority; });
+    Entry entry = std::move(*itr);
+    _queue.erase(itr);
+
+    _notFullCV.notify_one();
+    return entry;
+}
+
+size_t DatabaseCompileQueue::size() const
+{
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "DatabaseCompileQueue::_mutex");
+    return _queue.size();
+}
+
 /////////////////////////////////////////////////////////////////////////
 //
 // DatabasePager
@@ -497,58 +709,109 @@ void DatabasePager::start(uint32_t numReadThreads)
             {
                 CPU_INSTRUMENTATION_L1_NC(databasePager.instrumentation, "DatabasePager read", COLOR_PAGER);
 
-                uint64_t frameDelta = databasePager.frameCount - plod->frameHighResLastUsed.load();
-                if (frameDelta > 1 || !compare_exchange(plod->requestStatus, PagedLOD::ReadRequest, PagedLOD::Reading))
+                if (!databasePager._startReading(plod) || databasePager._recycle(plod)) continue;
+
+                ref_ptr<Object> read_object;
                 {
-                    // debug("Expire read request");
-                    databasePager.requestDiscarded(plod);
-                    continue;
+                    AllocatorArenaScope arenaScope(databasePager._createAllocatorArena());
+                    read_object = vsg::read(plod->filename, plod->options);
                 }
+                databasePager._compileOrQueue(plod, read_object);
+            }
+        }
+        debug("Finished DatabaseThread read thread");
+    };
 
-                auto read_object = vsg::read(plod->filename, plod->options);
-                auto subgraph = read_object.cast<Node>();
+    auto fetchThread = [](ref_ptr<DatabaseQueue> requestQueue, ref_ptr<ActivityStatus> status, DatabasePager& databasePager, const std::string& threadName) {
+        debug("Started DatabaseThread fetch thread");
 
-                if (subgraph && compare_exchange(plod->requestStatus, PagedLOD::Reading, PagedLOD::Compiling))
-                {
-                    {
-                        std::scoped_lock<std::mutex> lock(databasePager.pendingPagedLODMutex);
-                        plod->pending = subgraph;
-                    }
+        auto local_instrumentation = shareOrDuplicateForThreadSafety(databasePager.instrumentation);
+        if (local_instrumentation) local_instrumentation->setThreadName(threadName);
+
+        auto asyncFileReader = databasePager.asyncFileReader;
+        while (status->active())
+        {
+            // limit the number of outstanding reads so that requests keep being taken from the request queue in priority order
+            if (!asyncFileReader->wait_for_capacity()) continue;
 
-                    try
+            auto plod = requestQueue->take_when_available();
+            if (plod && databasePager._startReading(plod) && !databasePager._recycle(plod))
+            {
+                // files that can't be found locally, such as those provided by network protocols, fail to open and are read via the filename by the decode thread
+                asyncFileReader->read(AsyncRead::create(findFile(plod->filename, plod->options), plod));
+            }
+        }
+        debug("Finished DatabaseThread fetch thread");
+    };
+
+    auto decodeThread = [](ref_ptr<ActivityStatus> status, DatabasePager& databasePager, const std::string& threadName) {
+        debug("Started DatabaseThread decode thread");
+
+        auto local_instrumentation = shareOrDuplicateForThreadSafety(databasePager.instrumentation);
+        if (local_instrumentation) local_instrumentation->setThreadName(threadName);
+
+        auto asyncFileReader = databasePager.asyncFileReader;
+        while (status->active())
+        {
+            auto request = asyncFileReader->take_when_available();
+            auto plod = request ? request->object.cast<PagedLOD>() : ref_ptr<PagedLOD>();
+            if (plod)
+            {
+                CPU_INSTRUMENTATION_L1_NC(databasePager.instrumentation, "DatabasePager decode", COLOR_PAGER);
+
+                ref_ptr<Object> read_object;
+                {
+                    AllocatorArenaScope arenaScope(databasePager._createAllocatorArena());
+                    if (request->succeeded())
                     {
-                        // compile plod
-                        if (auto result = databasePager.compileManager->compile(subgraph))
-                        {
-                            plod->requestStatus.exchange(PagedLOD::MergeRequest);
+                        auto options = plod->options ? Options::create(*plod->options) : Options::create();
+                        options->extensionHint = lowerCaseFileExtension(plod->filename);
 
-                            // move to the merge queue;
-                            databasePager._toMergeQueue->add(plod, result);
-                        }
-                        else
+                        read_object = vsg::read(request->data->data(), request->data->dataSize(), options);
+                        if (read_object && options->generateLODs)
                         {
-                            debug("DatabaserPager::start() unable to compile subgraph, discarding request ", subgraph);
-                            databasePager.requestDiscarded(plod);
+                            if (auto node = read_object.cast<Node>()) read_object = options->generateLODs->generate(node);
                         }
+                        if (read_object && options->optimizeMeshes) options->optimizeMeshes->apply(*read_object);
+                        if (read_object && options->compressTextures) options->compressTextures->apply(*read_object);
+                        if (read_object && options->processImages) options->processImages->apply(*read_object);
                     }
-                    catch (...)
-                    {
-                        debug("DatabaserPager::start() compile threw exception, discarding request ", subgraph);
-                        databasePager.requestDiscarded(plod);
-                    }
+
+                    // fall back to reading via the filename for formats that can't be read from memory or files that couldn't be read asynchronously
+                    if (!read_object) read_object = vsg::read(plod->filename, plod->options);
                 }
-                else
-                {
-                    if (auto read_error = read_object.cast<ReadError>())
-                        warn(read_error->message);
-                    else
-                        warn("Failed to read ", plod, " ", plod->filename);
 
-                    databasePager.requestDiscarded(plod);
+                databasePager._compileOrQueue(plod, read_object);
+            }
+        }
+        debug("Finished DatabaseThread decode thread");
+    };
+
+    auto compileThread = [](ref_ptr<DatabaseCompileQueue> compileQueue, ref_ptr<ActivityStatus> status, DatabasePager& databasePager, const std::string& threadName) {
+        debug("Started DatabaseThread compile thread");
+
+        auto local_instrumentation = shareOrDuplicateForThreadSafety(databasePager.instrumentation);
+        if (local_instrumentation) local_instrumentation->setThreadName(threadName);
+
+        while (status->active())
+        {
+            auto entry = compileQueue->take_when_available();
+            if (entry.plod)
+            {
+                CPU_INSTRUMENTATION_L1_NC(databasePager.instrumentation, "DatabasePager compile", COLOR_PAGER);
+
+                // discard subgraphs that are no longer visible rather than spending compile time and GPU memory on them
+                uint64_t frameDelta = databasePager.frameCount - entry.plod->frameHighResLastUsed.load();
+                if (frameDelta > 1 && entry.object.cast<Node>())
+                {
+                    databasePager.requestExpired(entry.plod);
+                    continue;
                 }
+
+                databasePager._compile(entry.plod, entry.object);
             }
         }
-        debug("Finished DatabaseThread read thread");
+        debug("Finished DatabaseThread compile thread");
     };
 
     auto deleteThread = [](ref_ptr<DeleteQueue> deleteQueue, ref_ptr<ActivityStatus> status, const DatabasePager& databasePager, const std::string& threadName) {
@@ -564,12 +827,40 @@ void DatabasePager::start(uint32_t numReadThreads)
         debug("Finished DatabaseThread delete thread");
     };
 
-    for (uint32_t i = 0; i < numReadThreads; ++i)
+    if (asyncFileReader)
+    {
+        threads.emplace_back(fetchThread, std::ref(_requestQueue), std::ref(_status), std::ref(*this), "DatabasePager fetch thread");
+
+        for (uint32_t i = 0; i < numReadThreads; ++i)
+        {
+            threads.emplace_back(decodeThread, std::ref(_status), std::ref(*this), make_string("DatabasePager decode thread ", i));
+        }
+    }
+    else
     {
-        threads.emplace_back(readThread, std::ref(_requestQueue), std::ref(_status), std::ref(*this), make_string("DatabasePager read thread ", i));
+        for (uint32_t i = 0; i < numReadThreads; ++i)
+        {
+            threads.emplace_back(readThread, std::ref(_requestQueue), std::ref(_status), std::ref(*this), make_string("DatabasePager read thread ", i));
+        }
+    }
+
+    if (numCompileThreads > 0)
+    {
+        _compileQueue = DatabaseCompileQueue::create(_status, maxCompileQueueSize);
+
+        for (uint32_t i = 0; i < numCompileThreads; ++i)
+        {
+            threads.emplace_back(compileThread, _compileQueue, std::ref(_status), std::ref(*this), make_string("DatabasePager compile thread ", i));
+        }
     }
 
     threads.emplace_back(deleteThread, std::ref(_deleteQueue), std::ref(_status), std::ref(*this), "DatabasePager delete thread ");
+
+    auto affinity = threadAffinity ? threadAffinity : efficiencyCoreAffinity();
+    if (affinity)
+    {
+        for (auto& thread : threads) setAffinity(thread, affinity);
+    }
 }
 
 void DatabasePager::request(ref_ptr<PagedLOD> plod)
@@ -610,6 +901,162 @@ void DatabasePager::requestDiscarded(PagedLOD* plod)
     --numActiveRequests;
 }
 
+ref_ptr<AllocatorArena> DatabasePager::_createAllocatorArena() const
+{
+    if (allocatorArenaBlockSize == 0) return {};
+    return AllocatorArena::create(allocatorArenaBlockSize);
+}
+
+bool DatabasePager::_startReading(PagedLOD* plod)
+{
+    uint64_t frameDelta = frameCount - plod->frameHighResLastUsed.load();
+    if (frameDelta > 1 || !compare_exchange(plod->requestStatus, PagedLOD::ReadRequest, PagedLOD::Reading))
+    {
+        // debug("Expire read request");
+        requestExpired(plod);
+        return false;
+    }
+    return true;
+}
+
+void DatabasePager::_compile(PagedLOD* plod, ref_ptr<Object> read_object)
+{
+    auto subgraph = read_object.cast<Node>();
+
+    if (subgraph && compare_exchange(plod->requestStatus, PagedLOD::Reading, PagedLOD::Compiling))
+    {
+        {
+            std::scoped_lock<std::mutex> lock(pendingPagedLODMutex);
+            plod->pending = subgraph;
+        }
+
+        try
+        {
+            // assign the pager's memory priority to subgraphs that don't provide their own ResourceHints
+            bool assignedResourceHints = false;
+            if (!subgraph->getObject<ResourceHints>("ResourceHints"))
+            {
+                auto resourceHints = ResourceHints::create();
+                resourceHints->memoryPriority = memoryPriority;
+                subgraph->setObject("ResourceHints", resourceHints);
+                assignedResourceHints = true;
+            }
+
+            // compile plod
+            if (auto result = compileManager->compile(subgraph))
+            {
+                // record the memory held by the subgraph so the pager can keep within its memory budgets, complete ResourceHints provide it without a traversal
+                CollectResourceRequirements collectRequirements;
+                subgraph->accept(collectRequirements);
+                collectRequirements.requirements.computeMemoryUsage(plod->highResCPUMemory, plod->highResGPUMemory);
+
+                // cache the collected requirements with the subgraph so that merging it again after recycling doesn't need to traverse it
+                if (assignedResourceHints)
+                {
+                    if (auto resourceHints = collectRequirements.createSubgraphResourceHints()) subgraph->setObject("ResourceHints", resourceHints);
+                }
+
+                plod->requestStatus.exchange(PagedLOD::MergeRequest);
+
+                // move to the merge queue;
+                _toMergeQueue->add(ref_ptr<PagedLOD>(plod), result);
+            }
+            else
+            {
+                debug("DatabaserPager::start() unable to compile subgraph, discarding request ", subgraph);
+                requestFailed(plod);
+            }
+        }
+        catch (...)
+        {
+            debug("DatabaserPager::start() compile threw exception, discarding request ", subgraph);
+            requestFailed(plod);
+        }
+    }
+    else
+    {
+        if (auto read_error = read_object.cast<ReadError>())
+            warn(read_error->message);
+        else
+            warn("Failed to read ", plod, " ", plod->filename);
+
+        requestFailed(plod);
+    }
+}
+
+void DatabasePager::_compileOrQueue(PagedLOD* plod, ref_ptr<Object> read_object)
+{
+    if (_compileQueue)
+    {
+        // waits while the compile threads are busy, applying backpressure to the read threads
+        if (!_compileQueue->add(ref_ptr<PagedLOD>(plod), read_object)) requestDiscarded(plod);
+    }
+    else
+    {
+        _compile(plod, read_object);
+    }
+}
+
+bool DatabasePager::_recycle(PagedLOD* plod)
+{
+    if (!recycledSubgraphs) return false;
+
+    auto subgraph = recycledSubgraphs->take(plod->filename);
+    if (!subgraph) return false;
+
+    if (!compare_exchange(plod->requestStatus, PagedLOD::Reading, PagedLOD::Compiling))
+    {
+        // return the subgraph to the cache for a later request, deleting any subgraphs evicted via the DeleteQueue as they may still be in use by the GPU
+        auto evicted = recycledSubgraphs->add(plod->filename, subgraph, plod->highResGPUMemory);
+        if (!evicted.empty()) _deleteQueue->add(evicted);
+        requestDiscarded(plod);
+        return true;
+    }
+
+    {
+        std::scoped_lock<std::mutex> lock(pendingPagedLODMutex);
+        plod->pending = subgraph;
+    }
+
+    // the subgraph is already compiled so just collect the details required by the viewer when merging it
+    CollectResourceRequirements collectRequirements;
+    subgraph->accept(collectRequirements);
+
+    auto& requirements = collectRequirements.requirements;
+    requirements.computeMemoryUsage(plod->highResCPUMemory, plod->highResGPUMemory);
+
+    CompileResult result;
+    result.result = VK_SUCCESS;
+    result.maxSlots = requirements.maxSlots;
+    result.containsPagedLOD = requirements.containsPagedLOD;
+    result.views = requirements.views;
+    result.dynamicData = requirements.dynamicData;
+
+    plod->requestStatus.exchange(PagedLOD::MergeRequest);
+
+    _toMergeQueue->add(ref_ptr<PagedLOD>(plod), result);
+
+    ++recycledSubgraphs->numRecycled;
+    return true;
+}
+
+void DatabasePager::requestExpired(PagedLOD* plod)
+{
+    ++numExpiredRequests;
+    requestDiscarded(plod);
+}
+
+void DatabasePager::requestFailed(PagedLOD* plod)
+{
+    ++numFailedRequests;
+    requestDiscarded(plod);
+}
+
+bool DatabasePager::requiresUpdate() const
+{
+    return _toMergeQueue->size() > 0;
+}
+
 void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResult& cr)
 {
     CPU_INSTRUMENTATION_L1(instrumentation);
@@ -617,7 +1064,25 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
     frameCount.exchange(frameStamp ? frameStamp->frameCount : 0);
     _deleteQueue->advance(frameStamp);
 
-    auto nodes = _toMergeQueue->take_all(cr);
+    // merge the highest priority subgraphs within the per frame budget, leaving the rest for later frames
+    auto nodes = _toMergeQueue->take(cr, maxNumMergesPerFrame, maxMergeBytesPerFrame);
+
+    // re-prioritize outstanding read requests using the priorities assigned by the RecordTraversal for this frame, dropping those no longer visible.
+    auto expired = _requestQueue->prioritize(frameCount);
+    for (auto& plod : expired)
+    {
+        requestExpired(plod);
+    }
+
+    if (instrumentation)
+    {
+        instrumentation->plot("DatabasePager read requests", static_cast<double>(_requestQueue->size()));
+        instrumentation->plot("DatabasePager merge requests", static_cast<double>(_toMergeQueue->size()));
+        instrumentation->plot("DatabasePager CPU memory", static_cast<double>(highResSubgraphsCPUMemory.load()));
+        instrumentation->plot("DatabasePager GPU memory", static_cast<double>(highResSubgraphsGPUMemory.load()));
+        instrumentation->plot("DatabasePager expired requests", static_cast<double>(numExpiredRequests.load()));
+        instrumentation->plot("DatabasePager failed requests", static_cast<double>(numFailedRequests.load()));
+    }
 
     std::list<ref_ptr<Object>> deleteList;
     std::list<ref_ptr<SharedObjects>> sharedObjectsToPrune;
@@ -669,14 +1134,44 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
 
         debug("DatabasePager : activeList.count = ", pagedLODContainer->activeList.count, ", inactiveList.count = ", pagedLODContainer->inactiveList.count, ", total = ", total);
 
+        uint32_t targetNumInactive = pagedLODContainer->inactiveList.count;
         if ((nodes.size() + total) > targetMaxNumPagedLODWithHighResSubgraphs)
         {
             uint32_t numPagedLODHighRestSubgraphsToRemove = (static_cast<uint32_t>(nodes.size()) + total) - targetMaxNumPagedLODWithHighResSubgraphs;
-            uint32_t targetNumInactive = (numPagedLODHighRestSubgraphsToRemove < pagedLODContainer->inactiveList.count) ? (pagedLODContainer->inactiveList.count - numPagedLODHighRestSubgraphsToRemove) : 0;
+            targetNumInactive = (numPagedLODHighRestSubgraphsToRemove < pagedLODContainer->inactiveList.count) ? (pagedLODContainer->inactiveList.count - numPagedLODHighRestSubgraphsToRemove) : 0;
+        }
 
-            debug("Need to remove, inactive count = ", pagedLODContainer->inactiveList.count, ", target = ", targetNumInactive);
+        // memory that needs releasing to make room for the subgraphs about to be merged
+        uint64_t mergeCPUMemory = 0;
+        uint64_t mergeGPUMemory = 0;
+        for (auto& plod : nodes)
+        {
+            mergeCPUMemory += plod->highResCPUMemory;
+            mergeGPUMemory += plod->highResGPUMemory;
+        }
+
+        auto excess = [](uint64_t required, uint64_t budget) -> uint64_t {
+            return (budget > 0 && required > budget) ? (required - budget) : 0;
+        };
+
+        uint64_t cpuMemoryToRelease = excess(highResSubgraphsCPUMemory + mergeCPUMemory, targetMaxHighResSubgraphsCPUMemory);
+        uint64_t gpuMemoryToRelease = excess(highResSubgraphsGPUMemory + mergeGPUMemory, targetMaxHighResSubgraphsGPUMemory);
+
+        if (device && minimumAvailableDeviceMemory > 0 && device->supportsDeviceExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+        {
+            VkDeviceSize availableMemory = device->availableMemory(true);
+            if (availableMemory < minimumAvailableDeviceMemory) gpuMemoryToRelease = std::max(gpuMemoryToRelease, static_cast<uint64_t>(minimumAvailableDeviceMemory - availableMemory));
+        }
+
+        if (targetNumInactive < pagedLODContainer->inactiveList.count || cpuMemoryToRelease > 0 || gpuMemoryToRelease > 0)
+        {
+            debug("Need to remove, inactive count = ", pagedLODContainer->inactiveList.count, ", target = ", targetNumInactive, ", cpuMemoryToRelease = ", cpuMemoryToRelease, ", gpuMemoryToRelease = ", gpuMemoryToRelease);
 
-            for (uint32_t index = pagedLODContainer->inactiveList.head; (index != 0) && (pagedLODContainer->inactiveList.count > targetNumInactive);)
+            // the head of the inactiveList is the least recently visible
+            uint64_t cpuMemoryReleased = 0;
+            uint64_t gpuMemoryReleased = 0;
+            for (uint32_t index = pagedLODContainer->inactiveList.head;
+                 (index != 0) && (pagedLODContainer->inactiveList.count > targetNumInactive || cpuMemoryReleased < cpuMemoryToRelease || gpuMemoryReleased < gpuMemoryToRelease);)
             {
                 auto& element = elements[index];
                 index = element.next;
@@ -688,13 +1183,28 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
                     plod->requestCount.exchange(0);
                     plod->requestStatus.exchange(PagedLOD::NoRequest);
 
-                    deleteList.push_back(plod->pending);
+                    if (recycledSubgraphs && plod->pending)
+                    {
+                        // keep the compiled subgraph for reuse, deleting the subgraphs evicted to make room for it
+                        deleteList.splice(deleteList.end(), recycledSubgraphs->add(plod->filename, plod->pending, plod->highResGPUMemory));
+                    }
+                    else
+                    {
+                        deleteList.push_back(plod->pending);
+                    }
                     plod->pending = {};
 
+                    cpuMemoryReleased += plod->highResCPUMemory;
+                    gpuMemoryReleased += plod->highResGPUMemory;
+                    highResSubgraphsCPUMemory -= plod->highResCPUMemory;
+                    highResSubgraphsGPUMemory -= plod->highResGPUMemory;
+                    plod->highResCPUMemory = 0;
+                    plod->highResGPUMemory = 0;
+
                     deleteList.push_back(plod);
                     pagedLODContainer->remove(plod);
 
-                    if (plod->options->sharedObjects)
+                    if (plod->options && plod->options->sharedObjects)
                     {
                         if (std::find(sharedObjectsToPrune.begin(), sharedObjectsToPrune.end(), plod->options->sharedObjects) == sharedObjectsToPrune.end())
                         {
@@ -729,6 +1239,9 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
                     plod->children[0].node = plod->pending;
                 }
 
+                highResSubgraphsCPUMemory += plod->highResCPUMemory;
+                highResSubgraphsGPUMemory += plod->highResGPUMemory;
+
                 plod->requestStatus.exchange(PagedLOD::NoRequest);
             }
         }
@@ -739,5 +1252,6 @@ void DatabasePager::updateSceneGraph(ref_ptr<FrameStamp> frameStamp, CompileResu
         debug("DatabasePager::updateSceneGraph() nothing to merge");
     }
 
+    if (!deleteList.empty() && device) _deleteQueue->reclaim(device->descriptorPools.ref_ptr());
     if (!deleteList.empty() || !sharedObjectsToPrune.empty()) _deleteQueue->add_prune(deleteList, sharedObjectsToPrune);
 }
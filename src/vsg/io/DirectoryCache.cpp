@@ -0,0 +1,101 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/DirectoryCache.h>
+#include <vsg/io/FileSystem.h>
+
+#include <cwctype>
+
+using namespace vsg;
+
+namespace
+{
+    // directory entries are compared case insensitively on Windows to match its file system
+    Path::string_type normalizeEntry(const Path::string_type& entry)
+    {
+#if defined(_WIN32)
+        Path::string_type lowerCase(entry);
+        for (auto& c : lowerCase) c = static_cast<Path::value_type>(std::towlower(c));
+        return lowerCase;
+#else
+        return entry;
+#endif
+    }
+} // namespace
+
+DirectoryCache::DirectoryCache()
+{
+}
+
+bool DirectoryCache::fileExists(const Path& path)
+{
+    if (!path || trailingRelativePath(path)) return vsg::fileExists(path);
+
+    Path directory;
+    Path::string_type entry;
+    auto slash = path.find_last_of(Path::separators);
+    if (slash == Path::npos)
+    {
+        directory = ".";
+        entry = path.native();
+    }
+    else
+    {
+        directory = (slash == 0) ? path.substr(0, 1) : path.substr(0, slash);
+        entry = path.native().substr(slash + 1);
+    }
+
+    if (entry.empty()) return vsg::fileExists(path);
+
+    entry = normalizeEntry(entry);
+    auto now = clock::now();
+
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+        if (auto itr = _listings.find(directory); itr != _listings.end())
+        {
+            auto& listing = itr->second;
+            if (expiryTime < 0.0 || std::chrono::duration<double, std::chrono::seconds::period>(now - listing.timeRead).count() <= expiryTime)
+            {
+                return listing.entries.count(entry) != 0;
+            }
+        }
+    }
+
+    // read the directory without holding the mutex so other threads aren't blocked by the file system
+    Listing listing;
+    listing.timeRead = now;
+    for (auto& contents : getDirectoryContents(directory))
+    {
+        listing.entries.insert(normalizeEntry(contents.native()));
+    }
+
+    bool exists = listing.entries.count(entry) != 0;
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _listings[directory] = std::move(listing);
+
+    return exists;
+}
+
+void DirectoryCache::flush()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _listings.clear();
+}
+
+void DirectoryCache::flush(const Path& directory)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    _listings.erase(directory);
+}
@@ -10,6 +10,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/io/DirectoryCache.h>
 #include <vsg/io/FileSystem.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/Options.h>
@@ -162,20 +163,29 @@ Path vsg::findFile(const Path& filename, const Options* options)
         // if Options has a findFileCallback use it
         if (options->findFileCallback) return options->findFileCallback(filename, options);
 
+        // use the directoryCache when assigned to avoid querying the file system for each path
+        auto exists = [&options](const Path& path) { return options->directoryCache ? options->directoryCache->fileExists(path) : fileExists(path); };
+
         if (!options->paths.empty())
         {
             // if appropriate use the filename directly if it exists.
-            if (options->checkFilenameHint == Options::CHECK_ORIGINAL_FILENAME_EXISTS_FIRST && fileExists(filename)) return filename;
+            if (options->checkFilenameHint == Options::CHECK_ORIGINAL_FILENAME_EXISTS_FIRST && exists(filename)) return filename;
 
             // search for the file in the options specific paths.
-            if (auto path = findFile(filename, options->paths)) return path;
+            for (auto& path : options->paths)
+            {
+                Path fullpath = path / filename;
+                if (exists(fullpath)) return fullpath;
+            }
 
             // if appropriate use the filename directly if it exists.
-            if (options->checkFilenameHint == Options::CHECK_ORIGINAL_FILENAME_EXISTS_LAST && fileExists(filename))
+            if (options->checkFilenameHint == Options::CHECK_ORIGINAL_FILENAME_EXISTS_LAST && exists(filename))
                 return filename;
             else
                 return {};
         }
+
+        if (options->directoryCache) return exists(filename) ? filename : Path();
     }
 
     return fileExists(filename) ? filename : Path();
@@ -219,6 +229,24 @@ bool vsg::makeDirectory(const Path& path)
     return true;
 }
 
+bool vsg::renameFile(const Path& src, const Path& dst)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    return MoveFileExW(src.c_str(), dst.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return ::rename(src.c_str(), dst.c_str()) == 0;
+#endif
+}
+
+bool vsg::removeFile(const Path& path)
+{
+#if defined(_MSC_VER) || defined(__MINGW32__)
+    return _wremove(path.c_str()) == 0;
+#else
+    return ::remove(path.c_str()) == 0;
+#endif
+}
+
 Path vsg::executableFilePath()
 {
     Path path;
@@ -0,0 +1,75 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/HashOutput.h>
+
+using namespace vsg;
+
+HashOutput::HashOutput(uint64_t in_seed) :
+    value(in_seed)
+{
+}
+
+void HashOutput::write(size_t num, const long double* value_ptr)
+{
+    // long double has padding bytes with undefined contents so hash the values as doubles
+    for (; num > 0; --num, ++value_ptr)
+    {
+        double v = static_cast<double>(*value_ptr);
+        _hash(1, &v);
+    }
+}
+
+void HashOutput::write(size_t num, const std::string* value_ptr)
+{
+    for (; num > 0; --num, ++value_ptr)
+    {
+        value = hash_bytes(value_ptr->data(), value_ptr->size(), value);
+    }
+}
+
+void HashOutput::write(size_t num, const std::wstring* value_ptr)
+{
+    for (; num > 0; --num, ++value_ptr)
+    {
+        value = hash_bytes(value_ptr->data(), value_ptr->size() * sizeof(wchar_t), value);
+    }
+}
+
+void HashOutput::write(size_t num, const Path* value_ptr)
+{
+    for (; num > 0; --num, ++value_ptr)
+    {
+        auto str = value_ptr->string();
+        value = hash_bytes(str.data(), str.size(), value);
+    }
+}
+
+void HashOutput::write(const vsg::Object* object)
+{
+    if (!object)
+    {
+        value = hash_combine(value, 0);
+        return;
+    }
+
+    // objects already hashed contribute their ID rather than being hashed again
+    if (auto itr = objectIDMap.find(object); itr != objectIDMap.end())
+    {
+        value = hash_combine(value, itr->second);
+        return;
+    }
+    objectIDMap[object] = objectID++;
+
+    value = hash_combine(value, object->hash());
+}
@@ -27,6 +27,12 @@ Input::~Input()
 {
 }
 
+ref_ptr<Options> Input::sharedCopyOfOptions()
+{
+    if (!_sharedCopyOfOptions && options) _sharedCopyOfOptions = Options::create(*options);
+    return _sharedCopyOfOptions;
+}
+
 bool Input::version_less(uint32_t major, uint32_t minor, uint32_t patch, uint32_t soversion) const
 {
     return version < VsgVersion{major, minor, patch, soversion};
@@ -74,6 +74,18 @@ void JSONParser::Schema::read_null(JSONParser&, const std::string_view&)
 {
 }
 
+void JSONParser::Schema::read_number(JSONParser& parser, const std::string_view& value)
+{
+    parser.mstr.set(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+    read_number(parser, parser.mstr);
+}
+
+void JSONParser::Schema::read_number(JSONParser& parser, const std::string_view& name, const std::string_view& value)
+{
+    parser.mstr.set(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+    read_number(parser, name, parser.mstr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // JSONtoMetaDataSchema
@@ -168,6 +180,24 @@ void JSONtoMetaDataSchema::read_number(JSONParser&, const std::string_view& name
     addToObject(name, doubleValue::create(value));
 }
 
+void JSONtoMetaDataSchema::read_number(JSONParser& parser, const std::string_view& value)
+{
+    double number;
+    if (JSONParser::parse_number(value, number))
+        addToArray(doubleValue::create(number));
+    else
+        parser.warning("JSONtoMetaDataSchema unable to parse number ", value);
+}
+
+void JSONtoMetaDataSchema::read_number(JSONParser& parser, const std::string_view& name, const std::string_view& value)
+{
+    double number;
+    if (JSONParser::parse_number(value, number))
+        addToObject(name, doubleValue::create(number));
+    else
+        parser.warning("JSONtoMetaDataSchema unable to parse number ", value);
+}
+
 void JSONtoMetaDataSchema::read_bool(JSONParser&, const std::string_view& name, bool value)
 {
     addToObject(name, boolValue::create(value));
@@ -419,8 +449,7 @@ void JSONParser::read_object(JSONParser::Schema& schema)
                 }
                 else
                 {
-                    mstr.set(reinterpret_cast<const uint8_t*>(&buffer.at(pos)), end_of_value - pos + 1);
-                    schema.read_number(*this, name, mstr);
+                    schema.read_number(*this, name, std::string_view(&buffer.at(pos), end_of_value - pos + 1));
                 }
 
                 // skip to end of field
@@ -513,9 +542,7 @@ void JSONParser::read_array(JSONParser::Schema& schema)
             }
             else
             {
-                mstr.set(reinterpret_cast<const uint8_t*>(&buffer.at(pos)), end_of_value - pos + 1);
-
-                schema.read_number(*this, mstr);
+                schema.read_number(*this, std::string_view(&buffer.at(pos), end_of_value - pos + 1));
             }
 
             // skip to end of field
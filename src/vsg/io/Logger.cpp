@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Logger.h>
 #include <vsg/io/Options.h>
 
+#include <algorithm>
 #include <iostream>
 
 using namespace vsg;
@@ -343,3 +344,134 @@ void NullLogger::fatal_implementation(const std::string_view& message)
 {
     throw Exception{std::string(message)};
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// AsyncLogger
+//
+AsyncLogger::AsyncLogger(ref_ptr<Logger> in_logger, size_t queueSize) :
+    logger(in_logger ? in_logger : ref_ptr<Logger>(StdLogger::create())),
+    _entries(std::max(queueSize, size_t(1))),
+    _periodStart(std::chrono::steady_clock::now())
+{
+    level = logger->level;
+    _thread = std::thread([this]() { run(); });
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    _active = false;
+    _wakeCondition.notify_one();
+    if (_thread.joinable()) _thread.join();
+}
+
+void AsyncLogger::flush()
+{
+    auto target = _writeIndex.load(std::memory_order_acquire);
+    _wakeCondition.notify_one();
+    while (_readIndex.load(std::memory_order_acquire) < target && _thread.joinable())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    logger->flush();
+}
+
+bool AsyncLogger::push(Level msg_level, const std::string_view& message)
+{
+    auto write = _writeIndex.load(std::memory_order_relaxed);
+    if ((write - _readIndex.load(std::memory_order_acquire)) >= _entries.size())
+    {
+        ++droppedMessages;
+        return false;
+    }
+
+    // assign rather than construct so the capacity of previously used strings is reused
+    auto& entry = _entries[write % _entries.size()];
+    entry.level = msg_level;
+    entry.message.assign(message.data(), message.size());
+
+    _writeIndex.store(write + 1, std::memory_order_release);
+
+    // notify without taking _wakeMutex so the caller never blocks, a missed wake up is picked up by the background thread's timed wait
+    _wakeCondition.notify_one();
+    return true;
+}
+
+bool AsyncLogger::enqueue(Level msg_level, const std::string_view& message)
+{
+    if (rateLimitPeriod > 0.0 && maxRepeatsPerPeriod > 0)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double>(now - _periodStart).count() > rateLimitPeriod)
+        {
+            if (_suppressedMessages > 0)
+            {
+                _stream.str({});
+                _stream.clear();
+                _stream << "AsyncLogger suppressed " << _suppressedMessages << " repeated messages.";
+                push(LOGGER_WARN, _stream.str());
+            }
+
+            _repeatCounts.clear();
+            _suppressedMessages = 0;
+            _periodStart = now;
+        }
+
+        if (++_repeatCounts[std::hash<std::string_view>{}(message)] > maxRepeatsPerPeriod)
+        {
+            ++_suppressedMessages;
+            return false;
+        }
+    }
+
+    return push(msg_level, message);
+}
+
+void AsyncLogger::run()
+{
+    while (true)
+    {
+        auto read = _readIndex.load(std::memory_order_relaxed);
+        if (read == _writeIndex.load(std::memory_order_acquire))
+        {
+            if (!_active) break;
+
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _wakeCondition.wait_for(lock, std::chrono::milliseconds(100), [&]() { return !_active || read != _writeIndex.load(std::memory_order_acquire); });
+            continue;
+        }
+
+        auto& entry = _entries[read % _entries.size()];
+        logger->log(entry.level, entry.message);
+
+        _readIndex.store(read + 1, std::memory_order_release);
+    }
+}
+
+void AsyncLogger::debug_implementation(const std::string_view& message)
+{
+    enqueue(LOGGER_DEBUG, message);
+}
+
+void AsyncLogger::info_implementation(const std::string_view& message)
+{
+    enqueue(LOGGER_INFO, message);
+}
+
+void AsyncLogger::warn_implementation(const std::string_view& message)
+{
+    enqueue(LOGGER_WARN, message);
+}
+
+void AsyncLogger::error_implementation(const std::string_view& message)
+{
+    enqueue(LOGGER_ERROR, message);
+}
+
+void AsyncLogger::fatal_implementation(const std::string_view& message)
+{
+    // write out pending messages so they appear before the fatal message, then pass the fatal message on directly so any exception is thrown on the calling thread
+    flush();
+    logger->log(LOGGER_FATAL, message);
+}
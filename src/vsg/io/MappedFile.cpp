@@ -0,0 +1,132 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/Logger.h>
+#include <vsg/io/MappedFile.h>
+
+#if defined(_WIN32)
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// MappedFile
+//
+MappedFile::MappedFile(const Path& in_filename) :
+    filename(in_filename)
+{
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        warn("MappedFile::MappedFile(", filename, ") unable to open file.");
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(fileHandle);
+        return;
+    }
+
+    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mappingHandle)
+    {
+        warn("MappedFile::MappedFile(", filename, ") unable to create file mapping.");
+        CloseHandle(fileHandle);
+        return;
+    }
+
+    void* ptr = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+    if (!ptr)
+    {
+        warn("MappedFile::MappedFile(", filename, ") unable to map view of file.");
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return;
+    }
+
+    _fileHandle = fileHandle;
+    _mappingHandle = mappingHandle;
+    _data = static_cast<uint8_t*>(ptr);
+    _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        warn("MappedFile::MappedFile(", filename, ") unable to open file.");
+        return;
+    }
+
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        ::close(fd);
+        return;
+    }
+
+    // private mapping so that pages written to by the application are copied rather than written back to the file
+    size_t fileSize = static_cast<size_t>(fileStat.st_size);
+    void* ptr = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+    // the mapping remains valid after the file descriptor is closed
+    ::close(fd);
+
+    if (ptr == MAP_FAILED)
+    {
+        warn("MappedFile::MappedFile(", filename, ") unable to map file.");
+        return;
+    }
+
+    _data = static_cast<uint8_t*>(ptr);
+    _size = fileSize;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(_WIN32)
+    if (_data) UnmapViewOfFile(_data);
+    if (_mappingHandle) CloseHandle(static_cast<HANDLE>(_mappingHandle));
+    if (_fileHandle) CloseHandle(static_cast<HANDLE>(_fileHandle));
+#else
+    if (_data) ::munmap(_data, _size);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// MappedFileData
+//
+MappedFileData::MappedFileData(ref_ptr<MappedFile> in_mappedFile, size_t offset, size_t size, Properties in_properties) :
+    ubyteArray(static_cast<uint32_t>(size), in_mappedFile->data() + offset, in_properties),
+    mappedFile(in_mappedFile)
+{
+    // memory is owned by the MappedFile so must not be released by the Array
+    properties.allocatorType = ALLOCATOR_TYPE_NO_DELETE;
+}
+
+MappedFileData::~MappedFileData()
+{
+}
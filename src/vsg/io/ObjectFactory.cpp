@@ -71,6 +71,7 @@ ObjectFactory::ObjectFactory()
     // arrays
     add<vsg::byteArray>();
     add<vsg::ubyteArray>();
+    add<vsg::CompressedData>();
     add<vsg::shortArray>();
     add<vsg::ushortArray>();
     add<vsg::intArray>();
@@ -110,6 +111,8 @@ ObjectFactory::ObjectFactory()
     add<vsg::materialArray>();
     add<vsg::PhongMaterialArray>();
     add<vsg::PbrMaterialArray>();
+    add<vsg::BindlessMaterialArray>();
+    add<vsg::MeshletArray>();
     add<vsg::DrawIndirectCommandArray>();
     add<vsg::DrawIndexedIndirectCommandArray>();
 
@@ -175,11 +178,21 @@ ObjectFactory::ObjectFactory()
     add<vsg::Commands>();
     add<vsg::Group>();
     add<vsg::QuadGroup>();
+    add<vsg::ParallelGroup>();
     add<vsg::StateGroup>();
+    add<vsg::StreamingStateGroup>();
+    add<vsg::StreamedTexture>();
     add<vsg::CullGroup>();
+    add<vsg::BatchedCullGroup>();
+    add<vsg::LazyCompileGroup>();
+    add<vsg::SpatialGrid>();
+    add<vsg::PackedSubgraph>();
+    add<vsg::PackedDraws>();
     add<vsg::CullNode>();
     add<vsg::LOD>();
     add<vsg::PagedLOD>();
+    add<vsg::PointCloudTile>();
+    add<vsg::PointCloud>();
     add<vsg::AbsoluteTransform>();
     add<vsg::MatrixTransform>();
     add<vsg::CoordinateFrame>();
@@ -196,6 +209,9 @@ ObjectFactory::ObjectFactory()
     add<vsg::InstanceNode>();
     add<vsg::InstanceDraw>();
     add<vsg::InstanceDrawIndexed>();
+    add<vsg::InstanceDrawIndexedIndirect>();
+    add<vsg::InstanceCulling>();
+    add<vsg::Occluder>();
 
     // lighting
     add<vsg::Light>();
@@ -207,6 +223,7 @@ ObjectFactory::ObjectFactory()
     add<vsg::HardShadows>();
     add<vsg::SoftShadows>();
     add<vsg::PercentageCloserSoftShadows>();
+    add<vsg::RayTracedShadows>();
 
     // vulkan objects
     add<vsg::BindGraphicsPipeline>();
@@ -228,9 +245,13 @@ ObjectFactory::ObjectFactory()
     add<vsg::DepthStencilState>();
     add<vsg::ColorBlendState>();
     add<vsg::DynamicState>();
+    add<vsg::ExtendedDynamicState>();
+    add<vsg::RenderingState>();
     add<vsg::Dispatch>();
     add<vsg::BindDescriptorSets>();
     add<vsg::BindDescriptorSet>();
+    add<vsg::BindBindlessDescriptorSet>();
+    add<vsg::BindlessDescriptors>();
     add<vsg::BindVertexBuffers>();
     add<vsg::DescriptorTexelBufferView>();
     add<vsg::BindIndexBuffer>();
@@ -240,8 +261,11 @@ ObjectFactory::ObjectFactory()
     add<vsg::ViewDescriptorSetLayout>();
     add<vsg::DescriptorImage>();
     add<vsg::DescriptorBuffer>();
+    add<vsg::DynamicDescriptorBuffer>();
+    add<vsg::RingDescriptorBuffer>();
     add<vsg::Sampler>();
     add<vsg::PushConstants>();
+    add<vsg::PushDescriptorSet>();
     add<vsg::ResourceHints>();
     add<vsg::StateSwitch>();
 
@@ -259,6 +283,7 @@ ObjectFactory::ObjectFactory()
     add<vsg::ResetQueryPool>();
     add<vsg::CopyQueryPoolResults>();
     add<vsg::SetPrimitiveTopology>();
+    add<vsg::SetFragmentShadingRate>();
     add<vsg::ClearAttachments>();
 
     // text
@@ -269,6 +294,7 @@ ObjectFactory::ObjectFactory()
     add<vsg::StandardLayout>();
     add<vsg::CpuLayoutTechnique>();
     add<vsg::GpuLayoutTechnique>();
+    add<vsg::GpuLabelTechnique>();
     add<vsg::TextLayoutValue>();
 
     // ui
@@ -305,6 +331,7 @@ ObjectFactory::ObjectFactory()
     add<vsg::DrawMeshTasks>();
     add<vsg::DrawMeshTasksIndirect>();
     add<vsg::DrawMeshTasksIndirectCount>();
+    add<vsg::Meshlets>();
 
     // animation
     add<vsg::TransformKeyframes>();
@@ -329,6 +356,7 @@ ObjectFactory::ObjectFactory()
     // utils
     add<vsg::ShaderSet>();
     add<vsg::ViewDependentStateBinding>();
+    add<vsg::BindlessDescriptorSetBinding>();
     add<vsg::BillboardArrayState>();
     add<vsg::TranslationArrayState>();
     add<vsg::TranslationRotationScaleArrayState>();
@@ -336,6 +364,12 @@ ObjectFactory::ObjectFactory()
     add<vsg::DisplacementMapArrayState>();
     add<vsg::SharedObjects>();
     add<vsg::ProfileLog>();
+    add<vsg::GenerateLODs>();
+    add<vsg::CompressTextures>();
+    add<vsg::OptimizeMeshes>();
+    add<vsg::ProcessImages>();
+    add<vsg::TriangleBVH>();
+    add<vsg::InstanceBVH>();
 
     // application
     add<vsg::EllipsoidModel>();
@@ -357,3 +391,13 @@ vsg::ref_ptr<vsg::Object> ObjectFactory::create(const std::string& className)
 
     return vsg::ref_ptr<vsg::Object>();
 }
+
+ObjectFactory::CreateFunction ObjectFactory::getCreateFunction(const std::string& className)
+{
+    if (auto itr = _createMap.find(className); itr != _createMap.end())
+    {
+        return itr->second;
+    }
+
+    return [this, className]() { return create(className); };
+}
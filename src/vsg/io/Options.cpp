@@ -10,12 +10,17 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/io/DirectoryCache.h>
 #include <vsg/io/Options.h>
 #include <vsg/io/ReaderWriter.h>
 #include <vsg/state/DescriptorSetLayout.h>
 #include <vsg/threading/OperationThreads.h>
 #include <vsg/utils/CommandLine.h>
+#include <vsg/utils/CompressTextures.h>
 #include <vsg/utils/FindDynamicObjects.h>
+#include <vsg/utils/GenerateLODs.h>
+#include <vsg/utils/OptimizeMeshes.h>
+#include <vsg/utils/ProcessImages.h>
 #include <vsg/utils/PropagateDynamicObjects.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/utils/SharedObjects.h>
@@ -44,6 +49,7 @@ Options::Options(const Options& options, const CopyOp& copyop) :
     checkFilenameHint(options.checkFilenameHint),
     paths(options.paths),
     findFileCallback(options.findFileCallback),
+    directoryCache(options.directoryCache),
     fileCache(options.fileCache),
     extensionHint(options.extensionHint),
     mapRGBtoRGBAHint(options.mapRGBtoRGBAHint),
@@ -54,7 +60,12 @@ Options::Options(const Options& options, const CopyOp& copyop) :
     instrumentation(options.instrumentation),
     findDynamicObjects(options.findDynamicObjects),
     propagateDynamicObjects(options.propagateDynamicObjects),
-    instanceNodeHint(options.instanceNodeHint)
+    generateLODs(options.generateLODs),
+    compressTextures(options.compressTextures),
+    optimizeMeshes(options.optimizeMeshes),
+    processImages(options.processImages),
+    instanceNodeHint(options.instanceNodeHint),
+    lazyExternalHint(options.lazyExternalHint)
 {
     getOrCreateAuxiliary();
     // copy any meta data.
@@ -176,6 +187,34 @@ bool Options::readOptions(CommandLine& arguments)
     if (arguments.read("--file-cache", fileCache)) optionsRead = true;
     if (arguments.read("--extension-hint", extensionHint)) optionsRead = true;
 
+    if (uint32_t numLevels = 0; arguments.read("--generate-lods", numLevels))
+    {
+        generateLODs = GenerateLODs::create();
+        generateLODs->numLevels = numLevels;
+        optionsRead = true;
+    }
+
+    if (arguments.read("--compress-textures"))
+    {
+        compressTextures = CompressTextures::create();
+        optionsRead = true;
+    }
+
+    if (arguments.read("--optimize-meshes"))
+    {
+        optimizeMeshes = OptimizeMeshes::create();
+        optimizeMeshes->reduceOverdraw = arguments.read("--reduce-overdraw");
+        optionsRead = true;
+    }
+
+    if (arguments.read("--process-images"))
+    {
+        processImages = ProcessImages::create();
+        processImages->premultiplyAlpha = arguments.read("--premultiply-alpha");
+        processImages->generateMipmaps = arguments.read("--generate-mipmaps");
+        optionsRead = true;
+    }
+
     return optionsRead;
 }
 
@@ -0,0 +1,277 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/FileSystem.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/StreamingWriter.h>
+#include <vsg/io/VSG.h>
+#include <vsg/io/write.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/threading/Latch.h>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace vsg;
+
+namespace
+{
+    // collect the PagedLOD with a resident high resolution child, without traversing into the high resolution children as they are written to their own files.
+    struct CollectPagedLODs : public Visitor
+    {
+        std::vector<ref_ptr<PagedLOD>> pagedLODs;
+
+        void apply(Node& node) override
+        {
+            node.traverse(*this);
+        }
+
+        void apply(PagedLOD& plod) override
+        {
+            if (plod.children[0].node && plod.filename) pagedLODs.emplace_back(&plod);
+            if (plod.children[1].node) plod.children[1].node->accept(*this);
+        }
+    };
+
+    VsgVersion parseVersion(const std::string& version_string)
+    {
+        VsgVersion version{0, 0, 0, 0};
+
+        std::string str = version_string;
+        for (auto& c : str)
+        {
+            if (c == '.') c = ' ';
+        }
+
+        std::stringstream sstr(str);
+        sstr >> version.major >> version.minor >> version.patch >> version.soversion;
+        return version;
+    }
+} // namespace
+
+StreamingWriter::StreamingWriter(ref_ptr<const Options> in_options) :
+    options(in_options)
+{
+    if (options) operationThreads = options->operationThreads;
+}
+
+StreamingWriter::~StreamingWriter()
+{
+    close();
+}
+
+bool StreamingWriter::open(const Path& filename, ref_ptr<const Group> root, const Objects::Children& sharedObjects)
+{
+    if (_output)
+    {
+        warn("StreamingWriter::open(", filename, ") already writing to ", _filename);
+        return false;
+    }
+
+    if (lowerCaseFileExtension(filename) != ".vsgb")
+    {
+        warn("StreamingWriter::open(", filename, ") only .vsgb files are supported.");
+        return false;
+    }
+
+    auto version = vsgGetVersion();
+    if (std::string version_string; options && options->getValue("version", version_string)) version = parseVersion(version_string);
+
+    if (version.major < 1 || (version.major == 1 && (version.minor < 1 || (version.minor == 1 && version.patch < 18))))
+    {
+        warn("StreamingWriter::open(", filename, ") requires version 1.1.18 or later.");
+        return false;
+    }
+
+    if (auto directory = filePath(filename)) makeDirectory(directory);
+
+    _fout.open(filename, std::ios::out | std::ios::binary);
+    if (!_fout)
+    {
+        warn("StreamingWriter::open(", filename, ") unable to open file.");
+        return false;
+    }
+
+    _filename = filename;
+    _numChildren = 0;
+    _sharedObjects = sharedObjects;
+
+    VSG::create()->writeHeader(_fout, VSG::FormatInfo{VSG::BINARY, version});
+
+    _output.reset(new BinaryOutput(_fout, options));
+    auto& output = *_output;
+    output.version = version;
+    if (uint32_t alignment = 0; options && options->getValue("payload_alignment", alignment)) output.payloadAlignment = alignment;
+    if (std::string compression; options && options->getValue("compression", compression))
+    {
+        output.compression = compressionMethod(compression);
+        if (!compressionSupported(output.compression))
+        {
+            warn("StreamingWriter::open() compression \"", compression, "\" not supported by this build, writing payloads uncompressed.");
+            output.compression = COMPRESSION_NONE;
+        }
+    }
+    if (int level = 0; options && options->getValue("compression_level", level)) output.compressionLevel = level;
+    if (uint32_t threshold = 0; options && options->getValue("compression_threshold", threshold)) output.compressionThreshold = threshold;
+
+    // an object ID of 0 marks the start of a chunked group, see BinaryOutput::writeChunks(..)
+    uint32_t marker = 0;
+    output._write(1, &marker);
+
+    // write the root group without its children
+    auto shell = root ? Group::create(*root) : Group::create();
+    shell->children.clear();
+    output.write(shell.get());
+
+    uint32_t numSharedObjects = static_cast<uint32_t>(_sharedObjects.size());
+    output._write(1, &numSharedObjects);
+    for (auto& object : _sharedObjects)
+    {
+        output.write(object.get());
+    }
+
+    // placeholder for the number of chunks that is filled in by close()
+    _numChildrenPosition = _fout.tellp();
+    output._write(1, &_numChildren);
+
+    return _fout.good();
+}
+
+bool StreamingWriter::write(ref_ptr<Node> child)
+{
+    if (!_output) return false;
+
+    if (writePagedLODChildren && child) writePagedLODs(child, filePath(_filename));
+
+    std::ostringstream chunkStream(std::ios::out | std::ios::binary);
+
+    BinaryOutput chunkOutput(chunkStream, options);
+    chunkOutput.continueFrom(*_output);
+
+    auto position = _fout.tellp();
+    if (position >= 0) chunkOutput.streamOffset = position + static_cast<std::streamoff>(sizeof(uint64_t));
+
+    chunkOutput.write(child.get());
+
+    auto chunk = chunkStream.str();
+    uint64_t size = chunk.size();
+    _output->_write(1, &size);
+    _fout.write(chunk.data(), chunk.size());
+
+    ++_numChildren;
+
+    return _fout.good();
+}
+
+bool StreamingWriter::_writePagedLOD(PagedLOD& plod, const Path& directory)
+{
+    auto highres = plod.children[0].node;
+    auto filename = directory ? (directory / plod.filename).lexically_normal() : plod.filename;
+
+    // the nested PagedLOD filenames are relative to the file they are referenced from
+    bool result = writePagedLODs(highres, filePath(filename));
+
+    if (auto fileDirectory = filePath(filename)) makeDirectory(fileDirectory);
+
+    if (vsg::write(highres, filename, options))
+    {
+        plod.children[0].node = {};
+    }
+    else
+    {
+        warn("StreamingWriter unable to write PagedLOD child to ", filename);
+        result = false;
+    }
+
+    return result;
+}
+
+bool StreamingWriter::writePagedLODs(ref_ptr<Node> node, const Path& directory)
+{
+    if (!node) return true;
+
+    CollectPagedLODs collect;
+    node->accept(collect);
+
+    auto& pagedLODs = collect.pagedLODs;
+    if (pagedLODs.empty()) return true;
+
+    std::vector<char> results(pagedLODs.size(), 1);
+    auto writePagedLOD = [&](size_t i) {
+        results[i] = _writePagedLOD(*pagedLODs[i], directory) ? 1 : 0;
+    };
+
+    if (operationThreads && pagedLODs.size() > 1)
+    {
+        struct WritePagedLODOperation : public Operation
+        {
+            WritePagedLODOperation(std::function<void(size_t)>& in_writePagedLOD, size_t in_index, ref_ptr<Latch> in_latch) :
+                writePagedLOD(in_writePagedLOD),
+                index(in_index),
+                latch(in_latch) {}
+
+            void run() override
+            {
+                writePagedLOD(index);
+                latch->count_down();
+            }
+
+            std::function<void(size_t)>& writePagedLOD;
+            size_t index;
+            ref_ptr<Latch> latch;
+        };
+
+        std::function<void(size_t)> writePagedLODFunction(writePagedLOD);
+
+        // use latch to synchronize this thread with the writing threads
+        auto latch = Latch::create(static_cast<int>(pagedLODs.size()));
+
+        for (size_t i = 0; i < pagedLODs.size(); ++i)
+        {
+            operationThreads->add(ref_ptr<Operation>(new WritePagedLODOperation(writePagedLODFunction, i, latch)));
+        }
+
+        // use this thread to write PagedLOD children as well
+        operationThreads->run();
+
+        // wait till all the PagedLOD children have been written
+        latch->wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < pagedLODs.size(); ++i)
+        {
+            writePagedLOD(i);
+        }
+    }
+
+    return std::find(results.begin(), results.end(), 0) == results.end();
+}
+
+bool StreamingWriter::close()
+{
+    if (!_output) return false;
+
+    // fill in the number of chunks now that all the children have been written
+    auto end = _fout.tellp();
+    _fout.seekp(_numChildrenPosition);
+    _output->_write(1, &_numChildren);
+    _fout.seekp(end);
+
+    _output.reset();
+    _sharedObjects.clear();
+
+    bool result = _fout.good();
+    _fout.close();
+    return result;
+}
@@ -16,11 +16,43 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/BinaryInput.h>
 #include <vsg/io/BinaryOutput.h>
 #include <vsg/io/Logger.h>
+#include <vsg/io/MappedFile.h>
 #include <vsg/io/VSG.h>
 #include <vsg/io/mem_stream.h>
+#include <vsg/nodes/Group.h>
 
 using namespace vsg;
 
+namespace
+{
+    // write root Group's children as independently decodable chunks when requested via the "chunked" option, otherwise write the object as is.
+    void writeBinary(BinaryOutput& output, const Object* object, const Options* options)
+    {
+        if (std::string compression; options && options->getValue("compression", compression))
+        {
+            output.compression = compressionMethod(compression);
+            if (!compressionSupported(output.compression))
+            {
+                warn("VSG::write() compression \"", compression, "\" not supported by this build, writing payloads uncompressed.");
+                output.compression = COMPRESSION_NONE;
+            }
+        }
+        if (int level = 0; options && options->getValue("compression_level", level)) output.compressionLevel = level;
+        if (uint32_t threshold = 0; options && options->getValue("compression_threshold", threshold)) output.compressionThreshold = threshold;
+
+        bool chunked = false;
+        auto group = dynamic_cast<const Group*>(object);
+        if (group && group->type_info() == typeid(Group) && group->children.size() > 1 && options && options->getValue("chunked", chunked) && chunked && output.version_greater_equal(1, 1, 18))
+        {
+            output.writeChunks(group);
+        }
+        else
+        {
+            output.writeObject("Root", object);
+        }
+    }
+} // namespace
+
 // use a static handle that is initialized once at start up to avoid multi-threaded issues associated with calling std::locale::classic().
 auto s_class_locale = std::locale::classic();
 
@@ -100,6 +132,28 @@ vsg::ref_ptr<vsg::Object> VSG::read(const vsg::Path& filename, ref_ptr<const Opt
     vsg::Path filenameToUse = findFile(filename, options);
     if (!filenameToUse) return {};
 
+    bool memoryMap = false;
+    if (options && options->getValue("memory_map", memoryMap) && memoryMap && lowerCaseFileExtension(filenameToUse) == ".vsgb")
+    {
+        auto mappedFile = MappedFile::create(filenameToUse);
+        if (mappedFile->valid())
+        {
+            mem_stream fin(mappedFile->data(), mappedFile->size());
+
+            auto [type, version] = readHeader(fin);
+            if (type == BINARY)
+            {
+                vsg::BinaryInput input(fin, _objectFactory, options);
+                input.filename = filenameToUse;
+                input.version = version;
+                input.mappedFile = mappedFile;
+                uint32_t threshold = 0;
+                if (options->getValue("memory_map_threshold", threshold)) input.mappedPayloadThreshold = threshold;
+                return input.readObject("Root");
+            }
+        }
+    }
+
     std::ifstream fin(filenameToUse, std::ios::in | std::ios::binary);
     if (!fin) return {};
 
@@ -153,6 +207,27 @@ vsg::ref_ptr<vsg::Object> VSG::read(const uint8_t* ptr, size_t size, vsg::ref_pt
     if (options && !compatibleExtension(options, ".vsgb", ".vsgt")) return {};
 
     mem_stream fin(ptr, size);
+
+    // when the memory block lies within a MappedFile, such as an Archive entry, array payloads can reference the mapped memory directly rather than being copied.
+    ref_ptr<const MappedFile> mappedFile;
+    if (options) mappedFile = options->getRefObject<MappedFile>("mapped_file");
+    if (mappedFile && mappedFile->valid() && ptr >= mappedFile->data() && size <= mappedFile->size() && static_cast<size_t>(ptr - mappedFile->data()) <= (mappedFile->size() - size))
+    {
+        auto [type, version] = readHeader(fin);
+        if (type == BINARY)
+        {
+            vsg::BinaryInput input(fin, _objectFactory, options);
+            input.version = version;
+            input.mappedFile = const_cast<MappedFile*>(mappedFile.get());
+            input.mappedFileOffset = static_cast<size_t>(ptr - mappedFile->data());
+            uint32_t threshold = 0;
+            if (options->getValue("memory_map_threshold", threshold)) input.mappedPayloadThreshold = threshold;
+            return input.readObject("Root");
+        }
+        fin.clear();
+        fin.seekg(0);
+    }
+
     return read(fin, options);
 }
 
@@ -179,7 +254,8 @@ bool VSG::write(const vsg::Object* object, const vsg::Path& filename, ref_ptr<co
 
         vsg::BinaryOutput output(fout, options);
         output.version = version;
-        output.writeObject("Root", object);
+        if (uint32_t alignment = 0; options && options->getValue("payload_alignment", alignment)) output.payloadAlignment = alignment;
+        writeBinary(output, object, options);
         return true;
     }
     else if (ext == ".vsga" || ext == ".vsgt")
@@ -233,7 +309,8 @@ bool VSG::write(const vsg::Object* object, std::ostream& fout, ref_ptr<const Opt
 
         vsg::BinaryOutput output(fout, options);
         output.version = version;
-        output.writeObject("Root", object);
+        if (uint32_t alignment = 0; options && options->getValue("payload_alignment", alignment)) output.payloadAlignment = alignment;
+        writeBinary(output, object, options);
         return true;
     }
 }
@@ -242,5 +319,17 @@ bool VSG::getFeatures(Features& features) const
 {
     features.extensionFeatureMap[".vsgb"] = static_cast<FeatureMask>(READ_FILENAME | READ_ISTREAM | READ_MEMORY | WRITE_FILENAME | WRITE_OSTREAM);
     features.extensionFeatureMap[".vsgt"] = static_cast<FeatureMask>(READ_FILENAME | READ_ISTREAM | READ_MEMORY | WRITE_FILENAME | WRITE_OSTREAM);
+
+    // memory map .vsgb files when reading from filename, arrays larger than memory_map_threshold bytes then reference the mapped file rather than being copied.
+    features.optionNameTypeMap["memory_map"] = type_name<bool>();
+    features.optionNameTypeMap["memory_map_threshold"] = type_name<uint32_t>();
+    // alignment of array payloads in .vsgb files, defaults to 16
+    features.optionNameTypeMap["payload_alignment"] = type_name<uint32_t>();
+    // write a root Group's children as independent chunks in .vsgb files so they can be decoded in parallel using Options::operationThreads
+    features.optionNameTypeMap["chunked"] = type_name<bool>();
+    // compress array payloads of compression_threshold bytes or more in .vsgb files, "none", "lz4" or "zstd", with compression_level of 0 selecting the method's default
+    features.optionNameTypeMap["compression"] = type_name<std::string>();
+    features.optionNameTypeMap["compression_level"] = type_name<int>();
+    features.optionNameTypeMap["compression_threshold"] = type_name<uint32_t>();
     return true;
 }
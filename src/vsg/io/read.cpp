@@ -18,7 +18,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/tile.h>
 #include <vsg/io/txt.h>
 #include <vsg/threading/OperationThreads.h>
+#include <vsg/utils/CompressTextures.h>
 #include <vsg/utils/FindDynamicObjects.h>
+#include <vsg/utils/GenerateLODs.h>
+#include <vsg/utils/OptimizeMeshes.h>
+#include <vsg/utils/ProcessImages.h>
 #include <vsg/utils/PropagateDynamicObjects.h>
 #include <vsg/utils/SharedObjects.h>
 
@@ -28,7 +32,7 @@ ref_ptr<Object> vsg::read(const Path& filename, ref_ptr<const Options> options)
 {
     CPU_INSTRUMENTATION_L1_NC(options ? options->instrumentation.get() : nullptr, "read", COLOR_READ);
 
-    auto read_file = [&]() -> ref_ptr<Object> {
+    auto read_object = [&]() -> ref_ptr<Object> {
         if (options && !options->readerWriters.empty())
         {
             for (auto& readerWriter : options->readerWriters)
@@ -73,10 +77,37 @@ ref_ptr<Object> vsg::read(const Path& filename, ref_ptr<const Options> options)
         }
     };
 
+    auto read_file = [&]() -> ref_ptr<Object> {
+        auto object = read_object();
+        if (object && options && options->generateLODs)
+        {
+            if (auto node = object.cast<Node>()) object = options->generateLODs->generate(node);
+        }
+        if (object && options && options->optimizeMeshes) options->optimizeMeshes->apply(*object);
+        if (object && options && options->compressTextures) options->compressTextures->apply(*object);
+        if (object && options && options->processImages) options->processImages->apply(*object);
+        return object;
+    };
+
     if (options && options->sharedObjects && options->sharedObjects->suitable(filename))
     {
         auto loadedObject = LoadedObject::create(filename, options);
 
+        // if another thread is already reading this file wait for it to complete so the file is only loaded once
+        struct PendingLoad
+        {
+            PendingLoad(SharedObjects* in_sharedObjects, ref_ptr<Object> in_loadedObject) :
+                sharedObjects(in_sharedObjects),
+                loadedObject(in_loadedObject)
+            {
+                sharedObjects->beginLoad(loadedObject);
+            }
+            ~PendingLoad() { sharedObjects->endLoad(loadedObject); }
+
+            SharedObjects* sharedObjects;
+            ref_ptr<Object> loadedObject;
+        } pendingLoad(options->sharedObjects.get(), loadedObject);
+
         options->sharedObjects->share(loadedObject, [&](auto load) {
             load->object = read_file();
 
@@ -101,6 +132,7 @@ ref_ptr<Object> vsg::read(const Path& filename, ref_ptr<const Options> options)
         {
             vsg::CopyOp copyop;
             auto duplicate = copyop.duplicate = new vsg::Duplicate;
+            copyop.copyOnWriteData = options->sharedObjects->copyOnWriteData;
             for (auto& object : loadedObject->dynamicObjects)
             {
                 duplicate->insert(object);
@@ -217,6 +249,37 @@ ref_ptr<Object> vsg::read(const uint8_t* ptr, size_t size, ref_ptr<const Options
             auto object = readerWriter->read(ptr, size, options);
             if (object) return object;
         }
+        return {};
+    }
+
+    // without ReaderWriters fall back to the built in formats, using the extensionHint to select the ReaderWriter.
+    if (!options || !options->extensionHint) return {};
+
+    const auto& ext = options->extensionHint;
+    if (ext == ".vsga" || ext == ".vsgt" || ext == ".vsgb")
+    {
+        VSG rw;
+        return rw.read(ptr, size, options);
+    }
+    else if (ext == ".spv")
+    {
+        spirv rw;
+        return rw.read(ptr, size, options);
+    }
+    else if (ext == ".json")
+    {
+        json rw;
+        return rw.read(ptr, size, options);
+    }
+    else if (glsl::extensionSupported(ext))
+    {
+        glsl rw;
+        return rw.read(ptr, size, options);
+    }
+    else if (txt::extensionSupported(ext))
+    {
+        txt rw;
+        return rw.read(ptr, size, options);
     }
 
     return {};
@@ -34,6 +34,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/utils/CoordinateSpace.h>
 #include <vsg/vk/ResourceRequirements.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 tile::tile(ref_ptr<TileDatabaseSettings> in_settings, ref_ptr<const Options> in_options) :
@@ -149,6 +151,28 @@ vsg::ref_ptr<vsg::Object> tile::read_root(vsg::ref_ptr<const vsg::Options> optio
     auto group = createRoot();
 
     uint32_t lod = 0;
+
+    // share one copy of the options between all the PagedLOD created
+    auto plodOptions = Options::create_if(options, *options);
+
+    // read all the root tile layers together so they are loaded in parallel when Options::operationThreads are assigned
+    vsg::Paths tiles;
+    for (uint32_t y = 0; y < settings->noY; ++y)
+    {
+        for (uint32_t x = 0; x < settings->noX; ++x)
+        {
+            if (settings->imageLayer) tiles.push_back(getTilePath(settings->imageLayer, x, y, lod));
+            if (settings->detailLayer) tiles.push_back(getTilePath(settings->detailLayer, x, y, lod));
+            if (settings->elevationLayer) tiles.push_back(getTilePath(settings->elevationLayer, x, y, lod));
+        }
+    }
+
+    auto pathObjects = readTiles(tiles, options);
+    auto readLayer = [&pathObjects](const vsg::Path& tilePath) -> ref_ptr<Data> {
+        auto itr = pathObjects.find(tilePath);
+        return (itr != pathObjects.end()) ? itr->second.cast<Data>() : ref_ptr<Data>();
+    };
+
     for (uint32_t y = 0; y < settings->noY; ++y)
     {
         for (uint32_t x = 0; x < settings->noX; ++x)
@@ -158,7 +182,7 @@ vsg::ref_ptr<vsg::Object> tile::read_root(vsg::ref_ptr<const vsg::Options> optio
             if (settings->imageLayer)
             {
                 auto imagePath = getTilePath(settings->imageLayer, x, y, lod);
-                imageData = vsg::read_cast<vsg::Data>(imagePath, options);
+                imageData = readLayer(imagePath);
                 if (imageData && settings->imageLayerCallback)
                 {
                     imageData = settings->imageLayerCallback(imageData);
@@ -172,7 +196,7 @@ vsg::ref_ptr<vsg::Object> tile::read_root(vsg::ref_ptr<const vsg::Options> optio
             if (settings->detailLayer)
             {
                 auto detailPath = getTilePath(settings->detailLayer, x, y, lod);
-                detailData = vsg::read_cast<vsg::Data>(detailPath, options);
+                detailData = readLayer(detailPath);
                 if (detailData && settings->detailLayerCallback)
                 {
                     detailData = settings->detailLayerCallback(detailData);
@@ -186,7 +210,7 @@ vsg::ref_ptr<vsg::Object> tile::read_root(vsg::ref_ptr<const vsg::Options> optio
             if (settings->elevationLayer)
             {
                 auto terrainPath = getTilePath(settings->elevationLayer, x, y, lod);
-                elevationData = vsg::read_cast<vsg::Data>(terrainPath, options);
+                elevationData = readLayer(terrainPath);
                 if (elevationData && settings->elevationLayerCallback)
                 {
                     elevationData = settings->elevationLayerCallback(elevationData);
@@ -201,6 +225,11 @@ vsg::ref_ptr<vsg::Object> tile::read_root(vsg::ref_ptr<const vsg::Options> optio
             auto tile_node = createTile(tile_extents, imageData, detailData, elevationData);
             if (tile_node)
             {
+                if (elevationData && settings->terrainHeightCache && settings->ellipsoidModel)
+                {
+                    settings->terrainHeightCache->insert(tile_extents, lod, *elevationData, settings->elevationScale);
+                }
+
                 vsg::ComputeBounds computeBound;
                 tile_node->accept(computeBound);
                 const auto& bb = computeBound.bounds;
@@ -211,7 +240,7 @@ vsg::ref_ptr<vsg::Object> tile::read_root(vsg::ref_ptr<const vsg::Options> optio
                 plod->children[0] = vsg::PagedLOD::Child{0.25, {}};       // external child visible when its bound occupies more than 1/4 of the height of the window
                 plod->children[1] = vsg::PagedLOD::Child{0.0, tile_node}; // visible always
                 plod->filename = vsg::make_string(x, " ", y, " 0.tile");
-                plod->options = Options::create_if(options, *options);
+                plod->options = plodOptions;
 
                 group->addChild(plod);
             }
@@ -330,7 +359,7 @@ vsg::ref_ptr<vsg::Object> tile::read_subtile(uint32_t x, uint32_t y, uint32_t lo
         }
     }
 
-    auto pathObjects = vsg::read(tiles, options);
+    auto pathObjects = readTiles(tiles, options);
 
     struct TileData
     {
@@ -368,17 +397,94 @@ vsg::ref_ptr<vsg::Object> tile::read_subtile(uint32_t x, uint32_t y, uint32_t lo
         return ReadError::create("vsg::tile::read_subtile(..) could not load any subtiles.");
     }
 
+    struct Subtile
+    {
+        TileID tileID;
+        TileData tileData;
+        ref_ptr<Node> tile_node;
+        dsphere bound;
+    };
+
+    std::vector<Subtile> subtiles;
+    subtiles.reserve(tileData.size());
     for (auto& [tileID, entry] : tileData)
     {
-        auto tile_extents = computeTileExtents(tileID.local_x, tileID.local_y, local_lod);
-        auto tile_node = createTile(tile_extents, entry.imageData, entry.detailData, entry.elevationData);
-        if (tile_node)
+        subtiles.push_back(Subtile{tileID, entry, {}, {}});
+    }
+
+    std::function<void(size_t)> createSubtile = [&](size_t i) {
+        auto& subtile = subtiles[i];
+        auto tile_extents = computeTileExtents(subtile.tileID.local_x, subtile.tileID.local_y, local_lod);
+        subtile.tile_node = createTile(tile_extents, subtile.tileData.imageData, subtile.tileData.detailData, subtile.tileData.elevationData);
+        if (subtile.tile_node)
         {
+            if (subtile.tileData.elevationData && settings->terrainHeightCache && settings->ellipsoidModel)
+            {
+                settings->terrainHeightCache->insert(tile_extents, local_lod, *subtile.tileData.elevationData, settings->elevationScale);
+            }
+
             vsg::ComputeBounds computeBound;
-            tile_node->accept(computeBound);
+            subtile.tile_node->accept(computeBound);
             const auto& bb = computeBound.bounds;
-            vsg::dsphere bound((bb.min.x + bb.max.x) * 0.5, (bb.min.y + bb.max.y) * 0.5, (bb.min.z + bb.max.z) * 0.5, vsg::length(bb.max - bb.min) * 0.5);
+            subtile.bound.set((bb.min + bb.max) * 0.5, vsg::length(bb.max - bb.min) * 0.5);
+        }
+    };
+
+    ref_ptr<OperationThreads> operationThreads;
+    if (options) operationThreads = options->operationThreads;
+
+    if (operationThreads && subtiles.size() > 1)
+    {
+        struct CreateSubtileOperation : public Operation
+        {
+            CreateSubtileOperation(std::function<void(size_t)>& in_createSubtile, size_t in_index, ref_ptr<Latch> in_latch) :
+                createSubtile(in_createSubtile),
+                index(in_index),
+                latch(in_latch) {}
+
+            void run() override
+            {
+                createSubtile(index);
+                latch->count_down();
+            }
+
+            std::function<void(size_t)>& createSubtile;
+            size_t index;
+            ref_ptr<Latch> latch;
+        };
+
+        // use latch to synchronize this thread with the subtile creation threads
+        auto latch = Latch::create(static_cast<int>(subtiles.size()));
+
+        for (size_t i = 0; i < subtiles.size(); ++i)
+        {
+            operationThreads->add(ref_ptr<Operation>(new CreateSubtileOperation(createSubtile, i, latch)));
+        }
+
+        // use this thread to create subtiles as well
+        operationThreads->run();
+
+        // wait till all the subtiles have been created
+        latch->wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < subtiles.size(); ++i)
+        {
+            createSubtile(i);
+        }
+    }
+
+    // share one copy of the options between all the PagedLOD created
+    auto plodOptions = Options::create_if(options, *options);
 
+    for (auto& subtile : subtiles)
+    {
+        const auto& tileID = subtile.tileID;
+        const auto& tile_node = subtile.tile_node;
+        const auto& bound = subtile.bound;
+        if (tile_node)
+        {
             if (local_lod < settings->maxLevel)
             {
                 auto plod = vsg::PagedLOD::create();
@@ -386,7 +492,7 @@ vsg::ref_ptr<vsg::Object> tile::read_subtile(uint32_t x, uint32_t y, uint32_t lo
                 plod->children[0] = vsg::PagedLOD::Child{settings->lodTransitionScreenHeightRatio, {}}; // external child visible when its bound occupies more than 1/4 of the height of the window
                 plod->children[1] = vsg::PagedLOD::Child{0.0, tile_node};                               // visible always
                 plod->filename = vsg::make_string(tileID.local_x, " ", tileID.local_y, " ", local_lod, ".tile");
-                plod->options = Options::create_if(options, *options);
+                plod->options = plodOptions;
 
                 group->addChild(plod);
             }
@@ -421,6 +527,74 @@ vsg::ref_ptr<vsg::Object> tile::read_subtile(uint32_t x, uint32_t y, uint32_t lo
     return group;
 }
 
+bool tile::TileCache::get(const Path& path, ref_ptr<Data>& data)
+{
+    auto itr = lookup.find(path);
+    if (itr == lookup.end()) return false;
+
+    // move to the front as the most recently used entry
+    entries.splice(entries.begin(), entries, itr->second);
+    data = itr->second->second;
+    return true;
+}
+
+void tile::TileCache::insert(const Path& path, ref_ptr<Data> data, size_t maxSize)
+{
+    if (maxSize == 0) return;
+
+    if (auto itr = lookup.find(path); itr != lookup.end())
+    {
+        itr->second->second = data;
+        entries.splice(entries.begin(), entries, itr->second);
+        return;
+    }
+
+    entries.emplace_front(path, data);
+    lookup[path] = entries.begin();
+
+    while (entries.size() > maxSize)
+    {
+        lookup.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+vsg::PathObjects tile::readTiles(const vsg::Paths& tiles, vsg::ref_ptr<const vsg::Options> options) const
+{
+    if (settings->maxCachedTiles == 0 && settings->maxMissingTiles == 0) return vsg::read(tiles, options);
+
+    vsg::PathObjects pathObjects;
+    vsg::Paths tilesToRead;
+    {
+        std::scoped_lock<std::mutex> lock(_tileCacheMutex);
+        for (auto& tilePath : tiles)
+        {
+            ref_ptr<Data> data;
+            if (_dataCache.get(tilePath, data))
+                pathObjects[tilePath] = data;
+            else if (!_missingCache.get(tilePath, data))
+                tilesToRead.push_back(tilePath);
+        }
+    }
+
+    if (tilesToRead.empty()) return pathObjects;
+
+    auto readObjects = vsg::read(tilesToRead, options);
+
+    std::scoped_lock<std::mutex> lock(_tileCacheMutex);
+    for (auto& [tilePath, object] : readObjects)
+    {
+        if (auto data = object.cast<Data>())
+            _dataCache.insert(tilePath, data, settings->maxCachedTiles);
+        else
+            _missingCache.insert(tilePath, {}, settings->maxMissingTiles);
+
+        pathObjects[tilePath] = object;
+    }
+
+    return pathObjects;
+}
+
 void tile::init(vsg::ref_ptr<const vsg::Options> options)
 {
     CPU_INSTRUMENTATION_L2_NC(options ? options->instrumentation.get() : nullptr, "tile init", COLOR_READ);
@@ -437,6 +611,17 @@ void tile::init(vsg::ref_ptr<const vsg::Options> options)
             _shaderSet = createFlatShadedShaderSet(options);
     }
 
+    if (settings->tessellation && settings->ellipsoidModel)
+    {
+        _shaderSet = createTessellatedTerrainShaderSet(_shaderSet, settings->tessellationPixelsPerEdge);
+    }
+
+    if (auto& terrainHeightCache = settings->terrainHeightCache)
+    {
+        terrainHeightCache->projection = settings->projection;
+        if (!terrainHeightCache->ellipsoidModel) terrainHeightCache->ellipsoidModel = settings->ellipsoidModel;
+    }
+
     _sampler = vsg::Sampler::create();
     _sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
     _sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
@@ -595,6 +780,161 @@ vsg::ref_ptr<vsg::Node> tile::createTile(const vsg::dbox& tile_extents, ref_ptr<
     }
 }
 
+namespace
+{
+    template<class A>
+    ref_ptr<Data> createGridIndices(uint32_t numRows, uint32_t numCols, bool skirt, uint32_t numTriangles)
+    {
+        using index_type = typename A::value_type;
+
+        auto indices = A::create(numTriangles * 3);
+        auto itr = indices->begin();
+        auto add = [&itr](uint32_t i) { (*itr++) = static_cast<index_type>(i); };
+
+        for (uint32_t r = 0; r < numRows - 1; ++r)
+        {
+            for (uint32_t c = 0; c < numCols - 1; ++c)
+            {
+                uint32_t vi = c + r * numCols;
+                add(vi);
+                add(vi + 1);
+                add(vi + numCols);
+                add(vi + numCols);
+                add(vi + 1);
+                add(vi + numCols + 1);
+            }
+        }
+
+        if (!skirt) return indices;
+
+        // skirt vertices follow the grid vertices, bottom row, top row, left column then right column.
+        uint32_t skirt_bottom_row = numRows * numCols;
+        uint32_t skirt_top_row = skirt_bottom_row + numCols;
+        uint32_t skirt_left_column = skirt_top_row + numCols;
+        uint32_t skirt_right_column = skirt_left_column + numRows;
+
+        // row[0]
+        for (uint32_t c = 0; c < numCols - 1; ++c)
+        {
+            uint32_t tile_i = c;
+            uint32_t skirt_i = skirt_bottom_row + c;
+            add(tile_i);
+            add(skirt_i);
+            add(skirt_i + 1);
+            add(skirt_i + 1);
+            add(tile_i + 1);
+            add(tile_i);
+        }
+
+        // row[numRows-1]
+        for (uint32_t c = 0; c < numCols - 1; ++c)
+        {
+            uint32_t tile_i = (numRows - 1) * numCols + c;
+            uint32_t skirt_i = skirt_top_row + c;
+            add(tile_i);
+            add(skirt_i + 1);
+            add(skirt_i);
+            add(skirt_i + 1);
+            add(tile_i);
+            add(tile_i + 1);
+        }
+
+        // column[0]
+        for (uint32_t r = 0; r < numRows - 1; ++r)
+        {
+            uint32_t tile_i = r * numCols;
+            uint32_t skirt_i = skirt_left_column + r;
+            add(tile_i);
+            add(skirt_i + 1);
+            add(skirt_i);
+            add(skirt_i + 1);
+            add(tile_i);
+            add(tile_i + numCols);
+        }
+
+        // column[numColums-1]
+        for (uint32_t r = 0; r < numRows - 1; ++r)
+        {
+            uint32_t tile_i = (numCols - 1) + r * numCols;
+            uint32_t skirt_i = skirt_right_column + r;
+            add(tile_i);
+            add(skirt_i);
+            add(skirt_i + 1);
+            add(skirt_i + 1);
+            add(tile_i + numCols);
+            add(tile_i);
+        }
+
+        return indices;
+    }
+
+    /// create the indices of the quad patches, with corners ordered counter clockwise, used for tessellated tiles
+    template<class A>
+    ref_ptr<Data> createPatchIndices(uint32_t numRows, uint32_t numCols, bool skirt)
+    {
+        using index_type = typename A::value_type;
+
+        uint32_t numPatches = (numRows - 1) * (numCols - 1);
+        if (skirt) numPatches += 2 * (numCols - 1) + 2 * (numRows - 1);
+
+        auto indices = A::create(numPatches * 4);
+        auto itr = indices->begin();
+        auto add = [&itr](uint32_t i0, uint32_t i1, uint32_t i2, uint32_t i3) {
+            (*itr++) = static_cast<index_type>(i0);
+            (*itr++) = static_cast<index_type>(i1);
+            (*itr++) = static_cast<index_type>(i2);
+            (*itr++) = static_cast<index_type>(i3);
+        };
+
+        for (uint32_t r = 0; r < numRows - 1; ++r)
+        {
+            for (uint32_t c = 0; c < numCols - 1; ++c)
+            {
+                uint32_t vi = c + r * numCols;
+                add(vi, vi + 1, vi + numCols + 1, vi + numCols);
+            }
+        }
+
+        if (!skirt) return indices;
+
+        // skirt vertices follow the grid vertices, bottom row, top row, left column then right column, with the same winding as createGridIndices()
+        uint32_t skirt_bottom_row = numRows * numCols;
+        uint32_t skirt_top_row = skirt_bottom_row + numCols;
+        uint32_t skirt_left_column = skirt_top_row + numCols;
+        uint32_t skirt_right_column = skirt_left_column + numRows;
+
+        for (uint32_t c = 0; c < numCols - 1; ++c)
+        {
+            uint32_t tile_i = c;
+            uint32_t skirt_i = skirt_bottom_row + c;
+            add(tile_i, skirt_i, skirt_i + 1, tile_i + 1);
+        }
+
+        for (uint32_t c = 0; c < numCols - 1; ++c)
+        {
+            uint32_t tile_i = (numRows - 1) * numCols + c;
+            uint32_t skirt_i = skirt_top_row + c;
+            add(tile_i, tile_i + 1, skirt_i + 1, skirt_i);
+        }
+
+        for (uint32_t r = 0; r < numRows - 1; ++r)
+        {
+            uint32_t tile_i = r * numCols;
+            uint32_t skirt_i = skirt_left_column + r;
+            add(tile_i, tile_i + numCols, skirt_i + 1, skirt_i);
+        }
+
+        for (uint32_t r = 0; r < numRows - 1; ++r)
+        {
+            uint32_t tile_i = (numCols - 1) + r * numCols;
+            uint32_t skirt_i = skirt_right_column + r;
+            add(tile_i, skirt_i, skirt_i + 1, tile_i + numCols);
+        }
+
+        return indices;
+    }
+} // namespace
+
 vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_ptr<Data> imageData, ref_ptr<Data> detailData, ref_ptr<Data> elevationData) const
 {
     if (!imageData) return {};
@@ -612,6 +952,14 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
     if (numCols > settings->maxTileDimension) numCols = settings->maxTileDimension;
     if (numRows > settings->maxTileDimension) numRows = settings->maxTileDimension;
 
+    // tessellated tiles use a coarse grid of patches, with the elevation detail added by the tessellation shaders
+    bool tessellated = settings->tessellation;
+    if (tessellated)
+    {
+        numCols = std::max(settings->tessellationPatchDimension, 1u) + 1;
+        numRows = numCols;
+    }
+
     auto localToWorld = settings->ellipsoidModel->computeLocalToWorldTransform(center);
     auto worldToLocal = vsg::inverse(localToWorld);
 
@@ -657,7 +1005,10 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
         numTriangles += 4 * (numCols + numRows - 2);
     }
 
-    dvec4 geometryKey{tile_extents.min.y, (tile_extents.max.y - tile_extents.min.y), static_cast<double>(numRows), static_cast<double>(numCols)};
+    GeometryKey geometryKey;
+    geometryKey.extents.set(tile_extents.min.y, (tile_extents.max.y - tile_extents.min.y), static_cast<double>(numRows), static_cast<double>(numCols));
+    geometryKey.displaced = elevationData.valid();
+    geometryKey.displacementScale = elevationData ? displacementMapScale.z : 0.0f;
     ref_ptr<VertexIndexDraw> vid;
 
     // check if reusable geometry exists already
@@ -712,23 +1063,6 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
             }
         }
 
-        // set up indices
-        auto indices = vsg::uintArray::create(numTriangles * 3);
-        auto itr = indices->begin();
-        for (uint32_t r = 0; r < numRows - 1; ++r)
-        {
-            for (uint32_t c = 0; c < numCols - 1; ++c)
-            {
-                uint32_t vi = c + r * numCols;
-                (*itr++) = vi;
-                (*itr++) = vi + 1;
-                (*itr++) = vi + numCols;
-                (*itr++) = vi + numCols;
-                (*itr++) = vi + 1;
-                (*itr++) = vi + numCols + 1;
-            }
-        }
-
         // add skirt around perimeter to avoid visual gaps between adjacent tiles of different LOD level
         if (settings->skirtRatio != 0.0)
         {
@@ -736,8 +1070,7 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
 
             // row[0]
             uint32_t tile_bottom_row = 0;
-            uint32_t skirt_bottom_row = numRows * numCols;
-            uint32_t vi = skirt_bottom_row;
+            uint32_t vi = numRows * numCols;
             for (uint32_t c = 0; c < numCols; ++c, ++vi)
             {
                 uint32_t si = tile_bottom_row + c;
@@ -746,21 +1079,9 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
                 texcoords->at(vi) = texcoords->at(si);
                 normals->at(vi) = normal;
             }
-            for (uint32_t c = 0; c < numCols - 1; ++c)
-            {
-                uint32_t tile_i = tile_bottom_row + c;
-                uint32_t skirt_i = skirt_bottom_row + c;
-                (*itr++) = tile_i;
-                (*itr++) = skirt_i;
-                (*itr++) = skirt_i + 1;
-                (*itr++) = skirt_i + 1;
-                (*itr++) = tile_i + 1;
-                (*itr++) = tile_i;
-            }
 
             // row[numRows-1]
             uint32_t tile_top_row = (numRows - 1) * numCols;
-            uint32_t base_top_row = vi;
             for (uint32_t c = 0; c < numCols; ++c, ++vi)
             {
                 uint32_t si = tile_top_row + c;
@@ -769,21 +1090,9 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
                 texcoords->at(vi) = texcoords->at(si);
                 normals->at(vi) = normal;
             }
-            for (uint32_t c = 0; c < numCols - 1; ++c)
-            {
-                uint32_t tile_i = tile_top_row + c;
-                uint32_t skirt_i = base_top_row + c;
-                (*itr++) = tile_i;
-                (*itr++) = skirt_i + 1;
-                (*itr++) = skirt_i;
-                (*itr++) = skirt_i + 1;
-                (*itr++) = tile_i;
-                (*itr++) = tile_i + 1;
-            }
 
             // column[0]
             uint32_t tile_left_column = 0;
-            uint32_t skirt_left_column = vi;
             for (uint32_t r = 0; r < numRows; ++r, ++vi)
             {
                 uint32_t si = tile_left_column + r * numCols;
@@ -792,21 +1101,9 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
                 texcoords->at(vi) = texcoords->at(si);
                 normals->at(vi) = normal;
             }
-            for (uint32_t r = 0; r < numRows - 1; ++r)
-            {
-                uint32_t tile_i = tile_left_column + r * numCols;
-                uint32_t skirt_i = skirt_left_column + r;
-                (*itr++) = tile_i;
-                (*itr++) = skirt_i + 1;
-                (*itr++) = skirt_i;
-                (*itr++) = skirt_i + 1;
-                (*itr++) = tile_i;
-                (*itr++) = tile_i + numCols;
-            }
 
             // column[numColums-1]
             uint32_t tile_right_column = numCols - 1;
-            uint32_t skirt_right_column = vi;
             for (uint32_t r = 0; r < numRows; ++r, ++vi)
             {
                 uint32_t si = tile_right_column + r * numCols;
@@ -815,17 +1112,6 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
                 texcoords->at(vi) = texcoords->at(si);
                 normals->at(vi) = normal;
             }
-            for (uint32_t r = 0; r < numRows - 1; ++r)
-            {
-                uint32_t tile_i = tile_right_column + r * numCols;
-                uint32_t skirt_i = skirt_right_column + r;
-                (*itr++) = tile_i;
-                (*itr++) = skirt_i;
-                (*itr++) = skirt_i + 1;
-                (*itr++) = skirt_i + 1;
-                (*itr++) = tile_i + numCols;
-                (*itr++) = tile_i;
-            }
         }
 
         vsg::DataList arrays{vertices, normals, texcoords, colors};
@@ -835,11 +1121,34 @@ vsg::ref_ptr<vsg::Node> tile::createECEFTile(const vsg::dbox& tile_extents, ref_
             arrays.push_back(vsg::vec3Value::create(displacementMapScale));
         }
 
+        // share the grid indices between all geometries of the same dimensions
+        ref_ptr<Data> indices;
+        {
+            std::scoped_lock<std::mutex> lock(_geometryMapMutex);
+            auto& sharedIndices = _indicesMap[uivec2(numRows, numCols)];
+            if (!sharedIndices)
+            {
+                bool skirt = settings->skirtRatio != 0.0;
+                if (tessellated)
+                {
+                    if (numVertices <= 65536)
+                        sharedIndices = createPatchIndices<ushortArray>(numRows, numCols, skirt);
+                    else
+                        sharedIndices = createPatchIndices<uintArray>(numRows, numCols, skirt);
+                }
+                else if (numVertices <= 65536)
+                    sharedIndices = createGridIndices<ushortArray>(numRows, numCols, skirt, numTriangles);
+                else
+                    sharedIndices = createGridIndices<uintArray>(numRows, numCols, skirt, numTriangles);
+            }
+            indices = sharedIndices;
+        }
+
         // setup geometry
         vid = vsg::VertexIndexDraw::create();
         vid->assignArrays(arrays);
         vid->assignIndices(indices);
-        vid->indexCount = static_cast<uint32_t>(indices->size());
+        vid->indexCount = static_cast<uint32_t>(indices->valueCount());
         vid->instanceCount = 1;
 
         {
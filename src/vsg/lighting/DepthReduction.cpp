@@ -0,0 +1,314 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Logger.h>
+#include <vsg/lighting/DepthReduction.h>
+#include <vsg/maths/transform.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace vsg;
+
+namespace
+{
+    constexpr uint32_t s_localSize = 16;
+
+    const char* s_reductionSource = R"(#version 450
+
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(push_constant) uniform PushConstants
+{
+    ivec2 offset;
+    ivec2 extent;
+    float background;
+} pc;
+
+layout(set = 0, binding = 0) uniform sampler2D depthImage;
+layout(std430, set = 0, binding = 1) buffer DepthRange { uint minDepth; uint maxDepth; } depthRange;
+
+shared uint s_minDepth;
+shared uint s_maxDepth;
+
+void main()
+{
+    if (gl_LocalInvocationIndex == 0)
+    {
+        s_minDepth = 0xffffffffu;
+        s_maxDepth = 0u;
+    }
+    barrier();
+
+    // depths are positive so their bit patterns order the same as their values
+    ivec2 p = ivec2(gl_GlobalInvocationID.xy);
+    if (all(lessThan(p, pc.extent)))
+    {
+        float depth = texelFetch(depthImage, pc.offset + p, 0).r;
+        if (depth != pc.background)
+        {
+            atomicMin(s_minDepth, floatBitsToUint(depth));
+            atomicMax(s_maxDepth, floatBitsToUint(depth));
+        }
+    }
+    barrier();
+
+    if (gl_LocalInvocationIndex == 0 && s_minDepth <= s_maxDepth)
+    {
+        atomicMin(depthRange.minDepth, s_minDepth);
+        atomicMax(depthRange.maxDepth, s_maxDepth);
+    }
+}
+)";
+
+    struct ReductionPushConstants
+    {
+        int32_t offset[2];
+        int32_t extent[2];
+        float background;
+    };
+
+} // namespace
+
+DepthReduction::DepthReduction(ref_ptr<Window> in_window, uint32_t in_numBuffers) :
+    window(in_window),
+    numBuffers(std::max(in_numBuffers, 2u)),
+    _slots(numBuffers)
+{
+}
+
+DepthReduction::~DepthReduction()
+{
+    for (auto& slot : _slots)
+    {
+        if (slot.buffer && slot.mappedData)
+        {
+            slot.buffer->getDeviceMemory(_deviceID)->unmap();
+        }
+    }
+}
+
+void DepthReduction::prepare(WindowTraits& traits)
+{
+    traits.depthImageUsage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+}
+
+void DepthReduction::compile(Context& context)
+{
+    if (_pipeline) return;
+
+    auto device = context.device;
+    auto deviceID = device->deviceID;
+    _deviceID = deviceID;
+
+    DescriptorSetLayoutBindings bindings{
+        {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr}};
+
+    _descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    auto pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{_descriptorSetLayout}, PushConstantRanges{{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReductionPushConstants)}});
+    auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", s_reductionSource);
+
+    try
+    {
+        _pipeline = ComputePipeline::create(pipelineLayout, computeShader);
+        _pipeline->compile(context);
+    }
+    catch (const Exception& exception)
+    {
+        warn("DepthReduction::compile() unable to create depth reduction pipeline, shadow cascades will not be fitted to the rendered depths. ", exception.message);
+        _pipeline = {};
+        return;
+    }
+
+    _sampler = Sampler::create();
+    _sampler->minFilter = VK_FILTER_NEAREST;
+    _sampler->magFilter = VK_FILTER_NEAREST;
+    _sampler->mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    _sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    _sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    _sampler->addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    _sampler->compile(context);
+
+    _descriptorPool = DescriptorPool::create(device, numBuffers, DescriptorPoolSizes{{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, numBuffers}, {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, numBuffers}});
+
+    for (auto& slot : _slots)
+    {
+        slot.event = Event::create(device);
+        slot.buffer = createBufferAndMemory(device, 2 * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        // the buffer is mapped for its lifetime so the completed reductions can be read in place
+        void* data = nullptr;
+        if (slot.buffer->getDeviceMemory(deviceID)->map(slot.buffer->getMemoryOffset(deviceID), 2 * sizeof(uint32_t), 0, &data) != VK_SUCCESS)
+        {
+            throw Exception{"Error: DepthReduction::compile(..) unable to map depth range buffer."};
+        }
+        slot.mappedData = static_cast<const uint32_t*>(data);
+
+        slot.descriptorSet = _descriptorPool->allocateDescriptorSet(_descriptorSetLayout);
+        if (!slot.descriptorSet)
+        {
+            throw Exception{"Error: DepthReduction::compile(..) unable to allocate descriptor set."};
+        }
+    }
+}
+
+void DepthReduction::poll() const
+{
+    // take the most recent completed reduction, slots complete in the order they were recorded
+    for (uint32_t i = 0; i < numBuffers; ++i)
+    {
+        auto& slot = _slots[(_nextSlot + i) % numBuffers];
+        if (!slot.inFlight || slot.event->status() != VK_EVENT_SET) continue;
+
+        float depths[2];
+        std::memcpy(depths, slot.mappedData, sizeof(depths));
+        slot.event->reset();
+        slot.inFlight = false;
+
+        _rangeValid = depths[0] <= depths[1];
+        if (_rangeValid)
+        {
+            // convert both depths as reverse depth places the nearest depth at the maximum depth value
+            auto clipToEye = inverse(slot.projectionMatrix);
+            double d0 = -(clipToEye * dvec3(0.0, 0.0, depths[0])).z;
+            double d1 = -(clipToEye * dvec3(0.0, 0.0, depths[1])).z;
+            _nearDistance = std::min(d0, d1);
+            _farDistance = std::max(d0, d1);
+        }
+    }
+}
+
+bool DepthReduction::getDepthRange(double& nearDistance, double& farDistance) const
+{
+    if (_pipeline) poll();
+
+    if (!_rangeValid) return false;
+
+    nearDistance = _nearDistance;
+    farDistance = _farDistance;
+    return true;
+}
+
+void DepthReduction::record(CommandBuffer& commandBuffer) const
+{
+    auto previousProjectionMatrix = _previousProjectionMatrix;
+    _previousProjectionMatrix = projectionMatrix;
+
+    auto image = window->getDepthImage();
+    auto previousImage = _previousImage;
+    _previousImage = image.get();
+
+    // the depth image has to have been rendered by the previous frame to be in the depth attachment layout with depths to reduce
+    if (!_pipeline || !image || image.get() != previousImage) return;
+
+    if (window->framebufferSamples() != VK_SAMPLE_COUNT_1_BIT || (image->usage & VK_IMAGE_USAGE_SAMPLED_BIT) == 0)
+    {
+        warn("DepthReduction requires a single sampled depth image with VK_IMAGE_USAGE_SAMPLED_BIT, see DepthReduction::prepare(WindowTraits&).");
+        _previousImage = nullptr;
+        return;
+    }
+
+    auto& slot = _slots[_nextSlot];
+    if (slot.inFlight) return; // all the buffers are in flight, skip the reduction rather than stall
+
+    auto deviceID = commandBuffer.deviceID;
+    VkCommandBuffer vk_commandBuffer = commandBuffer;
+    auto device = commandBuffer.getDevice();
+
+    if (!_imageView || _imageView->image != image)
+    {
+        // sampling requires a view of just the depth aspect
+        _imageView = ImageView::create(image, VK_IMAGE_ASPECT_DEPTH_BIT);
+        _imageView->compile(device);
+    }
+
+    if (slot.imageView != _imageView)
+    {
+        // the slot isn't in flight so its descriptor set can be updated
+        VkDescriptorImageInfo imageInfo{_sampler->vk(deviceID), _imageView->vk(deviceID), VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL};
+        VkDescriptorBufferInfo bufferInfo{slot.buffer->vk(deviceID), 0, 2 * sizeof(uint32_t)};
+
+        VkWriteDescriptorSet writes[2] = {};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = slot.descriptorSet->_descriptorSet;
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &imageInfo;
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = slot.descriptorSet->_descriptorSet;
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[1].pBufferInfo = &bufferInfo;
+        vkUpdateDescriptorSets(*device, 2, writes, 0, nullptr);
+
+        slot.imageView = _imageView;
+    }
+
+    // clamp the region to the depth image
+    int32_t x0 = std::clamp(region.offset.x, 0, static_cast<int32_t>(image->extent.width));
+    int32_t y0 = std::clamp(region.offset.y, 0, static_cast<int32_t>(image->extent.height));
+    int32_t x1 = (region.extent.width > 0) ? std::min(x0 + static_cast<int32_t>(region.extent.width), static_cast<int32_t>(image->extent.width)) : static_cast<int32_t>(image->extent.width);
+    int32_t y1 = (region.extent.height > 0) ? std::min(y0 + static_cast<int32_t>(region.extent.height), static_cast<int32_t>(image->extent.height)) : static_cast<int32_t>(image->extent.height);
+    if (x1 <= x0 || y1 <= y0) return;
+
+    slot.projectionMatrix = previousProjectionMatrix;
+    slot.inFlight = true;
+    _nextSlot = (_nextSlot + 1) % numBuffers;
+
+    // reset the range to an empty range
+    auto vk_buffer = slot.buffer->vk(deviceID);
+    vkCmdFillBuffer(vk_commandBuffer, vk_buffer, 0, sizeof(uint32_t), 0xffffffff);
+    vkCmdFillBuffer(vk_commandBuffer, vk_buffer, sizeof(uint32_t), sizeof(uint32_t), 0);
+
+    VkImageMemoryBarrier toShaderRead{};
+    toShaderRead.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toShaderRead.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    toShaderRead.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    toShaderRead.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    toShaderRead.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    toShaderRead.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toShaderRead.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toShaderRead.image = image->vk(deviceID);
+    toShaderRead.subresourceRange = {computeAspectFlagsForFormat(image->format), 0, 1, 0, 1};
+
+    VkMemoryBarrier fillToShader{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT};
+    vkCmdPipelineBarrier(vk_commandBuffer, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &fillToShader, 0, nullptr, 1, &toShaderRead);
+
+    ReductionPushConstants pushConstants{{x0, y0}, {x1 - x0, y1 - y0}, (previousProjectionMatrix(2, 2) > 0.0) ? 0.0f : 1.0f};
+    auto vk_pipelineLayout = _pipeline->layout->vk(deviceID);
+
+    vkCmdBindPipeline(vk_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipeline->vk(deviceID));
+    vkCmdBindDescriptorSets(vk_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vk_pipelineLayout, 0, 1, &(slot.descriptorSet->_descriptorSet), 0, nullptr);
+    vkCmdPushConstants(vk_commandBuffer, vk_pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReductionPushConstants), &pushConstants);
+    vkCmdDispatch(vk_commandBuffer, (pushConstants.extent[0] + s_localSize - 1) / s_localSize, (pushConstants.extent[1] + s_localSize - 1) / s_localSize, 1);
+
+    // return the depth image to the attachment layout for this frame's render pass, and make the range visible to the host before signaling the event that poll() checks
+    VkImageMemoryBarrier toAttachment = toShaderRead;
+    toAttachment.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    toAttachment.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    toAttachment.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+    toAttachment.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    VkMemoryBarrier toHost{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT};
+    vkCmdPipelineBarrier(vk_commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &toHost, 0, nullptr, 1, &toAttachment);
+
+    vkCmdSetEvent(vk_commandBuffer, slot.event->vk(), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+
+    // compute pipeline and pipeline layout have been bound outside of vsg::State so force state to be reapplied
+    if (commandBuffer.state) commandBuffer.state->dirtyStateStacks();
+}
@@ -0,0 +1,233 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Logger.h>
+#include <vsg/lighting/LightClustering.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
+
+using namespace vsg;
+
+namespace
+{
+    const uint32_t s_workgroupSize = 64;
+
+    const char* s_clusteringSource = R"(#version 450
+
+layout(local_size_x = 64) in;
+
+layout(set = 0, binding = 0) uniform ClusterSettings
+{
+    vec4 depthRange; // near, far, log(far/near), numLights
+    vec4 dimensions; // x, y and z cluster counts, maxLightsPerCluster
+    vec4 viewport;
+    mat4 clipToEye;
+} clusterSettings;
+
+layout(set = 0, binding = 1) readonly buffer ClusterLights { vec4 clusterLights[]; };
+layout(set = 0, binding = 2) writeonly buffer ClusterLightCounts { uint clusterLightCounts[]; };
+layout(set = 0, binding = 3) writeonly buffer ClusterLightIndices { uint clusterLightIndices[]; };
+
+// intersect the ray through the clip space xy position with the eye space plane z = -depth, valid for perspective and orthographic projections
+vec3 eyeSpacePoint(vec2 clip_xy, float depth)
+{
+    vec4 p0 = clusterSettings.clipToEye * vec4(clip_xy, 0.25, 1.0);
+    vec4 p1 = clusterSettings.clipToEye * vec4(clip_xy, 0.75, 1.0);
+    vec3 a = p0.xyz / p0.w;
+    vec3 b = p1.xyz / p1.w;
+    return mix(a, b, (-depth - a.z) / (b.z - a.z));
+}
+
+void main()
+{
+    float intensityMinimum = 0.001;
+
+    uvec3 dims = uvec3(clusterSettings.dimensions.xyz);
+    uint cluster = gl_GlobalInvocationID.x;
+    if (cluster >= dims.x * dims.y * dims.z) return;
+
+    uvec3 c = uvec3(cluster % dims.x, (cluster / dims.x) % dims.y, cluster / (dims.x * dims.y));
+
+    // the first slice extends to the eye point and the last slice to beyond the far plane, matching the clamping of the slice index in the fragment shaders
+    float sliceNear = (c.z == 0) ? 0.0 : clusterSettings.depthRange.x * exp(clusterSettings.depthRange.z * float(c.z) / float(dims.z));
+    float sliceFar = (c.z + 1 == dims.z) ? 1e20 : clusterSettings.depthRange.x * exp(clusterSettings.depthRange.z * float(c.z + 1) / float(dims.z));
+
+    vec2 tileMin = vec2(c.xy) / vec2(dims.xy) * 2.0 - 1.0;
+    vec2 tileMax = vec2(c.xy + uvec2(1)) / vec2(dims.xy) * 2.0 - 1.0;
+
+    vec3 aabbMin = eyeSpacePoint(tileMin, sliceNear);
+    vec3 aabbMax = aabbMin;
+    vec3 corners[7] = vec3[](eyeSpacePoint(vec2(tileMax.x, tileMin.y), sliceNear),
+                             eyeSpacePoint(vec2(tileMin.x, tileMax.y), sliceNear),
+                             eyeSpacePoint(tileMax, sliceNear),
+                             eyeSpacePoint(tileMin, sliceFar),
+                             eyeSpacePoint(vec2(tileMax.x, tileMin.y), sliceFar),
+                             eyeSpacePoint(vec2(tileMin.x, tileMax.y), sliceFar),
+                             eyeSpacePoint(tileMax, sliceFar));
+    for(int i = 0; i < 7; ++i)
+    {
+        aabbMin = min(aabbMin, corners[i]);
+        aabbMax = max(aabbMax, corners[i]);
+    }
+
+    uint numLights = uint(clusterSettings.depthRange.w);
+    uint maxLightsPerCluster = uint(clusterSettings.dimensions.w);
+    uint offset = cluster * maxLightsPerCluster;
+    uint count = 0;
+
+    for(uint i = 0; i < numLights && count < maxLightsPerCluster; ++i)
+    {
+        // lights only contribute while intensity / distance^2 is above the intensityMinimum used by the fragment shaders
+        float intensity = clusterLights[i * 3].a;
+        vec3 position = clusterLights[i * 3 + 1].xyz;
+        float range2 = intensity / intensityMinimum;
+
+        vec3 delta = clamp(position, aabbMin, aabbMax) - position;
+        if (dot(delta, delta) <= range2)
+        {
+            clusterLightIndices[offset + count] = i;
+            ++count;
+        }
+    }
+
+    clusterLightCounts[cluster] = count;
+}
+)";
+
+} // namespace
+
+LightClustering::LightClustering(const uivec3& in_dimensions, uint32_t in_maxLights, uint32_t in_maxLightsPerCluster) :
+    dimensions(in_dimensions),
+    maxLights(in_maxLights),
+    maxLightsPerCluster(in_maxLightsPerCluster)
+{
+    uint32_t numClusters = dimensions.x * dimensions.y * dimensions.z;
+
+    settings = vec4Array::create(7);
+    settings->setValue("name", "clusterSettings");
+    settings->properties.dataVariance = DYNAMIC_DATA_TRANSFER_AFTER_RECORD;
+    settingsBufferInfo = BufferInfo::create(settings.get());
+
+    lights = vec4Array::create(std::max(maxLights, 1u) * 3);
+    lights->setValue("name", "clusterLights");
+    lights->properties.dataVariance = DYNAMIC_DATA_TRANSFER_AFTER_RECORD;
+    lightsBufferInfo = BufferInfo::create(lights.get());
+
+    VkDeviceSize countsSize = sizeof(uint32_t) * numClusters;
+    VkDeviceSize indicesSize = sizeof(uint32_t) * numClusters * maxLightsPerCluster;
+    lightCounts = BufferInfo::create(Buffer::create(countsSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE), 0, countsSize);
+    lightIndices = BufferInfo::create(Buffer::create(indicesSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE), 0, indicesSize);
+
+    VkShaderStageFlags stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    DescriptorSetLayoutBindings bindings{
+        VkDescriptorSetLayoutBinding{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, stageFlags, nullptr},
+        VkDescriptorSetLayoutBinding{1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr},
+        VkDescriptorSetLayoutBinding{2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr},
+        VkDescriptorSetLayoutBinding{3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr}};
+
+    Descriptors descriptors{
+        DescriptorBuffer::create(BufferInfoList{settingsBufferInfo}, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER),
+        DescriptorBuffer::create(BufferInfoList{lightsBufferInfo}, 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        DescriptorBuffer::create(BufferInfoList{lightCounts}, 2, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        DescriptorBuffer::create(BufferInfoList{lightIndices}, 3, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)};
+
+    auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", s_clusteringSource);
+
+    auto descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    _pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{descriptorSetLayout}, PushConstantRanges{});
+
+    _bindComputePipeline = BindComputePipeline::create(ComputePipeline::create(_pipelineLayout, computeShader));
+    _bindDescriptorSet = BindDescriptorSet::create(VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout, 0, DescriptorSet::create(descriptorSetLayout, descriptors));
+}
+
+LightClustering::~LightClustering()
+{
+}
+
+void LightClustering::assignSettings(uint32_t numLights, double nearDistance, double farDistance, const vec4& viewport, const dmat4& projectionMatrix)
+{
+    // clamp the depth range so that the exponential depth slices remain well behaved for orthographic and infinite far plane projections
+    nearDistance = std::max(nearDistance, 1e-3);
+    farDistance = std::max(farDistance, nearDistance * 2.0);
+
+    mat4 clipToEye(inverse(projectionMatrix));
+
+    vec4 values[7] = {
+        vec4(static_cast<float>(nearDistance), static_cast<float>(farDistance), static_cast<float>(std::log(farDistance / nearDistance)), static_cast<float>(std::min(numLights, maxLights))),
+        vec4(static_cast<float>(dimensions.x), static_cast<float>(dimensions.y), static_cast<float>(dimensions.z), static_cast<float>(maxLightsPerCluster)),
+        viewport,
+        clipToEye[0],
+        clipToEye[1],
+        clipToEye[2],
+        clipToEye[3]};
+
+    bool changed = false;
+    for (uint32_t i = 0; i < 7; ++i)
+    {
+        if (settings->at(i) != values[i])
+        {
+            settings->set(i, values[i]);
+            changed = true;
+        }
+    }
+
+    if (changed) settings->dirty();
+}
+
+void LightClustering::compile(Context& context)
+{
+    auto deviceID = context.deviceID;
+
+    // the light counts and indices are only ever accessed on the GPU so can be placed in device local memory
+    auto allocate = [&](BufferInfo& bufferInfo) -> void {
+        auto& buffer = bufferInfo.buffer;
+        buffer->compile(context.device);
+        if (buffer->getDeviceMemory(deviceID) == nullptr)
+        {
+            auto memRequirements = buffer->getMemoryRequirements(deviceID);
+            auto [deviceMemory, offset] = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            if (!deviceMemory)
+            {
+                throw Exception{"Error: LightClustering::compile(..) failed to allocate buffer from deviceMemoryBufferPools.", VK_ERROR_OUT_OF_DEVICE_MEMORY};
+            }
+            buffer->bind(deviceMemory, offset);
+        }
+    };
+
+    allocate(*lightCounts);
+    allocate(*lightIndices);
+
+    _bindComputePipeline->compile(context);
+    _bindDescriptorSet->compile(context);
+}
+
+void LightClustering::record(CommandBuffer& commandBuffer) const
+{
+    VkCommandBuffer cmdBuffer{commandBuffer};
+
+    uint32_t numClusters = dimensions.x * dimensions.y * dimensions.z;
+
+    // wait for previous frames reading the light counts and indices before overwriting them
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+    _bindComputePipeline->record(commandBuffer);
+    _bindDescriptorSet->record(commandBuffer);
+    vkCmdDispatch(cmdBuffer, (numClusters + s_workgroupSize - 1) / s_workgroupSize, 1, 1);
+
+    VkMemoryBarrier clusterBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT};
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 1, &clusterBarrier, 0, nullptr, 0, nullptr);
+
+    // compute pipeline and pipeline layout have been bound outside of vsg::State so force state to be reapplied
+    if (commandBuffer.state) commandBuffer.state->dirtyStateStacks();
+}
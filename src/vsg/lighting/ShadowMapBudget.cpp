@@ -0,0 +1,94 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/lighting/ShadowMapBudget.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace vsg;
+
+ShadowMapBudget::ShadowMapBudget()
+{
+}
+
+ShadowMapBudget::~ShadowMapBudget()
+{
+}
+
+void ShadowMapBudget::allocate(const std::vector<Candidate>& candidates, uint32_t availableShadowMaps, uint32_t layerSize, std::vector<Allocation>& allocations) const
+{
+    allocations.assign(candidates.size(), Allocation{0, 1.0, 1});
+
+    // rank the candidates by their screen contribution
+    std::vector<size_t> ranking(candidates.size());
+    std::iota(ranking.begin(), ranking.end(), 0);
+    std::stable_sort(ranking.begin(), ranking.end(), [&](size_t lhs, size_t rhs) { return candidates[lhs].screenRadius > candidates[rhs].screenRadius; });
+
+    uint32_t remainingShadowMaps = std::min(availableShadowMaps, maxShadowMaps);
+    double remainingArea = maxLayerArea;
+    double minScale = std::max(minRegionScale, 1.0 / static_cast<double>(std::max(layerSize, 1u)));
+    uint32_t rank = 0;
+
+    for (auto index : ranking)
+    {
+        if (remainingShadowMaps == 0) break;
+
+        const auto& candidate = candidates[index];
+        if (candidate.shadowMapCount == 0) continue;
+        if (candidate.screenRadius < minScreenRadius) break;
+
+        uint32_t count = std::min(candidate.shadowMapCount, remainingShadowMaps);
+
+        // smallest power of two fraction of the layer that provides the required texels across the light's projected diameter
+        double required = 2.0 * candidate.screenRadius * resolutionScale / static_cast<double>(std::max(layerSize, 1u));
+        double regionScale = 1.0;
+        while (regionScale * 0.5 >= required && regionScale * 0.5 >= minScale) regionScale *= 0.5;
+
+        // drop the resolution further when the remaining area can't accommodate it
+        auto area = [&]() { return static_cast<double>(count) * regionScale * regionScale; };
+        while (area() > remainingArea && regionScale * 0.5 >= minScale) regionScale *= 0.5;
+        if (area() > remainingArea) continue;
+
+        remainingShadowMaps -= count;
+        remainingArea -= area();
+
+        auto& allocation = allocations[index];
+        allocation.shadowMapCount = count;
+        allocation.regionScale = regionScale;
+        allocation.updateInterval = (rank < numFullRateLights) ? 1 : std::max(reducedUpdateInterval, 1u);
+        ++rank;
+    }
+}
+
+double ShadowMapBudget::screenRadius(const dvec3& eyeCenter, double radius, const dmat4& projectionMatrix, double viewportHeight)
+{
+    // sphere entirely behind the eye
+    double depth = -eyeCenter.z;
+    if (depth + radius <= 0.0) return 0.0;
+
+    // eye inside the sphere, or the sphere crossing the eye plane, covers the whole view
+    if (length(eyeCenter) <= radius || depth <= radius) return viewportHeight;
+
+    auto clip = projectionMatrix * dvec4(eyeCenter.x, eyeCenter.y, eyeCenter.z, 1.0);
+    double w = std::abs(clip.w);
+    if (w == 0.0) return viewportHeight;
+
+    double radius_x = radius * std::abs(projectionMatrix[0][0]) / w;
+    double radius_y = radius * std::abs(projectionMatrix[1][1]) / w;
+
+    // sphere outside the sides of the view frustum
+    if (std::abs(clip.x / clip.w) - radius_x > 1.0 || std::abs(clip.y / clip.w) - radius_y > 1.0) return 0.0;
+
+    return std::min(radius_y * 0.5 * viewportHeight, viewportHeight);
+}
@@ -162,9 +162,82 @@ mat4 vsg::inverse_4x3(const mat4& m)
     return t_inverse_4x3(m);
 }
 
+#if defined(VSG_SIMD_SSE2)
+// returns the 2x2 sub determinants (c2[p] * c3[q] - c3[p] * c2[q], <same>, c1[p] * c3[q] - c3[p] * c1[q], c1[p] * c2[q] - c2[p] * c1[q])
+template<int p, int q>
+static inline __m128 sse_subDeterminants(__m128 c1, __m128 c2, __m128 c3)
+{
+    const __m128 a = _mm_shuffle_ps(c2, c1, _MM_SHUFFLE(p, p, p, p));
+    const __m128 d = _mm_shuffle_ps(c2, c1, _MM_SHUFFLE(q, q, q, q));
+    const __m128 tq = _mm_shuffle_ps(c3, c2, _MM_SHUFFLE(q, q, q, q));
+    const __m128 tp = _mm_shuffle_ps(c3, c2, _MM_SHUFFLE(p, p, p, p));
+    const __m128 b = _mm_shuffle_ps(tq, tq, _MM_SHUFFLE(2, 0, 0, 0));
+    const __m128 c = _mm_shuffle_ps(tp, tp, _MM_SHUFFLE(2, 0, 0, 0));
+    return _mm_sub_ps(_mm_mul_ps(a, b), _mm_mul_ps(c, d));
+}
+
+// returns (c1[r], c0[r], c0[r], c0[r])
+template<int r>
+static inline __m128 sse_leading(__m128 c0, __m128 c1)
+{
+    const __m128 t = _mm_shuffle_ps(c1, c0, _MM_SHUFFLE(r, r, r, r));
+    return _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 0));
+}
+
+// SSE general purpose inverse, computes the adjugate one column at a time from the 2x2 sub determinants of the last three columns.
+static mat4 sse_inverse_4x4(const mat4& m)
+{
+    const __m128 c0 = _mm_loadu_ps(m[0].data());
+    const __m128 c1 = _mm_loadu_ps(m[1].data());
+    const __m128 c2 = _mm_loadu_ps(m[2].data());
+    const __m128 c3 = _mm_loadu_ps(m[3].data());
+
+    const __m128 s23 = sse_subDeterminants<2, 3>(c1, c2, c3);
+    const __m128 s13 = sse_subDeterminants<1, 3>(c1, c2, c3);
+    const __m128 s12 = sse_subDeterminants<1, 2>(c1, c2, c3);
+    const __m128 s03 = sse_subDeterminants<0, 3>(c1, c2, c3);
+    const __m128 s02 = sse_subDeterminants<0, 2>(c1, c2, c3);
+    const __m128 s01 = sse_subDeterminants<0, 1>(c1, c2, c3);
+
+    const __m128 v0 = sse_leading<0>(c0, c1);
+    const __m128 v1 = sse_leading<1>(c0, c1);
+    const __m128 v2 = sse_leading<2>(c0, c1);
+    const __m128 v3 = sse_leading<3>(c0, c1);
+
+    const __m128 signA = _mm_set_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+    const __m128 signB = _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f);
+
+    const __m128 i0 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(v1, s23), _mm_mul_ps(v2, s13)), _mm_mul_ps(v3, s12)));
+    const __m128 i1 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(v0, s23), _mm_mul_ps(v2, s03)), _mm_mul_ps(v3, s02)));
+    const __m128 i2 = _mm_mul_ps(signA, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(v0, s13), _mm_mul_ps(v1, s03)), _mm_mul_ps(v3, s01)));
+    const __m128 i3 = _mm_mul_ps(signB, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(v0, s12), _mm_mul_ps(v1, s02)), _mm_mul_ps(v2, s01)));
+
+    // determinant is the dot product of the first column with the first row of the adjugate
+    const __m128 row0 = _mm_shuffle_ps(_mm_shuffle_ps(i0, i1, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(i2, i3, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    alignas(16) float products[4];
+    _mm_store_ps(products, _mm_mul_ps(c0, row0));
+    const float det = (products[0] + products[1]) + (products[2] + products[3]);
+
+    if (det == 0.0f) return mat4(std::numeric_limits<float>::quiet_NaN()); // could use signaling_NaN()
+
+    const __m128 inv_det = _mm_set1_ps(1.0f / det);
+
+    mat4 result;
+    _mm_storeu_ps(result[0].data(), _mm_mul_ps(i0, inv_det));
+    _mm_storeu_ps(result[1].data(), _mm_mul_ps(i1, inv_det));
+    _mm_storeu_ps(result[2].data(), _mm_mul_ps(i2, inv_det));
+    _mm_storeu_ps(result[3].data(), _mm_mul_ps(i3, inv_det));
+    return result;
+}
+#endif
+
 mat4 vsg::inverse_4x4(const mat4& m)
 {
+#if defined(VSG_SIMD_SSE2)
+    return sse_inverse_4x4(m);
+#else
     return t_inverse_4x4(m);
+#endif
 }
 
 mat4 vsg::inverse(const mat4& m)
@@ -175,7 +248,7 @@ mat4 vsg::inverse(const mat4& m)
     }
     else
     {
-        return t_inverse_4x4(m);
+        return inverse_4x4(m);
     }
 }
 
@@ -231,6 +304,158 @@ double vsg::determinant(const dmat4& m)
     return t_determinant<double>(m);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// batched transform of points, the SIMD paths compute matrix[0] * x + matrix[1] * y + matrix[2] * z + matrix[3] with the same
+// multiply/add ordering as t_mat4 * t_vec3 so give the same results as the scalar fallback.
+//
+template<typename M, typename S, typename D>
+void t_transform(const M& matrix, const S* src, D* dest, size_t count)
+{
+    using vec_type = t_vec3<typename M::value_type>;
+    for (size_t i = 0; i < count; ++i)
+    {
+        dest[i] = D(matrix * vec_type(src[i]));
+    }
+}
+
+#if defined(VSG_SIMD_SSE2) || (defined(VSG_SIMD_NEON) && defined(__aarch64__))
+#    define VSG_SIMD_TRANSFORM_DOUBLE 1
+template<typename S, typename D>
+void simd_transform(const dmat4& matrix, const S* src, D* dest, size_t count)
+{
+    alignas(32) double r[4];
+#    if defined(VSG_SIMD_AVX)
+    const __m256d c0 = _mm256_loadu_pd(matrix[0].data());
+    const __m256d c1 = _mm256_loadu_pd(matrix[1].data());
+    const __m256d c2 = _mm256_loadu_pd(matrix[2].data());
+    const __m256d c3 = _mm256_loadu_pd(matrix[3].data());
+    for (size_t i = 0; i < count; ++i)
+    {
+        const S& v = src[i];
+        __m256d p = _mm256_mul_pd(c0, _mm256_set1_pd(v.x));
+        p = _mm256_add_pd(p, _mm256_mul_pd(c1, _mm256_set1_pd(v.y)));
+        p = _mm256_add_pd(p, _mm256_mul_pd(c2, _mm256_set1_pd(v.z)));
+        _mm256_store_pd(r, _mm256_add_pd(p, c3));
+
+        double inv = 1.0 / r[3];
+        dest[i] = D(dvec3(r[0] * inv, r[1] * inv, r[2] * inv));
+    }
+#    elif defined(VSG_SIMD_SSE2)
+    const __m128d c0_xy = _mm_loadu_pd(matrix[0].data()), c0_zw = _mm_loadu_pd(matrix[0].data() + 2);
+    const __m128d c1_xy = _mm_loadu_pd(matrix[1].data()), c1_zw = _mm_loadu_pd(matrix[1].data() + 2);
+    const __m128d c2_xy = _mm_loadu_pd(matrix[2].data()), c2_zw = _mm_loadu_pd(matrix[2].data() + 2);
+    const __m128d c3_xy = _mm_loadu_pd(matrix[3].data()), c3_zw = _mm_loadu_pd(matrix[3].data() + 2);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const S& v = src[i];
+        const __m128d x = _mm_set1_pd(v.x), y = _mm_set1_pd(v.y), z = _mm_set1_pd(v.z);
+        __m128d xy = _mm_mul_pd(c0_xy, x);
+        __m128d zw = _mm_mul_pd(c0_zw, x);
+        xy = _mm_add_pd(xy, _mm_mul_pd(c1_xy, y));
+        zw = _mm_add_pd(zw, _mm_mul_pd(c1_zw, y));
+        xy = _mm_add_pd(xy, _mm_mul_pd(c2_xy, z));
+        zw = _mm_add_pd(zw, _mm_mul_pd(c2_zw, z));
+        _mm_store_pd(r, _mm_add_pd(xy, c3_xy));
+        _mm_store_pd(r + 2, _mm_add_pd(zw, c3_zw));
+
+        double inv = 1.0 / r[3];
+        dest[i] = D(dvec3(r[0] * inv, r[1] * inv, r[2] * inv));
+    }
+#    else
+    const float64x2_t c0_xy = vld1q_f64(matrix[0].data()), c0_zw = vld1q_f64(matrix[0].data() + 2);
+    const float64x2_t c1_xy = vld1q_f64(matrix[1].data()), c1_zw = vld1q_f64(matrix[1].data() + 2);
+    const float64x2_t c2_xy = vld1q_f64(matrix[2].data()), c2_zw = vld1q_f64(matrix[2].data() + 2);
+    const float64x2_t c3_xy = vld1q_f64(matrix[3].data()), c3_zw = vld1q_f64(matrix[3].data() + 2);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const S& v = src[i];
+        const double x = v.x, y = v.y, z = v.z;
+        float64x2_t xy = vmulq_n_f64(c0_xy, x);
+        float64x2_t zw = vmulq_n_f64(c0_zw, x);
+        xy = vaddq_f64(xy, vmulq_n_f64(c1_xy, y));
+        zw = vaddq_f64(zw, vmulq_n_f64(c1_zw, y));
+        xy = vaddq_f64(xy, vmulq_n_f64(c2_xy, z));
+        zw = vaddq_f64(zw, vmulq_n_f64(c2_zw, z));
+        vst1q_f64(r, vaddq_f64(xy, c3_xy));
+        vst1q_f64(r + 2, vaddq_f64(zw, c3_zw));
+
+        double inv = 1.0 / r[3];
+        dest[i] = D(dvec3(r[0] * inv, r[1] * inv, r[2] * inv));
+    }
+#    endif
+}
+#endif
+
+void vsg::transform(const mat4& matrix, const vec3* src, vec3* dest, size_t count)
+{
+#if defined(VSG_SIMD_SSE2) || defined(VSG_SIMD_NEON)
+    alignas(16) float r[4];
+#    if defined(VSG_SIMD_SSE2)
+    const __m128 c0 = _mm_loadu_ps(matrix[0].data());
+    const __m128 c1 = _mm_loadu_ps(matrix[1].data());
+    const __m128 c2 = _mm_loadu_ps(matrix[2].data());
+    const __m128 c3 = _mm_loadu_ps(matrix[3].data());
+    for (size_t i = 0; i < count; ++i)
+    {
+        const vec3& v = src[i];
+        __m128 p = _mm_mul_ps(c0, _mm_set1_ps(v.x));
+        p = _mm_add_ps(p, _mm_mul_ps(c1, _mm_set1_ps(v.y)));
+        p = _mm_add_ps(p, _mm_mul_ps(c2, _mm_set1_ps(v.z)));
+        _mm_store_ps(r, _mm_add_ps(p, c3));
+
+        float inv = 1.0f / r[3];
+        dest[i].set(r[0] * inv, r[1] * inv, r[2] * inv);
+    }
+#    else
+    const float32x4_t c0 = vld1q_f32(matrix[0].data());
+    const float32x4_t c1 = vld1q_f32(matrix[1].data());
+    const float32x4_t c2 = vld1q_f32(matrix[2].data());
+    const float32x4_t c3 = vld1q_f32(matrix[3].data());
+    for (size_t i = 0; i < count; ++i)
+    {
+        const vec3& v = src[i];
+        float32x4_t p = vmulq_n_f32(c0, v.x);
+        p = vaddq_f32(p, vmulq_n_f32(c1, v.y));
+        p = vaddq_f32(p, vmulq_n_f32(c2, v.z));
+        vst1q_f32(r, vaddq_f32(p, c3));
+
+        float inv = 1.0f / r[3];
+        dest[i].set(r[0] * inv, r[1] * inv, r[2] * inv);
+    }
+#    endif
+#else
+    t_transform(matrix, src, dest, count);
+#endif
+}
+
+void vsg::transform(const dmat4& matrix, const dvec3* src, dvec3* dest, size_t count)
+{
+#if defined(VSG_SIMD_TRANSFORM_DOUBLE)
+    simd_transform(matrix, src, dest, count);
+#else
+    t_transform(matrix, src, dest, count);
+#endif
+}
+
+void vsg::transform(const dmat4& matrix, const vec3* src, dvec3* dest, size_t count)
+{
+#if defined(VSG_SIMD_TRANSFORM_DOUBLE)
+    simd_transform(matrix, src, dest, count);
+#else
+    t_transform(matrix, src, dest, count);
+#endif
+}
+
+void vsg::transform(const dmat4& matrix, const vec3* src, vec3* dest, size_t count)
+{
+#if defined(VSG_SIMD_TRANSFORM_DOUBLE)
+    simd_transform(matrix, src, dest, count);
+#else
+    t_transform(matrix, src, dest, count);
+#endif
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 //
 /// decompose float matrix into translation, rotation and scale components.
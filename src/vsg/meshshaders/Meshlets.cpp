@@ -0,0 +1,363 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/maths/vec3.h>
+#include <vsg/meshshaders/Meshlets.h>
+#include <vsg/utils/GraphicsPipelineConfigurator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Meshlets
+//
+Meshlets::Meshlets()
+{
+}
+
+Meshlets::~Meshlets()
+{
+}
+
+void Meshlets::assignDescriptors(DescriptorConfigurator& descriptorConfigurator) const
+{
+    descriptorConfigurator.assignDescriptor("vsg_Vertices", vertices);
+    descriptorConfigurator.assignDescriptor("vsg_Normals", normals);
+    if (texCoords) descriptorConfigurator.assignDescriptor("vsg_TexCoords0", texCoords);
+    if (colors) descriptorConfigurator.assignDescriptor("vsg_Colors", colors);
+    descriptorConfigurator.assignDescriptor("vsg_Meshlets", meshlets);
+    descriptorConfigurator.assignDescriptor("vsg_MeshletVertices", vertexIndices);
+    descriptorConfigurator.assignDescriptor("vsg_MeshletTriangles", triangles);
+}
+
+ref_ptr<DrawMeshTasks> Meshlets::createDrawMeshTasks() const
+{
+    uint32_t numMeshlets = meshlets ? static_cast<uint32_t>(meshlets->size()) : 0;
+    return DrawMeshTasks::create((numMeshlets + taskWorkGroupSize - 1) / taskWorkGroupSize, 1, 1);
+}
+
+void Meshlets::read(Input& input)
+{
+    Object::read(input);
+
+    input.readObject("meshlets", meshlets);
+    input.readObject("vertexIndices", vertexIndices);
+    input.readObject("triangles", triangles);
+    input.readObject("vertices", vertices);
+    input.readObject("normals", normals);
+    input.readObject("texCoords", texCoords);
+    input.readObject("colors", colors);
+}
+
+void Meshlets::write(Output& output) const
+{
+    Object::write(output);
+
+    output.writeObject("meshlets", meshlets);
+    output.writeObject("vertexIndices", vertexIndices);
+    output.writeObject("triangles", triangles);
+    output.writeObject("vertices", vertices);
+    output.writeObject("normals", normals);
+    output.writeObject("texCoords", texCoords);
+    output.writeObject("colors", colors);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// buildMeshlets
+//
+namespace
+{
+    template<class A>
+    void readIndices(const A& source, uint32_t firstIndex, uint32_t indexCount, uint32_t vertexOffset, std::vector<uint32_t>& indices)
+    {
+        for (uint32_t i = firstIndex; i < firstIndex + indexCount; ++i) indices.push_back(source.at(i) + vertexOffset);
+    }
+
+    struct MeshletBuilder
+    {
+        MeshletBuilder(const vec3Array& in_vertices, const std::vector<uint32_t>& in_indices, uint32_t in_maxVertices, uint32_t in_maxTriangles) :
+            vertices(in_vertices),
+            indices(in_indices),
+            maxVertices(in_maxVertices),
+            maxTriangles(in_maxTriangles),
+            localIndices(in_vertices.size(), invalid)
+        {
+        }
+
+        static constexpr uint32_t invalid = std::numeric_limits<uint32_t>::max();
+
+        const vec3Array& vertices;
+        const std::vector<uint32_t>& indices;
+        uint32_t maxVertices;
+        uint32_t maxTriangles;
+
+        std::vector<uint32_t> localIndices; // index into currentVertices for vertices in the current meshlet
+        std::vector<uint32_t> currentVertices;
+        std::vector<uint32_t> currentTriangles;
+
+        std::vector<Meshlet> meshlets;
+        std::vector<uint32_t> meshletVertices;
+        std::vector<uint32_t> meshletTriangles;
+
+        uint32_t numNewVertices(uint32_t t) const
+        {
+            uint32_t count = 0;
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                if (localIndices[indices[t * 3 + i]] == invalid) ++count;
+            }
+            return count;
+        }
+
+        bool fits(uint32_t t) const
+        {
+            return currentTriangles.size() < maxTriangles && currentVertices.size() + numNewVertices(t) <= maxVertices;
+        }
+
+        void add(uint32_t t)
+        {
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                auto v = indices[t * 3 + i];
+                if (localIndices[v] == invalid)
+                {
+                    localIndices[v] = static_cast<uint32_t>(currentVertices.size());
+                    currentVertices.push_back(v);
+                }
+            }
+            currentTriangles.push_back(t);
+        }
+
+        vec3 faceNormal(uint32_t t) const
+        {
+            const auto& v0 = vertices[indices[t * 3]];
+            const auto& v1 = vertices[indices[t * 3 + 1]];
+            const auto& v2 = vertices[indices[t * 3 + 2]];
+            return cross(v1 - v0, v2 - v0);
+        }
+
+        void flush()
+        {
+            if (currentTriangles.empty()) return;
+
+            Meshlet meshlet;
+            meshlet.vertexOffset = static_cast<uint32_t>(meshletVertices.size());
+            meshlet.vertexCount = static_cast<uint32_t>(currentVertices.size());
+            meshlet.triangleOffset = static_cast<uint32_t>(meshletTriangles.size());
+            meshlet.triangleCount = static_cast<uint32_t>(currentTriangles.size());
+
+            // bounding sphere centered on the bounding box of the vertices
+            vec3 minimum = vertices[currentVertices.front()];
+            vec3 maximum = minimum;
+            for (auto v : currentVertices)
+            {
+                const auto& vertex = vertices[v];
+                minimum.set(std::min(minimum.x, vertex.x), std::min(minimum.y, vertex.y), std::min(minimum.z, vertex.z));
+                maximum.set(std::max(maximum.x, vertex.x), std::max(maximum.y, vertex.y), std::max(maximum.z, vertex.z));
+            }
+            vec3 center = (minimum + maximum) * 0.5f;
+            float radius = 0.0f;
+            for (auto v : currentVertices) radius = std::max(radius, length(vertices[v] - center));
+            meshlet.sphere.set(center.x, center.y, center.z, radius);
+
+            // normal cone, the meshlet is backfacing for all viewpoints where dot(center - eye, axis) >= cutoff * length(center - eye) + radius
+            vec3 axis;
+            for (auto t : currentTriangles)
+            {
+                auto n = faceNormal(t);
+                if (auto l = length(n); l > 0.0f) axis += n / l;
+            }
+
+            float minimumDot = 1.0f;
+            if (auto l = length(axis); l > 0.0f)
+            {
+                axis /= l;
+                for (auto t : currentTriangles)
+                {
+                    auto n = faceNormal(t);
+                    if (auto nl = length(n); nl > 0.0f) minimumDot = std::min(minimumDot, dot(axis, n / nl));
+                }
+            }
+            else
+            {
+                minimumDot = -1.0f;
+            }
+
+            // only enable backface culling when the normals are within ~84 degrees of the axis
+            float cutoff = (minimumDot <= 0.1f) ? 1.0f : std::sqrt(1.0f - minimumDot * minimumDot);
+            meshlet.cone.set(axis.x, axis.y, axis.z, cutoff);
+
+            meshlets.push_back(meshlet);
+            meshletVertices.insert(meshletVertices.end(), currentVertices.begin(), currentVertices.end());
+            for (auto t : currentTriangles)
+            {
+                uint32_t packed = localIndices[indices[t * 3]] | (localIndices[indices[t * 3 + 1]] << 8) | (localIndices[indices[t * 3 + 2]] << 16);
+                meshletTriangles.push_back(packed);
+            }
+
+            for (auto v : currentVertices) localIndices[v] = invalid;
+            currentVertices.clear();
+            currentTriangles.clear();
+        }
+
+        void build()
+        {
+            uint32_t numVertices = static_cast<uint32_t>(vertices.size());
+            uint32_t numTriangles = static_cast<uint32_t>(indices.size() / 3);
+
+            // vertex to triangle adjacency, triangles referencing vertices outside the vertex array are discarded
+            std::vector<bool> used(numTriangles, false);
+            std::vector<uint32_t> offsets(numVertices + 1, 0);
+            for (uint32_t t = 0; t < numTriangles; ++t)
+            {
+                if (indices[t * 3] >= numVertices || indices[t * 3 + 1] >= numVertices || indices[t * 3 + 2] >= numVertices)
+                {
+                    used[t] = true;
+                    continue;
+                }
+                for (uint32_t i = 0; i < 3; ++i) ++offsets[indices[t * 3 + i] + 1];
+            }
+            for (uint32_t v = 0; v < numVertices; ++v) offsets[v + 1] += offsets[v];
+
+            std::vector<uint32_t> vertexTriangles(offsets.back());
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (uint32_t t = 0; t < numTriangles; ++t)
+            {
+                if (used[t]) continue;
+                for (uint32_t i = 0; i < 3; ++i) vertexTriangles[fill[indices[t * 3 + i]]++] = t;
+            }
+
+            uint32_t seed = 0;
+            while (true)
+            {
+                // choose the unused triangle adjacent to the current meshlet that adds the fewest new vertices
+                uint32_t best = invalid;
+                uint32_t bestNewVertices = 4;
+                for (auto v : currentVertices)
+                {
+                    for (uint32_t i = offsets[v]; i < offsets[v + 1] && bestNewVertices > 0; ++i)
+                    {
+                        auto t = vertexTriangles[i];
+                        if (used[t]) continue;
+                        if (auto n = numNewVertices(t); n < bestNewVertices)
+                        {
+                            best = t;
+                            bestNewVertices = n;
+                        }
+                    }
+                    if (bestNewVertices == 0) break;
+                }
+
+                // otherwise start from the next unused triangle in index order
+                if (best == invalid)
+                {
+                    while (seed < numTriangles && used[seed]) ++seed;
+                    if (seed == numTriangles) break;
+                    best = seed;
+                }
+
+                if (!fits(best)) flush();
+
+                add(best);
+                used[best] = true;
+            }
+
+            flush();
+        }
+    };
+} // namespace
+
+ref_ptr<Meshlets> vsg::buildMeshlets(ref_ptr<vec3Array> vertices, const Data& indices, uint32_t firstIndex, uint32_t indexCount, uint32_t vertexOffset, uint32_t maxVertices, uint32_t maxTriangles)
+{
+    if (!vertices || maxVertices < 3 || maxTriangles < 1 || maxVertices > 256) return {};
+
+    indexCount = std::min(indexCount, static_cast<uint32_t>(indices.valueCount()) - std::min(firstIndex, static_cast<uint32_t>(indices.valueCount())));
+    indexCount -= indexCount % 3;
+
+    std::vector<uint32_t> triangleIndices;
+    triangleIndices.reserve(indexCount);
+    if (auto us = indices.cast<ushortArray>())
+        readIndices(*us, firstIndex, indexCount, vertexOffset, triangleIndices);
+    else if (auto ui = indices.cast<uintArray>())
+        readIndices(*ui, firstIndex, indexCount, vertexOffset, triangleIndices);
+    else
+        return {};
+
+    MeshletBuilder builder(*vertices, triangleIndices, maxVertices, maxTriangles);
+    builder.build();
+
+    auto meshlets = Meshlets::create();
+    meshlets->vertices = vertices;
+
+    // area weighted vertex normals, replaced by the VertexIndexDraw normals when available
+    auto normals = vec3Array::create(static_cast<uint32_t>(vertices->size()), vec3(0.0f, 0.0f, 0.0f));
+    for (auto& meshlet : builder.meshlets)
+    {
+        for (uint32_t i = meshlet.triangleOffset; i < meshlet.triangleOffset + meshlet.triangleCount; ++i)
+        {
+            auto packed = builder.meshletTriangles[i];
+            uint32_t v0 = builder.meshletVertices[meshlet.vertexOffset + (packed & 0xff)];
+            uint32_t v1 = builder.meshletVertices[meshlet.vertexOffset + ((packed >> 8) & 0xff)];
+            uint32_t v2 = builder.meshletVertices[meshlet.vertexOffset + ((packed >> 16) & 0xff)];
+            auto n = cross(vertices->at(v1) - vertices->at(v0), vertices->at(v2) - vertices->at(v0));
+            normals->at(v0) += n;
+            normals->at(v1) += n;
+            normals->at(v2) += n;
+        }
+    }
+    for (auto& n : *normals)
+    {
+        if (auto l = length(n); l > 0.0f) n /= l;
+    }
+    meshlets->normals = normals;
+
+    meshlets->meshlets = MeshletArray::create(static_cast<uint32_t>(builder.meshlets.size()));
+    for (size_t i = 0; i < builder.meshlets.size(); ++i) meshlets->meshlets->at(i) = builder.meshlets[i];
+
+    meshlets->vertexIndices = uintArray::create(static_cast<uint32_t>(builder.meshletVertices.size()));
+    for (size_t i = 0; i < builder.meshletVertices.size(); ++i) meshlets->vertexIndices->at(i) = builder.meshletVertices[i];
+
+    meshlets->triangles = uintArray::create(static_cast<uint32_t>(builder.meshletTriangles.size()));
+    for (size_t i = 0; i < builder.meshletTriangles.size(); ++i) meshlets->triangles->at(i) = builder.meshletTriangles[i];
+
+    return meshlets;
+}
+
+ref_ptr<Meshlets> vsg::buildMeshlets(const VertexIndexDraw& vid, uint32_t maxVertices, uint32_t maxTriangles)
+{
+    if (vid.arrays.empty() || !vid.arrays[0] || !vid.indices || !vid.indices->data) return {};
+
+    auto vertices = vid.arrays[0]->data.cast<vec3Array>();
+    if (!vertices) return {};
+
+    auto meshlets = buildMeshlets(vertices, *vid.indices->data, vid.firstIndex, vid.indexCount, vid.vertexOffset, maxVertices, maxTriangles);
+    if (!meshlets) return {};
+
+    auto perVertex = [&](size_t i) -> ref_ptr<Data> {
+        if (i < vid.arrays.size() && vid.arrays[i] && vid.arrays[i]->data && vid.arrays[i]->data->valueCount() == vertices->valueCount()) return vid.arrays[i]->data;
+        return {};
+    };
+
+    if (auto normals = perVertex(1).cast<vec3Array>()) meshlets->normals = normals;
+    meshlets->texCoords = perVertex(2).cast<vec2Array>();
+    meshlets->colors = perVertex(3).cast<vec4Array>();
+
+    return meshlets;
+}
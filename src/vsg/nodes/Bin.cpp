@@ -11,13 +11,82 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/io/Logger.h>
+#include <vsg/core/ScratchMemory.h>
 #include <vsg/nodes/Bin.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/nodes/VertexIndexDraw.h>
 #include <vsg/vk/State.h>
 
 #include <algorithm>
+#include <cstring>
+#include <unordered_map>
 
 using namespace vsg;
 
+namespace
+{
+    // map float to uint32_t so that unsigned integer ordering matches floating point ordering.
+    inline uint32_t sortable_bits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    // least significant digit radix sort of key/index pairs, 8 bits per pass, skipping passes where all the keys share the same digit.
+    template<typename K>
+    void radix_sort(std::vector<std::pair<K, uint32_t>>& keys, std::vector<std::pair<K, uint32_t>>& scratch, size_t numBits)
+    {
+        const size_t n = keys.size();
+        scratch.resize(n);
+
+        auto src = keys.data();
+        auto dst = scratch.data();
+
+        for (size_t shift = 0; shift < numBits; shift += 8)
+        {
+            size_t offsets[256] = {};
+            for (size_t i = 0; i < n; ++i) ++offsets[(src[i].first >> shift) & 0xff];
+
+            if (offsets[(src[0].first >> shift) & 0xff] == n) continue;
+
+            size_t sum = 0;
+            for (auto& offset : offsets)
+            {
+                size_t count = offset;
+                offset = sum;
+                sum += count;
+            }
+
+            for (size_t i = 0; i < n; ++i) dst[offsets[(src[i].first >> shift) & 0xff]++] = src[i];
+
+            std::swap(src, dst);
+        }
+
+        if (src != keys.data()) std::copy(src, src + n, keys.data());
+    }
+
+    // the buffer holding the first vertex array of a draw, used to group draws that share vertex buffers
+    inline const void* vertexBufferKey(const Node* node)
+    {
+        if (auto vid = node->cast<VertexIndexDraw>(); vid && !vid->arrays.empty() && vid->arrays.front()) return vid->arrays.front()->buffer.get();
+        if (auto geometry = node->cast<Geometry>(); geometry && !geometry->arrays.empty() && geometry->arrays.front()) return geometry->arrays.front()->buffer.get();
+        if (auto vd = node->cast<VertexDraw>(); vd && !vd->arrays.empty() && vd->arrays.front()) return vd->arrays.front()->buffer.get();
+        return node;
+    }
+
+    // id maps used by the STATE_SORT, allocated from the RecordTraversal's frame scoped ScratchMemory
+    template<typename K>
+    using IDMap = std::unordered_map<K, uint32_t, std::hash<K>, std::equal_to<K>, ScratchAllocator<std::pair<const K, uint32_t>>>;
+
+    template<typename K>
+    inline uint64_t assignID(IDMap<K>& ids, const K& key)
+    {
+        return ids.emplace(key, static_cast<uint32_t>(ids.size())).first->second;
+    }
+} // namespace
+
 Bin::Bin()
 {
 }
@@ -52,42 +121,132 @@ int Bin::compare(const Object& rhs_object) const
 void Bin::clear()
 {
     _matrices.clear();
+    _matrixID = 0;
     _stateCommands.clear();
     _elements.clear();
     _binElements.clear();
 }
 
-void Bin::add(State* state, double value, const Node* node)
+void Bin::_sort(ScratchMemory* scratchMemory) const
 {
-    //debug("Bin::add(state= ", state, ", value = ", value, ", ", node, ") ", this, ", binNumber = ", binNumber, ",  binElements.size()=", _binElements.size());
+    // small bins don't benefit from the radix sort
+    const size_t minimumRadixSortSize = 64;
 
-    Element element;
+    if (sortOrder == NO_SORT || _binElements.size() < 2)
+    {
+        _previousOrder.clear();
+        return;
+    }
 
-    const auto& mv = state->modelviewMatrixStack.top();
-#if 1
-    if (_matrices.empty())
+    _sortKeys.clear();
+    _sortKeys.reserve(_binElements.size());
+
+    if (sortOrder == STATE_SORT)
     {
-        element.matrixIndex = static_cast<uint32_t>(_matrices.size());
-        _matrices.push_back(mv);
+        // 64 bit key packing, from most to least significant: pipeline 12 bits, other state 16 bits, vertex buffer 12 bits, value 24 bits.
+        // ids are assigned in order of first occurrence, ids beyond the available bits share the last id, this only affects the grouping not correctness.
+        IDMap<const void*> pipelineIDs(scratchMemory);
+        IDMap<size_t> stateIDs(scratchMemory);
+        IDMap<const void*> vertexBufferIDs(scratchMemory);
+
+        for (uint32_t i = 0; i < static_cast<uint32_t>(_binElements.size()); ++i)
+        {
+            const auto& [value, elementIndex] = _binElements[i];
+            const auto& element = _elements[elementIndex];
+
+            const StateCommand* pipeline = nullptr;
+            size_t stateHash = 0;
+            auto itr = _stateCommands.begin() + element.stateCommandIndex;
+            for (uint32_t c = 0; c < element.stateCommandCount; ++c, ++itr)
+            {
+                if ((*itr)->slot == 0)
+                    pipeline = *itr;
+                else
+                    stateHash ^= std::hash<const void*>{}(*itr) + 0x9e3779b9 + (stateHash << 6) + (stateHash >> 2);
+            }
+
+            uint64_t pipelineID = std::min(assignID<const void*>(pipelineIDs, pipeline), uint64_t(0xfff));
+            uint64_t stateID = std::min(assignID<size_t>(stateIDs, stateHash), uint64_t(0xffff));
+            uint64_t vertexBufferID = std::min(assignID<const void*>(vertexBufferIDs, vertexBufferKey(element.child)), uint64_t(0xfff));
+            uint64_t valueBits = sortable_bits(value) >> 8;
+
+            _sortKeys.emplace_back((pipelineID << 52) | (stateID << 36) | (vertexBufferID << 24) | valueBits, i);
+        }
+
+        radix_sort(_sortKeys, _sortScratch, 64);
     }
     else
     {
-        if (_matrices.back() == mv)
+        const auto numElements = static_cast<uint32_t>(_binElements.size());
+        const uint32_t flip = (sortOrder == DESCENDING) ? 0xffffffffu : 0u;
+
+        bool sorted = false;
+        if (_previousOrder.size() == numElements)
         {
-            //debug("reoccurring ");
-            element.matrixIndex = static_cast<uint32_t>(_matrices.size()) - 1;
+            // start from the previous frame's order, which for a camera moving smoothly is nearly sorted, and complete it with an insertion sort.
+            // Give up on the insertion sort if it needs more moves than a radix sort would cost, leaving _sortKeys a valid permutation for the radix sort.
+            for (auto position : _previousOrder) _sortKeys.emplace_back(sortable_bits(_binElements[position].first) ^ flip, position);
+
+            size_t maximumMoves = std::max(size_t(numElements) * 4, minimumRadixSortSize * minimumRadixSortSize);
+            size_t numMoves = 0;
+            for (size_t i = 1; i < _sortKeys.size() && numMoves <= maximumMoves; ++i)
+            {
+                auto sortKey = _sortKeys[i];
+                size_t j = i;
+                for (; j > 0 && sortKey.first < _sortKeys[j - 1].first; --j) _sortKeys[j] = _sortKeys[j - 1];
+                _sortKeys[j] = sortKey;
+                numMoves += i - j;
+            }
+            sorted = numMoves <= maximumMoves;
         }
         else
         {
-            //debug("new ");
-            element.matrixIndex = static_cast<uint32_t>(_matrices.size());
+            for (uint32_t i = 0; i < numElements; ++i) _sortKeys.emplace_back(sortable_bits(_binElements[i].first) ^ flip, i);
+        }
+
+        if (!sorted)
+        {
+            if (_sortKeys.size() < minimumRadixSortSize)
+                std::sort(_sortKeys.begin(), _sortKeys.end(), [](const SortKey& lhs, const SortKey& rhs) { return lhs.first < rhs.first; });
+            else
+                radix_sort(_sortKeys, _sortScratch, 32);
+        }
+
+        _previousOrder.resize(numElements);
+        for (uint32_t i = 0; i < numElements; ++i) _previousOrder[i] = _sortKeys[i].second;
+    }
+
+    _sortedBinElements.clear();
+    _sortedBinElements.reserve(_binElements.size());
+    for (const auto& sortKey : _sortKeys)
+    {
+        _sortedBinElements.push_back(_binElements[sortKey.second]);
+    }
+    _binElements.swap(_sortedBinElements);
+}
+
+void Bin::add(State* state, double value, const Node* node)
+{
+    //debug("Bin::add(state= ", state, ", value = ", value, ", ", node, ") ", this, ", binNumber = ", binNumber, ",  binElements.size()=", _binElements.size());
+
+    Element element;
+
+    // elements under the same transform share the matrix, checking the MatrixStack's id first avoids comparing the dmat4 for the common case.
+    auto matrixID = state->modelviewMatrixStack.topID();
+    if (!_matrices.empty() && matrixID != 0 && matrixID == _matrixID)
+    {
+        element.matrixIndex = static_cast<uint32_t>(_matrices.size()) - 1;
+    }
+    else
+    {
+        const auto& mv = state->modelviewMatrixStack.top();
+        if (_matrices.empty() || _matrices.back() != mv)
+        {
             _matrices.push_back(mv);
         }
+        element.matrixIndex = static_cast<uint32_t>(_matrices.size()) - 1;
+        _matrixID = matrixID;
     }
-#else
-    element.matrixIndex = _matrices.size();
-    _matrices.push_back(mv);
-#endif
 
     element.stateCommandIndex = static_cast<uint32_t>(_stateCommands.size());
     for (const auto& stateStack : state->stateStacks)
@@ -106,23 +265,36 @@ void Bin::add(State* state, double value, const Node* node)
     _elements.push_back(element);
 }
 
+void Bin::add(const Bin& bin)
+{
+    auto matrixOffset = static_cast<uint32_t>(_matrices.size());
+    auto stateCommandOffset = static_cast<uint32_t>(_stateCommands.size());
+    auto elementOffset = static_cast<uint32_t>(_elements.size());
+
+    _matrices.insert(_matrices.end(), bin._matrices.begin(), bin._matrices.end());
+    _matrixID = 0;
+    _stateCommands.insert(_stateCommands.end(), bin._stateCommands.begin(), bin._stateCommands.end());
+
+    for (auto element : bin._elements)
+    {
+        element.matrixIndex += matrixOffset;
+        element.stateCommandIndex += stateCommandOffset;
+        _elements.push_back(element);
+    }
+
+    for (const auto& [value, index] : bin._binElements)
+    {
+        _binElements.emplace_back(value, index + elementOffset);
+    }
+}
+
 void Bin::traverse(RecordTraversal& rt) const
 {
     //debug("Bin::traverse(RecordTraversal& visitor) ", sortOrder, " ", _binElements.size());
 
     auto state = rt.getState();
 
-    switch (sortOrder)
-    {
-    case (ASCENDING):
-        std::sort(_binElements.begin(), _binElements.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return lhs.first < rhs.first; });
-        break;
-    case (DESCENDING):
-        std::sort(_binElements.begin(), _binElements.end(), [](const KeyIndex& lhs, const KeyIndex& rhs) { return rhs.first < lhs.first; });
-        break;
-    case (NO_SORT):
-        break;
-    }
+    _sort(rt.scratchMemory.get());
 
     uint32_t previousMatrixIndex = static_cast<uint32_t>(_matrices.size());
     //uint32_t previousStateCommandIndex = _stateCommands.size();
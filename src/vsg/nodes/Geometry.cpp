@@ -55,6 +55,8 @@ int Geometry::compare(const Object& rhs_object) const
 
 void Geometry::assignArrays(const DataList& arrayData)
 {
+    cachedBounds.reset();
+
     arrays.clear();
     arrays.reserve(arrayData.size());
     for (auto& data : arrayData)
@@ -65,6 +67,8 @@ void Geometry::assignArrays(const DataList& arrayData)
 
 void Geometry::assignIndices(ref_ptr<vsg::Data> indexData)
 {
+    cachedBounds.reset();
+
     if (indexData)
     {
         indices = BufferInfo::create(indexData);
@@ -0,0 +1,425 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Input.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/Group.h>
+#include <vsg/nodes/InstanceCulling.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
+
+using namespace vsg;
+
+namespace
+{
+    const uint32_t s_workgroupSize = 64;
+
+    // matches the PushConstants block in the culling compute shader, kept within the 128 bytes guaranteed by Vulkan.
+    struct CullingPushConstants
+    {
+        vec4 planes[5];
+        vec4 lodScale;
+        vec4 bound;
+        uint32_t firstInstance;
+        uint32_t instanceCount;
+        float minimumScreenHeightRatio;
+        uint32_t padding;
+    };
+
+    const char* s_cullingSource = R"(#version 450
+
+#pragma import_defines (VSG_TRANSLATIONS, VSG_ROTATIONS, VSG_SCALES, VSG_COLORS, VSG_LEVELS)
+
+layout(local_size_x = 64) in;
+
+layout(constant_id = 0) const uint numColorComponents = 4;
+layout(constant_id = 1) const uint numLevels = 1;
+
+layout(push_constant) uniform PushConstants {
+    vec4 planes[5];
+    vec4 lodScale;
+    vec4 bound;
+    uint firstInstance;
+    uint instanceCount;
+    float minimumScreenHeightRatio;
+} pc;
+
+struct DrawIndexedIndirectCommand
+{
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+// one draw command per level, the firstInstance of each level's draw command is the start of its range in the compacted arrays
+layout(set = 0, binding = 0) buffer DrawCommands { DrawIndexedIndirectCommand drawCommands[]; };
+
+#ifdef VSG_LEVELS
+layout(set = 0, binding = 9) readonly buffer LevelRatios { float levelRatios[]; };
+#endif
+
+// per instance arrays are accessed as float arrays to match the tightly packed vsg::vec3Array/vec4Array layouts
+#ifdef VSG_TRANSLATIONS
+layout(set = 0, binding = 1) readonly buffer SourceTranslations { float sourceTranslations[]; };
+layout(set = 0, binding = 2) writeonly buffer CulledTranslations { float culledTranslations[]; };
+#endif
+
+#ifdef VSG_ROTATIONS
+layout(set = 0, binding = 3) readonly buffer SourceRotations { float sourceRotations[]; };
+layout(set = 0, binding = 4) writeonly buffer CulledRotations { float culledRotations[]; };
+#endif
+
+#ifdef VSG_SCALES
+layout(set = 0, binding = 5) readonly buffer SourceScales { float sourceScales[]; };
+layout(set = 0, binding = 6) writeonly buffer CulledScales { float culledScales[]; };
+#endif
+
+#ifdef VSG_COLORS
+layout(set = 0, binding = 7) readonly buffer SourceColors { float sourceColors[]; };
+layout(set = 0, binding = 8) writeonly buffer CulledColors { float culledColors[]; };
+#endif
+
+void main()
+{
+    if (gl_GlobalInvocationID.x >= pc.instanceCount) return;
+
+    uint source = pc.firstInstance + gl_GlobalInvocationID.x;
+
+    vec3 center = pc.bound.xyz;
+    float radius = pc.bound.w;
+
+#ifdef VSG_SCALES
+    vec3 scale = vec3(sourceScales[source * 3], sourceScales[source * 3 + 1], sourceScales[source * 3 + 2]);
+    center *= scale;
+    radius *= max(abs(scale.x), max(abs(scale.y), abs(scale.z)));
+#endif
+
+#ifdef VSG_ROTATIONS
+    vec4 rotation = vec4(sourceRotations[source * 4], sourceRotations[source * 4 + 1], sourceRotations[source * 4 + 2], sourceRotations[source * 4 + 3]);
+    center += 2.0 * cross(rotation.xyz, cross(rotation.xyz, center) + rotation.w * center);
+#endif
+
+#ifdef VSG_TRANSLATIONS
+    center += vec3(sourceTranslations[source * 3], sourceTranslations[source * 3 + 1], sourceTranslations[source * 3 + 2]);
+#endif
+
+    for (int i = 0; i < 5; ++i)
+    {
+        if (dot(pc.planes[i].xyz, center) + pc.planes[i].w < -radius) return;
+    }
+
+    uint level = 0;
+#ifdef VSG_LEVELS
+    float lodDistance = abs(dot(pc.lodScale.xyz, center) + pc.lodScale.w);
+    while (level < numLevels && radius <= lodDistance * levelRatios[level]) ++level;
+    if (level == numLevels) return;
+#else
+    if (pc.minimumScreenHeightRatio > 0.0)
+    {
+        float lodDistance = abs(dot(pc.lodScale.xyz, center) + pc.lodScale.w);
+        if (radius <= lodDistance * pc.minimumScreenHeightRatio) return;
+    }
+#endif
+
+    uint culled = drawCommands[level].firstInstance + atomicAdd(drawCommands[level].instanceCount, 1);
+
+#ifdef VSG_TRANSLATIONS
+    for (uint c = 0; c < 3; ++c) culledTranslations[culled * 3 + c] = sourceTranslations[source * 3 + c];
+#endif
+
+#ifdef VSG_ROTATIONS
+    for (uint c = 0; c < 4; ++c) culledRotations[culled * 4 + c] = sourceRotations[source * 4 + c];
+#endif
+
+#ifdef VSG_SCALES
+    for (uint c = 0; c < 3; ++c) culledScales[culled * 3 + c] = sourceScales[source * 3 + c];
+#endif
+
+#ifdef VSG_COLORS
+    for (uint c = 0; c < numColorComponents; ++c) culledColors[culled * numColorComponents + c] = sourceColors[source * numColorComponents + c];
+#endif
+}
+)";
+
+} // namespace
+
+InstanceCulling::InstanceCulling()
+{
+}
+
+InstanceCulling::InstanceCulling(ref_ptr<InstanceNode> in_instanceNode, ref_ptr<InstanceDrawIndexedIndirect> in_draw, const dsphere& in_bound, ref_ptr<Camera> in_camera) :
+    instanceNode(in_instanceNode),
+    draw(in_draw),
+    bound(in_bound),
+    camera(in_camera)
+{
+    init();
+}
+
+InstanceCulling::~InstanceCulling()
+{
+}
+
+void InstanceCulling::init()
+{
+    _sourceArrays.clear();
+    _culledArrays.clear();
+
+    if (!instanceNode) return;
+
+    uint32_t instanceCount = instanceNode->instanceCount;
+
+    _numLevels = levels.empty() ? 1 : static_cast<uint32_t>(levels.size());
+
+    culledInstanceNode = InstanceNode::create();
+    culledInstanceNode->firstInstance = 0;
+    culledInstanceNode->instanceCount = instanceCount;
+    if (levels.empty())
+    {
+        culledInstanceNode->child = instanceNode->child;
+    }
+    else
+    {
+        auto group = Group::create();
+        for (auto& level : levels)
+        {
+            if (level.child) group->addChild(level.child);
+        }
+        culledInstanceNode->child = group;
+    }
+
+    VkShaderStageFlags stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    auto shaderHints = ShaderCompileSettings::create();
+
+    DescriptorSetLayoutBindings bindings;
+    Descriptors descriptors;
+
+    const VkDeviceSize commandSize = sizeof(VkDrawIndexedIndirectCommand);
+    drawCommand = BufferInfo::create(Buffer::create(commandSize * _numLevels, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE), 0, commandSize * _numLevels);
+    bindings.push_back(VkDescriptorSetLayoutBinding{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr});
+    descriptors.push_back(DescriptorBuffer::create(BufferInfoList{drawCommand}, 0, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+
+    if (levels.empty())
+    {
+        if (draw) draw->indirect = drawCommand;
+    }
+    else
+    {
+        // each level draws from its own draw command in the shared buffer
+        for (uint32_t i = 0; i < _numLevels; ++i)
+        {
+            if (levels[i].draw) levels[i].draw->indirect = BufferInfo::create(drawCommand->buffer, commandSize * i, commandSize);
+        }
+
+        auto levelRatios = floatArray::create(_numLevels);
+        for (uint32_t i = 0; i < _numLevels; ++i) levelRatios->at(i) = static_cast<float>(levels[i].minimumScreenHeightRatio);
+
+        auto levelRatiosInfo = BufferInfo::create(levelRatios);
+        shaderHints->defines.insert("VSG_LEVELS");
+        bindings.push_back(VkDescriptorSetLayoutBinding{9, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr});
+        descriptors.push_back(DescriptorBuffer::create(BufferInfoList{levelRatiosInfo}, 9, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+        _sourceArrays.push_back(levelRatiosInfo);
+    }
+
+    // each level is assigned its own range of instanceCount entries in the compacted arrays
+    auto assignArray = [&](const ref_ptr<BufferInfo>& source, const char* define, uint32_t binding) -> ref_ptr<BufferInfo> {
+        if (!source || !source->data) return {};
+
+        VkDeviceSize size = source->data->valueSize() * instanceCount * _numLevels;
+        auto culled = BufferInfo::create(Buffer::create(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE), 0, size);
+
+        shaderHints->defines.insert(define);
+
+        bindings.push_back(VkDescriptorSetLayoutBinding{binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr});
+        bindings.push_back(VkDescriptorSetLayoutBinding{binding + 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr});
+        descriptors.push_back(DescriptorBuffer::create(BufferInfoList{source}, binding, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+        descriptors.push_back(DescriptorBuffer::create(BufferInfoList{culled}, binding + 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+
+        _sourceArrays.push_back(source);
+        _culledArrays.push_back(culled);
+
+        return culled;
+    };
+
+    culledInstanceNode->translations = assignArray(instanceNode->translations, "VSG_TRANSLATIONS", 1);
+    culledInstanceNode->rotations = assignArray(instanceNode->rotations, "VSG_ROTATIONS", 3);
+    culledInstanceNode->scales = assignArray(instanceNode->scales, "VSG_SCALES", 5);
+    culledInstanceNode->colors = assignArray(instanceNode->colors, "VSG_COLORS", 7);
+
+    uint32_t numColorComponents = (instanceNode->colors && instanceNode->colors->data) ? static_cast<uint32_t>(instanceNode->colors->data->valueSize() / sizeof(float)) : 4;
+
+    auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", s_cullingSource, shaderHints);
+    computeShader->specializationConstants[0] = uintValue::create(numColorComponents);
+    computeShader->specializationConstants[1] = uintValue::create(_numLevels);
+
+    auto descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    _pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{descriptorSetLayout}, PushConstantRanges{{stageFlags, 0, static_cast<uint32_t>(sizeof(CullingPushConstants))}});
+
+    _bindComputePipeline = BindComputePipeline::create(ComputePipeline::create(_pipelineLayout, computeShader));
+    _bindDescriptorSet = BindDescriptorSet::create(VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout, 0, DescriptorSet::create(descriptorSetLayout, descriptors));
+}
+
+void InstanceCulling::read(Input& input)
+{
+    Command::read(input);
+
+    input.readObject("instanceNode", instanceNode);
+    input.readObject("draw", draw);
+    input.read("bound", bound);
+    input.readObject("camera", camera);
+    input.read("matrix", matrix);
+    input.read("minimumScreenHeightRatio", minimumScreenHeightRatio);
+
+    if (input.version_greater_equal(1, 1, 22))
+    {
+        levels.resize(input.readValue<uint32_t>("levels"));
+        for (auto& level : levels)
+        {
+            input.read("minimumScreenHeightRatio", level.minimumScreenHeightRatio);
+            input.read("child", level.child);
+            input.read("draw", level.draw);
+        }
+    }
+    else
+    {
+        levels.clear();
+    }
+
+    init();
+}
+
+void InstanceCulling::write(Output& output) const
+{
+    Command::write(output);
+
+    output.writeObject("instanceNode", instanceNode);
+    output.writeObject("draw", draw);
+    output.write("bound", bound);
+    output.writeObject("camera", camera);
+    output.write("matrix", matrix);
+    output.write("minimumScreenHeightRatio", minimumScreenHeightRatio);
+
+    if (output.version_greater_equal(1, 1, 22))
+    {
+        output.writeValue<uint32_t>("levels", levels.size());
+        for (auto& level : levels)
+        {
+            output.write("minimumScreenHeightRatio", level.minimumScreenHeightRatio);
+            output.write("child", level.child);
+            output.write("draw", level.draw);
+        }
+    }
+}
+
+void InstanceCulling::compile(Context& context)
+{
+    if (!_bindComputePipeline) return;
+
+    auto deviceID = context.deviceID;
+
+    bool requiresCreateAndCopy = false;
+    for (auto& source : _sourceArrays)
+    {
+        if (source->requiresCopy(deviceID)) requiresCreateAndCopy = true;
+    }
+
+    if (requiresCreateAndCopy)
+    {
+        createBufferAndTransferData(context, _sourceArrays, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE);
+    }
+
+    // the compacted arrays and draw command are only ever written on the GPU so can be placed in device local memory
+    auto allocate = [&](BufferInfo& bufferInfo) -> void {
+        auto& buffer = bufferInfo.buffer;
+        buffer->compile(context.device);
+        if (buffer->getDeviceMemory(deviceID) == nullptr)
+        {
+            auto memRequirements = buffer->getMemoryRequirements(deviceID);
+            auto [deviceMemory, offset] = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            if (!deviceMemory)
+            {
+                throw Exception{"Error: InstanceCulling::compile(..) failed to allocate buffer from deviceMemoryBufferPools.", VK_ERROR_OUT_OF_DEVICE_MEMORY};
+            }
+            buffer->bind(deviceMemory, offset);
+        }
+    };
+
+    allocate(*drawCommand);
+    for (auto& culled : _culledArrays) allocate(*culled);
+
+    _bindComputePipeline->compile(context);
+    _bindDescriptorSet->compile(context);
+}
+
+void InstanceCulling::record(CommandBuffer& commandBuffer) const
+{
+    if (!_bindComputePipeline || (levels.empty() && !draw) || !camera || culledInstanceNode->instanceCount == 0) return;
+
+    auto deviceID = commandBuffer.deviceID;
+    VkCommandBuffer cmdBuffer{commandBuffer};
+
+    // compute the view frustum in the local coordinate frame of the instances, matching how vsg::State sets up the frustum for CPU culling
+    auto projection = camera->projectionMatrix->transform();
+    auto modelview = camera->viewMatrix->transform() * matrix;
+
+    Frustum frustumUnit;
+    Frustum frustumProjected(frustumUnit, projection);
+    Frustum frustum(frustumProjected, modelview);
+    frustum.computeLodScale(projection, modelview);
+
+    CullingPushConstants pushConstants;
+    for (int i = 0; i < 5; ++i)
+    {
+        pushConstants.planes[i] = (i < POLYTOPE_SIZE) ? vec4(frustum.face[i].vec) : vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+    pushConstants.lodScale = vec4(frustum.lodScale);
+    pushConstants.bound = vec4(bound.vec);
+    pushConstants.firstInstance = instanceNode->firstInstance;
+    pushConstants.instanceCount = culledInstanceNode->instanceCount;
+    pushConstants.minimumScreenHeightRatio = static_cast<float>(minimumScreenHeightRatio);
+    pushConstants.padding = 0;
+
+    // wait for previous frames reading the draw command and compacted arrays before overwriting them
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+    // reset the instanceCounts, the compute shader increments them for each visible instance
+    std::vector<VkDrawIndexedIndirectCommand> drawCommands(_numLevels);
+
+    for (uint32_t i = 0; i < _numLevels; ++i)
+    {
+        auto levelDraw = levels.empty() ? draw.get() : levels[i].draw.get();
+        uint32_t firstInstance = i * culledInstanceNode->instanceCount;
+        if (levelDraw)
+            drawCommands[i] = VkDrawIndexedIndirectCommand{levelDraw->indexCount, 0, levelDraw->firstIndex, static_cast<int32_t>(levelDraw->vertexOffset), firstInstance};
+        else
+            drawCommands[i] = VkDrawIndexedIndirectCommand{0, 0, 0, 0, firstInstance};
+    }
+    vkCmdUpdateBuffer(cmdBuffer, drawCommand->buffer->vk(deviceID), drawCommand->offset, sizeof(VkDrawIndexedIndirectCommand) * _numLevels, drawCommands.data());
+
+    VkMemoryBarrier resetBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT};
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &resetBarrier, 0, nullptr, 0, nullptr);
+
+    _bindComputePipeline->record(commandBuffer);
+    _bindDescriptorSet->record(commandBuffer);
+    vkCmdPushConstants(cmdBuffer, _pipelineLayout->vk(deviceID), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+    vkCmdDispatch(cmdBuffer, (pushConstants.instanceCount + s_workgroupSize - 1) / s_workgroupSize, 1, 1);
+
+    VkMemoryBarrier cullBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT};
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+
+    // compute pipeline and pipeline layout have been bound outside of vsg::State so force state to be reapplied
+    if (commandBuffer.state) commandBuffer.state->dirtyStateStacks();
+}
@@ -164,13 +164,13 @@ void InstanceDrawIndexed::compile(Context& context)
     }
 }
 
-void InstanceDrawIndexed::record(CommandBuffer& commandBuffer) const
+const InstanceNode* InstanceDrawIndexed::bindArraysAndIndices(CommandBuffer& commandBuffer) const
 {
     auto instanceNode = commandBuffer.instanceNode;
     if (!instanceNode)
     {
         vsg::info("InstanceDrawIndexed::record() required vsg::InstanceNode not provided.");
-        return;
+        return nullptr;
     }
 
     auto deviceID = commandBuffer.deviceID;
@@ -200,8 +200,17 @@ void InstanceDrawIndexed::record(CommandBuffer& commandBuffer) const
     // TODO: will need to get the values to apply by combing the inherited InstanceNode values with local arrays
     vkCmdBindVertexBuffers(cmdBuffer, firstBinding, static_cast<uint32_t>(vkBuffers.size()), vkBuffers.data(), offsets.data());
 
-    // vsg::info("InstanceDrawIndexed::record(CommandBuffer& commandBuffer) vkCmdDrawIndexed vkBuffers.size() = ", vkBuffers.size(), ", indexCount = ", indexCount, ", instanceNode->instanceCount = ", instanceNode->instanceCount);
-
     vkCmdBindIndexBuffer(cmdBuffer, indices->buffer->vk(deviceID), indices->offset, indexType);
-    vkCmdDrawIndexed(cmdBuffer, indexCount, instanceNode->instanceCount, firstIndex, vertexOffset, instanceNode->firstInstance);
+
+    return instanceNode;
+}
+
+void InstanceDrawIndexed::record(CommandBuffer& commandBuffer) const
+{
+    auto instanceNode = bindArraysAndIndices(commandBuffer);
+    if (!instanceNode) return;
+
+    // vsg::info("InstanceDrawIndexed::record(CommandBuffer& commandBuffer) vkCmdDrawIndexed indexCount = ", indexCount, ", instanceNode->instanceCount = ", instanceNode->instanceCount);
+
+    vkCmdDrawIndexed(commandBuffer, indexCount, instanceNode->instanceCount, firstIndex, vertexOffset, instanceNode->firstInstance);
 }
@@ -0,0 +1,95 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/InstanceDrawIndexedIndirect.h>
+#include <vsg/nodes/InstanceNode.h>
+#include <vsg/vk/Context.h>
+
+using namespace vsg;
+
+InstanceDrawIndexedIndirect::InstanceDrawIndexedIndirect()
+{
+}
+
+InstanceDrawIndexedIndirect::InstanceDrawIndexedIndirect(const InstanceDrawIndexedIndirect& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    indirect(copyop(rhs.indirect)),
+    drawCount(rhs.drawCount),
+    stride(rhs.stride)
+{
+}
+
+InstanceDrawIndexedIndirect::~InstanceDrawIndexedIndirect()
+{
+}
+
+int InstanceDrawIndexedIndirect::compare(const Object& rhs_object) const
+{
+    int result = InstanceDrawIndexed::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_value(drawCount, rhs.drawCount)) != 0) return result;
+    if ((result = compare_value(stride, rhs.stride)) != 0) return result;
+    return compare_pointer(indirect, rhs.indirect);
+}
+
+void InstanceDrawIndexedIndirect::read(Input& input)
+{
+    InstanceDrawIndexed::read(input);
+
+    ref_ptr<Data> data;
+    input.readObject("indirect", data);
+    if (data)
+        indirect = BufferInfo::create(data);
+    else
+        indirect = {};
+
+    input.read("drawCount", drawCount);
+    input.read("stride", stride);
+}
+
+void InstanceDrawIndexedIndirect::write(Output& output) const
+{
+    InstanceDrawIndexed::write(output);
+
+    if (indirect)
+        output.writeObject("indirect", indirect->data.get());
+    else
+        output.writeObject("indirect", nullptr);
+
+    output.write("drawCount", drawCount);
+    output.write("stride", stride);
+}
+
+void InstanceDrawIndexedIndirect::compile(Context& context)
+{
+    InstanceDrawIndexed::compile(context);
+
+    // indirect buffers written by a compute shader are created by the compute stage, only create and copy when the draw parameters are provided as data
+    if (indirect && indirect->requiresCopy(context.deviceID))
+    {
+        createBufferAndTransferData(context, {indirect}, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE);
+    }
+}
+
+void InstanceDrawIndexedIndirect::record(CommandBuffer& commandBuffer) const
+{
+    if (!indirect || !indirect->buffer) return;
+
+    if (!bindArraysAndIndices(commandBuffer)) return;
+
+    vkCmdDrawIndexedIndirect(commandBuffer, indirect->buffer->vk(commandBuffer.deviceID), indirect->offset, drawCount, stride);
+}
@@ -27,7 +27,7 @@ LOD::LOD(const LOD& rhs, const CopyOp& copyop) :
     children.reserve(rhs.children.size());
     for (auto child : rhs.children)
     {
-        children.push_back(Child{child.minimumScreenHeightRatio, copyop(child.node)});
+        children.push_back(Child{child.minimumScreenHeightRatio, copyop(child.node), child.geometricError});
     }
 }
 
@@ -53,6 +53,7 @@ int LOD::compare(const Object& rhs_object) const
     for (auto lhs_itr = children.begin(); lhs_itr != children.end(); ++lhs_itr, ++rhs_itr)
     {
         if ((result = compare_value(lhs_itr->minimumScreenHeightRatio, rhs_itr->minimumScreenHeightRatio)) != 0) return result;
+        if ((result = compare_value(lhs_itr->geometricError, rhs_itr->geometricError)) != 0) return result;
         if ((result = compare_pointer(lhs_itr->node, rhs_itr->node)) != 0) return result;
     }
     return 0;
@@ -69,6 +70,7 @@ void LOD::read(Input& input)
     {
         input.read("child.minimumScreenHeightRatio", child.minimumScreenHeightRatio);
         input.read("child.node", child.node);
+        if (input.version_greater_equal(1, 1, 23)) input.read("child.geometricError", child.geometricError);
     }
 }
 
@@ -83,5 +85,6 @@ void LOD::write(Output& output) const
     {
         output.write("child.minimumScreenHeightRatio", child.minimumScreenHeightRatio);
         output.write("child.node", child.node);
+        if (output.version_greater_equal(1, 1, 23)) output.write("child.geometricError", child.geometricError);
     }
 }
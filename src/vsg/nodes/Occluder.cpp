@@ -0,0 +1,64 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/stream.h>
+#include <vsg/nodes/Occluder.h>
+
+using namespace vsg;
+
+Occluder::Occluder()
+{
+}
+
+Occluder::Occluder(const Occluder& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    vertices(copyop(rhs.vertices)),
+    indices(copyop(rhs.indices))
+{
+}
+
+Occluder::Occluder(ref_ptr<vec3Array> in_vertices, ref_ptr<Data> in_indices) :
+    vertices(in_vertices),
+    indices(in_indices)
+{
+}
+
+Occluder::~Occluder()
+{
+}
+
+int Occluder::compare(const Object& rhs_object) const
+{
+    int result = Node::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_pointer(vertices, rhs.vertices)) != 0) return result;
+    return compare_pointer(indices, rhs.indices);
+}
+
+void Occluder::read(Input& input)
+{
+    Node::read(input);
+
+    input.readObject("vertices", vertices);
+    input.readObject("indices", indices);
+}
+
+void Occluder::write(Output& output) const
+{
+    Node::write(output);
+
+    output.writeObject("vertices", vertices);
+    output.writeObject("indices", indices);
+}
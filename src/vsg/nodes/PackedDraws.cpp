@@ -0,0 +1,110 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/PackedDraws.h>
+
+using namespace vsg;
+
+PackedDraws::PackedDraws()
+{
+}
+
+PackedDraws::PackedDraws(const PackedDraws& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    bindVertexBuffers(copyop(rhs.bindVertexBuffers)),
+    bindIndexBuffer(copyop(rhs.bindIndexBuffer)),
+    bounds(rhs.bounds),
+    stateIndices(rhs.stateIndices),
+    firstIndices(rhs.firstIndices),
+    indexCounts(rhs.indexCounts)
+{
+    stateSets.reserve(rhs.stateSets.size());
+    for (auto& stateSet : rhs.stateSets)
+    {
+        stateSets.push_back(copyop(stateSet));
+    }
+}
+
+PackedDraws::~PackedDraws()
+{
+}
+
+uint32_t PackedDraws::addDraw(const sphere& bound, uint32_t stateIndex, uint32_t firstIndex, uint32_t indexCount)
+{
+    uint32_t index = static_cast<uint32_t>(bounds.size());
+    bounds.push_back(bound);
+    stateIndices.push_back(stateIndex);
+    firstIndices.push_back(firstIndex);
+    indexCounts.push_back(indexCount);
+    return index;
+}
+
+int PackedDraws::compare(const Object& rhs_object) const
+{
+    int result = Node::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_pointer(bindVertexBuffers, rhs.bindVertexBuffers))) return result;
+    if ((result = compare_pointer(bindIndexBuffer, rhs.bindIndexBuffer))) return result;
+    if ((result = compare_value_container(bounds, rhs.bounds))) return result;
+    if ((result = compare_value_container(stateIndices, rhs.stateIndices))) return result;
+    if ((result = compare_value_container(firstIndices, rhs.firstIndices))) return result;
+    if ((result = compare_value_container(indexCounts, rhs.indexCounts))) return result;
+
+    if (stateSets.size() < rhs.stateSets.size()) return -1;
+    if (stateSets.size() > rhs.stateSets.size()) return 1;
+    for (size_t i = 0; i < stateSets.size(); ++i)
+    {
+        if ((result = compare_pointer_container(stateSets[i], rhs.stateSets[i]))) return result;
+    }
+    return 0;
+}
+
+void PackedDraws::read(Input& input)
+{
+    Node::read(input);
+
+    input.readObject("bindVertexBuffers", bindVertexBuffers);
+    input.readObject("bindIndexBuffer", bindIndexBuffer);
+    input.readValues("bounds", bounds);
+    input.readValues("stateIndices", stateIndices);
+    input.readValues("firstIndices", firstIndices);
+    input.readValues("indexCounts", indexCounts);
+
+    stateSets.resize(input.readValue<uint32_t>("stateSets"));
+    for (auto& stateSet : stateSets)
+    {
+        input.readObjects("stateCommands", stateSet);
+    }
+}
+
+void PackedDraws::write(Output& output) const
+{
+    Node::write(output);
+
+    output.writeObject("bindVertexBuffers", bindVertexBuffers);
+    output.writeObject("bindIndexBuffer", bindIndexBuffer);
+    output.writeValues("bounds", bounds);
+    output.writeValues("stateIndices", stateIndices);
+    output.writeValues("firstIndices", firstIndices);
+    output.writeValues("indexCounts", indexCounts);
+
+    output.writeValue<uint32_t>("stateSets", stateSets.size());
+    for (auto& stateSet : stateSets)
+    {
+        output.writeObjects("stateCommands", stateSet);
+    }
+}
@@ -0,0 +1,107 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/PackedSubgraph.h>
+
+using namespace vsg;
+
+PackedSubgraph::PackedSubgraph()
+{
+}
+
+PackedSubgraph::PackedSubgraph(const PackedSubgraph& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    bounds(rhs.bounds),
+    transformIndices(rhs.transformIndices),
+    stateIndices(rhs.stateIndices),
+    draws(copyop(rhs.draws)),
+    transforms(rhs.transforms)
+{
+    stateSets.reserve(rhs.stateSets.size());
+    for (auto& stateSet : rhs.stateSets)
+    {
+        stateSets.push_back(copyop(stateSet));
+    }
+}
+
+PackedSubgraph::~PackedSubgraph()
+{
+}
+
+uint32_t PackedSubgraph::addDraw(const dsphere& bound, uint32_t transformIndex, uint32_t stateIndex, ref_ptr<Node> draw)
+{
+    uint32_t index = static_cast<uint32_t>(draws.size());
+    bounds.push_back(bound);
+    transformIndices.push_back(transformIndex);
+    stateIndices.push_back(stateIndex);
+    draws.push_back(draw);
+    return index;
+}
+
+int PackedSubgraph::compare(const Object& rhs_object) const
+{
+    int result = Node::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_value_container(bounds, rhs.bounds))) return result;
+    if ((result = compare_value_container(transformIndices, rhs.transformIndices))) return result;
+    if ((result = compare_value_container(stateIndices, rhs.stateIndices))) return result;
+    if ((result = compare_pointer_container(draws, rhs.draws))) return result;
+    if ((result = compare_value_container(transforms, rhs.transforms))) return result;
+
+    if (stateSets.size() < rhs.stateSets.size()) return -1;
+    if (stateSets.size() > rhs.stateSets.size()) return 1;
+    for (size_t i = 0; i < stateSets.size(); ++i)
+    {
+        if ((result = compare_pointer_container(stateSets[i], rhs.stateSets[i]))) return result;
+    }
+    return 0;
+}
+
+void PackedSubgraph::read(Input& input)
+{
+    Node::read(input);
+
+    input.readValues("bounds", bounds);
+    input.readValues("transformIndices", transformIndices);
+    input.readValues("stateIndices", stateIndices);
+    input.readObjects("draws", draws);
+    input.readValues("transforms", transforms);
+
+    stateSets.resize(input.readValue<uint32_t>("stateSets"));
+    for (auto& stateSet : stateSets)
+    {
+        input.readObjects("stateCommands", stateSet);
+    }
+}
+
+void PackedSubgraph::write(Output& output) const
+{
+    Node::write(output);
+
+    output.writeValues("bounds", bounds);
+    output.writeValues("transformIndices", transformIndices);
+    output.writeValues("stateIndices", stateIndices);
+    output.writeObjects("draws", draws);
+    output.writeValues("transforms", transforms);
+
+    output.writeValue<uint32_t>("stateSets", stateSets.size());
+    for (auto& stateSet : stateSets)
+    {
+        output.writeObjects("stateCommands", stateSet);
+    }
+}
@@ -26,8 +26,10 @@ PagedLOD::PagedLOD(const PagedLOD& rhs, const CopyOp& copyop) :
 {
     children[0].minimumScreenHeightRatio = rhs.children[0].minimumScreenHeightRatio;
     children[0].node = copyop(rhs.children[0].node);
+    children[0].geometricError = rhs.children[0].geometricError;
     children[1].minimumScreenHeightRatio = rhs.children[1].minimumScreenHeightRatio;
     children[1].node = copyop(rhs.children[1].node);
+    children[1].geometricError = rhs.children[1].geometricError;
 }
 
 PagedLOD::~PagedLOD()
@@ -48,6 +50,7 @@ int PagedLOD::compare(const Object& rhs_object) const
     for (auto lhs_itr = children.begin(); lhs_itr != children.end(); ++lhs_itr, ++rhs_itr)
     {
         if ((result = compare_value(lhs_itr->minimumScreenHeightRatio, rhs_itr->minimumScreenHeightRatio)) != 0) return result;
+        if ((result = compare_value(lhs_itr->geometricError, rhs_itr->geometricError)) != 0) return result;
         if ((result = compare_pointer(lhs_itr->node, rhs_itr->node)) != 0) return result;
     }
 
@@ -76,7 +79,13 @@ void PagedLOD::read(Input& input)
     input.read("child.minimumScreenHeightRatio", children[1].minimumScreenHeightRatio);
     input.read("child.node", children[1].node);
 
-    options = Options::create_if(input.options, *input.options);
+    if (input.version_greater_equal(1, 1, 23))
+    {
+        input.read("child.geometricError", children[0].geometricError);
+        input.read("child.geometricError", children[1].geometricError);
+    }
+
+    options = input.sharedCopyOfOptions();
 }
 
 void PagedLOD::write(Output& output) const
@@ -90,4 +99,10 @@ void PagedLOD::write(Output& output) const
 
     output.write("child.minimumScreenHeightRatio", children[1].minimumScreenHeightRatio);
     output.write("child.node", children[1].node);
+
+    if (output.version_greater_equal(1, 1, 23))
+    {
+        output.write("child.geometricError", children[0].geometricError);
+        output.write("child.geometricError", children[1].geometricError);
+    }
 }
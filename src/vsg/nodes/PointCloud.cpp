@@ -0,0 +1,138 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Options.h>
+#include <vsg/io/stream.h>
+#include <vsg/nodes/PointCloud.h>
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// PointCloudTile
+//
+PointCloudTile::PointCloudTile()
+{
+}
+
+PointCloudTile::PointCloudTile(const PointCloudTile& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    numPoints(rhs.numPoints),
+    tiles(copyop(rhs.tiles))
+{
+}
+
+PointCloudTile::~PointCloudTile()
+{
+}
+
+int PointCloudTile::compare(const Object& rhs_object) const
+{
+    int result = PagedLOD::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+
+    if ((result = compare_value(numPoints, rhs.numPoints)) != 0) return result;
+    return compare_pointer_container(tiles, rhs.tiles);
+}
+
+void PointCloudTile::read(Input& input)
+{
+    Node::read(input);
+
+    input.read("bound", bound);
+    input.read("numPoints", numPoints);
+    input.read("filename", filename);
+
+    if (!filename.empty() && input.filename)
+    {
+        auto path = filePath(input.filename);
+        if (path)
+        {
+            filename = (path / filename).lexically_normal();
+        }
+    }
+
+    input.read("chunk", children[0].node);
+    input.readObjects("tiles", tiles);
+
+    options = input.sharedCopyOfOptions();
+}
+
+void PointCloudTile::write(Output& output) const
+{
+    Node::write(output);
+
+    output.write("bound", bound);
+    output.write("numPoints", numPoints);
+    output.write("filename", filename);
+
+    // paged chunks are loaded from filename so only write chunks held in memory
+    output.write("chunk", filename.empty() ? children[0].node : ref_ptr<Node>());
+    output.writeObjects("tiles", tiles);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// PointCloud
+//
+PointCloud::PointCloud()
+{
+}
+
+PointCloud::PointCloud(const PointCloud& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    root(copyop(rhs.root)),
+    pointBudget(rhs.pointBudget),
+    minimumScreenHeightRatio(rhs.minimumScreenHeightRatio)
+{
+}
+
+PointCloud::PointCloud(ref_ptr<PointCloudTile> in_root) :
+    root(in_root)
+{
+}
+
+PointCloud::~PointCloud()
+{
+}
+
+int PointCloud::compare(const Object& rhs_object) const
+{
+    int result = Node::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+
+    if ((result = compare_value(pointBudget, rhs.pointBudget)) != 0) return result;
+    if ((result = compare_value(minimumScreenHeightRatio, rhs.minimumScreenHeightRatio)) != 0) return result;
+    return compare_pointer(root, rhs.root);
+}
+
+void PointCloud::read(Input& input)
+{
+    Node::read(input);
+
+    input.read("pointBudget", pointBudget);
+    input.read("minimumScreenHeightRatio", minimumScreenHeightRatio);
+    input.read("root", root);
+}
+
+void PointCloud::write(Output& output) const
+{
+    Node::write(output);
+
+    output.write("pointBudget", pointBudget);
+    output.write("minimumScreenHeightRatio", minimumScreenHeightRatio);
+    output.write("root", root);
+}
@@ -23,7 +23,10 @@ RegionOfInterest::RegionOfInterest(const RegionOfInterest& rhs, const CopyOp& co
     Inherit(rhs, copyop),
     mask(rhs.mask),
     name(rhs.name),
-    points(rhs.points)
+    points(rhs.points),
+    focusRadius(rhs.focusRadius),
+    focusPriorityScale(rhs.focusPriorityScale),
+    focusMemoryBudget(rhs.focusMemoryBudget)
 {
 }
 
@@ -39,6 +42,9 @@ int RegionOfInterest::compare(const Object& rhs_object) const
     const auto& rhs = static_cast<decltype(*this)>(rhs_object);
     if ((result = compare_value(mask, rhs.mask)) != 0) return result;
     if ((result = compare_value(name, rhs.name)) != 0) return result;
+    if ((result = compare_value(focusRadius, rhs.focusRadius)) != 0) return result;
+    if ((result = compare_value(focusPriorityScale, rhs.focusPriorityScale)) != 0) return result;
+    if ((result = compare_value(focusMemoryBudget, rhs.focusMemoryBudget)) != 0) return result;
     return compare_value_container(points, rhs.points);
 }
 
@@ -49,6 +55,13 @@ void RegionOfInterest::read(Input& input)
     input.read("mask", mask);
     input.read("name", name);
     input.read("points", points);
+
+    if (input.version_greater_equal(1, 1, 24))
+    {
+        input.read("focusRadius", focusRadius);
+        input.read("focusPriorityScale", focusPriorityScale);
+        input.read("focusMemoryBudget", focusMemoryBudget);
+    }
 }
 
 void RegionOfInterest::write(Output& output) const
@@ -58,4 +71,11 @@ void RegionOfInterest::write(Output& output) const
     output.write("mask", mask);
     output.write("name", name);
     output.write("points", points);
+
+    if (output.version_greater_equal(1, 1, 24))
+    {
+        output.write("focusRadius", focusRadius);
+        output.write("focusPriorityScale", focusPriorityScale);
+        output.write("focusMemoryBudget", focusMemoryBudget);
+    }
 }
@@ -0,0 +1,243 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/SpatialGrid.h>
+#include <vsg/utils/ComputeBounds.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace vsg;
+
+namespace
+{
+    // children without valid bounds are given a bound that is never culled
+    constexpr double s_unboundedRadius = std::numeric_limits<double>::max() / 4.0;
+
+    constexpr int64_t s_keyBias = int64_t(1) << 20;
+    constexpr uint64_t s_keyMask = (uint64_t(1) << 21) - 1;
+} // namespace
+
+SpatialGrid::SpatialGrid(double in_cellSize) :
+    cellSize(in_cellSize)
+{
+}
+
+SpatialGrid::SpatialGrid(const SpatialGrid& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    cellSize(rhs.cellSize)
+{
+    rebuild();
+}
+
+SpatialGrid::~SpatialGrid()
+{
+}
+
+int SpatialGrid::compare(const Object& rhs_object) const
+{
+    int result = Group::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    return compare_value(cellSize, rhs.cellSize);
+}
+
+void SpatialGrid::read(Input& input)
+{
+    Group::read(input);
+
+    input.read("cellSize", cellSize);
+
+    rebuild();
+}
+
+void SpatialGrid::write(Output& output) const
+{
+    Group::write(output);
+
+    output.write("cellSize", cellSize);
+}
+
+uint64_t SpatialGrid::_cellKey(const dvec3& position) const
+{
+    auto coord = [&](double value) {
+        return static_cast<uint64_t>(static_cast<int64_t>(std::floor(value / cellSize)) + s_keyBias) & s_keyMask;
+    };
+    return coord(position.x) | (coord(position.y) << 21) | (coord(position.z) << 42);
+}
+
+dsphere SpatialGrid::_computeBound(size_t index) const
+{
+    const auto& localBound = _entries[index].localBound;
+    if (localBound.radius >= s_unboundedRadius) return localBound;
+
+    if (auto transform = children[index].cast<MatrixTransform>())
+    {
+        const auto& m = transform->matrix;
+        double scale = std::sqrt(std::max({length2(dvec3(m[0][0], m[0][1], m[0][2])), length2(dvec3(m[1][0], m[1][1], m[1][2])), length2(dvec3(m[2][0], m[2][1], m[2][2]))}));
+        return dsphere(m * localBound.center, localBound.radius * scale);
+    }
+    return localBound;
+}
+
+void SpatialGrid::_insert(size_t index)
+{
+    uint64_t key = _cellKey(bounds[index].center);
+
+    uint32_t cellIndex = 0;
+    if (auto itr = _cellIndices.find(key); itr != _cellIndices.end())
+    {
+        cellIndex = itr->second;
+    }
+    else
+    {
+        if (_freeCells.empty())
+        {
+            cellIndex = static_cast<uint32_t>(_cells.size());
+            _cells.emplace_back();
+            _cellBounds.emplace_back();
+        }
+        else
+        {
+            cellIndex = _freeCells.back();
+            _freeCells.pop_back();
+        }
+
+        auto& cell = _cells[cellIndex];
+        cell.key = key;
+        cell.maxRadius = 0.0;
+
+        auto center = [&](uint64_t k) { return (static_cast<double>(static_cast<int64_t>(k & s_keyMask) - s_keyBias) + 0.5) * cellSize; };
+        _cellBounds[cellIndex] = dsphere(center(key), center(key >> 21), center(key >> 42), cellSize * std::sqrt(3.0) * 0.5);
+
+        _cellIndices[key] = cellIndex;
+    }
+
+    auto& cell = _cells[cellIndex];
+    cell.children.push_back(static_cast<uint32_t>(index));
+    if (bounds[index].radius > cell.maxRadius)
+    {
+        // loosen the cell's bound to enclose the children that overhang it
+        _cellBounds[cellIndex].radius += bounds[index].radius - cell.maxRadius;
+        cell.maxRadius = bounds[index].radius;
+    }
+
+    _entries[index].cell = cellIndex;
+}
+
+void SpatialGrid::_remove(size_t index)
+{
+    uint32_t cellIndex = _entries[index].cell;
+    auto& cell = _cells[cellIndex];
+
+    auto itr = std::find(cell.children.begin(), cell.children.end(), static_cast<uint32_t>(index));
+    if (itr != cell.children.end())
+    {
+        *itr = cell.children.back();
+        cell.children.pop_back();
+    }
+
+    // the cell's bound isn't tightened as children leave, only once it's empty and reused
+    if (cell.children.empty())
+    {
+        _cellIndices.erase(cell.key);
+        _freeCells.push_back(cellIndex);
+    }
+}
+
+void SpatialGrid::addChild(ref_ptr<Node> child)
+{
+    children.push_back(child);
+    bounds.emplace_back();
+    _entries.emplace_back();
+
+    size_t index = children.size() - 1;
+
+    ComputeBounds computeBounds;
+    if (auto transform = child.cast<MatrixTransform>())
+        transform->traverse(computeBounds);
+    else
+        child->accept(computeBounds);
+
+    auto& box = computeBounds.bounds;
+    _entries[index].localBound = box.valid() ? dsphere((box.min + box.max) * 0.5, length(box.max - box.min) * 0.5) : dsphere(0.0, 0.0, 0.0, s_unboundedRadius);
+
+    bounds[index] = _computeBound(index);
+    _insert(index);
+}
+
+void SpatialGrid::removeChild(size_t index)
+{
+    if (index >= children.size()) return;
+
+    _remove(index);
+
+    size_t last = children.size() - 1;
+    if (index != last)
+    {
+        // move the last child into the vacated slot
+        _remove(last);
+        children[index] = children[last];
+        bounds[index] = bounds[last];
+        _entries[index] = _entries[last];
+        _insert(index);
+    }
+
+    children.pop_back();
+    bounds.pop_back();
+    _entries.pop_back();
+}
+
+void SpatialGrid::update(size_t index)
+{
+    auto bound = _computeBound(index);
+    bounds[index] = bound;
+
+    auto& cell = _cells[_entries[index].cell];
+    if (_cellKey(bound.center) != cell.key)
+    {
+        _remove(index);
+        _insert(index);
+    }
+    else if (bound.radius > cell.maxRadius)
+    {
+        _cellBounds[_entries[index].cell].radius += bound.radius - cell.maxRadius;
+        cell.maxRadius = bound.radius;
+    }
+}
+
+void SpatialGrid::update()
+{
+    for (size_t i = 0; i < children.size(); ++i) update(i);
+}
+
+void SpatialGrid::rebuild()
+{
+    auto currentChildren = std::move(children);
+
+    children.clear();
+    bounds.clear();
+    _entries.clear();
+    _cells.clear();
+    _cellBounds.clear();
+    _freeCells.clear();
+    _cellIndices.clear();
+
+    for (auto& child : currentChildren) addChild(child);
+}
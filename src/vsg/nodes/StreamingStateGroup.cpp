@@ -0,0 +1,182 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/TextureStreamer.h>
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/StreamingStateGroup.h>
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StreamedTexture
+//
+StreamedTexture::StreamedTexture()
+{
+}
+
+StreamedTexture::StreamedTexture(ref_ptr<ImageInfo> in_imageInfo, uint32_t in_residentLevel, ref_ptr<Data> in_data) :
+    imageInfo(in_imageInfo),
+    data(in_data),
+    residentLevel(in_residentLevel),
+    requestedLevel(in_residentLevel)
+{
+    _computeDimensions();
+}
+
+StreamedTexture::StreamedTexture(ref_ptr<Sampler> sampler, ref_ptr<Data> in_data, uint32_t in_residentLevel) :
+    data(in_data),
+    residentLevel(in_residentLevel),
+    requestedLevel(in_residentLevel)
+{
+    if (data)
+    {
+        residentLevel = std::min(in_residentLevel, std::max(uint32_t(data->properties.mipLevels), 1u) - 1u);
+        requestedLevel = residentLevel.load();
+
+        if (auto subset = TextureStreamer::mipmapSubset(data, residentLevel))
+        {
+            imageInfo = ImageInfo::create(sampler, subset);
+        }
+    }
+
+    _computeDimensions();
+}
+
+StreamedTexture::~StreamedTexture()
+{
+}
+
+void StreamedTexture::_computeDimensions()
+{
+    if (data)
+    {
+        auto [w, h, d, f] = data->pixelExtents();
+        width = w;
+        height = h;
+        mipLevels = std::max(uint32_t(data->properties.mipLevels), 1u);
+    }
+    else if (imageInfo && imageInfo->imageView && imageInfo->imageView->image && imageInfo->imageView->image->data)
+    {
+        // the resident levels are the tail of the full mipmap chain, so scale up to get the full resolution dimensions
+        auto& residentData = imageInfo->imageView->image->data;
+        auto [w, h, d, f] = residentData->pixelExtents();
+        width = w << residentLevel;
+        height = h << residentLevel;
+        mipLevels = std::max(uint32_t(residentData->properties.mipLevels), 1u) + residentLevel;
+    }
+}
+
+int StreamedTexture::compare(const Object& rhs_object) const
+{
+    int result = Object::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_pointer(imageInfo, rhs.imageInfo))) return result;
+    if ((result = compare_pointer(data, rhs.data))) return result;
+    if ((result = compare_value(residentLevel.load(), rhs.residentLevel.load()))) return result;
+    return filename.compare(rhs.filename);
+}
+
+void StreamedTexture::read(Input& input)
+{
+    Object::read(input);
+
+    imageInfo = ImageInfo::create();
+    input.readObject("sampler", imageInfo->sampler);
+    input.readObject("imageView", imageInfo->imageView);
+    input.readValue<uint32_t>("imageLayout", imageInfo->imageLayout);
+
+    input.readObject("data", data);
+    input.read("filename", filename);
+    input.read("width", width);
+    input.read("height", height);
+    input.read("mipLevels", mipLevels);
+    residentLevel = input.readValue<uint32_t>("residentLevel");
+    requestedLevel = residentLevel.load();
+
+    if (!filename.empty() && input.filename)
+    {
+        if (auto path = filePath(input.filename))
+        {
+            filename = (path / filename).lexically_normal();
+        }
+    }
+
+    options = Options::create_if(input.options, *input.options);
+}
+
+void StreamedTexture::write(Output& output) const
+{
+    Object::write(output);
+
+    output.writeObject("sampler", imageInfo ? imageInfo->sampler.get() : nullptr);
+    output.writeObject("imageView", imageInfo ? imageInfo->imageView.get() : nullptr);
+    output.writeValue<uint32_t>("imageLayout", imageInfo ? imageInfo->imageLayout : VK_IMAGE_LAYOUT_UNDEFINED);
+
+    output.writeObject("data", data);
+    output.write("filename", filename);
+    output.write("width", width);
+    output.write("height", height);
+    output.write("mipLevels", mipLevels);
+    output.writeValue<uint32_t>("residentLevel", residentLevel.load());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StreamingStateGroup
+//
+StreamingStateGroup::StreamingStateGroup()
+{
+}
+
+StreamingStateGroup::StreamingStateGroup(const StreamingStateGroup& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    bound(rhs.bound),
+    textures(rhs.textures),
+    textureStreamer(rhs.textureStreamer)
+{
+}
+
+StreamingStateGroup::~StreamingStateGroup()
+{
+}
+
+int StreamingStateGroup::compare(const Object& rhs_object) const
+{
+    int result = StateGroup::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_value(bound, rhs.bound))) return result;
+    return compare_pointer_container(textures, rhs.textures);
+}
+
+void StreamingStateGroup::read(Input& input)
+{
+    StateGroup::read(input);
+
+    input.read("bound", bound);
+    input.readObjects("textures", textures);
+}
+
+void StreamingStateGroup::write(Output& output) const
+{
+    StateGroup::write(output);
+
+    output.write("bound", bound);
+    output.writeObjects("textures", textures);
+}
@@ -21,7 +21,9 @@ Switch::Switch()
 }
 
 Switch::Switch(const Switch& rhs, const CopyOp& copyop) :
-    Inherit(rhs, copyop)
+    Inherit(rhs, copyop),
+    indexActiveChildren(rhs.indexActiveChildren),
+    activeChildren(rhs.activeChildren)
 {
     children.reserve(rhs.children.size());
     for (auto child : rhs.children)
@@ -41,6 +43,8 @@ int Switch::compare(const Object& rhs_object) const
 
     auto& rhs = static_cast<decltype(*this)>(rhs_object);
 
+    if ((result = compare_value(indexActiveChildren, rhs.indexActiveChildren)) != 0) return result;
+
     // compare the children vector
     if (children.size() < rhs.children.size()) return -1;
     if (children.size() > rhs.children.size()) return 1;
@@ -65,6 +69,17 @@ void Switch::read(Input& input)
         input.read("child.mask", child.mask);
         input.read("child.node", child.node);
     }
+
+    if (input.version_greater_equal(1, 1, 25))
+    {
+        input.read("indexActiveChildren", indexActiveChildren);
+    }
+    else
+    {
+        indexActiveChildren = false;
+    }
+
+    updateActiveChildren();
 }
 
 void Switch::write(Output& output) const
@@ -77,22 +92,29 @@ void Switch::write(Output& output) const
         output.write("child.mask", child.mask);
         output.write("child.node", child.node);
     }
+
+    if (output.version_greater_equal(1, 1, 25))
+    {
+        output.write("indexActiveChildren", indexActiveChildren);
+    }
 }
 
 void Switch::addChild(vsg::Mask mask, ref_ptr<Node> child)
 {
     children.push_back(Child{mask, child});
+    if (indexActiveChildren && mask != MASK_OFF) activeChildren.push_back(static_cast<uint32_t>(children.size() - 1));
 }
 
 void Switch::addChild(bool enabled, ref_ptr<Node> child)
 {
-    children.push_back(Child{boolToMask(enabled), child});
+    addChild(boolToMask(enabled), child);
 }
 
 void Switch::setAllChildren(bool enabled)
 {
     Mask mask = boolToMask(enabled);
     for (auto& child : children) child.mask = mask;
+    updateActiveChildren();
 }
 
 void Switch::setSingleChildOn(size_t index)
@@ -101,4 +123,28 @@ void Switch::setSingleChildOn(size_t index)
     {
         children[i].mask = boolToMask(i == index);
     }
+
+    activeChildren.clear();
+    if (indexActiveChildren && index < children.size()) activeChildren.push_back(static_cast<uint32_t>(index));
+}
+
+void Switch::setChildMask(size_t index, Mask mask)
+{
+    if (index >= children.size()) return;
+
+    bool wasActive = children[index].mask != MASK_OFF;
+    children[index].mask = mask;
+
+    if (indexActiveChildren && wasActive != (mask != MASK_OFF)) updateActiveChildren();
+}
+
+void Switch::updateActiveChildren()
+{
+    activeChildren.clear();
+    if (!indexActiveChildren) return;
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        if (children[i].mask != MASK_OFF) activeChildren.push_back(static_cast<uint32_t>(i));
+    }
 }
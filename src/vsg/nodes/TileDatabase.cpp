@@ -43,9 +43,16 @@ TileDatabaseSettings::TileDatabaseSettings(const TileDatabaseSettings& rhs, cons
     elevationLayerCallback(rhs.elevationLayerCallback),
     elevationScale(rhs.elevationScale),
     skirtRatio(rhs.skirtRatio),
+    maxTileDimension(rhs.maxTileDimension),
     mipmapLevelsHint(rhs.mipmapLevelsHint),
+    maxCachedTiles(rhs.maxCachedTiles),
+    maxMissingTiles(rhs.maxMissingTiles),
     lighting(rhs.lighting),
-    shaderSet(copyop(rhs.shaderSet))
+    shaderSet(copyop(rhs.shaderSet)),
+    tessellation(rhs.tessellation),
+    tessellationPatchDimension(rhs.tessellationPatchDimension),
+    tessellationPixelsPerEdge(rhs.tessellationPixelsPerEdge),
+    terrainHeightCache(rhs.terrainHeightCache)
 {
 }
 
@@ -71,7 +78,10 @@ int TileDatabaseSettings::compare(const Object& rhs_object) const
     if ((result = compare_value(maxTileDimension, rhs.maxTileDimension)) != 0) return result;
     if ((result = compare_value(mipmapLevelsHint, rhs.mipmapLevelsHint)) != 0) return result;
     if ((result = compare_value(lighting, rhs.lighting)) != 0) return result;
-    return compare_pointer(shaderSet, rhs.shaderSet);
+    if ((result = compare_pointer(shaderSet, rhs.shaderSet)) != 0) return result;
+    if ((result = compare_value(tessellation, rhs.tessellation)) != 0) return result;
+    if ((result = compare_value(tessellationPatchDimension, rhs.tessellationPatchDimension)) != 0) return result;
+    return compare_value(tessellationPixelsPerEdge, rhs.tessellationPixelsPerEdge);
 }
 
 void TileDatabaseSettings::read(vsg::Input& input)
@@ -104,6 +114,13 @@ void TileDatabaseSettings::read(vsg::Input& input)
         input.read("lighting", lighting);
         input.readObject("shaderSet", shaderSet);
     }
+
+    if (input.version_greater_equal(1, 1, 27))
+    {
+        input.read("tessellation", tessellation);
+        input.read("tessellationPatchDimension", tessellationPatchDimension);
+        input.read("tessellationPixelsPerEdge", tessellationPixelsPerEdge);
+    }
 }
 
 void TileDatabaseSettings::write(vsg::Output& output) const
@@ -136,6 +153,13 @@ void TileDatabaseSettings::write(vsg::Output& output) const
         output.write("lighting", lighting);
         output.writeObject("shaderSet", shaderSet);
     }
+
+    if (output.version_greater_equal(1, 1, 27))
+    {
+        output.write("tessellation", tessellation);
+        output.write("tessellationPatchDimension", tessellationPatchDimension);
+        output.write("tessellationPixelsPerEdge", tessellationPixelsPerEdge);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
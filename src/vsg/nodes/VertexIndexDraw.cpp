@@ -15,6 +15,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/ReaderWriter.h>
 #include <vsg/nodes/VertexIndexDraw.h>
 #include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
 
 using namespace vsg;
 
@@ -57,6 +58,8 @@ int VertexIndexDraw::compare(const Object& rhs_object) const
 
 void VertexIndexDraw::assignArrays(const DataList& arrayData)
 {
+    cachedBounds.reset();
+
     arrays.clear();
     arrays.reserve(arrayData.size());
     for (auto& data : arrayData)
@@ -67,6 +70,8 @@ void VertexIndexDraw::assignArrays(const DataList& arrayData)
 
 void VertexIndexDraw::assignIndices(ref_ptr<vsg::Data> indexData)
 {
+    cachedBounds.reset();
+
     if (indexData)
     {
         indices = BufferInfo::create(indexData);
@@ -187,3 +192,11 @@ void VertexIndexDraw::record(CommandBuffer& commandBuffer) const
 
     vkCmdDrawIndexed(cmdBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
+
+void VertexIndexDraw::record(CommandBuffer& commandBuffer, DrawBatch& drawBatch) const
+{
+    auto& vkd = _vulkanData[commandBuffer.deviceID];
+
+    drawBatch.add(commandBuffer, firstBinding, vkd, indices->buffer->vk(commandBuffer.deviceID), indices->offset, indexType,
+                  indexCount, instanceCount, firstIndex, static_cast<int32_t>(vertexOffset), firstInstance);
+}
@@ -895,7 +895,7 @@ bool MacOS_Window::handleNSEvent(NSEvent* anEvent)
                 case NSEventTypeRightMouseDragged:
                 case NSEventTypeOtherMouseDragged:
                 {
-                    bufferedEvents.emplace_back(vsg::MoveEvent::create(this, getEventTime([anEvent timestamp]), pos.x, contentRect.size.height - pos.y, vsg::ButtonMask(buttonMask)));
+                    bufferMoveEvent(getEventTime([anEvent timestamp]), pos.x, contentRect.size.height - pos.y, vsg::ButtonMask(buttonMask));
                     break;
                 }
                 case NSEventTypeLeftMouseDown:
@@ -78,6 +78,7 @@ void AccelerationStructure::compile(Context& context)
         _handle = extensions->vkGetAccelerationStructureDeviceAddressKHR(*context.device, &deviceAddressInfo);
 
         _requiredBuildScratchSize = accelerationStructureBuildSizesInfo.buildScratchSize;
+        _requiredUpdateScratchSize = accelerationStructureBuildSizesInfo.updateScratchSize;
         context.scratchBufferSize = std::max(_requiredBuildScratchSize, context.scratchBufferSize);
     }
     else
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <algorithm>
 
+#include <vsg/core/Exception.h>
 #include <vsg/raytracing/BottomLevelAccelerationStructure.h>
 #include <vsg/vk/CommandBuffer.h>
 #include <vsg/vk/Context.h>
@@ -41,8 +42,103 @@ void BottomLevelAccelerationStructure::compile(Context& context)
     }
     _accelerationStructureBuildGeometryInfo.geometryCount = static_cast<uint32_t>(geometries.size());
     _accelerationStructureBuildGeometryInfo.pGeometries = _vkGeometries.data();
+    if (allowCompaction) _accelerationStructureBuildGeometryInfo.flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
 
     Inherit::compile(context);
 
-    context.buildAccelerationStructureCommands.push_back(BuildAccelerationStructureCommand::create(context.device, _accelerationStructureBuildGeometryInfo, _accelerationStructure, _geometryPrimitiveCounts));
+    auto buildCommand = BuildAccelerationStructureCommand::create(context.device, _accelerationStructureBuildGeometryInfo, _accelerationStructure, _geometryPrimitiveCounts);
+    if (allowCompaction)
+    {
+        _compactedSizeQuery = QueryPool::create(context.device, 0, VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, 1, 0);
+        buildCommand->compactedSizeQuery = _compactedSizeQuery;
+    }
+    context.buildAccelerationStructureCommands.push_back(buildCommand);
+}
+
+bool BottomLevelAccelerationStructure::compact(Context& context)
+{
+    if (!_compactedSizeQuery || !_accelerationStructure) return false;
+
+    // without VK_QUERY_RESULT_WAIT_BIT the query returns VK_NOT_READY if the build hasn't completed yet
+    std::vector<uint64_t> results(1);
+    if (_compactedSizeQuery->getResults(results, 0, VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) return false;
+
+    _compactedSizeQuery = {};
+
+    VkDeviceSize compactedSize = results[0];
+    if (compactedSize == 0 || compactedSize >= _accelerationStructureInfo.size) return false;
+
+    auto extensions = context.device->getExtensions();
+
+    VkMemoryAllocateFlagsInfo memFlags = {};
+    memFlags.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    memFlags.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+    auto compactedBuffer = vsg::createBufferAndMemory(context.device, compactedSize, VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &memFlags);
+
+    auto compactedInfo = _accelerationStructureInfo;
+    compactedInfo.buffer = compactedBuffer->vk(context.deviceID);
+    compactedInfo.size = compactedSize;
+
+    VkAccelerationStructureKHR compactedAccelerationStructure{};
+    VkResult result = extensions->vkCreateAccelerationStructureKHR(*context.device, &compactedInfo, nullptr, &compactedAccelerationStructure);
+    if (result != VK_SUCCESS)
+    {
+        throw Exception{"Error: vsg::BottomLevelAccelerationStructure::compact(...) failed to create compacted AccelerationStructure.", result};
+    }
+
+    // the command takes over the original structure and buffer, releasing them once the copy has completed and the context's commands are cleared
+    context.commands.push_back(CompactAccelerationStructureCommand::create(context.device, _accelerationStructure, _buffer, compactedAccelerationStructure));
+
+    _accelerationStructure = compactedAccelerationStructure;
+    _accelerationStructureInfo = compactedInfo;
+    _buffer = compactedBuffer;
+
+    VkAccelerationStructureDeviceAddressInfoKHR deviceAddressInfo{};
+    deviceAddressInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR;
+    deviceAddressInfo.accelerationStructure = _accelerationStructure;
+    _handle = extensions->vkGetAccelerationStructureDeviceAddressKHR(*context.device, &deviceAddressInfo);
+
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+//
+// CompactAccelerationStructureCommand
+//
+CompactAccelerationStructureCommand::CompactAccelerationStructureCommand(Device* device, VkAccelerationStructureKHR source, ref_ptr<Buffer> sourceBuffer, VkAccelerationStructureKHR destination) :
+    _device(device),
+    _source(source),
+    _sourceBuffer(sourceBuffer),
+    _destination(destination)
+{
+}
+
+CompactAccelerationStructureCommand::~CompactAccelerationStructureCommand()
+{
+    if (_source)
+    {
+        auto extensions = _device->getExtensions();
+        extensions->vkDestroyAccelerationStructureKHR(*_device, _source, nullptr);
+    }
+}
+
+void CompactAccelerationStructureCommand::record(CommandBuffer& commandBuffer) const
+{
+    auto extensions = commandBuffer.getDevice()->getExtensions();
+
+    VkCopyAccelerationStructureInfoKHR copyInfo{};
+    copyInfo.sType = VK_STRUCTURE_TYPE_COPY_ACCELERATION_STRUCTURE_INFO_KHR;
+    copyInfo.src = _source;
+    copyInfo.dst = _destination;
+    copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+    extensions->vkCmdCopyAccelerationStructureKHR(commandBuffer, &copyInfo);
+
+    // top level builds and updates recorded after the copy read the compacted structure
+    VkMemoryBarrier memoryBarrier;
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.pNext = nullptr;
+    memoryBarrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+    memoryBarrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &memoryBarrier, 0, 0, 0, 0);
 }
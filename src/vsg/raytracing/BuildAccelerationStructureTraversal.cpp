@@ -26,12 +26,23 @@ void BuildAccelerationStructureTraversal::apply(Object& object)
     object.traverse(*this);
 }
 
+void BuildAccelerationStructureTraversal::apply(Node& node)
+{
+    _nodePath.push_back(&node);
+
+    node.traverse(*this);
+
+    _nodePath.pop_back();
+}
+
 void BuildAccelerationStructureTraversal::apply(Transform& transform)
 {
     _transformStack.push(transform);
+    _nodePath.push_back(&transform);
 
     transform.traverse(*this);
 
+    _nodePath.pop_back();
     _transformStack.pop();
 }
 
@@ -56,7 +67,9 @@ void BuildAccelerationStructureTraversal::apply(Geometry& geometry)
     }
 
     // create a geometry instance for this geometry using the blas that represents it and the current transform matrix
+    _nodePath.push_back(&geometry);
     createGeometryInstance(blas);
+    _nodePath.pop_back();
 }
 
 void BuildAccelerationStructureTraversal::apply(VertexIndexDraw& vid)
@@ -75,7 +88,9 @@ void BuildAccelerationStructureTraversal::apply(VertexIndexDraw& vid)
     }
 
     // create a geometry instance for this geometry using the blas that represents it and the current transform matrix
+    _nodePath.push_back(&vid);
     createGeometryInstance(blas);
+    _nodePath.pop_back();
 }
 
 void BuildAccelerationStructureTraversal::createGeometryInstance(BottomLevelAccelerationStructure* blas)
@@ -84,6 +99,7 @@ void BuildAccelerationStructureTraversal::createGeometryInstance(BottomLevelAcce
     geominst->accelerationStructure = blas;
     geominst->id = static_cast<uint32_t>(tlas->geometryInstances.size());
     geominst->transform = _transformStack.top();
+    geominst->nodePath = _nodePath;
 
     tlas->geometryInstances.push_back(geominst);
 }
@@ -0,0 +1,278 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Logger.h>
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/raytracing/DescriptorAccelerationStructure.h>
+#include <vsg/raytracing/RayQueryIntersector.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/vk/Context.h>
+
+using namespace vsg;
+
+namespace
+{
+    const char* rayQueryShader = R"(
+#version 460
+#extension GL_EXT_ray_query : require
+
+layout(local_size_x = 64) in;
+
+layout(set = 0, binding = 0) uniform accelerationStructureEXT tlas;
+
+struct LineSegment
+{
+    vec4 origin;    // w is tmin
+    vec4 direction; // w is tmax
+};
+
+layout(std430, set = 0, binding = 1) readonly buffer LineSegments { LineSegment lineSegments[]; };
+
+struct Hit
+{
+    float ratio;
+    uint instanceIndex;
+    uint primitiveIndex;
+    uint geometryIndex;
+    vec2 barycentrics;
+    uint padding[2];
+};
+
+layout(std430, set = 0, binding = 2) writeonly buffer Hits { Hit hits[]; };
+
+layout(push_constant) uniform PushConstants { uint lineSegmentCount; };
+
+void main()
+{
+    uint i = gl_GlobalInvocationID.x;
+    if (i >= lineSegmentCount) return;
+
+    LineSegment ls = lineSegments[i];
+
+    rayQueryEXT rayQuery;
+    rayQueryInitializeEXT(rayQuery, tlas, gl_RayFlagsOpaqueEXT, 0xFF, ls.origin.xyz, ls.origin.w, ls.direction.xyz, ls.direction.w);
+    while (rayQueryProceedEXT(rayQuery)) {}
+
+    Hit hit;
+    hit.padding[0] = 0;
+    hit.padding[1] = 0;
+    if (rayQueryGetIntersectionTypeEXT(rayQuery, true) == gl_RayQueryCommittedIntersectionTriangleEXT)
+    {
+        hit.ratio = rayQueryGetIntersectionTEXT(rayQuery, true);
+        hit.instanceIndex = rayQueryGetIntersectionInstanceCustomIndexEXT(rayQuery, true);
+        hit.primitiveIndex = rayQueryGetIntersectionPrimitiveIndexEXT(rayQuery, true);
+        hit.geometryIndex = rayQueryGetIntersectionGeometryIndexEXT(rayQuery, true);
+        hit.barycentrics = rayQueryGetIntersectionBarycentricsEXT(rayQuery, true);
+    }
+    else
+    {
+        hit.ratio = -1.0;
+        hit.instanceIndex = 0;
+        hit.primitiveIndex = 0;
+        hit.geometryIndex = 0;
+        hit.barycentrics = vec2(0.0, 0.0);
+    }
+
+    hits[i] = hit;
+}
+)";
+
+    template<class A>
+    bool triangleIndices(const Data* data, uint32_t primitiveIndex, uint32_t& i0, uint32_t& i1, uint32_t& i2)
+    {
+        auto indices = dynamic_cast<const A*>(data);
+        if (!indices || (primitiveIndex * 3 + 2) >= indices->size()) return false;
+
+        i0 = indices->at(primitiveIndex * 3);
+        i1 = indices->at(primitiveIndex * 3 + 1);
+        i2 = indices->at(primitiveIndex * 3 + 2);
+        return true;
+    }
+} // namespace
+
+RayQueryIntersector::RayQueryIntersector(ref_ptr<TopLevelAccelerationStructure> in_tlas) :
+    tlas(in_tlas)
+{
+    auto settings = ShaderCompileSettings::create();
+    settings->vulkanVersion = VK_API_VERSION_1_2;
+    settings->target = ShaderCompileSettings::SPIRV_1_4;
+    settings->defaultVersion = 460;
+
+    shaderStage = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", rayQueryShader, settings);
+}
+
+void RayQueryIntersector::_compile(Context& context, Queue* queue)
+{
+    if (_pipeline) return;
+
+    _deviceID = context.deviceID;
+
+    DescriptorSetLayoutBindings descriptorBindings{
+        {0, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr}};
+
+    auto descriptorSetLayout = DescriptorSetLayout::create(descriptorBindings);
+    PushConstantRanges pushConstantRanges{{VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t)}};
+
+    _pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{descriptorSetLayout}, pushConstantRanges);
+    _pipeline = ComputePipeline::create(_pipelineLayout, shaderStage);
+    _pipeline->compile(context);
+
+    _commandPool = CommandPool::create(context.device, queue->queueFamilyIndex(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+    _commandBuffer = _commandPool->allocate();
+    _fence = Fence::create(context.device);
+}
+
+VkResult RayQueryIntersector::submit(Context& context, Queue* queue, const LineSegments& lineSegments)
+{
+    if (_submitted)
+    {
+        if (VkResult result = wait(); result != VK_SUCCESS) return result;
+    }
+
+    _lineSegments = lineSegments;
+    _descriptorSet = {};
+    _hitBufferInfo = {};
+    _submitted = false;
+
+    if (lineSegments.empty() || !tlas) return VK_SUCCESS;
+
+    _compile(context, queue);
+
+    auto lineSegmentCount = static_cast<uint32_t>(lineSegments.size());
+
+    // line segments are passed as origin and direction so that the ratio along the segment is the t of the ray query
+    auto lineSegmentData = vec4Array::create(lineSegmentCount * 2);
+    for (uint32_t i = 0; i < lineSegmentCount; ++i)
+    {
+        const auto& ls = lineSegments[i];
+        dvec3 direction = ls.end - ls.start;
+        lineSegmentData->set(i * 2, vec4(vec3(ls.start), 0.0f));
+        lineSegmentData->set(i * 2 + 1, vec4(vec3(direction), 1.0f));
+    }
+
+    auto hitData = RayQueryHitArray::create(lineSegmentCount);
+
+    auto lineSegmentBufferInfos = createHostVisibleBuffer(context.device, DataList{lineSegmentData}, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE);
+    copyDataListToBuffers(context.device, lineSegmentBufferInfos);
+
+    auto hitBufferInfos = createHostVisibleBuffer(context.device, DataList{hitData}, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE);
+    _hitBufferInfo = hitBufferInfos.front();
+
+    Descriptors descriptors{
+        DescriptorAccelerationStructure::create(AccelerationStructures{tlas}, 0, 0),
+        DescriptorBuffer::create(lineSegmentBufferInfos, 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        DescriptorBuffer::create(hitBufferInfos, 2, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)};
+
+    _descriptorSet = DescriptorSet::create(_pipelineLayout->setLayouts.front(), descriptors);
+    _descriptorSet->compile(context);
+
+    VkCommandBuffer vk_commandBuffer = *_commandBuffer;
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(vk_commandBuffer, &beginInfo);
+
+    VkDescriptorSet vk_descriptorSet = _descriptorSet->vk(_deviceID);
+    vkCmdBindPipeline(vk_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipeline->vk(_deviceID));
+    vkCmdBindDescriptorSets(vk_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout->vk(_deviceID), 0, 1, &vk_descriptorSet, 0, nullptr);
+    vkCmdPushConstants(vk_commandBuffer, _pipelineLayout->vk(_deviceID), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(uint32_t), &lineSegmentCount);
+    vkCmdDispatch(vk_commandBuffer, (lineSegmentCount + workgroupSize - 1) / workgroupSize, 1, 1);
+
+    // make the shader writes visible to the host reading back the hits
+    VkMemoryBarrier memoryBarrier = {};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    memoryBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    vkCmdPipelineBarrier(vk_commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    vkEndCommandBuffer(vk_commandBuffer);
+
+    _fence->reset();
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &vk_commandBuffer;
+
+    VkResult result = queue->submit(submitInfo, _fence);
+    _submitted = (result == VK_SUCCESS);
+    return result;
+}
+
+bool RayQueryIntersector::completed() const
+{
+    return !_submitted || _fence->status() == VK_SUCCESS;
+}
+
+VkResult RayQueryIntersector::wait(uint64_t timeout) const
+{
+    if (!_submitted) return VK_SUCCESS;
+    return _fence->wait(timeout);
+}
+
+std::vector<RayQueryIntersector::Intersections> RayQueryIntersector::intersections(uint64_t timeout)
+{
+    std::vector<Intersections> results(_lineSegments.size());
+    if (!_submitted || !_hitBufferInfo) return results;
+
+    if (VkResult result = wait(timeout); result != VK_SUCCESS)
+    {
+        warn("RayQueryIntersector::intersections() failed to wait for ray queries to complete, result = ", result);
+        return results;
+    }
+
+    auto buffer = _hitBufferInfo->buffer;
+    auto hits = MappedData<RayQueryHitArray>::create(buffer->getDeviceMemory(_deviceID), buffer->getMemoryOffset(_deviceID) + _hitBufferInfo->offset, 0, static_cast<uint32_t>(_lineSegments.size()));
+
+    for (size_t i = 0; i < _lineSegments.size(); ++i)
+    {
+        const auto& hit = hits->at(i);
+        if (hit.ratio < 0.0f || hit.instanceIndex >= tlas->geometryInstances.size()) continue;
+
+        const auto& geometryInstance = tlas->geometryInstances[hit.instanceIndex];
+        const auto& ls = _lineSegments[i];
+
+        double ratio = hit.ratio;
+        dvec3 worldIntersection = ls.start + (ls.end - ls.start) * ratio;
+        dmat4 localToWorld(geometryInstance->transform);
+        dvec3 localIntersection = inverse(localToWorld) * worldIntersection;
+
+        // map the primitive back to the vertex indices of the draw it was built from
+        DataList arrays;
+        IndexRatios indexRatios;
+        const auto& nodePath = geometryInstance->nodePath;
+        if (auto vid = nodePath.empty() ? nullptr : dynamic_cast<const VertexIndexDraw*>(nodePath.back()))
+        {
+            for (auto& bufferInfo : vid->arrays) arrays.push_back(bufferInfo->data);
+
+            uint32_t i0, i1, i2;
+            const Data* indices = vid->indices ? vid->indices->data.get() : nullptr;
+            if (triangleIndices<ushortArray>(indices, hit.primitiveIndex, i0, i1, i2) ||
+                triangleIndices<uintArray>(indices, hit.primitiveIndex, i0, i1, i2) ||
+                triangleIndices<ubyteArray>(indices, hit.primitiveIndex, i0, i1, i2))
+            {
+                double r1 = hit.barycentrics.x;
+                double r2 = hit.barycentrics.y;
+                indexRatios = {{i0, 1.0 - r1 - r2}, {i1, r1}, {i2, r2}};
+            }
+        }
+
+        results[i].push_back(Intersection::create(localIntersection, worldIntersection, ratio, localToWorld, nodePath, arrays, indexRatios, 0));
+    }
+
+    return results;
+}
@@ -12,11 +12,16 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <algorithm>
 
+#include <vsg/io/Logger.h>
 #include <vsg/raytracing/TopLevelAccelerationStructure.h>
 
 #include <vsg/vk/CommandBuffer.h>
 #include <vsg/vk/Context.h>
 
+#include <algorithm>
+#include <cstring>
+#include <set>
+
 using namespace vsg;
 
 #define TRANSFER_BUFFERS 0
@@ -58,22 +63,91 @@ void TopLevelAccelerationStructure::compile(Context& context)
     auto instanceBufferInfo = vsg::createHostVisibleBuffer(context.device, dataList, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR, VK_SHARING_MODE_EXCLUSIVE);
     vsg::copyDataListToBuffers(context.device, instanceBufferInfo);
     _instanceBuffer = instanceBufferInfo[0]->buffer;
+    _instanceBufferInfo = instanceBufferInfo[0];
 #endif
     auto extensions = _device->getExtensions();
     VkBufferDeviceAddressInfo bufferDeviceAddressInfo{VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO, nullptr, _instanceBuffer->vk(context.deviceID)};
-    VkAccelerationStructureGeometryKHR accelerationStructureGeometry{};
-    accelerationStructureGeometry.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
-    accelerationStructureGeometry.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
-    accelerationStructureGeometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
-    accelerationStructureGeometry.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
-    accelerationStructureGeometry.geometry.instances.arrayOfPointers = VK_FALSE;
-    accelerationStructureGeometry.geometry.instances.data.deviceAddress = extensions->vkGetBufferDeviceAddressKHR(*context.device, &bufferDeviceAddressInfo);
+    _instanceGeometry = {};
+    _instanceGeometry.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+    _instanceGeometry.geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR;
+    _instanceGeometry.flags = VK_GEOMETRY_OPAQUE_BIT_KHR;
+    _instanceGeometry.geometry.instances.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR;
+    _instanceGeometry.geometry.instances.arrayOfPointers = VK_FALSE;
+    _instanceGeometry.geometry.instances.data.deviceAddress = extensions->vkGetBufferDeviceAddressKHR(*context.device, &bufferDeviceAddressInfo) + _instanceBufferInfo->offset;
 
     _accelerationStructureBuildGeometryInfo.geometryCount = 1;
-    _accelerationStructureBuildGeometryInfo.pGeometries = &accelerationStructureGeometry;
+    _accelerationStructureBuildGeometryInfo.pGeometries = &_instanceGeometry;
+    if (allowUpdate) _accelerationStructureBuildGeometryInfo.flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_UPDATE_BIT_KHR;
     _geometryPrimitiveCounts = {static_cast<uint32_t>(_instances->valueCount())};
 
     Inherit::compile(context);
 
     context.buildAccelerationStructureCommands.push_back(BuildAccelerationStructureCommand::create(context.device, _accelerationStructureBuildGeometryInfo, _accelerationStructure, _geometryPrimitiveCounts));
 }
+
+uint32_t TopLevelAccelerationStructure::update(Context& context)
+{
+    if (!_instances)
+    {
+        compile(context);
+        return static_cast<uint32_t>(geometryInstances.size());
+    }
+
+    if (geometryInstances.size() != _instances->size())
+    {
+        warn("TopLevelAccelerationStructure::update(..) number of geometryInstances changed from ", _instances->size(), " to ", geometryInstances.size(), ", a new TopLevelAccelerationStructure is required.");
+        return 0;
+    }
+
+    // find the instances whose transform, mask, flags or bottom level structure have changed
+    uint32_t numChanged = 0;
+    uint32_t first = static_cast<uint32_t>(_instances->size());
+    uint32_t last = 0;
+    for (uint32_t i = 0; i < geometryInstances.size(); i++)
+    {
+        VkGeometryInstance instance = *geometryInstances[i];
+        if (std::memcmp(&instance, &_instances->at(i), sizeof(VkGeometryInstance)) != 0)
+        {
+            _instances->set(i, instance);
+            first = std::min(first, i);
+            last = i;
+            ++numChanged;
+        }
+    }
+
+    if (numChanged == 0) return 0;
+
+    // copy only the range of changed instances into the host visible instance buffer
+    auto deviceMemory = _instanceBuffer->getDeviceMemory(context.deviceID);
+    VkDeviceSize offset = _instanceBuffer->getMemoryOffset(context.deviceID) + _instanceBufferInfo->offset + first * sizeof(VkGeometryInstance);
+    deviceMemory->copy(offset, (last - first + 1) * sizeof(VkGeometryInstance), &_instances->at(first));
+
+    // refit when the structure allows updates, otherwise rebuild it in place
+    auto mode = allowUpdate ? VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR : VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    VkDeviceSize scratchSize = allowUpdate ? _requiredUpdateScratchSize : _requiredBuildScratchSize;
+    context.scratchBufferSize = std::max(scratchSize, context.scratchBufferSize);
+
+    _accelerationStructureBuildGeometryInfo.pGeometries = &_instanceGeometry;
+    context.buildAccelerationStructureCommands.push_back(BuildAccelerationStructureCommand::create(context.device, _accelerationStructureBuildGeometryInfo, _accelerationStructure, _geometryPrimitiveCounts, mode));
+
+    return numChanged;
+}
+
+uint32_t TopLevelAccelerationStructure::compact(Context& context)
+{
+    std::set<BottomLevelAccelerationStructure*> visited;
+    uint32_t numCompacted = 0;
+    for (auto& geometryInstance : geometryInstances)
+    {
+        auto blas = geometryInstance->accelerationStructure.get();
+        if (blas && blas->allowCompaction && visited.insert(blas).second)
+        {
+            if (blas->compact(context)) ++numCompacted;
+        }
+    }
+
+    // pick up the device addresses of the compacted structures
+    if (numCompacted > 0) update(context);
+
+    return numCompacted;
+}
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/commands/BindIndexBuffer.h>
 #include <vsg/commands/BindVertexBuffers.h>
+#include <vsg/maths/quantize.h>
 #include <vsg/maths/quat.h>
 #include <vsg/maths/sample.h>
 #include <vsg/maths/transform.h>
@@ -27,6 +28,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/state/InputAssemblyState.h>
 #include <vsg/state/VertexInputState.h>
+#include <vsg/utils/CompactInstanceArrays.h>
 
 using namespace vsg;
 
@@ -198,6 +200,30 @@ void ArrayState::apply(const vsg::Data& array)
 
         vertices = proxy_vertices;
     }
+    else if (vertexAttribute.stride > 0 && (vertexAttribute.format == VK_FORMAT_R16G16B16_SNORM || vertexAttribute.format == VK_FORMAT_R16G16B16A16_SNORM ||
+                                            vertexAttribute.format == VK_FORMAT_R16G16B16_SFLOAT || vertexAttribute.format == VK_FORMAT_R16G16B16A16_SFLOAT))
+    {
+        // quantized or half float vertices can't be viewed as floats so decode them to a vec3Array, any dequantization scale and offset is provided by the parent transform
+        auto& data = arrays[vertexAttribute.binding];
+        uint32_t numVertices = static_cast<uint32_t>(data->dataSize()) / vertexAttribute.stride;
+        bool snorm = (vertexAttribute.format == VK_FORMAT_R16G16B16_SNORM || vertexAttribute.format == VK_FORMAT_R16G16B16A16_SNORM);
+
+        proxy_vertices = vsg::vec3Array::create(numVertices);
+
+        auto ptr = static_cast<const uint8_t*>(data->dataPointer()) + vertexAttribute.offset;
+        for (auto& v : *proxy_vertices)
+        {
+            uint16_t components[3];
+            std::memcpy(components, ptr, sizeof(components));
+            if (snorm)
+                v.set(snorm16ToFloat(static_cast<int16_t>(components[0])), snorm16ToFloat(static_cast<int16_t>(components[1])), snorm16ToFloat(static_cast<int16_t>(components[2])));
+            else
+                v.set(halfToFloat(components[0]), halfToFloat(components[1]), halfToFloat(components[2]));
+            ptr += vertexAttribute.stride;
+        }
+
+        vertices = proxy_vertices;
+    }
     else
     {
         vertices = nullptr;
@@ -306,7 +332,11 @@ TranslationRotationScaleArrayState::TranslationRotationScaleArrayState()
 TranslationRotationScaleArrayState::TranslationRotationScaleArrayState(const TranslationRotationScaleArrayState& rhs) :
     Inherit(rhs),
     translation_attribute_location(rhs.translation_attribute_location),
-    translationAttribute(rhs.translationAttribute)
+    rotation_attribute_location(rhs.rotation_attribute_location),
+    scale_attribute_location(rhs.scale_attribute_location),
+    translationAttribute(rhs.translationAttribute),
+    rotationAttribute(rhs.rotationAttribute),
+    scaleAttribute(rhs.scaleAttribute)
 {
 }
 
@@ -335,19 +365,16 @@ void TranslationRotationScaleArrayState::apply(const VertexInputState& vas)
 
 ref_ptr<const vec3Array> TranslationRotationScaleArrayState::vertexArray(uint32_t instanceIndex)
 {
-    auto translations = arrays[translationAttribute.binding].cast<vec3Array>();
-    auto rotations = arrays[rotationAttribute.binding].cast<quatArray>();
-    auto scales = arrays[scaleAttribute.binding].cast<vec3Array>();
+    auto arrayData = [&](const AttributeDetails& attribute) -> const Data* { return attribute.binding < arrays.size() ? arrays[attribute.binding].get() : nullptr; };
 
-    // vsg::info("TranslationRotationScaleArrayState::vertexArray(", instanceIndex, ") translations = ", translations, ", rotations = ", rotations, ", scales = ", scales);
-
-    if (translations && (instanceIndex < translations->size()) &&
-        rotations && (instanceIndex < rotations->size()) &&
-        scales && (instanceIndex < scales->size()))
+    // the per instance arrays may be in the compact formats set up by CompactInstanceArrays, so decode rather than cast them
+    vec3 translation;
+    quat rotation;
+    vec3 scale;
+    if (CompactInstanceArrays::decodeTranslation(arrayData(translationAttribute), instanceIndex, translation) &&
+        CompactInstanceArrays::decodeRotation(arrayData(rotationAttribute), instanceIndex, rotation) &&
+        CompactInstanceArrays::decodeScale(arrayData(scaleAttribute), instanceIndex, scale))
     {
-        auto translation = translations->at(instanceIndex);
-        auto rotation = rotations->at(instanceIndex);
-        auto scale = scales->at(instanceIndex);
         auto new_vertices = vsg::vec3Array::create(static_cast<uint32_t>(vertices->size()));
         auto src_vertex_itr = vertices->begin();
         for (auto& v : *new_vertices)
@@ -14,8 +14,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/Exception.h>
 #include <vsg/core/compare.h>
 #include <vsg/state/BindDescriptorSet.h>
+#include <vsg/state/RingDescriptorBuffer.h>
 #include <vsg/vk/Context.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -49,7 +52,8 @@ int BindDescriptorSets::compare(const Object& rhs_object) const
     if ((result = compare_value(pipelineBindPoint, rhs.pipelineBindPoint))) return result;
     if ((result = compare_pointer(layout, rhs.layout))) return result;
     if ((result = compare_value(firstSet, rhs.firstSet))) return result;
-    return compare_pointer_container(descriptorSets, rhs.descriptorSets);
+    if ((result = compare_pointer_container(descriptorSets, rhs.descriptorSets))) return result;
+    return compare_value_container(dynamicOffsets, rhs.dynamicOffsets);
 }
 
 void BindDescriptorSets::read(Input& input)
@@ -114,9 +118,9 @@ void BindDescriptorSets::record(CommandBuffer& commandBuffer) const
 {
     //info("BindDescriptorSets::record() ", dynamicOffsets.size(), ", ", dynamicOffsets.data());
     auto& vkd = _vulkanData[commandBuffer.deviceID];
-    vkCmdBindDescriptorSets(commandBuffer, pipelineBindPoint, vkd._vkPipelineLayout, firstSet,
-                            static_cast<uint32_t>(vkd._vkDescriptorSets.size()), vkd._vkDescriptorSets.data(),
-                            static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+    commandBuffer.bindDescriptorSets(pipelineBindPoint, layout.get(), firstSet,
+                                     static_cast<uint32_t>(vkd._vkDescriptorSets.size()), vkd._vkDescriptorSets.data(),
+                                     static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -149,7 +153,8 @@ int BindDescriptorSet::compare(const Object& rhs_object) const
     if ((result = compare_value(pipelineBindPoint, rhs.pipelineBindPoint))) return result;
     if ((result = compare_pointer(layout, rhs.layout))) return result;
     if ((result = compare_value(firstSet, rhs.firstSet))) return result;
-    return compare_pointer(descriptorSet, rhs.descriptorSet);
+    if ((result = compare_pointer(descriptorSet, rhs.descriptorSet))) return result;
+    return compare_value_container(dynamicOffsets, rhs.dynamicOffsets);
 }
 
 void BindDescriptorSet::read(Input& input)
@@ -204,13 +209,51 @@ void BindDescriptorSet::compile(Context& context)
 
     vkd._vkPipelineLayout = layout->vk(context.deviceID);
     vkd._vkDescriptorSet = descriptorSet->vk(context.deviceID);
+
+    // dynamic offsets are ordered by binding, so locate the dynamic offset index of each RingDescriptorBuffer
+    std::vector<const Descriptor*> dynamicDescriptors;
+    for (auto& descriptor : descriptorSet->descriptors)
+    {
+        if (descriptor->descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || descriptor->descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC) dynamicDescriptors.push_back(descriptor.get());
+    }
+    std::sort(dynamicDescriptors.begin(), dynamicDescriptors.end(), [](const Descriptor* lhs, const Descriptor* rhs) { return (lhs->dstBinding < rhs->dstBinding) || (lhs->dstBinding == rhs->dstBinding && lhs->dstArrayElement < rhs->dstArrayElement); });
+
+    vkd._ringDescriptorBuffers.clear();
+    vkd._numDynamicOffsets = 0;
+    for (auto& descriptor : dynamicDescriptors)
+    {
+        if (auto ring = descriptor->cast<RingDescriptorBuffer>())
+        {
+            vkd._ringDescriptorBuffers.emplace_back(vkd._numDynamicOffsets, ring);
+        }
+        vkd._numDynamicOffsets += descriptor->getNumDescriptors();
+    }
+
+    if (vkd._numDynamicOffsets > maxDynamicOffsets)
+    {
+        throw Exception{"Error: BindDescriptorSet::compile(..) DescriptorSet has more dynamic descriptors than supported."};
+    }
 }
 
 void BindDescriptorSet::record(CommandBuffer& commandBuffer) const
 {
     //info("BindDescriptorSet::record() ", dynamicOffsets.size(), ", ", dynamicOffsets.data());
     auto& vkd = _vulkanData[commandBuffer.deviceID];
-    vkCmdBindDescriptorSets(commandBuffer, pipelineBindPoint, vkd._vkPipelineLayout, firstSet,
-                            1, &(vkd._vkDescriptorSet),
-                            static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+    if (vkd._ringDescriptorBuffers.empty())
+    {
+        commandBuffer.bindDescriptorSets(pipelineBindPoint, layout.get(), firstSet,
+                                         1, &(vkd._vkDescriptorSet),
+                                         static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+        return;
+    }
+
+    // merge the current slices of the RingDescriptorBuffers with the user assigned dynamicOffsets
+    uint32_t offsets[maxDynamicOffsets];
+    uint32_t numOffsets = vkd._numDynamicOffsets;
+    for (uint32_t i = 0; i < numOffsets; ++i) offsets[i] = (i < dynamicOffsets.size()) ? dynamicOffsets[i] : 0;
+    for (auto& [index, ring] : vkd._ringDescriptorBuffers) offsets[index] = ring->dynamicOffset(commandBuffer.deviceID);
+
+    commandBuffer.bindDescriptorSets(pipelineBindPoint, layout.get(), firstSet,
+                                     1, &(vkd._vkDescriptorSet),
+                                     numOffsets, offsets);
 }
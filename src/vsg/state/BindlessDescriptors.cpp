@@ -0,0 +1,255 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/BindlessDescriptors.h>
+#include <vsg/vk/Context.h>
+
+#include <cstring>
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BindlessDescriptors
+//
+BindlessDescriptors::BindlessDescriptors()
+{
+}
+
+BindlessDescriptors::BindlessDescriptors(ref_ptr<Data> in_materials, uint32_t in_maxTextures, uint32_t in_textureBinding, uint32_t in_materialBinding) :
+    maxTextures(in_maxTextures),
+    textureBinding(in_textureBinding),
+    materialBinding(in_materialBinding),
+    materials(in_materials)
+{
+    init();
+}
+
+BindlessDescriptors::~BindlessDescriptors()
+{
+}
+
+void BindlessDescriptors::init()
+{
+    VkShaderStageFlags stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // textures array is only partially bound, new entries are written while the set is in use by previous frames so require UPDATE_UNUSED_WHILE_PENDING.
+    descriptorSetLayout = DescriptorSetLayout::create();
+    descriptorSetLayout->addBinding(textureBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, maxTextures, stageFlags, VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT);
+    descriptorSetLayout->addBinding(materialBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, 0);
+
+    Descriptors descriptors;
+    if (materials)
+    {
+        // material entries are updated via the TransferTask
+        if (materials->properties.dataVariance == STATIC_DATA) materials->properties.dataVariance = DYNAMIC_DATA;
+
+        descriptors.push_back(DescriptorBuffer::create(materials, materialBinding, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+    }
+
+    descriptorSet = DescriptorSet::create(descriptorSetLayout, descriptors);
+}
+
+uint32_t BindlessDescriptors::addTexture(ref_ptr<ImageInfo> imageInfo)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    if (auto itr = _textureIndices.find(imageInfo.get()); itr != _textureIndices.end()) return itr->second;
+
+    if (textures.size() >= maxTextures)
+    {
+        warn("BindlessDescriptors::addTexture(", imageInfo, ") texture array full, maxTextures = ", maxTextures);
+        return maxTextures;
+    }
+
+    uint32_t index = static_cast<uint32_t>(textures.size());
+    textures.push_back(imageInfo);
+    _textureIndices[imageInfo.get()] = index;
+    return index;
+}
+
+uint32_t BindlessDescriptors::addMaterial(const Data* material)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    if (!materials || _numMaterials >= materials->valueCount())
+    {
+        warn("BindlessDescriptors::addMaterial(", material, ") material array full.");
+        return materials ? static_cast<uint32_t>(materials->valueCount()) : 0;
+    }
+
+    uint32_t index = _numMaterials++;
+    if (material && material->valueSize() == materials->valueSize())
+    {
+        std::memcpy(materials->dataPointer(index), material->dataPointer(), material->valueSize());
+        materials->dirty();
+    }
+    else
+    {
+        warn("BindlessDescriptors::addMaterial(", material, ") material value size not compatible with materials array.");
+    }
+
+    return index;
+}
+
+void BindlessDescriptors::setMaterial(uint32_t index, const Data* material)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    if (materials && material && index < materials->valueCount() && material->valueSize() == materials->valueSize())
+    {
+        std::memcpy(materials->dataPointer(index), material->dataPointer(), material->valueSize());
+        materials->dirty();
+    }
+}
+
+uint32_t BindlessDescriptors::numTextures() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return static_cast<uint32_t>(textures.size());
+}
+
+uint32_t BindlessDescriptors::numMaterials() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _numMaterials;
+}
+
+void BindlessDescriptors::compile(Context& context)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    if (!descriptorSet) return;
+
+    descriptorSet->compile(context);
+
+    if (_numTexturesAssigned.size() <= context.deviceID) _numTexturesAssigned.resize(context.deviceID + 1, 0);
+
+    auto& numAssigned = _numTexturesAssigned[context.deviceID];
+    if (numAssigned >= textures.size()) return;
+
+    // only write the new entries, earlier entries may be in use by command buffers still being processed.
+    ImageInfoList newTextures(textures.begin() + numAssigned, textures.end());
+    auto descriptorImage = DescriptorImage::create(newTextures, textureBinding, numAssigned, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    descriptorImage->compile(context);
+
+    VkWriteDescriptorSet descriptorWrite = {};
+    descriptorImage->assignTo(context, descriptorWrite);
+    descriptorWrite.dstSet = descriptorSet->vk(context.deviceID);
+
+    vkUpdateDescriptorSets(*context.device, 1, &descriptorWrite, 0, nullptr);
+
+    context.scratchMemory->release();
+
+    numAssigned = static_cast<uint32_t>(textures.size());
+}
+
+void BindlessDescriptors::read(Input& input)
+{
+    Object::read(input);
+
+    input.read("maxTextures", maxTextures);
+    input.read("textureBinding", textureBinding);
+    input.read("materialBinding", materialBinding);
+    input.readObject("materials", materials);
+    input.read("numMaterials", _numMaterials);
+
+    textures.resize(input.readValue<uint32_t>("textures"));
+    for (auto& imageInfo : textures)
+    {
+        imageInfo = ImageInfo::create();
+        input.readObject("sampler", imageInfo->sampler);
+        input.readObject("imageView", imageInfo->imageView);
+        input.readValue<uint32_t>("imageLayout", imageInfo->imageLayout);
+    }
+
+    _textureIndices.clear();
+    for (size_t i = 0; i < textures.size(); ++i) _textureIndices[textures[i].get()] = static_cast<uint32_t>(i);
+    _numTexturesAssigned.clear();
+
+    init();
+}
+
+void BindlessDescriptors::write(Output& output) const
+{
+    Object::write(output);
+
+    output.write("maxTextures", maxTextures);
+    output.write("textureBinding", textureBinding);
+    output.write("materialBinding", materialBinding);
+    output.writeObject("materials", materials);
+    output.write("numMaterials", _numMaterials);
+
+    output.writeValue<uint32_t>("textures", textures.size());
+    for (const auto& imageInfo : textures)
+    {
+        output.writeObject("sampler", imageInfo->sampler);
+        output.writeObject("imageView", imageInfo->imageView);
+        output.writeValue<uint32_t>("imageLayout", imageInfo->imageLayout);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BindBindlessDescriptorSet
+//
+BindBindlessDescriptorSet::BindBindlessDescriptorSet()
+{
+}
+
+BindBindlessDescriptorSet::BindBindlessDescriptorSet(const BindBindlessDescriptorSet& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    bindlessDescriptors(rhs.bindlessDescriptors)
+{
+}
+
+BindBindlessDescriptorSet::BindBindlessDescriptorSet(VkPipelineBindPoint in_bindPoint, PipelineLayout* in_pipelineLayout, uint32_t in_firstSet, BindlessDescriptors* in_bindlessDescriptors) :
+    Inherit(in_bindPoint, in_pipelineLayout, in_firstSet, in_bindlessDescriptors->descriptorSet.get()),
+    bindlessDescriptors(in_bindlessDescriptors)
+{
+}
+
+int BindBindlessDescriptorSet::compare(const Object& rhs_object) const
+{
+    int result = BindDescriptorSet::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    return compare_pointer(bindlessDescriptors, rhs.bindlessDescriptors);
+}
+
+void BindBindlessDescriptorSet::read(Input& input)
+{
+    BindDescriptorSet::read(input);
+
+    input.readObject("bindlessDescriptors", bindlessDescriptors);
+    if (bindlessDescriptors) descriptorSet = bindlessDescriptors->descriptorSet;
+}
+
+void BindBindlessDescriptorSet::write(Output& output) const
+{
+    BindDescriptorSet::write(output);
+
+    output.writeObject("bindlessDescriptors", bindlessDescriptors);
+}
+
+void BindBindlessDescriptorSet::compile(Context& context)
+{
+    // write any new textures before the base class checks whether it has already been compiled
+    if (bindlessDescriptors) bindlessDescriptors->compile(context);
+
+    BindDescriptorSet::compile(context);
+}
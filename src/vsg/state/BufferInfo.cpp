@@ -11,11 +11,14 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/commands/CopyAndReleaseBuffer.h>
+#include <vsg/core/CompressedData.h>
 #include <vsg/core/compare.h>
 #include <vsg/io/Logger.h>
 #include <vsg/state/BufferInfo.h>
 #include <vsg/vk/Context.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -44,6 +47,87 @@ BufferInfo::~BufferInfo()
     release();
 }
 
+static void insertDirtyRange(BufferInfo::DirtyRangeList& ranges, const BufferInfo::DirtyRange& dirtyRange)
+{
+    // insert in begin order then merge any ranges that now overlap or touch
+    auto itr = std::upper_bound(ranges.begin(), ranges.end(), dirtyRange.begin, [](VkDeviceSize begin, const BufferInfo::DirtyRange& rhs) { return begin < rhs.begin; });
+    ranges.insert(itr, dirtyRange);
+
+    size_t numRanges = 0;
+    for (auto& current : ranges)
+    {
+        if (numRanges > 0 && current.begin <= ranges[numRanges - 1].end)
+            ranges[numRanges - 1].end = std::max(ranges[numRanges - 1].end, current.end);
+        else
+            ranges[numRanges++] = current;
+    }
+    ranges.resize(numRanges);
+
+    // keep the number of ranges bounded by merging the neighbours with the smallest gap between them
+    while (ranges.size() > BufferInfo::maxDirtyRanges)
+    {
+        size_t closest = 0;
+        for (size_t i = 1; i + 1 < ranges.size(); ++i)
+        {
+            if ((ranges[i + 1].begin - ranges[i].end) < (ranges[closest + 1].begin - ranges[closest].end)) closest = i;
+        }
+        ranges[closest].end = ranges[closest + 1].end;
+        ranges.erase(ranges.begin() + closest + 1);
+    }
+}
+
+void BufferInfo::dirty(VkDeviceSize rangeOffset, VkDeviceSize rangeSize)
+{
+    if (!data) return;
+
+    ModifiedCount modifiedCount;
+    data->getModifiedCount(modifiedCount);
+
+    DirtyRange dirtyRange{rangeOffset, rangeOffset + rangeSize};
+    for (uint32_t deviceID = 0; deviceID < copiedModifiedCounts.size(); ++deviceID)
+    {
+        auto& pending = pendingDirtyRanges[deviceID];
+        if (copiedModifiedCounts[deviceID] == modifiedCount)
+        {
+            // nothing pending so start a new list of ranges
+            pending.ranges.clear();
+            pending.ranges.push_back(dirtyRange);
+        }
+        else if (pending.modifiedCount == modifiedCount)
+        {
+            // all pending modifications have been marked so add to the ranges
+            insertDirtyRange(pending.ranges, dirtyRange);
+        }
+        else
+        {
+            // data has been dirtied without a range so the whole of it needs copying
+            pending.ranges.clear();
+            pending.ranges.push_back(DirtyRange{0, range});
+        }
+    }
+
+    data->dirty();
+    data->getModifiedCount(modifiedCount);
+
+    for (uint32_t deviceID = 0; deviceID < copiedModifiedCounts.size(); ++deviceID)
+    {
+        pendingDirtyRanges[deviceID].modifiedCount = modifiedCount;
+    }
+}
+
+BufferInfo::DirtyRangeList BufferInfo::dirtyRanges(uint32_t deviceID) const
+{
+    if (deviceID < pendingDirtyRanges.size())
+    {
+        auto& pending = pendingDirtyRanges[deviceID];
+        if (data && !data->differentModifiedCount(pending.modifiedCount) && !pending.ranges.empty() && pending.ranges.back().end <= range)
+        {
+            return pending.ranges;
+        }
+    }
+    return {DirtyRange{0, range}};
+}
+
 ref_ptr<Object> BufferInfo::clone(const CopyOp& copyop) const
 {
     auto new_data = copyop(data);
@@ -131,7 +215,7 @@ void BufferInfo::copyDataToBuffer(uint32_t deviceID)
         }
 
         char* ptr = reinterpret_cast<char*>(buffer_data);
-        std::memcpy(ptr, data->dataPointer(), data->dataSize());
+        copyData(*data, ptr);
 
         dm->unmap();
     }
@@ -159,7 +243,7 @@ ref_ptr<BufferInfo> vsg::copyDataToStagingBuffer(Context& context, const Data* d
     if (!imageStagingMemory) return {};
 
     // copy data to staging memory
-    imageStagingMemory->copy(imageStagingBuffer->getMemoryOffset(context.deviceID) + stagingBufferInfo->offset, imageTotalSize, data->dataPointer());
+    imageStagingMemory->copy(imageStagingBuffer->getMemoryOffset(context.deviceID) + stagingBufferInfo->offset, data);
 
     debug("Creating imageStagingBuffer and memory size = ", imageTotalSize);
 
@@ -255,7 +339,7 @@ bool vsg::createBufferAndTransferData(Context& context, const BufferInfoList& bu
                 VkMemoryRequirements memRequirements;
                 vkGetBufferMemoryRequirements(*device, deviceBufferInfo->buffer->vk(device->deviceID), &memRequirements);
 
-                auto deviceMemoryOffset = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+                auto deviceMemoryOffset = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, nullptr, context.memoryPriority);
                 if (!deviceMemoryOffset.first)
                     deviceBufferInfo->buffer->bind(deviceMemoryOffset.first, deviceMemoryOffset.second);
                 else
@@ -270,7 +354,7 @@ bool vsg::createBufferAndTransferData(Context& context, const BufferInfoList& bu
     if (!deviceBufferInfo)
     {
         VkBufferUsageFlags bufferUsageFlags = VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage;
-        deviceBufferInfo = context.deviceMemoryBufferPools->reserveBuffer(totalSize, alignment, bufferUsageFlags, sharingMode, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        deviceBufferInfo = context.deviceMemoryBufferPools->reserveBuffer(totalSize, alignment, bufferUsageFlags, sharingMode, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, context.memoryPriority);
     }
 
     if (!deviceBufferInfo)
@@ -327,7 +411,7 @@ bool vsg::createBufferAndTransferData(Context& context, const BufferInfoList& bu
         const Data* data = bufferInfo->data;
         if (data)
         {
-            std::memcpy(ptr + bufferInfo->offset - deviceBufferInfo->offset, data->dataPointer(), data->dataSize());
+            copyData(*data, ptr + bufferInfo->offset - deviceBufferInfo->offset);
             if (data->properties.dataVariance == STATIC_DATA_UNREF_AFTER_TRANSFER)
             {
                 bufferInfo->data.reset();
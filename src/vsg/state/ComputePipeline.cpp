@@ -85,7 +85,20 @@ void ComputePipeline::compile(Context& context)
 
         layout->compile(context);
         stage->compile(context);
-        _implementation[context.deviceID] = ComputePipeline::Implementation::create(context, context.device, layout, stage);
+        if (context.operationThreads)
+        {
+            // assign the Implementation now but leave the creation of the VkPipeline to the operationThreads
+            auto implementation = ComputePipeline::Implementation::create(context.device);
+            _implementation[context.deviceID] = implementation;
+
+            context.compileInParallel([implementation, pipelineLayout = layout, shaderStage = stage](Context& threadContext) {
+                implementation->create(threadContext, pipelineLayout, shaderStage);
+            });
+        }
+        else
+        {
+            _implementation[context.deviceID] = ComputePipeline::Implementation::create(context, context.device, layout, stage);
+        }
     }
 }
 
@@ -96,6 +109,18 @@ void ComputePipeline::compile(Context& context)
 ComputePipeline::Implementation::Implementation(Context& context, Device* device, const PipelineLayout* pipelineLayout, const ShaderStage* shaderStage) :
     _device(device)
 {
+    create(context, pipelineLayout, shaderStage);
+}
+
+ComputePipeline::Implementation::Implementation(Device* device) :
+    _device(device)
+{
+}
+
+void ComputePipeline::Implementation::create(Context& context, const PipelineLayout* pipelineLayout, const ShaderStage* shaderStage)
+{
+    Device* device = _device;
+
     VkPipelineShaderStageCreateInfo stageInfo = {};
     stageInfo.pNext = nullptr;
     shaderStage->apply(context, stageInfo);
@@ -107,7 +132,8 @@ ComputePipeline::Implementation::Implementation(Context& context, Device* device
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineInfo.pNext = nullptr;
 
-    if (VkResult result = vkCreateComputePipelines(*device, VK_NULL_HANDLE, 1, &pipelineInfo, _device->getAllocationCallbacks(), &_pipeline); result != VK_SUCCESS)
+    VkPipelineCache pipelineCache = context.pipelineCache ? context.pipelineCache->vk() : VK_NULL_HANDLE;
+    if (VkResult result = vkCreateComputePipelines(*device, pipelineCache, 1, &pipelineInfo, _device->getAllocationCallbacks(), &_pipeline); result != VK_SUCCESS)
     {
         throw Exception{"Error: vsg::ComputePipeline failed to create VkPipeline.", result};
     }
@@ -158,7 +184,7 @@ void BindComputePipeline::write(Output& output) const
 void BindComputePipeline::record(CommandBuffer& commandBuffer) const
 {
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->vk(commandBuffer.deviceID));
-    commandBuffer.setCurrentPipelineLayout(pipeline->layout);
+    commandBuffer.setCurrentPipelineLayout(pipeline->layout, VK_PIPELINE_BIND_POINT_COMPUTE);
 }
 
 void BindComputePipeline::compile(Context& context)
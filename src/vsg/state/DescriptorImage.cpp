@@ -10,6 +10,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/app/TransferTask.h>
 #include <vsg/commands/CopyAndReleaseImage.h>
 #include <vsg/core/compare.h>
 #include <vsg/state/DescriptorImage.h>
@@ -119,6 +120,12 @@ void DescriptorImage::compile(Context& context)
                 imageInfo->computeNumMipMapLevels();
             }
 
+            // images whose mipmaps are generated by the TransferTask's compute shader require storage usage before they are created
+            if (transferTask && transferTask->mipmapGenerator && imageInfo->imageView->image)
+            {
+                transferTask->mipmapGenerator->prepare(*imageInfo->imageView->image);
+            }
+
             auto& imageView = *imageInfo->imageView;
             imageView.compile(context);
 
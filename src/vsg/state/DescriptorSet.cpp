@@ -16,6 +16,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/DescriptorSet.h>
 #include <vsg/vk/Context.h>
 
+#include <cstring>
+
 using namespace vsg;
 
 DescriptorSet::DescriptorSet()
@@ -156,12 +158,71 @@ void DescriptorSet::Implementation::assign(Context& context, const Descriptors&
     }
 
     auto device = _descriptorPool->getDevice();
+
+    // write the descriptors with the layout's cached VkDescriptorUpdateTemplate, reducing the work the driver has to do parsing VkWriteDescriptorSet
+    if (device->getExtensions()->vkUpdateDescriptorSetWithTemplate && _assignWithTemplate(context, descriptorWrites, static_cast<uint32_t>(in_descriptors.size())))
+    {
+        context.scratchMemory->release();
+        return;
+    }
+
     vkUpdateDescriptorSets(*device, static_cast<uint32_t>(in_descriptors.size()), descriptorWrites, 0, nullptr);
 
     // clean up scratch memory so it can be reused.
     context.scratchMemory->release();
 }
 
+bool DescriptorSet::Implementation::_assignWithTemplate(Context& context, const VkWriteDescriptorSet* descriptorWrites, uint32_t descriptorWriteCount)
+{
+    auto entries = context.scratchMemory->allocate<VkDescriptorUpdateTemplateEntry>(descriptorWriteCount);
+
+    // pack the image, buffer and texel buffer view infos of the writes consecutively
+    size_t dataSize = 0;
+    for (uint32_t i = 0; i < descriptorWriteCount; ++i)
+    {
+        auto& write = descriptorWrites[i];
+
+        // writes of inline uniform blocks and acceleration structures are chained via pNext so aren't supported by the template path
+        if (write.pNext) return false;
+
+        size_t stride = 0;
+        if (write.pImageInfo)
+            stride = sizeof(VkDescriptorImageInfo);
+        else if (write.pBufferInfo)
+            stride = sizeof(VkDescriptorBufferInfo);
+        else if (write.pTexelBufferView)
+            stride = sizeof(VkBufferView);
+        else
+            return false;
+
+        auto& entry = entries[i];
+        entry.dstBinding = write.dstBinding;
+        entry.dstArrayElement = write.dstArrayElement;
+        entry.descriptorCount = write.descriptorCount;
+        entry.descriptorType = write.descriptorType;
+        entry.offset = dataSize;
+        entry.stride = stride;
+
+        dataSize += stride * write.descriptorCount;
+    }
+
+    auto device = _descriptorPool->getDevice();
+    auto updateTemplate = _descriptorSetLayout->getOrCreateUpdateTemplate(device->deviceID, entries, descriptorWriteCount);
+    if (!updateTemplate) return false;
+
+    // all the info structs contain 64bit handles so allocate as uint64_t to keep them aligned
+    auto data = reinterpret_cast<uint8_t*>(context.scratchMemory->allocate<uint64_t>((dataSize + sizeof(uint64_t) - 1) / sizeof(uint64_t)));
+    for (uint32_t i = 0; i < descriptorWriteCount; ++i)
+    {
+        auto& write = descriptorWrites[i];
+        const void* src = write.pImageInfo ? static_cast<const void*>(write.pImageInfo) : (write.pBufferInfo ? static_cast<const void*>(write.pBufferInfo) : static_cast<const void*>(write.pTexelBufferView));
+        std::memcpy(data + entries[i].offset, src, entries[i].stride * write.descriptorCount);
+    }
+
+    device->getExtensions()->vkUpdateDescriptorSetWithTemplate(*device, _descriptorSet, updateTemplate, data);
+    return true;
+}
+
 void DescriptorSet::Implementation::recycle(ref_ptr<DescriptorSet::Implementation>& dsi)
 {
     if (dsi)
@@ -146,6 +146,54 @@ void DescriptorSetLayout::compile(Context& context)
     if (!_implementation[context.deviceID]) _implementation[context.deviceID] = DescriptorSetLayout::Implementation::create(context.device, createFlags, bindings, bindingFlags);
 }
 
+VkDescriptorUpdateTemplate DescriptorSetLayout::getOrCreateUpdateTemplate(uint32_t deviceID, const VkDescriptorUpdateTemplateEntry* entries, uint32_t entryCount)
+{
+    auto& implementation = _implementation[deviceID];
+    if (!implementation) return VK_NULL_HANDLE;
+
+    auto extensions = implementation->_device->getExtensions();
+    if (!extensions->vkCreateDescriptorUpdateTemplate) return VK_NULL_HANDLE;
+
+    auto matches = [&](const Implementation::UpdateTemplate& updateTemplate) {
+        if (updateTemplate.entries.size() != entryCount) return false;
+        for (uint32_t i = 0; i < entryCount; ++i)
+        {
+            auto& lhs = updateTemplate.entries[i];
+            auto& rhs = entries[i];
+            if (lhs.dstBinding != rhs.dstBinding || lhs.dstArrayElement != rhs.dstArrayElement || lhs.descriptorCount != rhs.descriptorCount ||
+                lhs.descriptorType != rhs.descriptorType || lhs.offset != rhs.offset || lhs.stride != rhs.stride) return false;
+        }
+        return true;
+    };
+
+    // DescriptorSet are compiled from multiple threads so the templates are shared under a mutex
+    std::scoped_lock<std::mutex> lock(implementation->_updateTemplatesMutex);
+
+    for (auto& updateTemplate : implementation->_updateTemplates)
+    {
+        if (matches(updateTemplate)) return updateTemplate.updateTemplate;
+    }
+
+    VkDescriptorUpdateTemplateCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.descriptorUpdateEntryCount = entryCount;
+    createInfo.pDescriptorUpdateEntries = entries;
+    createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    createInfo.descriptorSetLayout = implementation->_descriptorSetLayout;
+
+    Implementation::UpdateTemplate updateTemplate;
+    updateTemplate.entries.assign(entries, entries + entryCount);
+    if (VkResult result = extensions->vkCreateDescriptorUpdateTemplate(*(implementation->_device), &createInfo, implementation->_device->getAllocationCallbacks(), &updateTemplate.updateTemplate); result != VK_SUCCESS)
+    {
+        throw Exception{"Error: Failed to create DescriptorUpdateTemplate.", result};
+    }
+
+    implementation->_updateTemplates.push_back(updateTemplate);
+    return updateTemplate.updateTemplate;
+}
+
 //////////////////////////////////////
 //
 // DescriptorSetLayout::Implementation
@@ -180,6 +228,15 @@ DescriptorSetLayout::Implementation::Implementation(Device* device, VkDescriptor
 
 DescriptorSetLayout::Implementation::~Implementation()
 {
+    if (!_updateTemplates.empty())
+    {
+        auto extensions = _device->getExtensions();
+        for (auto& updateTemplate : _updateTemplates)
+        {
+            extensions->vkDestroyDescriptorUpdateTemplate(*_device, updateTemplate.updateTemplate, _device->getAllocationCallbacks());
+        }
+    }
+
     if (_descriptorSetLayout)
     {
         vkDestroyDescriptorSetLayout(*_device, _descriptorSetLayout, _device->getAllocationCallbacks());
@@ -0,0 +1,131 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Exception.h>
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/DynamicDescriptorBuffer.h>
+#include <vsg/vk/Context.h>
+
+#include <cstring>
+
+using namespace vsg;
+
+DynamicDescriptorBuffer::DynamicDescriptorBuffer() :
+    Inherit(BufferInfoList{}, 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+{
+}
+
+DynamicDescriptorBuffer::DynamicDescriptorBuffer(const DynamicDescriptorBuffer& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    numObjects(rhs.numObjects),
+    objectSize(rhs.objectSize),
+    stride(rhs.stride),
+    data(bufferInfoList.empty() ? copyop(rhs.data) : bufferInfoList.front()->data.cast<ubyteArray>())
+{
+}
+
+DynamicDescriptorBuffer::DynamicDescriptorBuffer(uint32_t in_numObjects, uint32_t in_objectSize, uint32_t in_dstBinding, VkDescriptorType in_descriptorType, uint32_t alignment) :
+    Inherit(BufferInfoList{}, in_dstBinding, 0, in_descriptorType),
+    numObjects(in_numObjects),
+    objectSize(in_objectSize),
+    stride(((in_objectSize + alignment - 1) / alignment) * alignment)
+{
+    data = ubyteArray::create(numObjects * stride, 0);
+    bufferInfoList.push_back(BufferInfo::create(data));
+}
+
+DynamicDescriptorBuffer::~DynamicDescriptorBuffer()
+{
+}
+
+void DynamicDescriptorBuffer::assign(uint32_t index, const Data& objectData)
+{
+    if (index >= numObjects || objectData.dataSize() > objectSize)
+    {
+        warn("DynamicDescriptorBuffer::assign(", index, ", ", &objectData, ") objectData doesn't fit within the object storage, numObjects = ", numObjects, ", objectSize = ", objectSize);
+        return;
+    }
+
+    std::memcpy(data->data(dynamicOffset(index)), objectData.dataPointer(), objectData.dataSize());
+    data->dirty();
+}
+
+int DynamicDescriptorBuffer::compare(const Object& rhs_object) const
+{
+    int result = DescriptorBuffer::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+
+    if ((result = compare_value(numObjects, rhs.numObjects))) return result;
+    if ((result = compare_value(objectSize, rhs.objectSize))) return result;
+    return compare_value(stride, rhs.stride);
+}
+
+void DynamicDescriptorBuffer::read(Input& input)
+{
+    Descriptor::read(input);
+
+    input.read("numObjects", numObjects);
+    input.read("objectSize", objectSize);
+    input.read("stride", stride);
+    input.readObject("data", data);
+
+    bufferInfoList.clear();
+    if (data) bufferInfoList.push_back(BufferInfo::create(data));
+}
+
+void DynamicDescriptorBuffer::write(Output& output) const
+{
+    Descriptor::write(output);
+
+    output.write("numObjects", numObjects);
+    output.write("objectSize", objectSize);
+    output.write("stride", stride);
+    output.writeObject("data", data);
+}
+
+void DynamicDescriptorBuffer::compile(Context& context)
+{
+    const auto& limits = context.device->getPhysicalDevice()->getProperties().limits;
+    bool storage = (descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC || descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    VkDeviceSize minAlignment = storage ? limits.minStorageBufferOffsetAlignment : limits.minUniformBufferOffsetAlignment;
+    if (stride == 0 || (stride % minAlignment) != 0)
+    {
+        throw Exception{"Error: DynamicDescriptorBuffer::compile(..) stride is not a multiple of the device's minimum buffer offset alignment."};
+    }
+
+    DescriptorBuffer::compile(context);
+}
+
+void DynamicDescriptorBuffer::assignTo(Context& context, VkWriteDescriptorSet& wds) const
+{
+    Descriptor::assignTo(context, wds);
+
+    auto pBufferInfo = context.scratchMemory->allocate<VkDescriptorBufferInfo>(bufferInfoList.size());
+    wds.descriptorCount = static_cast<uint32_t>(bufferInfoList.size());
+    wds.pBufferInfo = pBufferInfo;
+
+    // the descriptor covers a single object, the BindDescriptorSet::dynamicOffsets select which one
+    for (size_t i = 0; i < bufferInfoList.size(); ++i)
+    {
+        auto& bufferInfo = bufferInfoList[i];
+        VkDescriptorBufferInfo& info = pBufferInfo[i];
+        info.buffer = bufferInfo->buffer->vk(context.deviceID);
+        info.offset = bufferInfo->offset;
+        info.range = objectSize;
+    }
+}
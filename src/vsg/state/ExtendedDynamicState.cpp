@@ -0,0 +1,311 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/ColorBlendState.h>
+#include <vsg/state/DepthStencilState.h>
+#include <vsg/state/ExtendedDynamicState.h>
+#include <vsg/state/InputAssemblyState.h>
+#include <vsg/state/RasterizationState.h>
+#include <vsg/vk/CommandBuffer.h>
+
+using namespace vsg;
+
+// return the first topology of the same topology class, dynamic primitive topology only allows topologies of the same class as the pipeline was created with
+static VkPrimitiveTopology topologyClass(VkPrimitiveTopology topology)
+{
+    switch (topology)
+    {
+    case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+        return VK_PRIMITIVE_TOPOLOGY_POINT_LIST;
+    case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+    case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+    case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+    case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+        return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+    case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+        return VK_PRIMITIVE_TOPOLOGY_PATCH_LIST;
+    default:
+        return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    }
+}
+
+ExtendedDynamicState::ExtendedDynamicState(uint32_t in_mask) :
+    mask(in_mask)
+{
+}
+
+ExtendedDynamicState::ExtendedDynamicState(const ExtendedDynamicState& eds) :
+    Inherit(eds),
+    mask(eds.mask),
+    primitiveTopology(eds.primitiveTopology),
+    primitiveRestartEnable(eds.primitiveRestartEnable),
+    rasterizerDiscardEnable(eds.rasterizerDiscardEnable),
+    polygonMode(eds.polygonMode),
+    cullMode(eds.cullMode),
+    frontFace(eds.frontFace),
+    depthBiasEnable(eds.depthBiasEnable),
+    depthTestEnable(eds.depthTestEnable),
+    depthWriteEnable(eds.depthWriteEnable),
+    depthCompareOp(eds.depthCompareOp),
+    depthBoundsTestEnable(eds.depthBoundsTestEnable),
+    stencilTestEnable(eds.stencilTestEnable),
+    colorBlendEnables(eds.colorBlendEnables),
+    colorWriteMasks(eds.colorWriteMasks)
+{
+}
+
+ExtendedDynamicState::~ExtendedDynamicState()
+{
+}
+
+uint32_t ExtendedDynamicState::supportedStates(Device* device)
+{
+    auto extensions = device->getExtensions();
+
+    uint32_t supported = NO_STATES;
+    if (extensions->vkCmdSetCullMode) supported |= CULL_MODE;
+    if (extensions->vkCmdSetFrontFace) supported |= FRONT_FACE;
+    if (extensions->vkCmdSetPrimitiveTopology) supported |= PRIMITIVE_TOPOLOGY;
+    if (extensions->vkCmdSetDepthTestEnable) supported |= DEPTH_TEST_ENABLE;
+    if (extensions->vkCmdSetDepthWriteEnable) supported |= DEPTH_WRITE_ENABLE;
+    if (extensions->vkCmdSetDepthCompareOp) supported |= DEPTH_COMPARE_OP;
+    if (extensions->vkCmdSetDepthBoundsTestEnable) supported |= DEPTH_BOUNDS_TEST_ENABLE;
+    if (extensions->vkCmdSetStencilTestEnable) supported |= STENCIL_TEST_ENABLE;
+    if (extensions->vkCmdSetRasterizerDiscardEnable) supported |= RASTERIZER_DISCARD_ENABLE;
+    if (extensions->vkCmdSetDepthBiasEnable) supported |= DEPTH_BIAS_ENABLE;
+    if (extensions->vkCmdSetPrimitiveRestartEnable) supported |= PRIMITIVE_RESTART_ENABLE;
+    if (extensions->vkCmdSetPolygonModeEXT) supported |= POLYGON_MODE;
+    if (extensions->vkCmdSetColorBlendEnableEXT) supported |= COLOR_BLEND_ENABLE;
+    if (extensions->vkCmdSetColorWriteMaskEXT) supported |= COLOR_WRITE_MASK;
+    return supported;
+}
+
+void ExtendedDynamicState::set(const GraphicsPipelineStates& pipelineStates)
+{
+    for (const auto& pipelineState : pipelineStates)
+    {
+        if (auto ias = pipelineState.cast<InputAssemblyState>())
+        {
+            if (mask & PRIMITIVE_TOPOLOGY) primitiveTopology = ias->topology;
+            if (mask & PRIMITIVE_RESTART_ENABLE) primitiveRestartEnable = ias->primitiveRestartEnable;
+        }
+        else if (auto rs = pipelineState.cast<RasterizationState>())
+        {
+            if (mask & RASTERIZER_DISCARD_ENABLE) rasterizerDiscardEnable = rs->rasterizerDiscardEnable;
+            if (mask & POLYGON_MODE) polygonMode = rs->polygonMode;
+            if (mask & CULL_MODE) cullMode = rs->cullMode;
+            if (mask & FRONT_FACE) frontFace = rs->frontFace;
+            if (mask & DEPTH_BIAS_ENABLE) depthBiasEnable = rs->depthBiasEnable;
+        }
+        else if (auto dss = pipelineState.cast<DepthStencilState>())
+        {
+            if (mask & DEPTH_TEST_ENABLE) depthTestEnable = dss->depthTestEnable;
+            if (mask & DEPTH_WRITE_ENABLE) depthWriteEnable = dss->depthWriteEnable;
+            if (mask & DEPTH_COMPARE_OP) depthCompareOp = dss->depthCompareOp;
+            if (mask & DEPTH_BOUNDS_TEST_ENABLE) depthBoundsTestEnable = dss->depthBoundsTestEnable;
+            if (mask & STENCIL_TEST_ENABLE) stencilTestEnable = dss->stencilTestEnable;
+        }
+        else if (auto cbs = pipelineState.cast<ColorBlendState>())
+        {
+            colorBlendEnables.clear();
+            colorWriteMasks.clear();
+            for (const auto& attachment : cbs->attachments)
+            {
+                if (mask & COLOR_BLEND_ENABLE) colorBlendEnables.push_back(attachment.blendEnable);
+                if (mask & COLOR_WRITE_MASK) colorWriteMasks.push_back(attachment.colorWriteMask);
+            }
+        }
+    }
+}
+
+GraphicsPipelineStates ExtendedDynamicState::normalize(const GraphicsPipelineStates& pipelineStates) const
+{
+    GraphicsPipelineStates normalized;
+    normalized.reserve(pipelineStates.size() + 1);
+
+    auto defaultRasterizationState = RasterizationState::create();
+    auto defaultDepthStencilState = DepthStencilState::create();
+
+    for (const auto& pipelineState : pipelineStates)
+    {
+        if (auto ias = pipelineState.cast<InputAssemblyState>(); ias && (mask & (PRIMITIVE_TOPOLOGY | PRIMITIVE_RESTART_ENABLE)))
+        {
+            auto copy = InputAssemblyState::create(*ias);
+            if (mask & PRIMITIVE_TOPOLOGY) copy->topology = topologyClass(ias->topology);
+            if (mask & PRIMITIVE_RESTART_ENABLE) copy->primitiveRestartEnable = VK_FALSE;
+            normalized.push_back(copy);
+        }
+        else if (auto rs = pipelineState.cast<RasterizationState>(); rs && (mask & (RASTERIZER_DISCARD_ENABLE | POLYGON_MODE | CULL_MODE | FRONT_FACE | DEPTH_BIAS_ENABLE)))
+        {
+            auto copy = RasterizationState::create(*rs);
+            if (mask & RASTERIZER_DISCARD_ENABLE) copy->rasterizerDiscardEnable = defaultRasterizationState->rasterizerDiscardEnable;
+            if (mask & POLYGON_MODE) copy->polygonMode = defaultRasterizationState->polygonMode;
+            if (mask & CULL_MODE) copy->cullMode = defaultRasterizationState->cullMode;
+            if (mask & FRONT_FACE) copy->frontFace = defaultRasterizationState->frontFace;
+            if (mask & DEPTH_BIAS_ENABLE) copy->depthBiasEnable = defaultRasterizationState->depthBiasEnable;
+            normalized.push_back(copy);
+        }
+        else if (auto dss = pipelineState.cast<DepthStencilState>(); dss && (mask & (DEPTH_TEST_ENABLE | DEPTH_WRITE_ENABLE | DEPTH_COMPARE_OP | DEPTH_BOUNDS_TEST_ENABLE | STENCIL_TEST_ENABLE)))
+        {
+            auto copy = DepthStencilState::create(*dss);
+            if (mask & DEPTH_TEST_ENABLE) copy->depthTestEnable = defaultDepthStencilState->depthTestEnable;
+            if (mask & DEPTH_WRITE_ENABLE) copy->depthWriteEnable = defaultDepthStencilState->depthWriteEnable;
+            if (mask & DEPTH_COMPARE_OP) copy->depthCompareOp = defaultDepthStencilState->depthCompareOp;
+            if (mask & DEPTH_BOUNDS_TEST_ENABLE) copy->depthBoundsTestEnable = defaultDepthStencilState->depthBoundsTestEnable;
+            if (mask & STENCIL_TEST_ENABLE) copy->stencilTestEnable = defaultDepthStencilState->stencilTestEnable;
+            normalized.push_back(copy);
+        }
+        else if (auto cbs = pipelineState.cast<ColorBlendState>(); cbs && (mask & (COLOR_BLEND_ENABLE | COLOR_WRITE_MASK)))
+        {
+            auto copy = ColorBlendState::create(*cbs);
+            for (auto& attachment : copy->attachments)
+            {
+                if (mask & COLOR_BLEND_ENABLE) attachment.blendEnable = VK_FALSE;
+                if (mask & COLOR_WRITE_MASK) attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+            }
+            normalized.push_back(copy);
+        }
+        else
+        {
+            normalized.push_back(pipelineState);
+        }
+    }
+
+    auto states = dynamicStates();
+    if (!states.empty()) mergeGraphicsPipelineStates(MASK_ALL, normalized, DynamicState::create(states));
+
+    return normalized;
+}
+
+DynamicState::DynamicStates ExtendedDynamicState::dynamicStates() const
+{
+    DynamicState::DynamicStates states;
+    if (mask & CULL_MODE) states.push_back(VK_DYNAMIC_STATE_CULL_MODE_EXT);
+    if (mask & FRONT_FACE) states.push_back(VK_DYNAMIC_STATE_FRONT_FACE_EXT);
+    if (mask & PRIMITIVE_TOPOLOGY) states.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY_EXT);
+    if (mask & DEPTH_TEST_ENABLE) states.push_back(VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT);
+    if (mask & DEPTH_WRITE_ENABLE) states.push_back(VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT);
+    if (mask & DEPTH_COMPARE_OP) states.push_back(VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT);
+    if (mask & DEPTH_BOUNDS_TEST_ENABLE) states.push_back(VK_DYNAMIC_STATE_DEPTH_BOUNDS_TEST_ENABLE_EXT);
+    if (mask & STENCIL_TEST_ENABLE) states.push_back(VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT);
+    if (mask & RASTERIZER_DISCARD_ENABLE) states.push_back(VK_DYNAMIC_STATE_RASTERIZER_DISCARD_ENABLE_EXT);
+    if (mask & DEPTH_BIAS_ENABLE) states.push_back(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT);
+    if (mask & PRIMITIVE_RESTART_ENABLE) states.push_back(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE_EXT);
+    if (mask & POLYGON_MODE) states.push_back(VK_DYNAMIC_STATE_POLYGON_MODE_EXT);
+    if (mask & COLOR_BLEND_ENABLE) states.push_back(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT);
+    if (mask & COLOR_WRITE_MASK) states.push_back(VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT);
+    return states;
+}
+
+void ExtendedDynamicState::record(CommandBuffer& commandBuffer) const
+{
+    auto extensions = commandBuffer.getDevice()->getExtensions();
+
+    if ((mask & CULL_MODE) && extensions->vkCmdSetCullMode) extensions->vkCmdSetCullMode(commandBuffer, cullMode);
+    if ((mask & FRONT_FACE) && extensions->vkCmdSetFrontFace) extensions->vkCmdSetFrontFace(commandBuffer, frontFace);
+    if ((mask & PRIMITIVE_TOPOLOGY) && extensions->vkCmdSetPrimitiveTopology) extensions->vkCmdSetPrimitiveTopology(commandBuffer, primitiveTopology);
+    if ((mask & DEPTH_TEST_ENABLE) && extensions->vkCmdSetDepthTestEnable) extensions->vkCmdSetDepthTestEnable(commandBuffer, depthTestEnable);
+    if ((mask & DEPTH_WRITE_ENABLE) && extensions->vkCmdSetDepthWriteEnable) extensions->vkCmdSetDepthWriteEnable(commandBuffer, depthWriteEnable);
+    if ((mask & DEPTH_COMPARE_OP) && extensions->vkCmdSetDepthCompareOp) extensions->vkCmdSetDepthCompareOp(commandBuffer, depthCompareOp);
+    if ((mask & DEPTH_BOUNDS_TEST_ENABLE) && extensions->vkCmdSetDepthBoundsTestEnable) extensions->vkCmdSetDepthBoundsTestEnable(commandBuffer, depthBoundsTestEnable);
+    if ((mask & STENCIL_TEST_ENABLE) && extensions->vkCmdSetStencilTestEnable) extensions->vkCmdSetStencilTestEnable(commandBuffer, stencilTestEnable);
+    if ((mask & RASTERIZER_DISCARD_ENABLE) && extensions->vkCmdSetRasterizerDiscardEnable) extensions->vkCmdSetRasterizerDiscardEnable(commandBuffer, rasterizerDiscardEnable);
+    if ((mask & DEPTH_BIAS_ENABLE) && extensions->vkCmdSetDepthBiasEnable) extensions->vkCmdSetDepthBiasEnable(commandBuffer, depthBiasEnable);
+    if ((mask & PRIMITIVE_RESTART_ENABLE) && extensions->vkCmdSetPrimitiveRestartEnable) extensions->vkCmdSetPrimitiveRestartEnable(commandBuffer, primitiveRestartEnable);
+    if ((mask & POLYGON_MODE) && extensions->vkCmdSetPolygonModeEXT) extensions->vkCmdSetPolygonModeEXT(commandBuffer, polygonMode);
+
+    if ((mask & COLOR_BLEND_ENABLE) && extensions->vkCmdSetColorBlendEnableEXT && !colorBlendEnables.empty())
+    {
+        extensions->vkCmdSetColorBlendEnableEXT(commandBuffer, 0, static_cast<uint32_t>(colorBlendEnables.size()), colorBlendEnables.data());
+    }
+
+    if ((mask & COLOR_WRITE_MASK) && extensions->vkCmdSetColorWriteMaskEXT && !colorWriteMasks.empty())
+    {
+        extensions->vkCmdSetColorWriteMaskEXT(commandBuffer, 0, static_cast<uint32_t>(colorWriteMasks.size()), colorWriteMasks.data());
+    }
+}
+
+int ExtendedDynamicState::compare(const Object& rhs_object) const
+{
+    int result = Object::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_region(mask, stencilTestEnable, rhs.mask))) return result;
+    if ((result = compare_value_container(colorBlendEnables, rhs.colorBlendEnables))) return result;
+    return compare_value_container(colorWriteMasks, rhs.colorWriteMasks);
+}
+
+void ExtendedDynamicState::read(Input& input)
+{
+    Object::read(input);
+
+    input.read("mask", mask);
+    input.readValue<uint32_t>("primitiveTopology", primitiveTopology);
+    input.readValue<uint32_t>("primitiveRestartEnable", primitiveRestartEnable);
+    input.readValue<uint32_t>("rasterizerDiscardEnable", rasterizerDiscardEnable);
+    input.readValue<uint32_t>("polygonMode", polygonMode);
+    input.readValue<uint32_t>("cullMode", cullMode);
+    input.readValue<uint32_t>("frontFace", frontFace);
+    input.readValue<uint32_t>("depthBiasEnable", depthBiasEnable);
+    input.readValue<uint32_t>("depthTestEnable", depthTestEnable);
+    input.readValue<uint32_t>("depthWriteEnable", depthWriteEnable);
+    input.readValue<uint32_t>("depthCompareOp", depthCompareOp);
+    input.readValue<uint32_t>("depthBoundsTestEnable", depthBoundsTestEnable);
+    input.readValue<uint32_t>("stencilTestEnable", stencilTestEnable);
+
+    colorBlendEnables.resize(input.readValue<uint32_t>("NumColorBlendEnables"));
+    for (auto& colorBlendEnable : colorBlendEnables)
+    {
+        input.readValue<uint32_t>("value", colorBlendEnable);
+    }
+
+    colorWriteMasks.resize(input.readValue<uint32_t>("NumColorWriteMasks"));
+    for (auto& colorWriteMask : colorWriteMasks)
+    {
+        input.readValue<uint32_t>("value", colorWriteMask);
+    }
+}
+
+void ExtendedDynamicState::write(Output& output) const
+{
+    Object::write(output);
+
+    output.write("mask", mask);
+    output.writeValue<uint32_t>("primitiveTopology", primitiveTopology);
+    output.writeValue<uint32_t>("primitiveRestartEnable", primitiveRestartEnable);
+    output.writeValue<uint32_t>("rasterizerDiscardEnable", rasterizerDiscardEnable);
+    output.writeValue<uint32_t>("polygonMode", polygonMode);
+    output.writeValue<uint32_t>("cullMode", cullMode);
+    output.writeValue<uint32_t>("frontFace", frontFace);
+    output.writeValue<uint32_t>("depthBiasEnable", depthBiasEnable);
+    output.writeValue<uint32_t>("depthTestEnable", depthTestEnable);
+    output.writeValue<uint32_t>("depthWriteEnable", depthWriteEnable);
+    output.writeValue<uint32_t>("depthCompareOp", depthCompareOp);
+    output.writeValue<uint32_t>("depthBoundsTestEnable", depthBoundsTestEnable);
+    output.writeValue<uint32_t>("stencilTestEnable", stencilTestEnable);
+
+    output.writeValue<uint32_t>("NumColorBlendEnables", colorBlendEnables.size());
+    for (auto& colorBlendEnable : colorBlendEnables)
+    {
+        output.writeValue<uint32_t>("value", colorBlendEnable);
+    }
+
+    output.writeValue<uint32_t>("NumColorWriteMasks", colorWriteMasks.size());
+    for (auto& colorWriteMask : colorWriteMasks)
+    {
+        output.writeValue<uint32_t>("value", colorWriteMask);
+    }
+}
@@ -14,6 +14,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/core/compare.h>
 #include <vsg/io/Logger.h>
 #include <vsg/state/DynamicState.h>
+#include <vsg/state/ExtendedDynamicState.h>
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/state/ViewportState.h>
 #include <vsg/vk/Context.h>
@@ -215,7 +216,25 @@ void GraphicsPipeline::compile(Context& context)
             shaderStage->compile(context);
         }
 
-        _implementation[viewID] = GraphicsPipeline::Implementation::create(context, context.device, context.renderPass, layout, stages, combined_pipelineStates, subpass);
+        if (context.operationThreads)
+        {
+            // assign the Implementation now so that it's shared with other views, but leave the creation of the VkPipeline to the operationThreads
+            auto implementation = GraphicsPipeline::Implementation::create(context.device, combined_pipelineStates);
+            _implementation[viewID] = implementation;
+
+            auto createPipeline = [implementation, renderPass = context.renderPass, pipelineLayout = layout, shaderStages = stages, in_subpass = subpass](Context& threadContext) {
+                implementation->create(threadContext, renderPass, pipelineLayout, shaderStages, in_subpass);
+            };
+
+            if (context.asynchronousPipelines)
+                context.compileAsynchronously(createPipeline);
+            else
+                context.compileInParallel(createPipeline);
+        }
+        else
+        {
+            _implementation[viewID] = GraphicsPipeline::Implementation::create(context, context.device, context.renderPass, layout, stages, combined_pipelineStates, subpass);
+        }
     }
 }
 
@@ -227,10 +246,23 @@ GraphicsPipeline::Implementation::Implementation(Context& context, Device* devic
     _pipelineStates(pipelineStates),
     _device(device)
 {
+    create(context, renderPass, pipelineLayout, shaderStages, subpass);
+}
+
+GraphicsPipeline::Implementation::Implementation(Device* device, const GraphicsPipelineStates& pipelineStates) :
+    _pipelineStates(pipelineStates),
+    _device(device)
+{
+}
+
+void GraphicsPipeline::Implementation::create(Context& context, const RenderPass* renderPass, const PipelineLayout* pipelineLayout, const ShaderStages& shaderStages, uint32_t subpass)
+{
+    Device* device = _device;
+
     VkGraphicsPipelineCreateInfo pipelineInfo = {};
     pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
     pipelineInfo.layout = pipelineLayout->vk(device->deviceID);
-    pipelineInfo.renderPass = *renderPass;
+    pipelineInfo.renderPass = renderPass ? renderPass->vk() : VK_NULL_HANDLE; // no RenderPass when using dynamic rendering, see RenderingState
     pipelineInfo.subpass = subpass;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineInfo.pNext = nullptr;
@@ -252,12 +284,13 @@ GraphicsPipeline::Implementation::Implementation(Context& context, Device* devic
     pipelineInfo.stageCount = i;
     pipelineInfo.pStages = shaderStageCreateInfo;
 
-    for (auto pipelineState : pipelineStates)
+    for (auto pipelineState : _pipelineStates)
     {
         pipelineState->apply(context, pipelineInfo);
     }
 
-    VkResult result = vkCreateGraphicsPipelines(*device, VK_NULL_HANDLE, 1, &pipelineInfo, _device->getAllocationCallbacks(), &_pipeline);
+    VkPipelineCache pipelineCache = context.pipelineCache ? context.pipelineCache->vk() : VK_NULL_HANDLE;
+    VkResult result = vkCreateGraphicsPipelines(*device, pipelineCache, 1, &pipelineInfo, _device->getAllocationCallbacks(), &_pipeline);
 
     context.scratchMemory->release();
 
@@ -265,6 +298,8 @@ GraphicsPipeline::Implementation::Implementation(Context& context, Device* devic
     {
         throw Exception{"Error: vsg::GraphicsPipeline failed to create VkPipeline.", result};
     }
+
+    _ready.store(true, std::memory_order_release);
 }
 
 GraphicsPipeline::Implementation::~Implementation()
@@ -292,7 +327,8 @@ int BindGraphicsPipeline::compare(const Object& rhs_object) const
     if (result != 0) return result;
 
     const auto& rhs = static_cast<decltype(*this)>(rhs_object);
-    return compare_pointer(pipeline, rhs.pipeline);
+    if ((result = compare_pointer(pipeline, rhs.pipeline))) return result;
+    return compare_pointer(dynamicState, rhs.dynamicState);
 }
 
 void BindGraphicsPipeline::read(Input& input)
@@ -300,6 +336,11 @@ void BindGraphicsPipeline::read(Input& input)
     StateCommand::read(input);
 
     input.readObject("pipeline", pipeline);
+
+    if (input.version_greater_equal(1, 1, 21))
+    {
+        input.readObject("dynamicState", dynamicState);
+    }
 }
 
 void BindGraphicsPipeline::write(Output& output) const
@@ -307,12 +348,19 @@ void BindGraphicsPipeline::write(Output& output) const
     StateCommand::write(output);
 
     output.writeObject("pipeline", pipeline);
+
+    if (output.version_greater_equal(1, 1, 21))
+    {
+        output.writeObject("dynamicState", dynamicState);
+    }
 }
 
 void BindGraphicsPipeline::record(CommandBuffer& commandBuffer) const
 {
     vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->vk(commandBuffer.viewID));
     commandBuffer.setCurrentPipelineLayout(pipeline->layout);
+
+    if (dynamicState) dynamicState->record(commandBuffer);
 }
 
 void BindGraphicsPipeline::compile(Context& context)
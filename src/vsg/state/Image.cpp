@@ -144,19 +144,19 @@ VkResult Image::bind(DeviceMemory* deviceMemory, VkDeviceSize memoryOffset)
 
 VkResult Image::allocateAndBindMemory(Device* device, VkMemoryPropertyFlags memoryProperties, void* pNextAllocInfo)
 {
-    auto memRequirements = getMemoryRequirements(device->deviceID);
-
     if ((memoryProperties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) != 0)
     {
         auto deviceMemoryBufferPools = device->deviceMemoryBufferPools.ref_ptr();
         if (deviceMemoryBufferPools)
         {
-            auto [memory, offset] = deviceMemoryBufferPools->reserveMemory(memRequirements, memoryProperties);
+            auto [memory, offset] = deviceMemoryBufferPools->reserveImageMemory(_vulkanData[device->deviceID].image, memoryProperties);
 
             return bind(memory, offset);
         }
     }
 
+    auto memRequirements = getMemoryRequirements(device->deviceID);
+
     auto memory = DeviceMemory::create(device, memRequirements, memoryProperties, pNextAllocInfo);
     auto [allocated, offset] = memory->reserve(memRequirements.size);
     if (!allocated)
@@ -214,10 +214,10 @@ VkResult Image::compile(Device* device)
 
 VkResult Image::compile(Context& context)
 {
-    return compile(*context.deviceMemoryBufferPools);
+    return compile(*context.deviceMemoryBufferPools, context.memoryPriority);
 }
 
-VkResult Image::compile(MemoryBufferPools& memoryBufferPools)
+VkResult Image::compile(MemoryBufferPools& memoryBufferPools, float memoryPriority)
 {
     auto device = memoryBufferPools.device;
     auto& vd = _vulkanData[device->deviceID];
@@ -226,10 +226,7 @@ VkResult Image::compile(MemoryBufferPools& memoryBufferPools)
     VkResult result = compile(device);
     if (result != VK_SUCCESS) return result;
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(*device, vd.image, &memRequirements);
-
-    auto [deviceMemory, offset] = memoryBufferPools.reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    auto [deviceMemory, offset] = memoryBufferPools.reserveImageMemory(vd.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memoryPriority);
     if (deviceMemory)
     {
         vd.requiresDataCopy = data.valid();
@@ -37,9 +37,10 @@ void ImageView::VulkanData::release()
 {
     if (imageView)
     {
-        vkDestroyImageView(*device, imageView, device->getAllocationCallbacks());
+        if (!shared) vkDestroyImageView(*device, imageView, device->getAllocationCallbacks());
         imageView = VK_NULL_HANDLE;
         device = {};
+        shared = {};
     }
 }
 
@@ -133,10 +134,7 @@ void ImageView::compile(Device* device)
         info.image = image->vk(device->deviceID);
     }
 
-    if (VkResult result = vkCreateImageView(*vd.device, &info, vd.device->getAllocationCallbacks(), &vd.imageView); result != VK_SUCCESS)
-    {
-        throw Exception{"Error: Failed to create VkImageView.", result};
-    }
+    _createImageView(vd, info, device->resourceCache.ref_ptr());
 }
 
 void ImageView::compile(Context& context)
@@ -162,6 +160,20 @@ void ImageView::compile(Context& context)
         info.image = image->vk(vd.device->deviceID);
     }
 
+    _createImageView(vd, info, context.resourceCache);
+}
+
+void ImageView::_createImageView(VulkanData& vd, const VkImageViewCreateInfo& info, DeviceResourceCache* resourceCache)
+{
+    // ImageViews of the same image with the same settings share a single VkImageView
+    if (resourceCache && info.image != VK_NULL_HANDLE)
+    {
+        auto sharedImageView = resourceCache->getOrCreateImageView(info);
+        vd.imageView = sharedImageView->imageView;
+        vd.shared = sharedImageView;
+        return;
+    }
+
     if (VkResult result = vkCreateImageView(*vd.device, &info, vd.device->getAllocationCallbacks(), &vd.imageView); result != VK_SUCCESS)
     {
         throw Exception{"Error: Failed to create VkImageView.", result};
@@ -174,11 +186,8 @@ ref_ptr<ImageView> vsg::createImageView(vsg::Context& context, ref_ptr<Image> im
 
     image->compile(device);
 
-    // get memory requirements
-    VkMemoryRequirements memRequirements = image->getMemoryRequirements(device->deviceID);
-
     // allocate memory with out export memory info extension
-    auto [deviceMemory, offset] = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    auto [deviceMemory, offset] = context.deviceMemoryBufferPools->reserveImageMemory(image->vk(device->deviceID), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, context.memoryPriority);
     image->bind(deviceMemory, offset);
 
     auto imageView = ImageView::create(image, aspectFlags);
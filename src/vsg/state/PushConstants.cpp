@@ -52,5 +52,5 @@ void PushConstants::write(Output& output) const
 
 void PushConstants::record(CommandBuffer& commandBuffer) const
 {
-    vkCmdPushConstants(commandBuffer, commandBuffer.getCurrentPipelineLayout(), stageFlags, offset, static_cast<uint32_t>(data->dataSize()), data->dataPointer());
+    commandBuffer.pushConstants(stageFlags, offset, static_cast<uint32_t>(data->dataSize()), data->dataPointer());
 }
@@ -0,0 +1,115 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/PushDescriptorSet.h>
+#include <vsg/vk/CommandBuffer.h>
+#include <vsg/vk/Context.h>
+
+using namespace vsg;
+
+PushDescriptorSet::PushDescriptorSet() :
+    Inherit(1), // slot 1
+    pipelineBindPoint(VK_PIPELINE_BIND_POINT_GRAPHICS),
+    set(0)
+{
+}
+
+PushDescriptorSet::PushDescriptorSet(const PushDescriptorSet& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    pipelineBindPoint(rhs.pipelineBindPoint),
+    layout(copyop(rhs.layout)),
+    set(rhs.set),
+    descriptors(copyop(rhs.descriptors))
+{
+}
+
+int PushDescriptorSet::compare(const Object& rhs_object) const
+{
+    int result = StateCommand::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+
+    if ((result = compare_value(pipelineBindPoint, rhs.pipelineBindPoint))) return result;
+    if ((result = compare_pointer(layout, rhs.layout))) return result;
+    if ((result = compare_value(set, rhs.set))) return result;
+    return compare_pointer_container(descriptors, rhs.descriptors);
+}
+
+void PushDescriptorSet::read(Input& input)
+{
+    _vulkanData.clear();
+
+    StateCommand::read(input);
+
+    input.readValue<uint32_t>("pipelineBindPoint", pipelineBindPoint);
+    input.readObject("layout", layout);
+    input.read("set", set);
+    input.readObjects("descriptors", descriptors);
+}
+
+void PushDescriptorSet::write(Output& output) const
+{
+    StateCommand::write(output);
+
+    output.writeValue<uint32_t>("pipelineBindPoint", pipelineBindPoint);
+    output.writeObject("layout", layout);
+    output.write("set", set);
+    output.writeObjects("descriptors", descriptors);
+}
+
+void PushDescriptorSet::compile(Context& context)
+{
+    auto& vkd = _vulkanData[context.deviceID];
+
+    // no need to compile if already compiled
+    if (vkd._vkPipelineLayout != 0 && vkd._descriptorWrites) return;
+
+    layout->compile(context);
+
+    size_t numDescriptors = 0;
+    for (auto& descriptor : descriptors)
+    {
+        descriptor->compile(context);
+        numDescriptors += descriptor->getNumDescriptors();
+    }
+
+    // the VkWriteDescriptorSet are recorded every frame so allocate them, and the buffer/image infos they point to, from ScratchMemory owned by this PushDescriptorSet
+    // rather than the Context's ScratchMemory that is released after each use.
+    size_t writeMemorySize = descriptors.size() * (sizeof(VkWriteDescriptorSet) + 16) + numDescriptors * (sizeof(VkDescriptorImageInfo) + 16);
+    vkd._writeMemory = ScratchMemory::create(std::max(writeMemorySize, size_t(256)));
+
+    auto previous_scratchMemory = context.scratchMemory;
+    context.scratchMemory = vkd._writeMemory;
+
+    vkd._descriptorWrites = vkd._writeMemory->allocate<VkWriteDescriptorSet>(descriptors.size());
+    for (size_t i = 0; i < descriptors.size(); ++i)
+    {
+        descriptors[i]->assignTo(context, vkd._descriptorWrites[i]);
+    }
+
+    context.scratchMemory = previous_scratchMemory;
+
+    vkd._vkPipelineLayout = layout->vk(context.deviceID);
+}
+
+void PushDescriptorSet::record(CommandBuffer& commandBuffer) const
+{
+    auto& vkd = _vulkanData[commandBuffer.deviceID];
+    auto extensions = commandBuffer.getDevice()->getExtensions();
+    extensions->vkCmdPushDescriptorSetKHR(commandBuffer, pipelineBindPoint, vkd._vkPipelineLayout, set,
+                                          static_cast<uint32_t>(descriptors.size()), vkd._descriptorWrites);
+}
@@ -0,0 +1,99 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/RenderingState.h>
+#include <vsg/vk/Context.h>
+
+using namespace vsg;
+
+RenderingState::RenderingState()
+{
+}
+
+RenderingState::RenderingState(const RenderingState& rs) :
+    Inherit(rs),
+    viewMask(rs.viewMask),
+    colorAttachmentFormats(rs.colorAttachmentFormats),
+    depthAttachmentFormat(rs.depthAttachmentFormat),
+    stencilAttachmentFormat(rs.stencilAttachmentFormat)
+{
+}
+
+RenderingState::RenderingState(const Formats& in_colorAttachmentFormats, VkFormat in_depthAttachmentFormat, VkFormat in_stencilAttachmentFormat) :
+    colorAttachmentFormats(in_colorAttachmentFormats),
+    depthAttachmentFormat(in_depthAttachmentFormat),
+    stencilAttachmentFormat(in_stencilAttachmentFormat)
+{
+}
+
+RenderingState::~RenderingState()
+{
+}
+
+int RenderingState::compare(const Object& rhs_object) const
+{
+    int result = GraphicsPipelineState::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    if ((result = compare_value(viewMask, rhs.viewMask))) return result;
+    if ((result = compare_value_container(colorAttachmentFormats, rhs.colorAttachmentFormats))) return result;
+    if ((result = compare_value(depthAttachmentFormat, rhs.depthAttachmentFormat))) return result;
+    return compare_value(stencilAttachmentFormat, rhs.stencilAttachmentFormat);
+}
+
+void RenderingState::read(Input& input)
+{
+    GraphicsPipelineState::read(input);
+
+    input.read("viewMask", viewMask);
+    colorAttachmentFormats.resize(input.readValue<uint32_t>("NumColorAttachmentFormats"));
+    for (auto& format : colorAttachmentFormats)
+    {
+        input.readValue<uint32_t>("value", format);
+    }
+    input.readValue<uint32_t>("depthAttachmentFormat", depthAttachmentFormat);
+    input.readValue<uint32_t>("stencilAttachmentFormat", stencilAttachmentFormat);
+}
+
+void RenderingState::write(Output& output) const
+{
+    GraphicsPipelineState::write(output);
+
+    output.write("viewMask", viewMask);
+    output.writeValue<uint32_t>("NumColorAttachmentFormats", colorAttachmentFormats.size());
+    for (auto& format : colorAttachmentFormats)
+    {
+        output.writeValue<uint32_t>("value", format);
+    }
+    output.writeValue<uint32_t>("depthAttachmentFormat", depthAttachmentFormat);
+    output.writeValue<uint32_t>("stencilAttachmentFormat", stencilAttachmentFormat);
+}
+
+void RenderingState::apply(Context& context, VkGraphicsPipelineCreateInfo& pipelineInfo) const
+{
+    auto renderingInfo = context.scratchMemory->allocate<VkPipelineRenderingCreateInfoKHR>();
+
+    renderingInfo->sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+    renderingInfo->pNext = pipelineInfo.pNext;
+    renderingInfo->viewMask = viewMask;
+    renderingInfo->colorAttachmentCount = static_cast<uint32_t>(colorAttachmentFormats.size());
+    renderingInfo->pColorAttachmentFormats = colorAttachmentFormats.data();
+    renderingInfo->depthAttachmentFormat = depthAttachmentFormat;
+    renderingInfo->stencilAttachmentFormat = stencilAttachmentFormat;
+
+    pipelineInfo.pNext = renderingInfo;
+}
@@ -83,6 +83,24 @@ void ResourceHints::read(Input& input)
         input.read("containsPagedLOD", containsPagedLOD);
         input.read("allocatedMemoryLimit", allocatedMemoryLimit);
     }
+
+    if (input.version_greater_equal(1, 1, 15))
+    {
+        input.read("pipelineCacheDirectory", pipelineCacheDirectory);
+    }
+
+    if (input.version_greater_equal(1, 1, 20))
+    {
+        input.read("memoryPriority", memoryPriority);
+    }
+
+    if (input.version_greater_equal(1, 1, 26))
+    {
+        input.read("complete", complete);
+        input.readValues("binNumbers", binNumbers);
+        input.read("cpuMemory", cpuMemory);
+        input.read("gpuMemory", gpuMemory);
+    }
 }
 
 void ResourceHints::write(Output& output) const
@@ -145,4 +163,22 @@ void ResourceHints::write(Output& output) const
         output.write("containsPagedLOD", containsPagedLOD);
         output.write("allocatedMemoryLimit", allocatedMemoryLimit);
     }
+
+    if (output.version_greater_equal(1, 1, 15))
+    {
+        output.write("pipelineCacheDirectory", pipelineCacheDirectory);
+    }
+
+    if (output.version_greater_equal(1, 1, 20))
+    {
+        output.write("memoryPriority", memoryPriority);
+    }
+
+    if (output.version_greater_equal(1, 1, 26))
+    {
+        output.write("complete", complete);
+        output.writeValues("binNumbers", binNumbers);
+        output.write("cpuMemory", cpuMemory);
+        output.write("gpuMemory", gpuMemory);
+    }
 }
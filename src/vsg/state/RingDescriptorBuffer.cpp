@@ -0,0 +1,141 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Exception.h>
+#include <vsg/core/compare.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/RingDescriptorBuffer.h>
+#include <vsg/vk/Context.h>
+
+#include <cstring>
+
+using namespace vsg;
+
+RingDescriptorBuffer::RingDescriptorBuffer() :
+    Inherit(0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+{
+}
+
+RingDescriptorBuffer::RingDescriptorBuffer(const RingDescriptorBuffer& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    data(copyop(rhs.data)),
+    numSlices(rhs.numSlices)
+{
+}
+
+RingDescriptorBuffer::RingDescriptorBuffer(ref_ptr<Data> in_data, uint32_t in_dstBinding, uint32_t in_numSlices, VkDescriptorType in_descriptorType) :
+    Inherit(in_dstBinding, 0, in_descriptorType),
+    data(in_data),
+    numSlices(in_numSlices)
+{
+}
+
+RingDescriptorBuffer::~RingDescriptorBuffer()
+{
+    for (uint32_t deviceID = 0; deviceID < _vulkanData.size(); ++deviceID)
+    {
+        auto& vkd = _vulkanData[deviceID];
+        if (vkd.buffer && vkd.mappedData) vkd.buffer->getDeviceMemory(deviceID)->unmap();
+    }
+}
+
+int RingDescriptorBuffer::compare(const Object& rhs_object) const
+{
+    int result = Descriptor::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+
+    if ((result = compare_pointer(data, rhs.data))) return result;
+    return compare_value(numSlices, rhs.numSlices);
+}
+
+void RingDescriptorBuffer::read(Input& input)
+{
+    Descriptor::read(input);
+
+    input.readObject("data", data);
+    input.read("numSlices", numSlices);
+}
+
+void RingDescriptorBuffer::write(Output& output) const
+{
+    Descriptor::write(output);
+
+    output.writeObject("data", data);
+    output.write("numSlices", numSlices);
+}
+
+void RingDescriptorBuffer::compile(Context& context)
+{
+    auto& vkd = _vulkanData[context.deviceID];
+    if (vkd.buffer || !data) return;
+
+    if (numSlices == 0)
+    {
+        throw Exception{"Error: RingDescriptorBuffer::compile(..) numSlices must be greater than 0."};
+    }
+
+    const auto& limits = context.device->getPhysicalDevice()->getProperties().limits;
+    bool storage = (descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
+    auto alignment = static_cast<uint32_t>(storage ? limits.minStorageBufferOffsetAlignment : limits.minUniformBufferOffsetAlignment);
+    auto dataSize = static_cast<uint32_t>(data->dataSize());
+
+    vkd.stride = ((dataSize + alignment - 1) / alignment) * alignment;
+    vkd.buffer = createBufferAndMemory(context.device, VkDeviceSize(vkd.stride) * numSlices, storage ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT : VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+                                       VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    // the buffer is mapped for its lifetime so each update is a plain memory write
+    void* mapped = nullptr;
+    if (vkd.buffer->getDeviceMemory(context.deviceID)->map(vkd.buffer->getMemoryOffset(context.deviceID), VkDeviceSize(vkd.stride) * numSlices, 0, &mapped) != VK_SUCCESS)
+    {
+        throw Exception{"Error: RingDescriptorBuffer::compile(..) unable to map ring buffer."};
+    }
+    vkd.mappedData = static_cast<uint8_t*>(mapped);
+
+    std::memcpy(vkd.mappedData, data->dataPointer(), dataSize);
+    vkd.slice = 0;
+    data->getModifiedCount(vkd.modifiedCount);
+}
+
+void RingDescriptorBuffer::assignTo(Context& context, VkWriteDescriptorSet& wds) const
+{
+    Descriptor::assignTo(context, wds);
+
+    auto& vkd = _vulkanData[context.deviceID];
+
+    auto pBufferInfo = context.scratchMemory->allocate<VkDescriptorBufferInfo>(1);
+    pBufferInfo->buffer = vkd.buffer ? vkd.buffer->vk(context.deviceID) : VK_NULL_HANDLE;
+    pBufferInfo->offset = 0;
+    pBufferInfo->range = data ? data->dataSize() : 0;
+
+    // the descriptor covers a single slice, the BindDescriptorSet::dynamicOffsets select which one
+    wds.descriptorCount = 1;
+    wds.pBufferInfo = pBufferInfo;
+}
+
+uint32_t RingDescriptorBuffer::dynamicOffset(uint32_t deviceID) const
+{
+    auto& vkd = _vulkanData[deviceID];
+    if (!vkd.mappedData) return 0;
+
+    std::scoped_lock lock(_mutex);
+
+    if (data->getModifiedCount(vkd.modifiedCount))
+    {
+        vkd.slice = (vkd.slice + 1) % numSlices;
+        std::memcpy(vkd.mappedData + VkDeviceSize(vkd.slice) * vkd.stride, data->dataPointer(), data->dataSize());
+    }
+
+    return vkd.slice * vkd.stride;
+}
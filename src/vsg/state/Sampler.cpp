@@ -99,6 +99,14 @@ void Sampler::compile(Context& context)
     samplerInfo->borderColor = borderColor;
     samplerInfo->unnormalizedCoordinates = unnormalizedCoordinates;
 
+    if (context.resourceCache)
+    {
+        // share the VkSampler of any other Sampler with the same settings
+        auto sharedSampler = context.resourceCache->getOrCreateSampler(*samplerInfo);
+        _implementation[context.deviceID] = Implementation::create(context.device, sharedSampler->sampler, sharedSampler);
+        return;
+    }
+
     _implementation[context.deviceID] = Implementation::create(context.device, *samplerInfo);
 }
 
@@ -111,9 +119,16 @@ Sampler::Implementation::Implementation(Device* device, const VkSamplerCreateInf
     }
 }
 
+Sampler::Implementation::Implementation(Device* device, VkSampler sampler, ref_ptr<Object> shared) :
+    _sampler(sampler),
+    _device(device),
+    _shared(shared)
+{
+}
+
 Sampler::Implementation::~Implementation()
 {
-    if (_sampler)
+    if (_sampler && !_shared)
     {
         vkDestroySampler(*_device, _sampler, _device->getAllocationCallbacks());
     }
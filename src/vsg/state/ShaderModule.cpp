@@ -47,6 +47,13 @@ int ShaderCompileSettings::compare(const Object& rhs_object) const
 
     const auto& rhs = static_cast<decltype(*this)>(rhs_object);
 
+    if ((result = compareExcludingDefines(rhs))) return result;
+    return compare_container(defines, rhs.defines);
+}
+
+int ShaderCompileSettings::compareExcludingDefines(const ShaderCompileSettings& rhs) const
+{
+    int result = 0;
     if ((result = compare_value(vulkanVersion, rhs.vulkanVersion))) return result;
     if ((result = compare_value(clientInputVersion, rhs.clientInputVersion))) return result;
     if ((result = compare_value(language, rhs.language))) return result;
@@ -54,8 +61,7 @@ int ShaderCompileSettings::compare(const Object& rhs_object) const
     if ((result = compare_value(target, rhs.target))) return result;
     if ((result = compare_value(forwardCompatible, rhs.forwardCompatible))) return result;
     if ((result = compare_value(generateDebugInfo, rhs.generateDebugInfo))) return result;
-    if ((result = compare_value(optimize, rhs.optimize))) return result;
-    return compare_container(defines, rhs.defines);
+    return compare_value(optimize, rhs.optimize);
 }
 
 void ShaderCompileSettings::read(Input& input)
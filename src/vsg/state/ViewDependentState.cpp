@@ -10,9 +10,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/app/RecordTraversal.h>
 #include <vsg/app/View.h>
+#include <vsg/commands/CopyImage.h>
 #include <vsg/commands/PipelineBarrier.h>
 #include <vsg/core/compare.h>
+#include <vsg/io/DatabasePager.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/write.h>
 #include <vsg/lighting/AmbientLight.h>
@@ -20,17 +23,87 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/lighting/HardShadows.h>
 #include <vsg/lighting/PercentageCloserSoftShadows.h>
 #include <vsg/lighting/PointLight.h>
+#include <vsg/lighting/RayTracedShadows.h>
 #include <vsg/lighting/SoftShadows.h>
 #include <vsg/lighting/SpotLight.h>
 #include <vsg/nodes/RegionOfInterest.h>
+#include <vsg/raytracing/DescriptorAccelerationStructure.h>
 #include <vsg/state/DescriptorImage.h>
 #include <vsg/state/ViewDependentState.h>
+#include <vsg/ui/FrameStamp.h>
 #include <vsg/utils/GraphicsPipelineConfigurator.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
 
 using namespace vsg;
 
+namespace
+{
+    // records a shadow map's CommandGraph, retained by the ShadowMap so that no Operation needs to be allocated each frame
+    struct RecordShadowMapOperation : public Inherit<Operation, RecordShadowMapOperation>
+    {
+        CommandGraph* commandGraph = nullptr;
+        ref_ptr<RecordedCommandBuffers> recordedCommandBuffers;
+        ref_ptr<FrameStamp> frameStamp;
+        ref_ptr<DatabasePager> databasePager;
+        Latch* latch = nullptr;
+
+        void run() override
+        {
+            commandGraph->record(recordedCommandBuffers, frameStamp, databasePager);
+
+            // don't retain the frame's objects beyond the record
+            recordedCommandBuffers = {};
+            frameStamp = {};
+            databasePager = {};
+
+            if (latch) latch->count_down();
+        }
+    };
+
+    // collects the runs of modified vec4 entries of an array so that only the modified slices are marked dirty on its BufferInfo and transferred,
+    // when no BufferInfo is available the whole array is dirtied.
+    struct ModifiedEntries
+    {
+        Data* data = nullptr;
+        BufferInfo* bufferInfo = nullptr;
+        uint32_t count = 0;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+
+        void modified(uint32_t index)
+        {
+            if (count > 0 && index == end)
+            {
+                ++end;
+            }
+            else
+            {
+                dirtyRun();
+                begin = index;
+                end = index + 1;
+            }
+            ++count;
+        }
+
+        void dirtyRun()
+        {
+            if (bufferInfo && end > begin) bufferInfo->dirty(begin * sizeof(vec4), (end - begin) * sizeof(vec4));
+        }
+
+        void dirty()
+        {
+            if (count == 0) return;
+
+            if (bufferInfo)
+                dirtyRun();
+            else if (data)
+                data->dirty();
+        }
+    };
+} // namespace
+
 //////////////////////////////////////
 //
 // TraverseChildrenOfNode
@@ -153,7 +226,7 @@ void BindViewDescriptorSets::record(CommandBuffer& commandBuffer) const
 {
     if (commandBuffer.viewDependentState)
     {
-        commandBuffer.viewDependentState->bindDescriptorSets(commandBuffer, pipelineBindPoint, layout->vk(commandBuffer.deviceID), firstSet);
+        commandBuffer.viewDependentState->bindDescriptorSets(commandBuffer, pipelineBindPoint, layout.get(), firstSet);
     }
 }
 
@@ -213,10 +286,13 @@ void ViewDependentState::init(ResourceRequirements& requirements)
     // check if ViewDependentState has already been initialized
     if (lightData) return;
 
+    bool clusteredLighting = (view->features & CLUSTERED_LIGHTING) != 0;
+
     if (!shaderSet)
     {
         // fallback to using the standard PBR ShaderSet
-        shaderSet = vsg::createPhysicsBasedRenderingShaderSet();
+        shaderSet = clusteredLighting ? vsg::createPhysicsBasedRenderingClusteredLightingShaderSet() : vsg::createPhysicsBasedRenderingShaderSet();
+        if (shadowAccelerationStructure) shaderSet = vsg::createRayTracedShadowsShaderSet(shaderSet);
     }
 
     auto descriptorConfigurator = DescriptorConfigurator::create(shaderSet);
@@ -234,14 +310,21 @@ void ViewDependentState::init(ResourceRequirements& requirements)
     {
         uint32_t numLights = static_cast<uint32_t>(viewDetails.lights.size());
         uint32_t numShadowMaps = 0;
+        uint32_t numSpotLightShadowMaps = 0;
         for (auto& light : viewDetails.lights)
         {
             if (auto shadowSettings = getActiveShadowSettings(light))
             {
-                numShadowMaps += shadowSettings->shadowMapCount;
+                if (shadowMapBudget && dynamic_cast<const SpotLight*>(light))
+                    numSpotLightShadowMaps += shadowSettings->shadowMapCount;
+                else
+                    numShadowMaps += shadowSettings->shadowMapCount;
             }
         }
 
+        // spot light shadow maps beyond the budget are never rendered so don't need layers
+        if (shadowMapBudget) numShadowMaps += std::min(numSpotLightShadowMaps, shadowMapBudget->maxShadowMaps);
+
         if (numLights < requirements.numLightsRange[0])
             maxNumberLights = requirements.numLightsRange[0];
         else if (numLights > requirements.numLightsRange[1])
@@ -326,7 +409,27 @@ void ViewDependentState::init(ResourceRequirements& requirements)
 #endif
     if (maxShadowMaps > 0)
     {
-        shadowDepthImage = createShadowImage(shadowWidth, shadowHeight, maxShadowMaps, VK_FORMAT_D32_SFLOAT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+        if (staticShadowCasterMask != MASK_OFF && shadowMapPageSize > 0)
+        {
+            warn("ViewDependentState::init() shadowMapPageSize is not supported in combination with staticShadowCasterMask, rendering full resolution shadow maps.");
+        }
+
+        if (staticShadowCasterMask != MASK_OFF)
+        {
+            // the static caster depth is copied into the shadow maps each frame
+            shadowDepthImage = createShadowImage(shadowWidth, shadowHeight, maxShadowMaps, VK_FORMAT_D32_SFLOAT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+            staticShadowDepthImage = createShadowImage(shadowWidth, shadowHeight, maxShadowMaps, VK_FORMAT_D32_SFLOAT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+        }
+        else if (shadowMapPageSize > 0)
+        {
+            // the pages are rendered to a single scratch layer and blitted up to the shadow map's layer
+            shadowDepthImage = createShadowImage(shadowWidth, shadowHeight, maxShadowMaps, VK_FORMAT_D32_SFLOAT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+            pagedShadowDepthImage = createShadowImage(shadowWidth, shadowHeight, 1, VK_FORMAT_D32_SFLOAT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+        }
+        else
+        {
+            shadowDepthImage = createShadowImage(shadowWidth, shadowHeight, maxShadowMaps, VK_FORMAT_D32_SFLOAT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+        }
 
         auto depthImageView = ImageView::create(shadowDepthImage, VK_IMAGE_ASPECT_DEPTH_BIT);
         depthImageView->viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
@@ -370,6 +473,57 @@ void ViewDependentState::init(ResourceRequirements& requirements)
     descriptorConfigurator->assignTexture("shadowMapDirectSampler", ImageInfoList{shadowMapDirectSamplerInfo});
     descriptorConfigurator->assignTexture("shadowMapShadowSampler", ImageInfoList{shadowMapSamplerInfo});
 
+    if (clusteredLighting)
+    {
+        uint32_t maxLights = std::min(std::max(static_cast<uint32_t>(viewDetails.lights.size()), requirements.numLightsRange[0]), maxClusteredLights);
+        lightClustering = LightClustering::create(clusterDimensions, maxLights, maxLightsPerCluster);
+
+        bool assigned = descriptorConfigurator->assignDescriptor("clusterSettings", BufferInfoList{lightClustering->settingsBufferInfo});
+        assigned = descriptorConfigurator->assignDescriptor("clusterLights", BufferInfoList{lightClustering->lightsBufferInfo}) && assigned;
+        assigned = descriptorConfigurator->assignDescriptor("clusterLightCounts", BufferInfoList{lightClustering->lightCounts}) && assigned;
+        assigned = descriptorConfigurator->assignDescriptor("clusterLightIndices", BufferInfoList{lightClustering->lightIndices}) && assigned;
+
+        if (assigned)
+        {
+            // the compute dispatch can't be recorded within the View's render pass so record it to its own CommandBuffer submitted ahead of the main rendering
+            lightClusteringCommandGraph = CommandGraph::create();
+            lightClusteringCommandGraph->submitOrder = -1;
+            lightClusteringCommandGraph->addChild(lightClustering);
+        }
+        else
+        {
+            warn("ViewDependentState::init(..) CLUSTERED_LIGHTING requires a clustered lighting ShaderSet, falling back to packing all lights into lightData.");
+            lightClustering = {};
+        }
+    }
+
+    if (depthReduction)
+    {
+        // the depth buffer can't be read within the View's render pass so record the reduction to its own CommandBuffer submitted ahead of the main rendering
+        depthReductionCommandGraph = CommandGraph::create();
+        depthReductionCommandGraph->submitOrder = -1;
+        depthReductionCommandGraph->addChild(depthReduction);
+    }
+
+    if (shadowAccelerationStructure)
+    {
+        auto& accelerationStructureBinding = shaderSet->getDescriptorBinding("shadowAccelerationStructure");
+        if (accelerationStructureBinding && shaderSet->getDescriptorBinding("rayTracedShadowSettings"))
+        {
+            rayTracedShadowSettings = mat4Value::create();
+            rayTracedShadowSettings->properties.dataVariance = DYNAMIC_DATA_TRANSFER_AFTER_RECORD;
+            descriptorConfigurator->assignDescriptor("rayTracedShadowSettings", BufferInfoList{BufferInfo::create(rayTracedShadowSettings.get())});
+
+            auto descriptor = DescriptorAccelerationStructure::create(AccelerationStructures{shadowAccelerationStructure}, accelerationStructureBinding.binding);
+            descriptorConfigurator->assignDescriptor(accelerationStructureBinding.set, accelerationStructureBinding.binding, accelerationStructureBinding.descriptorType,
+                                                     accelerationStructureBinding.descriptorCount, accelerationStructureBinding.stageFlags, descriptor);
+        }
+        else
+        {
+            warn("ViewDependentState::init(..) shadowAccelerationStructure requires a ray traced shadows ShaderSet, RayTracedShadows will be unshadowed.");
+        }
+    }
+
     // assign the DescriptorSet and layout created by the descriptorConfigurator
     for (size_t set = 0; set < descriptorConfigurator->descriptorSets.size(); ++set)
     {
@@ -392,11 +546,10 @@ void ViewDependentState::init(ResourceRequirements& requirements)
 
     auto tcon = TraverseChildrenOfNode::create(view);
 
-    Mask shadowMask = 0x1; // TODO: do we inherit from main scene? how?
-
     auto viewportState = ViewportState::create(VkExtent2D{shadowWidth, shadowHeight});
 
     ref_ptr<View> first_view;
+    uint32_t layer = 0;
     shadowMaps.resize(maxShadowMaps);
     for (auto& shadowMap : shadowMaps)
     {
@@ -410,14 +563,112 @@ void ViewDependentState::init(ResourceRequirements& requirements)
             shadowMap.view = first_view;
         }
 
-        shadowMap.view->mask = shadowMask;
+        shadowMap.view->mask = shadowCasterMask;
         shadowMap.view->camera = Camera::create();
         shadowMap.view->addChild(tcon);
-        shadowMap.view->camera->viewportState = viewportState;
+        // when paging each shadow map sets its own viewport to the region of pages it renders to
+        shadowMap.view->camera->viewportState = pagedShadowDepthImage ? ViewportState::create(VkExtent2D{shadowWidth, shadowHeight}) : viewportState;
 
         shadowMap.renderGraph = RenderGraph::create();
         shadowMap.renderGraph->addChild(shadowMap.view);
-        preRenderSwitch->addChild(MASK_ALL, shadowMap.renderGraph);
+
+        ref_ptr<Node> shadowMapSubgraph = shadowMap.renderGraph;
+        if (staticShadowDepthImage)
+        {
+            // the static casters share the shadow map's camera, so are rendered with the same light space matrices
+            shadowMap.staticView = View::create(*first_view);
+            shadowMap.staticView->mask = staticShadowCasterMask;
+            shadowMap.staticView->camera = shadowMap.view->camera;
+            shadowMap.staticView->addChild(tcon);
+
+            shadowMap.staticRenderGraph = RenderGraph::create();
+            shadowMap.staticRenderGraph->addChild(shadowMap.staticView);
+
+            shadowMap.staticSwitch = Switch::create();
+            shadowMap.staticSwitch->addChild(MASK_ALL, shadowMap.staticRenderGraph);
+
+            // copy the cached static caster depth into the shadow map, the dynamic casters' render pass then loads and renders on top of it
+            VkImageSubresourceLayers subresource{VK_IMAGE_ASPECT_DEPTH_BIT, 0, layer, 1};
+            auto copyStaticDepth = CopyImage::create();
+            copyStaticDepth->srcImage = staticShadowDepthImage;
+            copyStaticDepth->srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            copyStaticDepth->dstImage = shadowDepthImage;
+            copyStaticDepth->dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            copyStaticDepth->regions.push_back(VkImageCopy{subresource, VkOffset3D{0, 0, 0}, subresource, VkOffset3D{0, 0, 0}, VkExtent3D{shadowWidth, shadowHeight, 1}});
+
+            auto transferDstBarrier = ImageMemoryBarrier::create(
+                VK_ACCESS_SHADER_READ_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_QUEUE_FAMILY_IGNORED,
+                VK_QUEUE_FAMILY_IGNORED,
+                shadowDepthImage,
+                VkImageSubresourceRange{VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, layer, 1});
+
+            auto casters = Group::create();
+            casters->addChild(shadowMap.staticSwitch);
+            casters->addChild(PipelineBarrier::create(VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, transferDstBarrier));
+            casters->addChild(copyStaticDepth);
+            casters->addChild(shadowMap.renderGraph);
+            shadowMapSubgraph = casters;
+        }
+        else if (pagedShadowDepthImage)
+        {
+            // blit the rendered pages up to the whole of the shadow map's layer, the source region is set each frame by traverse(..)
+            shadowMap.pageBlit = BlitImage::create();
+            shadowMap.pageBlit->srcImage = pagedShadowDepthImage;
+            shadowMap.pageBlit->srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+            shadowMap.pageBlit->dstImage = shadowDepthImage;
+            shadowMap.pageBlit->dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            shadowMap.pageBlit->filter = VK_FILTER_NEAREST;
+
+            VkImageBlit region{};
+            region.srcSubresource = VkImageSubresourceLayers{VK_IMAGE_ASPECT_DEPTH_BIT, 0, 0, 1};
+            region.srcOffsets[1] = VkOffset3D{static_cast<int32_t>(shadowWidth), static_cast<int32_t>(shadowHeight), 1};
+            region.dstSubresource = VkImageSubresourceLayers{VK_IMAGE_ASPECT_DEPTH_BIT, 0, layer, 1};
+            region.dstOffsets[1] = VkOffset3D{static_cast<int32_t>(shadowWidth), static_cast<int32_t>(shadowHeight), 1};
+            shadowMap.pageBlit->regions.push_back(region);
+
+            VkImageSubresourceRange layerRange{VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, layer, 1};
+            auto transferDstBarrier = ImageMemoryBarrier::create(
+                VK_ACCESS_SHADER_READ_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_QUEUE_FAMILY_IGNORED,
+                VK_QUEUE_FAMILY_IGNORED,
+                shadowDepthImage,
+                layerRange);
+
+            auto readOnlyBarrier = ImageMemoryBarrier::create(
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_ACCESS_SHADER_READ_BIT,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+                VK_QUEUE_FAMILY_IGNORED,
+                VK_QUEUE_FAMILY_IGNORED,
+                shadowDepthImage,
+                layerRange);
+
+            shadowMap.pageCommands = Group::create();
+            shadowMap.pageCommands->addChild(PipelineBarrier::create(VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, transferDstBarrier));
+            shadowMap.pageCommands->addChild(shadowMap.pageBlit);
+            shadowMap.pageCommands->addChild(PipelineBarrier::create(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, readOnlyBarrier));
+
+            auto pages = Group::create();
+            pages->addChild(shadowMap.renderGraph);
+            pages->addChild(shadowMap.pageCommands);
+            shadowMapSubgraph = pages;
+        }
+
+        preRenderSwitch->addChild(MASK_ALL, shadowMapSubgraph);
+
+        shadowMap.commandGraph = CommandGraph::create();
+        shadowMap.commandGraph->submitOrder = preRenderCommandGraph->submitOrder;
+        shadowMap.commandGraph->addChild(shadowMapSubgraph);
+
+        ++layer;
     }
 }
 
@@ -427,6 +678,21 @@ void ViewDependentState::update(ResourceRequirements& requirements)
     {
         preRenderCommandGraph->maxSlots.merge(requirements.maxSlots);
     }
+
+    if (lightClusteringCommandGraph)
+    {
+        lightClusteringCommandGraph->maxSlots.merge(requirements.maxSlots);
+    }
+
+    if (depthReductionCommandGraph)
+    {
+        depthReductionCommandGraph->maxSlots.merge(requirements.maxSlots);
+    }
+
+    for (auto& shadowMap : shadowMaps)
+    {
+        if (shadowMap.commandGraph) shadowMap.commandGraph->maxSlots.merge(requirements.maxSlots);
+    }
 }
 
 void ViewDependentState::compile(Context& context)
@@ -436,6 +702,23 @@ void ViewDependentState::compile(Context& context)
 
     CPU_INSTRUMENTATION_L1_NC(context.instrumentation, "ViewDependentState compile", COLOR_COMPILE);
 
+    if (lightClustering && lightClusteringCommandGraph && !lightClusteringCommandGraph->device)
+    {
+        // compile ahead of the descriptorSet so that the GPU only light counts and indices are placed in device local memory
+        lightClustering->compile(context);
+
+        lightClusteringCommandGraph->device = context.device;
+        lightClusteringCommandGraph->queueFamily = 0;
+    }
+
+    if (depthReduction && depthReductionCommandGraph && !depthReductionCommandGraph->device)
+    {
+        depthReduction->compile(context);
+
+        depthReductionCommandGraph->device = context.device;
+        depthReductionCommandGraph->queueFamily = 0;
+    }
+
     descriptorSet->compile(context);
 
     if ((view->features & RECORD_SHADOW_MAPS) != 0 && preRenderCommandGraph && !preRenderCommandGraph->device)
@@ -448,18 +731,63 @@ void ViewDependentState::compile(Context& context)
         auto extent = shadowDepthImage->extent;
 
         shadowDepthImage->compile(context);
+        if (staticShadowDepthImage) staticShadowDepthImage->compile(context);
 
-        uint32_t layer = 0;
-        for (const auto& shadowMap : shadowMaps)
+        if (pagedShadowDepthImage)
         {
-            // create depth buffer
-            auto depthImageView = ImageView::create(shadowDepthImage, VK_IMAGE_ASPECT_DEPTH_BIT);
+            VkFormatProperties props;
+            vkGetPhysicalDeviceFormatProperties(*(context.device->getPhysicalDevice()), shadowDepthImage->format, &props);
+            const VkFormatFeatureFlags requiredFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+            if ((props.optimalTilingFeatures & requiredFeatures) == requiredFeatures)
+            {
+                pagedShadowDepthImage->compile(context);
+            }
+            else
+            {
+                warn("ViewDependentState::compile() shadow map format does not support blits, shadowMapPageSize disabled.");
+
+                // render straight to the shadow map layers
+                pagedShadowDepthImage = {};
+                for (auto& shadowMap : shadowMaps)
+                {
+                    if (shadowMap.pageCommands) shadowMap.pageCommands->children.clear();
+                    shadowMap.pageBlit = {};
+                }
+            }
+        }
+
+        auto createDepthImageView = [&](ref_ptr<Image> image, uint32_t layer) -> ref_ptr<ImageView> {
+            auto depthImageView = ImageView::create(image, VK_IMAGE_ASPECT_DEPTH_BIT);
             depthImageView->viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
             depthImageView->subresourceRange.baseMipLevel = 0;
             depthImageView->subresourceRange.levelCount = 1;
             depthImageView->subresourceRange.baseArrayLayer = layer;
             depthImageView->subresourceRange.layerCount = 1;
             depthImageView->compile(context);
+            return depthImageView;
+        };
+
+        auto setUpRenderGraph = [&](RenderGraph& rendergraph, ref_ptr<RenderPass> renderPass, ref_ptr<ImageView> depthImageView) -> void {
+            rendergraph.renderArea.offset = VkOffset2D{0, 0};
+            rendergraph.renderArea.extent = VkExtent2D{extent.width, extent.height};
+            rendergraph.framebuffer = Framebuffer::create(renderPass, ImageViews{depthImageView}, extent.width, extent.height, 1);
+
+            rendergraph.clearValues.resize(1);
+            rendergraph.clearValues[0].depthStencil = VkClearDepthStencilValue{0.0f, 0};
+        };
+
+        AttachmentReference ignoreColorReference = {VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED};
+        AttachmentReference depthReference = {0, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+        RenderPass::Subpasses subpassDescription(1);
+        subpassDescription[0].pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpassDescription[0].colorAttachments.emplace_back(ignoreColorReference);
+        subpassDescription[0].depthStencilAttachments.emplace_back(depthReference);
+
+        uint32_t layer = 0;
+        for (const auto& shadowMap : shadowMaps)
+        {
+            // create depth buffer, when paging the pages are rendered to the scratch layer
+            auto depthImageView = shadowMap.pageBlit ? createDepthImageView(pagedShadowDepthImage, 0) : createDepthImageView(shadowDepthImage, layer);
 
             // attachment descriptions
             RenderPass::Attachments attachments(1);
@@ -473,12 +801,37 @@ void ViewDependentState::compile(Context& context)
             attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
             attachments[0].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
 
-            AttachmentReference ignoreColorReference = {VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED};
-            AttachmentReference depthReference = {0, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
-            RenderPass::Subpasses subpassDescription(1);
-            subpassDescription[0].pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-            subpassDescription[0].colorAttachments.emplace_back(ignoreColorReference);
-            subpassDescription[0].depthStencilAttachments.emplace_back(depthReference);
+            if (shadowMap.staticRenderGraph)
+            {
+                // static caster pass, rendered to the static caster depth layer that is then copied into the shadow map
+                auto staticAttachments = attachments;
+                staticAttachments[0].finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+                RenderPass::Dependencies staticDependencies(2);
+
+                staticDependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+                staticDependencies[0].dstSubpass = 0;
+                staticDependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+                staticDependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+                staticDependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+                staticDependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+                staticDependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+                staticDependencies[1].srcSubpass = 0;
+                staticDependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+                staticDependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+                staticDependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+                staticDependencies[1].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+                staticDependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+                staticDependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+                auto staticRenderPass = RenderPass::create(context.device, staticAttachments, subpassDescription, staticDependencies);
+                setUpRenderGraph(*shadowMap.staticRenderGraph, staticRenderPass, createDepthImageView(staticShadowDepthImage, layer));
+
+                // the dynamic casters are rendered on top of the copied static caster depth
+                attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+                attachments[0].initialLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            }
 
             RenderPass::Dependencies dependencies(2);
 
@@ -490,6 +843,15 @@ void ViewDependentState::compile(Context& context)
             dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
             dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
+            if (shadowMap.staticRenderGraph)
+            {
+                // wait for the copy of the static caster depth
+                dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+                dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+                dependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            }
+
             dependencies[1].srcSubpass = 0;
             dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
             dependencies[1].srcStageMask = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
@@ -498,18 +860,26 @@ void ViewDependentState::compile(Context& context)
             dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
             dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
 
-            auto renderPass = RenderPass::create(context.device, attachments, subpassDescription, dependencies);
+            if (shadowMap.pageBlit)
+            {
+                // the pages are rendered once any prior blit has read from the scratch layer, and are then blitted to the shadow map layer
+                attachments[0].finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
 
-            // Framebuffer
-            auto fbuf = Framebuffer::create(renderPass, ImageViews{depthImageView}, extent.width, extent.height, 1);
+                dependencies[0].srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+                dependencies[0].srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
 
-            auto rendergraph = shadowMap.renderGraph;
-            rendergraph->renderArea.offset = VkOffset2D{0, 0};
-            rendergraph->renderArea.extent = VkExtent2D{extent.width, extent.height};
-            rendergraph->framebuffer = fbuf;
+                dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+                dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            }
 
-            rendergraph->clearValues.resize(1);
-            rendergraph->clearValues[0].depthStencil = VkClearDepthStencilValue{0.0f, 0};
+            auto renderPass = RenderPass::create(context.device, attachments, subpassDescription, dependencies);
+            setUpRenderGraph(*shadowMap.renderGraph, renderPass, depthImageView);
+
+            if (shadowMap.commandGraph)
+            {
+                shadowMap.commandGraph->device = preRenderCommandGraph->device;
+                shadowMap.commandGraph->queueFamily = preRenderCommandGraph->queueFamily;
+            }
 
             ++layer;
         }
@@ -543,6 +913,15 @@ void ViewDependentState::clear()
     spotLights.clear();
 }
 
+void ViewDependentState::dirtyShadowMaps()
+{
+    for (auto& shadowMap : shadowMaps)
+    {
+        shadowMap.rendered = false;
+        shadowMap.staticRendered = false;
+    }
+}
+
 void ViewDependentState::traverse(RecordTraversal& rt) const
 {
     //GPU_INSTRUMENTATION_L1_NC(rt.instrumentation, *rt.getCommandBuffer(), "ViewDependentState", COLOR_RECORD_L1);
@@ -565,7 +944,7 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
     // https://andrew-pham.blog/2019/08/03/percentage-closer-soft-shadows/
     // https://github.com/vsgopenmw-dev/vsgopenmw/blob/master/files/shaders/lib/view/shadow.glsl
 
-    bool requiresPerRenderShadowMaps = false;
+    uint32_t numShadowMapsToRender = 0;
     uint32_t shadowMapIndex = 0;
     uint32_t numShadowMaps = static_cast<uint32_t>(shadowMaps.size());
     if (preRenderSwitch)
@@ -656,6 +1035,10 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
     auto n = -(clipToEye * dvec3(0.0, 0.0, 1.0)).z;
     auto f = -(clipToEye * dvec3(0.0, 0.0, 0.0)).z;
 
+    // the clusters span the whole view frustum so are set up before the near/far values are clamped for the shadow maps
+    double clusterNear = n;
+    double clusterFar = std::min(f, maxClusterDistance);
+
     // if regions of interest have been found in the scene graph use them to clamp the near/far values.
     if (!rt.regionsOfInterest.empty())
     {
@@ -677,33 +1060,177 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         }
     }
 
+    // fit the near/far values to the depths rendered by the previous frames, widened by the margin to allow for the frames the reduction lags behind
+    bool depthRangeFitted = false;
+    double depthNear, depthFar;
+    if (depthReduction && depthReduction->getDepthRange(depthNear, depthFar))
+    {
+        double fittedNear = std::max(n, depthNear * (1.0 - depthReductionMargin));
+        double fittedFar = std::min(f, depthFar * (1.0 + depthReductionMargin));
+        if (fittedNear < fittedFar)
+        {
+            n = fittedNear;
+            f = fittedFar;
+            depthRangeFitted = true;
+        }
+    }
+
     // set up the light data
     auto light_itr = lightData->begin();
-    uint32_t numLightDataChanges = 0;
+    uint32_t lightDataIndex = 0;
+    ModifiedEntries lightDataChanges{lightData.get(), lightDataBufferInfo.get()};
 
     auto assignLightData = [&](const vec4& value) -> void {
         if (*light_itr != value)
         {
             *light_itr = value;
-            ++numLightDataChanges;
+            lightDataChanges.modified(lightDataIndex);
         }
         ++light_itr;
+        ++lightDataIndex;
     };
 
     auto assignLightData4 = [&](float x, float y, float z, float w) -> void {
-        vec4 value(x, y, z, w);
-        if (*light_itr != value)
+        assignLightData(vec4(x, y, z, w));
+    };
+
+    // lights that share a modelview matrix, such as the static lights under the same transform, share the inverse used to transform their directions into eye coordinates
+    const dmat4* previous_mv = nullptr;
+    dmat3 previous_inverse_3x3;
+    auto eyeDirection = [&](const dvec3& direction, const dmat4& mv) -> dvec3 {
+        if (!previous_mv || *previous_mv != mv)
         {
-            *light_itr = value;
-            ++numLightDataChanges;
+            previous_inverse_3x3 = inverse_3x3(mv);
+            previous_mv = &mv;
         }
-        ++light_itr;
+        return normalize(direction * previous_inverse_3x3);
+    };
+
+    // when paging, limit the shadow map's viewport to the square of pages that provides the required number of texels and blit them up to the whole of the
+    // shadow map's layer, returning the scale of the pages relative to the full shadow map layer.
+    auto assignShadowMapPages = [&](ShadowMap& shadowMap, double requiredTexels) -> dvec2 {
+        if (!shadowMap.pageBlit)
+        {
+            // restore the whole layer if the shadow map was last rendered to a reduced resolution region
+            if (shadowMap.regionScale != 1.0)
+            {
+                auto extent = shadowDepthImage->extent;
+                shadowMap.view->camera->viewportState->set(0, 0, extent.width, extent.height);
+                shadowMap.renderGraph->renderArea.extent = VkExtent2D{extent.width, extent.height};
+                shadowMap.regionScale = 1.0;
+            }
+            return dvec2(1.0, 1.0);
+        }
+
+        auto extent = shadowDepthImage->extent;
+        uint32_t maxPages = std::max(std::max(extent.width, extent.height) / shadowMapPageSize, 1u);
+        uint32_t pages = maxPages;
+        if (requiredTexels < static_cast<double>(maxPages * shadowMapPageSize))
+        {
+            pages = std::max(static_cast<uint32_t>(std::ceil(requiredTexels / static_cast<double>(shadowMapPageSize))), 1u);
+        }
+
+        uint32_t width = (pages < maxPages) ? std::min(pages * shadowMapPageSize, extent.width) : extent.width;
+        uint32_t height = (pages < maxPages) ? std::min(pages * shadowMapPageSize, extent.height) : extent.height;
+
+        shadowMap.view->camera->viewportState->set(0, 0, width, height);
+        shadowMap.renderGraph->renderArea.extent = VkExtent2D{width, height};
+        shadowMap.pageBlit->regions[0].srcOffsets[1] = VkOffset3D{static_cast<int32_t>(width), static_cast<int32_t>(height), 1};
+
+        return dvec2(static_cast<double>(width) / static_cast<double>(extent.width), static_cast<double>(height) / static_cast<double>(extent.height));
+    };
+
+    // render the current shadow map at the reduced resolution assigned by the shadowMapBudget, when paging the pages are blitted up to the whole layer,
+    // otherwise the region in the corner of the layer is rendered, returning the scale of the region that the tex gen matrix must be scaled by.
+    auto assignShadowMapRegion = [&](ShadowMap& shadowMap, double regionScale) -> dvec2 {
+        auto extent = shadowDepthImage->extent;
+        if (shadowMap.pageBlit)
+        {
+            assignShadowMapPages(shadowMap, regionScale * static_cast<double>(std::max(extent.width, extent.height)));
+            shadowMap.regionScale = regionScale;
+            return dvec2(1.0, 1.0);
+        }
+
+        if (shadowMap.regionScale != regionScale)
+        {
+            uint32_t width = std::max(static_cast<uint32_t>(regionScale * static_cast<double>(extent.width)), 1u);
+            uint32_t height = std::max(static_cast<uint32_t>(regionScale * static_cast<double>(extent.height)), 1u);
+            shadowMap.view->camera->viewportState->set(0, 0, width, height);
+            shadowMap.renderGraph->renderArea.extent = VkExtent2D{width, height};
+            shadowMap.regionScale = regionScale;
+        }
+
+        auto& renderExtent = shadowMap.renderGraph->renderArea.extent;
+        return dvec2(static_cast<double>(renderExtent.width) / static_cast<double>(extent.width), static_cast<double>(renderExtent.height) / static_cast<double>(extent.height));
+    };
+
+    // size of a screen pixel at the specified eye space depth of the main view, used to compute the shadow map texels required to match the screen resolution.
+    auto screenPixelSize = [&](double depth) -> double {
+        double viewportHeight = viewportData->at(0).w;
+        if (viewportHeight <= 0.0 || projectionMatrix[1][1] == 0.0) return 0.0;
+        double w = -projectionMatrix[2][3] * depth + projectionMatrix[3][3];
+        return 2.0 * std::abs(w) / (std::abs(projectionMatrix[1][1]) * viewportHeight);
+    };
+
+    // enable rendering of the current shadow map unless cacheStaticShadowMaps is set and it was last rendered with the same projection and view matrices
+    auto enableShadowMap = [&](ShadowMap& shadowMap, const dmat4& projectionViewMatrix) -> void {
+        if (cacheStaticShadowMaps && shadowMap.rendered && shadowMap.renderedProjectionViewMatrix == projectionViewMatrix) return;
+
+        preRenderSwitch->children[shadowMapIndex].mask = MASK_ALL;
+        shadowMap.renderedProjectionViewMatrix = projectionViewMatrix;
+        shadowMap.rendered = true;
+        shadowMap.renderedLight = nullptr;
+
+        if (shadowMap.staticSwitch)
+        {
+            // only re-render the static casters when the light space matrices have changed
+            bool staticValid = shadowMap.staticRendered && shadowMap.staticProjectionViewMatrix == projectionViewMatrix;
+            shadowMap.staticSwitch->setAllChildren(!staticValid);
+            shadowMap.staticProjectionViewMatrix = projectionViewMatrix;
+            shadowMap.staticRendered = true;
+        }
+        ++numShadowMapsToRender;
+    };
+
+    // when clustered lighting is active point lights and spot lights without shadow maps are passed to lightClustering rather than packed into lightData
+    auto clusteredSpotLight = [&](const SpotLight* light) -> bool {
+        if (!lightClustering) return false;
+        auto shadowSettings = getActiveShadowSettings(light);
+        return !shadowSettings || (shadowSettings->shadowMapCount == 0 && shadowSettings->type_info() != typeid(RayTracedShadows));
+    };
+
+    uint32_t numPointLights = lightClustering ? 0 : static_cast<uint32_t>(pointLights.size());
+    uint32_t numSpotLights = 0;
+    for (auto& entry : spotLights)
+    {
+        if (!clusteredSpotLight(entry.second)) ++numSpotLights;
+    }
+
+    uint32_t numClusteredLights = 0;
+    ModifiedEntries clusteredLightChanges;
+    if (lightClustering) clusteredLightChanges = ModifiedEntries{lightClustering->lights.get(), lightClustering->lightsBufferInfo.get()};
+
+    auto assignClusteredLight = [&](const vec4& color, const vec4& position_cosInnerAngle, const vec4& direction_cosOuterAngle) -> void {
+        if (numClusteredLights >= lightClustering->maxLights) return;
+
+        auto& lights = *(lightClustering->lights);
+        uint32_t index = numClusteredLights * 3;
+        for (const auto& value : {color, position_cosInnerAngle, direction_cosOuterAngle})
+        {
+            if (lights[index] != value)
+            {
+                lights[index] = value;
+                clusteredLightChanges.modified(index);
+            }
+            ++index;
+        }
+        ++numClusteredLights;
     };
 
     assignLightData4(static_cast<float>(ambientLights.size()),
                      static_cast<float>(directionalLights.size()),
-                     static_cast<float>(pointLights.size()),
-                     static_cast<float>(spotLights.size()));
+                     static_cast<float>(numPointLights),
+                     static_cast<float>(numSpotLights));
 
     // lightData requirements = vec4 * (num_ambientLights + 3 * num_directionLights + 3 * num_pointLights + 4 * num_spotLights + 4 * num_shadow_maps)
 
@@ -718,12 +1245,19 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         // info("   light ", light->className(), ", light->shadowMapCount = ", light->shadowMapCount);
 
         // assign basic direction light settings to light data
-        auto eye_direction = normalize(light->direction * inverse_3x3(mv));
+        auto eye_direction = eyeDirection(light->direction, mv);
         assignLightData4(light->color.r, light->color.g, light->color.b, light->intensity);
         assignLightData4(static_cast<float>(eye_direction.x), static_cast<float>(eye_direction.y), static_cast<float>(eye_direction.z), 0.0f);
 
         auto shadowSettings = getActiveShadowSettings(light);
         uint32_t activeNumShadowMaps = shadowSettings ? std::min(shadowSettings->shadowMapCount, numShadowMaps - shadowMapIndex) : 0;
+        if (depthRangeFitted && depthReductionCascadeRatio > 1.0 && activeNumShadowMaps > 1 && n > 0.0)
+        {
+            // a shallow rendered depth range needs fewer cascades for each to cover at least depthReductionCascadeRatio of far to near distance
+            double shadowFar = std::min(f, maxShadowDistance);
+            double cascades = (shadowFar > n) ? std::ceil(std::log(shadowFar / n) / std::log(depthReductionCascadeRatio)) : 1.0;
+            activeNumShadowMaps = std::min(activeNumShadowMaps, static_cast<uint32_t>(std::max(cascades, 1.0)));
+        }
         if (shadowSettings)
         {
             if (shadowSettings->type_info() == typeid(HardShadows))
@@ -739,15 +1273,17 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
             {
                 assignLightData4(static_cast<float>(activeNumShadowMaps), 0.1f /* todo: calculate blocker search radius */, std::tan(light->angleSubtended / 2), 0.0f);
             }
+            else if (shadowSettings->type_info() == typeid(RayTracedShadows))
+            {
+                const auto& rayTracedShadows = static_cast<const RayTracedShadows&>(*shadowSettings);
+                assignLightData4(0.0f, rayTracedShadows.rayOffset, rayTracedShadows.maxDistance, rayTracedShadowSettings ? 1.0f : 0.0f);
+            }
         }
         else
             assignLightData4(0.0f, 0.0f, 0.0f, 0.0f);
 
         if (activeNumShadowMaps == 0) continue;
 
-        // set up shadow map rendering backend
-        requiresPerRenderShadowMaps = true;
-
         // compute directional light space
         // light direction in world coords
         auto light_direction = normalize(light->direction * (inverse_3x3(mv * inverse_viewMatrix)));
@@ -776,8 +1312,7 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         }
 
         auto updateCamera = [&](double clip_near_z, double clip_far_z, const dmat4& clipToWorld) -> void {
-            const auto& shadowMap = shadowMaps[shadowMapIndex];
-            preRenderSwitch->children[shadowMapIndex].mask = MASK_ALL;
+            auto& shadowMap = shadowMaps[shadowMapIndex];
 
             const auto& camera = shadowMap.view->camera;
             auto lookAt = camera->viewMatrix.cast<LookAt>();
@@ -799,10 +1334,18 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
             ortho->right = ls_bounds.max.x;
             ortho->bottom = ls_bounds.min.y;
             ortho->top = ls_bounds.max.y;
-            ortho->nearDistance = -ls_bounds.max.z;
+            // extrude the receiver bounds towards the light so that casters between the light and receivers are captured
+            ortho->nearDistance = -ls_bounds.max.z - shadowCasterExtrusion * length(ws_bounds.max - ws_bounds.min);
             ortho->farDistance = -ls_bounds.min.z;
 
+            // the receivers nearest the eye require the highest shadow map resolution
+            double pixelSize = screenPixelSize(-(clipToEye * dvec3(0.0, 0.0, clip_near_z)).z);
+            double requiredTexels = (pixelSize > 0.0) ? shadowMapResolutionScale * std::max(ortho->right - ortho->left, ortho->top - ortho->bottom) / pixelSize : std::numeric_limits<double>::max();
+            dvec2 pageScale = assignShadowMapPages(shadowMap, requiredTexels);
+
             dmat4 shadowMapProjView = camera->projectionMatrix->transform() * camera->viewMatrix->transform();
+            // a change in the number of pages requires the shadow map to be re-rendered
+            enableShadowMap(shadowMap, scale(pageScale.x, pageScale.y, 1.0) * shadowMapProjView);
 
             dmat4 shadowMapTM = scale(0.5, 0.5, 1.0) * translate(1.0, 1.0, shadowMapBias) * shadowMapProjView * inverse_viewMatrix;
 
@@ -868,22 +1411,64 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
     for (auto& [mv, light] : pointLights)
     {
         auto eye_position = mv * light->position;
+        if (lightClustering)
+        {
+            assignClusteredLight(vec4(light->color.r, light->color.g, light->color.b, light->intensity),
+                                 vec4(static_cast<float>(eye_position.x), static_cast<float>(eye_position.y), static_cast<float>(eye_position.z), -1.0f),
+                                 vec4(0.0f, 0.0f, 0.0f, -2.0f));
+            continue;
+        }
+
         assignLightData4(light->color.r, light->color.g, light->color.b, light->intensity);
         assignLightData4(static_cast<float>(eye_position.x), static_cast<float>(eye_position.y), static_cast<float>(eye_position.z), 0.0f);
     }
 
+    // rank the shadow casting spot lights by their screen contribution and allocate their shadow maps from the budget
+    auto frameStamp = rt.getFrameStamp();
+    if (shadowMapBudget)
+    {
+        _shadowMapCandidates.clear();
+        for (auto& [mv, light] : spotLights)
+        {
+            ShadowMapBudget::Candidate candidate;
+            if (auto shadowSettings = getActiveShadowSettings(light); shadowSettings && shadowSettings->type_info() != typeid(RayTracedShadows))
+            {
+                // the spot light shadow map's far distance bounds the sphere the light illuminates
+                candidate.shadowMapCount = shadowSettings->shadowMapCount;
+                candidate.screenRadius = ShadowMapBudget::screenRadius(mv * light->position, sqrt(light->intensity / 0.001), projectionMatrix, viewportData->at(0).w);
+            }
+            _shadowMapCandidates.push_back(candidate);
+        }
+
+        uint32_t layerSize = std::max(shadowDepthImage->extent.width, shadowDepthImage->extent.height);
+        shadowMapBudget->allocate(_shadowMapCandidates, numShadowMaps - shadowMapIndex, layerSize, _shadowMapAllocations);
+    }
+
+    size_t spotLightIndex = 0;
     for (auto& [mv, light] : spotLights)
     {
+        const ShadowMapBudget::Allocation* allocation = shadowMapBudget ? &_shadowMapAllocations[spotLightIndex] : nullptr;
+        ++spotLightIndex;
+
         auto eye_position = mv * light->position;
-        auto eye_direction = normalize(light->direction * inverse_3x3(mv));
+        auto eye_direction = eyeDirection(light->direction, mv);
         float cos_innerAngle = static_cast<float>(cos(light->innerAngle));
         float cos_outerAngle = static_cast<float>(cos(light->outerAngle));
+        if (clusteredSpotLight(light))
+        {
+            assignClusteredLight(vec4(light->color.r, light->color.g, light->color.b, light->intensity),
+                                 vec4(static_cast<float>(eye_position.x), static_cast<float>(eye_position.y), static_cast<float>(eye_position.z), cos_innerAngle),
+                                 vec4(static_cast<float>(eye_direction.x), static_cast<float>(eye_direction.y), static_cast<float>(eye_direction.z), cos_outerAngle));
+            continue;
+        }
+
         assignLightData4(light->color.r, light->color.g, light->color.b, light->intensity);
         assignLightData4(static_cast<float>(eye_position.x), static_cast<float>(eye_position.y), static_cast<float>(eye_position.z), cos_innerAngle);
         assignLightData4(static_cast<float>(eye_direction.x), static_cast<float>(eye_direction.y), static_cast<float>(eye_direction.z), cos_outerAngle);
 
         auto shadowSettings = getActiveShadowSettings(light);
         uint32_t activeNumShadowMaps = shadowSettings ? std::min(shadowSettings->shadowMapCount, numShadowMaps - shadowMapIndex) : 0;
+        if (allocation) activeNumShadowMaps = std::min(activeNumShadowMaps, allocation->shadowMapCount);
         if (shadowSettings)
         {
             if (shadowSettings->type_info() == typeid(HardShadows))
@@ -899,15 +1484,17 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
             {
                 assignLightData4(static_cast<float>(activeNumShadowMaps), 0.1f /* todo: calculate blocker search radius */, static_cast<float>(light->radius), 0.0f);
             }
+            else if (shadowSettings->type_info() == typeid(RayTracedShadows))
+            {
+                const auto& rayTracedShadows = static_cast<const RayTracedShadows&>(*shadowSettings);
+                assignLightData4(0.0f, rayTracedShadows.rayOffset, rayTracedShadows.maxDistance, rayTracedShadowSettings ? 1.0f : 0.0f);
+            }
         }
         else
             assignLightData4(0.0f, 0.0f, 0.0f, 0.0f);
 
         if (activeNumShadowMaps == 0) continue;
 
-        // set up shadow map rendering backend
-        requiresPerRenderShadowMaps = true;
-
         // compute spot light space
         // light direction in world coords
         auto light_direction = normalize(light->direction * (inverse_3x3(mv * inverse_viewMatrix)));
@@ -938,10 +1525,10 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
 
         auto light_outerAngle = light->outerAngle;
         auto light_intensity = light->intensity;
+        const Light* current_light = light;
 
         auto updateCamera = [&](double clip_near_z, double clip_far_z, const dmat4& clipToWorld) -> void {
-            const auto& shadowMap = shadowMaps[shadowMapIndex];
-            preRenderSwitch->children[shadowMapIndex].mask = MASK_ALL;
+            auto& shadowMap = shadowMaps[shadowMapIndex];
 
             const auto& camera = shadowMap.view->camera;
             auto lookAt = camera->viewMatrix.cast<LookAt>();
@@ -967,6 +1554,9 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
             ls_bounds.min = dvec3(std::max(-1.0, ls_bounds.min.x), std::max(-1.0, ls_bounds.min.y), std::max(0.0, ls_bounds.min.z));
             ls_bounds.max = dvec3(std::min(1.0, ls_bounds.max.x), std::min(1.0, ls_bounds.max.y), std::min(1.0, ls_bounds.max.z));
 
+            // extrude the receiver bounds towards the light, reverse depth places the light's near plane at 1.0
+            if (shadowCasterExtrusion > 0.0) ls_bounds.max.z = 1.0;
+
             // we need to use the reverse Z depth range without actually reversing depth, as the previous matrix already does that
             auto tweakedOrthographic = [](double left, double right, double bottom, double top, double zNear, double zFar) {
                 return dmat4(2.0 / (right - left), 0.0, 0.0, 0.0,
@@ -978,8 +1568,38 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
             relativeProjection->matrix = tweakedOrthographic(ls_bounds.min.x, ls_bounds.max.x, ls_bounds.min.y, ls_bounds.max.y, ls_bounds.min.z, ls_bounds.max.z);
 
             dmat4 shadowMapProjView = camera->projectionMatrix->transform() * camera->viewMatrix->transform();
+            dvec2 regionScale(1.0, 1.0);
 
-            dmat4 shadowMapTM = scale(0.5, 0.5, 1.0 + shadowMapBias) * translate(1.0, 1.0, 0.0) * shadowMapProjView * inverse_viewMatrix;
+            if (allocation)
+            {
+                // between the reduced frequency updates the shadow map rendered for the light is reused, sampled with the matrices it was rendered with
+                bool reuse = frameStamp && shadowMap.renderedLight == current_light && shadowMap.regionScale == allocation->regionScale &&
+                             (frameStamp->frameCount - shadowMap.renderedFrameCount) < allocation->updateInterval;
+
+                regionScale = assignShadowMapRegion(shadowMap, allocation->regionScale);
+
+                if (reuse)
+                {
+                    shadowMapProjView = shadowMap.renderedShadowMapProjView;
+                }
+                else
+                {
+                    // a change of region requires the shadow map to be re-rendered
+                    enableShadowMap(shadowMap, scale(allocation->regionScale, allocation->regionScale, 1.0) * shadowMapProjView);
+
+                    shadowMap.renderedLight = current_light;
+                    shadowMap.renderedFrameCount = frameStamp ? frameStamp->frameCount : 0;
+                    shadowMap.renderedShadowMapProjView = shadowMapProjView;
+                }
+            }
+            else
+            {
+                // spot light shadow maps always use the full resolution
+                dvec2 pageScale = assignShadowMapPages(shadowMap, std::numeric_limits<double>::max());
+                enableShadowMap(shadowMap, scale(pageScale.x, pageScale.y, 1.0) * shadowMapProjView);
+            }
+
+            dmat4 shadowMapTM = scale(regionScale.x, regionScale.y, 1.0) * scale(0.5, 0.5, 1.0 + shadowMapBias) * translate(1.0, 1.0, 0.0) * shadowMapProjView * inverse_viewMatrix;
 
             // convert tex gen matrix to float matrix and assign to light data
             mat4 m(shadowMapTM);
@@ -1040,12 +1660,38 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         }
     }
 
-    if (numLightDataChanges > 0)
+    lightDataChanges.dirty();
+
+    if (rayTracedShadowSettings)
+    {
+        mat4 eyeToWorld(inverse_viewMatrix);
+        if (rayTracedShadowSettings->value() != eyeToWorld)
+        {
+            rayTracedShadowSettings->set(eyeToWorld);
+            rayTracedShadowSettings->dirty();
+        }
+    }
+
+    if (lightClustering && lightClusteringCommandGraph)
     {
-        lightData->dirty();
+        clusteredLightChanges.dirty();
+
+        lightClustering->assignSettings(numClusteredLights, clusterNear, clusterFar, viewportData->at(0), projectionMatrix);
+
+        lightClusteringCommandGraph->accept(rt);
     }
 
-    if (requiresPerRenderShadowMaps && preRenderCommandGraph)
+    if (depthReduction && depthReductionCommandGraph)
+    {
+        // the reduction of this frame's depth buffer is recorded at the start of the next frame, so pass on the projection matrix it's rendered with
+        auto& viewport = viewportData->at(0);
+        depthReduction->region = VkRect2D{{static_cast<int32_t>(viewport[0]), static_cast<int32_t>(viewport[1])}, {static_cast<uint32_t>(viewport[2]), static_cast<uint32_t>(viewport[3])}};
+        depthReduction->projectionMatrix = projectionMatrix;
+
+        depthReductionCommandGraph->accept(rt);
+    }
+
+    if (numShadowMapsToRender > 0 && preRenderCommandGraph)
     {
         if (rt.instrumentation && !preRenderCommandGraph->instrumentation)
         {
@@ -1053,12 +1699,70 @@ void ViewDependentState::traverse(RecordTraversal& rt) const
         }
 
         // info("ViewDependentState::traverse(RecordTraversal&) doing pre render command graph. shadowMapIndex = ", shadowMapIndex);
-        preRenderCommandGraph->accept(rt);
+        if (numShadowMapsToRender > 1 && rt.recordThreads && rt.recordedCommandBuffers && preRenderCommandGraph->device)
+            recordShadowMapsInParallel(rt);
+        else
+            preRenderCommandGraph->accept(rt);
+    }
+}
+
+void ViewDependentState::recordShadowMapsInParallel(RecordTraversal& rt) const
+{
+    CPU_INSTRUMENTATION_L1_NC(rt.instrumentation, "ViewDependentState recordShadowMapsInParallel", COLOR_RECORD_L1);
+
+    std::vector<ShadowMap*> activeShadowMaps;
+    for (size_t i = 0; i < shadowMaps.size(); ++i)
+    {
+        if (preRenderSwitch->children[i].mask != MASK_OFF && shadowMaps[i].commandGraph) activeShadowMaps.push_back(&shadowMaps[i]);
     }
+    if (activeShadowMaps.empty()) return;
+
+    auto& recordedCommandBuffers = rt.recordedCommandBuffers;
+    ref_ptr<FrameStamp> frameStamp(rt.getFrameStamp());
+    ref_ptr<DatabasePager> databasePager(rt.getDatabasePager());
+
+    int numOnRecordThreads = static_cast<int>(activeShadowMaps.size()) - 1;
+    if (!_shadowMapsLatch)
+        _shadowMapsLatch = Latch::create(numOnRecordThreads);
+    else
+        _shadowMapsLatch->set(numOnRecordThreads);
+
+    for (size_t i = 0; i < activeShadowMaps.size(); ++i)
+    {
+        auto& shadowMap = *activeShadowMaps[i];
+        auto& commandGraph = shadowMap.commandGraph;
+
+        // each shadow map CommandGraph has its own RecordTraversal, so set it up on this thread in the same way as RecordTraversal::apply(const CommandGraph&)
+        auto recordTraversal = commandGraph->getOrCreateRecordTraversal();
+        recordTraversal->getState()->inherit(*rt.getState());
+        if ((view->features & INHERIT_VIEWPOINT) != 0 && view->camera)
+        {
+            recordTraversal->getState()->setInhertiedViewProjectionAndViewMatrix(view->camera->projectionMatrix->transform(), view->camera->viewMatrix->transform());
+        }
+        recordTraversal->recordThreads = rt.recordThreads;
+        if (rt.instrumentation && !commandGraph->instrumentation) commandGraph->instrumentation = shareOrDuplicateForThreadSafety(rt.instrumentation);
+
+        // retain the Operation so that none need to be allocated each frame
+        if (!shadowMap.recordOperation) shadowMap.recordOperation = RecordShadowMapOperation::create();
+
+        auto operation = static_cast<RecordShadowMapOperation*>(shadowMap.recordOperation.get());
+        operation->commandGraph = commandGraph.get();
+        operation->recordedCommandBuffers = recordedCommandBuffers;
+        operation->frameStamp = frameStamp;
+        operation->databasePager = databasePager;
+        operation->latch = (i + 1 < activeShadowMaps.size()) ? _shadowMapsLatch.get() : nullptr;
+
+        if (operation->latch) rt.recordThreads->add(shadowMap.recordOperation);
+    }
+
+    // record the last shadow map on this thread then help the record threads with the rest
+    activeShadowMaps.back()->recordOperation->run();
+
+    rt.recordThreads->wait(*_shadowMapsLatch);
 }
 
-void ViewDependentState::bindDescriptorSets(CommandBuffer& commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, uint32_t firstSet)
+void ViewDependentState::bindDescriptorSets(CommandBuffer& commandBuffer, VkPipelineBindPoint pipelineBindPoint, const PipelineLayout* layout, uint32_t firstSet)
 {
     auto vk = descriptorSet->vk(commandBuffer.deviceID);
-    vkCmdBindDescriptorSets(commandBuffer, pipelineBindPoint, layout, firstSet, 1, &vk, 0, nullptr);
+    commandBuffer.bindDescriptorSets(pipelineBindPoint, layout, firstSet, 1, &vk, 0, nullptr);
 }
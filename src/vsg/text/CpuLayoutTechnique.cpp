@@ -26,6 +26,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/utils/GraphicsPipelineConfigurator.h>
 #include <vsg/utils/SharedObjects.h>
 
+#include <cstring>
+
 using namespace vsg;
 
 class VSG_DECLSPEC CpuLayoutTechniqueArrayState : public Inherit<ArrayState, CpuLayoutTechniqueArrayState>
@@ -111,11 +113,12 @@ void CpuLayoutTechnique::setup(Text* text, uint32_t minimumAllocation, ref_ptr<c
 
     auto num_quads = vsg::visit<CountGlyphs>(text->text).count;
 
-    TextQuads quads;
-    quads.reserve(num_quads);
-    layout->layout(text->text, *font, quads);
+    // reuse the layout quads container to avoid allocations when the text is updated frequently
+    _layoutQuads.clear();
+    _layoutQuads.reserve(num_quads);
+    layout->layout(text->text, *font, _layoutQuads);
 
-    scenegraph = createRenderingSubgraph(shaderSet, font, layout->requiresBillboard(), quads, minimumAllocation);
+    scenegraph = createRenderingSubgraph(shaderSet, font, layout->requiresBillboard(), _layoutQuads, minimumAllocation);
 }
 
 void CpuLayoutTechnique::setup(TextGroup* textGroup, uint32_t minimumAllocation, ref_ptr<const Options> options)
@@ -140,22 +143,20 @@ void CpuLayoutTechnique::setup(TextGroup* textGroup, uint32_t minimumAllocation,
         }
     }
 
-    TextQuads quads;
-    quads.reserve(countGlyphs.count);
+    _layoutQuads.clear();
+    _layoutQuads.reserve(countGlyphs.count);
     for (auto& text : textGroup->children)
     {
-        if (text->text && text->layout) text->layout->layout(text->text, *font, quads);
+        if (text->text && text->layout) text->layout->layout(text->text, *font, _layoutQuads);
     }
 
-    scenegraph = createRenderingSubgraph(shaderSet, font, requiresBillboard, quads, minimumAllocation);
+    scenegraph = createRenderingSubgraph(shaderSet, font, requiresBillboard, _layoutQuads, minimumAllocation);
 }
 
 ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> shaderSet, ref_ptr<Font> font, bool billboard, TextQuads& quads, uint32_t minimumAllocation)
 {
     if (quads.empty()) return {};
 
-    ref_ptr<StateGroup> stategroup;
-
     vec4 color = quads.front().colors[0];
     vec4 outlineColor = quads.front().outlineColors[0];
     float outlineWidth = quads.front().outlineWidths[0];
@@ -175,31 +176,77 @@ ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> sha
         if (quad.centerAndAutoScaleDistance != centerAndAutoScaleDistance) singleCenterAutoScaleDistance = false;
     }
 
+    // the existing subgraph can be updated in place when the arrays have the capacity for the quads and any attribute bound as a single value remains a single value,
+    // in which case only the quads that differ from the previous layout are rewritten, and only their range of the arrays is transferred.
+    auto stategroup = scenegraph.cast<StateGroup>();
+    auto perVertex = [](const ref_ptr<Data>& array) { return array && array->valueCount() > 1; };
+    bool updateInPlace = stategroup && bindVertexBuffers && font == _font && shaderSet == _shaderSet && billboard == _billboard &&
+                         vertices && quads.size() * 4 <= vertices->size() &&
+                         (singleColor || perVertex(colors)) &&
+                         (singleOutlineColor || perVertex(outlineColors)) &&
+                         (singleOutlineWidth || perVertex(outlineWidths)) &&
+                         (!billboard || singleCenterAutoScaleDistance || perVertex(centerAndAutoScaleDistances));
+
     uint32_t num_quads = std::max(static_cast<uint32_t>(quads.size()), minimumAllocation);
     uint32_t num_vertices = num_quads * 4;
-    uint32_t num_colors = singleColor ? 1 : num_vertices;
-    uint32_t num_outlineColors = singleOutlineColor ? 1 : num_vertices;
-    uint32_t num_outlineWidths = singleOutlineWidth ? 1 : num_vertices;
-    uint32_t num_centerAndAutoScaleDistances = billboard ? (singleCenterAutoScaleDistance ? 1 : num_vertices) : 0;
 
-    if (!vertices || num_vertices > vertices->size()) vertices = vec3Array::create(num_vertices);
-    if (!colors || num_colors > colors->size()) colors = vec4Array::create(num_colors);
-    if (!outlineColors || num_outlineColors > outlineColors->size()) outlineColors = vec4Array::create(num_outlineColors);
-    if (!outlineWidths || num_outlineWidths > outlineWidths->size()) outlineWidths = floatArray::create(num_outlineWidths);
-    if (!texcoords || num_vertices > texcoords->size()) texcoords = vec3Array::create(num_vertices);
-    if (billboard && (!centerAndAutoScaleDistances || num_centerAndAutoScaleDistances > centerAndAutoScaleDistances->size())) centerAndAutoScaleDistances = vec4Array::create(num_centerAndAutoScaleDistances);
+    if (!updateInPlace)
+    {
+        stategroup = {};
+
+        uint32_t num_colors = singleColor ? 1 : num_vertices;
+        uint32_t num_outlineColors = singleOutlineColor ? 1 : num_vertices;
+        uint32_t num_outlineWidths = singleOutlineWidth ? 1 : num_vertices;
+        uint32_t num_centerAndAutoScaleDistances = billboard ? (singleCenterAutoScaleDistance ? 1 : num_vertices) : 0;
+
+        // arrays are dynamic so that subsequent in place updates are transferred
+        auto allocate = [](auto& array, uint32_t size) {
+            using ArrayType = typename std::remove_reference_t<decltype(array)>::element_type;
+            if (array && size <= array->size() && (size == 1) == (array->size() == 1)) return;
+            array = ArrayType::create(size);
+            array->properties.dataVariance = DYNAMIC_DATA;
+        };
+
+        allocate(vertices, num_vertices);
+        allocate(colors, num_colors);
+        allocate(outlineColors, num_outlineColors);
+        allocate(outlineWidths, num_outlineWidths);
+        allocate(texcoords, num_vertices);
+        if (billboard)
+            allocate(centerAndAutoScaleDistances, num_centerAndAutoScaleDistances);
+        else
+            centerAndAutoScaleDistances = {};
 
-    uint32_t vi = 0;
+        textQuads.clear();
+    }
 
-    float leadingEdgeGradient = 0.1f;
+    // single values
+    auto assignSingleValue = [&](auto& array, const auto& value) {
+        if (!array || array->size() != 1 || array->at(0) == value) return;
+        array->set(0, value);
+        array->dirty();
+    };
+
+    assignSingleValue(colors, color);
+    assignSingleValue(outlineColors, outlineColor);
+    assignSingleValue(outlineWidths, outlineWidth);
+    assignSingleValue(centerAndAutoScaleDistances, centerAndAutoScaleDistance);
 
-    if (singleColor) colors->set(0, color);
-    if (singleOutlineColor) outlineColors->set(0, outlineColor);
-    if (singleOutlineWidth) outlineWidths->set(0, outlineWidth);
-    if (singleCenterAutoScaleDistance && centerAndAutoScaleDistances) centerAndAutoScaleDistances->set(0, centerAndAutoScaleDistance);
+    // per vertex values of the quads that differ from the previous layout
+    float leadingEdgeGradient = 0.1f;
 
-    for (auto& quad : quads)
+    uint32_t firstModified = static_cast<uint32_t>(quads.size());
+    uint32_t endModified = 0;
+    for (uint32_t qi = 0; qi < static_cast<uint32_t>(quads.size()); ++qi)
     {
+        const auto& quad = quads[qi];
+        if (qi < textQuads.size() && std::memcmp(&quad, &textQuads[qi], sizeof(TextQuad)) == 0) continue;
+
+        firstModified = std::min(firstModified, qi);
+        endModified = qi + 1;
+
+        uint32_t vi = qi * 4;
+
         float leadingEdgeTilt = length(quad.vertices[0] - quad.vertices[1]) * leadingEdgeGradient;
         float topEdgeTilt = leadingEdgeTilt;
 
@@ -208,7 +255,7 @@ ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> sha
         vertices->set(vi + 2, quad.vertices[2]);
         vertices->set(vi + 3, quad.vertices[3]);
 
-        if (!singleColor)
+        if (perVertex(colors))
         {
             colors->set(vi, quad.colors[0]);
             colors->set(vi + 1, quad.colors[1]);
@@ -216,7 +263,7 @@ ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> sha
             colors->set(vi + 3, quad.colors[3]);
         }
 
-        if (!singleOutlineColor)
+        if (perVertex(outlineColors))
         {
             outlineColors->set(vi, quad.outlineColors[0]);
             outlineColors->set(vi + 1, quad.outlineColors[1]);
@@ -224,7 +271,7 @@ ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> sha
             outlineColors->set(vi + 3, quad.outlineColors[3]);
         }
 
-        if (!singleOutlineWidth)
+        if (perVertex(outlineWidths))
         {
             outlineWidths->set(vi, quad.outlineWidths[0]);
             outlineWidths->set(vi + 1, quad.outlineWidths[1]);
@@ -237,15 +284,37 @@ ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> sha
         texcoords->set(vi + 2, vec3(quad.texcoords[2].x, quad.texcoords[2].y, 0.0f));
         texcoords->set(vi + 3, vec3(quad.texcoords[3].x, quad.texcoords[3].y, leadingEdgeTilt));
 
-        if (!singleCenterAutoScaleDistance && centerAndAutoScaleDistances)
+        if (perVertex(centerAndAutoScaleDistances))
         {
             centerAndAutoScaleDistances->set(vi, quad.centerAndAutoScaleDistance);
             centerAndAutoScaleDistances->set(vi + 1, quad.centerAndAutoScaleDistance);
             centerAndAutoScaleDistances->set(vi + 2, quad.centerAndAutoScaleDistance);
             centerAndAutoScaleDistances->set(vi + 3, quad.centerAndAutoScaleDistance);
         }
+    }
+
+    textQuads.assign(quads.begin(), quads.end());
+
+    if (!drawIndexed)
+        drawIndexed = DrawIndexed::create(static_cast<uint32_t>(quads.size() * 6), 1, 0, 0, 0);
+    else
+        drawIndexed->indexCount = static_cast<uint32_t>(quads.size() * 6);
+
+    if (updateInPlace)
+    {
+        // mark just the range of the modified quads for transfer
+        if (endModified > firstModified)
+        {
+            for (auto& bufferInfo : bindVertexBuffers->arrays)
+            {
+                if (!perVertex(bufferInfo->data)) continue;
+
+                VkDeviceSize vertexSize = bufferInfo->data->valueSize();
+                bufferInfo->dirty(firstModified * 4 * vertexSize, (endModified - firstModified) * 4 * vertexSize);
+            }
+        }
 
-        vi += 4;
+        return stategroup;
     }
 
     uint32_t num_indices = num_quads * 6;
@@ -257,7 +326,7 @@ ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> sha
             indices = ui_indices;
 
             auto itr = ui_indices->begin();
-            vi = 0;
+            uint32_t vi = 0;
             for (uint32_t i = 0; i < num_quads; ++i)
             {
                 (*itr++) = vi;
@@ -276,7 +345,7 @@ ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> sha
             indices = us_indices;
 
             auto itr = us_indices->begin();
-            vi = 0;
+            uint32_t vi = 0;
             for (uint32_t i = 0; i < num_quads; ++i)
             {
                 (*itr++) = vi;
@@ -291,82 +360,72 @@ ref_ptr<Node> CpuLayoutTechnique::createRenderingSubgraph(ref_ptr<ShaderSet> sha
         }
     }
 
-    if (!drawIndexed)
-        drawIndexed = DrawIndexed::create(static_cast<uint32_t>(quads.size() * 6), 1, 0, 0, 0);
-    else
-        drawIndexed->indexCount = static_cast<uint32_t>(quads.size() * 6);
-
     // create StateGroup as the root of the scene/command graph to hold the GraphicsPipeline, and binding of Descriptors to decorate the whole graph
-    if (!stategroup)
-    {
-        stategroup = StateGroup::create();
+    stategroup = StateGroup::create();
 
-        auto config = vsg::GraphicsPipelineConfigurator::create(shaderSet);
+    _font = font;
+    _shaderSet = shaderSet;
+    _billboard = billboard;
 
-        auto& sharedObjects = font->sharedObjects;
-        if (!sharedObjects) sharedObjects = SharedObjects::create();
+    auto config = vsg::GraphicsPipelineConfigurator::create(shaderSet);
 
-        DataList arrays;
-        config->assignArray(arrays, "inPosition", VK_VERTEX_INPUT_RATE_VERTEX, vertices);
-        config->assignArray(arrays, "inColor", singleColor ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX, colors);
-        config->assignArray(arrays, "inOutlineColor", singleOutlineColor ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX, outlineColors);
-        config->assignArray(arrays, "inOutlineWidth", singleOutlineWidth ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX, outlineWidths);
-        config->assignArray(arrays, "inTexCoord", VK_VERTEX_INPUT_RATE_VERTEX, texcoords);
+    auto& sharedObjects = font->sharedObjects;
+    if (!sharedObjects) sharedObjects = SharedObjects::create();
 
-        if (centerAndAutoScaleDistances)
-        {
-            config->assignArray(arrays, "inCenterAndAutoScaleDistance", singleCenterAutoScaleDistance ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX, centerAndAutoScaleDistances);
-        }
+    DataList arrays;
+    config->assignArray(arrays, "inPosition", VK_VERTEX_INPUT_RATE_VERTEX, vertices);
+    config->assignArray(arrays, "inColor", singleColor ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX, colors);
+    config->assignArray(arrays, "inOutlineColor", singleOutlineColor ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX, outlineColors);
+    config->assignArray(arrays, "inOutlineWidth", singleOutlineWidth ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX, outlineWidths);
+    config->assignArray(arrays, "inTexCoord", VK_VERTEX_INPUT_RATE_VERTEX, texcoords);
 
-        if (billboard)
-        {
-            config->shaderHints->defines.insert("BILLBOARD");
-        }
+    if (centerAndAutoScaleDistances)
+    {
+        config->assignArray(arrays, "inCenterAndAutoScaleDistance", singleCenterAutoScaleDistance ? VK_VERTEX_INPUT_RATE_INSTANCE : VK_VERTEX_INPUT_RATE_VERTEX, centerAndAutoScaleDistances);
+    }
 
-        // set up sampler for atlas.
-        auto sampler = Sampler::create();
-        sampler->magFilter = VK_FILTER_LINEAR;
-        sampler->minFilter = VK_FILTER_LINEAR;
-        sampler->mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-        sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-        sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-        sampler->addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
-        sampler->borderColor = VK_BORDER_COLOR_INT_TRANSPARENT_BLACK;
-        sampler->anisotropyEnable = VK_TRUE;
-        sampler->maxAnisotropy = 16.0f;
-        sampler->maxLod = 12.0;
-
-        if (sharedObjects) sharedObjects->share(sampler);
-
-        config->assignTexture("textureAtlas", font->atlas, sampler);
-
-        if (sharedObjects)
-            sharedObjects->share(config, [](auto gpc) { gpc->init(); });
-        else
-            config->init();
+    if (billboard)
+    {
+        config->shaderHints->defines.insert("BILLBOARD");
+    }
+
+    // set up sampler for atlas.
+    auto sampler = Sampler::create();
+    sampler->magFilter = VK_FILTER_LINEAR;
+    sampler->minFilter = VK_FILTER_LINEAR;
+    sampler->mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+    sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+    sampler->addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_BORDER;
+    sampler->borderColor = VK_BORDER_COLOR_INT_TRANSPARENT_BLACK;
+    sampler->anisotropyEnable = VK_TRUE;
+    sampler->maxAnisotropy = 16.0f;
+    sampler->maxLod = 12.0;
+
+    if (sharedObjects) sharedObjects->share(sampler);
+
+    config->assignTexture("textureAtlas", font->atlas, sampler);
+
+    if (sharedObjects)
+        sharedObjects->share(config, [](auto gpc) { gpc->init(); });
+    else
+        config->init();
 
-        config->copyTo(stategroup, sharedObjects);
+    config->copyTo(stategroup, sharedObjects);
 
-        bindVertexBuffers = BindVertexBuffers::create(0, arrays);
-        bindIndexBuffer = BindIndexBuffer::create(indices);
+    bindVertexBuffers = BindVertexBuffers::create(0, arrays);
+    bindIndexBuffer = BindIndexBuffer::create(indices);
 
-        // setup geometry
-        auto drawCommands = Commands::create();
-        drawCommands->addChild(bindVertexBuffers);
-        drawCommands->addChild(bindIndexBuffer);
-        drawCommands->addChild(drawIndexed);
-        stategroup->addChild(drawCommands);
+    // setup geometry
+    auto drawCommands = Commands::create();
+    drawCommands->addChild(bindVertexBuffers);
+    drawCommands->addChild(bindIndexBuffer);
+    drawCommands->addChild(drawIndexed);
+    stategroup->addChild(drawCommands);
 
-        // Assign ArrayState for CPU mapping of vertices for billboarding
-        if (billboard)
-            stategroup->prototypeArrayState = CpuLayoutTechniqueArrayState::create(this);
-    }
-    else
-    {
-        info("TODO : CpuLayoutTechnique::setup(), does not yet support updates. Consider using GpuLayoutTechnique instead.");
-        // bindVertexBuffers->copyDataToBuffers();
-        // bindIndexBuffer->copyDataToBuffers();
-    }
+    // Assign ArrayState for CPU mapping of vertices for billboarding
+    if (billboard)
+        stategroup->prototypeArrayState = CpuLayoutTechniqueArrayState::create(this);
 
     return stategroup;
 }
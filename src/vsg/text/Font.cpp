@@ -10,11 +10,55 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/io/Logger.h>
 #include <vsg/text/TextLayout.h>
 #include <vsg/utils/SharedObjects.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace vsg;
 
+namespace
+{
+    struct GenerateGlyph : public Inherit<Operation, GenerateGlyph>
+    {
+        GenerateGlyph(Font* in_font, uint32_t in_glyphIndex) :
+            font(in_font),
+            glyphIndex(in_glyphIndex) {}
+
+        observer_ptr<Font> font;
+        uint32_t glyphIndex;
+
+        void run() override
+        {
+            ref_ptr<Font> ref_font = font;
+            if (ref_font) ref_font->generateGlyph(glyphIndex);
+        }
+    };
+
+    struct CollectGlyphIndices : public ConstVisitor
+    {
+        explicit CollectGlyphIndices(const Font& in_font) :
+            font(in_font) {}
+
+        const Font& font;
+        std::vector<uint32_t> glyphIndices;
+
+        template<typename T>
+        void collect(const T& charcodes)
+        {
+            for (auto c : charcodes) glyphIndices.push_back(font.glyphIndexForCharcode(uint32_t(c)));
+        }
+
+        void apply(const stringValue& text) override { collect(text.value()); }
+        void apply(const wstringValue& text) override { collect(text.value()); }
+        void apply(const ubyteArray& text) override { collect(text); }
+        void apply(const ushortArray& text) override { collect(text); }
+        void apply(const uintArray& text) override { collect(text); }
+    };
+} // namespace
+
 Font::Font()
 {
 }
@@ -91,6 +135,143 @@ void Font::createFontImages()
 
         auto glyphMetricsProxy = vec4Array2D::create(glyphMetrics, 0, stride, numVec4PerGlyph, numGlyphs,
                                                      Data::Properties{VK_FORMAT_R32G32B32A32_SFLOAT});
+        if (glyphGenerator) glyphMetricsProxy->properties.dataVariance = DYNAMIC_DATA;
         glyphImageInfo = ImageInfo::create(glyphMetricSampler, glyphMetricsProxy);
     }
 }
+
+bool Font::requestGlyphs(const Data& text)
+{
+    if (!glyphGenerator) return true;
+
+    CollectGlyphIndices collectGlyphIndices(*this);
+    text.accept(collectGlyphIndices);
+    return requestGlyphIndices(collectGlyphIndices.glyphIndices);
+}
+
+bool Font::requestGlyphIndices(const std::vector<uint32_t>& glyphIndices)
+{
+    if (!glyphGenerator || !glyphMetrics || !atlas) return true;
+
+    std::vector<uint32_t> required;
+    bool allAvailable = true;
+    {
+        std::scoped_lock<std::mutex> lock(_glyphMutex);
+
+        if (_glyphStates.empty())
+        {
+            // the atlas and glyph metrics are updated as glyphs are added so need to be transferred to the GPU on change
+            atlas->properties.dataVariance = DYNAMIC_DATA;
+            glyphMetrics->properties.dataVariance = DYNAMIC_DATA;
+
+            _glyphStates.resize(glyphMetrics->size(), GLYPH_NOT_REQUESTED);
+            _packX = atlasPadding;
+            _packY = atlasPadding;
+        }
+
+        for (auto glyphIndex : glyphIndices)
+        {
+            if (glyphIndex == 0 || glyphIndex >= _glyphStates.size()) continue;
+
+            auto& state = _glyphStates[glyphIndex];
+            if (state == GLYPH_NOT_REQUESTED)
+            {
+                state = GLYPH_PENDING;
+                required.push_back(glyphIndex);
+            }
+            if (state != GLYPH_AVAILABLE) allAvailable = false;
+        }
+    }
+
+    if (required.empty()) return allAvailable;
+
+    if (operationThreads)
+    {
+        for (auto glyphIndex : required) operationThreads->add(GenerateGlyph::create(this, glyphIndex));
+        return false;
+    }
+
+    for (auto glyphIndex : required) generateGlyph(glyphIndex);
+    mergeGeneratedGlyphs();
+
+    return requestGlyphIndices(glyphIndices);
+}
+
+void Font::generateGlyph(uint32_t glyphIndex)
+{
+    auto image = glyphGenerator->generate(glyphIndex);
+
+    std::scoped_lock<std::mutex> lock(_glyphMutex);
+    _generatedGlyphs.emplace_back(glyphIndex, image);
+}
+
+uint32_t Font::mergeGeneratedGlyphs()
+{
+    std::scoped_lock<std::mutex> lock(_glyphMutex);
+
+    uint32_t numMerged = 0;
+    for (auto& [glyphIndex, image] : _generatedGlyphs)
+    {
+        if (_addToAtlas(glyphIndex, image)) ++numMerged;
+
+        // glyphs that failed to generate or fit are marked available so they aren't requested again, their zero uvrect leaves them blank
+        _glyphStates[glyphIndex] = GLYPH_AVAILABLE;
+    }
+    _generatedGlyphs.clear();
+
+    if (numMerged > 0)
+    {
+        atlas->dirty();
+        glyphMetrics->dirty();
+        if (glyphImageInfo && glyphImageInfo->imageView && glyphImageInfo->imageView->image && glyphImageInfo->imageView->image->data)
+        {
+            glyphImageInfo->imageView->image->data->dirty();
+        }
+    }
+
+    return numMerged;
+}
+
+bool Font::_addToAtlas(uint32_t glyphIndex, const Data* image)
+{
+    if (!image || image->stride() != atlas->stride()) return false;
+
+    uint32_t width = image->width();
+    uint32_t height = image->height();
+    uint32_t atlasWidth = atlas->width();
+    uint32_t atlasHeight = atlas->height();
+
+    // start a new shelf when the glyph doesn't fit in the remainder of the current one
+    if (_packX + width + atlasPadding > atlasWidth)
+    {
+        _packX = atlasPadding;
+        _packY += _rowHeight + atlasPadding;
+        _rowHeight = 0;
+    }
+
+    if (_packY + height + atlasPadding > atlasHeight || width + 2 * atlasPadding > atlasWidth)
+    {
+        if (!_atlasFull) warn("Font::mergeGeneratedGlyphs() atlas full, unable to add glyph ", glyphIndex);
+        _atlasFull = true;
+        return false;
+    }
+
+    size_t stride = atlas->stride();
+    size_t rowSize = width * stride;
+    auto src = static_cast<const uint8_t*>(image->dataPointer());
+    auto dest = static_cast<uint8_t*>(atlas->dataPointer());
+    for (uint32_t row = 0; row < height; ++row)
+    {
+        std::memcpy(dest + ((_packY + row) * atlasWidth + _packX) * stride, src + row * rowSize, rowSize);
+    }
+
+    // the first row of the image is the top of the glyph, and uvrect[1] maps to the bottom of the glyph quad
+    auto& uvrect = (*glyphMetrics)[glyphIndex].uvrect;
+    uvrect.set(float(_packX) / float(atlasWidth), float(_packY + height) / float(atlasHeight),
+               float(_packX + width) / float(atlasWidth), float(_packY) / float(atlasHeight));
+
+    _packX += width + atlasPadding;
+    _rowHeight = std::max(_rowHeight, height);
+
+    return true;
+}
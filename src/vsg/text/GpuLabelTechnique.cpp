@@ -0,0 +1,624 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Commands.h>
+#include <vsg/io/Logger.h>
+#include <vsg/io/Options.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/text/GpuLabelTechnique.h>
+#include <vsg/text/Text.h>
+#include <vsg/text/TextGroup.h>
+#include <vsg/utils/GraphicsPipelineConfigurator.h>
+#include <vsg/utils/SharedObjects.h>
+#include <vsg/vk/Context.h>
+#include <vsg/vk/State.h>
+
+#include <limits>
+
+using namespace vsg;
+
+namespace
+{
+    const uint32_t s_workgroupSize = 64;
+
+    // matches the PushConstants block in the label culling compute shader, kept within the 128 bytes guaranteed by Vulkan.
+    struct LabelCullingPushConstants
+    {
+        vec4 planes[5];
+        vec4 lodScale;
+        uint32_t labelCount;
+        float minimumScreenHeightRatio;
+        uint32_t padding[2];
+    };
+
+    const char* s_labelCullingSource = R"(#version 450
+
+layout(local_size_x = 64) in;
+
+layout(push_constant) uniform PushConstants {
+    vec4 planes[5];
+    vec4 lodScale;
+    uint labelCount;
+    float minimumScreenHeightRatio;
+} pc;
+
+#define LABEL_VISIBLE 1
+
+struct Label
+{
+    vec4 position;
+    vec4 horizontal;
+    vec4 vertical;
+    vec4 color;
+    vec4 outlineColor;
+    vec4 bound;
+    float outlineWidth;
+    uint firstGlyph;
+    uint glyphCount;
+    uint flags;
+};
+
+struct DrawIndirectCommand
+{
+    uint vertexCount;
+    uint instanceCount;
+    uint firstVertex;
+    uint firstInstance;
+};
+
+layout(set = 0, binding = 0) readonly buffer Labels { Label labels[]; };
+layout(set = 0, binding = 1) buffer DrawCommand { DrawIndirectCommand drawCommand; };
+layout(set = 0, binding = 2) writeonly buffer VisibleLabels { uint visibleLabels[]; };
+
+void main()
+{
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= pc.labelCount) return;
+
+    Label label = labels[index];
+    if ((label.flags & LABEL_VISIBLE) == 0 || label.glyphCount == 0) return;
+
+    vec3 center = label.position.xyz + label.bound.xyz;
+    float radius = label.bound.w;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        if (dot(pc.planes[i].xyz, center) + pc.planes[i].w < -radius) return;
+    }
+
+    if (pc.minimumScreenHeightRatio > 0.0)
+    {
+        float lodDistance = abs(dot(pc.lodScale.xyz, center) + pc.lodScale.w);
+        if (radius <= lodDistance * pc.minimumScreenHeightRatio) return;
+    }
+
+    visibleLabels[atomicAdd(drawCommand.instanceCount, 1)] = index;
+}
+)";
+
+    const char* s_labelVertexSource = R"(#version 450
+
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelview;
+} pc;
+
+#define LABEL_BILLBOARD 2
+
+struct Label
+{
+    vec4 position; // w is the billboard auto scale distance
+    vec4 horizontal;
+    vec4 vertical;
+    vec4 color;
+    vec4 outlineColor;
+    vec4 bound;
+    float outlineWidth;
+    uint firstGlyph;
+    uint glyphCount;
+    uint flags;
+};
+
+struct Glyph
+{
+    vec4 rect;
+    vec4 uvrect;
+};
+
+layout(set = 1, binding = 0) readonly buffer Labels { Label labels[]; };
+layout(set = 1, binding = 1) readonly buffer Glyphs { Glyph glyphs[]; };
+
+layout(location = 0) in uint inLabel;
+
+layout(location = 0) out vec4 fragColor;
+layout(location = 1) out vec4 outlineColor;
+layout(location = 2) out float outlineWidth;
+layout(location = 3) out vec2 fragTexCoord;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+// corners of the two triangles of a glyph quad, z is the leading edge gradient used to avoid z fighting between overlapping glyphs
+const vec3 corners[6] = vec3[](vec3(0.0, 1.0, 0.2), vec3(0.0, 0.0, 0.1), vec3(1.0, 1.0, 0.1),
+                               vec3(0.0, 0.0, 0.1), vec3(1.0, 0.0, 0.0), vec3(1.0, 1.0, 0.1));
+
+mat4 computeBillboadMatrix(vec4 center_eye, float autoScaleDistance)
+{
+    float distance = -center_eye.z;
+
+    float scale = (distance < autoScaleDistance) ? distance/autoScaleDistance : 1.0;
+    mat4 S = mat4(scale, 0.0, 0.0, 0.0,
+                  0.0, scale, 0.0, 0.0,
+                  0.0, 0.0, scale, 0.0,
+                  0.0, 0.0, 0.0, 1.0);
+
+    mat4 T = mat4(1.0, 0.0, 0.0, 0.0,
+                  0.0, 1.0, 0.0, 0.0,
+                  0.0, 0.0, 1.0, 0.0,
+                  center_eye.x, center_eye.y, center_eye.z, 1.0);
+    return T*S;
+}
+
+void main()
+{
+    Label label = labels[inLabel];
+
+    fragColor = label.color;
+    outlineColor = label.outlineColor;
+    outlineWidth = label.outlineWidth;
+
+    uint glyph_index = gl_VertexIndex / 6;
+    if (glyph_index >= label.glyphCount)
+    {
+        // unused glyph slots of the label collapse to a degenerate triangle outside the clip volume
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        fragTexCoord = vec2(0.0, 0.0);
+        return;
+    }
+
+    vec3 corner = corners[gl_VertexIndex % 6];
+    Glyph glyph = glyphs[label.firstGlyph + glyph_index];
+
+    vec2 local = mix(glyph.rect.xy, glyph.rect.zw, corner.xy);
+    vec3 pos = label.horizontal.xyz * local.x + label.vertical.xyz * local.y;
+
+    if ((label.flags & LABEL_BILLBOARD) != 0)
+        gl_Position = (pc.projection * computeBillboadMatrix(pc.modelview * vec4(label.position.xyz, 1.0), label.position.w)) * vec4(pos, 1.0);
+    else
+        gl_Position = (pc.projection * pc.modelview) * vec4(label.position.xyz + pos, 1.0);
+
+    gl_Position.z += corner.z*0.0001;
+
+    fragTexCoord = mix(glyph.uvrect.xy, glyph.uvrect.zw, corner.xy);
+}
+)";
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// createTextLabelShaderSet
+//
+ref_ptr<ShaderSet> vsg::createTextLabelShaderSet(ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("text_label"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    auto textShaderSet = createTextShaderSet(options);
+
+    // reuse the fragment shader of the text ShaderSet, the label vertex shader provides the same outputs as the text vertex shader.
+    ShaderStages stages{ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, "main", s_labelVertexSource)};
+    for (auto& stage : textShaderSet->stages)
+    {
+        if (stage->stage == VK_SHADER_STAGE_FRAGMENT_BIT) stages.push_back(stage);
+    }
+
+    auto shaderSet = ShaderSet::create(stages);
+    shaderSet->pushConstantRanges = textShaderSet->pushConstantRanges;
+    shaderSet->defaultGraphicsPipelineStates = textShaderSet->defaultGraphicsPipelineStates;
+    for (auto& descriptorBinding : textShaderSet->descriptorBindings)
+    {
+        if (descriptorBinding.name == "textureAtlas") shaderSet->descriptorBindings.push_back(descriptorBinding);
+    }
+
+    shaderSet->addAttributeBinding("inLabel", "", 0, VK_FORMAT_R32_UINT, uintArray::create(1));
+    shaderSet->addDescriptorBinding("labels", "", 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, GpuLabelValue::create());
+    shaderSet->addDescriptorBinding("labelGlyphs", "", 1, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, GpuLabelGlyphArray::create(1));
+
+    return shaderSet;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// LabelCulling
+//
+LabelCulling::LabelCulling()
+{
+}
+
+LabelCulling::~LabelCulling()
+{
+}
+
+void LabelCulling::init()
+{
+    _bindComputePipeline = {};
+    _bindDescriptorSet = {};
+
+    if (!labels || !glyphs || labelCount == 0) return;
+
+    VkShaderStageFlags stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    drawCommand = BufferInfo::create(Buffer::create(sizeof(VkDrawIndirectCommand), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE), 0, sizeof(VkDrawIndirectCommand));
+
+    VkDeviceSize visibleLabelsSize = sizeof(uint32_t) * labelCount;
+    visibleLabels = BufferInfo::create(Buffer::create(visibleLabelsSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE), 0, visibleLabelsSize);
+
+    DescriptorSetLayoutBindings bindings{
+        VkDescriptorSetLayoutBinding{0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr},
+        VkDescriptorSetLayoutBinding{1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr},
+        VkDescriptorSetLayoutBinding{2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageFlags, nullptr}};
+
+    Descriptors descriptors{
+        DescriptorBuffer::create(BufferInfoList{labels}, 0, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        DescriptorBuffer::create(BufferInfoList{drawCommand}, 1, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        DescriptorBuffer::create(BufferInfoList{visibleLabels}, 2, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)};
+
+    auto computeShader = ShaderStage::create(VK_SHADER_STAGE_COMPUTE_BIT, "main", s_labelCullingSource);
+
+    auto descriptorSetLayout = DescriptorSetLayout::create(bindings);
+    _pipelineLayout = PipelineLayout::create(DescriptorSetLayouts{descriptorSetLayout}, PushConstantRanges{{stageFlags, 0, static_cast<uint32_t>(sizeof(LabelCullingPushConstants))}});
+
+    _bindComputePipeline = BindComputePipeline::create(ComputePipeline::create(_pipelineLayout, computeShader));
+    _bindDescriptorSet = BindDescriptorSet::create(VK_PIPELINE_BIND_POINT_COMPUTE, _pipelineLayout, 0, DescriptorSet::create(descriptorSetLayout, descriptors));
+}
+
+void LabelCulling::compile(Context& context)
+{
+    if (!_bindComputePipeline) return;
+
+    auto deviceID = context.deviceID;
+
+    // the whole label and glyph buffers are allocated up front so the per label slices, which have them as their parent, are packed into them
+    auto allocate = [&](BufferInfo& bufferInfo) -> void {
+        auto& buffer = bufferInfo.buffer;
+        buffer->compile(context.device);
+        if (buffer->getDeviceMemory(deviceID) == nullptr)
+        {
+            auto memRequirements = buffer->getMemoryRequirements(deviceID);
+            auto [deviceMemory, offset] = context.deviceMemoryBufferPools->reserveMemory(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+            if (!deviceMemory)
+            {
+                throw Exception{"Error: LabelCulling::compile(..) failed to allocate buffer from deviceMemoryBufferPools.", VK_ERROR_OUT_OF_DEVICE_MEMORY};
+            }
+            buffer->bind(deviceMemory, offset);
+        }
+    };
+
+    allocate(*labels);
+    allocate(*glyphs);
+    allocate(*drawCommand);
+    allocate(*visibleLabels);
+
+    // the slices aren't padded to minStorageBufferOffsetAlignment as they are indexed from the start of the whole buffer, so don't pass usage of just VK_BUFFER_USAGE_STORAGE_BUFFER_BIT
+    auto transfer = [&](const BufferInfoList& slices) -> void {
+        for (auto& slice : slices)
+        {
+            if (slice->requiresCopy(deviceID))
+            {
+                createBufferAndTransferData(context, slices, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE);
+                return;
+            }
+        }
+    };
+
+    transfer(labelSlices);
+    transfer(glyphSlices);
+
+    _bindComputePipeline->compile(context);
+    _bindDescriptorSet->compile(context);
+}
+
+void LabelCulling::record(CommandBuffer& commandBuffer) const
+{
+    if (!_bindComputePipeline || !camera || labelCount == 0) return;
+
+    auto deviceID = commandBuffer.deviceID;
+    VkCommandBuffer cmdBuffer{commandBuffer};
+
+    // compute the view frustum in the local coordinate frame of the labels, matching how vsg::State sets up the frustum for CPU culling
+    auto projection = camera->projectionMatrix->transform();
+    auto modelview = camera->viewMatrix->transform() * matrix;
+
+    Frustum frustumUnit;
+    Frustum frustumProjected(frustumUnit, projection);
+    Frustum frustum(frustumProjected, modelview);
+    frustum.computeLodScale(projection, modelview);
+
+    LabelCullingPushConstants pushConstants;
+    for (int i = 0; i < 5; ++i)
+    {
+        pushConstants.planes[i] = (i < POLYTOPE_SIZE) ? vec4(frustum.face[i].vec) : vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+    pushConstants.lodScale = vec4(frustum.lodScale);
+    pushConstants.labelCount = labelCount;
+    pushConstants.minimumScreenHeightRatio = static_cast<float>(minimumScreenHeightRatio);
+    pushConstants.padding[0] = 0;
+    pushConstants.padding[1] = 0;
+
+    // wait for previous frames reading the draw command and visible labels before overwriting them
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+
+    // reset the instanceCount, the compute shader increments it for each visible label, each of which is drawn as glyphsPerLabel quads
+    VkDrawIndirectCommand drawIndirect{6 * glyphsPerLabel, 0, 0, 0};
+    vkCmdUpdateBuffer(cmdBuffer, drawCommand->buffer->vk(deviceID), drawCommand->offset, sizeof(drawIndirect), &drawIndirect);
+
+    VkMemoryBarrier resetBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT};
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &resetBarrier, 0, nullptr, 0, nullptr);
+
+    _bindComputePipeline->record(commandBuffer);
+    _bindDescriptorSet->record(commandBuffer);
+    vkCmdPushConstants(cmdBuffer, _pipelineLayout->vk(deviceID), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+    vkCmdDispatch(cmdBuffer, (labelCount + s_workgroupSize - 1) / s_workgroupSize, 1, 1);
+
+    VkMemoryBarrier cullBarrier{VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT};
+    vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+
+    // compute pipeline and pipeline layout have been bound outside of vsg::State so force state to be reapplied
+    if (commandBuffer.state) commandBuffer.state->dirtyStateStacks();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// GpuLabelTechnique
+//
+void GpuLabelTechnique::setup(Text* text, uint32_t minimumAllocation, ref_ptr<const Options> options)
+{
+    info("GpuLabelTechnique::setup(", text, ", ", minimumAllocation, options, ") not supported, use GpuLayoutTechnique or CpuLayoutTechnique for individual Text.");
+}
+
+void GpuLabelTechnique::setup(TextGroup* textGroup, uint32_t minimumAllocation, ref_ptr<const Options> options)
+{
+    if (!textGroup || textGroup->children.empty() || !textGroup->font) return;
+
+    _textGroup = textGroup;
+
+    auto& font = textGroup->font;
+    auto& children = textGroup->children;
+    auto labelCount = static_cast<uint32_t>(children.size());
+
+    uint32_t requiredGlyphsPerLabel = std::max(minimumAllocation, 1u);
+    for (auto& text : children)
+    {
+        CountGlyphs countGlyphs;
+        if (text->text) text->text->accept(countGlyphs);
+        requiredGlyphsPerLabel = std::max(requiredGlyphsPerLabel, static_cast<uint32_t>(countGlyphs.count));
+    }
+
+    if (!_planarLayout) _planarLayout = StandardLayout::create();
+
+    // reuse the existing buffers when they can accommodate the labels, otherwise set everything up from scratch
+    if (scenegraph && labels.size() == labelCount && requiredGlyphsPerLabel <= glyphsPerLabel)
+    {
+        textExtents.reset();
+        for (uint32_t i = 0; i < labelCount; ++i) updateLabel(i);
+        return;
+    }
+
+    glyphsPerLabel = requiredGlyphsPerLabel;
+
+    labels.resize(labelCount);
+    labelGlyphs.resize(labelCount);
+
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    VkDeviceSize labelsSize = sizeof(GpuLabelStruct) * labelCount;
+    VkDeviceSize glyphsSize = sizeof(GpuLabelGlyph) * glyphsPerLabel * labelCount;
+
+    culling = LabelCulling::create();
+    culling->labelCount = labelCount;
+    culling->glyphsPerLabel = glyphsPerLabel;
+    culling->labels = BufferInfo::create(Buffer::create(labelsSize, usage, VK_SHARING_MODE_EXCLUSIVE), 0, labelsSize);
+    culling->glyphs = BufferInfo::create(Buffer::create(glyphsSize, usage, VK_SHARING_MODE_EXCLUSIVE), 0, glyphsSize);
+
+    textExtents.reset();
+    for (uint32_t i = 0; i < labelCount; ++i)
+    {
+        auto label = GpuLabelValue::create();
+        label->properties.dataVariance = DYNAMIC_DATA;
+        label->value().firstGlyph = i * glyphsPerLabel;
+        label->value().flags = LABEL_VISIBLE;
+        labels[i] = label;
+
+        auto glyphArray = GpuLabelGlyphArray::create(glyphsPerLabel);
+        glyphArray->properties.dataVariance = DYNAMIC_DATA;
+        labelGlyphs[i] = glyphArray;
+
+        auto labelSlice = BufferInfo::create(label);
+        labelSlice->parent = culling->labels;
+        culling->labelSlices.push_back(labelSlice);
+
+        auto glyphSlice = BufferInfo::create(glyphArray);
+        glyphSlice->parent = culling->glyphs;
+        culling->glyphSlices.push_back(glyphSlice);
+
+        updateLabel(i);
+    }
+
+    culling->init();
+
+    auto stateGroup = StateGroup::create();
+    scenegraph = stateGroup;
+
+    auto shaderSet = textGroup->shaderSet ? textGroup->shaderSet : createTextLabelShaderSet(options);
+
+    auto config = vsg::GraphicsPipelineConfigurator::create(shaderSet);
+
+    auto& sharedObjects = font->sharedObjects;
+    if (!sharedObjects) sharedObjects = SharedObjects::create();
+
+    config->enableArray("inLabel", VK_VERTEX_INPUT_RATE_INSTANCE, sizeof(uint32_t), VK_FORMAT_R32_UINT);
+
+    if (!font->atlasImageInfo)
+    {
+        font->createFontImages();
+    }
+    config->assignTexture("textureAtlas", {font->atlasImageInfo}, 0);
+
+    config->assignDescriptor("labels", BufferInfoList{culling->labels});
+    config->assignDescriptor("labelGlyphs", BufferInfoList{culling->glyphs});
+
+    config->init();
+    config->copyTo(stateGroup, sharedObjects);
+
+    // the visible label indices written by the culling are the per instance attribute, and the indirect draw instanceCount the number of visible labels
+    auto bindVertexBuffers = BindVertexBuffers::create();
+    bindVertexBuffers->arrays = BufferInfoList{culling->visibleLabels};
+
+    auto drawIndirect = DrawIndirect::create();
+    drawIndirect->bufferInfo = culling->drawCommand;
+    drawIndirect->drawCount = 1;
+    drawIndirect->stride = sizeof(VkDrawIndirectCommand);
+
+    auto drawCommands = Commands::create();
+    drawCommands->addChild(bindVertexBuffers);
+    drawCommands->addChild(drawIndirect);
+    stateGroup->addChild(drawCommands);
+}
+
+void GpuLabelTechnique::updateLabel(uint32_t index)
+{
+    auto textGroup = _textGroup.ref_ptr();
+    if (!textGroup || !textGroup->font || index >= labels.size() || index >= textGroup->children.size()) return;
+
+    auto& text = textGroup->children[index];
+    if (text) _layoutLabel(index, *text);
+}
+
+void GpuLabelTechnique::setLabelVisible(uint32_t index, bool visible)
+{
+    if (index >= labels.size()) return;
+
+    auto& label = labels[index]->value();
+    uint32_t flags = visible ? (label.flags | LABEL_VISIBLE) : (label.flags & ~LABEL_VISIBLE);
+    if (flags == label.flags) return;
+
+    label.flags = flags;
+    labels[index]->dirty();
+}
+
+bool GpuLabelTechnique::getLabelVisible(uint32_t index) const
+{
+    return index < labels.size() && (labels[index]->value().flags & LABEL_VISIBLE) != 0;
+}
+
+void GpuLabelTechnique::_layoutLabel(uint32_t index, const Text& text)
+{
+    auto textGroup = _textGroup.ref_ptr();
+    auto& font = textGroup->font;
+
+    auto& label = labels[index]->value();
+    auto& glyphArray = *labelGlyphs[index];
+
+    uint32_t flags = label.flags & LABEL_VISIBLE;
+
+    // lay out the glyphs in the plane of the label so its position and axes can be applied on the GPU
+    _textQuads.clear();
+    if (text.text && text.layout)
+    {
+        font->requestGlyphs(*text.text);
+
+        if (auto standardLayout = text.layout.cast<StandardLayout>())
+        {
+            _planarLayout->horizontalAlignment = standardLayout->horizontalAlignment;
+            _planarLayout->verticalAlignment = standardLayout->verticalAlignment;
+            _planarLayout->glyphLayout = standardLayout->glyphLayout;
+            _planarLayout->layout(text.text, *font, _textQuads);
+
+            label.position = standardLayout->position;
+            label.horizontal = standardLayout->horizontal;
+            label.vertical = standardLayout->vertical;
+            label.color = standardLayout->color;
+            label.outlineColor = standardLayout->outlineColor;
+            label.outlineWidth = standardLayout->outlineWidth;
+            label.billboardAutoScaleDistance = standardLayout->billboardAutoScaleDistance;
+            if (standardLayout->billboard) flags |= LABEL_BILLBOARD;
+        }
+        else
+        {
+            // other layouts are placed using the x and y coordinates of their quads
+            text.layout->layout(text.text, *font, _textQuads);
+
+            label.position.set(0.0f, 0.0f, 0.0f);
+            label.horizontal.set(1.0f, 0.0f, 0.0f);
+            label.vertical.set(0.0f, 1.0f, 0.0f);
+            if (!_textQuads.empty())
+            {
+                label.color = _textQuads.front().colors[0];
+                label.outlineColor = _textQuads.front().outlineColors[0];
+                label.outlineWidth = _textQuads.front().outlineWidths[0];
+            }
+        }
+    }
+
+    if (_textQuads.size() > glyphsPerLabel)
+    {
+        warn("GpuLabelTechnique label ", index, " requires ", _textQuads.size(), " glyphs, truncating to glyphsPerLabel = ", glyphsPerLabel);
+    }
+
+    uint32_t glyphCount = std::min(static_cast<uint32_t>(_textQuads.size()), glyphsPerLabel);
+
+    vec2 minimum(std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    vec2 maximum(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+    for (uint32_t i = 0; i < glyphCount; ++i)
+    {
+        const auto& quad = _textQuads[i];
+        auto& glyph = glyphArray[i];
+        glyph.rect.set(quad.vertices[0].x, quad.vertices[0].y, quad.vertices[2].x, quad.vertices[2].y);
+        glyph.uvrect.set(quad.texcoords[0].x, quad.texcoords[0].y, quad.texcoords[2].x, quad.texcoords[2].y);
+
+        minimum.x = std::min(minimum.x, std::min(glyph.rect[0], glyph.rect[2]));
+        minimum.y = std::min(minimum.y, std::min(glyph.rect[1], glyph.rect[3]));
+        maximum.x = std::max(maximum.x, std::max(glyph.rect[0], glyph.rect[2]));
+        maximum.y = std::max(maximum.y, std::max(glyph.rect[1], glyph.rect[3]));
+    }
+
+    // bounding sphere relative to the label position used by the GPU culling, billboards are oriented towards the viewer so can only be bounded around their position
+    if (glyphCount > 0)
+    {
+        float axisScale = std::max(length(label.horizontal), length(label.vertical));
+        vec2 center = (minimum + maximum) * 0.5f;
+        float radius = length(maximum - center) * axisScale;
+        if ((flags & LABEL_BILLBOARD) != 0)
+            label.bound.set(0.0f, 0.0f, 0.0f, length(center) * axisScale + radius);
+        else
+            label.bound = vec4(label.horizontal * center.x + label.vertical * center.y, radius);
+
+        vec3 labelCenter = label.position + vec3(label.bound.x, label.bound.y, label.bound.z);
+        textExtents.add(dvec3(labelCenter - vec3(label.bound.w, label.bound.w, label.bound.w)));
+        textExtents.add(dvec3(labelCenter + vec3(label.bound.w, label.bound.w, label.bound.w)));
+    }
+    else
+    {
+        label.bound.set(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    label.glyphCount = glyphCount;
+    label.flags = flags;
+
+    labels[index]->dirty();
+    glyphArray.dirty();
+}
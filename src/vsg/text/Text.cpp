@@ -63,6 +63,9 @@ void Text::setup(uint32_t minimumAllocation, ref_ptr<const Options> options)
     if (!layout) layout = StandardLayout::create();
     if (!technique) technique = CpuLayoutTechnique::create();
 
+    // make sure the glyphs are generated when the font is using a dynamic atlas
+    if (font && text) font->requestGlyphs(*text);
+
     technique->setup(this, minimumAllocation, options);
 }
 
@@ -12,6 +12,10 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/threading/Affinity.h>
 
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
 #ifdef _WIN32
 
 #    include <process.h>
@@ -152,3 +156,314 @@ void vsg::setAffinity(const Affinity& affinity)
 }
 
 #endif
+
+/////////////////////////////////////////////////////////////////////////
+//
+// ProcessorTopology
+//
+bool vsg::ProcessorTopology::hybrid() const
+{
+    bool hasPerformance = false;
+    bool hasEfficiency = false;
+    for (auto& processor : processors)
+    {
+        if (processor.coreType == CORE_TYPE_PERFORMANCE) hasPerformance = true;
+        else if (processor.coreType == CORE_TYPE_EFFICIENCY) hasEfficiency = true;
+    }
+    return hasPerformance && hasEfficiency;
+}
+
+uint32_t vsg::ProcessorTopology::numNumaNodes() const
+{
+    uint32_t maxNode = 0;
+    for (auto& processor : processors) maxNode = std::max(maxNode, processor.numaNode);
+    return processors.empty() ? 0 : maxNode + 1;
+}
+
+uint32_t vsg::ProcessorTopology::numaNodeOf(uint32_t cpu) const
+{
+    for (auto& processor : processors)
+    {
+        if (processor.cpu == cpu) return processor.numaNode;
+    }
+    return 0;
+}
+
+vsg::Affinity vsg::ProcessorTopology::cpus(CoreType coreType) const
+{
+    Affinity affinity;
+    for (auto& processor : processors)
+    {
+        if (processor.coreType == coreType) affinity.cpus.insert(processor.cpu);
+    }
+    return affinity;
+}
+
+vsg::Affinity vsg::ProcessorTopology::numaNode(uint32_t node) const
+{
+    Affinity affinity;
+    for (auto& processor : processors)
+    {
+        if (processor.numaNode == node) affinity.cpus.insert(processor.cpu);
+    }
+    return affinity;
+}
+
+vsg::Affinity vsg::performanceCoreAffinity()
+{
+    auto& topology = processorTopology();
+    return topology.hybrid() ? topology.cpus(CORE_TYPE_PERFORMANCE) : Affinity();
+}
+
+vsg::Affinity vsg::efficiencyCoreAffinity()
+{
+    auto& topology = processorTopology();
+    return topology.hybrid() ? topology.cpus(CORE_TYPE_EFFICIENCY) : Affinity();
+}
+
+static void defaultProcessorTopology(vsg::ProcessorTopology& topology)
+{
+    uint32_t numProcessors = std::thread::hardware_concurrency();
+    topology.processors.resize(numProcessors);
+    for (uint32_t cpu = 0; cpu < numProcessors; ++cpu)
+    {
+        auto& processor = topology.processors[cpu];
+        processor.cpu = cpu;
+        processor.core = cpu;
+    }
+}
+
+#if defined(_WIN32)
+
+static vsg::ProcessorTopology queryProcessorTopology()
+{
+    vsg::ProcessorTopology topology;
+    defaultProcessorTopology(topology);
+
+    uint32_t numProcessors = static_cast<uint32_t>(topology.processors.size());
+
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    if (length == 0) return topology;
+
+    std::vector<char> buffer(length);
+    if (!GetLogicalProcessorInformationEx(RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length)) return topology;
+
+    // only processor group 0 is covered, matching the single affinity mask used by setAffinity(..)
+    auto forEachCpu = [&](const GROUP_AFFINITY& groupAffinity, auto func) {
+        if (groupAffinity.Group != 0) return;
+        for (uint32_t cpu = 0; cpu < numProcessors && cpu < sizeof(KAFFINITY) * 8; ++cpu)
+        {
+            if (groupAffinity.Mask & (KAFFINITY(1) << cpu)) func(topology.processors[cpu]);
+        }
+    };
+
+    std::vector<BYTE> efficiencyClasses(numProcessors, 0);
+    BYTE minEfficiencyClass = 255;
+    BYTE maxEfficiencyClass = 0;
+    uint32_t coreIndex = 0;
+    uint32_t packageIndex = 0;
+
+    for (DWORD offset = 0; offset < length;)
+    {
+        auto info = reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data() + offset);
+        offset += info->Size;
+
+        switch (info->Relationship)
+        {
+        case RelationProcessorCore: {
+            BYTE efficiencyClass = info->Processor.EfficiencyClass;
+            minEfficiencyClass = std::min(minEfficiencyClass, efficiencyClass);
+            maxEfficiencyClass = std::max(maxEfficiencyClass, efficiencyClass);
+            for (WORD g = 0; g < info->Processor.GroupCount; ++g)
+            {
+                forEachCpu(info->Processor.GroupMask[g], [&](vsg::LogicalProcessor& processor) {
+                    processor.core = coreIndex;
+                    efficiencyClasses[processor.cpu] = efficiencyClass;
+                });
+            }
+            ++coreIndex;
+            break;
+        }
+        case RelationProcessorPackage: {
+            for (WORD g = 0; g < info->Processor.GroupCount; ++g)
+            {
+                forEachCpu(info->Processor.GroupMask[g], [&](vsg::LogicalProcessor& processor) { processor.package = packageIndex; });
+            }
+            ++packageIndex;
+            break;
+        }
+        case RelationNumaNode: {
+            uint32_t node = info->NumaNode.NodeNumber;
+            forEachCpu(info->NumaNode.GroupMask, [&](vsg::LogicalProcessor& processor) { processor.numaNode = node; });
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    // a higher EfficiencyClass denotes a higher performance core
+    if (minEfficiencyClass < maxEfficiencyClass)
+    {
+        for (auto& processor : topology.processors)
+        {
+            processor.coreType = (efficiencyClasses[processor.cpu] == maxEfficiencyClass) ? vsg::CORE_TYPE_PERFORMANCE : vsg::CORE_TYPE_EFFICIENCY;
+        }
+    }
+
+    return topology;
+}
+
+uint32_t vsg::currentNumaNode()
+{
+    PROCESSOR_NUMBER processorNumber;
+    GetCurrentProcessorNumberEx(&processorNumber);
+
+    USHORT node = 0;
+    if (GetNumaProcessorNodeEx(&processorNumber, &node)) return node;
+    return 0;
+}
+
+#elif defined(__linux__)
+
+#    include <sched.h>
+
+#    include <cstdlib>
+#    include <fstream>
+#    include <string>
+
+// read a sysfs cpu list of the form "0-3,8,10-11"
+static std::set<uint32_t> readCpuList(const std::string& filename)
+{
+    std::set<uint32_t> values;
+
+    std::ifstream fin(filename);
+    std::string line;
+    if (!std::getline(fin, line)) return values;
+
+    const char* ptr = line.c_str();
+    while (*ptr)
+    {
+        char* end = nullptr;
+        auto first = std::strtoul(ptr, &end, 10);
+        if (end == ptr) break;
+
+        auto last = first;
+        ptr = end;
+        if (*ptr == '-')
+        {
+            ++ptr;
+            last = std::strtoul(ptr, &end, 10);
+            if (end == ptr) break;
+            ptr = end;
+        }
+
+        for (auto value = first; value <= last; ++value) values.insert(static_cast<uint32_t>(value));
+
+        if (*ptr == ',') ++ptr;
+        else break;
+    }
+    return values;
+}
+
+static bool readValue(const std::string& filename, uint32_t& value)
+{
+    std::ifstream fin(filename);
+    return static_cast<bool>(fin >> value);
+}
+
+static vsg::ProcessorTopology queryProcessorTopology()
+{
+    vsg::ProcessorTopology topology;
+
+    // cpu ids of online cpus may be sparse so the processors are looked up by cpu id rather than index
+    auto onlineCpus = readCpuList("/sys/devices/system/cpu/online");
+    if (onlineCpus.empty())
+        defaultProcessorTopology(topology);
+    else
+        for (auto cpu : onlineCpus) topology.processors.push_back(vsg::LogicalProcessor{cpu, cpu, 0, 0, vsg::CORE_TYPE_UNKNOWN});
+
+    if (topology.processors.empty()) return topology;
+
+    std::vector<vsg::LogicalProcessor*> processorOf(topology.processors.back().cpu + 1, nullptr);
+    for (auto& processor : topology.processors) processorOf[processor.cpu] = &processor;
+
+    const std::string cpuDirectory("/sys/devices/system/cpu/cpu");
+    for (auto& processor : topology.processors)
+    {
+        std::string topologyDirectory = cpuDirectory + std::to_string(processor.cpu) + "/topology/";
+        readValue(topologyDirectory + "core_id", processor.core);
+        readValue(topologyDirectory + "physical_package_id", processor.package);
+    }
+
+    for (auto node : readCpuList("/sys/devices/system/node/online"))
+    {
+        for (auto cpu : readCpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"))
+        {
+            if (cpu < processorOf.size() && processorOf[cpu]) processorOf[cpu]->numaNode = node;
+        }
+    }
+
+    // Intel hybrid CPUs report their P-cores and E-cores as separate PMU devices
+    auto performanceCpus = readCpuList("/sys/devices/cpu_core/cpus");
+    auto efficiencyCpus = readCpuList("/sys/devices/cpu_atom/cpus");
+    if (!performanceCpus.empty() && !efficiencyCpus.empty())
+    {
+        for (auto& processor : topology.processors)
+        {
+            if (performanceCpus.count(processor.cpu) > 0) processor.coreType = vsg::CORE_TYPE_PERFORMANCE;
+            else if (efficiencyCpus.count(processor.cpu) > 0) processor.coreType = vsg::CORE_TYPE_EFFICIENCY;
+        }
+        return topology;
+    }
+
+    // ARM big.LITTLE CPUs report a lower cpu_capacity for their efficiency cores
+    std::vector<uint32_t> capacities(topology.processors.size(), 0);
+    uint32_t minCapacity = UINT32_MAX;
+    uint32_t maxCapacity = 0;
+    for (size_t i = 0; i < topology.processors.size(); ++i)
+    {
+        if (!readValue(cpuDirectory + std::to_string(topology.processors[i].cpu) + "/cpu_capacity", capacities[i])) return topology;
+        minCapacity = std::min(minCapacity, capacities[i]);
+        maxCapacity = std::max(maxCapacity, capacities[i]);
+    }
+
+    if (minCapacity < maxCapacity)
+    {
+        for (size_t i = 0; i < topology.processors.size(); ++i)
+        {
+            topology.processors[i].coreType = (capacities[i] == maxCapacity) ? vsg::CORE_TYPE_PERFORMANCE : vsg::CORE_TYPE_EFFICIENCY;
+        }
+    }
+
+    return topology;
+}
+
+uint32_t vsg::currentNumaNode()
+{
+    int cpu = sched_getcpu();
+    return (cpu >= 0) ? processorTopology().numaNodeOf(static_cast<uint32_t>(cpu)) : 0;
+}
+
+#else
+
+static vsg::ProcessorTopology queryProcessorTopology()
+{
+    vsg::ProcessorTopology topology;
+    defaultProcessorTopology(topology);
+    return topology;
+}
+
+uint32_t vsg::currentNumaNode()
+{
+    return 0;
+}
+
+#endif
+
+const vsg::ProcessorTopology& vsg::processorTopology()
+{
+    static const ProcessorTopology s_topology = queryProcessorTopology();
+    return s_topology;
+}
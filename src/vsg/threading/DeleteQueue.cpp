@@ -13,6 +13,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/io/Options.h>
 #include <vsg/threading/DeleteQueue.h>
 #include <vsg/ui/FrameStamp.h>
+#include <vsg/vk/DescriptorPools.h>
+
+#include <limits>
 
 using namespace vsg;
 
@@ -27,6 +30,13 @@ DeleteQueue::DeleteQueue(ref_ptr<ActivityStatus> status) :
 
 DeleteQueue::~DeleteQueue()
 {
+    _takeIncoming();
+    while (_pendingHead)
+    {
+        auto batch = _pendingHead;
+        _pendingHead = batch->next;
+        delete batch;
+    }
 }
 
 void DeleteQueue::advance(ref_ptr<FrameStamp> frameStamp)
@@ -35,16 +45,70 @@ void DeleteQueue::advance(ref_ptr<FrameStamp> frameStamp)
 
     frameCount = frameStamp->frameCount;
 
-    if (!_objectsToDelete.empty() && _objectsToDelete.front().frameCount <= frameStamp->frameCount)
+    _cv.notify_one();
+}
+
+void DeleteQueue::reclaim(ref_ptr<DescriptorPools> descriptorPools)
+{
+    std::scoped_lock lock(_mutex);
+
+    if (descriptorPools && std::find(_descriptorPoolsToReclaim.begin(), _descriptorPoolsToReclaim.end(), descriptorPools) == _descriptorPoolsToReclaim.end())
     {
-        _cv.notify_one();
+        _descriptorPoolsToReclaim.push_back(descriptorPools);
     }
 }
 
+void DeleteQueue::_takeIncoming()
+{
+    // take the whole list in one exchange, then reverse it so the batches are retired in the order they were added
+    Batch* batch = _incoming.exchange(nullptr, std::memory_order_acquire);
+    if (!batch) return;
+
+    Batch* head = nullptr;
+    Batch* tail = batch;
+    while (batch)
+    {
+        Batch* next = batch->next;
+        batch->next = head;
+        head = batch;
+        batch = next;
+    }
+
+    if (_pendingTail)
+        _pendingTail->next = head;
+    else
+        _pendingHead = head;
+    _pendingTail = tail;
+}
+
+size_t DeleteQueue::_retire(uint64_t retireFrameCount, std::list<ref_ptr<SharedObjects>>& sharedObjectsToPrune)
+{
+    size_t numObjectsDeleted = 0;
+    while (_pendingHead && _pendingHead->frameCount <= retireFrameCount)
+    {
+        auto batch = _pendingHead;
+        _pendingHead = batch->next;
+        if (!_pendingHead) _pendingTail = nullptr;
+
+        for (auto& sharedObjects : batch->sharedObjectsToPrune)
+        {
+            if (std::find(sharedObjectsToPrune.begin(), sharedObjectsToPrune.end(), sharedObjects) == sharedObjectsToPrune.end())
+                sharedObjectsToPrune.push_back(sharedObjects);
+        }
+
+        // releasing the whole batch at once lets the allocator's thread cache return the freed memory to its blocks in bulk
+        numObjectsDeleted += batch->objects.size();
+        delete batch;
+    }
+    return numObjectsDeleted;
+}
+
 void DeleteQueue::wait_then_clear()
 {
-    ObjectsToDelete objectsToDelete;
-    std::list<ref_ptr<SharedObjects>> sharedObjectsToPrune;
+    std::scoped_lock retireLock(_retireMutex);
+
+    std::list<ref_ptr<DescriptorPools>> descriptorPoolsToReclaim;
+    uint64_t retireFrameCount = 0;
 
     {
         std::chrono::duration waitDuration = std::chrono::milliseconds(100);
@@ -52,54 +116,48 @@ void DeleteQueue::wait_then_clear()
 
         uint64_t previous_frameCount = frameCount.load();
 
-        // wait until the conditional variable signals that an operation has been added
-        while ((_objectsToDelete.empty() || (frameCount.load() == previous_frameCount)) && _status->active())
+        // wait until there are batches to delete and the frameCount has advanced
+        while ((!_pendingHead && !_incoming.load(std::memory_order_relaxed)) || (frameCount.load() == previous_frameCount))
         {
+            if (!_status->active()) break;
             _cv.wait_for(lock, waitDuration);
         }
-        auto last_itr = std::find_if(_objectsToDelete.begin(), _objectsToDelete.end(), [&](const ObjectToDelete& otd) { return otd.frameCount > frameCount; });
 
-        // use a swap of the container to keep the time the mutex is acquired as short as possible
-        objectsToDelete.splice(objectsToDelete.end(), _objectsToDelete, _objectsToDelete.begin(), last_itr);
-
-        sharedObjectsToPrune.swap(_sharedObjectsToPrune);
+        retireFrameCount = frameCount.load();
+        descriptorPoolsToReclaim = _descriptorPoolsToReclaim;
     }
 
-    size_t numObjectsToDelete = objectsToDelete.size();
+    _takeIncoming();
+
+    std::list<ref_ptr<SharedObjects>> sharedObjectsToPrune;
+    size_t numObjectsDeleted = _retire(retireFrameCount, sharedObjectsToPrune);
 
-    objectsToDelete.clear();
+    for (auto& sharedObjects : sharedObjectsToPrune)
+    {
+        sharedObjects->prune();
+    }
 
-    if (numObjectsToDelete > 0)
+    if (numObjectsDeleted > 0)
     {
-        for (auto& sharedObjects : sharedObjectsToPrune)
+        // deleted subgraphs will have recycled their DescriptorSets so destroy any DescriptorPools left empty
+        for (auto& descriptorPools : descriptorPoolsToReclaim)
         {
-            sharedObjects->prune();
+            descriptorPools->reclaim();
         }
-        sharedObjectsToPrune.clear();
     }
 }
 
 void DeleteQueue::clear()
 {
-    ObjectsToDelete objectsToDelete;
+    std::scoped_lock retireLock(_retireMutex);
 
-    // use a swap of the container to keep the time the mutex is acquired as short as possible
-    {
-        std::scoped_lock lock(_mutex);
-        objectsToDelete.swap(objectsToDelete);
-    }
+    _takeIncoming();
 
-    size_t numObjectsToDelete = objectsToDelete.size();
-
-    //vsg::info("DeleteQueue::clear(), releasing ", nodesToRelease.size());
-    objectsToDelete.clear();
+    std::list<ref_ptr<SharedObjects>> sharedObjectsToPrune;
+    _retire(std::numeric_limits<uint64_t>::max(), sharedObjectsToPrune);
 
-    if (numObjectsToDelete > 0)
+    for (auto& sharedObjects : sharedObjectsToPrune)
     {
-        for (auto& sharedObjects : _sharedObjectsToPrune)
-        {
-            sharedObjects->prune();
-        }
-        _sharedObjectsToPrune.clear();
+        sharedObjects->prune();
     }
 }
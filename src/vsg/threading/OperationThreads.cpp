@@ -14,26 +14,93 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 using namespace vsg;
 
+namespace
+{
+    // identify which OperationThreads, and which of its threads, the current thread belongs to
+    thread_local const OperationThreads* t_operationThreads = nullptr;
+    thread_local size_t t_workerIndex = 0;
+
+    // number of times an idle thread checks for new operations before going to sleep
+    const int s_spinCount = 64;
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Task
+//
+Task::Task(ref_ptr<Operation> in_operation) :
+    operation(in_operation),
+    completed(Latch::create(1)),
+    _remaining(1)
+{
+}
+
+void Task::dependsOn(ref_ptr<Task> dependency)
+{
+    if (!dependency || dependency == this) return;
+
+    std::scoped_lock lock(dependency->_mutex);
+    if (!dependency->_completed)
+    {
+        dependency->_dependents.push_back(ref_ptr<Task>(this));
+        ++_remaining;
+    }
+}
+
+void Task::run()
+{
+    if (operation) operation->run();
+
+    std::vector<ref_ptr<Task>> dependents;
+    {
+        std::scoped_lock lock(_mutex);
+        _completed = true;
+        dependents.swap(_dependents);
+    }
+
+    _operationThreads = {};
+
+    for (auto& dependent : dependents) dependent->_release();
+
+    completed->count_down();
+}
+
+void Task::_submit(OperationThreads* operationThreads)
+{
+    _operationThreads = operationThreads;
+
+    // release the hold that prevents the Task being run before it's been submitted
+    _release();
+}
+
+void Task::_release()
+{
+    if (_remaining.fetch_sub(1) == 1)
+    {
+        _operationThreads->add(ref_ptr<Operation>(this));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// OperationThreads
+//
 OperationThreads::OperationThreads(uint32_t numThreads, ref_ptr<ActivityStatus> in_status) :
-    status(in_status)
+    status(in_status),
+    _pending(0),
+    _sleeping(0)
 {
     if (!status) status = ActivityStatus::create();
     queue = OperationQueue::create(status);
 
-    auto runThread = [](ref_ptr<OperationQueue> q, ref_ptr<ActivityStatus> thread_status) {
-        while (thread_status->active())
-        {
-            ref_ptr<Operation> operation = q->take_when_available();
-            if (operation)
-            {
-                operation->run();
-            }
-        }
-    };
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        _workerQueues.emplace_back(new WorkerQueue);
+    }
 
     for (size_t i = 0; i < numThreads; ++i)
     {
-        threads.emplace_back(runThread, queue, status);
+        threads.emplace_back(&OperationThreads::_runThread, this, i);
     }
 }
 
@@ -42,18 +109,162 @@ OperationThreads::~OperationThreads()
     stop();
 }
 
+size_t OperationThreads::_workerIndex() const
+{
+    return (t_operationThreads == this) ? t_workerIndex : _workerQueues.size();
+}
+
+void OperationThreads::_wake()
+{
+    // _pending has already been incremented so a thread that's about to sleep will see it, only need to notify threads that are already sleeping
+    if (_sleeping.load() > 0)
+    {
+        std::scoped_lock lock(_sleepMutex);
+        _sleepCondition.notify_one();
+    }
+}
+
+void OperationThreads::add(ref_ptr<Operation> operation, InsertionPosition insertionPosition)
+{
+    if (!operation) return;
+
+    ++_pending;
+
+    auto index = _workerIndex();
+    if (index < _workerQueues.size())
+    {
+        auto& workerQueue = *_workerQueues[index];
+        std::scoped_lock lock(workerQueue.mutex);
+        if (insertionPosition == INSERT_BACK)
+            workerQueue.operations.push_back(operation);
+        else
+            workerQueue.operations.push_front(operation);
+    }
+    else
+    {
+        queue->add(operation, insertionPosition);
+    }
+
+    _wake();
+}
+
+void OperationThreads::submit(ref_ptr<Task> task)
+{
+    if (task) task->_submit(this);
+}
+
+ref_ptr<Operation> OperationThreads::_take(size_t index)
+{
+    size_t numWorkers = _workerQueues.size();
+
+    // first check this thread's own deque, taking the most recently added operation
+    if (index < numWorkers)
+    {
+        auto& workerQueue = *_workerQueues[index];
+        std::scoped_lock lock(workerQueue.mutex);
+        if (!workerQueue.operations.empty())
+        {
+            auto operation = workerQueue.operations.back();
+            workerQueue.operations.pop_back();
+            --_pending;
+            return operation;
+        }
+    }
+
+    // next the shared queue
+    if (auto operation = queue->take())
+    {
+        --_pending;
+        return operation;
+    }
+
+    // finally try to steal the oldest operation from the other threads' deques
+    if (_pending.load() > 0)
+    {
+        for (size_t i = 1; i <= numWorkers; ++i)
+        {
+            auto& workerQueue = *_workerQueues[(index + i) % numWorkers];
+            std::scoped_lock lock(workerQueue.mutex);
+            if (!workerQueue.operations.empty())
+            {
+                auto operation = workerQueue.operations.front();
+                workerQueue.operations.pop_front();
+                --_pending;
+                return operation;
+            }
+        }
+    }
+
+    return {};
+}
+
+void OperationThreads::_runThread(size_t index)
+{
+    t_operationThreads = this;
+    t_workerIndex = index;
+
+    int spin = 0;
+    while (status->active())
+    {
+        if (auto operation = _take(index))
+        {
+            operation->run();
+            spin = 0;
+        }
+        else if (spin < s_spinCount)
+        {
+            ++spin;
+            std::this_thread::yield();
+        }
+        else
+        {
+            // the timeout catches operations added directly to the queue rather than via add(..)
+            std::unique_lock lock(_sleepMutex);
+            ++_sleeping;
+            _sleepCondition.wait_for(lock, std::chrono::milliseconds(100), [&]() { return _pending.load() > 0 || !status->active(); });
+            --_sleeping;
+            spin = 0;
+        }
+    }
+
+    t_operationThreads = nullptr;
+}
+
 void OperationThreads::run()
 {
-    while (ref_ptr<Operation> operation = queue->take())
+    auto index = _workerIndex();
+    while (ref_ptr<Operation> operation = _take(index))
     {
         operation->run();
     }
 }
 
+void OperationThreads::wait(Latch& latch)
+{
+    auto index = _workerIndex();
+    while (!latch.is_ready())
+    {
+        if (auto operation = _take(index))
+        {
+            operation->run();
+        }
+        else
+        {
+            // remaining operations are already running on other threads
+            latch.wait();
+        }
+    }
+}
+
 void OperationThreads::stop()
 {
     status->set(false);
 
+    {
+        std::scoped_lock lock(_sleepMutex);
+        _sleepCondition.notify_all();
+    }
+
     for (auto& thread : threads)
     {
         thread.join();
@@ -0,0 +1,59 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/ConstVisitor.h>
+#include <vsg/threading/ThreadConfinedScope.h>
+
+#include <atomic>
+
+using namespace vsg;
+
+namespace
+{
+    struct CollectUnconfinedObjects : public ConstVisitor
+    {
+        explicit CollectUnconfinedObjects(std::vector<ref_ptr<const Object>>& in_objects) :
+            objects(in_objects) { overrideMask = MASK_ALL; }
+
+        std::vector<ref_ptr<const Object>>& objects;
+
+        void apply(const Object& object) override
+        {
+            if (object.getThreadConfined()) return;
+
+            // take the reference before marking so the count is updated atomically
+            objects.emplace_back(&object);
+            object.setThreadConfined(true);
+
+            object.traverse(*this);
+        }
+    };
+} // namespace
+
+ThreadConfinedScope::ThreadConfinedScope(ref_ptr<const Object> object)
+{
+    if (!object) return;
+
+    CollectUnconfinedObjects collect(_objects);
+    object->accept(collect);
+}
+
+ThreadConfinedScope::~ThreadConfinedScope()
+{
+    for (auto& object : _objects) object->setThreadConfined(false);
+
+    // make the reference counts updated with plain stores visible before the objects can be handed on to other threads
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _objects.clear();
+}
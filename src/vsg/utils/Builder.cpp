@@ -1,7 +1,10 @@
 
 #include <vsg/io/Logger.h>
 #include <vsg/io/read.h>
+#include <vsg/commands/DrawIndexed.h>
+#include <vsg/maths/transform.h>
 #include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/Geometry.h>
 #include <vsg/nodes/StateGroup.h>
 #include <vsg/nodes/VertexIndexDraw.h>
 #include <vsg/state/DescriptorBuffer.h>
@@ -27,6 +30,11 @@ void Builder::assignCompileTraversal(ref_ptr<CompileTraversal> ct)
 }
 
 ref_ptr<StateGroup> Builder::createStateGroup(const StateInfo& stateInfo)
+{
+    return _createStateGroup(stateInfo, false);
+}
+
+ref_ptr<StateGroup> Builder::_createStateGroup(const StateInfo& stateInfo, bool instanceTransforms)
 {
     if (!sharedObjects)
     {
@@ -107,7 +115,17 @@ ref_ptr<StateGroup> Builder::createStateGroup(const StateInfo& stateInfo)
         graphicsPipelineConfig->enableArray("vsg_Color", VK_VERTEX_INPUT_RATE_INSTANCE, 4);
     }
 
-    if (stateInfo.billboard)
+    if (instanceTransforms)
+    {
+        if (!graphicsPipelineConfig->enableArray("vsg_Translation", VK_VERTEX_INPUT_RATE_INSTANCE, 12) ||
+            !graphicsPipelineConfig->enableArray("vsg_Rotation", VK_VERTEX_INPUT_RATE_INSTANCE, 16) ||
+            !graphicsPipelineConfig->enableArray("vsg_Scale", VK_VERTEX_INPUT_RATE_INSTANCE, 12))
+        {
+            warn("Builder::createInstances() ShaderSet doesn't support vsg_Translation, vsg_Rotation and vsg_Scale instance arrays.");
+            return {};
+        }
+    }
+    else if (stateInfo.billboard)
     {
         graphicsPipelineConfig->enableArray("vsg_Translation_scaleDistance", VK_VERTEX_INPUT_RATE_INSTANCE, 16);
     }
@@ -171,9 +189,16 @@ ref_ptr<StateGroup> Builder::createStateGroup(const StateInfo& stateInfo)
 
 void Builder::transform(const mat4& matrix, ref_ptr<vec3Array> vertices, ref_ptr<vec3Array> normals)
 {
-    for (auto& v : *vertices)
+    if (vertices->properties.stride == sizeof(vec3))
     {
-        v = matrix * v;
+        vsg::transform(matrix, vertices->data(), vertices->data(), vertices->size());
+    }
+    else
+    {
+        for (auto& v : *vertices)
+        {
+            v = matrix * v;
+        }
     }
 
     if (normals)
@@ -222,6 +247,8 @@ vec3 Builder::y_texcoord(const StateInfo& info) const
 
 ref_ptr<Node> Builder::decorateAndCompileIfRequired(const GeometryInfo& info, const StateInfo& stateInfo, ref_ptr<Node> node)
 {
+    if (_unitMeshes) return node;
+
     ref_ptr<Node> subgraph = node;
 
     // create StateGroup as the root of the scene/command graph to hold the GraphicsPipeline, and binding of Descriptors to decorate the whole graph
@@ -268,6 +295,169 @@ ref_ptr<Node> Builder::decorateAndCompileIfRequired(const GeometryInfo& info, co
     return subgraph;
 }
 
+ref_ptr<Node> Builder::_createUnitMesh(Shape shape, const StateInfo& stateInfo)
+{
+    GeometryInfo unit;
+    switch (shape)
+    {
+    case (BOX): return createBox(unit, stateInfo);
+    case (CAPSULE): return createCapsule(unit, stateInfo);
+    case (CONE): return createCone(unit, stateInfo);
+    case (CYLINDER): return createCylinder(unit, stateInfo);
+    case (DISK): return createDisk(unit, stateInfo);
+    case (QUAD): return createQuad(unit, stateInfo);
+    case (SPHERE): return createSphere(unit, stateInfo);
+    }
+    return {};
+}
+
+void Builder::addInstance(Shape shape, const GeometryInfo& info, const StateInfo& stateInfo)
+{
+    // the instances provide the translations and colors so normalize the StateInfo settings that would otherwise select other instance arrays
+    StateInfo batchStateInfo = stateInfo;
+    batchStateInfo.instance_colors_vec4 = true;
+    batchStateInfo.instance_positions_vec3 = false;
+    batchStateInfo.billboard = false;
+
+    auto& instances = _instances[batchStateInfo][shape];
+
+    mat4 axes(info.dx.x, info.dx.y, info.dx.z, 0.0f,
+              info.dy.x, info.dy.y, info.dy.z, 0.0f,
+              info.dz.x, info.dz.y, info.dz.z, 0.0f,
+              0.0f, 0.0f, 0.0f, 1.0f);
+
+    auto add = [&](const vec3& offset, const vec4& color) {
+        mat4 matrix = info.transform * translate(info.position + offset) * axes;
+
+        Instance instance;
+        instance.color = color;
+        if (!decompose(matrix, instance.translation, instance.rotation, instance.scale))
+        {
+            instance.translation.set(matrix[3][0], matrix[3][1], matrix[3][2]);
+            instance.rotation.set(0.0f, 0.0f, 0.0f, 1.0f);
+            instance.scale.set(1.0f, 1.0f, 1.0f);
+        }
+        instances.push_back(instance);
+    };
+
+    if (auto positions = info.positions.cast<vec3Array>())
+    {
+        auto colors = info.colors.cast<vec4Array>();
+        if (colors && colors->size() != positions->size()) colors = {};
+
+        instances.reserve(instances.size() + positions->size());
+        for (size_t i = 0; i < positions->size(); ++i)
+        {
+            add(positions->at(i), colors ? colors->at(i) : info.color);
+        }
+    }
+    else
+    {
+        add(vec3(0.0f, 0.0f, 0.0f), info.color);
+    }
+}
+
+ref_ptr<Node> Builder::createInstances()
+{
+    if (_instances.empty()) return {};
+
+    if (!_unitMeshBuilder)
+    {
+        _unitMeshBuilder = Builder::create();
+        _unitMeshBuilder->_unitMeshes = true;
+    }
+
+    auto group = Group::create();
+    for (auto& [stateInfo, shapes] : _instances)
+    {
+        struct Mesh
+        {
+            ref_ptr<vec3Array> vertices;
+            ref_ptr<vec3Array> normals;
+            ref_ptr<vec2Array> texcoords;
+            ref_ptr<ushortArray> indices;
+            const std::vector<Instance>* instances = nullptr;
+        };
+
+        std::vector<Mesh> meshes;
+        size_t numVertices = 0, numIndices = 0, numInstances = 0;
+        for (auto& [shape, instances] : shapes)
+        {
+            auto vid = _unitMeshBuilder->_createUnitMesh(shape, stateInfo).cast<VertexIndexDraw>();
+            if (!vid || vid->arrays.size() < 3 || !vid->indices) continue;
+
+            Mesh mesh;
+            mesh.vertices = vid->arrays[0]->data.cast<vec3Array>();
+            mesh.normals = vid->arrays[1]->data.cast<vec3Array>();
+            mesh.texcoords = vid->arrays[2]->data.cast<vec2Array>();
+            mesh.indices = vid->indices->data.cast<ushortArray>();
+            mesh.instances = &instances;
+            if (!mesh.vertices || !mesh.normals || !mesh.texcoords || !mesh.indices) continue;
+
+            numVertices += mesh.vertices->size();
+            numIndices += mesh.indices->size();
+            numInstances += instances.size();
+            meshes.push_back(mesh);
+        }
+
+        if (meshes.empty()) continue;
+
+        // indices remain local to each shape's vertices as each DrawIndexed provides a vertexOffset
+        auto vertices = vec3Array::create(static_cast<uint32_t>(numVertices));
+        auto normals = vec3Array::create(static_cast<uint32_t>(numVertices));
+        auto texcoords = vec2Array::create(static_cast<uint32_t>(numVertices));
+        auto indices = ushortArray::create(static_cast<uint32_t>(numIndices));
+        auto colors = vec4Array::create(static_cast<uint32_t>(numInstances));
+        auto translations = vec3Array::create(static_cast<uint32_t>(numInstances));
+        auto rotations = quatArray::create(static_cast<uint32_t>(numInstances));
+        auto scales = vec3Array::create(static_cast<uint32_t>(numInstances));
+
+        auto geometry = Geometry::create();
+
+        uint32_t vertexOffset = 0, firstIndex = 0, firstInstance = 0;
+        for (auto& mesh : meshes)
+        {
+            std::copy(mesh.vertices->begin(), mesh.vertices->end(), vertices->data() + vertexOffset);
+            std::copy(mesh.normals->begin(), mesh.normals->end(), normals->data() + vertexOffset);
+            std::copy(mesh.texcoords->begin(), mesh.texcoords->end(), texcoords->data() + vertexOffset);
+            std::copy(mesh.indices->begin(), mesh.indices->end(), indices->data() + firstIndex);
+
+            uint32_t instanceIndex = firstInstance;
+            for (auto& instance : *mesh.instances)
+            {
+                colors->set(instanceIndex, instance.color);
+                translations->set(instanceIndex, instance.translation);
+                rotations->set(instanceIndex, instance.rotation);
+                scales->set(instanceIndex, instance.scale);
+                ++instanceIndex;
+            }
+
+            auto indexCount = static_cast<uint32_t>(mesh.indices->size());
+            auto instanceCount = static_cast<uint32_t>(mesh.instances->size());
+            geometry->commands.push_back(DrawIndexed::create(indexCount, instanceCount, firstIndex, static_cast<int32_t>(vertexOffset), firstInstance));
+
+            vertexOffset += static_cast<uint32_t>(mesh.vertices->size());
+            firstIndex += indexCount;
+            firstInstance += instanceCount;
+        }
+
+        geometry->assignArrays(DataList{vertices, normals, texcoords, colors, translations, rotations, scales});
+        geometry->assignIndices(indices);
+
+        if (auto stateGroup = _createStateGroup(stateInfo, true))
+        {
+            stateGroup->addChild(geometry);
+            group->addChild(stateGroup);
+        }
+    }
+
+    _instances.clear();
+
+    if (compileTraversal) compileTraversal->compile(group);
+
+    return group;
+}
+
 ref_ptr<Node> Builder::createBox(const GeometryInfo& info, const StateInfo& stateInfo)
 {
     auto& subgraph = _boxes[std::make_pair(info, stateInfo)];
@@ -0,0 +1,279 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/BindIndexBuffer.h>
+#include <vsg/commands/BindVertexBuffers.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/utils/ChangeTracker.h>
+
+#include <algorithm>
+
+using namespace vsg;
+
+static const char* s_changeRecordKey = "vsg::ChangeRecord";
+
+/////////////////////////////////////////////////////////////////////////////////////////
+//
+// ChangeRecord
+//
+void ChangeRecord::addParent(Object* parent)
+{
+    if (!parent) return;
+    for (auto& existing : parents)
+    {
+        if (existing == parent) return;
+    }
+    parents.emplace_back(parent);
+}
+
+void ChangeRecord::removeParent(const Object* parent)
+{
+    parents.erase(std::remove_if(parents.begin(), parents.end(), [parent](const observer_ptr<Object>& existing) { return existing == parent || !existing; }), parents.end());
+}
+
+namespace
+{
+    /// attach ChangeRecords to a subgraph, recording the parent of each node and of the vertex and index Data used by draws.
+    class TrackSubgraph : public Visitor
+    {
+    public:
+        std::vector<Object*> parentStack;
+        std::vector<ref_ptr<Data>> newData;
+
+        // return true if a new ChangeRecord was attached to object.
+        bool record(Object& object)
+        {
+            Object* parent = parentStack.empty() ? nullptr : parentStack.back();
+            if (auto changeRecord = ChangeTracker::getRecord(&object))
+            {
+                changeRecord->addParent(parent);
+                return false;
+            }
+
+            auto changeRecord = ChangeRecord::create();
+            changeRecord->addParent(parent);
+            object.setObject(s_changeRecordKey, changeRecord);
+            return true;
+        }
+
+        void recordData(BufferInfo* bufferInfo)
+        {
+            if (!bufferInfo || !bufferInfo->data) return;
+            if (record(*bufferInfo->data)) newData.push_back(bufferInfo->data);
+        }
+
+        template<class T>
+        void recordArrays(T& object)
+        {
+            parentStack.push_back(&object);
+            for (auto& bufferInfo : object.arrays) recordData(bufferInfo);
+            parentStack.pop_back();
+        }
+
+        template<class T>
+        void recordIndices(T& object)
+        {
+            parentStack.push_back(&object);
+            recordData(object.indices);
+            parentStack.pop_back();
+        }
+
+        void apply(Object& object) override
+        {
+            if (!record(object)) return;
+
+            parentStack.push_back(&object);
+            object.traverse(*this);
+            parentStack.pop_back();
+        }
+
+        void apply(Geometry& geometry) override
+        {
+            apply(static_cast<Object&>(geometry));
+            recordArrays(geometry);
+            recordIndices(geometry);
+        }
+
+        void apply(VertexDraw& vd) override
+        {
+            apply(static_cast<Object&>(vd));
+            recordArrays(vd);
+        }
+
+        void apply(VertexIndexDraw& vid) override
+        {
+            apply(static_cast<Object&>(vid));
+            recordArrays(vid);
+            recordIndices(vid);
+        }
+
+        void apply(BindVertexBuffers& bvb) override
+        {
+            apply(static_cast<Object&>(bvb));
+            recordArrays(bvb);
+        }
+
+        void apply(BindIndexBuffer& bib) override
+        {
+            apply(static_cast<Object&>(bib));
+            recordIndices(bib);
+        }
+    };
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////
+//
+// ChangeTracker
+//
+ChangeTracker::ChangeTracker()
+{
+}
+
+ChangeRecord* ChangeTracker::getRecord(const Object* object)
+{
+    if (!object || !object->getAuxiliary()) return nullptr;
+    return const_cast<ChangeRecord*>(object->getObject<ChangeRecord>(s_changeRecordKey));
+}
+
+bool ChangeTracker::hasChanged(const Object* object)
+{
+    auto changeRecord = getRecord(object);
+    return !changeRecord || changeRecord->changed;
+}
+
+void ChangeTracker::track(ref_ptr<Node> root)
+{
+    if (!root) return;
+
+    TrackSubgraph trackSubgraph;
+    root->accept(trackSubgraph);
+
+    for (auto& data : trackSubgraph.newData)
+    {
+        TrackedData trackedData;
+        trackedData.data = data;
+        data->getModifiedCount(trackedData.modifiedCount);
+        _trackedData.push_back(trackedData);
+    }
+}
+
+void ChangeTracker::addChild(ref_ptr<Group> parent, ref_ptr<Node> child)
+{
+    if (!parent || !child) return;
+
+    parent->addChild(child);
+
+    TrackSubgraph trackSubgraph;
+    trackSubgraph.parentStack.push_back(parent.get());
+    child->accept(trackSubgraph);
+
+    for (auto& data : trackSubgraph.newData)
+    {
+        TrackedData trackedData;
+        trackedData.data = data;
+        data->getModifiedCount(trackedData.modifiedCount);
+        _trackedData.push_back(trackedData);
+    }
+
+    added.push_back(child);
+    changed(parent);
+}
+
+bool ChangeTracker::removeChild(ref_ptr<Group> parent, ref_ptr<Node> child)
+{
+    if (!parent || !child) return false;
+
+    auto itr = std::find(parent->children.begin(), parent->children.end(), child);
+    if (itr == parent->children.end()) return false;
+
+    parent->children.erase(itr);
+
+    // the child may still be referenced elsewhere so only remove the parent link if it isn't still a child of parent
+    if (std::find(parent->children.begin(), parent->children.end(), child) == parent->children.end())
+    {
+        if (auto changeRecord = getRecord(child)) changeRecord->removeParent(parent);
+    }
+
+    changed(parent);
+    return true;
+}
+
+void ChangeTracker::setMatrix(ref_ptr<MatrixTransform> transform, const dmat4& matrix)
+{
+    if (!transform) return;
+
+    transform->matrix = matrix;
+    changed(transform);
+}
+
+void ChangeTracker::changed(const Object* object)
+{
+    std::vector<ref_ptr<Object>> objects;
+    if (object) objects.emplace_back(const_cast<Object*>(object));
+
+    while (!objects.empty())
+    {
+        auto current = objects.back();
+        objects.pop_back();
+
+        auto changeRecord = getRecord(current);
+
+        // ancestors of an object that is already changed and has no cached results are already marked as changed
+        if (!changeRecord || (changeRecord->changed && !changeRecord->boundsValid)) continue;
+
+        if (!changeRecord->changed) _changed.emplace_back(current);
+
+        changeRecord->changed = true;
+        changeRecord->boundsValid = false;
+
+        for (auto& parent : changeRecord->parents)
+        {
+            if (auto ref_parent = parent.ref_ptr()) objects.push_back(ref_parent);
+        }
+    }
+}
+
+size_t ChangeTracker::update()
+{
+    size_t numModified = 0;
+    for (auto itr = _trackedData.begin(); itr != _trackedData.end();)
+    {
+        auto data = itr->data.ref_ptr();
+        if (!data)
+        {
+            itr = _trackedData.erase(itr);
+            continue;
+        }
+
+        if (data->getModifiedCount(itr->modifiedCount))
+        {
+            changed(data);
+            ++numModified;
+        }
+        ++itr;
+    }
+    return numModified;
+}
+
+void ChangeTracker::clear()
+{
+    for (auto& object : _changed)
+    {
+        if (auto changeRecord = getRecord(object.ref_ptr())) changeRecord->changed = false;
+    }
+    _changed.clear();
+    added.clear();
+}
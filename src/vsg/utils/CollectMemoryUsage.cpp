@@ -0,0 +1,270 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/app/CommandGraph.h>
+#include <vsg/commands/BindIndexBuffer.h>
+#include <vsg/commands/BindVertexBuffers.h>
+#include <vsg/io/Logger.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/InstanceDraw.h>
+#include <vsg/nodes/InstanceDrawIndexed.h>
+#include <vsg/nodes/InstanceNode.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/raytracing/DescriptorAccelerationStructure.h>
+#include <vsg/raytracing/TopLevelAccelerationStructure.h>
+#include <vsg/state/DescriptorBuffer.h>
+#include <vsg/state/DescriptorImage.h>
+#include <vsg/state/DescriptorSet.h>
+#include <vsg/utils/CollectMemoryUsage.h>
+#include <vsg/vk/DeviceMemory.h>
+
+using namespace vsg;
+
+VkDeviceSize MemoryUsage::totalBytes() const
+{
+    VkDeviceSize total = 0;
+    for (auto size : bytes) total += size;
+    return total;
+}
+
+const char* MemoryUsage::categoryName(Category category)
+{
+    switch (category)
+    {
+    case IMAGE: return "Image";
+    case VERTEX_BUFFER: return "Vertex buffer";
+    case INDEX_BUFFER: return "Index buffer";
+    case UNIFORM_BUFFER: return "Uniform buffer";
+    case STORAGE_BUFFER: return "Storage buffer";
+    case ACCELERATION_STRUCTURE: return "Acceleration structure";
+    case OTHER_BUFFER: return "Other buffer";
+    default: return "Unknown";
+    }
+}
+
+CollectMemoryUsage::CollectMemoryUsage(uint32_t in_deviceID) :
+    deviceID(in_deviceID)
+{
+    overrideMask = MASK_ALL;
+}
+
+void CollectMemoryUsage::clear()
+{
+    total = {};
+    owners.clear();
+    _ownerStack.clear();
+    _visited.clear();
+}
+
+void CollectMemoryUsage::add(const Object* resource, MemoryUsage::Category category, VkDeviceSize size)
+{
+    if (size == 0 || !_visited.insert(resource).second) return;
+
+    total.add(category, size);
+    owners[_ownerStack.empty() ? nullptr : _ownerStack.back()].add(category, size);
+}
+
+void CollectMemoryUsage::traverseOwner(const Object& owner)
+{
+    _ownerStack.push_back(&owner);
+    owner.traverse(*this);
+    _ownerStack.pop_back();
+}
+
+void CollectMemoryUsage::apply(const Object& object)
+{
+    object.traverse(*this);
+}
+
+void CollectMemoryUsage::apply(const PagedLOD& plod)
+{
+    traverseOwner(plod);
+}
+
+void CollectMemoryUsage::apply(const CommandGraph& commandGraph)
+{
+    traverseOwner(commandGraph);
+}
+
+void CollectMemoryUsage::apply(const DescriptorSet& descriptorSet)
+{
+    if (_visited.insert(&descriptorSet).second) descriptorSet.traverse(*this);
+}
+
+void CollectMemoryUsage::apply(const Descriptor& descriptor)
+{
+    if (auto dac = descriptor.cast<DescriptorAccelerationStructure>())
+    {
+        for (const auto& accelerationStructure : dac->getAccelerationStructures()) apply(accelerationStructure.get());
+    }
+}
+
+void CollectMemoryUsage::apply(const DescriptorBuffer& descriptorBuffer)
+{
+    MemoryUsage::Category category = MemoryUsage::OTHER_BUFFER;
+    switch (descriptorBuffer.descriptorType)
+    {
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+    case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+        category = MemoryUsage::UNIFORM_BUFFER;
+        break;
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+    case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+        category = MemoryUsage::STORAGE_BUFFER;
+        break;
+    default:
+        break;
+    }
+
+    for (const auto& bufferInfo : descriptorBuffer.bufferInfoList) apply(bufferInfo.get(), category);
+}
+
+void CollectMemoryUsage::apply(const DescriptorImage& descriptorImage)
+{
+    for (const auto& imageInfo : descriptorImage.imageInfoList) apply(imageInfo.get());
+}
+
+void CollectMemoryUsage::apply(const Geometry& geometry)
+{
+    for (const auto& bufferInfo : geometry.arrays) apply(bufferInfo.get(), MemoryUsage::VERTEX_BUFFER);
+    apply(geometry.indices.get(), MemoryUsage::INDEX_BUFFER);
+}
+
+void CollectMemoryUsage::apply(const VertexDraw& vd)
+{
+    for (const auto& bufferInfo : vd.arrays) apply(bufferInfo.get(), MemoryUsage::VERTEX_BUFFER);
+}
+
+void CollectMemoryUsage::apply(const VertexIndexDraw& vid)
+{
+    for (const auto& bufferInfo : vid.arrays) apply(bufferInfo.get(), MemoryUsage::VERTEX_BUFFER);
+    apply(vid.indices.get(), MemoryUsage::INDEX_BUFFER);
+}
+
+void CollectMemoryUsage::apply(const BindVertexBuffers& bvb)
+{
+    for (const auto& bufferInfo : bvb.arrays) apply(bufferInfo.get(), MemoryUsage::VERTEX_BUFFER);
+}
+
+void CollectMemoryUsage::apply(const BindIndexBuffer& bib)
+{
+    apply(bib.indices.get(), MemoryUsage::INDEX_BUFFER);
+}
+
+void CollectMemoryUsage::apply(const InstanceNode& in)
+{
+    apply(in.translations.get(), MemoryUsage::VERTEX_BUFFER);
+    apply(in.rotations.get(), MemoryUsage::VERTEX_BUFFER);
+    apply(in.scales.get(), MemoryUsage::VERTEX_BUFFER);
+    apply(in.colors.get(), MemoryUsage::VERTEX_BUFFER);
+
+    in.traverse(*this);
+}
+
+void CollectMemoryUsage::apply(const InstanceDraw& id)
+{
+    for (const auto& bufferInfo : id.arrays) apply(bufferInfo.get(), MemoryUsage::VERTEX_BUFFER);
+}
+
+void CollectMemoryUsage::apply(const InstanceDrawIndexed& idi)
+{
+    for (const auto& bufferInfo : idi.arrays) apply(bufferInfo.get(), MemoryUsage::VERTEX_BUFFER);
+    apply(idi.indices.get(), MemoryUsage::INDEX_BUFFER);
+}
+
+void CollectMemoryUsage::apply(const BufferInfo* bufferInfo, MemoryUsage::Category category)
+{
+    if (!bufferInfo || !bufferInfo->buffer) return;
+
+    // BufferInfo are suballocated from shared Buffers so count the range of each BufferInfo rather than the Buffer
+    auto& buffer = bufferInfo->buffer;
+    if (deviceID < buffer->sizeVulkanData() && buffer->vk(deviceID) != VK_NULL_HANDLE)
+    {
+        add(bufferInfo, category, bufferInfo->range);
+    }
+}
+
+void CollectMemoryUsage::apply(const ImageInfo* imageInfo)
+{
+    if (!imageInfo || !imageInfo->imageView || !imageInfo->imageView->image) return;
+
+    auto& image = imageInfo->imageView->image;
+    if (deviceID < image->sizeVulkanData() && image->vk(deviceID) != VK_NULL_HANDLE && image->getDeviceMemory(deviceID))
+    {
+        if (_visited.count(image.get()) == 0) add(image.get(), MemoryUsage::IMAGE, image->getMemoryRequirements(deviceID).size);
+    }
+}
+
+void CollectMemoryUsage::apply(const AccelerationStructure* accelerationStructure)
+{
+    if (!accelerationStructure || _visited.count(accelerationStructure) != 0) return;
+
+    add(accelerationStructure, MemoryUsage::ACCELERATION_STRUCTURE, accelerationStructure->size());
+
+    if (auto tlas = accelerationStructure->cast<TopLevelAccelerationStructure>())
+    {
+        for (const auto& geometryInstance : tlas->geometryInstances)
+        {
+            if (geometryInstance) apply(geometryInstance->accelerationStructure.get());
+        }
+    }
+}
+
+void CollectMemoryUsage::report(std::ostream& out, const Device* device) const
+{
+    auto print = [&out](const std::string& indent, const MemoryUsage& usage) {
+        for (size_t i = 0; i < MemoryUsage::CATEGORY_COUNT; ++i)
+        {
+            if (usage.counts[i] == 0) continue;
+            out << indent << MemoryUsage::categoryName(static_cast<MemoryUsage::Category>(i)) << " count = " << usage.counts[i] << ", bytes = " << usage.bytes[i] << std::endl;
+        }
+    };
+
+    out << "CollectMemoryUsage total bytes = " << total.totalBytes() << std::endl;
+    print("    ", total);
+
+    for (auto& [owner, usage] : owners)
+    {
+        if (owner)
+        {
+            std::string name;
+            owner->getValue("name", name);
+            out << "    " << owner->className() << " " << owner << " " << name << " bytes = " << usage.totalBytes() << std::endl;
+        }
+        else
+        {
+            out << "    unowned bytes = " << usage.totalBytes() << std::endl;
+        }
+        print("        ", usage);
+    }
+
+    if (!device) return;
+
+    size_t deviceMemoryAllocated = 0;
+    size_t deviceMemoryReserved = 0;
+    for (auto& deviceMemory : getActiveDeviceMemoryList(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
+    {
+        if (deviceMemory->getDevice() != device) continue;
+        deviceMemoryAllocated += deviceMemory->totalMemorySize();
+        deviceMemoryReserved += deviceMemory->totalReservedSize();
+    }
+    out << "    DeviceMemory allocated = " << deviceMemoryAllocated << ", reserved = " << deviceMemoryReserved << std::endl;
+
+    auto heapBudgets = device->memoryHeapBudgets();
+    for (size_t heapIndex = 0; heapIndex < heapBudgets.size(); ++heapIndex)
+    {
+        auto& heapBudget = heapBudgets[heapIndex];
+        out << "    heap " << heapIndex << ((heapBudget.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? " device local" : "") << " size = " << heapBudget.size << ", budget = " << heapBudget.budget << ", usage = " << heapBudget.usage << std::endl;
+    }
+}
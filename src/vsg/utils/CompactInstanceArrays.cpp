@@ -0,0 +1,584 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/maths/box.h>
+#include <vsg/maths/quantize.h>
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/state/VertexInputState.h>
+#include <vsg/utils/CompactInstanceArrays.h>
+
+#include <map>
+#include <typeinfo>
+
+using namespace vsg;
+
+namespace
+{
+    const char* packedRotationDefine = "VSG_INSTANCE_ROTATION_PACKED";
+    const char* uniformScaleDefine = "VSG_INSTANCE_UNIFORM_SCALE";
+
+    VertexInputState* findVertexInputState(GraphicsPipeline& pipeline)
+    {
+        for (auto& pipelineState : pipeline.pipelineStates)
+        {
+            if (auto vis = pipelineState->cast<VertexInputState>()) return vis;
+        }
+        return nullptr;
+    }
+
+    bool supportsDefine(GraphicsPipeline& pipeline, const char* define)
+    {
+        for (auto& stage : pipeline.stages)
+        {
+            if (stage && stage->stage == VK_SHADER_STAGE_VERTEX_BIT) return stage->module && stage->module->source.find(define) != std::string::npos;
+        }
+        return false;
+    }
+
+    bool isUniform(const vec3Array& scales)
+    {
+        for (auto& s : scales)
+        {
+            float tolerance = std::max({std::abs(s.x), std::abs(s.y), std::abs(s.z)}) * 1e-5f;
+            if (std::abs(s.x - s.y) > tolerance || std::abs(s.x - s.z) > tolerance) return false;
+        }
+        return true;
+    }
+
+    struct ConvertedTranslations
+    {
+        ref_ptr<Data> data;
+        dvec3 center;
+        double halfExtent = 1.0;
+    };
+} // namespace
+
+CompactInstanceArrays::CompactInstanceArrays()
+{
+}
+
+CompactInstanceArrays::~CompactInstanceArrays()
+{
+}
+
+ref_ptr<usvec4Array> CompactInstanceArrays::halfFloatTranslationArray(const vec3Array& translations, const dvec3& origin)
+{
+    auto converted = usvec4Array::create(translations.size());
+    converted->properties.format = VK_FORMAT_R16G16B16A16_SFLOAT;
+
+    auto itr = converted->begin();
+    for (auto& t : translations)
+    {
+        dvec3 r = dvec3(t) - origin;
+        (itr++)->set(floatToHalf(static_cast<float>(r.x)), floatToHalf(static_cast<float>(r.y)), floatToHalf(static_cast<float>(r.z)), floatToHalf(1.0f));
+    }
+    return converted;
+}
+
+ref_ptr<svec4Array> CompactInstanceArrays::quantizeTranslationArray(const vec3Array& translations, const dvec3& center, double halfExtent)
+{
+    auto quantized = svec4Array::create(translations.size());
+    quantized->properties.format = VK_FORMAT_R16G16B16A16_SNORM;
+
+    auto itr = quantized->begin();
+    for (auto& t : translations)
+    {
+        dvec3 q = (dvec3(t) - center) / halfExtent;
+        (itr++)->set(floatToSnorm16(static_cast<float>(q.x)), floatToSnorm16(static_cast<float>(q.y)), floatToSnorm16(static_cast<float>(q.z)), floatToSnorm16(1.0f));
+    }
+    return quantized;
+}
+
+ref_ptr<uintArray> CompactInstanceArrays::packRotationArray(const quatArray& rotations)
+{
+    auto packed = uintArray::create(rotations.size());
+    packed->properties.format = VK_FORMAT_R32_UINT;
+
+    auto itr = packed->begin();
+    for (auto& q : rotations)
+    {
+        *(itr++) = packQuatSmallestThree(q);
+    }
+    return packed;
+}
+
+ref_ptr<uintArray> CompactInstanceArrays::packRotationArray(const vec4Array& rotations)
+{
+    auto packed = uintArray::create(rotations.size());
+    packed->properties.format = VK_FORMAT_R32_UINT;
+
+    auto itr = packed->begin();
+    for (auto& q : rotations)
+    {
+        *(itr++) = packQuatSmallestThree(quat(q.x, q.y, q.z, q.w));
+    }
+    return packed;
+}
+
+ref_ptr<floatArray> CompactInstanceArrays::uniformScaleArray(const vec3Array& scales, float multiplier)
+{
+    auto converted = floatArray::create(scales.size());
+    converted->properties.format = VK_FORMAT_R32_SFLOAT;
+
+    auto itr = converted->begin();
+    for (auto& s : scales)
+    {
+        *(itr++) = s.x * multiplier;
+    }
+    return converted;
+}
+
+ref_ptr<ubvec4Array> CompactInstanceArrays::packColorArray(const vec3Array& colors)
+{
+    auto packed = ubvec4Array::create(colors.size());
+    packed->properties.format = VK_FORMAT_R8G8B8A8_UNORM;
+
+    auto toUnorm8 = [](float v) { return static_cast<uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f)); };
+
+    auto itr = packed->begin();
+    for (auto& c : colors)
+    {
+        (itr++)->set(toUnorm8(c.r), toUnorm8(c.g), toUnorm8(c.b), 255);
+    }
+    return packed;
+}
+
+ref_ptr<ubvec4Array> CompactInstanceArrays::packColorArray(const vec4Array& colors)
+{
+    auto packed = ubvec4Array::create(colors.size());
+    packed->properties.format = VK_FORMAT_R8G8B8A8_UNORM;
+
+    auto toUnorm8 = [](float v) { return static_cast<uint8_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f)); };
+
+    auto itr = packed->begin();
+    for (auto& c : colors)
+    {
+        (itr++)->set(toUnorm8(c.r), toUnorm8(c.g), toUnorm8(c.b), toUnorm8(c.a));
+    }
+    return packed;
+}
+
+bool CompactInstanceArrays::decodeTranslation(const Data* translations, uint32_t index, vec3& translation)
+{
+    if (!translations || index >= translations->valueCount()) return false;
+
+    if (auto vertices = translations->cast<vec3Array>())
+    {
+        translation = vertices->at(index);
+        return true;
+    }
+    if (auto halfFloats = translations->cast<usvec4Array>())
+    {
+        auto& t = halfFloats->at(index);
+        translation.set(halfToFloat(t.x), halfToFloat(t.y), halfToFloat(t.z));
+        return true;
+    }
+    if (auto snorms = translations->cast<svec4Array>())
+    {
+        auto& t = snorms->at(index);
+        translation.set(snorm16ToFloat(t.x), snorm16ToFloat(t.y), snorm16ToFloat(t.z));
+        return true;
+    }
+    return false;
+}
+
+bool CompactInstanceArrays::decodeRotation(const Data* rotations, uint32_t index, quat& rotation)
+{
+    if (!rotations || index >= rotations->valueCount()) return false;
+
+    if (auto quats = rotations->cast<quatArray>())
+    {
+        rotation = quats->at(index);
+        return true;
+    }
+    if (auto vec4s = rotations->cast<vec4Array>())
+    {
+        auto& q = vec4s->at(index);
+        rotation.set(q.x, q.y, q.z, q.w);
+        return true;
+    }
+    if (auto packed = rotations->cast<uintArray>())
+    {
+        rotation = unpackQuatSmallestThree(packed->at(index));
+        return true;
+    }
+    return false;
+}
+
+bool CompactInstanceArrays::decodeScale(const Data* scales, uint32_t index, vec3& scale)
+{
+    if (!scales || index >= scales->valueCount()) return false;
+
+    if (auto vec3s = scales->cast<vec3Array>())
+    {
+        scale = vec3s->at(index);
+        return true;
+    }
+    if (auto floats = scales->cast<floatArray>())
+    {
+        float s = floats->at(index);
+        scale.set(s, s, s);
+        return true;
+    }
+    return false;
+}
+
+void CompactInstanceArrays::compact(Node& node)
+{
+    _visited.clear();
+    _instances.clear();
+    _pipelineStack.clear();
+    _parent = nullptr;
+    _currentInstances = nullptr;
+
+    node.accept(*this);
+
+    _convert();
+
+    _instances.clear();
+    _visited.clear();
+}
+
+void CompactInstanceArrays::report(LogOutput& output) const
+{
+    output("CompactInstanceArrays::report(..) ", this, " {");
+    output.in();
+    output("numArraysConverted = ", numArraysConverted);
+    output("numPipelinesUpdated = ", numPipelinesUpdated);
+    output("numBytesBefore = ", numBytesBefore);
+    output("numBytesAfter = ", numBytesAfter);
+    output.out();
+    output("}");
+}
+
+void CompactInstanceArrays::apply(Node& node)
+{
+    // InstanceNode that aren't direct children of a Group can't be placed under a dequantizing MatrixTransform
+    _parent = nullptr;
+    node.traverse(*this);
+}
+
+void CompactInstanceArrays::apply(Group& group)
+{
+    if (!_visited.insert(&group).second) return;
+
+    for (size_t i = 0; i < group.children.size(); ++i)
+    {
+        _parent = &group;
+        _childIndex = i;
+        group.children[i]->accept(*this);
+    }
+    _parent = nullptr;
+}
+
+void CompactInstanceArrays::apply(StateGroup& stateGroup)
+{
+    GraphicsPipeline* pipeline = nullptr;
+    for (auto& stateCommand : stateGroup.stateCommands)
+    {
+        if (auto bindPipeline = stateCommand->cast<BindGraphicsPipeline>()) pipeline = bindPipeline->pipeline;
+    }
+
+    if (pipeline)
+    {
+        _pipelineStack.push_back(pipeline);
+        if (_currentInstances) _currentInstances->pipelines.push_back(pipeline);
+    }
+
+    apply(static_cast<Group&>(stateGroup));
+
+    if (pipeline) _pipelineStack.pop_back();
+}
+
+void CompactInstanceArrays::apply(InstanceNode& instanceNode)
+{
+    // an InstanceNode with multiple parents is collected once per parent so that each parent can be redirected to the dequantizing MatrixTransform
+    auto& instances = _instances.emplace_back();
+    instances.node = &instanceNode;
+    instances.parent = _parent;
+    instances.childIndex = _childIndex;
+    if (!_pipelineStack.empty()) instances.pipelines.push_back(_pipelineStack.back());
+
+    auto previousInstances = _currentInstances;
+    _currentInstances = &instances;
+    _parent = nullptr;
+
+    if (instanceNode.child) instanceNode.child->accept(*this);
+
+    _currentInstances = previousInstances;
+    _parent = nullptr;
+}
+
+void CompactInstanceArrays::_convert()
+{
+    // InstanceNode without a GraphicsPipeline can't have their arrays converted as there is no VertexInputState to update to match
+    _instances.remove_if([](const Instances& instances) { return instances.pipelines.empty(); });
+    if (_instances.empty()) return;
+
+    std::set<GraphicsPipeline*> pipelines;
+    for (auto& instances : _instances) pipelines.insert(instances.pipelines.begin(), instances.pipelines.end());
+
+    // a kind of array is only converted when every pipeline reading it at location has a per instance attribute suitable for conversion
+    auto pipelinesSupport = [&](uint32_t location, std::initializer_list<VkFormat> formats, const char* define) {
+        for (auto pipeline : pipelines)
+        {
+            auto vertexInputState = findVertexInputState(*pipeline);
+            if (!vertexInputState) return false;
+
+            auto& attributes = vertexInputState->vertexAttributeDescriptions;
+            auto attribute = std::find_if(attributes.begin(), attributes.end(), [&](const VkVertexInputAttributeDescription& a) { return a.location == location; });
+            if (attribute == attributes.end()) continue;
+
+            if (std::find(formats.begin(), formats.end(), attribute->format) == formats.end() || attribute->offset != 0) return false;
+            if (define && !supportsDefine(*pipeline, define)) return false;
+
+            auto& bindings = vertexInputState->vertexBindingDescriptions;
+            auto binding = std::find_if(bindings.begin(), bindings.end(), [&](const VkVertexInputBindingDescription& b) { return b.binding == attribute->binding; });
+            if (binding == bindings.end() || binding->inputRate != VK_VERTEX_INPUT_RATE_INSTANCE) return false;
+
+            auto numAttributesUsingBinding = std::count_if(attributes.begin(), attributes.end(), [&](const VkVertexInputAttributeDescription& a) { return a.binding == attribute->binding; });
+            if (numAttributesUsingBinding != 1) return false;
+        }
+        return true;
+    };
+
+    // and every InstanceNode with that kind of array provides one that can be converted
+    auto arraysSupport = [&](ref_ptr<BufferInfo> InstanceNode::*member, std::initializer_list<const std::type_info*> types) {
+        bool found = false;
+        for (auto& instances : _instances)
+        {
+            auto& bufferInfo = instances.node->*member;
+            if (!bufferInfo) continue;
+            if (!bufferInfo->data || bufferInfo->offset != 0 || bufferInfo->data->dynamic()) return false;
+
+            auto& data = *bufferInfo->data;
+            if (std::none_of(types.begin(), types.end(), [&](const std::type_info* type) { return typeid(data) == *type; })) return false;
+            found = true;
+        }
+        return found;
+    };
+
+    bool convertColors = packColors && arraysSupport(&InstanceNode::colors, {&typeid(vec3Array), &typeid(vec4Array)}) &&
+                         pipelinesSupport(6, {VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT}, nullptr);
+
+    bool convertRotations = packRotations && arraysSupport(&InstanceNode::rotations, {&typeid(quatArray), &typeid(vec4Array)}) &&
+                            pipelinesSupport(8, {VK_FORMAT_R32G32B32A32_SFLOAT}, packedRotationDefine);
+
+    bool scalesConvertible = arraysSupport(&InstanceNode::scales, {&typeid(vec3Array)}) && pipelinesSupport(9, {VK_FORMAT_R32G32B32_SFLOAT}, nullptr);
+
+    bool convertUniformScales = uniformScales && scalesConvertible && pipelinesSupport(9, {VK_FORMAT_R32G32B32_SFLOAT}, uniformScaleDefine);
+    for (auto& instances : _instances)
+    {
+        if (convertUniformScales && instances.node->scales) convertUniformScales = isUniform(*instances.node->scales->data.cast<vec3Array>());
+    }
+
+    bool translationsConvertible = arraysSupport(&InstanceNode::translations, {&typeid(vec3Array)}) && pipelinesSupport(7, {VK_FORMAT_R32G32B32_SFLOAT}, nullptr);
+
+    // snorm translations are normalized to their bounds, so require the scales to be divided by the half extent and a parent to place the dequantizing MatrixTransform under
+    bool convertQuantizedTranslations = quantizeTranslations && translationsConvertible && scalesConvertible;
+    for (auto& instances : _instances)
+    {
+        if (convertQuantizedTranslations && instances.node->translations) convertQuantizedTranslations = instances.node->scales && instances.parent;
+    }
+
+    bool convertHalfFloatTranslations = halfFloatTranslations && translationsConvertible && !convertQuantizedTranslations;
+
+    if (!convertColors && !convertRotations && !convertUniformScales && !convertQuantizedTranslations && !convertHalfFloatTranslations) return;
+
+    auto recordConversion = [&](const Data& source, const Data& result) {
+        ++numArraysConverted;
+        numBytesBefore += source.dataSize();
+        numBytesAfter += result.dataSize();
+    };
+
+    // convert the arrays, sharing the converted arrays between the InstanceNode that shared the originals
+    std::map<std::pair<const Data*, bool>, ConvertedTranslations> convertedTranslations;
+    std::map<std::pair<const Data*, double>, ref_ptr<Data>> convertedScales;
+    std::map<const Data*, ref_ptr<Data>> converted;
+    std::map<const InstanceNode*, dmat4> matrices;
+    std::set<const InstanceNode*> convertedNodes;
+
+    for (auto& instances : _instances)
+    {
+        auto& node = *instances.node;
+        if (!convertedNodes.insert(&node).second) continue;
+
+        double scaleMultiplier = 1.0;
+        if (node.translations && (convertQuantizedTranslations || convertHalfFloatTranslations))
+        {
+            auto source = node.translations->data.cast<vec3Array>();
+
+            // translations are made relative to the center of their bounds when a MatrixTransform can be placed above the InstanceNode to restore them
+            bool relative = instances.parent != nullptr;
+            auto& result = convertedTranslations[{source.get(), relative}];
+            if (!result.data)
+            {
+                dbox bound;
+                for (auto& t : *source) bound.add(t);
+
+                if (relative && bound.valid())
+                {
+                    result.center = (bound.min + bound.max) * 0.5;
+                    result.halfExtent = std::max({bound.max.x - result.center.x, bound.max.y - result.center.y, bound.max.z - result.center.z});
+                    if (result.halfExtent <= 0.0) result.halfExtent = 1.0;
+                }
+
+                if (convertQuantizedTranslations)
+                    result.data = quantizeTranslationArray(*source, result.center, result.halfExtent);
+                else
+                    result.data = halfFloatTranslationArray(*source, result.center);
+
+                recordConversion(*source, *result.data);
+            }
+
+            if (convertQuantizedTranslations)
+            {
+                matrices[&node] = translate(result.center) * scale(result.halfExtent);
+                scaleMultiplier = 1.0 / result.halfExtent;
+            }
+            else if (relative)
+            {
+                matrices[&node] = translate(result.center);
+            }
+
+            node.translations = BufferInfo::create(result.data);
+        }
+
+        if (node.scales && (convertUniformScales || scaleMultiplier != 1.0))
+        {
+            auto source = node.scales->data.cast<vec3Array>();
+            auto& result = convertedScales[{source.get(), scaleMultiplier}];
+            if (!result)
+            {
+                auto multiplier = static_cast<float>(scaleMultiplier);
+                if (convertUniformScales)
+                {
+                    result = uniformScaleArray(*source, multiplier);
+                }
+                else
+                {
+                    auto scaled = vec3Array::create(source->size());
+                    auto itr = scaled->begin();
+                    for (auto& s : *source) *(itr++) = s * multiplier;
+                    result = scaled;
+                }
+                recordConversion(*source, *result);
+            }
+            node.scales = BufferInfo::create(result);
+        }
+
+        if (node.rotations && convertRotations)
+        {
+            auto source = node.rotations->data.get();
+            auto& result = converted[source];
+            if (!result)
+            {
+                if (auto quats = source->cast<quatArray>())
+                    result = packRotationArray(*quats);
+                else
+                    result = packRotationArray(*source->cast<vec4Array>());
+                recordConversion(*source, *result);
+            }
+            node.rotations = BufferInfo::create(result);
+        }
+
+        if (node.colors && convertColors)
+        {
+            auto source = node.colors->data.get();
+            auto& result = converted[source];
+            if (!result)
+            {
+                if (auto vec3s = source->cast<vec3Array>())
+                    result = packColorArray(*vec3s);
+                else
+                    result = packColorArray(*source->cast<vec4Array>());
+                recordConversion(*source, *result);
+            }
+            node.colors = BufferInfo::create(result);
+        }
+    }
+
+    // place the InstanceNode with relative translations under the MatrixTransform that restores them, reusing the transform for InstanceNode with multiple parents
+    std::map<const InstanceNode*, ref_ptr<MatrixTransform>> transforms;
+    for (auto& instances : _instances)
+    {
+        auto itr = matrices.find(instances.node);
+        if (itr == matrices.end() || !instances.parent) continue;
+
+        auto& transform = transforms[instances.node];
+        if (!transform)
+        {
+            transform = MatrixTransform::create(itr->second);
+            transform->addChild(ref_ptr<Node>(instances.node));
+        }
+        instances.parent->children[instances.childIndex] = transform;
+    }
+
+    // update the pipelines to match the new array formats
+    for (auto pipeline : pipelines)
+    {
+        auto vertexInputState = findVertexInputState(*pipeline);
+        auto newVertexInputState = VertexInputState::create(*vertexInputState);
+        std::vector<const char*> defines;
+        bool updated = false;
+
+        auto update = [&](uint32_t location, VkFormat format, uint32_t stride, const char* define) {
+            for (auto& attribute : newVertexInputState->vertexAttributeDescriptions)
+            {
+                if (attribute.location != location) continue;
+
+                attribute.format = format;
+                for (auto& binding : newVertexInputState->vertexBindingDescriptions)
+                {
+                    if (binding.binding == attribute.binding) binding.stride = stride;
+                }
+                if (define) defines.push_back(define);
+                updated = true;
+            }
+        };
+
+        if (convertColors) update(6, VK_FORMAT_R8G8B8A8_UNORM, sizeof(ubvec4), nullptr);
+        if (convertQuantizedTranslations) update(7, VK_FORMAT_R16G16B16A16_SNORM, sizeof(svec4), nullptr);
+        if (convertHalfFloatTranslations) update(7, VK_FORMAT_R16G16B16A16_SFLOAT, sizeof(usvec4), nullptr);
+        if (convertRotations) update(8, VK_FORMAT_R32_UINT, sizeof(uint32_t), packedRotationDefine);
+        if (convertUniformScales) update(9, VK_FORMAT_R32_SFLOAT, sizeof(float), uniformScaleDefine);
+
+        if (!updated) continue;
+
+        for (auto& pipelineState : pipeline->pipelineStates)
+        {
+            if (pipelineState == vertexInputState) pipelineState = newVertexInputState;
+        }
+
+        if (!defines.empty())
+        {
+            // replace the vertex shader with one compiled with the decoding defines
+            for (auto& stage : pipeline->stages)
+            {
+                if (!stage || stage->stage != VK_SHADER_STAGE_VERTEX_BIT) continue;
+
+                auto hints = stage->module->hints ? ShaderCompileSettings::create(*stage->module->hints) : ShaderCompileSettings::create();
+                hints->defines.insert(defines.begin(), defines.end());
+
+                auto vertexShader = ShaderStage::create(stage->stage, stage->entryPointName, ShaderModule::create(stage->module->source, hints));
+                vertexShader->flags = stage->flags;
+                vertexShader->mask = stage->mask;
+                vertexShader->specializationConstants = stage->specializationConstants;
+                stage = vertexShader;
+            }
+        }
+
+        ++numPipelinesUpdated;
+    }
+}
@@ -0,0 +1,819 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array2D.h>
+#include <vsg/core/MipmapLayout.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/state/DescriptorImage.h>
+#include <vsg/utils/CompressTextures.h>
+#include <vsg/vk/PhysicalDevice.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// block encoders
+//
+namespace
+{
+    /// 8 bit per component RGBA image used as the source of the block encoders
+    struct Image8
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> rgba;
+
+        const uint8_t* pixel(uint32_t x, uint32_t y) const { return &rgba[(static_cast<size_t>(y) * width + x) * 4]; }
+    };
+
+    using Block = uint8_t[16][4];
+
+    inline int clamp255(int v) { return std::clamp(v, 0, 255); }
+    inline int square(int v) { return v * v; }
+
+    /// copy the 4x4 block of pixels at block bx, by, replicating the edge pixels for blocks that overlap the edge of the image
+    void extractBlock(const Image8& image, uint32_t bx, uint32_t by, Block& block)
+    {
+        for (uint32_t y = 0; y < 4; ++y)
+        {
+            uint32_t py = std::min(by * 4 + y, image.height - 1);
+            for (uint32_t x = 0; x < 4; ++x)
+            {
+                uint32_t px = std::min(bx * 4 + x, image.width - 1);
+                std::copy_n(image.pixel(px, py), 4, block[y * 4 + x]);
+            }
+        }
+    }
+
+    void extractChannel(const Block& block, int channel, uint8_t values[16])
+    {
+        for (int i = 0; i < 16; ++i) values[i] = block[i][channel];
+    }
+
+    /// box filter image down to the next mipmap level
+    Image8 downsample(const Image8& image)
+    {
+        Image8 result;
+        result.width = std::max(image.width / 2, 1u);
+        result.height = std::max(image.height / 2, 1u);
+        result.rgba.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+        auto dest = result.rgba.data();
+        for (uint32_t y = 0; y < result.height; ++y)
+        {
+            uint32_t y0 = std::min(y * 2, image.height - 1);
+            uint32_t y1 = std::min(y * 2 + 1, image.height - 1);
+            for (uint32_t x = 0; x < result.width; ++x)
+            {
+                uint32_t x0 = std::min(x * 2, image.width - 1);
+                uint32_t x1 = std::min(x * 2 + 1, image.width - 1);
+                for (int c = 0; c < 4; ++c)
+                {
+                    int sum = image.pixel(x0, y0)[c] + image.pixel(x1, y0)[c] + image.pixel(x0, y1)[c] + image.pixel(x1, y1)[c];
+                    *(dest++) = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+        return result;
+    }
+
+    //
+    // BC1 color block, endpoints fitted to the range of the pixels along their principal axis
+    //
+    uint16_t packRGB565(const float rgb[3])
+    {
+        int r = std::clamp(static_cast<int>(std::lround(rgb[0] * 31.0f / 255.0f)), 0, 31);
+        int g = std::clamp(static_cast<int>(std::lround(rgb[1] * 63.0f / 255.0f)), 0, 63);
+        int b = std::clamp(static_cast<int>(std::lround(rgb[2] * 31.0f / 255.0f)), 0, 31);
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void unpackRGB565(uint16_t c, int rgb[3])
+    {
+        int r = (c >> 11) & 31;
+        int g = (c >> 5) & 63;
+        int b = c & 31;
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    void encodeBC1(const Block& block, uint8_t* out)
+    {
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        for (auto& p : block)
+            for (int c = 0; c < 3; ++c) mean[c] += p[c];
+        for (auto& m : mean) m /= 16.0f;
+
+        // covariance rr, rg, rb, gg, gb, bb
+        float cov[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        for (auto& p : block)
+        {
+            float r = p[0] - mean[0], g = p[1] - mean[1], b = p[2] - mean[2];
+            cov[0] += r * r;
+            cov[1] += r * g;
+            cov[2] += r * b;
+            cov[3] += g * g;
+            cov[4] += g * b;
+            cov[5] += b * b;
+        }
+
+        // principal axis by power iteration
+        float axis[3] = {1.0f, 1.0f, 1.0f};
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            float m = std::max({std::abs(x), std::abs(y), std::abs(z)});
+            if (m < 1e-6f) break;
+            axis[0] = x / m;
+            axis[1] = y / m;
+            axis[2] = z / m;
+        }
+
+        float length = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        for (auto& a : axis) a /= length;
+
+        float minT = 0.0f, maxT = 0.0f;
+        for (auto& p : block)
+        {
+            float t = (p[0] - mean[0]) * axis[0] + (p[1] - mean[1]) * axis[1] + (p[2] - mean[2]) * axis[2];
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+
+        // inset the endpoints slightly, reducing the error of the pixels between the extremes
+        float inset = (maxT - minT) / 16.0f;
+        minT += inset;
+        maxT -= inset;
+
+        float c0[3], c1[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            c0[c] = mean[c] + axis[c] * maxT;
+            c1[c] = mean[c] + axis[c] * minT;
+        }
+
+        uint16_t e0 = packRGB565(c0);
+        uint16_t e1 = packRGB565(c1);
+        if (e0 < e1) std::swap(e0, e1);
+
+        uint32_t indices = 0;
+        if (e0 != e1)
+        {
+            // e0 > e1 selects the four color mode
+            int palette[4][3];
+            unpackRGB565(e0, palette[0]);
+            unpackRGB565(e1, palette[1]);
+            for (int c = 0; c < 3; ++c)
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+            }
+
+            for (int i = 0; i < 16; ++i)
+            {
+                int bestIndex = 0;
+                int bestError = INT_MAX;
+                for (int j = 0; j < 4; ++j)
+                {
+                    int error = square(block[i][0] - palette[j][0]) + square(block[i][1] - palette[j][1]) + square(block[i][2] - palette[j][2]);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = j;
+                    }
+                }
+                indices |= static_cast<uint32_t>(bestIndex) << (2 * i);
+            }
+        }
+
+        out[0] = static_cast<uint8_t>(e0 & 0xff);
+        out[1] = static_cast<uint8_t>(e0 >> 8);
+        out[2] = static_cast<uint8_t>(e1 & 0xff);
+        out[3] = static_cast<uint8_t>(e1 >> 8);
+        for (int b = 0; b < 4; ++b) out[4 + b] = static_cast<uint8_t>(indices >> (8 * b));
+    }
+
+    //
+    // BC4 single channel block, used for the alpha of BC3 and the channels of BC4/BC5
+    //
+    void encodeBC4(const uint8_t values[16], uint8_t* out)
+    {
+        int minValue = *std::min_element(values, values + 16);
+        int maxValue = *std::max_element(values, values + 16);
+
+        uint64_t bits = 0;
+        if (maxValue > minValue)
+        {
+            // a0 > a1 selects the eight value mode
+            int palette[8];
+            palette[0] = maxValue;
+            palette[1] = minValue;
+            for (int i = 1; i < 7; ++i) palette[i + 1] = ((7 - i) * maxValue + i * minValue + 3) / 7;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                int bestIndex = 0;
+                int bestError = INT_MAX;
+                for (int j = 0; j < 8; ++j)
+                {
+                    int error = std::abs(values[i] - palette[j]);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = j;
+                    }
+                }
+                bits |= static_cast<uint64_t>(bestIndex) << (3 * i);
+            }
+        }
+
+        out[0] = static_cast<uint8_t>(maxValue);
+        out[1] = static_cast<uint8_t>(minValue);
+        for (int b = 0; b < 6; ++b) out[2 + b] = static_cast<uint8_t>(bits >> (8 * b));
+    }
+
+    //
+    // ETC1 block, a valid ETC2 RGB block, using the individual and differential modes
+    //
+    const int s_etcModifiers[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+    /// find the modifier table with the lowest error for the 8 pixels of a sub block, returning the error
+    int fitETCSubblock(const Block& block, const int pixels[8], const int base[3], int& bestTable, int selectors[8])
+    {
+        int bestError = INT_MAX;
+        for (int table = 0; table < 8; ++table)
+        {
+            int error = 0;
+            int tableSelectors[8];
+            for (int p = 0; p < 8 && error < bestError; ++p)
+            {
+                const auto& pixel = block[pixels[p]];
+                int bestPixelError = INT_MAX;
+                for (int selector = 0; selector < 4; ++selector)
+                {
+                    // selector 0 and 1 are the small and large positive modifiers, 2 and 3 the negative ones.
+                    int modifier = (selector & 2) ? -s_etcModifiers[table][selector & 1] : s_etcModifiers[table][selector & 1];
+                    int pixelError = square(clamp255(base[0] + modifier) - pixel[0]) + square(clamp255(base[1] + modifier) - pixel[1]) + square(clamp255(base[2] + modifier) - pixel[2]);
+                    if (pixelError < bestPixelError)
+                    {
+                        bestPixelError = pixelError;
+                        tableSelectors[p] = selector;
+                    }
+                }
+                error += bestPixelError;
+            }
+
+            if (error < bestError)
+            {
+                bestError = error;
+                bestTable = table;
+                std::copy_n(tableSelectors, 8, selectors);
+            }
+        }
+        return bestError;
+    }
+
+    void encodeETC1(const Block& block, uint8_t* out)
+    {
+        uint64_t bestWord = 0;
+        int64_t bestError = INT64_MAX;
+
+        for (int flip = 0; flip < 2; ++flip)
+        {
+            // flip == 0 has 2x4 sub blocks side by side, flip == 1 has 4x2 sub blocks one above the other.
+            int pixels[2][8];
+            int count[2] = {0, 0};
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    int subblock = flip ? (y >= 2) : (x >= 2);
+                    pixels[subblock][count[subblock]++] = y * 4 + x;
+                }
+            }
+
+            float average[2][3];
+            for (int s = 0; s < 2; ++s)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    int sum = 0;
+                    for (int p = 0; p < 8; ++p) sum += block[pixels[s][p]][c];
+                    average[s][c] = static_cast<float>(sum) / 8.0f;
+                }
+            }
+
+            for (int differential = 1; differential >= 0; --differential)
+            {
+                int quantized[2][3];
+                int base[2][3];
+                bool valid = true;
+                for (int s = 0; s < 2; ++s)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        if (differential)
+                        {
+                            quantized[s][c] = std::clamp(static_cast<int>(std::lround(average[s][c] * 31.0f / 255.0f)), 0, 31);
+                            base[s][c] = (quantized[s][c] << 3) | (quantized[s][c] >> 2);
+                        }
+                        else
+                        {
+                            quantized[s][c] = std::clamp(static_cast<int>(std::lround(average[s][c] * 15.0f / 255.0f)), 0, 15);
+                            base[s][c] = quantized[s][c] * 17;
+                        }
+                    }
+                }
+
+                if (differential)
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        int delta = quantized[1][c] - quantized[0][c];
+                        if (delta < -4 || delta > 3) valid = false;
+                    }
+                    if (!valid) continue;
+                }
+
+                int tables[2] = {0, 0};
+                int selectors[2][8];
+                int64_t error = fitETCSubblock(block, pixels[0], base[0], tables[0], selectors[0]);
+                error += fitETCSubblock(block, pixels[1], base[1], tables[1], selectors[1]);
+                if (error >= bestError) continue;
+
+                uint64_t word = 0;
+                if (differential)
+                {
+                    word |= static_cast<uint64_t>(quantized[0][0]) << 59;
+                    word |= static_cast<uint64_t>((quantized[1][0] - quantized[0][0]) & 7) << 56;
+                    word |= static_cast<uint64_t>(quantized[0][1]) << 51;
+                    word |= static_cast<uint64_t>((quantized[1][1] - quantized[0][1]) & 7) << 48;
+                    word |= static_cast<uint64_t>(quantized[0][2]) << 43;
+                    word |= static_cast<uint64_t>((quantized[1][2] - quantized[0][2]) & 7) << 40;
+                }
+                else
+                {
+                    word |= static_cast<uint64_t>(quantized[0][0]) << 60;
+                    word |= static_cast<uint64_t>(quantized[1][0]) << 56;
+                    word |= static_cast<uint64_t>(quantized[0][1]) << 52;
+                    word |= static_cast<uint64_t>(quantized[1][1]) << 48;
+                    word |= static_cast<uint64_t>(quantized[0][2]) << 44;
+                    word |= static_cast<uint64_t>(quantized[1][2]) << 40;
+                }
+                word |= static_cast<uint64_t>(tables[0]) << 37;
+                word |= static_cast<uint64_t>(tables[1]) << 34;
+                word |= static_cast<uint64_t>(differential) << 33;
+                word |= static_cast<uint64_t>(flip) << 32;
+
+                // pixel selectors are ordered in columns, with the most significant bits of all the selectors before the least significant bits.
+                for (int s = 0; s < 2; ++s)
+                {
+                    for (int p = 0; p < 8; ++p)
+                    {
+                        int x = pixels[s][p] % 4;
+                        int y = pixels[s][p] / 4;
+                        int bit = x * 4 + y;
+                        word |= static_cast<uint64_t>(selectors[s][p] >> 1) << (16 + bit);
+                        word |= static_cast<uint64_t>(selectors[s][p] & 1) << bit;
+                    }
+                }
+
+                bestError = error;
+                bestWord = word;
+            }
+        }
+
+        for (int b = 0; b < 8; ++b) out[b] = static_cast<uint8_t>(bestWord >> (56 - 8 * b));
+    }
+
+    //
+    // EAC single channel block, used for the alpha of ETC2 RGBA and the channels of EAC R11/RG11
+    //
+    const int s_eacModifiers[16][8] = {
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+    void encodeEAC(const uint8_t values[16], uint8_t* out)
+    {
+        int minValue = *std::min_element(values, values + 16);
+        int maxValue = *std::max_element(values, values + 16);
+
+        // table 13 has a zero modifier so represents uniform values exactly
+        int bestBase = minValue, bestMultiplier = 1, bestTable = 13;
+        int bestSelectors[16];
+        std::fill_n(bestSelectors, 16, 4);
+
+        if (maxValue > minValue)
+        {
+            int bestError = INT_MAX;
+            for (int table = 0; table < 16; ++table)
+            {
+                const auto& modifiers = s_eacModifiers[table];
+                int span = modifiers[7] - modifiers[3];
+                int estimate = std::clamp(static_cast<int>(std::lround(static_cast<float>(maxValue - minValue) / static_cast<float>(span))), 1, 15);
+                for (int multiplier = std::max(estimate - 1, 1); multiplier <= std::min(estimate + 1, 15); ++multiplier)
+                {
+                    int centre = static_cast<int>(std::lround(0.5f * static_cast<float>(minValue + maxValue - (modifiers[3] + modifiers[7]) * multiplier)));
+                    for (int base = std::max(centre - 1, 0); base <= std::min(centre + 1, 255); ++base)
+                    {
+                        int error = 0;
+                        int selectors[16];
+                        for (int i = 0; i < 16 && error < bestError; ++i)
+                        {
+                            int bestPixelError = INT_MAX;
+                            for (int j = 0; j < 8; ++j)
+                            {
+                                int pixelError = square(clamp255(base + modifiers[j] * multiplier) - values[i]);
+                                if (pixelError < bestPixelError)
+                                {
+                                    bestPixelError = pixelError;
+                                    selectors[i] = j;
+                                }
+                            }
+                            error += bestPixelError;
+                        }
+
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            bestBase = base;
+                            bestMultiplier = multiplier;
+                            bestTable = table;
+                            std::copy_n(selectors, 16, bestSelectors);
+                        }
+                    }
+                }
+            }
+        }
+
+        uint64_t word = static_cast<uint64_t>(bestBase) << 56;
+        word |= static_cast<uint64_t>(bestMultiplier) << 52;
+        word |= static_cast<uint64_t>(bestTable) << 48;
+
+        // pixel selectors are ordered in columns, the first pixel in the most significant bits
+        for (int i = 0; i < 16; ++i)
+        {
+            int x = i % 4;
+            int y = i / 4;
+            word |= static_cast<uint64_t>(bestSelectors[i]) << (45 - 3 * (x * 4 + y));
+        }
+
+        for (int b = 0; b < 8; ++b) out[b] = static_cast<uint8_t>(word >> (56 - 8 * b));
+    }
+
+    /// encode the 4x4 block of pixels to the specified block compressed format
+    void encodeBlock(VkFormat format, const Block& block, uint8_t* out)
+    {
+        uint8_t values[16];
+        switch (format)
+        {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+            encodeBC1(block, out);
+            break;
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+            extractChannel(block, 3, values);
+            encodeBC4(values, out);
+            encodeBC1(block, out + 8);
+            break;
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+            extractChannel(block, 0, values);
+            encodeBC4(values, out);
+            break;
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+            extractChannel(block, 0, values);
+            encodeBC4(values, out);
+            extractChannel(block, 1, values);
+            encodeBC4(values, out + 8);
+            break;
+        case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+            encodeETC1(block, out);
+            break;
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+            extractChannel(block, 3, values);
+            encodeEAC(values, out);
+            encodeETC1(block, out + 8);
+            break;
+        case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+            extractChannel(block, 0, values);
+            encodeEAC(values, out);
+            break;
+        case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+            extractChannel(block, 0, values);
+            encodeEAC(values, out);
+            extractChannel(block, 1, values);
+            encodeEAC(values, out + 8);
+            break;
+        default:
+            break;
+        }
+    }
+
+    size_t blockSize(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+        case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+            return 8;
+        default:
+            return 16;
+        }
+    }
+
+    /// source formats that can be compressed, along with the number of components and whether they are sRGB
+    struct SourceFormat
+    {
+        int numComponents = 0;
+        bool bgr = false;
+        bool srgb = false;
+    };
+
+    SourceFormat sourceFormat(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_R8_UNORM: return {1, false, false};
+        case VK_FORMAT_R8G8_UNORM: return {2, false, false};
+        case VK_FORMAT_R8G8B8_UNORM: return {3, false, false};
+        case VK_FORMAT_R8G8B8_SRGB: return {3, false, true};
+        case VK_FORMAT_B8G8R8_UNORM: return {3, true, false};
+        case VK_FORMAT_B8G8R8_SRGB: return {3, true, true};
+        case VK_FORMAT_R8G8B8A8_UNORM: return {4, false, false};
+        case VK_FORMAT_R8G8B8A8_SRGB: return {4, false, true};
+        case VK_FORMAT_B8G8R8A8_UNORM: return {4, true, false};
+        case VK_FORMAT_B8G8R8A8_SRGB: return {4, true, true};
+        default: return {};
+        }
+    }
+
+    /// copy a 2D image to an RGBA Image8, returning false if the image isn't a suitable 8 bit per component 2D image
+    bool convert(const Data& image, Image8& result)
+    {
+        auto source = sourceFormat(image.properties.format);
+        if (source.numComponents == 0 || image.dimensions() != 2 || image.properties.mipLevels > 1 || image.getMipmapLayout()) return false;
+        if (image.properties.imageViewType >= 0 && image.properties.imageViewType != VK_IMAGE_VIEW_TYPE_2D) return false;
+        if (image.stride() < static_cast<uint32_t>(source.numComponents)) return false;
+
+        result.width = image.width();
+        result.height = image.height();
+        result.rgba.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+        auto src = static_cast<const uint8_t*>(image.dataPointer());
+        auto dest = result.rgba.data();
+        size_t stride = image.stride();
+        size_t count = static_cast<size_t>(result.width) * result.height;
+        for (size_t i = 0; i < count; ++i, src += stride, dest += 4)
+        {
+            dest[0] = src[0];
+            dest[1] = source.numComponents > 1 ? src[1] : 0;
+            dest[2] = source.numComponents > 2 ? src[2] : 0;
+            dest[3] = source.numComponents > 3 ? src[3] : 255;
+            if (source.bgr) std::swap(dest[0], dest[2]);
+        }
+        return true;
+    }
+
+    bool hasTranslucentPixels(const Data& image)
+    {
+        if (sourceFormat(image.properties.format).numComponents < 4) return false;
+
+        auto src = static_cast<const uint8_t*>(image.dataPointer());
+        size_t stride = image.stride();
+        size_t count = static_cast<size_t>(image.width()) * image.height();
+        for (size_t i = 0; i < count; ++i, src += stride)
+        {
+            if (src[3] != 255) return true;
+        }
+        return false;
+    }
+
+    /// replace the ImageView of DescriptorImage with ones that reference compressed images
+    class CompressDescriptorImages : public Visitor
+    {
+    public:
+        explicit CompressDescriptorImages(const CompressTextures& in_compressTextures) :
+            compressTextures(in_compressTextures) {}
+
+        const CompressTextures& compressTextures;
+        std::set<const Object*> visited;
+        std::map<const ImageView*, ref_ptr<ImageView>> replacements;
+
+        void apply(Object& object) override
+        {
+            if (visited.insert(&object).second) object.traverse(*this);
+        }
+
+        void apply(DescriptorImage& descriptorImage) override
+        {
+            for (auto& imageInfo : descriptorImage.imageInfoList)
+            {
+                if (!imageInfo || !imageInfo->imageView) continue;
+
+                auto itr = replacements.find(imageInfo->imageView.get());
+                if (itr == replacements.end())
+                {
+                    ref_ptr<ImageView> replacement;
+                    const auto& image = imageInfo->imageView->image;
+                    if (image && image->data)
+                    {
+                        // block compressed images can't have their mipmaps generated on the GPU so generate all the levels the Sampler requires
+                        auto mipLevels = computeNumMipMapLevels(image->data, imageInfo->sampler);
+                        if (auto compressed = compressTextures.compress(*image->data, mipLevels))
+                        {
+                            auto compressedImage = Image::create(compressed);
+                            compressedImage->usage = image->usage;
+                            replacement = ImageView::create(compressedImage);
+                        }
+                    }
+                    itr = replacements.emplace(imageInfo->imageView.get(), replacement).first;
+                }
+
+                if (itr->second) imageInfo->imageView = itr->second;
+            }
+        }
+    };
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// CompressTextures
+//
+CompressTextures::CompressTextures()
+{
+}
+
+CompressTextures::CompressTextures(const PhysicalDevice* physicalDevice)
+{
+    if (physicalDevice)
+    {
+        const auto& features = physicalDevice->getFeatures();
+        supportsBC = features.textureCompressionBC == VK_TRUE;
+        supportsETC2 = features.textureCompressionETC2 == VK_TRUE;
+    }
+}
+
+CompressTextures::~CompressTextures()
+{
+}
+
+VkFormat CompressTextures::selectFormat(const Data& image) const
+{
+    auto source = sourceFormat(image.properties.format);
+    if (source.numComponents == 0 || (!supportsBC && !supportsETC2)) return VK_FORMAT_UNDEFINED;
+    if (image.dimensions() != 2 || image.width() < minimumDimension || image.height() < minimumDimension) return VK_FORMAT_UNDEFINED;
+
+    switch (source.numComponents)
+    {
+    case 1:
+        return supportsBC ? VK_FORMAT_BC4_UNORM_BLOCK : VK_FORMAT_EAC_R11_UNORM_BLOCK;
+    case 2:
+        return supportsBC ? VK_FORMAT_BC5_UNORM_BLOCK : VK_FORMAT_EAC_R11G11_UNORM_BLOCK;
+    default:
+        if (hasTranslucentPixels(image))
+        {
+            if (supportsBC) return source.srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+            return source.srgb ? VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK;
+        }
+        if (supportsBC) return source.srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+        return source.srgb ? VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK : VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
+    }
+}
+
+ref_ptr<Data> CompressTextures::compress(const Data& image, uint32_t mipLevels) const
+{
+    auto format = selectFormat(image);
+    if (format == VK_FORMAT_UNDEFINED) return {};
+
+    Image8 level;
+    if (!convert(image, level)) return {};
+
+    uint32_t maxMipLevels = 1;
+    while ((1u << maxMipLevels) <= std::max(level.width, level.height)) ++maxMipLevels;
+    mipLevels = std::clamp(mipLevels, 1u, std::min(maxMipLevels, 255u));
+
+    // compute the layout of the mipmap levels, recording the pixel dimensions as the image sizes needn't be a multiple of the block size.
+    auto mipmapLayout = MipmapLayout::create(mipLevels);
+    size_t numBlocks = 0;
+    for (uint32_t i = 0, w = level.width, h = level.height; i < mipLevels; ++i)
+    {
+        mipmapLayout->set(i, uivec4(w, h, 1, static_cast<uint32_t>(numBlocks * blockSize(format))));
+        numBlocks += static_cast<size_t>((w + 3) / 4) * ((h + 3) / 4);
+        w = std::max(w / 2, 1u);
+        h = std::max(h / 2, 1u);
+    }
+
+    Data::Properties properties;
+    properties.format = format;
+    properties.blockWidth = 4;
+    properties.blockHeight = 4;
+    properties.mipLevels = static_cast<uint8_t>(mipLevels);
+    properties.imageViewType = image.properties.imageViewType;
+    properties.origin = image.properties.origin;
+    properties.allocatorType = ALLOCATOR_TYPE_NEW_DELETE;
+
+    uint32_t widthInBlocks = (level.width + 3) / 4;
+    uint32_t heightInBlocks = (level.height + 3) / 4;
+
+    ref_ptr<Data> compressed;
+    uint8_t* dest = nullptr;
+    if (blockSize(format) == 8)
+    {
+        auto blocks = new block64[numBlocks];
+        dest = blocks[0].value;
+        compressed = block64Array2D::create(widthInBlocks, heightInBlocks, blocks, properties, mipmapLayout.get());
+    }
+    else
+    {
+        auto blocks = new block128[numBlocks];
+        dest = blocks[0].value;
+        compressed = block128Array2D::create(widthInBlocks, heightInBlocks, blocks, properties, mipmapLayout.get());
+    }
+
+    Block block;
+    for (uint32_t i = 0; i < mipLevels; ++i)
+    {
+        if (i > 0) level = downsample(level);
+
+        for (uint32_t by = 0; by < (level.height + 3) / 4; ++by)
+        {
+            for (uint32_t bx = 0; bx < (level.width + 3) / 4; ++bx)
+            {
+                extractBlock(level, bx, by, block);
+                encodeBlock(format, block, dest);
+                dest += blockSize(format);
+            }
+        }
+    }
+
+    compressed->dirty();
+    return compressed;
+}
+
+void CompressTextures::apply(Object& object) const
+{
+    CompressDescriptorImages compressDescriptorImages(*this);
+    object.accept(compressDescriptorImages);
+}
+
+void CompressTextures::read(Input& input)
+{
+    Object::read(input);
+
+    input.read("supportsBC", supportsBC);
+    input.read("supportsETC2", supportsETC2);
+    input.read("minimumDimension", minimumDimension);
+}
+
+void CompressTextures::write(Output& output) const
+{
+    Object::write(output);
+
+    output.write("supportsBC", supportsBC);
+    output.write("supportsETC2", supportsETC2);
+    output.write("minimumDimension", minimumDimension);
+}
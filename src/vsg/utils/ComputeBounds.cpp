@@ -16,6 +16,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/commands/Draw.h>
 #include <vsg/commands/DrawIndexed.h>
 #include <vsg/io/Logger.h>
+#include <vsg/maths/simd.h>
+#include <vsg/maths/transform.h>
 #include <vsg/nodes/CullGroup.h>
 #include <vsg/nodes/CullNode.h>
 #include <vsg/nodes/Geometry.h>
@@ -24,24 +26,256 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/InstanceNode.h>
 #include <vsg/nodes/LOD.h>
 #include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/PackedDraws.h>
+#include <vsg/nodes/PackedSubgraph.h>
 #include <vsg/nodes/PagedLOD.h>
 #include <vsg/nodes/StateGroup.h>
 #include <vsg/nodes/VertexDraw.h>
 #include <vsg/nodes/VertexIndexDraw.h>
 #include <vsg/text/Text.h>
 #include <vsg/text/TextGroup.h>
+#include <vsg/threading/Latch.h>
+#include <vsg/utils/ChangeTracker.h>
 #include <vsg/utils/ComputeBounds.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace vsg;
 
-ComputeBounds::ComputeBounds(ref_ptr<ArrayState> intialArrayState)
+namespace
 {
+    // compute the bounds of count vertices transformed by matrix, the SIMD paths use the same multiply/add ordering and perspective divide as dmat4 * dvec3
+    // with min/max that ignore NaN in the same way as dbox::add(..), so give the same bounds as adding each transformed vertex in turn.
+    dbox transformedBounds(const dmat4& matrix, const vec3* vertices, uint32_t count)
+    {
+        dbox bb;
+        if (count == 0) return bb;
+
+        bool affine = (matrix[0][3] == 0.0 && matrix[1][3] == 0.0 && matrix[2][3] == 0.0 && matrix[3][3] == 1.0);
+
+#if defined(VSG_SIMD_AVX)
+        const __m256d c0 = _mm256_loadu_pd(matrix[0].data());
+        const __m256d c1 = _mm256_loadu_pd(matrix[1].data());
+        const __m256d c2 = _mm256_loadu_pd(matrix[2].data());
+        const __m256d c3 = _mm256_loadu_pd(matrix[3].data());
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d lower = _mm256_set1_pd(bb.min.x);
+        __m256d upper = _mm256_set1_pd(bb.max.x);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const vec3& v = vertices[i];
+            __m256d p = _mm256_mul_pd(c0, _mm256_set1_pd(v.x));
+            p = _mm256_add_pd(p, _mm256_mul_pd(c1, _mm256_set1_pd(v.y)));
+            p = _mm256_add_pd(p, _mm256_mul_pd(c2, _mm256_set1_pd(v.z)));
+            p = _mm256_add_pd(p, c3);
+            if (!affine)
+            {
+                // broadcast w and multiply by its reciprocal
+                __m256d w = _mm256_permute_pd(_mm256_permute2f128_pd(p, p, 0x11), 0xF);
+                p = _mm256_mul_pd(p, _mm256_div_pd(one, w));
+            }
+            lower = _mm256_min_pd(p, lower);
+            upper = _mm256_max_pd(p, upper);
+        }
+        alignas(32) double l[4], u[4];
+        _mm256_store_pd(l, lower);
+        _mm256_store_pd(u, upper);
+        bb.min.set(l[0], l[1], l[2]);
+        bb.max.set(u[0], u[1], u[2]);
+#elif defined(VSG_SIMD_SSE2)
+        const __m128d c0_xy = _mm_loadu_pd(matrix[0].data()), c0_zw = _mm_loadu_pd(matrix[0].data() + 2);
+        const __m128d c1_xy = _mm_loadu_pd(matrix[1].data()), c1_zw = _mm_loadu_pd(matrix[1].data() + 2);
+        const __m128d c2_xy = _mm_loadu_pd(matrix[2].data()), c2_zw = _mm_loadu_pd(matrix[2].data() + 2);
+        const __m128d c3_xy = _mm_loadu_pd(matrix[3].data()), c3_zw = _mm_loadu_pd(matrix[3].data() + 2);
+        const __m128d one = _mm_set1_pd(1.0);
+        __m128d lower_xy = _mm_set1_pd(bb.min.x), lower_zw = lower_xy;
+        __m128d upper_xy = _mm_set1_pd(bb.max.x), upper_zw = upper_xy;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const vec3& v = vertices[i];
+            const __m128d x = _mm_set1_pd(v.x), y = _mm_set1_pd(v.y), z = _mm_set1_pd(v.z);
+            __m128d xy = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0_xy, x), _mm_mul_pd(c1_xy, y)), _mm_mul_pd(c2_xy, z)), c3_xy);
+            __m128d zw = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0_zw, x), _mm_mul_pd(c1_zw, y)), _mm_mul_pd(c2_zw, z)), c3_zw);
+            if (!affine)
+            {
+                __m128d inv = _mm_div_pd(one, _mm_unpackhi_pd(zw, zw));
+                xy = _mm_mul_pd(xy, inv);
+                zw = _mm_mul_pd(zw, inv);
+            }
+            lower_xy = _mm_min_pd(xy, lower_xy);
+            lower_zw = _mm_min_pd(zw, lower_zw);
+            upper_xy = _mm_max_pd(xy, upper_xy);
+            upper_zw = _mm_max_pd(zw, upper_zw);
+        }
+        alignas(16) double l[4], u[4];
+        _mm_store_pd(l, lower_xy);
+        _mm_store_pd(l + 2, lower_zw);
+        _mm_store_pd(u, upper_xy);
+        _mm_store_pd(u + 2, upper_zw);
+        bb.min.set(l[0], l[1], l[2]);
+        bb.max.set(u[0], u[1], u[2]);
+#else
+        constexpr uint32_t batchSize = 256;
+        dvec3 transformed[batchSize];
+        for (uint32_t base = 0; base < count; base += batchSize)
+        {
+            uint32_t n = std::min(count - base, batchSize);
+            vsg::transform(matrix, vertices + base, transformed, n);
+            for (uint32_t j = 0; j < n; ++j) bb.add(transformed[j]);
+        }
+#endif
+        return bb;
+    }
+
+    // compute the bounds of the vertices returned by vertex(i), gathering them into batches for transformedBounds(..)
+    template<typename F>
+    dbox transformedBounds(const dmat4& matrix, uint32_t count, F vertex)
+    {
+        constexpr uint32_t batchSize = 256;
+        vec3 gathered[batchSize];
+        dbox bb;
+        for (uint32_t base = 0; base < count; base += batchSize)
+        {
+            uint32_t n = std::min(count - base, batchSize);
+            for (uint32_t j = 0; j < n; ++j) gathered[j] = vertex(base + j);
+            bb.add(transformedBounds(matrix, gathered, n));
+        }
+        return bb;
+    }
+
+    // split [0, count) into ranges that are bounded by rangeBounds(begin, end) on the operationThreads and the calling thread.
+    template<typename F>
+    dbox parallelBounds(OperationThreads* operationThreads, uint32_t parallelThreshold, uint32_t count, F rangeBounds)
+    {
+        size_t numThreads = operationThreads ? operationThreads->threads.size() : 0;
+        if (numThreads == 0 || count < parallelThreshold || count < 2) return rangeBounds(0, count);
+
+        uint32_t numRanges = static_cast<uint32_t>(std::min(numThreads + 1, static_cast<size_t>(count / std::max(parallelThreshold / 2, 1u))));
+        if (numRanges < 2) return rangeBounds(0, count);
+
+        struct BoundsOperation : public Inherit<Operation, BoundsOperation>
+        {
+            BoundsOperation(F& in_rangeBounds, uint32_t in_begin, uint32_t in_end, dbox& in_result, Latch* in_latch) :
+                rangeBounds(in_rangeBounds), begin(in_begin), end(in_end), result(in_result), latch(in_latch) {}
+
+            F& rangeBounds;
+            uint32_t begin, end;
+            dbox& result;
+            Latch* latch;
+
+            void run() override
+            {
+                result = rangeBounds(begin, end);
+                latch->count_down();
+            }
+        };
+
+        std::vector<dbox> results(numRanges);
+        auto latch = Latch::create(static_cast<int>(numRanges - 1));
+        uint32_t rangeSize = (count + numRanges - 1) / numRanges;
+        for (uint32_t r = 1; r < numRanges; ++r)
+        {
+            uint32_t begin = std::min(r * rangeSize, count);
+            uint32_t end = std::min(begin + rangeSize, count);
+            operationThreads->add(BoundsOperation::create(rangeBounds, begin, end, results[r], latch.get()));
+        }
+
+        results[0] = rangeBounds(0, std::min(rangeSize, count));
+        latch->wait();
+
+        dbox bb;
+        for (auto& result : results) bb.add(result);
+        return bb;
+    }
+
+    // compute the bounds that func() adds to computeBounds in the local coordinate frame of the current node.
+    template<typename F>
+    dbox localBounds(ComputeBounds& computeBounds, F func)
+    {
+        dbox bb;
+        ComputeBounds::MatrixStack matrixStack;
+        std::swap(bb, computeBounds.bounds);
+        std::swap(matrixStack, computeBounds.matrixStack);
+
+        func();
+
+        std::swap(bb, computeBounds.bounds);
+        std::swap(matrixStack, computeBounds.matrixStack);
+        return bb;
+    }
+
+    // the key used to check CachedBounds, proxy vertex arrays are keyed by the Data they adapt.
+    const Data* cacheKey(const vec3Array* vertices)
+    {
+        if (!vertices) return nullptr;
+        return vertices->storage() ? vertices->storage() : vertices;
+    }
+} // namespace
+
+namespace
+{
+    // the apply(..) overridden by ComputeBounds, derived classes before their base classes
+    const ConstVisitorDispatcher::Registrations& computeBoundsRegistrations()
+    {
+        using D = ConstVisitorDispatcher;
+        static const D::Registrations s_registrations{
+            D::registration<StateGroup>(),
+            D::registration<MatrixTransform>(),
+            D::registration<Transform>(),
+            D::registration<CullNode>(),
+            D::registration<CullGroup>(),
+            D::registration<PackedSubgraph>(),
+            D::registration<PackedDraws>(),
+            D::registration<LOD>(),
+            D::registration<PagedLOD>(),
+            D::registration<Geometry>(),
+            D::registration<VertexDraw>(),
+            D::registration<VertexIndexDraw>(),
+            D::registration<InstanceNode>(),
+            D::registration<InstanceDraw>(),
+            D::registration<InstanceDrawIndexed>(),
+            D::registration<BindVertexBuffers>(),
+            D::registration<BindIndexBuffer>(),
+            D::registration<StateCommand>(),
+            D::registration<Draw>(),
+            D::registration<DrawIndexed>(),
+            D::registration<Text>(),
+            D::registration<TextGroup>(),
+            D::registration<TextTechnique>(),
+            D::registration<BufferInfo>(),
+            D::registration<ushortArray>(),
+            D::registration<uintArray>(),
+            D::registration<Object>()};
+        return s_registrations;
+    }
+} // namespace
+
+ComputeBounds::ComputeBounds(ref_ptr<ArrayState> intialArrayState) :
+    _dispatcher(computeBoundsRegistrations(), typeid(ComputeBounds))
+{
+    dispatcher = &_dispatcher;
+
     arrayStateStack.reserve(4);
     arrayStateStack.emplace_back(intialArrayState ? intialArrayState : ArrayState::create());
 }
 
 void ComputeBounds::apply(const vsg::Object& object)
 {
+    if (useChangeRecords && object.is_compatible(typeid(Node)) && _useCachedBounds())
+    {
+        if (auto changeRecord = ChangeTracker::getRecord(&object))
+        {
+            if (!changeRecord->boundsValid)
+            {
+                changeRecord->bounds = localBounds(*this, [&]() { object.traverse(*this); });
+                changeRecord->boundsValid = true;
+            }
+            if (changeRecord->bounds.valid()) add(changeRecord->bounds);
+            return;
+        }
+    }
+
     object.traverse(*this);
 }
 
@@ -54,7 +288,7 @@ void ComputeBounds::apply(const StateGroup& stategroup)
         statecommand->accept(*arrayState);
     }
 
-    arrayStateStack.emplace_back(arrayState);
+    arrayStateStack.emplace_back(std::move(arrayState));
 
     stategroup.traverse(*this);
 
@@ -101,6 +335,68 @@ void ComputeBounds::apply(const CullGroup& cullGroup)
         cullGroup.traverse(*this);
 }
 
+void ComputeBounds::apply(const PackedSubgraph& packedSubgraph)
+{
+    if (useNodeBounds)
+    {
+        // unbounded draws, such as state binding commands, don't contribute to the bounds
+        for (const auto& bound : packedSubgraph.bounds)
+        {
+            if (bound.radius < std::numeric_limits<double>::max()) add(bound);
+        }
+        return;
+    }
+
+    size_t count = std::min(packedSubgraph.draws.size(), packedSubgraph.transformIndices.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& transform = packedSubgraph.transforms[packedSubgraph.transformIndices[i]];
+        if (matrixStack.empty())
+            matrixStack.push_back(transform);
+        else
+            matrixStack.push_back(matrixStack.back() * transform);
+
+        packedSubgraph.draws[i]->accept(*this);
+
+        matrixStack.pop_back();
+    }
+}
+
+void ComputeBounds::apply(const PackedDraws& packedDraws)
+{
+    size_t count = packedDraws.numDraws();
+
+    if (useNodeBounds)
+    {
+        for (size_t i = 0; i < count; ++i) add(dsphere(packedDraws.bounds[i]));
+        return;
+    }
+
+    if (!packedDraws.bindVertexBuffers || !packedDraws.bindIndexBuffer || !packedDraws.bindIndexBuffer->indices) return;
+
+    packedDraws.bindIndexBuffer->indices->accept(*this);
+
+    // ArrayState for each of the state sets, created when the first draw using it is visited
+    std::vector<ref_ptr<ArrayState>> arrayStates(packedDraws.stateSets.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t stateIndex = packedDraws.stateIndices[i];
+        if (stateIndex >= arrayStates.size()) continue;
+
+        auto& arrayState = arrayStates[stateIndex];
+        if (!arrayState)
+        {
+            arrayState = arrayStateStack.back()->cloneArrayState();
+            for (auto& stateCommand : packedDraws.stateSets[stateIndex]) stateCommand->accept(*arrayState);
+            arrayState->apply(*packedDraws.bindVertexBuffers);
+        }
+
+        arrayStateStack.push_back(arrayState);
+        applyDrawIndexed(packedDraws.firstIndices[i], packedDraws.indexCounts[i], 0, 0, 1);
+        arrayStateStack.pop_back();
+    }
+}
+
 void ComputeBounds::apply(const LOD& lod)
 {
     if (useNodeBounds && lod.bound.valid())
@@ -117,6 +413,19 @@ void ComputeBounds::apply(const PagedLOD& plod)
         plod.traverse(*this);
 }
 
+bool ComputeBounds::_useCachedBounds() const
+{
+    if (!useCachedBounds || typeid(*arrayStateStack.back()) != typeid(ArrayState)) return false;
+    if (useNodeBounds || matrixStack.empty()) return true;
+
+    // transforming the cached box is only exact when the matrix contains no rotation, shear or perspective
+    const auto& m = matrixStack.back();
+    return m[0][1] == 0.0 && m[0][2] == 0.0 && m[0][3] == 0.0 &&
+           m[1][0] == 0.0 && m[1][2] == 0.0 && m[1][3] == 0.0 &&
+           m[2][0] == 0.0 && m[2][1] == 0.0 && m[2][3] == 0.0 &&
+           m[3][3] == 1.0;
+}
+
 void ComputeBounds::apply(const vsg::Geometry& geometry)
 {
     auto& arrayState = *arrayStateStack.back();
@@ -124,9 +433,29 @@ void ComputeBounds::apply(const vsg::Geometry& geometry)
 
     if (geometry.indices) geometry.indices->accept(*this);
 
-    for (auto& command : geometry.commands)
+    auto traverseCommands = [&]() {
+        for (auto& command : geometry.commands)
+        {
+            command->accept(*this);
+        }
+    };
+
+    if (_useCachedBounds())
     {
-        command->accept(*this);
+        const Data* vertices = cacheKey(arrayState.vertices);
+        const Data* indices = geometry.indices ? geometry.indices->data.get() : nullptr;
+
+        dbox bb;
+        if (!geometry.cachedBounds.get(vertices, indices, bb))
+        {
+            bb = localBounds(*this, traverseCommands);
+            geometry.cachedBounds.set(vertices, indices, bb);
+        }
+        if (bb.valid()) add(bb);
+    }
+    else
+    {
+        traverseCommands();
     }
 }
 
@@ -145,7 +474,23 @@ void ComputeBounds::apply(const vsg::VertexIndexDraw& vid)
 
     if (vid.indices) vid.indices->accept(*this);
 
-    applyDrawIndexed(vid.firstIndex, vid.indexCount, vid.firstInstance, vid.vertexOffset, vid.instanceCount);
+    if (_useCachedBounds())
+    {
+        const Data* vertices = cacheKey(arrayState.vertices);
+        const Data* indices = vid.indices ? vid.indices->data.get() : nullptr;
+
+        dbox bb;
+        if (!vid.cachedBounds.get(vertices, indices, bb))
+        {
+            bb = localBounds(*this, [&]() { applyDrawIndexed(vid.firstIndex, vid.indexCount, vid.firstInstance, vid.vertexOffset, vid.instanceCount); });
+            vid.cachedBounds.set(vertices, indices, bb);
+        }
+        if (bb.valid()) add(bb);
+    }
+    else
+    {
+        applyDrawIndexed(vid.firstIndex, vid.indexCount, vid.firstInstance, vid.vertexOffset, vid.instanceCount);
+    }
 }
 
 void ComputeBounds::apply(const vsg::InstanceNode& in)
@@ -226,7 +571,6 @@ void ComputeBounds::applyDraw(uint32_t firstVertex, uint32_t vertexCount, uint32
 {
     auto& arrayState = *arrayStateStack.back();
     uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
-    uint32_t endVertex = firstVertex + vertexCount;
     dmat4 matrix;
     if (!matrixStack.empty()) matrix = matrixStack.back();
 
@@ -234,9 +578,18 @@ void ComputeBounds::applyDraw(uint32_t firstVertex, uint32_t vertexCount, uint32
     {
         if (auto vertices = arrayState.vertexArray(instanceIndex))
         {
-            for (uint32_t i = firstVertex; i < endVertex; ++i)
+            const vec3Array& array = *vertices;
+            if (array.properties.stride == sizeof(vec3))
             {
-                bounds.add(matrix * dvec3(vertices->at(i)));
+                bounds.add(parallelBounds(operationThreads, parallelThreshold, vertexCount, [&](uint32_t begin, uint32_t end) {
+                    return transformedBounds(matrix, array.data(firstVertex + begin), end - begin);
+                }));
+            }
+            else
+            {
+                bounds.add(parallelBounds(operationThreads, parallelThreshold, vertexCount, [&](uint32_t begin, uint32_t end) {
+                    return transformedBounds(matrix, end - begin, [&](uint32_t j) { return array.at(firstVertex + begin + j); });
+                }));
             }
         }
     }
@@ -246,36 +599,26 @@ void ComputeBounds::applyDrawIndexed(uint32_t firstIndex, uint32_t indexCount, u
 {
     auto& arrayState = *arrayStateStack.back();
     uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
-    uint32_t endIndex = firstIndex + indexCount;
     dmat4 matrix;
     if (!matrixStack.empty()) matrix = matrixStack.back();
 
-    if (ushort_indices)
-    {
+    auto addIndexedBounds = [&](const auto& indices) {
         for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
         {
             if (auto vertices = arrayState.vertexArray(instanceIndex))
             {
-                for (uint32_t i = firstIndex; i < endIndex; ++i)
-                {
-                    bounds.add(matrix * dvec3(vertices->at(ushort_indices->at(i) + vertexOffset)));
-                }
+                const vec3Array& array = *vertices;
+                bounds.add(parallelBounds(operationThreads, parallelThreshold, indexCount, [&](uint32_t begin, uint32_t end) {
+                    return transformedBounds(matrix, end - begin, [&](uint32_t j) { return array.at(indices.at(firstIndex + begin + j) + vertexOffset); });
+                }));
             }
         }
-    }
+    };
+
+    if (ushort_indices)
+        addIndexedBounds(*ushort_indices);
     else if (uint_indices)
-    {
-        for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
-        {
-            if (auto vertices = arrayState.vertexArray(instanceIndex))
-            {
-                for (uint32_t i = firstIndex; i < endIndex; ++i)
-                {
-                    bounds.add(matrix * dvec3(vertices->at(uint_indices->at(i) + vertexOffset)));
-                }
-            }
-        }
-    }
+        addIndexedBounds(*uint_indices);
 }
 
 void ComputeBounds::apply(const Text& text)
@@ -31,6 +31,42 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 using namespace vsg;
 
+namespace
+{
+    // the apply(..) overridden by FindDynamicObjects, derived classes before their base classes
+    const ConstVisitorDispatcher::Registrations& findDynamicObjectsRegistrations()
+    {
+        using D = ConstVisitorDispatcher;
+        static const D::Registrations s_registrations{
+            D::registration<AnimationGroup>(),
+            D::registration<Animation>(),
+            D::registration<TransformSampler>(),
+            D::registration<MorphSampler>(),
+            D::registration<JointSampler>(),
+            D::registration<AnimationSampler>(),
+            D::registration<BufferInfo>(),
+            D::registration<Image>(),
+            D::registration<ImageView>(),
+            D::registration<ImageInfo>(),
+            D::registration<DescriptorBuffer>(),
+            D::registration<DescriptorImage>(),
+            D::registration<BindIndexBuffer>(),
+            D::registration<BindVertexBuffers>(),
+            D::registration<VertexDraw>(),
+            D::registration<VertexIndexDraw>(),
+            D::registration<Geometry>(),
+            D::registration<Data>(),
+            D::registration<Object>()};
+        return s_registrations;
+    }
+} // namespace
+
+FindDynamicObjects::FindDynamicObjects() :
+    _dispatcher(findDynamicObjectsRegistrations(), typeid(FindDynamicObjects))
+{
+    dispatcher = &_dispatcher;
+}
+
 void FindDynamicObjects::apply(const Object& object)
 {
     object.traverse(*this);
@@ -78,6 +114,7 @@ void FindDynamicObjects::apply(const JointSampler& sampler)
 {
     tag(&sampler);
     tag(sampler.jointMatrices);
+    tag(sampler.localMatrices);
     tag(sampler.subgraph);
     if (sampler.subgraph) sampler.subgraph->traverse(*this);
 }
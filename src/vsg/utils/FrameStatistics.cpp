@@ -0,0 +1,205 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/utils/FrameStatistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+using namespace vsg;
+
+FrameStatistics::FrameStatistics(uint32_t in_windowSize) :
+    windowSize(std::max(in_windowSize, 1u))
+{
+}
+
+void FrameStatistics::_push(Metric& metric, double value)
+{
+    if (metric.window.size() < windowSize)
+    {
+        metric.window.push_back(value);
+    }
+    else
+    {
+        metric.window[metric.next] = value;
+        metric.next = (metric.next + 1) % windowSize;
+    }
+}
+
+void FrameStatistics::increment(const std::string& name, double amount)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& metric = _metrics[name];
+    metric.type = COUNTER;
+    metric.current += amount;
+    metric.total += amount;
+    metric.updated = true;
+}
+
+void FrameStatistics::set(const std::string& name, double value)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& metric = _metrics[name];
+    metric.type = GAUGE;
+    metric.current = value;
+    metric.total = value;
+    metric.updated = true;
+}
+
+void FrameStatistics::sample(const std::string& name, double value)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& metric = _metrics[name];
+    metric.type = HISTOGRAM;
+    metric.total = value;
+    _push(metric, value);
+}
+
+void FrameStatistics::advanceFrame(uint64_t frameCount)
+{
+    Summaries results;
+    {
+        std::scoped_lock<std::mutex> lock(_mutex);
+
+        for (auto& [name, metric] : _metrics)
+        {
+            if (metric.type == COUNTER)
+            {
+                // counters not incremented in a frame record a zero for that frame
+                _push(metric, metric.current);
+                metric.current = 0.0;
+            }
+            else if (metric.type == GAUGE && metric.updated)
+            {
+                _push(metric, metric.current);
+            }
+            metric.updated = false;
+        }
+
+        if (exportInterval == 0 || exporters.empty() || (frameCount - _lastExportFrameCount) < exportInterval) return;
+        _lastExportFrameCount = frameCount;
+
+        results.resize(_metrics.size());
+        auto itr = results.begin();
+        for (auto& [name, metric] : _metrics)
+        {
+            _summarize(name, metric, *(itr++));
+        }
+    }
+
+    // call exporters without the mutex locked so they may query the FrameStatistics
+    for (auto& exporter : exporters)
+    {
+        exporter(frameCount, results);
+    }
+}
+
+void FrameStatistics::_summarize(const std::string& name, const Metric& metric, Summary& result) const
+{
+    result.name = name;
+    result.type = metric.type;
+    result.total = metric.total;
+    result.count = metric.window.size();
+
+    if (metric.window.empty())
+    {
+        result.min = result.max = result.mean = result.p50 = result.p95 = result.p99 = 0.0;
+        return;
+    }
+
+    auto sorted = metric.window;
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (auto value : sorted) sum += value;
+
+    // nearest rank percentile
+    auto percentile = [&](double p) {
+        auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+        return sorted[std::min(std::max(rank, size_t(1)), sorted.size()) - 1];
+    };
+
+    result.min = sorted.front();
+    result.max = sorted.back();
+    result.mean = sum / static_cast<double>(sorted.size());
+    result.p50 = percentile(0.5);
+    result.p95 = percentile(0.95);
+    result.p99 = percentile(0.99);
+}
+
+FrameStatistics::Summaries FrameStatistics::summaries() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    Summaries results(_metrics.size());
+    auto itr = results.begin();
+    for (auto& [name, metric] : _metrics)
+    {
+        _summarize(name, metric, *(itr++));
+    }
+    return results;
+}
+
+bool FrameStatistics::summary(const std::string& name, Summary& result) const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto itr = _metrics.find(name);
+    if (itr == _metrics.end()) return false;
+
+    _summarize(name, itr->second, result);
+    return true;
+}
+
+void FrameStatistics::clear()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    _metrics.clear();
+}
+
+void FrameStatistics::writeJSON(std::ostream& out, uint64_t frameCount, const Summaries& summaries)
+{
+    static const char* typeNames[] = {"counter", "gauge", "histogram"};
+
+    auto writeString = [&out](const std::string& str) {
+        out << '"';
+        for (auto c : str)
+        {
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (static_cast<unsigned char>(c) < 0x20)
+                out << ' ';
+            else
+                out << c;
+        }
+        out << '"';
+    };
+
+    out << "{\"frameCount\":" << frameCount << ",\"metrics\":[";
+    for (size_t i = 0; i < summaries.size(); ++i)
+    {
+        auto& summary = summaries[i];
+        if (i > 0) out << ",";
+        out << "{\"name\":";
+        writeString(summary.name);
+        out << ",\"type\":\"" << typeNames[summary.type] << "\"";
+        out << ",\"total\":" << summary.total << ",\"count\":" << summary.count;
+        out << ",\"min\":" << summary.min << ",\"max\":" << summary.max << ",\"mean\":" << summary.mean;
+        out << ",\"p50\":" << summary.p50 << ",\"p95\":" << summary.p95 << ",\"p99\":" << summary.p99 << "}";
+    }
+    out << "]}" << std::endl;
+}
@@ -0,0 +1,490 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/app/Camera.h>
+#include <vsg/app/RenderPassChain.h>
+#include <vsg/app/View.h>
+#include <vsg/app/Viewer.h>
+#include <vsg/commands/CopyImageToBuffer.h>
+#include <vsg/commands/PipelineBarrier.h>
+#include <vsg/io/Logger.h>
+#include <vsg/lighting/AmbientLight.h>
+#include <vsg/nodes/LOD.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/state/ImageView.h>
+#include <vsg/state/InputAssemblyState.h>
+#include <vsg/state/RasterizationState.h>
+#include <vsg/utils/ComputeBounds.h>
+#include <vsg/utils/GenerateImpostor.h>
+#include <vsg/utils/GraphicsPipelineConfigurator.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vsg;
+
+namespace
+{
+    const char* s_impostorVertexSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelView;
+} pc;
+
+layout(set = 0, binding = 2) uniform ImpostorSettings
+{
+    vec4 numFrames;
+} settings;
+
+layout(location = 0) in vec2 vsg_Corner;
+layout(location = 1) in vec4 vsg_CenterRadius;
+
+layout(location = 0) out vec2 texCoord;
+layout(location = 1) out vec3 eyePosition;
+layout(location = 2) flat out vec3 eyeDirection;
+layout(location = 3) flat out vec4 projectionZ;
+layout(location = 4) flat out vec4 projectionW;
+layout(location = 5) flat out mat3 normalMatrix;
+
+out gl_PerVertex{ vec4 gl_Position; };
+
+vec2 signNotZero(vec2 v)
+{
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec2 octahedralEncode(vec3 d)
+{
+    d /= (abs(d.x) + abs(d.y) + abs(d.z));
+    return (d.z >= 0.0) ? d.xy : (1.0 - abs(d.yx)) * signNotZero(d.xy);
+}
+
+vec3 octahedralDecode(vec2 e)
+{
+    vec3 d = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (d.z < 0.0) d.xy = (1.0 - abs(d.yx)) * signNotZero(d.xy);
+    return normalize(d);
+}
+
+void main()
+{
+    float numFrames = settings.numFrames.x;
+    vec3 center = vsg_CenterRadius.xyz;
+    float radius = vsg_CenterRadius.w;
+
+    // select the frame rendered from the direction nearest to the eye point
+    vec3 eye = (inverse(pc.modelView) * vec4(0.0, 0.0, 0.0, 1.0)).xyz;
+    vec2 frame = clamp(floor((octahedralEncode(normalize(eye - center)) * 0.5 + 0.5) * numFrames), vec2(0.0), vec2(numFrames - 1.0));
+    vec3 direction = octahedralDecode((frame + 0.5) / numFrames * 2.0 - 1.0);
+
+    // orient the quad with the same basis as the LookAt the frame was rendered with
+    vec3 up = (abs(direction.z) > 0.999) ? vec3(0.0, 1.0, 0.0) : vec3(0.0, 0.0, 1.0);
+    vec3 side = normalize(cross(-direction, up));
+    up = cross(side, -direction);
+
+    vec4 position = pc.modelView * vec4(center + (side * vsg_Corner.x + up * vsg_Corner.y) * radius, 1.0);
+    gl_Position = pc.projection * position;
+
+    texCoord = (frame + vec2(0.5 + 0.5 * vsg_Corner.x, 0.5 - 0.5 * vsg_Corner.y)) / numFrames;
+    eyePosition = position.xyz;
+    eyeDirection = mat3(pc.modelView) * (direction * radius);
+    projectionZ = vec4(pc.projection[0][2], pc.projection[1][2], pc.projection[2][2], pc.projection[3][2]);
+    projectionW = vec4(pc.projection[0][3], pc.projection[1][3], pc.projection[2][3], pc.projection[3][3]);
+    normalMatrix = mat3(pc.modelView);
+}
+)";
+
+    const char* s_impostorFragmentSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(set = 0, binding = 0) uniform sampler2D colorAtlas;
+layout(set = 0, binding = 1) uniform sampler2D normalDepthAtlas;
+
+layout(location = 0) in vec2 texCoord;
+layout(location = 1) in vec3 eyePosition;
+layout(location = 2) flat in vec3 eyeDirection;
+layout(location = 3) flat in vec4 projectionZ;
+layout(location = 4) flat in vec4 projectionW;
+layout(location = 5) flat in mat3 normalMatrix;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    vec4 color = texture(colorAtlas, texCoord);
+    if (color.a < 0.5) discard;
+
+    vec4 normalDepth = texture(normalDepthAtlas, texCoord);
+
+    // move the fragment from the plane of the quad to the surface of the subgraph
+    vec4 position = vec4(eyePosition + eyeDirection * (normalDepth.w * 2.0 - 1.0), 1.0);
+    gl_FragDepth = dot(projectionZ, position) / dot(projectionW, position);
+
+    // headlight
+    vec3 normal = normalize(normalMatrix * (normalDepth.xyz * 2.0 - 1.0));
+    float diffuse = max(dot(normal, normalize(-position.xyz)), 0.0);
+
+    outColor = vec4(color.rgb * (0.2 + 0.8 * diffuse), 1.0);
+}
+)";
+
+    dvec3 octahedralDecode(const dvec2& e)
+    {
+        dvec3 d(e.x, e.y, 1.0 - std::abs(e.x) - std::abs(e.y));
+        if (d.z < 0.0)
+        {
+            double x = (1.0 - std::abs(d.y)) * (d.x >= 0.0 ? 1.0 : -1.0);
+            double y = (1.0 - std::abs(d.x)) * (d.y >= 0.0 ? 1.0 : -1.0);
+            d.x = x;
+            d.y = y;
+        }
+        return normalize(d);
+    }
+
+    // up direction of the LookAt used to render each frame, must match the impostor vertex shader
+    dvec3 frameUp(const dvec3& direction)
+    {
+        return (std::abs(direction.z) > 0.999) ? dvec3(0.0, 1.0, 0.0) : dvec3(0.0, 0.0, 1.0);
+    }
+
+    ref_ptr<ImageView> createAttachment(Device* device, VkFormat format, VkImageUsageFlags usage, const VkExtent2D& extent)
+    {
+        auto image = Image::create();
+        image->imageType = VK_IMAGE_TYPE_2D;
+        image->format = format;
+        image->extent = VkExtent3D{extent.width, extent.height, 1};
+        image->mipLevels = 1;
+        image->arrayLayers = 1;
+        image->samples = VK_SAMPLE_COUNT_1_BIT;
+        image->tiling = VK_IMAGE_TILING_OPTIMAL;
+        image->usage = usage;
+        image->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        image->sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        image->compile(device);
+        image->allocateAndBindMemory(device);
+
+        auto imageView = ImageView::create(image, computeAspectFlagsForFormat(format));
+        imageView->compile(device);
+        return imageView;
+    }
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// createImpostorShaderSet
+//
+ref_ptr<ShaderSet> vsg::createImpostorShaderSet(ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("impostor"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    auto vertexShader = ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, "main", s_impostorVertexSource);
+    auto fragmentShader = ShaderStage::create(VK_SHADER_STAGE_FRAGMENT_BIT, "main", s_impostorFragmentSource);
+
+    auto shaderSet = ShaderSet::create(ShaderStages{vertexShader, fragmentShader});
+
+    shaderSet->addAttributeBinding("vsg_Corner", "", 0, VK_FORMAT_R32G32_SFLOAT, vec2Array::create(1));
+    shaderSet->addAttributeBinding("vsg_CenterRadius", "", 1, VK_FORMAT_R32G32B32A32_SFLOAT, vec4Array::create(1, vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+
+    shaderSet->addDescriptorBinding("colorAtlas", "", 0, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, ubvec4Array2D::create(1, 1, Data::Properties{VK_FORMAT_R8G8B8A8_UNORM}));
+    shaderSet->addDescriptorBinding("normalDepthAtlas", "", 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, ubvec4Array2D::create(1, 1, Data::Properties{VK_FORMAT_R8G8B8A8_UNORM}));
+    shaderSet->addDescriptorBinding("impostorSettings", "", 0, 2, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, vec4Value::create(vec4(1.0f, 0.0f, 0.0f, 0.0f)));
+
+    shaderSet->addPushConstantRange("pc", "", VK_SHADER_STAGE_VERTEX_BIT, 0, 128);
+
+    auto rasterizationState = RasterizationState::create();
+    rasterizationState->cullMode = VK_CULL_MODE_NONE;
+    shaderSet->defaultGraphicsPipelineStates = {InputAssemblyState::create(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP), rasterizationState};
+
+    return shaderSet;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// GenerateImpostor
+//
+GenerateImpostor::GenerateImpostor(ref_ptr<Device> in_device, int in_queueFamily) :
+    device(in_device),
+    queueFamily(in_queueFamily)
+{
+}
+
+GenerateImpostor::~GenerateImpostor()
+{
+}
+
+GenerateImpostor::Atlas GenerateImpostor::createAtlas(ref_ptr<Node> subgraph) const
+{
+    Atlas atlas;
+    if (!subgraph || !device || queueFamily < 0 || numFrames == 0 || frameSize == 0) return atlas;
+
+    ComputeBounds computeBounds;
+    subgraph->accept(computeBounds);
+    if (!computeBounds.bounds.valid()) return atlas;
+
+    const auto& box = computeBounds.bounds;
+    dvec3 center = (box.min + box.max) * 0.5;
+    double radius = length(box.max - box.min) * 0.5;
+    if (radius <= 0.0) return atlas;
+
+    atlas.bound.set(center, radius);
+    atlas.numFrames = numFrames;
+
+    // render each frame in turn to a frame sized framebuffer, copying it to its place in the atlas held in host visible staging buffers
+    const VkFormat colorFormat = VK_FORMAT_R8G8B8A8_UNORM;
+    const VkFormat depthFormat = VK_FORMAT_D32_SFLOAT;
+    const VkExtent2D extent{frameSize, frameSize};
+
+    auto colorImageView = createAttachment(device, colorFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, extent);
+    auto depthImageView = createAttachment(device, depthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, extent);
+
+    // orthographic projection enclosing the bound, with the eye point two radii from the center, so depth runs from 1.0 at the front of the bound to 0.0 at the back
+    auto lookAt = LookAt::create();
+    auto camera = Camera::create(Orthographic::create(-radius, radius, -radius, radius, radius, 3.0 * radius), lookAt, ViewportState::create(extent));
+
+    auto view = View::create(camera);
+    view->addChild(AmbientLight::create());
+    view->addChild(subgraph);
+
+    auto renderPassChain = RenderPassChain::create(extent);
+
+    RenderPassChain::Attachment colorAttachment;
+    colorAttachment.format = colorFormat;
+    colorAttachment.clearValue.color = {{0.0f, 0.0f, 0.0f, 0.0f}};
+    colorAttachment.imageView = colorImageView;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    RenderPassChain::Attachment depthAttachment;
+    depthAttachment.format = depthFormat;
+    depthAttachment.clearValue.depthStencil = {0.0f, 0};
+    depthAttachment.imageView = depthImageView;
+    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    RenderPassChain::Pass pass;
+    pass.subgraph = view;
+    pass.colorAttachments.push_back(renderPassChain->addAttachment(colorAttachment));
+    pass.depthStencilAttachment = static_cast<int32_t>(renderPassChain->addAttachment(depthAttachment));
+    renderPassChain->addPass(pass);
+
+    uint32_t width = numFrames * frameSize;
+    VkDeviceSize atlasSize = static_cast<VkDeviceSize>(width) * width * 4;
+    auto colorBuffer = createBufferAndMemory(device, atlasSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    auto depthBuffer = createBufferAndMemory(device, atlasSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_SHARING_MODE_EXCLUSIVE, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    auto createCopy = [&](ref_ptr<ImageView> imageView, ref_ptr<Buffer> buffer) {
+        VkBufferImageCopy region = {};
+        region.bufferRowLength = width;
+        region.bufferImageHeight = width;
+        region.imageSubresource = VkImageSubresourceLayers{imageView->subresourceRange.aspectMask, 0, 0, 1};
+        region.imageExtent = VkExtent3D{frameSize, frameSize, 1};
+
+        auto copy = CopyImageToBuffer::create();
+        copy->srcImage = imageView->image;
+        copy->srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        copy->dstBuffer = buffer;
+        copy->regions.push_back(region);
+        return copy;
+    };
+
+    auto copyColor = createCopy(colorImageView, colorBuffer);
+    auto copyDepth = createCopy(depthImageView, depthBuffer);
+
+    auto commandGraph = CommandGraph::create(device, queueFamily);
+    commandGraph->addChild(renderPassChain->createRenderGraph(device));
+    commandGraph->addChild(copyColor);
+    commandGraph->addChild(copyDepth);
+    commandGraph->addChild(PipelineBarrier::create(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, MemoryBarrier::create(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT)));
+
+    auto viewer = Viewer::create();
+    viewer->assignRecordAndSubmitTaskAndPresentation({commandGraph});
+    viewer->compile();
+
+    for (uint32_t row = 0; row < numFrames; ++row)
+    {
+        for (uint32_t column = 0; column < numFrames; ++column)
+        {
+            dvec3 direction = octahedralDecode(dvec2((double(column) + 0.5) / double(numFrames) * 2.0 - 1.0, (double(row) + 0.5) / double(numFrames) * 2.0 - 1.0));
+            lookAt->eye = center + direction * (2.0 * radius);
+            lookAt->center = center;
+            lookAt->up = frameUp(direction);
+
+            VkDeviceSize offset = (static_cast<VkDeviceSize>(row) * frameSize * width + static_cast<VkDeviceSize>(column) * frameSize) * 4;
+            copyColor->regions[0].bufferOffset = offset;
+            copyDepth->regions[0].bufferOffset = offset;
+
+            if (!viewer->advanceToNextFrame())
+            {
+                warn("GenerateImpostor::createAtlas(..) failed to render frames.");
+                return {};
+            }
+
+            viewer->recordAndSubmit();
+
+            // wait for the frame's copies to complete before the framebuffer and regions are reused
+            viewer->deviceWaitIdle();
+        }
+    }
+
+    auto deviceID = device->deviceID;
+    void* colorPtr = nullptr;
+    void* depthPtr = nullptr;
+    colorBuffer->getDeviceMemory(deviceID)->map(colorBuffer->getMemoryOffset(deviceID), atlasSize, 0, &colorPtr);
+    depthBuffer->getDeviceMemory(deviceID)->map(depthBuffer->getMemoryOffset(deviceID), atlasSize, 0, &depthPtr);
+    if (!colorPtr || !depthPtr)
+    {
+        warn("GenerateImpostor::createAtlas(..) failed to map staging buffers.");
+        return {};
+    }
+
+    const auto* colors = static_cast<const ubvec4*>(colorPtr);
+    const auto* depths = static_cast<const float*>(depthPtr);
+
+    atlas.color = ubvec4Array2D::create(width, width, Data::Properties{VK_FORMAT_R8G8B8A8_UNORM});
+    atlas.normalDepth = ubvec4Array2D::create(width, width, Data::Properties{VK_FORMAT_R8G8B8A8_UNORM});
+
+    // distance between texel centers, and the depth range, in the units of the subgraph
+    double texelSize = 2.0 * radius / double(frameSize);
+    double depthRange = 2.0 * radius;
+
+    for (uint32_t row = 0; row < numFrames; ++row)
+    {
+        for (uint32_t column = 0; column < numFrames; ++column)
+        {
+            dvec3 direction = octahedralDecode(dvec2((double(column) + 0.5) / double(numFrames) * 2.0 - 1.0, (double(row) + 0.5) / double(numFrames) * 2.0 - 1.0));
+            dvec3 side = normalize(cross(-direction, frameUp(direction)));
+            dvec3 up = cross(side, -direction);
+
+            uint32_t x0 = column * frameSize;
+            uint32_t y0 = row * frameSize;
+
+            // depth of a texel within the frame, 0.0 where only the cleared background is present
+            auto depthAt = [&](int32_t x, int32_t y) -> float {
+                if (x < 0 || y < 0 || x >= static_cast<int32_t>(frameSize) || y >= static_cast<int32_t>(frameSize)) return 0.0f;
+                return depths[(y0 + y) * width + x0 + x];
+            };
+
+            // slope of the depth between neighbouring texels, using one sided differences at the silhouette
+            auto slope = [&](float before, float depth, float after) -> double {
+                if (before > 0.0f && after > 0.0f) return double(after - before) * 0.5 * depthRange;
+                if (after > 0.0f) return double(after - depth) * depthRange;
+                if (before > 0.0f) return double(depth - before) * depthRange;
+                return 0.0;
+            };
+
+            for (int32_t y = 0; y < static_cast<int32_t>(frameSize); ++y)
+            {
+                for (int32_t x = 0; x < static_cast<int32_t>(frameSize); ++x)
+                {
+                    size_t index = (y0 + y) * width + x0 + x;
+                    float depth = depths[index];
+                    auto& color = atlas.color->at(x0 + x, y0 + y);
+                    auto& normalDepth = atlas.normalDepth->at(x0 + x, y0 + y);
+
+                    if (depth <= 0.0f)
+                    {
+                        color.set(0, 0, 0, 0);
+                        normalDepth.set(128, 128, 255, 0);
+                        continue;
+                    }
+
+                    color = colors[index];
+                    color.a = 255;
+
+                    // normal in the frame's eye coordinates, with +x to the right, rows running down the frame and +z toward the eye
+                    double dx = slope(depthAt(x - 1, y), depth, depthAt(x + 1, y));
+                    double dy = slope(depthAt(x, y - 1), depth, depthAt(x, y + 1));
+                    dvec3 n = normalize(dvec3(-dx * texelSize, dy * texelSize, texelSize * texelSize));
+                    dvec3 normal = side * n.x + up * n.y + direction * n.z;
+
+                    auto encode = [](double v) { return static_cast<uint8_t>(std::clamp(std::round((v * 0.5 + 0.5) * 255.0), 0.0, 255.0)); };
+                    normalDepth.set(encode(normal.x), encode(normal.y), encode(normal.z), static_cast<uint8_t>(std::clamp(std::round(double(depth) * 255.0), 1.0, 255.0)));
+                }
+            }
+        }
+    }
+
+    colorBuffer->getDeviceMemory(deviceID)->unmap();
+    depthBuffer->getDeviceMemory(deviceID)->unmap();
+
+    return atlas;
+}
+
+ref_ptr<Node> GenerateImpostor::createImpostor(const Atlas& atlas, ref_ptr<vec4Array> positions) const
+{
+    if (!atlas.color || !atlas.normalDepth || atlas.numFrames == 0) return {};
+
+    auto shaderSet = createImpostorShaderSet(options);
+    auto graphicsPipelineConfig = GraphicsPipelineConfigurator::create(shaderSet);
+
+    auto sampler = Sampler::create();
+    sampler->addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler->addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    if (sharedObjects) sharedObjects->share(sampler);
+
+    graphicsPipelineConfig->assignTexture("colorAtlas", atlas.color, sampler);
+    graphicsPipelineConfig->assignTexture("normalDepthAtlas", atlas.normalDepth, sampler);
+    graphicsPipelineConfig->assignDescriptor("impostorSettings", vec4Value::create(vec4(static_cast<float>(atlas.numFrames), 0.0f, 0.0f, 0.0f)));
+
+    // per instance center and radius of the quads
+    size_t count = positions ? positions->size() : 1;
+    auto centerRadii = vec4Array::create(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        vec4 position = positions ? positions->at(i) : vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        vec3 center = position.xyz + vec3(atlas.bound.center) * position.w;
+        centerRadii->at(i) = vec4(center.x, center.y, center.z, static_cast<float>(atlas.bound.radius) * position.w);
+    }
+
+    auto corners = vec2Array::create({{-1.0f, -1.0f}, {1.0f, -1.0f}, {-1.0f, 1.0f}, {1.0f, 1.0f}});
+
+    DataList arrays;
+    graphicsPipelineConfig->assignArray(arrays, "vsg_Corner", VK_VERTEX_INPUT_RATE_VERTEX, corners);
+    graphicsPipelineConfig->assignArray(arrays, "vsg_CenterRadius", VK_VERTEX_INPUT_RATE_INSTANCE, centerRadii);
+
+    if (sharedObjects)
+        sharedObjects->share(graphicsPipelineConfig, [](auto gpc) { gpc->init(); });
+    else
+        graphicsPipelineConfig->init();
+
+    auto draw = VertexDraw::create();
+    draw->assignArrays(arrays);
+    draw->vertexCount = 4;
+    draw->instanceCount = static_cast<uint32_t>(count);
+
+    auto stateGroup = StateGroup::create();
+    if (!graphicsPipelineConfig->copyTo(stateGroup, sharedObjects)) return {};
+
+    stateGroup->addChild(draw);
+    return stateGroup;
+}
+
+ref_ptr<Node> GenerateImpostor::generate(ref_ptr<Node> subgraph) const
+{
+    auto atlas = createAtlas(subgraph);
+    auto impostor = createImpostor(atlas);
+    if (!impostor) return subgraph;
+
+    auto lod = LOD::create();
+    lod->bound = atlas.bound;
+    lod->addChild(LOD::Child{minimumScreenHeightRatio, subgraph});
+    lod->addChild(LOD::Child{0.0, impostor});
+    return lod;
+}
@@ -0,0 +1,511 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/DrawIndexed.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/LOD.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/state/GraphicsPipeline.h>
+#include <vsg/state/InputAssemblyState.h>
+#include <vsg/utils/ComputeBounds.h>
+#include <vsg/utils/GenerateLODs.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// simplify
+//
+namespace
+{
+    /// symmetric 4x4 quadric error matrix, along with the total weight of the planes accumulated so errors can be normalized to squared distances
+    struct Quadric
+    {
+        double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+        double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+        double a22 = 0.0, a23 = 0.0;
+        double a33 = 0.0;
+        double weight = 0.0;
+
+        void addPlane(const dvec3& n, double d, double w)
+        {
+            a00 += w * n.x * n.x;
+            a01 += w * n.x * n.y;
+            a02 += w * n.x * n.z;
+            a03 += w * n.x * d;
+            a11 += w * n.y * n.y;
+            a12 += w * n.y * n.z;
+            a13 += w * n.y * d;
+            a22 += w * n.z * n.z;
+            a23 += w * n.z * d;
+            a33 += w * d * d;
+            weight += w;
+        }
+
+        void add(const Quadric& q)
+        {
+            a00 += q.a00;
+            a01 += q.a01;
+            a02 += q.a02;
+            a03 += q.a03;
+            a11 += q.a11;
+            a12 += q.a12;
+            a13 += q.a13;
+            a22 += q.a22;
+            a23 += q.a23;
+            a33 += q.a33;
+            weight += q.weight;
+        }
+
+        double error(const dvec3& v) const
+        {
+            double e = a00 * v.x * v.x + 2.0 * a01 * v.x * v.y + 2.0 * a02 * v.x * v.z + 2.0 * a03 * v.x +
+                       a11 * v.y * v.y + 2.0 * a12 * v.y * v.z + 2.0 * a13 * v.y +
+                       a22 * v.z * v.z + 2.0 * a23 * v.z +
+                       a33;
+            return weight > 0.0 ? std::max(e, 0.0) / weight : 0.0;
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t from;
+        uint32_t to;
+        double error;
+
+        bool operator<(const Collapse& rhs) const { return error < rhs.error; }
+    };
+
+    template<class A>
+    void readIndices(const A& source, uint32_t firstIndex, uint32_t indexCount, std::vector<uint32_t>& indices)
+    {
+        for (uint32_t i = firstIndex; i < firstIndex + indexCount; ++i) indices.push_back(source.at(i));
+    }
+
+    template<class A>
+    ref_ptr<Data> createIndices(const std::vector<uint32_t>& indices)
+    {
+        auto result = A::create(static_cast<uint32_t>(indices.size()));
+        for (size_t i = 0; i < indices.size(); ++i) result->at(i) = static_cast<typename A::value_type>(indices[i]);
+        return result;
+    }
+} // namespace
+
+ref_ptr<Data> vsg::simplify(const vec3Array& vertices, const Data& indices, uint32_t firstIndex, uint32_t indexCount, uint32_t vertexOffset, uint32_t targetIndexCount, float targetError, float* resultError)
+{
+    if (resultError) *resultError = 0.0f;
+
+    uint32_t availableIndices = static_cast<uint32_t>(indices.valueCount()) - std::min(firstIndex, static_cast<uint32_t>(indices.valueCount()));
+    indexCount = std::min(indexCount, availableIndices);
+    indexCount -= indexCount % 3;
+
+    std::vector<uint32_t> triangles;
+    triangles.reserve(indexCount);
+    if (auto us = indices.cast<ushortArray>())
+        readIndices(*us, firstIndex, indexCount, triangles);
+    else if (auto ui = indices.cast<uintArray>())
+        readIndices(*ui, firstIndex, indexCount, triangles);
+    else
+        return {};
+
+    auto createResult = [&]() -> ref_ptr<Data> {
+        if (indices.is_compatible(typeid(ushortArray))) return createIndices<ushortArray>(triangles);
+        return createIndices<uintArray>(triangles);
+    };
+
+    // discard triangles that reference vertices outside the vertex array
+    uint32_t numVertices = static_cast<uint32_t>(vertices.size()) - std::min(vertexOffset, static_cast<uint32_t>(vertices.size()));
+    for (size_t i = 0; i < triangles.size();)
+    {
+        if (triangles[i] >= numVertices || triangles[i + 1] >= numVertices || triangles[i + 2] >= numVertices)
+            triangles.erase(triangles.begin() + i, triangles.begin() + i + 3);
+        else
+            i += 3;
+    }
+
+    if (triangles.size() <= targetIndexCount) return createResult();
+
+    auto position = [&](uint32_t v) { return dvec3(vertices[v + vertexOffset]); };
+
+    // lock vertices that share their position with another vertex, these will be on texture coordinate and normal seams
+    std::vector<bool> locked(numVertices, false);
+    std::vector<uint32_t> positionRemap(numVertices);
+    {
+        std::map<std::tuple<float, float, float>, uint32_t> positions;
+        for (uint32_t v = 0; v < numVertices; ++v)
+        {
+            const auto& p = vertices[v + vertexOffset];
+            auto [itr, inserted] = positions.emplace(std::make_tuple(p.x, p.y, p.z), v);
+            positionRemap[v] = itr->second;
+            if (!inserted)
+            {
+                locked[v] = true;
+                locked[itr->second] = true;
+            }
+        }
+    }
+
+    // extent of the mesh used to scale the error limit
+    dvec3 minimum(position(triangles[0])), maximum(minimum);
+    for (auto v : triangles)
+    {
+        auto p = position(v);
+        minimum.set(std::min(minimum.x, p.x), std::min(minimum.y, p.y), std::min(minimum.z, p.z));
+        maximum.set(std::max(maximum.x, p.x), std::max(maximum.y, p.y), std::max(maximum.z, p.z));
+    }
+    double extent = length(maximum - minimum);
+    if (extent <= 0.0) return createResult();
+
+    double errorLimit = static_cast<double>(targetError) * extent;
+    errorLimit *= errorLimit;
+
+    // face quadrics, weighted by triangle area
+    std::vector<Quadric> quadrics(numVertices);
+    for (size_t t = 0; t < triangles.size(); t += 3)
+    {
+        auto p0 = position(triangles[t]);
+        auto n = cross(position(triangles[t + 1]) - p0, position(triangles[t + 2]) - p0);
+        double l = length(n);
+        if (l <= 0.0) continue;
+
+        n /= l;
+        double d = -dot(n, p0);
+        for (size_t i = 0; i < 3; ++i) quadrics[triangles[t + i]].addPlane(n, d, l * 0.5);
+    }
+
+    // boundary quadrics, planes perpendicular to the faces along edges that have no opposite edge
+    {
+        std::map<std::pair<uint32_t, uint32_t>, uint32_t> edges;
+        for (size_t t = 0; t < triangles.size(); t += 3)
+        {
+            for (size_t i = 0; i < 3; ++i)
+            {
+                uint32_t a = positionRemap[triangles[t + i]];
+                uint32_t b = positionRemap[triangles[t + (i + 1) % 3]];
+                ++edges[{a, b}];
+            }
+        }
+
+        for (size_t t = 0; t < triangles.size(); t += 3)
+        {
+            auto p0 = position(triangles[t]);
+            auto faceNormal = cross(position(triangles[t + 1]) - p0, position(triangles[t + 2]) - p0);
+            for (size_t i = 0; i < 3; ++i)
+            {
+                uint32_t a = triangles[t + i];
+                uint32_t b = triangles[t + (i + 1) % 3];
+                if (edges.count({positionRemap[b], positionRemap[a]}) > 0) continue;
+
+                auto edge = position(b) - position(a);
+                auto n = cross(edge, faceNormal);
+                double l = length(n);
+                if (l <= 0.0) continue;
+
+                n /= l;
+                double d = -dot(n, position(a));
+                double w = dot(edge, edge) * 10.0;
+                quadrics[a].addPlane(n, d, w);
+                quadrics[b].addPlane(n, d, w);
+            }
+        }
+    }
+
+    double maxError = 0.0;
+    std::vector<uint32_t> offsets(numVertices + 1);
+    std::vector<uint32_t> vertexTriangles;
+    std::vector<uint32_t> remap(numVertices);
+    std::vector<bool> touched(numVertices);
+    std::vector<Collapse> collapses;
+
+    while (triangles.size() > targetIndexCount)
+    {
+        uint32_t numTriangles = static_cast<uint32_t>(triangles.size() / 3);
+
+        // vertex to triangle adjacency
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (auto v : triangles) ++offsets[v + 1];
+        for (uint32_t v = 0; v < numVertices; ++v) offsets[v + 1] += offsets[v];
+        vertexTriangles.resize(triangles.size());
+        {
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (uint32_t t = 0; t < numTriangles; ++t)
+            {
+                for (uint32_t i = 0; i < 3; ++i) vertexTriangles[fill[triangles[t * 3 + i]]++] = t;
+            }
+        }
+
+        // collapse candidates for each edge
+        collapses.clear();
+        for (uint32_t t = 0; t < numTriangles; ++t)
+        {
+            for (uint32_t i = 0; i < 3; ++i)
+            {
+                uint32_t a = triangles[t * 3 + i];
+                uint32_t b = triangles[t * 3 + (i + 1) % 3];
+
+                Quadric q = quadrics[a];
+                q.add(quadrics[b]);
+                if (!locked[a]) collapses.push_back(Collapse{a, b, q.error(position(b))});
+                if (!locked[b]) collapses.push_back(Collapse{b, a, q.error(position(a))});
+            }
+        }
+        std::sort(collapses.begin(), collapses.end());
+
+        // return true if replacing from by to would flip any of the triangles around from
+        auto flips = [&](uint32_t from, uint32_t to) {
+            for (uint32_t i = offsets[from]; i < offsets[from + 1]; ++i)
+            {
+                const uint32_t* tri = &triangles[vertexTriangles[i] * 3];
+                if (tri[0] == to || tri[1] == to || tri[2] == to) continue;
+
+                dvec3 p[3] = {position(tri[0]), position(tri[1]), position(tri[2])};
+                auto before = cross(p[1] - p[0], p[2] - p[0]);
+                for (uint32_t j = 0; j < 3; ++j)
+                {
+                    if (tri[j] == from) p[j] = position(to);
+                }
+                auto after = cross(p[1] - p[0], p[2] - p[0]);
+                if (dot(before, after) <= 0.0) return true;
+            }
+            return false;
+        };
+
+        for (uint32_t v = 0; v < numVertices; ++v) remap[v] = v;
+        std::fill(touched.begin(), touched.end(), false);
+
+        uint32_t numRemaining = numTriangles;
+        uint32_t numCollapses = 0;
+        for (auto& collapse : collapses)
+        {
+            if (collapse.error > errorLimit || numRemaining * 3 <= targetIndexCount) break;
+            if (touched[collapse.from] || touched[collapse.to] || flips(collapse.from, collapse.to)) continue;
+
+            // mark the vertices of the triangles around the collapsed vertex so the flip tests of later collapses in this pass use valid positions
+            for (uint32_t i = offsets[collapse.from]; i < offsets[collapse.from + 1]; ++i)
+            {
+                const uint32_t* tri = &triangles[vertexTriangles[i] * 3];
+                if (tri[0] == collapse.to || tri[1] == collapse.to || tri[2] == collapse.to) --numRemaining;
+                touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = true;
+            }
+
+            remap[collapse.from] = collapse.to;
+            quadrics[collapse.to].add(quadrics[collapse.from]);
+            maxError = std::max(maxError, collapse.error);
+            ++numCollapses;
+        }
+
+        if (numCollapses == 0) break;
+
+        // apply the collapses and remove the degenerate triangles
+        size_t write = 0;
+        for (size_t t = 0; t < triangles.size(); t += 3)
+        {
+            uint32_t a = remap[triangles[t]], b = remap[triangles[t + 1]], c = remap[triangles[t + 2]];
+            if (a == b || b == c || c == a) continue;
+
+            triangles[write++] = a;
+            triangles[write++] = b;
+            triangles[write++] = c;
+        }
+        triangles.resize(write);
+    }
+
+    if (resultError) *resultError = static_cast<float>(std::sqrt(maxError) / extent);
+
+    return createResult();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// GenerateLODs
+//
+namespace
+{
+    struct CountTriangles : public ConstVisitor
+    {
+        uint64_t numTriangles = 0;
+
+        void apply(const Node& node) override { node.traverse(*this); }
+        void apply(const VertexIndexDraw& vid) override { numTriangles += vid.indexCount / 3; }
+        void apply(const Geometry& geometry) override
+        {
+            for (auto& command : geometry.commands)
+            {
+                if (auto drawIndexed = command.cast<DrawIndexed>()) numTriangles += drawIndexed->indexCount / 3;
+            }
+        }
+    };
+
+    struct SimplifySubgraph
+    {
+        float ratio = 1.0f;
+        float targetError = 0.01f;
+
+        ref_ptr<Data> simplifyIndices(const BufferInfoList& arrays, const BufferInfo* indices, uint32_t firstIndex, uint32_t indexCount, uint32_t vertexOffset) const
+        {
+            if (arrays.empty() || !arrays[0] || !indices || !indices->data) return {};
+
+            auto vertices = arrays[0]->data.cast<vec3Array>();
+            if (!vertices) return {};
+
+            uint32_t targetIndexCount = static_cast<uint32_t>(static_cast<float>(indexCount) * ratio);
+            targetIndexCount = std::max(targetIndexCount - targetIndexCount % 3, 3u);
+
+            return simplify(*vertices, *indices->data, firstIndex, indexCount, vertexOffset, targetIndexCount, targetError);
+        }
+
+        ref_ptr<Node> apply(ref_ptr<Node> node, bool triangleList) const
+        {
+            if (node->is_compatible(typeid(StateGroup)))
+            {
+                for (auto& stateCommand : node->cast<StateGroup>()->stateCommands)
+                {
+                    auto bindGraphicsPipeline = stateCommand.cast<BindGraphicsPipeline>();
+                    if (!bindGraphicsPipeline || !bindGraphicsPipeline->pipeline) continue;
+                    for (auto& pipelineState : bindGraphicsPipeline->pipeline->pipelineStates)
+                    {
+                        if (auto inputAssemblyState = pipelineState.cast<InputAssemblyState>()) triangleList = (inputAssemblyState->topology == VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+                    }
+                }
+            }
+
+            if (auto vid = node.cast<VertexIndexDraw>())
+            {
+                if (!triangleList) return node;
+
+                auto indices = simplifyIndices(vid->arrays, vid->indices, vid->firstIndex, vid->indexCount, vid->vertexOffset);
+                if (!indices || indices->valueCount() >= vid->indexCount) return node;
+
+                auto simplified = VertexIndexDraw::create(*vid);
+                simplified->assignIndices(indices);
+                simplified->indexCount = static_cast<uint32_t>(indices->valueCount());
+                simplified->firstIndex = 0;
+                return simplified;
+            }
+            else if (auto geometry = node.cast<Geometry>())
+            {
+                if (!triangleList || geometry->commands.size() != 1) return node;
+
+                auto drawIndexed = geometry->commands.front().cast<DrawIndexed>();
+                if (!drawIndexed) return node;
+
+                auto indices = simplifyIndices(geometry->arrays, geometry->indices, drawIndexed->firstIndex, drawIndexed->indexCount, drawIndexed->vertexOffset);
+                if (!indices || indices->valueCount() >= drawIndexed->indexCount) return node;
+
+                auto simplified = Geometry::create(*geometry);
+                simplified->assignIndices(indices);
+                simplified->commands = {DrawIndexed::create(static_cast<uint32_t>(indices->valueCount()), drawIndexed->instanceCount, 0, drawIndexed->vertexOffset, drawIndexed->firstInstance)};
+                return simplified;
+            }
+            else if (auto group = node.cast<Group>())
+            {
+                Group::Children children;
+                bool changed = false;
+                for (auto& child : group->children)
+                {
+                    children.push_back(apply(child, triangleList));
+                    if (children.back() != child) changed = true;
+                }
+                if (!changed) return node;
+
+                auto duplicate = group->clone().cast<Group>();
+                if (!duplicate) return node;
+
+                duplicate->children = children;
+                return duplicate;
+            }
+            return node;
+        }
+    };
+} // namespace
+
+GenerateLODs::GenerateLODs()
+{
+}
+
+GenerateLODs::~GenerateLODs()
+{
+}
+
+ref_ptr<Node> GenerateLODs::generate(ref_ptr<Node> subgraph) const
+{
+    if (!subgraph || numLevels < 2 || reductionRatio <= 0.0f || reductionRatio >= 1.0f) return subgraph;
+
+    CountTriangles countTriangles;
+    subgraph->accept(countTriangles);
+    if (countTriangles.numTriangles < minimumNumTriangles) return subgraph;
+
+    ComputeBounds computeBounds;
+    subgraph->accept(computeBounds);
+    if (!computeBounds.bounds.valid()) return subgraph;
+
+    auto lod = LOD::create();
+    lod->bound.center = (computeBounds.bounds.min + computeBounds.bounds.max) * 0.5;
+    lod->bound.radius = length(computeBounds.bounds.max - computeBounds.bounds.min) * 0.5;
+
+    double ratio = minimumScreenHeightRatio;
+    lod->addChild(LOD::Child{ratio, subgraph});
+
+    SimplifySubgraph simplifySubgraph;
+    simplifySubgraph.targetError = targetError;
+    for (uint32_t level = 1; level < numLevels; ++level)
+    {
+        simplifySubgraph.ratio = std::pow(reductionRatio, static_cast<float>(level));
+
+        auto simplified = simplifySubgraph.apply(subgraph, true);
+        if (simplified == subgraph) break;
+
+        CountTriangles countSimplified;
+        simplified->accept(countSimplified);
+        if (countSimplified.numTriangles >= countTriangles.numTriangles) break;
+        countTriangles.numTriangles = countSimplified.numTriangles;
+
+        ratio *= std::sqrt(static_cast<double>(reductionRatio));
+        lod->addChild(LOD::Child{ratio, simplified});
+    }
+
+    if (lod->children.size() < 2) return subgraph;
+
+    lod->children.back().minimumScreenHeightRatio = 0.0;
+    return lod;
+}
+
+void GenerateLODs::read(Input& input)
+{
+    Object::read(input);
+
+    input.read("numLevels", numLevels);
+    input.read("reductionRatio", reductionRatio);
+    input.read("targetError", targetError);
+    input.read("minimumScreenHeightRatio", minimumScreenHeightRatio);
+    input.read("minimumNumTriangles", minimumNumTriangles);
+}
+
+void GenerateLODs::write(Output& output) const
+{
+    Object::write(output);
+
+    output.write("numLevels", numLevels);
+    output.write("reductionRatio", reductionRatio);
+    output.write("targetError", targetError);
+    output.write("minimumScreenHeightRatio", minimumScreenHeightRatio);
+    output.write("minimumNumTriangles", minimumNumTriangles);
+}
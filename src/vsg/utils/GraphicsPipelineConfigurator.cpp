@@ -533,6 +533,7 @@ int GraphicsPipelineConfigurator::compare(const Object& rhs_object) const
 
     if ((result = compare_value(subpass, rhs.subpass))) return result;
     if ((result = compare_value(baseAttributeBinding, rhs.baseAttributeBinding))) return result;
+    if ((result = compare_value(dynamicStateMask, rhs.dynamicStateMask))) return result;
     if ((result = compare_pointer(shaderSet, rhs.shaderSet))) return result;
 
     if ((result = compare_pointer(shaderHints, rhs.shaderHints))) return result;
@@ -623,9 +624,45 @@ void GraphicsPipelineConfigurator::init()
         shaderHints->defines.insert(descriptorConfigurator->defines.begin(), descriptorConfigurator->defines.end());
     }
 
+    GraphicsPipelineConfiguratorCache::DefinesMask mask = 0;
+    if (cache && cache->shaderSet == shaderSet && shaderSet->definesMask(shaderHints->defines, mask))
+    {
+        layout = cache->getOrCreatePipelineLayout(mask);
+        auto stages = shaderSet->getShaderStages(mask, shaderHints);
+
+        if (dynamicStateMask != 0)
+        {
+            auto dynamicState = ExtendedDynamicState::create(dynamicStateMask);
+            dynamicState->set(pipelineStates);
+
+            graphicsPipeline = cache->getOrCreateGraphicsPipeline(mask, layout, stages, dynamicState->normalize(pipelineStates), subpass);
+            bindGraphicsPipeline = vsg::BindGraphicsPipeline::create(graphicsPipeline);
+            bindGraphicsPipeline->dynamicState = dynamicState;
+        }
+        else
+        {
+            graphicsPipeline = cache->getOrCreateGraphicsPipeline(mask, layout, stages, pipelineStates, subpass);
+            bindGraphicsPipeline = vsg::BindGraphicsPipeline::create(graphicsPipeline);
+        }
+        return;
+    }
+
     layout = shaderSet->createPipelineLayout(shaderHints->defines);
-    graphicsPipeline = GraphicsPipeline::create(layout, shaderSet->getShaderStages(shaderHints), pipelineStates, subpass);
-    bindGraphicsPipeline = vsg::BindGraphicsPipeline::create(graphicsPipeline);
+
+    if (dynamicStateMask != 0)
+    {
+        auto dynamicState = ExtendedDynamicState::create(dynamicStateMask);
+        dynamicState->set(pipelineStates);
+
+        graphicsPipeline = GraphicsPipeline::create(layout, shaderSet->getShaderStages(shaderHints), dynamicState->normalize(pipelineStates), subpass);
+        bindGraphicsPipeline = vsg::BindGraphicsPipeline::create(graphicsPipeline);
+        bindGraphicsPipeline->dynamicState = dynamicState;
+    }
+    else
+    {
+        graphicsPipeline = GraphicsPipeline::create(layout, shaderSet->getShaderStages(shaderHints), pipelineStates, subpass);
+        bindGraphicsPipeline = vsg::BindGraphicsPipeline::create(graphicsPipeline);
+    }
 }
 
 bool GraphicsPipelineConfigurator::copyTo(StateCommands& stateCommands, ref_ptr<SharedObjects> sharedObjects)
@@ -744,3 +781,56 @@ bool GraphicsPipelineConfigurator::copyTo(ref_ptr<StateGroup> stateGroup, ref_pt
         return false;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// GraphicsPipelineConfiguratorCache
+//
+GraphicsPipelineConfiguratorCache::GraphicsPipelineConfiguratorCache(ref_ptr<ShaderSet> in_shaderSet) :
+    shaderSet(in_shaderSet)
+{
+}
+
+void GraphicsPipelineConfiguratorCache::init(GraphicsPipelineConfigurator& configurator)
+{
+    auto previous = configurator.cache;
+    configurator.cache = this;
+    configurator.init();
+    configurator.cache = previous;
+}
+
+void GraphicsPipelineConfiguratorCache::init(const std::vector<ref_ptr<GraphicsPipelineConfigurator>>& configurators)
+{
+    for (auto& configurator : configurators)
+    {
+        if (configurator) init(*configurator);
+    }
+}
+
+ref_ptr<PipelineLayout> GraphicsPipelineConfiguratorCache::getOrCreatePipelineLayout(DefinesMask mask)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& layout = _layouts[mask];
+    if (!layout) layout = shaderSet->createPipelineLayout(mask);
+    return layout;
+}
+
+ref_ptr<GraphicsPipeline> GraphicsPipelineConfiguratorCache::getOrCreateGraphicsPipeline(DefinesMask mask, ref_ptr<PipelineLayout> layout, const ShaderStages& stages, const GraphicsPipelineStates& pipelineStates, uint32_t subpass)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& candidates = _graphicsPipelines[mask];
+    for (auto& candidate : candidates)
+    {
+        if (candidate->layout == layout && candidate->stages == stages && candidate->subpass == subpass &&
+            compare_pointer_container(candidate->pipelineStates, pipelineStates) == 0)
+        {
+            return candidate;
+        }
+    }
+
+    auto graphicsPipeline = GraphicsPipeline::create(layout, stages, pipelineStates, subpass);
+    candidates.push_back(graphicsPipeline);
+    return graphicsPipeline;
+}
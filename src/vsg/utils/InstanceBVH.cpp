@@ -0,0 +1,144 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Output.h>
+#include <vsg/utils/InstanceBVH.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace vsg;
+
+namespace
+{
+    // limit the depth so that the fixed size traversal stack can't overflow
+    constexpr uint32_t maxDepth = 48;
+
+    struct BuildInstanceBVH
+    {
+        const vec3Array& translations;
+        const std::vector<float>& scales;
+        std::vector<uint32_t>& order;
+        std::vector<InstanceBVH::Node>& nodes;
+        uint32_t maxInstancesPerLeaf;
+
+        uint32_t build(uint32_t begin, uint32_t end, uint32_t depth)
+        {
+            uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+
+            box bounds;
+            float maxScale = 0.0f;
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                bounds.add(translations.at(order[i]));
+                maxScale = std::max(maxScale, scales[order[i]]);
+            }
+
+            vec3 extents = bounds.max - bounds.min;
+            int axis = (extents.x >= extents.y && extents.x >= extents.z) ? 0 : ((extents.y >= extents.z) ? 1 : 2);
+
+            if ((end - begin) <= maxInstancesPerLeaf || extents[axis] <= 0.0f || depth >= maxDepth)
+            {
+                auto& node = nodes[nodeIndex];
+                node.min = bounds.min;
+                node.max = bounds.max;
+                node.maxScale = maxScale;
+                node.index = begin;
+                node.count = end - begin;
+                return nodeIndex;
+            }
+
+            uint32_t mid = begin + (end - begin) / 2;
+            std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](uint32_t lhs, uint32_t rhs) { return translations.at(lhs)[axis] < translations.at(rhs)[axis]; });
+
+            build(begin, mid, depth + 1);
+            uint32_t second = build(mid, end, depth + 1);
+
+            auto& node = nodes[nodeIndex];
+            node.min = bounds.min;
+            node.max = bounds.max;
+            node.maxScale = maxScale;
+            node.index = second;
+            node.count = 0;
+            return nodeIndex;
+        }
+    };
+} // namespace
+
+InstanceBVH::InstanceBVH()
+{
+}
+
+InstanceBVH::~InstanceBVH()
+{
+}
+
+void InstanceBVH::build(const vec3Array& translations, const vec3Array* scales, uint32_t firstInstance, uint32_t instanceCount, uint32_t maxInstancesPerLeaf)
+{
+    nodes.clear();
+    instances.clear();
+
+    // only index the instances that have a translation
+    uint32_t endInstance = std::min(firstInstance + instanceCount, static_cast<uint32_t>(translations.size()));
+    if (firstInstance >= endInstance) return;
+
+    // the largest absolute scale component of each instance, indexed by instance index
+    std::vector<float> maxScales(endInstance, 1.0f);
+    if (scales)
+    {
+        for (uint32_t i = firstInstance; i < endInstance && i < scales->size(); ++i)
+        {
+            const auto& s = scales->at(i);
+            maxScales[i] = std::max(std::fabs(s.x), std::max(std::fabs(s.y), std::fabs(s.z)));
+        }
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(endInstance - firstInstance);
+    for (uint32_t i = firstInstance; i < endInstance; ++i) order.push_back(i);
+
+    maxInstancesPerLeaf = std::max(maxInstancesPerLeaf, 1u);
+    nodes.reserve(2 * (order.size() / maxInstancesPerLeaf) + 1);
+
+    BuildInstanceBVH builder{translations, maxScales, order, nodes, maxInstancesPerLeaf};
+    builder.build(0, static_cast<uint32_t>(order.size()), 0);
+
+    instances = std::move(order);
+}
+
+void InstanceBVH::setSource(const Data* translations, const Data* scales, uint32_t first, uint32_t count)
+{
+    _translations = translations;
+    _scales = scales;
+    if (translations) translations->getModifiedCount(_translationsModifiedCount);
+    if (scales) scales->getModifiedCount(_scalesModifiedCount);
+    _first = first;
+    _count = count;
+}
+
+bool InstanceBVH::valid(const Data* translations, const Data* scales, uint32_t first, uint32_t count) const
+{
+    if (translations != _translations || scales != _scales || first != _first || count != _count) return false;
+    if (translations && translations->differentModifiedCount(_translationsModifiedCount)) return false;
+    if (scales && scales->differentModifiedCount(_scalesModifiedCount)) return false;
+    return _translations != nullptr;
+}
+
+void InstanceBVH::read(Input&)
+{
+    // the BVH is rebuilt on demand so isn't serialized, an InstanceBVH read from file is never valid.
+}
+
+void InstanceBVH::write(Output&) const
+{
+}
@@ -28,6 +28,8 @@ Instrumentation::~Instrumentation()
 {
 }
 
+std::atomic<const Instrumentation*> vsg::lockInstrumentation{nullptr};
+
 ref_ptr<Instrumentation> vsg::shareOrDuplicateForThreadSafety(ref_ptr<Instrumentation> instrumentation)
 {
     return instrumentation ? instrumentation->shareOrDuplicateForThreadSafety() : instrumentation;
@@ -0,0 +1,447 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/state/VertexInputState.h>
+#include <vsg/utils/InterleaveVertexArrays.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace vsg;
+
+namespace
+{
+    uint32_t alignTo4(size_t size)
+    {
+        return static_cast<uint32_t>((size + 3) & ~size_t(3));
+    }
+
+    // typed operations on the 1D Arrays that can be interleaved, Data of other types are left unsupported
+    struct ArrayOperation : public Visitor
+    {
+        enum Mode
+        {
+            CHECK,
+            ASSIGN_VIEW,
+            MAKE_CONTIGUOUS
+        };
+
+        explicit ArrayOperation(Mode in_mode) :
+            mode(in_mode) {}
+
+        Mode mode;
+        bool supported = false;
+
+        ref_ptr<Data> storage;
+        uint32_t offset = 0;
+        uint32_t stride = 0;
+
+        template<class A>
+        void arrayOperation(A& array)
+        {
+            using value_type = typename A::value_type;
+
+            supported = true;
+            switch (mode)
+            {
+            case (CHECK):
+                break;
+            case (ASSIGN_VIEW):
+                array.assign(storage, offset, stride, array.width(), array.properties);
+                break;
+            case (MAKE_CONTIGUOUS):
+                if (array.copyOnWrite())
+                {
+                    array.detachSharedData();
+                }
+                else if (array.storage())
+                {
+                    const A& source = array;
+                    uint32_t numElements = array.width();
+                    auto values = new value_type[numElements];
+                    std::copy(source.begin(), source.end(), values);
+
+                    auto properties = array.properties;
+                    properties.allocatorType = ALLOCATOR_TYPE_NEW_DELETE;
+                    array.assign(numElements, values, properties);
+                }
+                break;
+            }
+        }
+
+#define ARRAY_OPERATION(A) \
+    void apply(A& array) override { arrayOperation(array); }
+
+        ARRAY_OPERATION(byteArray)
+        ARRAY_OPERATION(ubyteArray)
+        ARRAY_OPERATION(shortArray)
+        ARRAY_OPERATION(ushortArray)
+        ARRAY_OPERATION(intArray)
+        ARRAY_OPERATION(uintArray)
+        ARRAY_OPERATION(floatArray)
+        ARRAY_OPERATION(doubleArray)
+        ARRAY_OPERATION(vec2Array)
+        ARRAY_OPERATION(vec3Array)
+        ARRAY_OPERATION(vec4Array)
+        ARRAY_OPERATION(dvec2Array)
+        ARRAY_OPERATION(dvec3Array)
+        ARRAY_OPERATION(dvec4Array)
+        ARRAY_OPERATION(bvec2Array)
+        ARRAY_OPERATION(bvec3Array)
+        ARRAY_OPERATION(bvec4Array)
+        ARRAY_OPERATION(ubvec2Array)
+        ARRAY_OPERATION(ubvec3Array)
+        ARRAY_OPERATION(ubvec4Array)
+        ARRAY_OPERATION(svec2Array)
+        ARRAY_OPERATION(svec3Array)
+        ARRAY_OPERATION(svec4Array)
+        ARRAY_OPERATION(usvec2Array)
+        ARRAY_OPERATION(usvec3Array)
+        ARRAY_OPERATION(usvec4Array)
+        ARRAY_OPERATION(ivec2Array)
+        ARRAY_OPERATION(ivec3Array)
+        ARRAY_OPERATION(ivec4Array)
+        ARRAY_OPERATION(uivec2Array)
+        ARRAY_OPERATION(uivec3Array)
+        ARRAY_OPERATION(uivec4Array)
+        ARRAY_OPERATION(mat4Array)
+        ARRAY_OPERATION(dmat4Array)
+
+#undef ARRAY_OPERATION
+    };
+
+    bool supportedArray(Data* data)
+    {
+        if (!data || !data->dataAvailable() || data->dimensions() != 1 || data->properties.mipLevels > 1) return false;
+
+        ArrayOperation check(ArrayOperation::CHECK);
+        data->accept(check);
+        return check.supported;
+    }
+
+    // copy the arrays into a new interleaved storage without modifying them
+    ref_ptr<ubyteArray> copyInterleaved(const DataList& arrays, std::vector<uint32_t>& offsets, uint32_t& stride)
+    {
+        if (arrays.empty() || !arrays.front()) return {};
+
+        uint32_t numElements = arrays.front()->width();
+        if (numElements == 0) return {};
+
+        offsets.clear();
+        stride = 0;
+        for (auto& array : arrays)
+        {
+            if (!supportedArray(array) || array->width() != numElements) return {};
+
+            offsets.push_back(stride);
+            stride += alignTo4(array->valueSize());
+        }
+
+        auto storage = ubyteArray::create(numElements * stride, uint8_t(0));
+        auto dest = storage->data();
+        for (size_t a = 0; a < arrays.size(); ++a)
+        {
+            const Data& array = *arrays[a];
+            size_t valueSize = array.valueSize();
+            for (uint32_t i = 0; i < numElements; ++i)
+            {
+                std::memcpy(dest + static_cast<size_t>(i) * stride + offsets[a], array.dataPointer(i), valueSize);
+            }
+        }
+        return storage;
+    }
+} // namespace
+
+ref_ptr<ubyteArray> vsg::interleaveArrays(const DataList& arrays, std::vector<uint32_t>* offsets)
+{
+    std::vector<uint32_t> arrayOffsets;
+    uint32_t stride = 0;
+    auto storage = copyInterleaved(arrays, arrayOffsets, stride);
+    if (!storage) return {};
+
+    ArrayOperation assignView(ArrayOperation::ASSIGN_VIEW);
+    assignView.storage = storage;
+    assignView.stride = stride;
+    for (size_t a = 0; a < arrays.size(); ++a)
+    {
+        assignView.offset = arrayOffsets[a];
+        arrays[a]->accept(assignView);
+    }
+
+    if (offsets) offsets->swap(arrayOffsets);
+    return storage;
+}
+
+ref_ptr<ubyteArray> vsg::packArrays(const DataList& arrays)
+{
+    if (arrays.empty()) return {};
+
+    std::vector<uint32_t> arrayOffsets;
+    uint32_t totalSize = 0;
+    for (auto& array : arrays)
+    {
+        if (!supportedArray(array)) return {};
+
+        arrayOffsets.push_back(totalSize);
+        totalSize += alignTo4(array->width() * array->valueSize());
+    }
+    if (totalSize == 0) return {};
+
+    auto storage = ubyteArray::create(totalSize, uint8_t(0));
+    auto dest = storage->data();
+    for (size_t a = 0; a < arrays.size(); ++a)
+    {
+        const Data& array = *arrays[a];
+        size_t valueSize = array.valueSize();
+        for (uint32_t i = 0; i < array.width(); ++i)
+        {
+            std::memcpy(dest + arrayOffsets[a] + i * valueSize, array.dataPointer(i), valueSize);
+        }
+    }
+
+    ArrayOperation assignView(ArrayOperation::ASSIGN_VIEW);
+    assignView.storage = storage;
+    for (size_t a = 0; a < arrays.size(); ++a)
+    {
+        assignView.offset = arrayOffsets[a];
+        assignView.stride = static_cast<uint32_t>(arrays[a]->valueSize());
+        arrays[a]->accept(assignView);
+    }
+
+    return storage;
+}
+
+void vsg::deinterleaveArrays(const DataList& arrays)
+{
+    ArrayOperation makeContiguous(ArrayOperation::MAKE_CONTIGUOUS);
+    for (auto& array : arrays)
+    {
+        if (array) array->accept(makeContiguous);
+    }
+}
+
+InterleaveVertexArrays::InterleaveVertexArrays()
+{
+}
+
+InterleaveVertexArrays::~InterleaveVertexArrays()
+{
+}
+
+void InterleaveVertexArrays::interleave(Node& node)
+{
+    _draws.clear();
+    _pipelineStack.clear();
+
+    node.accept(*this);
+
+    // draws reached through more than one pipeline can only be given one layout so those pipelines are left unchanged
+    std::map<const Node*, std::set<GraphicsPipeline*>> drawPipelines;
+    for (auto& [pipeline, draws] : _draws)
+    {
+        for (auto& draw : draws) drawPipelines[draw.node].insert(pipeline);
+    }
+
+    for (auto& [pipeline, draws] : _draws)
+    {
+        bool shared = std::any_of(draws.begin(), draws.end(), [&](const Draw& draw) { return drawPipelines[draw.node].size() > 1; });
+        if (!shared) _convert(*pipeline, draws);
+    }
+
+    _draws.clear();
+}
+
+void InterleaveVertexArrays::report(LogOutput& output) const
+{
+    output("InterleaveVertexArrays::report(..) ", this, " {");
+    output.in();
+    output("numDrawsConverted = ", numDrawsConverted);
+    output("numPipelinesUpdated = ", numPipelinesUpdated);
+    output("numBindingsBefore = ", numBindingsBefore);
+    output("numBindingsAfter = ", numBindingsAfter);
+    output.out();
+    output("}");
+}
+
+void InterleaveVertexArrays::apply(Node& node)
+{
+    // subgraphs are traversed for each path they're reached through so draws shared between pipelines are detected
+    node.traverse(*this);
+}
+
+void InterleaveVertexArrays::apply(StateGroup& stateGroup)
+{
+    GraphicsPipeline* pipeline = nullptr;
+    for (auto& stateCommand : stateGroup.stateCommands)
+    {
+        if (auto bindPipeline = stateCommand->cast<BindGraphicsPipeline>()) pipeline = bindPipeline->pipeline;
+    }
+
+    if (pipeline) _pipelineStack.push_back(pipeline);
+
+    stateGroup.traverse(*this);
+
+    if (pipeline) _pipelineStack.pop_back();
+}
+
+void InterleaveVertexArrays::apply(VertexIndexDraw& vid)
+{
+    _collect(vid, vid.firstBinding, vid.arrays);
+}
+
+void InterleaveVertexArrays::apply(VertexDraw& vd)
+{
+    _collect(vd, vd.firstBinding, vd.arrays);
+}
+
+void InterleaveVertexArrays::apply(Geometry& geometry)
+{
+    _collect(geometry, geometry.firstBinding, geometry.arrays);
+}
+
+void InterleaveVertexArrays::_collect(Node& node, uint32_t& firstBinding, BufferInfoList& arrays)
+{
+    if (_pipelineStack.empty()) return;
+
+    _draws[_pipelineStack.back()].push_back(Draw{&node, &firstBinding, &arrays});
+}
+
+void InterleaveVertexArrays::_convert(GraphicsPipeline& pipeline, std::vector<Draw>& draws)
+{
+    VertexInputState* vertexInputState = nullptr;
+    for (auto& pipelineState : pipeline.pipelineStates)
+    {
+        if (auto vis = pipelineState->cast<VertexInputState>()) vertexInputState = vis;
+    }
+    if (!vertexInputState || draws.empty()) return;
+
+    auto& bindings = vertexInputState->vertexBindingDescriptions;
+    auto& attributes = vertexInputState->vertexAttributeDescriptions;
+
+    // the draws must all bind one array per binding description starting from the same firstBinding
+    uint32_t firstBinding = *draws.front().firstBinding;
+    for (auto& draw : draws)
+    {
+        if (*draw.firstBinding != firstBinding || draw.arrays->size() != bindings.size()) return;
+    }
+    for (auto& binding : bindings)
+    {
+        if (binding.binding < firstBinding || (binding.binding - firstBinding) >= bindings.size()) return;
+    }
+
+    // per vertex bindings with a single attribute and tightly packed static arrays in every draw are interleaved
+    std::vector<const VkVertexInputBindingDescription*> interleavedBindings;
+    std::vector<const VkVertexInputBindingDescription*> separateBindings;
+    for (auto& binding : bindings)
+    {
+        auto numAttributes = std::count_if(attributes.begin(), attributes.end(), [&](const VkVertexInputAttributeDescription& a) { return a.binding == binding.binding; });
+        auto attribute = std::find_if(attributes.begin(), attributes.end(), [&](const VkVertexInputAttributeDescription& a) { return a.binding == binding.binding; });
+
+        bool suitable = binding.inputRate == VK_VERTEX_INPUT_RATE_VERTEX && numAttributes == 1 && attribute->offset == 0;
+        for (auto itr = draws.begin(); suitable && itr != draws.end(); ++itr)
+        {
+            auto& bufferInfo = (*itr->arrays)[binding.binding - firstBinding];
+            auto data = bufferInfo ? bufferInfo->data.get() : nullptr;
+            suitable = data && bufferInfo->offset == 0 && !data->dynamic() && supportedArray(data) &&
+                       data->properties.stride == data->valueSize() && binding.stride == data->valueSize();
+        }
+
+        if (suitable)
+            interleavedBindings.push_back(&binding);
+        else
+            separateBindings.push_back(&binding);
+    }
+
+    if (interleavedBindings.size() < 2) return;
+
+    // interleave the arrays of each draw, sharing the interleaved storage between draws that shared the same arrays
+    std::map<std::vector<const Data*>, std::pair<DataList, ref_ptr<BufferInfo>>> interleaved;
+    std::vector<uint32_t> offsets;
+    uint32_t stride = 0;
+    for (auto& draw : draws)
+    {
+        DataList drawArrays;
+        std::vector<const Data*> key;
+        for (auto binding : interleavedBindings)
+        {
+            auto& data = (*draw.arrays)[binding->binding - firstBinding]->data;
+            drawArrays.push_back(data);
+            key.push_back(data.get());
+        }
+        auto& entry = interleaved[key];
+        if (entry.second) continue;
+
+        entry.first = drawArrays;
+        auto storage = copyInterleaved(drawArrays, offsets, stride);
+        if (!storage) return; // arrays with different numbers of vertices
+        entry.second = BufferInfo::create(storage);
+    }
+
+    // assign the interleaved buffer followed by the separate arrays to each draw
+    std::set<const Node*> convertedDraws;
+    for (auto& draw : draws)
+    {
+        if (!convertedDraws.insert(draw.node).second) continue;
+
+        std::vector<const Data*> key;
+        for (auto binding : interleavedBindings) key.push_back((*draw.arrays)[binding->binding - firstBinding]->data.get());
+
+        BufferInfoList arrays{interleaved[key].second};
+        for (auto binding : separateBindings) arrays.push_back((*draw.arrays)[binding->binding - firstBinding]);
+        draw.arrays->swap(arrays);
+
+        ++numDrawsConverted;
+    }
+
+    // update the pipeline to match the interleaved layout, the interleaved binding takes firstBinding with the separate bindings following in their original order
+    std::map<uint32_t, uint32_t> bindingRemap;
+    std::map<uint32_t, uint32_t> attributeOffsets;
+    for (size_t i = 0; i < interleavedBindings.size(); ++i)
+    {
+        bindingRemap[interleavedBindings[i]->binding] = firstBinding;
+        attributeOffsets[interleavedBindings[i]->binding] = offsets[i];
+    }
+    for (size_t i = 0; i < separateBindings.size(); ++i)
+    {
+        bindingRemap[separateBindings[i]->binding] = firstBinding + 1 + static_cast<uint32_t>(i);
+    }
+
+    auto newVertexInputState = VertexInputState::create(*vertexInputState);
+    auto& newBindings = newVertexInputState->vertexBindingDescriptions;
+    newBindings.clear();
+    newBindings.push_back(VkVertexInputBindingDescription{firstBinding, stride, VK_VERTEX_INPUT_RATE_VERTEX});
+    for (auto binding : separateBindings)
+    {
+        newBindings.push_back(*binding);
+        newBindings.back().binding = bindingRemap[binding->binding];
+    }
+
+    for (auto& attribute : newVertexInputState->vertexAttributeDescriptions)
+    {
+        if (auto itr = attributeOffsets.find(attribute.binding); itr != attributeOffsets.end()) attribute.offset = itr->second;
+        attribute.binding = bindingRemap[attribute.binding];
+    }
+
+    numBindingsBefore += static_cast<uint32_t>(bindings.size());
+    numBindingsAfter += static_cast<uint32_t>(newBindings.size());
+    ++numPipelinesUpdated;
+
+    for (auto& pipelineState : pipeline.pipelineStates)
+    {
+        if (pipelineState == vertexInputState) pipelineState = newVertexInputState;
+    }
+}
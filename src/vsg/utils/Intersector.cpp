@@ -20,8 +20,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/CullNode.h>
 #include <vsg/nodes/DepthSorted.h>
 #include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/InstanceDraw.h>
+#include <vsg/nodes/InstanceDrawIndexed.h>
+#include <vsg/nodes/InstanceNode.h>
 #include <vsg/nodes/LOD.h>
+#include <vsg/nodes/PackedDraws.h>
 #include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/SpatialGrid.h>
 #include <vsg/nodes/StateGroup.h>
 #include <vsg/nodes/Transform.h>
 #include <vsg/nodes/VertexDraw.h>
@@ -29,10 +34,34 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/state/GraphicsPipeline.h>
 #include <vsg/text/CpuLayoutTechnique.h>
 #include <vsg/text/GpuLayoutTechnique.h>
+#include <vsg/utils/CompactInstanceArrays.h>
+#include <vsg/utils/InstanceBVH.h>
 #include <vsg/utils/Intersector.h>
 
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <typeinfo>
+
 using namespace vsg;
 
+// serializes building and caching of TriangleBVH on draw nodes that may be shared between Intersectors running on different threads
+static std::mutex s_triangleBVHMutex;
+
+// serializes building and caching of InstanceBVH on InstanceNode that may be shared between Intersectors running on different threads
+static std::mutex s_instanceBVHMutex;
+
+// bounding sphere of the vertices [first, first + count), invalid if there are none
+static dsphere vertexBound(const vec3Array& vertices, uint32_t first, uint32_t count)
+{
+    dbox bb;
+    uint32_t end = std::min(first + count, static_cast<uint32_t>(vertices.size()));
+    for (uint32_t i = first; i < end; ++i) bb.add(vertices[i]);
+
+    if (!bb.valid()) return {};
+    return dsphere((bb.min + bb.max) * 0.5, length(bb.max - bb.min) * 0.5);
+}
+
 struct PushPopNode
 {
     Intersector::NodePath& nodePath;
@@ -66,7 +95,7 @@ void Intersector::apply(const StateGroup& stategroup)
         statecommand->accept(*arrayState);
     }
 
-    arrayStateStack.emplace_back(arrayState);
+    arrayStateStack.emplace_back(std::move(arrayState));
 
     stategroup.traverse(*this);
 
@@ -132,6 +161,23 @@ void Intersector::apply(const CullGroup& cn)
     if (intersects(cn.bound)) cn.traverse(*this);
 }
 
+void Intersector::apply(const SpatialGrid& spatialGrid)
+{
+    PushPopNode ppn(_nodePath, &spatialGrid);
+
+    const auto& cells = spatialGrid.getCells();
+    const auto& cellBounds = spatialGrid.getCellBounds();
+    for (size_t c = 0; c < cells.size(); ++c)
+    {
+        if (cells[c].children.empty() || !intersects(cellBounds[c])) continue;
+
+        for (auto index : cells[c].children)
+        {
+            if (intersects(spatialGrid.bounds[index])) spatialGrid.children[index]->accept(*this);
+        }
+    }
+}
+
 void Intersector::apply(const DepthSorted& cn)
 {
     PushPopNode ppn(_nodePath, &cn);
@@ -179,6 +225,90 @@ void Intersector::apply(const Geometry& geometry)
     }
 }
 
+void Intersector::apply(const PackedDraws& packedDraws)
+{
+    if (!packedDraws.bindVertexBuffers || !packedDraws.bindIndexBuffer || !packedDraws.bindIndexBuffer->indices) return;
+
+    PushPopNode ppn(_nodePath, &packedDraws);
+
+    packedDraws.bindIndexBuffer->indices->accept(*this);
+
+    // ArrayState for each of the state sets, created when the first draw using it is intersected
+    std::vector<ref_ptr<ArrayState>> arrayStates(packedDraws.stateSets.size());
+
+    size_t count = packedDraws.numDraws();
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t stateIndex = packedDraws.stateIndices[i];
+        if (stateIndex >= arrayStates.size() || !intersects(dsphere(packedDraws.bounds[i]))) continue;
+
+        auto& arrayState = arrayStates[stateIndex];
+        if (!arrayState)
+        {
+            arrayState = arrayStateStack.back()->cloneArrayState();
+            for (auto& stateCommand : packedDraws.stateSets[stateIndex]) stateCommand->accept(*arrayState);
+            arrayState->apply(*packedDraws.bindVertexBuffers);
+        }
+        if (!arrayState->vertices) continue;
+
+        arrayStateStack.push_back(arrayState);
+        intersectDrawIndexed(packedDraws.firstIndices[i], packedDraws.indexCounts[i], 0, 1);
+        arrayStateStack.pop_back();
+    }
+}
+
+void Intersector::apply(const InstanceNode& in)
+{
+    PushPopNode ppn(_nodePath, &in);
+
+    auto arrayState = arrayStateStack.back()->cloneArrayState();
+    arrayState->apply(in);
+
+    arrayStateStack.emplace_back(std::move(arrayState));
+    auto previousInstanceNode = instanceNode;
+    instanceNode = &in;
+
+    in.traverse(*this);
+
+    instanceNode = previousInstanceNode;
+    arrayStateStack.pop_back();
+}
+
+void Intersector::apply(const InstanceDraw& id)
+{
+    if (!instanceNode) return;
+
+    auto& arrayState = *arrayStateStack.back();
+    arrayState.apply(id);
+    if (!arrayState.vertices) return;
+
+    PushPopNode ppn(_nodePath, &id);
+
+    // only the instances whose transformed bound is reached have their triangles tested
+    for (auto instanceIndex : candidateInstances(vertexBound(*arrayState.vertices, id.firstVertex, id.vertexCount)))
+    {
+        intersectDraw(id.firstVertex, id.vertexCount, instanceIndex, 1);
+    }
+}
+
+void Intersector::apply(const InstanceDrawIndexed& idi)
+{
+    if (!instanceNode || !idi.indices) return;
+
+    auto& arrayState = *arrayStateStack.back();
+    arrayState.apply(idi);
+    if (!arrayState.vertices) return;
+
+    idi.indices->accept(*this);
+
+    PushPopNode ppn(_nodePath, &idi);
+
+    for (auto instanceIndex : candidateInstances(vertexBound(*arrayState.vertices, 0, static_cast<uint32_t>(arrayState.vertices->size()))))
+    {
+        intersectDrawIndexed(idi.firstIndex, idi.indexCount, instanceIndex, 1);
+    }
+}
+
 void Intersector::apply(const BindVertexBuffers& bvb)
 {
     arrayStateStack.back()->apply(bvb);
@@ -242,3 +372,150 @@ void Intersector::apply(const DrawIndexed& drawIndexed)
 
     intersectDrawIndexed(drawIndexed.firstIndex, drawIndexed.indexCount, drawIndexed.firstInstance, drawIndexed.instanceCount);
 }
+
+ref_ptr<const TriangleBVH> Intersector::getTriangleBVH(uint32_t first, uint32_t count, bool indexed)
+{
+    uint32_t numTriangles = count / 3;
+    if (triangleBVHThreshold == 0 || numTriangles < triangleBVHThreshold || _nodePath.empty()) return {};
+
+    auto& arrayState = *arrayStateStack.back();
+    if (arrayState.topology != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST || !arrayState.vertices || typeid(arrayState) != typeid(ArrayState)) return {};
+
+    const vec3Array& vertices = *arrayState.vertices;
+    const Data* verticesData = vertices.storage() ? vertices.storage() : &vertices;
+    const Data* indicesData = nullptr;
+    if (indexed)
+    {
+        if (ubyte_indices)
+            indicesData = ubyte_indices;
+        else if (ushort_indices)
+            indicesData = ushort_indices;
+        else if (uint_indices)
+            indicesData = uint_indices;
+        else
+            return {};
+    }
+
+    std::scoped_lock<std::mutex> lock(s_triangleBVHMutex);
+
+    const Node* drawNode = _nodePath.back();
+    if (auto bvh = drawNode->getObject<TriangleBVH>("TriangleBVH"); bvh && bvh->valid(verticesData, indicesData, first, count))
+    {
+        return ref_ptr<const TriangleBVH>(bvh);
+    }
+
+    std::vector<uivec3> triangles;
+    triangles.reserve(numTriangles);
+
+    auto collectTriangles = [&](const auto& indices) {
+        uint32_t endIndex = std::min(first + numTriangles * 3, static_cast<uint32_t>(indices.size()));
+        for (uint32_t i = first; (i + 2) < endIndex; i += 3)
+        {
+            triangles.emplace_back(indices.at(i), indices.at(i + 1), indices.at(i + 2));
+        }
+    };
+
+    if (ubyte_indices && indexed)
+        collectTriangles(*ubyte_indices);
+    else if (ushort_indices && indexed)
+        collectTriangles(*ushort_indices);
+    else if (uint_indices && indexed)
+        collectTriangles(*uint_indices);
+    else
+    {
+        for (uint32_t i = 0; i < numTriangles; ++i)
+        {
+            uint32_t v = first + i * 3;
+            triangles.emplace_back(v, v + 1, v + 2);
+        }
+    }
+
+    auto bvh = TriangleBVH::create();
+    bvh->build(vertices, std::move(triangles));
+    bvh->setSource(verticesData, indicesData, first, count);
+
+    const_cast<Node*>(drawNode)->setObject("TriangleBVH", bvh);
+
+    return bvh;
+}
+
+const std::vector<uint32_t>& Intersector::candidateInstances(const dsphere& localBound)
+{
+    _candidateInstances.clear();
+    if (!instanceNode || !localBound.valid()) return _candidateInstances;
+
+    // the per instance arrays may be in the compact formats set up by CompactInstanceArrays, so decode rather than cast them
+    auto arrayData = [](const ref_ptr<BufferInfo>& bufferInfo) -> const Data* { return bufferInfo ? bufferInfo->data.get() : nullptr; };
+    const Data* translationsData = arrayData(instanceNode->translations);
+    const Data* rotationsData = arrayData(instanceNode->rotations);
+    const Data* scalesData = arrayData(instanceNode->scales);
+
+    // transform localBound in the same order as the instanced vertex shaders, scale, then rotate, then translate
+    auto intersectInstance = [&](uint32_t i) {
+        dvec3 center = localBound.center;
+        double radius = localBound.radius;
+        vec3 scale;
+        if (CompactInstanceArrays::decodeScale(scalesData, i, scale))
+        {
+            center = center * dvec3(scale);
+            radius *= std::max(std::fabs(scale.x), std::max(std::fabs(scale.y), std::fabs(scale.z)));
+        }
+        quat rotation;
+        if (CompactInstanceArrays::decodeRotation(rotationsData, i, rotation)) center = dquat(rotation) * center;
+        vec3 translation;
+        if (CompactInstanceArrays::decodeTranslation(translationsData, i, translation)) center += dvec3(translation);
+
+        if (intersects(dsphere(center, radius))) _candidateInstances.push_back(i);
+    };
+
+    if (translationsData && instanceBVHThreshold > 0 && instanceNode->instanceCount >= instanceBVHThreshold)
+    {
+        ref_ptr<const InstanceBVH> bvh;
+        {
+            std::scoped_lock<std::mutex> lock(s_instanceBVHMutex);
+
+            auto cached = instanceNode->getObject<InstanceBVH>("InstanceBVH");
+            if (cached && cached->valid(translationsData, scalesData, instanceNode->firstInstance, instanceNode->instanceCount))
+            {
+                bvh = cached;
+            }
+            else
+            {
+                // the InstanceBVH is built from float arrays, so decode compact arrays into temporary ones
+                auto decodeArray = [](const Data* data, auto decode) {
+                    auto decoded = vec3Array::create(static_cast<uint32_t>(data->valueCount()));
+                    for (uint32_t i = 0; i < decoded->size(); ++i) decode(data, i, decoded->at(i));
+                    return decoded;
+                };
+
+                ref_ptr<const vec3Array> translations(translationsData->cast<vec3Array>());
+                if (!translations) translations = decodeArray(translationsData, CompactInstanceArrays::decodeTranslation);
+
+                ref_ptr<const vec3Array> scales(scalesData ? scalesData->cast<vec3Array>() : nullptr);
+                if (scalesData && !scales) scales = decodeArray(scalesData, CompactInstanceArrays::decodeScale);
+
+                auto new_bvh = InstanceBVH::create();
+                new_bvh->build(*translations, scales.get(), instanceNode->firstInstance, instanceNode->instanceCount);
+                new_bvh->setSource(translationsData, scalesData, instanceNode->firstInstance, instanceNode->instanceCount);
+
+                const_cast<InstanceNode*>(instanceNode)->setObject("InstanceBVH", new_bvh);
+                bvh = new_bvh;
+            }
+        }
+
+        bvh->intersect(
+            localBound, [&](const dsphere& bound) { return intersects(bound); }, intersectInstance);
+
+        // keep the instances in the same order as the linear search
+        std::sort(_candidateInstances.begin(), _candidateInstances.end());
+        return _candidateInstances;
+    }
+
+    uint32_t endInstance = instanceNode->firstInstance + instanceNode->instanceCount;
+    for (uint32_t i = instanceNode->firstInstance; i < endInstance; ++i)
+    {
+        intersectInstance(i);
+    }
+
+    return _candidateInstances;
+}
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/nodes/Transform.h>
 #include <vsg/utils/LineSegmentIntersector.h>
+#include <vsg/utils/PrimitiveFunctor.h>
 
 using namespace vsg;
 
@@ -34,6 +35,7 @@ struct TriangleIntersector
     vec_type _d_invZ;
 
     LineSegmentIntersector& intersector;
+    ArrayState* arrayState = nullptr;
     ref_ptr<const vec3Array> vertices;
 
     TriangleIntersector(LineSegmentIntersector& in_intersector, const dvec3& in_start, const dvec3& in_end, ref_ptr<const vec3Array> in_vertices) :
@@ -41,6 +43,21 @@ struct TriangleIntersector
         end(in_end),
         intersector(in_intersector),
         vertices(in_vertices)
+    {
+        init();
+    }
+
+    /// constructor used by PrimitiveFunctor, the vertices of each instance are provided by the arrayState
+    TriangleIntersector(LineSegmentIntersector& in_intersector, const dvec3& in_start, const dvec3& in_end, ArrayState& in_arrayState) :
+        start(in_start),
+        end(in_end),
+        intersector(in_intersector),
+        arrayState(&in_arrayState)
+    {
+        init();
+    }
+
+    void init()
     {
 
         _d = end - start;
@@ -127,8 +144,27 @@ struct TriangleIntersector
 
         return true;
     }
+
+    //
+    // PrimitiveFunctor interface, only triangles are intersected
+    //
+    bool instance(uint32_t index)
+    {
+        vertices = arrayState->vertexArray(index);
+        instanceIndex = index;
+        return vertices.valid();
+    }
+
+    void point(uint32_t) {}
+    void line(uint32_t, uint32_t) {}
+    void triangle(uint32_t i0, uint32_t i1, uint32_t i2) { intersect(i0, i1, i2); }
 };
 
+static bool triangleTopology(VkPrimitiveTopology topology)
+{
+    return topology == VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST || topology == VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP || topology == VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN;
+}
+
 LineSegmentIntersector::LineSegmentIntersector(const dvec3& s, const dvec3& e, ref_ptr<ArrayState> initialArrayData) :
     Inherit(initialArrayData)
 {
@@ -247,61 +283,64 @@ bool LineSegmentIntersector::intersects(const dsphere& bs)
 bool LineSegmentIntersector::intersectDraw(uint32_t firstVertex, uint32_t vertexCount, uint32_t firstInstance, uint32_t instanceCount)
 {
     auto& arrayState = *arrayStateStack.back();
-    if (arrayState.topology != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST || vertexCount < 3) return false;
+    if (!triangleTopology(arrayState.topology) || vertexCount < 3) return false;
 
     const auto& ls = _lineSegmentStack.back();
 
     size_t previous_size = intersections.size();
-    uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
-    for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
+
+    if (auto bvh = getTriangleBVH(firstVertex, vertexCount, false))
     {
-        TriangleIntersector<double> triIntersector(*this, ls.start, ls.end, arrayState.vertexArray(instanceIndex));
-        if (!triIntersector.vertices) return false;
+        uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
+        for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
+        {
+            TriangleIntersector<double> triIntersector(*this, ls.start, ls.end, arrayState.vertexArray(instanceIndex));
+            if (!triIntersector.vertices) continue;
 
-        uint32_t endVertex = int((firstVertex + vertexCount) / 3.0f) * 3;
+            triIntersector.instanceIndex = instanceIndex;
 
-        for (uint32_t i = firstVertex; i < endVertex; i += 3)
-        {
-            triIntersector.intersect(i, i + 1, i + 2);
+            bvh->intersect(ls.start, ls.end, [&](uint32_t i0, uint32_t i1, uint32_t i2) { triIntersector.intersect(i0, i1, i2); });
         }
+        return intersections.size() != previous_size;
     }
 
+    PrimitiveFunctor<TriangleIntersector<double>> triIntersector(*this, ls.start, ls.end, arrayState);
+    triIntersector.draw(arrayState.topology, firstVertex, vertexCount, firstInstance, instanceCount);
+
     return intersections.size() != previous_size;
 }
 
 bool LineSegmentIntersector::intersectDrawIndexed(uint32_t firstIndex, uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount)
 {
     auto& arrayState = *arrayStateStack.back();
-    if (arrayState.topology != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST || indexCount < 3) return false;
+    if (!triangleTopology(arrayState.topology) || indexCount < 3) return false;
 
     const auto& ls = _lineSegmentStack.back();
 
     size_t previous_size = intersections.size();
-    uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
-    for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
-    {
-        TriangleIntersector<double> triIntersector(*this, ls.start, ls.end, arrayState.vertexArray(instanceIndex));
-        if (!triIntersector.vertices) continue;
 
-        triIntersector.instanceIndex = instanceIndex;
+    if (auto bvh = getTriangleBVH(firstIndex, indexCount, true))
+    {
+        uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
+        for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
+        {
+            TriangleIntersector<double> triIntersector(*this, ls.start, ls.end, arrayState.vertexArray(instanceIndex));
+            if (!triIntersector.vertices) continue;
 
-        uint32_t endIndex = int((firstIndex + indexCount) / 3.0f) * 3;
+            triIntersector.instanceIndex = instanceIndex;
 
-        if (ushort_indices)
-        {
-            for (uint32_t i = firstIndex; i < endIndex; i += 3)
-            {
-                triIntersector.intersect(ushort_indices->at(i), ushort_indices->at(i + 1), ushort_indices->at(i + 2));
-            }
-        }
-        else if (uint_indices)
-        {
-            for (uint32_t i = firstIndex; i < endIndex; i += 3)
-            {
-                triIntersector.intersect(uint_indices->at(i), uint_indices->at(i + 1), uint_indices->at(i + 2));
-            }
+            bvh->intersect(ls.start, ls.end, [&](uint32_t i0, uint32_t i1, uint32_t i2) { triIntersector.intersect(i0, i1, i2); });
         }
+        return intersections.size() != previous_size;
     }
 
+    PrimitiveFunctor<TriangleIntersector<double>> triIntersector(*this, ls.start, ls.end, arrayState);
+    if (ubyte_indices)
+        triIntersector.drawIndexed(arrayState.topology, ubyte_indices, firstIndex, indexCount, firstInstance, instanceCount);
+    else if (ushort_indices)
+        triIntersector.drawIndexed(arrayState.topology, ushort_indices, firstIndex, indexCount, firstInstance, instanceCount);
+    else if (uint_indices)
+        triIntersector.drawIndexed(arrayState.topology, uint_indices, firstIndex, indexCount, firstInstance, instanceCount);
+
     return intersections.size() != previous_size;
 }
@@ -18,6 +18,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/MatrixTransform.h>
 #include <vsg/nodes/PagedLOD.h>
 #include <vsg/utils/LoadPagedLOD.h>
+#include <vsg/vk/ResourceRequirements.h>
 
 using namespace vsg;
 
@@ -132,7 +133,26 @@ void LoadPagedLOD::apply(PagedLOD& plod)
                     _pathStack.push_back(_pathStack.back() / localPath);
             }
 
-            if (!child.node)
+            if (!child.node && _deferLoading)
+            {
+                // load(..) reads the tiles of each level concurrently, so queue the tile along with the traversal state required to continue from it.
+                if (budgetExceeded())
+                {
+                    ++numTilesSkipped;
+                }
+                else if (_pendingPagedLODs.insert(&plod).second)
+                {
+                    PendingTile tile;
+                    tile.plod = &plod;
+                    tile.childIndex = static_cast<size_t>(&child - plod.children.data());
+                    tile.filename = filename;
+                    tile.modelview = modelviewMatrixStack.top();
+                    tile.pathStack = _pathStack;
+                    tile.level = level;
+                    _pendingTiles.push_back(tile);
+                }
+            }
+            else if (!child.node)
             {
                 child.node = read_cast<Node>(filename, plod.options);
                 ++numTiles;
@@ -149,3 +169,140 @@ void LoadPagedLOD::apply(PagedLOD& plod)
         }
     }
 }
+
+unsigned int LoadPagedLOD::load(ref_ptr<Node> node)
+{
+    if (!node) return 0;
+
+    unsigned int numTilesBefore = numTiles;
+
+    _deferLoading = true;
+    _pendingTiles.clear();
+    _pendingPagedLODs.clear();
+
+    node->accept(*this);
+
+    while (!_pendingTiles.empty())
+    {
+        PendingTiles tiles;
+        tiles.swap(_pendingTiles);
+        _pendingPagedLODs.clear();
+
+        _loadPendingTiles(tiles);
+
+        // continue the traversal from each of the loaded tiles to collect the tiles of the next level
+        for (auto& tile : tiles)
+        {
+            if (!tile.node) continue;
+
+            memoryUsed += tile.memory;
+            ++numTiles;
+
+            auto& child = tile.plod->children[tile.childIndex];
+            if (!child.node) child.node = tile.node;
+
+            auto savedPathStack = _pathStack;
+            auto savedLevel = level;
+
+            modelviewMatrixStack.push(tile.modelview);
+            pushFrustum();
+            _pathStack = tile.pathStack;
+            level = tile.level;
+
+            child.node->accept(*this);
+
+            level = savedLevel;
+            _pathStack = savedPathStack;
+            _frustumStack.pop();
+            modelviewMatrixStack.pop();
+        }
+    }
+
+    _deferLoading = false;
+    _pendingPagedLODs.clear();
+
+    return numTiles - numTilesBefore;
+}
+
+void LoadPagedLOD::_loadTile(PendingTile& tile)
+{
+    tile.node = read_cast<Node>(tile.filename, tile.plod->options);
+    if (tile.node)
+    {
+        CollectResourceRequirements collectRequirements;
+        tile.node->accept(collectRequirements);
+
+        uint64_t cpuMemory = 0;
+        uint64_t gpuMemory = 0;
+        collectRequirements.requirements.computeMemoryUsage(cpuMemory, gpuMemory);
+        tile.memory = gpuMemory;
+
+        if (compileManager)
+        {
+            auto result = compileManager->compile(tile.node);
+            if (result)
+            {
+                std::scoped_lock<std::mutex> lock(_progressMutex);
+                compileResult.add(result);
+            }
+            else
+            {
+                warn("LoadPagedLOD unable to compile ", tile.filename, ", ", result.message);
+                tile.node = {};
+            }
+        }
+    }
+
+    std::scoped_lock<std::mutex> lock(_progressMutex);
+    ++_numLoaded;
+    --_numPending;
+    if (progress) progress(*this, _numLoaded, _numPending);
+}
+
+void LoadPagedLOD::_loadPendingTiles(PendingTiles& tiles)
+{
+    {
+        std::scoped_lock<std::mutex> lock(_progressMutex);
+        _numPending += static_cast<unsigned int>(tiles.size());
+    }
+
+    auto threads = operationThreads;
+    if (!threads && !tiles.empty() && tiles.front().plod->options) threads = tiles.front().plod->options->operationThreads;
+
+    if (threads && tiles.size() > 1)
+    {
+        struct LoadTileOperation : public Operation
+        {
+            LoadTileOperation(LoadPagedLOD* in_loader, PendingTile& in_tile, ref_ptr<Latch> in_latch) :
+                loader(in_loader),
+                tile(in_tile),
+                latch(in_latch) {}
+
+            void run() override
+            {
+                loader->_loadTile(tile);
+                latch->count_down();
+            }
+
+            LoadPagedLOD* loader;
+            PendingTile& tile;
+            ref_ptr<Latch> latch;
+        };
+
+        auto latch = Latch::create(tiles.size());
+        for (auto& tile : tiles)
+        {
+            threads->add(ref_ptr<Operation>(new LoadTileOperation(this, tile, latch)));
+        }
+
+        // use this thread to load tiles as well while waiting for all the tiles to be loaded
+        threads->wait(*latch);
+    }
+    else
+    {
+        for (auto& tile : tiles)
+        {
+            _loadTile(tile);
+        }
+    }
+}
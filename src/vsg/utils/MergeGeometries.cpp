@@ -0,0 +1,373 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/Logger.h>
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/utils/MergeGeometries.h>
+
+#include <limits>
+#include <typeinfo>
+
+using namespace vsg;
+
+namespace
+{
+    struct CountParents : public Visitor
+    {
+        explicit CountParents(std::map<const Node*, uint32_t>& in_parentCounts) :
+            parentCounts(in_parentCounts) {}
+
+        std::map<const Node*, uint32_t>& parentCounts;
+
+        void apply(Node& node) override
+        {
+            if (++parentCounts[&node] == 1) node.traverse(*this);
+        }
+    };
+
+    template<class A>
+    ref_ptr<Data> mergeArrays(const std::vector<const Data*>& sources, uint32_t numValues)
+    {
+        auto merged = A::create(numValues);
+        merged->properties.format = sources.front()->properties.format;
+
+        size_t i = 0;
+        for (auto source : sources)
+        {
+            for (auto& value : *static_cast<const A*>(source)) merged->at(i++) = value;
+        }
+        return merged;
+    }
+
+    // merge the arrays into a single array, returns null if the array type isn't supported.
+    ref_ptr<Data> mergeArrays(const std::vector<const Data*>& sources, uint32_t numValues)
+    {
+        const auto& type = typeid(*sources.front());
+        if (type == typeid(vec3Array)) return mergeArrays<vec3Array>(sources, numValues);
+        if (type == typeid(vec2Array)) return mergeArrays<vec2Array>(sources, numValues);
+        if (type == typeid(vec4Array)) return mergeArrays<vec4Array>(sources, numValues);
+        if (type == typeid(floatArray)) return mergeArrays<floatArray>(sources, numValues);
+        if (type == typeid(ubvec4Array)) return mergeArrays<ubvec4Array>(sources, numValues);
+        if (type == typeid(usvec2Array)) return mergeArrays<usvec2Array>(sources, numValues);
+        if (type == typeid(usvec4Array)) return mergeArrays<usvec4Array>(sources, numValues);
+        if (type == typeid(uintArray)) return mergeArrays<uintArray>(sources, numValues);
+        return {};
+    }
+
+    bool supportedArrayType(const std::type_info& type)
+    {
+        return type == typeid(vec3Array) || type == typeid(vec2Array) || type == typeid(vec4Array) || type == typeid(floatArray) ||
+               type == typeid(ubvec4Array) || type == typeid(usvec2Array) || type == typeid(usvec4Array) || type == typeid(uintArray);
+    }
+
+    bool supportedIndexType(const std::type_info& type)
+    {
+        return type == typeid(ushortArray) || type == typeid(uintArray) || type == typeid(ubyteArray);
+    }
+
+    // copy indices, rebasing them to the merged vertex arrays. The maximum index value is treated as a primitive restart
+    // when it can't reference a vertex, and is mapped to the restart value of the merged indices.
+    template<class S, class D>
+    void copyIndices(const S& source, uint32_t firstIndex, uint32_t indexCount, uint32_t numVertices, uint32_t base, D& dest, size_t& pos)
+    {
+        using source_type = typename S::value_type;
+        using dest_type = typename D::value_type;
+
+        const bool restartPossible = numVertices <= std::numeric_limits<source_type>::max();
+        for (uint32_t i = firstIndex; i < firstIndex + indexCount; ++i)
+        {
+            auto index = source.at(i);
+            if (restartPossible && index == std::numeric_limits<source_type>::max())
+                dest.at(pos++) = std::numeric_limits<dest_type>::max();
+            else
+                dest.at(pos++) = static_cast<dest_type>(index + base);
+        }
+    }
+
+    template<class D>
+    void copyIndices(const Data* source, uint32_t firstIndex, uint32_t indexCount, uint32_t numVertices, uint32_t base, D& dest, size_t& pos)
+    {
+        if (auto us = source->cast<ushortArray>())
+            copyIndices(*us, firstIndex, indexCount, numVertices, base, dest, pos);
+        else if (auto ui = source->cast<uintArray>())
+            copyIndices(*ui, firstIndex, indexCount, numVertices, base, dest, pos);
+        else if (auto ub = source->cast<ubyteArray>())
+            copyIndices(*ub, firstIndex, indexCount, numVertices, base, dest, pos);
+    }
+
+    uint32_t numVertices(const VertexIndexDraw& vid)
+    {
+        return static_cast<uint32_t>(vid.arrays.front()->data->valueCount());
+    }
+} // namespace
+
+MergeGeometries::MergeGeometries()
+{
+}
+
+MergeGeometries::~MergeGeometries()
+{
+}
+
+bool MergeGeometries::_isShared(const Node* node) const
+{
+    auto itr = _parentCounts.find(node);
+    return itr != _parentCounts.end() && itr->second > 1;
+}
+
+void MergeGeometries::merge(Node& node)
+{
+    _parentCounts.clear();
+    _visited.clear();
+
+    CountParents countParents(_parentCounts);
+    node.accept(countParents);
+
+    node.accept(*this);
+
+    _parentCounts.clear();
+    _visited.clear();
+}
+
+void MergeGeometries::apply(Node& node)
+{
+    if (_visited.insert(&node).second) node.traverse(*this);
+}
+
+void MergeGeometries::apply(Group& group)
+{
+    if (!_visited.insert(&group).second) return;
+
+    std::map<Layout, std::vector<Candidate>> candidates;
+    _collect(group, dmat4(), false, candidates);
+
+    MergedDraws merged;
+    Group::Children mergedDraws;
+    for (auto& [layout, draws] : candidates)
+    {
+        std::vector<Candidate> batch;
+        uint64_t batchNumVertices = 0;
+
+        auto flush = [&, &layout = layout]() {
+            if (batch.size() >= minimumNumDraws)
+            {
+                if (auto vid = _merge(layout, batch))
+                {
+                    mergedDraws.push_back(vid);
+                    for (auto& candidate : batch) merged.emplace(candidate.parent, candidate.vertexIndexDraw.get());
+                    numDrawsMerged += static_cast<uint32_t>(batch.size());
+                    ++numMergedDraws;
+                }
+            }
+            batch.clear();
+            batchNumVertices = 0;
+        };
+
+        for (auto& candidate : draws)
+        {
+            auto count = numVertices(*candidate.vertexIndexDraw);
+            if (!batch.empty() && (batchNumVertices + count) > maxNumVertices) flush();
+
+            batch.push_back(candidate);
+            batchNumVertices += count;
+        }
+        flush();
+    }
+
+    if (!merged.empty()) _prune(group, merged);
+
+    // merge geometries in the subgraphs that couldn't be collected such as those beneath StateGroup, CullGroup and LOD nodes.
+    for (auto& child : group.children) child->accept(*this);
+
+    group.children.insert(group.children.end(), mergedDraws.begin(), mergedDraws.end());
+}
+
+void MergeGeometries::_collect(Group& group, const dmat4& matrix, bool transformed, std::map<Layout, std::vector<Candidate>>& candidates)
+{
+    for (auto& child : group.children)
+    {
+        auto node = child.get();
+        const auto& type = typeid(*node);
+        if (type == typeid(VertexIndexDraw))
+        {
+            auto vid = static_cast<VertexIndexDraw*>(node);
+            if (!_mergeable(*vid, transformed)) continue;
+
+            Layout layout;
+            layout.firstBinding = vid->firstBinding;
+            for (auto& bufferInfo : vid->arrays) layout.arrayTypes.emplace_back(typeid(*bufferInfo->data));
+
+            candidates[layout].push_back(Candidate{ref_ptr<VertexIndexDraw>(vid), &group, matrix, transformed});
+        }
+        else if (_isShared(node))
+        {
+            continue;
+        }
+        else if (type == typeid(Group))
+        {
+            _collect(static_cast<Group&>(*node), matrix, transformed, candidates);
+        }
+        else if (preTransform && type == typeid(MatrixTransform))
+        {
+            auto& transform = static_cast<MatrixTransform&>(*node);
+            _collect(transform, matrix * transform.matrix, true, candidates);
+        }
+    }
+}
+
+bool MergeGeometries::_mergeable(const VertexIndexDraw& vid, bool transformed) const
+{
+    if (vid.instanceCount != 1 || vid.firstInstance != 0 || vid.arrays.empty() || !vid.indices || !vid.indices->data) return false;
+
+    auto indices = vid.indices->data.get();
+    if (indices->dynamic() || !indices->dataAvailable() || !supportedIndexType(typeid(*indices))) return false;
+    if (static_cast<size_t>(vid.firstIndex) + vid.indexCount > indices->valueCount()) return false;
+
+    // all arrays must be per vertex arrays, per instance arrays will have a different size
+    if (!vid.arrays.front() || !vid.arrays.front()->data) return false;
+    auto count = vid.arrays.front()->data->valueCount();
+    if (count == 0) return false;
+
+    for (auto& bufferInfo : vid.arrays)
+    {
+        if (!bufferInfo || !bufferInfo->data) return false;
+
+        auto& data = *bufferInfo->data;
+        if (data.dynamic() || !data.dataAvailable() || data.valueCount() != count || !supportedArrayType(typeid(data))) return false;
+    }
+
+    if (transformed && (vertexArrayIndex >= vid.arrays.size() || typeid(*vid.arrays[vertexArrayIndex]->data) != typeid(vec3Array))) return false;
+
+    return true;
+}
+
+ref_ptr<VertexIndexDraw> MergeGeometries::_merge(const Layout& layout, const std::vector<Candidate>& batch) const
+{
+    uint32_t totalNumVertices = 0;
+    uint32_t totalNumIndices = 0;
+    for (auto& candidate : batch)
+    {
+        totalNumVertices += numVertices(*candidate.vertexIndexDraw);
+        totalNumIndices += candidate.vertexIndexDraw->indexCount;
+    }
+
+    DataList arrays;
+    for (size_t i = 0; i < layout.arrayTypes.size(); ++i)
+    {
+        std::vector<const Data*> sources;
+        for (auto& candidate : batch) sources.push_back(candidate.vertexIndexDraw->arrays[i]->data.get());
+
+        auto array = mergeArrays(sources, totalNumVertices);
+        if (!array) return {};
+        arrays.push_back(array);
+    }
+
+    auto vertices = (vertexArrayIndex < arrays.size()) ? arrays[vertexArrayIndex].cast<vec3Array>() : ref_ptr<vec3Array>();
+    auto normals = (normalArrayIndex >= 0 && static_cast<size_t>(normalArrayIndex) < arrays.size()) ? arrays[normalArrayIndex].cast<vec3Array>() : ref_ptr<vec3Array>();
+
+    ref_ptr<Data> indices;
+    if (totalNumVertices < std::numeric_limits<uint16_t>::max())
+        indices = ushortArray::create(totalNumIndices);
+    else
+        indices = uintArray::create(totalNumIndices);
+
+    uint32_t base = 0;
+    size_t pos = 0;
+    for (auto& candidate : batch)
+    {
+        auto& vid = *candidate.vertexIndexDraw;
+        auto count = numVertices(vid);
+
+        if (candidate.transformed)
+        {
+            const auto& matrix = candidate.matrix;
+            if (vertices->properties.stride == sizeof(vec3))
+            {
+                vsg::transform(matrix, vertices->data(base), vertices->data(base), count);
+            }
+            else
+            {
+                for (uint32_t i = base; i < base + count; ++i)
+                {
+                    auto& v = vertices->at(i);
+                    v = vec3(matrix * dvec3(v));
+                }
+            }
+
+            if (normals)
+            {
+                // transform normals by the inverse transpose so that they remain perpendicular under non uniform scaling
+                auto inverseMatrix = inverse(matrix);
+                for (uint32_t i = base; i < base + count; ++i)
+                {
+                    auto& n = normals->at(i);
+                    auto tn = dvec4(n.x, n.y, n.z, 0.0) * inverseMatrix;
+                    n = vec3(normalize(dvec3(tn.x, tn.y, tn.z)));
+                }
+            }
+        }
+
+        auto sourceIndices = vid.indices->data.get();
+        auto indexBase = base + vid.vertexOffset;
+        if (auto us = indices.cast<ushortArray>())
+            copyIndices(sourceIndices, vid.firstIndex, vid.indexCount, count, indexBase, *us, pos);
+        else if (auto ui = indices.cast<uintArray>())
+            copyIndices(sourceIndices, vid.firstIndex, vid.indexCount, count, indexBase, *ui, pos);
+
+        base += count;
+    }
+
+    auto vid = VertexIndexDraw::create();
+    vid->firstBinding = layout.firstBinding;
+    vid->assignArrays(arrays);
+    vid->assignIndices(indices);
+    vid->indexCount = totalNumIndices;
+    vid->instanceCount = 1;
+    return vid;
+}
+
+bool MergeGeometries::_prune(Group& group, const MergedDraws& merged)
+{
+    auto& children = group.children;
+    for (auto itr = children.begin(); itr != children.end();)
+    {
+        auto node = itr->get();
+        bool remove = merged.count({&group, node}) > 0;
+        if (!remove && !_isShared(node))
+        {
+            const auto& type = typeid(*node);
+            if (type == typeid(Group) || (preTransform && type == typeid(MatrixTransform)))
+            {
+                auto& child = static_cast<Group&>(*node);
+                remove = !child.children.empty() && _prune(child, merged);
+            }
+        }
+
+        if (remove)
+            itr = children.erase(itr);
+        else
+            ++itr;
+    }
+    return children.empty();
+}
+
+void MergeGeometries::report(LogOutput& output) const
+{
+    output("MergeGeometries::report(..) ", this, " {");
+    output.in();
+    output("numDrawsMerged = ", numDrawsMerged);
+    output("numMergedDraws = ", numMergedDraws);
+    output.out();
+    output("}");
+}
@@ -0,0 +1,477 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/maths/simd.h>
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/DepthSorted.h>
+#include <vsg/nodes/LOD.h>
+#include <vsg/nodes/PagedLOD.h>
+#include <vsg/nodes/Transform.h>
+#include <vsg/utils/MultiLineSegmentIntersector.h>
+
+using namespace vsg;
+
+namespace
+{
+    constexpr double epsilon = 1e-10;
+
+    bool segmentIntersectsSphere(const dvec3& start, const dvec3& end, const dsphere& bs)
+    {
+        dvec3 sm = start - bs.center;
+        double c = length2(sm) - bs.radius * bs.radius;
+        if (c < 0.0) return true;
+
+        dvec3 se = end - start;
+        double a = length2(se);
+        double b = dot(sm, se) * 2.0;
+        double d = b * b - 4.0 * a * c;
+
+        if (d < 0.0) return false;
+
+        d = sqrt(d);
+
+        double div = 1.0 / (2.0 * a);
+
+        double r1 = (-b - d) * div;
+        double r2 = (-b + d) * div;
+
+        if (r1 <= 0.0 && r2 <= 0.0) return false;
+        if (r1 >= 1.0 && r2 >= 1.0) return false;
+
+        return true;
+    }
+
+    // line segment in the form used by the triangle tests, matching the setup of LineSegmentIntersector's TriangleIntersector
+    struct Ray
+    {
+        dvec3 start;
+        dvec3 d;
+        double length;
+        double inverse_length;
+
+        explicit Ray(const MultiLineSegmentIntersector::LineSegment& ls) :
+            start(ls.start),
+            d(ls.end - ls.start)
+        {
+            length = vsg::length(d);
+            inverse_length = (length != 0.0) ? 1.0 / length : 0.0;
+            d *= inverse_length;
+        }
+    };
+
+    // scalar Moller-Trumbore test with the same operations and rejection tests as LineSegmentIntersector so the two report the same intersections.
+    bool intersectTriangle(const Ray& ray, const dvec3& v0, const dvec3& E1, const dvec3& E2, double& r, double& u, double& v)
+    {
+        dvec3 T = ray.start - v0;
+        dvec3 P = cross(ray.d, E2);
+        double det = dot(P, E1);
+
+        if (det > epsilon)
+        {
+            u = dot(P, T);
+            if (u < 0.0 || u > det) return false;
+
+            dvec3 Q = cross(T, E1);
+            v = dot(Q, ray.d);
+            if (v < 0.0 || v > det) return false;
+
+            if ((u + v) > det) return false;
+
+            double inv_det = 1.0 / det;
+            double t = dot(Q, E2) * inv_det;
+            if (t < 0.0 || t > ray.length) return false;
+
+            u *= inv_det;
+            v *= inv_det;
+            r = t * ray.inverse_length;
+            return true;
+        }
+        else if (det < -epsilon)
+        {
+            u = dot(P, T);
+            if (u > 0.0 || u < det) return false;
+
+            dvec3 Q = cross(T, E1);
+            v = dot(Q, ray.d);
+            if (v > 0.0 || v < det) return false;
+
+            if ((u + v) < det) return false;
+
+            double inv_det = 1.0 / det;
+            double t = dot(Q, E2) * inv_det;
+            if (t < 0.0 || t > ray.length) return false;
+
+            u *= inv_det;
+            v *= inv_det;
+            r = t * ray.inverse_length;
+            return true;
+        }
+        return false;
+    }
+
+    // structure of arrays layout of the rays, padded to a multiple of width with rays of zero direction that can never hit.
+    struct RayPacket
+    {
+        static constexpr size_t width = 4;
+
+        std::vector<double> sx, sy, sz, dx, dy, dz, length;
+
+        explicit RayPacket(const std::vector<Ray>& rays)
+        {
+            size_t size = ((rays.size() + width - 1) / width) * width;
+            for (auto* a : {&sx, &sy, &sz, &dx, &dy, &dz, &length}) a->assign(size, 0.0);
+            for (size_t i = 0; i < rays.size(); ++i)
+            {
+                const auto& ray = rays[i];
+                sx[i] = ray.start.x;
+                sy[i] = ray.start.y;
+                sz[i] = ray.start.z;
+                dx[i] = ray.d.x;
+                dy[i] = ray.d.y;
+                dz[i] = ray.d.z;
+                length[i] = ray.length;
+            }
+        }
+
+        size_t size() const { return sx.size(); }
+
+#if defined(VSG_SIMD_SSE2)
+#    if defined(VSG_SIMD_AVX)
+        using vtype = __m256d;
+        static constexpr size_t lanes = 4;
+        static vtype load(const double* ptr) { return _mm256_loadu_pd(ptr); }
+        static vtype set1(double v) { return _mm256_set1_pd(v); }
+        static vtype add(vtype a, vtype b) { return _mm256_add_pd(a, b); }
+        static vtype sub(vtype a, vtype b) { return _mm256_sub_pd(a, b); }
+        static vtype mul(vtype a, vtype b) { return _mm256_mul_pd(a, b); }
+        static vtype div(vtype a, vtype b) { return _mm256_div_pd(a, b); }
+        static vtype and_mask(vtype a, vtype b) { return _mm256_and_pd(a, b); }
+        static vtype or_mask(vtype a, vtype b) { return _mm256_or_pd(a, b); }
+        static vtype gt(vtype a, vtype b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+        static vtype lt(vtype a, vtype b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+        static vtype nlt(vtype a, vtype b) { return _mm256_cmp_pd(a, b, _CMP_NLT_UQ); }
+        static vtype ngt(vtype a, vtype b) { return _mm256_cmp_pd(a, b, _CMP_NGT_UQ); }
+        static uint32_t movemask(vtype a) { return static_cast<uint32_t>(_mm256_movemask_pd(a)); }
+#    else
+        using vtype = __m128d;
+        static constexpr size_t lanes = 2;
+        static vtype load(const double* ptr) { return _mm_loadu_pd(ptr); }
+        static vtype set1(double v) { return _mm_set1_pd(v); }
+        static vtype add(vtype a, vtype b) { return _mm_add_pd(a, b); }
+        static vtype sub(vtype a, vtype b) { return _mm_sub_pd(a, b); }
+        static vtype mul(vtype a, vtype b) { return _mm_mul_pd(a, b); }
+        static vtype div(vtype a, vtype b) { return _mm_div_pd(a, b); }
+        static vtype and_mask(vtype a, vtype b) { return _mm_and_pd(a, b); }
+        static vtype or_mask(vtype a, vtype b) { return _mm_or_pd(a, b); }
+        static vtype gt(vtype a, vtype b) { return _mm_cmpgt_pd(a, b); }
+        static vtype lt(vtype a, vtype b) { return _mm_cmplt_pd(a, b); }
+        static vtype nlt(vtype a, vtype b) { return _mm_cmpnlt_pd(a, b); }
+        static vtype ngt(vtype a, vtype b) { return _mm_cmpngt_pd(a, b); }
+        static uint32_t movemask(vtype a) { return static_cast<uint32_t>(_mm_movemask_pd(a)); }
+#    endif
+
+        // SIMD version of the rejection tests in intersectTriangle(..) for the lanes starting at base, using the same arithmetic so that no lane
+        // the scalar test would accept is rejected, returns a bit mask of the lanes that need the full scalar test.
+        uint32_t hits(size_t base, const dvec3& v0, const dvec3& E1, const dvec3& E2) const
+        {
+            const vtype d_x = load(dx.data() + base), d_y = load(dy.data() + base), d_z = load(dz.data() + base);
+            const vtype T_x = sub(load(sx.data() + base), set1(v0.x));
+            const vtype T_y = sub(load(sy.data() + base), set1(v0.y));
+            const vtype T_z = sub(load(sz.data() + base), set1(v0.z));
+            const vtype E1_x = set1(E1.x), E1_y = set1(E1.y), E1_z = set1(E1.z);
+            const vtype E2_x = set1(E2.x), E2_y = set1(E2.y), E2_z = set1(E2.z);
+
+            // P = cross(d, E2)
+            const vtype P_x = sub(mul(d_y, E2_z), mul(E2_y, d_z));
+            const vtype P_y = sub(mul(d_z, E2_x), mul(E2_z, d_x));
+            const vtype P_z = sub(mul(d_x, E2_y), mul(E2_x, d_y));
+
+            const vtype det = add(add(mul(P_x, E1_x), mul(P_y, E1_y)), mul(P_z, E1_z));
+            const vtype u = add(add(mul(P_x, T_x), mul(P_y, T_y)), mul(P_z, T_z));
+
+            // Q = cross(T, E1)
+            const vtype Q_x = sub(mul(T_y, E1_z), mul(E1_y, T_z));
+            const vtype Q_y = sub(mul(T_z, E1_x), mul(E1_z, T_x));
+            const vtype Q_z = sub(mul(T_x, E1_y), mul(E1_x, T_y));
+
+            const vtype v = add(add(mul(Q_x, d_x), mul(Q_y, d_y)), mul(Q_z, d_z));
+            const vtype uv = add(u, v);
+            const vtype t = mul(add(add(mul(Q_x, E2_x), mul(Q_y, E2_y)), mul(Q_z, E2_z)), div(set1(1.0), det));
+
+            const vtype zero = set1(0.0);
+            vtype positive = and_mask(gt(det, set1(epsilon)), and_mask(and_mask(nlt(u, zero), ngt(u, det)), and_mask(and_mask(nlt(v, zero), ngt(v, det)), ngt(uv, det))));
+            vtype negative = and_mask(lt(det, set1(-epsilon)), and_mask(and_mask(ngt(u, zero), nlt(u, det)), and_mask(and_mask(ngt(v, zero), nlt(v, det)), nlt(uv, det))));
+            vtype within = and_mask(nlt(t, zero), ngt(t, load(length.data() + base)));
+
+            return movemask(and_mask(or_mask(positive, negative), within));
+        }
+#else
+        static constexpr size_t lanes = 1;
+
+        // without SIMD support every lane is passed on to the scalar test
+        uint32_t hits(size_t base, const dvec3&, const dvec3&, const dvec3&) const
+        {
+            return (dx[base] != 0.0 || dy[base] != 0.0 || dz[base] != 0.0) ? 1u : 0u;
+        }
+#endif
+    };
+} // namespace
+
+MultiLineSegmentIntersector::MultiLineSegmentIntersector(const LineSegments& in_lineSegments, ref_ptr<ArrayState> initialArrayData) :
+    Inherit(initialArrayData)
+{
+    intersections.resize(in_lineSegments.size());
+    _lineSegmentsStack.push_back(in_lineSegments);
+
+    std::vector<uint32_t> active(in_lineSegments.size());
+    for (size_t i = 0; i < active.size(); ++i) active[i] = static_cast<uint32_t>(i);
+    _activeStack.push_back(std::move(active));
+}
+
+ref_ptr<MultiLineSegmentIntersector::Intersection> MultiLineSegmentIntersector::add(uint32_t segmentIndex, const dvec3& coord, double ratio, const IndexRatios& indexRatios, uint32_t instanceIndex)
+{
+    auto localToWorld = computeTransform(_nodePath);
+    auto intersection = Intersection::create(coord, localToWorld * coord, ratio, localToWorld, _nodePath, arrayStateStack.back()->arrays, indexRatios, instanceIndex);
+    intersections[segmentIndex].emplace_back(intersection);
+    return intersection;
+}
+
+bool MultiLineSegmentIntersector::_pushActive(const dsphere& bs)
+{
+    if (!bs.valid()) return false;
+
+    const auto& lineSegments = _lineSegmentsStack.back();
+    std::vector<uint32_t> active;
+    for (auto i : _activeStack.back())
+    {
+        if (segmentIntersectsSphere(lineSegments[i].start, lineSegments[i].end, bs)) active.push_back(i);
+    }
+
+    if (active.empty()) return false;
+
+    _activeStack.push_back(std::move(active));
+    return true;
+}
+
+void MultiLineSegmentIntersector::apply(const LOD& lod)
+{
+    if (!_pushActive(lod.bound)) return;
+
+    _nodePath.push_back(&lod);
+    for (auto& child : lod.children)
+    {
+        if (child.node)
+        {
+            child.node->accept(*this);
+            break;
+        }
+    }
+    _nodePath.pop_back();
+
+    _popActive();
+}
+
+void MultiLineSegmentIntersector::apply(const PagedLOD& plod)
+{
+    if (!_pushActive(plod.bound)) return;
+
+    _nodePath.push_back(&plod);
+    for (auto& child : plod.children)
+    {
+        if (child.node)
+        {
+            child.node->accept(*this);
+            break;
+        }
+    }
+    _nodePath.pop_back();
+
+    _popActive();
+}
+
+void MultiLineSegmentIntersector::apply(const CullNode& cn)
+{
+    if (!_pushActive(cn.bound)) return;
+
+    _nodePath.push_back(&cn);
+    cn.traverse(*this);
+    _nodePath.pop_back();
+
+    _popActive();
+}
+
+void MultiLineSegmentIntersector::apply(const CullGroup& cg)
+{
+    if (!_pushActive(cg.bound)) return;
+
+    _nodePath.push_back(&cg);
+    cg.traverse(*this);
+    _nodePath.pop_back();
+
+    _popActive();
+}
+
+void MultiLineSegmentIntersector::apply(const DepthSorted& ds)
+{
+    if (!_pushActive(ds.bound)) return;
+
+    _nodePath.push_back(&ds);
+    ds.traverse(*this);
+    _nodePath.pop_back();
+
+    _popActive();
+}
+
+void MultiLineSegmentIntersector::pushTransform(const Transform& transform)
+{
+    auto& l2wStack = localToWorldStack();
+    auto& w2lStack = worldToLocalStack();
+
+    dmat4 localToWorld = l2wStack.empty() ? transform.transform(dmat4{}) : transform.transform(l2wStack.back());
+    dmat4 worldToLocal = inverse(localToWorld);
+
+    l2wStack.push_back(localToWorld);
+    w2lStack.push_back(worldToLocal);
+
+    // only the active line segments are transformed, the others can't be reached in this subgraph
+    const auto& worldLineSegments = _lineSegmentsStack.front();
+    LineSegments localLineSegments(worldLineSegments.size());
+    for (auto i : _activeStack.back())
+    {
+        localLineSegments[i] = LineSegment{worldToLocal * worldLineSegments[i].start, worldToLocal * worldLineSegments[i].end};
+    }
+    _lineSegmentsStack.push_back(std::move(localLineSegments));
+}
+
+void MultiLineSegmentIntersector::popTransform()
+{
+    _lineSegmentsStack.pop_back();
+    localToWorldStack().pop_back();
+    worldToLocalStack().pop_back();
+}
+
+bool MultiLineSegmentIntersector::intersects(const dsphere& bs)
+{
+    if (!bs.valid()) return false;
+
+    const auto& lineSegments = _lineSegmentsStack.back();
+    for (auto i : _activeStack.back())
+    {
+        if (segmentIntersectsSphere(lineSegments[i].start, lineSegments[i].end, bs)) return true;
+    }
+    return false;
+}
+
+template<typename F>
+bool MultiLineSegmentIntersector::_intersectTriangles(uint32_t first, uint32_t count, bool indexed, uint32_t firstInstance, uint32_t instanceCount, F forEachTriangle)
+{
+    auto& arrayState = *arrayStateStack.back();
+    if (arrayState.topology != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST || count < 3) return false;
+
+    const auto& active = _activeStack.back();
+    if (active.empty()) return false;
+
+    const auto& lineSegments = _lineSegmentsStack.back();
+    std::vector<Ray> rays;
+    rays.reserve(active.size());
+    for (auto i : active) rays.emplace_back(lineSegments[i]);
+
+    bool intersected = false;
+
+    uint32_t instanceIndex = 0;
+    ref_ptr<const vec3Array> vertices;
+
+    auto test = [&](size_t r, uint32_t i0, uint32_t i1, uint32_t i2, const dvec3& v0, const dvec3& E1, const dvec3& E2) {
+        double ratio, u, v;
+        if (!intersectTriangle(rays[r], v0, E1, E2, ratio, u, v)) return;
+
+        double r0 = 1.0 - u - v;
+        dvec3 intersection = v0 * r0 + dvec3(vertices->at(i1)) * u + dvec3(vertices->at(i2)) * v;
+        add(active[r], intersection, ratio, {{i0, r0}, {i1, u}, {i2, v}}, instanceIndex);
+        intersected = true;
+    };
+
+    auto bvh = getTriangleBVH(first, count, indexed);
+    std::unique_ptr<RayPacket> packet;
+    if (!bvh) packet.reset(new RayPacket(rays));
+
+    uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
+    for (instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
+    {
+        vertices = arrayState.vertexArray(instanceIndex);
+        if (!vertices) continue;
+
+        if (bvh)
+        {
+            // large draws are queried per line segment through the BVH
+            for (size_t r = 0; r < rays.size(); ++r)
+            {
+                const auto& ls = lineSegments[active[r]];
+                bvh->intersect(ls.start, ls.end, [&](uint32_t i0, uint32_t i1, uint32_t i2) {
+                    dvec3 v0(vertices->at(i0));
+                    test(r, i0, i1, i2, v0, dvec3(vertices->at(i1)) - v0, dvec3(vertices->at(i2)) - v0);
+                });
+            }
+        }
+        else
+        {
+            // small draws test each triangle against packets of line segments
+            forEachTriangle([&](uint32_t i0, uint32_t i1, uint32_t i2) {
+                dvec3 v0(vertices->at(i0));
+                dvec3 E1 = dvec3(vertices->at(i1)) - v0;
+                dvec3 E2 = dvec3(vertices->at(i2)) - v0;
+                for (size_t base = 0; base < packet->size(); base += RayPacket::lanes)
+                {
+                    uint32_t mask = packet->hits(base, v0, E1, E2);
+                    for (size_t lane = 0; mask != 0; ++lane, mask >>= 1)
+                    {
+                        if (mask & 1) test(base + lane, i0, i1, i2, v0, E1, E2);
+                    }
+                }
+            });
+        }
+    }
+
+    return intersected;
+}
+
+bool MultiLineSegmentIntersector::intersectDraw(uint32_t firstVertex, uint32_t vertexCount, uint32_t firstInstance, uint32_t instanceCount)
+{
+    return _intersectTriangles(firstVertex, vertexCount, false, firstInstance, instanceCount, [&](auto func) {
+        uint32_t endVertex = firstVertex + (vertexCount / 3) * 3;
+        for (uint32_t i = firstVertex; i < endVertex; i += 3)
+        {
+            func(i, i + 1, i + 2);
+        }
+    });
+}
+
+bool MultiLineSegmentIntersector::intersectDrawIndexed(uint32_t firstIndex, uint32_t indexCount, uint32_t firstInstance, uint32_t instanceCount)
+{
+    auto forEachIndexedTriangle = [&](const auto& indices, auto func) {
+        uint32_t endIndex = std::min(firstIndex + (indexCount / 3) * 3, static_cast<uint32_t>(indices.size()));
+        for (uint32_t i = firstIndex; (i + 2) < endIndex; i += 3)
+        {
+            func(indices.at(i), indices.at(i + 1), indices.at(i + 2));
+        }
+    };
+
+    if (ubyte_indices)
+        return _intersectTriangles(firstIndex, indexCount, true, firstInstance, instanceCount, [&](auto func) { forEachIndexedTriangle(*ubyte_indices, func); });
+    else if (ushort_indices)
+        return _intersectTriangles(firstIndex, indexCount, true, firstInstance, instanceCount, [&](auto func) { forEachIndexedTriangle(*ushort_indices, func); });
+    else if (uint_indices)
+        return _intersectTriangles(firstIndex, indexCount, true, firstInstance, instanceCount, [&](auto func) { forEachIndexedTriangle(*uint_indices, func); });
+    return false;
+}
@@ -0,0 +1,486 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/DrawIndexed.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/state/GraphicsPipeline.h>
+#include <vsg/state/InputAssemblyState.h>
+#include <vsg/utils/OptimizeMeshes.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// optimizeVertexCache
+//
+void vsg::optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t numVertices, uint32_t cacheSize)
+{
+    size_t numTriangles = indices.size() / 3;
+    if (numTriangles < 2 || cacheSize < 4) return;
+
+    // scoring parameters from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+    const float cacheDecayPower = 1.5f;
+    const float lastTriangleScore = 0.75f;
+    const float valenceBoostScale = 2.0f;
+    const float valenceBoostPower = 0.5f;
+
+    // build the lists of triangles that use each vertex
+    std::vector<uint32_t> remaining(numVertices, 0);
+    for (size_t i = 0; i < numTriangles * 3; ++i) ++remaining[indices[i]];
+
+    std::vector<uint32_t> offsets(numVertices + 1, 0);
+    for (uint32_t v = 0; v < numVertices; ++v) offsets[v + 1] = offsets[v] + remaining[v];
+
+    std::vector<uint32_t> adjacency(numTriangles * 3);
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < numTriangles * 3; ++i) adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+
+    std::vector<int32_t> cachePosition(numVertices, -1);
+
+    auto vertexScore = [&](uint32_t v) -> float {
+        if (remaining[v] == 0) return -1.0f;
+
+        float score = 0.0f;
+        int32_t position = cachePosition[v];
+        if (position >= 0)
+        {
+            if (position < 3)
+                score = lastTriangleScore;
+            else
+                score = std::pow(1.0f - static_cast<float>(position - 3) / static_cast<float>(cacheSize - 3), cacheDecayPower);
+        }
+        return score + valenceBoostScale * std::pow(static_cast<float>(remaining[v]), -valenceBoostPower);
+    };
+
+    std::vector<float> vertexScores(numVertices);
+    for (uint32_t v = 0; v < numVertices; ++v) vertexScores[v] = vertexScore(v);
+
+    std::vector<bool> emitted(numTriangles, false);
+    std::vector<uint32_t> optimized;
+    optimized.reserve(numTriangles * 3);
+
+    std::vector<uint32_t> cache, newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+
+    size_t nextUnemitted = 0;
+    int64_t best = 0;
+    while (optimized.size() < numTriangles * 3)
+    {
+        if (best < 0)
+        {
+            // no triangles use the vertices in the cache so continue with the next triangle in the original order
+            while (emitted[nextUnemitted]) ++nextUnemitted;
+            best = static_cast<int64_t>(nextUnemitted);
+        }
+
+        auto triangle = static_cast<size_t>(best);
+        emitted[triangle] = true;
+
+        // emit the triangle and remove it from the vertex triangle lists
+        newCache.clear();
+        for (size_t k = 0; k < 3; ++k)
+        {
+            uint32_t v = indices[triangle * 3 + k];
+            optimized.push_back(v);
+            newCache.push_back(v);
+
+            auto begin = adjacency.begin() + offsets[v];
+            auto end = begin + remaining[v];
+            auto itr = std::find(begin, end, static_cast<uint32_t>(triangle));
+            if (itr != end)
+            {
+                *itr = *(end - 1);
+                --remaining[v];
+            }
+        }
+
+        // LRU cache with the emitted triangle's vertices at the front
+        for (auto v : cache)
+        {
+            if (v != newCache[0] && v != newCache[1] && v != newCache[2]) newCache.push_back(v);
+        }
+
+        for (size_t i = 0; i < newCache.size(); ++i)
+        {
+            uint32_t v = newCache[i];
+            cachePosition[v] = (i < cacheSize) ? static_cast<int32_t>(i) : -1;
+            vertexScores[v] = vertexScore(v);
+        }
+        if (newCache.size() > cacheSize) newCache.resize(cacheSize);
+        std::swap(cache, newCache);
+
+        // score the triangles that use the vertices in the cache and pick the best as the next triangle
+        best = -1;
+        float bestScore = -1.0f;
+        for (auto v : cache)
+        {
+            for (uint32_t i = offsets[v]; i < offsets[v] + remaining[v]; ++i)
+            {
+                uint32_t t = adjacency[i];
+                float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+    }
+
+    std::copy(optimized.begin(), optimized.end(), indices.begin());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// optimizeOverdraw
+//
+void vsg::optimizeOverdraw(std::vector<uint32_t>& indices, const vec3Array& vertices, uint32_t cacheSize)
+{
+    size_t numTriangles = indices.size() / 3;
+    if (numTriangles < 2) return;
+
+    // split the triangles into clusters where the FIFO vertex cache misses all of a triangle's vertices
+    std::vector<size_t> clusterStarts;
+    std::vector<uint32_t> insertTime(vertices.size(), 0);
+    uint32_t time = cacheSize + 1;
+    for (size_t t = 0; t < numTriangles; ++t)
+    {
+        uint32_t misses = 0;
+        for (size_t k = 0; k < 3; ++k)
+        {
+            uint32_t v = indices[t * 3 + k];
+            if (time - insertTime[v] > cacheSize)
+            {
+                insertTime[v] = time++;
+                ++misses;
+            }
+        }
+        if (t == 0 || misses == 3) clusterStarts.push_back(t);
+    }
+    if (clusterStarts.size() < 2) return;
+
+    struct Cluster
+    {
+        size_t start;
+        size_t end;
+        dvec3 centroid;
+        dvec3 normal;
+        double sortValue;
+    };
+
+    std::vector<Cluster> clusters;
+    clusters.reserve(clusterStarts.size());
+
+    // area weighted centroids and normals of the clusters and the whole mesh
+    dvec3 meshCentroid;
+    double meshArea = 0.0;
+    for (size_t c = 0; c < clusterStarts.size(); ++c)
+    {
+        Cluster cluster{clusterStarts[c], (c + 1 < clusterStarts.size()) ? clusterStarts[c + 1] : numTriangles, {}, {}, 0.0};
+
+        double clusterArea = 0.0;
+        for (size_t t = cluster.start; t < cluster.end; ++t)
+        {
+            dvec3 v0(vertices[indices[t * 3]]);
+            dvec3 v1(vertices[indices[t * 3 + 1]]);
+            dvec3 v2(vertices[indices[t * 3 + 2]]);
+
+            dvec3 n = cross(v1 - v0, v2 - v0);
+            double area = length(n);
+            cluster.normal += n;
+            cluster.centroid += (v0 + v1 + v2) * (area / 3.0);
+            clusterArea += area;
+        }
+
+        if (clusterArea > 0.0) cluster.centroid /= clusterArea;
+        meshCentroid += cluster.centroid * clusterArea;
+        meshArea += clusterArea;
+
+        clusters.push_back(cluster);
+    }
+    if (meshArea > 0.0) meshCentroid /= meshArea;
+
+    // clusters that face away from the center of the mesh are likely to occlude the others so draw them first
+    for (auto& cluster : clusters)
+    {
+        double normalLength = length(cluster.normal);
+        cluster.sortValue = (normalLength > 0.0) ? dot(cluster.centroid - meshCentroid, cluster.normal / normalLength) : 0.0;
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& lhs, const Cluster& rhs) { return lhs.sortValue > rhs.sortValue; });
+
+    std::vector<uint32_t> sorted;
+    sorted.reserve(numTriangles * 3);
+    for (auto& cluster : clusters)
+    {
+        sorted.insert(sorted.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+    }
+
+    std::copy(sorted.begin(), sorted.end(), indices.begin());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// optimizeVertexFetch
+//
+std::vector<uint32_t> vsg::optimizeVertexFetch(const std::vector<uint32_t>& indices, uint32_t numVertices)
+{
+    const uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+
+    std::vector<uint32_t> remap(numVertices, unassigned);
+    uint32_t next = 0;
+    for (auto index : indices)
+    {
+        if (remap[index] == unassigned) remap[index] = next++;
+    }
+    for (auto& value : remap)
+    {
+        if (value == unassigned) value = next++;
+    }
+    return remap;
+}
+
+float vsg::averageCacheMissRatio(const std::vector<uint32_t>& indices, uint32_t numVertices, uint32_t cacheSize)
+{
+    size_t numTriangles = indices.size() / 3;
+    if (numTriangles == 0) return 0.0f;
+
+    std::vector<uint32_t> insertTime(numVertices, 0);
+    uint32_t time = cacheSize + 1;
+    uint32_t misses = 0;
+    for (size_t i = 0; i < numTriangles * 3; ++i)
+    {
+        uint32_t v = indices[i];
+        if (time - insertTime[v] > cacheSize)
+        {
+            insertTime[v] = time++;
+            ++misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(numTriangles);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// OptimizeMeshes
+//
+namespace
+{
+    struct Mesh
+    {
+        BufferInfoList* arrays = nullptr;
+        BufferInfo* indices = nullptr;
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        uint32_t vertexOffset = 0;
+        bool soleDraw = false;
+    };
+
+    struct CollectMeshes : public Visitor
+    {
+        bool triangleList = true;
+        std::vector<Mesh> meshes;
+        std::map<const Data*, uint32_t> dataUsers;
+        std::set<const Node*> visited;
+
+        void countUsers(const BufferInfoList& arrays, const BufferInfo* indices)
+        {
+            for (auto& bufferInfo : arrays)
+            {
+                if (bufferInfo && bufferInfo->data) ++dataUsers[bufferInfo->data];
+            }
+            if (indices && indices->data) ++dataUsers[indices->data];
+        }
+
+        void apply(Node& node) override
+        {
+            if (visited.insert(&node).second) node.traverse(*this);
+        }
+
+        void apply(StateGroup& stateGroup) override
+        {
+            if (!visited.insert(&stateGroup).second) return;
+
+            bool previous = triangleList;
+            for (auto& stateCommand : stateGroup.stateCommands)
+            {
+                auto bindGraphicsPipeline = stateCommand.cast<BindGraphicsPipeline>();
+                if (!bindGraphicsPipeline || !bindGraphicsPipeline->pipeline) continue;
+                for (auto& pipelineState : bindGraphicsPipeline->pipeline->pipelineStates)
+                {
+                    if (auto inputAssemblyState = pipelineState.cast<InputAssemblyState>()) triangleList = (inputAssemblyState->topology == VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+                }
+            }
+
+            stateGroup.traverse(*this);
+
+            triangleList = previous;
+        }
+
+        void apply(VertexIndexDraw& vid) override
+        {
+            if (!visited.insert(&vid).second) return;
+
+            countUsers(vid.arrays, vid.indices);
+            if (triangleList) meshes.push_back(Mesh{&vid.arrays, vid.indices, vid.firstIndex, vid.indexCount, vid.vertexOffset, true});
+        }
+
+        void apply(Geometry& geometry) override
+        {
+            if (!visited.insert(&geometry).second) return;
+
+            countUsers(geometry.arrays, geometry.indices);
+            if (!triangleList) return;
+
+            bool soleDraw = geometry.commands.size() == 1;
+            for (auto& command : geometry.commands)
+            {
+                if (auto drawIndexed = command.cast<DrawIndexed>())
+                    meshes.push_back(Mesh{&geometry.arrays, geometry.indices, drawIndexed->firstIndex, drawIndexed->indexCount, drawIndexed->vertexOffset, soleDraw});
+            }
+        }
+    };
+
+    template<class A>
+    void readIndices(const A& source, uint32_t firstIndex, uint32_t indexCount, std::vector<uint32_t>& indices)
+    {
+        for (uint32_t i = firstIndex; i < firstIndex + indexCount; ++i) indices.push_back(source.at(i));
+    }
+
+    template<class A>
+    void writeIndices(A& dest, uint32_t firstIndex, const std::vector<uint32_t>& indices)
+    {
+        for (size_t i = 0; i < indices.size(); ++i) dest.at(firstIndex + i) = static_cast<typename A::value_type>(indices[i]);
+    }
+
+    // reorder the values of the array in place so that value i is moved to remap[i]
+    void remapArray(Data& data, const std::vector<uint32_t>& remap)
+    {
+        size_t valueSize = data.valueSize();
+        std::vector<uint8_t> values(remap.size() * valueSize);
+        for (size_t i = 0; i < remap.size(); ++i) std::memcpy(values.data() + remap[i] * valueSize, data.dataPointer(i), valueSize);
+        for (size_t i = 0; i < remap.size(); ++i) std::memcpy(data.dataPointer(i), values.data() + i * valueSize, valueSize);
+        data.dirty();
+    }
+} // namespace
+
+OptimizeMeshes::OptimizeMeshes()
+{
+}
+
+OptimizeMeshes::~OptimizeMeshes()
+{
+}
+
+void OptimizeMeshes::apply(Object& object) const
+{
+    CollectMeshes collectMeshes;
+    object.accept(collectMeshes);
+
+    std::set<std::tuple<const Data*, uint32_t, uint32_t>> optimized;
+    std::vector<uint32_t> triangles;
+
+    for (auto& mesh : collectMeshes.meshes)
+    {
+        if (!mesh.indices || !mesh.indices->data || mesh.indices->data->dynamic()) continue;
+        if (mesh.arrays->empty() || !mesh.arrays->front() || !mesh.arrays->front()->data) continue;
+
+        auto& indices = *mesh.indices->data;
+        uint32_t availableIndices = static_cast<uint32_t>(indices.valueCount()) - std::min(mesh.firstIndex, static_cast<uint32_t>(indices.valueCount()));
+        uint32_t indexCount = std::min(mesh.indexCount, availableIndices);
+        indexCount -= indexCount % 3;
+        if (indexCount < 6) continue;
+
+        // index ranges shared between draws only need to be optimized once
+        if (!optimized.emplace(&indices, mesh.firstIndex, indexCount).second) continue;
+
+        triangles.clear();
+        triangles.reserve(indexCount);
+        if (auto us = indices.cast<ushortArray>())
+            readIndices(*us, mesh.firstIndex, indexCount, triangles);
+        else if (auto ui = indices.cast<uintArray>())
+            readIndices(*ui, mesh.firstIndex, indexCount, triangles);
+        else if (auto ub = indices.cast<ubyteArray>())
+            readIndices(*ub, mesh.firstIndex, indexCount, triangles);
+        else
+            continue;
+
+        auto& vertexData = *mesh.arrays->front()->data;
+        uint32_t numVertices = static_cast<uint32_t>(vertexData.valueCount()) - std::min(mesh.vertexOffset, static_cast<uint32_t>(vertexData.valueCount()));
+        if (std::any_of(triangles.begin(), triangles.end(), [&](uint32_t index) { return index >= numVertices; })) continue;
+
+        optimizeVertexCache(triangles, numVertices, vertexCacheSize);
+
+        if (reduceOverdraw && mesh.vertexOffset == 0)
+        {
+            if (auto vertices = vertexData.cast<vec3Array>()) optimizeOverdraw(triangles, *vertices, vertexCacheSize);
+        }
+
+        // vertex arrays can only be remapped when they are used by just this draw, and all their vertices are indexed by it
+        bool remap = remapVertices && mesh.soleDraw && mesh.vertexOffset == 0 && mesh.firstIndex == 0 && indexCount == indices.valueCount() &&
+                     collectMeshes.dataUsers[&indices] == 1;
+        for (auto& bufferInfo : *mesh.arrays)
+        {
+            if (!remap) break;
+            remap = bufferInfo && bufferInfo->data && !bufferInfo->data->dynamic() && bufferInfo->offset == 0 &&
+                    bufferInfo->data->valueCount() == numVertices && collectMeshes.dataUsers[bufferInfo->data] == 1;
+        }
+
+        if (remap)
+        {
+            auto vertexRemap = optimizeVertexFetch(triangles, numVertices);
+            for (auto& bufferInfo : *mesh.arrays) remapArray(*bufferInfo->data, vertexRemap);
+            for (auto& index : triangles) index = vertexRemap[index];
+        }
+
+        if (auto us = indices.cast<ushortArray>())
+            writeIndices(*us, mesh.firstIndex, triangles);
+        else if (auto ui = indices.cast<uintArray>())
+            writeIndices(*ui, mesh.firstIndex, triangles);
+        else if (auto ub = indices.cast<ubyteArray>())
+            writeIndices(*ub, mesh.firstIndex, triangles);
+        indices.dirty();
+    }
+}
+
+void OptimizeMeshes::read(Input& input)
+{
+    Object::read(input);
+
+    input.read("vertexCacheSize", vertexCacheSize);
+    input.read("reduceOverdraw", reduceOverdraw);
+    input.read("remapVertices", remapVertices);
+}
+
+void OptimizeMeshes::write(Output& output) const
+{
+    Object::write(output);
+
+    output.write("vertexCacheSize", vertexCacheSize);
+    output.write("reduceOverdraw", reduceOverdraw);
+    output.write("remapVertices", remapVertices);
+}
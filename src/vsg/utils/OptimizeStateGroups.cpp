@@ -0,0 +1,335 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/io/Logger.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/utils/OptimizeStateGroups.h>
+
+#include <algorithm>
+#include <typeinfo>
+
+using namespace vsg;
+
+namespace
+{
+    struct CountParents : public Visitor
+    {
+        explicit CountParents(std::map<const Node*, uint32_t>& in_parentCounts) :
+            parentCounts(in_parentCounts) {}
+
+        std::map<const Node*, uint32_t>& parentCounts;
+
+        void apply(Node& node) override
+        {
+            if (++parentCounts[&node] == 1) node.traverse(*this);
+        }
+    };
+
+    struct ShareStateCommands : public Visitor
+    {
+        explicit ShareStateCommands(std::set<ref_ptr<StateCommand>, DereferenceLess>& in_sharedStateCommands) :
+            sharedStateCommands(in_sharedStateCommands) {}
+
+        std::set<ref_ptr<StateCommand>, DereferenceLess>& sharedStateCommands;
+        std::set<const Node*> visited;
+        uint32_t numShared = 0;
+
+        void apply(Node& node) override
+        {
+            if (visited.insert(&node).second) node.traverse(*this);
+        }
+
+        void apply(StateGroup& stateGroup) override
+        {
+            if (!visited.insert(&stateGroup).second) return;
+
+            for (auto& stateCommand : stateGroup.stateCommands)
+            {
+                if (!stateCommand) continue;
+                if (auto [itr, inserted] = sharedStateCommands.insert(stateCommand); !inserted && *itr != stateCommand)
+                {
+                    stateCommand = *itr;
+                    ++numShared;
+                }
+            }
+
+            for (auto& child : stateGroup.children) child->accept(*this);
+        }
+    };
+
+    // only operate on StateGroups of exactly type StateGroup, subclasses may have state or behaviour that depends on their position in the graph.
+    StateGroup* asStateGroup(Node* node)
+    {
+        return (node && typeid(*node) == typeid(StateGroup)) ? static_cast<StateGroup*>(node) : nullptr;
+    }
+
+    bool equal(const StateCommand* lhs, const StateCommand* rhs)
+    {
+        return lhs == rhs || (lhs && rhs && lhs->compare(*rhs) == 0);
+    }
+
+    // return the StateCommand assigned to the slot if it's the only one on that slot, otherwise nullptr
+    const StateCommand* uniqueOnSlot(const StateGroup& stateGroup, uint32_t slot)
+    {
+        const StateCommand* match = nullptr;
+        for (auto& stateCommand : stateGroup.stateCommands)
+        {
+            if (stateCommand && stateCommand->slot == slot)
+            {
+                if (match) return nullptr;
+                match = stateCommand.get();
+            }
+        }
+        return match;
+    }
+
+    bool hasSlot(const StateGroup& stateGroup, uint32_t slot)
+    {
+        return std::any_of(stateGroup.stateCommands.begin(), stateGroup.stateCommands.end(), [&](const ref_ptr<StateCommand>& stateCommand) { return stateCommand && stateCommand->slot == slot; });
+    }
+
+    bool sameStateCommands(const StateGroup& lhs, const StateGroup& rhs)
+    {
+        if (lhs.stateCommands.size() != rhs.stateCommands.size() || lhs.prototypeArrayState != rhs.prototypeArrayState) return false;
+
+        for (auto& stateCommand : lhs.stateCommands)
+        {
+            auto matches = [&](const ref_ptr<StateCommand>& other) { return equal(stateCommand, other); };
+            if (std::none_of(rhs.stateCommands.begin(), rhs.stateCommands.end(), matches)) return false;
+        }
+        return true;
+    }
+} // namespace
+
+OptimizeStateGroups::OptimizeStateGroups()
+{
+}
+
+OptimizeStateGroups::~OptimizeStateGroups()
+{
+}
+
+bool OptimizeStateGroups::_isShared(const Node* node) const
+{
+    auto itr = _parentCounts.find(node);
+    return itr != _parentCounts.end() && itr->second > 1;
+}
+
+void OptimizeStateGroups::optimize(Node& node)
+{
+    _parentCounts.clear();
+    _inheritedState.clear();
+
+    CountParents countParents(_parentCounts);
+    node.accept(countParents);
+
+    if (shareStateCommands)
+    {
+        ShareStateCommands share(_sharedStateCommands);
+        node.accept(share);
+        numStateCommandsShared += share.numShared;
+    }
+
+    node.accept(*this);
+
+    _parentCounts.clear();
+    _sharedStateCommands.clear();
+    _inheritedState.clear();
+}
+
+void OptimizeStateGroups::apply(Node& node)
+{
+    // nodes with multiple parents inherit different state along each path so leave them and their subgraphs untouched.
+    if (_isShared(&node)) return;
+
+    node.traverse(*this);
+}
+
+void OptimizeStateGroups::apply(Group& group)
+{
+    if (_isShared(&group)) return;
+
+    for (auto& child : group.children) child->accept(*this);
+
+    _optimizeChildren(group);
+}
+
+void OptimizeStateGroups::apply(StateGroup& stateGroup)
+{
+    if (_isShared(&stateGroup)) return;
+
+    if (removeRedundantStateCommands)
+    {
+        auto& stateCommands = stateGroup.stateCommands;
+        for (auto itr = stateCommands.begin(); itr != stateCommands.end();)
+        {
+            auto stateCommand = itr->get();
+            bool redundant = stateCommand && stateCommand->slot < _inheritedState.size() &&
+                             equal(_inheritedState[stateCommand->slot], stateCommand) &&
+                             uniqueOnSlot(stateGroup, stateCommand->slot) == stateCommand;
+            if (redundant)
+            {
+                itr = stateCommands.erase(itr);
+                ++numRedundantStateCommandsRemoved;
+            }
+            else
+            {
+                ++itr;
+            }
+        }
+    }
+
+    auto previousState = _inheritedState;
+    for (auto& stateCommand : stateGroup.stateCommands)
+    {
+        if (!stateCommand) continue;
+        if (stateCommand->slot >= _inheritedState.size()) _inheritedState.resize(stateCommand->slot + 1, nullptr);
+        _inheritedState[stateCommand->slot] = stateCommand.get();
+    }
+
+    for (auto& child : stateGroup.children) child->accept(*this);
+
+    _inheritedState.swap(previousState);
+
+    _optimizeChildren(stateGroup);
+}
+
+void OptimizeStateGroups::_optimizeChildren(Group& group)
+{
+    if (mergeSiblingStateGroups) _mergeSiblings(group);
+    if (hoistCommonStateCommands) _hoist(group);
+    if (removeEmptyStateGroups) _removeEmptyStateGroups(group);
+}
+
+void OptimizeStateGroups::_mergeSiblings(Group& group)
+{
+    auto& children = group.children;
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        auto lhs = asStateGroup(children[i].get());
+        if (!lhs || _isShared(lhs)) continue;
+
+        size_t j = i + 1;
+        while (j < children.size())
+        {
+            auto rhs = asStateGroup(children[j].get());
+            if (rhs && !_isShared(rhs) && sameStateCommands(*lhs, *rhs))
+            {
+                lhs->children.insert(lhs->children.end(), rhs->children.begin(), rhs->children.end());
+                children.erase(children.begin() + j);
+                ++numStateGroupsMerged;
+            }
+            else if (mergeNonAdjacentSiblings)
+            {
+                ++j;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+}
+
+void OptimizeStateGroups::_hoist(Group& group)
+{
+    auto& children = group.children;
+    if (children.empty()) return;
+
+    // StateCommands can be moved into a parent StateGroup, or into a new StateGroup inserted beneath Group nodes that simply traverse their children.
+    auto parentStateGroup = asStateGroup(&group);
+    if (!parentStateGroup)
+    {
+        if (children.size() < 2) return;
+        if (typeid(group) != typeid(Group) && typeid(group) != typeid(MatrixTransform) && typeid(group) != typeid(CullGroup)) return;
+    }
+
+    std::vector<StateGroup*> stateGroups;
+    for (auto& child : children)
+    {
+        auto stateGroup = asStateGroup(child.get());
+        if (!stateGroup || _isShared(stateGroup)) return;
+        stateGroups.push_back(stateGroup);
+    }
+
+    StateCommands common;
+    for (auto& stateCommand : stateGroups.front()->stateCommands)
+    {
+        if (!stateCommand || (parentStateGroup && hasSlot(*parentStateGroup, stateCommand->slot))) continue;
+
+        auto matches = [&](const StateGroup* stateGroup) { return equal(uniqueOnSlot(*stateGroup, stateCommand->slot), stateCommand); };
+        if (std::all_of(stateGroups.begin(), stateGroups.end(), matches)) common.push_back(stateCommand);
+    }
+
+    if (common.empty()) return;
+
+    for (auto stateGroup : stateGroups)
+    {
+        auto& stateCommands = stateGroup->stateCommands;
+        auto hoisted = [&](const ref_ptr<StateCommand>& stateCommand) {
+            return stateCommand && std::any_of(common.begin(), common.end(), [&](const ref_ptr<StateCommand>& sc) { return sc->slot == stateCommand->slot; });
+        };
+        stateCommands.erase(std::remove_if(stateCommands.begin(), stateCommands.end(), hoisted), stateCommands.end());
+    }
+
+    numStateCommandsHoisted += static_cast<uint32_t>(common.size());
+
+    if (parentStateGroup)
+    {
+        for (auto& stateCommand : common) parentStateGroup->add(stateCommand);
+    }
+    else
+    {
+        auto stateGroup = StateGroup::create();
+        stateGroup->stateCommands = common;
+        stateGroup->children.swap(children);
+        children.push_back(stateGroup);
+
+        if (removeEmptyStateGroups) _removeEmptyStateGroups(*stateGroup);
+    }
+}
+
+void OptimizeStateGroups::_removeEmptyStateGroups(Group& group)
+{
+    auto& children = group.children;
+    for (auto itr = children.begin(); itr != children.end();)
+    {
+        auto stateGroup = asStateGroup(itr->get());
+        if (stateGroup && !_isShared(stateGroup) && stateGroup->stateCommands.empty() && !stateGroup->prototypeArrayState)
+        {
+            auto grandChildren = stateGroup->children;
+            itr = children.erase(itr);
+            itr = children.insert(itr, grandChildren.begin(), grandChildren.end());
+            itr += grandChildren.size();
+            ++numStateGroupsRemoved;
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+void OptimizeStateGroups::report(LogOutput& output) const
+{
+    output("OptimizeStateGroups::report(..) ", this, " {");
+    output.in();
+    output("numStateCommandsShared = ", numStateCommandsShared);
+    output("numRedundantStateCommandsRemoved = ", numRedundantStateCommandsRemoved);
+    output("numStateGroupsMerged = ", numStateGroupsMerged);
+    output("numStateCommandsHoisted = ", numStateCommandsHoisted);
+    output("numStateGroupsRemoved = ", numStateGroupsRemoved);
+    output.out();
+    output("}");
+}
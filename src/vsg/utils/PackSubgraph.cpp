@@ -0,0 +1,552 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Commands.h>
+#include <vsg/commands/DrawIndexed.h>
+#include <vsg/nodes/BatchedCullGroup.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/nodes/CullNode.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/utils/ComputeBounds.h>
+#include <vsg/utils/PackSubgraph.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <typeinfo>
+
+using namespace vsg;
+
+namespace
+{
+    /// collect the draws of a subgraph into a PackedSubgraph, setting supported to false if a node that can't be packed is encountered.
+    struct CollectPackedDraws : public ConstVisitor
+    {
+        ref_ptr<PackedSubgraph> packed = PackedSubgraph::create();
+        bool supported = true;
+
+        std::vector<dmat4> matrixStack;
+        std::vector<uint32_t> transformIndexStack;
+        std::vector<uint32_t> stateIndexStack;
+        std::vector<ref_ptr<ArrayState>> arrayStateStack;
+
+        CollectPackedDraws()
+        {
+            // index 0 is the identity transform and empty state set
+            packed->transforms.emplace_back();
+            packed->stateSets.emplace_back();
+
+            matrixStack.emplace_back();
+            transformIndexStack.push_back(0);
+            stateIndexStack.push_back(0);
+            arrayStateStack.push_back(ArrayState::create());
+        }
+
+        void apply(const Object&) override
+        {
+            supported = false;
+        }
+
+        void apply(const Group& group) override
+        {
+            if (!supported) return;
+
+            // only plain grouping nodes can be packed, subclasses such as AnimationGroup, View or RenderGraph have behavior beyond grouping
+            const auto& type = group.type_info();
+            if (type == typeid(Group) || type == typeid(CullGroup) || type == typeid(BatchedCullGroup))
+                group.traverse(*this);
+            else
+                supported = false;
+        }
+
+        void apply(const CullNode& cullNode) override
+        {
+            if (!supported) return;
+
+            if (cullNode.type_info() == typeid(CullNode))
+                cullNode.traverse(*this);
+            else
+                supported = false;
+        }
+
+        void apply(const MatrixTransform& transform) override
+        {
+            if (!supported) return;
+
+            if (transform.type_info() != typeid(MatrixTransform))
+            {
+                supported = false;
+                return;
+            }
+
+            matrixStack.push_back(matrixStack.back() * transform.matrix);
+            transformIndexStack.push_back(static_cast<uint32_t>(packed->transforms.size()));
+            packed->transforms.push_back(matrixStack.back());
+
+            transform.traverse(*this);
+
+            transformIndexStack.pop_back();
+            matrixStack.pop_back();
+        }
+
+        void apply(const StateGroup& stategroup) override
+        {
+            if (!supported) return;
+
+            if (stategroup.type_info() != typeid(StateGroup))
+            {
+                supported = false;
+                return;
+            }
+
+            auto arrayState = stategroup.prototypeArrayState ? stategroup.prototypeArrayState->cloneArrayState(arrayStateStack.back()) : arrayStateStack.back()->cloneArrayState();
+            for (auto& statecommand : stategroup.stateCommands)
+            {
+                statecommand->accept(*arrayState);
+            }
+            arrayStateStack.push_back(std::move(arrayState));
+
+            if (stategroup.stateCommands.empty())
+            {
+                stateIndexStack.push_back(stateIndexStack.back());
+            }
+            else
+            {
+                auto stateSet = packed->stateSets[stateIndexStack.back()];
+                stateSet.insert(stateSet.end(), stategroup.stateCommands.begin(), stategroup.stateCommands.end());
+
+                stateIndexStack.push_back(static_cast<uint32_t>(packed->stateSets.size()));
+                packed->stateSets.push_back(stateSet);
+            }
+
+            stategroup.traverse(*this);
+
+            stateIndexStack.pop_back();
+            arrayStateStack.pop_back();
+        }
+
+        void apply(const Commands& commands) override
+        {
+            addDraw(commands);
+        }
+
+        void apply(const Command& command) override
+        {
+            addDraw(command);
+        }
+
+        void addDraw(const Node& draw)
+        {
+            if (!supported) return;
+
+            ComputeBounds computeBounds(arrayStateStack.back()->cloneArrayState());
+            computeBounds.matrixStack.push_back(matrixStack.back());
+            draw.accept(computeBounds);
+
+            // draws without geometry, such as state binding commands, are never culled
+            dsphere bound(0.0, 0.0, 0.0, std::numeric_limits<double>::max());
+            if (computeBounds.bounds.valid())
+            {
+                const auto& bb = computeBounds.bounds;
+                bound.set((bb.min + bb.max) * 0.5, length(bb.max - bb.min) * 0.5);
+            }
+
+            packed->addDraw(bound, transformIndexStack.back(), stateIndexStack.back(), ref_ptr<Node>(const_cast<Node*>(&draw)));
+        }
+    };
+} // namespace
+
+ref_ptr<Node> vsg::packSubgraph(ref_ptr<Node> subgraph, size_t minimumNumDraws)
+{
+    if (!subgraph) return subgraph;
+
+    CollectPackedDraws collectPackedDraws;
+    subgraph->accept(collectPackedDraws);
+
+    if (collectPackedDraws.supported)
+    {
+        if (collectPackedDraws.packed->numDraws() >= minimumNumDraws) return collectPackedDraws.packed;
+        return subgraph;
+    }
+
+    // the subgraph can't be packed as a whole so pack what we can of its children
+    if (auto group = subgraph->cast<Group>())
+    {
+        for (auto& child : group->children)
+        {
+            child = packSubgraph(child, minimumNumDraws);
+        }
+    }
+
+    return subgraph;
+}
+
+ref_ptr<Node> vsg::unpackSubgraph(const PackedSubgraph& packedSubgraph)
+{
+    auto root = Group::create();
+
+    size_t count = std::min({packedSubgraph.draws.size(), packedSubgraph.transformIndices.size(), packedSubgraph.stateIndices.size()});
+
+    Group* parent = nullptr;
+    uint32_t previousTransformIndex = 0;
+    uint32_t previousStateIndex = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t transformIndex = packedSubgraph.transformIndices[i];
+        uint32_t stateIndex = packedSubgraph.stateIndices[i];
+
+        if (!parent || transformIndex != previousTransformIndex || stateIndex != previousStateIndex)
+        {
+            parent = root.get();
+
+            if (stateIndex < packedSubgraph.stateSets.size() && !packedSubgraph.stateSets[stateIndex].empty())
+            {
+                auto stateGroup = StateGroup::create();
+                stateGroup->stateCommands = packedSubgraph.stateSets[stateIndex];
+                parent->addChild(stateGroup);
+                parent = stateGroup.get();
+            }
+
+            if (transformIndex < packedSubgraph.transforms.size() && packedSubgraph.transforms[transformIndex] != dmat4())
+            {
+                auto transform = MatrixTransform::create(packedSubgraph.transforms[transformIndex]);
+                parent->addChild(transform);
+                parent = transform.get();
+            }
+
+            previousTransformIndex = transformIndex;
+            previousStateIndex = stateIndex;
+        }
+
+        parent->addChild(packedSubgraph.draws[i]);
+    }
+
+    return root;
+}
+
+namespace
+{
+    /// collect the indexed draws of a subgraph for packing into a PackedDraws, setting supported to false if a node that can't be packed is encountered.
+    struct CollectIndexedDraws : public ConstVisitor
+    {
+        struct IndexedDraw
+        {
+            const BufferInfoList* arrays = nullptr;
+            uint32_t firstBinding = 0;
+            const BufferInfo* indices = nullptr;
+            uint32_t firstIndex = 0;
+            uint32_t indexCount = 0;
+            int32_t vertexOffset = 0;
+            uint32_t stateIndex = 0;
+            sphere bound;
+        };
+
+        std::vector<IndexedDraw> draws;
+        std::vector<StateCommands> stateSets;
+        bool supported = true;
+
+        std::vector<uint32_t> stateIndexStack;
+        std::vector<ref_ptr<ArrayState>> arrayStateStack;
+
+        CollectIndexedDraws()
+        {
+            // index 0 is the empty state set
+            stateSets.emplace_back();
+            stateIndexStack.push_back(0);
+            arrayStateStack.push_back(ArrayState::create());
+        }
+
+        void apply(const Object&) override
+        {
+            supported = false;
+        }
+
+        void apply(const Group& group) override
+        {
+            if (!supported) return;
+
+            const auto& type = group.type_info();
+            if (type == typeid(Group) || type == typeid(CullGroup) || type == typeid(BatchedCullGroup))
+                group.traverse(*this);
+            else
+                supported = false;
+        }
+
+        void apply(const CullNode& cullNode) override
+        {
+            if (!supported) return;
+
+            if (cullNode.type_info() == typeid(CullNode))
+                cullNode.traverse(*this);
+            else
+                supported = false;
+        }
+
+        void apply(const StateGroup& stategroup) override
+        {
+            if (!supported) return;
+
+            if (stategroup.type_info() != typeid(StateGroup))
+            {
+                supported = false;
+                return;
+            }
+
+            auto arrayState = stategroup.prototypeArrayState ? stategroup.prototypeArrayState->cloneArrayState(arrayStateStack.back()) : arrayStateStack.back()->cloneArrayState();
+            for (auto& statecommand : stategroup.stateCommands)
+            {
+                statecommand->accept(*arrayState);
+            }
+            arrayStateStack.push_back(std::move(arrayState));
+
+            if (stategroup.stateCommands.empty())
+            {
+                stateIndexStack.push_back(stateIndexStack.back());
+            }
+            else
+            {
+                auto stateSet = stateSets[stateIndexStack.back()];
+                stateSet.insert(stateSet.end(), stategroup.stateCommands.begin(), stategroup.stateCommands.end());
+
+                stateIndexStack.push_back(static_cast<uint32_t>(stateSets.size()));
+                stateSets.push_back(stateSet);
+            }
+
+            stategroup.traverse(*this);
+
+            stateIndexStack.pop_back();
+            arrayStateStack.pop_back();
+        }
+
+        void apply(const VertexIndexDraw& vid) override
+        {
+            if (!supported) return;
+
+            if (vid.instanceCount > 1 || vid.firstInstance != 0 || !vid.indices)
+            {
+                supported = false;
+                return;
+            }
+
+            addDraw(vid.arrays, vid.firstBinding, vid.indices, vid.firstIndex, vid.indexCount, vid.vertexOffset);
+        }
+
+        void apply(const Geometry& geometry) override
+        {
+            if (!supported) return;
+
+            if (!geometry.indices)
+            {
+                supported = false;
+                return;
+            }
+
+            for (auto& command : geometry.commands)
+            {
+                auto drawIndexed = command.cast<DrawIndexed>();
+                if (!drawIndexed || drawIndexed->instanceCount > 1 || drawIndexed->firstInstance != 0)
+                {
+                    supported = false;
+                    return;
+                }
+            }
+
+            for (auto& command : geometry.commands)
+            {
+                auto drawIndexed = command.cast<DrawIndexed>();
+                addDraw(geometry.arrays, geometry.firstBinding, geometry.indices, drawIndexed->firstIndex, drawIndexed->indexCount, drawIndexed->vertexOffset);
+            }
+        }
+
+        void addDraw(const BufferInfoList& arrays, uint32_t firstBinding, const BufferInfo* indices, uint32_t firstIndex, uint32_t indexCount, int32_t vertexOffset)
+        {
+            // compute the bounds of just this draw's index range, as the draws of a Geometry may use different parts of the vertex arrays
+            ComputeBounds computeBounds(arrayStateStack.back()->cloneArrayState());
+            computeBounds.arrayStateStack.back()->applyArrays(firstBinding, arrays);
+            indices->accept(computeBounds);
+            computeBounds.applyDrawIndexed(firstIndex, indexCount, 0, static_cast<uint32_t>(vertexOffset), 1);
+
+            sphere bound;
+            if (computeBounds.bounds.valid())
+            {
+                const auto& bb = computeBounds.bounds;
+                bound.set(vec3((bb.min + bb.max) * 0.5), static_cast<float>(length(bb.max - bb.min) * 0.5));
+            }
+
+            draws.push_back(IndexedDraw{&arrays, firstBinding, indices, firstIndex, indexCount, vertexOffset, stateIndexStack.back(), bound});
+        }
+    };
+
+    template<class A>
+    ref_ptr<Data> concatenateArrays(const std::vector<const Data*>& sources, size_t numValues)
+    {
+        auto concatenated = A::create(numValues);
+        concatenated->properties.format = sources.front()->properties.format;
+
+        size_t i = 0;
+        for (auto source : sources)
+        {
+            for (auto& value : *static_cast<const A*>(source)) concatenated->at(i++) = value;
+        }
+        return concatenated;
+    }
+
+    // concatenate the arrays into a single array, returns null if the array type isn't supported.
+    ref_ptr<Data> concatenateArrays(const std::vector<const Data*>& sources, size_t numValues)
+    {
+        const auto& type = typeid(*sources.front());
+        if (type == typeid(vec3Array)) return concatenateArrays<vec3Array>(sources, numValues);
+        if (type == typeid(vec2Array)) return concatenateArrays<vec2Array>(sources, numValues);
+        if (type == typeid(vec4Array)) return concatenateArrays<vec4Array>(sources, numValues);
+        if (type == typeid(floatArray)) return concatenateArrays<floatArray>(sources, numValues);
+        if (type == typeid(ubvec4Array)) return concatenateArrays<ubvec4Array>(sources, numValues);
+        if (type == typeid(svec2Array)) return concatenateArrays<svec2Array>(sources, numValues);
+        if (type == typeid(svec4Array)) return concatenateArrays<svec4Array>(sources, numValues);
+        if (type == typeid(usvec2Array)) return concatenateArrays<usvec2Array>(sources, numValues);
+        if (type == typeid(usvec4Array)) return concatenateArrays<usvec4Array>(sources, numValues);
+        if (type == typeid(uintArray)) return concatenateArrays<uintArray>(sources, numValues);
+        return {};
+    }
+
+    uint32_t readIndex(const Data& indices, uint32_t i)
+    {
+        if (auto us = indices.cast<ushortArray>()) return us->at(i);
+        if (auto ui = indices.cast<uintArray>()) return ui->at(i);
+        if (auto ub = indices.cast<ubyteArray>()) return ub->at(i);
+        return 0;
+    }
+
+    ref_ptr<PackedDraws> createPackedDraws(const CollectIndexedDraws& collected)
+    {
+        const auto& draws = collected.draws;
+        if (draws.empty()) return {};
+
+        // all the draws must provide the same vertex array layout
+        const auto& first = draws.front();
+        for (auto& draw : draws)
+        {
+            if (draw.firstBinding != first.firstBinding || draw.arrays->size() != first.arrays->size() || draw.arrays->empty()) return {};
+            if (!draw.indices->data || draw.vertexOffset < 0) return {};
+
+            size_t numVertices = 0;
+            for (size_t i = 0; i < draw.arrays->size(); ++i)
+            {
+                auto& bufferInfo = (*draw.arrays)[i];
+                auto& firstBufferInfo = (*first.arrays)[i];
+                if (!bufferInfo || !bufferInfo->data || bufferInfo->offset != 0 || bufferInfo->data->dynamic()) return {};
+                if (typeid(*bufferInfo->data) != typeid(*firstBufferInfo->data)) return {};
+
+                if (i == 0) numVertices = bufferInfo->data->valueCount();
+                if (bufferInfo->data->valueCount() != numVertices) return {};
+            }
+        }
+
+        // assign each distinct set of vertex arrays its base vertex in the concatenated arrays
+        std::map<std::vector<const Data*>, uint32_t> baseVertices;
+        std::vector<std::vector<const Data*>> vertexSets;
+        uint64_t numVertices = 0;
+        uint64_t numIndices = 0;
+        for (auto& draw : draws)
+        {
+            std::vector<const Data*> vertexSet;
+            for (auto& bufferInfo : *draw.arrays) vertexSet.push_back(bufferInfo->data);
+
+            if (baseVertices.emplace(vertexSet, static_cast<uint32_t>(numVertices)).second)
+            {
+                numVertices += vertexSet.front()->valueCount();
+                vertexSets.push_back(vertexSet);
+            }
+            numIndices += draw.indexCount;
+        }
+        if (numVertices > std::numeric_limits<uint32_t>::max() || numIndices > std::numeric_limits<uint32_t>::max()) return {};
+
+        DataList arrays;
+        for (size_t i = 0; i < first.arrays->size(); ++i)
+        {
+            std::vector<const Data*> sources;
+            for (auto& vertexSet : vertexSets) sources.push_back(vertexSet[i]);
+
+            auto concatenated = concatenateArrays(sources, static_cast<size_t>(numVertices));
+            if (!concatenated) return {};
+            arrays.push_back(concatenated);
+        }
+
+        auto packed = PackedDraws::create();
+        packed->stateSets = collected.stateSets;
+
+        ref_ptr<ushortArray> ushortIndices;
+        ref_ptr<uintArray> uintIndices;
+        if (numVertices < std::numeric_limits<uint16_t>::max())
+            ushortIndices = ushortArray::create(static_cast<size_t>(numIndices));
+        else
+            uintIndices = uintArray::create(static_cast<size_t>(numIndices));
+
+        uint32_t position = 0;
+        for (auto& draw : draws)
+        {
+            std::vector<const Data*> vertexSet;
+            for (auto& bufferInfo : *draw.arrays) vertexSet.push_back(bufferInfo->data);
+            uint32_t base = baseVertices[vertexSet] + static_cast<uint32_t>(draw.vertexOffset);
+
+            const auto& indices = *draw.indices->data;
+            uint32_t indexCount = std::min(draw.indexCount, static_cast<uint32_t>(indices.valueCount()) - std::min(draw.firstIndex, static_cast<uint32_t>(indices.valueCount())));
+
+            packed->addDraw(draw.bound, draw.stateIndex, position, indexCount);
+            for (uint32_t i = draw.firstIndex; i < draw.firstIndex + indexCount; ++i)
+            {
+                uint32_t index = readIndex(indices, i) + base;
+                if (ushortIndices)
+                    ushortIndices->at(position++) = static_cast<uint16_t>(index);
+                else
+                    uintIndices->at(position++) = index;
+            }
+        }
+
+        packed->bindVertexBuffers = BindVertexBuffers::create(first.firstBinding, arrays);
+        if (ushortIndices)
+            packed->bindIndexBuffer = BindIndexBuffer::create(ushortIndices);
+        else
+            packed->bindIndexBuffer = BindIndexBuffer::create(uintIndices);
+
+        return packed;
+    }
+} // namespace
+
+ref_ptr<Node> vsg::packDraws(ref_ptr<Node> subgraph, size_t minimumNumDraws)
+{
+    if (!subgraph) return subgraph;
+
+    CollectIndexedDraws collectIndexedDraws;
+    subgraph->accept(collectIndexedDraws);
+
+    if (collectIndexedDraws.supported)
+    {
+        if (collectIndexedDraws.draws.size() < minimumNumDraws) return subgraph;
+        if (auto packed = createPackedDraws(collectIndexedDraws)) return packed;
+        return subgraph;
+    }
+
+    // the subgraph can't be packed as a whole so pack what we can of its children
+    if (auto group = subgraph->cast<Group>())
+    {
+        for (auto& child : group->children)
+        {
+            child = packDraws(child, minimumNumDraws);
+        }
+    }
+
+    return subgraph;
+}
@@ -0,0 +1,430 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/commands/BindVertexBuffers.h>
+#include <vsg/core/compare.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/state/BindDescriptorSet.h>
+#include <vsg/utils/PackTextures.h>
+
+#include <algorithm>
+#include <typeindex>
+#include <typeinfo>
+
+using namespace vsg;
+
+namespace
+{
+    bool supportedImageType(const std::type_info& type)
+    {
+        return type == typeid(ubyteArray2D) || type == typeid(ubvec2Array2D) || type == typeid(ubvec3Array2D) || type == typeid(ubvec4Array2D) || type == typeid(vec4Array2D);
+    }
+
+    template<class A>
+    ref_ptr<Data> createAtlas(uint32_t width, uint32_t height, const Data::Properties& properties)
+    {
+        return A::create(width, height, typename A::value_type{}, properties);
+    }
+
+    ref_ptr<Data> createAtlas(const std::type_info& type, uint32_t width, uint32_t height, const Data::Properties& properties)
+    {
+        if (type == typeid(ubyteArray2D)) return createAtlas<ubyteArray2D>(width, height, properties);
+        if (type == typeid(ubvec2Array2D)) return createAtlas<ubvec2Array2D>(width, height, properties);
+        if (type == typeid(ubvec3Array2D)) return createAtlas<ubvec3Array2D>(width, height, properties);
+        if (type == typeid(ubvec4Array2D)) return createAtlas<ubvec4Array2D>(width, height, properties);
+        if (type == typeid(vec4Array2D)) return createAtlas<vec4Array2D>(width, height, properties);
+        return {};
+    }
+
+    // copy the source image into the atlas, replicating the edge texels into the padding around it.
+    template<class A>
+    void copyImage(const Data& source, Data& atlas, const uivec2& offset, int padding)
+    {
+        auto& src = static_cast<const A&>(source);
+        auto& dest = static_cast<A&>(atlas);
+
+        int width = static_cast<int>(src.width());
+        int height = static_cast<int>(src.height());
+        for (int j = -padding; j < height + padding; ++j)
+        {
+            uint32_t sj = static_cast<uint32_t>(std::clamp(j, 0, height - 1));
+            for (int i = -padding; i < width + padding; ++i)
+            {
+                uint32_t si = static_cast<uint32_t>(std::clamp(i, 0, width - 1));
+                dest.set(static_cast<uint32_t>(static_cast<int>(offset.x) + i), static_cast<uint32_t>(static_cast<int>(offset.y) + j), src.at(si, sj));
+            }
+        }
+    }
+
+    void copyImage(const Data& source, Data& atlas, const uivec2& offset, int padding)
+    {
+        const auto& type = typeid(source);
+        if (type == typeid(ubyteArray2D)) copyImage<ubyteArray2D>(source, atlas, offset, padding);
+        else if (type == typeid(ubvec2Array2D)) copyImage<ubvec2Array2D>(source, atlas, offset, padding);
+        else if (type == typeid(ubvec3Array2D)) copyImage<ubvec3Array2D>(source, atlas, offset, padding);
+        else if (type == typeid(ubvec4Array2D)) copyImage<ubvec4Array2D>(source, atlas, offset, padding);
+        else if (type == typeid(vec4Array2D)) copyImage<vec4Array2D>(source, atlas, offset, padding);
+    }
+
+    bool identity(const VkComponentMapping& components)
+    {
+        return components.r == VK_COMPONENT_SWIZZLE_IDENTITY && components.g == VK_COMPONENT_SWIZZLE_IDENTITY &&
+               components.b == VK_COMPONENT_SWIZZLE_IDENTITY && components.a == VK_COMPONENT_SWIZZLE_IDENTITY;
+    }
+} // namespace
+
+PackTextures::PackTextures()
+{
+}
+
+PackTextures::~PackTextures()
+{
+}
+
+bool PackTextures::_packable(const ImageInfo& imageInfo) const
+{
+    if (!imageInfo.sampler || !imageInfo.imageView || !imageInfo.imageView->image) return false;
+
+    auto& imageView = *imageInfo.imageView;
+    auto& data = imageView.image->data;
+    if (!data || imageView.viewType != VK_IMAGE_VIEW_TYPE_2D || !identity(imageView.components)) return false;
+    if (imageView.format != VK_FORMAT_UNDEFINED && imageView.format != data->properties.format) return false;
+    if (!supportedImageType(typeid(*data)) || data->dimensions() != 2) return false;
+
+    auto& properties = data->properties;
+    if (properties.mipLevels > 1 || properties.blockWidth != 1 || properties.blockHeight != 1 || properties.dataVariance != STATIC_DATA) return false;
+
+    uint32_t maxDimension = std::min(maxTextureDimension, atlasDimension - std::min(atlasDimension, 2 * padding));
+    return data->width() <= maxDimension && data->height() <= maxDimension;
+}
+
+PackTextures::Texture* PackTextures::_texture(const DescriptorSet& descriptorSet, bool& unpackable)
+{
+    DescriptorImage* descriptorImage = nullptr;
+    for (auto& descriptor : descriptorSet.descriptors)
+    {
+        if (auto di = descriptor.cast<DescriptorImage>())
+        {
+            // the texture coordinates may be used by more than one image so only DescriptorSets with a single DescriptorImage are packed.
+            if (descriptorImage)
+            {
+                unpackable = true;
+                return nullptr;
+            }
+            descriptorImage = di;
+        }
+    }
+
+    if (!descriptorImage) return nullptr;
+
+    if (descriptorImage->descriptorType != VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER || descriptorImage->imageInfoList.size() != 1 || !_packable(*descriptorImage->imageInfoList.front()))
+    {
+        unpackable = true;
+        return nullptr;
+    }
+
+    auto& imageInfo = *descriptorImage->imageInfoList.front();
+    auto& data = imageInfo.imageView->image->data;
+
+    auto& texture = _textures[data.get()];
+    if (!texture.image)
+    {
+        texture.image = data;
+        texture.sampler = imageInfo.sampler;
+    }
+    else if (compare_pointer(texture.sampler, imageInfo.sampler) != 0)
+    {
+        // the same image used with different Samplers can't be placed in a single atlas
+        texture.valid = false;
+    }
+
+    texture.descriptorImages.insert(descriptorImage);
+    return &texture;
+}
+
+void PackTextures::_texCoords(const BufferInfoList& arrays)
+{
+    vec2Array* texCoords = nullptr;
+    if (texCoordArrayIndex < arrays.size() && arrays[texCoordArrayIndex] && arrays[texCoordArrayIndex]->data) texCoords = arrays[texCoordArrayIndex]->data.cast<vec2Array>();
+
+    if (!texCoords)
+    {
+        if (_current) _current->valid = false;
+        return;
+    }
+
+    if (_current && texCoords->properties.dataVariance != STATIC_DATA) _current->valid = false;
+
+    _texCoordUsers[ref_ptr<vec2Array>(texCoords)].insert(_current);
+}
+
+void PackTextures::apply(Node& node)
+{
+    if (!_visited.emplace(&node, _current).second) return;
+
+    node.traverse(*this);
+}
+
+void PackTextures::apply(StateGroup& stateGroup)
+{
+    if (!_visited.emplace(&stateGroup, _current).second) return;
+
+    Texture* texture = nullptr;
+    bool unpackable = false;
+    auto checkDescriptorSet = [&](const DescriptorSet* descriptorSet) {
+        if (!descriptorSet) return;
+        if (auto t = _texture(*descriptorSet, unpackable))
+        {
+            if (texture && texture != t) unpackable = true;
+            texture = t;
+        }
+    };
+
+    for (auto& stateCommand : stateGroup.stateCommands)
+    {
+        if (auto bds = stateCommand.cast<BindDescriptorSet>())
+        {
+            checkDescriptorSet(bds->descriptorSet);
+        }
+        else if (auto bdss = stateCommand.cast<BindDescriptorSets>())
+        {
+            for (auto& descriptorSet : bdss->descriptorSets) checkDescriptorSet(descriptorSet);
+        }
+    }
+
+    auto previous = _current;
+    if (unpackable)
+    {
+        // the subgraph uses textures that aren't packed
+        if (texture) texture->valid = false;
+        if (previous) previous->valid = false;
+        _current = nullptr;
+    }
+    else if (texture)
+    {
+        // nested textures may both be sampled by the subgraph so can't have their texture coordinates remapped
+        if (previous && previous != texture)
+        {
+            previous->valid = false;
+            texture->valid = false;
+        }
+        _current = texture;
+    }
+
+    stateGroup.traverse(*this);
+
+    _current = previous;
+}
+
+void PackTextures::apply(Geometry& geometry)
+{
+    _texCoords(geometry.arrays);
+}
+
+void PackTextures::apply(VertexDraw& vd)
+{
+    _texCoords(vd.arrays);
+}
+
+void PackTextures::apply(VertexIndexDraw& vid)
+{
+    _texCoords(vid.arrays);
+}
+
+void PackTextures::apply(BindVertexBuffers& bvb)
+{
+    _texCoords(bvb.arrays);
+}
+
+void PackTextures::_invalidateConflicts()
+{
+    for (auto& [texCoords, users] : _texCoordUsers)
+    {
+        // texture coordinates shared with geometry using other textures, or none, can't be remapped
+        if (users.size() > 1)
+        {
+            for (auto& texture : users)
+            {
+                if (texture) texture->valid = false;
+            }
+            continue;
+        }
+
+        // texture coordinates outside the 0 to 1 range would sample the neighbouring textures in the atlas
+        auto texture = *users.begin();
+        if (texture && texture->valid)
+        {
+            const float epsilon = 1e-4f;
+            for (auto& tc : *texCoords)
+            {
+                if (tc.x < -epsilon || tc.x > 1.0f + epsilon || tc.y < -epsilon || tc.y > 1.0f + epsilon)
+                {
+                    texture->valid = false;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void PackTextures::_packTextures(const std::vector<Texture*>& textures)
+{
+    auto sorted = textures;
+    std::sort(sorted.begin(), sorted.end(), [](const Texture* lhs, const Texture* rhs) { return lhs->image->height() > rhs->image->height(); });
+
+    struct Layout
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<std::pair<Texture*, uivec2>> placements;
+    };
+
+    // place the textures in rows of decreasing height, starting a new atlas when full
+    std::vector<Layout> layouts(1);
+    uint32_t x = 0, y = 0, rowHeight = 0;
+    for (auto texture : sorted)
+    {
+        uint32_t width = texture->image->width() + 2 * padding;
+        uint32_t height = texture->image->height() + 2 * padding;
+        if (x + width > atlasDimension)
+        {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        if (y + height > atlasDimension)
+        {
+            layouts.emplace_back();
+            x = y = rowHeight = 0;
+        }
+
+        auto& layout = layouts.back();
+        layout.placements.emplace_back(texture, uivec2(x + padding, y + padding));
+        layout.width = std::max(layout.width, x + width);
+        layout.height = std::max(layout.height, y + height);
+
+        x += width;
+        rowHeight = std::max(rowHeight, height);
+    }
+
+    for (auto& layout : layouts)
+    {
+        if (layout.placements.size() < minimumNumTextures) continue;
+
+        auto& front = *layout.placements.front().first;
+        Data::Properties properties;
+        properties.format = front.image->properties.format;
+        properties.origin = front.image->properties.origin;
+        properties.imageViewType = front.image->properties.imageViewType;
+
+        auto atlas = createAtlas(typeid(*front.image), layout.width, layout.height, properties);
+        if (!atlas) continue;
+
+        vec2 atlasSize(static_cast<float>(layout.width), static_cast<float>(layout.height));
+        for (auto& [texture, offset] : layout.placements)
+        {
+            copyImage(*texture->image, *atlas, offset, static_cast<int>(padding));
+
+            texture->packed = true;
+            texture->texCoordScale.set(static_cast<float>(texture->image->width()) / atlasSize.x, static_cast<float>(texture->image->height()) / atlasSize.y);
+            texture->texCoordOffset.set(static_cast<float>(offset.x) / atlasSize.x, static_cast<float>(offset.y) / atlasSize.y);
+            ++numTexturesPacked;
+        }
+
+        // share a single ImageInfo so the DescriptorImage referencing the atlas compare as equal
+        auto imageInfo = ImageInfo::create(front.sampler, atlas);
+        for (auto& placement : layout.placements)
+        {
+            for (auto descriptorImage : placement.first->descriptorImages)
+            {
+                descriptorImage->imageInfoList.front() = imageInfo;
+                ++numDescriptorImagesReplaced;
+            }
+        }
+
+        ++numAtlases;
+    }
+}
+
+void PackTextures::pack(Node& node)
+{
+    _textures.clear();
+    _texCoordUsers.clear();
+    _visited.clear();
+    _current = nullptr;
+
+    node.accept(*this);
+
+    _invalidateConflicts();
+
+    struct AtlasKey
+    {
+        std::type_index type;
+        VkFormat format;
+        uint8_t origin;
+        const Sampler* sampler;
+
+        bool operator<(const AtlasKey& rhs) const
+        {
+            if (type != rhs.type) return type < rhs.type;
+            if (format != rhs.format) return format < rhs.format;
+            if (origin != rhs.origin) return origin < rhs.origin;
+            return sampler->compare(*rhs.sampler) < 0;
+        }
+    };
+
+    std::map<AtlasKey, std::vector<Texture*>> groups;
+    for (auto& [image, texture] : _textures)
+    {
+        if (texture.valid)
+        {
+            groups[AtlasKey{std::type_index(typeid(*image)), image->properties.format, image->properties.origin, texture.sampler.get()}].push_back(&texture);
+        }
+    }
+
+    for (auto& [key, textures] : groups)
+    {
+        if (textures.size() >= minimumNumTextures) _packTextures(textures);
+    }
+
+    for (auto& [texCoords, users] : _texCoordUsers)
+    {
+        auto texture = *users.begin();
+        if (users.size() != 1 || !texture || !texture->packed) continue;
+
+        for (auto& tc : *texCoords)
+        {
+            tc = texture->texCoordOffset + tc * texture->texCoordScale;
+        }
+        texCoords->dirty();
+        ++numTexCoordArraysRemapped;
+    }
+
+    _textures.clear();
+    _texCoordUsers.clear();
+    _visited.clear();
+}
+
+void PackTextures::report(LogOutput& output) const
+{
+    output("PackTextures::report(..) ", this, " {");
+    output.in();
+    output("numTexturesPacked = ", numTexturesPacked);
+    output("numAtlases = ", numAtlases);
+    output("numDescriptorImagesReplaced = ", numDescriptorImagesReplaced);
+    output("numTexCoordArraysRemapped = ", numTexCoordArraysRemapped);
+    output.out();
+    output("}");
+}
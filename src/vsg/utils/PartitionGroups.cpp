@@ -0,0 +1,242 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Command.h>
+#include <vsg/nodes/CullGroup.h>
+#include <vsg/utils/ComputeBounds.h>
+#include <vsg/utils/PartitionGroups.h>
+
+#include <algorithm>
+#include <limits>
+#include <typeinfo>
+
+using namespace vsg;
+
+namespace
+{
+    struct CountParents : public Visitor
+    {
+        explicit CountParents(std::map<const Node*, uint32_t>& in_parentCounts) :
+            parentCounts(in_parentCounts) {}
+
+        std::map<const Node*, uint32_t>& parentCounts;
+
+        void apply(Node& node) override
+        {
+            if (++parentCounts[&node] == 1) node.traverse(*this);
+        }
+    };
+
+    double surfaceArea(const dbox& bounds)
+    {
+        if (!bounds.valid()) return 0.0;
+        dvec3 d = bounds.max - bounds.min;
+        return 2.0 * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    dsphere boundingSphere(const dbox& bounds)
+    {
+        return dsphere((bounds.min + bounds.max) * 0.5, length(bounds.max - bounds.min) * 0.5);
+    }
+} // namespace
+
+PartitionGroups::PartitionGroups()
+{
+}
+
+PartitionGroups::~PartitionGroups()
+{
+}
+
+bool PartitionGroups::_isShared(const Node* node) const
+{
+    auto itr = _parentCounts.find(node);
+    return itr != _parentCounts.end() && itr->second > 1;
+}
+
+void PartitionGroups::partition(Node& node)
+{
+    _parentCounts.clear();
+
+    CountParents countParents(_parentCounts);
+    node.accept(countParents);
+
+    node.accept(*this);
+
+    _parentCounts.clear();
+}
+
+void PartitionGroups::apply(Node& node)
+{
+    if (_isShared(&node)) return;
+
+    node.traverse(*this);
+}
+
+void PartitionGroups::apply(Group& group)
+{
+    if (_isShared(&group)) return;
+
+    for (auto& child : group.children) child->accept(*this);
+
+    // only operate on Groups of exactly type Group, subclasses may have behaviour that depends on their children.
+    if (typeid(group) == typeid(Group) && group.children.size() > minChildren) _partition(group);
+}
+
+void PartitionGroups::_partition(Group& group)
+{
+    // Commands apply to the siblings that follow them so the children can't be reordered
+    for (auto& child : group.children)
+    {
+        if (child->is_compatible(typeid(Command))) return;
+    }
+
+    Group::Children unbounded;
+    Items items;
+    items.reserve(group.children.size());
+    for (auto& child : group.children)
+    {
+        ComputeBounds computeBounds;
+        child->accept(computeBounds);
+        if (computeBounds.bounds.valid())
+            items.push_back(Item{child, computeBounds.bounds, (computeBounds.bounds.min + computeBounds.bounds.max) * 0.5});
+        else
+            unbounded.push_back(child);
+    }
+
+    if (items.size() <= minChildren) return;
+
+    auto root = _build(items.begin(), items.end());
+
+    // children without bounds, such as lights, are kept ahead of the hierarchy
+    group.children = unbounded;
+    if (auto rootGroup = root.cast<CullGroup>())
+    {
+        group.children.insert(group.children.end(), rootGroup->children.begin(), rootGroup->children.end());
+        --numCullGroupsCreated;
+    }
+    else
+    {
+        group.children.push_back(root);
+    }
+
+    ++numGroupsPartitioned;
+}
+
+ref_ptr<Node> PartitionGroups::_build(Items::iterator begin, Items::iterator end)
+{
+    dbox bounds;
+    dbox centroidBounds;
+    for (auto itr = begin; itr != end; ++itr)
+    {
+        bounds.add(itr->bounds);
+        centroidBounds.add(itr->centroid);
+    }
+
+    auto cullGroup = CullGroup::create(boundingSphere(bounds));
+    ++numCullGroupsCreated;
+
+    if (static_cast<uint32_t>(end - begin) <= std::max(maxLeafChildren, 1u))
+    {
+        for (auto itr = begin; itr != end; ++itr) cullGroup->addChild(itr->node);
+        return cullGroup;
+    }
+
+    auto mid = _split(begin, end, centroidBounds);
+    cullGroup->addChild(_build(begin, mid));
+    cullGroup->addChild(_build(mid, end));
+    return cullGroup;
+}
+
+PartitionGroups::Items::iterator PartitionGroups::_split(Items::iterator begin, Items::iterator end, const dbox& centroidBounds)
+{
+    dvec3 extents = centroidBounds.max - centroidBounds.min;
+    size_t longestAxis = (extents.x >= extents.y && extents.x >= extents.z) ? 0 : ((extents.y >= extents.z) ? 1 : 2);
+
+    auto medianSplit = [&](size_t axis) {
+        auto mid = begin + (end - begin) / 2;
+        std::nth_element(begin, mid, end, [axis](const Item& lhs, const Item& rhs) { return lhs.centroid[axis] < rhs.centroid[axis]; });
+        return mid;
+    };
+
+    // all the centroids coincide so no split can separate them
+    if (extents[longestAxis] <= 0.0) return begin + (end - begin) / 2;
+
+    if (!useSurfaceAreaHeuristic || numBins < 2) return medianSplit(longestAxis);
+
+    auto binIndex = [&](const Item& item, size_t axis) {
+        auto index = static_cast<uint32_t>(static_cast<double>(numBins) * (item.centroid[axis] - centroidBounds.min[axis]) / extents[axis]);
+        return std::min(index, numBins - 1);
+    };
+
+    // evaluate the cost of splitting between each pair of bins along each axis
+    double bestCost = std::numeric_limits<double>::max();
+    size_t bestAxis = longestAxis;
+    uint32_t bestSplit = 0;
+
+    std::vector<dbox> binBounds(numBins);
+    std::vector<size_t> binCounts(numBins);
+    std::vector<double> rightAreas(numBins);
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+        if (extents[axis] <= 0.0) continue;
+
+        std::fill(binBounds.begin(), binBounds.end(), dbox());
+        std::fill(binCounts.begin(), binCounts.end(), 0);
+        for (auto itr = begin; itr != end; ++itr)
+        {
+            auto index = binIndex(*itr, axis);
+            binBounds[index].add(itr->bounds);
+            ++binCounts[index];
+        }
+
+        dbox right;
+        for (uint32_t i = numBins - 1; i > 0; --i)
+        {
+            right.add(binBounds[i]);
+            rightAreas[i] = surfaceArea(right);
+        }
+
+        dbox left;
+        size_t leftCount = 0;
+        size_t total = static_cast<size_t>(end - begin);
+        for (uint32_t i = 1; i < numBins; ++i)
+        {
+            left.add(binBounds[i - 1]);
+            leftCount += binCounts[i - 1];
+            if (leftCount == 0 || leftCount == total) continue;
+
+            double cost = surfaceArea(left) * static_cast<double>(leftCount) + rightAreas[i] * static_cast<double>(total - leftCount);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i;
+            }
+        }
+    }
+
+    if (bestSplit == 0) return medianSplit(longestAxis);
+
+    return std::partition(begin, end, [&](const Item& item) { return binIndex(item, bestAxis) < bestSplit; });
+}
+
+void PartitionGroups::report(LogOutput& output) const
+{
+    output("PartitionGroups::report(..) ", this, " {");
+    output.in();
+    output("numGroupsPartitioned = ", numGroupsPartitioned);
+    output("numCullGroupsCreated = ", numCullGroupsCreated);
+    output.out();
+    output("}");
+}
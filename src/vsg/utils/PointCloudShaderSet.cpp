@@ -0,0 +1,156 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Options.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/state/InputAssemblyState.h>
+#include <vsg/utils/GraphicsPipelineConfigurator.h>
+#include <vsg/utils/PointCloudShaderSet.h>
+
+using namespace vsg;
+
+namespace
+{
+    const char* s_pointCloudVertexSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelView;
+} pc;
+
+// x = point size scale, y = minimum point size, z = maximum point size, w = viewport height
+layout(set = 0, binding = 0) uniform PointCloudSettings
+{
+    vec4 values;
+} settings;
+
+layout(location = 0) in vec3 vsg_Vertex;
+layout(location = 1) in vec4 vsg_Color;
+layout(location = 2) in float vsg_PointSpacing;
+
+layout(location = 0) out vec4 color;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+    float gl_PointSize;
+};
+
+void main()
+{
+    gl_Position = (pc.projection * pc.modelView) * vec4(vsg_Vertex, 1.0);
+
+    // project the spacing between points at the point's depth to pixels so the points of each chunk just cover the surface they sample,
+    // gl_Position.w is 1.0 for orthographic projections.
+    float pixels = vsg_PointSpacing * abs(pc.projection[1][1]) * 0.5 * settings.values.w / max(gl_Position.w, 1e-6);
+    gl_PointSize = clamp(pixels * settings.values.x, settings.values.y, settings.values.z);
+
+    color = vsg_Color;
+}
+)";
+
+    const char* s_pointCloudFragmentSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) in vec4 color;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    // round points
+    vec2 offset = gl_PointCoord * 2.0 - 1.0;
+    if (dot(offset, offset) > 1.0) discard;
+
+    outColor = color;
+}
+)";
+
+    ref_ptr<ubvec4Array> colorArray(size_t size)
+    {
+        auto colors = ubvec4Array::create(size, ubvec4(255, 255, 255, 255));
+        colors->properties.format = VK_FORMAT_R8G8B8A8_UNORM;
+        return colors;
+    }
+
+} // namespace
+
+ref_ptr<ShaderSet> vsg::createPointCloudShaderSet(ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("pointcloud"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    auto vertexShader = ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, "main", s_pointCloudVertexSource);
+    auto fragmentShader = ShaderStage::create(VK_SHADER_STAGE_FRAGMENT_BIT, "main", s_pointCloudFragmentSource);
+
+    auto shaderSet = ShaderSet::create(ShaderStages{vertexShader, fragmentShader});
+
+    shaderSet->addAttributeBinding("vsg_Vertex", "", 0, VK_FORMAT_R32G32B32_SFLOAT, vec3Array::create(1));
+    shaderSet->addAttributeBinding("vsg_Color", "", 1, VK_FORMAT_R8G8B8A8_UNORM, colorArray(1));
+    shaderSet->addAttributeBinding("vsg_PointSpacing", "", 2, VK_FORMAT_R32_SFLOAT, floatArray::create(1, 1.0f));
+
+    shaderSet->addDescriptorBinding("pointCloudSettings", "", 0, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, vec4Value::create(vec4(1.0f, 1.0f, 64.0f, 1080.0f)));
+
+    shaderSet->addPushConstantRange("pc", "", VK_SHADER_STAGE_VERTEX_BIT, 0, 128);
+
+    shaderSet->defaultGraphicsPipelineStates = {InputAssemblyState::create(VK_PRIMITIVE_TOPOLOGY_POINT_LIST)};
+
+    return shaderSet;
+}
+
+ref_ptr<StateGroup> vsg::createPointCloudStateGroup(ref_ptr<vec4Value> settings, ref_ptr<const Options> options, ref_ptr<SharedObjects> sharedObjects)
+{
+    auto shaderSet = createPointCloudShaderSet(options);
+    auto graphicsPipelineConfig = GraphicsPipelineConfigurator::create(shaderSet);
+
+    if (settings) graphicsPipelineConfig->assignDescriptor("pointCloudSettings", settings);
+
+    // the vertex input matches the arrays of the chunks created by createPointCloudChunk(..)
+    DataList arrays;
+    graphicsPipelineConfig->assignArray(arrays, "vsg_Vertex", VK_VERTEX_INPUT_RATE_VERTEX, vec3Array::create(1));
+    graphicsPipelineConfig->assignArray(arrays, "vsg_Color", VK_VERTEX_INPUT_RATE_VERTEX, colorArray(1));
+    graphicsPipelineConfig->assignArray(arrays, "vsg_PointSpacing", VK_VERTEX_INPUT_RATE_INSTANCE, floatArray::create(1, 1.0f));
+
+    if (sharedObjects)
+        sharedObjects->share(graphicsPipelineConfig, [](auto gpc) { gpc->init(); });
+    else
+        graphicsPipelineConfig->init();
+
+    auto stateGroup = StateGroup::create();
+    if (!graphicsPipelineConfig->copyTo(stateGroup, sharedObjects)) return {};
+
+    return stateGroup;
+}
+
+ref_ptr<Node> vsg::createPointCloudChunk(ref_ptr<vec3Array> vertices, ref_ptr<ubvec4Array> colors, float spacing)
+{
+    if (!vertices || vertices->empty()) return {};
+
+    if (!colors || colors->size() != vertices->size())
+    {
+        colors = colorArray(vertices->size());
+    }
+    else if (colors->properties.format == VK_FORMAT_UNDEFINED)
+    {
+        colors->properties.format = VK_FORMAT_R8G8B8A8_UNORM;
+    }
+
+    // the spacing is a per instance attribute so that a single pipeline can draw the chunks of all the levels of the octree
+    auto draw = VertexDraw::create();
+    draw->assignArrays(DataList{vertices, colors, floatArray::create(1, spacing)});
+    draw->vertexCount = static_cast<uint32_t>(vertices->size());
+    draw->instanceCount = 1;
+    return draw;
+}
@@ -300,6 +300,18 @@ bool PolytopeIntersector::intersects(const dsphere& bs)
     return vsg::intersect(polytope, bs);
 }
 
+// test only the triangles in the TriangleBVH leaves that the polytope reaches
+static void intersectTriangleBVH(const TriangleBVH& bvh, PolytopePrimitiveIntersection& primitiveIntersection, uint32_t firstInstance, uint32_t instanceCount)
+{
+    uint32_t lastIndex = instanceCount > 1 ? (firstInstance + instanceCount) : firstInstance + 1;
+    for (uint32_t instanceIndex = firstInstance; instanceIndex < lastIndex; ++instanceIndex)
+    {
+        if (!primitiveIntersection.instance(instanceIndex)) continue;
+
+        bvh.intersect(primitiveIntersection.polytope, [&](uint32_t i0, uint32_t i1, uint32_t i2) { primitiveIntersection.triangle(i0, i1, i2); });
+    }
+}
+
 bool PolytopeIntersector::intersectDraw(uint32_t firstVertex, uint32_t vertexCount, uint32_t firstInstance, uint32_t instanceCount)
 {
     size_t previous_size = intersections.size();
@@ -307,6 +319,13 @@ bool PolytopeIntersector::intersectDraw(uint32_t firstVertex, uint32_t vertexCou
     auto& arrayState = *arrayStateStack.back();
 
     vsg::PrimitiveFunctor<vsg::PolytopePrimitiveIntersection> printPrimitives(*this, arrayState, _polytopeStack.back());
+
+    if (auto bvh = getTriangleBVH(firstVertex, vertexCount, false))
+    {
+        intersectTriangleBVH(*bvh, printPrimitives, firstInstance, instanceCount);
+        return intersections.size() != previous_size;
+    }
+
     printPrimitives.draw(arrayState.topology, firstVertex, vertexCount, firstInstance, instanceCount);
 
     return intersections.size() != previous_size;
@@ -319,6 +338,13 @@ bool PolytopeIntersector::intersectDrawIndexed(uint32_t firstIndex, uint32_t ind
     auto& arrayState = *arrayStateStack.back();
 
     vsg::PrimitiveFunctor<vsg::PolytopePrimitiveIntersection> printPrimtives(*this, arrayState, _polytopeStack.back());
+
+    if (auto bvh = getTriangleBVH(firstIndex, indexCount, true))
+    {
+        intersectTriangleBVH(*bvh, printPrimtives, firstInstance, instanceCount);
+        return intersections.size() != previous_size;
+    }
+
     if (ubyte_indices)
         printPrimtives.drawIndexed(arrayState.topology, ubyte_indices, firstIndex, indexCount, firstInstance, instanceCount);
     else if (ushort_indices)
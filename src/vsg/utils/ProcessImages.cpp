@@ -0,0 +1,454 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Array2D.h>
+#include <vsg/core/Visitor.h>
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/maths/simd.h>
+#include <vsg/state/DescriptorImage.h>
+#include <vsg/utils/ProcessImages.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <set>
+
+#if defined(VSG_SIMD_AVX)
+#    include <tmmintrin.h>
+#endif
+
+using namespace vsg;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// pixel kernels
+//
+namespace
+{
+    /// lookup tables for converting 8 bit components between sRGB and linear, with 12 bit linear values used when filtering sRGB images
+    struct ColorSpaceTables
+    {
+        uint8_t sRGBToLinear[256];
+        uint8_t linearToSRGB[256];
+        uint16_t sRGBToLinear12[256];
+        uint8_t linear12ToSRGB[4096];
+
+        ColorSpaceTables()
+        {
+            for (int i = 0; i < 256; ++i)
+            {
+                float c = static_cast<float>(i) / 255.0f;
+                sRGBToLinear[i] = static_cast<uint8_t>(std::lround(sRGB_to_linear(c) * 255.0f));
+                linearToSRGB[i] = static_cast<uint8_t>(std::lround(linear_to_sRGB(c) * 255.0f));
+                sRGBToLinear12[i] = static_cast<uint16_t>(std::lround(sRGB_to_linear(c) * 4095.0f));
+            }
+            for (int i = 0; i < 4096; ++i)
+            {
+                linear12ToSRGB[i] = static_cast<uint8_t>(std::lround(linear_to_sRGB(static_cast<float>(i) / 4095.0f) * 255.0f));
+            }
+        }
+    };
+
+    const ColorSpaceTables& colorSpaceTables()
+    {
+        static const ColorSpaceTables s_tables;
+        return s_tables;
+    }
+
+    /// exact round(v / 255) for v <= 255 * 255
+    inline uint32_t div255(uint32_t v)
+    {
+        v += 128;
+        return (v + (v >> 8)) >> 8;
+    }
+
+    struct SourceFormat
+    {
+        uint32_t numComponents = 0;
+        bool srgb = false;
+        VkFormat rgbaFormat = VK_FORMAT_UNDEFINED;
+    };
+
+    SourceFormat sourceFormat(VkFormat format)
+    {
+        switch (format)
+        {
+        case VK_FORMAT_R8_UNORM: return {1, false, VK_FORMAT_UNDEFINED};
+        case VK_FORMAT_R8G8_UNORM: return {2, false, VK_FORMAT_UNDEFINED};
+        case VK_FORMAT_R8G8B8_UNORM: return {3, false, VK_FORMAT_R8G8B8A8_UNORM};
+        case VK_FORMAT_R8G8B8_SRGB: return {3, true, VK_FORMAT_R8G8B8A8_SRGB};
+        case VK_FORMAT_B8G8R8_UNORM: return {3, false, VK_FORMAT_B8G8R8A8_UNORM};
+        case VK_FORMAT_B8G8R8_SRGB: return {3, true, VK_FORMAT_B8G8R8A8_SRGB};
+        case VK_FORMAT_R8G8B8A8_UNORM: return {4, false, format};
+        case VK_FORMAT_R8G8B8A8_SRGB: return {4, true, format};
+        case VK_FORMAT_B8G8R8A8_UNORM: return {4, false, format};
+        case VK_FORMAT_B8G8R8A8_SRGB: return {4, true, format};
+        default: return {};
+        }
+    }
+
+    template<typename T>
+    ref_ptr<Data> createImage(uint32_t width, uint32_t height, size_t valueCount, const Data::Properties& properties, uint8_t*& dest)
+    {
+        auto values = new T[valueCount];
+        dest = reinterpret_cast<uint8_t*>(values);
+        return Array2D<T>::create(width, height, values, properties);
+    }
+
+    /// replace the ImageView of DescriptorImage with ones that reference processed images
+    class ProcessDescriptorImages : public Visitor
+    {
+    public:
+        explicit ProcessDescriptorImages(const ProcessImages& in_processImages) :
+            processImages(in_processImages) {}
+
+        const ProcessImages& processImages;
+        std::set<const Object*> visited;
+        std::map<const ImageView*, ref_ptr<ImageView>> replacements;
+
+        void apply(Object& object) override
+        {
+            if (visited.insert(&object).second) object.traverse(*this);
+        }
+
+        void apply(DescriptorImage& descriptorImage) override
+        {
+            for (auto& imageInfo : descriptorImage.imageInfoList)
+            {
+                if (!imageInfo || !imageInfo->imageView) continue;
+
+                auto itr = replacements.find(imageInfo->imageView.get());
+                if (itr == replacements.end())
+                {
+                    ref_ptr<ImageView> replacement;
+                    const auto& image = imageInfo->imageView->image;
+                    if (image && image->data)
+                    {
+                        auto mipLevels = processImages.generateMipmaps ? computeNumMipMapLevels(image->data, imageInfo->sampler) : 1;
+                        if (auto processed = processImages.process(*image->data, mipLevels))
+                        {
+                            auto processedImage = Image::create(processed);
+                            processedImage->usage = image->usage;
+                            replacement = ImageView::create(processedImage);
+                        }
+                    }
+                    itr = replacements.emplace(imageInfo->imageView.get(), replacement).first;
+                }
+
+                if (itr->second) imageInfo->imageView = itr->second;
+            }
+        }
+    };
+
+} // namespace
+
+void vsg::expandPixels(const uint8_t* source, uint32_t sourceSize, uint8_t* target, uint32_t targetSize, const uint8_t* defaultValue, size_t count)
+{
+    if (sourceSize == 3 && targetSize == 4)
+    {
+        // the extra bytes of each pixel are filled from the start of defaultValue
+        const uint8_t alpha = defaultValue[0];
+        size_t i = 0;
+
+#if defined(VSG_SIMD_NEON)
+        const uint8x16_t alphas = vdupq_n_u8(alpha);
+        for (; i + 16 <= count; i += 16, source += 48, target += 64)
+        {
+            uint8x16x3_t rgb = vld3q_u8(source);
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = alphas;
+            vst4q_u8(target, rgba);
+        }
+#elif defined(VSG_SIMD_AVX)
+        // AVX implies SSSE3 so shuffle 4 pixels at a time, the 16 byte load reads beyond the 4 pixels so stop before the last 2 pixels
+        const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alphas = _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(alpha) << 24));
+        for (; i + 6 <= count; i += 4, source += 12, target += 16)
+        {
+            __m128i rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(target), _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alphas));
+        }
+#endif
+        for (; i < count; ++i, source += 3, target += 4)
+        {
+            target[0] = source[0];
+            target[1] = source[1];
+            target[2] = source[2];
+            target[3] = alpha;
+        }
+        return;
+    }
+
+    if (sourceSize >= targetSize)
+    {
+        for (size_t i = 0; i < count; ++i, source += sourceSize, target += targetSize)
+        {
+            std::memcpy(target, source, targetSize);
+        }
+        return;
+    }
+
+    uint32_t numDefaultBytes = targetSize - sourceSize;
+    for (size_t i = 0; i < count; ++i, source += sourceSize, target += targetSize)
+    {
+        std::memcpy(target, source, sourceSize);
+        std::memcpy(target + sourceSize, defaultValue, numDefaultBytes);
+    }
+}
+
+void vsg::convertColorSpace(uint8_t* pixels, size_t count, uint32_t numComponents, uint32_t numColorComponents, CoordinateSpace source, CoordinateSpace target)
+{
+    const uint8_t* table = nullptr;
+    if (source == CoordinateSpace::sRGB && target == CoordinateSpace::LINEAR)
+        table = colorSpaceTables().sRGBToLinear;
+    else if (source == CoordinateSpace::LINEAR && target == CoordinateSpace::sRGB)
+        table = colorSpaceTables().linearToSRGB;
+    else
+        return;
+
+    numColorComponents = std::min(numColorComponents, numComponents);
+    for (size_t i = 0; i < count; ++i, pixels += numComponents)
+    {
+        for (uint32_t c = 0; c < numColorComponents; ++c) pixels[c] = table[pixels[c]];
+    }
+}
+
+void vsg::premultiplyAlpha(uint8_t* pixels, size_t count)
+{
+    size_t i = 0;
+
+#if defined(VSG_SIMD_SSE2)
+    // multiply 4 pixels at a time as 16 bit components, the alpha is multiplied by 255 to leave it unchanged
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i colorMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m128i alphaScale = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    const __m128i half = _mm_set1_epi16(128);
+
+    auto multiply = [&](__m128i values) {
+        __m128i alphas = _mm_shufflehi_epi16(_mm_shufflelo_epi16(values, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        alphas = _mm_or_si128(_mm_and_si128(alphas, colorMask), alphaScale);
+        __m128i product = _mm_add_epi16(_mm_mullo_epi16(values, alphas), half);
+        return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+    };
+
+    for (; i + 4 <= count; i += 4, pixels += 16)
+    {
+        __m128i rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+        __m128i lo = multiply(_mm_unpacklo_epi8(rgba, zero));
+        __m128i hi = multiply(_mm_unpackhi_epi8(rgba, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), _mm_packus_epi16(lo, hi));
+    }
+#elif defined(VSG_SIMD_NEON)
+    for (; i + 8 <= count; i += 8, pixels += 32)
+    {
+        uint8x8x4_t rgba = vld4_u8(pixels);
+        for (int c = 0; c < 3; ++c)
+        {
+            uint16x8_t product = vmull_u8(rgba.val[c], rgba.val[3]);
+            rgba.val[c] = vrshrn_n_u16(vrsraq_n_u16(product, product, 8), 8);
+        }
+        vst4_u8(pixels, rgba);
+    }
+#endif
+
+    for (; i < count; ++i, pixels += 4)
+    {
+        uint32_t alpha = pixels[3];
+        pixels[0] = static_cast<uint8_t>(div255(pixels[0] * alpha));
+        pixels[1] = static_cast<uint8_t>(div255(pixels[1] * alpha));
+        pixels[2] = static_cast<uint8_t>(div255(pixels[2] * alpha));
+    }
+}
+
+void vsg::downsample(const uint8_t* source, uint32_t width, uint32_t height, uint32_t numComponents, bool sRGB, uint8_t* target)
+{
+    uint32_t targetWidth = std::max(width / 2, 1u);
+    uint32_t targetHeight = std::max(height / 2, 1u);
+    size_t rowSize = static_cast<size_t>(width) * numComponents;
+    uint32_t numColorComponents = sRGB ? std::min(numComponents, 3u) : 0;
+    const auto& tables = colorSpaceTables();
+
+    for (uint32_t y = 0; y < targetHeight; ++y)
+    {
+        const uint8_t* row0 = source + static_cast<size_t>(y) * 2 * rowSize;
+        const uint8_t* row1 = (height > 1) ? row0 + rowSize : row0;
+        uint32_t x = 0;
+
+        if (numComponents == 4 && width > 1 && !sRGB)
+        {
+#if defined(VSG_SIMD_SSE2)
+            // average 4 pixels of each row down to 2 pixels at a time
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i two = _mm_set1_epi16(2);
+            for (; x + 2 <= targetWidth; x += 2)
+            {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+                __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+                hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+                __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), two), 2);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(target + x * 4), _mm_packus_epi16(sum, sum));
+            }
+#elif defined(VSG_SIMD_NEON)
+            for (; x + 2 <= targetWidth; x += 2)
+            {
+                uint8x16_t a = vld1q_u8(row0 + x * 8);
+                uint8x16_t b = vld1q_u8(row1 + x * 8);
+                uint16x8_t lo = vaddl_u8(vget_low_u8(a), vget_low_u8(b));
+                uint16x8_t hi = vaddl_u8(vget_high_u8(a), vget_high_u8(b));
+                uint16x4_t sum0 = vadd_u16(vget_low_u16(lo), vget_high_u16(lo));
+                uint16x4_t sum1 = vadd_u16(vget_low_u16(hi), vget_high_u16(hi));
+                vst1_u8(target + x * 4, vrshrn_n_u16(vcombine_u16(sum0, sum1), 2));
+            }
+#endif
+        }
+
+        for (; x < targetWidth; ++x)
+        {
+            size_t x0 = static_cast<size_t>(x) * 2 * numComponents;
+            size_t x1 = (width > 1) ? x0 + numComponents : x0;
+            uint8_t* dest = target + static_cast<size_t>(x) * numComponents;
+            for (uint32_t c = 0; c < numComponents; ++c)
+            {
+                if (c < numColorComponents)
+                {
+                    uint32_t sum = tables.sRGBToLinear12[row0[x0 + c]] + tables.sRGBToLinear12[row0[x1 + c]] + tables.sRGBToLinear12[row1[x0 + c]] + tables.sRGBToLinear12[row1[x1 + c]];
+                    dest[c] = tables.linear12ToSRGB[(sum + 2) >> 2];
+                }
+                else
+                {
+                    dest[c] = static_cast<uint8_t>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+                }
+            }
+        }
+
+        target += static_cast<size_t>(targetWidth) * numComponents;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ProcessImages
+//
+ProcessImages::ProcessImages()
+{
+}
+
+ProcessImages::~ProcessImages()
+{
+}
+
+ref_ptr<Data> ProcessImages::process(const Data& image, uint32_t mipLevels) const
+{
+    auto source = sourceFormat(image.properties.format);
+    if (source.numComponents == 0 || image.dimensions() != 2 || image.properties.mipLevels > 1 || image.getMipmapLayout()) return {};
+    if (image.properties.imageViewType >= 0 && image.properties.imageViewType != VK_IMAGE_VIEW_TYPE_2D) return {};
+    if (image.stride() != source.numComponents || !image.dataPointer()) return {};
+
+    uint32_t width = image.width();
+    uint32_t height = image.height();
+
+    uint32_t maxMipLevels = 1;
+    while ((1u << maxMipLevels) <= std::max(width, height)) ++maxMipLevels;
+    mipLevels = std::clamp(mipLevels, 1u, std::min(maxMipLevels, 255u));
+
+    bool expand = mapRGBtoRGBA && source.numComponents == 3;
+    bool premultiply = premultiplyAlpha && source.numComponents == 4;
+    if (!expand && !premultiply && mipLevels == 1) return {};
+
+    uint32_t numComponents = expand ? 4 : source.numComponents;
+
+    size_t valueCount = 0;
+    for (uint32_t i = 0, w = width, h = height; i < mipLevels; ++i)
+    {
+        valueCount += static_cast<size_t>(w) * h;
+        w = std::max(w / 2, 1u);
+        h = std::max(h / 2, 1u);
+    }
+
+    Data::Properties properties;
+    properties.format = expand ? source.rgbaFormat : image.properties.format;
+    properties.mipLevels = static_cast<uint8_t>(mipLevels);
+    properties.imageViewType = image.properties.imageViewType;
+    properties.origin = image.properties.origin;
+    properties.dataVariance = image.properties.dataVariance;
+    properties.allocatorType = ALLOCATOR_TYPE_NEW_DELETE;
+
+    ref_ptr<Data> processed;
+    uint8_t* dest = nullptr;
+    switch (numComponents)
+    {
+    case 1: processed = createImage<uint8_t>(width, height, valueCount, properties, dest); break;
+    case 2: processed = createImage<ubvec2>(width, height, valueCount, properties, dest); break;
+    case 3: processed = createImage<ubvec3>(width, height, valueCount, properties, dest); break;
+    default: processed = createImage<ubvec4>(width, height, valueCount, properties, dest); break;
+    }
+
+    auto src = static_cast<const uint8_t*>(image.dataPointer());
+    size_t count = static_cast<size_t>(width) * height;
+    if (expand)
+    {
+        const uint8_t opaque[4] = {255, 255, 255, 255};
+        expandPixels(src, 3, dest, 4, opaque, count);
+    }
+    else
+    {
+        std::memcpy(dest, src, count * numComponents);
+    }
+
+    if (premultiply) vsg::premultiplyAlpha(dest, count);
+
+    // mipmaps are stored contiguously after the base level, each half the size of the previous level
+    for (uint32_t i = 1, w = width, h = height; i < mipLevels; ++i)
+    {
+        uint8_t* next = dest + static_cast<size_t>(w) * h * numComponents;
+        downsample(dest, w, h, numComponents, source.srgb, next);
+        dest = next;
+        w = std::max(w / 2, 1u);
+        h = std::max(h / 2, 1u);
+    }
+
+    processed->dirty();
+    return processed;
+}
+
+void ProcessImages::apply(Object& object) const
+{
+    ProcessDescriptorImages processDescriptorImages(*this);
+    object.accept(processDescriptorImages);
+}
+
+void ProcessImages::read(Input& input)
+{
+    Object::read(input);
+
+    input.read("mapRGBtoRGBA", mapRGBtoRGBA);
+    input.read("premultiplyAlpha", premultiplyAlpha);
+    input.read("generateMipmaps", generateMipmaps);
+}
+
+void ProcessImages::write(Output& output) const
+{
+    Object::write(output);
+
+    output.write("mapRGBtoRGBA", mapRGBtoRGBA);
+    output.write("premultiplyAlpha", premultiplyAlpha);
+    output.write("generateMipmaps", generateMipmaps);
+}
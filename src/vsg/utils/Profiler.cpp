@@ -18,24 +18,128 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 using namespace vsg;
 
+static const char* pipelineStatisticName(VkQueryPipelineStatisticFlags bit)
+{
+    switch (bit)
+    {
+    case (VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT): return "input assembly vertices";
+    case (VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT): return "input assembly primitives";
+    case (VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT): return "vertex shader invocations";
+    case (VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT): return "geometry shader invocations";
+    case (VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT): return "geometry shader primitives";
+    case (VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT): return "clipping invocations";
+    case (VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT): return "clipping primitives";
+    case (VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT): return "fragment shader invocations";
+    case (VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT): return "tessellation control shader patches";
+    case (VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT): return "tessellation evaluation shader invocations";
+    case (VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT): return "compute shader invocations";
+    default: return "unknown statistic";
+    }
+}
+
+static uint32_t countBits(VkQueryPipelineStatisticFlags flags)
+{
+    uint32_t count = 0;
+    for (; flags != 0; flags &= (flags - 1)) ++count;
+    return count;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // ProfileLog
 //
-ProfileLog::ProfileLog(size_t size) :
-    // TODO make user definable
-    entries(size)
+static std::atomic_uint64_t s_nextProfileLogID = 1;
+
+ProfileLog::ProfileLog(size_t in_size, uint32_t maxThreads) :
+    threadLogs(std::max(maxThreads, 1u)),
+    size(std::max(in_size, size_t(1))),
+    _logID(s_nextProfileLogID.fetch_add(1))
+{
+}
+
+ProfileLog::ThreadLog& ProfileLog::threadLog()
+{
+    // cache the calling thread's ThreadLog so the recording of entries only needs to take the mutex on the first use by each thread
+    struct Cache
+    {
+        uint64_t logID = 0;
+        ThreadLog* threadLog = nullptr;
+    };
+    thread_local Cache s_cache;
+
+    if (s_cache.logID == _logID) return *s_cache.threadLog;
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto thread_id = std::this_thread::get_id();
+    uint32_t count = numThreadLogs.load();
+    ThreadLog* log = nullptr;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (threadLogs[i]->thread_id == thread_id)
+        {
+            log = threadLogs[i].get();
+            break;
+        }
+    }
+
+    if (!log)
+    {
+        if (count < threadLogs.size())
+        {
+            auto& new_log = threadLogs[count];
+            new_log.reset(new ThreadLog);
+            new_log->thread_id = thread_id;
+            new_log->threadIndex = count;
+            new_log->entries.resize(size);
+            log = new_log.get();
+
+            numThreadLogs.store(count + 1);
+        }
+        else
+        {
+            // out of ThreadLogs so share the last one
+            log = threadLogs.back().get();
+        }
+    }
+
+    s_cache.logID = _logID;
+    s_cache.threadLog = log;
+    return *log;
+}
+
+void ProfileLog::setThreadName(const std::string& name)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    threadNames[std::this_thread::get_id()] = name;
+}
+
+bool ProfileLog::valid(uint64_t reference) const
 {
+    uint64_t threadIndex = reference >> threadShift;
+    if (threadIndex >= numThreadLogs.load()) return false;
+
+    uint64_t index = reference & entryMask;
+    uint64_t end = threadLogs[threadIndex]->index.load();
+    return index < end && (end - index) <= size;
 }
 
 void ProfileLog::read(Input& input)
 {
-    entries.resize(input.readValue<uint64_t>("entries"));
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    size = std::max(input.readValue<uint64_t>("entries"), uint64_t(1));
+
+    // discard existing ThreadLogs, and invalidate the threads' cached ThreadLog
+    for (auto& log : threadLogs) log.reset();
+    numThreadLogs = 0;
+    frameIndices.clear();
+    _logID = s_nextProfileLogID.fetch_add(1);
 }
 
 void ProfileLog::write(Output& output) const
 {
-    output.writeValue<uint64_t>("entries", entries.size());
+    output.writeValue<uint64_t>("entries", size);
 }
 
 void ProfileLog::report(std::ostream& out)
@@ -71,55 +175,118 @@ uint64_t ProfileLog::report(std::ostream& out, uint64_t reference)
         std::swap(startReference, endReference);
     }
 
-    for (uint64_t i = startReference; i <= endReference; ++i)
-    {
-        auto& first = entry(i);
-        auto& second = entry(first.reference);
-        auto cpu_duration = std::abs(std::chrono::duration<double, std::chrono::milliseconds::period>(second.cpuTime - first.cpuTime).count());
-
-        auto gpu_duration = 0.0;
-        if (first.gpuTime != 0 && second.gpuTime != 0)
+    auto reportEntries = [&](uint64_t firstReference, uint64_t lastReference) {
+        uint32_t depth = 0;
+        for (uint64_t i = firstReference; i <= lastReference; ++i)
         {
-            gpu_duration = static_cast<double>((first.gpuTime < second.gpuTime) ? (second.gpuTime - first.gpuTime) : (first.gpuTime - second.gpuTime)) * timestampScaleToMilliseconds;
-        }
+            auto& first = entry(i);
+            auto& second = entry(first.reference);
+            auto cpu_duration = std::abs(std::chrono::duration<double, std::chrono::milliseconds::period>(second.cpuTime - first.cpuTime).count());
 
-        if (first.enter && first.reference == i + 1)
-        {
-            ++i;
+            auto gpu_duration = 0.0;
+            if (first.gpuTime != 0 && second.gpuTime != 0)
+            {
+                gpu_duration = static_cast<double>((first.gpuTime < second.gpuTime) ? (second.gpuTime - first.gpuTime) : (first.gpuTime - second.gpuTime)) * timestampScaleToMilliseconds;
+            }
 
-            out << indent << "{ " << typeNames[first.type] << ", cpu_duration = " << cpu_duration << "ms, ";
-            if (gpu_duration != 0.0) out << ", gpu_duration = " << gpu_duration << "ms, ";
+            if (first.enter && first.reference == i + 1)
+            {
+                ++i;
 
-            auto itr = threadNames.find(first.thread_id);
-            if (itr != threadNames.end()) out << ", thread = " << itr->second;
+                out << indent << "{ " << typeNames[first.type] << ", cpu_duration = " << cpu_duration << "ms, ";
+                if (gpu_duration != 0.0) out << ", gpu_duration = " << gpu_duration << "ms, ";
 
-            if (first.sourceLocation) out /*<<", file="<<first.sourceLocation->file*/ << ", func=" << first.sourceLocation->function << ", line=" << first.sourceLocation->line;
-            // if (first.object) out<<", "<<first.object->className();
-            out << " }" << std::endl;
-        }
-        else
-        {
-            if (first.enter)
-                out << indent << "{ ";
+                auto itr = threadNames.find(first.thread_id);
+                if (itr != threadNames.end()) out << ", thread = " << itr->second;
+
+                if (first.sourceLocation) out /*<<", file="<<first.sourceLocation->file*/ << ", func=" << first.sourceLocation->function << ", line=" << first.sourceLocation->line;
+                // if (first.object) out<<", "<<first.object->className();
+                out << " }" << std::endl;
+            }
             else
             {
-                indent -= tab;
-                out << indent << "} ";
-            }
+                if (first.enter)
+                    out << indent << "{ ";
+                else
+                {
+                    // entries of other threads may leave scopes entered before the frame started
+                    if (depth > 0)
+                    {
+                        indent -= tab;
+                        --depth;
+                    }
+                    out << indent << "} ";
+                }
+
+                out << typeNames[first.type] << ", cpu_duration = " << cpu_duration << "ms, ";
+                if (gpu_duration != 0.0) out << ", gpu_duration = " << gpu_duration << "ms, ";
+
+                auto itr = threadNames.find(first.thread_id);
+                if (itr != threadNames.end()) out << ", thread = " << itr->second;
+
+                if (first.sourceLocation) out /*<<", file="<<first.sourceLocation->file*/ << ", func=" << first.sourceLocation->function << ", line=" << first.sourceLocation->line;
+                // if (first.object) out<<", "<<first.object->className();
 
-            out << typeNames[first.type] << ", cpu_duration = " << cpu_duration << "ms, ";
-            if (gpu_duration != 0.0) out << ", gpu_duration = " << gpu_duration << "ms, ";
+                if (first.enter && first.type == COMMAND_BUFFER)
+                {
+                    if (auto stats_itr = pipelineStatistics.find(i); stats_itr != pipelineStatistics.end())
+                    {
+                        auto& stats = stats_itr->second;
+                        size_t v = 0;
+                        for (VkQueryPipelineStatisticFlags bit = 1; bit <= stats.flags && v < stats.values.size(); bit <<= 1)
+                        {
+                            if ((stats.flags & bit) != 0) out << ", " << pipelineStatisticName(bit) << " = " << stats.values[v++];
+                        }
+                    }
+                }
 
-            auto itr = threadNames.find(first.thread_id);
-            if (itr != threadNames.end()) out << ", thread = " << itr->second;
+                out << std::endl;
+
+                if (first.enter)
+                {
+                    indent += tab;
+                    ++depth;
+                }
+            }
+        }
 
-            if (first.sourceLocation) out /*<<", file="<<first.sourceLocation->file*/ << ", func=" << first.sourceLocation->function << ", line=" << first.sourceLocation->line;
-            // if (first.object) out<<", "<<first.object->className();
+        indent -= tab * depth;
+    };
+
+    // entries of the thread that recorded the frame
+    if ((startReference >> threadShift) == (endReference >> threadShift))
+        reportEntries(startReference, endReference);
+    else
+        reportEntries(startReference, startReference);
+
+    // merge in the entries that the other threads recorded during the frame
+    auto startTime = entry(startReference).cpuTime;
+    auto endTime = entry(endReference).cpuTime;
+    uint64_t frameThreadIndex = startReference >> threadShift;
+    uint32_t count = numThreadLogs.load();
+    for (uint64_t threadIndex = 0; threadIndex < count; ++threadIndex)
+    {
+        if (threadIndex == frameThreadIndex) continue;
 
-            out << std::endl;
+        auto& log = *threadLogs[threadIndex];
+        uint64_t end = log.index.load();
+        uint64_t begin = (end > size) ? (end - size) : 0;
 
-            if (first.enter) indent += tab;
+        uint64_t first = end;
+        uint64_t last = end;
+        for (uint64_t i = begin; i < end; ++i)
+        {
+            auto& e = log.entries[i % size];
+            if (e.cpuTime < startTime) continue;
+            if (e.cpuTime > endTime) break;
+            if (first == end) first = i;
+            last = i;
         }
+
+        if (first == end) continue;
+
+        uint64_t threadBits = threadIndex << threadShift;
+        reportEntries(threadBits | first, threadBits | last);
     }
 
     out << "}" << std::endl;
@@ -142,13 +309,32 @@ void GPUStatsCollection::writeGpuTimestamp(CommandBuffer& commandBuffer, uint64_
     }
 }
 
+void GPUStatsCollection::beginPipelineStatistics(CommandBuffer& commandBuffer, uint64_t reference)
+{
+    if (!statisticsQueryPool || statisticsQueryActive) return;
+
+    vkCmdResetQueryPool(commandBuffer, statisticsQueryPool->vk(), 0, 1);
+    vkCmdBeginQuery(commandBuffer, statisticsQueryPool->vk(), 0, 0);
+
+    statisticsQueryActive = true;
+    statisticsReference = reference;
+}
+
+void GPUStatsCollection::endPipelineStatistics(CommandBuffer& commandBuffer)
+{
+    if (!statisticsQueryActive) return;
+
+    vkCmdEndQuery(commandBuffer, statisticsQueryPool->vk(), 0);
+    statisticsQueryActive = false;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Profiler
 //
 Profiler::Profiler(ref_ptr<Settings> in_settings) :
     settings(in_settings.valid() ? in_settings : Settings::create()),
-    log(ProfileLog::create(settings->log_size)),
+    log(ProfileLog::create(settings->log_size, settings->max_threads)),
     perFrameGPUStats(3)
 {
 }
@@ -170,6 +356,15 @@ VkResult Profiler::getGpuResults(FrameStatsCollection& frameStats) const
                 {
                     auto& gpu_entry = log->entry(gpuStats->references[i]);
                     gpu_entry.gpuTime = gpuStats->timestamps[i];
+
+                    if (statistics && gpu_entry.type == ProfileLog::COMMAND_BUFFER && !gpu_entry.enter)
+                    {
+                        auto& enter_entry = log->entry(gpu_entry.reference);
+                        if (enter_entry.gpuTime != 0 && gpu_entry.gpuTime >= enter_entry.gpuTime && gpu_entry.sourceLocation && gpu_entry.sourceLocation->name)
+                        {
+                            statistics->sample(std::string(gpu_entry.sourceLocation->name) + " gpu ms", static_cast<double>(gpu_entry.gpuTime - enter_entry.gpuTime) * log->timestampScaleToMilliseconds);
+                        }
+                    }
                 }
                 gpuStats->queryIndex = 0;
             }
@@ -178,6 +373,30 @@ VkResult Profiler::getGpuResults(FrameStatsCollection& frameStats) const
                 info("Profiler::getGpuResults() ", gpuStats, ", query failed with result = ", result);
             }
         }
+
+        if (gpuStats && gpuStats->statisticsQueryPool && gpuStats->statisticsReference != 0)
+        {
+            // don't wait for results, if they aren't available yet they are discarded
+            auto& values = gpuStats->statistics;
+            VkDeviceSize stride = values.size() * sizeof(uint64_t);
+            if (vkGetQueryPoolResults(gpuStats->device->vk(), gpuStats->statisticsQueryPool->vk(), 0, 1, stride, values.data(), stride, VK_QUERY_RESULT_64_BIT) == VK_SUCCESS)
+            {
+                auto flags = gpuStats->statisticsQueryPool->pipelineStatistics;
+                log->pipelineStatistics[gpuStats->statisticsReference] = ProfileLog::PipelineStatistics{flags, values};
+
+                auto& enter_entry = log->entry(gpuStats->statisticsReference);
+                if (statistics && enter_entry.sourceLocation && enter_entry.sourceLocation->name)
+                {
+                    size_t i = 0;
+                    for (VkQueryPipelineStatisticFlags bit = 1; bit <= flags && i < values.size(); bit <<= 1)
+                    {
+                        if ((flags & bit) == 0) continue;
+                        statistics->sample(std::string(enter_entry.sourceLocation->name) + " " + pipelineStatisticName(bit), static_cast<double>(values[i++]));
+                    }
+                }
+            }
+            gpuStats->statisticsReference = 0;
+        }
     }
 
     return result;
@@ -185,7 +404,7 @@ VkResult Profiler::getGpuResults(FrameStatsCollection& frameStats) const
 
 void Profiler::setThreadName(const std::string& name) const
 {
-    log->threadNames[std::this_thread::get_id()] = name;
+    log->setThreadName(name);
 }
 
 void Profiler::enterFrame(const SourceLocation* sl, uint64_t& reference, FrameStamp& frameStamp) const
@@ -203,27 +422,36 @@ void Profiler::leaveFrame(const SourceLocation* sl, uint64_t& reference, FrameSt
     auto& entry = log->leave(reference, ProfileLog::FRAME);
     entry.sourceLocation = sl;
     entry.object = &frameStamp;
-    uint64_t endReference = reference;
 
-    if (endReference >= static_cast<uint64_t>(log->entries.size()))
+    // remove the frames whose entries have been overwritten
+    size_t i = 0;
+    for (; i < log->frameIndices.size(); ++i)
     {
-        uint64_t safeReference = endReference - static_cast<uint64_t>(log->entries.size());
-        size_t i = 0;
-        for (; i < log->frameIndices.size(); ++i)
-        {
-            if (log->frameIndices[i] > safeReference)
-            {
-                break;
-            }
-        }
-        if (i > 0)
-        {
-            log->frameIndices.erase(log->frameIndices.begin(), log->frameIndices.begin() + i);
-        }
+        if (log->valid(log->frameIndices[i])) break;
+    }
+    if (i > 0)
+    {
+        log->frameIndices.erase(log->frameIndices.begin(), log->frameIndices.begin() + i);
+    }
+
+    // remove the pipeline statistics whose entries have been overwritten
+    for (auto itr = log->pipelineStatistics.begin(); itr != log->pipelineStatistics.end();)
+    {
+        if (log->valid(itr->first))
+            ++itr;
+        else
+            itr = log->pipelineStatistics.erase(itr);
     }
 
     log->frameIndices.push_back(startReference);
 
+    if (statistics)
+    {
+        auto& enter_entry = log->entry(startReference);
+        statistics->sample("frame cpu ms", std::chrono::duration<double, std::chrono::milliseconds::period>(entry.cpuTime - enter_entry.cpuTime).count());
+        statistics->advanceFrame(frameStamp.frameCount);
+    }
+
     // advance the frame index to the next frame position in the perFrameGPUStats container
     ++frameIndex;
     if (frameIndex >= perFrameGPUStats.size()) frameIndex = 0;
@@ -273,6 +501,29 @@ void Profiler::enterCommandBuffer(const SourceLocation* sl, uint64_t& reference,
                 gpuStats->references.resize(numQueries);
                 gpuStats->timestamps.resize(numQueries);
 
+                // pipeline statistics queries can't be nested so are only used for primary command buffers
+                auto statisticsFlags = settings->pipeline_statistics;
+                if (statisticsFlags != 0 && commandBuffer.level() == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
+                {
+                    const auto& queueFamilies = physicalDevice->getQueueFamilyProperties();
+                    auto queueFamilyIndex = commandBuffer.getCommandPool()->queueFamilyIndex;
+                    if (queueFamilyIndex < queueFamilies.size() && (queueFamilies[queueFamilyIndex].queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0)
+                    {
+                        // only compute statistics are valid on queues without graphics support
+                        statisticsFlags &= VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+                    }
+
+                    if (!commandBuffer.getDevice()->supportsPipelineStatisticsQuery())
+                    {
+                        warn("Profiler pipeline statistics require the pipelineStatisticsQuery device feature.");
+                    }
+                    else if (statisticsFlags != 0)
+                    {
+                        gpuStats->statisticsQueryPool = QueryPool::create(commandBuffer.getDevice(), VkQueryPoolCreateFlags{0}, VK_QUERY_TYPE_PIPELINE_STATISTICS, 1, statisticsFlags);
+                        gpuStats->statistics.resize(countBits(statisticsFlags));
+                    }
+                }
+
                 auto& frameStats = perFrameGPUStats[frameIndex];
                 frameStats.gpuStats.push_back(gpuStats);
             }
@@ -292,6 +543,7 @@ void Profiler::enterCommandBuffer(const SourceLocation* sl, uint64_t& reference,
             gpuStats->queryIndex = 0;
 
             gpuStats->writeGpuTimestamp(commandBuffer, reference, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+            gpuStats->beginPipelineStatistics(commandBuffer, reference);
         }
     }
 }
@@ -304,7 +556,17 @@ void Profiler::leaveCommandBuffer(const SourceLocation* sl, uint64_t& reference,
         entry.sourceLocation = sl;
         entry.object = &commandBuffer;
 
-        if (commandBuffer.gpuStats) commandBuffer.gpuStats->writeGpuTimestamp(commandBuffer, reference, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+        if (commandBuffer.gpuStats)
+        {
+            commandBuffer.gpuStats->endPipelineStatistics(commandBuffer);
+            commandBuffer.gpuStats->writeGpuTimestamp(commandBuffer, reference, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+        }
+
+        if (statistics && sl->name)
+        {
+            auto& enter_entry = log->entry(entry.reference);
+            statistics->sample(std::string(sl->name) + " cpu ms", std::chrono::duration<double, std::chrono::milliseconds::period>(entry.cpuTime - enter_entry.cpuTime).count());
+        }
     }
 }
 
@@ -332,6 +594,11 @@ void Profiler::leave(const SourceLocation* sl, uint64_t& reference, CommandBuffe
     }
 }
 
+void Profiler::plot(const char* name, double value) const
+{
+    if (statistics && name) statistics->set(name, value);
+}
+
 void Profiler::finish() const
 {
     for (auto& gpuStats : perFrameGPUStats)
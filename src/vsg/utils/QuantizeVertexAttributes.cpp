@@ -0,0 +1,378 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Logger.h>
+#include <vsg/maths/quantize.h>
+#include <vsg/maths/transform.h>
+#include <vsg/nodes/Geometry.h>
+#include <vsg/nodes/MatrixTransform.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/nodes/VertexDraw.h>
+#include <vsg/nodes/VertexIndexDraw.h>
+#include <vsg/state/VertexInputState.h>
+#include <vsg/utils/QuantizeVertexAttributes.h>
+
+#include <typeinfo>
+
+using namespace vsg;
+
+namespace
+{
+    enum Conversion
+    {
+        NO_CONVERSION,
+        QUANTIZE_VERTICES,
+        ENCODE_NORMALS,
+        HALF_FLOAT_TEXCOORDS
+    };
+
+    struct AttributeConversion
+    {
+        Conversion conversion = NO_CONVERSION;
+        uint32_t location = 0;
+        uint32_t binding = 0;
+    };
+
+    const char* octahedralNormalDefine = "VSG_OCTAHEDRAL_NORMAL";
+
+    ShaderStage* vertexShaderStage(GraphicsPipeline& pipeline)
+    {
+        for (auto& stage : pipeline.stages)
+        {
+            if (stage && stage->stage == VK_SHADER_STAGE_VERTEX_BIT) return stage;
+        }
+        return nullptr;
+    }
+
+    bool supportsOctahedralNormals(GraphicsPipeline& pipeline)
+    {
+        auto stage = vertexShaderStage(pipeline);
+        return stage && stage->module && stage->module->source.find(octahedralNormalDefine) != std::string::npos;
+    }
+} // namespace
+
+QuantizeVertexAttributes::QuantizeVertexAttributes()
+{
+}
+
+QuantizeVertexAttributes::~QuantizeVertexAttributes()
+{
+}
+
+ref_ptr<svec4Array> QuantizeVertexAttributes::quantizeVertexArray(const vec3Array& vertices, dmat4& matrix)
+{
+    dbox bound;
+    for (auto& v : vertices) bound.add(v);
+
+    // use a uniform scale so the normals are not distorted by the dequantizing transform
+    dvec3 center = bound.valid() ? (bound.min + bound.max) * 0.5 : dvec3();
+    double halfExtent = bound.valid() ? std::max({bound.max.x - center.x, bound.max.y - center.y, bound.max.z - center.z}) : 0.0;
+    if (halfExtent <= 0.0) halfExtent = 1.0;
+
+    matrix = translate(center) * scale(halfExtent);
+
+    auto quantized = svec4Array::create(vertices.size());
+    quantized->properties.format = VK_FORMAT_R16G16B16A16_SNORM;
+
+    auto itr = quantized->begin();
+    for (auto& v : vertices)
+    {
+        dvec3 q = (dvec3(v) - center) / halfExtent;
+        (itr++)->set(floatToSnorm16(static_cast<float>(q.x)), floatToSnorm16(static_cast<float>(q.y)), floatToSnorm16(static_cast<float>(q.z)), floatToSnorm16(1.0f));
+    }
+    return quantized;
+}
+
+ref_ptr<svec2Array> QuantizeVertexAttributes::encodeNormalArray(const vec3Array& normals)
+{
+    auto encoded = svec2Array::create(normals.size());
+    encoded->properties.format = VK_FORMAT_R16G16_SNORM;
+
+    auto itr = encoded->begin();
+    for (auto& n : normals)
+    {
+        auto e = octahedralEncode(n);
+        (itr++)->set(floatToSnorm16(e.x), floatToSnorm16(e.y));
+    }
+    return encoded;
+}
+
+ref_ptr<usvec2Array> QuantizeVertexAttributes::halfFloatTexCoordArray(const vec2Array& texCoords)
+{
+    auto converted = usvec2Array::create(texCoords.size());
+    converted->properties.format = VK_FORMAT_R16G16_SFLOAT;
+
+    auto itr = converted->begin();
+    for (auto& tc : texCoords)
+    {
+        (itr++)->set(floatToHalf(tc.x), floatToHalf(tc.y));
+    }
+    return converted;
+}
+
+void QuantizeVertexAttributes::quantize(Node& node)
+{
+    _visited.clear();
+    _draws.clear();
+    _pipelineStack.clear();
+    _parent = nullptr;
+
+    node.accept(*this);
+
+    for (auto& [pipeline, draws] : _draws)
+    {
+        _convert(*pipeline, draws);
+    }
+
+    _draws.clear();
+    _visited.clear();
+}
+
+void QuantizeVertexAttributes::report(LogOutput& output) const
+{
+    output("QuantizeVertexAttributes::report(..) ", this, " {");
+    output.in();
+    output("numArraysConverted = ", numArraysConverted);
+    output("numPipelinesUpdated = ", numPipelinesUpdated);
+    output("numBytesBefore = ", numBytesBefore);
+    output("numBytesAfter = ", numBytesAfter);
+    output.out();
+    output("}");
+}
+
+void QuantizeVertexAttributes::apply(Node& node)
+{
+    // draws that aren't direct children of a Group can't be placed under a dequantizing MatrixTransform
+    _parent = nullptr;
+    node.traverse(*this);
+}
+
+void QuantizeVertexAttributes::apply(Group& group)
+{
+    if (!_visited.insert(&group).second) return;
+
+    for (size_t i = 0; i < group.children.size(); ++i)
+    {
+        _parent = &group;
+        _childIndex = i;
+        group.children[i]->accept(*this);
+    }
+    _parent = nullptr;
+}
+
+void QuantizeVertexAttributes::apply(StateGroup& stateGroup)
+{
+    GraphicsPipeline* pipeline = nullptr;
+    for (auto& stateCommand : stateGroup.stateCommands)
+    {
+        if (auto bindPipeline = stateCommand->cast<BindGraphicsPipeline>()) pipeline = bindPipeline->pipeline;
+    }
+
+    if (pipeline) _pipelineStack.push_back(pipeline);
+
+    apply(static_cast<Group&>(stateGroup));
+
+    if (pipeline) _pipelineStack.pop_back();
+}
+
+void QuantizeVertexAttributes::apply(VertexIndexDraw& vid)
+{
+    _collect(vid, vid.firstBinding, vid.arrays);
+}
+
+void QuantizeVertexAttributes::apply(VertexDraw& vd)
+{
+    _collect(vd, vd.firstBinding, vd.arrays);
+}
+
+void QuantizeVertexAttributes::apply(Geometry& geometry)
+{
+    _collect(geometry, geometry.firstBinding, geometry.arrays);
+}
+
+void QuantizeVertexAttributes::_collect(Node& node, uint32_t firstBinding, BufferInfoList& arrays)
+{
+    if (_pipelineStack.empty()) return;
+
+    _draws[_pipelineStack.back()].push_back(Draw{&node, firstBinding, &arrays, _parent, _childIndex});
+}
+
+void QuantizeVertexAttributes::_convert(GraphicsPipeline& pipeline, std::vector<Draw>& draws)
+{
+    VertexInputState* vertexInputState = nullptr;
+    for (auto& pipelineState : pipeline.pipelineStates)
+    {
+        if (auto vis = pipelineState->cast<VertexInputState>()) vertexInputState = vis;
+    }
+    if (!vertexInputState) return;
+
+    auto& bindings = vertexInputState->vertexBindingDescriptions;
+    auto& attributes = vertexInputState->vertexAttributeDescriptions;
+
+    auto findBinding = [&](uint32_t binding) -> const VkVertexInputBindingDescription* {
+        for (auto& description : bindings)
+        {
+            if (description.binding == binding) return &description;
+        }
+        return nullptr;
+    };
+
+    // an attribute is only converted when every draw using the pipeline provides a suitable array for it
+    auto convertible = [&](const AttributeConversion& ac, const std::type_info& type) {
+        for (auto& draw : draws)
+        {
+            if (ac.binding < draw.firstBinding || (ac.binding - draw.firstBinding) >= draw.arrays->size()) return false;
+
+            auto& bufferInfo = (*draw.arrays)[ac.binding - draw.firstBinding];
+            if (!bufferInfo || !bufferInfo->data || bufferInfo->offset != 0 || bufferInfo->data->dynamic()) return false;
+            if (typeid(*bufferInfo->data) != type) return false;
+            if (ac.conversion == QUANTIZE_VERTICES && !draw.parent) return false;
+        }
+        return true;
+    };
+
+    bool octahedralNormals = encodeNormals && supportsOctahedralNormals(pipeline);
+
+    std::vector<AttributeConversion> conversions;
+    for (auto& attribute : attributes)
+    {
+        AttributeConversion ac{NO_CONVERSION, attribute.location, attribute.binding};
+        if (attribute.location == 0 && quantizeVertices && attribute.format == VK_FORMAT_R32G32B32_SFLOAT)
+            ac.conversion = QUANTIZE_VERTICES;
+        else if (attribute.location == 1 && octahedralNormals && attribute.format == VK_FORMAT_R32G32B32_SFLOAT)
+            ac.conversion = ENCODE_NORMALS;
+        else if (attribute.location >= 2 && attribute.location <= 5 && halfFloatTexCoords && attribute.format == VK_FORMAT_R32G32_SFLOAT)
+            ac.conversion = HALF_FLOAT_TEXCOORDS;
+        else
+            continue;
+
+        // interleaved and per instance arrays are left unchanged
+        auto binding = findBinding(attribute.binding);
+        if (!binding || binding->inputRate != VK_VERTEX_INPUT_RATE_VERTEX || attribute.offset != 0) continue;
+        if (binding->stride != (ac.conversion == HALF_FLOAT_TEXCOORDS ? sizeof(vec2) : sizeof(vec3))) continue;
+        auto numAttributesUsingBinding = std::count_if(attributes.begin(), attributes.end(), [&](const VkVertexInputAttributeDescription& a) { return a.binding == attribute.binding; });
+        if (numAttributesUsingBinding != 1) continue;
+
+        if (!convertible(ac, ac.conversion == HALF_FLOAT_TEXCOORDS ? typeid(vec2Array) : typeid(vec3Array))) continue;
+
+        conversions.push_back(ac);
+    }
+
+    if (conversions.empty()) return;
+
+    // convert the arrays, sharing the converted arrays between the draws that shared the originals
+    std::map<const Data*, ref_ptr<Data>> converted;
+    std::map<const Data*, dmat4> matrices;
+    std::map<const Node*, dmat4> drawMatrices;
+    std::set<const Node*> convertedDraws;
+
+    for (auto& draw : draws)
+    {
+        if (!convertedDraws.insert(draw.node).second) continue;
+
+        for (auto& ac : conversions)
+        {
+            auto& bufferInfo = (*draw.arrays)[ac.binding - draw.firstBinding];
+            auto source = bufferInfo->data.get();
+
+            auto& result = converted[source];
+            if (!result)
+            {
+                switch (ac.conversion)
+                {
+                case (QUANTIZE_VERTICES): result = quantizeVertexArray(*static_cast<const vec3Array*>(source), matrices[source]); break;
+                case (ENCODE_NORMALS): result = encodeNormalArray(*static_cast<const vec3Array*>(source)); break;
+                case (HALF_FLOAT_TEXCOORDS): result = halfFloatTexCoordArray(*static_cast<const vec2Array*>(source)); break;
+                default: break;
+                }
+
+                ++numArraysConverted;
+                numBytesBefore += source->dataSize();
+                numBytesAfter += result->dataSize();
+            }
+
+            if (ac.conversion == QUANTIZE_VERTICES) drawMatrices[draw.node] = matrices[source];
+
+            bufferInfo = BufferInfo::create(result.get());
+        }
+    }
+
+    // place the draws with quantized vertices under the MatrixTransform that dequantizes them, reusing the transform for draws with multiple parents
+    std::map<const Node*, ref_ptr<MatrixTransform>> transforms;
+    for (auto& draw : draws)
+    {
+        auto itr = drawMatrices.find(draw.node);
+        if (itr == drawMatrices.end()) continue;
+
+        auto& transform = transforms[draw.node];
+        if (!transform)
+        {
+            transform = MatrixTransform::create(itr->second);
+            transform->addChild(ref_ptr<Node>(draw.node));
+        }
+        draw.parent->children[draw.childIndex] = transform;
+    }
+
+    // update the pipeline to match the new array formats
+    auto newVertexInputState = VertexInputState::create(*vertexInputState);
+    bool normalsEncoded = false;
+    for (auto& ac : conversions)
+    {
+        VkFormat format = VK_FORMAT_R16G16_SFLOAT;
+        uint32_t stride = sizeof(usvec2);
+        if (ac.conversion == QUANTIZE_VERTICES)
+        {
+            format = VK_FORMAT_R16G16B16A16_SNORM;
+            stride = sizeof(svec4);
+        }
+        else if (ac.conversion == ENCODE_NORMALS)
+        {
+            format = VK_FORMAT_R16G16_SNORM;
+            stride = sizeof(svec2);
+            normalsEncoded = true;
+        }
+
+        for (auto& attribute : newVertexInputState->vertexAttributeDescriptions)
+        {
+            if (attribute.location == ac.location) attribute.format = format;
+        }
+        for (auto& binding : newVertexInputState->vertexBindingDescriptions)
+        {
+            if (binding.binding == ac.binding) binding.stride = stride;
+        }
+    }
+
+    for (auto& pipelineState : pipeline.pipelineStates)
+    {
+        if (pipelineState == vertexInputState) pipelineState = newVertexInputState;
+    }
+
+    if (normalsEncoded)
+    {
+        // replace the vertex shader with one compiled with VSG_OCTAHEDRAL_NORMAL defined
+        for (auto& stage : pipeline.stages)
+        {
+            if (!stage || stage->stage != VK_SHADER_STAGE_VERTEX_BIT) continue;
+
+            auto hints = stage->module->hints ? ShaderCompileSettings::create(*stage->module->hints) : ShaderCompileSettings::create();
+            hints->defines.insert(octahedralNormalDefine);
+
+            auto vertexShader = ShaderStage::create(stage->stage, stage->entryPointName, ShaderModule::create(stage->module->source, hints));
+            vertexShader->flags = stage->flags;
+            vertexShader->mask = stage->mask;
+            vertexShader->specializationConstants = stage->specializationConstants;
+            stage = vertexShader;
+        }
+    }
+
+    ++numPipelinesUpdated;
+}
@@ -11,12 +11,14 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/core/Version.h>
+#include <vsg/io/FileSystem.h>
 #include <vsg/io/Logger.h>
 #include <vsg/io/Options.h>
 #include <vsg/nodes/StateGroup.h>
 #include <vsg/raytracing/RayTracingPipeline.h>
 #include <vsg/state/ComputePipeline.h>
 #include <vsg/state/GraphicsPipeline.h>
+#include <vsg/threading/OperationThreads.h>
 #include <vsg/utils/ShaderCompiler.h>
 
 #if VSG_SUPPORTS_ShaderCompiler
@@ -30,7 +32,12 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #endif
 
 #include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
 
 #ifndef VK_API_VERSION_MAJOR
 #    define VK_API_VERSION_MAJOR(version) (((uint32_t)(version) >> 22) & 0x7FU)
@@ -93,6 +100,143 @@ namespace
         }
     }
 #endif
+
+#if VSG_SUPPORTS_ShaderCompiler
+    // FNV-1a hash, used rather than std::hash as the file cache requires hash values that are consistent across processes and builds.
+    uint64_t fnv1a(const std::string& str, uint64_t hash = 14695981039346656037ull)
+    {
+        for (auto c : str)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /// layout of the SPIR-V file cache entries
+    constexpr uint32_t s_spirvCacheMagic = 0x56535056; // "VPSV"
+    constexpr uint32_t s_spirvCacheVersion = 1;
+
+    struct SpirvCacheKey
+    {
+        Path filename;
+        uint64_t check = 0;
+    };
+
+    SpirvCacheKey spirvCacheKey(const Path& fileCache, const ShaderStages& shaders, const std::vector<std::string>& finalShaderSources, const ShaderCompileSettings& defaults)
+    {
+        // the sources already have their includes inserted and defines added, so the key covers the source, includes, defines and settings of each stage
+        std::ostringstream key;
+        key << VSG_VERSION_STRING << " optimizer=" << VSG_SUPPORTS_ShaderOptimizer << "\n";
+        for (size_t i = 0; i < shaders.size(); ++i)
+        {
+            const auto& vsg_shader = shaders[i];
+            const auto& settings = vsg_shader->module->hints ? *(vsg_shader->module->hints) : defaults;
+            key << "stage=" << vsg_shader->stage << " entryPoint=" << vsg_shader->entryPointName
+                << " vulkanVersion=" << settings.vulkanVersion << " clientInputVersion=" << settings.clientInputVersion
+                << " language=" << settings.language << " defaultVersion=" << settings.defaultVersion << " target=" << settings.target
+                << " forwardCompatible=" << settings.forwardCompatible << " generateDebugInfo=" << settings.generateDebugInfo << " optimize=" << settings.optimize
+                << " sourceSize=" << finalShaderSources[i].size() << "\n"
+                << finalShaderSources[i] << "\n";
+        }
+
+        auto keyString = key.str();
+
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << fnv1a(keyString) << ".spv";
+
+        // second hash seeded differently, stored in the file to guard against filename collisions
+        return SpirvCacheKey{fileCache / "spirv" / Path(name.str()), fnv1a(keyString, 0x84222325cbf29ce4ull)};
+    }
+
+    bool readSpirvCache(const SpirvCacheKey& cacheKey, ShaderStages& shaders)
+    {
+        if (!fileExists(cacheKey.filename)) return false;
+
+        std::ifstream fin(cacheKey.filename, std::ios::in | std::ios::binary);
+        if (!fin.is_open()) return false;
+
+        auto readValue = [&fin](auto& value) { fin.read(reinterpret_cast<char*>(&value), sizeof(value)); };
+
+        uint32_t magic = 0, version = 0, numStages = 0;
+        uint64_t check = 0;
+        readValue(magic);
+        readValue(version);
+        readValue(check);
+        readValue(numStages);
+        if (!fin.good() || magic != s_spirvCacheMagic || version != s_spirvCacheVersion || check != cacheKey.check || numStages != shaders.size()) return false;
+
+        std::vector<ShaderModule::SPIRV> codes(numStages);
+        for (uint32_t i = 0; i < numStages; ++i)
+        {
+            uint32_t stage = 0, numWords = 0;
+            readValue(stage);
+            readValue(numWords);
+            if (!fin.good() || stage != static_cast<uint32_t>(shaders[i]->stage)) return false;
+
+            codes[i].resize(numWords);
+            fin.read(reinterpret_cast<char*>(codes[i].data()), numWords * sizeof(uint32_t));
+            if (!fin.good()) return false;
+        }
+
+        for (uint32_t i = 0; i < numStages; ++i)
+        {
+            shaders[i]->module->code = std::move(codes[i]);
+        }
+
+        return true;
+    }
+
+    void writeSpirvCache(const SpirvCacheKey& cacheKey, const ShaderStages& shaders)
+    {
+        auto directory = filePath(cacheKey.filename);
+        if (directory && !fileExists(directory)) makeDirectory(directory);
+
+        // write to a temporary file unique to this process and thread, then rename it over the final filename so that
+        // concurrent readers and writers in other processes never see a partially written file.
+        static std::atomic_uint s_tempCount = 0;
+        std::ostringstream suffix;
+        suffix << "." << std::hex << std::random_device{}() << "_" << std::hash<std::thread::id>{}(std::this_thread::get_id()) << "_"
+               << std::chrono::steady_clock::now().time_since_epoch().count() << "_" << s_tempCount.fetch_add(1) << ".tmp";
+        auto tempFilename = cacheKey.filename + Path(suffix.str());
+
+        {
+            std::ofstream fout(tempFilename, std::ios::out | std::ios::binary);
+            if (!fout.is_open())
+            {
+                debug("ShaderCompiler::compile() unable to open ", tempFilename, " for writing.");
+                return;
+            }
+
+            auto writeValue = [&fout](const auto& value) { fout.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+            writeValue(s_spirvCacheMagic);
+            writeValue(s_spirvCacheVersion);
+            writeValue(cacheKey.check);
+            writeValue(static_cast<uint32_t>(shaders.size()));
+            for (const auto& vsg_shader : shaders)
+            {
+                const auto& code = vsg_shader->module->code;
+                writeValue(static_cast<uint32_t>(vsg_shader->stage));
+                writeValue(static_cast<uint32_t>(code.size()));
+                fout.write(reinterpret_cast<const char*>(code.data()), code.size() * sizeof(uint32_t));
+            }
+
+            if (!fout.good())
+            {
+                fout.close();
+                removeFile(tempFilename);
+                return;
+            }
+        }
+
+        if (!renameFile(tempFilename, cacheKey.filename))
+        {
+            // another process may have written the same entry, either way the temporary file is no longer required
+            removeFile(tempFilename);
+        }
+    }
+#endif
 } // namespace
 
 std::string debugFormatShaderSource(const std::string& source)
@@ -160,6 +304,36 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
         return "";
     };
 
+    // insert includes and defines up front so that the final sources can be used as the file cache key
+    std::vector<std::string> finalShaderSources;
+    finalShaderSources.reserve(shaders.size());
+    for (auto& vsg_shader : shaders)
+    {
+        auto settings = vsg_shader->module->hints ? vsg_shader->module->hints : defaults;
+
+        std::string finalShaderSource = vsg::insertIncludes(vsg_shader->module->source, options);
+
+        std::vector<std::string> combinedDefines(defines);
+        for (auto& define : settings->defines) combinedDefines.push_back(define);
+        if (!combinedDefines.empty()) finalShaderSource = combineSourceAndDefines(finalShaderSource, combinedDefines);
+
+        vsg::debug("ShaderCompiler::compile() combinedDefines = ", combinedDefines);
+
+        finalShaderSources.push_back(std::move(finalShaderSource));
+    }
+
+    // reuse previously compiled SPIR-V from the file cache when available
+    SpirvCacheKey cacheKey;
+    if (options && options->fileCache && !shaders.empty())
+    {
+        cacheKey = spirvCacheKey(options->fileCache, shaders, finalShaderSources, *defaults);
+        if (readSpirvCache(cacheKey, shaders))
+        {
+            debug("ShaderCompiler::compile() read SPIR-V from file cache ", cacheKey.filename);
+            return true;
+        }
+    }
+
     using StageShaderMap = std::map<EShLanguage, ref_ptr<ShaderStage>>;
     using TShaders = std::list<std::unique_ptr<glslang::TShader>>;
     TShaders tshaders;
@@ -199,8 +373,9 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
     StageShaderMap stageShaderMap;
     std::unique_ptr<glslang::TProgram> program(new glslang::TProgram);
 
-    for (auto& vsg_shader : shaders)
+    for (size_t stageIndex = 0; stageIndex < shaders.size(); ++stageIndex)
     {
+        auto& vsg_shader = shaders[stageIndex];
         EShLanguage envStage = EShLangCount;
 
         glslang::EShTargetLanguageVersion minTargetLanguageVersion = glslang::EShTargetSpv_1_0;
@@ -278,13 +453,7 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
         shader->setEnvClient(glslang::EShClientVulkan, targetClientVersion);
         shader->setEnvTarget(glslang::EShTargetSpv, targetLanguageVersion);
 
-        std::string finalShaderSource = vsg::insertIncludes(vsg_shader->module->source, options);
-
-        std::vector<std::string> combinedDefines(defines);
-        for (auto& define : settings->defines) combinedDefines.push_back(define);
-        if (!combinedDefines.empty()) finalShaderSource = combineSourceAndDefines(finalShaderSource, combinedDefines);
-
-        vsg::debug("ShaderCompiler::compile() combinedDefines = ", combinedDefines);
+        const std::string& finalShaderSource = finalShaderSources[stageIndex];
 
         const char* str = finalShaderSource.c_str();
         shader->setStrings(&str, 1);
@@ -380,6 +549,8 @@ bool ShaderCompiler::compile(ShaderStages& shaders, const std::vector<std::strin
         }
     }
 
+    if (cacheKey.filename) writeSpirvCache(cacheKey, shaders);
+
     return true;
 }
 #else
@@ -584,3 +755,71 @@ void ShaderCompiler::apply(BindRayTracingPipeline& brtp)
         compile(pipeline->getShaderStages()); // may need to map defines and paths in some fashion
     }
 }
+
+bool ShaderCompiler::compileBatch(std::vector<ShaderStages>& batch, const std::vector<std::string>& defines, ref_ptr<const Options> options)
+{
+    ref_ptr<OperationThreads> operationThreads;
+    if (options) operationThreads = options->operationThreads;
+
+    if (!operationThreads || batch.size() <= 1)
+    {
+        bool result = true;
+        for (auto& shaders : batch)
+        {
+            if (!compile(shaders, defines, options)) result = false;
+        }
+        return result;
+    }
+
+#if VSG_SUPPORTS_ShaderCompiler
+    // initialize glslang before dispatching the compiles so that the operations don't race on _initialized
+    if (!_initialized)
+    {
+        s_initializeProcess();
+        _initialized = true;
+    }
+#endif
+
+    struct CompileOperation : public Operation
+    {
+        CompileOperation(ShaderCompiler* in_compiler, ShaderStages& in_shaders, const std::vector<std::string>& in_defines, ref_ptr<const Options> in_options, uint8_t& in_result, ref_ptr<Latch> in_latch) :
+            compiler(in_compiler),
+            shaders(in_shaders),
+            defines(in_defines),
+            options(in_options),
+            result(in_result),
+            latch(in_latch) {}
+
+        void run() override
+        {
+            // glslang is thread safe for separate TShader/TProgram instances so each ShaderStages can be compiled independently
+            result = compiler->compile(shaders, defines, options) ? 1 : 0;
+            latch->count_down();
+        }
+
+        ShaderCompiler* compiler;
+        ShaderStages& shaders;
+        const std::vector<std::string>& defines;
+        ref_ptr<const Options> options;
+        uint8_t& result;
+        ref_ptr<Latch> latch;
+    };
+
+    std::vector<uint8_t> results(batch.size(), 0);
+
+    // use latch to synchronize this thread with the compile threads
+    auto latch = Latch::create(static_cast<int>(batch.size()));
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        operationThreads->add(ref_ptr<Operation>(new CompileOperation(this, batch[i], defines, options, results[i], latch)));
+    }
+
+    // use this thread to compile shaders as well
+    operationThreads->run();
+
+    // wait till all the compile operations have completed
+    latch->wait();
+
+    return std::all_of(results.begin(), results.end(), [](uint8_t result) { return result != 0; });
+}
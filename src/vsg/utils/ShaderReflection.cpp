@@ -0,0 +1,658 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/hash.h>
+#include <vsg/io/Logger.h>
+#include <vsg/state/ImageInfo.h>
+#include <vsg/utils/ShaderReflection.h>
+#include <vsg/utils/ShaderSet.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace vsg;
+
+namespace
+{
+    // subset of the SPIR-V specification's enums required to reflect the resources of a module
+    enum Op : uint32_t
+    {
+        OpName = 5,
+        OpEntryPoint = 15,
+        OpTypeInt = 21,
+        OpTypeFloat = 22,
+        OpTypeVector = 23,
+        OpTypeMatrix = 24,
+        OpTypeImage = 25,
+        OpTypeSampler = 26,
+        OpTypeSampledImage = 27,
+        OpTypeArray = 28,
+        OpTypeRuntimeArray = 29,
+        OpTypeStruct = 30,
+        OpTypePointer = 32,
+        OpConstant = 43,
+        OpVariable = 59,
+        OpDecorate = 71,
+        OpMemberDecorate = 72,
+        OpTypeAccelerationStructureKHR = 5341
+    };
+
+    enum Decoration : uint32_t
+    {
+        Block = 2,
+        BufferBlock = 3,
+        ArrayStride = 6,
+        MatrixStride = 7,
+        BuiltIn = 11,
+        Location = 30,
+        Binding = 33,
+        DescriptorSet = 34,
+        Offset = 35
+    };
+
+    enum StorageClass : uint32_t
+    {
+        UniformConstant = 0,
+        Input = 1,
+        Uniform = 2,
+        PushConstant = 9,
+        StorageBuffer = 12
+    };
+
+    enum Dim : uint32_t
+    {
+        DimBuffer = 5,
+        DimSubpassData = 6
+    };
+
+    VkShaderStageFlags executionModelStage(uint32_t executionModel)
+    {
+        switch (executionModel)
+        {
+        case 0: return VK_SHADER_STAGE_VERTEX_BIT;
+        case 1: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+        case 2: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+        case 3: return VK_SHADER_STAGE_GEOMETRY_BIT;
+        case 4: return VK_SHADER_STAGE_FRAGMENT_BIT;
+        case 5: return VK_SHADER_STAGE_COMPUTE_BIT;
+        case 5267:
+        case 5364: return VK_SHADER_STAGE_TASK_BIT_EXT;
+        case 5268:
+        case 5365: return VK_SHADER_STAGE_MESH_BIT_EXT;
+        case 5313: return VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+        case 5314: return VK_SHADER_STAGE_INTERSECTION_BIT_KHR;
+        case 5315: return VK_SHADER_STAGE_ANY_HIT_BIT_KHR;
+        case 5316: return VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+        case 5317: return VK_SHADER_STAGE_MISS_BIT_KHR;
+        case 5318: return VK_SHADER_STAGE_CALLABLE_BIT_KHR;
+        default: return 0;
+        }
+    }
+
+    struct Instruction
+    {
+        uint32_t opcode = 0;
+        const uint32_t* operands = nullptr; // operands following the result id
+        uint32_t numOperands = 0;
+
+        uint32_t operand(uint32_t i) const { return i < numOperands ? operands[i] : 0; }
+    };
+
+    struct Module
+    {
+        std::unordered_map<uint32_t, Instruction> types;
+        std::unordered_map<uint32_t, uint32_t> constants;
+        std::unordered_map<uint32_t, std::string> names;
+        std::unordered_map<uint32_t, std::map<uint32_t, uint32_t>> decorations;
+        std::map<std::pair<uint32_t, uint32_t>, std::map<uint32_t, uint32_t>> memberDecorations;
+        std::vector<Instruction> variables; // operands are result type, result id, storage class
+
+        const Instruction* type(uint32_t id) const
+        {
+            auto itr = types.find(id);
+            return itr != types.end() ? &itr->second : nullptr;
+        }
+
+        bool decoration(uint32_t id, uint32_t decoration, uint32_t& value) const
+        {
+            if (auto itr = decorations.find(id); itr != decorations.end())
+            {
+                if (auto d_itr = itr->second.find(decoration); d_itr != itr->second.end())
+                {
+                    value = d_itr->second;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool hasDecoration(uint32_t id, uint32_t decoration) const
+        {
+            uint32_t value;
+            return this->decoration(id, decoration, value);
+        }
+
+        uint32_t memberDecoration(uint32_t id, uint32_t member, uint32_t decoration, uint32_t defaultValue) const
+        {
+            if (auto itr = memberDecorations.find({id, member}); itr != memberDecorations.end())
+            {
+                if (auto d_itr = itr->second.find(decoration); d_itr != itr->second.end()) return d_itr->second;
+            }
+            return defaultValue;
+        }
+
+        std::string name(uint32_t id) const
+        {
+            auto itr = names.find(id);
+            return itr != names.end() ? itr->second : std::string();
+        }
+
+        // size in bytes of the type when laid out in a block, matrixStride is the MatrixStride decoration of the enclosing member
+        uint32_t size(uint32_t id, uint32_t matrixStride = 0) const
+        {
+            auto t = type(id);
+            if (!t) return 0;
+
+            switch (t->opcode)
+            {
+            case OpTypeInt:
+            case OpTypeFloat:
+                return t->operand(0) / 8;
+            case OpTypeVector:
+                return t->operand(1) * size(t->operand(0));
+            case OpTypeMatrix:
+                return t->operand(1) * (matrixStride != 0 ? matrixStride : size(t->operand(0)));
+            case OpTypeArray: {
+                uint32_t stride = 0;
+                if (!decoration(id, ArrayStride, stride)) stride = size(t->operand(0), matrixStride);
+                auto c_itr = constants.find(t->operand(1));
+                return (c_itr != constants.end() ? c_itr->second : 1) * stride;
+            }
+            case OpTypeStruct: {
+                uint32_t structSize = 0;
+                for (uint32_t m = 0; m < t->numOperands; ++m)
+                {
+                    uint32_t offset = memberDecoration(id, m, Offset, 0);
+                    uint32_t memberSize = size(t->operands[m], memberDecoration(id, m, MatrixStride, 0));
+                    structSize = std::max(structSize, offset + memberSize);
+                }
+                return structSize;
+            }
+            default:
+                return 0;
+            }
+        }
+    };
+
+    std::string decodeString(const uint32_t* words, uint32_t numWords)
+    {
+        auto chars = reinterpret_cast<const char*>(words);
+        size_t length = 0;
+        size_t maxLength = static_cast<size_t>(numWords) * 4;
+        while (length < maxLength && chars[length] != 0) ++length;
+        return std::string(chars, length);
+    }
+
+    VkFormat vertexFormat(const Instruction& scalar, uint32_t numComponents)
+    {
+        static const VkFormat float16Formats[] = {VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT};
+        static const VkFormat float32Formats[] = {VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT};
+        static const VkFormat float64Formats[] = {VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT};
+        static const VkFormat int32Formats[] = {VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT};
+        static const VkFormat uint32Formats[] = {VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT};
+
+        if (numComponents < 1 || numComponents > 4) return VK_FORMAT_UNDEFINED;
+
+        uint32_t width = scalar.operand(0);
+        if (scalar.opcode == OpTypeFloat)
+        {
+            if (width == 16) return float16Formats[numComponents - 1];
+            if (width == 32) return float32Formats[numComponents - 1];
+            if (width == 64) return float64Formats[numComponents - 1];
+        }
+        else if (scalar.opcode == OpTypeInt && width == 32)
+        {
+            return scalar.operand(1) != 0 ? int32Formats[numComponents - 1] : uint32Formats[numComponents - 1];
+        }
+        return VK_FORMAT_UNDEFINED;
+    }
+
+    VkDescriptorType descriptorType(const Module& module, const Instruction& t, uint32_t typeID, uint32_t storageClass)
+    {
+        switch (t.opcode)
+        {
+        case OpTypeSampledImage:
+            return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        case OpTypeSampler:
+            return VK_DESCRIPTOR_TYPE_SAMPLER;
+        case OpTypeAccelerationStructureKHR:
+            return VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR;
+        case OpTypeImage: {
+            uint32_t dim = t.operand(1);
+            bool storage = t.operand(5) == 2;
+            if (dim == DimSubpassData) return VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+            if (dim == DimBuffer) return storage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+            return storage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        }
+        case OpTypeStruct:
+            if (storageClass == StorageBuffer || module.hasDecoration(typeID, BufferBlock)) return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            if (storageClass == Uniform) return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+            return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        default:
+            return VK_DESCRIPTOR_TYPE_MAX_ENUM;
+        }
+    }
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ShaderReflection
+//
+ShaderReflection::ShaderReflection()
+{
+}
+
+ShaderReflection::ShaderReflection(const ShaderModule::SPIRV& code)
+{
+    reflect(code);
+}
+
+ShaderReflection::~ShaderReflection()
+{
+}
+
+bool ShaderReflection::reflect(const ShaderModule::SPIRV& code)
+{
+    stageFlags = 0;
+    descriptorBindings.clear();
+    vertexAttributes.clear();
+    pushConstantSize = 0;
+    valid = false;
+
+    const uint32_t headerSize = 5;
+    if (code.size() < headerSize || code[0] != 0x07230203)
+    {
+        warn("ShaderReflection::reflect(..) invalid SPIR-V header.");
+        return false;
+    }
+
+    Module module;
+
+    // gather the names, decorations, types and variables of the module
+    for (size_t pos = headerSize; pos < code.size();)
+    {
+        uint32_t opcode = code[pos] & 0xffff;
+        uint32_t wordCount = code[pos] >> 16;
+        if (wordCount == 0 || pos + wordCount > code.size())
+        {
+            warn("ShaderReflection::reflect(..) malformed SPIR-V instruction at word ", pos);
+            return false;
+        }
+
+        const uint32_t* words = code.data() + pos;
+        switch (opcode)
+        {
+        case OpName:
+            if (wordCount > 2) module.names[words[1]] = decodeString(words + 2, wordCount - 2);
+            break;
+        case OpEntryPoint:
+            if (wordCount > 1) stageFlags |= executionModelStage(words[1]);
+            break;
+        case OpDecorate:
+            if (wordCount > 2) module.decorations[words[1]][words[2]] = (wordCount > 3) ? words[3] : 0;
+            break;
+        case OpMemberDecorate:
+            if (wordCount > 3) module.memberDecorations[{words[1], words[2]}][words[3]] = (wordCount > 4) ? words[4] : 0;
+            break;
+        case OpConstant:
+            if (wordCount > 3) module.constants[words[2]] = words[3];
+            break;
+        case OpVariable:
+            if (wordCount > 3) module.variables.push_back(Instruction{opcode, words + 1, wordCount - 1});
+            break;
+        case OpTypeInt:
+        case OpTypeFloat:
+        case OpTypeVector:
+        case OpTypeMatrix:
+        case OpTypeImage:
+        case OpTypeSampler:
+        case OpTypeSampledImage:
+        case OpTypeArray:
+        case OpTypeRuntimeArray:
+        case OpTypeStruct:
+        case OpTypePointer:
+        case OpTypeAccelerationStructureKHR:
+            if (wordCount > 1) module.types[words[1]] = Instruction{opcode, words + 2, wordCount - 2};
+            break;
+        default:
+            break;
+        }
+
+        pos += wordCount;
+    }
+
+    for (auto& variable : module.variables)
+    {
+        uint32_t variableID = variable.operand(1);
+        uint32_t storageClass = variable.operand(2);
+
+        auto pointer = module.type(variable.operand(0));
+        if (!pointer || pointer->opcode != OpTypePointer) continue;
+
+        uint32_t typeID = pointer->operand(1);
+        auto t = module.type(typeID);
+        if (!t) continue;
+
+        if (storageClass == PushConstant)
+        {
+            pushConstantSize = std::max(pushConstantSize, module.size(typeID));
+        }
+        else if (storageClass == UniformConstant || storageClass == Uniform || storageClass == StorageBuffer)
+        {
+            DescriptorBinding db;
+            if (!module.decoration(variableID, DescriptorSet, db.set) || !module.decoration(variableID, Binding, db.binding)) continue;
+
+            // unwrap arrays of descriptors
+            while (t && (t->opcode == OpTypeArray || t->opcode == OpTypeRuntimeArray))
+            {
+                if (t->opcode == OpTypeRuntimeArray)
+                {
+                    db.runtimeArray = true;
+                }
+                else if (auto c_itr = module.constants.find(t->operand(1)); c_itr != module.constants.end())
+                {
+                    db.descriptorCount *= c_itr->second;
+                }
+                typeID = t->operand(0);
+                t = module.type(typeID);
+            }
+            if (!t) continue;
+
+            db.descriptorType = descriptorType(module, *t, typeID, storageClass);
+            if (db.descriptorType == VK_DESCRIPTOR_TYPE_MAX_ENUM) continue;
+
+            // anonymous block instances take the name of the block
+            db.name = module.name(variableID);
+            if (db.name.empty()) db.name = module.name(typeID);
+
+            descriptorBindings.push_back(db);
+        }
+        else if (storageClass == Input && (stageFlags & VK_SHADER_STAGE_VERTEX_BIT) != 0)
+        {
+            uint32_t location = 0;
+            if (module.hasDecoration(variableID, BuiltIn) || !module.decoration(variableID, Location, location)) continue;
+
+            uint32_t numElements = 1;
+            if (t->opcode == OpTypeArray)
+            {
+                if (auto c_itr = module.constants.find(t->operand(1)); c_itr != module.constants.end()) numElements = c_itr->second;
+                t = module.type(t->operand(0));
+            }
+            if (t && t->opcode == OpTypeMatrix)
+            {
+                numElements *= t->operand(1);
+                t = module.type(t->operand(0));
+            }
+            if (!t) continue;
+
+            uint32_t numComponents = 1;
+            if (t->opcode == OpTypeVector)
+            {
+                numComponents = t->operand(1);
+                t = module.type(t->operand(0));
+            }
+            if (!t) continue;
+
+            VkFormat format = vertexFormat(*t, numComponents);
+            if (format == VK_FORMAT_UNDEFINED) continue;
+
+            // 64 bit three and four component vectors consume two locations
+            uint32_t locationsPerElement = (t->operand(0) == 64 && numComponents > 2) ? 2 : 1;
+
+            std::string name = module.name(variableID);
+            for (uint32_t i = 0; i < numElements; ++i)
+            {
+                vertexAttributes.push_back(VertexAttribute{name, location + i * locationsPerElement, format});
+            }
+        }
+    }
+
+    std::sort(descriptorBindings.begin(), descriptorBindings.end(), [](const DescriptorBinding& lhs, const DescriptorBinding& rhs) {
+        return lhs.set < rhs.set || (lhs.set == rhs.set && lhs.binding < rhs.binding);
+    });
+
+    std::sort(vertexAttributes.begin(), vertexAttributes.end(), [](const VertexAttribute& lhs, const VertexAttribute& rhs) {
+        return lhs.location < rhs.location;
+    });
+
+    valid = true;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ReflectedLayoutCache
+//
+ReflectedLayoutCache::ReflectedLayoutCache(ref_ptr<SharedObjects> in_sharedObjects) :
+    sharedObjects(in_sharedObjects)
+{
+    if (!sharedObjects) sharedObjects = SharedObjects::create();
+}
+
+ReflectedLayoutCache::~ReflectedLayoutCache()
+{
+}
+
+ref_ptr<ShaderReflection> ReflectedLayoutCache::_reflect(const ShaderModule& module, uint64_t& hash)
+{
+    if (module.code.empty()) return {};
+
+    hash = hash_bytes(module.code.data(), module.code.size() * sizeof(uint32_t));
+    Key key(hash, module.code.size());
+
+    std::scoped_lock<std::recursive_mutex> lock(_mutex);
+
+    if (auto itr = _reflections.find(key); itr != _reflections.end())
+    {
+        ++numCacheHits;
+        return itr->second;
+    }
+
+    auto reflection = ShaderReflection::create(module.code);
+    _reflections[key] = reflection;
+    ++numReflected;
+
+    return reflection;
+}
+
+ref_ptr<ShaderReflection> ReflectedLayoutCache::reflect(const ShaderModule& module)
+{
+    uint64_t hash = 0;
+    return _reflect(module, hash);
+}
+
+DescriptorSetLayoutBindings ReflectedLayoutCache::getDescriptorSetLayoutBindings(const ShaderStages& stages, uint32_t set)
+{
+    DescriptorSetLayoutBindings bindings;
+    for (auto& stage : stages)
+    {
+        if (!stage || !stage->module) continue;
+
+        auto reflection = reflect(*stage->module);
+        if (!reflection || !reflection->valid) continue;
+
+        for (auto& db : reflection->descriptorBindings)
+        {
+            if (db.set != set) continue;
+
+            auto itr = std::find_if(bindings.begin(), bindings.end(), [&](const VkDescriptorSetLayoutBinding& binding) { return binding.binding == db.binding; });
+            if (itr != bindings.end())
+            {
+                if (itr->descriptorType != db.descriptorType)
+                {
+                    warn("ReflectedLayoutCache::getDescriptorSetLayoutBindings(..) set = ", set, ", binding = ", db.binding, " declared with different descriptor types by different stages.");
+                }
+                itr->descriptorCount = std::max(itr->descriptorCount, db.descriptorCount);
+                itr->stageFlags |= stage->stage;
+            }
+            else
+            {
+                bindings.push_back(VkDescriptorSetLayoutBinding{db.binding, db.descriptorType, db.descriptorCount, static_cast<VkShaderStageFlags>(stage->stage), nullptr});
+            }
+        }
+    }
+
+    std::sort(bindings.begin(), bindings.end(), [](const VkDescriptorSetLayoutBinding& lhs, const VkDescriptorSetLayoutBinding& rhs) { return lhs.binding < rhs.binding; });
+
+    return bindings;
+}
+
+ref_ptr<DescriptorSetLayout> ReflectedLayoutCache::getOrCreateDescriptorSetLayout(const ShaderStages& stages, uint32_t set)
+{
+    auto dsl = DescriptorSetLayout::create(getDescriptorSetLayoutBindings(stages, set));
+
+    std::scoped_lock<std::recursive_mutex> lock(_mutex);
+    sharedObjects->share(dsl);
+    return dsl;
+}
+
+ref_ptr<PipelineLayout> ReflectedLayoutCache::getOrCreatePipelineLayout(const ShaderStages& stages)
+{
+    std::vector<uint64_t> key;
+    std::vector<ref_ptr<ShaderReflection>> reflections;
+    for (auto& stage : stages)
+    {
+        if (!stage || !stage->module) continue;
+
+        uint64_t hash = 0;
+        auto reflection = _reflect(*stage->module, hash);
+        if (!reflection || !reflection->valid)
+        {
+            warn("ReflectedLayoutCache::getOrCreatePipelineLayout(..) unable to reflect ShaderStage without valid SPIR-V.");
+            return {};
+        }
+
+        key.push_back(hash_combine(hash, static_cast<uint64_t>(stage->stage)));
+        reflections.push_back(reflection);
+    }
+
+    std::scoped_lock<std::recursive_mutex> lock(_mutex);
+
+    if (auto itr = _pipelineLayouts.find(key); itr != _pipelineLayouts.end()) return itr->second;
+
+    uint32_t numSets = 0;
+    VkPushConstantRange pushConstantRange{0, 0, 0};
+    for (size_t i = 0; i < reflections.size(); ++i)
+    {
+        for (auto& db : reflections[i]->descriptorBindings) numSets = std::max(numSets, db.set + 1);
+        if (reflections[i]->pushConstantSize > 0)
+        {
+            pushConstantRange.stageFlags |= stages[i]->stage;
+            pushConstantRange.size = std::max(pushConstantRange.size, reflections[i]->pushConstantSize);
+        }
+    }
+
+    DescriptorSetLayouts setLayouts;
+    for (uint32_t set = 0; set < numSets; ++set)
+    {
+        setLayouts.push_back(getOrCreateDescriptorSetLayout(stages, set));
+    }
+
+    PushConstantRanges pushConstantRanges;
+    if (pushConstantRange.size > 0) pushConstantRanges.push_back(pushConstantRange);
+
+    auto pipelineLayout = PipelineLayout::create(setLayouts, pushConstantRanges);
+    sharedObjects->share(pipelineLayout);
+
+    _pipelineLayouts[key] = pipelineLayout;
+    return pipelineLayout;
+}
+
+ref_ptr<VertexInputState> ReflectedLayoutCache::getOrCreateVertexInputState(const ShaderStages& stages, VkVertexInputRate inputRate)
+{
+    auto vertexInputState = VertexInputState::create();
+    for (auto& stage : stages)
+    {
+        if (!stage || !stage->module || stage->stage != VK_SHADER_STAGE_VERTEX_BIT) continue;
+
+        auto reflection = reflect(*stage->module);
+        if (!reflection || !reflection->valid) continue;
+
+        for (auto& attribute : reflection->vertexAttributes)
+        {
+            auto stride = static_cast<uint32_t>(getFormatTraits(attribute.format).size);
+            vertexInputState->vertexBindingDescriptions.push_back(VkVertexInputBindingDescription{attribute.location, stride, inputRate});
+            vertexInputState->vertexAttributeDescriptions.push_back(VkVertexInputAttributeDescription{attribute.location, attribute.location, attribute.format, 0});
+        }
+    }
+
+    std::scoped_lock<std::recursive_mutex> lock(_mutex);
+    sharedObjects->share(vertexInputState);
+    return vertexInputState;
+}
+
+void ReflectedLayoutCache::assignBindings(ShaderSet& shaderSet)
+{
+    // bindings already declared by the ShaderSet are left as is, only the bindings added here have their stageFlags merged across stages
+    size_t numDeclaredDescriptorBindings = shaderSet.descriptorBindings.size();
+    bool declaredPushConstantRanges = !shaderSet.pushConstantRanges.empty();
+    VkPushConstantRange pushConstantRange{0, 0, 0};
+
+    for (auto& stage : shaderSet.stages)
+    {
+        if (!stage || !stage->module) continue;
+
+        auto reflection = reflect(*stage->module);
+        if (!reflection || !reflection->valid) continue;
+
+        for (auto& attribute : reflection->vertexAttributes)
+        {
+            auto itr = std::find_if(shaderSet.attributeBindings.begin(), shaderSet.attributeBindings.end(), [&](const AttributeBinding& ab) { return ab.location == attribute.location; });
+            if (itr == shaderSet.attributeBindings.end() && !attribute.name.empty())
+            {
+                shaderSet.addAttributeBinding(attribute.name, "", attribute.location, attribute.format, {});
+            }
+        }
+
+        for (auto& db : reflection->descriptorBindings)
+        {
+            auto itr = std::find_if(shaderSet.descriptorBindings.begin(), shaderSet.descriptorBindings.end(), [&](const vsg::DescriptorBinding& binding) { return binding.set == db.set && binding.binding == db.binding; });
+            if (itr == shaderSet.descriptorBindings.end())
+            {
+                if (!db.name.empty()) shaderSet.addDescriptorBinding(db.name, "", db.set, db.binding, db.descriptorType, db.descriptorCount, stage->stage, {});
+            }
+            else if (static_cast<size_t>(itr - shaderSet.descriptorBindings.begin()) >= numDeclaredDescriptorBindings)
+            {
+                itr->stageFlags |= stage->stage;
+            }
+        }
+
+        if (reflection->pushConstantSize > 0)
+        {
+            pushConstantRange.stageFlags |= stage->stage;
+            pushConstantRange.size = std::max(pushConstantRange.size, reflection->pushConstantSize);
+        }
+    }
+
+    if (!declaredPushConstantRanges && pushConstantRange.size > 0)
+    {
+        shaderSet.addPushConstantRange("pc", "", pushConstantRange.stageFlags, 0, pushConstantRange.size);
+    }
+}
+
+void ReflectedLayoutCache::clear()
+{
+    std::scoped_lock<std::recursive_mutex> lock(_mutex);
+    _reflections.clear();
+    _pipelineLayouts.clear();
+}
@@ -12,13 +12,18 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include <vsg/app/View.h>
 #include <vsg/io/Input.h>
+#include <vsg/io/Logger.h>
 #include <vsg/io/Output.h>
 #include <vsg/io/read.h>
+#include <vsg/meshshaders/Meshlets.h>
 #include <vsg/state/ColorBlendState.h>
 #include <vsg/state/DescriptorImage.h>
+#include <vsg/state/InputAssemblyState.h>
 #include <vsg/state/PipelineLayout.h>
+#include <vsg/state/TessellationState.h>
 #include <vsg/state/ViewDependentState.h>
 #include <vsg/state/material.h>
+#include <vsg/utils/ShaderCompiler.h>
 #include <vsg/utils/ShaderSet.h>
 #include <vsg/vk/Context.h>
 
@@ -152,6 +157,65 @@ ref_ptr<StateCommand> ViewDependentStateBinding::createStateCommand(ref_ptr<Pipe
     return BindViewDescriptorSets::create(VK_PIPELINE_BIND_POINT_GRAPHICS, layout, set);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BindlessDescriptorSetBinding
+//
+BindlessDescriptorSetBinding::BindlessDescriptorSetBinding(uint32_t in_set, ref_ptr<BindlessDescriptors> in_bindlessDescriptors) :
+    Inherit(in_set),
+    bindlessDescriptors(in_bindlessDescriptors)
+{
+}
+
+int BindlessDescriptorSetBinding::compare(const Object& rhs_object) const
+{
+    int result = CustomDescriptorSetBinding::compare(rhs_object);
+    if (result != 0) return result;
+
+    const auto& rhs = static_cast<decltype(*this)>(rhs_object);
+    return compare_pointer(bindlessDescriptors, rhs.bindlessDescriptors);
+}
+
+void BindlessDescriptorSetBinding::read(Input& input)
+{
+    CustomDescriptorSetBinding::read(input);
+
+    input.readObject("bindlessDescriptors", bindlessDescriptors);
+}
+
+void BindlessDescriptorSetBinding::write(Output& output) const
+{
+    CustomDescriptorSetBinding::write(output);
+
+    output.writeObject("bindlessDescriptors", bindlessDescriptors);
+}
+
+bool BindlessDescriptorSetBinding::compatibleDescriptorSetLayout(const DescriptorSetLayout& dsl) const
+{
+    return bindlessDescriptors && bindlessDescriptors->descriptorSetLayout->compare(dsl) == 0;
+}
+
+ref_ptr<DescriptorSetLayout> BindlessDescriptorSetBinding::createDescriptorSetLayout()
+{
+    return bindlessDescriptors ? bindlessDescriptors->descriptorSetLayout : ref_ptr<DescriptorSetLayout>{};
+}
+
+ref_ptr<StateCommand> BindlessDescriptorSetBinding::createStateCommand(ref_ptr<PipelineLayout> layout)
+{
+    if (!bindlessDescriptors) return {};
+
+    // reuse the same state command for all subgraphs sharing a compatible pipeline layout so that nested/adjacent binds are skipped during recording
+    std::scoped_lock<std::mutex> lock(_mutex);
+    for (auto& sc : _stateCommands)
+    {
+        if (sc->layout == layout || compare_pointer(sc->layout, layout) == 0) return sc;
+    }
+
+    auto sc = BindBindlessDescriptorSet::create(VK_PIPELINE_BIND_POINT_GRAPHICS, layout, set, bindlessDescriptors);
+    _stateCommands.push_back(sc);
+    return sc;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // ShaderSet
@@ -166,6 +230,25 @@ ShaderSet::ShaderSet(const ShaderStages& in_stages, ref_ptr<ShaderCompileSetting
 {
 }
 
+ShaderSet::ShaderSet(const ShaderSet& rhs, const CopyOp& copyop) :
+    Inherit(rhs, copyop),
+    stages(copyop(rhs.stages)),
+    attributeBindings(rhs.attributeBindings),
+    descriptorBindings(rhs.descriptorBindings),
+    pushConstantRanges(rhs.pushConstantRanges),
+    definesArrayStates(rhs.definesArrayStates),
+    optionalDefines(rhs.optionalDefines),
+    defaultGraphicsPipelineStates(rhs.defaultGraphicsPipelineStates),
+    customDescriptorSetBindings(rhs.customDescriptorSetBindings),
+    defaultShaderHints(rhs.defaultShaderHints)
+{
+    std::scoped_lock<std::mutex> lock(const_cast<std::mutex&>(rhs.mutex));
+    for (auto& [hints, variant_stages] : rhs.variants)
+    {
+        variants[hints] = copyop(variant_stages);
+    }
+}
+
 ShaderSet::~ShaderSet()
 {
 }
@@ -173,16 +256,19 @@ ShaderSet::~ShaderSet()
 void ShaderSet::addAttributeBinding(const std::string& name, const std::string& define, uint32_t location, VkFormat format, ref_ptr<Data> data, CoordinateSpace coordinateSpace)
 {
     attributeBindings.push_back(AttributeBinding{name, define, location, format, coordinateSpace, data});
+    resetDefinesRegistry();
 }
 
 void ShaderSet::addDescriptorBinding(const std::string& name, const std::string& define, uint32_t set, uint32_t binding, VkDescriptorType descriptorType, uint32_t descriptorCount, VkShaderStageFlags stageFlags, ref_ptr<Data> data, CoordinateSpace coordinateSpace)
 {
     descriptorBindings.push_back(DescriptorBinding{name, define, set, binding, descriptorType, descriptorCount, stageFlags, coordinateSpace, data});
+    resetDefinesRegistry();
 }
 
 void ShaderSet::addPushConstantRange(const std::string& name, const std::string& define, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size)
 {
     pushConstantRanges.push_back(vsg::PushConstantRange{name, define, VkPushConstantRange{stageFlags, offset, size}});
+    resetDefinesRegistry();
 }
 
 const AttributeBinding& ShaderSet::getAttributeBinding(const std::string& name) const
@@ -253,8 +339,109 @@ ref_ptr<ArrayState> ShaderSet::getSuitableArrayState(const std::set<std::string>
 
 ShaderStages ShaderSet::getShaderStages(ref_ptr<ShaderCompileSettings> scs)
 {
-    std::scoped_lock<std::mutex> lock(mutex);
+    SCOPED_LOCK_INSTRUMENTATION(mutex, "ShaderSet::mutex");
+
+    return _getShaderStages(scs);
+}
+
+ShaderStages ShaderSet::getShaderStages(DefinesMask mask, ref_ptr<ShaderCompileSettings> scs)
+{
+    if (!scs) return getShaderStages(scs);
+
+    SCOPED_LOCK_INSTRUMENTATION(mutex, "ShaderSet::mutex");
+
+    auto& maskVariants = _variantsByMask[mask];
+    for (auto& [hints, variant_stages] : maskVariants)
+    {
+        if (hints->compareExcludingDefines(*scs) == 0) return variant_stages;
+    }
+
+    auto stages_for_mask = _getShaderStages(scs);
+    maskVariants.emplace_back(scs, stages_for_mask);
+    return stages_for_mask;
+}
+
+const ShaderSet::DefinesRegistry& ShaderSet::_getDefinesRegistry() const
+{
+    std::scoped_lock<std::mutex> lock(_definesRegistryMutex);
+
+    if (_definesRegistry) return *_definesRegistry;
+
+    _definesRegistry.reset(new DefinesRegistry);
+    auto& registry = *_definesRegistry;
+
+    std::set<std::string> defines(optionalDefines);
+    for (auto& binding : attributeBindings) defines.insert(binding.define);
+    for (auto& binding : descriptorBindings) defines.insert(binding.define);
+    for (auto& pcr : pushConstantRanges) defines.insert(pcr.define);
+    for (auto& definesArrayState : definesArrayStates) defines.insert(definesArrayState.defines.begin(), definesArrayState.defines.end());
+    if (defaultShaderHints) defines.insert(defaultShaderHints->defines.begin(), defaultShaderHints->defines.end());
+    defines.erase("");
+
+    if (defines.size() > 64) return registry;
+
+    for (auto& define : defines)
+    {
+        auto index = static_cast<uint32_t>(registry.indices.size());
+        registry.indices[define] = index;
+    }
+
+    auto maskOf = [&](const std::string& define) -> DefinesMask {
+        return define.empty() ? DefinesMask(0) : (DefinesMask(1) << registry.indices[define]);
+    };
+
+    for (auto& binding : descriptorBindings) registry.descriptorBindingMasks.push_back(maskOf(binding.define));
+    for (auto& pcr : pushConstantRanges) registry.pushConstantRangeMasks.push_back(maskOf(pcr.define));
+    for (auto& definesArrayState : definesArrayStates)
+    {
+        DefinesMask mask = 0;
+        for (auto& define : definesArrayState.defines) mask |= maskOf(define);
+        registry.definesArrayStateMasks.push_back(mask);
+        registry.arrayStateDefines |= mask;
+    }
+
+    registry.valid = true;
+    return registry;
+}
+
+void ShaderSet::resetDefinesRegistry()
+{
+    std::scoped_lock<std::mutex> lock(_definesRegistryMutex);
+    _definesRegistry.reset();
+}
+
+bool ShaderSet::definesMask(const std::set<std::string>& defines, DefinesMask& mask) const
+{
+    auto& registry = _getDefinesRegistry();
+    if (!registry.valid) return false;
+
+    mask = 0;
+    for (auto& define : defines)
+    {
+        auto itr = registry.indices.find(define);
+        if (itr == registry.indices.end()) return false;
+        mask |= (DefinesMask(1) << itr->second);
+    }
+    return true;
+}
+
+ref_ptr<ArrayState> ShaderSet::getSuitableArrayState(DefinesMask mask) const
+{
+    auto& registry = _getDefinesRegistry();
+    if (!registry.valid) return {};
+
+    // as with getSuitableArrayState(defines) only the defines used by the DefinesArrayStates are relevant to the match
+    DefinesMask relevant_defines = mask & registry.arrayStateDefines;
+    for (size_t i = 0; i < definesArrayStates.size(); ++i)
+    {
+        if (registry.definesArrayStateMasks[i] == relevant_defines) return definesArrayStates[i].arrayState;
+    }
 
+    return {};
+}
+
+ShaderStages ShaderSet::_getShaderStages(ref_ptr<ShaderCompileSettings> scs)
+{
     if (auto itr = variants.find(scs); itr != variants.end())
     {
         return itr->second;
@@ -282,6 +469,45 @@ ShaderStages ShaderSet::getShaderStages(ref_ptr<ShaderCompileSettings> scs)
     return new_stages;
 }
 
+bool ShaderSet::precompileVariants(const std::set<std::string>& defines, ShaderCompiler& shaderCompiler, ref_ptr<const Options> options)
+{
+    // the number of permutations doubles with each define so cap the number that can be precompiled in one call
+    const size_t maxDefines = 16;
+    if (defines.size() > maxDefines)
+    {
+        warn("ShaderSet::precompileVariants() ", defines.size(), " defines exceeds the maximum of ", maxDefines, " supported.");
+        return false;
+    }
+
+    std::vector<std::string> definesList(defines.begin(), defines.end());
+    std::vector<ShaderStages> batch;
+
+    const uint32_t numPermutations = 1u << definesList.size();
+    for (uint32_t permutation = 0; permutation < numPermutations; ++permutation)
+    {
+        // match the settings that GraphicsPipelineConfigurator builds from the defaultShaderHints so the variants are found in the variants map
+        auto scs = defaultShaderHints ? ShaderCompileSettings::create(*defaultShaderHints) : ShaderCompileSettings::create();
+        for (size_t i = 0; i < definesList.size(); ++i)
+        {
+            if ((permutation & (1u << i)) != 0) scs->defines.insert(definesList[i]);
+        }
+
+        auto variant = getShaderStages(scs);
+
+        bool requiresCompile = false;
+        for (auto& stage : variant)
+        {
+            if (stage->module && stage->module->code.empty() && !stage->module->source.empty()) requiresCompile = true;
+        }
+
+        if (requiresCompile) batch.push_back(variant);
+    }
+
+    if (batch.empty()) return true;
+
+    return shaderCompiler.compileBatch(batch, {}, options);
+}
+
 int ShaderSet::compare(const Object& rhs_object) const
 {
     int result = Object::compare(rhs_object);
@@ -359,6 +585,8 @@ void ShaderSet::read(Input& input)
 
     auto num_variants = input.readValue<uint32_t>("variants");
     variants.clear();
+    _variantsByMask.clear();
+    resetDefinesRegistry();
     for (uint32_t i = 0; i < num_variants; ++i)
     {
         auto hints = input.readObject<ShaderCompileSettings>("hints");
@@ -452,6 +680,162 @@ void ShaderSet::write(Output& output) const
     }
 }
 
+static ref_ptr<ShaderSet> addOctahedralNormalSupport(ref_ptr<ShaderSet> shaderSet)
+{
+    // add the optional VSG_OCTAHEDRAL_NORMAL define to the vertex shader so vsg_Normal can be provided as a 2 component octahedral encoded normal,
+    // quantized formats such as VK_FORMAT_R16G16_SNORM are then decoded by the hardware, with the remaining decode done at the start of main().
+    const std::string importDefines = "#pragma import_defines (";
+    const std::string normalDeclaration = "layout(location = 1) in vec3 vsg_Normal;\n";
+    const std::string mainEntry = "void main()\n{\n";
+
+    const std::string octahedralDeclaration = R"(#ifdef VSG_OCTAHEDRAL_NORMAL
+layout(location = 1) in vec2 vsg_NormalOctahedral;
+vec3 vsg_Normal;
+#else
+layout(location = 1) in vec3 vsg_Normal;
+#endif
+)";
+
+    const std::string octahedralDecode = R"(#ifdef VSG_OCTAHEDRAL_NORMAL
+    {
+        vec3 n = vec3(vsg_NormalOctahedral, 1.0 - abs(vsg_NormalOctahedral.x) - abs(vsg_NormalOctahedral.y));
+        float t = max(-n.z, 0.0);
+        n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+        vsg_Normal = normalize(n);
+    }
+#endif
+)";
+
+    for (auto& stage : shaderSet->stages)
+    {
+        if (stage->stage != VK_SHADER_STAGE_VERTEX_BIT || !stage->module) continue;
+
+        auto source = stage->module->source;
+        auto importPos = source.find(importDefines);
+        auto declarationPos = source.find(normalDeclaration);
+        auto mainPos = source.find(mainEntry);
+        if (importPos == std::string::npos || declarationPos == std::string::npos || mainPos == std::string::npos || mainPos < declarationPos)
+        {
+            warn("addOctahedralNormalSupport(..) unable to find insertion points in vertex shader source, VSG_OCTAHEDRAL_NORMAL not supported.");
+            return shaderSet;
+        }
+
+        // insert from the end of the source backwards so the earlier positions remain valid
+        source.insert(mainPos + mainEntry.size(), octahedralDecode);
+        source.replace(declarationPos, normalDeclaration.size(), octahedralDeclaration);
+        source.insert(importPos + importDefines.size(), "VSG_OCTAHEDRAL_NORMAL, ");
+
+        // the precompiled variants remain valid as without VSG_OCTAHEDRAL_NORMAL defined the patched source is equivalent to the original
+        auto vertexShader = ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, stage->entryPointName, source, stage->module->hints);
+        vertexShader->specializationConstants = stage->specializationConstants;
+        stage = vertexShader;
+    }
+
+    shaderSet->optionalDefines.insert("VSG_OCTAHEDRAL_NORMAL");
+
+    return shaderSet;
+}
+
+static ref_ptr<ShaderSet> addCompactInstanceSupport(ref_ptr<ShaderSet> shaderSet)
+{
+    // add the optional VSG_INSTANCE_ROTATION_PACKED and VSG_INSTANCE_UNIFORM_SCALE defines to the vertex shader so the per instance rotations can be provided
+    // as smallest three packed quaternions and the scales as a single float, each decoded at the start of main().
+    const std::string importDefines = "#pragma import_defines (";
+    const std::string rotationDeclaration = "#if defined(VSG_INSTANCE_ROTATION)\nlayout(location = 8) in vec4 vsg_Rotation;\n#endif\n";
+    const std::string scaleDeclaration = "#if defined(VSG_INSTANCE_SCALE)\nlayout(location = 9) in vec3 vsg_Scale;\n#endif\n";
+    const std::string mainEntry = "void main()\n{\n";
+
+    const std::string packedRotationDeclaration = R"(#if defined(VSG_INSTANCE_ROTATION_PACKED)
+#ifndef VSG_INSTANCE_ROTATION
+#define VSG_INSTANCE_ROTATION
+#endif
+layout(location = 8) in uint vsg_RotationPacked;
+vec4 vsg_Rotation;
+#elif defined(VSG_INSTANCE_ROTATION)
+layout(location = 8) in vec4 vsg_Rotation;
+#endif
+)";
+
+    const std::string uniformScaleDeclaration = R"(#if defined(VSG_INSTANCE_UNIFORM_SCALE)
+#ifndef VSG_INSTANCE_SCALE
+#define VSG_INSTANCE_SCALE
+#endif
+layout(location = 9) in float vsg_UniformScale;
+vec3 vsg_Scale;
+#elif defined(VSG_INSTANCE_SCALE)
+layout(location = 9) in vec3 vsg_Scale;
+#endif
+)";
+
+    const std::string instanceDecode = R"(#if defined(VSG_INSTANCE_ROTATION_PACKED)
+    {
+        uint largest = vsg_RotationPacked >> 30;
+        vec3 abc = (vec3(uvec3(vsg_RotationPacked, vsg_RotationPacked >> 10, vsg_RotationPacked >> 20) & uvec3(1023u)) * (2.0 / 1023.0) - 1.0) * 0.70710678;
+        float d = sqrt(max(1.0 - dot(abc, abc), 0.0));
+        if (largest == 0u) vsg_Rotation = vec4(d, abc);
+        else if (largest == 1u) vsg_Rotation = vec4(abc.x, d, abc.yz);
+        else if (largest == 2u) vsg_Rotation = vec4(abc.xy, d, abc.z);
+        else vsg_Rotation = vec4(abc, d);
+    }
+#endif
+#if defined(VSG_INSTANCE_UNIFORM_SCALE)
+    vsg_Scale = vec3(vsg_UniformScale);
+#endif
+)";
+
+    for (auto& stage : shaderSet->stages)
+    {
+        if (stage->stage != VK_SHADER_STAGE_VERTEX_BIT || !stage->module) continue;
+
+        auto source = stage->module->source;
+        auto importPos = source.find(importDefines);
+        auto rotationPos = source.find(rotationDeclaration);
+        auto scalePos = source.find(scaleDeclaration);
+        auto mainPos = source.find(mainEntry);
+        if (importPos == std::string::npos || rotationPos == std::string::npos || scalePos == std::string::npos || mainPos == std::string::npos || scalePos < rotationPos || mainPos < scalePos)
+        {
+            warn("addCompactInstanceSupport(..) unable to find insertion points in vertex shader source, VSG_INSTANCE_ROTATION_PACKED and VSG_INSTANCE_UNIFORM_SCALE not supported.");
+            return shaderSet;
+        }
+
+        // insert from the end of the source backwards so the earlier positions remain valid
+        source.insert(mainPos + mainEntry.size(), instanceDecode);
+        source.replace(scalePos, scaleDeclaration.size(), uniformScaleDeclaration);
+        source.replace(rotationPos, rotationDeclaration.size(), packedRotationDeclaration);
+        source.insert(importPos + importDefines.size(), "VSG_INSTANCE_ROTATION_PACKED, VSG_INSTANCE_UNIFORM_SCALE, ");
+
+        // the precompiled variants remain valid as without the new defines the patched source is equivalent to the original
+        auto vertexShader = ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, stage->entryPointName, source, stage->module->hints);
+        vertexShader->specializationConstants = stage->specializationConstants;
+        stage = vertexShader;
+    }
+
+    shaderSet->addAttributeBinding("vsg_RotationPacked", "VSG_INSTANCE_ROTATION_PACKED", 8, VK_FORMAT_R32_UINT, uintArray::create(1));
+    shaderSet->addAttributeBinding("vsg_UniformScale", "VSG_INSTANCE_UNIFORM_SCALE", 9, VK_FORMAT_R32_SFLOAT, floatArray::create(1, 1.0f));
+    shaderSet->optionalDefines.insert("VSG_INSTANCE_ROTATION_PACKED");
+    shaderSet->optionalDefines.insert("VSG_INSTANCE_UNIFORM_SCALE");
+
+    return shaderSet;
+}
+
+static ref_ptr<ShaderSet> copyBuiltInShaderSet(const ShaderSet& builtIn)
+{
+    // the precompiled variants are shared with the built-in ShaderSet as they already hold their SPIR-V,
+    // the base stages are copied so that compiling them for one copy doesn't modify the others
+    auto shaderSet = ShaderSet::create(builtIn);
+    for (auto& stage : shaderSet->stages)
+    {
+        auto copiedStage = ShaderStage::create(*stage);
+        if (stage->module)
+        {
+            copiedStage->module = ShaderModule::create(stage->module->source, stage->module->hints);
+            copiedStage->module->code = stage->module->code;
+        }
+        stage = copiedStage;
+    }
+    return shaderSet;
+}
+
 ref_ptr<ShaderSet> vsg::createFlatShadedShaderSet(ref_ptr<const Options> options)
 {
     if (options)
@@ -459,7 +843,9 @@ ref_ptr<ShaderSet> vsg::createFlatShadedShaderSet(ref_ptr<const Options> options
         // check if a ShaderSet has already been assigned to the options object, if so return it
         if (auto itr = options->shaderSets.find("flat"); itr != options->shaderSets.end()) return itr->second;
     }
-    return flat_ShaderSet();
+    // decode the embedded ShaderSet on first use only, later requests copy it
+    static const ref_ptr<ShaderSet> s_shaderSet = addCompactInstanceSupport(addOctahedralNormalSupport(flat_ShaderSet()));
+    return copyBuiltInShaderSet(*s_shaderSet);
 }
 
 ref_ptr<ShaderSet> vsg::createPhongShaderSet(ref_ptr<const Options> options)
@@ -470,7 +856,9 @@ ref_ptr<ShaderSet> vsg::createPhongShaderSet(ref_ptr<const Options> options)
         if (auto itr = options->shaderSets.find("phong"); itr != options->shaderSets.end()) return itr->second;
     }
 
-    return phong_ShaderSet();
+    // decode the embedded ShaderSet on first use only, later requests copy it
+    static const ref_ptr<ShaderSet> s_shaderSet = addCompactInstanceSupport(addOctahedralNormalSupport(phong_ShaderSet()));
+    return copyBuiltInShaderSet(*s_shaderSet);
 }
 
 ref_ptr<ShaderSet> vsg::createPhysicsBasedRenderingShaderSet(ref_ptr<const Options> options)
@@ -481,7 +869,841 @@ ref_ptr<ShaderSet> vsg::createPhysicsBasedRenderingShaderSet(ref_ptr<const Optio
         if (auto itr = options->shaderSets.find("pbr"); itr != options->shaderSets.end()) return itr->second;
     }
 
-    return pbr_ShaderSet();
+    // decode the embedded ShaderSet on first use only, later requests copy it
+    static const ref_ptr<ShaderSet> s_shaderSet = addCompactInstanceSupport(addOctahedralNormalSupport(pbr_ShaderSet()));
+    return copyBuiltInShaderSet(*s_shaderSet);
+}
+
+ref_ptr<ShaderSet> vsg::createBindlessFlatShadedShaderSet(ref_ptr<BindlessDescriptors> bindlessDescriptors, ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("bindless_flat"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    const char* vertexSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+#pragma import_defines (VSG_TEXTURECOORD_0)
+
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelView;
+    uint materialIndex;
+} pc;
+
+layout(location = 0) in vec3 vsg_Vertex;
+layout(location = 6) in vec4 vsg_Color;
+
+#ifdef VSG_TEXTURECOORD_0
+layout(location = 2) in vec2 vsg_TexCoord0;
+#endif
+
+layout(location = 0) out vec4 vertexColor;
+layout(location = 1) out vec2 texCoord0;
+layout(location = 2) flat out uint materialIndex;
+
+out gl_PerVertex{ vec4 gl_Position; };
+
+void main()
+{
+    gl_Position = (pc.projection * pc.modelView) * vec4(vsg_Vertex, 1.0);
+    vertexColor = vsg_Color;
+#ifdef VSG_TEXTURECOORD_0
+    texCoord0 = vsg_TexCoord0;
+#else
+    texCoord0 = vec2(0.0, 0.0);
+#endif
+    materialIndex = pc.materialIndex;
+}
+)";
+
+    const char* fragmentSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_EXT_nonuniform_qualifier : enable
+
+#pragma import_defines (VSG_TEXTURECOORD_0)
+
+struct BindlessMaterial
+{
+    vec4 baseColorFactor;
+    int diffuseMap;
+    float alphaMask;
+    float alphaMaskCutoff;
+    int padding;
+};
+
+layout(set = 0, binding = 0) uniform sampler2D textures[];
+layout(set = 0, binding = 1) readonly buffer Materials
+{
+    BindlessMaterial materials[];
+};
+
+layout(location = 0) in vec4 vertexColor;
+layout(location = 1) in vec2 texCoord0;
+layout(location = 2) flat in uint materialIndex;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    BindlessMaterial material = materials[materialIndex];
+    vec4 diffuseColor = vertexColor * material.baseColorFactor;
+
+#ifdef VSG_TEXTURECOORD_0
+    if (material.diffuseMap >= 0) diffuseColor *= texture(textures[nonuniformEXT(material.diffuseMap)], texCoord0.st);
+#endif
+
+    if (material.alphaMask == 1.0f && diffuseColor.a < material.alphaMaskCutoff) discard;
+
+    outColor = diffuseColor;
+}
+)";
+
+    auto vertexShader = ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, "main", vertexSource);
+    auto fragmentShader = ShaderStage::create(VK_SHADER_STAGE_FRAGMENT_BIT, "main", fragmentSource);
+
+    auto shaderSet = ShaderSet::create(ShaderStages{vertexShader, fragmentShader});
+
+    shaderSet->addAttributeBinding("vsg_Vertex", "", 0, VK_FORMAT_R32G32B32_SFLOAT, vec3Array::create(1));
+    shaderSet->addAttributeBinding("vsg_TexCoord0", "VSG_TEXTURECOORD_0", 2, VK_FORMAT_R32G32_SFLOAT, vec2Array::create(1));
+    shaderSet->addAttributeBinding("vsg_Color", "", 6, VK_FORMAT_R32G32B32A32_SFLOAT, vec4Array::create(1, vec4(1.0f, 1.0f, 1.0f, 1.0f)));
+
+    uint32_t maxTextures = bindlessDescriptors ? bindlessDescriptors->maxTextures : 4096;
+    uint32_t textureBinding = bindlessDescriptors ? bindlessDescriptors->textureBinding : 0;
+    uint32_t materialBinding = bindlessDescriptors ? bindlessDescriptors->materialBinding : 1;
+    shaderSet->addDescriptorBinding("textures", "", 0, textureBinding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, maxTextures, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, {});
+    shaderSet->addDescriptorBinding("materials", "", 0, materialBinding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, {});
+
+    shaderSet->addPushConstantRange("pc", "", VK_SHADER_STAGE_VERTEX_BIT, 0, 132);
+
+    shaderSet->customDescriptorSetBindings.push_back(BindlessDescriptorSetBinding::create(0, bindlessDescriptors));
+
+    return shaderSet;
+}
+
+static ref_ptr<ShaderSet> createMeshletShaderSet(ref_ptr<ShaderSet> baseShaderSet)
+{
+    const char* taskSource = R"(#version 460
+#extension GL_EXT_mesh_shader : require
+
+#pragma import_defines (VSG_TWO_SIDED_LIGHTING)
+
+#define MESHLET_DESCRIPTOR_SET 2
+#define TASK_WORKGROUP_SIZE 32
+
+layout(local_size_x = TASK_WORKGROUP_SIZE) in;
+
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelView;
+} pc;
+
+struct Meshlet
+{
+    vec4 sphere;
+    vec4 cone;
+    uint vertexOffset;
+    uint vertexCount;
+    uint triangleOffset;
+    uint triangleCount;
+};
+
+layout(set = MESHLET_DESCRIPTOR_SET, binding = 4) readonly buffer Meshlets
+{
+    Meshlet meshlets[];
+};
+
+struct Task
+{
+    uint meshletIndices[TASK_WORKGROUP_SIZE];
+};
+
+taskPayloadSharedEXT Task payload;
+
+shared uint numVisible;
+
+bool visible(Meshlet meshlet)
+{
+    float scale = max(length(pc.modelView[0].xyz), max(length(pc.modelView[1].xyz), length(pc.modelView[2].xyz)));
+    vec3 center = (pc.modelView * vec4(meshlet.sphere.xyz, 1.0)).xyz;
+    float radius = meshlet.sphere.w * scale;
+
+    // left, right, bottom and top planes extracted from the projection matrix, in eye coordinates
+    mat4 p = transpose(pc.projection);
+    vec4 planes[4] = vec4[4](p[3] + p[0], p[3] - p[0], p[3] + p[1], p[3] - p[1]);
+    for (int i = 0; i < 4; ++i)
+    {
+        vec4 plane = planes[i] / length(planes[i].xyz);
+        if (dot(plane.xyz, center) + plane.w < -radius) return false;
+    }
+
+#ifndef VSG_TWO_SIDED_LIGHTING
+    // backface cone test, the eye point is at the origin in eye coordinates
+    vec3 axis = normalize(mat3(pc.modelView) * meshlet.cone.xyz);
+    if (meshlet.cone.w < 1.0 && dot(center, axis) >= meshlet.cone.w * length(center) + radius) return false;
+#endif
+
+    return true;
+}
+
+void main()
+{
+    if (gl_LocalInvocationIndex == 0) numVisible = 0;
+    barrier();
+
+    uint meshletIndex = gl_GlobalInvocationID.x;
+    if (meshletIndex < meshlets.length() && visible(meshlets[meshletIndex]))
+    {
+        uint index = atomicAdd(numVisible, 1);
+        payload.meshletIndices[index] = meshletIndex;
+    }
+    barrier();
+
+    EmitMeshTasksEXT(numVisible, 1, 1);
+}
+)";
+
+    const char* meshSource = R"(#version 460
+#extension GL_EXT_mesh_shader : require
+
+#pragma import_defines (VSG_TEXTURECOORD_0, VSG_MESHLET_COLORS)
+
+#define MESHLET_DESCRIPTOR_SET 2
+#define TASK_WORKGROUP_SIZE 32
+#define MESH_WORKGROUP_SIZE 32
+
+layout(local_size_x = MESH_WORKGROUP_SIZE) in;
+layout(triangles, max_vertices = 64, max_primitives = 124) out;
+
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelView;
+} pc;
+
+struct Meshlet
+{
+    vec4 sphere;
+    vec4 cone;
+    uint vertexOffset;
+    uint vertexCount;
+    uint triangleOffset;
+    uint triangleCount;
+};
+
+layout(set = MESHLET_DESCRIPTOR_SET, binding = 0) readonly buffer Vertices { float vertices[]; };
+layout(set = MESHLET_DESCRIPTOR_SET, binding = 1) readonly buffer Normals { float normals[]; };
+#ifdef VSG_TEXTURECOORD_0
+layout(set = MESHLET_DESCRIPTOR_SET, binding = 2) readonly buffer TexCoords { vec2 texCoords[]; };
+#endif
+#ifdef VSG_MESHLET_COLORS
+layout(set = MESHLET_DESCRIPTOR_SET, binding = 3) readonly buffer Colors { vec4 colors[]; };
+#endif
+layout(set = MESHLET_DESCRIPTOR_SET, binding = 4) readonly buffer Meshlets { Meshlet meshlets[]; };
+layout(set = MESHLET_DESCRIPTOR_SET, binding = 5) readonly buffer MeshletVertices { uint meshletVertices[]; };
+layout(set = MESHLET_DESCRIPTOR_SET, binding = 6) readonly buffer MeshletTriangles { uint meshletTriangles[]; };
+
+struct Task
+{
+    uint meshletIndices[TASK_WORKGROUP_SIZE];
+};
+
+taskPayloadSharedEXT Task payload;
+
+layout(location = 0) out vec3 eyePos[];
+layout(location = 1) out vec3 normalDir[];
+layout(location = 2) out vec4 vertexColor[];
+layout(location = 3) out vec3 viewDir[];
+layout(location = 4) out vec2 texCoord[][1];
+
+void main()
+{
+    Meshlet meshlet = meshlets[payload.meshletIndices[gl_WorkGroupID.x]];
+
+    SetMeshOutputsEXT(meshlet.vertexCount, meshlet.triangleCount);
+
+    mat4 mv = pc.modelView;
+    for (uint i = gl_LocalInvocationIndex; i < meshlet.vertexCount; i += MESH_WORKGROUP_SIZE)
+    {
+        uint v = meshletVertices[meshlet.vertexOffset + i];
+        vec4 vertex = vec4(vertices[v * 3], vertices[v * 3 + 1], vertices[v * 3 + 2], 1.0);
+        vec4 normal = vec4(normals[v * 3], normals[v * 3 + 1], normals[v * 3 + 2], 0.0);
+
+        gl_MeshVerticesEXT[i].gl_Position = (pc.projection * mv) * vertex;
+        eyePos[i] = (mv * vertex).xyz;
+        viewDir[i] = - (mv * vertex).xyz;
+        normalDir[i] = (mv * normal).xyz;
+
+#ifdef VSG_MESHLET_COLORS
+        vertexColor[i] = colors[v];
+#else
+        vertexColor[i] = vec4(1.0, 1.0, 1.0, 1.0);
+#endif
+
+#ifdef VSG_TEXTURECOORD_0
+        texCoord[i][0] = texCoords[v];
+#else
+        texCoord[i][0] = vec2(0.0, 0.0);
+#endif
+    }
+
+    for (uint i = gl_LocalInvocationIndex; i < meshlet.triangleCount; i += MESH_WORKGROUP_SIZE)
+    {
+        uint packed = meshletTriangles[meshlet.triangleOffset + i];
+        gl_PrimitiveTriangleIndicesEXT[i] = uvec3(packed & 0xff, (packed >> 8) & 0xff, (packed >> 16) & 0xff);
+    }
+}
+)";
+
+    // mesh shaders require SPIR-V 1.4
+    auto hints = ShaderCompileSettings::create();
+    hints->vulkanVersion = VK_API_VERSION_1_3;
+    hints->target = ShaderCompileSettings::SPIRV_1_4;
+
+    ShaderStages stages{ShaderStage::create(VK_SHADER_STAGE_TASK_BIT_EXT, "main", taskSource),
+                        ShaderStage::create(VK_SHADER_STAGE_MESH_BIT_EXT, "main", meshSource)};
+
+    // reuse the fragment shader of the base ShaderSet, the mesh shader provides the same outputs as the base vertex shader.
+    for (auto& stage : baseShaderSet->stages)
+    {
+        if (stage->stage == VK_SHADER_STAGE_FRAGMENT_BIT) stages.push_back(stage);
+    }
+
+    auto shaderSet = ShaderSet::create(stages, hints);
+    shaderSet->descriptorBindings = baseShaderSet->descriptorBindings;
+    shaderSet->customDescriptorSetBindings = baseShaderSet->customDescriptorSetBindings;
+    shaderSet->optionalDefines = baseShaderSet->optionalDefines;
+    shaderSet->defaultGraphicsPipelineStates = baseShaderSet->defaultGraphicsPipelineStates;
+
+    const VkShaderStageFlags meshletStages = VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT;
+    for (auto pushConstantRange : baseShaderSet->pushConstantRanges)
+    {
+        pushConstantRange.range.stageFlags |= meshletStages;
+        shaderSet->pushConstantRanges.push_back(pushConstantRange);
+    }
+
+    const uint32_t meshletSet = 2;
+    shaderSet->addDescriptorBinding("vsg_Vertices", "", meshletSet, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, vec3Array::create(1));
+    shaderSet->addDescriptorBinding("vsg_Normals", "", meshletSet, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, vec3Array::create(1, vec3(0.0f, 0.0f, 1.0f)));
+    shaderSet->addDescriptorBinding("vsg_TexCoords0", "VSG_TEXTURECOORD_0", meshletSet, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, vec2Array::create(1));
+    shaderSet->addDescriptorBinding("vsg_Colors", "VSG_MESHLET_COLORS", meshletSet, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, vec4Array::create(1, vec4(1.0f, 1.0f, 1.0f, 1.0f)));
+    shaderSet->addDescriptorBinding("vsg_Meshlets", "", meshletSet, 4, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, meshletStages, MeshletArray::create(1));
+    shaderSet->addDescriptorBinding("vsg_MeshletVertices", "", meshletSet, 5, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, uintArray::create(1));
+    shaderSet->addDescriptorBinding("vsg_MeshletTriangles", "", meshletSet, 6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_MESH_BIT_EXT, uintArray::create(1));
+
+    return shaderSet;
+}
+
+ref_ptr<ShaderSet> vsg::createPhongMeshletShaderSet(ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("phong_meshlet"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    return createMeshletShaderSet(createPhongShaderSet(options));
+}
+
+ref_ptr<ShaderSet> vsg::createPhysicsBasedRenderingMeshletShaderSet(ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("pbr_meshlet"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    return createMeshletShaderSet(createPhysicsBasedRenderingShaderSet(options));
+}
+
+ref_ptr<ShaderSet> vsg::createTessellatedTerrainShaderSet(ref_ptr<ShaderSet> baseShaderSet, float pixelsPerEdge, float maxTessellationLevel)
+{
+    const char* vertexSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+#define VIEW_DESCRIPTOR_SET 0
+
+layout(set = VIEW_DESCRIPTOR_SET, binding = 1) readonly buffer ViewportData
+{
+    vec4 values[];
+} viewportData;
+
+layout(location = 0) in vec3 vsg_Vertex;
+layout(location = 1) in vec3 vsg_Normal;
+layout(location = 2) in vec2 vsg_TexCoord0;
+layout(location = 6) in vec4 vsg_Color;
+
+layout(location = 0) out vec3 patchVertex;
+layout(location = 1) out vec3 patchNormal;
+layout(location = 2) out vec2 patchTexCoord;
+layout(location = 3) out vec4 patchColor;
+layout(location = 4) out float viewportHeight;
+
+void main()
+{
+    patchVertex = vsg_Vertex;
+    patchNormal = vsg_Normal;
+    patchTexCoord = vsg_TexCoord0;
+    patchColor = vsg_Color;
+    viewportHeight = viewportData.values[0].w;
+}
+)";
+
+    const char* tessellationControlSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+#pragma import_defines (VSG_DISPLACEMENT_MAP)
+
+#define MATERIAL_DESCRIPTOR_SET 1
+
+layout(vertices = 4) out;
+
+layout(constant_id = 0) const float pixelsPerEdge = 16.0;
+layout(constant_id = 1) const float maxTessellationLevel = 64.0;
+
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelView;
+} pc;
+
+#ifdef VSG_DISPLACEMENT_MAP
+layout(set = MATERIAL_DESCRIPTOR_SET, binding = 7) uniform sampler2D displacementMap;
+#endif
+
+layout(location = 0) in vec3 patchVertex[];
+layout(location = 1) in vec3 patchNormal[];
+layout(location = 2) in vec2 patchTexCoord[];
+layout(location = 3) in vec4 patchColor[];
+layout(location = 4) in float viewportHeight[];
+
+layout(location = 0) out vec3 controlVertex[];
+layout(location = 1) out vec3 controlNormal[];
+layout(location = 2) out vec2 controlTexCoord[];
+layout(location = 3) out vec4 controlColor[];
+
+// the level of an edge only depends on its end points so that the patches either side of it subdivide it identically
+float edgeLevel(int i0, int i1)
+{
+    vec4 v0 = pc.modelView * vec4(patchVertex[i0], 1.0);
+    vec4 v1 = pc.modelView * vec4(patchVertex[i1], 1.0);
+
+    // clip space w of the edge center, -z for perspective and 1.0 for orthographic projections
+    vec4 center = (v0 + v1) * 0.5;
+    float w = dot(vec4(pc.projection[0][3], pc.projection[1][3], pc.projection[2][3], pc.projection[3][3]), center);
+
+    float maxLevel = maxTessellationLevel;
+#ifdef VSG_DISPLACEMENT_MAP
+    // subdividing beyond the resolution of the elevation data adds no detail
+    vec2 texels = abs(patchTexCoord[i1] - patchTexCoord[i0]) * vec2(textureSize(displacementMap, 0));
+    maxLevel = clamp(max(texels.x, texels.y), 1.0, maxTessellationLevel);
+#endif
+
+    if (w <= 0.0) return maxLevel;
+
+    float pixels = distance(v0.xyz, v1.xyz) * abs(pc.projection[1][1]) * 0.5 * viewportHeight[0] / w;
+    return clamp(pixels / pixelsPerEdge, 1.0, maxLevel);
+}
+
+void main()
+{
+    controlVertex[gl_InvocationID] = patchVertex[gl_InvocationID];
+    controlNormal[gl_InvocationID] = patchNormal[gl_InvocationID];
+    controlTexCoord[gl_InvocationID] = patchTexCoord[gl_InvocationID];
+    controlColor[gl_InvocationID] = patchColor[gl_InvocationID];
+
+    if (gl_InvocationID == 0)
+    {
+        // outer levels of the u=0, v=0, u=1 and v=1 edges of the quad with corners ordered (0,0), (1,0), (1,1), (0,1)
+        gl_TessLevelOuter[0] = edgeLevel(3, 0);
+        gl_TessLevelOuter[1] = edgeLevel(0, 1);
+        gl_TessLevelOuter[2] = edgeLevel(1, 2);
+        gl_TessLevelOuter[3] = edgeLevel(2, 3);
+
+        gl_TessLevelInner[0] = max(gl_TessLevelOuter[1], gl_TessLevelOuter[3]);
+        gl_TessLevelInner[1] = max(gl_TessLevelOuter[0], gl_TessLevelOuter[2]);
+    }
+}
+)";
+
+    const char* tessellationEvaluationSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+#pragma import_defines (VSG_DISPLACEMENT_MAP)
+
+#define MATERIAL_DESCRIPTOR_SET 1
+
+// Vulkan's tessellation domain origin is the upper left, so cw generates triangles that are counter clockwise when u and v map to the patches' x and y axes
+layout(quads, fractional_odd_spacing, cw) in;
+
+layout(push_constant) uniform PushConstants {
+    mat4 projection;
+    mat4 modelView;
+} pc;
+
+#ifdef VSG_DISPLACEMENT_MAP
+layout(set = MATERIAL_DESCRIPTOR_SET, binding = 7) uniform sampler2D displacementMap;
+layout(set = MATERIAL_DESCRIPTOR_SET, binding = 8) uniform DisplacementMapScale
+{
+    vec3 value;
+} displacementMapScale;
+#endif
+
+layout(location = 0) in vec3 controlVertex[];
+layout(location = 1) in vec3 controlNormal[];
+layout(location = 2) in vec2 controlTexCoord[];
+layout(location = 3) in vec4 controlColor[];
+
+layout(location = 0) out vec3 eyePos;
+layout(location = 1) out vec3 normalDir;
+layout(location = 2) out vec4 vertexColor;
+layout(location = 3) out vec3 viewDir;
+layout(location = 4) out vec2 texCoord[1];
+
+out gl_PerVertex{
+    vec4 gl_Position;
+};
+
+void main()
+{
+    vec2 uv = gl_TessCoord.xy;
+
+    vec4 vertex = vec4(mix(mix(controlVertex[0], controlVertex[1], uv.x), mix(controlVertex[3], controlVertex[2], uv.x), uv.y), 1.0);
+    vec3 interpolatedNormal = normalize(mix(mix(controlNormal[0], controlNormal[1], uv.x), mix(controlNormal[3], controlNormal[2], uv.x), uv.y));
+    vec4 normal = vec4(interpolatedNormal, 0.0);
+    vec2 tc = mix(mix(controlTexCoord[0], controlTexCoord[1], uv.x), mix(controlTexCoord[3], controlTexCoord[2], uv.x), uv.y);
+
+#ifdef VSG_DISPLACEMENT_MAP
+    vec3 scale = displacementMapScale.value;
+
+    vertex.xyz = vertex.xyz + interpolatedNormal * (texture(displacementMap, tc.st).s * scale.z);
+
+    float s_delta = 0.01;
+
+    float s_left = max(tc.s - s_delta, 0.0);
+    float s_right = min(tc.s + s_delta, 1.0);
+    float delta_left_right = (s_right - s_left) * scale.x;
+    float dz_left_right = (texture(displacementMap, vec2(s_right, tc.t)).s - texture(displacementMap, vec2(s_left, tc.t)).s) * scale.z;
+
+    float t_delta = s_delta;
+    float t_bottom = max(tc.t - t_delta, 0.0);
+    float t_top = min(tc.t + t_delta, 1.0);
+    float delta_bottom_top = (t_top - t_bottom) * scale.y;
+    float dz_bottom_top = (texture(displacementMap, vec2(tc.s, t_top)).s - texture(displacementMap, vec2(tc.s, t_bottom)).s) * scale.z;
+
+    vec3 dx = normalize(vec3(delta_left_right, 0.0, dz_left_right));
+    vec3 dy = normalize(vec3(0.0, delta_bottom_top, -dz_bottom_top));
+    vec3 dz = normalize(cross(dx, dy));
+
+    normal.xyz = normalize(dx * interpolatedNormal.x + dy * interpolatedNormal.y + dz * interpolatedNormal.z);
+#endif
+
+    gl_Position = (pc.projection * pc.modelView) * vertex;
+    eyePos = (pc.modelView * vertex).xyz;
+    viewDir = - (pc.modelView * vertex).xyz;
+    normalDir = (pc.modelView * normal).xyz;
+
+    vertexColor = mix(mix(controlColor[0], controlColor[1], uv.x), mix(controlColor[3], controlColor[2], uv.x), uv.y);
+    texCoord[0] = tc;
+}
+)";
+
+    auto tessellationControlShader = ShaderStage::create(VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT, "main", tessellationControlSource);
+    tessellationControlShader->specializationConstants = {{0, floatValue::create(pixelsPerEdge)}, {1, floatValue::create(maxTessellationLevel)}};
+
+    ShaderStages stages{ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, "main", vertexSource),
+                        tessellationControlShader,
+                        ShaderStage::create(VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT, "main", tessellationEvaluationSource)};
+
+    // reuse the fragment shader of the base ShaderSet, the tessellation evaluation shader provides the same outputs as the base vertex shader.
+    for (auto& stage : baseShaderSet->stages)
+    {
+        if (stage->stage == VK_SHADER_STAGE_FRAGMENT_BIT) stages.push_back(stage);
+    }
+
+    auto shaderSet = ShaderSet::create(stages, baseShaderSet->defaultShaderHints);
+    shaderSet->attributeBindings = baseShaderSet->attributeBindings;
+    shaderSet->definesArrayStates = baseShaderSet->definesArrayStates;
+    shaderSet->optionalDefines = baseShaderSet->optionalDefines;
+    shaderSet->customDescriptorSetBindings = baseShaderSet->customDescriptorSetBindings;
+
+    // the displacement map is sampled when tessellating rather than by the vertex shader
+    const VkShaderStageFlags tessellationStages = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+    for (auto descriptorBinding : baseShaderSet->descriptorBindings)
+    {
+        if (descriptorBinding.name == "displacementMap" || descriptorBinding.name == "displacementMapScale") descriptorBinding.stageFlags |= tessellationStages;
+        shaderSet->descriptorBindings.push_back(descriptorBinding);
+    }
+
+    for (auto pushConstantRange : baseShaderSet->pushConstantRanges)
+    {
+        pushConstantRange.range.stageFlags |= tessellationStages;
+        shaderSet->pushConstantRanges.push_back(pushConstantRange);
+    }
+
+    for (auto& pipelineState : baseShaderSet->defaultGraphicsPipelineStates)
+    {
+        if (!pipelineState->is_compatible(typeid(InputAssemblyState)) && !pipelineState->is_compatible(typeid(TessellationState))) shaderSet->defaultGraphicsPipelineStates.push_back(pipelineState);
+    }
+    shaderSet->defaultGraphicsPipelineStates.push_back(InputAssemblyState::create(VK_PRIMITIVE_TOPOLOGY_PATCH_LIST));
+    shaderSet->defaultGraphicsPipelineStates.push_back(TessellationState::create(4));
+
+    return shaderSet;
+}
+
+static ref_ptr<ShaderSet> createClusteredLightingShaderSet(ref_ptr<ShaderSet> baseShaderSet, const std::string& insertBefore, const std::string& clusteredLightingSource)
+{
+    // declarations of the view descriptor set bindings assigned by ViewDependentState when the View's features include CLUSTERED_LIGHTING
+    const std::string clusterDeclarations = R"(
+layout(set = VIEW_DESCRIPTOR_SET, binding = 5) uniform ClusterSettings
+{
+    vec4 depthRange; // near, far, log(far/near), numLights
+    vec4 dimensions; // x, y and z cluster counts, maxLightsPerCluster
+    vec4 viewport;
+    mat4 clipToEye;
+} clusterSettings;
+
+layout(set = VIEW_DESCRIPTOR_SET, binding = 6) readonly buffer ClusterLights { vec4 clusterLights[]; };
+layout(set = VIEW_DESCRIPTOR_SET, binding = 7) readonly buffer ClusterLightCounts { uint clusterLightCounts[]; };
+layout(set = VIEW_DESCRIPTOR_SET, binding = 8) readonly buffer ClusterLightIndices { uint clusterLightIndices[]; };
+
+uint clusterIndex()
+{
+    vec3 dims = clusterSettings.dimensions.xyz;
+    vec2 tile = (gl_FragCoord.xy - clusterSettings.viewport.xy) / clusterSettings.viewport.zw;
+    float slice = log(max(-eyePos.z, clusterSettings.depthRange.x) / clusterSettings.depthRange.x) / clusterSettings.depthRange.z;
+    uvec3 cluster = uvec3(clamp(vec3(tile, slice) * dims, vec3(0.0), dims - vec3(1.0)));
+    return cluster.x + uint(dims.x) * (cluster.y + uint(dims.y) * cluster.z);
+}
+)";
+
+    const std::string lightDataDeclaration = "} lightData;\n";
+
+    ShaderStages stages;
+    for (auto& stage : baseShaderSet->stages)
+    {
+        if (stage->stage != VK_SHADER_STAGE_FRAGMENT_BIT || !stage->module)
+        {
+            stages.push_back(stage);
+            continue;
+        }
+
+        // derive the fragment shader from the base ShaderSet's, with the clustered light loop inserted after the lightData driven lighting
+        std::string source = stage->module->source;
+        auto declarationPos = source.find(lightDataDeclaration);
+        auto insertPos = source.rfind(insertBefore);
+        if (declarationPos == std::string::npos || insertPos == std::string::npos || insertPos < declarationPos)
+        {
+            warn("createClusteredLightingShaderSet(..) unable to find insertion points in fragment shader source, clustered lighting not enabled.");
+            return baseShaderSet;
+        }
+
+        source.insert(insertPos, clusteredLightingSource);
+        source.insert(declarationPos + lightDataDeclaration.size(), clusterDeclarations);
+
+        auto fragmentShader = ShaderStage::create(VK_SHADER_STAGE_FRAGMENT_BIT, stage->entryPointName, source, stage->module->hints);
+        fragmentShader->specializationConstants = stage->specializationConstants;
+        stages.push_back(fragmentShader);
+    }
+
+    // precompiled variants of the base ShaderSet aren't copied as they don't contain the clustered lighting
+    auto shaderSet = ShaderSet::create(stages, baseShaderSet->defaultShaderHints);
+    shaderSet->attributeBindings = baseShaderSet->attributeBindings;
+    shaderSet->descriptorBindings = baseShaderSet->descriptorBindings;
+    shaderSet->pushConstantRanges = baseShaderSet->pushConstantRanges;
+    shaderSet->definesArrayStates = baseShaderSet->definesArrayStates;
+    shaderSet->optionalDefines = baseShaderSet->optionalDefines;
+    shaderSet->defaultGraphicsPipelineStates = baseShaderSet->defaultGraphicsPipelineStates;
+    shaderSet->customDescriptorSetBindings = baseShaderSet->customDescriptorSetBindings;
+
+    const uint32_t viewSet = 0;
+    shaderSet->addDescriptorBinding("clusterSettings", "", viewSet, 5, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, vec4Array::create(7));
+    shaderSet->addDescriptorBinding("clusterLights", "", viewSet, 6, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, vec4Array::create(3));
+    shaderSet->addDescriptorBinding("clusterLightCounts", "", viewSet, 7, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, uintArray::create(1));
+    shaderSet->addDescriptorBinding("clusterLightIndices", "", viewSet, 8, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, uintArray::create(1));
+
+    return shaderSet;
+}
+
+ref_ptr<ShaderSet> vsg::createPhongClusteredLightingShaderSet(ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("phong_clustered"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    const char* clusteredLightingSource = R"(
+    {
+        // clustered point and spot lights
+        uint cluster = clusterIndex();
+        uint maxLightsPerCluster = uint(clusterSettings.dimensions.w);
+        uint numClusterLights = min(clusterLightCounts[cluster], maxLightsPerCluster);
+        for(uint i = 0; i<numClusterLights; ++i)
+        {
+            uint lightIndex = clusterLightIndices[cluster * maxLightsPerCluster + i] * 3;
+            vec4 lightColor = clusterLights[lightIndex];
+            vec4 position_cosInnerAngle = clusterLights[lightIndex+1];
+            vec4 lightDirection_cosOuterAngle = clusterLights[lightIndex+2];
+
+            vec3 delta = position_cosInnerAngle.xyz - eyePos;
+            float distance2 = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+            vec3 direction = delta / sqrt(distance2);
+
+            float dot_lightdirection = dot(lightDirection_cosOuterAngle.xyz, -direction);
+            float scale = (lightColor.a * smoothstep(lightDirection_cosOuterAngle.w, position_cosInnerAngle.w, dot_lightdirection)) / distance2;
+
+            float unclamped_LdotN = dot(direction, nd);
+
+            float diff = scale * max(unclamped_LdotN, 0.0);
+            color.rgb += (diffuseColor.rgb * lightColor.rgb) * diff;
+            if (shininess > 0.0 && diff > 0.0)
+            {
+                vec3 halfDir = normalize(direction + vd);
+                color.rgb += specularColor.rgb * (pow(max(dot(halfDir, nd), 0.0), shininess) * scale);
+            }
+        }
+    }
+
+)";
+
+    return createClusteredLightingShaderSet(createPhongShaderSet(options), "    outColor.rgb = ", clusteredLightingSource);
+}
+
+ref_ptr<ShaderSet> vsg::createPhysicsBasedRenderingClusteredLightingShaderSet(ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("pbr_clustered"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    const char* clusteredLightingSource = R"(
+    {
+        // clustered point and spot lights
+        uint cluster = clusterIndex();
+        uint maxLightsPerCluster = uint(clusterSettings.dimensions.w);
+        uint numClusterLights = min(clusterLightCounts[cluster], maxLightsPerCluster);
+        for(uint i = 0; i<numClusterLights; ++i)
+        {
+            uint lightIndex = clusterLightIndices[cluster * maxLightsPerCluster + i] * 3;
+            vec4 lightColor = clusterLights[lightIndex];
+            vec4 position_cosInnerAngle = clusterLights[lightIndex+1];
+            vec4 lightDirection_cosOuterAngle = clusterLights[lightIndex+2];
+
+            vec3 delta = position_cosInnerAngle.xyz - eyePos;
+            float distance2 = delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+            vec3 direction = delta / sqrt(distance2);
+
+            float dot_lightdirection = dot(lightDirection_cosOuterAngle.xyz, -direction);
+
+            vec3 l = direction;         // Vector from surface point to light
+            vec3 h = normalize(l+v);    // Half vector between both l and v
+            float scale = (lightColor.a * smoothstep(lightDirection_cosOuterAngle.w, position_cosInnerAngle.w, dot_lightdirection)) / distance2;
+
+            color.rgb += BRDF(lightColor.rgb * scale, v, n, l, h, perceptualRoughness, metallic, specularEnvironmentR0, specularEnvironmentR90, alphaRoughness, diffuseColor, specularColor, ambientOcclusion);
+        }
+    }
+
+)";
+
+    return createClusteredLightingShaderSet(createPhysicsBasedRenderingShaderSet(options), "#ifdef VSG_EMISSIVE_MAP\n    vec3 emissive", clusteredLightingSource);
+}
+
+ref_ptr<ShaderSet> vsg::createRayTracedShadowsShaderSet(ref_ptr<ShaderSet> baseShaderSet)
+{
+    // declarations of the view descriptor set bindings assigned by ViewDependentState when its shadowAccelerationStructure is assigned
+    const std::string rayTracedShadowDeclarations = R"(
+layout(set = VIEW_DESCRIPTOR_SET, binding = 9) uniform RayTracedShadowSettings
+{
+    mat4 eyeToWorld;
+} rayTracedShadowSettings;
+
+layout(set = VIEW_DESCRIPTOR_SET, binding = 10) uniform accelerationStructureEXT shadowAccelerationStructure;
+
+float rayTracedShadowCoverage(vec3 direction, float rayOffset, float maxDistance)
+{
+    vec3 origin = (rayTracedShadowSettings.eyeToWorld * vec4(eyePos, 1.0)).xyz;
+    vec3 worldDirection = normalize(mat3(rayTracedShadowSettings.eyeToWorld) * direction);
+
+    rayQueryEXT rayQuery;
+    rayQueryInitializeEXT(rayQuery, shadowAccelerationStructure, gl_RayFlagsOpaqueEXT | gl_RayFlagsTerminateOnFirstHitEXT, 0xFF, origin, rayOffset, worldDirection, maxDistance);
+    while (rayQueryProceedEXT(rayQuery)) {}
+
+    return (rayQueryGetIntersectionTypeEXT(rayQuery, true) != gl_RayQueryCommittedIntersectionNoneEXT) ? 1.0 : 0.0;
+}
+)";
+
+    // lights without shadow maps have a single shadow settings entry, its alpha is non zero for RayTracedShadows
+    const std::string unshadowedLight = "            else\n                lightDataIndex++;\n";
+    const std::string rayTracedDirectionalLight = R"(            else
+            {
+                vec4 shadowSettings = lightData.values[lightDataIndex++];
+                if (shadowSettings.a > 0.0 && intensity >= intensityMinimum)
+                    intensity *= (1.0 - rayTracedShadowCoverage(direction, shadowSettings.g, shadowSettings.b));
+            }
+)";
+    const std::string rayTracedSpotLight = R"(            else
+            {
+                vec4 shadowSettings = lightData.values[lightDataIndex++];
+                if (shadowSettings.a > 0.0 && dot_lightdirection > lightDirection_cosOuterAngle.w)
+                    intensity *= (1.0 - rayTracedShadowCoverage(direction, shadowSettings.g, max(dist - shadowSettings.g, shadowSettings.g)));
+            }
+)";
+
+    const std::string lightDataDeclaration = "} lightData;\n";
+    const std::string versionDeclaration = "#version 450\n";
+
+    ShaderStages stages;
+    for (auto& stage : baseShaderSet->stages)
+    {
+        if (stage->stage != VK_SHADER_STAGE_FRAGMENT_BIT || !stage->module)
+        {
+            stages.push_back(stage);
+            continue;
+        }
+
+        // derive the fragment shader from the base ShaderSet's, the directional light loop precedes the spot light loop
+        std::string source = stage->module->source;
+        auto directionalPos = source.find(unshadowedLight);
+        auto spotPos = (directionalPos != std::string::npos) ? source.find(unshadowedLight, directionalPos + unshadowedLight.size()) : std::string::npos;
+        auto declarationPos = source.find(lightDataDeclaration);
+        if (source.compare(0, versionDeclaration.size(), versionDeclaration) != 0 || spotPos == std::string::npos || declarationPos == std::string::npos || directionalPos < declarationPos)
+        {
+            warn("createRayTracedShadowsShaderSet(..) unable to find insertion points in fragment shader source, ray traced shadows not enabled.");
+            return baseShaderSet;
+        }
+
+        source.replace(spotPos, unshadowedLight.size(), rayTracedSpotLight);
+        source.replace(directionalPos, unshadowedLight.size(), rayTracedDirectionalLight);
+        source.insert(declarationPos + lightDataDeclaration.size(), rayTracedShadowDeclarations);
+        source.replace(0, versionDeclaration.size(), "#version 460\n#extension GL_EXT_ray_query : require\n");
+
+        auto fragmentShader = ShaderStage::create(VK_SHADER_STAGE_FRAGMENT_BIT, stage->entryPointName, source, stage->module->hints);
+        fragmentShader->specializationConstants = stage->specializationConstants;
+        stages.push_back(fragmentShader);
+    }
+
+    // ray queries require GLSL 4.60 and SPIR-V 1.4
+    auto hints = baseShaderSet->defaultShaderHints ? ShaderCompileSettings::create(*baseShaderSet->defaultShaderHints) : ShaderCompileSettings::create();
+    hints->vulkanVersion = std::max(hints->vulkanVersion, static_cast<uint32_t>(VK_API_VERSION_1_2));
+    if (hints->target < ShaderCompileSettings::SPIRV_1_4) hints->target = ShaderCompileSettings::SPIRV_1_4;
+
+    // precompiled variants of the base ShaderSet aren't copied as they don't contain the ray queries
+    auto shaderSet = ShaderSet::create(stages, hints);
+    shaderSet->attributeBindings = baseShaderSet->attributeBindings;
+    shaderSet->descriptorBindings = baseShaderSet->descriptorBindings;
+    shaderSet->pushConstantRanges = baseShaderSet->pushConstantRanges;
+    shaderSet->definesArrayStates = baseShaderSet->definesArrayStates;
+    shaderSet->optionalDefines = baseShaderSet->optionalDefines;
+    shaderSet->defaultGraphicsPipelineStates = baseShaderSet->defaultGraphicsPipelineStates;
+    shaderSet->customDescriptorSetBindings = baseShaderSet->customDescriptorSetBindings;
+
+    const uint32_t viewSet = 0;
+    shaderSet->addDescriptorBinding("rayTracedShadowSettings", "", viewSet, 9, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, mat4Value::create());
+    shaderSet->addDescriptorBinding("shadowAccelerationStructure", "", viewSet, 10, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, 1, VK_SHADER_STAGE_FRAGMENT_BIT, {});
+
+    return shaderSet;
 }
 
 std::pair<uint32_t, uint32_t> ShaderSet::descriptorSetRange() const
@@ -573,6 +1795,99 @@ bool ShaderSet::compatiblePipelineLayout(const PipelineLayout& layout, const std
     return true;
 }
 
+bool ShaderSet::compatibleDescriptorSetLayout(const DescriptorSetLayout& dsl, DefinesMask mask, uint32_t set) const
+{
+    for (auto& cdsb : customDescriptorSetBindings)
+    {
+        if (cdsb->set == set && cdsb->compatibleDescriptorSetLayout(dsl)) return true;
+    }
+
+    auto& registry = _getDefinesRegistry();
+
+    DescriptorSetLayoutBindings bindings;
+    for (size_t i = 0; i < descriptorBindings.size(); ++i)
+    {
+        auto& binding = descriptorBindings[i];
+        if (binding.set == set && (binding.define.empty() || (registry.valid && (registry.descriptorBindingMasks[i] & mask) != 0)))
+        {
+            bindings.push_back(VkDescriptorSetLayoutBinding{binding.binding, binding.descriptorType, binding.descriptorCount, binding.stageFlags, nullptr});
+        }
+    }
+
+    return compare_value_container(dsl.bindings, bindings) == 0;
+}
+
+ref_ptr<DescriptorSetLayout> ShaderSet::createDescriptorSetLayout(DefinesMask mask, uint32_t set) const
+{
+    for (auto& cdsb : customDescriptorSetBindings)
+    {
+        if (cdsb->set == set) return cdsb->createDescriptorSetLayout();
+    }
+
+    auto& registry = _getDefinesRegistry();
+
+    DescriptorSetLayoutBindings bindings;
+    for (size_t i = 0; i < descriptorBindings.size(); ++i)
+    {
+        auto& binding = descriptorBindings[i];
+        if (binding.set == set && (binding.define.empty() || (registry.valid && (registry.descriptorBindingMasks[i] & mask) != 0)))
+        {
+            bindings.push_back(VkDescriptorSetLayoutBinding{binding.binding, binding.descriptorType, binding.descriptorCount, binding.stageFlags, nullptr});
+        }
+    }
+
+    return DescriptorSetLayout::create(bindings);
+}
+
+bool ShaderSet::compatiblePipelineLayout(const PipelineLayout& layout, DefinesMask mask) const
+{
+    uint32_t set = 0;
+    for (const auto& descriptorSetLayout : layout.setLayouts)
+    {
+        if (descriptorSetLayout && !compatibleDescriptorSetLayout(*descriptorSetLayout, mask, set))
+        {
+            return false;
+        }
+        ++set;
+    }
+
+    auto& registry = _getDefinesRegistry();
+
+    PushConstantRanges ranges;
+    for (size_t i = 0; i < pushConstantRanges.size(); ++i)
+    {
+        if (pushConstantRanges[i].define.empty() || (registry.valid && (registry.pushConstantRangeMasks[i] & mask) != 0)) ranges.push_back(pushConstantRanges[i].range);
+    }
+
+    return compare_value_container(layout.pushConstantRanges, ranges) == 0;
+}
+
+ref_ptr<PipelineLayout> ShaderSet::createPipelineLayout(DefinesMask mask, std::pair<uint32_t, uint32_t> range) const
+{
+    DescriptorSetLayouts descriptorSetLayouts;
+
+    uint32_t set = 0;
+    for (; set < range.first; ++set)
+    {
+        descriptorSetLayouts.push_back(DescriptorSetLayout::create());
+    }
+
+    for (; set < range.second; ++set)
+    {
+        descriptorSetLayouts.push_back(createDescriptorSetLayout(mask, set));
+    }
+
+    auto& registry = _getDefinesRegistry();
+
+    PushConstantRanges activePushConstantRanges;
+    for (size_t i = 0; i < pushConstantRanges.size(); ++i)
+    {
+        if (pushConstantRanges[i].define.empty() || (registry.valid && (registry.pushConstantRangeMasks[i] & mask) != 0)) activePushConstantRanges.push_back(pushConstantRanges[i].range);
+    }
+
+    return vsg::PipelineLayout::create(descriptorSetLayouts, activePushConstantRanges);
+}
+
 ref_ptr<PipelineLayout> ShaderSet::createPipelineLayout(const std::set<std::string>& defines, std::pair<uint32_t, uint32_t> range) const
 {
     DescriptorSetLayouts descriptorSetLayouts;
@@ -1,3 +1,4 @@
+#include <vsg/core/hash.h>
 
 #include <vsg/io/Logger.h>
 #include <vsg/io/Options.h>
@@ -14,6 +15,35 @@ SharedObjects::~SharedObjects()
 {
 }
 
+bool SharedObjects::_suitable(const Object* object)
+{
+    if (!suitableForSharing) return true;
+
+    std::scoped_lock<std::mutex> lock(_suitableMutex);
+    return suitableForSharing->suitable(object);
+}
+
+ref_ptr<Object> SharedObjects::_findHashed(const std::type_index& id, ref_ptr<Object> object, uint64_t hash, bool insert)
+{
+    uint64_t key = hash_combine(hash, id.hash_code());
+    auto& shard = _shards[hash_mix(key) % numShards];
+
+    std::scoped_lock<std::mutex> lock(shard.mutex);
+
+    // only objects with matching hashes need a full compare
+    auto [begin, end] = shard.objects.equal_range(key);
+    for (auto itr = begin; itr != end; ++itr)
+    {
+        auto& entry = itr->second;
+        if (entry.id == id && (entry.object == object || entry.object->compare(*object) == 0)) return entry.object;
+    }
+
+    if (!insert) return {};
+
+    shard.objects.emplace(key, HashedObject{id, object});
+    return object;
+}
+
 bool SharedObjects::suitable(const Path& filename) const
 {
     return excludedExtensions.count(vsg::lowerCaseFileExtension(filename)) == 0;
@@ -65,11 +95,33 @@ bool SharedObjects::remove(const Path& filename, ref_ptr<const Options> options)
     }
 }
 
+void SharedObjects::beginLoad(ref_ptr<Object> loadedObject)
+{
+    std::unique_lock<std::mutex> lock(_pendingLoadsMutex);
+    _pendingLoadsCondition.wait(lock, [&]() { return _pendingLoads.count(loadedObject) == 0; });
+    _pendingLoads.insert(loadedObject);
+}
+
+void SharedObjects::endLoad(ref_ptr<Object> loadedObject)
+{
+    {
+        std::scoped_lock<std::mutex> lock(_pendingLoadsMutex);
+        _pendingLoads.erase(loadedObject);
+    }
+    _pendingLoadsCondition.notify_all();
+}
+
 void SharedObjects::clear()
 {
     std::scoped_lock<std::recursive_mutex> lock(_mutex);
     _defaults.clear();
     _sharedObjects.clear();
+
+    for (auto& shard : _shards)
+    {
+        std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+        shard.objects.clear();
+    }
 }
 
 void SharedObjects::prune()
@@ -124,6 +176,23 @@ void SharedObjects::prune()
                 }
             }
         }
+
+        for (auto& shard : _shards)
+        {
+            std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+            for (auto object_itr = shard.objects.begin(); object_itr != shard.objects.end();)
+            {
+                if (object_itr->second.object->referenceCount() == 1)
+                {
+                    object_itr = shard.objects.erase(object_itr);
+                    prunedObjects = true;
+                }
+                else
+                {
+                    ++object_itr;
+                }
+            }
+        }
     } while (prunedObjects);
 
     observedLoadedObject_itr = observedLoadedObjects.begin();
@@ -190,6 +259,26 @@ void SharedObjects::report(vsg::LogOutput& output)
     }
     output.out();
     output("}");
+
+    std::map<std::type_index, size_t> hashedCounts;
+    for (auto& shard : _shards)
+    {
+        std::scoped_lock<std::mutex> shard_lock(shard.mutex);
+        for (auto& [key, entry] : shard.objects) ++hashedCounts[entry.id];
+    }
+
+    if (!hashedCounts.empty())
+    {
+        output("SharedObjects::_shards ", numShards, " {");
+        output.in();
+        for (auto& [type, count] : hashedCounts)
+        {
+            output(type.name(), ", objects = ", count);
+        }
+        output.out();
+        output("}");
+    }
+
     output.out();
     output("}");
 }
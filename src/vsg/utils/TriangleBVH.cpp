@@ -0,0 +1,151 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/io/Input.h>
+#include <vsg/io/Output.h>
+#include <vsg/utils/TriangleBVH.h>
+
+#include <algorithm>
+
+using namespace vsg;
+
+namespace
+{
+    // limit the depth so that the fixed size traversal stack can't overflow
+    constexpr uint32_t maxDepth = 48;
+
+    struct BuildTriangleBVH
+    {
+        const vec3Array& vertices;
+        const std::vector<uivec3>& triangles;
+        const std::vector<vec3>& centroids;
+        std::vector<uint32_t>& order;
+        std::vector<TriangleBVH::Node>& nodes;
+        uint32_t maxTrianglesPerLeaf;
+
+        uint32_t build(uint32_t begin, uint32_t end, uint32_t depth)
+        {
+            uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+            nodes.emplace_back();
+
+            // bounds of the triangle centroids decide the split axis
+            box centroidBounds;
+            for (uint32_t i = begin; i < end; ++i) centroidBounds.add(centroids[order[i]]);
+
+            vec3 extents = centroidBounds.max - centroidBounds.min;
+            int axis = (extents.x >= extents.y && extents.x >= extents.z) ? 0 : ((extents.y >= extents.z) ? 1 : 2);
+
+            if ((end - begin) <= maxTrianglesPerLeaf || extents[axis] <= 0.0f || depth >= maxDepth)
+            {
+                box bounds;
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    const auto& t = triangles[order[i]];
+                    bounds.add(vertices.at(t.x));
+                    bounds.add(vertices.at(t.y));
+                    bounds.add(vertices.at(t.z));
+                }
+
+                auto& node = nodes[nodeIndex];
+                node.min = bounds.min;
+                node.max = bounds.max;
+                node.index = begin;
+                node.count = end - begin;
+                return nodeIndex;
+            }
+
+            uint32_t mid = begin + (end - begin) / 2;
+            std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](uint32_t lhs, uint32_t rhs) { return centroids[lhs][axis] < centroids[rhs][axis]; });
+
+            build(begin, mid, depth + 1);
+            uint32_t second = build(mid, end, depth + 1);
+
+            // internal node bounds are the union of its children's bounds
+            auto& node = nodes[nodeIndex];
+            const auto& first_child = nodes[nodeIndex + 1];
+            const auto& second_child = nodes[second];
+            node.min.set(std::min(first_child.min.x, second_child.min.x), std::min(first_child.min.y, second_child.min.y), std::min(first_child.min.z, second_child.min.z));
+            node.max.set(std::max(first_child.max.x, second_child.max.x), std::max(first_child.max.y, second_child.max.y), std::max(first_child.max.z, second_child.max.z));
+            node.index = second;
+            node.count = 0;
+            return nodeIndex;
+        }
+    };
+} // namespace
+
+TriangleBVH::TriangleBVH()
+{
+}
+
+TriangleBVH::~TriangleBVH()
+{
+}
+
+void TriangleBVH::build(const vec3Array& vertices, std::vector<uivec3> in_triangles, uint32_t maxTrianglesPerLeaf)
+{
+    nodes.clear();
+    triangles.clear();
+
+    // discard triangles that reference vertices outside the array
+    uint32_t numVertices = static_cast<uint32_t>(vertices.size());
+    in_triangles.erase(std::remove_if(in_triangles.begin(), in_triangles.end(), [&](const uivec3& t) { return t.x >= numVertices || t.y >= numVertices || t.z >= numVertices; }), in_triangles.end());
+    if (in_triangles.empty()) return;
+
+    std::vector<vec3> centroids(in_triangles.size());
+    std::vector<uint32_t> order(in_triangles.size());
+    for (size_t i = 0; i < in_triangles.size(); ++i)
+    {
+        const auto& t = in_triangles[i];
+        centroids[i] = (vertices.at(t.x) + vertices.at(t.y) + vertices.at(t.z)) / 3.0f;
+        order[i] = static_cast<uint32_t>(i);
+    }
+
+    maxTrianglesPerLeaf = std::max(maxTrianglesPerLeaf, 1u);
+    nodes.reserve(2 * (in_triangles.size() / maxTrianglesPerLeaf) + 1);
+
+    BuildTriangleBVH builder{vertices, in_triangles, centroids, order, nodes, maxTrianglesPerLeaf};
+    builder.build(0, static_cast<uint32_t>(order.size()), 0);
+
+    // leaves reference ranges of order, so store the triangles in that order
+    triangles.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        triangles[i] = in_triangles[order[i]];
+    }
+}
+
+void TriangleBVH::setSource(const Data* vertices, const Data* indices, uint32_t first, uint32_t count)
+{
+    _vertices = vertices;
+    _indices = indices;
+    if (vertices) vertices->getModifiedCount(_verticesModifiedCount);
+    if (indices) indices->getModifiedCount(_indicesModifiedCount);
+    _first = first;
+    _count = count;
+}
+
+bool TriangleBVH::valid(const Data* vertices, const Data* indices, uint32_t first, uint32_t count) const
+{
+    if (vertices != _vertices || indices != _indices || first != _first || count != _count) return false;
+    if (vertices && vertices->differentModifiedCount(_verticesModifiedCount)) return false;
+    if (indices && indices->differentModifiedCount(_indicesModifiedCount)) return false;
+    return _vertices != nullptr;
+}
+
+void TriangleBVH::read(Input&)
+{
+    // the BVH is rebuilt on demand so isn't serialized, a TriangleBVH read from file is never valid.
+}
+
+void TriangleBVH::write(Output&) const
+{
+}
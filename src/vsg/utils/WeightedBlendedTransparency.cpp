@@ -0,0 +1,271 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/commands/Draw.h>
+#include <vsg/io/Options.h>
+#include <vsg/io/Logger.h>
+#include <vsg/nodes/StateGroup.h>
+#include <vsg/state/ColorBlendState.h>
+#include <vsg/state/DepthStencilState.h>
+#include <vsg/state/ImageInfo.h>
+#include <vsg/state/RasterizationState.h>
+#include <vsg/utils/GraphicsPipelineConfigurator.h>
+#include <vsg/utils/WeightedBlendedTransparency.h>
+
+using namespace vsg;
+
+namespace
+{
+    // weighted blended order independent transparency, McGuire and Bavoil 2013, the depth weight favouring near surfaces with the reverse depth used by vsg.
+    const char* s_weightedBlendedOutputSource = R"(
+
+void main()
+{
+    shade();
+
+    float alpha = outColor.a;
+    float weight = clamp(pow(min(1.0, alpha * 10.0) + 0.01, 3.0) * 1e8 * pow(0.1 + 0.9 * gl_FragCoord.z, 3.0), 1e-2, 3e3);
+
+    outAccumulation = vec4(outColor.rgb * alpha, alpha) * weight;
+    outRevealage = alpha;
+}
+)";
+
+    const char* s_compositeVertexSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+out gl_PerVertex{ vec4 gl_Position; };
+
+void main()
+{
+    // full screen triangle
+    vec2 uv = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+    const char* s_compositeFragmentSource = R"(#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(input_attachment_index = 0, set = 0, binding = 0) uniform subpassInput accumulation;
+layout(input_attachment_index = 1, set = 0, binding = 1) uniform subpassInput revealage;
+
+layout(location = 0) out vec4 outColor;
+
+void main()
+{
+    float revealed = subpassLoad(revealage).r;
+    if (revealed >= 1.0) discard;
+
+    vec4 accumulated = subpassLoad(accumulation);
+    outColor = vec4(accumulated.rgb / max(accumulated.a, 1e-5), 1.0 - revealed);
+}
+)";
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// createWeightedBlendedTransparencyShaderSet
+//
+ref_ptr<ShaderSet> vsg::createWeightedBlendedTransparencyShaderSet(ref_ptr<ShaderSet> baseShaderSet)
+{
+    if (!baseShaderSet) return {};
+
+    const std::string outputDeclaration = "layout(location = 0) out vec4 outColor;";
+    const std::string mainDeclaration = "void main()";
+
+    ShaderStages stages;
+    for (auto& stage : baseShaderSet->stages)
+    {
+        if (stage->stage != VK_SHADER_STAGE_FRAGMENT_BIT || !stage->module)
+        {
+            stages.push_back(stage);
+            continue;
+        }
+
+        // derive the fragment shader from the base ShaderSet's, with its output redirected to a global and main() wrapped to write the accumulation and revealage
+        std::string source = stage->module->source;
+        auto outputPos = source.find(outputDeclaration);
+        auto mainPos = (outputPos != std::string::npos) ? source.find(mainDeclaration, outputPos) : std::string::npos;
+        if (mainPos == std::string::npos)
+        {
+            warn("createWeightedBlendedTransparencyShaderSet(..) unable to find outColor and main() in fragment shader source.");
+            return {};
+        }
+
+        source.replace(mainPos, mainDeclaration.size(), "void shade()");
+        source.replace(outputPos, outputDeclaration.size(), "layout(location = 0) out vec4 outAccumulation;\nlayout(location = 1) out float outRevealage;\n\nvec4 outColor;");
+        source += s_weightedBlendedOutputSource;
+
+        auto fragmentShader = ShaderStage::create(VK_SHADER_STAGE_FRAGMENT_BIT, stage->entryPointName, source, stage->module->hints);
+        fragmentShader->specializationConstants = stage->specializationConstants;
+        stages.push_back(fragmentShader);
+    }
+
+    // precompiled variants of the base ShaderSet aren't copied as they write to a single color attachment
+    auto shaderSet = ShaderSet::create(stages, baseShaderSet->defaultShaderHints);
+    shaderSet->attributeBindings = baseShaderSet->attributeBindings;
+    shaderSet->descriptorBindings = baseShaderSet->descriptorBindings;
+    shaderSet->pushConstantRanges = baseShaderSet->pushConstantRanges;
+    shaderSet->definesArrayStates = baseShaderSet->definesArrayStates;
+    shaderSet->optionalDefines = baseShaderSet->optionalDefines;
+    shaderSet->customDescriptorSetBindings = baseShaderSet->customDescriptorSetBindings;
+
+    // accumulate weighted color additively and multiply the revealage by the transmittance of each surface, testing against but not writing to the opaque depth
+    VkPipelineColorBlendAttachmentState accumulationBlend = {};
+    accumulationBlend.blendEnable = VK_TRUE;
+    accumulationBlend.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    accumulationBlend.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+    accumulationBlend.colorBlendOp = VK_BLEND_OP_ADD;
+    accumulationBlend.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    accumulationBlend.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    accumulationBlend.alphaBlendOp = VK_BLEND_OP_ADD;
+    accumulationBlend.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendAttachmentState revealageBlend = {};
+    revealageBlend.blendEnable = VK_TRUE;
+    revealageBlend.srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+    revealageBlend.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR;
+    revealageBlend.colorBlendOp = VK_BLEND_OP_ADD;
+    revealageBlend.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+    revealageBlend.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    revealageBlend.alphaBlendOp = VK_BLEND_OP_ADD;
+    revealageBlend.colorWriteMask = VK_COLOR_COMPONENT_R_BIT;
+
+    auto depthStencilState = DepthStencilState::create();
+    depthStencilState->depthWriteEnable = VK_FALSE;
+
+    for (auto& pipelineState : baseShaderSet->defaultGraphicsPipelineStates)
+    {
+        if (!pipelineState->is_compatible(typeid(ColorBlendState)) && !pipelineState->is_compatible(typeid(DepthStencilState))) shaderSet->defaultGraphicsPipelineStates.push_back(pipelineState);
+    }
+    shaderSet->defaultGraphicsPipelineStates.push_back(ColorBlendState::create(ColorBlendState::ColorBlendAttachments{accumulationBlend, revealageBlend}));
+    shaderSet->defaultGraphicsPipelineStates.push_back(depthStencilState);
+
+    return shaderSet;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// createWeightedBlendedCompositeShaderSet
+//
+ref_ptr<ShaderSet> vsg::createWeightedBlendedCompositeShaderSet(ref_ptr<const Options> options)
+{
+    if (options)
+    {
+        // check if a ShaderSet has already been assigned to the options object, if so return it
+        if (auto itr = options->shaderSets.find("weighted_blended_composite"); itr != options->shaderSets.end()) return itr->second;
+    }
+
+    auto vertexShader = ShaderStage::create(VK_SHADER_STAGE_VERTEX_BIT, "main", s_compositeVertexSource);
+    auto fragmentShader = ShaderStage::create(VK_SHADER_STAGE_FRAGMENT_BIT, "main", s_compositeFragmentSource);
+
+    auto shaderSet = ShaderSet::create(ShaderStages{vertexShader, fragmentShader});
+
+    shaderSet->addDescriptorBinding("accumulation", "", 0, 0, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1, VK_SHADER_STAGE_FRAGMENT_BIT, {});
+    shaderSet->addDescriptorBinding("revealage", "", 0, 1, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1, VK_SHADER_STAGE_FRAGMENT_BIT, {});
+
+    auto rasterizationState = RasterizationState::create();
+    rasterizationState->cullMode = VK_CULL_MODE_NONE;
+
+    auto colorBlendState = ColorBlendState::create();
+    colorBlendState->configureAttachments(true);
+
+    auto depthStencilState = DepthStencilState::create();
+    depthStencilState->depthTestEnable = VK_FALSE;
+    depthStencilState->depthWriteEnable = VK_FALSE;
+
+    shaderSet->defaultGraphicsPipelineStates = {rasterizationState, colorBlendState, depthStencilState};
+
+    return shaderSet;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// WeightedBlendedTransparency
+//
+WeightedBlendedTransparency::WeightedBlendedTransparency(ref_ptr<RenderPassChain> in_chain, uint32_t in_colorAttachment, uint32_t in_depthAttachment) :
+    chain(in_chain),
+    colorAttachment(in_colorAttachment),
+    depthAttachment(in_depthAttachment)
+{
+}
+
+WeightedBlendedTransparency::~WeightedBlendedTransparency()
+{
+}
+
+uint32_t WeightedBlendedTransparency::addPasses(ref_ptr<Node> transparentSubgraph)
+{
+    if (!chain) throw Exception{"Error: vsg::WeightedBlendedTransparency::addPasses(..) no RenderPassChain assigned."};
+
+    auto numAttachments = static_cast<uint32_t>(chain->attachments.size());
+    if (colorAttachment >= numAttachments || depthAttachment >= numAttachments) throw Exception{"Error: vsg::WeightedBlendedTransparency::addPasses(..) attachment index out of range."};
+
+    // the composite pass reads the accumulation with subpassInput, which requires single sampled attachments
+    if (chain->attachments[colorAttachment].samples != VK_SAMPLE_COUNT_1_BIT || chain->attachments[depthAttachment].samples != VK_SAMPLE_COUNT_1_BIT)
+    {
+        throw Exception{"Error: vsg::WeightedBlendedTransparency::addPasses(..) multisampled attachments not supported."};
+    }
+
+    RenderPassChain::Attachment accumulation;
+    accumulation.format = accumulationFormat;
+    accumulation.clearValue.color = {{0.0f, 0.0f, 0.0f, 0.0f}};
+    accumulationAttachment = chain->addAttachment(accumulation);
+
+    RenderPassChain::Attachment revealage;
+    revealage.format = revealageFormat;
+    revealage.clearValue.color = {{1.0f, 0.0f, 0.0f, 0.0f}};
+    revealageAttachment = chain->addAttachment(revealage);
+
+    RenderPassChain::Pass transparent;
+    transparent.subgraph = transparentSubgraph;
+    transparent.colorAttachments = {accumulationAttachment, revealageAttachment};
+    transparent.depthStencilAttachment = static_cast<int32_t>(depthAttachment);
+    transparentPass = chain->addPass(transparent);
+
+    // populated by createRenderGraph() once the accumulation and revealage images have been created
+    _compositeSubgraph = Group::create();
+
+    RenderPassChain::Pass composite;
+    composite.subgraph = _compositeSubgraph;
+    composite.colorAttachments = {colorAttachment};
+    composite.inputAttachments = {accumulationAttachment, revealageAttachment};
+    compositePass = chain->addPass(composite);
+
+    return transparentPass;
+}
+
+ref_ptr<RenderGraph> WeightedBlendedTransparency::createRenderGraph(Device* device)
+{
+    if (!chain || !_compositeSubgraph) throw Exception{"Error: vsg::WeightedBlendedTransparency::createRenderGraph(..) addPasses() must be called first."};
+
+    auto renderGraph = chain->createRenderGraph(device);
+
+    auto& imageViews = renderGraph->framebuffer->getAttachments();
+
+    auto graphicsPipelineConfig = GraphicsPipelineConfigurator::create(createWeightedBlendedCompositeShaderSet(options));
+    graphicsPipelineConfig->subpass = compositePass;
+    graphicsPipelineConfig->assignTexture("accumulation", ImageInfoList{ImageInfo::create(ref_ptr<Sampler>(), imageViews[accumulationAttachment], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)});
+    graphicsPipelineConfig->assignTexture("revealage", ImageInfoList{ImageInfo::create(ref_ptr<Sampler>(), imageViews[revealageAttachment], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)});
+    graphicsPipelineConfig->init();
+
+    auto stateGroup = StateGroup::create();
+    graphicsPipelineConfig->copyTo(stateGroup);
+    stateGroup->addChild(Draw::create(3, 1, 0, 0));
+
+    _compositeSubgraph->children.clear();
+    _compositeSubgraph->addChild(stateGroup);
+
+    return renderGraph;
+}
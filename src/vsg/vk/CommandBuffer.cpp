@@ -11,11 +11,15 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/core/Exception.h>
+#include <vsg/core/compare.h>
 #include <vsg/io/Logger.h>
 #include <vsg/utils/Profiler.h>
 #include <vsg/vk/CommandBuffer.h>
 #include <vsg/vk/State.h>
 
+#include <algorithm>
+#include <cstring>
+
 using namespace vsg;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -32,6 +36,7 @@ CommandBuffer::CommandBuffer(CommandPool* commandPool, VkCommandBuffer commandBu
     _currentPipelineLayout(VK_NULL_HANDLE),
     _currentPushConstantStageFlags(0)
 {
+    dirtyBindings();
 }
 
 CommandBuffer::~CommandBuffer()
@@ -46,6 +51,9 @@ void CommandBuffer::reset(VkCommandBufferResetFlags flags)
 {
     _currentPipelineLayout = VK_NULL_HANDLE;
     _currentPushConstantStageFlags = 0;
+    numSkippedDescriptorSetBinds = 0;
+    numSkippedPushConstants = 0;
+    dirtyBindings();
 
     if ((_commandPool->flags & VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT) != 0)
     {
@@ -53,13 +61,31 @@ void CommandBuffer::reset(VkCommandBufferResetFlags flags)
     }
 }
 
-void CommandBuffer::setCurrentPipelineLayout(const PipelineLayout* pipelineLayout)
+void CommandBuffer::setCurrentPipelineLayout(const PipelineLayout* pipelineLayout, VkPipelineBindPoint pipelineBindPoint)
 {
+    if (auto bound = _getBoundDescriptorSets(pipelineBindPoint))
+    {
+        // descriptor sets bound with a compatible layout remain valid, the rest are disturbed by binding the pipeline
+        if (bound->pipelineLayout)
+            bound->invalidate(_computeCompatibleSets(bound->pipelineLayout, pipelineLayout));
+        else
+            bound->invalidate();
+
+        bound->pipelineLayout = pipelineLayout;
+    }
+
+    // push constants remain valid if the new layout has the same push constant ranges
+    if (_pushConstantsLayout && _pushConstantsLayout != pipelineLayout && compare_value_container(_pushConstantsLayout->pushConstantRanges, pipelineLayout->pushConstantRanges) != 0)
+    {
+        _pushConstantStages.fill(0);
+    }
+    _pushConstantsLayout = pipelineLayout;
+
     VkPipelineLayout newLayout = pipelineLayout->vk(deviceID);
     if (_currentPipelineLayout != newLayout)
     {
-        // have to assume that all DescriptorSets will need to be rebound.
-        state->dirtyStateStacks();
+        // re-record the state, the descriptor sets and push constants that are still bound will be skipped by bindDescriptorSets(..) and pushConstants(..)
+        state->dirtyStateStacks(false);
 
         _currentPipelineLayout = newLayout;
         if (pipelineLayout->pushConstantRanges.empty())
@@ -69,6 +95,133 @@ void CommandBuffer::setCurrentPipelineLayout(const PipelineLayout* pipelineLayou
     }
 }
 
+void CommandBuffer::bindDescriptorSets(VkPipelineBindPoint pipelineBindPoint, const PipelineLayout* pipelineLayout, uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet* descriptorSets, uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets)
+{
+    auto bound = _getBoundDescriptorSets(pipelineBindPoint);
+    uint32_t endSet = firstSet + descriptorSetCount;
+
+    // the dynamic offsets can only be attributed to a single descriptor set without knowing the number of dynamic descriptors in each set
+    bool trackable = bound && pipelineLayout && endSet <= maxTrackedDescriptorSets && (dynamicOffsetCount == 0 || (descriptorSetCount == 1 && dynamicOffsetCount <= maxTrackedDynamicOffsets));
+
+    uint32_t compatibleSets = 0;
+    if (trackable && bound->pipelineLayout)
+    {
+        compatibleSets = _computeCompatibleSets(bound->pipelineLayout, pipelineLayout);
+        if (compatibleSets >= endSet)
+        {
+            bool alreadyBound = true;
+            for (uint32_t i = 0; i < descriptorSetCount && alreadyBound; ++i)
+            {
+                auto& boundSet = bound->sets[firstSet + i];
+                alreadyBound = boundSet.descriptorSet == descriptorSets[i] && boundSet.numDynamicOffsets == dynamicOffsetCount &&
+                               std::equal(dynamicOffsets, dynamicOffsets + dynamicOffsetCount, boundSet.dynamicOffsets.begin());
+            }
+
+            if (alreadyBound)
+            {
+                ++numSkippedDescriptorSetBinds;
+                return;
+            }
+        }
+    }
+
+    VkPipelineLayout layout = pipelineLayout ? pipelineLayout->vk(deviceID) : _currentPipelineLayout;
+    vkCmdBindDescriptorSets(_commandBuffer, pipelineBindPoint, layout, firstSet, descriptorSetCount, descriptorSets, dynamicOffsetCount, dynamicOffsets);
+
+    if (!bound) return;
+
+    if (!trackable)
+    {
+        bound->invalidate();
+        return;
+    }
+
+    // sets not compatible with the layout used for the bind are disturbed by it
+    bound->invalidate(bound->pipelineLayout ? compatibleSets : 0);
+    bound->pipelineLayout = pipelineLayout;
+
+    for (uint32_t i = 0; i < descriptorSetCount; ++i)
+    {
+        auto& boundSet = bound->sets[firstSet + i];
+        boundSet.descriptorSet = descriptorSets[i];
+        boundSet.numDynamicOffsets = dynamicOffsetCount;
+        std::copy(dynamicOffsets, dynamicOffsets + dynamicOffsetCount, boundSet.dynamicOffsets.begin());
+    }
+}
+
+void CommandBuffer::pushConstants(VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* values)
+{
+    bool trackable = (offset + size) <= maxTrackedPushConstantsSize && (offset % 4) == 0 && (size % 4) == 0;
+    if (trackable)
+    {
+        bool alreadyPushed = std::memcmp(_pushConstantValues.data() + offset, values, size) == 0;
+        for (uint32_t word = offset / 4; word < (offset + size) / 4 && alreadyPushed; ++word)
+        {
+            alreadyPushed = _pushConstantStages[word] == stageFlags;
+        }
+
+        if (alreadyPushed)
+        {
+            ++numSkippedPushConstants;
+            return;
+        }
+    }
+
+    vkCmdPushConstants(_commandBuffer, _currentPipelineLayout, stageFlags, offset, size, values);
+
+    if (trackable)
+    {
+        std::memcpy(_pushConstantValues.data() + offset, values, size);
+        for (uint32_t word = offset / 4; word < (offset + size) / 4; ++word) _pushConstantStages[word] = stageFlags;
+    }
+    else
+    {
+        _pushConstantStages.fill(0);
+    }
+}
+
+void CommandBuffer::dirtyBindings()
+{
+    for (auto& bound : _boundDescriptorSets)
+    {
+        bound.pipelineLayout = nullptr;
+        bound.invalidate();
+    }
+    _pushConstantStages.fill(0);
+    _pushConstantsLayout = nullptr;
+
+    _compatibilityLhs = nullptr;
+    _compatibilityRhs = nullptr;
+    _compatibleSets = 0;
+}
+
+CommandBuffer::BoundDescriptorSets* CommandBuffer::_getBoundDescriptorSets(VkPipelineBindPoint pipelineBindPoint)
+{
+    switch (pipelineBindPoint)
+    {
+    case (VK_PIPELINE_BIND_POINT_GRAPHICS): return &_boundDescriptorSets[0];
+    case (VK_PIPELINE_BIND_POINT_COMPUTE): return &_boundDescriptorSets[1];
+    case (VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR): return &_boundDescriptorSets[2];
+    default: return nullptr;
+    }
+}
+
+uint32_t CommandBuffer::_computeCompatibleSets(const PipelineLayout* lhs, const PipelineLayout* rhs)
+{
+    if (lhs == rhs || lhs->vk(deviceID) == rhs->vk(deviceID)) return maxTrackedDescriptorSets;
+
+    if (lhs != _compatibilityLhs || rhs != _compatibilityRhs)
+    {
+        // layouts are only compatible for descriptor set N if they are also push constant compatible
+        auto [pushConstantsCompatible, compatibleSets] = lhs->computeCompatibility(*rhs);
+
+        _compatibilityLhs = lhs;
+        _compatibilityRhs = rhs;
+        _compatibleSets = pushConstantsCompatible ? compatibleSets : 0;
+    }
+    return _compatibleSets;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // RecordedCommandBuffers
@@ -11,6 +11,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/core/Exception.h>
+#include <vsg/utils/Instrumentation.h>
 #include <vsg/vk/CommandBuffer.h>
 #include <vsg/vk/CommandPool.h>
 
@@ -49,7 +50,7 @@ ref_ptr<CommandBuffer> CommandPool::allocate(VkCommandBufferLevel level)
     allocateInfo.level = level;
     allocateInfo.commandBufferCount = 1;
 
-    std::scoped_lock<std::mutex> lock(_mutex);
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "CommandPool::_mutex");
     VkCommandBuffer commandBuffer;
     if (VkResult result = vkAllocateCommandBuffers(*_device, &allocateInfo, &commandBuffer); result != VK_SUCCESS)
     {
@@ -63,7 +64,7 @@ void CommandPool::free(CommandBuffer* commandBuffer)
 {
     if (commandBuffer && commandBuffer->_commandBuffer)
     {
-        std::scoped_lock<std::mutex> lock(_mutex);
+        SCOPED_LOCK_INSTRUMENTATION(_mutex, "CommandPool::_mutex");
         vkFreeCommandBuffers(*_device, _commandPool, 1, commandBuffer->data());
         commandBuffer->_commandBuffer = 0;
     }
@@ -0,0 +1,81 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/vk/CommandPoolRing.h>
+
+using namespace vsg;
+
+bool CommandPoolRing::Frame::available() const
+{
+    for (size_t i = 0; i < numUsed; ++i)
+    {
+        if (commandBuffers[i]->numDependentSubmissions() != 0) return false;
+    }
+    return true;
+}
+
+CommandPoolRing::CommandPoolRing(Device* in_device, uint32_t in_queueFamilyIndex, VkCommandBufferLevel in_level) :
+    device(in_device),
+    queueFamilyIndex(in_queueFamilyIndex),
+    level(in_level)
+{
+}
+
+CommandPoolRing::~CommandPoolRing()
+{
+}
+
+void CommandPoolRing::advance()
+{
+    // search from the oldest frame as it's the most likely to have completed
+    size_t numFrames = _frames.size();
+    for (size_t i = 1; i <= numFrames; ++i)
+    {
+        size_t index = (_currentFrame + i) % numFrames;
+        auto& frame = _frames[index];
+        if (frame.available())
+        {
+            // reset all the CommandBuffers used by the frame in one call
+            if (frame.numUsed > 0) frame.commandPool->reset();
+            frame.numUsed = 0;
+
+            _currentFrame = index;
+            return;
+        }
+    }
+
+    // all the CommandPools have pending submissions so add a new one
+    Frame frame;
+    frame.commandPool = CommandPool::create(device, queueFamilyIndex);
+    _frames.push_back(frame);
+    _currentFrame = _frames.size() - 1;
+}
+
+ref_ptr<CommandBuffer> CommandPoolRing::next()
+{
+    if (_frames.empty()) advance();
+
+    auto& frame = _frames[_currentFrame];
+    if (frame.numUsed < frame.commandBuffers.size())
+    {
+        // clear the CommandBuffer's tracked state, the VkCommandBuffer itself was reset along with its CommandPool
+        auto& commandBuffer = frame.commandBuffers[frame.numUsed++];
+        commandBuffer->reset();
+        return commandBuffer;
+    }
+
+    auto commandBuffer = frame.commandPool->allocate(level);
+    frame.commandBuffers.push_back(commandBuffer);
+    ++frame.numUsed;
+    return commandBuffer;
+}
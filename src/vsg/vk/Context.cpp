@@ -23,6 +23,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/StateGroup.h>
 #include <vsg/state/DescriptorSet.h>
 #include <vsg/state/DynamicState.h>
+#include <vsg/state/QueryPool.h>
 #include <vsg/ui/UIEvent.h>
 #include <vsg/vk/CommandBuffer.h>
 #include <vsg/vk/Context.h>
@@ -37,12 +38,13 @@ using namespace vsg;
 // BuildAccelerationStructureCommand
 //
 
-BuildAccelerationStructureCommand::BuildAccelerationStructureCommand(Device* device, const VkAccelerationStructureBuildGeometryInfoKHR& info, const VkAccelerationStructureKHR& structure, const std::vector<uint32_t>& primitiveCounts) :
+BuildAccelerationStructureCommand::BuildAccelerationStructureCommand(Device* device, const VkAccelerationStructureBuildGeometryInfoKHR& info, const VkAccelerationStructureKHR& structure, const std::vector<uint32_t>& primitiveCounts, VkBuildAccelerationStructureModeKHR mode) :
     _device(device),
     _accelerationStructureInfo(info),
     _accelerationStructure(structure)
 {
-    _accelerationStructureInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR;
+    _accelerationStructureInfo.mode = mode;
+    _accelerationStructureInfo.srcAccelerationStructure = (mode == VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR) ? _accelerationStructure : VK_NULL_HANDLE;
     _accelerationStructureInfo.dstAccelerationStructure = _accelerationStructure;
     _accelerationStructureGeometries = std::vector<VkAccelerationStructureGeometryKHR>(_accelerationStructureInfo.pGeometries, _accelerationStructureInfo.pGeometries + _accelerationStructureInfo.geometryCount);
     _accelerationStructureInfo.pGeometries = _accelerationStructureGeometries.data();
@@ -73,6 +75,12 @@ void BuildAccelerationStructureCommand::record(CommandBuffer& commandBuffer) con
     memoryBarrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR | VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
 
     vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &memoryBarrier, 0, 0, 0, 0);
+
+    if (compactedSizeQuery)
+    {
+        vkCmdResetQueryPool(commandBuffer, *compactedSizeQuery, 0, 1);
+        extensions->vkCmdWriteAccelerationStructuresPropertiesKHR(commandBuffer, 1, &_accelerationStructure, VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, *compactedSizeQuery, 0);
+    }
 }
 
 void BuildAccelerationStructureCommand::setScratchBuffer(ref_ptr<Buffer> scratchBuffer)
@@ -109,6 +117,8 @@ Context::Context(Device* in_device, const ResourceRequirements& in_resourceRequi
         vsg::debug("Context::Context() reusing deviceMemoryBufferPools = ", deviceMemoryBufferPools);
     }
 
+    memoryPriority = in_resourceRequirements.memoryPriority;
+
     stagingMemoryBufferPools = device->stagingMemoryBufferPools.ref_ptr();
     if (!stagingMemoryBufferPools)
     {
@@ -130,6 +140,32 @@ Context::Context(Device* in_device, const ResourceRequirements& in_resourceRequi
     {
         vsg::debug("Context::Context() reusing descriptorPools = ", descriptorPools);
     }
+    descriptorPoolShard = descriptorPools->acquireShard();
+
+    pipelineCache = device->pipelineCache.ref_ptr();
+    if (!pipelineCache)
+    {
+        Path pipelineCacheFilename;
+        if (resourceRequirements.pipelineCacheDirectory) pipelineCacheFilename = PipelineCache::filenameForDevice(device->getPhysicalDevice(), resourceRequirements.pipelineCacheDirectory);
+
+        device->pipelineCache = pipelineCache = PipelineCache::create(device, pipelineCacheFilename);
+        vsg::debug("Context::Context() creating new pipelineCache = ", pipelineCache, ", filename = ", pipelineCacheFilename);
+    }
+    else
+    {
+        vsg::debug("Context::Context() reusing pipelineCache = ", pipelineCache);
+    }
+
+    resourceCache = device->resourceCache.ref_ptr();
+    if (!resourceCache)
+    {
+        device->resourceCache = resourceCache = DeviceResourceCache::create(device);
+        vsg::debug("Context::Context() creating new resourceCache = ", resourceCache);
+    }
+    else
+    {
+        vsg::debug("Context::Context() reusing resourceCache = ", resourceCache);
+    }
 
     if ((resourceRequirements.viewportStateHint & DYNAMIC_VIEWPORTSTATE))
     {
@@ -145,21 +181,32 @@ Context::Context(const Context& context) :
     viewID(context.viewID),
     mask(context.mask),
     viewDependentState(context.viewDependentState),
+    operationThreads(context.operationThreads),
+    asynchronousPipelines(context.asynchronousPipelines),
     renderPass(context.renderPass),
     defaultPipelineStates(context.defaultPipelineStates),
     overridePipelineStates(context.overridePipelineStates),
     descriptorPools(context.descriptorPools),
+    pipelineCache(context.pipelineCache),
+    resourceCache(context.resourceCache),
     graphicsQueue(context.graphicsQueue),
     commandPool(context.commandPool),
     deviceMemoryBufferPools(context.deviceMemoryBufferPools),
     stagingMemoryBufferPools(context.stagingMemoryBufferPools),
+    memoryPriority(context.memoryPriority),
     scratchBufferSize(context.scratchBufferSize)
 {
+    // copies are typically used from another thread so acquire a separate shard to avoid contention
+    if (descriptorPools) descriptorPoolShard = descriptorPools->acquireShard();
+
     scratchMemory = ScratchMemory::create(4096);
 }
 
 Context::~Context()
 {
+    // operations added by compileInParallel(..) reference this Context so must complete before it's destroyed.
+    if (_parallelCompileLatch) _parallelCompileLatch->wait();
+
     if (requiresWaitForCompletion)
     {
         waitForCompletion();
@@ -197,18 +244,145 @@ VkResult Context::reserve(ResourceRequirements& requirements)
 {
     CPU_INSTRUMENTATION_L2_NC(instrumentation, "Context reserve", COLOR_COMPILE)
 
+    memoryPriority = requirements.memoryPriority;
+
     VkResult result = deviceMemoryBufferPools->reserve(requirements);
 
     resourceRequirements.maxSlots.merge(requirements.maxSlots);
 
-    descriptorPools->reserve(requirements);
+    descriptorPools->reserve(requirements, descriptorPoolShard);
 
     return result;
 }
 
 ref_ptr<DescriptorSet::Implementation> Context::allocateDescriptorSet(DescriptorSetLayout* descriptorSetLayout)
 {
-    return descriptorPools->allocateDescriptorSet(descriptorSetLayout);
+    return descriptorPools->allocateDescriptorSet(descriptorSetLayout, descriptorPoolShard);
+}
+
+void Context::compileInParallel(CompileFunction function)
+{
+    if (!operationThreads)
+    {
+        function(*this);
+        return;
+    }
+
+    struct CompileOperation : public Inherit<Operation, CompileOperation>
+    {
+        CompileOperation(Context* in_parent, CompileFunction in_function) :
+            parent(in_parent),
+            context(Context::create(*in_parent)),
+            function(in_function)
+        {
+            // prevent the function from deferring further work
+            context->operationThreads = {};
+        }
+
+        void run() override
+        {
+            try
+            {
+                function(*context);
+            }
+            catch (const Exception& exception)
+            {
+                std::scoped_lock<std::mutex> lock(parent->_parallelCompileMutex);
+                parent->_parallelCompileExceptions.push_back(exception);
+            }
+            catch (...)
+            {
+                std::scoped_lock<std::mutex> lock(parent->_parallelCompileMutex);
+                parent->_parallelCompileExceptions.push_back(Exception{"Error: exception thrown during parallel compile.", VK_ERROR_UNKNOWN});
+            }
+
+            latch->count_down();
+        }
+
+        Context* parent = nullptr;
+        ref_ptr<Context> context;
+        CompileFunction function;
+        ref_ptr<Latch> latch;
+    };
+
+    auto operation = CompileOperation::create(this, function);
+
+    {
+        std::scoped_lock<std::mutex> lock(_parallelCompileMutex);
+        if (!_parallelCompileLatch) _parallelCompileLatch = Latch::create(0);
+        _parallelCompileLatch->count_up();
+        operation->latch = _parallelCompileLatch;
+    }
+
+    operationThreads->add(operation);
+}
+
+void Context::compileAsynchronously(CompileFunction function)
+{
+    if (!operationThreads)
+    {
+        function(*this);
+        return;
+    }
+
+    struct AsynchronousCompileOperation : public Inherit<Operation, AsynchronousCompileOperation>
+    {
+        AsynchronousCompileOperation(Context* in_parent, CompileFunction in_function) :
+            context(Context::create(*in_parent)),
+            function(in_function)
+        {
+            // prevent the function from deferring further work
+            context->operationThreads = {};
+        }
+
+        void run() override
+        {
+            try
+            {
+                function(*context);
+            }
+            catch (const Exception& exception)
+            {
+                warn("Context::compileAsynchronously() ", exception.message, " result = ", exception.result);
+            }
+            catch (...)
+            {
+                warn("Context::compileAsynchronously() exception thrown during compile.");
+            }
+        }
+
+        ref_ptr<Context> context;
+        CompileFunction function;
+    };
+
+    operationThreads->add(AsynchronousCompileOperation::create(this, function));
+}
+
+void Context::waitForParallelCompiles()
+{
+    ref_ptr<Latch> latch;
+    {
+        std::scoped_lock<std::mutex> lock(_parallelCompileMutex);
+        latch = _parallelCompileLatch;
+    }
+
+    if (!latch) return;
+
+    CPU_INSTRUMENTATION_L1_NC(instrumentation, "Context waitForParallelCompiles", COLOR_COMPILE)
+
+    // help out with any compiles not yet taken by the operationThreads
+    if (operationThreads)
+        operationThreads->wait(*latch);
+    else
+        latch->wait();
+
+    std::vector<Exception> exceptions;
+    {
+        std::scoped_lock<std::mutex> lock(_parallelCompileMutex);
+        exceptions.swap(_parallelCompileExceptions);
+    }
+
+    if (!exceptions.empty()) throw exceptions.front();
 }
 
 void Context::copy(ref_ptr<Data> data, ref_ptr<ImageInfo> dest)
@@ -260,6 +434,9 @@ bool Context::record()
 {
     CPU_INSTRUMENTATION_L1_NC(instrumentation, "Context record", COLOR_COMPILE)
 
+    // pipelines etc. being created on the operationThreads must be complete before the compiled subgraph can be used.
+    waitForParallelCompiles();
+
     if (commands.empty() && buildAccelerationStructureCommands.empty()) return false;
 
     if (!fence)
@@ -361,6 +538,8 @@ void Context::waitForCompletion()
 
     requiresWaitForCompletion = false;
     commands.clear();
+    buildAccelerationStructureCommands.clear();
+    scratchBufferSize = 0;
     copyImageCmd = nullptr;
     copyBufferCmd = nullptr;
 }
@@ -17,34 +17,54 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 using namespace vsg;
 
-DescriptorPools::DescriptorPools(ref_ptr<Device> in_device) :
+DescriptorPools::DescriptorPools(ref_ptr<Device> in_device, uint32_t in_numShards) :
     device(in_device)
 {
+    _shards.resize(std::max(in_numShards, 1u));
+    for (auto& shard : _shards) shard = std::make_unique<Shard>();
 }
 
 DescriptorPools::~DescriptorPools()
 {
 }
 
-void DescriptorPools::getDescriptorPoolSizesToUse(uint32_t& maxSets, DescriptorPoolSizes& descriptorPoolSizes)
+uint32_t DescriptorPools::acquireShard()
 {
-    if (reserve_count > 0)
+    return _nextShard.fetch_add(1) % numShards();
+}
+
+uint32_t DescriptorPools::sizeClass(DescriptorSetLayout* descriptorSetLayout)
+{
+    uint32_t numDescriptors = 0;
+    for (auto& binding : descriptorSetLayout->bindings) numDescriptors += binding.descriptorCount;
+
+    // size class is the number of bits required to represent the number of descriptors, so each class spans a power of two range
+    uint32_t result = 0;
+    for (; numDescriptors > 0; numDescriptors >>= 1) ++result;
+    return result;
+}
+
+void DescriptorPools::getDescriptorPoolSizesToUse(Shard& shard, uint32_t& maxSets, DescriptorPoolSizes& descriptorPoolSizes)
+{
+    if (shard.minimum_maxSets < minimum_maxSets) shard.minimum_maxSets = minimum_maxSets;
+
+    if (shard.reserve_count > 0)
     {
-        if (minimum_maxSets > reserve_maxSets)
+        if (shard.minimum_maxSets > shard.reserve_maxSets)
         {
-            for (auto& dps : reserve_descriptorPoolSizes)
+            for (auto& dps : shard.reserve_descriptorPoolSizes)
             {
-                dps.descriptorCount = static_cast<uint32_t>(std::ceil(static_cast<double>(dps.descriptorCount) * static_cast<double>(minimum_maxSets) / static_cast<double>(reserve_maxSets)));
+                dps.descriptorCount = static_cast<uint32_t>(std::ceil(static_cast<double>(dps.descriptorCount) * static_cast<double>(shard.minimum_maxSets) / static_cast<double>(shard.reserve_maxSets)));
             }
-            reserve_maxSets = minimum_maxSets;
+            shard.reserve_maxSets = shard.minimum_maxSets;
         }
 
-        if (minimum_maxSets > maxSets)
+        if (shard.minimum_maxSets > maxSets)
         {
-            maxSets = minimum_maxSets;
+            maxSets = shard.minimum_maxSets;
         }
 
-        for (auto& [type, descriptorCount] : reserve_descriptorPoolSizes)
+        for (auto& [type, descriptorCount] : shard.reserve_descriptorPoolSizes)
         {
             auto itr = descriptorPoolSizes.begin();
             for (; itr != descriptorPoolSizes.end(); ++itr)
@@ -63,34 +83,37 @@ void DescriptorPools::getDescriptorPoolSizesToUse(uint32_t& maxSets, DescriptorP
         }
     }
 
-    minimum_maxSets = std::min(maximum_maxSets, static_cast<uint32_t>(static_cast<double>(maxSets) * scale_maxSets));
+    shard.minimum_maxSets = std::min(maximum_maxSets, static_cast<uint32_t>(static_cast<double>(maxSets) * scale_maxSets));
 
-    reserve_count = 0;
-    reserve_maxSets = 0;
-    reserve_descriptorPoolSizes.clear();
+    shard.reserve_count = 0;
+    shard.reserve_maxSets = 0;
+    shard.reserve_descriptorPoolSizes.clear();
 }
 
-void DescriptorPools::reserve(const ResourceRequirements& requirements)
+void DescriptorPools::reserve(const ResourceRequirements& requirements, uint32_t shardIndex)
 {
     auto maxSets = requirements.computeNumDescriptorSets();
     auto descriptorPoolSizes = requirements.computeDescriptorPoolSizes();
 
+    auto& shard = _shard(shardIndex);
+    std::scoped_lock<std::mutex> lock(shard.mutex);
+
     // update the variables tracing all reserve calls.
-    ++reserve_count;
-    reserve_maxSets += maxSets;
+    ++shard.reserve_count;
+    shard.reserve_maxSets += maxSets;
     for (auto& dps : descriptorPoolSizes)
     {
-        auto itr = std::find_if(reserve_descriptorPoolSizes.begin(), reserve_descriptorPoolSizes.end(), [&dps](const VkDescriptorPoolSize& value) { return value.type == dps.type; });
-        if (itr != reserve_descriptorPoolSizes.end())
+        auto itr = std::find_if(shard.reserve_descriptorPoolSizes.begin(), shard.reserve_descriptorPoolSizes.end(), [&dps](const VkDescriptorPoolSize& value) { return value.type == dps.type; });
+        if (itr != shard.reserve_descriptorPoolSizes.end())
             itr->descriptorCount += dps.descriptorCount;
         else
-            reserve_descriptorPoolSizes.push_back(dps);
+            shard.reserve_descriptorPoolSizes.push_back(dps);
     }
 
-    // compute the total available resources
+    // compute the total available resources in this shard's reserved DescriptorPools
     uint32_t available_maxSets = 0;
     DescriptorPoolSizes available_descriptorPoolSizes;
-    for (auto& descriptorPool : descriptorPools)
+    for (auto& descriptorPool : shard.reservedDescriptorPools)
     {
         descriptorPool->available(available_maxSets, available_descriptorPoolSizes);
     }
@@ -131,31 +154,141 @@ void DescriptorPools::reserve(const ResourceRequirements& requirements)
     }
 
     // not enough descriptor resources available so allocator new DescriptorPool.
-    getDescriptorPoolSizesToUse(required_maxSets, required_descriptorPoolSizes);
-    descriptorPools.push_back(vsg::DescriptorPool::create(device, required_maxSets, required_descriptorPoolSizes));
+    getDescriptorPoolSizesToUse(shard, required_maxSets, required_descriptorPoolSizes);
+    shard.reservedDescriptorPools.push_back(vsg::DescriptorPool::create(device, required_maxSets, required_descriptorPoolSizes));
+    ++shard.statistics.numDescriptorPoolsCreated;
 }
 
-ref_ptr<DescriptorSet::Implementation> DescriptorPools::allocateDescriptorSet(DescriptorSetLayout* descriptorSetLayout)
+ref_ptr<DescriptorSet::Implementation> DescriptorPools::_allocateDescriptorSet(Shard& shard, DescriptorSetLayout* descriptorSetLayout, uint32_t layoutSizeClass)
 {
-    for (auto itr = descriptorPools.rbegin(); itr != descriptorPools.rend(); ++itr)
+    // search the DescriptorPools of the same size class first, then the pools reserved for whole subgraphs, most recently allocated first.
+    if (auto itr = shard.sizeClassDescriptorPools.find(layoutSizeClass); itr != shard.sizeClassDescriptorPools.end())
     {
-        auto dsi = (*itr)->allocateDescriptorSet(descriptorSetLayout);
-        if (dsi) return dsi;
+        for (auto dp_itr = itr->second.rbegin(); dp_itr != itr->second.rend(); ++dp_itr)
+        {
+            if (auto dsi = (*dp_itr)->allocateDescriptorSet(descriptorSetLayout)) return dsi;
+        }
     }
 
-    DescriptorPoolSizes descriptorPoolSizes;
-    descriptorSetLayout->getDescriptorPoolSizes(descriptorPoolSizes);
+    for (auto itr = shard.reservedDescriptorPools.rbegin(); itr != shard.reservedDescriptorPools.rend(); ++itr)
+    {
+        if (auto dsi = (*itr)->allocateDescriptorSet(descriptorSetLayout)) return dsi;
+    }
+
+    return {};
+}
+
+ref_ptr<DescriptorSet::Implementation> DescriptorPools::allocateDescriptorSet(DescriptorSetLayout* descriptorSetLayout, uint32_t shardIndex)
+{
+    auto& shard = _shard(shardIndex);
+    std::scoped_lock<std::mutex> lock(shard.mutex);
+
+    ++shard.statistics.numAllocations;
+
+    auto layoutSizeClass = sizeClass(descriptorSetLayout);
+    if (auto dsi = _allocateDescriptorSet(shard, descriptorSetLayout, layoutSizeClass)) return dsi;
+
+    // before allocating a new DescriptorPool try the other shards that aren't currently in use, such as the shard a parent Context reserved resources in.
+    for (auto& other : _shards)
+    {
+        if (other.get() == &shard) continue;
+
+        std::unique_lock<std::mutex> other_lock(other->mutex, std::try_to_lock);
+        if (!other_lock.owns_lock()) continue;
+
+        if (auto dsi = _allocateDescriptorSet(*other, descriptorSetLayout, layoutSizeClass)) return dsi;
+    }
+
+    DescriptorPoolSizes layoutDescriptorPoolSizes;
+    descriptorSetLayout->getDescriptorPoolSizes(layoutDescriptorPoolSizes);
 
     uint32_t maxSets = 1;
-    getDescriptorPoolSizesToUse(maxSets, descriptorPoolSizes);
+    auto descriptorPoolSizes = layoutDescriptorPoolSizes;
+    getDescriptorPoolSizesToUse(shard, maxSets, descriptorPoolSizes);
+
+    // size the new DescriptorPool so that all its sets can be used by DescriptorSetLayouts of this size class
+    for (auto& [type, descriptorCount] : layoutDescriptorPoolSizes)
+    {
+        auto itr = std::find_if(descriptorPoolSizes.begin(), descriptorPoolSizes.end(), [type = type](const VkDescriptorPoolSize& value) { return value.type == type; });
+        if (itr != descriptorPoolSizes.end()) itr->descriptorCount = std::max(itr->descriptorCount, descriptorCount * maxSets);
+    }
 
     auto descriptorPool = vsg::DescriptorPool::create(device, maxSets, descriptorPoolSizes);
     auto dsi = descriptorPool->allocateDescriptorSet(descriptorSetLayout);
 
-    descriptorPools.push_back(descriptorPool);
+    shard.sizeClassDescriptorPools[layoutSizeClass].push_back(descriptorPool);
+    ++shard.statistics.numDescriptorPoolsCreated;
     return dsi;
 }
 
+size_t DescriptorPools::reclaim(size_t numEmptyPoolsToRetain)
+{
+    auto isEmpty = [](const ref_ptr<DescriptorPool>& dp) {
+        // each DescriptorSet::Implementation in use holds a reference to its DescriptorPool, so only our reference remains once they are all recycled.
+        return dp->referenceCount() == 1;
+    };
+
+    size_t numReclaimed = 0;
+    for (auto& shard : _shards)
+    {
+        std::scoped_lock<std::mutex> lock(shard->mutex);
+
+        size_t numRetained = 0;
+        auto reclaimFrom = [&](DescriptorPoolList& descriptorPools) {
+            // iterate from the most recently allocated DescriptorPools as these are searched first by allocateDescriptorSet(..)
+            for (auto itr = descriptorPools.end(); itr != descriptorPools.begin();)
+            {
+                --itr;
+                if (!isEmpty(*itr)) continue;
+
+                if (numRetained < numEmptyPoolsToRetain)
+                {
+                    ++numRetained;
+                    continue;
+                }
+
+                itr = descriptorPools.erase(itr);
+                ++numReclaimed;
+                ++shard->statistics.numDescriptorPoolsReclaimed;
+            }
+        };
+
+        reclaimFrom(shard->reservedDescriptorPools);
+        for (auto itr = shard->sizeClassDescriptorPools.begin(); itr != shard->sizeClassDescriptorPools.end();)
+        {
+            reclaimFrom(itr->second);
+            if (itr->second.empty())
+                itr = shard->sizeClassDescriptorPools.erase(itr);
+            else
+                ++itr;
+        }
+    }
+
+    if (numReclaimed > 0) vsg::debug("DescriptorPools::reclaim() ", this, " destroyed ", numReclaimed, " empty DescriptorPools");
+
+    return numReclaimed;
+}
+
+DescriptorPools::Statistics DescriptorPools::getStatistics() const
+{
+    Statistics statistics;
+    for (auto& shard : _shards)
+    {
+        std::scoped_lock<std::mutex> lock(shard->mutex);
+        statistics.numAllocations += shard->statistics.numAllocations;
+        statistics.numDescriptorPoolsCreated += shard->statistics.numDescriptorPoolsCreated;
+        statistics.numDescriptorPoolsReclaimed += shard->statistics.numDescriptorPoolsReclaimed;
+    }
+    return statistics;
+}
+
+size_t DescriptorPools::numDescriptorPools() const
+{
+    size_t count = 0;
+    _forEachDescriptorPool([&count](const DescriptorPool&) { ++count; });
+    return count;
+}
+
 void DescriptorPools::report(std::ostream& out, indentation indent) const
 {
     auto print = [&out, &indent](const std::string_view& name, uint32_t numSets, const DescriptorPoolSizes& descriptorPoolSizes) {
@@ -178,18 +311,21 @@ void DescriptorPools::report(std::ostream& out, indentation indent) const
     out << "DescriptorPools::report(..) " << this << " {" << std::endl;
     indent += 4;
 
-#if 1
-    out << indent << "descriptorPools " << descriptorPools.size() << std::endl;
-#else
-    out << indent << "descriptorPools " << descriptorPools.size() << " {" << std::endl;
+    out << indent << "descriptorPools " << numDescriptorPools() << std::endl;
+
+    out << indent << "shards " << _shards.size() << " {" << std::endl;
     indent += 4;
-    for (auto& dp : descriptorPools)
+    for (auto& shard : _shards)
     {
-        dp->report(out, indent);
+        std::scoped_lock<std::mutex> lock(shard->mutex);
+        out << indent << "Shard { reserved " << shard->reservedDescriptorPools.size() << ", sizeClasses {";
+        for (auto& [sc, descriptorPools] : shard->sizeClassDescriptorPools) out << " " << sc << ":" << descriptorPools.size();
+        out << " }, numAllocations " << shard->statistics.numAllocations;
+        out << ", numDescriptorPoolsCreated " << shard->statistics.numDescriptorPoolsCreated;
+        out << ", numDescriptorPoolsReclaimed " << shard->statistics.numDescriptorPoolsReclaimed << " }" << std::endl;
     }
     indent -= 4;
     out << indent << "}" << std::endl;
-#endif
 
     uint32_t numSets = 0;
     DescriptorPoolSizes descriptorPoolSizes;
@@ -214,31 +350,27 @@ void DescriptorPools::report(std::ostream& out, indentation indent) const
 bool DescriptorPools::available(uint32_t& numSets, DescriptorPoolSizes& availableDescriptorPoolSizes) const
 {
     bool result = false;
-    for (auto& dp : descriptorPools)
-    {
-        result = dp->available(numSets, availableDescriptorPoolSizes) | result;
-    }
+    _forEachDescriptorPool([&](const DescriptorPool& dp) {
+        result = dp.available(numSets, availableDescriptorPoolSizes) | result;
+    });
     return result;
 }
 
 bool DescriptorPools::used(uint32_t& numSets, DescriptorPoolSizes& descriptorPoolSizes) const
 {
     bool result = false;
-    for (auto& dp : descriptorPools)
-    {
-        result = dp->used(numSets, descriptorPoolSizes) | result;
-    }
+    _forEachDescriptorPool([&](const DescriptorPool& dp) {
+        result = dp.used(numSets, descriptorPoolSizes) | result;
+    });
     return result;
 }
 
 bool DescriptorPools::allocated(uint32_t& numSets, DescriptorPoolSizes& descriptorPoolSizes) const
 {
-    if (descriptorPools.empty()) return false;
-
-    for (const auto& dp : descriptorPools)
-    {
-        numSets += dp->maxSets;
-        for (auto& dps : dp->descriptorPoolSizes)
+    bool result = false;
+    _forEachDescriptorPool([&](const DescriptorPool& dp) {
+        numSets += dp.maxSets;
+        for (auto& dps : dp.descriptorPoolSizes)
         {
             auto itr = std::find_if(descriptorPoolSizes.begin(), descriptorPoolSizes.end(), [&dps](const VkDescriptorPoolSize& value) { return value.type == dps.type; });
             if (itr != descriptorPoolSizes.end())
@@ -246,6 +378,7 @@ bool DescriptorPools::allocated(uint32_t& numSets, DescriptorPoolSizes& descript
             else
                 descriptorPoolSizes.push_back(dps);
         }
-    }
-    return true;
+        result = true;
+    });
+    return result;
 }
@@ -131,6 +131,17 @@ Device::Device(PhysicalDevice* physicalDevice, const QueueSettings& queueSetting
 
     createInfo.pNext = deviceFeatures ? deviceFeatures->data() : nullptr;
 
+    // check whether timeline semaphores and pipeline statistics queries have been enabled
+    for (auto feature = reinterpret_cast<const VkBaseInStructure*>(createInfo.pNext); feature; feature = feature->pNext)
+    {
+        if (feature->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2)
+            _pipelineStatisticsQuery = _pipelineStatisticsQuery || reinterpret_cast<const VkPhysicalDeviceFeatures2*>(feature)->features.pipelineStatisticsQuery;
+        else if (feature->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES)
+            _timelineSemaphores = _timelineSemaphores || reinterpret_cast<const VkPhysicalDeviceTimelineSemaphoreFeatures*>(feature)->timelineSemaphore;
+        else if (feature->sType == VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES)
+            _timelineSemaphores = _timelineSemaphores || reinterpret_cast<const VkPhysicalDeviceVulkan12Features*>(feature)->timelineSemaphore;
+    }
+
     VkResult result = vkCreateDevice(*physicalDevice, &createInfo, allocator, &_device);
     if (result != VK_SUCCESS)
     {
@@ -249,3 +260,32 @@ VkDeviceSize Device::availableMemory(bool includeMemoryPools) const
 
     return available;
 }
+
+std::vector<Device::MemoryHeapBudget> Device::memoryHeapBudgets() const
+{
+    bool budgetSupported = supportsDeviceExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudget;
+    memoryBudget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+    memoryBudget.pNext = nullptr;
+
+    VkPhysicalDeviceMemoryProperties2 dmp;
+    dmp.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+    dmp.pNext = budgetSupported ? &memoryBudget : nullptr;
+
+    vkGetPhysicalDeviceMemoryProperties2(*(getPhysicalDevice()), &dmp);
+
+    auto& memoryProperties = dmp.memoryProperties;
+
+    std::vector<MemoryHeapBudget> budgets(memoryProperties.memoryHeapCount);
+    for (uint32_t heapIndex = 0; heapIndex < memoryProperties.memoryHeapCount; ++heapIndex)
+    {
+        auto& heapBudget = budgets[heapIndex];
+        heapBudget.flags = memoryProperties.memoryHeaps[heapIndex].flags;
+        heapBudget.size = memoryProperties.memoryHeaps[heapIndex].size;
+        heapBudget.budget = budgetSupported ? memoryBudget.heapBudget[heapIndex] : heapBudget.size;
+        heapBudget.usage = budgetSupported ? memoryBudget.heapUsage[heapIndex] : 0;
+    }
+
+    return budgets;
+}
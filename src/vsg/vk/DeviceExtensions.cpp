@@ -35,6 +35,8 @@ DeviceExtensions::DeviceExtensions(Device* device)
     device->getProcAddr(vkGetAccelerationStructureDeviceAddressKHR, "vkGetAccelerationStructureDeviceAddressKHR");
     device->getProcAddr(vkGetAccelerationStructureBuildSizesKHR, "vkGetAccelerationStructureBuildSizesKHR");
     device->getProcAddr(vkCmdBuildAccelerationStructuresKHR, "vkCmdBuildAccelerationStructuresKHR");
+    device->getProcAddr(vkCmdCopyAccelerationStructureKHR, "vkCmdCopyAccelerationStructureKHR");
+    device->getProcAddr(vkCmdWriteAccelerationStructuresPropertiesKHR, "vkCmdWriteAccelerationStructuresPropertiesKHR");
     device->getProcAddr(vkCreateRayTracingPipelinesKHR, "vkCreateRayTracingPipelinesKHR");
     device->getProcAddr(vkGetRayTracingShaderGroupHandlesKHR, "vkGetRayTracingShaderGroupHandlesKHR");
     device->getProcAddr(vkCmdTraceRaysKHR, "vkCmdTraceRaysKHR");
@@ -46,6 +48,13 @@ DeviceExtensions::DeviceExtensions(Device* device)
     device->getProcAddr(vkCmdDrawMeshTasksIndirectEXT, "vkCmdDrawMeshTasksIndirectEXT");
     device->getProcAddr(vkCmdDrawMeshTasksIndirectCountEXT, "vkCmdDrawMeshTasksIndirectCountEXT");
 
+    // VK_EXT_multi_draw
+    if (device->supportsDeviceExtension(VK_EXT_MULTI_DRAW_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkCmdDrawMultiEXT, "vkCmdDrawMultiEXT");
+        device->getProcAddr(vkCmdDrawMultiIndexedEXT, "vkCmdDrawMultiIndexedEXT");
+    }
+
     // VK_EXT_extended_dynamic_state
     if (device->supportsApiVersion(VK_API_VERSION_1_3))
     {
@@ -77,4 +86,84 @@ DeviceExtensions::DeviceExtensions(Device* device)
         device->getProcAddr(vkCmdSetStencilTestEnable, "vkCmdSetStencilTestEnableEXT");
         device->getProcAddr(vkCmdSetStencilOp, "vkCmdSetStencilOpEXT");
     }
+
+    // VK_EXT_extended_dynamic_state2
+    if (device->supportsApiVersion(VK_API_VERSION_1_3))
+    {
+        device->getProcAddr(vkCmdSetRasterizerDiscardEnable, "vkCmdSetRasterizerDiscardEnable");
+        device->getProcAddr(vkCmdSetDepthBiasEnable, "vkCmdSetDepthBiasEnable");
+        device->getProcAddr(vkCmdSetPrimitiveRestartEnable, "vkCmdSetPrimitiveRestartEnable");
+    }
+    else if (device->supportsDeviceExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkCmdSetRasterizerDiscardEnable, "vkCmdSetRasterizerDiscardEnableEXT");
+        device->getProcAddr(vkCmdSetDepthBiasEnable, "vkCmdSetDepthBiasEnableEXT");
+        device->getProcAddr(vkCmdSetPrimitiveRestartEnable, "vkCmdSetPrimitiveRestartEnableEXT");
+    }
+
+    // VK_EXT_extended_dynamic_state3
+    if (device->supportsDeviceExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkCmdSetPolygonModeEXT, "vkCmdSetPolygonModeEXT");
+        device->getProcAddr(vkCmdSetColorBlendEnableEXT, "vkCmdSetColorBlendEnableEXT");
+        device->getProcAddr(vkCmdSetColorWriteMaskEXT, "vkCmdSetColorWriteMaskEXT");
+    }
+
+    // VK_KHR_fragment_shading_rate
+    if (device->supportsDeviceExtension(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkCmdSetFragmentShadingRateKHR, "vkCmdSetFragmentShadingRateKHR");
+    }
+
+    // VK_KHR_dynamic_rendering
+    if (device->supportsApiVersion(VK_API_VERSION_1_3))
+    {
+        device->getProcAddr(vkCmdBeginRendering, "vkCmdBeginRendering");
+        device->getProcAddr(vkCmdEndRendering, "vkCmdEndRendering");
+    }
+    else if (device->supportsDeviceExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkCmdBeginRendering, "vkCmdBeginRenderingKHR");
+        device->getProcAddr(vkCmdEndRendering, "vkCmdEndRenderingKHR");
+    }
+
+    // VK_KHR_push_descriptor
+    if (device->supportsDeviceExtension(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkCmdPushDescriptorSetKHR, "vkCmdPushDescriptorSetKHR");
+    }
+
+    // VK_KHR_descriptor_update_template
+    if (device->supportsApiVersion(VK_API_VERSION_1_1))
+    {
+        device->getProcAddr(vkCreateDescriptorUpdateTemplate, "vkCreateDescriptorUpdateTemplate");
+        device->getProcAddr(vkDestroyDescriptorUpdateTemplate, "vkDestroyDescriptorUpdateTemplate");
+        device->getProcAddr(vkUpdateDescriptorSetWithTemplate, "vkUpdateDescriptorSetWithTemplate");
+    }
+    else if (device->supportsDeviceExtension(VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkCreateDescriptorUpdateTemplate, "vkCreateDescriptorUpdateTemplateKHR");
+        device->getProcAddr(vkDestroyDescriptorUpdateTemplate, "vkDestroyDescriptorUpdateTemplateKHR");
+        device->getProcAddr(vkUpdateDescriptorSetWithTemplate, "vkUpdateDescriptorSetWithTemplateKHR");
+    }
+
+    // VK_KHR_timeline_semaphore
+    if (device->supportsApiVersion(VK_API_VERSION_1_2))
+    {
+        device->getProcAddr(vkGetSemaphoreCounterValue, "vkGetSemaphoreCounterValue");
+        device->getProcAddr(vkWaitSemaphores, "vkWaitSemaphores");
+        device->getProcAddr(vkSignalSemaphore, "vkSignalSemaphore");
+    }
+    else if (device->supportsDeviceExtension(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkGetSemaphoreCounterValue, "vkGetSemaphoreCounterValueKHR");
+        device->getProcAddr(vkWaitSemaphores, "vkWaitSemaphoresKHR");
+        device->getProcAddr(vkSignalSemaphore, "vkSignalSemaphoreKHR");
+    }
+
+    // VK_KHR_present_wait
+    if (device->supportsDeviceExtension(VK_KHR_PRESENT_WAIT_EXTENSION_NAME))
+    {
+        device->getProcAddr(vkWaitForPresentKHR, "vkWaitForPresentKHR");
+    }
 }
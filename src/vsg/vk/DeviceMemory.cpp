@@ -10,9 +10,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 </editor-fold> */
 
+#include <vsg/core/CompressedData.h>
 #include <vsg/core/Exception.h>
 #include <vsg/vk/DeviceMemory.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 
@@ -43,8 +45,14 @@ DeviceMemoryList vsg::getActiveDeviceMemoryList(VkMemoryPropertyFlagBits propert
 // DeviceMemory
 //
 DeviceMemory::DeviceMemory(Device* device, const VkMemoryRequirements& memRequirements, VkMemoryPropertyFlags properties, void* pNextAllocInfo) :
+    DeviceMemory(device, memRequirements, properties, 0.5f, pNextAllocInfo)
+{
+}
+
+DeviceMemory::DeviceMemory(Device* device, const VkMemoryRequirements& memRequirements, VkMemoryPropertyFlags properties, float in_priority, void* pNextAllocInfo) :
     _memoryRequirements(memRequirements),
     _properties(properties),
+    _priority(std::clamp(in_priority, 0.0f, 1.0f)),
     _device(device),
     _memorySlots(memRequirements.size)
 {
@@ -63,6 +71,7 @@ DeviceMemory::DeviceMemory(Device* device, const VkMemoryRequirements& memRequir
         throw Exception{"Error: vsg::DeviceMemory::create(...) failed to create DeviceMemory, no usable memory type found.", VK_ERROR_FORMAT_NOT_SUPPORTED};
     }
     uint32_t memoryTypeIndex = i;
+    _memoryTypePropertyFlags = memProperties.memoryTypes[i].propertyFlags;
 
 #if DO_CHECK
     if (properties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
@@ -85,6 +94,15 @@ DeviceMemory::DeviceMemory(Device* device, const VkMemoryRequirements& memRequir
     allocateInfo.memoryTypeIndex = memoryTypeIndex;
     allocateInfo.pNext = pNextAllocInfo;
 
+    VkMemoryPriorityAllocateInfoEXT priorityInfo = {};
+    if (device->supportsDeviceExtension(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME))
+    {
+        priorityInfo.sType = VK_STRUCTURE_TYPE_MEMORY_PRIORITY_ALLOCATE_INFO_EXT;
+        priorityInfo.pNext = pNextAllocInfo;
+        priorityInfo.priority = _priority;
+        allocateInfo.pNext = &priorityInfo;
+    }
+
     if (VkResult result = vkAllocateMemory(*device, &allocateInfo, _device->getAllocationCallbacks(), &_deviceMemory); result != VK_SUCCESS)
     {
         throw Exception{"Error: Failed to allocate DeviceMemory.", result};
@@ -147,7 +165,13 @@ void DeviceMemory::copy(VkDeviceSize offset, VkDeviceSize size, const void* src_
 
 void DeviceMemory::copy(VkDeviceSize offset, const Data* data)
 {
-    copy(offset, data->dataSize(), data->dataPointer());
+    void* buffer_data;
+    map(offset, data->dataSize(), 0, &buffer_data);
+
+    // decompresses CompressedData directly into the mapped memory
+    copyData(*data, buffer_data);
+
+    unmap();
 }
 
 MemorySlots::OptionalOffset DeviceMemory::reserve(VkDeviceSize size)
@@ -190,3 +214,9 @@ size_t DeviceMemory::totalMemorySize() const
 {
     return _memorySlots.totalMemorySize();
 }
+
+double DeviceMemory::fragmentation() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _memorySlots.fragmentation();
+}
@@ -0,0 +1,182 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/core/Exception.h>
+#include <vsg/vk/DeviceResourceCache.h>
+
+#include <cstring>
+
+using namespace vsg;
+
+// copy the settings member by member into zeroed structs so that padding doesn't affect the memory comparisons used by the cache's maps
+static VkSamplerCreateInfo normalized(const VkSamplerCreateInfo& in)
+{
+    VkSamplerCreateInfo info;
+    std::memset(&info, 0, sizeof(info));
+    info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    info.flags = in.flags;
+    info.magFilter = in.magFilter;
+    info.minFilter = in.minFilter;
+    info.mipmapMode = in.mipmapMode;
+    info.addressModeU = in.addressModeU;
+    info.addressModeV = in.addressModeV;
+    info.addressModeW = in.addressModeW;
+    info.mipLodBias = in.mipLodBias;
+    info.anisotropyEnable = in.anisotropyEnable;
+    info.maxAnisotropy = in.maxAnisotropy;
+    info.compareEnable = in.compareEnable;
+    info.compareOp = in.compareOp;
+    info.minLod = in.minLod;
+    info.maxLod = in.maxLod;
+    info.borderColor = in.borderColor;
+    info.unnormalizedCoordinates = in.unnormalizedCoordinates;
+    return info;
+}
+
+static VkImageViewCreateInfo normalized(const VkImageViewCreateInfo& in)
+{
+    VkImageViewCreateInfo info;
+    std::memset(&info, 0, sizeof(info));
+    info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    info.flags = in.flags;
+    info.image = in.image;
+    info.viewType = in.viewType;
+    info.format = in.format;
+    info.components = in.components;
+    info.subresourceRange = in.subresourceRange;
+    return info;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// DeviceResourceCache::SharedSampler
+//
+DeviceResourceCache::SharedSampler::SharedSampler(DeviceResourceCache* in_cache, const VkSamplerCreateInfo& in_info) :
+    info(in_info),
+    device(in_cache->getDevice()),
+    _cache(in_cache)
+{
+    if (VkResult result = vkCreateSampler(*device, &info, device->getAllocationCallbacks(), &sampler); result != VK_SUCCESS)
+    {
+        throw Exception{"Error: Failed to create VkSampler.", result};
+    }
+}
+
+DeviceResourceCache::SharedSampler::~SharedSampler()
+{
+    if (auto cache = _cache.ref_ptr()) cache->_remove(this);
+
+    if (sampler)
+    {
+        vkDestroySampler(*device, sampler, device->getAllocationCallbacks());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// DeviceResourceCache::SharedImageView
+//
+DeviceResourceCache::SharedImageView::SharedImageView(DeviceResourceCache* in_cache, const VkImageViewCreateInfo& in_info) :
+    info(in_info),
+    device(in_cache->getDevice()),
+    _cache(in_cache)
+{
+    if (VkResult result = vkCreateImageView(*device, &info, device->getAllocationCallbacks(), &imageView); result != VK_SUCCESS)
+    {
+        throw Exception{"Error: Failed to create VkImageView.", result};
+    }
+}
+
+DeviceResourceCache::SharedImageView::~SharedImageView()
+{
+    if (auto cache = _cache.ref_ptr()) cache->_remove(this);
+
+    if (imageView)
+    {
+        vkDestroyImageView(*device, imageView, device->getAllocationCallbacks());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// DeviceResourceCache
+//
+DeviceResourceCache::DeviceResourceCache(Device* in_device) :
+    _device(in_device)
+{
+}
+
+DeviceResourceCache::~DeviceResourceCache()
+{
+}
+
+ref_ptr<DeviceResourceCache::SharedSampler> DeviceResourceCache::getOrCreateSampler(const VkSamplerCreateInfo& in_info)
+{
+    auto info = normalized(in_info);
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& entry = _samplers[info];
+    if (auto sharedSampler = entry.ref_ptr()) return sharedSampler;
+
+    auto sharedSampler = SharedSampler::create(this, info);
+    entry = sharedSampler;
+    return sharedSampler;
+}
+
+ref_ptr<DeviceResourceCache::SharedImageView> DeviceResourceCache::getOrCreateImageView(const VkImageViewCreateInfo& in_info)
+{
+    auto info = normalized(in_info);
+
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    auto& entry = _imageViews[info];
+    if (auto sharedImageView = entry.ref_ptr()) return sharedImageView;
+
+    auto sharedImageView = SharedImageView::create(this, info);
+    entry = sharedImageView;
+    return sharedImageView;
+}
+
+size_t DeviceResourceCache::numSamplers() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _samplers.size();
+}
+
+size_t DeviceResourceCache::numImageViews() const
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _imageViews.size();
+}
+
+void DeviceResourceCache::_remove(const SharedSampler* sharedSampler)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    // only remove the entry if it hasn't already been replaced by a new SharedSampler
+    if (auto itr = _samplers.find(sharedSampler->info); itr != _samplers.end() && !itr->second.ref_ptr())
+    {
+        _samplers.erase(itr);
+    }
+}
+
+void DeviceResourceCache::_remove(const SharedImageView* sharedImageView)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    if (auto itr = _imageViews.find(sharedImageView->info); itr != _imageViews.end() && !itr->second.ref_ptr())
+    {
+        _imageViews.erase(itr);
+    }
+}
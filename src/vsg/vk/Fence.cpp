@@ -38,6 +38,12 @@ Fence::~Fence()
 }
 
 void Fence::resetFenceAndDependencies()
+{
+    resetDependencies();
+    reset();
+}
+
+void Fence::resetDependencies()
 {
     for (auto& semaphore : _dependentSemaphores)
     {
@@ -51,8 +57,6 @@ void Fence::resetFenceAndDependencies()
 
     _dependentSemaphores.clear();
     _dependentCommandBuffers.clear();
-
-    reset();
 }
 
 VkResult Fence::wait(uint64_t timeout) const
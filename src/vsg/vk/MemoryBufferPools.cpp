@@ -11,6 +11,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/io/Logger.h>
+#include <vsg/utils/Instrumentation.h>
 #include <vsg/vk/MemoryBufferPools.h>
 
 #include <algorithm>
@@ -28,7 +29,7 @@ MemoryBufferPools::MemoryBufferPools(const std::string& in_name, ref_ptr<Device>
 
 VkDeviceSize MemoryBufferPools::computeMemoryTotalAvailable() const
 {
-    std::scoped_lock<std::mutex> lock(_mutex);
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
 
     VkDeviceSize totalAvailableSize = 0;
     for (auto& deviceMemory : memoryPools)
@@ -40,7 +41,7 @@ VkDeviceSize MemoryBufferPools::computeMemoryTotalAvailable() const
 
 VkDeviceSize MemoryBufferPools::computeMemoryTotalReserved() const
 {
-    std::scoped_lock<std::mutex> lock(_mutex);
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
 
     VkDeviceSize totalReservedSize = 0;
     for (auto& deviceMemory : memoryPools)
@@ -52,7 +53,7 @@ VkDeviceSize MemoryBufferPools::computeMemoryTotalReserved() const
 
 VkDeviceSize MemoryBufferPools::computeBufferTotalAvailable() const
 {
-    std::scoped_lock<std::mutex> lock(_mutex);
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
 
     VkDeviceSize totalAvailableSize = 0;
     for (auto& buffer : bufferPools)
@@ -64,7 +65,7 @@ VkDeviceSize MemoryBufferPools::computeBufferTotalAvailable() const
 
 VkDeviceSize MemoryBufferPools::computeBufferTotalReserved() const
 {
-    std::scoped_lock<std::mutex> lock(_mutex);
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
 
     VkDeviceSize totalReservedSize = 0;
     for (auto& buffer : bufferPools)
@@ -74,16 +75,68 @@ VkDeviceSize MemoryBufferPools::computeBufferTotalReserved() const
     return totalReservedSize;
 }
 
-ref_ptr<BufferInfo> MemoryBufferPools::reserveBuffer(VkDeviceSize totalSize, VkDeviceSize alignment, VkBufferUsageFlags bufferUsageFlags, VkSharingMode sharingMode, VkMemoryPropertyFlags memoryPropertiesFlags)
+double MemoryBufferPools::computeMemoryFragmentation() const
 {
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
+
+    VkDeviceSize totalAvailableSize = 0;
+    VkDeviceSize totalContiguousSize = 0;
+    for (auto& deviceMemory : memoryPools)
+    {
+        totalAvailableSize += deviceMemory->totalAvailableSize();
+        totalContiguousSize += deviceMemory->maximumAvailableSpace();
+    }
+    return (totalAvailableSize > 0) ? (1.0 - static_cast<double>(totalContiguousSize) / static_cast<double>(totalAvailableSize)) : 0.0;
+}
+
+double MemoryBufferPools::computeBufferFragmentation() const
+{
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
+
+    VkDeviceSize totalAvailableSize = 0;
+    VkDeviceSize totalContiguousSize = 0;
+    for (auto& buffer : bufferPools)
+    {
+        totalAvailableSize += buffer->totalAvailableSize();
+        totalContiguousSize += buffer->maximumAvailableSpace();
+    }
+    return (totalAvailableSize > 0) ? (1.0 - static_cast<double>(totalContiguousSize) / static_cast<double>(totalAvailableSize)) : 0.0;
+}
+
+void MemoryBufferPools::report(std::ostream& out, indentation indent) const
+{
+    out << indent << "MemoryBufferPools::report(..) " << this << " " << name << " {" << std::endl;
+    indent += 4;
+
+    {
+        SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
+        out << indent << "memoryPools " << memoryPools.size() << std::endl;
+        out << indent << "bufferPools " << bufferPools.size() << std::endl;
+    }
+
+    out << indent << "memory reserved " << computeMemoryTotalReserved() << ", available " << computeMemoryTotalAvailable() << ", fragmentation " << computeMemoryFragmentation() << std::endl;
+    out << indent << "buffer reserved " << computeBufferTotalReserved() << ", available " << computeBufferTotalAvailable() << ", fragmentation " << computeBufferFragmentation() << std::endl;
+
+    indent -= 4;
+    out << indent << "}" << std::endl;
+}
+
+ref_ptr<BufferInfo> MemoryBufferPools::reserveBuffer(VkDeviceSize totalSize, VkDeviceSize alignment, VkBufferUsageFlags bufferUsageFlags, VkSharingMode sharingMode, VkMemoryPropertyFlags memoryPropertiesFlags, float priority)
+{
+    // clamp to match the priority stored by DeviceMemory
+    priority = std::clamp(priority, 0.0f, 1.0f);
+
     ref_ptr<BufferInfo> bufferInfo = BufferInfo::create();
 
     {
-        std::scoped_lock<std::mutex> lock(_mutex);
+        SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
         for (auto& bufferFromPool : bufferPools)
         {
-            if (bufferFromPool->usage == bufferUsageFlags && bufferFromPool->size >= totalSize)
+            if (bufferFromPool->usage == bufferUsageFlags && bufferFromPool->size >= totalSize && bufferFromPool->maximumAvailableSpace() >= totalSize)
             {
+                auto bufferMemory = bufferFromPool->getDeviceMemory(device->deviceID);
+                if (bufferMemory && bufferMemory->getPriority() != priority) continue;
+
                 MemorySlots::OptionalOffset reservedBufferSlot = bufferFromPool->reserve(totalSize, alignment);
                 if (reservedBufferSlot.first)
                 {
@@ -112,7 +165,7 @@ ref_ptr<BufferInfo> MemoryBufferPools::reserveBuffer(VkDeviceSize totalSize, VkD
     VkMemoryRequirements memRequirements;
     vkGetBufferMemoryRequirements(*device, bufferInfo->buffer->vk(device->deviceID), &memRequirements);
 
-    auto reservedMemorySlot = reserveMemory(memRequirements, memoryPropertiesFlags);
+    auto reservedMemorySlot = reserveMemory(memRequirements, memoryPropertiesFlags, nullptr, priority);
 
     if (!reservedMemorySlot.first)
     {
@@ -126,7 +179,7 @@ ref_ptr<BufferInfo> MemoryBufferPools::reserveBuffer(VkDeviceSize totalSize, VkD
 
     //if (!bufferInfo->buffer->full())
     {
-        std::scoped_lock<std::mutex> lock(_mutex);
+        SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
         //debug(name, "  inserting new Buffer into Context.bufferPools");
         bufferPools.push_back(bufferInfo->buffer);
     }
@@ -134,12 +187,14 @@ ref_ptr<BufferInfo> MemoryBufferPools::reserveBuffer(VkDeviceSize totalSize, VkD
     return bufferInfo;
 }
 
-MemoryBufferPools::DeviceMemoryOffset MemoryBufferPools::reserveMemory(VkMemoryRequirements memRequirements, VkMemoryPropertyFlags memoryPropertiesFlags, void* pNextAllocInfo)
+MemoryBufferPools::DeviceMemoryOffset MemoryBufferPools::reserveMemory(VkMemoryRequirements memRequirements, VkMemoryPropertyFlags memoryPropertiesFlags, void* pNextAllocInfo, float priority)
 {
+    priority = std::clamp(priority, 0.0f, 1.0f);
+
     VkDeviceSize totalSize = memRequirements.size;
     // vsg::info("MemoryBufferPools::reserveMemory() ", totalSize, ", device->availableMemory() = ", device->availableMemory());
 
-    std::scoped_lock<std::mutex> lock(_mutex);
+    SCOPED_LOCK_INSTRUMENTATION(_mutex, "MemoryBufferPools::_mutex");
 
     ref_ptr<DeviceMemory> deviceMemory;
     MemorySlots::OptionalOffset reservedSlot(false, 0);
@@ -148,6 +203,7 @@ MemoryBufferPools::DeviceMemoryOffset MemoryBufferPools::reserveMemory(VkMemoryR
     {
         if (memoryPool->getMemoryRequirements().memoryTypeBits == memRequirements.memoryTypeBits &&
             memoryPool->getMemoryRequirements().alignment == memRequirements.alignment &&
+            memoryPool->getPriority() == priority &&
             memoryPool->maximumAvailableSpace() >= totalSize)
         {
             reservedSlot = memoryPool->reserve(totalSize);
@@ -215,7 +271,7 @@ MemoryBufferPools::DeviceMemoryOffset MemoryBufferPools::reserveMemory(VkMemoryR
             //debug("Creating new local DeviceMemory");
             if (memRequirements.size < deviceMemorySize) memRequirements.size = deviceMemorySize;
 
-            deviceMemory = vsg::DeviceMemory::create(device, memRequirements, memoryPropertiesFlags, pNextAllocInfo);
+            deviceMemory = vsg::DeviceMemory::create(device, memRequirements, memoryPropertiesFlags, priority, pNextAllocInfo);
             if (deviceMemory)
             {
                 reservedSlot = deviceMemory->reserve(totalSize);
@@ -242,6 +298,56 @@ MemoryBufferPools::DeviceMemoryOffset MemoryBufferPools::reserveMemory(VkMemoryR
     return MemoryBufferPools::DeviceMemoryOffset(deviceMemory, reservedSlot.second);
 }
 
+MemoryBufferPools::DeviceMemoryOffset MemoryBufferPools::reserveImageMemory(VkImage image, VkMemoryPropertyFlags memoryPropertiesFlags, float priority)
+{
+    VkMemoryRequirements memRequirements;
+    bool dedicated = false;
+    bool dedicatedAllocateInfoSupported = useDedicatedAllocations && (device->getInstance()->apiVersion >= VK_API_VERSION_1_1);
+
+    if (dedicatedAllocateInfoSupported)
+    {
+        VkMemoryDedicatedRequirements dedicatedRequirements = {};
+        dedicatedRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+        VkMemoryRequirements2 memRequirements2 = {};
+        memRequirements2.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+        memRequirements2.pNext = &dedicatedRequirements;
+
+        VkImageMemoryRequirementsInfo2 requirementsInfo = {};
+        requirementsInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+        requirementsInfo.image = image;
+
+        vkGetImageMemoryRequirements2(*device, &requirementsInfo, &memRequirements2);
+
+        memRequirements = memRequirements2.memoryRequirements;
+        dedicated = dedicatedRequirements.requiresDedicatedAllocation || dedicatedRequirements.prefersDedicatedAllocation;
+    }
+    else
+    {
+        vkGetImageMemoryRequirements(*device, image, &memRequirements);
+    }
+
+    if (dedicatedAllocationThreshold > 0 && memRequirements.size >= dedicatedAllocationThreshold) dedicated = true;
+
+    if (!dedicated) return reserveMemory(memRequirements, memoryPropertiesFlags, nullptr, priority);
+
+    VkMemoryDedicatedAllocateInfo dedicatedAllocateInfo = {};
+    dedicatedAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+    dedicatedAllocateInfo.image = image;
+
+    // dedicated DeviceMemory isn't added to the memoryPools so is freed as soon as the image releases it.
+    auto deviceMemory = vsg::DeviceMemory::create(device, memRequirements, memoryPropertiesFlags, priority, dedicatedAllocateInfoSupported ? &dedicatedAllocateInfo : nullptr);
+    auto reservedSlot = deviceMemory->reserve(memRequirements.size);
+    if (!reservedSlot.first)
+    {
+        debug(name, " : reserveImageMemory(", image, ") failed to reserve dedicated DeviceMemory.");
+        return {};
+    }
+
+    debug(name, " : reserveImageMemory(", image, ") allocated dedicated DeviceMemory ", deviceMemory, ", size = ", memRequirements.size);
+    return MemoryBufferPools::DeviceMemoryOffset(deviceMemory, reservedSlot.second);
+}
+
 VkResult MemoryBufferPools::reserve(ResourceRequirements& requirements)
 {
     //vsg::info("MemoryBufferPools::reserve(ResourceRequirements& requirements) { ");
@@ -265,7 +371,7 @@ VkResult MemoryBufferPools::reserve(ResourceRequirements& requirements)
                 else if ((properties.usageFlags & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) != 0)
                     alignment = limits.minStorageBufferOffsetAlignment;
 
-                auto newBufferInfo = reserveBuffer(bufferInfo->data->dataSize(), alignment, properties.usageFlags, properties.sharingMode, memoryPropertiesFlags);
+                auto newBufferInfo = reserveBuffer(bufferInfo->data->dataSize(), alignment, properties.usageFlags, properties.sharingMode, memoryPropertiesFlags, requirements.memoryPriority);
                 if (newBufferInfo)
                 {
                     bufferInfo->buffer = newBufferInfo->buffer;
@@ -290,7 +396,7 @@ VkResult MemoryBufferPools::reserve(ResourceRequirements& requirements)
     {
         if (imageInfo->imageView && imageInfo->imageView->image && imageInfo->imageView->image->getDeviceMemory(deviceID) == 0)
         {
-            if (imageInfo->imageView->image->compile(*this) == VK_SUCCESS && imageInfo->imageView->image->getDeviceMemory(deviceID) != 0)
+            if (imageInfo->imageView->image->compile(*this, requirements.memoryPriority) == VK_SUCCESS && imageInfo->imageView->image->getDeviceMemory(deviceID) != 0)
             {
                 //info("    ALLOCATED imageInfo = ", imageInfo, ", imageView = ", imageInfo->imageView, " ----- size = ", computeSize(*imageInfo), " device memory = ", imageInfo->imageView->image->getDeviceMemory(deviceID), " offset = ", imageInfo->imageView->image->getMemoryOffset(deviceID));
             }
@@ -0,0 +1,134 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+#include <vsg/core/Exception.h>
+#include <vsg/io/FileSystem.h>
+#include <vsg/io/Logger.h>
+#include <vsg/vk/PipelineCache.h>
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace vsg;
+
+PipelineCache::PipelineCache(Device* device, const Path& in_filename) :
+    filename(in_filename),
+    _device(device)
+{
+    std::vector<uint8_t> initialData;
+    if (filename && fileExists(filename))
+    {
+        std::ifstream fin(filename, std::ios::ate | std::ios::binary);
+        if (fin.is_open())
+        {
+            size_t fileSize = fin.tellg();
+            initialData.resize(fileSize);
+
+            fin.seekg(0);
+            fin.read(reinterpret_cast<char*>(initialData.data()), fileSize);
+            fin.close();
+        }
+
+        if (!compatible(device->getPhysicalDevice(), initialData))
+        {
+            info("PipelineCache::PipelineCache() ", filename, " is not compatible with device, ignoring contents.");
+            initialData.clear();
+        }
+    }
+
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+    createInfo.initialDataSize = initialData.size();
+    createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+    if (VkResult result = vkCreatePipelineCache(*device, &createInfo, _device->getAllocationCallbacks(), &_pipelineCache); result != VK_SUCCESS)
+    {
+        throw Exception{"Error: vsg::PipelineCache failed to create VkPipelineCache.", result};
+    }
+}
+
+PipelineCache::~PipelineCache()
+{
+    if (_pipelineCache)
+    {
+        if (filename) write();
+
+        vkDestroyPipelineCache(*_device, _pipelineCache, _device->getAllocationCallbacks());
+    }
+}
+
+std::vector<uint8_t> PipelineCache::getData() const
+{
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(*_device, _pipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) return {};
+
+    std::vector<uint8_t> data(dataSize);
+    if (vkGetPipelineCacheData(*_device, _pipelineCache, &dataSize, data.data()) != VK_SUCCESS) return {};
+
+    data.resize(dataSize);
+    return data;
+}
+
+bool PipelineCache::write(const Path& in_filename) const
+{
+    if (!in_filename) return false;
+
+    auto data = getData();
+    if (data.empty()) return false;
+
+    auto directory = filePath(in_filename);
+    if (directory && !fileExists(directory)) makeDirectory(directory);
+
+    std::ofstream fout(in_filename, std::ios::out | std::ios::binary);
+    if (!fout.is_open())
+    {
+        warn("PipelineCache::write() unable to open ", in_filename, " for writing.");
+        return false;
+    }
+
+    fout.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return fout.good();
+}
+
+bool PipelineCache::compatible(const PhysicalDevice* physicalDevice, const std::vector<uint8_t>& data)
+{
+    if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne)) return false;
+
+    VkPipelineCacheHeaderVersionOne header;
+    std::memcpy(&header, data.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+
+    const auto& properties = physicalDevice->getProperties();
+    return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == properties.vendorID &&
+           header.deviceID == properties.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+Path PipelineCache::filenameForDevice(const PhysicalDevice* physicalDevice, const Path& directory)
+{
+    const auto& properties = physicalDevice->getProperties();
+
+    std::stringstream str;
+    str << "pipelineCache_" << std::hex << properties.vendorID << "_" << properties.deviceID << "_" << properties.driverVersion << "_";
+    for (auto c : properties.pipelineCacheUUID)
+    {
+        str << std::setw(2) << std::setfill('0') << static_cast<uint32_t>(c);
+    }
+    str << ".bin";
+
+    return directory / Path(str.str());
+}
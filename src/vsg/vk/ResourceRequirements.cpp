@@ -21,6 +21,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/nodes/InstanceDrawIndexed.h>
 #include <vsg/nodes/InstanceNode.h>
 #include <vsg/nodes/Layer.h>
+#include <vsg/nodes/LazyCompileGroup.h>
 #include <vsg/nodes/PagedLOD.h>
 #include <vsg/nodes/StateGroup.h>
 #include <vsg/nodes/VertexDraw.h>
@@ -32,6 +33,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include <vsg/vk/RenderPass.h>
 #include <vsg/vk/ResourceRequirements.h>
 
+#include <algorithm>
+
 using namespace vsg;
 
 /////////////////////////////////////////////////////////////////////
@@ -64,6 +67,42 @@ DescriptorPoolSizes ResourceRequirements::computeDescriptorPoolSizes() const
     return poolSizes;
 }
 
+void ResourceRequirements::computeMemoryUsage(uint64_t& cpuMemory, uint64_t& gpuMemory) const
+{
+    cpuMemory = externalCPUMemory;
+    gpuMemory = externalGPUMemory;
+
+    // Data may be shared between several BufferInfo/ImageInfo so only count it once
+    std::unordered_set<const Data*> countedData;
+    auto countData = [&](const Data* data) {
+        if (data && countedData.insert(data).second) cpuMemory += data->dataSize();
+    };
+
+    for (const auto& [properties, bufferInfoSet] : bufferInfos)
+    {
+        for (const auto& bufferInfo : bufferInfoSet)
+        {
+            countData(bufferInfo->data);
+            gpuMemory += (bufferInfo->range > 0) ? bufferInfo->range : (bufferInfo->data ? bufferInfo->data->dataSize() : 0);
+        }
+    }
+
+    std::unordered_set<const Image*> countedImages;
+    for (const auto& imageInfo : imageInfos)
+    {
+        auto& image = imageInfo->imageView->image;
+        if (!countedImages.insert(image.get()).second || !image->data) continue;
+
+        auto& data = image->data;
+        countData(data);
+
+        // mipmaps generated on the GPU add roughly a third to the size of the base level
+        uint64_t imageSize = data->dataSize();
+        if (image->mipLevels > std::max(1u, static_cast<uint32_t>(data->properties.mipLevels))) imageSize += imageSize / 3;
+        gpuMemory += imageSize;
+    }
+}
+
 void ResourceRequirements::apply(const ResourceHints& resourceHints)
 {
     maxSlots.merge(resourceHints.maxSlots);
@@ -88,9 +127,18 @@ void ResourceRequirements::apply(const ResourceHints& resourceHints)
 
     dataTransferHint = resourceHints.dataTransferHint;
     viewportStateHint = resourceHints.viewportStateHint;
+    memoryPriority = resourceHints.memoryPriority;
+    if (resourceHints.pipelineCacheDirectory) pipelineCacheDirectory = resourceHints.pipelineCacheDirectory;
 
     dynamicData.add(resourceHints.dynamicData);
     containsPagedLOD = containsPagedLOD | resourceHints.containsPagedLOD;
+
+    if (resourceHints.complete)
+    {
+        viewDetailsStack.top().indices.insert(resourceHints.binNumbers.begin(), resourceHints.binNumbers.end());
+        externalCPUMemory += resourceHints.cpuMemory;
+        externalGPUMemory += resourceHints.gpuMemory;
+    }
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -112,6 +160,26 @@ ref_ptr<ResourceHints> CollectResourceRequirements::createResourceHints(uint32_t
 
     resourceHints->dynamicData = requirements.dynamicData;
     resourceHints->containsPagedLOD = requirements.containsPagedLOD;
+    resourceHints->memoryPriority = requirements.memoryPriority;
+
+    return resourceHints;
+}
+
+ref_ptr<ResourceHints> CollectResourceRequirements::createSubgraphResourceHints() const
+{
+    auto& viewDetails = requirements.viewDetailsStack.top();
+    if (!requirements.views.empty() || !viewDetails.bins.empty() || !viewDetails.lights.empty()) return {};
+
+    auto resourceHints = createResourceHints();
+    resourceHints->minimumBufferSize = requirements.minimumBufferSize;
+    resourceHints->minimumDeviceMemorySize = requirements.minimumDeviceMemorySize;
+    resourceHints->minimumStagingBufferSize = requirements.minimumStagingBufferSize;
+    resourceHints->dataTransferHint = requirements.dataTransferHint;
+    resourceHints->viewportStateHint = requirements.viewportStateHint;
+
+    resourceHints->complete = true;
+    resourceHints->binNumbers.assign(viewDetails.indices.begin(), viewDetails.indices.end());
+    requirements.computeMemoryUsage(resourceHints->cpuMemory, resourceHints->gpuMemory);
 
     return resourceHints;
 }
@@ -127,7 +195,7 @@ bool CollectResourceRequirements::checkForResourceHints(const Object& object)
     if (resourceHints)
     {
         apply(*resourceHints);
-        return true;
+        return resourceHints->complete;
     }
     else
     {
@@ -142,7 +210,7 @@ void CollectResourceRequirements::apply(const ResourceHints& resourceHints)
 
 void CollectResourceRequirements::apply(const Node& node)
 {
-    checkForResourceHints(node);
+    if (checkForResourceHints(node)) return;
 
     node.traverse(*this);
 }
@@ -151,11 +219,19 @@ void CollectResourceRequirements::apply(const PagedLOD& plod)
 {
     requirements.containsPagedLOD = true;
 
-    checkForResourceHints(plod);
+    if (checkForResourceHints(plod)) return;
 
     plod.traverse(*this);
 }
 
+void CollectResourceRequirements::apply(const LazyCompileGroup& lcg)
+{
+    // the requirements of the children of LazyCompileGroup assigned a LazyCompiler are collected when they are compiled
+    if (!lcg.compiled()) return;
+
+    apply(static_cast<const Node&>(lcg));
+}
+
 void CollectResourceRequirements::apply(const StateCommand& stateCommand)
 {
     if (stateCommand.slot > requirements.maxSlots.state) requirements.maxSlots.state = stateCommand.slot;
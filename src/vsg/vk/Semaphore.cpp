@@ -30,6 +30,67 @@ Semaphore::Semaphore(Device* device, VkPipelineStageFlags pipelineStageFlags, vo
     }
 }
 
+Semaphore::Semaphore(Device* device, VkSemaphoreType semaphoreType, uint64_t initialValue, VkPipelineStageFlags pipelineStageFlags) :
+    _pipelineStageFlags(pipelineStageFlags),
+    _timeline(semaphoreType == VK_SEMAPHORE_TYPE_TIMELINE),
+    _signalValue(initialValue),
+    _device(device)
+{
+    VkSemaphoreTypeCreateInfo semaphoreTypeInfo = {};
+    semaphoreTypeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    semaphoreTypeInfo.pNext = nullptr;
+    semaphoreTypeInfo.semaphoreType = semaphoreType;
+    semaphoreTypeInfo.initialValue = initialValue;
+
+    VkSemaphoreCreateInfo semaphoreInfo = {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &semaphoreTypeInfo;
+
+    VkResult result = vkCreateSemaphore(*device, &semaphoreInfo, _device->getAllocationCallbacks(), &_semaphore);
+    if (result != VK_SUCCESS)
+    {
+        throw Exception{"Error: Failed to create semaphore.", result};
+    }
+}
+
+uint64_t Semaphore::counterValue() const
+{
+    uint64_t value = 0;
+    auto extensions = _device->getExtensions();
+    if (_timeline && extensions->vkGetSemaphoreCounterValue) extensions->vkGetSemaphoreCounterValue(*_device, _semaphore, &value);
+    return value;
+}
+
+VkResult Semaphore::wait(uint64_t value, uint64_t timeout) const
+{
+    auto extensions = _device->getExtensions();
+    if (!_timeline || !extensions->vkWaitSemaphores) return VK_ERROR_FEATURE_NOT_PRESENT;
+
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.pNext = nullptr;
+    waitInfo.flags = 0;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &_semaphore;
+    waitInfo.pValues = &value;
+
+    return extensions->vkWaitSemaphores(*_device, &waitInfo, timeout);
+}
+
+VkResult Semaphore::signal(uint64_t value) const
+{
+    auto extensions = _device->getExtensions();
+    if (!_timeline || !extensions->vkSignalSemaphore) return VK_ERROR_FEATURE_NOT_PRESENT;
+
+    VkSemaphoreSignalInfo signalInfo = {};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO;
+    signalInfo.pNext = nullptr;
+    signalInfo.semaphore = _semaphore;
+    signalInfo.value = value;
+
+    return extensions->vkSignalSemaphore(*_device, &signalInfo);
+}
+
 Semaphore::~Semaphore()
 {
     if (_semaphore)
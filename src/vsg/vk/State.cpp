@@ -11,11 +11,243 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 </editor-fold> */
 
 #include <vsg/app/View.h>
+#include <vsg/commands/Commands.h>
 #include <vsg/state/ResourceHints.h>
+#include <vsg/vk/Device.h>
 #include <vsg/vk/State.h>
 
+#if defined(__AVX__)
+#    include <immintrin.h>
+#    define VSG_FRUSTUM_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define VSG_FRUSTUM_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#    include <arm_neon.h>
+#    define VSG_FRUSTUM_NEON 1
+#endif
+
 using namespace vsg;
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Frustum
+//
+// The SIMD code paths test several spheres against each plane at once, using the same multiply/add ordering as
+// distance(plane, center) so that the results match the scalar Frustum::intersect(sphere).
+//
+size_t Frustum::intersect(const dsphere* spheres, size_t count, uint8_t* visible) const
+{
+    size_t numVisible = 0;
+    size_t i = 0;
+
+#if defined(VSG_FRUSTUM_AVX)
+    for (; (i + 4) <= count; i += 4)
+    {
+        // transpose 4 spheres of {x, y, z, r} into {x0..x3}, {y0..y3}, {z0..z3}, {r0..r3}
+        __m256d s0 = _mm256_loadu_pd(spheres[i].value);
+        __m256d s1 = _mm256_loadu_pd(spheres[i + 1].value);
+        __m256d s2 = _mm256_loadu_pd(spheres[i + 2].value);
+        __m256d s3 = _mm256_loadu_pd(spheres[i + 3].value);
+
+        __m256d t0 = _mm256_unpacklo_pd(s0, s1); // x0 x1 z0 z1
+        __m256d t1 = _mm256_unpackhi_pd(s0, s1); // y0 y1 r0 r1
+        __m256d t2 = _mm256_unpacklo_pd(s2, s3); // x2 x3 z2 z3
+        __m256d t3 = _mm256_unpackhi_pd(s2, s3); // y2 y3 r2 r3
+
+        __m256d x = _mm256_permute2f128_pd(t0, t2, 0x20);
+        __m256d y = _mm256_permute2f128_pd(t1, t3, 0x20);
+        __m256d z = _mm256_permute2f128_pd(t0, t2, 0x31);
+        __m256d negative_radius = _mm256_sub_pd(_mm256_setzero_pd(), _mm256_permute2f128_pd(t1, t3, 0x31));
+
+        __m256d outside = _mm256_setzero_pd();
+        for (const auto& plane : face)
+        {
+            __m256d d = _mm256_mul_pd(_mm256_set1_pd(plane.value[0]), x);
+            d = _mm256_add_pd(d, _mm256_mul_pd(_mm256_set1_pd(plane.value[1]), y));
+            d = _mm256_add_pd(d, _mm256_mul_pd(_mm256_set1_pd(plane.value[2]), z));
+            d = _mm256_add_pd(d, _mm256_set1_pd(plane.value[3]));
+            outside = _mm256_or_pd(outside, _mm256_cmp_pd(d, negative_radius, _CMP_LT_OQ));
+        }
+
+        int mask = _mm256_movemask_pd(outside);
+        for (int j = 0; j < 4; ++j)
+        {
+            uint8_t result = ((mask >> j) & 1) ? 0 : 1;
+            visible[i + j] = result;
+            numVisible += result;
+        }
+    }
+#elif defined(VSG_FRUSTUM_SSE2)
+    for (; (i + 2) <= count; i += 2)
+    {
+        // transpose 2 spheres of {x, y, z, r} into {x0, x1}, {y0, y1}, {z0, z1}, {r0, r1}
+        __m128d a0 = _mm_loadu_pd(spheres[i].value);         // x0 y0
+        __m128d a1 = _mm_loadu_pd(spheres[i].value + 2);     // z0 r0
+        __m128d b0 = _mm_loadu_pd(spheres[i + 1].value);     // x1 y1
+        __m128d b1 = _mm_loadu_pd(spheres[i + 1].value + 2); // z1 r1
+
+        __m128d x = _mm_unpacklo_pd(a0, b0);
+        __m128d y = _mm_unpackhi_pd(a0, b0);
+        __m128d z = _mm_unpacklo_pd(a1, b1);
+        __m128d negative_radius = _mm_sub_pd(_mm_setzero_pd(), _mm_unpackhi_pd(a1, b1));
+
+        __m128d outside = _mm_setzero_pd();
+        for (const auto& plane : face)
+        {
+            __m128d d = _mm_mul_pd(_mm_set1_pd(plane.value[0]), x);
+            d = _mm_add_pd(d, _mm_mul_pd(_mm_set1_pd(plane.value[1]), y));
+            d = _mm_add_pd(d, _mm_mul_pd(_mm_set1_pd(plane.value[2]), z));
+            d = _mm_add_pd(d, _mm_set1_pd(plane.value[3]));
+            outside = _mm_or_pd(outside, _mm_cmplt_pd(d, negative_radius));
+        }
+
+        int mask = _mm_movemask_pd(outside);
+        for (int j = 0; j < 2; ++j)
+        {
+            uint8_t result = ((mask >> j) & 1) ? 0 : 1;
+            visible[i + j] = result;
+            numVisible += result;
+        }
+    }
+#elif defined(VSG_FRUSTUM_NEON)
+    for (; (i + 2) <= count; i += 2)
+    {
+        // de-interleave 2 spheres of {x, y, z, r} into {x0, x1}, {y0, y1}, {z0, z1}, {r0, r1}
+        float64x2x4_t s = vld4q_f64(spheres[i].value);
+        float64x2_t negative_radius = vnegq_f64(s.val[3]);
+
+        uint64x2_t outside = vdupq_n_u64(0);
+        for (const auto& plane : face)
+        {
+            float64x2_t d = vmulq_f64(vdupq_n_f64(plane.value[0]), s.val[0]);
+            d = vaddq_f64(d, vmulq_f64(vdupq_n_f64(plane.value[1]), s.val[1]));
+            d = vaddq_f64(d, vmulq_f64(vdupq_n_f64(plane.value[2]), s.val[2]));
+            d = vaddq_f64(d, vdupq_n_f64(plane.value[3]));
+            outside = vorrq_u64(outside, vcltq_f64(d, negative_radius));
+        }
+
+        uint8_t result0 = (vgetq_lane_u64(outside, 0) != 0) ? 0 : 1;
+        uint8_t result1 = (vgetq_lane_u64(outside, 1) != 0) ? 0 : 1;
+        visible[i] = result0;
+        visible[i + 1] = result1;
+        numVisible += result0 + result1;
+    }
+#endif
+
+    // remaining spheres
+    for (; i < count; ++i)
+    {
+        bool result = intersect(spheres[i]);
+        visible[i] = result ? 1 : 0;
+        if (result) ++numVisible;
+    }
+
+    return numVisible;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// DrawBatch
+//
+void DrawBatch::connect(Device* device)
+{
+    if (device == _device) return;
+
+    _device = device;
+    _draws.clear();
+
+    vkCmdDrawMultiIndexedEXT = device ? device->getExtensions()->vkCmdDrawMultiIndexedEXT : nullptr;
+    maxDrawCount = 0;
+    if (vkCmdDrawMultiIndexedEXT)
+    {
+        auto properties = device->getPhysicalDevice()->getProperties<VkPhysicalDeviceMultiDrawPropertiesEXT, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTI_DRAW_PROPERTIES_EXT>();
+        maxDrawCount = properties.maxMultiDrawCount;
+    }
+}
+
+void DrawBatch::add(CommandBuffer& commandBuffer, uint32_t firstBinding, const VulkanArrayData& vertexArrays, VkBuffer indexBuffer, VkDeviceSize indexOffset, VkIndexType indexType,
+                    uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    VkDeviceSize indexSize = (indexType == VK_INDEX_TYPE_UINT32) ? 4 : ((indexType == VK_INDEX_TYPE_UINT16) ? 2 : 1);
+
+    if (!_draws.empty())
+    {
+        bool compatible = _bindBuffers && _draws.size() < maxDrawCount &&
+                          _instanceCount == instanceCount && _firstInstance == firstInstance &&
+                          _indexBuffer == indexBuffer && _indexType == indexType &&
+                          indexOffset >= _indexOffset && ((indexOffset - _indexOffset) % indexSize) == 0 &&
+                          _firstBinding == firstBinding && _vertexBuffers == vertexArrays.vkBuffers && _vertexOffsets == vertexArrays.offsets;
+
+        if (!compatible) flush(commandBuffer);
+    }
+
+    if (_draws.empty())
+    {
+        _bindBuffers = true;
+        _firstBinding = firstBinding;
+        _vertexBuffers = vertexArrays.vkBuffers;
+        _vertexOffsets = vertexArrays.offsets;
+        _indexBuffer = indexBuffer;
+        _indexOffset = indexOffset;
+        _indexType = indexType;
+        _instanceCount = instanceCount;
+        _firstInstance = firstInstance;
+    }
+
+    // fold the index buffer offset into the firstIndex relative to the offset the index buffer will be bound with
+    uint32_t indexBufferFirstIndex = static_cast<uint32_t>((indexOffset - _indexOffset) / indexSize);
+    _draws.push_back(VkMultiDrawIndexedInfoEXT{firstIndex + indexBufferFirstIndex, indexCount, vertexOffset});
+}
+
+void DrawBatch::add(CommandBuffer& commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    if (!_draws.empty())
+    {
+        bool compatible = !_bindBuffers && _draws.size() < maxDrawCount && _instanceCount == instanceCount && _firstInstance == firstInstance;
+        if (!compatible) flush(commandBuffer);
+    }
+
+    if (_draws.empty())
+    {
+        _bindBuffers = false;
+        _instanceCount = instanceCount;
+        _firstInstance = firstInstance;
+    }
+
+    _draws.push_back(VkMultiDrawIndexedInfoEXT{firstIndex, indexCount, vertexOffset});
+}
+
+void DrawBatch::flush(CommandBuffer& commandBuffer)
+{
+    if (_draws.empty()) return;
+
+    if (_bindBuffers)
+    {
+        vkCmdBindVertexBuffers(commandBuffer, _firstBinding, static_cast<uint32_t>(_vertexBuffers.size()), _vertexBuffers.data(), _vertexOffsets.data());
+        vkCmdBindIndexBuffer(commandBuffer, _indexBuffer, _indexOffset, _indexType);
+    }
+
+    if (_draws.size() == 1)
+    {
+        auto& draw = _draws.front();
+        vkCmdDrawIndexed(commandBuffer, draw.indexCount, _instanceCount, draw.firstIndex, draw.vertexOffset, _firstInstance);
+    }
+    else
+    {
+        vkCmdDrawMultiIndexedEXT(commandBuffer, static_cast<uint32_t>(_draws.size()), _draws.data(), _instanceCount, _firstInstance, sizeof(VkMultiDrawIndexedInfoEXT), nullptr);
+        ++numMultiDraws;
+    }
+
+    numDraws += _draws.size();
+    _draws.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// State
+//
+
 State::State(const Slots& in_maxSlots) :
     dirty(false)
 {
@@ -47,6 +279,7 @@ void State::connect(ref_ptr<CommandBuffer> commandBuffer)
 {
     _commandBuffer = commandBuffer;
     commandBuffer->state = this;
+    drawBatch.connect(commandBuffer->getDevice());
     dirtyStateStacks();
 }
 
@@ -74,6 +307,18 @@ void State::popView(const View& view)
     if ((viewportStateHint & DYNAMIC_VIEWPORTSTATE) && view.camera && view.camera->viewportState) popView(view.camera->viewportState);
 }
 
+void State::capture(const Command& command)
+{
+    capturedCommands->children.push_back(ref_ptr<Command>(const_cast<Command*>(&command)));
+}
+
+void State::capture(uint32_t offset, const mat4& matrix)
+{
+    // copy the matrix so the captured value isn't lost when the MatrixStack entry is reused
+    auto pushConstants = PushConstants::create(_commandBuffer->getCurrentPushConstantStageFlags(), offset, mat4Value::create(matrix));
+    capturedCommands->children.push_back(pushConstants);
+}
+
 void State::inherit(const State& state)
 {
     reserve(state.maxSlots);
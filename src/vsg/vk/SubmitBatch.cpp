@@ -0,0 +1,58 @@
+/* <editor-fold desc="MIT License">
+
+Copyright(c) 2026 Robert Osfield
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+</editor-fold> */
+
+
+#include <vsg/vk/SubmitBatch.h>
+
+using namespace vsg;
+
+SubmitBatch::SubmitBatch(ref_ptr<Queue> in_queue) :
+    queue(in_queue)
+{
+}
+
+SubmitBatch::~SubmitBatch()
+{
+}
+
+VkResult SubmitBatch::add(const VkSubmitInfo& submitInfo, Fence* in_fence)
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+
+    if (in_fence && fence)
+    {
+        if (VkResult result = _submit(); result != VK_SUCCESS) return result;
+    }
+
+    submitInfos.push_back(submitInfo);
+    if (in_fence) fence = in_fence;
+
+    return VK_SUCCESS;
+}
+
+VkResult SubmitBatch::submit()
+{
+    std::scoped_lock<std::mutex> lock(_mutex);
+    return _submit();
+}
+
+VkResult SubmitBatch::_submit()
+{
+    if (submitInfos.empty()) return VK_SUCCESS;
+
+    VkResult result = queue->submit(submitInfos, fence);
+
+    submitInfos.clear();
+    fence = {};
+
+    return result;
+}
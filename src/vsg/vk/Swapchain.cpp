@@ -269,3 +269,20 @@ VkResult Swapchain::acquireNextImage(uint64_t timeout, ref_ptr<Semaphore> semaph
     VkFence vk_fence = fence ? fence->vk() : VK_NULL_HANDLE;
     return vkAcquireNextImageKHR(*_device, _swapchain, timeout, vk_semaphore, vk_fence, &imageIndex);
 }
+
+bool Swapchain::supportsPresentId() const
+{
+    return _device->supportsDeviceExtension(VK_KHR_PRESENT_ID_EXTENSION_NAME);
+}
+
+bool Swapchain::supportsPresentWait() const
+{
+    return _device->getExtensions()->vkWaitForPresentKHR != nullptr;
+}
+
+VkResult Swapchain::waitForPresent(uint64_t presentId, uint64_t timeout) const
+{
+    auto extensions = _device->getExtensions();
+    if (!extensions->vkWaitForPresentKHR) return VK_ERROR_EXTENSION_NOT_PRESENT;
+    return extensions->vkWaitForPresentKHR(*_device, _swapchain, presentId, timeout);
+}